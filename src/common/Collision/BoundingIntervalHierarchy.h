@@ -27,6 +27,8 @@
 #include <stdexcept>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <limits>
 #include "string.h"
 
@@ -112,6 +114,7 @@ class TC_COMMON_API BIH
             delete[] dat.indices;
         }
         uint32 primCount() const { return uint32(objects.size()); }
+        std::size_t GetMemoryUsage() const { return (tree.capacity() + objects.capacity()) * sizeof(uint32); }
         G3D::AABox const& bound() const { return bounds; }
 
         template<typename RayCallback>
@@ -252,6 +255,233 @@ class TC_COMMON_API BIH
             }
         }
 
+        // number of rays traced together by intersectRays
+        static constexpr std::size_t RayPacketSize = 4;
+
+        /**
+            Traces up to N rays together, every ray keeps its own interval and its own maxDist.
+            Interior nodes are tested for all rays of the packet at once (fixed width loops over the packet, vectorized by the compiler),
+            children are visited while at least one ray overlaps them and leaves call intersectCallback only for those rays.
+            Rays do not need a common origin but packets of rays with similar directions visit fewer nodes.
+            intersectCallback is called as intersectCallback(rayIndex, ray, entry, maxDist, stopAtFirst), with stopAtFirst a ray stops after its first hit.
+        */
+        template<std::size_t N = RayPacketSize, typename RayCallback>
+        void intersectRays(G3D::Ray const* rays, std::size_t count, RayCallback& intersectCallback, float* maxDist, bool stopAtFirst = false) const
+        {
+            static_assert(N <= 32, "Ray packets are tracked with 32 bit masks");
+
+            struct PacketInterval
+            {
+                alignas(16) std::array<float, N> Min;
+                alignas(16) std::array<float, N> Max;
+            };
+
+            struct PacketStackNode
+            {
+                uint32 node;
+                uint32 mask;
+                PacketInterval interval;
+            };
+
+            alignas(16) std::array<float, N> org[3];
+            alignas(16) std::array<float, N> invDir[3];
+            alignas(16) std::array<float, N> slabInf[3];   // t of the infinitely distant plane behind the origin, -inf or +inf by direction sign
+            alignas(16) std::array<float, N> hitDist;
+            PacketInterval interval;
+            uint32 active = 0;
+            count = std::min(count, N);
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                if (i >= count)
+                {
+                    // padding lanes never overlap anything
+                    for (int axis = 0; axis < 3; ++axis)
+                    {
+                        org[axis][i] = 0.0f;
+                        invDir[axis][i] = 0.0f;
+                        slabInf[axis][i] = -std::numeric_limits<float>::infinity();
+                    }
+                    hitDist[i] = 0.0f;
+                    interval.Min[i] = 1.0f;
+                    interval.Max[i] = 0.0f;
+                    continue;
+                }
+
+                G3D::Ray const& r = rays[i];
+                hitDist[i] = maxDist[i];
+                float intervalMin = 0.0f;
+                float intervalMax = maxDist[i];
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    org[axis][i] = r.origin()[axis];
+                    invDir[axis][i] = r.invDirection()[axis];
+                    slabInf[axis][i] = (floatToRawIntBits(r.direction()[axis]) >> 31) ? std::numeric_limits<float>::infinity() : -std::numeric_limits<float>::infinity();
+
+                    // same clipping against the tree bounds as intersectRay
+                    if (G3D::fuzzyNe(r.direction()[axis], 0.0f))
+                    {
+                        float t1 = (bounds.low()[axis] - org[axis][i]) * invDir[axis][i];
+                        float t2 = (bounds.high()[axis] - org[axis][i]) * invDir[axis][i];
+                        if (t1 > t2)
+                            std::swap(t1, t2);
+                        intervalMin = std::max(intervalMin, t1);
+                        intervalMax = std::min(intervalMax, t2);
+                    }
+                }
+
+                interval.Min[i] = intervalMin;
+                interval.Max[i] = intervalMax;
+                if (intervalMin <= intervalMax)
+                    active |= 1u << i;
+            }
+
+            PacketStackNode stack[MAX_STACK_SIZE];
+            int stackPos = 0;
+            uint32 node = 0;
+            uint32 mask = active;
+
+            while (mask)
+            {
+                uint32 tn = tree[node];
+                uint32 axis = (tn & (3 << 30)) >> 30;
+                bool BVH2 = (tn & (1 << 29)) != 0;
+                uint32 offset = tn & ~(7 << 29);
+                bool popNode = false;
+
+                if (!BVH2 && axis < 3)
+                {
+                    // "normal" interior node, left child is the slab (-inf, clipLeft] and right child [clipRight, +inf)
+                    // slab intervals are intersected branch free with min/max so the loops map to packed instructions
+                    float clipLeft = intBitsToFloat(tree[node + 1]);
+                    float clipRight = intBitsToFloat(tree[node + 2]);
+                    PacketInterval left, right;
+                    for (std::size_t i = 0; i < N; ++i)
+                    {
+                        float tl = (clipLeft - org[axis][i]) * invDir[axis][i];
+                        float tr = (clipRight - org[axis][i]) * invDir[axis][i];
+                        float intervalMax = std::min(interval.Max[i], hitDist[i]);
+                        left.Min[i] = std::max(interval.Min[i], std::min(slabInf[axis][i], tl));
+                        left.Max[i] = std::min(intervalMax, std::max(slabInf[axis][i], tl));
+                        right.Min[i] = std::max(interval.Min[i], std::min(-slabInf[axis][i], tr));
+                        right.Max[i] = std::min(intervalMax, std::max(-slabInf[axis][i], tr));
+                    }
+
+                    uint32 leftMask = 0;
+                    uint32 rightMask = 0;
+                    for (std::size_t i = 0; i < N; ++i)
+                    {
+                        leftMask |= uint32(left.Min[i] <= left.Max[i]) << i;
+                        rightMask |= uint32(right.Min[i] <= right.Max[i]) << i;
+                    }
+                    leftMask &= mask;
+                    rightMask &= mask;
+
+                    // front child is the one the first active ray enters first
+                    bool leftFirst = slabInf[axis][std::countr_zero(mask)] < 0.0f;
+                    uint32 frontMask = leftFirst ? leftMask : rightMask;
+                    uint32 backMask = leftFirst ? rightMask : leftMask;
+                    PacketInterval const& front = leftFirst ? left : right;
+                    PacketInterval const& back = leftFirst ? right : left;
+                    uint32 frontNode = leftFirst ? offset : offset + 3;
+                    uint32 backNode = leftFirst ? offset + 3 : offset;
+                    if (frontMask)
+                    {
+                        if (backMask)
+                        {
+                            stack[stackPos].node = backNode;
+                            stack[stackPos].mask = backMask;
+                            stack[stackPos].interval = back;
+                            stackPos++;
+                        }
+
+                        node = frontNode;
+                        mask = frontMask;
+                        interval = front;
+                    }
+                    else if (backMask)
+                    {
+                        node = backNode;
+                        mask = backMask;
+                        interval = back;
+                    }
+                    else
+                        popNode = true;
+                }
+                else if (!BVH2)
+                {
+                    // leaf - test some objects
+                    uint32 n = tree[node + 1];
+                    for (uint32 i = 0; i < n; ++i)
+                    {
+                        for (uint32 rayMask = mask; rayMask; rayMask &= rayMask - 1)
+                        {
+                            uint32 ray = std::countr_zero(rayMask);
+                            bool hit = intersectCallback(std::size_t(ray), rays[ray], objects[offset + i], hitDist[ray], stopAtFirst);
+                            if (stopAtFirst && hit)
+                            {
+                                active &= ~(1u << ray);
+                                mask &= ~(1u << ray);
+                            }
+                        }
+                    }
+                    popNode = true;
+                }
+                else
+                {
+                    if (axis > 2)
+                        break; // should not happen
+
+                    // BVH2 node (empty space cut off left and right)
+                    float clipLow = intBitsToFloat(tree[node + 1]);
+                    float clipHigh = intBitsToFloat(tree[node + 2]);
+                    for (std::size_t i = 0; i < N; ++i)
+                    {
+                        float tl = (clipLow - org[axis][i]) * invDir[axis][i];
+                        float th = (clipHigh - org[axis][i]) * invDir[axis][i];
+                        interval.Min[i] = std::max(interval.Min[i], std::min(tl, th));
+                        interval.Max[i] = std::min(std::min(interval.Max[i], hitDist[i]), std::max(tl, th));
+                    }
+
+                    uint32 childMask = 0;
+                    for (std::size_t i = 0; i < N; ++i)
+                        childMask |= uint32(interval.Min[i] <= interval.Max[i]) << i;
+                    node = offset;
+                    mask &= childMask;
+                    popNode = !mask;
+                }
+
+                while (popNode)
+                {
+                    // stack is empty?
+                    if (stackPos == 0)
+                    {
+                        mask = 0;
+                        break;
+                    }
+
+                    // move back up the stack, skipping rays that finished or already hit something closer
+                    stackPos--;
+                    mask = stack[stackPos].mask & active;
+                    for (uint32 rayMask = mask; rayMask; rayMask &= rayMask - 1)
+                    {
+                        uint32 ray = std::countr_zero(rayMask);
+                        if (hitDist[ray] < stack[stackPos].interval.Min[ray])
+                            mask &= ~(1u << ray);
+                    }
+
+                    if (!mask)
+                        continue;
+
+                    node = stack[stackPos].node;
+                    interval = stack[stackPos].interval;
+                    popNode = false;
+                }
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+                maxDist[i] = hitDist[i];
+        }
+
         template<typename IsectCallback>
         void intersectPoint(const G3D::Vector3 &p, IsectCallback& intersectCallback) const
         {
@@ -22,6 +22,7 @@
 #include <G3D/Table.h>
 #include <G3D/Array.h>
 #include <G3D/Set.h>
+#include <algorithm>
 
 template<class T, class BoundsFunc = BoundsTrait<T> >
 class BIHWrap
@@ -32,8 +33,9 @@ class BIHWrap
         const T* const* objects;
         RayCallback& _callback;
         uint32 objects_size;
+        bool hit;
 
-        MDLCallback(RayCallback& callback, const T* const* objects_array, uint32 objects_size ) : objects(objects_array), _callback(callback), objects_size(objects_size) { }
+        MDLCallback(RayCallback& callback, const T* const* objects_array, uint32 objects_size ) : objects(objects_array), _callback(callback), objects_size(objects_size), hit(false) { }
 
         /// Intersect ray
         bool operator() (const G3D::Ray& ray, uint32 idx, float& maxDist, bool /*stopAtFirst*/)
@@ -41,7 +43,8 @@ class BIHWrap
             if (idx >= objects_size)
                 return false;
             if (const T* obj = objects[idx])
-                return _callback(ray, *obj, maxDist/*, stopAtFirst*/);
+                if (_callback(ray, *obj, maxDist/*, stopAtFirst*/))
+                    return hit = true;
             return false;
         }
 
@@ -57,60 +60,101 @@ class BIHWrap
 
     typedef G3D::Array<const T*> ObjArray;
 
+    // objects inserted since the last rebuild are tested one by one, removed objects leave an empty slot in the tree
+    // the tree is only rebuilt once either of these exceeds the limits below, so a single moving object does not rebuild it every time
+    static constexpr int MaxPendingObjects = 8;
+    static constexpr int MinRemovedObjects = 8;
+
     BIH m_tree;
     ObjArray m_objects;
     G3D::Table<const T*, uint32> m_obj2Idx;
     G3D::Set<const T*> m_objects_to_push;
-    int unbalanced_times;
+    int removed_objects;
 
 public:
-    BIHWrap() : unbalanced_times(0) { }
+    BIHWrap() : removed_objects(0) { }
 
     void insert(const T& obj)
     {
-        ++unbalanced_times;
         m_objects_to_push.insert(&obj);
     }
 
     void remove(const T& obj)
     {
-        ++unbalanced_times;
         uint32 Idx = 0;
         const T * temp;
         if (m_obj2Idx.getRemove(&obj, temp, Idx))
+        {
             m_objects[Idx] = nullptr;
+            ++removed_objects;
+        }
         else
             m_objects_to_push.remove(&obj);
     }
 
-    void balance()
+    bool isBalanced() const { return m_objects_to_push.size() == 0 && removed_objects == 0; }
+
+    bool isDegraded() const
     {
-        if (unbalanced_times == 0)
-            return;
+        return m_objects_to_push.size() > MaxPendingObjects
+            || removed_objects > std::max(MinRemovedObjects, int(m_objects.size()) / 4);
+    }
+
+    // rebuilds the tree when anything changed since the last rebuild, returns true if it was rebuilt
+    bool balance()
+    {
+        if (isBalanced())
+            return false;
+
+        // both getters clear the array they fill
+        ObjArray objects, pending;
+        m_obj2Idx.getKeys(objects);
+        m_objects_to_push.getMembers(pending);
+        objects.append(pending);
 
-        unbalanced_times = 0;
         m_objects.fastClear();
-        m_obj2Idx.getKeys(m_objects);
-        m_objects_to_push.getMembers(m_objects);
-        //assert that m_obj2Idx has all the keys
+        m_obj2Idx.clear();
+        m_objects_to_push.clear();
+        removed_objects = 0;
+        for (int i = 0; i < objects.size(); ++i)
+        {
+            m_obj2Idx.set(objects[i], uint32(m_objects.size()));
+            m_objects.append(objects[i]);
+        }
 
         m_tree.build(m_objects, BoundsFunc::getBounds2);
+        return true;
     }
 
     template<typename RayCallback>
     void intersectRay(const G3D::Ray& ray, RayCallback& intersectCallback, float& maxDist)
     {
-        balance();
         MDLCallback<RayCallback> temp_cb(intersectCallback, m_objects.getCArray(), m_objects.size());
         m_tree.intersectRay(ray, temp_cb, maxDist, true);
+        if (temp_cb.hit)
+            return;
+
+        for (const T* obj : m_objects_to_push)
+        {
+            G3D::AABox bounds;
+            BoundsFunc::getBounds2(obj, bounds);
+            if (ray.intersectionTime(bounds) < maxDist && intersectCallback(ray, *obj, maxDist))
+                return;
+        }
     }
 
     template<typename IsectCallback>
     void intersectPoint(const G3D::Vector3& point, IsectCallback& intersectCallback)
     {
-        balance();
         MDLCallback<IsectCallback> callback(intersectCallback, m_objects.getCArray(), m_objects.size());
         m_tree.intersectPoint(point, callback);
+        for (const T* obj : m_objects_to_push)
+        {
+            G3D::AABox bounds;
+            BoundsFunc::getBounds2(obj, bounds);
+            if (bounds.contains(point))
+                intersectCallback(point, *obj);
+        }
     }
 };
 
@@ -28,6 +28,8 @@
 #include <G3D/AABox.h>
 #include <G3D/Ray.h>
 #include <G3D/Vector3.h>
+#include <chrono>
+#include <utility>
 
 using VMAP::ModelInstance;
 
@@ -64,27 +66,13 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
     typedef ParentTree base;
 
     DynTreeImpl() :
-        rebalance_timer(CHECK_TREE_PERIOD),
-        unbalanced_times(0)
+        rebalance_timer(CHECK_TREE_PERIOD)
     {
     }
 
-    void insert(Model const& mdl)
-    {
-        base::insert(mdl);
-        ++unbalanced_times;
-    }
-
-    void remove(Model const& mdl)
-    {
-        base::remove(mdl);
-        ++unbalanced_times;
-    }
-
     void balance()
     {
-        base::balance();
-        unbalanced_times = 0;
+        TimedBalance([this] { return base::balance(); });
     }
 
     void update(uint32 difftime)
@@ -96,13 +84,21 @@ struct DynTreeImpl : public ParentTree/*, public Intersectable*/
         if (rebalance_timer.Passed())
         {
             rebalance_timer.Reset(CHECK_TREE_PERIOD);
-            if (unbalanced_times > 0)
-                balance();
+            if (!changedNodes.empty())
+                TimedBalance([this] { return base::balanceDegraded(); });
         }
     }
 
+    template<typename Balancer>
+    void TimedBalance(Balancer balancer)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        balance_statistics.Rebuilds += balancer();
+        balance_statistics.BalanceTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
     TimeTracker rebalance_timer;
-    int unbalanced_times;
+    DynamicMapTree::BalanceStatistics balance_statistics;
 };
 
 DynamicMapTree::DynamicMapTree() : impl(new DynTreeImpl()) { }
@@ -137,6 +133,11 @@ void DynamicMapTree::update(uint32 t_diff)
     impl->update(t_diff);
 }
 
+DynamicMapTree::BalanceStatistics DynamicMapTree::consumeBalanceStatistics()
+{
+    return std::exchange(impl->balance_statistics, {});
+}
+
 struct DynamicTreeIntersectionCallback
 {
     DynamicTreeIntersectionCallback(PhaseShift const& phaseShift) : _didHit(false), _phaseShift(phaseShift) { }
@@ -56,8 +56,18 @@ public:
     void remove(GameObjectModel const&);
     bool contains(GameObjectModel const&) const;
 
+    struct BalanceStatistics
+    {
+        uint32 Rebuilds = 0;        // number of rebuilt grid cell trees
+        uint64 BalanceTime = 0;     // microseconds
+    };
+
+    // forces a rebuild of every grid cell tree that changed, update() only rebuilds the ones that became slow to query
     void balance();
     void update(uint32 diff);
+
+    // statistics collected since the last call
+    BalanceStatistics consumeBalanceStatistics();
 };
 
 #endif // _DYNTREE_H
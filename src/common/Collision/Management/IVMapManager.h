@@ -21,6 +21,8 @@
 #include "Define.h"
 #include "ModelIgnoreFlags.h"
 #include "Optional.h"
+#include <G3D/Vector3.h>
+#include <span>
 #include <string>
 
 //===========================================================
@@ -90,6 +92,10 @@ namespace VMAP
             virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) = 0;
             virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
             /**
+            resolve the heights of many world positions of one map at once, heights must be at least as large as positions
+            */
+            virtual void getHeights(unsigned int pMapId, std::span<G3D::Vector3 const> positions, std::span<float> heights, float maxSearchDist) = 0;
+            /**
             test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
             return a position, that is pReduceDist closer to the origin
             */
@@ -19,6 +19,8 @@
 #include "Errors.h"
 #include "Log.h"
 #include "MMapDefines.h"
+#include "Timer.h"
+#include <algorithm>
 
 namespace MMAP
 {
@@ -107,6 +109,7 @@ namespace MMAP
         // store inside our map list
         MMapData* mmap_data = new MMapData(mesh);
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
         itr->second = mmap_data;
         return true;
     }
@@ -194,11 +197,26 @@ namespace MMAP
         dtMeshHeader* header = (dtMeshHeader*)data;
         dtTileRef tileRef = 0;
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
+
+        // evicted tiles can be reloaded by several threads at once
+        if (mmap->loadedTileRefs.find(packedGridPos) != mmap->loadedTileRefs.end())
+        {
+            dtFree(data);
+            return false;
+        }
+
         // memory allocated for data is now managed by detour, and will be deallocated when the tile is removed
         if (dtStatusSucceed(mmap->navMesh->addTile(data, fileHeader.size, DT_TILE_FREE_DATA, 0, &tileRef)))
         {
             mmap->loadedTileRefs.insert(std::pair<uint32, dtTileRef>(packedGridPos, tileRef));
             ++loadedTiles;
+            loadedTileDataSize += fileHeader.size;
+            {
+                std::lock_guard<std::mutex> usageLock(mmap->tileUsageLock);
+                mmap->tileLastUseTimes[packedGridPos] = getMSTime();
+                mmap->evictedTiles.erase(packedGridPos);
+            }
             TC_LOG_DEBUG("maps", "MMAP:loadMap: Loaded mmtile {:04}[{:02}, {:02}] into {:04}[{:02}, {:02}]", mapId, x, y, mapId, header->x, header->y);
             return true;
         }
@@ -216,23 +234,9 @@ namespace MMAP
             return false;
 
         MMapData* mmap = loadedMMaps[meshMapId];
-        auto [queryItr, inserted] = mmap->navMeshQueries.try_emplace({ instanceMapId, instanceId }, nullptr);
-        if (!inserted)
-            return true;
-
-        // allocate mesh query
-        dtNavMeshQuery* query = dtAllocNavMeshQuery();
-        ASSERT(query);
-        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
-        {
-            dtFreeNavMeshQuery(query);
-            mmap->navMeshQueries.erase(queryItr);
-            TC_LOG_ERROR("maps", "MMAP:GetNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId {:04} instanceId {}", instanceMapId, instanceId);
-            return false;
-        }
-
-        TC_LOG_DEBUG("maps", "MMAP:GetNavMeshQuery: created dtNavMeshQuery for mapId {:04} instanceId {}", instanceMapId, instanceId);
-        queryItr->second = query;
+        std::lock_guard<std::mutex> lock(mmap->navMeshQueriesLock);
+        ++mmap->instanceCount;
+        TC_LOG_DEBUG("maps", "MMAP:loadMapInstance: Loaded mapId {:04} instanceId {}", instanceMapId, instanceId);
         return true;
     }
 
@@ -249,8 +253,21 @@ namespace MMAP
 
         MMapData* mmap = itr->second;
 
-        // check if we have this tile loaded
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
+
+        // the grid is gone, its tile is not reloaded anymore
         uint32 packedGridPos = packTileID(x, y);
+        {
+            std::lock_guard<std::mutex> usageLock(mmap->tileUsageLock);
+            mmap->tileLastUseTimes.erase(packedGridPos);
+            if (mmap->evictedTiles.erase(packedGridPos))
+            {
+                TC_LOG_DEBUG("maps", "MMAP:unloadMap: Forgot evicted mmtile {:04}[{:02}, {:02}]", mapId, x, y);
+                return true;
+            }
+        }
+
+        // check if we have this tile loaded
         auto tileRefItr = mmap->loadedTileRefs.find(packedGridPos);
         if (tileRefItr == mmap->loadedTileRefs.end())
         {
@@ -260,23 +277,33 @@ namespace MMAP
         }
 
         // unload, and mark as non loaded
-        if (dtStatusFailed(mmap->navMesh->removeTile(tileRefItr->second, nullptr, nullptr)))
+        if (!removeTile(mmap, mapId, tileRefItr))
         {
             // this is technically a memory leak
             // if the grid is later reloaded, dtNavMesh::addTile will return error but no extra memory is used
             // we cannot recover from this error - assert out
-            TC_LOG_ERROR("maps", "MMAP:unloadMap: Could not unload {:04}{:02}{:02}.mmtile from navmesh", mapId, x, y);
             ABORT();
         }
-        else
+
+        TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile {:04}[{:02}, {:02}] from {:03}", mapId, x, y, mapId);
+        return true;
+    }
+
+    bool MMapManager::removeTile(MMapData* mmap, uint32 mapId, MMapTileSet::iterator tileRefItr)
+    {
+        dtMeshTile const* tile = mmap->navMesh->getTileByRef(tileRefItr->second);
+        uint32 tileDataSize = tile ? uint32(tile->dataSize) : 0;
+
+        if (dtStatusFailed(mmap->navMesh->removeTile(tileRefItr->second, nullptr, nullptr)))
         {
-            mmap->loadedTileRefs.erase(tileRefItr);
-            --loadedTiles;
-            TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile {:04}[{:02}, {:02}] from {:03}", mapId, x, y, mapId);
-            return true;
+            TC_LOG_ERROR("maps", "MMAP:removeTile: Could not unload {:04}{:02}{:02}.mmtile from navmesh", mapId, tileRefItr->first >> 16, tileRefItr->first & 0x0000FFFF);
+            return false;
         }
 
-        return false;
+        mmap->loadedTileRefs.erase(tileRefItr);
+        --loadedTiles;
+        loadedTileDataSize -= tileDataSize;
+        return true;
     }
 
     bool MMapManager::unloadMap(uint32 mapId)
@@ -289,17 +316,22 @@ namespace MMAP
             return false;
         }
 
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
+
         // unload all tiles from given map
         MMapData* mmap = itr->second;
         for (MMapTileSet::iterator i = mmap->loadedTileRefs.begin(); i != mmap->loadedTileRefs.end(); ++i)
         {
             uint32 x = (i->first >> 16);
             uint32 y = (i->first & 0x0000FFFF);
+            dtMeshTile const* tile = mmap->navMesh->getTileByRef(i->second);
+            uint32 tileDataSize = tile ? uint32(tile->dataSize) : 0;
             if (dtStatusFailed(mmap->navMesh->removeTile(i->second, nullptr, nullptr)))
                 TC_LOG_ERROR("maps", "MMAP:unloadMap: Could not unload {:04}{:02}{:02}.mmtile from navmesh", mapId, x, y);
             else
             {
                 --loadedTiles;
+                loadedTileDataSize -= tileDataSize;
                 TC_LOG_DEBUG("maps", "MMAP:unloadMap: Unloaded mmtile {:04}[{:02}, {:02}] from {:04}", mapId, x, y, mapId);
             }
         }
@@ -323,17 +355,23 @@ namespace MMAP
         }
 
         MMapData* mmap = itr->second;
-        auto queryItr = mmap->navMeshQueries.find({ instanceMapId, instanceId });
-        if (queryItr == mmap->navMeshQueries.end())
+        std::lock_guard<std::mutex> lock(mmap->navMeshQueriesLock);
+        if (!mmap->instanceCount)
         {
-            TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded dtNavMeshQuery mapId {:04} instanceId {}", instanceMapId, instanceId);
+            TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Asked to unload not loaded mapId {:04} instanceId {}", instanceMapId, instanceId);
             return false;
         }
 
-        dtFreeNavMeshQuery(queryItr->second);
-        mmap->navMeshQueries.erase(queryItr);
-        TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId {:04} instanceId {}", instanceMapId, instanceId);
+        // idle meshes don't keep their queries
+        if (!--mmap->instanceCount)
+        {
+            for (dtNavMeshQuery* query : mmap->freeNavMeshQueries)
+                dtFreeNavMeshQuery(query);
+
+            mmap->freeNavMeshQueries.clear();
+        }
 
+        TC_LOG_DEBUG("maps", "MMAP:unloadMapInstance: Unloaded mapId {:04} instanceId {}", instanceMapId, instanceId);
         return true;
     }
 
@@ -346,16 +384,180 @@ namespace MMAP
         return itr->second->navMesh;
     }
 
-    dtNavMeshQuery const* MMapManager::GetNavMeshQuery(uint32 meshMapId, uint32 instanceMapId, uint32 instanceId)
+    uint32 MMapManager::getTileDataSize(uint32 mapId, int32 x, int32 y) const
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return 0;
+
+        auto tileRefItr = itr->second->loadedTileRefs.find(packTileID(x, y));
+        if (tileRefItr == itr->second->loadedTileRefs.end())
+            return 0;
+
+        dtMeshTile const* tile = itr->second->navMesh->getTileByRef(tileRefItr->second);
+        return tile ? uint32(tile->dataSize) : 0;
+    }
+
+    bool MMapManager::touchTile(uint32 mapId, int32 x, int32 y)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return false;
+
+        MMapData* mmap = itr->second;
+        uint32 packedGridPos = packTileID(x, y);
+        std::lock_guard<std::mutex> lock(mmap->tileUsageLock);
+        auto evictedItr = mmap->evictedTiles.find(packedGridPos);
+        if (evictedItr != mmap->evictedTiles.end())
+        {
+            if (evictedItr->second)
+                return false;
+
+            evictedItr->second = true;
+            return true;
+        }
+
+        auto lastUseItr = mmap->tileLastUseTimes.find(packedGridPos);
+        if (lastUseItr != mmap->tileLastUseTimes.end())
+            lastUseItr->second = getMSTime();
+
+        return false;
+    }
+
+    bool MMapManager::reloadEvictedTile(std::string const& basePath, uint32 mapId, int32 x, int32 y)
+    {
+        MMapDataSet::const_iterator itr = GetMMapData(mapId);
+        if (itr == loadedMMaps.end())
+            return false;
+
+        {
+            // the grid could have been unloaded since the tile was touched
+            std::lock_guard<std::mutex> lock(itr->second->tileUsageLock);
+            if (itr->second->evictedTiles.find(packTileID(x, y)) == itr->second->evictedTiles.end())
+                return false;
+        }
+
+        if (!loadMap(basePath, mapId, x, y))
+            return false;
+
+        TC_LOG_DEBUG("maps", "MMAP:reloadEvictedTile: Reloaded evicted mmtile {:04}[{:02}, {:02}]", mapId, x, y);
+        return true;
+    }
+
+    std::size_t MMapManager::evictTilesOverBudget(std::size_t budget, uint32 minIdleTime)
+    {
+        if (loadedTileDataSize <= budget)
+            return 0;
+
+        struct EvictionCandidate
+        {
+            uint32 IdleTime;
+            uint32 MapId;
+            uint32 PackedGridPos;
+        };
+
+        std::unique_lock<std::shared_mutex> lock(navMeshLock);
+
+        uint32 now = getMSTime();
+        std::vector<EvictionCandidate> candidates;
+        for (std::pair<uint32 const, MMapData*> const& loadedMMap : loadedMMaps)
+        {
+            if (!loadedMMap.second)
+                continue;
+
+            std::lock_guard<std::mutex> usageLock(loadedMMap.second->tileUsageLock);
+            for (std::pair<uint32 const, uint32> const& lastUseTime : loadedMMap.second->tileLastUseTimes)
+            {
+                uint32 idleTime = getMSTimeDiff(lastUseTime.second, now);
+                if (idleTime >= minIdleTime)
+                    candidates.push_back({ idleTime, loadedMMap.first, lastUseTime.first });
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end(), [](EvictionCandidate const& left, EvictionCandidate const& right)
+        {
+            return left.IdleTime > right.IdleTime;
+        });
+
+        std::size_t sizeBefore = loadedTileDataSize;
+        for (EvictionCandidate const& candidate : candidates)
+        {
+            if (loadedTileDataSize <= budget)
+                break;
+
+            MMapData* mmap = loadedMMaps[candidate.MapId];
+            auto tileRefItr = mmap->loadedTileRefs.find(candidate.PackedGridPos);
+            if (tileRefItr == mmap->loadedTileRefs.end() || !removeTile(mmap, candidate.MapId, tileRefItr))
+                continue;
+
+            std::lock_guard<std::mutex> usageLock(mmap->tileUsageLock);
+            mmap->tileLastUseTimes.erase(candidate.PackedGridPos);
+            mmap->evictedTiles[candidate.PackedGridPos] = false;
+            TC_LOG_DEBUG("maps", "MMAP:evictTilesOverBudget: Evicted mmtile {:04}[{:02}, {:02}] after being idle for {} ms",
+                candidate.MapId, candidate.PackedGridPos >> 16, candidate.PackedGridPos & 0x0000FFFF, candidate.IdleTime);
+        }
+
+        return sizeBefore - loadedTileDataSize;
+    }
+
+    std::vector<MMapTileStatistics> MMapManager::getTileStatistics()
+    {
+        std::shared_lock<std::shared_mutex> lock(navMeshLock);
+
+        std::vector<MMapTileStatistics> statistics;
+        for (std::pair<uint32 const, MMapData*> const& loadedMMap : loadedMMaps)
+        {
+            if (!loadedMMap.second)
+                continue;
+
+            MMapTileStatistics& mapStatistics = statistics.emplace_back();
+            mapStatistics.MapId = loadedMMap.first;
+            mapStatistics.Tiles = uint32(loadedMMap.second->loadedTileRefs.size());
+            for (std::pair<uint32 const, dtTileRef> const& tileRef : loadedMMap.second->loadedTileRefs)
+                if (dtMeshTile const* tile = loadedMMap.second->navMesh->getTileByRef(tileRef.second))
+                    mapStatistics.TileDataSize += tile->dataSize;
+
+            std::lock_guard<std::mutex> usageLock(loadedMMap.second->tileUsageLock);
+            mapStatistics.EvictedTiles = uint32(loadedMMap.second->evictedTiles.size());
+        }
+
+        return statistics;
+    }
+
+    NavMeshQueryPtr MMapManager::AcquireNavMeshQuery(uint32 meshMapId)
     {
         auto itr = GetMMapData(meshMapId);
         if (itr == loadedMMaps.end())
             return nullptr;
 
-        auto queryItr = itr->second->navMeshQueries.find({ instanceMapId, instanceId });
-        if (queryItr == itr->second->navMeshQueries.end())
+        MMapData* mmap = itr->second;
+        {
+            std::lock_guard<std::mutex> lock(mmap->navMeshQueriesLock);
+            if (!mmap->freeNavMeshQueries.empty())
+            {
+                dtNavMeshQuery* query = mmap->freeNavMeshQueries.back();
+                mmap->freeNavMeshQueries.pop_back();
+                return NavMeshQueryPtr(query, NavMeshQueryReleaser{ mmap });
+            }
+        }
+
+        // allocate mesh query
+        dtNavMeshQuery* query = dtAllocNavMeshQuery();
+        ASSERT(query);
+        if (dtStatusFailed(query->init(mmap->navMesh, 1024)))
+        {
+            dtFreeNavMeshQuery(query);
+            TC_LOG_ERROR("maps", "MMAP:AcquireNavMeshQuery: Failed to initialize dtNavMeshQuery for mapId {:04}", meshMapId);
             return nullptr;
+        }
 
-        return queryItr->second;
+        TC_LOG_DEBUG("maps", "MMAP:AcquireNavMeshQuery: created dtNavMeshQuery for mapId {:04}", meshMapId);
+        return NavMeshQueryPtr(query, NavMeshQueryReleaser{ mmap });
+    }
+
+    void NavMeshQueryReleaser::operator()(dtNavMeshQuery* query) const
+    {
+        std::lock_guard<std::mutex> lock(Data->navMeshQueriesLock);
+        Data->freeNavMeshQueries.push_back(query);
     }
 }
@@ -21,7 +21,10 @@
 #include "Define.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshQuery.h"
-#include "Hash.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -30,7 +33,18 @@
 namespace MMAP
 {
     typedef std::unordered_map<uint32, dtTileRef> MMapTileSet;
-    typedef std::unordered_map<std::pair<uint32, uint32>, dtNavMeshQuery*> NavMeshQuerySet;
+
+    struct MMapData;
+
+    // returns a borrowed dtNavMeshQuery to the pool of its nav mesh
+    struct TC_COMMON_API NavMeshQueryReleaser
+    {
+        MMapData* Data = nullptr;
+
+        void operator()(dtNavMeshQuery* query) const;
+    };
+
+    typedef std::unique_ptr<dtNavMeshQuery, NavMeshQueryReleaser> NavMeshQueryPtr;
 
     // dummy struct to hold map's mmap data
     struct TC_COMMON_API MMapData
@@ -38,28 +52,45 @@ namespace MMAP
         MMapData(dtNavMesh* mesh) : navMesh(mesh) { }
         ~MMapData()
         {
-            for (NavMeshQuerySet::iterator i = navMeshQueries.begin(); i != navMeshQueries.end(); ++i)
-                dtFreeNavMeshQuery(i->second);
+            for (dtNavMeshQuery* query : freeNavMeshQueries)
+                dtFreeNavMeshQuery(query);
 
             if (navMesh)
                 dtFreeNavMesh(navMesh);
         }
 
-        // we have to use single dtNavMeshQuery for every instance, since those are not thread safe
-        NavMeshQuerySet navMeshQueries;     // instanceId to query
+        // dtNavMeshQuery is not thread safe, every path calculation borrows one for its duration
+        // the pool grows to the number of queries used at the same time and is emptied when no instance uses the mesh anymore
+        std::vector<dtNavMeshQuery*> freeNavMeshQueries;
+        uint32 instanceCount = 0;
+        std::mutex navMeshQueriesLock;
 
         dtNavMesh* navMesh;
         MMapTileSet loadedTileRefs;        // maps [map grid coords] to [dtTile]
+
+        // tiles are evicted when they were not used recently and the loaded tiles are over the memory budget
+        // evicted tiles of grids that are still loaded are reloaded when they are used again
+        std::unordered_map<uint32, uint32> tileLastUseTimes;
+        std::unordered_map<uint32, bool> evictedTiles;     // maps [map grid coords] to [reload pending]
+        std::mutex tileUsageLock;
     };
 
     typedef std::unordered_map<uint32, MMapData*> MMapDataSet;
 
+    struct MMapTileStatistics
+    {
+        uint32 MapId = 0;
+        uint32 Tiles = 0;
+        std::size_t TileDataSize = 0;
+        uint32 EvictedTiles = 0;
+    };
+
     // singleton class
     // holds all all access to mmap loading unloading and meshes
     class TC_COMMON_API MMapManager
     {
         public:
-            MMapManager() : loadedTiles(0), thread_safe_environment(true) {}
+            MMapManager() : loadedTiles(0), loadedTileDataSize(0), thread_safe_environment(true) {}
             ~MMapManager();
 
             void InitializeThreadUnsafe(std::unordered_map<uint32, std::vector<uint32>> const& mapData);
@@ -69,22 +100,45 @@ namespace MMAP
             bool unloadMap(uint32 mapId);
             bool unloadMapInstance(uint32 meshMapId, uint32 instanceMapId, uint32 instanceId);
 
-            // the returned [dtNavMeshQuery const*] is NOT threadsafe
-            dtNavMeshQuery const* GetNavMeshQuery(uint32 meshMapId, uint32 instanceMapId, uint32 instanceId);
+            // borrows a query from the pool of the nav mesh, it is returned when the pointer is destroyed
+            // the returned query is only used by the caller and must not outlive the nav mesh
+            NavMeshQueryPtr AcquireNavMeshQuery(uint32 meshMapId);
             dtNavMesh const* GetNavMesh(uint32 mapId);
 
+            // for threads other than map update threads
+            // tiles cannot be loaded or unloaded while the returned lock is held, keep it for as long as a query is used
+            std::shared_lock<std::shared_mutex> LockNavMeshesForWorker() { return std::shared_lock<std::shared_mutex>(navMeshLock); }
+
+            // size of the navmesh tile data loaded for the given grid, 0 if it is not loaded
+            uint32 getTileDataSize(uint32 mapId, int32 x, int32 y) const;
+
+            // marks the tile as used, returns true if it was evicted and must be reloaded with reloadEvictedTile
+            bool touchTile(uint32 mapId, int32 x, int32 y);
+            bool reloadEvictedTile(std::string const& basePath, uint32 mapId, int32 x, int32 y);
+            // unloads least recently used tiles not used for at least minIdleTime ms until the tile data fits in the budget
+            // must not be called while map update threads use nav meshes without holding the worker lock
+            std::size_t evictTilesOverBudget(std::size_t budget, uint32 minIdleTime);
+            std::vector<MMapTileStatistics> getTileStatistics();
+
             uint32 getLoadedTilesCount() const { return loadedTiles; }
             uint32 getLoadedMapsCount() const { return uint32(loadedMMaps.size()); }
+            // navmesh tile data of all loaded tiles, the navmesh and query objects themselves are not included
+            std::size_t getMemoryUsage() const { return loadedTileDataSize; }
         private:
             bool loadMapData(std::string const& basePath, uint32 mapId);
-            uint32 packTileID(int32 x, int32 y);
+            static uint32 packTileID(int32 x, int32 y);
+            bool removeTile(MMapData* mmap, uint32 mapId, MMapTileSet::iterator tileRefItr);
 
             MMapDataSet::const_iterator GetMMapData(uint32 mapId) const;
             MMapDataSet loadedMMaps;
             uint32 loadedTiles;
+            std::atomic<std::size_t> loadedTileDataSize;
             bool thread_safe_environment;
 
             std::unordered_map<uint32, uint32> parentMapData;
+
+            // exclusively held while nav meshes are modified, shared by worker queries
+            std::shared_mutex navMeshLock;
     };
 }
 
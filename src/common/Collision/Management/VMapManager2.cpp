@@ -23,6 +23,7 @@
 #include "VMapDefinitions.h"
 #include "WorldModel.h"
 #include <G3D/Vector3.h>
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -34,13 +35,16 @@ namespace VMAP
     class ManagedModel
     {
         public:
-            ManagedModel() : iRefCount(0) { }
+            ManagedModel() : iRefCount(0), iMemoryUsage(0) { }
             WorldModel* getModel() { return &iModel; }
             void incRefCount() { ++iRefCount; }
             int decRefCount() { return --iRefCount; }
+            std::size_t getMemoryUsage() const { return iMemoryUsage; }
+            void setMemoryUsage(std::size_t memoryUsage) { iMemoryUsage = memoryUsage; }
         protected:
             WorldModel iModel;
             int iRefCount;
+            std::size_t iMemoryUsage;
     };
 
     bool readChunk(FILE* rf, char* dest, const char* compare, uint32 len)
@@ -54,6 +58,7 @@ namespace VMAP
         GetLiquidFlagsPtr = &GetLiquidFlagsDummy;
         IsVMAPDisabledForPtr = &IsVMAPDisabledForDummy;
         thread_safe_environment = true;
+        iLoadedModelFilesMemoryUsage = 0;
     }
 
     VMapManager2::~VMapManager2()
@@ -185,6 +190,24 @@ namespace VMAP
         return true;
     }
 
+    void VMapManager2::isInLineOfSight(unsigned int mapId, Vector3 const& pos, std::span<Vector3 const> targets, std::span<bool> results, ModelIgnoreFlags ignoreFlags)
+    {
+        std::fill(results.begin(), results.end(), true);
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+            return;
+
+        auto instanceTree = GetMapTree(mapId);
+        if (instanceTree == iInstanceMapTrees.end())
+            return;
+
+        std::vector<Vector3> internalTargets;
+        internalTargets.reserve(targets.size());
+        for (Vector3 const& target : targets)
+            internalTargets.push_back(convertPositionToInternalRep(target.x, target.y, target.z));
+
+        instanceTree->second->isInLineOfSight(convertPositionToInternalRep(pos.x, pos.y, pos.z), internalTargets, results, ignoreFlags);
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -238,6 +261,31 @@ namespace VMAP
         return VMAP_INVALID_HEIGHT_VALUE;
     }
 
+    void VMapManager2::getHeights(unsigned int mapId, std::span<G3D::Vector3 const> positions, std::span<float> heights, float maxSearchDist)
+    {
+        ASSERT(heights.size() >= positions.size());
+
+        InstanceTreeMap::const_iterator instanceTree = iInstanceMapTrees.cend();
+        if (isHeightCalcEnabled() && !IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_HEIGHT))
+            instanceTree = GetMapTree(mapId);
+
+        if (instanceTree == iInstanceMapTrees.end())
+        {
+            std::fill_n(heights.begin(), positions.size(), VMAP_INVALID_HEIGHT_VALUE);
+            return;
+        }
+
+        for (std::size_t i = 0; i < positions.size(); ++i)
+        {
+            Vector3 pos = convertPositionToInternalRep(positions[i].x, positions[i].y, positions[i].z);
+            float height = instanceTree->second->getHeight(pos, maxSearchDist);
+            if (!(height < G3D::finf()))
+                height = VMAP_INVALID_HEIGHT_VALUE; // No height
+
+            heights[i] = height;
+        }
+    }
+
     bool VMapManager2::getAreaAndLiquidData(unsigned int mapId, float x, float y, float z, Optional<uint8> reqLiquidType, AreaAndLiquidData& data) const
     {
         InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
@@ -285,6 +333,8 @@ namespace VMAP
             TC_LOG_DEBUG("maps", "VMapManager2: loading file '{}{}'", basepath, filename);
 
             worldmodel->getModel()->SetName(filename);
+            worldmodel->setMemoryUsage(sizeof(ManagedModel) + worldmodel->getModel()->GetMemoryUsage());
+            iLoadedModelFilesMemoryUsage += worldmodel->getMemoryUsage();
 
             model = iLoadedModelFiles.insert(std::pair<std::string, ManagedModel*>(filename, worldmodel)).first;
         }
@@ -306,6 +356,7 @@ namespace VMAP
         if (model->second->decRefCount() == 0)
         {
             TC_LOG_DEBUG("maps", "VMapManager2: unloading file '{}'", filename);
+            iLoadedModelFilesMemoryUsage -= model->second->getMemoryUsage();
             delete model->second;
             iLoadedModelFiles.erase(model);
         }
@@ -316,6 +367,18 @@ namespace VMAP
         return StaticMapTree::CanLoadMap(std::string(basePath), mapId, x, y, this);
     }
 
+    std::size_t VMapManager2::getMemoryUsage()
+    {
+        std::size_t size = 0;
+        for (auto const& [mapId, mapTree] : iInstanceMapTrees)
+            if (mapTree)
+                size += sizeof(StaticMapTree) + mapTree->GetMemoryUsage();
+
+        //! Critical section, thread safe access to iLoadedModelFiles
+        std::lock_guard<std::mutex> lock(LoadedModelFilesLock);
+        return size + iLoadedModelFilesMemoryUsage;
+    }
+
     void VMapManager2::getInstanceMapTree(InstanceTreeMap &instanceMapTree)
     {
         instanceMapTree = iInstanceMapTrees;
@@ -19,6 +19,7 @@
 #define _VMAPMANAGER2_H
 
 #include <mutex>
+#include <span>
 #include <unordered_map>
 #include <vector>
 #include "Define.h"
@@ -72,6 +73,7 @@ namespace VMAP
             bool thread_safe_environment;
             // Mutex for iLoadedModelFiles
             std::mutex LoadedModelFilesLock;
+            std::size_t iLoadedModelFilesMemoryUsage;
 
             static uint32 GetLiquidFlagsDummy(uint32) { return 0; }
             static bool IsVMAPDisabledForDummy(uint32 /*entry*/, uint8 /*flags*/) { return false; }
@@ -95,11 +97,15 @@ namespace VMAP
             void unloadMap(unsigned int mapId) override;
 
             bool isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) override ;
+            // line of sight from pos to every target (world coordinates), results[i] belongs to targets[i]
+            // the rays are traced through the map tree in packets, which is cheaper than one call per target
+            void isInLineOfSight(unsigned int mapId, G3D::Vector3 const& pos, std::span<G3D::Vector3 const> targets, std::span<bool> results, ModelIgnoreFlags ignoreFlags);
             /**
             fill the hit pos and return true, if an object was hit
             */
             bool getObjectHitPos(unsigned int mapId, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist) override;
             float getHeight(unsigned int mapId, float x, float y, float z, float maxSearchDist) override;
+            void getHeights(unsigned int mapId, std::span<G3D::Vector3 const> positions, std::span<float> heights, float maxSearchDist) override;
 
             bool processCommand(char* /*command*/) override { return false; } // for debug and extensions
 
@@ -117,6 +123,9 @@ namespace VMAP
 
             void getInstanceMapTree(InstanceTreeMap &instanceMapTree);
 
+            // loaded map trees and models
+            std::size_t getMemoryUsage();
+
             int32 getParentMapId(uint32 mapId) const;
 
             typedef uint32(*GetLiquidFlagsFn)(uint32 liquidType);
@@ -18,13 +18,17 @@
 #include "MapTree.h"
 #include "Errors.h"
 #include "Log.h"
+#include "MemoryUsage.h"
 #include "Metric.h"
 #include "ModelInstance.h"
 #include "VMapDefinitions.h"
 #include "VMapManager2.h"
 #include "WorldModel.h"
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
 #include <limits>
+#include <numeric>
 #include <sstream>
 #include <string>
 
@@ -50,6 +54,24 @@ namespace VMAP
             ModelIgnoreFlags flags;
     };
 
+    class MapRayPacketCallback
+    {
+        public:
+            MapRayPacketCallback(ModelInstance* val, ModelIgnoreFlags ignoreFlags) : prims(val), hits(0), flags(ignoreFlags) { }
+            bool operator()(std::size_t rayIndex, G3D::Ray const& ray, uint32 entry, float& distance, bool pStopAtFirstHit)
+            {
+                bool result = prims[entry].intersectRay(ray, distance, pStopAtFirstHit, flags);
+                if (result)
+                    hits |= 1u << rayIndex;
+                return result;
+            }
+            bool didHit(std::size_t rayIndex) const { return (hits & (1u << rayIndex)) != 0; }
+        protected:
+            ModelInstance* prims;
+            uint32 hits;
+            ModelIgnoreFlags flags;
+    };
+
     class LocationInfoCallback
     {
         public:
@@ -118,6 +140,35 @@ namespace VMAP
             pMaxDist = distance;
         return intersectionCallBack.didHit();
     }
+
+    void StaticMapTree::getIntersectionTimes(std::span<G3D::Ray const> rays, std::span<float> maxDists, std::span<bool> hits, bool stopAtFirstHit, ModelIgnoreFlags ignoreFlags) const
+    {
+        // neighbours in a packet should point the same way, otherwise the packet visits the union of the nodes of very different rays
+        std::vector<std::size_t> order(rays.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::sort(order, {}, [&](std::size_t index) { return std::atan2(rays[index].direction().y, rays[index].direction().x); });
+
+        for (std::size_t first = 0; first < order.size(); first += BIH::RayPacketSize)
+        {
+            std::size_t count = std::min(BIH::RayPacketSize, order.size() - first);
+            G3D::Ray packet[BIH::RayPacketSize];
+            float distances[BIH::RayPacketSize];
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                packet[i] = rays[order[first + i]];
+                distances[i] = maxDists[order[first + i]];
+            }
+
+            MapRayPacketCallback intersectionCallBack(iTreeValues, ignoreFlags);
+            iTree.intersectRays(packet, count, intersectionCallBack, distances, stopAtFirstHit);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                hits[order[first + i]] = intersectionCallBack.didHit(i);
+                if (intersectionCallBack.didHit(i))
+                    maxDists[order[first + i]] = distances[i];
+            }
+        }
+    }
     //=========================================================
 
     bool StaticMapTree::isInLineOfSight(Vector3 const& pos1, Vector3 const& pos2, ModelIgnoreFlags ignoreFlag) const
@@ -139,12 +190,66 @@ namespace VMAP
 
         return true;
     }
+
+    void StaticMapTree::isInLineOfSight(Vector3 const& pos1, std::span<Vector3 const> targets, std::span<bool> results, ModelIgnoreFlags ignoreFlags) const
+    {
+        std::vector<G3D::Ray> rays;
+        std::vector<float> maxDists;
+        std::vector<std::size_t> rayTargets;
+        rays.reserve(targets.size());
+        maxDists.reserve(targets.size());
+        rayTargets.reserve(targets.size());
+        for (std::size_t i = 0; i < targets.size(); ++i)
+        {
+            // same special cases as the single target version
+            float maxDist = (targets[i] - pos1).magnitude();
+            if (maxDist == std::numeric_limits<float>::max() || !std::isfinite(maxDist))
+            {
+                results[i] = false;
+                continue;
+            }
+
+            results[i] = true;
+            if (maxDist < 1e-10f)
+                continue;
+
+            rays.push_back(G3D::Ray::fromOriginAndDirection(pos1, (targets[i] - pos1) / maxDist));
+            maxDists.push_back(maxDist);
+            rayTargets.push_back(i);
+        }
+
+        std::unique_ptr<bool[]> hits = std::make_unique<bool[]>(rays.size());
+        getIntersectionTimes(rays, maxDists, { hits.get(), rays.size() }, true, ignoreFlags);
+        for (std::size_t i = 0; i < rays.size(); ++i)
+            results[rayTargets[i]] = !hits[i];
+    }
     //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
     Return the hit pos or the original dest pos
     */
 
+    static Vector3 applyHitPosModifyDist(Vector3 const& pPos1, Vector3 const& dir, float dist, float pModifyDist)
+    {
+        Vector3 resultHitPos = pPos1 + dir * dist;
+        if (pModifyDist < 0)
+        {
+            if ((resultHitPos - pPos1).magnitude() > -pModifyDist)
+            {
+                resultHitPos = resultHitPos + dir * pModifyDist;
+            }
+            else
+            {
+                resultHitPos = pPos1;
+            }
+        }
+        else
+        {
+            resultHitPos = resultHitPos + dir * pModifyDist;
+        }
+        return resultHitPos;
+    }
+
     bool StaticMapTree::getObjectHitPos(Vector3 const& pPos1, Vector3 const& pPos2, Vector3& pResultHitPos, float pModifyDist) const
     {
         bool result = false;
@@ -162,22 +267,7 @@ namespace VMAP
         float dist = maxDist;
         if (getIntersectionTime(ray, dist, false, ModelIgnoreFlags::Nothing))
         {
-            pResultHitPos = pPos1 + dir * dist;
-            if (pModifyDist < 0)
-            {
-                if ((pResultHitPos - pPos1).magnitude() > -pModifyDist)
-                {
-                    pResultHitPos = pResultHitPos + dir * pModifyDist;
-                }
-                else
-                {
-                    pResultHitPos = pPos1;
-                }
-            }
-            else
-            {
-                pResultHitPos = pResultHitPos + dir * pModifyDist;
-            }
+            pResultHitPos = applyHitPosModifyDist(pPos1, dir, dist, pModifyDist);
             result = true;
         }
         else
@@ -188,6 +278,43 @@ namespace VMAP
         return result;
     }
 
+    void StaticMapTree::getObjectHitPos(Vector3 const& pPos1, std::span<Vector3 const> targets, std::span<Vector3> resultHitPos, std::span<bool> results, float pModifyDist) const
+    {
+        std::vector<G3D::Ray> rays;
+        std::vector<float> maxDists;
+        std::vector<std::size_t> rayTargets;
+        rays.reserve(targets.size());
+        maxDists.reserve(targets.size());
+        rayTargets.reserve(targets.size());
+        for (std::size_t i = 0; i < targets.size(); ++i)
+        {
+            resultHitPos[i] = targets[i];
+            results[i] = false;
+
+            float maxDist = (targets[i] - pPos1).magnitude();
+            // valid map coords should *never ever* produce float overflow, but this would produce NaNs too
+            ASSERT(maxDist < std::numeric_limits<float>::max());
+            // prevent NaN values which can cause BIH intersection to enter infinite loop
+            if (maxDist < 1e-10f)
+                continue;
+
+            rays.push_back(G3D::Ray(pPos1, (targets[i] - pPos1) / maxDist));
+            maxDists.push_back(maxDist);
+            rayTargets.push_back(i);
+        }
+
+        std::unique_ptr<bool[]> hits = std::make_unique<bool[]>(rays.size());
+        getIntersectionTimes(rays, maxDists, { hits.get(), rays.size() }, false, ModelIgnoreFlags::Nothing);
+        for (std::size_t i = 0; i < rays.size(); ++i)
+        {
+            if (!hits[i])
+                continue;
+
+            resultHitPos[rayTargets[i]] = applyHitPosModifyDist(pPos1, rays[i].direction(), maxDists[i], pModifyDist);
+            results[rayTargets[i]] = true;
+        }
+    }
+
     //=========================================================
 
     float StaticMapTree::getHeight(Vector3 const& pPos, float maxSearchDist) const
@@ -478,4 +605,10 @@ namespace VMAP
         models = iTreeValues;
         count = iNTreeValues;
     }
+
+    std::size_t StaticMapTree::GetMemoryUsage() const
+    {
+        return iNTreeValues * sizeof(ModelInstance) + iTree.GetMemoryUsage() + Trinity::MemoryUsage::Of(iSpawnIndices)
+            + Trinity::MemoryUsage::Of(iLoadedTiles) + Trinity::MemoryUsage::Of(iLoadedPrimaryTiles) + Trinity::MemoryUsage::Of(iLoadedSpawns);
+    }
 }
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "BoundingIntervalHierarchy.h"
+#include <span>
 #include <unordered_map>
 
 namespace VMAP
@@ -75,6 +76,8 @@ namespace VMAP
         private:
             static TileFileOpenResult OpenMapTileFile(std::string const& basePath, uint32 mapID, uint32 tileX, uint32 tileY, VMapManager2* vm);
             bool getIntersectionTime(const G3D::Ray& pRay, float &pMaxDist, bool pStopAtFirstHit, ModelIgnoreFlags ignoreFlags) const;
+            // rays are grouped by direction and traced in packets, maxDists[i] is lowered to the hit distance when hits[i] is set
+            void getIntersectionTimes(std::span<G3D::Ray const> rays, std::span<float> maxDists, std::span<bool> hits, bool stopAtFirstHit, ModelIgnoreFlags ignoreFlags) const;
             //bool containsLoadedMapTile(unsigned int pTileIdent) const { return(iLoadedMapTiles.containsKey(pTileIdent)); }
         public:
             static std::string getTileFileName(uint32 mapID, uint32 tileX, uint32 tileY);
@@ -87,6 +90,9 @@ namespace VMAP
 
             bool isInLineOfSight(const G3D::Vector3& pos1, const G3D::Vector3& pos2, ModelIgnoreFlags ignoreFlags) const;
             bool getObjectHitPos(const G3D::Vector3& pos1, const G3D::Vector3& pos2, G3D::Vector3& pResultHitPos, float pModifyDist) const;
+            // batched versions for several targets seen from pos1, results[i] belongs to targets[i]
+            void isInLineOfSight(G3D::Vector3 const& pos1, std::span<G3D::Vector3 const> targets, std::span<bool> results, ModelIgnoreFlags ignoreFlags) const;
+            void getObjectHitPos(G3D::Vector3 const& pos1, std::span<G3D::Vector3 const> targets, std::span<G3D::Vector3> resultHitPos, std::span<bool> results, float pModifyDist) const;
             float getHeight(const G3D::Vector3& pPos, float maxSearchDist) const;
             bool GetLocationInfo(const G3D::Vector3 &pos, LocationInfo &info) const;
 
@@ -95,6 +101,8 @@ namespace VMAP
             LoadResult LoadMapTile(uint32 tileX, uint32 tileY, VMapManager2* vm);
             void UnloadMapTile(uint32 tileX, uint32 tileY, VMapManager2* vm);
             uint32 numLoadedTiles() const { return uint32(iLoadedTiles.size()); }
+            // tree and model instances, the shared models are owned by VMapManager2
+            std::size_t GetMemoryUsage() const;
             void getModelInstances(ModelInstance* &models, uint32 &count);
 
         private:
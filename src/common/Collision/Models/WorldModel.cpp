@@ -217,6 +217,11 @@ namespace VMAP
                 (iFlags ? ((iTilesX + 1) * (iTilesY + 1) * sizeof(float) + iTilesX * iTilesY) : sizeof(float));
     }
 
+    std::size_t WmoLiquid::GetMemoryUsage() const
+    {
+        return iFlags ? ((iTilesX + 1) * (iTilesY + 1) * sizeof(float) + iTilesX * iTilesY) : sizeof(float);
+    }
+
     bool WmoLiquid::writeToFile(FILE* wf)
     {
         bool result = false;
@@ -471,8 +476,24 @@ namespace VMAP
         return 0;
     }
 
+    std::size_t GroupModel::GetMemoryUsage() const
+    {
+        std::size_t size = vertices.capacity() * sizeof(Vector3) + triangles.capacity() * sizeof(MeshTriangle) + meshTree.GetMemoryUsage();
+        if (iLiquid)
+            size += sizeof(WmoLiquid) + iLiquid->GetMemoryUsage();
+        return size;
+    }
+
     // ===================== WorldModel ==================================
 
+    std::size_t WorldModel::GetMemoryUsage() const
+    {
+        std::size_t size = groupModels.capacity() * sizeof(GroupModel) + groupTree.GetMemoryUsage() + name.capacity();
+        for (GroupModel const& groupModel : groupModels)
+            size += groupModel.GetMemoryUsage();
+        return size;
+    }
+
     void WorldModel::setGroupModels(std::vector<GroupModel>& models)
     {
         groupModels.swap(models);
@@ -63,6 +63,7 @@ namespace VMAP
             float const* GetHeightStorage() const { return iHeight; }
             uint8 const* GetFlagsStorage()  const { return iFlags; }
             uint32 GetFileSize();
+            std::size_t GetMemoryUsage() const;
             bool writeToFile(FILE* wf);
             static bool readFromFile(FILE* rf, WmoLiquid* &liquid);
             void getPosInfo(uint32 &tilesX, uint32 &tilesY, G3D::Vector3 &corner) const;
@@ -103,6 +104,7 @@ namespace VMAP
             std::vector<G3D::Vector3> const& GetVertices() const { return vertices; }
             std::vector<MeshTriangle> const& GetTriangles() const { return triangles; }
             WmoLiquid const* GetLiquid() const { return iLiquid; }
+            std::size_t GetMemoryUsage() const;
         protected:
             G3D::AABox iBound;
             uint32 iMogpFlags;// 0x8 outdor; 0x2000 indoor
@@ -131,6 +133,7 @@ namespace VMAP
             std::vector<GroupModel> const& getGroupModels() const { return groupModels; }
             std::string const& GetName() const { return name; }
             void SetName(std::string newName) { name = std::move(newName); }
+            std::size_t GetMemoryUsage() const;
         protected:
             EnumFlag<ModelFlags> Flags;
             uint32 RootWMOID;
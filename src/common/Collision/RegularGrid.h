@@ -24,6 +24,7 @@
 #include <G3D/BoundsTrait.h>
 #include <G3D/PositionTrait.h>
 #include <unordered_map>
+#include <unordered_set>
 
 template<class Node>
 struct NodeCreator{
@@ -51,6 +52,7 @@ public:
 
     MemberTable memberTable;
     Node* nodes[CELL_NUMBER][CELL_NUMBER];
+    std::unordered_set<Node*> changedNodes;     // nodes modified since they were last balanced
 
     RegularGrid2D()
     {
@@ -77,6 +79,7 @@ public:
                 Node& node = getGrid(x, y);
                 node.insert(value);
                 memberTable.emplace(&value, &node);
+                changedNodes.insert(&node);
             }
         }
     }
@@ -84,17 +87,42 @@ public:
     void remove(const T& value)
     {
         for (auto& p : Trinity::Containers::MapEqualRange(memberTable, &value))
+        {
             p.second->remove(value);
+            changedNodes.insert(p.second);
+        }
         // Remove the member
         memberTable.erase(&value);
     }
 
-    void balance()
+    // rebuilds every node that changed since it was last balanced, returns the number of rebuilt nodes
+    uint32 balance()
     {
-        for (int x = 0; x < CELL_NUMBER; ++x)
-            for (int y = 0; y < CELL_NUMBER; ++y)
-                if (Node* n = nodes[x][y])
-                    n->balance();
+        uint32 rebuilt = 0;
+        for (Node* node : changedNodes)
+            if (node->balance())
+                ++rebuilt;
+
+        changedNodes.clear();
+        return rebuilt;
+    }
+
+    // only rebuilds changed nodes whose queries became too slow, the remaining changes are kept for later
+    uint32 balanceDegraded()
+    {
+        uint32 rebuilt = 0;
+        for (auto itr = changedNodes.begin(); itr != changedNodes.end();)
+        {
+            Node* node = *itr;
+            if (node->isDegraded() && node->balance())
+                ++rebuilt;
+
+            if (node->isBalanced())
+                itr = changedNodes.erase(itr);
+            else
+                ++itr;
+        }
+        return rebuilt;
     }
 
     bool contains(const T& value) const { return memberTable.count(&value) > 0; }
@@ -0,0 +1,151 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_DENSE_ID_SET_H
+#define TRINITYCORE_DENSE_ID_SET_H
+
+#include "Define.h"
+#include <bit>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace Trinity::Containers
+{
+// Set of unsigned ids stored as a bitmap, for large sets of ids from a compact range (quest ids, ...)
+// Memory is proportional to the largest id inserted, not to the number of elements
+template <class Key>
+class DenseIdSet
+{
+    static_assert(std::is_unsigned_v<Key>, "DenseIdSet only stores unsigned ids");
+
+    using Block = uint64;
+    static constexpr std::size_t BlockBits = 64;
+
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Key const*;
+        using reference = Key;
+
+        const_iterator() : _set(nullptr), _bit(0) { }
+        const_iterator(DenseIdSet const* set, std::size_t bit) : _set(set), _bit(bit) { }
+
+        reference operator*() const { return Key(_bit); }
+
+        const_iterator& operator++()
+        {
+            _bit = _set->FindNext(_bit + 1);
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            const_iterator itr = *this;
+            ++*this;
+            return itr;
+        }
+
+        friend bool operator==(const_iterator const& left, const_iterator const& right) { return left._bit == right._bit; }
+
+    private:
+        DenseIdSet const* _set;
+        std::size_t _bit;
+    };
+
+    using iterator = const_iterator;
+
+    bool empty() const { return _size == 0; }
+    std::size_t size() const { return _size; }
+
+    const_iterator begin() const { return { this, FindNext(0) }; }
+    const_iterator end() const { return { this, _blocks.size() * BlockBits }; }
+
+    bool contains(Key key) const
+    {
+        std::size_t blockIndex = std::size_t(key) / BlockBits;
+        return blockIndex < _blocks.size() && (_blocks[blockIndex] & BitOf(key)) != 0;
+    }
+
+    bool insert(Key key)
+    {
+        std::size_t blockIndex = std::size_t(key) / BlockBits;
+        if (blockIndex >= _blocks.size())
+            _blocks.resize(blockIndex + 1);
+
+        Block& block = _blocks[blockIndex];
+        if (block & BitOf(key))
+            return false;
+
+        block |= BitOf(key);
+        ++_size;
+        return true;
+    }
+
+    std::size_t erase(Key key)
+    {
+        if (!contains(key))
+            return 0;
+
+        _blocks[std::size_t(key) / BlockBits] &= ~BitOf(key);
+        --_size;
+
+        while (!_blocks.empty() && !_blocks.back())
+            _blocks.pop_back();
+
+        return 1;
+    }
+
+    void clear()
+    {
+        _blocks.clear();
+        _size = 0;
+    }
+
+    void shrink_to_fit() { _blocks.shrink_to_fit(); }
+
+private:
+    static Block BitOf(Key key) { return Block(1) << (std::size_t(key) % BlockBits); }
+
+    std::size_t FindNext(std::size_t bit) const
+    {
+        std::size_t blockIndex = bit / BlockBits;
+        if (blockIndex >= _blocks.size())
+            return _blocks.size() * BlockBits;
+
+        Block block = _blocks[blockIndex] & (~Block(0) << (bit % BlockBits));
+        while (!block)
+        {
+            if (++blockIndex == _blocks.size())
+                return _blocks.size() * BlockBits;
+
+            block = _blocks[blockIndex];
+        }
+
+        return blockIndex * BlockBits + std::countr_zero(block);
+    }
+
+    std::vector<Block> _blocks;
+    std::size_t _size = 0;
+};
+}
+
+#endif // TRINITYCORE_DENSE_ID_SET_H
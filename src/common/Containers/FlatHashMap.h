@@ -0,0 +1,59 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_FLAT_HASH_MAP_H
+#define TRINITYCORE_FLAT_HASH_MAP_H
+
+#include "FlatHashTable.h"
+#include <tuple>
+
+namespace Trinity::Containers
+{
+namespace Impl
+{
+struct FlatHashMapKeyOf
+{
+    template <class Pair>
+    auto const& operator()(Pair const& pair) const { return pair.first; }
+};
+}
+
+// Unordered map storing its pairs in one contiguous array, mapped types must be default constructible and movable
+// Unlike std::unordered_map, insert and erase invalidate all iterators and references to values
+template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatHashMap : public Impl::FlatHashTable<std::pair<Key, T>, Key, Impl::FlatHashMapKeyOf, Hash, KeyEqual>
+{
+    using Base = Impl::FlatHashTable<std::pair<Key, T>, Key, Impl::FlatHashMapKeyOf, Hash, KeyEqual>;
+
+public:
+    using mapped_type = T;
+    using typename Base::iterator;
+
+    template <class... Args>
+    std::pair<iterator, bool> try_emplace(Key const& key, Args&&... args)
+    {
+        auto [index, inserted] = this->InsertWith(key, [&]() { return std::pair<Key, T>(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...)); });
+        return { iterator(this, index), inserted };
+    }
+
+    std::pair<iterator, bool> insert(std::pair<Key, T> const& value) { return try_emplace(value.first, value.second); }
+
+    T& operator[](Key const& key) { return try_emplace(key).first->second; }
+};
+}
+
+#endif // TRINITYCORE_FLAT_HASH_MAP_H
@@ -0,0 +1,57 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_FLAT_HASH_SET_H
+#define TRINITYCORE_FLAT_HASH_SET_H
+
+#include "FlatHashTable.h"
+
+namespace Trinity::Containers
+{
+namespace Impl
+{
+struct FlatHashSetKeyOf
+{
+    template <class Key>
+    Key const& operator()(Key const& key) const { return key; }
+};
+}
+
+// Unordered set storing its keys in one contiguous array, for small trivially copyable keys looked up in hot paths
+// Unlike std::unordered_set, insert and erase invalidate all iterators
+template <class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatHashSet : public Impl::FlatHashTable<Key, Key, Impl::FlatHashSetKeyOf, Hash, KeyEqual>
+{
+    using Base = Impl::FlatHashTable<Key, Key, Impl::FlatHashSetKeyOf, Hash, KeyEqual>;
+
+public:
+    using iterator = typename Base::const_iterator;
+    using const_iterator = typename Base::const_iterator;
+
+    const_iterator begin() const { return Base::begin(); }
+    const_iterator end() const { return Base::end(); }
+    const_iterator find(Key const& key) const { return Base::find(key); }
+
+    std::pair<const_iterator, bool> insert(Key const& key)
+    {
+        auto [index, inserted] = this->InsertWith(key, [&]() { return key; });
+        return { const_iterator(this, index), inserted };
+    }
+};
+}
+
+#endif // TRINITYCORE_FLAT_HASH_SET_H
@@ -0,0 +1,228 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_FLAT_HASH_TABLE_H
+#define TRINITYCORE_FLAT_HASH_TABLE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace Trinity::Containers::Impl
+{
+// Open addressing hash table with linear probing, elements live in a single array
+// Erasing shifts the following elements of the probe sequence back instead of leaving tombstones
+// Any insertion or erasure invalidates all iterators and references
+template <class Value, class Key, class KeyOf, class Hash, class KeyEqual>
+class FlatHashTable
+{
+    template <bool Const>
+    class IteratorImpl
+    {
+        using TablePtr = std::conditional_t<Const, FlatHashTable const*, FlatHashTable*>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, Value const*, Value*>;
+        using reference = std::conditional_t<Const, Value const&, Value&>;
+
+        IteratorImpl() = default;
+        IteratorImpl(TablePtr table, std::size_t index) : _table(table), _index(index) { SkipUnused(); }
+        operator IteratorImpl<true>() const requires (!Const) { return { _table, _index }; }
+
+        reference operator*() const { return _table->_values[_index]; }
+        pointer operator->() const { return &_table->_values[_index]; }
+
+        IteratorImpl& operator++() { ++_index; SkipUnused(); return *this; }
+        IteratorImpl operator++(int) { IteratorImpl copy = *this; ++*this; return copy; }
+
+        friend bool operator==(IteratorImpl const& left, IteratorImpl const& right) { return left._index == right._index; }
+
+    private:
+        void SkipUnused()
+        {
+            while (_index < _table->_used.size() && !_table->_used[_index])
+                ++_index;
+        }
+
+        TablePtr _table = nullptr;
+        std::size_t _index = 0;
+    };
+
+public:
+    using key_type = Key;
+    using value_type = Value;
+    using size_type = std::size_t;
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+
+    bool empty() const { return _size == 0; }
+    size_type size() const { return _size; }
+    size_type capacity() const { return _used.size(); }
+
+    iterator begin() { return { this, 0 }; }
+    const_iterator begin() const { return { this, 0 }; }
+    iterator end() { return { this, _used.size() }; }
+    const_iterator end() const { return { this, _used.size() }; }
+
+    iterator find(Key const& key) { return { this, FindIndex(key) }; }
+    const_iterator find(Key const& key) const { return { this, FindIndex(key) }; }
+    bool contains(Key const& key) const { return FindIndex(key) != _used.size(); }
+    size_type count(Key const& key) const { return contains(key) ? 1 : 0; }
+
+    size_type erase(Key const& key)
+    {
+        std::size_t index = FindIndex(key);
+        if (index == _used.size())
+            return 0;
+
+        EraseIndex(index);
+        return 1;
+    }
+
+    void clear()
+    {
+        for (std::size_t i = 0; i < _used.size(); ++i)
+        {
+            if (_used[i])
+            {
+                _values[i] = Value();
+                _used[i] = 0;
+            }
+        }
+        _size = 0;
+    }
+
+    void reserve(size_type count)
+    {
+        if (count <= MaxSizeFor(_used.size()))
+            return;
+
+        std::size_t capacity = std::max<std::size_t>(std::bit_ceil(count + count / 7 + 1), 8);
+        Rehash(capacity);
+    }
+
+protected:
+    // returns the index of the element with the key of value and whether it was inserted
+    template <class ValueFactory>
+    std::pair<std::size_t, bool> InsertWith(Key const& key, ValueFactory&& factory)
+    {
+        if (_size + 1 > MaxSizeFor(_used.size()))
+            Rehash(std::max<std::size_t>(_used.size() * 2, 8));
+
+        std::size_t mask = _used.size() - 1;
+        std::size_t index = GetBucket(key);
+        while (_used[index])
+        {
+            if (KeyEqual()(KeyOf()(_values[index]), key))
+                return { index, false };
+            index = (index + 1) & mask;
+        }
+
+        _values[index] = factory();
+        _used[index] = 1;
+        ++_size;
+        return { index, true };
+    }
+
+private:
+    // keeps at least one eighth of the slots free so probe sequences stay short
+    static std::size_t MaxSizeFor(std::size_t capacity) { return capacity - capacity / 8; }
+
+    std::size_t GetBucket(Key const& key) const
+    {
+        // fibonacci hashing takes the top bits so hashers with weak low bits (sequential guid counters) still spread out
+        return std::size_t((std::uint64_t(Hash()(key)) * UINT64_C(0x9E3779B97F4A7C15)) >> _shift);
+    }
+
+    std::size_t FindIndex(Key const& key) const
+    {
+        if (!_size)
+            return _used.size();
+
+        std::size_t mask = _used.size() - 1;
+        std::size_t index = GetBucket(key);
+        while (_used[index])
+        {
+            if (KeyEqual()(KeyOf()(_values[index]), key))
+                return index;
+            index = (index + 1) & mask;
+        }
+
+        return _used.size();
+    }
+
+    void EraseIndex(std::size_t hole)
+    {
+        std::size_t mask = _used.size() - 1;
+        std::size_t index = hole;
+        while (true)
+        {
+            index = (index + 1) & mask;
+            if (!_used[index])
+                break;
+
+            // elements whose home bucket is cyclically in (hole, index] are still reachable and stay where they are
+            std::size_t bucket = GetBucket(KeyOf()(_values[index]));
+            if (hole <= index ? (hole < bucket && bucket <= index) : (hole < bucket || bucket <= index))
+                continue;
+
+            _values[hole] = std::move(_values[index]);
+            hole = index;
+        }
+
+        _values[hole] = Value();
+        _used[hole] = 0;
+        --_size;
+    }
+
+    void Rehash(std::size_t capacity)
+    {
+        std::vector<Value> oldValues = std::exchange(_values, std::vector<Value>(capacity));
+        std::vector<std::uint8_t> oldUsed = std::exchange(_used, std::vector<std::uint8_t>(capacity));
+        _shift = 64 - std::countr_zero(capacity);
+
+        std::size_t mask = capacity - 1;
+        for (std::size_t i = 0; i < oldUsed.size(); ++i)
+        {
+            if (!oldUsed[i])
+                continue;
+
+            std::size_t index = GetBucket(KeyOf()(oldValues[i]));
+            while (_used[index])
+                index = (index + 1) & mask;
+
+            _values[index] = std::move(oldValues[i]);
+            _used[index] = 1;
+        }
+    }
+
+    std::vector<Value> _values;
+    std::vector<std::uint8_t> _used;
+    std::size_t _size = 0;
+    int _shift = 64;
+};
+}
+
+#endif // TRINITYCORE_FLAT_HASH_TABLE_H
@@ -31,6 +31,7 @@ public:
 
     bool empty() const { return _storage.empty(); }
     auto size() const { return _storage.size(); }
+    auto capacity() const { return _storage.capacity(); }
 
     auto begin()  { return _storage.begin(); }
     auto begin() const { return _storage.begin(); }
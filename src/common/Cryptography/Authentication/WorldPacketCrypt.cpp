@@ -82,3 +82,26 @@ bool WorldPacketCrypt::EncryptSend(uint8* data, size_t length, Trinity::Crypto::
     ++_serverCounter;
     return true;
 }
+
+bool WorldPacketCrypt::EncryptSendBatch(std::span<SendRequest const> requests)
+{
+    if (!_initialized)
+    {
+        for (SendRequest const& request : requests)
+            memset(*request.Tag, 0, sizeof(*request.Tag));
+
+        _serverCounter += requests.size();
+        return true;
+    }
+
+    for (SendRequest const& request : requests)
+    {
+        WorldPacketCryptIV iv{ _serverCounter, 0x52565253 };
+        if (!_serverEncrypt.Process(iv.Value, request.Data, request.Length, *request.Tag))
+            return false;
+
+        ++_serverCounter;
+    }
+
+    return true;
+}
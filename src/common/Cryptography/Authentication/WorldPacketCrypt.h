@@ -19,6 +19,7 @@
 #define _WORLDPACKETCRYPT_H
 
 #include "AES.h"
+#include <span>
 
 class TC_COMMON_API WorldPacketCrypt
 {
@@ -30,6 +31,16 @@ public:
     bool DecryptRecv(uint8* data, size_t length, Trinity::Crypto::AES::Tag& tag);
     bool EncryptSend(uint8* data, size_t length, Trinity::Crypto::AES::Tag& tag);
 
+    struct SendRequest
+    {
+        uint8* Data;
+        size_t Length;
+        Trinity::Crypto::AES::Tag* Tag;
+    };
+
+    // encrypts packets in order back to back, same result as calling EncryptSend for each of them
+    bool EncryptSendBatch(std::span<SendRequest const> requests);
+
     bool IsInitialized() const { return _initialized; }
 
 protected:
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CryptoWorkerPool.h"
+
+Trinity::Crypto::WorkerPool::WorkerPool() : _maxQueuedTasks(0), _stopping(false), _rejected(0)
+{
+}
+
+Trinity::Crypto::WorkerPool::~WorkerPool()
+{
+    Stop();
+}
+
+Trinity::Crypto::WorkerPool& Trinity::Crypto::WorkerPool::Instance()
+{
+    static WorkerPool instance;
+    return instance;
+}
+
+void Trinity::Crypto::WorkerPool::Start(uint32 threadCount, uint32 maxQueuedTasks)
+{
+    Stop();
+
+    std::lock_guard lock(_lock);
+    _stopping = false;
+    _maxQueuedTasks = maxQueuedTasks;
+    _threads.reserve(threadCount);
+    for (uint32 i = 0; i < threadCount; ++i)
+        _threads.emplace_back(&WorkerPool::WorkerThread, this);
+}
+
+void Trinity::Crypto::WorkerPool::Stop()
+{
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard lock(_lock);
+        _stopping = true;
+        threads.swap(_threads);
+    }
+
+    _condition.notify_all();
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+std::size_t Trinity::Crypto::WorkerPool::GetQueueDepth() const
+{
+    std::lock_guard lock(_lock);
+    return _tasks.size();
+}
+
+bool Trinity::Crypto::WorkerPool::Enqueue(std::function<void()>&& task)
+{
+    {
+        std::unique_lock lock(_lock);
+        if (!_threads.empty())
+        {
+            if (_tasks.size() >= _maxQueuedTasks)
+            {
+                _rejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            _tasks.push_back(std::move(task));
+            lock.unlock();
+            _condition.notify_one();
+            return true;
+        }
+    }
+
+    task();
+    return true;
+}
+
+void Trinity::Crypto::WorkerPool::WorkerThread()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(_lock);
+            _condition.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+            if (_tasks.empty())
+                return;
+
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+
+        task();
+    }
+}
@@ -0,0 +1,140 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_CRYPTO_WORKER_POOL_H
+#define TRINITY_CRYPTO_WORKER_POOL_H
+
+#include "Define.h"
+#include "Optional.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Trinity::Crypto
+{
+// Result of work posted to a WorkerPool
+// Its callback runs on the thread processing it with AsyncCallbackProcessor, like QueryCallback does for database results
+class WorkerCallback
+{
+public:
+    template<typename Result, typename Callback>
+    WorkerCallback(std::future<Result>&& result, Callback&& callback)
+        : _impl(std::make_unique<Impl<Result, std::decay_t<Callback>>>(std::move(result), std::forward<Callback>(callback))) { }
+
+    WorkerCallback(WorkerCallback&& other) noexcept = default;
+    WorkerCallback& operator=(WorkerCallback&& other) noexcept = default;
+
+    // returns true when completed
+    bool InvokeIfReady() { return _impl->InvokeIfReady(); }
+
+private:
+    struct ImplBase
+    {
+        virtual ~ImplBase() = default;
+        virtual bool InvokeIfReady() = 0;
+    };
+
+    template<typename Result, typename Callback>
+    struct Impl final : ImplBase
+    {
+        template<typename CallbackArg>
+        Impl(std::future<Result>&& result, CallbackArg&& callback) : _result(std::move(result)), _callback(std::forward<CallbackArg>(callback)) { }
+
+        bool InvokeIfReady() override
+        {
+            if (_result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return false;
+
+            _callback(_result.get());
+            return true;
+        }
+
+        std::future<Result> _result;
+        Callback _callback;
+    };
+
+    std::unique_ptr<ImplBase> _impl;
+};
+
+// Bounded pool of threads for expensive cryptography (password hashing, SRP verification)
+// that would otherwise stall the network thread handling the request together with all other sockets on it
+// Work is rejected instead of queued once MaxQueuedTasks are waiting, callers are expected to answer with a "try again later"
+// when their callback receives no result
+// Without worker threads work runs immediately on the posting thread and is never rejected
+class TC_COMMON_API WorkerPool
+{
+public:
+    WorkerPool();
+    ~WorkerPool();
+
+    WorkerPool(WorkerPool const&) = delete;
+    WorkerPool& operator=(WorkerPool const&) = delete;
+
+    static WorkerPool& Instance();
+
+    void Start(uint32 threadCount, uint32 maxQueuedTasks);
+    // runs all queued work before returning
+    void Stop();
+
+    // callback receives the result of work, or nothing when the work was rejected
+    template<typename Work, typename Callback>
+    WorkerCallback Post(Work&& work, Callback&& callback)
+    {
+        using Result = std::invoke_result_t<std::decay_t<Work>&>;
+        static_assert(!std::is_void_v<Result>, "Work must produce a result");
+
+        std::shared_ptr<std::packaged_task<Optional<Result>()>> task = std::make_shared<std::packaged_task<Optional<Result>()>>(
+            [work = std::forward<Work>(work)]() mutable -> Optional<Result> { return work(); });
+
+        std::future<Optional<Result>> result = task->get_future();
+        if (!Enqueue([task] { (*task)(); }))
+        {
+            std::promise<Optional<Result>> rejected;
+            rejected.set_value(std::nullopt);
+            result = rejected.get_future();
+        }
+
+        return WorkerCallback(std::move(result), std::forward<Callback>(callback));
+    }
+
+    std::size_t GetQueueDepth() const;
+    uint64 GetRejectedCount() const { return _rejected.load(std::memory_order_relaxed); }
+
+private:
+    bool Enqueue(std::function<void()>&& task);
+    void WorkerThread();
+
+    mutable std::mutex _lock;
+    std::condition_variable _condition;
+    std::deque<std::function<void()>> _tasks;
+    std::vector<std::thread> _threads;
+    std::size_t _maxQueuedTasks;
+    bool _stopping;
+    std::atomic<uint64> _rejected;
+};
+}
+
+#define sCryptoWorkerPool Trinity::Crypto::WorkerPool::Instance()
+
+#endif // TRINITY_CRYPTO_WORKER_POOL_H
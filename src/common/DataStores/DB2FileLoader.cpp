@@ -155,6 +155,11 @@ int32 DB2FileLoadInfo::GetFieldIndexByMetaIndex(uint32 metaIndex) const
 DB2FileSource::DB2FileSource() = default;
 DB2FileSource::~DB2FileSource() = default;
 
+uint8 const* DB2FileSource::GetMappedData(int64 /*position*/, std::size_t /*numBytes*/) const
+{
+    return nullptr;
+}
+
 class DB2FileLoaderImpl
 {
 public:
@@ -256,7 +261,9 @@ private:
     DB2FileLoadInfo const* _loadInfo;
     DB2Header const* _header;
     std::unique_ptr<uint8[]> _data;
-    uint8* _stringTable;
+    uint8 const* _recordData;       // _data or the mapped file when it could be used in place
+    uint8 const* _stringTable;
+    bool _mapped;
     std::unique_ptr<DB2SectionHeader[]> _sections;
     std::unique_ptr<DB2ColumnMeta[]> _columnMeta;
     std::unique_ptr<std::unique_ptr<DB2PalletValue[]>[]> _palletValues;
@@ -338,7 +345,9 @@ DB2FileLoaderRegularImpl::DB2FileLoaderRegularImpl(char const* fileName, DB2File
     _fileName(fileName),
     _loadInfo(loadInfo),
     _header(header),
-    _stringTable(nullptr)
+    _recordData(nullptr),
+    _stringTable(nullptr),
+    _mapped(false)
 {
 }
 
@@ -355,9 +364,30 @@ void DB2FileLoaderRegularImpl::LoadColumnData(std::unique_ptr<DB2SectionHeader[]
 
 bool DB2FileLoaderRegularImpl::LoadTableData(DB2FileSource* source, uint32 section)
 {
+    if (_mapped)
+        return true;
+
     if (!_data)
     {
+        // a single section is laid out in the file exactly like _data, records followed by strings (and at least 8 more bytes for packed reads)
+        if (_header->SectionCount == 1)
+        {
+            int64 position = source->GetPosition();
+            std::size_t size = _header->RecordSize * _header->RecordCount + _header->StringTableSize;
+            if (uint8 const* mapped = source->GetMappedData(position, size + 8))
+            {
+                if (!source->SetPosition(position + size))
+                    return false;
+
+                _recordData = mapped;
+                _stringTable = &mapped[_header->RecordSize * _header->RecordCount];
+                _mapped = true;
+                return true;
+            }
+        }
+
         _data = std::make_unique<uint8[]>(_header->RecordSize * _header->RecordCount + _header->StringTableSize + 8);
+        _recordData = _data.get();
         _stringTable = &_data[_header->RecordSize * _header->RecordCount];
     }
 
@@ -372,7 +402,7 @@ bool DB2FileLoaderRegularImpl::LoadTableData(DB2FileSource* source, uint32 secti
     if (_sections[section].RecordCount && !source->Read(&_data[sectionDataStart], _header->RecordSize * _sections[section].RecordCount))
         return false;
 
-    if (_sections[section].StringTableSize && !source->Read(&_stringTable[sectionStringTableStart], _sections[section].StringTableSize))
+    if (_sections[section].StringTableSize && !source->Read(&_data[_header->RecordSize * _header->RecordCount + sectionStringTableStart], _sections[section].StringTableSize))
         return false;
 
     return true;
@@ -537,8 +567,21 @@ char* DB2FileLoaderRegularImpl::AutoProduceStrings(char** indexTable, uint32 ind
     if (!_loadInfo->GetStringFieldCount(false))
         return nullptr;
 
-    char* stringPool = new char[_header->StringTableSize];
-    memcpy(stringPool, _stringTable, _header->StringTableSize);
+    // strings of a mapped file are used in place, the source is kept alive by the caller
+    char* stringPool = nullptr;
+    if (!_mapped)
+    {
+        stringPool = new char[_header->StringTableSize];
+        memcpy(stringPool, _stringTable, _header->StringTableSize);
+    }
+
+    auto getPooledString = [&](char const* string)
+    {
+        if (!stringPool)
+            return const_cast<char*>(string);
+
+        return stringPool + (string - reinterpret_cast<char const*>(_stringTable));
+    };
 
     uint32 y = 0;
 
@@ -594,13 +637,13 @@ char* DB2FileLoaderRegularImpl::AutoProduceStrings(char** indexTable, uint32 ind
                             break;
                         case FT_STRING:
                             if (char const* string = RecordGetString(rawRecord, x, z))
-                                reinterpret_cast<LocalizedString*>(&recordData[offset])->Str[locale] = stringPool + (string - reinterpret_cast<char const*>(_stringTable));
+                                reinterpret_cast<LocalizedString*>(&recordData[offset])->Str[locale] = getPooledString(string);
 
                             offset += sizeof(LocalizedString);
                             break;
                         case FT_STRING_NOT_LOCALIZED:
                             if (char const* string = RecordGetString(rawRecord, x, z))
-                                *reinterpret_cast<char**>(&recordData[offset]) = stringPool + (string - reinterpret_cast<char const*>(_stringTable));
+                                *reinterpret_cast<char**>(&recordData[offset]) = getPooledString(string);
 
                             offset += sizeof(char*);
                             break;
@@ -749,7 +792,7 @@ unsigned char const* DB2FileLoaderRegularImpl::GetRawRecordData(uint32 recordNum
     if (!IsKnownTactId(GetSection(section ? *section : GetRecordSection(recordNumber)).TactId))
         return nullptr;
 
-    return &_data[recordNumber * _header->RecordSize];
+    return &_recordData[recordNumber * _header->RecordSize];
 }
 
 uint32 DB2FileLoaderRegularImpl::RecordGetId(uint8 const* record, uint32 recordIndex) const
@@ -823,7 +866,7 @@ T DB2FileLoaderRegularImpl::RecordGetVarInt(uint8 const* record, uint32 field, u
         }
         case DB2ColumnCompression::CommonData:
         {
-            uint32 id = RecordGetId(record, (record - _data.get()) / _header->RecordSize);
+            uint32 id = RecordGetId(record, (record - _recordData) / _header->RecordSize);
             T value;
             auto valueItr = _commonValues[field].find(id);
             if (valueItr != _commonValues[field].end())
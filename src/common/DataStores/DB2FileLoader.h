@@ -124,6 +124,10 @@ struct TC_COMMON_API DB2FileSource
     virtual char const* GetFileName() const = 0;
 
     virtual DB2EncryptedSectionHandling HandleEncryptedSection(DB2SectionHeader const& sectionHeader) const = 0;
+
+    // Returns numBytes bytes at position from memory that stays valid for the lifetime of the source (a file mapping)
+    // or nullptr when the source has no such memory. Loaded strings may point into it, such sources must outlive the records using them
+    virtual uint8 const* GetMappedData(int64 position, std::size_t numBytes) const;
 };
 
 class TC_COMMON_API DB2Record
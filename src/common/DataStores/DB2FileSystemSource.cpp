@@ -17,10 +17,26 @@
 
 #include "DB2FileSystemSource.h"
 #include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <cstring>
 
-DB2FileSystemSource::DB2FileSystemSource(std::string const& fileName)
+DB2FileSystemSource::DB2FileSystemSource(std::string const& fileName, bool mapFile /*= false*/) : _file(nullptr), _position(0)
 {
     _fileName = fileName;
+    if (mapFile)
+    {
+        // mapping fails for missing and empty files, those are handled by the regular file access below
+        try
+        {
+            _mapping = std::make_unique<boost::iostreams::mapped_file_source>(_fileName);
+            return;
+        }
+        catch (std::exception const&)
+        {
+            _mapping = nullptr;
+        }
+    }
+
     _file = fopen(_fileName.c_str(), "rb");
 }
 
@@ -32,26 +48,51 @@ DB2FileSystemSource::~DB2FileSystemSource()
 
 bool DB2FileSystemSource::IsOpen() const
 {
-    return _file != nullptr;
+    return _mapping || _file != nullptr;
 }
 
 bool DB2FileSystemSource::Read(void* buffer, std::size_t numBytes)
 {
+    if (_mapping)
+    {
+        if (_position < 0 || std::size_t(_position) + numBytes > _mapping->size())
+            return false;
+
+        memcpy(buffer, _mapping->data() + _position, numBytes);
+        _position += numBytes;
+        return true;
+    }
+
     return fread(buffer, numBytes, 1, _file) == 1;
 }
 
 int64 DB2FileSystemSource::GetPosition() const
 {
+    if (_mapping)
+        return _position;
+
     return ftell(_file);
 }
 
 bool DB2FileSystemSource::SetPosition(int64 position)
 {
+    if (_mapping)
+    {
+        if (position < 0 || std::size_t(position) > _mapping->size())
+            return false;
+
+        _position = position;
+        return true;
+    }
+
     return fseek(_file, position, SEEK_SET) == 0;
 }
 
 int64 DB2FileSystemSource::GetFileSize() const
 {
+    if (_mapping)
+        return _mapping->size();
+
     boost::system::error_code error;
     int64 size = boost::filesystem::file_size(_fileName, error);
     return !error ? size : 0;
@@ -66,3 +107,11 @@ DB2EncryptedSectionHandling DB2FileSystemSource::HandleEncryptedSection(DB2Secti
 {
     return DB2EncryptedSectionHandling::Skip;
 }
+
+uint8 const* DB2FileSystemSource::GetMappedData(int64 position, std::size_t numBytes) const
+{
+    if (!_mapping || position < 0 || std::size_t(position) + numBytes > _mapping->size())
+        return nullptr;
+
+    return reinterpret_cast<uint8 const*>(_mapping->data()) + position;
+}
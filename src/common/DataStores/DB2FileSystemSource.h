@@ -19,11 +19,18 @@
 #define DB2FileSystemSource_h__
 
 #include "DB2FileLoader.h"
+#include <memory>
 #include <string>
 
+namespace boost::iostreams
+{
+class mapped_file_source;
+}
+
 struct TC_COMMON_API DB2FileSystemSource : public DB2FileSource
 {
-    DB2FileSystemSource(std::string const& fileName);
+    // mapped sources read the file through a read only mapping shared with other processes and let the loader use it in place
+    DB2FileSystemSource(std::string const& fileName, bool mapFile = false);
     DB2FileSystemSource(DB2FileSystemSource const& other) = delete;
     DB2FileSystemSource(DB2FileSystemSource&& other) noexcept = delete;
     DB2FileSystemSource& operator=(DB2FileSystemSource const& other) = delete;
@@ -36,10 +43,14 @@ struct TC_COMMON_API DB2FileSystemSource : public DB2FileSource
     int64 GetFileSize() const override;
     char const* GetFileName() const override;
     DB2EncryptedSectionHandling HandleEncryptedSection(DB2SectionHeader const& sectionHeader) const override;
+    uint8 const* GetMappedData(int64 position, std::size_t numBytes) const override;
+    bool IsMapped() const { return _mapping != nullptr; }
 
 private:
     std::string _fileName;
     FILE* _file;
+    std::unique_ptr<boost::iostreams::mapped_file_source> _mapping;
+    int64 _position;
 };
 
 #endif // DB2FileSystemSource_h__
@@ -20,10 +20,66 @@
 #include "Errors.h"
 #include "IpAddress.h"
 #include "Log.h"
-#include "StringConvert.h"
+#include "Optional.h"
 #include "Util.h"
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <unordered_map>
+
+namespace
+{
+// all sections of the cache file follow this header, in order:
+// uint32 ipv4From[Ipv4Count], uint32 ipv4To[Ipv4Count], Ipv6Key ipv6From[Ipv6Count], Ipv6Key ipv6To[Ipv6Count],
+// uint16 ipv4Country[Ipv4Count], uint16 ipv6Country[Ipv6Count], CountryCount * (uint8 length, code, uint8 length, name)
+// the file is only ever read by the process that wrote it (same endianness and layout)
+struct IpLocationCacheHeader
+{
+    std::array<char, 4> Magic;
+    uint32 Version;
+    uint64 SourceSize;
+    int64 SourceWriteTime;
+    uint32 Ipv4Count;
+    uint32 Ipv6Count;
+    uint32 CountryCount;
+    uint32 CountriesSize;
+};
+
+constexpr std::array<char, 4> CacheMagic = { 'T', 'C', 'I', 'P' };
+constexpr uint32 CacheVersion = 1;
+
+// the CSV stores addresses as decimal numbers, IPv6 ones do not fit in 64 bits
+template<typename Key>
+Optional<Key> ParseIpNumber(std::string_view number)
+{
+    if (number.empty())
+        return {};
+
+    uint64 high = 0;
+    uint64 low = 0;
+    for (char c : number)
+    {
+        if (c < '0' || c > '9')
+            return {};
+
+        // multiply the 128 bit value by 10 in 32 bit halves of its low part to keep the carry
+        uint64 part0 = (low & 0xFFFFFFFF) * 10 + uint64(c - '0');
+        uint64 part1 = (low >> 32) * 10 + (part0 >> 32);
+        uint64 carry = part1 >> 32;
+        if (high > (std::numeric_limits<uint64>::max() - carry) / 10)
+            return {};
+
+        low = (part1 << 32) | (part0 & 0xFFFFFFFF);
+        high = high * 10 + carry;
+    }
+
+    return Key{ high, low };
+}
+}
 
 IpLocationStore::IpLocationStore()
 {
@@ -33,29 +89,113 @@ IpLocationStore::~IpLocationStore()
 {
 }
 
+void IpLocationStore::Clear()
+{
+    _ipv4From = {};
+    _ipv4To = {};
+    _ipv4Country = {};
+    _ipv6From = {};
+    _ipv6To = {};
+    _ipv6Country = {};
+    _countries.clear();
+    _image.clear();
+    _image.shrink_to_fit();
+    _mapping = nullptr;
+}
+
 void IpLocationStore::Load()
 {
-    _ipLocationStore.clear();
+    Clear();
     TC_LOG_INFO("server.loading", "Loading IP Location Database...");
 
     std::string databaseFilePath = sConfigMgr->GetStringDefault("IPLocationFile", "");
     if (databaseFilePath.empty())
         return;
 
-    // Check if file exists
-    std::ifstream databaseFile(databaseFilePath);
-    if (!databaseFile)
+    if (!LoadFile(databaseFilePath))
+        return;
+
+    TC_LOG_INFO("server.loading", ">> Loaded {} ip location entries{}.", _ipv4From.size() + _ipv6From.size(), IsMapped() ? " from cache" : "");
+}
+
+bool IpLocationStore::LoadFile(std::string const& databaseFilePath)
+{
+    Clear();
+
+    boost::system::error_code error;
+    uint64 sourceSize = boost::filesystem::file_size(databaseFilePath, error);
+    if (error)
     {
         TC_LOG_ERROR("server.loading", "IPLocation: No ip database file exists ({}).", databaseFilePath);
-        return;
+        return false;
+    }
+
+    int64 sourceWriteTime = int64(boost::filesystem::last_write_time(databaseFilePath, error));
+
+    std::string cacheFilePath = databaseFilePath + ".cache";
+    if (LoadCache(cacheFilePath, sourceSize, sourceWriteTime))
+        return true;
+
+    if (!ParseCsv(databaseFilePath, sourceSize, sourceWriteTime))
+        return false;
+
+    std::ofstream cacheFile(cacheFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!cacheFile || !cacheFile.write(reinterpret_cast<char const*>(_image.data()), _image.size() * sizeof(uint64)))
+        TC_LOG_WARN("server.loading", "IPLocation: Could not write cache file {}, ip database will be parsed again on next startup.", cacheFilePath);
+
+    return true;
+}
+
+bool IpLocationStore::LoadCache(std::string const& cacheFilePath, uint64 sourceSize, int64 sourceWriteTime)
+{
+    boost::system::error_code error;
+    if (!boost::filesystem::exists(cacheFilePath, error))
+        return false;
+
+    try
+    {
+        _mapping = std::make_unique<boost::iostreams::mapped_file_source>(cacheFilePath);
     }
+    catch (std::exception const&)
+    {
+        _mapping = nullptr;
+        return false;
+    }
+
+    uint8 const* data = reinterpret_cast<uint8 const*>(_mapping->data());
+    IpLocationCacheHeader header;
+    if (_mapping->size() >= sizeof(header))
+    {
+        std::memcpy(&header, data, sizeof(header));
+        if (header.SourceSize == sourceSize && header.SourceWriteTime == sourceWriteTime && SetRangesFromImage(data, _mapping->size()))
+            return true;
+    }
+
+    Clear();
+    return false;
+}
 
+bool IpLocationStore::ParseCsv(std::string const& databaseFilePath, uint64 sourceSize, int64 sourceWriteTime)
+{
+    std::ifstream databaseFile(databaseFilePath);
     if (!databaseFile.is_open())
     {
         TC_LOG_ERROR("server.loading", "IPLocation: Ip database file ({}) can not be opened.", databaseFilePath);
-        return;
+        return false;
     }
 
+    struct Range
+    {
+        Ipv6Key From;
+        Ipv6Key To;
+        uint16 Country;
+    };
+
+    std::vector<Range> ipv4Ranges;
+    std::vector<Range> ipv6Ranges;
+    std::vector<IpLocationRecord> countries;
+    std::unordered_map<std::string, uint16> countryIndexes;
+
     std::string ipFrom;
     std::string ipTo;
     std::string countryCode;
@@ -86,42 +226,183 @@ void IpLocationStore::Load()
         // Convert country code to lowercase
         strToLower(countryCode);
 
-        Optional<uint32> from = Trinity::StringTo<uint32>(ipFrom);
+        Optional<Ipv6Key> from = ParseIpNumber<Ipv6Key>(ipFrom);
         if (!from)
             continue;
 
-        Optional<uint32> to = Trinity::StringTo<uint32>(ipTo);
+        Optional<Ipv6Key> to = ParseIpNumber<Ipv6Key>(ipTo);
         if (!to)
             continue;
 
-        _ipLocationStore.emplace_back(*from, *to, std::move(countryCode), std::move(countryName));
+        auto [country, inserted] = countryIndexes.try_emplace(countryCode, uint16(countries.size()));
+        if (inserted)
+        {
+            ASSERT(countries.size() < std::numeric_limits<uint16>::max(), "Too many countries in ip database file");
+            countries.push_back({ .CountryCode = std::move(countryCode), .CountryName = std::move(countryName) });
+        }
+
+        bool isIpv4 = from->High == 0 && to->High == 0 && from->Low <= std::numeric_limits<uint32>::max() && to->Low <= std::numeric_limits<uint32>::max();
+        (isIpv4 ? ipv4Ranges : ipv6Ranges).push_back({ .From = *from, .To = *to, .Country = country->second });
+    }
+
+    for (std::vector<Range>* ranges : { &ipv4Ranges, &ipv6Ranges })
+    {
+        std::sort(ranges->begin(), ranges->end(), [](Range const& a, Range const& b) { return a.From < b.From; });
+        ASSERT(std::is_sorted(ranges->begin(), ranges->end(), [](Range const& a, Range const& b) { return a.From < b.To; }),
+            "Overlapping IP ranges detected in database file");
     }
 
-    std::sort(_ipLocationStore.begin(), _ipLocationStore.end(), [](IpLocationRecord const& a, IpLocationRecord const& b) { return a.IpFrom < b.IpFrom; });
-    ASSERT(std::is_sorted(_ipLocationStore.begin(), _ipLocationStore.end(), [](IpLocationRecord const& a, IpLocationRecord const& b) { return a.IpFrom < b.IpTo; }),
-        "Overlapping IP ranges detected in database file");
+    IpLocationCacheHeader header;
+    header.Magic = CacheMagic;
+    header.Version = CacheVersion;
+    header.SourceSize = sourceSize;
+    header.SourceWriteTime = sourceWriteTime;
+    header.Ipv4Count = uint32(ipv4Ranges.size());
+    header.Ipv6Count = uint32(ipv6Ranges.size());
+    header.CountryCount = uint32(countries.size());
+    header.CountriesSize = 0;
+    for (IpLocationRecord const& country : countries)
+        header.CountriesSize += 2 + std::min<std::size_t>(country.CountryCode.length(), 255) + std::min<std::size_t>(country.CountryName.length(), 255);
 
-    databaseFile.close();
+    std::size_t imageSize = sizeof(header)
+        + ipv4Ranges.size() * (sizeof(uint32) * 2 + sizeof(uint16))
+        + ipv6Ranges.size() * (sizeof(Ipv6Key) * 2 + sizeof(uint16))
+        + header.CountriesSize;
 
-    TC_LOG_INFO("server.loading", ">> Loaded {} ip location entries.", _ipLocationStore.size());
+    _image.resize((imageSize + sizeof(uint64) - 1) / sizeof(uint64));
+    uint8* data = reinterpret_cast<uint8*>(_image.data());
+    auto write = [&data](auto const& value)
+    {
+        std::memcpy(data, &value, sizeof(value));
+        data += sizeof(value);
+    };
+
+    write(header);
+    for (Range const& range : ipv4Ranges)
+        write(uint32(range.From.Low));
+    for (Range const& range : ipv4Ranges)
+        write(uint32(range.To.Low));
+    for (Range const& range : ipv6Ranges)
+        write(range.From);
+    for (Range const& range : ipv6Ranges)
+        write(range.To);
+    for (Range const& range : ipv4Ranges)
+        write(range.Country);
+    for (Range const& range : ipv6Ranges)
+        write(range.Country);
+    for (IpLocationRecord const& country : countries)
+    {
+        for (std::string const* str : { &country.CountryCode, &country.CountryName })
+        {
+            uint8 length = uint8(std::min<std::size_t>(str->length(), 255));
+            write(length);
+            std::memcpy(data, str->data(), length);
+            data += length;
+        }
+    }
+
+    return SetRangesFromImage(reinterpret_cast<uint8 const*>(_image.data()), imageSize);
+}
+
+bool IpLocationStore::SetRangesFromImage(uint8 const* data, std::size_t size)
+{
+    IpLocationCacheHeader header;
+    if (size < sizeof(header))
+        return false;
+
+    std::memcpy(&header, data, sizeof(header));
+    if (header.Magic != CacheMagic || header.Version != CacheVersion)
+        return false;
+
+    std::size_t expectedSize = sizeof(header)
+        + std::size_t(header.Ipv4Count) * (sizeof(uint32) * 2 + sizeof(uint16))
+        + std::size_t(header.Ipv6Count) * (sizeof(Ipv6Key) * 2 + sizeof(uint16))
+        + header.CountriesSize;
+    if (size < expectedSize)
+        return false;
+
+    uint8 const* itr = data + sizeof(header);
+    auto read = [&itr]<typename T>(std::span<T const>& target, uint32 count)
+    {
+        target = { reinterpret_cast<T const*>(itr), count };
+        itr += sizeof(T) * count;
+    };
+
+    read(_ipv4From, header.Ipv4Count);
+    read(_ipv4To, header.Ipv4Count);
+    read(_ipv6From, header.Ipv6Count);
+    read(_ipv6To, header.Ipv6Count);
+    read(_ipv4Country, header.Ipv4Count);
+    read(_ipv6Country, header.Ipv6Count);
+
+    uint8 const* countriesEnd = itr + header.CountriesSize;
+    _countries.resize(header.CountryCount);
+    for (IpLocationRecord& country : _countries)
+    {
+        for (std::string* str : { &country.CountryCode, &country.CountryName })
+        {
+            if (itr >= countriesEnd || itr + 1 + *itr > countriesEnd)
+                return false;
+
+            str->assign(reinterpret_cast<char const*>(itr + 1), *itr);
+            itr += 1 + *itr;
+        }
+    }
+
+    return std::ranges::all_of(_ipv4Country, [&](uint16 country) { return country < _countries.size(); })
+        && std::ranges::all_of(_ipv6Country, [&](uint16 country) { return country < _countries.size(); });
+}
+
+template<typename Address>
+IpLocationRecord const* IpLocationStore::FindRecord(std::span<Address const> from, std::span<Address const> to, std::span<uint16 const> countries, Address ip) const
+{
+    // ranges do not overlap so their ends are sorted too
+    auto itr = std::upper_bound(to.begin(), to.end(), ip);
+    if (itr == to.end())
+        return nullptr;
+
+    std::size_t index = std::distance(to.begin(), itr);
+    if (ip < from[index])
+        return nullptr;
+
+    return &_countries[countries[index]];
 }
 
 IpLocationRecord const* IpLocationStore::GetLocationRecord(std::string const& ipAddress) const
 {
     boost::system::error_code error;
-    boost::asio::ip::address_v4 address = Trinity::Net::make_address_v4(ipAddress, error);
+    boost::asio::ip::address address = Trinity::Net::make_address(ipAddress, error);
     if (error)
         return nullptr;
 
-    uint32 ip = Trinity::Net::address_to_uint(address);
-    auto itr = std::upper_bound(_ipLocationStore.begin(), _ipLocationStore.end(), ip, [](uint32 ip, IpLocationRecord const& loc) { return ip < loc.IpTo; });
-    if (itr == _ipLocationStore.end())
-        return nullptr;
+    return GetLocationRecord(address);
+}
 
-    if (ip < itr->IpFrom)
-        return nullptr;
+IpLocationRecord const* IpLocationStore::GetLocationRecord(boost::asio::ip::address const& address) const
+{
+    if (address.is_v6())
+    {
+        boost::asio::ip::address_v6 addressV6 = address.to_v6();
+        if (addressV6.is_v4_mapped())
+            return GetLocationRecord(Trinity::Net::make_address_v4(boost::asio::ip::v4_mapped, addressV6));
+
+        boost::asio::ip::address_v6::bytes_type bytes = addressV6.to_bytes();
+        Ipv6Key ip = { 0, 0 };
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            ip.High = (ip.High << 8) | bytes[i];
+            ip.Low = (ip.Low << 8) | bytes[i + 8];
+        }
+
+        return FindRecord(_ipv6From, _ipv6To, _ipv6Country, ip);
+    }
+
+    uint32 ip = Trinity::Net::address_to_uint(address.to_v4());
+    if (IpLocationRecord const* record = FindRecord(_ipv4From, _ipv4To, _ipv4Country, ip))
+        return record;
 
-    return &(*itr);
+    // IPv6 databases list IPv4 addresses mapped to ::ffff:0:0/96
+    return FindRecord(_ipv6From, _ipv6To, _ipv6Country, Ipv6Key{ 0, (uint64(0xFFFF) << 32) | ip });
 }
 
 IpLocationStore* IpLocationStore::Instance()
@@ -19,17 +19,21 @@
 #define IPLOCATION_H
 
 #include "Define.h"
+#include <boost/asio/ip/address.hpp>
+#include <compare>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
-struct IpLocationRecord
+namespace boost::iostreams
 {
-    IpLocationRecord() : IpFrom(0), IpTo(0) { }
-    IpLocationRecord(uint32 ipFrom, uint32 ipTo, std::string countryCode, std::string countryName)
-        : IpFrom(ipFrom), IpTo(ipTo), CountryCode(std::move(countryCode)), CountryName(std::move(countryName)) { }
+class mapped_file_source;
+}
 
-    uint32 IpFrom;
-    uint32 IpTo;
+// one per country, shared by all ranges located in it
+struct IpLocationRecord
+{
     std::string CountryCode;
     std::string CountryName;
 };
@@ -42,10 +46,44 @@ class TC_COMMON_API IpLocationStore
         static IpLocationStore* Instance();
 
         void Load();
+
+        // Parsing the CSV file is slow, its ranges are also written to <path>.cache which is mapped
+        // instead on following loads as long as the CSV file is unchanged
+        bool LoadFile(std::string const& databaseFilePath);
+        bool IsMapped() const { return _mapping != nullptr; }
+
         IpLocationRecord const* GetLocationRecord(std::string const& ipAddress) const;
+        IpLocationRecord const* GetLocationRecord(boost::asio::ip::address const& address) const;
 
     private:
-        std::vector<IpLocationRecord> _ipLocationStore;
+        struct Ipv6Key
+        {
+            uint64 High;
+            uint64 Low;
+
+            friend std::strong_ordering operator<=>(Ipv6Key const& left, Ipv6Key const& right) = default;
+        };
+
+        void Clear();
+        bool LoadCache(std::string const& cacheFilePath, uint64 sourceSize, int64 sourceWriteTime);
+        bool ParseCsv(std::string const& databaseFilePath, uint64 sourceSize, int64 sourceWriteTime);
+        bool SetRangesFromImage(uint8 const* data, std::size_t size);
+
+        template<typename Address>
+        IpLocationRecord const* FindRecord(std::span<Address const> from, std::span<Address const> to, std::span<uint16 const> countries, Address ip) const;
+
+        // ranges sorted by their start, kept as separate arrays so the binary search only touches the keys
+        // both ends are views into the cache file mapping or into _image
+        std::span<uint32 const> _ipv4From;
+        std::span<uint32 const> _ipv4To;
+        std::span<uint16 const> _ipv4Country;
+        std::span<Ipv6Key const> _ipv6From;
+        std::span<Ipv6Key const> _ipv6To;
+        std::span<uint16 const> _ipv6Country;
+        std::vector<IpLocationRecord> _countries;
+
+        std::vector<uint64> _image;                         // ranges parsed from CSV when the cache could not be mapped
+        std::unique_ptr<boost::iostreams::mapped_file_source> _mapping;
 };
 
 #define sIPLocation IpLocationStore::Instance()
@@ -17,8 +17,8 @@
 
 #include "Appender.h"
 #include "LogMessage.h"
-#include "StringFormat.h"
-#include <sstream>
+#include "StringFormatCompiled.h"
+#include <iterator>
 
 Appender::Appender(uint8 _id, std::string const& _name, LogLevel _level /* = LOG_LEVEL_DISABLED */, AppenderFlags _flags /* = APPENDER_FLAGS_NONE */):
 id(_id), name(_name), level(_level), flags(_flags) { }
@@ -55,18 +55,26 @@ void Appender::write(LogMessage* message)
     if (!level || level > message->level)
         return;
 
-    std::ostringstream ss;
+    // every appender rebuilds the prefix of the shared message, keep its capacity
+    std::string& prefix = message->prefix;
+    prefix.clear();
 
     if (flags & APPENDER_FLAGS_PREFIX_TIMESTAMP)
-        ss << message->getTimeStr() << ' ';
+    {
+        LogMessage::appendTimeStr(prefix, message->mtime);
+        prefix += ' ';
+    }
 
     if (flags & APPENDER_FLAGS_PREFIX_LOGLEVEL)
-        ss << Trinity::StringFormat("{:<5} ", Appender::getLogLevelString(message->level));
+        Trinity::StringFormatTo(std::back_inserter(prefix), TC_COMPILED_FORMAT("{:<5} "), Appender::getLogLevelString(message->level));
 
     if (flags & APPENDER_FLAGS_PREFIX_LOGFILTERTYPE)
-        ss << '[' << message->type << "] ";
+    {
+        prefix += '[';
+        prefix += message->type;
+        prefix += "] ";
+    }
 
-    message->prefix = ss.str();
     _write(message);
 }
 
@@ -21,15 +21,33 @@
 #include "Config.h"
 #include "Duration.h"
 #include "Errors.h"
+#include "IoContext.h"
 #include "Logger.h"
 #include "LogMessage.h"
-#include "LogOperation.h"
-#include "Strand.h"
+#include "MPSCQueue.h"
 #include "StringConvert.h"
 #include "Util.h"
 #include <sstream>
 
-Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _strand(nullptr)
+struct Log::AsyncQueue
+{
+    struct Entry
+    {
+        Entry(Logger const* logger, std::unique_ptr<LogMessage> message) : Target(logger), Message(std::move(message)) { }
+
+        Logger const* Target;
+        std::unique_ptr<LogMessage> Message;
+        std::atomic<Entry*> QueueLink;
+    };
+
+    MPSCQueue<Entry, &Entry::QueueLink> Messages;
+    std::atomic<uint32> Size = 0;
+    std::atomic<bool> DrainScheduled = false;
+    std::atomic<bool> AnyDropped = false;
+};
+
+Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr), _asyncQueue(std::make_unique<AsyncQueue>()),
+    _asyncMaxQueuedMessages(0)
 {
     m_logsTimestamp = "_" + GetTimestampStr();
     RegisterAppender<AppenderConsole>();
@@ -38,7 +56,6 @@ Log::Log() : AppenderId(0), lowestLogLevel(LOG_LEVEL_FATAL), _ioContext(nullptr)
 
 Log::~Log()
 {
-    delete _strand;
     Close();
 }
 
@@ -235,13 +252,60 @@ void Log::write(Logger const* logger, std::unique_ptr<LogMessage> msg) const
 {
     if (_ioContext)
     {
-        std::shared_ptr<LogOperation> logOperation = std::make_shared<LogOperation>(logger, std::move(msg));
-        Trinity::Asio::post(*_strand, [logOperation]() { logOperation->call(); });
+        // the writer thread is falling behind, drop instead of growing the queue without bounds
+        if (_asyncMaxQueuedMessages && _asyncQueue->Size.load(std::memory_order_relaxed) >= _asyncMaxQueuedMessages)
+        {
+            logger->AddDroppedMessage();
+            _asyncQueue->AnyDropped.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        _asyncQueue->Size.fetch_add(1, std::memory_order_relaxed);
+        _asyncQueue->Messages.Enqueue(new AsyncQueue::Entry(logger, std::move(msg)));
+
+        // only one drain task is queued at a time, it keeps going until the queue is empty
+        if (!_asyncQueue->DrainScheduled.exchange(true, std::memory_order_acq_rel))
+            Trinity::Asio::post(*_ioContext, [this]() { ProcessAsyncQueue(); });
     }
     else
         logger->write(msg.get());
 }
 
+void Log::ProcessAsyncQueue() const
+{
+    do
+    {
+        AsyncQueue::Entry* entry;
+        while (_asyncQueue->Messages.Dequeue(entry))
+        {
+            _asyncQueue->Size.fetch_sub(1, std::memory_order_relaxed);
+            entry->Target->write(entry->Message.get());
+            delete entry;
+        }
+
+        ReportDroppedMessages();
+
+        _asyncQueue->DrainScheduled.store(false, std::memory_order_release);
+
+        // messages enqueued after the last Dequeue but before DrainScheduled was cleared did not schedule another drain
+    } while (_asyncQueue->Size.load(std::memory_order_acquire) && !_asyncQueue->DrainScheduled.exchange(true, std::memory_order_acq_rel));
+}
+
+void Log::ReportDroppedMessages() const
+{
+    if (!_asyncQueue->AnyDropped.exchange(false, std::memory_order_relaxed))
+        return;
+
+    for (auto const& [name, logger] : loggers)
+    {
+        if (uint64 dropped = logger->TakeDroppedMessages())
+        {
+            LogMessage message(LOG_LEVEL_WARN, name, Trinity::StringFormat("{} messages were dropped, the async log queue was full", dropped));
+            logger->write(&message);
+        }
+    }
+}
+
 Logger const* Log::GetLoggerByType(std::string_view type) const
 {
     auto it = loggers.find(type);
@@ -342,6 +406,12 @@ void Log::SetRealmId(uint32 id)
         appender.second->setRealmId(id);
 }
 
+void Log::Flush()
+{
+    for (std::pair<uint8 const, std::unique_ptr<Appender>>& appender : appenders)
+        appender.second->flush();
+}
+
 void Log::Close()
 {
     loggers.clear();
@@ -388,28 +458,36 @@ Log* Log::instance()
 
 void Log::Initialize(Trinity::Asio::IoContext* ioContext)
 {
-    if (ioContext)
-    {
-        _ioContext = ioContext;
-        _strand = new Trinity::Asio::Strand(*ioContext);
-    }
+    _ioContext = ioContext;
 
     LoadFromConfig();
 }
 
 void Log::SetSynchronous()
 {
-    delete _strand;
-    _strand = nullptr;
     _ioContext = nullptr;
+
+    // write out what the async writer did not get to before its threads were joined
+    AsyncQueue::Entry* entry;
+    while (_asyncQueue->Messages.Dequeue(entry))
+    {
+        _asyncQueue->Size.fetch_sub(1, std::memory_order_relaxed);
+        entry->Target->write(entry->Message.get());
+        delete entry;
+    }
+
+    _asyncQueue->DrainScheduled.store(false, std::memory_order_relaxed);
+    ReportDroppedMessages();
 }
 
 void Log::LoadFromConfig()
 {
+    Flush();
     Close();
 
     lowestLogLevel = LOG_LEVEL_FATAL;
     AppenderId = 0;
+    _asyncMaxQueuedMessages = sConfigMgr->GetIntDefault("Log.Async.MaxQueuedMessages", 100000);
     m_logsDir = sConfigMgr->GetStringDefault("LogsDir", "");
     if (!m_logsDir.empty())
         if ((m_logsDir.at(m_logsDir.length() - 1) != '/') && (m_logsDir.at(m_logsDir.length() - 1) != '\\'))
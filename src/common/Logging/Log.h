@@ -19,7 +19,6 @@
 #define TRINITYCORE_LOG_H
 
 #include "Define.h"
-#include "AsioHacksFwd.h"
 #include "LogCommon.h"
 #include "StringFormat.h"
 #include <memory>
@@ -93,6 +92,7 @@ class TC_COMMON_API Log
         void OutCharDump(char const* str, uint32 account_id, uint64 guid, char const* name);
 
         void SetRealmId(uint32 id);
+        void Flush();
 
         template<class AppenderImpl>
         void RegisterAppender()
@@ -127,6 +127,8 @@ class TC_COMMON_API Log
     private:
         static std::string GetTimestampStr();
         void write(Logger const* logger, std::unique_ptr<LogMessage> msg) const;
+        void ProcessAsyncQueue() const;
+        void ReportDroppedMessages() const;
 
         Logger const* GetLoggerByType(std::string_view type) const;
         Appender* GetAppenderByName(std::string_view name);
@@ -149,7 +151,11 @@ class TC_COMMON_API Log
         std::string m_logsTimestamp;
 
         Trinity::Asio::IoContext* _ioContext;
-        Trinity::Asio::Strand* _strand;
+
+        // messages logged in async mode wait in a lock free queue drained by a single task on _ioContext at a time
+        struct AsyncQueue;
+        std::unique_ptr<AsyncQueue> _asyncQueue;
+        uint32 _asyncMaxQueuedMessages;
 };
 
 #define sLog Log::instance()
@@ -16,8 +16,9 @@
  */
 
 #include "LogMessage.h"
-#include "StringFormat.h"
+#include "StringFormatCompiled.h"
 #include "Util.h"
+#include <iterator>
 
 LogMessage::LogMessage(LogLevel _level, std::string_view _type, std::string _text)
     : level(_level), type(_type), text(std::move(_text)), mtime(time(nullptr))
@@ -30,10 +31,18 @@ LogMessage::LogMessage(LogLevel _level, std::string_view _type, std::string _tex
 }
 
 std::string LogMessage::getTimeStr(time_t time)
+{
+    std::string timeStr;
+    appendTimeStr(timeStr, time);
+    return timeStr;
+}
+
+void LogMessage::appendTimeStr(std::string& out, time_t time)
 {
     tm aTm;
     localtime_r(&time, &aTm);
-    return Trinity::StringFormat("{:04}-{:02}-{:02}_{:02}:{:02}:{:02}", aTm.tm_year + 1900, aTm.tm_mon + 1, aTm.tm_mday, aTm.tm_hour, aTm.tm_min, aTm.tm_sec);
+    Trinity::StringFormatTo(std::back_inserter(out), TC_COMPILED_FORMAT("{:04}-{:02}-{:02}_{:02}:{:02}:{:02}"),
+        aTm.tm_year + 1900, aTm.tm_mon + 1, aTm.tm_mday, aTm.tm_hour, aTm.tm_min, aTm.tm_sec);
 }
 
 std::string LogMessage::getTimeStr() const
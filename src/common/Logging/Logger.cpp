@@ -19,7 +19,7 @@
 #include "Appender.h"
 #include "LogMessage.h"
 
-Logger::Logger(std::string const& _name, LogLevel _level): name(_name), level(_level) { }
+Logger::Logger(std::string const& _name, LogLevel _level): name(_name), level(_level), droppedMessages(0) { }
 
 std::string const& Logger::getName() const
 {
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "LogCommon.h"
+#include <atomic>
 #include <unordered_map>
 #include <string>
 
@@ -39,10 +40,15 @@ class TC_COMMON_API Logger
         void setLogLevel(LogLevel level);
         void write(LogMessage* message) const;
 
+        // messages discarded because the async log queue was full
+        void AddDroppedMessage() const { droppedMessages.fetch_add(1, std::memory_order_relaxed); }
+        uint64 TakeDroppedMessages() const { return droppedMessages.exchange(0, std::memory_order_relaxed); }
+
     private:
         std::string name;
         LogLevel level;
         std::unordered_map<uint8, Appender*> appenders;
+        mutable std::atomic<uint64> droppedMessages;
 };
 
 #endif
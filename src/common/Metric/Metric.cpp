@@ -20,10 +20,66 @@
 #include "DeadlineTimer.h"
 #include "IoContext.h"
 #include "Log.h"
+#include "MetricExportRegistry.h"
+#include "StringConvert.h"
 #include "Util.h"
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/asio/ip/tcp.hpp>
 
+namespace
+{
+// reads back a value formatted by Metric::FormatInfluxDBValue, strings have no numeric value
+Optional<double> ParseInfluxDBValue(std::string_view value)
+{
+    if (value == "t")
+        return 1.0;
+
+    if (value == "f")
+        return 0.0;
+
+    if (value.empty() || value.front() == '"')
+        return {};
+
+    if (value.back() == 'i')
+        value.remove_suffix(1);
+
+    return Trinity::StringTo<double>(value);
+}
+}
+
+MetricHistogramSeries::MetricHistogramSeries(std::string category, std::size_t index) : _category(std::move(category)), _index(index)
+{
+}
+
+MetricHistogramSeries::~MetricHistogramSeries() = default;
+
+void MetricHistogramSeries::Add(uint32 value)
+{
+    // indexed by series, shards outlive their threads and keep being collected
+    thread_local std::vector<AtomicMetricHistogram*> threadShards;
+    if (threadShards.size() <= _index)
+        threadShards.resize(_index + 1);
+
+    AtomicMetricHistogram*& shard = threadShards[_index];
+    if (!shard)
+    {
+        std::lock_guard lock(_shardsLock);
+        shard = _shards.emplace_back(std::make_unique<AtomicMetricHistogram>()).get();
+    }
+
+    shard->Add(value);
+}
+
+MetricHistogram MetricHistogramSeries::Collect()
+{
+    MetricHistogram histogram;
+    std::lock_guard lock(_shardsLock);
+    for (std::unique_ptr<AtomicMetricHistogram> const& shard : _shards)
+        shard->MoveTo(histogram);
+
+    return histogram;
+}
+
 void Metric::Initialize(std::string const& realmName, Trinity::Asio::IoContext& ioContext, std::function<void()> overallStatusLogger)
 {
     _dataStream = std::make_unique<boost::asio::ip::tcp::iostream>();
@@ -31,6 +87,15 @@ void Metric::Initialize(std::string const& realmName, Trinity::Asio::IoContext&
     _batchTimer = std::make_unique<Trinity::Asio::DeadlineTimer>(ioContext);
     _overallStatusTimer = std::make_unique<Trinity::Asio::DeadlineTimer>(ioContext);
     _overallStatusLogger = overallStatusLogger;
+
+    // the exporter service is started together with the server, changing its port requires a restart
+    _exportEnabled = sConfigMgr->GetIntDefault("Metric.Exporter.Port", 0) != 0;
+    if (_exportEnabled)
+    {
+        _exportRealmName = realmName;
+        _exportRegistry = std::make_unique<MetricExportRegistry>();
+    }
+
     LoadFromConfigs();
 }
 
@@ -52,7 +117,8 @@ bool Metric::Connect()
 
 void Metric::LoadFromConfigs()
 {
-    bool previousValue = _enabled;
+    bool previousValue = IsEnabled();
+    bool previousPushValue = _enabled;
     _enabled = sConfigMgr->GetBoolDefault("Metric.Enable", false);
     _updateInterval = sConfigMgr->GetIntDefault("Metric.Interval", 1);
     if (_updateInterval < 1)
@@ -77,29 +143,35 @@ void Metric::LoadFromConfigs()
         _thresholds[thresholdName] = thresholdValue;
     }
 
-    // Schedule a send at this point only if the config changed from Disabled to Enabled.
-    // Cancel any scheduled operation if the config changed from Enabled to Disabled.
-    if (_enabled && !previousValue)
+    if (_enabled && !previousPushValue)
     {
         std::string connectionInfo = sConfigMgr->GetStringDefault("Metric.ConnectionInfo", "");
+        std::vector<std::string_view> tokens = Trinity::Tokenize(connectionInfo, ';', true);
         if (connectionInfo.empty())
         {
             TC_LOG_ERROR("metric", "'Metric.ConnectionInfo' not specified in configuration file.");
-            return;
+            _enabled = false;
         }
-
-        std::vector<std::string_view> tokens = Trinity::Tokenize(connectionInfo, ';', true);
-        if (tokens.size() != 3)
+        else if (tokens.size() != 3)
         {
             TC_LOG_ERROR("metric", "'Metric.ConnectionInfo' specified with wrong format in configuration file.");
-            return;
+            _enabled = false;
         }
+        else
+        {
+            _hostname.assign(tokens[0]);
+            _port.assign(tokens[1]);
+            _databaseName.assign(tokens[2]);
+            Connect();
+        }
+    }
+    else if (!_enabled && previousPushValue)
+        static_cast<boost::asio::ip::tcp::iostream&>(GetDataStream()).close();
 
-        _hostname.assign(tokens[0]);
-        _port.assign(tokens[1]);
-        _databaseName.assign(tokens[2]);
-        Connect();
-
+    // Schedule a send at this point only if the config changed from Disabled to Enabled.
+    // Cancel any scheduled operation if the config changed from Enabled to Disabled.
+    if (IsEnabled() && !previousValue)
+    {
         ScheduleSend();
         ScheduleOverallStatusLog();
     }
@@ -122,6 +194,22 @@ bool Metric::ShouldLog(std::string const& category, int64 value) const
     return value >= threshold->second;
 }
 
+MetricHistogramSeries& Metric::GetHistogramSeries(std::string_view category)
+{
+    std::lock_guard lock(_histogramSeriesLock);
+    auto itr = _histogramSeries.find(category);
+    if (itr == _histogramSeries.end())
+        itr = _histogramSeries.emplace(category, std::make_unique<MetricHistogramSeries>(std::string(category), _histogramSeries.size())).first;
+
+    return *itr->second;
+}
+
+std::string Metric::GetExportedText() const
+{
+    std::lock_guard lock(_exportedTextLock);
+    return _exportedText;
+}
+
 void Metric::LogEvent(std::string category, std::string title, std::string description)
 {
     using namespace std::chrono;
@@ -136,15 +224,59 @@ void Metric::LogEvent(std::string category, std::string title, std::string descr
     _queuedData.Enqueue(data);
 }
 
+void Metric::CollectHistogramSeries()
+{
+    std::lock_guard lock(_histogramSeriesLock);
+    for (auto const& [category, series] : _histogramSeries)
+    {
+        MetricHistogram histogram = series->Collect();
+        if (histogram.GetCount())
+            LogHistogram(category, histogram);
+    }
+}
+
+void Metric::ExportData(MetricData const& data)
+{
+    std::vector<MetricTag> tags;
+    tags.emplace_back("realm", _exportRealmName);
+    if (data.Tags)
+        std::visit([&](auto const& dataTags) { tags.insert(tags.end(), dataTags.begin(), dataTags.end()); }, *data.Tags);
+
+    switch (data.Type)
+    {
+        case METRIC_DATA_VALUE:
+            if (Optional<double> value = ParseInfluxDBValue(data.ValueOrEventText))
+                _exportRegistry->SetValue(data.Category, tags, *value);
+            break;
+        case METRIC_DATA_HISTOGRAM:
+            _exportRegistry->AddHistogram(data.Category, tags, *data.Histogram);
+            break;
+        default:
+            // events have no Prometheus equivalent
+            break;
+    }
+}
+
 void Metric::SendBatch()
 {
     using namespace std::chrono;
 
+    CollectHistogramSeries();
+
     std::stringstream batchedData;
     MetricData* data;
     bool firstLoop = true;
     while (_queuedData.Dequeue(data))
     {
+        if (_exportRegistry)
+            ExportData(*data);
+
+        if (!_enabled)
+        {
+            delete data;
+            continue;
+        }
+
         if (!firstLoop)
             batchedData << "\n";
 
@@ -171,6 +303,9 @@ void Metric::SendBatch()
             case METRIC_DATA_EVENT:
                 batchedData << "title=\"" << data->Title << "\",text=\"" << data->ValueOrEventText << "\"";
                 break;
+            case METRIC_DATA_HISTOGRAM:
+                batchedData << FormatInfluxDBHistogram(*data->Histogram);
+                break;
         }
 
         batchedData << " ";
@@ -181,6 +316,13 @@ void Metric::SendBatch()
         delete data;
     }
 
+    if (_exportRegistry)
+    {
+        std::string exportedText = _exportRegistry->Render();
+        std::lock_guard lock(_exportedTextLock);
+        _exportedText.swap(exportedText);
+    }
+
     // Check if there's any data to send
     if (batchedData.tellp() == std::streampos(0))
     {
@@ -189,7 +331,10 @@ void Metric::SendBatch()
     }
 
     if (!GetDataStream().good() && !Connect())
+    {
+        ScheduleSend();
         return;
+    }
 
     GetDataStream() << "POST " << "/write?db=" << _databaseName << " HTTP/1.1\r\n";
     GetDataStream() << "Host: " << _hostname << ":" << _port << "\r\n";
@@ -223,7 +368,7 @@ void Metric::SendBatch()
 
 void Metric::ScheduleSend()
 {
-    if (_enabled)
+    if (IsEnabled())
     {
         _batchTimer->expires_from_now(boost::posix_time::seconds(_updateInterval));
         _batchTimer->async_wait([this](boost::system::error_code const&){ SendBatch(); });
@@ -241,10 +386,11 @@ void Metric::ScheduleSend()
 void Metric::Unload()
 {
     // Send what's queued only if IoContext is stopped (so only on shutdown)
-    if (_enabled && Trinity::Asio::get_io_context(*_batchTimer).stopped())
+    if (IsEnabled() && Trinity::Asio::get_io_context(*_batchTimer).stopped())
     {
-        _enabled = false;
         SendBatch();
+        _enabled = false;
+        _exportEnabled = false;
     }
 
     _batchTimer->cancel();
@@ -253,7 +399,7 @@ void Metric::Unload()
 
 void Metric::ScheduleOverallStatusLog()
 {
-    if (_enabled)
+    if (IsEnabled())
     {
         _overallStatusTimer->expires_from_now(boost::posix_time::seconds(_overallStatusTimerInterval));
         _overallStatusTimer->async_wait([this](const boost::system::error_code&)
@@ -301,6 +447,16 @@ std::string Metric::FormatInfluxDBTagValue(std::string const& value)
     return boost::replace_all_copy(value, " ", "\\ ");
 }
 
+std::string Metric::FormatInfluxDBHistogram(MetricHistogram const& histogram)
+{
+    return "count=" + FormatInfluxDBValue(histogram.GetCount())
+        + ",sum=" + FormatInfluxDBValue(histogram.GetSum())
+        + ",max=" + FormatInfluxDBValue(histogram.GetMax())
+        + ",p50=" + FormatInfluxDBValue(histogram.GetPercentile(50.0f))
+        + ",p95=" + FormatInfluxDBValue(histogram.GetPercentile(95.0f))
+        + ",p99=" + FormatInfluxDBValue(histogram.GetPercentile(99.0f));
+}
+
 std::string Metric::FormatInfluxDBValue(std::chrono::nanoseconds value)
 {
     return FormatInfluxDBValue(std::chrono::duration_cast<Milliseconds>(value).count());
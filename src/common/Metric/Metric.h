@@ -20,11 +20,15 @@
 
 #include "Define.h"
 #include "Duration.h"
+#include "MetricHistogram.h"
 #include "MPSCQueue.h"
 #include "Optional.h"
+#include "TickTracer.h"
 #include <functional>
 #include <iosfwd>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -42,7 +46,8 @@ namespace Trinity
 enum MetricDataType
 {
     METRIC_DATA_VALUE,
-    METRIC_DATA_EVENT
+    METRIC_DATA_EVENT,
+    METRIC_DATA_HISTOGRAM
 };
 
 using MetricTag = std::pair<std::string, std::string>;
@@ -61,10 +66,37 @@ struct MetricData
 
     std::string ValueOrEventText;
 
+    // LogHistogram-specific fields
+    std::unique_ptr<MetricHistogram> Histogram;
+
     // intrusive queue link
     std::atomic<MetricData*> QueueLink;
 };
 
+class MetricExportRegistry;
+
+// Histogram that can be recorded from any thread without locking, every thread writes to its own shard
+// Shards are merged and reported once per Metric.Interval
+class TC_COMMON_API MetricHistogramSeries
+{
+public:
+    MetricHistogramSeries(std::string category, std::size_t index);
+    ~MetricHistogramSeries();
+
+    void Add(uint32 value);
+
+    std::string const& GetCategory() const { return _category; }
+
+    // everything recorded by all threads since the previous call
+    MetricHistogram Collect();
+
+private:
+    std::string _category;
+    std::size_t _index;
+    std::mutex _shardsLock;
+    std::vector<std::unique_ptr<AtomicMetricHistogram>> _shards;
+};
+
 class TC_COMMON_API Metric
 {
 private:
@@ -76,6 +108,7 @@ private:
     int32 _updateInterval = 0;
     int32 _overallStatusTimerInterval = 0;
     bool _enabled = false;
+    bool _exportEnabled = false;
     bool _overallStatusTimerTriggered = false;
     std::string _hostname;
     std::string _port;
@@ -84,7 +117,17 @@ private:
     std::string _realmName;
     std::unordered_map<std::string, int64> _thresholds;
 
+    std::mutex _histogramSeriesLock;
+    std::map<std::string, std::unique_ptr<MetricHistogramSeries>, std::less<>> _histogramSeries;
+
+    std::string _exportRealmName;
+    std::unique_ptr<MetricExportRegistry> _exportRegistry;
+    mutable std::mutex _exportedTextLock;
+    std::string _exportedText;
+
     bool Connect();
+    void CollectHistogramSeries();
+    void ExportData(MetricData const& data);
     void SendBatch();
     void ScheduleSend();
     void ScheduleOverallStatusLog();
@@ -99,6 +142,26 @@ private:
     static std::string FormatInfluxDBValue(std::chrono::nanoseconds value);
 
     static std::string FormatInfluxDBTagValue(std::string const& value);
+    static std::string FormatInfluxDBHistogram(MetricHistogram const& histogram);
+
+    template<class... TagsList>
+    static void SetTags(MetricData* data, TagsList&&... tags)
+    {
+        if constexpr (sizeof...(tags) > 0)
+        {
+            data->Tags.emplace();
+            if constexpr (sizeof...(tags) > 2)
+            {
+                decltype(auto) tagsVector = data->Tags->emplace<1>();
+                (tagsVector.emplace_back(std::move(tags)), ...);
+            }
+            else
+            {
+                decltype(auto) tagsArray = data->Tags->emplace<0>();
+                tagsArray = { std::move(tags)... };
+            }
+        }
+    }
 
     // ToDo: should format TagKey and FieldKey too in the same way as TagValue
 
@@ -112,6 +175,12 @@ public:
     void Update();
     bool ShouldLog(std::string const& category, int64 value) const;
 
+    // series are never removed, callers keep the reference (TC_METRIC_HISTOGRAM_TIMER stores it in a static)
+    MetricHistogramSeries& GetHistogramSeries(std::string_view category);
+
+    // latest metrics in Prometheus text format, refreshed every Metric.Interval
+    std::string GetExportedText() const;
+
     template<class T, class... TagsList>
     void LogValue(std::string category, T value, TagsList&&... tags)
     {
@@ -122,20 +191,23 @@ public:
         data->Timestamp = system_clock::now();
         data->Type = METRIC_DATA_VALUE;
         data->ValueOrEventText = FormatInfluxDBValue(value);
-        if constexpr (sizeof...(tags) > 0)
-        {
-            data->Tags.emplace();
-            if constexpr (sizeof...(tags) > 2)
-            {
-                decltype(auto) tagsVector = data->Tags->emplace<1>();
-                (tagsVector.emplace_back(std::move(tags)), ...);
-            }
-            else
-            {
-                decltype(auto) tagsArray = data->Tags->emplace<0>();
-                tagsArray = { std::move(tags)... };
-            }
-        }
+        SetTags(data, std::forward<TagsList>(tags)...);
+
+        _queuedData.Enqueue(data);
+    }
+
+    // sends count, sum, max and common percentiles of the histogram as fields of a single point
+    template<class... TagsList>
+    void LogHistogram(std::string category, MetricHistogram const& histogram, TagsList&&... tags)
+    {
+        using namespace std::chrono;
+
+        MetricData* data = new MetricData;
+        data->Category = std::move(category);
+        data->Timestamp = system_clock::now();
+        data->Type = METRIC_DATA_HISTOGRAM;
+        data->Histogram = std::make_unique<MetricHistogram>(histogram);
+        SetTags(data, std::forward<TagsList>(tags)...);
 
         _queuedData.Enqueue(data);
     }
@@ -143,7 +215,10 @@ public:
     void LogEvent(std::string category, std::string title, std::string description);
 
     void Unload();
-    bool IsEnabled() const { return _enabled; }
+
+    // true if metrics are pushed to InfluxDB or exported for Prometheus
+    bool IsEnabled() const { return _enabled || _exportEnabled; }
+    bool IsExportEnabled() const { return _exportEnabled; }
 };
 
 #define sMetric Metric::instance()
@@ -168,10 +243,11 @@ private:
     TimePoint _startTime;
 };
 
+// timers also run while the tick tracer records, the logger must check which of the two is enabled
 template<typename LoggerType>
 Optional<MetricStopWatch<LoggerType>> MakeMetricStopWatch(LoggerType&& loggerFunc)
 {
-    if (!sMetric->IsEnabled())
+    if (!sMetric->IsEnabled() && !Trinity::TickTracer::IsRecording())
         return {};
 
     return Optional<MetricStopWatch<LoggerType>>(std::in_place, std::forward<LoggerType>(loggerFunc));
@@ -186,7 +262,9 @@ Optional<MetricStopWatch<LoggerType>> MakeMetricStopWatch(LoggerType&& loggerFun
 #if defined PERFORMANCE_PROFILING || defined WITHOUT_METRICS
 #define TC_METRIC_EVENT(category, title, description) ((void)0)
 #define TC_METRIC_VALUE(category, value, ...) ((void)0)
+#define TC_METRIC_HISTOGRAM(category, histogram, ...) ((void)0)
 #define TC_METRIC_TIMER(category, ...) ((void)0)
+#define TC_METRIC_HISTOGRAM_TIMER(category) ((void)0)
 #define TC_METRIC_DETAILED_EVENT(category, title, description) ((void)0)
 #define TC_METRIC_DETAILED_TIMER(category, ...) ((void)0)
 #define TC_METRIC_DETAILED_NO_THRESHOLD_TIMER(category, ...) ((void)0)
@@ -202,6 +280,11 @@ Optional<MetricStopWatch<LoggerType>> MakeMetricStopWatch(LoggerType&& loggerFun
             if (sMetric->IsEnabled())                                  \
                 sMetric->LogValue(category, value, ##__VA_ARGS__);     \
         } while (0)
+#define TC_METRIC_HISTOGRAM(category, histogram, ...)                  \
+        do {                                                           \
+            if (sMetric->IsEnabled())                                  \
+                sMetric->LogHistogram(category, histogram, ##__VA_ARGS__); \
+        } while (0)
 #  else
 #define TC_METRIC_EVENT(category, title, description)                  \
         __pragma(warning(push))                                        \
@@ -219,19 +302,45 @@ Optional<MetricStopWatch<LoggerType>> MakeMetricStopWatch(LoggerType&& loggerFun
                 sMetric->LogValue(category, value, ##__VA_ARGS__);     \
         } while (0)                                                    \
         __pragma(warning(pop))
+#define TC_METRIC_HISTOGRAM(category, histogram, ...)                  \
+        __pragma(warning(push))                                        \
+        __pragma(warning(disable:4127))                                \
+        do {                                                           \
+            if (sMetric->IsEnabled())                                  \
+                sMetric->LogHistogram(category, histogram, ##__VA_ARGS__); \
+        } while (0)                                                    \
+        __pragma(warning(pop))
 #  endif
 #define TC_METRIC_TIMER(category, ...)                                                                           \
         auto TC_METRIC_UNIQUE_NAME(__tc_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start)            \
         {                                                                                                        \
-            sMetric->LogValue(category, std::chrono::steady_clock::now() - start, ##__VA_ARGS__);                \
+            TimePoint end = std::chrono::steady_clock::now();                                                    \
+            if (sMetric->IsEnabled())                                                                            \
+                sMetric->LogValue(category, end - start, ##__VA_ARGS__);                                         \
+            if (Trinity::TickTracer::IsRecording())                                                              \
+                Trinity::TickTracer::RecordWithTags(category, start, end, ##__VA_ARGS__);                        \
+        });
+// records microseconds into a per thread histogram instead of sending every sample, category must not change between calls
+#define TC_METRIC_HISTOGRAM_TIMER(category)                                                                      \
+        auto TC_METRIC_UNIQUE_NAME(__tc_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start)            \
+        {                                                                                                        \
+            TimePoint end = std::chrono::steady_clock::now();                                                    \
+            static MetricHistogramSeries& series = sMetric->GetHistogramSeries(category);                        \
+            if (sMetric->IsEnabled())                                                                            \
+                series.Add(uint32(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()));  \
+            if (Trinity::TickTracer::IsRecording())                                                              \
+                Trinity::TickTracer::Record(category, {}, {}, start, end);                                       \
         });
 #  if defined WITH_DETAILED_METRICS
 #define TC_METRIC_DETAILED_TIMER(category, ...)                                                                  \
         auto TC_METRIC_UNIQUE_NAME(__tc_metric_stop_watch) = MakeMetricStopWatch([&](TimePoint start)            \
         {                                                                                                        \
-            int64 duration = int64(std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - start).count()); \
+            TimePoint end = std::chrono::steady_clock::now();                                                    \
+            int64 duration = int64(std::chrono::duration_cast<Milliseconds>(end - start).count());               \
             std::string category2 = category;                                                                    \
-            if (sMetric->ShouldLog(category2, duration))                                                         \
+            if (Trinity::TickTracer::IsRecording())                                                              \
+                Trinity::TickTracer::RecordWithTags(category2, start, end, ##__VA_ARGS__);                       \
+            if (sMetric->IsEnabled() && sMetric->ShouldLog(category2, duration))                                 \
                 sMetric->LogValue(std::move(category2), duration, ##__VA_ARGS__);                                \
         });
 #define TC_METRIC_DETAILED_NO_THRESHOLD_TIMER(category, ...) TC_METRIC_TIMER(category, ##__VA_ARGS__)
@@ -0,0 +1,155 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricExportRegistry.h"
+#include "StringFormat.h"
+#include <iterator>
+
+void MetricExportRegistry::SetValue(std::string_view category, std::span<Tag const> tags, double value)
+{
+    if (Series* series = FindOrCreateSeries(category, tags, value))
+        *series = value;
+}
+
+void MetricExportRegistry::AddHistogram(std::string_view category, std::span<Tag const> tags, MetricHistogram const& histogram)
+{
+    Series* series = FindOrCreateSeries(category, tags, Histogram());
+    if (!series)
+        return;
+
+    Histogram& cumulative = std::get<Histogram>(*series);
+    for (std::size_t i = 0; i < MetricHistogram::BucketCount; ++i)
+    {
+        if (uint32 count = histogram.GetBucket(i))
+        {
+            cumulative.Buckets[i] += count;
+            cumulative.UsedBuckets = std::max(cumulative.UsedBuckets, i + 1);
+        }
+    }
+
+    cumulative.Count += histogram.GetCount();
+    cumulative.Sum += histogram.GetSum();
+}
+
+std::string MetricExportRegistry::Render() const
+{
+    std::string text;
+    auto out = std::back_inserter(text);
+    for (auto const& [name, family] : _families)
+    {
+        if (family.empty())
+            continue;
+
+        bool isHistogram = std::holds_alternative<Histogram>(family.begin()->second);
+        Trinity::StringFormatTo(out, "# TYPE {} {}\n", name, isHistogram ? "histogram" : "gauge");
+
+        for (auto const& [labels, series] : family)
+        {
+            std::string_view separator = labels.empty() ? "" : ",";
+            if (double const* value = std::get_if<double>(&series))
+            {
+                if (labels.empty())
+                    Trinity::StringFormatTo(out, "{} {}\n", name, *value);
+                else
+                    Trinity::StringFormatTo(out, "{}{{{}}} {}\n", name, labels, *value);
+                continue;
+            }
+
+            Histogram const& histogram = std::get<Histogram>(series);
+            uint64 cumulativeCount = 0;
+            for (std::size_t i = 0; i < histogram.UsedBuckets; ++i)
+            {
+                cumulativeCount += histogram.Buckets[i];
+                Trinity::StringFormatTo(out, "{}_bucket{{{}{}le=\"{}\"}} {}\n", name, labels, separator, MetricHistogram::GetBucketUpperBound(i), cumulativeCount);
+            }
+
+            Trinity::StringFormatTo(out, "{}_bucket{{{}{}le=\"+Inf\"}} {}\n", name, labels, separator, histogram.Count);
+            if (labels.empty())
+            {
+                Trinity::StringFormatTo(out, "{}_sum {}\n", name, histogram.Sum);
+                Trinity::StringFormatTo(out, "{}_count {}\n", name, histogram.Count);
+            }
+            else
+            {
+                Trinity::StringFormatTo(out, "{}_sum{{{}}} {}\n", name, labels, histogram.Sum);
+                Trinity::StringFormatTo(out, "{}_count{{{}}} {}\n", name, labels, histogram.Count);
+            }
+        }
+    }
+
+    return text;
+}
+
+std::string MetricExportRegistry::FormatName(std::string_view name)
+{
+    // metric and label names may only contain [a-zA-Z0-9_] and not start with a digit
+    std::string formatted;
+    formatted.reserve(name.length() + 1);
+    if (name.empty() || (name[0] >= '0' && name[0] <= '9'))
+        formatted += '_';
+
+    for (char c : name)
+    {
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))
+            formatted += c;
+        else
+            formatted += '_';
+    }
+
+    return formatted;
+}
+
+MetricExportRegistry::Series* MetricExportRegistry::FindOrCreateSeries(std::string_view category, std::span<Tag const> tags, Series&& defaultValue)
+{
+    Family& family = _families[FormatName(category)];
+
+    // the same category logged as both a value and a histogram, keep the type that was seen first
+    if (!family.empty() && family.begin()->second.index() != defaultValue.index())
+        return nullptr;
+
+    return &family.try_emplace(FormatLabels(tags), std::move(defaultValue)).first->second;
+}
+
+std::string MetricExportRegistry::FormatLabels(std::span<Tag const> tags)
+{
+    std::string labels;
+    for (auto const& [name, value] : tags)
+    {
+        if (name.empty())
+            continue;
+
+        if (!labels.empty())
+            labels += ',';
+
+        labels += FormatName(name);
+        labels += "=\"";
+        for (char c : value)
+        {
+            switch (c)
+            {
+                case '\\': labels += "\\\\"; break;
+                case '"': labels += "\\\""; break;
+                case '\n': labels += "\\n"; break;
+                default: labels += c; break;
+            }
+        }
+
+        labels += '"';
+    }
+
+    return labels;
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef METRIC_EXPORT_REGISTRY_H__
+#define METRIC_EXPORT_REGISTRY_H__
+
+#include "Define.h"
+#include "MetricHistogram.h"
+#include <array>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+// Latest values and cumulative histograms of every metric, rendered in Prometheus text exposition format
+// Values become gauges, histograms keep counting from the first time they were added like Prometheus expects
+class TC_COMMON_API MetricExportRegistry
+{
+public:
+    using Tag = std::pair<std::string, std::string>;
+
+    void SetValue(std::string_view category, std::span<Tag const> tags, double value);
+    void AddHistogram(std::string_view category, std::span<Tag const> tags, MetricHistogram const& histogram);
+
+    std::string Render() const;
+
+    static std::string FormatName(std::string_view name);
+
+private:
+    struct Histogram
+    {
+        std::array<uint64, MetricHistogram::BucketCount> Buckets = { };
+        uint64 Count = 0;
+        uint64 Sum = 0;
+        std::size_t UsedBuckets = 0;     // buckets above the highest one ever used are left out of the output
+    };
+
+    using Series = std::variant<double, Histogram>;
+
+    // rendered labels -> value, all series of a family share the type of the first one added
+    using Family = std::map<std::string, Series>;
+
+    Series* FindOrCreateSeries(std::string_view category, std::span<Tag const> tags, Series&& defaultValue);
+
+    static std::string FormatLabels(std::span<Tag const> tags);
+
+    std::map<std::string, Family> _families;
+};
+
+#endif // METRIC_EXPORT_REGISTRY_H__
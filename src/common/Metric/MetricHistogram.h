@@ -0,0 +1,122 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef METRIC_HISTOGRAM_H__
+#define METRIC_HISTOGRAM_H__
+
+#include "Define.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+
+// Fixed size histogram with power of two buckets, cheap enough to record every update tick
+// bucket 0 holds value 0, bucket i holds values in range [2^(i-1), 2^i)
+class MetricHistogram
+{
+public:
+    static constexpr std::size_t BucketCount = 33;
+
+    void Add(uint32 value)
+    {
+        ++_buckets[std::bit_width(value)];
+        ++_count;
+        _sum += value;
+        _max = std::max(_max, value);
+    }
+
+    void Merge(MetricHistogram const& other)
+    {
+        for (std::size_t i = 0; i < BucketCount; ++i)
+            _buckets[i] += other._buckets[i];
+
+        _count += other._count;
+        _sum += other._sum;
+        _max = std::max(_max, other._max);
+    }
+
+    void Reset() { *this = MetricHistogram(); }
+
+    uint32 GetCount() const { return _count; }
+    uint64 GetSum() const { return _sum; }
+    uint32 GetMax() const { return _max; }
+    uint32 GetBucket(std::size_t bucket) const { return _buckets[bucket]; }
+
+    // largest value stored in the bucket
+    static constexpr uint32 GetBucketUpperBound(std::size_t bucket) { return bucket ? uint32((uint64(1) << bucket) - 1) : 0; }
+
+    // upper bound of the bucket containing the requested percentile, never above the largest recorded value
+    uint32 GetPercentile(float percentile) const
+    {
+        if (!_count)
+            return 0;
+
+        uint64 rank = std::max<uint64>(uint64(std::clamp(percentile, 0.0f, 100.0f) / 100.0f * _count + 0.5f), 1);
+        uint64 seen = 0;
+        for (std::size_t i = 0; i < BucketCount; ++i)
+        {
+            seen += _buckets[i];
+            if (seen >= rank)
+                return std::min(GetBucketUpperBound(i), _max);
+        }
+
+        return _max;
+    }
+
+private:
+    friend class AtomicMetricHistogram;
+
+    std::array<uint32, BucketCount> _buckets = { };
+    uint32 _count = 0;
+    uint64 _sum = 0;
+    uint32 _max = 0;
+};
+
+// MetricHistogram with relaxed atomic counters, written by one thread while another periodically moves its contents out
+// A value added during MoveTo may have its bucket counted in the next interval and its sum and max in this one
+class AtomicMetricHistogram
+{
+public:
+    void Add(uint32 value)
+    {
+        _buckets[std::bit_width(value)].fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(value, std::memory_order_relaxed);
+        if (value > _max.load(std::memory_order_relaxed))
+            _max.store(value, std::memory_order_relaxed);
+    }
+
+    // merges everything recorded since the previous call into target
+    void MoveTo(MetricHistogram& target)
+    {
+        for (std::size_t i = 0; i < MetricHistogram::BucketCount; ++i)
+        {
+            uint32 count = _buckets[i].exchange(0, std::memory_order_relaxed);
+            target._buckets[i] += count;
+            target._count += count;
+        }
+
+        target._sum += _sum.exchange(0, std::memory_order_relaxed);
+        target._max = std::max(target._max, _max.exchange(0, std::memory_order_relaxed));
+    }
+
+private:
+    std::array<std::atomic<uint32>, MetricHistogram::BucketCount> _buckets = { };
+    std::atomic<uint64> _sum = 0;
+    std::atomic<uint32> _max = 0;
+};
+
+#endif // METRIC_HISTOGRAM_H__
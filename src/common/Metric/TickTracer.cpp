@@ -0,0 +1,208 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TickTracer.h"
+#include "StringFormat.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+struct TraceEvent
+{
+    int64 Start = 0;        // nanoseconds of steady_clock
+    int64 Duration = 0;
+    std::array<char, 48> Name = { };
+    std::array<char, 24> ArgName = { };
+    std::array<char, 48> ArgValue = { };
+};
+
+struct ThreadBuffer
+{
+    std::mutex Lock;
+    uint32 ThreadId = 0;
+    std::string ThreadName;
+    std::vector<TraceEvent> Events;     // allocated by the first recorded zone
+    uint64 Written = 0;
+};
+
+struct ThreadBufferRegistry
+{
+    std::mutex Lock;
+    std::vector<std::weak_ptr<ThreadBuffer>> Buffers;
+    uint32 NextThreadId = 1;
+};
+
+ThreadBufferRegistry& GetRegistry()
+{
+    static ThreadBufferRegistry registry;
+    return registry;
+}
+
+// zones of exited threads are dropped together with their buffer
+ThreadBuffer& GetThreadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> buffer = []
+    {
+        std::shared_ptr<ThreadBuffer> newBuffer = std::make_shared<ThreadBuffer>();
+        ThreadBufferRegistry& registry = GetRegistry();
+        std::lock_guard lock(registry.Lock);
+        std::erase_if(registry.Buffers, [](std::weak_ptr<ThreadBuffer> const& existing) { return existing.expired(); });
+        newBuffer->ThreadId = registry.NextThreadId++;
+        newBuffer->ThreadName = Trinity::StringFormat("thread {}", newBuffer->ThreadId);
+        registry.Buffers.push_back(newBuffer);
+        return newBuffer;
+    }();
+
+    return *buffer;
+}
+
+template<std::size_t Size>
+void CopyTruncated(std::array<char, Size>& target, std::string_view value)
+{
+    std::size_t length = std::min(value.length(), Size - 1);
+    std::copy_n(value.data(), length, target.data());
+    target[length] = '\0';
+}
+
+void AppendJsonString(std::string& json, std::string_view value)
+{
+    json += '"';
+    for (char c : value)
+    {
+        switch (c)
+        {
+            case '"': json += "\\\""; break;
+            case '\\': json += "\\\\"; break;
+            default:
+                if (uint8(c) < 0x20)
+                    Trinity::StringFormatTo(std::back_inserter(json), "\\u{:04x}", uint32(c));
+                else
+                    json += c;
+                break;
+        }
+    }
+    json += '"';
+}
+}
+
+std::atomic<bool> Trinity::TickTracer::_recording = false;
+
+void Trinity::TickTracer::SetThreadName(std::string name)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard lock(buffer.Lock);
+    buffer.ThreadName = std::move(name);
+}
+
+void Trinity::TickTracer::Record(std::string_view name, std::string_view argName, std::string_view argValue, TimePoint start, TimePoint end)
+{
+    ThreadBuffer& buffer = GetThreadBuffer();
+    std::lock_guard lock(buffer.Lock);
+    if (buffer.Events.empty())
+        buffer.Events.resize(EventsPerThread);
+
+    TraceEvent& event = buffer.Events[buffer.Written++ % EventsPerThread];
+    event.Start = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()).count();
+    event.Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    CopyTruncated(event.Name, name);
+    CopyTruncated(event.ArgName, argName);
+    CopyTruncated(event.ArgValue, argValue);
+}
+
+std::string Trinity::TickTracer::FormatChromeTrace(Milliseconds window)
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        ThreadBufferRegistry& registry = GetRegistry();
+        std::lock_guard lock(registry.Lock);
+        for (std::weak_ptr<ThreadBuffer> const& buffer : registry.Buffers)
+            if (std::shared_ptr<ThreadBuffer> liveBuffer = buffer.lock())
+                buffers.push_back(std::move(liveBuffer));
+    }
+
+    int64 cutoff = std::chrono::duration_cast<std::chrono::nanoseconds>((std::chrono::steady_clock::now() - window).time_since_epoch()).count();
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    std::vector<TraceEvent> events;
+    for (std::shared_ptr<ThreadBuffer> const& buffer : buffers)
+    {
+        uint32 threadId;
+        std::string threadName;
+        {
+            std::lock_guard lock(buffer->Lock);
+            threadId = buffer->ThreadId;
+            threadName = buffer->ThreadName;
+            std::copy_if(buffer->Events.begin(), buffer->Events.end(), std::back_inserter(events), [cutoff](TraceEvent const& event)
+            {
+                return event.Name[0] && event.Start + event.Duration >= cutoff;
+            });
+        }
+
+        if (!first)
+            json += ',';
+
+        first = false;
+        Trinity::StringFormatTo(std::back_inserter(json), "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":", threadId);
+        AppendJsonString(json, threadName);
+        json += "}}";
+
+        for (TraceEvent const& event : events)
+        {
+            std::string_view name = event.Name.data();
+            std::string_view argName = event.ArgName.data();
+            std::string_view argValue = event.ArgValue.data();
+
+            json += ",{\"name\":";
+            AppendJsonString(json, argValue.empty() ? std::string(name) : Trinity::StringFormat("{} ({})", name, argValue));
+            json += ",\"cat\":";
+            AppendJsonString(json, name);
+            Trinity::StringFormatTo(std::back_inserter(json), ",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}",
+                threadId, event.Start / 1000.0, event.Duration / 1000.0);
+            if (!argName.empty())
+            {
+                json += ",\"args\":{";
+                AppendJsonString(json, argName);
+                json += ':';
+                AppendJsonString(json, argValue);
+                json += '}';
+            }
+            json += '}';
+        }
+
+        events.clear();
+    }
+
+    json += "]}";
+    return json;
+}
+
+bool Trinity::TickTracer::WriteChromeTrace(std::string const& fileName, Milliseconds window)
+{
+    std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+    if (!file)
+        return false;
+
+    file << FormatChromeTrace(window);
+    return bool(file);
+}
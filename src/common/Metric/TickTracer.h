@@ -0,0 +1,102 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TICK_TRACER_H__
+#define TICK_TRACER_H__
+
+#include "Define.h"
+#include "Duration.h"
+#include <atomic>
+#include <string>
+#include <string_view>
+
+namespace Trinity
+{
+// Timeline of what every thread was doing, for finding the cause of a single slow tick
+// Zones are kept in a ring buffer of the thread that recorded them (the last EventsPerThread zones)
+// and can be written as Chrome trace event JSON, viewable in chrome://tracing or ui.perfetto.dev
+// While recording is off a zone costs one relaxed atomic load
+class TC_COMMON_API TickTracer
+{
+public:
+    static constexpr std::size_t EventsPerThread = 8192;
+
+    static bool IsRecording() { return _recording.load(std::memory_order_relaxed); }
+    static void SetRecording(bool recording) { _recording.store(recording, std::memory_order_relaxed); }
+
+    // name shown for the calling thread in traces
+    static void SetThreadName(std::string name);
+
+    static void Record(std::string_view name, std::string_view argName, std::string_view argValue, TimePoint start, TimePoint end);
+
+    // records the zone with the first tag of a TC_METRIC_TIMER as its argument
+    template<typename... TagsList>
+    static void RecordWithTags(std::string_view name, TimePoint start, TimePoint end, TagsList&&... tags)
+    {
+        if constexpr (sizeof...(tags) > 0)
+            RecordWithFirstTag(name, start, end, tags...);
+        else
+            Record(name, {}, {}, start, end);
+    }
+
+    // zones of all threads that ended within the last window
+    static std::string FormatChromeTrace(Milliseconds window);
+    static bool WriteChromeTrace(std::string const& fileName, Milliseconds window);
+
+    class Zone
+    {
+    public:
+        explicit Zone(char const* name) : _name(IsRecording() ? name : nullptr)
+        {
+            if (_name)
+                _start = std::chrono::steady_clock::now();
+        }
+
+        ~Zone()
+        {
+            if (_name)
+                Record(_name, {}, {}, _start, std::chrono::steady_clock::now());
+        }
+
+        Zone(Zone const&) = delete;
+        Zone& operator=(Zone const&) = delete;
+
+    private:
+        char const* _name;
+        TimePoint _start;
+    };
+
+private:
+    template<typename Tag, typename... TagsList>
+    static void RecordWithFirstTag(std::string_view name, TimePoint start, TimePoint end, Tag const& tag, TagsList const&... /*tags*/)
+    {
+        Record(name, tag.first, tag.second, start, end);
+    }
+
+    static std::atomic<bool> _recording;
+};
+}
+
+#if defined PERFORMANCE_PROFILING || defined WITHOUT_METRICS
+#define TC_TRACE_ZONE(name) ((void)0)
+#else
+#define TC_TRACE_ZONE_DO_CONCAT(a, b) a ## b
+#define TC_TRACE_ZONE_CONCAT(a, b) TC_TRACE_ZONE_DO_CONCAT(a, b)
+#define TC_TRACE_ZONE(name) Trinity::TickTracer::Zone TC_TRACE_ZONE_CONCAT(__tc_trace_zone, __LINE__)(name)
+#endif
+
+#endif // TICK_TRACER_H__
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ReadCopyUpdate.h"
+#include <array>
+
+namespace
+{
+struct alignas(64) ReaderSlot
+{
+    std::atomic<uint64> PinnedEpoch = 0;    // 0 while not reading
+    std::atomic<bool> InUse = false;
+};
+
+constexpr std::size_t MaxReaderSlots = 256;
+
+std::array<ReaderSlot, MaxReaderSlots> ReaderSlots;
+alignas(64) std::atomic<uint64> GlobalEpoch = 1;
+// threads that could not get a slot, they block reclamation while reading
+alignas(64) std::atomic<uint32> UnslottedReaders = 0;
+
+struct ThreadReaderState
+{
+    ReaderSlot* Slot = nullptr;
+    uint32 Depth = 0;
+    bool Initialized = false;
+
+    ~ThreadReaderState()
+    {
+        if (Slot)
+            Slot->InUse.store(false, std::memory_order_release);
+    }
+
+    void Initialize()
+    {
+        Initialized = true;
+        for (ReaderSlot& slot : ReaderSlots)
+        {
+            bool expected = false;
+            if (!slot.InUse.load(std::memory_order_relaxed) && slot.InUse.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                Slot = &slot;
+                return;
+            }
+        }
+    }
+};
+
+thread_local ThreadReaderState ReaderState;
+}
+
+void Trinity::Impl::EpochDomain::EnterRead()
+{
+    // nested reads keep the epoch pinned by the outermost one
+    if (ReaderState.Depth++)
+        return;
+
+    if (!ReaderState.Initialized)
+        ReaderState.Initialize();
+
+    if (ReaderState.Slot)
+        ReaderState.Slot->PinnedEpoch.store(GlobalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    else
+        UnslottedReaders.fetch_add(1, std::memory_order_seq_cst);
+}
+
+void Trinity::Impl::EpochDomain::LeaveRead()
+{
+    if (--ReaderState.Depth)
+        return;
+
+    if (ReaderState.Slot)
+        ReaderState.Slot->PinnedEpoch.store(0, std::memory_order_release);
+    else
+        UnslottedReaders.fetch_sub(1, std::memory_order_release);
+}
+
+uint64 Trinity::Impl::EpochDomain::Retire()
+{
+    return GlobalEpoch.fetch_add(1, std::memory_order_seq_cst);
+}
+
+bool Trinity::Impl::EpochDomain::CanReclaim(uint64 retireEpoch)
+{
+    // readers that pinned a later epoch loaded the snapshot after it was replaced
+    if (UnslottedReaders.load(std::memory_order_seq_cst))
+        return false;
+
+    for (ReaderSlot const& slot : ReaderSlots)
+    {
+        uint64 pinned = slot.PinnedEpoch.load(std::memory_order_seq_cst);
+        if (pinned && pinned <= retireEpoch)
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,100 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_READ_COPY_UPDATE_H
+#define TRINITY_READ_COPY_UPDATE_H
+
+#include "Define.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Trinity
+{
+namespace Impl
+{
+// Epoch based reclamation shared by all ReadCopyUpdate instances
+// every reader thread owns a cache line sized slot, readers never write memory touched by other readers
+class TC_COMMON_API EpochDomain
+{
+public:
+    static void EnterRead();
+    static void LeaveRead();
+
+    // returns the epoch in which an object was unpublished
+    static uint64 Retire();
+    static bool CanReclaim(uint64 retireEpoch);
+};
+
+struct EpochReadGuard
+{
+    EpochReadGuard() { EpochDomain::EnterRead(); }
+    ~EpochReadGuard() { EpochDomain::LeaveRead(); }
+
+    EpochReadGuard(EpochReadGuard const&) = delete;
+    EpochReadGuard& operator=(EpochReadGuard const&) = delete;
+};
+}
+
+// Holds an immutable snapshot of T that can be read without locks
+// writers copy the current snapshot, modify the copy and publish it, old snapshots are freed once no reader can see them
+template<typename T>
+class ReadCopyUpdate
+{
+public:
+    ReadCopyUpdate() : _current(new T()) { }
+    ~ReadCopyUpdate() { delete _current.load(std::memory_order_relaxed); }
+
+    ReadCopyUpdate(ReadCopyUpdate const&) = delete;
+    ReadCopyUpdate& operator=(ReadCopyUpdate const&) = delete;
+
+    // reader must not keep references to the snapshot after returning
+    template<typename Reader>
+    decltype(auto) Read(Reader&& reader) const
+    {
+        Impl::EpochReadGuard guard;
+        return std::forward<Reader>(reader)(*_current.load(std::memory_order_seq_cst));
+    }
+
+    template<typename Updater>
+    void Update(Updater&& updater)
+    {
+        std::lock_guard<std::mutex> lock(_writeLock);
+
+        std::unique_ptr<T> copy = std::make_unique<T>(*_current.load(std::memory_order_relaxed));
+        std::forward<Updater>(updater)(*copy);
+
+        std::unique_ptr<T const> old(_current.exchange(copy.release(), std::memory_order_seq_cst));
+        _retired.emplace_back(Impl::EpochDomain::Retire(), std::move(old));
+
+        std::erase_if(_retired, [](std::pair<uint64, std::unique_ptr<T const>> const& retired)
+        {
+            return Impl::EpochDomain::CanReclaim(retired.first);
+        });
+    }
+
+private:
+    std::atomic<T const*> _current;
+
+    std::mutex _writeLock;
+    std::vector<std::pair<uint64, std::unique_ptr<T const>>> _retired;
+};
+}
+
+#endif // TRINITY_READ_COPY_UPDATE_H
@@ -0,0 +1,123 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskGraph.h"
+#include "Errors.h"
+#include "ThreadPool.h"
+#include "Timer.h"
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+namespace Trinity
+{
+TaskGraph::TaskId TaskGraph::Add(std::string name, std::function<void()> work, std::initializer_list<TaskId> dependencies)
+{
+    TaskId id = _tasks.size();
+    Task& task = _tasks.emplace_back();
+    task.Name = std::move(name);
+    task.Work = std::move(work);
+    for (TaskId dependency : dependencies)
+    {
+        ASSERT(dependency < id, "Task %s depends on a task that was not added before it", task.Name.c_str());
+        _tasks[dependency].Dependents.push_back(id);
+        ++task.DependencyCount;
+    }
+
+    return id;
+}
+
+void TaskGraph::Run(ThreadPool* pool)
+{
+    // tasks can only depend on tasks added before them, so insertion order is a valid sequential order
+    if (!pool)
+    {
+        for (Task& task : _tasks)
+        {
+            uint32 startTime = getMSTime();
+            task.Work();
+            task.Duration = GetMSTimeDiffToNow(startTime);
+            task.Finished = true;
+        }
+        return;
+    }
+
+    std::mutex lock;
+    std::condition_variable allDone;
+    std::vector<uint32> pendingDependencies;
+    pendingDependencies.reserve(_tasks.size());
+    for (Task const& task : _tasks)
+        pendingDependencies.push_back(task.DependencyCount);
+
+    std::size_t running = 0;
+    std::exception_ptr error;
+
+    std::function<void(TaskId)> start = [&](TaskId id)
+    {
+        ++running;
+        pool->PostWork([&, id]
+        {
+            Task& task = _tasks[id];
+            std::exception_ptr taskError;
+            uint32 startTime = getMSTime();
+            try
+            {
+                task.Work();
+            }
+            catch (...)
+            {
+                taskError = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> guard(lock);
+            task.Duration = GetMSTimeDiffToNow(startTime);
+            task.Finished = !taskError;
+            if (taskError && !error)
+                error = taskError;
+
+            if (!error)
+                for (TaskId dependent : task.Dependents)
+                    if (!--pendingDependencies[dependent])
+                        start(dependent);
+
+            if (!--running)
+                allDone.notify_all();
+        });
+    };
+
+    std::unique_lock<std::mutex> guard(lock);
+    for (TaskId id = 0; id < _tasks.size(); ++id)
+        if (!pendingDependencies[id])
+            start(id);
+
+    allDone.wait(guard, [&] { return !running; });
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+std::vector<TaskGraph::Timing> TaskGraph::GetTimings() const
+{
+    std::vector<Timing> timings;
+    timings.reserve(_tasks.size());
+    for (Task const& task : _tasks)
+        if (task.Finished)
+            timings.push_back({ task.Name, task.Duration });
+
+    return timings;
+}
+}
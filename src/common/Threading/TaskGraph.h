@@ -0,0 +1,76 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TASK_GRAPH_H
+#define TRINITY_TASK_GRAPH_H
+
+#include "Define.h"
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+namespace Trinity
+{
+class ThreadPool;
+
+// Set of named tasks with explicit dependencies, every task starts as soon as all tasks it depends on have finished
+// tasks are started in the order they were added when several become ready at once
+class TC_COMMON_API TaskGraph
+{
+public:
+    using TaskId = std::size_t;
+
+    struct Timing
+    {
+        std::string Name;
+        uint32 Duration = 0;    // milliseconds
+    };
+
+    TaskGraph() = default;
+
+    TaskGraph(TaskGraph const&) = delete;
+    TaskGraph& operator=(TaskGraph const&) = delete;
+
+    // dependencies must be ids returned by earlier calls, which makes cycles impossible
+    TaskId Add(std::string name, std::function<void()> work, std::initializer_list<TaskId> dependencies = {});
+
+    // blocks until every task has finished, tasks run on the calling thread when no pool is given
+    // the first exception thrown by a task is rethrown once running tasks have finished, tasks that did not start yet are skipped
+    void Run(ThreadPool* pool);
+
+    // durations of the finished tasks, in the order they were added
+    std::vector<Timing> GetTimings() const;
+
+    std::size_t GetSize() const { return _tasks.size(); }
+
+private:
+    struct Task
+    {
+        std::string Name;
+        std::function<void()> Work;
+        std::vector<TaskId> Dependents;
+        uint32 DependencyCount = 0;
+        uint32 Duration = 0;
+        bool Finished = false;
+    };
+
+    std::vector<Task> _tasks;
+};
+}
+
+#endif // TRINITY_TASK_GRAPH_H
@@ -0,0 +1,320 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreadAffinity.h"
+#include "Log.h"
+#include "StringConvert.h"
+#include "StringFormat.h"
+#include "Util.h"
+#include <boost/filesystem/operations.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#include <Windows.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <cstring>
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+struct ThreadClassSettings
+{
+    std::vector<uint32> Processors;
+    bool NumaLocalMemory = false;
+    std::atomic<uint32> AppliedThreads;
+    std::atomic<uint32> FailedThreads;
+};
+
+std::array<ThreadClassSettings, std::size_t(Trinity::ThreadClass::Max)> Settings;
+
+std::string_view Trim(std::string_view str)
+{
+    while (!str.empty() && std::isspace(uint8(str.front())))
+        str.remove_prefix(1);
+    while (!str.empty() && std::isspace(uint8(str.back())))
+        str.remove_suffix(1);
+    return str;
+}
+
+bool ParseProcessorListTo(std::string_view processors, std::vector<uint32>& result, bool allowNodes)
+{
+    for (std::string_view token : Trinity::Tokenize(processors, ',', false))
+    {
+        token = Trim(token);
+        if (token.empty())
+            continue;
+
+        if (token.starts_with("node:"))
+        {
+            Optional<uint32> node = Trinity::StringTo<uint32>(Trim(token.substr(5)));
+            if (!allowNodes || !node)
+                return false;
+
+            std::vector<uint32> nodeProcessors = Trinity::ThreadAffinity::GetNumaNodeProcessors(*node);
+            if (nodeProcessors.empty())
+                return false;
+
+            result.insert(result.end(), nodeProcessors.begin(), nodeProcessors.end());
+            continue;
+        }
+
+        std::size_t dash = token.find('-');
+        Optional<uint32> first = Trinity::StringTo<uint32>(Trim(token.substr(0, dash)));
+        Optional<uint32> last = dash != std::string_view::npos ? Trinity::StringTo<uint32>(Trim(token.substr(dash + 1))) : first;
+        if (!first || !last || *first > *last)
+            return false;
+
+        for (uint32 processor = *first; processor <= *last; ++processor)
+            result.push_back(processor);
+    }
+
+    return true;
+}
+
+// "0-3,8" style ranges for logs
+std::string FormatProcessorList(std::vector<uint32> const& processors)
+{
+    std::string result;
+    for (std::size_t i = 0; i < processors.size();)
+    {
+        std::size_t last = i;
+        while (last + 1 < processors.size() && processors[last + 1] == processors[last] + 1)
+            ++last;
+
+        if (!result.empty())
+            result += ',';
+
+        if (last == i)
+            Trinity::StringFormatTo(std::back_inserter(result), "{}", processors[i]);
+        else
+            Trinity::StringFormatTo(std::back_inserter(result), "{}-{}", processors[i], processors[last]);
+
+        i = last + 1;
+    }
+    return result;
+}
+
+std::vector<uint32> GetNumaNodes(std::vector<uint32> const& processors)
+{
+    std::vector<uint32> nodes;
+    for (uint32 processor : processors)
+        if (Optional<uint32> node = Trinity::ThreadAffinity::GetProcessorNumaNode(processor))
+            nodes.push_back(*node);
+
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+    return nodes;
+}
+
+bool SetCurrentThreadProcessors(std::vector<uint32> const& processors, std::string& error)
+{
+#ifdef _WIN32
+    // without processor groups only the first 64 processors can be addressed
+    DWORD_PTR mask = 0;
+    for (uint32 processor : processors)
+        if (processor < sizeof(mask) * 8)
+            mask |= DWORD_PTR(1) << processor;
+
+    if (!mask || !SetThreadAffinityMask(GetCurrentThread(), mask))
+    {
+        error = Trinity::StringFormat("SetThreadAffinityMask failed, error {}", GetLastError());
+        return false;
+    }
+    return true;
+#elif defined(__linux__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    for (uint32 processor : processors)
+        if (processor < CPU_SETSIZE)
+            CPU_SET(processor, &mask);
+
+    if (int result = pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask))
+    {
+        error = strerror(result);
+        return false;
+    }
+    return true;
+#else
+    (void)processors;
+    error = "thread affinity is not supported on this platform";
+    return false;
+#endif
+}
+
+bool SetCurrentThreadMemoryNodes(std::vector<uint32> const& nodes, std::string& error)
+{
+#ifdef __linux__
+    // preferred (not bound) so that a full node falls back to the others instead of failing allocations
+    // MPOL_PREFERRED accepts a single node, use the first one of the processor set
+    std::array<unsigned long, 16> nodeMask = { };
+    uint32 node = nodes.front();
+    if (node >= nodeMask.size() * sizeof(unsigned long) * 8)
+    {
+        error = Trinity::StringFormat("NUMA node {} is out of range", node);
+        return false;
+    }
+
+    nodeMask[node / (sizeof(unsigned long) * 8)] |= 1ul << (node % (sizeof(unsigned long) * 8));
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, nodeMask.data(), nodeMask.size() * sizeof(unsigned long) * 8 + 1))
+    {
+        error = strerror(errno);
+        return false;
+    }
+    return true;
+#else
+    (void)nodes;
+    error = "NUMA local memory is only supported on Linux";
+    return false;
+#endif
+}
+}
+
+char const* Trinity::GetThreadClassName(ThreadClass threadClass)
+{
+    switch (threadClass)
+    {
+        case ThreadClass::MapUpdate: return "map update";
+        case ThreadClass::Network: return "network";
+        case ThreadClass::DatabaseAsync: return "database async";
+        case ThreadClass::ThreadPool: return "thread pool";
+        default:
+            break;
+    }
+    return "unknown";
+}
+
+Optional<std::vector<uint32>> Trinity::ThreadAffinity::ParseProcessorList(std::string_view processors)
+{
+    std::vector<uint32> result;
+    if (!ParseProcessorListTo(processors, result, true))
+        return {};
+
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+std::vector<uint32> Trinity::ThreadAffinity::GetNumaNodeProcessors(uint32 node)
+{
+    std::vector<uint32> processors;
+#ifdef __linux__
+    std::ifstream cpuList(Trinity::StringFormat("/sys/devices/system/node/node{}/cpulist", node));
+    std::string line;
+    if (!std::getline(cpuList, line) || !ParseProcessorListTo(line, processors, false))
+        processors.clear();
+#else
+    (void)node;
+#endif
+    return processors;
+}
+
+Optional<uint32> Trinity::ThreadAffinity::GetProcessorNumaNode(uint32 processor)
+{
+#ifdef __linux__
+    // the cpu directory contains a nodeN link to the node it belongs to
+    boost::system::error_code error;
+    for (boost::filesystem::directory_iterator itr(Trinity::StringFormat("/sys/devices/system/cpu/cpu{}", processor), error), end; !error && itr != end; itr.increment(error))
+    {
+        std::string name = itr->path().filename().string();
+        if (name.starts_with("node"))
+            if (Optional<uint32> node = Trinity::StringTo<uint32>(std::string_view(name).substr(4)))
+                return node;
+    }
+#else
+    (void)processor;
+#endif
+    return {};
+}
+
+bool Trinity::ThreadAffinity::Configure(ThreadClass threadClass, std::string_view processors, bool numaLocalMemory)
+{
+    Optional<std::vector<uint32>> parsed = ParseProcessorList(processors);
+    if (!parsed)
+        return false;
+
+    ThreadClassSettings& settings = Settings[std::size_t(threadClass)];
+    settings.Processors = std::move(*parsed);
+    settings.NumaLocalMemory = numaLocalMemory && !settings.Processors.empty();
+    return true;
+}
+
+void Trinity::ThreadAffinity::ApplyToCurrentThread(ThreadClass threadClass)
+{
+    ThreadClassSettings& settings = Settings[std::size_t(threadClass)];
+    if (settings.Processors.empty())
+        return;
+
+    std::string error;
+    bool success = SetCurrentThreadProcessors(settings.Processors, error);
+    if (!success)
+        TC_LOG_ERROR("server", "Can't set processors {} of {} thread: {}", FormatProcessorList(settings.Processors), GetThreadClassName(threadClass), error);
+
+    if (settings.NumaLocalMemory)
+    {
+        std::vector<uint32> nodes = GetNumaNodes(settings.Processors);
+        if (nodes.empty())
+        {
+            success = false;
+            TC_LOG_ERROR("server", "Can't set NUMA local memory of {} thread: NUMA topology is not available", GetThreadClassName(threadClass));
+        }
+        else if (!SetCurrentThreadMemoryNodes(nodes, error))
+        {
+            success = false;
+            TC_LOG_ERROR("server", "Can't set NUMA local memory of {} thread: {}", GetThreadClassName(threadClass), error);
+        }
+    }
+
+    if (success)
+        ++settings.AppliedThreads;
+    else
+        ++settings.FailedThreads;
+}
+
+std::vector<std::string> Trinity::ThreadAffinity::GetSummary()
+{
+    std::vector<std::string> summary;
+    for (std::size_t i = 0; i < Settings.size(); ++i)
+    {
+        ThreadClassSettings const& settings = Settings[i];
+        char const* name = GetThreadClassName(ThreadClass(i));
+        if (settings.Processors.empty())
+        {
+            summary.push_back(Trinity::StringFormat("{}: not restricted", name));
+            continue;
+        }
+
+        std::string nodes;
+        for (uint32 node : GetNumaNodes(settings.Processors))
+            Trinity::StringFormatTo(std::back_inserter(nodes), "{}{}", nodes.empty() ? "" : ",", node);
+
+        summary.push_back(Trinity::StringFormat("{}: processors {} (NUMA nodes {}), NUMA local memory {}, applied to {} threads, failed for {}",
+            name, FormatProcessorList(settings.Processors), nodes.empty() ? "unknown" : nodes, settings.NumaLocalMemory ? "on" : "off",
+            settings.AppliedThreads.load(), settings.FailedThreads.load()));
+    }
+    return summary;
+}
@@ -0,0 +1,67 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_THREAD_AFFINITY_H
+#define TRINITY_THREAD_AFFINITY_H
+
+#include "Define.h"
+#include "Optional.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Trinity
+{
+enum class ThreadClass : uint8
+{
+    MapUpdate,
+    Network,
+    DatabaseAsync,
+    ThreadPool,         // threads running the main io context, they also write async logs
+
+    Max
+};
+
+TC_COMMON_API char const* GetThreadClassName(ThreadClass threadClass);
+
+// Placement of threads of one kind on a set of processors, unlike UseProcessors (which restricts the whole process)
+// Every thread of a configured class is allowed to run on all processors of its set, the OS still balances inside it
+// With NUMA local memory the memory first touched by these threads (their malloc arenas, TickArena blocks, ...)
+// is preferably taken from the NUMA node of their processors (Linux only)
+class TC_COMMON_API ThreadAffinity
+{
+public:
+    // comma separated processor numbers, ranges ("0-7,16-23") and whole NUMA nodes ("node:1", Linux only)
+    // an empty list is valid and means no restriction, nullopt when the list is malformed
+    static Optional<std::vector<uint32>> ParseProcessorList(std::string_view processors);
+
+    // empty when the node does not exist or NUMA topology is not available
+    static std::vector<uint32> GetNumaNodeProcessors(uint32 node);
+    static Optional<uint32> GetProcessorNumaNode(uint32 processor);
+
+    // must be called before threads of the class are started
+    static bool Configure(ThreadClass threadClass, std::string_view processors, bool numaLocalMemory);
+
+    // called by every thread of the class when it starts, does nothing for classes that were not configured
+    static void ApplyToCurrentThread(ThreadClass threadClass);
+
+    // one line per class with the chosen placement and the number of threads it was applied to
+    static std::vector<std::string> GetSummary();
+};
+}
+
+#endif // TRINITY_THREAD_AFFINITY_H
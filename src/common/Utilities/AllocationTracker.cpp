@@ -0,0 +1,131 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdlib>
+
+namespace
+{
+// keeps the alignment guaranteed by malloc for the memory handed out
+struct alignas(alignof(std::max_align_t)) AllocationHeader
+{
+    std::size_t Size;
+    Trinity::AllocationTag Tag;
+};
+
+// counters are spread over shards picked per thread to keep threads from fighting over the same cache lines
+// everything here is constant initialized, operator new can be called before any dynamic initialization
+struct alignas(64) CounterShard
+{
+    std::array<std::atomic<int64>, Trinity::AllocationTracker::TagCount> LiveBytes;
+    std::array<std::atomic<uint64>, Trinity::AllocationTracker::TagCount> Allocations;
+    std::array<std::atomic<uint64>, Trinity::AllocationTracker::TagCount> AllocatedBytes;
+};
+
+constexpr std::size_t ShardCount = 64;
+CounterShard Shards[ShardCount];
+std::atomic<std::size_t> NextShard;
+
+thread_local CounterShard* LocalShard = nullptr;
+thread_local Trinity::AllocationTag CurrentTag = Trinity::AllocationTag::Untagged;
+
+CounterShard& GetLocalShard()
+{
+    if (!LocalShard)
+        LocalShard = &Shards[NextShard.fetch_add(1, std::memory_order_relaxed) % ShardCount];
+
+    return *LocalShard;
+}
+}
+
+char const* Trinity::GetAllocationTagName(AllocationTag tag)
+{
+    switch (tag)
+    {
+        case AllocationTag::Untagged: return "untagged";
+        case AllocationTag::MapUpdate: return "map_update";
+        case AllocationTag::Packets: return "packets";
+        case AllocationTag::PacketHandlers: return "packet_handlers";
+        case AllocationTag::Spells: return "spells";
+        case AllocationTag::Auras: return "auras";
+        case AllocationTag::Players: return "players";
+        case AllocationTag::Creatures: return "creatures";
+        case AllocationTag::Grids: return "grids";
+        case AllocationTag::DatabaseResults: return "database_results";
+        case AllocationTag::DatabaseCallbacks: return "database_callbacks";
+        case AllocationTag::Scripts: return "scripts";
+        default:
+            break;
+    }
+    return "unknown";
+}
+
+Trinity::AllocationTag Trinity::AllocationTracker::GetCurrentTag()
+{
+    return CurrentTag;
+}
+
+Trinity::AllocationTag Trinity::AllocationTracker::SetCurrentTag(AllocationTag tag)
+{
+    AllocationTag previous = CurrentTag;
+    CurrentTag = tag;
+    return previous;
+}
+
+void* Trinity::AllocationTracker::Allocate(std::size_t size)
+{
+    AllocationHeader* header = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size));
+    if (!header)
+        return nullptr;
+
+    header->Size = size;
+    header->Tag = CurrentTag;
+
+    CounterShard& shard = GetLocalShard();
+    std::size_t tagIndex = std::size_t(header->Tag);
+    shard.LiveBytes[tagIndex].fetch_add(int64(size), std::memory_order_relaxed);
+    shard.Allocations[tagIndex].fetch_add(1, std::memory_order_relaxed);
+    shard.AllocatedBytes[tagIndex].fetch_add(size, std::memory_order_relaxed);
+    return header + 1;
+}
+
+void Trinity::AllocationTracker::Deallocate(void* ptr) noexcept
+{
+    if (!ptr)
+        return;
+
+    AllocationHeader* header = static_cast<AllocationHeader*>(ptr) - 1;
+    GetLocalShard().LiveBytes[std::size_t(header->Tag)].fetch_sub(int64(header->Size), std::memory_order_relaxed);
+    std::free(header);
+}
+
+std::array<Trinity::AllocationTracker::TagStatistics, Trinity::AllocationTracker::TagCount> Trinity::AllocationTracker::GetStatistics()
+{
+    std::array<TagStatistics, TagCount> statistics = { };
+    for (CounterShard const& shard : Shards)
+    {
+        for (std::size_t i = 0; i < TagCount; ++i)
+        {
+            statistics[i].LiveBytes += shard.LiveBytes[i].load(std::memory_order_relaxed);
+            statistics[i].Allocations += shard.Allocations[i].load(std::memory_order_relaxed);
+            statistics[i].AllocatedBytes += shard.AllocatedBytes[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    return statistics;
+}
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_ALLOCATION_TRACKER_H
+#define TRINITY_ALLOCATION_TRACKER_H
+
+#include "Define.h"
+#include <array>
+#include <cstddef>
+
+namespace Trinity
+{
+enum class AllocationTag : uint8
+{
+    Untagged,
+    MapUpdate,
+    Packets,                // packet objects and their buffers
+    PacketHandlers,
+    Spells,
+    Auras,
+    Players,
+    Creatures,
+    Grids,
+    DatabaseResults,
+    DatabaseCallbacks,
+    Scripts,
+
+    Max
+};
+
+TC_COMMON_API char const* GetAllocationTagName(AllocationTag tag);
+
+// Attributes heap memory to the subsystem that allocated it
+// Every allocation is charged to the tag of the innermost AllocationTagScope active on the allocating thread
+// and remembers it, so freeing it on any thread releases the bytes from the same tag
+// Only active when built WITH_ALLOCATION_TAGS, which replaces the global operator new/delete (see AllocationHooks.cpp)
+// and adds a small header to every allocation
+class TC_COMMON_API AllocationTracker
+{
+public:
+    static constexpr std::size_t TagCount = std::size_t(AllocationTag::Max);
+
+    struct TagStatistics
+    {
+        int64 LiveBytes = 0;
+        uint64 Allocations = 0;         // since startup
+        uint64 AllocatedBytes = 0;      // since startup
+    };
+
+    static constexpr bool IsEnabled()
+    {
+#ifdef WITH_ALLOCATION_TAGS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    static AllocationTag GetCurrentTag();
+    // returns the previous tag
+    static AllocationTag SetCurrentTag(AllocationTag tag);
+
+    // nullptr when out of memory
+    static void* Allocate(std::size_t size);
+    static void Deallocate(void* ptr) noexcept;
+
+    static std::array<TagStatistics, TagCount> GetStatistics();
+};
+
+class AllocationTagScope
+{
+public:
+    explicit AllocationTagScope(AllocationTag tag) : _previous(AllocationTracker::SetCurrentTag(tag)) { }
+    ~AllocationTagScope() { AllocationTracker::SetCurrentTag(_previous); }
+
+    AllocationTagScope(AllocationTagScope const&) = delete;
+    AllocationTagScope& operator=(AllocationTagScope const&) = delete;
+
+private:
+    AllocationTag _previous;
+};
+}
+
+#ifdef WITH_ALLOCATION_TAGS
+#define TC_ALLOCATION_TAG_DO_CONCAT(a, b) a ## b
+#define TC_ALLOCATION_TAG_CONCAT(a, b) TC_ALLOCATION_TAG_DO_CONCAT(a, b)
+#define TC_ALLOCATION_TAG_SCOPE(tag) Trinity::AllocationTagScope TC_ALLOCATION_TAG_CONCAT(__tc_allocation_tag, __LINE__)(Trinity::AllocationTag::tag)
+// charges objects of the class (and derived classes) to tag no matter where they are created
+#define TC_ALLOCATION_TAGGED_CLASS(tag) \
+    static void* operator new(std::size_t size) { Trinity::AllocationTagScope allocationTag(Trinity::AllocationTag::tag); return ::operator new(size); } \
+    static void operator delete(void* ptr) noexcept { ::operator delete(ptr); }
+#else
+#define TC_ALLOCATION_TAG_SCOPE(tag) ((void)0)
+#define TC_ALLOCATION_TAGGED_CLASS(tag)
+#endif
+
+#endif // TRINITY_ALLOCATION_TRACKER_H
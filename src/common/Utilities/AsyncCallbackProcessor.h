@@ -18,6 +18,7 @@
 #ifndef AsyncCallbackProcessor_h__
 #define AsyncCallbackProcessor_h__
 
+#include "AllocationTracker.h"
 #include <algorithm>
 #include <vector>
 
@@ -46,6 +47,7 @@ public:
 
         updateCallbacks.erase(std::remove_if(updateCallbacks.begin(), updateCallbacks.end(), [](T& callback)
         {
+            TC_ALLOCATION_TAG_SCOPE(DatabaseCallbacks);
             return callback.InvokeIfReady();
         }), updateCallbacks.end());
 
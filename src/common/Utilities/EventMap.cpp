@@ -16,7 +16,9 @@
  */
 
 #include "EventMap.h"
+#include "Containers.h"
 #include "Random.h"
+#include <algorithm>
 
 void EventMap::Reset()
 {
@@ -41,7 +43,7 @@ void EventMap::ScheduleEvent(uint32 eventId, Milliseconds time, uint32 group /*=
     if (phase && phase <= 8)
         eventId |= (1 << (phase + 23));
 
-    _eventMap.insert(EventStore::value_type(_time + time, eventId));
+    InsertEvent(_time + time, eventId);
 }
 
 void EventMap::ScheduleEvent(uint32 eventId, Milliseconds minTime, Milliseconds maxTime, uint32 group /*= 0*/, uint8 phase /*= 0*/)
@@ -62,7 +64,7 @@ void EventMap::RescheduleEvent(uint32 eventId, Milliseconds minTime, Millisecond
 
 void EventMap::Repeat(Milliseconds time)
 {
-    _eventMap.insert(EventStore::value_type(_time + time, _lastEvent));
+    InsertEvent(_time + time, _lastEvent);
 }
 
 void EventMap::Repeat(Milliseconds minTime, Milliseconds maxTime)
@@ -74,17 +76,17 @@ uint32 EventMap::ExecuteEvent()
 {
     while (!Empty())
     {
-        EventStore::iterator itr = _eventMap.begin();
+        EventStore::value_type const& next = _eventMap.back();
 
-        if (itr->first > _time)
+        if (next.first > _time)
             return 0;
-        else if (_phase && (itr->second & 0xFF000000) && !((itr->second >> 24) & _phase))
-            _eventMap.erase(itr);
+        else if (_phase && (next.second & 0xFF000000) && !((next.second >> 24) & _phase))
+            _eventMap.pop_back();
         else
         {
-            uint32 eventId = (itr->second & 0x0000FFFF);
-            _lastEvent = itr->second; // include phase/group
-            _eventMap.erase(itr);
+            uint32 eventId = (next.second & 0x0000FFFF);
+            _lastEvent = next.second; // include phase/group
+            _eventMap.pop_back();
             ScheduleNextFromSeries(_lastEvent);
             return eventId;
         }
@@ -98,13 +100,8 @@ void EventMap::DelayEvents(Milliseconds delay)
     if (Empty())
         return;
 
-    EventStore delayed = std::move(_eventMap);
-    for (EventStore::iterator itr = delayed.begin(); itr != delayed.end();)
-    {
-        EventStore::node_type node = delayed.extract(itr++);
-        node.key() = node.key() + delay;
-        _eventMap.insert(_eventMap.end(), std::move(node));
-    }
+    for (EventStore::value_type& event : _eventMap)
+        event.first += delay;
 }
 
 void EventMap::DelayEvents(Milliseconds delay, uint32 group)
@@ -112,20 +109,19 @@ void EventMap::DelayEvents(Milliseconds delay, uint32 group)
     if (!group || group > 8 || Empty())
         return;
 
+    // collected in execution order, delayed events are placed after other events with the same time
     EventStore delayed;
-
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
-    {
+    for (EventStore::reverse_iterator itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
         if (itr->second & (1 << (group + 15)))
-        {
-            delayed.insert(EventStore::value_type(itr->first + delay, itr->second));
-            _eventMap.erase(itr++);
-        }
-        else
-            ++itr;
-    }
+            delayed.emplace_back(itr->first + delay, itr->second);
+
+    if (delayed.empty())
+        return;
+
+    Trinity::Containers::EraseIf(_eventMap, [group](EventStore::value_type const& event) { return (event.second & (1 << (group + 15))) != 0; });
 
-    _eventMap.insert(delayed.begin(), delayed.end());
+    for (EventStore::value_type const& event : delayed)
+        InsertEvent(event.first, event.second);
 }
 
 void EventMap::CancelEvent(uint32 eventId)
@@ -133,13 +129,7 @@ void EventMap::CancelEvent(uint32 eventId)
     if (Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
-    {
-        if (eventId == (itr->second & 0x0000FFFF))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+    Trinity::Containers::EraseIf(_eventMap, [eventId](EventStore::value_type const& event) { return eventId == (event.second & 0x0000FFFF); });
 
     for (EventSeriesStore::iterator itr = _timerSeries.begin(); itr != _timerSeries.end();)
     {
@@ -155,13 +145,7 @@ void EventMap::CancelEventGroup(uint32 group)
     if (!group || group > 8 || Empty())
         return;
 
-    for (EventStore::iterator itr = _eventMap.begin(); itr != _eventMap.end();)
-    {
-        if (itr->second & (1 << (group + 15)))
-            _eventMap.erase(itr++);
-        else
-            ++itr;
-    }
+    Trinity::Containers::EraseIf(_eventMap, [group](EventStore::value_type const& event) { return (event.second & (1 << (group + 15))) != 0; });
 
     for (EventSeriesStore::iterator itr = _timerSeries.begin(); itr != _timerSeries.end();)
     {
@@ -174,13 +158,19 @@ void EventMap::CancelEventGroup(uint32 group)
 
 Milliseconds EventMap::GetTimeUntilEvent(uint32 eventId) const
 {
-    for (std::pair<TimePoint const, uint32> const& itr : _eventMap)
-        if (eventId == (itr.second & 0x0000FFFF))
-            return std::chrono::duration_cast<Milliseconds>(itr.first - _time);
+    for (EventStore::const_reverse_iterator itr = _eventMap.rbegin(); itr != _eventMap.rend(); ++itr)
+        if (eventId == (itr->second & 0x0000FFFF))
+            return std::chrono::duration_cast<Milliseconds>(itr->first - _time);
 
     return Milliseconds::max();
 }
 
+void EventMap::InsertEvent(TimePoint time, uint32 eventData)
+{
+    EventStore::iterator itr = std::partition_point(_eventMap.begin(), _eventMap.end(), [time](EventStore::value_type const& event) { return event.first > time; });
+    _eventMap.emplace(itr, time, eventData);
+}
+
 void EventMap::ScheduleNextFromSeries(uint32 eventData)
 {
     EventSeriesStore::iterator itr = _timerSeries.find(eventData);
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "Duration.h"
+#include <boost/container/small_vector.hpp>
 #include <map>
 #include <queue>
 
@@ -27,8 +28,12 @@ class TC_COMMON_API EventMap
 {
     /**
     * Internal storage type.
-    * Key: Time as TimePoint when the event should occur.
-    * Value: The event data as uint32.
+    * First: Time as TimePoint when the event should occur.
+    * Second: The event data as uint32.
+    *
+    * Sorted by descending time, the next event to execute is the last element.
+    * Events with equal time are stored in reverse scheduling order so they execute in scheduling order.
+    * Scripts rarely have more than a few events scheduled, these are stored without allocating.
     *
     * Structure of event data:
     * - Bit  0 - 15: Event Id.
@@ -36,7 +41,7 @@ class TC_COMMON_API EventMap
     * - Bit 24 - 31: Phase
     * - Pattern: 0xPPGGEEEE
     */
-    typedef std::multimap<TimePoint, uint32> EventStore;
+    typedef boost::container::small_vector<std::pair<TimePoint, uint32>, 8> EventStore;
     typedef std::map<uint32 /*event data*/, std::queue<Milliseconds>> EventSeriesStore;
 
 public:
@@ -253,6 +258,14 @@ public:
     void ScheduleEventSeries(uint32 eventId, std::initializer_list<Milliseconds> const& series);
 
 private:
+    /**
+    * @name InsertEvent
+    * @brief Inserts event data at its position in the storage, after all events with the same or earlier time.
+    * @param time Time when the event should occur.
+    * @param eventData Full event data, including group and phase.
+    */
+    void InsertEvent(TimePoint time, uint32 eventData);
+
     /**
     * @name _time
     * @brief Internal timer.
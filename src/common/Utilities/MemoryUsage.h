@@ -0,0 +1,171 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MEMORY_USAGE_H
+#define TRINITY_MEMORY_USAGE_H
+
+#include "Define.h"
+#include "FlatSet.h"
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Trinity
+{
+/**
+    @class MemoryUsageReport
+
+    @brief Named estimates of the heap memory owned by data stores and managers
+
+    Every entry belongs to a category (the owner, like "db2" or "ObjectMgr") and names one container
+    or store of that owner. Values are estimates computed from container sizes, allocator overhead is ignored.
+*/
+class MemoryUsageReport
+{
+public:
+    struct Entry
+    {
+        std::string Category;
+        std::string Name;
+        std::size_t Bytes = 0;
+    };
+
+    void Add(std::string category, std::string name, std::size_t bytes)
+    {
+        _entries.push_back({ std::move(category), std::move(name), bytes });
+    }
+
+    std::vector<Entry> const& GetEntries() const { return _entries; }
+
+    // totals per category, ordered by category name
+    std::map<std::string, std::size_t> GetCategoryTotals() const
+    {
+        std::map<std::string, std::size_t> totals;
+        for (Entry const& entry : _entries)
+            totals[entry.Category] += entry.Bytes;
+        return totals;
+    }
+
+    std::size_t GetTotal() const
+    {
+        std::size_t total = 0;
+        for (Entry const& entry : _entries)
+            total += entry.Bytes;
+        return total;
+    }
+
+private:
+    std::vector<Entry> _entries;
+};
+
+// Estimates of the memory allocated by standard containers, excluding the container object itself
+// node overhead follows the common node layouts (three pointers and a color for tree nodes, a next pointer and cached hash for hash nodes)
+namespace MemoryUsage
+{
+    inline std::size_t Of(std::string const& str)
+    {
+        // short strings are stored inside the object
+        static std::size_t const inlineCapacity = std::string().capacity();
+        return str.capacity() > inlineCapacity ? str.capacity() + 1 : 0;
+    }
+
+    template<typename T, typename A>
+    std::size_t Of(std::vector<T, A> const& container)
+    {
+        return container.capacity() * sizeof(T);
+    }
+
+    template<typename A>
+    std::size_t Of(std::vector<std::string, A> const& container)
+    {
+        std::size_t size = container.capacity() * sizeof(std::string);
+        for (std::string const& str : container)
+            size += Of(str);
+        return size;
+    }
+
+    template<typename T, typename A>
+    std::size_t Of(std::list<T, A> const& container)
+    {
+        return container.size() * (sizeof(T) + 2 * sizeof(void*));
+    }
+
+    template<typename T>
+    constexpr std::size_t TreeNodeSize = sizeof(T) + 4 * sizeof(void*);
+
+    template<typename T>
+    constexpr std::size_t HashNodeSize = sizeof(T) + 2 * sizeof(void*);
+
+    template<typename K, typename V, typename C, typename A>
+    std::size_t Of(std::map<K, V, C, A> const& container)
+    {
+        return container.size() * TreeNodeSize<typename std::map<K, V, C, A>::value_type>;
+    }
+
+    template<typename K, typename V, typename C, typename A>
+    std::size_t Of(std::multimap<K, V, C, A> const& container)
+    {
+        return container.size() * TreeNodeSize<typename std::multimap<K, V, C, A>::value_type>;
+    }
+
+    template<typename K, typename C, typename A>
+    std::size_t Of(std::set<K, C, A> const& container)
+    {
+        return container.size() * TreeNodeSize<K>;
+    }
+
+    template<typename K, typename C, typename KC>
+    std::size_t Of(Containers::FlatSet<K, C, KC> const& container)
+    {
+        return container.capacity() * sizeof(K);
+    }
+
+    template<typename K, typename V, typename H, typename E, typename A>
+    std::size_t Of(std::unordered_map<K, V, H, E, A> const& container)
+    {
+        return container.bucket_count() * sizeof(void*) + container.size() * HashNodeSize<typename std::unordered_map<K, V, H, E, A>::value_type>;
+    }
+
+    template<typename K, typename V, typename H, typename E, typename A>
+    std::size_t Of(std::unordered_multimap<K, V, H, E, A> const& container)
+    {
+        return container.bucket_count() * sizeof(void*) + container.size() * HashNodeSize<typename std::unordered_multimap<K, V, H, E, A>::value_type>;
+    }
+
+    template<typename K, typename H, typename E, typename A>
+    std::size_t Of(std::unordered_set<K, H, E, A> const& container)
+    {
+        return container.bucket_count() * sizeof(void*) + container.size() * HashNodeSize<K>;
+    }
+
+    // container memory plus memory owned by its elements, elementUsage is called with every element (key/value pair for maps)
+    template<typename Container, typename ElementUsage>
+    std::size_t Of(Container const& container, ElementUsage&& elementUsage)
+    {
+        std::size_t size = Of(container);
+        for (auto const& element : container)
+            size += elementUsage(element);
+        return size;
+    }
+}
+}
+
+#endif // TRINITY_MEMORY_USAGE_H
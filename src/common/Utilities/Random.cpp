@@ -32,6 +32,22 @@ static SFMTRand* GetRng()
     return sfmtRand.get();
 }
 
+// draws from the generator of the calling thread found once, for rolling many times in a row
+class ThreadRandomEngine
+{
+public:
+    typedef uint32 result_type;
+
+    explicit ThreadRandomEngine(SFMTRand& rng) : _rng(rng) { }
+
+    static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    result_type operator()() const { return _rng.RandomUInt32(); }
+
+private:
+    SFMTRand& _rng;
+};
+
 int32 irand(int32 min, int32 max)
 {
     ASSERT(max >= min);
@@ -67,11 +83,21 @@ Milliseconds randtime(Milliseconds min, Milliseconds max)
     return min + Milliseconds(urand(0, uint32(diff)));
 }
 
+void SeedRandomEngine(uint32 seed)
+{
+    sfmtRand = std::make_unique<SFMTRand>(seed);
+}
+
 uint32 rand32()
 {
     return GetRng()->RandomUInt32();
 }
 
+void fill_rand32(uint32* values, size_t count)
+{
+    GetRng()->RandomUInt32(values, count);
+}
+
 float rand_norm()
 {
     std::uniform_real_distribution<float> urd;
@@ -84,6 +110,14 @@ float rand_chance()
     return urd(engine);
 }
 
+void roll_chances_f(size_t count, float const* chances, bool* results)
+{
+    ThreadRandomEngine threadEngine(*GetRng());
+    std::uniform_real_distribution<float> urd(0.0f, 100.0f);
+    for (size_t i = 0; i < count; ++i)
+        results[i] = chances[i] > urd(threadEngine);
+}
+
 uint32 urandweighted(size_t count, double const* chances)
 {
     std::discrete_distribution<uint32> dd(chances, chances + count);
@@ -34,6 +34,9 @@ TC_COMMON_API uint32 urandms(uint32 min, uint32 max);
 /* Return a random number in the range 0 .. UINT32_MAX. */
 TC_COMMON_API uint32 rand32();
 
+/* Fill values with count random numbers in the range 0 .. UINT32_MAX, the same ones count calls to rand32() would return. */
+TC_COMMON_API void fill_rand32(uint32* values, size_t count);
+
 /* Return a random time in the range min..max (up to millisecond precision). Only works for values where millisecond difference is a valid uint32. */
 TC_COMMON_API Milliseconds randtime(Milliseconds min, Milliseconds max);
 
@@ -49,6 +52,9 @@ TC_COMMON_API float rand_chance();
 /* Return a random number in the range 0..count (exclusive) with each value having a different chance of happening */
 TC_COMMON_API uint32 urandweighted(size_t count, double const* chances);
 
+/* Reseed the generator of the calling thread, making all following rolls on that thread reproducible. Meant for tools and benchmarks. */
+TC_COMMON_API void SeedRandomEngine(uint32 seed);
+
 /* Return true if a random roll fits in the specified chance (range 0-100). */
 inline bool roll_chance_f(float chance)
 {
@@ -61,6 +67,10 @@ inline bool roll_chance_i(int chance)
     return chance > irand(0, 99);
 }
 
+/* Store in results whether a random roll fits in each of count chances (range 0-100).
+   Rolls the same as calling roll_chance_f for every chance in order, without looking up the generator for each of them. */
+TC_COMMON_API void roll_chances_f(size_t count, float const* chances, bool* results);
+
 /*
 * Wrapper satisfying UniformRandomNumberGenerator concept for use in <random> algorithms
 */
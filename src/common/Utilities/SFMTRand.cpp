@@ -67,9 +67,27 @@ SFMTRand::SFMTRand()
         sfmt_init_gen_rand(&_state, uint32(time(nullptr)));
 }
 
-uint32 SFMTRand::RandomUInt32()                            // Output random bits
+SFMTRand::SFMTRand(uint32 seed)
 {
-    return sfmt_genrand_uint32(&_state);
+    sfmt_init_gen_rand(&_state, seed);
+}
+
+void SFMTRand::RandomUInt32(uint32* values, std::size_t count)
+{
+    uint32 const* block = &_state.state[0].u[0];
+    while (count)
+    {
+        if (_state.idx >= SFMT_N32)
+        {
+            sfmt_gen_rand_all(&_state);
+            _state.idx = 0;
+        }
+
+        std::size_t available = std::min<std::size_t>(SFMT_N32 - _state.idx, count);
+        values = std::copy_n(block + _state.idx, available, values);
+        _state.idx += int(available);
+        count -= available;
+    }
 }
 
 void* SFMTRand::operator new(size_t size, std::nothrow_t const&)
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include <SFMT.h>
+#include <cstddef>
 #include <new>
 
 /*
@@ -28,7 +29,11 @@
 class SFMTRand {
 public:
     SFMTRand();
-    uint32 RandomUInt32(); // Output random bits
+    explicit SFMTRand(uint32 seed);
+    // words are served from the state block, which is regenerated with SIMD once all SFMT_N32 words were used
+    uint32 RandomUInt32() { return sfmt_genrand_uint32(&_state); } // Output random bits
+    // the same words count calls to RandomUInt32() would return, copied out a block at a time
+    void RandomUInt32(uint32* values, std::size_t count);
     void* operator new(size_t size, std::nothrow_t const&);
     void operator delete(void* ptr, std::nothrow_t const&);
     void* operator new(size_t size);
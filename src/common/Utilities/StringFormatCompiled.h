@@ -0,0 +1,64 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_STRING_FORMAT_COMPILED_H
+#define TRINITYCORE_STRING_FORMAT_COMPILED_H
+
+#include "StringFormat.h"
+#include <fmt/compile.h>
+
+/// Format string parsed at compile time into formatting code for its exact arguments, no parsing happens at runtime
+/// Meant for hot formatting code, every distinct string instantiates its own code so keep it out of rarely used paths
+/// Trinity::StringFormat(TC_COMPILED_FORMAT("{}-{}"), a, b)
+#define TC_COMPILED_FORMAT(fmt) FMT_COMPILE(fmt)
+
+namespace Trinity
+{
+    template<typename CompiledFormat>
+    concept CompiledFormatString = fmt::detail::is_compiled_string<CompiledFormat>::value;
+
+    // formats through fmt::appender like the runtime functions do, formatters only written for fmt::format_context keep working
+    template<CompiledFormatString CompiledFormat, typename... Args>
+    inline std::string StringFormat(CompiledFormat const& fmt, Args&&... args)
+    {
+        try
+        {
+            fmt::memory_buffer buffer;
+            fmt::format_to(fmt::appender(buffer), fmt, std::forward<Args>(args)...);
+            return fmt::to_string(buffer);
+        }
+        catch (std::exception const& formatError)
+        {
+            return fmt::format("An error occurred formatting compiled string: {}", formatError.what());
+        }
+    }
+
+    template<typename OutputIt, CompiledFormatString CompiledFormat, typename... Args>
+    inline OutputIt StringFormatTo(OutputIt out, CompiledFormat const& fmt, Args&&... args)
+    {
+        try
+        {
+            return fmt::format_to(out, fmt, std::forward<Args>(args)...);
+        }
+        catch (std::exception const& formatError)
+        {
+            return fmt::format_to(out, "An error occurred formatting compiled string: {}", formatError.what());
+        }
+    }
+}
+
+#endif
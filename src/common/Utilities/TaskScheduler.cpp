@@ -16,6 +16,7 @@
  */
 
 #include "TaskScheduler.h"
+#include "Containers.h"
 #include "Errors.h"
 
 TaskScheduler& TaskScheduler::ClearValidator()
@@ -114,19 +115,24 @@ void TaskScheduler::Dispatch(success_t const& callback/* = nullptr*/)
 
 void TaskScheduler::TaskQueue::Push(TaskContainer&& task)
 {
-    container.emplace(std::move(task));
+    // insert after all tasks ending at the same time or earlier
+    auto itr = std::partition_point(container.begin(), container.end(), [&task](TaskContainer const& queued)
+    {
+        return queued->_end > task->_end;
+    });
+    container.insert(itr, std::move(task));
 }
 
 auto TaskScheduler::TaskQueue::Pop() -> TaskContainer
 {
-    TaskContainer result = *container.begin();
-    container.erase(container.begin());
+    TaskContainer result = std::move(container.back());
+    container.pop_back();
     return result;
 }
 
 auto TaskScheduler::TaskQueue::First() const -> TaskContainer const&
 {
-    return *container.begin();
+    return container.back();
 }
 
 void TaskScheduler::TaskQueue::Clear()
@@ -136,26 +142,24 @@ void TaskScheduler::TaskQueue::Clear()
 
 void TaskScheduler::TaskQueue::RemoveIf(std::function<bool(TaskContainer const&)> const& filter)
 {
-    for (auto itr = container.begin(); itr != container.end();)
-        if (filter(*itr))
-            itr = container.erase(itr);
-        else
-            ++itr;
+    Trinity::Containers::EraseIf(container, [&filter](TaskContainer const& task) { return filter(task); });
 }
 
 void TaskScheduler::TaskQueue::ModifyIf(std::function<bool(TaskContainer const&)> const& filter)
 {
+    // filters modify the tasks they match, each task is passed exactly once and in dispatch order
     std::vector<TaskContainer> cache;
-    for (auto itr = container.begin(); itr != container.end();)
+    for (auto itr = container.rbegin(); itr != container.rend(); ++itr)
         if (filter(*itr))
-        {
-            cache.push_back(*itr);
-            itr = container.erase(itr);
-        }
-        else
-            ++itr;
-
-    container.insert(cache.begin(), cache.end());
+            cache.push_back(std::move(*itr));
+
+    if (cache.empty())
+        return;
+
+    Trinity::Containers::EraseIf(container, [](TaskContainer const& task) { return !task; });
+
+    for (TaskContainer& task : cache)
+        Push(std::move(task));
 }
 
 bool TaskScheduler::TaskQueue::IsEmpty() const
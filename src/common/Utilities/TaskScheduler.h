@@ -21,13 +21,13 @@
 #include "Duration.h"
 #include "Optional.h"
 #include "Random.h"
+#include "ThreadLocalPool.h"
 #include <algorithm>
 #include <functional>
 #include <vector>
 #include <queue>
 #include <memory>
 #include <utility>
-#include <set>
 
 class TaskContext;
 
@@ -117,18 +117,19 @@ class TC_COMMON_API TaskScheduler
 
     typedef std::shared_ptr<Task> TaskContainer;
 
-    /// Container which provides Task order, insert and reschedule operations.
-    struct Compare
+    /// Creates a task, tasks and their reference counts share one block from a per thread pool.
+    template<typename... Args>
+    static TaskContainer MakeTask(Args&&... args)
     {
-        bool operator() (TaskContainer const& left, TaskContainer const& right) const
-        {
-            return (*left.get()) < (*right.get());
-        }
-    };
+        return std::allocate_shared<Task>(Trinity::ThreadLocalPoolAllocator<Task>(), std::forward<Args>(args)...);
+    }
 
+    /// Container which provides Task order, insert and reschedule operations.
     class TC_COMMON_API TaskQueue
     {
-        std::multiset<TaskContainer, Compare> container;
+        /// Sorted by descending end, the next task is the last element.
+        /// Tasks with equal end are stored in reverse insertion order so they are dispatched in insertion order.
+        std::vector<TaskContainer> container;
 
     public:
         // Pushes the task in the container
@@ -370,7 +371,7 @@ private:
     TaskScheduler& ScheduleAt(timepoint_t end,
         std::chrono::duration<Rep, Period> time, task_handler_t task)
     {
-        return InsertTask(TaskContainer(new Task(end + time, time, std::move(task))));
+        return InsertTask(MakeTask(end + time, time, std::move(task)));
     }
 
     /// Schedule an event with a fixed rate.
@@ -381,7 +382,7 @@ private:
         group_t const group, task_handler_t task)
     {
         static constexpr repeated_t DEFAULT_REPEATED = 0;
-        return InsertTask(TaskContainer(new Task(end + time, time, group, DEFAULT_REPEATED, std::move(task))));
+        return InsertTask(MakeTask(end + time, time, group, DEFAULT_REPEATED, std::move(task)));
     }
 
     /// Dispatch remaining tasks
@@ -407,11 +408,11 @@ class TC_COMMON_API TaskContext
 public:
     // Empty constructor
     TaskContext()
-        : _task(), _owner(), _consumed(std::make_shared<bool>(true)) { }
+        : _task(), _owner(), _consumed(std::allocate_shared<bool>(Trinity::ThreadLocalPoolAllocator<bool>(), true)) { }
 
     // Construct from task and owner
     explicit TaskContext(TaskScheduler::TaskContainer&& task, std::weak_ptr<TaskScheduler>&& owner)
-        : _task(std::move(task)), _owner(std::move(owner)), _consumed(std::make_shared<bool>(false)) { }
+        : _task(std::move(task)), _owner(std::move(owner)), _consumed(std::allocate_shared<bool>(Trinity::ThreadLocalPoolAllocator<bool>(), false)) { }
 
     // Copy construct
     TaskContext(TaskContext const& right)
@@ -0,0 +1,143 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_THREAD_LOCAL_POOL_H
+#define TRINITY_THREAD_LOCAL_POOL_H
+
+#include "Define.h"
+#include <new>
+#include <vector>
+
+namespace Trinity
+{
+// Per thread free list of memory blocks for classes that are created and destroyed at high rates
+// Intended to back class specific operator new/delete. Blocks freed by a thread stay with that thread,
+// each list is capped at MaxFree blocks and allocations of other sizes (derived classes) bypass the pool
+template <typename T, std::size_t MaxFree = 256>
+class ThreadLocalAllocationPool
+{
+public:
+    static void* Allocate(std::size_t size)
+    {
+        if (size == sizeof(T) && !Destroyed)
+        {
+            std::vector<void*>& blocks = Cache.Blocks;
+            if (!blocks.empty())
+            {
+                void* block = blocks.back();
+                blocks.pop_back();
+                return block;
+            }
+        }
+
+        return ::operator new(size);
+    }
+
+    static void Deallocate(void* block, std::size_t size) noexcept
+    {
+        if (size == sizeof(T) && !Destroyed && Cache.Blocks.size() < MaxFree)
+        {
+            Cache.Blocks.push_back(block);
+            return;
+        }
+
+        ::operator delete(block);
+    }
+
+private:
+    struct LocalCache
+    {
+        std::vector<void*> Blocks;
+
+        LocalCache() { Blocks.reserve(MaxFree); }
+
+        ~LocalCache()
+        {
+            Destroyed = true;
+            for (void* block : Blocks)
+                ::operator delete(block);
+        }
+    };
+
+    // objects destroyed during thread exit after the cache itself (static objects) bypass the pool
+    static inline thread_local bool Destroyed = false;
+    static inline thread_local LocalCache Cache;
+};
+
+// Standard allocator drawing single element allocations from ThreadLocalAllocationPool, for node based containers
+// owned by objects that insert and erase constantly (one node per allocation, arrays bypass the pool)
+template <typename T>
+class ThreadLocalPoolAllocator
+{
+public:
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Pooled blocks only have default new alignment");
+
+    using value_type = T;
+
+    ThreadLocalPoolAllocator() noexcept = default;
+
+    template <typename U>
+    ThreadLocalPoolAllocator(ThreadLocalPoolAllocator<U> const& /*other*/) noexcept { }
+
+    T* allocate(std::size_t count) { return static_cast<T*>(ThreadLocalAllocationPool<T>::Allocate(count * sizeof(T))); }
+    void deallocate(T* block, std::size_t count) noexcept { ThreadLocalAllocationPool<T>::Deallocate(block, count * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(ThreadLocalPoolAllocator<U> const& /*other*/) const noexcept { return true; }
+};
+
+// Per thread free list of emptied vectors that keep their capacity, for containers rebuilt by every short lived owner
+// Vectors that grew beyond MaxCapacity elements are freed instead of kept
+template <typename T, std::size_t MaxFree = 64, std::size_t MaxCapacity = 64>
+class ThreadLocalVectorPool
+{
+public:
+    static std::vector<T> Acquire()
+    {
+        std::vector<T> storage;
+        if (!Destroyed && !Cache.Vectors.empty())
+        {
+            storage = std::move(Cache.Vectors.back());
+            Cache.Vectors.pop_back();
+        }
+
+        return storage;
+    }
+
+    static void Release(std::vector<T>&& storage)
+    {
+        if (Destroyed || !storage.capacity() || storage.capacity() > MaxCapacity || Cache.Vectors.size() >= MaxFree)
+            return;
+
+        storage.clear();
+        Cache.Vectors.push_back(std::move(storage));
+    }
+
+private:
+    struct LocalCache
+    {
+        std::vector<std::vector<T>> Vectors;
+
+        ~LocalCache() { Destroyed = true; }
+    };
+
+    static inline thread_local bool Destroyed = false;
+    static inline thread_local LocalCache Cache;
+};
+}
+
+#endif // TRINITY_THREAD_LOCAL_POOL_H
@@ -0,0 +1,109 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TickArena.h"
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <optional>
+
+namespace
+{
+// remembers how much the arena needed beyond its reserved block during the current tick
+class OverflowResource : public std::pmr::memory_resource
+{
+public:
+    std::size_t Overflow = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        Overflow += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+struct ThreadArena
+{
+    std::unique_ptr<std::byte[]> Block;
+    std::size_t BlockSize = 0;
+    OverflowResource Upstream;
+    std::optional<std::pmr::monotonic_buffer_resource> Resource;
+    uint32 ScopeDepth = 0;
+
+    void Reserve(std::size_t size)
+    {
+        Resource.reset();
+        Block = std::make_unique_for_overwrite<std::byte[]>(size);
+        BlockSize = size;
+        Resource.emplace(Block.get(), BlockSize, &Upstream);
+    }
+
+    void Reset()
+    {
+        if (Upstream.Overflow)
+        {
+            std::size_t needed = std::min(std::bit_ceil(BlockSize + Upstream.Overflow), Trinity::TickArena::MaxSize);
+            Upstream.Overflow = 0;
+            if (needed > BlockSize)
+            {
+                Reserve(needed);
+                return;
+            }
+        }
+
+        Resource->release();
+    }
+};
+
+thread_local ThreadArena Arena;
+}
+
+std::pmr::memory_resource* Trinity::TickArena::GetResource()
+{
+    if (!Arena.ScopeDepth)
+        return std::pmr::get_default_resource();
+
+    return &*Arena.Resource;
+}
+
+std::size_t Trinity::TickArena::GetReservedSize()
+{
+    return Arena.BlockSize;
+}
+
+Trinity::TickArena::Scope::Scope()
+{
+    if (!Arena.ScopeDepth++ && !Arena.Resource)
+        Arena.Reserve(InitialSize);
+}
+
+Trinity::TickArena::Scope::~Scope()
+{
+    if (!--Arena.ScopeDepth)
+        Arena.Reset();
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TICK_ARENA_H
+#define TRINITY_TICK_ARENA_H
+
+#include "Define.h"
+#include <functional>
+#include <memory_resource>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace Trinity
+{
+// Per thread monotonic memory for temporary containers of a single update (a map tick)
+// Everything allocated while a Scope is active is released at once when the outermost Scope of the thread ends,
+// freeing memory inside a scope does nothing. Containers using it must not outlive that scope
+// Outside of any scope GetResource returns the default resource, so code shared with other threads stays correct
+// The block reserved by a thread grows (up to MaxSize) when a tick needed more than it, later ticks then allocate nothing
+class TC_COMMON_API TickArena
+{
+public:
+    static constexpr std::size_t InitialSize = 64 * 1024;
+    static constexpr std::size_t MaxSize = 16 * 1024 * 1024;
+
+    static std::pmr::memory_resource* GetResource();
+
+    // size of the block currently reserved by the calling thread
+    static std::size_t GetReservedSize();
+
+    class TC_COMMON_API Scope
+    {
+    public:
+        Scope();
+        ~Scope();
+
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+    };
+};
+
+// containers for temporaries of a tick, construct them with TickArena::GetResource()
+template<typename T>
+using TickVector = std::pmr::vector<T>;
+
+template<typename T, typename Compare = std::less<T>>
+using TickSet = std::pmr::set<T, Compare>;
+
+template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using TickUnorderedMap = std::pmr::unordered_map<Key, Value, Hash, KeyEqual>;
+}
+
+#endif // TRINITY_TICK_ARENA_H
@@ -27,6 +27,7 @@
 #include "Banner.h"
 #include "BigNumber.h"
 #include "Config.h"
+#include "CryptoWorkerPool.h"
 #include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
 #include "DeadlineTimer.h"
@@ -36,11 +37,13 @@
 #include "Locales.h"
 #include "LoginRESTService.h"
 #include "Memory.h"
+#include "Metric.h"
 #include "MySQLThreading.h"
 #include "OpenSSLCrypto.h"
 #include "ProcessPriority.h"
 #include "RealmList.h"
 #include "SecretMgr.h"
+#include "ServiceDispatcher.h"
 #include "SessionManager.h"
 #include "SslContext.h"
 #include "Util.h"
@@ -86,6 +89,7 @@ void StopDB();
 void SignalHandler(std::weak_ptr<Trinity::Asio::IoContext> ioContextRef, boost::system::error_code const& error, int signalNumber);
 void KeepDatabaseAliveHandler(std::weak_ptr<Trinity::Asio::DeadlineTimer> dbPingTimerRef, int32 dbPingInterval, boost::system::error_code const& error);
 void BanExpiryHandler(std::weak_ptr<Trinity::Asio::DeadlineTimer> banExpiryCheckTimerRef, int32 banExpiryCheckInterval, boost::system::error_code const& error);
+void MetricUpdateHandler(std::weak_ptr<Trinity::Asio::DeadlineTimer> metricUpdateTimerRef, boost::system::error_code const& error);
 variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile, fs::path& configDir, std::string& winServiceAction);
 
 int main(int argc, char** argv)
@@ -212,6 +216,12 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    // password hashing and SRP verification of login requests
+    sCryptoWorkerPool.Start(uint32(std::max(sConfigMgr->GetIntDefault("LoginREST.CryptoThreads", 2), 0)),
+        uint32(std::max(sConfigMgr->GetIntDefault("LoginREST.CryptoMaxQueuedTasks", 256), 1)));
+
+    auto sCryptoWorkerPoolHandle = Trinity::make_unique_ptr_with_deleter(&sCryptoWorkerPool, [](Trinity::Crypto::WorkerPool* pool) { pool->Stop(); });
+
     if (!sLoginService.StartNetwork(*ioContext, httpBindIp, httpPort))
     {
         TC_LOG_ERROR("server.bnetserver", "Failed to initialize login service");
@@ -243,6 +253,24 @@ int main(int argc, char** argv)
 
     auto sSessionMgrHandle = Trinity::make_unique_ptr_with_deleter(&sSessionMgr, [](Battlenet::SessionManager* sessMgr) { sessMgr->StopNetwork(); });
 
+    sMetric->Initialize("bnetserver", *ioContext, []()
+    {
+        Battlenet::ServiceDispatcher::Instance().LogMetrics();
+        sLoginService.LogMetrics();
+        TC_METRIC_VALUE("crypto_queue_depth", uint64(sCryptoWorkerPool.GetQueueDepth()));
+        TC_METRIC_VALUE("crypto_rejected_tasks", sCryptoWorkerPool.GetRejectedCount());
+    });
+
+    auto sMetricHandle = Trinity::make_unique_ptr_with_deleter(sMetric, [](Metric* metric) { metric->Unload(); });
+
+    // there is no world loop here, Metric::Update triggers the overall status logger
+    std::shared_ptr<Trinity::Asio::DeadlineTimer> metricUpdateTimer = std::make_shared<Trinity::Asio::DeadlineTimer>(*ioContext);
+    metricUpdateTimer->expires_from_now(boost::posix_time::seconds(1));
+    metricUpdateTimer->async_wait([timerRef = std::weak_ptr(metricUpdateTimer)](boost::system::error_code const& error) mutable
+    {
+        MetricUpdateHandler(std::move(timerRef), error);
+    });
+
     // Set signal handlers
     boost::asio::signal_set signals(*ioContext, SIGINT, SIGTERM);
 #if TRINITY_PLATFORM == TRINITY_PLATFORM_WINDOWS
@@ -289,6 +317,7 @@ int main(int argc, char** argv)
     // Start the io service worker loop
     ioContext->run();
 
+    metricUpdateTimer->cancel();
     banExpiryCheckTimer->cancel();
     dbPingTimer->cancel();
 
@@ -320,6 +349,9 @@ bool StartDB()
 /// Close the connection to the database
 void StopDB()
 {
+    // buffered db log messages must reach the login database before it closes
+    sLog->Flush();
+
     LoginDatabase.Close();
     MySQL::Library_End();
 }
@@ -368,6 +400,23 @@ void BanExpiryHandler(std::weak_ptr<Trinity::Asio::DeadlineTimer> banExpiryCheck
     }
 }
 
+void MetricUpdateHandler(std::weak_ptr<Trinity::Asio::DeadlineTimer> metricUpdateTimerRef, boost::system::error_code const& error)
+{
+    if (!error)
+    {
+        if (std::shared_ptr<Trinity::Asio::DeadlineTimer> metricUpdateTimer = metricUpdateTimerRef.lock())
+        {
+            sMetric->Update();
+
+            metricUpdateTimer->expires_from_now(boost::posix_time::seconds(1));
+            metricUpdateTimer->async_wait([timerRef = std::move(metricUpdateTimerRef)](boost::system::error_code const& error) mutable
+            {
+                MetricUpdateHandler(std::move(timerRef), error);
+            });
+        }
+    }
+}
+
 #if TRINITY_PLATFORM == TRINITY_PLATFORM_WINDOWS
 void ServiceStatusWatcher(std::weak_ptr<Trinity::Asio::DeadlineTimer> serviceStatusWatchTimerRef, std::weak_ptr<Trinity::Asio::IoContext> ioContextRef, boost::system::error_code const& error)
 {
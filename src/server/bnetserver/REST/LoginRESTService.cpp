@@ -20,6 +20,7 @@
 #include "Configuration/Config.h"
 #include "CryptoHash.h"
 #include "CryptoRandom.h"
+#include "CryptoWorkerPool.h"
 #include "DatabaseEnv.h"
 #include "IpNetwork.h"
 #include "IteratorPair.h"
@@ -49,7 +50,7 @@ bool LoginRESTService::StartNetwork(Trinity::Asio::IoContext& ioContext, std::st
         return HandleGetForm(std::move(session), context);
     });
 
-    RegisterHandler(boost::beast::http::verb::get, "/bnetserver/gameAccounts/", [](std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context)
+    RegisterHandler(boost::beast::http::verb::get, "/bnetserver/gameAccounts/", [this](std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context)
     {
         return HandleGetGameAccounts(std::move(session), context);
     });
@@ -120,10 +121,11 @@ bool LoginRESTService::StartNetwork(Trinity::Asio::IoContext& ioContext, std::st
     input->set_label("Log In");
 
     _loginTicketDuration = sConfigMgr->GetIntDefault("LoginREST.TicketDuration", 3600);
+    _gameAccountsCacheDuration = Seconds(std::max(sConfigMgr->GetIntDefault("LoginREST.GameAccountsCacheDuration", 10), 0));
 
     MigrateLegacyPasswordHashes();
 
-    _acceptor->AsyncAcceptWithCallback<&LoginRESTService::OnSocketAccept>();
+    AsyncAcceptWithCallback<&LoginRESTService::OnSocketAccept>();
     return true;
 }
 
@@ -177,16 +179,23 @@ LoginRESTService::RequestHandlerResult LoginRESTService::HandleGetForm(std::shar
     return RequestHandlerResult::Handled;
 }
 
-LoginRESTService::RequestHandlerResult LoginRESTService::HandleGetGameAccounts(std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context)
+LoginRESTService::RequestHandlerResult LoginRESTService::HandleGetGameAccounts(std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context) const
 {
     std::string ticket = ExtractAuthorization(context.request);
     if (ticket.empty())
         return HandleUnauthorized(std::move(session), context);
 
+    if (Optional<std::string> cached = GetCachedGameAccounts(ticket))
+    {
+        context.response.set(boost::beast::http::field::content_type, "application/json;charset=utf-8");
+        context.response.body() = std::move(*cached);
+        return RequestHandlerResult::Handled;
+    }
+
     LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_BNET_GAME_ACCOUNT_LIST);
     stmt->setString(0, ticket);
     session->QueueQuery(LoginDatabase.AsyncQuery(stmt)
-        .WithPreparedCallback([session, context = std::move(context)](PreparedQueryResult result) mutable
+        .WithPreparedCallback([this, session, context = std::move(context), ticket = std::move(ticket)](PreparedQueryResult result) mutable
     {
         JSON::Login::GameAccountList gameAccounts;
         if (result)
@@ -220,12 +229,45 @@ LoginRESTService::RequestHandlerResult LoginRESTService::HandleGetGameAccounts(s
 
         context.response.set(boost::beast::http::field::content_type, "application/json;charset=utf-8");
         context.response.body() = ::JSON::Serialize(gameAccounts);
+        if (result)
+            CacheGameAccounts(ticket, context.response.body());
+
         session->SendResponse(context);
     }));
 
     return RequestHandlerResult::Async;
 }
 
+Optional<std::string> LoginRESTService::GetCachedGameAccounts(std::string const& ticket) const
+{
+    if (_gameAccountsCacheDuration <= 0s)
+        return {};
+
+    std::lock_guard<std::mutex> lock(_gameAccountsCacheLock);
+    auto itr = _gameAccountsCache.find(ticket);
+    if (itr == _gameAccountsCache.end() || itr->second.Expiry < std::chrono::steady_clock::now())
+        return {};
+
+    return itr->second.Body;
+}
+
+void LoginRESTService::CacheGameAccounts(std::string const& ticket, std::string const& body) const
+{
+    if (_gameAccountsCacheDuration <= 0s)
+        return;
+
+    TimePoint now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(_gameAccountsCacheLock);
+    if (now >= _gameAccountsCacheNextPurge)
+    {
+        std::erase_if(_gameAccountsCache, [now](auto const& entry) { return entry.second.Expiry < now; });
+        _gameAccountsCacheNextPurge = now + _gameAccountsCacheDuration;
+    }
+
+    _gameAccountsCache[ticket] = { body, now + _gameAccountsCacheDuration };
+}
+
 LoginRESTService::RequestHandlerResult LoginRESTService::HandleGetPortal(std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context) const
 {
     context.response.set(boost::beast::http::field::content_type, "text/plain");
@@ -246,8 +288,6 @@ LoginRESTService::RequestHandlerResult LoginRESTService::HandlePostLogin(std::sh
         context.response.result(boost::beast::http::status::bad_request);
         context.response.set(boost::beast::http::field::content_type, "application/json;charset=utf-8");
         context.response.body() = ::JSON::Serialize(loginResult);
-        session->SendResponse(context);
-
         return RequestHandlerResult::Handled;
     }
 
@@ -266,7 +306,7 @@ LoginRESTService::RequestHandlerResult LoginRESTService::HandlePostLogin(std::sh
     stmt->setString(0, login);
 
     session->QueueQuery(LoginDatabase.AsyncQuery(stmt)
-        .WithChainingPreparedCallback([this, session, context = std::move(context), loginForm = std::move(loginForm), getInputValue](QueryCallback& callback, PreparedQueryResult result) mutable
+        .WithPreparedCallback([this, session, context = std::move(context), loginForm = std::move(loginForm), getInputValue](PreparedQueryResult result) mutable
     {
         if (!result)
         {
@@ -280,8 +320,16 @@ LoginRESTService::RequestHandlerResult LoginRESTService::HandlePostLogin(std::sh
 
         std::string login(getInputValue(loginForm.get(), "account_name"));
         Utf8ToUpperOnlyLatin(login);
-        bool passwordCorrect = false;
-        Optional<std::string> serverM2;
+
+        struct CredentialsCheck
+        {
+            std::unique_ptr<Trinity::Crypto::SRP::BnetSRP6Base> NewSrp;
+            bool PasswordCorrect = false;
+            Optional<std::string> ServerM2;
+        };
+
+        // password hashing and SRP verification run on the crypto workers, the session pointer keeps the SRP state alive until they finish
+        std::function<CredentialsCheck()> checkCredentials;
 
         Field* fields = result->Fetch();
         uint32 accountId = fields[0].GetUInt32();
@@ -291,23 +339,32 @@ LoginRESTService::RequestHandlerResult LoginRESTService::HandlePostLogin(std::sh
             std::string srpUsername = ByteArrayToHexStr(Trinity::Crypto::SHA256::GetDigestOf(login));
             Trinity::Crypto::SRP::Salt s = fields[2].GetBinary<Trinity::Crypto::SRP::SALT_LENGTH>();
             Trinity::Crypto::SRP::Verifier v = fields[3].GetBinary();
-            session->GetSessionState()->Srp = CreateSrpImplementation(version, SrpHashFunction::Sha256, srpUsername, s, v);
 
             std::string password(getInputValue(loginForm.get(), "password"));
             if (version == SrpVersion::v1)
                 Utf8ToUpperOnlyLatin(password);
 
-            passwordCorrect = session->GetSessionState()->Srp->CheckCredentials(srpUsername, password);
+            checkCredentials = [version, srpUsername = std::move(srpUsername), s, v = std::move(v), password = std::move(password)]
+            {
+                CredentialsCheck check;
+                check.NewSrp = CreateSrpImplementation(version, SrpHashFunction::Sha256, srpUsername, s, v);
+                check.PasswordCorrect = check.NewSrp && check.NewSrp->CheckCredentials(srpUsername, password);
+                return check;
+            };
         }
         else
         {
-            BigNumber A(getInputValue(loginForm.get(), "public_A"));
-            BigNumber M1(getInputValue(loginForm.get(), "client_evidence_M1"));
-            if (Optional<BigNumber> sessionKey = session->GetSessionState()->Srp->VerifyClientEvidence(A, M1))
+            checkCredentials = [session, A = BigNumber(getInputValue(loginForm.get(), "public_A")), M1 = BigNumber(getInputValue(loginForm.get(), "client_evidence_M1"))]
             {
-                passwordCorrect = true;
-                serverM2 = session->GetSessionState()->Srp->CalculateServerEvidence(A, M1, *sessionKey).AsHexStr();
-            }
+                CredentialsCheck check;
+                Trinity::Crypto::SRP::BnetSRP6Base* srp = session->GetSessionState()->Srp.get();
+                if (Optional<BigNumber> sessionKey = srp->VerifyClientEvidence(A, M1))
+                {
+                    check.PasswordCorrect = true;
+                    check.ServerM2 = srp->CalculateServerEvidence(A, M1, *sessionKey).AsHexStr();
+                }
+                return check;
+            };
         }
 
         uint32 failedLogins = fields[4].GetUInt32();
@@ -315,83 +372,97 @@ LoginRESTService::RequestHandlerResult LoginRESTService::HandlePostLogin(std::sh
         uint32 loginTicketExpiry = fields[6].GetUInt32();
         bool isBanned = fields[7].GetUInt64() != 0;
 
-        if (!passwordCorrect)
+        session->QueueCryptoCallback(sCryptoWorkerPool.Post(std::move(checkCredentials),
+            [this, session, context = std::move(context), login = std::move(login), accountId, failedLogins, loginTicket = std::move(loginTicket), loginTicketExpiry, isBanned](Optional<CredentialsCheck> check) mutable
         {
-            if (!isBanned)
+            if (!check)
             {
-                std::string ip_address = session->GetRemoteIpAddress().to_string();
-                uint32 maxWrongPassword = uint32(sConfigMgr->GetIntDefault("WrongPass.MaxCount", 0));
+                HandleCryptoWorkersBusy(*session, context);
+                return;
+            }
 
-                if (sConfigMgr->GetBoolDefault("WrongPass.Logging", false))
-                    TC_LOG_DEBUG("server.http.login", "[{}, Account {}, Id {}] Attempted to connect with wrong password!", ip_address, login, accountId);
+            if (check->NewSrp)
+                session->GetSessionState()->Srp = std::move(check->NewSrp);
 
-                if (maxWrongPassword)
+            if (!check->PasswordCorrect)
+            {
+                if (!isBanned)
                 {
-                    LoginDatabaseTransaction trans = LoginDatabase.BeginTransaction();
-                    LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_BNET_FAILED_LOGINS);
-                    stmt->setUInt32(0, accountId);
-                    trans->Append(stmt);
-
-                    ++failedLogins;
+                    std::string ip_address = session->GetRemoteIpAddress().to_string();
+                    uint32 maxWrongPassword = uint32(sConfigMgr->GetIntDefault("WrongPass.MaxCount", 0));
 
-                    TC_LOG_DEBUG("server.http.login", "MaxWrongPass : {}, failed_login : {}", maxWrongPassword, accountId);
+                    if (sConfigMgr->GetBoolDefault("WrongPass.Logging", false))
+                        TC_LOG_DEBUG("server.http.login", "[{}, Account {}, Id {}] Attempted to connect with wrong password!", ip_address, login, accountId);
 
-                    if (failedLogins >= maxWrongPassword)
+                    if (maxWrongPassword)
                     {
-                        BanMode banType = BanMode(sConfigMgr->GetIntDefault("WrongPass.BanType", uint16(BanMode::BAN_IP)));
-                        int32 banTime = sConfigMgr->GetIntDefault("WrongPass.BanTime", 600);
+                        LoginDatabaseTransaction trans = LoginDatabase.BeginTransaction();
+                        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_BNET_FAILED_LOGINS);
+                        stmt->setUInt32(0, accountId);
+                        trans->Append(stmt);
+
+                        ++failedLogins;
 
-                        if (banType == BanMode::BAN_ACCOUNT)
+                        TC_LOG_DEBUG("server.http.login", "MaxWrongPass : {}, failed_login : {}", maxWrongPassword, accountId);
+
+                        if (failedLogins >= maxWrongPassword)
                         {
-                            stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_BNET_ACCOUNT_AUTO_BANNED);
+                            BanMode banType = BanMode(sConfigMgr->GetIntDefault("WrongPass.BanType", uint16(BanMode::BAN_IP)));
+                            int32 banTime = sConfigMgr->GetIntDefault("WrongPass.BanTime", 600);
+
+                            if (banType == BanMode::BAN_ACCOUNT)
+                            {
+                                stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_BNET_ACCOUNT_AUTO_BANNED);
+                                stmt->setUInt32(0, accountId);
+                            }
+                            else
+                            {
+                                stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_IP_AUTO_BANNED);
+                                stmt->setString(0, ip_address);
+                            }
+
+                            stmt->setUInt32(1, banTime);
+                            trans->Append(stmt);
+
+                            stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_BNET_RESET_FAILED_LOGINS);
                             stmt->setUInt32(0, accountId);
+                            trans->Append(stmt);
                         }
-                        else
-                        {
-                            stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_IP_AUTO_BANNED);
-                            stmt->setString(0, ip_address);
-                        }
-
-                        stmt->setUInt32(1, banTime);
-                        trans->Append(stmt);
 
-                        stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_BNET_RESET_FAILED_LOGINS);
-                        stmt->setUInt32(0, accountId);
-                        trans->Append(stmt);
+                        LoginDatabase.CommitTransaction(trans);
                     }
-
-                    LoginDatabase.CommitTransaction(trans);
                 }
-            }
 
-            JSON::Login::LoginResult loginResult;
-            loginResult.set_authentication_state(JSON::Login::DONE);
-
-            context.response.set(boost::beast::http::field::content_type, "application/json;charset=utf-8");
-            context.response.body() = ::JSON::Serialize(loginResult);
-            session->SendResponse(context);
-            return;
-        }
+                JSON::Login::LoginResult loginResult;
+                loginResult.set_authentication_state(JSON::Login::DONE);
 
-        if (loginTicket.empty() || loginTicketExpiry < time(nullptr))
-            loginTicket = "TC-" + ByteArrayToHexStr(Trinity::Crypto::GetRandomBytes<20>());
+                context.response.set(boost::beast::http::field::content_type, "application/json;charset=utf-8");
+                context.response.body() = ::JSON::Serialize(loginResult);
+                session->SendResponse(context);
+                return;
+            }
 
-        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_BNET_AUTHENTICATION);
-        stmt->setString(0, loginTicket);
-        stmt->setUInt32(1, time(nullptr) + _loginTicketDuration);
-        stmt->setUInt32(2, accountId);
-        callback.WithPreparedCallback([session, context = std::move(context), loginTicket = std::move(loginTicket), serverM2 = std::move(serverM2)](PreparedQueryResult) mutable
-        {
-            JSON::Login::LoginResult loginResult;
-            loginResult.set_authentication_state(JSON::Login::DONE);
-            loginResult.set_login_ticket(loginTicket);
-            if (serverM2)
-                loginResult.set_server_evidence_m2(*serverM2);
+            if (loginTicket.empty() || loginTicketExpiry < time(nullptr))
+                loginTicket = "TC-" + ByteArrayToHexStr(Trinity::Crypto::GetRandomBytes<20>());
 
-            context.response.set(boost::beast::http::field::content_type, "application/json;charset=utf-8");
-            context.response.body() = ::JSON::Serialize(loginResult);
-            session->SendResponse(context);
-        }).SetNextQuery(LoginDatabase.AsyncQuery(stmt));
+            LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_BNET_AUTHENTICATION);
+            stmt->setString(0, loginTicket);
+            stmt->setUInt32(1, time(nullptr) + _loginTicketDuration);
+            stmt->setUInt32(2, accountId);
+            session->QueueQuery(LoginDatabase.AsyncQuery(stmt)
+                .WithPreparedCallback([session, context = std::move(context), loginTicket = std::move(loginTicket), serverM2 = std::move(check->ServerM2)](PreparedQueryResult) mutable
+            {
+                JSON::Login::LoginResult loginResult;
+                loginResult.set_authentication_state(JSON::Login::DONE);
+                loginResult.set_login_ticket(loginTicket);
+                if (serverM2)
+                    loginResult.set_server_evidence_m2(*serverM2);
+
+                context.response.set(boost::beast::http::field::content_type, "application/json;charset=utf-8");
+                context.response.body() = ::JSON::Serialize(loginResult);
+                session->SendResponse(context);
+            }));
+        }));
     }));
 
     return RequestHandlerResult::Async;
@@ -410,8 +481,6 @@ LoginRESTService::RequestHandlerResult LoginRESTService::HandlePostLoginSrpChall
         context.response.result(boost::beast::http::status::bad_request);
         context.response.set(boost::beast::http::field::content_type, "application/json;charset=utf-8");
         context.response.body() = ::JSON::Serialize(loginResult);
-        session->SendResponse(context);
-
         return RequestHandlerResult::Handled;
     }
 
@@ -446,44 +515,73 @@ LoginRESTService::RequestHandlerResult LoginRESTService::HandlePostLoginSrpChall
         Trinity::Crypto::SRP::Salt s = fields[1].GetBinary<Trinity::Crypto::SRP::SALT_LENGTH>();
         Trinity::Crypto::SRP::Verifier v = fields[2].GetBinary();
 
-        session->GetSessionState()->Srp = CreateSrpImplementation(version, hashFunction, srpUsername, s, v);
-        if (!session->GetSessionState()->Srp)
+        // computing the public ephemeral B takes a modular exponentiation
+        session->QueueCryptoCallback(sCryptoWorkerPool.Post([=]
         {
-            context.response.result(boost::beast::http::status::internal_server_error);
-            session->SendResponse(context);
-            return;
-        }
-
-        JSON::Login::SrpLoginChallenge challenge;
-        challenge.set_version(session->GetSessionState()->Srp->GetVersion());
-        challenge.set_iterations(session->GetSessionState()->Srp->GetXIterations());
-        challenge.set_modulus(session->GetSessionState()->Srp->GetN().AsHexStr());
-        challenge.set_generator(session->GetSessionState()->Srp->Getg().AsHexStr());
-        challenge.set_hash_function([=]
+            return CreateSrpImplementation(version, hashFunction, srpUsername, s, v);
+        }, [session, context = std::move(context), hashFunction, srpUsername](Optional<std::unique_ptr<Trinity::Crypto::SRP::BnetSRP6Base>> srp) mutable
         {
-            switch (hashFunction)
+            if (!srp)
             {
-                case SrpHashFunction::Sha256:
-                    return "SHA-256";
-                case SrpHashFunction::Sha512:
-                    return "SHA-512";
-                default:
-                    break;
+                HandleCryptoWorkersBusy(*session, context);
+                return;
             }
-            return "";
-        }());
-        challenge.set_username(srpUsername);
-        challenge.set_salt(ByteArrayToHexStr(session->GetSessionState()->Srp->s));
-        challenge.set_public_b(session->GetSessionState()->Srp->B.AsHexStr());
 
-        context.response.set(boost::beast::http::field::content_type, "application/json;charset=utf-8");
-        context.response.body() = ::JSON::Serialize(challenge);
-        session->SendResponse(context);
+            session->GetSessionState()->Srp = std::move(*srp);
+            if (!session->GetSessionState()->Srp)
+            {
+                context.response.result(boost::beast::http::status::internal_server_error);
+                session->SendResponse(context);
+                return;
+            }
+
+            JSON::Login::SrpLoginChallenge challenge;
+            challenge.set_version(session->GetSessionState()->Srp->GetVersion());
+            challenge.set_iterations(session->GetSessionState()->Srp->GetXIterations());
+            challenge.set_modulus(session->GetSessionState()->Srp->GetN().AsHexStr());
+            challenge.set_generator(session->GetSessionState()->Srp->Getg().AsHexStr());
+            challenge.set_hash_function([=]
+            {
+                switch (hashFunction)
+                {
+                    case SrpHashFunction::Sha256:
+                        return "SHA-256";
+                    case SrpHashFunction::Sha512:
+                        return "SHA-512";
+                    default:
+                        break;
+                }
+                return "";
+            }());
+            challenge.set_username(srpUsername);
+            challenge.set_salt(ByteArrayToHexStr(session->GetSessionState()->Srp->s));
+            challenge.set_public_b(session->GetSessionState()->Srp->B.AsHexStr());
+
+            context.response.set(boost::beast::http::field::content_type, "application/json;charset=utf-8");
+            context.response.body() = ::JSON::Serialize(challenge);
+            session->SendResponse(context);
+        }));
     }));
 
     return RequestHandlerResult::Async;
 }
 
+void LoginRESTService::HandleCryptoWorkersBusy(LoginHttpSessionWrapper& session, HttpRequestContext& context)
+{
+    TC_LOG_DEBUG("server.http.login", "{} Rejected login request, crypto workers are busy", session.GetClientInfo());
+
+    JSON::Login::LoginResult loginResult;
+    loginResult.set_authentication_state(JSON::Login::LOGIN);
+    loginResult.set_error_code("SERVER_BUSY");
+    loginResult.set_error_message("Battle.net is busy. Please try again later.");
+
+    context.response.result(boost::beast::http::status::service_unavailable);
+    context.response.set(boost::beast::http::field::retry_after, "1");
+    context.response.set(boost::beast::http::field::content_type, "application/json;charset=utf-8");
+    context.response.body() = ::JSON::Serialize(loginResult);
+    session.SendResponse(context);
+}
+
 LoginRESTService::RequestHandlerResult LoginRESTService::HandlePostRefreshLoginTicket(std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context) const
 {
     std::string ticket = ExtractAuthorization(context.request);
@@ -18,9 +18,13 @@
 #ifndef LoginRESTService_h__
 #define LoginRESTService_h__
 
+#include "Duration.h"
 #include "HttpService.h"
 #include "Login.pb.h"
 #include "LoginHttpSession.h"
+#include "Optional.h"
+#include <mutex>
+#include <unordered_map>
 
 namespace Battlenet
 {
@@ -51,7 +55,7 @@ public:
     using HttpRequestContext = Trinity::Net::Http::RequestContext;
     using HttpSessionState = Trinity::Net::Http::SessionState;
 
-    LoginRESTService() : HttpService("login"), _port(0), _loginTicketDuration(0) { }
+    LoginRESTService() : HttpService("login"), _port(0), _loginTicketDuration(0), _gameAccountsCacheDuration(0) { }
 
     static LoginRESTService& Instance();
 
@@ -68,13 +72,18 @@ private:
     static std::string ExtractAuthorization(HttpRequest const& request);
 
     RequestHandlerResult HandleGetForm(std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context) const;
-    static RequestHandlerResult HandleGetGameAccounts(std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context);
+    RequestHandlerResult HandleGetGameAccounts(std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context) const;
+    Optional<std::string> GetCachedGameAccounts(std::string const& ticket) const;
+    void CacheGameAccounts(std::string const& ticket, std::string const& body) const;
     RequestHandlerResult HandleGetPortal(std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context) const;
 
     RequestHandlerResult HandlePostLogin(std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context) const;
     static RequestHandlerResult HandlePostLoginSrpChallenge(std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context);
     RequestHandlerResult HandlePostRefreshLoginTicket(std::shared_ptr<LoginHttpSessionWrapper> session, HttpRequestContext& context) const;
 
+    // crypto worker queue is full
+    static void HandleCryptoWorkersBusy(LoginHttpSessionWrapper& session, HttpRequestContext& context);
+
     static std::unique_ptr<Trinity::Crypto::SRP::BnetSRP6Base> CreateSrpImplementation(SrpVersion version, SrpHashFunction hashFunction,
         std::string const& username, Trinity::Crypto::SRP::Salt const& salt, Trinity::Crypto::SRP::Verifier const& verifier);
 
@@ -86,6 +95,18 @@ private:
     std::array<std::string, 2> _hostnames;
     std::array<boost::asio::ip::address, 2> _addresses;
     uint32 _loginTicketDuration;
+
+    // serialized game account lists by login ticket, game clients request them repeatedly while reconnecting
+    struct CachedGameAccountList
+    {
+        std::string Body;
+        TimePoint Expiry;
+    };
+
+    Seconds _gameAccountsCacheDuration;
+    mutable std::mutex _gameAccountsCacheLock;
+    mutable std::unordered_map<std::string, CachedGameAccountList> _gameAccountsCache;
+    mutable TimePoint _gameAccountsCacheNextPurge;
 };
 }
 
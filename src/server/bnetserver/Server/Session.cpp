@@ -392,7 +392,7 @@ uint32 Battlenet::Session::VerifyWebCredentials(std::string const& webCredential
         }
         else
         {
-            if (IpLocationRecord const* location = sIPLocation->GetLocationRecord(ip_address))
+            if (IpLocationRecord const* location = sIPLocation->GetLocationRecord(GetRemoteIpAddress()))
                 _ipCountry = location->CountryCode;
 
             TC_LOG_DEBUG("session", "[Session::HandleVerifyWebCredentials] Account '{}' is not locked to ip", _accountInfo->Login);
@@ -798,27 +798,28 @@ bool Battlenet::Session::ReadHeaderHandler()
     if (!header.ParseFromArray(_headerBuffer.GetReadPointer(), _headerBuffer.GetActiveSize()))
         return false;
 
+    _incomingHeader.ServiceId = header.service_id();
+    _incomingHeader.ServiceHash = header.service_hash();
+    _incomingHeader.MethodId = header.method_id();
+    _incomingHeader.Token = header.token();
+
     _packetBuffer.Resize(header.size());
     return true;
 }
 
 bool Battlenet::Session::ReadDataHandler()
 {
-    Header header;
-    bool parseSuccess = header.ParseFromArray(_headerBuffer.GetReadPointer(), _headerBuffer.GetActiveSize());
-    ASSERT(parseSuccess);
-
-    if (header.service_id() != 0xFE)
+    if (_incomingHeader.ServiceId != 0xFE)
     {
-        sServiceDispatcher.Dispatch(this, header.service_hash(), header.token(), header.method_id(), std::move(_packetBuffer));
+        sServiceDispatcher.Dispatch(this, _incomingHeader.ServiceHash, _incomingHeader.Token, _incomingHeader.MethodId, std::move(_packetBuffer));
     }
     else
     {
-        auto itr = _responseCallbacks.find(header.token());
+        auto itr = _responseCallbacks.find(_incomingHeader.Token);
         if (itr != _responseCallbacks.end())
         {
             itr->second(std::move(_packetBuffer));
-            _responseCallbacks.erase(header.token());
+            _responseCallbacks.erase(_incomingHeader.Token);
         }
         else
             _packetBuffer.Reset();
@@ -167,6 +167,15 @@ namespace Battlenet
         MessageBuffer _headerBuffer;
         MessageBuffer _packetBuffer;
 
+        // fields of the header of the packet being received, parsed once by ReadHeaderHandler
+        struct
+        {
+            uint32 ServiceId = 0;
+            uint32 ServiceHash = 0;
+            uint32 MethodId = 0;
+            uint32 Token = 0;
+        } _incomingHeader;
+
         std::shared_ptr<AccountInfo> _accountInfo;
         GameAccountInfo* _gameAccountInfo;          // Points at selected game account (inside _gameAccounts)
 
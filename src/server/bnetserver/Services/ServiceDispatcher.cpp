@@ -16,6 +16,8 @@
  */
 
 #include "ServiceDispatcher.h"
+#include "Duration.h"
+#include "Metric.h"
 
 Battlenet::ServiceDispatcher::ServiceDispatcher()
 {
@@ -37,11 +39,35 @@ void Battlenet::ServiceDispatcher::Dispatch(Session* session, uint32 serviceHash
 {
     auto itr = _dispatchers.find(serviceHash);
     if (itr != _dispatchers.end())
+    {
+        TimePoint start = std::chrono::steady_clock::now();
         itr->second(session, token, methodId, std::move(buffer));
+        uint32 elapsed = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+        ServiceStats& stats = _serviceStats.at(serviceHash);
+        std::lock_guard<std::mutex> lock(stats.Lock);
+        stats.Latency.Add(elapsed);
+    }
     else
         TC_LOG_DEBUG("session.rpc", "{} tried to call invalid service 0x{:X}", session->GetClientInfo(), serviceHash);
 }
 
+void Battlenet::ServiceDispatcher::LogMetrics()
+{
+    for (auto& [serviceHash, stats] : _serviceStats)
+    {
+        MetricHistogram latency;
+        {
+            std::lock_guard<std::mutex> lock(stats.Lock);
+            latency = stats.Latency;
+            stats.Latency.Reset();
+        }
+
+        if (latency.GetCount())
+            TC_METRIC_HISTOGRAM("rpc_latency", latency, TC_METRIC_TAG("service", stats.Name));
+    }
+}
+
 Battlenet::ServiceDispatcher& Battlenet::ServiceDispatcher::Instance()
 {
     static ServiceDispatcher instance;
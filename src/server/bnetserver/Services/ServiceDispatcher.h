@@ -19,6 +19,7 @@
 #define ServiceDispatcher_h__
 
 #include "MessageBuffer.h"
+#include "MetricHistogram.h"
 #include "AccountService.h"
 #include "AuthenticationService.h"
 #include "challenge_service.pb.h"
@@ -35,6 +36,7 @@
 #include "api/client/v2/report_service.pb.h"
 #include "resource_service.pb.h"
 #include "user_manager_service.pb.h"
+#include <mutex>
 
 namespace Battlenet
 {
@@ -45,15 +47,27 @@ namespace Battlenet
     public:
         void Dispatch(Session* session, uint32 serviceHash, uint32 token, uint32 methodId, MessageBuffer buffer);
 
+        /// Sends the handler latency of every called service since the previous call to the metric database
+        void LogMetrics();
+
         static ServiceDispatcher& Instance();
 
     private:
         ServiceDispatcher();
 
+        struct ServiceStats
+        {
+            std::string Name;
+            std::mutex Lock;
+            // microseconds spent in the synchronous part of the call, continuations waiting for the database are not included
+            MetricHistogram Latency;
+        };
+
         template<class Service>
         void AddService()
         {
             _dispatchers[Service::OriginalHash::value] = &ServiceDispatcher::Dispatch<Service>;
+            _serviceStats.try_emplace(Service::OriginalHash::value).first->second.Name = Service::descriptor()->full_name();
         }
 
         template<class Service>
@@ -64,6 +78,7 @@ namespace Battlenet
 
         typedef void(*ServiceMethod)(Session*, uint32, uint32, MessageBuffer);
         std::unordered_map<uint32, ServiceMethod> _dispatchers;
+        std::unordered_map<uint32, ServiceStats> _serviceStats;
     };
 }
 
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DatabaseAwaitable.h"
+#include <algorithm>
+
+namespace Trinity::Database
+{
+void AsyncTaskReadyQueue::Push(std::coroutine_handle<> handle)
+{
+    std::lock_guard lock(_lock);
+    _handles.push_back(handle);
+}
+
+std::vector<std::coroutine_handle<>> AsyncTaskReadyQueue::TakeAll()
+{
+    std::lock_guard lock(_lock);
+    return std::exchange(_handles, {});
+}
+
+AsyncTask& AsyncTask::operator=(AsyncTask&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (_handle)
+            _handle.destroy();
+
+        _handle = std::exchange(other._handle, nullptr);
+    }
+    return *this;
+}
+
+AsyncTask::~AsyncTask()
+{
+    if (_handle)
+        _handle.destroy();
+}
+
+AsyncTaskProcessor::AsyncTaskProcessor() : _readyQueue(std::make_shared<AsyncTaskReadyQueue>())
+{
+}
+
+AsyncTaskProcessor::~AsyncTaskProcessor()
+{
+    // workers completing an operation after this point find no queue to push to
+    _readyQueue = nullptr;
+    _tasks.clear();
+}
+
+void AsyncTaskProcessor::Start(AsyncTask&& task)
+{
+    task._handle.promise().ReadyQueue = _readyQueue;
+    task._handle.resume();
+    if (!task._handle.done())
+        _tasks.push_back(std::move(task));
+}
+
+void AsyncTaskProcessor::ProcessReadyTasks()
+{
+    std::vector<std::coroutine_handle<>> ready = _readyQueue->TakeAll();
+    if (ready.empty())
+        return;
+
+    for (std::coroutine_handle<> handle : ready)
+        handle.resume();
+
+    std::erase_if(_tasks, [](AsyncTask const& task) { return task._handle.done(); });
+}
+}
@@ -0,0 +1,170 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DatabaseAwaitable_h__
+#define DatabaseAwaitable_h__
+
+#include "Define.h"
+#include <coroutine>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Trinity::Database
+{
+class AsyncTaskProcessor;
+
+//! Coroutines waiting to be resumed by their AsyncTaskProcessor, filled by database worker threads
+class TC_DATABASE_API AsyncTaskReadyQueue
+{
+public:
+    void Push(std::coroutine_handle<> handle);
+    std::vector<std::coroutine_handle<>> TakeAll();
+
+private:
+    std::mutex _lock;
+    std::vector<std::coroutine_handle<>> _handles;
+};
+
+//! Coroutine of a multi step database flow, written with co_await on DatabaseWorkerPool::Await* results
+//! Does not run until started by an AsyncTaskProcessor, which owns it from then on
+class [[nodiscard]] TC_DATABASE_API AsyncTask
+{
+public:
+    struct promise_type
+    {
+        std::weak_ptr<AsyncTaskReadyQueue> ReadyQueue;
+
+        AsyncTask get_return_object() { return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() { }
+        void unhandled_exception() { throw; }
+    };
+
+    AsyncTask(AsyncTask&& other) noexcept : _handle(std::exchange(other._handle, nullptr)) { }
+    AsyncTask& operator=(AsyncTask&& other) noexcept;
+    ~AsyncTask();
+
+    AsyncTask(AsyncTask const&) = delete;
+    AsyncTask& operator=(AsyncTask const&) = delete;
+
+private:
+    friend AsyncTaskProcessor;
+
+    explicit AsyncTask(std::coroutine_handle<promise_type> handle) : _handle(handle) { }
+
+    std::coroutine_handle<promise_type> _handle;
+};
+
+//! Result of an asynchronous database operation shared by the worker thread completing it and the coroutine awaiting it
+template<typename Result>
+class AwaitState
+{
+public:
+    //! Called by the worker thread, queues the awaiting coroutine for its processor if it is already suspended
+    void Complete(Result result)
+    {
+        std::coroutine_handle<> waiting;
+        std::shared_ptr<AsyncTaskReadyQueue> readyQueue;
+        {
+            std::lock_guard lock(_lock);
+            _result = std::move(result);
+            _done = true;
+            waiting = _waiting;
+            readyQueue = _readyQueue.lock();
+        }
+
+        // a processor that is gone has destroyed the coroutine with it
+        if (waiting && readyQueue)
+            readyQueue->Push(waiting);
+    }
+
+    bool IsDone()
+    {
+        std::lock_guard lock(_lock);
+        return _done;
+    }
+
+    //! Returns false when the result arrived in the meantime and the coroutine should continue without suspending
+    bool Suspend(std::coroutine_handle<> waiting, std::weak_ptr<AsyncTaskReadyQueue> readyQueue)
+    {
+        std::lock_guard lock(_lock);
+        if (_done)
+            return false;
+
+        _waiting = waiting;
+        _readyQueue = std::move(readyQueue);
+        return true;
+    }
+
+    Result TakeResult()
+    {
+        std::lock_guard lock(_lock);
+        return std::move(_result);
+    }
+
+private:
+    std::mutex _lock;
+    bool _done = false;
+    Result _result = { };
+    std::coroutine_handle<> _waiting;
+    std::weak_ptr<AsyncTaskReadyQueue> _readyQueue;
+};
+
+//! co_await on it inside an AsyncTask suspends the task until the operation completes, no polling involved
+template<typename Result>
+class [[nodiscard]] Awaitable
+{
+public:
+    explicit Awaitable(std::shared_ptr<AwaitState<Result>> state) : _state(std::move(state)) { }
+
+    bool await_ready() const { return _state->IsDone(); }
+    bool await_suspend(std::coroutine_handle<AsyncTask::promise_type> waiting) { return _state->Suspend(waiting, waiting.promise().ReadyQueue); }
+    Result await_resume() { return _state->TakeResult(); }
+
+private:
+    std::shared_ptr<AwaitState<Result>> _state;
+};
+
+//! Owns the AsyncTasks of one owner (a session) and resumes them on the thread calling ProcessReadyTasks
+//! Destroying the processor destroys unfinished tasks without resuming them, operations still running are ignored when they complete
+class TC_DATABASE_API AsyncTaskProcessor
+{
+public:
+    AsyncTaskProcessor();
+    ~AsyncTaskProcessor();
+
+    AsyncTaskProcessor(AsyncTaskProcessor const&) = delete;
+    AsyncTaskProcessor& operator=(AsyncTaskProcessor const&) = delete;
+
+    //! Runs the task until it first waits for the database
+    void Start(AsyncTask&& task);
+
+    //! Resumes the tasks whose awaited operations completed
+    void ProcessReadyTasks();
+
+    bool IsEmpty() const { return _tasks.empty(); }
+
+private:
+    std::shared_ptr<AsyncTaskReadyQueue> _readyQueue;
+    std::vector<AsyncTask> _tasks;
+};
+}
+
+#endif // DatabaseAwaitable_h__
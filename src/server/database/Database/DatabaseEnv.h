@@ -26,6 +26,7 @@
 #include "Implementation/WorldDatabase.h"
 #include "Implementation/HotfixDatabase.h"
 
+#include "DatabaseAwaitable.h"
 #include "Field.h"
 #include "PreparedStatement.h"
 #include "QueryCallback.h"
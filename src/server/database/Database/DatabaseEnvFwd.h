@@ -78,6 +78,15 @@ using WorldDatabaseQueryHolder = SQLQueryHolder<WorldDatabaseConnection>;
 
 class SQLQueryHolderCallback;
 
+namespace Trinity::Database
+{
+class AsyncTask;
+class AsyncTaskProcessor;
+
+template<typename Result>
+class Awaitable;
+}
+
 // mysql
 struct MySQLHandle;
 struct MySQLResult;
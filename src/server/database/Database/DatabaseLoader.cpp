@@ -20,6 +20,8 @@
 #include "DatabaseEnv.h"
 #include "DBUpdater.h"
 #include "Log.h"
+#include <future>
+#include <vector>
 
 #include <mysqld_error.h>
 
@@ -53,7 +55,17 @@ DatabaseLoader& DatabaseLoader::AddDatabase(DatabaseWorkerPool<T>& pool, std::st
 
         uint8 const synchThreads = uint8(sConfigMgr->GetIntDefault(name + "Database.SynchThreads", 1));
 
-        pool.SetConnectionInfo(dbString, asyncThreads, synchThreads);
+        uint8 const maxAsyncThreads = uint8(sConfigMgr->GetIntDefault(name + "Database.MaxWorkerThreads", 0));
+        if (maxAsyncThreads && (maxAsyncThreads < asyncThreads || maxAsyncThreads > 32))
+        {
+            TC_LOG_ERROR(_logger, "{} database: invalid maximum number of worker threads specified. "
+                "Please pick a value between {}Database.WorkerThreads and 32.", name, name);
+            return false;
+        }
+
+        pool.SetConnectionInfo(dbString, asyncThreads, synchThreads, maxAsyncThreads);
+        pool.SetSlowStatementThreshold(sConfigMgr->GetIntDefault(name + "Database.SlowStatementThreshold", 0));
+        pool.SetSnapshotDirectory(sConfigMgr->GetStringDefault(name + "Database.SnapshotDir", ""));
         if (uint32 error = pool.Open())
         {
             // Database does not exist
@@ -150,7 +162,33 @@ bool DatabaseLoader::PopulateDatabases()
 
 bool DatabaseLoader::UpdateDatabases()
 {
-    return Process(_update);
+    if (_update.size() < 2 || !sConfigMgr->GetBoolDefault("Updates.Parallel", true))
+        return Process(_update);
+
+    // every database has its own connections and update directories, only the mysql cli lookup is shared
+    // resolve it once up front so the updaters don't race on the corrected path
+    bool success = DBUpdaterUtil::CheckExecutable();
+    if (success)
+    {
+        std::vector<std::future<bool>> updates;
+        updates.reserve(_update.size());
+        for (; !_update.empty(); _update.pop())
+            updates.push_back(std::async(std::launch::async, std::move(_update.front())));
+
+        for (std::future<bool>& update : updates)
+            success = update.get() && success;
+    }
+
+    if (!success)
+    {
+        while (!_close.empty())
+        {
+            _close.top()();
+            _close.pop();
+        }
+    }
+
+    return success;
 }
 
 bool DatabaseLoader::PrepareStatements()
@@ -18,13 +18,17 @@
 #include "DatabaseWorkerPool.h"
 #include "AdhocStatement.h"
 #include "Common.h"
+#include "DatabaseAwaitable.h"
 #include "Errors.h"
+#include "Field.h"
+#include "Hash.h"
 #include "IoContext.h"
 #include "Implementation/LoginDatabase.h"
 #include "Implementation/WorldDatabase.h"
 #include "Implementation/CharacterDatabase.h"
 #include "Implementation/HotfixDatabase.h"
 #include "Log.h"
+#include "Metric.h"
 #include "MySQLPreparedStatement.h"
 #include "PreparedStatement.h"
 #include "ProducerConsumerQueue.h"
@@ -33,8 +37,18 @@
 #include "QueryResult.h"
 #include "Transaction.h"
 #include "MySQLWorkaround.h"
-#include <boost/asio/use_future.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <mysqld_error.h>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string_view>
 #include <utility>
 #ifdef TRINITY_DEBUG
 #include <sstream>
@@ -51,6 +65,9 @@
 #define MIN_MARIADB_CLIENT_VERSION 30003u
 #define MIN_MARIADB_CLIENT_VERSION_STRING "3.0.3"
 
+// consecutive async prepared statements executed in a single transaction
+#define MAX_EXECUTE_BATCH_SIZE 128u
+
 template<typename T>
 struct DatabaseWorkerPool<T>::QueueSizeTracker
 {
@@ -101,9 +118,89 @@ private:
     DatabaseWorkerPool* _pool;
 };
 
+template<typename T>
+struct DatabaseWorkerPool<T>::ExecuteBatch
+{
+    std::vector<std::unique_ptr<PreparedStatement<T>>> Statements;
+    std::vector<QueueSizeTracker> Trackers;
+};
+
+template<typename T>
+struct DatabaseWorkerPool<T>::TaskQueue
+{
+    struct TaskBase
+    {
+        virtual ~TaskBase() = default;
+        virtual void Execute(T* connection) = 0;
+    };
+
+    template<typename Callable>
+    struct TaskImpl final : TaskBase
+    {
+        explicit TaskImpl(Callable&& callable) : Action(std::move(callable)) { }
+        void Execute(T* connection) override { Action(connection); }
+
+        Callable Action;
+    };
+
+    struct Entry
+    {
+        std::unique_ptr<TaskBase> Task;
+        uint64 Sequence;
+        std::chrono::steady_clock::time_point EnqueueTime;
+    };
+
+    // shares of the worker time while multiple lanes have work waiting
+    static constexpr std::array<int32, MAX_DATABASE_TASK_PRIORITIES> Weights = { 8, 4, 2, 1 };
+    static constexpr std::array<char const*, MAX_DATABASE_TASK_PRIORITIES> Names = { "interactive", "login", "write", "background" };
+
+    // smooth weighted round robin over the lanes allowed to run
+    std::size_t PickLane()
+    {
+        std::deque<Entry> const& writes = Lanes[std::size_t(DatabaseTaskPriority::Write)];
+        uint64 writeBarrier = writes.empty() ? std::numeric_limits<uint64>::max() : writes.front().Sequence;
+
+        std::size_t picked = MAX_DATABASE_TASK_PRIORITIES;
+        int32 totalWeight = 0;
+        for (std::size_t i = 0; i < MAX_DATABASE_TASK_PRIORITIES; ++i)
+        {
+            if (Lanes[i].empty())
+                continue;
+
+            // reading before an earlier write completes would return stale data
+            if ((i == std::size_t(DatabaseTaskPriority::Interactive) || i == std::size_t(DatabaseTaskPriority::Login)) && Lanes[i].front().Sequence > writeBarrier)
+                continue;
+
+            Credits[i] += Weights[i];
+            totalWeight += Weights[i];
+            if (picked == MAX_DATABASE_TASK_PRIORITIES || Credits[i] > Credits[picked])
+                picked = i;
+        }
+
+        ASSERT(picked != MAX_DATABASE_TASK_PRIORITIES, "ExecuteNextTask called without queued tasks");
+        Credits[picked] -= totalWeight;
+        return picked;
+    }
+
+    std::mutex Lock;
+    std::array<std::deque<Entry>, MAX_DATABASE_TASK_PRIORITIES> Lanes;
+    std::array<int32, MAX_DATABASE_TASK_PRIORITIES> Credits = { };
+    std::array<MetricHistogram, MAX_DATABASE_TASK_PRIORITIES> WaitTimes;   //!< microseconds, since the last LogQueueMetrics
+    uint64 NextSequence = 0;
+
+    // async connection scaling, a task waiting GrowWait asks for one more connection
+    // and a connection is closed when no task waited that long for ShrinkIdleTime
+    static constexpr std::chrono::milliseconds GrowWait = std::chrono::milliseconds(100);
+    static constexpr std::chrono::seconds ResizeCooldown = std::chrono::seconds(10);
+    static constexpr std::chrono::minutes ShrinkIdleTime = std::chrono::minutes(5);
+    std::chrono::steady_clock::time_point LastBusyTime;
+    std::chrono::steady_clock::time_point LastResizeTime;
+};
+
 template <class T>
 DatabaseWorkerPool<T>::DatabaseWorkerPool()
-    : _async_threads(0), _synch_threads(0)
+    : _taskQueue(std::make_unique<TaskQueue>()), _asyncConnectionCount(0), _statementStatistics(std::make_unique<MySQLStatementStatistics>()),
+    _async_threads(0), _synch_threads(0), _max_async_threads(0)
 {
     WPFatal(mysql_thread_safe(), "Used MySQL library isn't thread-safe.");
 
@@ -123,12 +220,25 @@ DatabaseWorkerPool<T>::~DatabaseWorkerPool()
 
 template <class T>
 void DatabaseWorkerPool<T>::SetConnectionInfo(std::string const& infoString,
-    uint8 const asyncThreads, uint8 const synchThreads)
+    uint8 const asyncThreads, uint8 const synchThreads, uint8 const maxAsyncThreads /*= 0*/)
 {
     _connectionInfo = std::make_unique<MySQLConnectionInfo>(infoString);
 
     _async_threads = asyncThreads;
     _synch_threads = synchThreads;
+    _max_async_threads = std::max(asyncThreads, maxAsyncThreads);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::SetSlowStatementThreshold(uint32 milliseconds)
+{
+    _statementStatistics->SetSlowStatementThreshold(milliseconds);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::SetSnapshotDirectory(std::string directory)
+{
+    _snapshotDirectory = std::move(directory);
 }
 
 template <class T>
@@ -155,6 +265,8 @@ uint32 DatabaseWorkerPool<T>::Open()
     for (std::unique_ptr<T> const& connection : _connections[IDX_ASYNC])
         connection->StartWorkerThread(_ioContext.get());
 
+    _asyncConnectionCount = _connections[IDX_ASYNC].size();
+
     TC_LOG_INFO("sql.driver", "DatabasePool '{}' opened successfully. "
         "{} total connections running.", GetDatabaseName(),
         (_connections[IDX_SYNCH].size() + _connections[IDX_ASYNC].size()));
@@ -171,10 +283,33 @@ void DatabaseWorkerPool<T>::Close()
         _ioContext->stop();
 
     //! Closes the actualy MySQL connection.
-    _connections[IDX_ASYNC].clear();
+    //! Joining the worker threads waits for connections they are adding, repeat until none are left
+    while (true)
+    {
+        std::vector<std::unique_ptr<T>> connections;
+        {
+            std::lock_guard lock(_asyncConnectionsLock);
+            connections.swap(_connections[IDX_ASYNC]);
+            std::move(_retiredConnections.begin(), _retiredConnections.end(), std::back_inserter(connections));
+            _retiredConnections.clear();
+        }
+
+        if (connections.empty())
+            break;
+
+        connections.clear();
+    }
+
+    _asyncConnectionCount = 0;
 
     _ioContext.reset();
 
+    {
+        std::lock_guard lock(_taskQueue->Lock);
+        for (std::deque<typename TaskQueue::Entry>& lane : _taskQueue->Lanes)
+            lane.clear();
+    }
+
     TC_LOG_INFO("sql.driver", "Asynchronous connections on DatabasePool '{}' terminated. "
                 "Proceeding with synchronous connections.",
         GetDatabaseName());
@@ -257,39 +392,212 @@ PreparedQueryResult DatabaseWorkerPool<T>::Query(PreparedStatement<T>* stmt)
     return ret;
 }
 
+template <class T>
+QueryResult DatabaseWorkerPool<T>::QueryCached(char const* sql, std::initializer_list<char const*> tables)
+{
+    if (_snapshotDirectory.empty())
+        return Query(sql);
+
+    T* connection = GetFreeConnection();
+    uint64 key = GetSnapshotKey(connection, sql, tables);
+
+    std::string fileName = Trinity::StringFormat("{}/{}_{:016X}.snapshot", _snapshotDirectory, _connectionInfo->database, std::hash<std::string_view>()(sql));
+    QueryResult result;
+    if (std::ifstream file{ fileName, std::ios::binary | std::ios::ate })
+    {
+        std::vector<char> snapshot(std::size_t(file.tellg()));
+        file.seekg(0);
+        if (file.read(snapshot.data(), snapshot.size()) && ResultSet::ReadSnapshot(std::move(snapshot), key, result))
+        {
+            connection->Unlock();
+            TC_LOG_DEBUG("sql.driver", "DatabasePool '{}' read {} rows from snapshot {}", _connectionInfo->database, result ? result->GetRowCount() : 0, fileName);
+            return result;
+        }
+    }
+
+    result = BasicStatementTask::Query(connection, sql);
+    connection->Unlock();
+
+    std::vector<char> snapshot = ResultSet::WriteSnapshot(result.get(), key);
+
+    boost::system::error_code error;
+    boost::filesystem::create_directories(_snapshotDirectory, error);
+
+    // write to a temporary file first, a crash while writing must not leave a truncated snapshot behind
+    std::string temporaryFileName = fileName + ".tmp";
+    bool written = false;
+    if (std::ofstream file{ temporaryFileName, std::ios::binary | std::ios::trunc })
+        written = bool(file.write(snapshot.data(), snapshot.size()));
+
+    if (written)
+        boost::filesystem::rename(temporaryFileName, fileName, error);
+
+    if (!written || error)
+        TC_LOG_ERROR("sql.driver", "DatabasePool '{}' could not write snapshot {}", _connectionInfo->database, fileName);
+
+    bool read = ResultSet::ReadSnapshot(std::move(snapshot), key, result);
+    ASSERT(read, "Snapshot of query %s cannot be read back", sql);
+    return result;
+}
+
+template <class T>
+uint64 DatabaseWorkerPool<T>::GetSnapshotKey(T* connection, char const* sql, std::initializer_list<char const*> tables)
+{
+    if (!_snapshotUpdatesKey)
+    {
+        std::size_t updatesKey = 0;
+        if (QueryResult updates = BasicStatementTask::Query(connection, "SELECT name, hash FROM updates ORDER BY name"))
+        {
+            do
+            {
+                Field* fields = updates->Fetch();
+                Trinity::hash_combine(updatesKey, fields[0].GetStringView());
+                Trinity::hash_combine(updatesKey, fields[1].GetStringView());
+            } while (updates->NextRow());
+        }
+
+        _snapshotUpdatesKey = updatesKey;
+    }
+
+    std::size_t key = std::hash<std::string_view>()(sql);
+    Trinity::hash_combine(key, *_snapshotUpdatesKey);
+
+    std::string checksumQuery = "CHECKSUM TABLE ";
+    for (char const* table : tables)
+    {
+        if (table != *tables.begin())
+            checksumQuery += ", ";
+
+        checksumQuery += table;
+    }
+
+    if (QueryResult checksums = BasicStatementTask::Query(connection, checksumQuery.c_str()))
+    {
+        do
+        {
+            Field* fields = checksums->Fetch();
+            Trinity::hash_combine(key, fields[0].GetStringView());
+            Trinity::hash_combine(key, fields[1].GetUInt64());
+        } while (checksums->NextRow());
+    }
+
+    return key;
+}
+
 template <class T>
 QueryCallback DatabaseWorkerPool<T>::AsyncQuery(char const* sql)
 {
-    std::future<QueryResult> result = boost::asio::post(_ioContext->get_executor(), boost::asio::use_future([this, sql = std::string(sql), tracker = QueueSizeTracker(this)]
+    CloseExecuteBatch();
+
+    std::packaged_task<QueryResult(T*)> task([sql = std::string(sql)](T* conn)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
         return BasicStatementTask::Query(conn, sql.c_str());
-    }));
+    });
+    std::future<QueryResult> result = task.get_future();
+    Enqueue(DatabaseTaskPriority::Interactive, [task = std::move(task), tracker = QueueSizeTracker(this)](T* conn) mutable { task(conn); });
     return QueryCallback(std::move(result));
 }
 
 template <class T>
 QueryCallback DatabaseWorkerPool<T>::AsyncQuery(PreparedStatement<T>* stmt)
 {
-    std::future<PreparedQueryResult> result = boost::asio::post(_ioContext->get_executor(), boost::asio::use_future([this, stmt = std::unique_ptr<PreparedStatement<T>>(stmt), tracker = QueueSizeTracker(this)]
+    CloseExecuteBatch();
+
+    std::packaged_task<PreparedQueryResult(T*)> task([stmt = std::unique_ptr<PreparedStatement<T>>(stmt)](T* conn)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
         return PreparedStatementTask::Query(conn, stmt.get());
-    }));
+    });
+    std::future<PreparedQueryResult> result = task.get_future();
+    Enqueue(DatabaseTaskPriority::Interactive, [task = std::move(task), tracker = QueueSizeTracker(this)](T* conn) mutable { task(conn); });
     return QueryCallback(std::move(result));
 }
 
 template <class T>
 SQLQueryHolderCallback DatabaseWorkerPool<T>::DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder)
 {
-    std::future<void> result = boost::asio::post(_ioContext->get_executor(), boost::asio::use_future([this, holder, tracker = QueueSizeTracker(this)]
-    {
-        T* conn = GetAsyncConnectionForCurrentThread();
-        SQLQueryHolderTask::Execute(conn, holder.get());
-    }));
+    std::shared_ptr<std::promise<void>> promise = std::make_shared<std::promise<void>>();
+    std::future<void> result = promise->get_future();
+    EnqueueQueryHolder(holder, [promise] { promise->set_value(); });
     return { std::move(holder), std::move(result) };
 }
 
+template <class T>
+Trinity::Database::Awaitable<QueryResult> DatabaseWorkerPool<T>::AwaitQuery(char const* sql)
+{
+    CloseExecuteBatch();
+
+    std::shared_ptr<Trinity::Database::AwaitState<QueryResult>> state = std::make_shared<Trinity::Database::AwaitState<QueryResult>>();
+    Enqueue(DatabaseTaskPriority::Interactive, [state, sql = std::string(sql), tracker = QueueSizeTracker(this)](T* conn)
+    {
+        state->Complete(BasicStatementTask::Query(conn, sql.c_str()));
+    });
+    return Trinity::Database::Awaitable<QueryResult>(std::move(state));
+}
+
+template <class T>
+Trinity::Database::Awaitable<PreparedQueryResult> DatabaseWorkerPool<T>::AwaitQuery(PreparedStatement<T>* stmt)
+{
+    CloseExecuteBatch();
+
+    std::shared_ptr<Trinity::Database::AwaitState<PreparedQueryResult>> state = std::make_shared<Trinity::Database::AwaitState<PreparedQueryResult>>();
+    Enqueue(DatabaseTaskPriority::Interactive, [state, stmt = std::unique_ptr<PreparedStatement<T>>(stmt), tracker = QueueSizeTracker(this)](T* conn)
+    {
+        state->Complete(PreparedStatementTask::Query(conn, stmt.get()));
+    });
+    return Trinity::Database::Awaitable<PreparedQueryResult>(std::move(state));
+}
+
+template <class T>
+Trinity::Database::Awaitable<std::shared_ptr<SQLQueryHolderBase>> DatabaseWorkerPool<T>::AwaitQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder)
+{
+    std::shared_ptr<Trinity::Database::AwaitState<std::shared_ptr<SQLQueryHolderBase>>> state = std::make_shared<Trinity::Database::AwaitState<std::shared_ptr<SQLQueryHolderBase>>>();
+    EnqueueQueryHolder(holder, [state, holder] { state->Complete(holder); });
+    return Trinity::Database::Awaitable<std::shared_ptr<SQLQueryHolderBase>>(std::move(state));
+}
+
+template <class T>
+template <typename Completion>
+void DatabaseWorkerPool<T>::EnqueueQueryHolder(std::shared_ptr<SQLQueryHolder<T>> const& holder, Completion&& onComplete)
+{
+    CloseExecuteBatch();
+
+    // each statement is a full round trip, spreading them over idle connections turns a login into a few round trips
+    // a part is only worth a task when it saves at least a couple of them
+    static constexpr std::size_t MinStatementsPerPart = 4;
+
+    std::size_t queryCount = holder->GetSize();
+    std::size_t partCount = std::clamp<std::size_t>(queryCount / MinStatementsPerPart, 1, std::max<std::size_t>(_asyncConnectionCount.load(), 1));
+    if (partCount == 1)
+    {
+        Enqueue(DatabaseTaskPriority::Login, [holder, onComplete = std::forward<Completion>(onComplete), tracker = QueueSizeTracker(this)](T* conn) mutable
+        {
+            SQLQueryHolderTask::Execute(conn, holder.get());
+            onComplete();
+        });
+        return;
+    }
+
+    struct HolderCompletion
+    {
+        std::decay_t<Completion> OnComplete;
+        std::atomic<std::size_t> RemainingParts;
+    };
+
+    std::shared_ptr<HolderCompletion> completion = std::make_shared<HolderCompletion>(std::forward<Completion>(onComplete), partCount);
+
+    for (std::size_t part = 0; part < partCount; ++part)
+    {
+        std::size_t begin = queryCount * part / partCount;
+        std::size_t end = queryCount * (part + 1) / partCount;
+        Enqueue(DatabaseTaskPriority::Login, [holder, completion, begin, end, tracker = QueueSizeTracker(this)](T* conn)
+        {
+            SQLQueryHolderTask::Execute(conn, holder.get(), begin, end);
+            if (--completion->RemainingParts == 0)
+                completion->OnComplete();
+        });
+    }
+}
+
 template <class T>
 SQLTransaction<T> DatabaseWorkerPool<T>::BeginTransaction()
 {
@@ -297,7 +605,7 @@ SQLTransaction<T> DatabaseWorkerPool<T>::BeginTransaction()
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
+void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction, DatabaseTaskPriority priority /*= DatabaseTaskPriority::Write*/)
 {
 #ifdef TRINITY_DEBUG
     //! Only analyze transaction weaknesses in Debug mode.
@@ -316,9 +624,10 @@ void DatabaseWorkerPool<T>::CommitTransaction(SQLTransaction<T> transaction)
     }
 #endif // TRINITY_DEBUG
 
-    boost::asio::post(_ioContext->get_executor(), [this, transaction, tracker = QueueSizeTracker(this)]
+    CloseExecuteBatch();
+
+    Enqueue(priority, [transaction, tracker = QueueSizeTracker(this)](T* conn)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
         TransactionTask::Execute(conn, transaction);
     });
 }
@@ -343,14 +652,30 @@ TransactionCallback DatabaseWorkerPool<T>::AsyncCommitTransaction(SQLTransaction
     }
 #endif // TRINITY_DEBUG
 
-    std::future<bool> result = boost::asio::post(_ioContext->get_executor(), boost::asio::use_future([this, transaction, tracker = QueueSizeTracker(this)]
+    CloseExecuteBatch();
+
+    std::packaged_task<bool(T*)> task([transaction](T* conn)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
         return TransactionTask::Execute(conn, transaction);
-    }));
+    });
+    std::future<bool> result = task.get_future();
+    Enqueue(DatabaseTaskPriority::Write, [task = std::move(task), tracker = QueueSizeTracker(this)](T* conn) mutable { task(conn); });
     return TransactionCallback(std::move(result));
 }
 
+template <class T>
+Trinity::Database::Awaitable<bool> DatabaseWorkerPool<T>::AwaitCommitTransaction(SQLTransaction<T> transaction)
+{
+    CloseExecuteBatch();
+
+    std::shared_ptr<Trinity::Database::AwaitState<bool>> state = std::make_shared<Trinity::Database::AwaitState<bool>>();
+    Enqueue(DatabaseTaskPriority::Write, [state, transaction, tracker = QueueSizeTracker(this)](T* conn)
+    {
+        state->Complete(TransactionTask::Execute(conn, transaction));
+    });
+    return Trinity::Database::Awaitable<bool>(std::move(state));
+}
+
 template <class T>
 void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction<T>& transaction)
 {
@@ -415,12 +740,11 @@ void DatabaseWorkerPool<T>::KeepAlive()
     //! Assuming all worker threads are free, every worker thread will receive 1 ping operation request
     //! If one or more worker threads are busy, the ping operations will not be split evenly, but this doesn't matter
     //! as the sole purpose is to prevent connections from idling.
-    auto const count = _connections[IDX_ASYNC].size();
+    auto const count = _asyncConnectionCount.load();
     for (uint8 i = 0; i < count; ++i)
     {
-        boost::asio::post(_ioContext->get_executor(), [this, tracker = QueueSizeTracker(this)]
+        Enqueue(DatabaseTaskPriority::Background, [tracker = QueueSizeTracker(this)](T* conn)
         {
-            T* conn = GetAsyncConnectionForCurrentThread();
             conn->Ping();
         });
     }
@@ -435,6 +759,7 @@ uint32 DatabaseWorkerPool<T>::OpenConnections(InternalIndex type, uint8 numConne
         constexpr std::array<ConnectionFlags, IDX_SIZE> flags = { { CONNECTION_ASYNC, CONNECTION_SYNCH } };
 
         std::unique_ptr<T> connection = std::make_unique<T>(*_connectionInfo, flags[type]);
+        connection->SetStatementStatistics(_statementStatistics.get());
 
         if (uint32 error = connection->Open())
         {
@@ -511,12 +836,8 @@ T* DatabaseWorkerPool<T>::GetFreeConnection()
 template <class T>
 T* DatabaseWorkerPool<T>::GetAsyncConnectionForCurrentThread() const
 {
-    std::thread::id id = std::this_thread::get_id();
-    for (auto&& connection : _connections[IDX_ASYNC])
-        if (connection->GetWorkerThreadId() == id)
-            return connection.get();
-
-    return nullptr;
+    // worker threads only ever run tasks of the pool that started them
+    return static_cast<T*>(MySQLConnection::GetCurrentThreadConnection());
 }
 
 template <class T>
@@ -526,28 +847,218 @@ char const* DatabaseWorkerPool<T>::GetDatabaseName() const
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Execute(char const* sql)
+void DatabaseWorkerPool<T>::Execute(char const* sql, DatabaseTaskPriority priority)
 {
     if (!sql)
         return;
 
-    boost::asio::post(_ioContext->get_executor(), [this, sql = std::string(sql), tracker = QueueSizeTracker(this)]
+    CloseExecuteBatch();
+
+    Enqueue(priority, [sql = std::string(sql), tracker = QueueSizeTracker(this)](T* conn)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
         BasicStatementTask::Execute(conn, sql.c_str());
     });
 }
 
 template <class T>
-void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt)
+void DatabaseWorkerPool<T>::Execute(PreparedStatement<T>* stmt, DatabaseTaskPriority priority /*= DatabaseTaskPriority::Write*/)
 {
-    boost::asio::post(_ioContext->get_executor(), [this, stmt = std::unique_ptr<PreparedStatement<T>>(stmt), tracker = QueueSizeTracker(this)]
+    if (priority != DatabaseTaskPriority::Write)
     {
-        T* conn = GetAsyncConnectionForCurrentThread();
-        PreparedStatementTask::Execute(conn, stmt.get());
+        Enqueue(priority, [stmt = std::unique_ptr<PreparedStatement<T>>(stmt), tracker = QueueSizeTracker(this)](T* conn)
+        {
+            PreparedStatementTask::Execute(conn, stmt.get());
+        });
+        return;
+    }
+
+    std::shared_ptr<ExecuteBatch> batch;
+    {
+        std::lock_guard lock(_executeBatchLock);
+        if (_openExecuteBatch && _openExecuteBatch->Statements.size() < MAX_EXECUTE_BATCH_SIZE)
+        {
+            // previous statement not picked up by a worker yet, run together with it
+            _openExecuteBatch->Statements.emplace_back(stmt);
+            _openExecuteBatch->Trackers.emplace_back(this);
+            return;
+        }
+
+        batch = std::make_shared<ExecuteBatch>();
+        batch->Statements.emplace_back(stmt);
+        batch->Trackers.emplace_back(this);
+        _openExecuteBatch = batch;
+    }
+
+    Enqueue(DatabaseTaskPriority::Write, [this, batch](T* conn)
+    {
+        {
+            std::lock_guard lock(_executeBatchLock);
+            if (_openExecuteBatch == batch)
+                _openExecuteBatch = nullptr;
+        }
+
+        if (batch->Statements.size() == 1)
+        {
+            PreparedStatementTask::Execute(conn, batch->Statements.front().get());
+            return;
+        }
+
+        std::vector<PreparedStatementBase*> statements;
+        statements.reserve(batch->Statements.size());
+        for (std::unique_ptr<PreparedStatement<T>> const& statement : batch->Statements)
+            statements.push_back(statement.get());
+
+        conn->ExecuteBatch(statements);
     });
 }
 
+template <class T>
+void DatabaseWorkerPool<T>::CloseExecuteBatch()
+{
+    std::lock_guard lock(_executeBatchLock);
+    _openExecuteBatch = nullptr;
+}
+
+template <class T>
+template <typename Task>
+void DatabaseWorkerPool<T>::Enqueue(DatabaseTaskPriority priority, Task&& task)
+{
+    using TaskType = typename TaskQueue::template TaskImpl<std::remove_cvref_t<Task>>;
+
+    {
+        std::lock_guard lock(_taskQueue->Lock);
+        _taskQueue->Lanes[std::size_t(priority)].push_back({ std::make_unique<TaskType>(std::forward<Task>(task)), _taskQueue->NextSequence++, std::chrono::steady_clock::now() });
+    }
+
+    boost::asio::post(_ioContext->get_executor(), [this] { ExecuteNextTask(); });
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::ExecuteNextTask()
+{
+    std::optional<typename TaskQueue::Entry> entry;
+    bool addConnection = false;
+    bool retireConnection = false;
+    {
+        std::lock_guard lock(_taskQueue->Lock);
+        std::size_t lane = _taskQueue->PickLane();
+        entry.emplace(std::move(_taskQueue->Lanes[lane].front()));
+        _taskQueue->Lanes[lane].pop_front();
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        auto wait = std::chrono::duration_cast<std::chrono::microseconds>(now - entry->EnqueueTime);
+        _taskQueue->WaitTimes[lane].Add(uint32(std::min<int64>(wait.count(), std::numeric_limits<uint32>::max())));
+
+        if (_max_async_threads > _async_threads)
+        {
+            std::size_t connectionCount = _asyncConnectionCount;
+            bool canResize = now - _taskQueue->LastResizeTime >= TaskQueue::ResizeCooldown;
+            if (wait >= TaskQueue::GrowWait)
+            {
+                _taskQueue->LastBusyTime = now;
+                addConnection = canResize && connectionCount < _max_async_threads;
+            }
+            else
+                retireConnection = canResize && connectionCount > _async_threads && now - _taskQueue->LastBusyTime >= TaskQueue::ShrinkIdleTime;
+
+            if (addConnection || retireConnection)
+                _taskQueue->LastResizeTime = now;
+        }
+    }
+
+    {
+        TC_TRACE_ZONE("db_task");
+        entry->Task->Execute(GetAsyncConnectionForCurrentThread());
+        entry.reset();
+    }
+
+    if (addConnection)
+        AddAsyncConnection();
+    else if (retireConnection)
+        RetireCurrentAsyncConnection();
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::AddAsyncConnection()
+{
+    ReapRetiredAsyncConnections();
+
+    std::unique_ptr<T> connection = std::make_unique<T>(*_connectionInfo, CONNECTION_ASYNC);
+    connection->SetStatementStatistics(_statementStatistics.get());
+    if (connection->Open() || !connection->PrepareStatements())
+    {
+        TC_LOG_ERROR("sql.driver", "DatabasePool '{}' could not open an additional asynchronous connection.", GetDatabaseName());
+        return;
+    }
+
+    connection->StartWorkerThread(_ioContext.get());
+
+    std::lock_guard lock(_asyncConnectionsLock);
+    _connections[IDX_ASYNC].push_back(std::move(connection));
+    _asyncConnectionCount = _connections[IDX_ASYNC].size();
+
+    TC_LOG_INFO("sql.driver", "DatabasePool '{}' queue is falling behind, asynchronous connections: {} (max {}).",
+        GetDatabaseName(), _connections[IDX_ASYNC].size(), _max_async_threads);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::RetireCurrentAsyncConnection()
+{
+    T* current = GetAsyncConnectionForCurrentThread();
+
+    std::lock_guard lock(_asyncConnectionsLock);
+    auto itr = std::find_if(_connections[IDX_ASYNC].begin(), _connections[IDX_ASYNC].end(), [current](std::unique_ptr<T> const& connection) { return connection.get() == current; });
+    if (itr == _connections[IDX_ASYNC].end())
+        return;
+
+    // the connection cannot join its own worker thread, it is destroyed by ReapRetiredAsyncConnections
+    current->RetireWorkerThread();
+    _retiredConnections.push_back(std::move(*itr));
+    _connections[IDX_ASYNC].erase(itr);
+    _asyncConnectionCount = _connections[IDX_ASYNC].size();
+
+    TC_LOG_INFO("sql.driver", "DatabasePool '{}' is idle, asynchronous connections: {} (min {}).",
+        GetDatabaseName(), _connections[IDX_ASYNC].size(), _async_threads);
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::ReapRetiredAsyncConnections()
+{
+    std::lock_guard lock(_asyncConnectionsLock);
+    std::erase_if(_retiredConnections, [](std::unique_ptr<T> const& connection) { return connection->IsWorkerThreadFinished(); });
+}
+
+template <class T>
+void DatabaseWorkerPool<T>::LogQueueMetrics()
+{
+    std::array<std::size_t, MAX_DATABASE_TASK_PRIORITIES> depths;
+    std::array<MetricHistogram, MAX_DATABASE_TASK_PRIORITIES> waitTimes;
+    {
+        std::lock_guard lock(_taskQueue->Lock);
+        for (std::size_t i = 0; i < MAX_DATABASE_TASK_PRIORITIES; ++i)
+        {
+            depths[i] = _taskQueue->Lanes[i].size();
+            waitTimes[i] = _taskQueue->WaitTimes[i];
+            _taskQueue->WaitTimes[i].Reset();
+        }
+    }
+
+    for (std::size_t i = 0; i < MAX_DATABASE_TASK_PRIORITIES; ++i)
+    {
+        TC_METRIC_VALUE("db_queue_depth", uint64(depths[i]), TC_METRIC_TAG("database", GetDatabaseName()), TC_METRIC_TAG("priority", TaskQueue::Names[i]));
+        TC_METRIC_HISTOGRAM("db_queue_wait", waitTimes[i], TC_METRIC_TAG("database", GetDatabaseName()), TC_METRIC_TAG("priority", TaskQueue::Names[i]));
+    }
+
+    ReapRetiredAsyncConnections();
+    TC_METRIC_VALUE("db_async_connections", uint64(_asyncConnectionCount.load()), TC_METRIC_TAG("database", GetDatabaseName()));
+
+    // tagged with the index in the Statements enum of the database
+    std::vector<MetricHistogram> latencies = _statementStatistics->Collect();
+    for (std::size_t i = 0; i < latencies.size(); ++i)
+        if (latencies[i].GetCount())
+            TC_METRIC_HISTOGRAM("db_statement_latency", latencies[i], TC_METRIC_TAG("database", GetDatabaseName()), TC_METRIC_TAG("statement", std::to_string(i)));
+}
+
 template <class T>
 void DatabaseWorkerPool<T>::DirectExecute(char const* sql)
 {
@@ -24,10 +24,29 @@
 #include "StringFormat.h"
 #include <array>
 #include <atomic>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
 struct MySQLConnectionInfo;
+class MySQLStatementStatistics;
+
+//! Async work is split in lanes served by weight, each lane is executed in order
+//! Interactive and login reads never overtake writes enqueued before them
+enum class DatabaseTaskPriority : uint8
+{
+    Interactive,    //!< async queries somebody is waiting on
+    Login,          //!< login query holders
+    Write,          //!< statements and transactions
+    Background,     //!< maintenance work nothing waits on, may run out of order with all other lanes
+
+    Max
+};
+
+constexpr std::size_t MAX_DATABASE_TASK_PRIORITIES = std::size_t(DatabaseTaskPriority::Max);
 
 template <class T>
 class DatabaseWorkerPool
@@ -46,7 +65,14 @@ class DatabaseWorkerPool
 
         ~DatabaseWorkerPool();
 
-        void SetConnectionInfo(std::string const& infoString, uint8 const asyncThreads, uint8 const synchThreads);
+        //! Async connections are added while tasks wait too long, up to maxAsyncThreads, and removed again when idle
+        void SetConnectionInfo(std::string const& infoString, uint8 const asyncThreads, uint8 const synchThreads, uint8 const maxAsyncThreads = 0);
+
+        //! Prepared statements taking at least this long are logged with their parameters, 0 disables the log
+        void SetSlowStatementThreshold(uint32 milliseconds);
+
+        //! Results of QueryCached are stored in this directory, empty disables snapshots
+        void SetSnapshotDirectory(std::string directory);
 
         uint32 Open();
 
@@ -66,7 +92,7 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in string format that will be executed asynchronously.
         //! This method should only be used for queries that are only executed once, e.g during startup.
-        void Execute(char const* sql);
+        void Execute(char const* sql, DatabaseTaskPriority priority = DatabaseTaskPriority::Write);
 
         //! Enqueues a one-way SQL operation in string format -with variable args- that will be executed asynchronously.
         //! This method should only be used for queries that are only executed once, e.g during startup.
@@ -81,7 +107,7 @@ class DatabaseWorkerPool
 
         //! Enqueues a one-way SQL operation in prepared statement format that will be executed asynchronously.
         //! Statement must be prepared with CONNECTION_ASYNC flag.
-        void Execute(PreparedStatement<T>* stmt);
+        void Execute(PreparedStatement<T>* stmt, DatabaseTaskPriority priority = DatabaseTaskPriority::Write);
 
         /**
             Direct synchronous one-way statement methods.
@@ -141,6 +167,11 @@ class DatabaseWorkerPool
         //! Statement must be prepared with CONNECTION_SYNCH flag.
         PreparedQueryResult Query(PreparedStatement<T>* stmt);
 
+        //! Directly executes an SQL query in string format and stores its rows in a snapshot file, later calls read the file instead
+        //! as long as the checksums of the given tables and the applied updates did not change.
+        //! This method should only be used for large startup queries whose result depends on nothing but the given tables.
+        QueryResult QueryCached(char const* sql, std::initializer_list<char const*> tables);
+
         /**
             Asynchronous query (with resultset) methods.
         */
@@ -158,8 +189,24 @@ class DatabaseWorkerPool
         //! return object as soon as the query is executed.
         //! The return value is then processed in ProcessQueryCallback methods.
         //! Any prepared statements added to this holder need to be prepared with the CONNECTION_ASYNC flag.
+        //! Large holders are split in parts that run on several async connections at the same time, statements of one holder are not ordered.
         SQLQueryHolderCallback DelayQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder);
 
+        /**
+            Coroutine (co_await inside a Trinity::Database::AsyncTask) methods.
+            The awaiting task is resumed by the AsyncTaskProcessor it was started on, once the worker finished the operation.
+        */
+
+        //! Same as AsyncQuery, with the result returned by co_await.
+        Trinity::Database::Awaitable<QueryResult> AwaitQuery(char const* sql);
+
+        //! Same as AsyncQuery, with the result returned by co_await.
+        //! Statement must be prepared with CONNECTION_ASYNC flag.
+        Trinity::Database::Awaitable<PreparedQueryResult> AwaitQuery(PreparedStatement<T>* stmt);
+
+        //! Same as DelayQueryHolder, co_await returns the executed holder.
+        Trinity::Database::Awaitable<std::shared_ptr<SQLQueryHolderBase>> AwaitQueryHolder(std::shared_ptr<SQLQueryHolder<T>> holder);
+
         /**
             Transaction context methods.
         */
@@ -169,12 +216,15 @@ class DatabaseWorkerPool
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
-        void CommitTransaction(SQLTransaction<T> transaction);
+        void CommitTransaction(SQLTransaction<T> transaction, DatabaseTaskPriority priority = DatabaseTaskPriority::Write);
 
         //! Enqueues a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
         TransactionCallback AsyncCommitTransaction(SQLTransaction<T> transaction);
 
+        //! Same as AsyncCommitTransaction, co_await returns whether the transaction was committed.
+        Trinity::Database::Awaitable<bool> AwaitCommitTransaction(SQLTransaction<T> transaction);
+
         //! Directly executes a collection of one-way SQL operations (can be both adhoc and prepared). The order in which these operations
         //! were appended to the transaction will be respected during execution.
         void DirectCommitTransaction(SQLTransaction<T>& transaction);
@@ -213,6 +263,10 @@ class DatabaseWorkerPool
 
         size_t QueueSize() const;
 
+        //! Sends queue depth and wait time of every priority lane, the async connection count
+        //! and the latency of every prepared statement executed since the last call to Metric
+        void LogQueueMetrics();
+
     private:
         uint32 OpenConnections(InternalIndex type, uint8 numConnections);
 
@@ -226,16 +280,54 @@ class DatabaseWorkerPool
 
         char const* GetDatabaseName() const;
 
+        //! Ends the batch Execute(PreparedStatement*) appends to, called before posting any other task to keep them in order
+        void CloseExecuteBatch();
+
+        //! Queues task (callable with the async connection running it) in the lane of priority
+        template<typename Task>
+        void Enqueue(DatabaseTaskPriority priority, Task&& task);
+
+        //! Queues the statements of holder, split over several async connections when large enough, onComplete runs once after the last one
+        template<typename Completion>
+        void EnqueueQueryHolder(std::shared_ptr<SQLQueryHolder<T>> const& holder, Completion&& onComplete);
+
+        //! Runs one queued task, posted to the worker threads once for every Enqueue
+        void ExecuteNextTask();
+
+        //! Opens one more async connection with its worker thread
+        void AddAsyncConnection();
+
+        //! Removes the connection of the calling worker thread, which ends after the current task
+        void RetireCurrentAsyncConnection();
+
+        //! Destroys retired connections whose worker threads ended
+        void ReapRetiredAsyncConnections();
+
+        //! Identifies the contents of tables and the applied updates, snapshots written for another key are ignored
+        uint64 GetSnapshotKey(T* connection, char const* sql, std::initializer_list<char const*> tables);
+
         struct QueueSizeTracker;
         friend QueueSizeTracker;
 
+        struct ExecuteBatch;
+        struct TaskQueue;
+
         //! Queue shared by async worker threads.
         std::unique_ptr<Trinity::Asio::IoContext> _ioContext;
         std::atomic<size_t> _queueSize;
+        std::unique_ptr<TaskQueue> _taskQueue;
+        std::mutex _executeBatchLock;
+        std::shared_ptr<ExecuteBatch> _openExecuteBatch;   //!< queued but not yet started statements, later ones join it
         std::array<std::vector<std::unique_ptr<T>>, IDX_SIZE> _connections;
+        std::mutex _asyncConnectionsLock;                   //!< guards _connections[IDX_ASYNC] and _retiredConnections once the pool is open
+        std::vector<std::unique_ptr<T>> _retiredConnections;
+        std::atomic<size_t> _asyncConnectionCount;
+        std::unique_ptr<MySQLStatementStatistics> _statementStatistics;
+        std::string _snapshotDirectory;
+        std::optional<std::size_t> _snapshotUpdatesKey;  //!< hash of the `updates` table, read by the first QueryCached
         std::unique_ptr<MySQLConnectionInfo> _connectionInfo;
         std::vector<uint8> _preparedStatementSize;
-        uint8 _async_threads, _synch_threads;
+        uint8 _async_threads, _synch_threads, _max_async_threads;
 #ifdef TRINITY_DEBUG
         static inline thread_local bool _warnSyncQueries = false;
 #endif
@@ -92,6 +92,7 @@ class TC_DATABASE_API Field
 {
     friend class ResultSet;
     friend class PreparedResultSet;
+    friend class QueryResultRowReader;
 
     public:
         Field();
@@ -426,6 +426,7 @@ enum CharacterDatabaseStatements : uint32
     CHAR_SEL_CHAR_SOCIAL,
     CHAR_SEL_CHAR_OLD_CHARS,
     CHAR_SEL_MAIL,
+    CHAR_SEL_MAIL_ITEM_INFO,
     CHAR_DEL_CHAR_AURA_FROZEN,
     CHAR_SEL_CHAR_INVENTORY_COUNT_ITEM,
     CHAR_SEL_MAIL_COUNT_ITEM,
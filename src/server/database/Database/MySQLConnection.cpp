@@ -16,6 +16,7 @@
  */
 
 #include "MySQLConnection.h"
+#include "AllocationTracker.h"
 #include "Common.h"
 #include "IoContext.h"
 #include "Log.h"
@@ -23,12 +24,19 @@
 #include "MySQLPreparedStatement.h"
 #include "PreparedStatement.h"
 #include "QueryResult.h"
+#include "StringFormat.h"
+#include "ThreadAffinity.h"
+#include "TickTracer.h"
 #include "Timer.h"
 #include "Transaction.h"
+#include "StringConvert.h"
 #include "Util.h"
 #include <errmsg.h>
 #include "MySQLWorkaround.h"
 #include <mysqld_error.h>
+#include <algorithm>
+#include <bit>
+#include <limits>
 
 MySQLConnectionInfo::MySQLConnectionInfo(std::string const& infoString)
 {
@@ -47,12 +55,38 @@ MySQLConnectionInfo::MySQLConnectionInfo(std::string const& infoString)
         ssl.assign(tokens[5]);
 }
 
+namespace
+{
+thread_local MySQLConnection* CurrentThreadConnection = nullptr;
+}
+
+void MySQLStatementStatistics::Record(uint32 index, uint32 microseconds)
+{
+    std::lock_guard lock(_lock);
+    if (index >= _latencies.size())
+        _latencies.resize(index + 1);
+
+    _latencies[index].Add(microseconds);
+}
+
+std::vector<MetricHistogram> MySQLStatementStatistics::Collect()
+{
+    std::vector<MetricHistogram> latencies;
+    std::lock_guard lock(_lock);
+    latencies.swap(_latencies);
+    return latencies;
+}
+
 MySQLConnection::MySQLConnection(MySQLConnectionInfo& connInfo, ConnectionFlags connectionFlags) :
 m_reconnecting(false),
 m_prepareError(false),
 m_Mysql(nullptr),
 m_connectionInfo(connInfo),
-m_connectionFlags(connectionFlags)
+m_connectionFlags(connectionFlags),
+m_maxAllowedPacket(0),
+m_workerRetired(false),
+m_workerFinished(false),
+m_statementStatistics(nullptr)
 {
 }
 
@@ -70,6 +104,7 @@ void MySQLConnection::Close()
         m_workerThread.reset();
     }
 
+    m_multiRowStmts.clear();
     m_stmts.clear();
 
     if (m_Mysql)
@@ -163,6 +198,20 @@ uint32 MySQLConnection::Open()
         // set connection properties to UTF8 to properly handle locales for different
         // server configs - core sends data in UTF8, so MySQL must expect UTF8 too
         mysql_set_character_set(m_Mysql, "utf8mb4");
+
+        // 4 MB is the smallest default of all supported server versions
+        m_maxAllowedPacket = 4 * 1024 * 1024;
+        if (!mysql_query(m_Mysql, "SELECT @@max_allowed_packet"))
+        {
+            if (MYSQL_RES* result = mysql_store_result(m_Mysql))
+            {
+                if (MYSQL_ROW row = mysql_fetch_row(result); row && row[0])
+                    m_maxAllowedPacket = Trinity::StringTo<uint64>(row[0]).value_or(m_maxAllowedPacket);
+
+                mysql_free_result(result);
+            }
+        }
+
         return 0;
     }
     else
@@ -176,6 +225,7 @@ uint32 MySQLConnection::Open()
 
 bool MySQLConnection::PrepareStatements()
 {
+    m_multiRowStmts.clear();
     DoPrepareStatements();
     return !m_prepareError;
 }
@@ -242,6 +292,7 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
     MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
     uint32 _s = getMSTime();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
     if (mysql_bind_param_no_deprecated(msql_STMT, msql_BIND))
     {
@@ -267,12 +318,56 @@ bool MySQLConnection::Execute(PreparedStatementBase* stmt)
         return false;
     }
 
+    RecordStatementTime(m_mStmt, index, start);
     TC_LOG_DEBUG("sql.sql", "[{} ms] SQL(p): {}", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString());
 
     m_mStmt->ClearParameters();
     return true;
 }
 
+bool MySQLConnection::ExecuteMultiRow(std::span<PreparedStatementBase* const> rows)
+{
+    if (!m_Mysql)
+        return false;
+
+    MySQLPreparedStatement* m_mStmt = GetMultiRowPreparedStatement(rows.front()->GetIndex(), uint32(rows.size()));
+    if (!m_mStmt)
+    {
+        for (PreparedStatementBase* row : rows)
+            if (!Execute(row))
+                return false;
+
+        return true;
+    }
+
+    m_mStmt->BindParameters(rows);
+
+    MYSQL_STMT* msql_STMT = m_mStmt->GetSTMT();
+    MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
+
+    uint32 _s = getMSTime();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if (mysql_bind_param_no_deprecated(msql_STMT, msql_BIND) || mysql_stmt_execute(msql_STMT))
+    {
+        uint32 lErrno = mysql_errno(m_Mysql);
+        TC_LOG_ERROR("sql.sql", "SQL(p): {}\n [ERROR]: [{}] {}", m_mStmt->getQueryString(), lErrno, mysql_stmt_error(msql_STMT));
+
+        m_mStmt->ClearParameters();
+
+        if (_HandleMySQLErrno(lErrno))  // If it returns true, an error was handled successfully (i.e. reconnection)
+            return ExecuteMultiRow(rows); // Try again, reconnecting dropped the multi row statements
+
+        return false;
+    }
+
+    RecordStatementTime(m_mStmt, rows.front()->GetIndex(), start);
+    TC_LOG_DEBUG("sql.sql", "[{} ms] SQL(p) {} rows: {}", getMSTimeDiff(_s, getMSTime()), rows.size(), m_mStmt->getQueryString());
+
+    m_mStmt->ClearParameters();
+    return true;
+}
+
 bool MySQLConnection::_Query(PreparedStatementBase* stmt, MySQLPreparedStatement** mysqlStmt, MySQLResult** pResult, uint64* pRowCount, uint32* pFieldCount)
 {
     if (!m_Mysql)
@@ -290,6 +385,7 @@ bool MySQLConnection::_Query(PreparedStatementBase* stmt, MySQLPreparedStatement
     MYSQL_BIND* msql_BIND = m_mStmt->GetBind();
 
     uint32 _s = getMSTime();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
     if (mysql_bind_param_no_deprecated(msql_STMT, msql_BIND))
     {
@@ -316,6 +412,7 @@ bool MySQLConnection::_Query(PreparedStatementBase* stmt, MySQLPreparedStatement
         return false;
     }
 
+    RecordStatementTime(m_mStmt, index, start);
     TC_LOG_DEBUG("sql.sql", "[{} ms] SQL(p): {}", getMSTimeDiff(_s, getMSTime()), m_mStmt->getQueryString());
 
     m_mStmt->ClearParameters();
@@ -340,6 +437,7 @@ ResultSet* MySQLConnection::Query(char const* sql)
     if (!_Query(sql, &result, &fields, &rowCount, &fieldCount))
         return nullptr;
 
+    TC_ALLOCATION_TAG_SCOPE(DatabaseResults);
     return new ResultSet(result, fields, rowCount, fieldCount);
 }
 
@@ -407,15 +505,32 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
 
     BeginTransaction();
 
-    for (auto itr = queries.begin(); itr != queries.end(); ++itr)
+    std::vector<PreparedStatementBase*> rows;
+    for (std::size_t i = 0; i < queries.size();)
     {
-        if (!std::visit([this](auto&& data) { return this->Execute(TransactionData::ToExecutable(data)); }, itr->query))
+        bool executed;
+        std::size_t rowCount = GetMultiRowInsertCount(queries, i);
+        if (rowCount > 1)
+        {
+            // consecutive rows of the same INSERT are sent as a single statement
+            rows.clear();
+            for (std::size_t j = i; j < i + rowCount; ++j)
+                rows.push_back(std::get<std::unique_ptr<PreparedStatementBase>>(queries[j].query).get());
+
+            executed = ExecuteMultiRow(rows);
+        }
+        else
+            executed = std::visit([this](auto&& data) { return this->Execute(TransactionData::ToExecutable(data)); }, queries[i].query);
+
+        if (!executed)
         {
             TC_LOG_WARN("sql.sql", "Transaction aborted. {} queries not executed.", queries.size());
             int errorCode = GetLastError();
             RollbackTransaction();
             return errorCode;
         }
+
+        i += rowCount;
     }
 
     // we might encounter errors during certain queries, and depending on the kind of error
@@ -427,6 +542,55 @@ int MySQLConnection::ExecuteTransaction(std::shared_ptr<TransactionBase> transac
     return 0;
 }
 
+void MySQLConnection::ExecuteBatch(std::span<PreparedStatementBase* const> statements)
+{
+    if (statements.size() <= 1 || !m_Mysql)
+    {
+        for (PreparedStatementBase* stmt : statements)
+            Execute(stmt);
+        return;
+    }
+
+    // every statement executed with autocommit is a transaction of its own with its own commit on the server,
+    // run the batch in a single one instead. Failing statements are still reported one by one by Execute
+    // and only roll back themselves, except for deadlocks and reconnections that lose the whole transaction
+    unsigned long threadId = mysql_thread_id(m_Mysql);
+    auto isSameSession = [&]() { return m_Mysql && mysql_thread_id(m_Mysql) == threadId; };
+
+    auto executeSeparately = [&](std::size_t interruptedAt, bool interruptedExecuted)
+    {
+        TC_LOG_WARN("sql.sql", "Batch of {} statements lost its transaction at statement {}, executing them separately.", statements.size(), std::min(interruptedAt + 1, statements.size()));
+
+        if (isSameSession())
+            RollbackTransaction();
+
+        // a statement retried after reconnecting already ran on the new connection
+        std::size_t redoEnd = interruptedExecuted ? interruptedAt : interruptedAt + 1;
+        for (std::size_t i = 0; i < redoEnd; ++i)
+            Execute(statements[i]);
+
+        for (std::size_t i = interruptedAt + 1; i < statements.size(); ++i)
+            Execute(statements[i]);
+    };
+
+    BeginTransaction();
+
+    for (std::size_t i = 0; i < statements.size(); ++i)
+    {
+        bool executed = Execute(statements[i]);
+        if (!isSameSession() || (!executed && GetLastError() == ER_LOCK_DEADLOCK))
+        {
+            executeSeparately(i, executed);
+            return;
+        }
+    }
+
+    CommitTransaction();
+
+    if (!isSameSession())
+        executeSeparately(statements.size(), true);
+}
+
 size_t MySQLConnection::EscapeString(char* to, const char* from, size_t length)
 {
     return mysql_real_escape_string(m_Mysql, to, from, length);
@@ -444,14 +608,43 @@ uint32 MySQLConnection::GetLastError()
 
 void MySQLConnection::StartWorkerThread(Trinity::Asio::IoContext* context)
 {
-    m_workerThread = std::make_unique<std::thread>([context]
+    m_workerThread = std::make_unique<std::thread>([this, context]
     {
         boost::asio::executor_work_guard executorWorkGuard = boost::asio::make_work_guard(context->get_executor());
 
-        context->run();
+        CurrentThreadConnection = this;
+        Trinity::TickTracer::SetThreadName(Trinity::StringFormat("db {}", m_connectionInfo.database));
+        Trinity::ThreadAffinity::ApplyToCurrentThread(Trinity::ThreadClass::DatabaseAsync);
+        while (!m_workerRetired && context->run_one())
+            ;
+
+        CurrentThreadConnection = nullptr;
+        m_workerFinished = true;
     });
 }
 
+MySQLConnection* MySQLConnection::GetCurrentThreadConnection()
+{
+    return CurrentThreadConnection;
+}
+
+void MySQLConnection::RecordStatementTime(MySQLPreparedStatement* stmt, uint32 index, std::chrono::steady_clock::time_point start)
+{
+    if (Trinity::TickTracer::IsRecording())
+        Trinity::TickTracer::Record("db_statement", "statement", Trinity::StringFormat("{} {}", m_connectionInfo.database, index), start, std::chrono::steady_clock::now());
+
+    if (!m_statementStatistics)
+        return;
+
+    std::chrono::microseconds elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    m_statementStatistics->Record(index, uint32(std::min<int64>(elapsed.count(), std::numeric_limits<uint32>::max())));
+
+    uint32 slowThreshold = m_statementStatistics->GetSlowStatementThreshold();
+    if (slowThreshold && elapsed >= std::chrono::milliseconds(slowThreshold))
+        TC_LOG_WARN("sql.sql", "Slow statement {} on database `{}` took {} ms: {}", index, m_connectionInfo.database,
+            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), stmt->getQueryString());
+}
+
 std::thread::id MySQLConnection::GetWorkerThreadId() const
 {
     if (m_workerThread)
@@ -487,6 +680,77 @@ MySQLPreparedStatement* MySQLConnection::GetPreparedStatement(uint32 index)
     return ret;
 }
 
+MySQLPreparedStatement* MySQLConnection::GetMultiRowPreparedStatement(uint32 index, uint32 rows)
+{
+    std::unique_ptr<MySQLPreparedStatement>& stmt = m_multiRowStmts[(uint64(index) << 32) | rows];
+    if (stmt)
+        return stmt.get();
+
+    MySQLPreparedStatement* rowStmt = GetPreparedStatement(index);
+    if (!rowStmt)
+        return nullptr;
+
+    std::string sql = rowStmt->GetMultiRowQueryString(rows);
+    MYSQL_STMT* mysqlStmt = mysql_stmt_init(m_Mysql);
+    if (!mysqlStmt)
+        return nullptr;
+
+    if (mysql_stmt_prepare(mysqlStmt, sql.data(), static_cast<unsigned long>(sql.size())))
+    {
+        // not fatal, the rows are executed one by one instead
+        TC_LOG_ERROR("sql.sql", "In mysql_stmt_prepare() id: {} ({} rows), sql: \"{}\"", index, rows, sql);
+        TC_LOG_ERROR("sql.sql", "{}", mysql_stmt_error(mysqlStmt));
+        mysql_stmt_close(mysqlStmt);
+        return nullptr;
+    }
+
+    stmt = std::make_unique<MySQLPreparedStatement>(reinterpret_cast<MySQLStmt*>(mysqlStmt), std::move(sql));
+    return stmt.get();
+}
+
+std::size_t MySQLConnection::GetMultiRowInsertCount(std::vector<TransactionData> const& queries, std::size_t first)
+{
+    // rows are sent in power of two sized groups to keep the number of prepared variants of each statement low
+    static constexpr std::size_t MAX_MULTI_ROW_INSERT_ROWS = 64;
+    static constexpr std::size_t MAX_STATEMENT_PARAMETERS = std::numeric_limits<uint16>::max();
+
+    auto const* stmt = std::get_if<std::unique_ptr<PreparedStatementBase>>(&queries[first].query);
+    if (!stmt || first + 1 >= queries.size())
+        return 1;
+
+    uint32 index = (*stmt)->GetIndex();
+    MySQLPreparedStatement* rowStmt = GetPreparedStatement(index);
+    if (!rowStmt || !rowStmt->CanInsertMultipleRows() || !rowStmt->GetParameterCount())
+        return 1;
+
+    std::size_t maxRows = std::min(MAX_MULTI_ROW_INSERT_ROWS, MAX_STATEMENT_PARAMETERS / rowStmt->GetParameterCount());
+    uint64 packetSize = 0;
+    std::size_t rows = 0;
+    for (std::size_t i = first; i < queries.size() && rows < maxRows; ++i)
+    {
+        auto const* row = std::get_if<std::unique_ptr<PreparedStatementBase>>(&queries[i].query);
+        if (!row || (*row)->GetIndex() != index)
+            break;
+
+        // approximate size of the row in the execute packet, with a wide margin to max_allowed_packet
+        for (PreparedStatementData const& data : (*row)->GetParameters())
+        {
+            packetSize += 10;
+            if (std::string const* str = std::get_if<std::string>(&data.data))
+                packetSize += str->size();
+            else if (std::vector<uint8> const* blob = std::get_if<std::vector<uint8>>(&data.data))
+                packetSize += blob->size();
+        }
+
+        if (rows && packetSize > m_maxAllowedPacket / 2)
+            break;
+
+        ++rows;
+    }
+
+    return std::bit_floor(rows);
+}
+
 void MySQLConnection::PrepareStatement(uint32 index, std::string_view sql, ConnectionFlags flags)
 {
     // Check if specified query should be prepared on this connection
@@ -533,6 +797,8 @@ PreparedResultSet* MySQLConnection::Query(PreparedStatementBase* stmt)
     {
         mysql_next_result(m_Mysql);
     }
+
+    TC_ALLOCATION_TAG_SCOPE(DatabaseResults);
     return new PreparedResultSet(mysqlStmt->GetSTMT(), result, rowCount, fieldCount);
 }
 
@@ -21,13 +21,19 @@
 #include "AsioHacksFwd.h"
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include "MetricHistogram.h"
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 class MySQLPreparedStatement;
+struct TransactionData;
 
 enum ConnectionFlags
 {
@@ -48,6 +54,25 @@ struct TC_DATABASE_API MySQLConnectionInfo
     std::string ssl;
 };
 
+//! Execution times of prepared statements, shared by all connections of a pool
+class TC_DATABASE_API MySQLStatementStatistics
+{
+    public:
+        //! Statements taking at least this long are logged with their parameters, 0 disables the log
+        void SetSlowStatementThreshold(uint32 milliseconds) { _slowStatementThreshold = milliseconds; }
+        uint32 GetSlowStatementThreshold() const { return _slowStatementThreshold; }
+
+        void Record(uint32 index, uint32 microseconds);
+
+        //! Returns the latencies in microseconds recorded since the last call, indexed by statement
+        std::vector<MetricHistogram> Collect();
+
+    private:
+        std::atomic<uint32> _slowStatementThreshold = 0;
+        std::mutex _lock;
+        std::vector<MetricHistogram> _latencies;
+};
+
 class TC_DATABASE_API MySQLConnection
 {
     template <class T> friend class DatabaseWorkerPool;
@@ -64,6 +89,7 @@ class TC_DATABASE_API MySQLConnection
 
         bool Execute(char const* sql);
         bool Execute(PreparedStatementBase* stmt);
+        bool ExecuteMultiRow(std::span<PreparedStatementBase* const> rows);
         ResultSet* Query(char const* sql);
         PreparedResultSet* Query(PreparedStatementBase* stmt);
         bool _Query(char const* sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount);
@@ -73,6 +99,7 @@ class TC_DATABASE_API MySQLConnection
         void RollbackTransaction();
         void CommitTransaction();
         int ExecuteTransaction(std::shared_ptr<TransactionBase> transaction);
+        void ExecuteBatch(std::span<PreparedStatementBase* const> statements);
         size_t EscapeString(char* to, const char* from, size_t length);
         void Ping();
 
@@ -81,6 +108,15 @@ class TC_DATABASE_API MySQLConnection
         void StartWorkerThread(Trinity::Asio::IoContext* context);
         std::thread::id GetWorkerThreadId() const;
 
+        //! Ends the worker thread once the handler is running finished, must be called from the worker thread itself
+        void RetireWorkerThread() { m_workerRetired = true; }
+        bool IsWorkerThreadFinished() const { return m_workerFinished; }
+
+        //! Connection whose worker thread is the calling thread
+        static MySQLConnection* GetCurrentThreadConnection();
+
+        void SetStatementStatistics(MySQLStatementStatistics* statistics) { m_statementStatistics = statistics; }
+
     protected:
         /// Tries to acquire lock. If lock is acquired by another thread
         /// the calling parent will just try another connection
@@ -91,6 +127,8 @@ class TC_DATABASE_API MySQLConnection
 
         uint32 GetServerVersion() const;
         MySQLPreparedStatement* GetPreparedStatement(uint32 index);
+        MySQLPreparedStatement* GetMultiRowPreparedStatement(uint32 index, uint32 rows);
+        std::size_t GetMultiRowInsertCount(std::vector<TransactionData> const& queries, std::size_t first);
         void PrepareStatement(uint32 index, std::string_view sql, ConnectionFlags flags);
 
         virtual void DoPrepareStatements() = 0;
@@ -98,17 +136,23 @@ class TC_DATABASE_API MySQLConnection
         typedef std::vector<std::unique_ptr<MySQLPreparedStatement>> PreparedStatementContainer;
 
         PreparedStatementContainer           m_stmts;         //!< PreparedStatements storage
+        std::unordered_map<uint64, std::unique_ptr<MySQLPreparedStatement>> m_multiRowStmts; //!< Multi row variants of m_stmts, prepared on first use
         bool                                 m_reconnecting;  //!< Are we reconnecting?
         bool                                 m_prepareError;  //!< Was there any error while preparing statements?
 
     private:
         bool _HandleMySQLErrno(uint32 errNo, uint8 attempts = 5);
+        void RecordStatementTime(MySQLPreparedStatement* stmt, uint32 index, std::chrono::steady_clock::time_point start);
 
         std::unique_ptr<std::thread> m_workerThread;        //!< Core worker thread.
         MySQLHandle*          m_Mysql;                      //!< MySQL Handle.
         MySQLConnectionInfo&  m_connectionInfo;             //!< Connection info (used for logging)
         ConnectionFlags       m_connectionFlags;            //!< Connection flags (for preparing relevant statements)
+        uint64                m_maxAllowedPacket;           //!< Server max_allowed_packet, limits multi row statements
         std::mutex            m_Mutex;
+        std::atomic<bool>     m_workerRetired;
+        std::atomic<bool>     m_workerFinished;
+        MySQLStatementStatistics* m_statementStatistics;   //!< Latencies of the owning pool, if any
 
         MySQLConnection(MySQLConnection const& right) = delete;
         MySQLConnection& operator=(MySQLConnection const& right) = delete;
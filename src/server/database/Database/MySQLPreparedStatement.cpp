@@ -20,6 +20,8 @@
 #include "Log.h"
 #include "MySQLHacks.h"
 #include "PreparedStatement.h"
+#include "Util.h"
+#include <cctype>
 #include <chrono>
 #include <cstring>
 
@@ -37,6 +39,53 @@ template<> struct MySQLType<int64> : std::integral_constant<enum_field_types, MY
 template<> struct MySQLType<float> : std::integral_constant<enum_field_types, MYSQL_TYPE_FLOAT> { };
 template<> struct MySQLType<double> : std::integral_constant<enum_field_types, MYSQL_TYPE_DOUBLE> { };
 
+namespace
+{
+// finds the trailing "(?, ?, ...)" of INSERT/REPLACE ... VALUES (...) statements whose only placeholders are the row values
+std::string_view FindRowValues(std::string_view sql)
+{
+    if (!StringStartsWithI(sql, "INSERT") && !StringStartsWithI(sql, "REPLACE"))
+        return {};
+
+    while (!sql.empty() && (isspace(static_cast<unsigned char>(sql.back())) || sql.back() == ';'))
+        sql.remove_suffix(1);
+
+    if (sql.empty() || sql.back() != ')')
+        return {};
+
+    // walk back to the parenthesis opening the last value list, literals could hide parentheses
+    int32 depth = 0;
+    std::size_t open = sql.size();
+    while (open-- > 0)
+    {
+        char c = sql[open];
+        if (c == '\'' || c == '"' || c == '`')
+            return {};
+        if (c == ')')
+            ++depth;
+        else if (c == '(' && --depth == 0)
+            break;
+    }
+
+    if (depth != 0)
+        return {};
+
+    std::string_view rowValues = sql.substr(open);
+    std::string_view prefix = sql.substr(0, open);
+    while (!prefix.empty() && isspace(static_cast<unsigned char>(prefix.back())))
+        prefix.remove_suffix(1);
+
+    if (prefix.size() < 7 || !StringEqualI(prefix.substr(prefix.size() - 6), "VALUES") || !isspace(static_cast<unsigned char>(prefix[prefix.size() - 7])))
+        return {};
+
+    // ON DUPLICATE KEY UPDATE x = VALUES(x) and statements with placeholders outside of the values cannot be repeated
+    if (prefix.find('?') != std::string_view::npos || rowValues.find('?') == std::string_view::npos)
+        return {};
+
+    return rowValues;
+}
+}
+
 MySQLPreparedStatement::MySQLPreparedStatement(MySQLStmt* stmt, std::string queryString) :
     m_stmt(nullptr), m_Mstmt(stmt), m_bind(nullptr), m_queryString(std::move(queryString))
 {
@@ -46,6 +95,8 @@ MySQLPreparedStatement::MySQLPreparedStatement(MySQLStmt* stmt, std::string quer
     m_bind = new MySQLBind[m_paramCount];
     memset(m_bind, 0, sizeof(MySQLBind) * m_paramCount);
 
+    m_rowValues = FindRowValues(m_queryString);
+
     /// "If set to 1, causes mysql_stmt_store_result() to update the metadata MYSQL_FIELD->max_length value."
     MySQLBool bool_tmp = MySQLBool(1);
     mysql_stmt_attr_set(stmt, STMT_ATTR_UPDATE_MAX_LENGTH, &bool_tmp);
@@ -66,19 +117,29 @@ MySQLPreparedStatement::~MySQLPreparedStatement()
 void MySQLPreparedStatement::BindParameters(PreparedStatementBase* stmt)
 {
     m_stmt = stmt;     // Cross reference them for debug output
+    BindParameters(std::span(&m_stmt, 1));
+}
 
-    uint8 pos = 0;
-    for (PreparedStatementData const& data : stmt->GetParameters())
+void MySQLPreparedStatement::BindParameters(std::span<PreparedStatementBase* const> rows)
+{
+    m_stmt = rows.front();
+    m_rows = rows;
+
+    uint32 pos = 0;
+    for (PreparedStatementBase* row : rows)
     {
-        std::visit([&](auto&& param)
+        for (PreparedStatementData const& data : row->GetParameters())
         {
-            SetParameter(pos, param);
-        }, data.data);
-        ++pos;
+            std::visit([&](auto&& param)
+            {
+                SetParameter(pos, param);
+            }, data.data);
+            ++pos;
+        }
     }
 #ifdef _DEBUG
     if (pos < m_paramCount)
-        TC_LOG_WARN("sql.sql", "[WARNING]: BindParameters() for statement {} did not bind all allocated parameters", stmt->GetIndex());
+        TC_LOG_WARN("sql.sql", "[WARNING]: BindParameters() for statement {} did not bind all allocated parameters", m_stmt->GetIndex());
 #endif
 }
 
@@ -94,14 +155,14 @@ void MySQLPreparedStatement::ClearParameters()
     }
 }
 
-static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint8 index, uint32 paramCount)
+static bool ParamenterIndexAssertFail(uint32 stmtIndex, uint32 index, uint32 paramCount)
 {
     TC_LOG_ERROR("sql.driver", "Attempted to bind parameter {}{} on a PreparedStatement {} (statement has only {} parameters)", uint32(index) + 1, (index == 1 ? "st" : (index == 2 ? "nd" : (index == 3 ? "rd" : "nd"))), stmtIndex, paramCount);
     return false;
 }
 
 //- Bind on mysql level
-void MySQLPreparedStatement::AssertValidIndex(uint8 index)
+void MySQLPreparedStatement::AssertValidIndex(uint32 index)
 {
     ASSERT(index < m_paramCount || ParamenterIndexAssertFail(m_stmt->GetIndex(), index, m_paramCount));
 
@@ -109,7 +170,7 @@ void MySQLPreparedStatement::AssertValidIndex(uint8 index)
         TC_LOG_ERROR("sql.sql", "[ERROR] Prepared Statement (id: {}) trying to bind value on already bound index ({}).", m_stmt->GetIndex(), index);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::nullptr_t)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::nullptr_t)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -123,13 +184,13 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::nullptr_t)
     param->length = nullptr;
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, bool value)
+void MySQLPreparedStatement::SetParameter(uint32 index, bool value)
 {
     SetParameter(index, uint8(value ? 1 : 0));
 }
 
 template<typename T>
-void MySQLPreparedStatement::SetParameter(uint8 index, T value)
+void MySQLPreparedStatement::SetParameter(uint32 index, T value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -146,7 +207,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, T value)
     memcpy(param->buffer, &value, len);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, SystemTimePoint value)
+void MySQLPreparedStatement::SetParameter(uint32 index, SystemTimePoint value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -173,7 +234,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, SystemTimePoint value)
     time->second_part = hms.subseconds().count();
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::string const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -190,7 +251,7 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::string const& value)
     memcpy(param->buffer, value.c_str(), len);
 }
 
-void MySQLPreparedStatement::SetParameter(uint8 index, std::vector<uint8> const& value)
+void MySQLPreparedStatement::SetParameter(uint32 index, std::vector<uint8> const& value)
 {
     AssertValidIndex(index);
     m_paramsSet[index] = true;
@@ -207,22 +268,38 @@ void MySQLPreparedStatement::SetParameter(uint8 index, std::vector<uint8> const&
     memcpy(param->buffer, value.data(), len);
 }
 
+std::string MySQLPreparedStatement::GetMultiRowQueryString(uint32 rows) const
+{
+    std::string queryString(m_queryString.data(), m_rowValues.data() + m_rowValues.size());
+    queryString.reserve(queryString.size() + (m_rowValues.size() + 2) * (rows - 1));
+    for (uint32 i = 1; i < rows; ++i)
+    {
+        queryString += ", ";
+        queryString += m_rowValues;
+    }
+
+    return queryString;
+}
+
 std::string MySQLPreparedStatement::getQueryString() const
 {
     std::string queryString(m_queryString);
 
     size_t pos = 0;
-    for (PreparedStatementData const& data : m_stmt->GetParameters())
+    for (PreparedStatementBase const* row : m_rows)
     {
-        pos = queryString.find('?', pos);
-
-        std::string replaceStr = std::visit([&](auto&& data)
+        for (PreparedStatementData const& data : row->GetParameters())
         {
-            return PreparedStatementData::ToString(data);
-        }, data.data);
+            pos = queryString.find('?', pos);
+
+            std::string replaceStr = std::visit([&](auto&& data)
+            {
+                return PreparedStatementData::ToString(data);
+            }, data.data);
 
-        queryString.replace(pos, 1, replaceStr);
-        pos += replaceStr.length();
+            queryString.replace(pos, 1, replaceStr);
+            pos += replaceStr.length();
+        }
     }
 
     return queryString;
@@ -21,7 +21,9 @@
 #include "DatabaseEnvFwd.h"
 #include "Define.h"
 #include "Duration.h"
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 class MySQLConnection;
@@ -40,23 +42,30 @@ class TC_DATABASE_API MySQLPreparedStatement
         ~MySQLPreparedStatement();
 
         void BindParameters(PreparedStatementBase* stmt);
+        //! Binds the parameters of every row in order, for statements made by GetMultiRowQueryString
+        void BindParameters(std::span<PreparedStatementBase* const> rows);
 
         uint32 GetParameterCount() const { return m_paramCount; }
 
+        //! Plain INSERT/REPLACE ... VALUES (...) statements can insert several rows at once by repeating the value list
+        bool CanInsertMultipleRows() const { return !m_rowValues.empty(); }
+        std::string GetMultiRowQueryString(uint32 rows) const;
+
     protected:
-        void SetParameter(uint8 index, std::nullptr_t);
-        void SetParameter(uint8 index, bool value);
+        void SetParameter(uint32 index, std::nullptr_t);
+        void SetParameter(uint32 index, bool value);
         template<typename T>
-        void SetParameter(uint8 index, T value);
-        void SetParameter(uint8 index, SystemTimePoint value);
-        void SetParameter(uint8 index, std::string const& value);
-        void SetParameter(uint8 index, std::vector<uint8> const& value);
+        void SetParameter(uint32 index, T value);
+        void SetParameter(uint32 index, SystemTimePoint value);
+        void SetParameter(uint32 index, std::string const& value);
+        void SetParameter(uint32 index, std::vector<uint8> const& value);
 
         MySQLStmt* GetSTMT() { return m_Mstmt; }
         MySQLBind* GetBind() { return m_bind; }
         PreparedStatementBase* m_stmt;
+        std::span<PreparedStatementBase* const> m_rows;
         void ClearParameters();
-        void AssertValidIndex(uint8 index);
+        void AssertValidIndex(uint32 index);
         std::string getQueryString() const;
 
     private:
@@ -65,6 +74,7 @@ class TC_DATABASE_API MySQLPreparedStatement
         std::vector<bool> m_paramsSet;
         MySQLBind* m_bind;
         std::string const m_queryString;
+        std::string_view m_rowValues;  //!< "(?, ?, ...)" part of m_queryString when the statement can insert multiple rows
 
         MySQLPreparedStatement(MySQLPreparedStatement const& right) = delete;
         MySQLPreparedStatement& operator=(MySQLPreparedStatement const& right) = delete;
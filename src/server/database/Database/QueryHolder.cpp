@@ -75,7 +75,13 @@ void SQLQueryHolderBase::SetSize(size_t size)
 bool SQLQueryHolderTask::Execute(MySQLConnection* conn, SQLQueryHolderBase* holder)
 {
     /// execute all queries in the holder and pass the results
-    for (size_t i = 0; i < holder->m_queries.size(); ++i)
+    return Execute(conn, holder, 0, holder->m_queries.size());
+}
+
+bool SQLQueryHolderTask::Execute(MySQLConnection* conn, SQLQueryHolderBase* holder, size_t begin, size_t end)
+{
+    /// every part only writes the results of its own indexes
+    for (size_t i = begin; i < end && i < holder->m_queries.size(); ++i)
         if (PreparedStatementBase* stmt = holder->m_queries[i].first)
             holder->SetPreparedResult(i, conn->Query(stmt));
 
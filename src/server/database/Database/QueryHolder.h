@@ -34,6 +34,7 @@ class TC_DATABASE_API SQLQueryHolderBase
         SQLQueryHolderBase() = default;
         virtual ~SQLQueryHolderBase();
         void SetSize(size_t size);
+        size_t GetSize() const { return m_queries.size(); }
         PreparedQueryResult GetPreparedResult(size_t index) const;
         void SetPreparedResult(size_t index, PreparedResultSet* result);
 
@@ -55,6 +56,9 @@ class TC_DATABASE_API SQLQueryHolderTask
 {
 public:
     static bool Execute(MySQLConnection* conn, SQLQueryHolderBase* holder);
+
+    //! executes the statements with indexes in [begin, end), parts of one holder may run concurrently on different connections
+    static bool Execute(MySQLConnection* conn, SQLQueryHolderBase* holder, size_t begin, size_t end);
 };
 
 class TC_DATABASE_API SQLQueryHolderCallback
@@ -22,8 +22,11 @@
 #include "Log.h"
 #include "MySQLHacks.h"
 #include "MySQLWorkaround.h"
+#include <array>
 #include <chrono>
 #include <cstring>
+#include <iterator>
+#include <limits>
 
 namespace
 {
@@ -391,13 +394,31 @@ void InitializeDatabaseFieldMetadata(QueryResultFieldMetadata* meta, MySQLField
     meta->Type = MysqlTypeToFieldType(field->type, field->flags);
     meta->Converter = binaryProtocol ? BinaryValueConverters[AsUnderlyingType(meta->Type)].get() : FromStringValueConverters[AsUnderlyingType(meta->Type)].get();
 }
+
+// snapshot layout: header, per field its type and 5 null terminated metadata strings, per row and field
+// the value length followed by the value and a null terminator (no value for NULL fields)
+struct SnapshotHeader
+{
+    std::array<char, 4> Magic;
+    uint32 Version;
+    uint64 Key;
+    uint64 RowCount;
+    uint32 FieldCount;
+    uint32 Reserved;
+};
+
+constexpr std::array<char, 4> SnapshotMagic = { 'T', 'C', 'Q', 'R' };
+constexpr uint32 SnapshotVersion = 1;
+constexpr uint32 SnapshotNullLength = std::numeric_limits<uint32>::max();
+constexpr uint32 SnapshotMetadataStrings = 5;
 }
 
 ResultSet::ResultSet(MySQLResult* result, MySQLField* fields, uint64 rowCount, uint32 fieldCount) :
 _rowCount(rowCount),
 _fieldCount(fieldCount),
 _result(result),
-_fields(fields)
+_fields(fields),
+_snapshotOffset(0)
 {
     _fieldMetadata.resize(_fieldCount);
     _currentRow = new Field[_fieldCount];
@@ -408,6 +429,161 @@ _fields(fields)
     }
 }
 
+ResultSet::ResultSet(std::vector<char> snapshot) :
+_rowCount(0),
+_currentRow(nullptr),
+_fieldCount(0),
+_result(nullptr),
+_fields(nullptr),
+_snapshot(std::move(snapshot)),
+_snapshotOffset(sizeof(SnapshotHeader))
+{
+    // contents were validated by ReadSnapshot
+    SnapshotHeader header;
+    memcpy(&header, _snapshot.data(), sizeof(header));
+    _rowCount = header.RowCount;
+    _fieldCount = header.FieldCount;
+
+    auto readString = [&]()
+    {
+        char const* string = &_snapshot[_snapshotOffset];
+        _snapshotOffset += strlen(string) + 1;
+        return string;
+    };
+
+    _fieldMetadata.resize(_fieldCount);
+    _currentRow = new Field[_fieldCount];
+    for (uint32 i = 0; i < _fieldCount; ++i)
+    {
+        QueryResultFieldMetadata& meta = _fieldMetadata[i];
+        meta.Type = DatabaseFieldTypes(_snapshot[_snapshotOffset++]);
+        meta.TableName = readString();
+        meta.TableAlias = readString();
+        meta.Name = readString();
+        meta.Alias = readString();
+        meta.TypeName = readString();
+        meta.Index = i;
+        meta.Converter = FromStringValueConverters[AsUnderlyingType(meta.Type)].get();
+        _currentRow[i].SetMetadata(&meta);
+    }
+}
+
+std::vector<char> ResultSet::WriteSnapshot(ResultSet* result, uint64 key)
+{
+    std::vector<char> snapshot(sizeof(SnapshotHeader));
+    auto append = [&](void const* data, std::size_t size)
+    {
+        char const* bytes = static_cast<char const*>(data);
+        snapshot.insert(snapshot.end(), bytes, bytes + size);
+    };
+    auto appendString = [&](char const* string)
+    {
+        if (!string)
+            string = "";
+
+        append(string, strlen(string) + 1);
+    };
+
+    SnapshotHeader header = { };
+    header.Magic = SnapshotMagic;
+    header.Version = SnapshotVersion;
+    header.Key = key;
+    if (result)
+    {
+        header.FieldCount = result->_fieldCount;
+        for (QueryResultFieldMetadata const& meta : result->_fieldMetadata)
+        {
+            uint8 type = AsUnderlyingType(meta.Type);
+            append(&type, sizeof(type));
+            appendString(meta.TableName);
+            appendString(meta.TableAlias);
+            appendString(meta.Name);
+            appendString(meta.Alias);
+            appendString(meta.TypeName);
+        }
+
+        do
+        {
+            for (uint32 i = 0; i < result->_fieldCount; ++i)
+            {
+                Field const& field = result->_currentRow[i];
+                uint32 length = field.IsNull() ? SnapshotNullLength : field._length;
+                append(&length, sizeof(length));
+                if (!field.IsNull())
+                {
+                    append(field._value, field._length);
+                    snapshot.push_back('\0');
+                }
+            }
+
+            ++header.RowCount;
+        } while (result->NextRow());
+    }
+
+    memcpy(snapshot.data(), &header, sizeof(header));
+    return snapshot;
+}
+
+bool ResultSet::ReadSnapshot(std::vector<char> snapshot, uint64 key, QueryResult& result)
+{
+    if (snapshot.size() < sizeof(SnapshotHeader))
+        return false;
+
+    SnapshotHeader header;
+    memcpy(&header, snapshot.data(), sizeof(header));
+    if (header.Magic != SnapshotMagic || header.Version != SnapshotVersion || header.Key != key)
+        return false;
+
+    std::size_t offset = sizeof(SnapshotHeader);
+    for (uint32 i = 0; i < header.FieldCount; ++i)
+    {
+        if (offset >= snapshot.size() || uint8(snapshot[offset]) >= std::size(FromStringValueConverters))
+            return false;
+
+        ++offset;
+        for (uint32 j = 0; j < SnapshotMetadataStrings; ++j)
+        {
+            void const* end = memchr(snapshot.data() + offset, '\0', snapshot.size() - offset);
+            if (!end)
+                return false;
+
+            offset = static_cast<char const*>(end) - snapshot.data() + 1;
+        }
+    }
+
+    for (uint64 row = 0; row < header.RowCount; ++row)
+    {
+        for (uint32 i = 0; i < header.FieldCount; ++i)
+        {
+            uint32 length;
+            if (snapshot.size() - offset < sizeof(length))
+                return false;
+
+            memcpy(&length, snapshot.data() + offset, sizeof(length));
+            offset += sizeof(length);
+            if (length == SnapshotNullLength)
+                continue;
+
+            if (snapshot.size() - offset <= length)
+                return false;
+
+            offset += length + 1;
+        }
+    }
+
+    if (offset != snapshot.size())
+        return false;
+
+    result = nullptr;
+    if (!header.RowCount || !header.FieldCount)
+        return true;
+
+    ResultSet* resultSet = new ResultSet(std::move(snapshot));
+    resultSet->NextRow();
+    result.reset(resultSet);
+    return true;
+}
+
 PreparedResultSet::PreparedResultSet(MySQLStmt* stmt, MySQLResult* result, uint64 rowCount, uint32 fieldCount) :
 m_rowCount(rowCount),
 m_rowPosition(0),
@@ -554,6 +730,31 @@ bool ResultSet::NextRow()
 {
     MYSQL_ROW row;
 
+    if (!_snapshot.empty())
+    {
+        if (_snapshotOffset >= _snapshot.size())
+        {
+            CleanUp();
+            return false;
+        }
+
+        for (uint32 i = 0; i < _fieldCount; ++i)
+        {
+            uint32 length;
+            memcpy(&length, &_snapshot[_snapshotOffset], sizeof(length));
+            _snapshotOffset += sizeof(length);
+            if (length == SnapshotNullLength)
+                _currentRow[i].SetValue(nullptr, 0);
+            else
+            {
+                _currentRow[i].SetValue(&_snapshot[_snapshotOffset], length);
+                _snapshotOffset += length + 1;
+            }
+        }
+
+        return true;
+    }
+
     if (!_result)
         return false;
 
@@ -612,6 +813,8 @@ void ResultSet::CleanUp()
         mysql_free_result(_result);
         _result = nullptr;
     }
+
+    std::vector<char>().swap(_snapshot);
 }
 
 void PreparedResultSet::CleanUp()
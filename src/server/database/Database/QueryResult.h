@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "DatabaseEnvFwd.h"
+#include "QueryResultRow.h"
 #include <vector>
 
 class TC_DATABASE_API ResultSet
@@ -35,6 +36,21 @@ class TC_DATABASE_API ResultSet
         Field* Fetch() const { return _currentRow; }
         Field const& operator[](std::size_t index) const;
 
+        //! Decodes the leading columns of the current row, auto [id, name] = result->ReadRow<uint32, std::string_view>();
+        template<typename... Ts>
+        std::tuple<Ts...> ReadRow() const
+        {
+            return QueryResultRowReader::Read<Ts...>(_currentRow, _fieldCount, false, _rowReaderCache);
+        }
+
+        //! Serializes the current and all remaining rows of result (which may be null for empty results) into one buffer
+        //! the result is consumed, key identifies the database state the rows were read from
+        static std::vector<char> WriteSnapshot(ResultSet* result, uint64 key);
+
+        //! Turns a buffer created by WriteSnapshot back into a result positioned on its first row, result is null for snapshots without rows
+        //! returns false when the buffer is malformed or was written for another key
+        static bool ReadSnapshot(std::vector<char> snapshot, uint64 key, QueryResult& result);
+
     protected:
         std::vector<QueryResultFieldMetadata> _fieldMetadata;
         uint64 _rowCount;
@@ -42,10 +58,16 @@ class TC_DATABASE_API ResultSet
         uint32 _fieldCount;
 
     private:
+        explicit ResultSet(std::vector<char> snapshot);
+
         void CleanUp();
         MySQLResult* _result;
         MySQLField* _fields;
 
+        std::vector<char> _snapshot;        //!< header, metadata and rows of a result read from a snapshot
+        std::size_t _snapshotOffset;        //!< start of the next row in _snapshot
+        mutable QueryResultRowReader::ColumnCache _rowReaderCache;
+
         ResultSet(ResultSet const& right) = delete;
         ResultSet& operator=(ResultSet const& right) = delete;
 };
@@ -63,6 +85,13 @@ class TC_DATABASE_API PreparedResultSet
         Field* Fetch() const;
         Field const& operator[](std::size_t index) const;
 
+        //! Decodes the leading columns of the current row, auto [id, name] = result->ReadRow<uint32, std::string_view>();
+        template<typename... Ts>
+        std::tuple<Ts...> ReadRow() const
+        {
+            return QueryResultRowReader::Read<Ts...>(Fetch(), m_fieldCount, true, m_rowReaderCache);
+        }
+
     protected:
         std::vector<QueryResultFieldMetadata> m_fieldMetadata;
         std::vector<Field> m_rows;
@@ -74,6 +103,7 @@ class TC_DATABASE_API PreparedResultSet
         MySQLBind* m_rBind;
         MySQLStmt* m_stmt;
         MySQLResult* m_metadataResult;    ///< Field metadata, returned by mysql_stmt_result_metadata
+        mutable QueryResultRowReader::ColumnCache m_rowReaderCache;
 
         void CleanUp();
         bool _NextRow();
@@ -0,0 +1,176 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_DATABASE_QUERY_RESULT_ROW_H
+#define TRINITY_DATABASE_QUERY_RESULT_ROW_H
+
+#include "Errors.h"
+#include "Field.h"
+#include "Optional.h"
+#include "StringConvert.h"
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace Trinity::Impl
+{
+// maps a C++ type requested from ReadRow to the column type it can be decoded from without conversion
+// and to the Field accessor used for every other column type
+template<typename T, DatabaseFieldTypes ColumnType, T(Field::*Getter)() const>
+struct NumericRowValue
+{
+    static constexpr DatabaseFieldTypes Type = ColumnType;
+
+    static T Decode(char const* value, uint32 length, bool binaryProtocol)
+    {
+        if (binaryProtocol)
+        {
+            T result;
+            memcpy(&result, value, sizeof(T));
+            return result;
+        }
+
+        return Trinity::StringTo<T>({ value, length }).value_or(T(0));
+    }
+
+    static T Get(Field const& field) { return (field.*Getter)(); }
+};
+
+template<typename T>
+struct RowValue;
+
+template<> struct RowValue<uint8> : NumericRowValue<uint8, DatabaseFieldTypes::UInt8, &Field::GetUInt8> { };
+template<> struct RowValue<int8> : NumericRowValue<int8, DatabaseFieldTypes::Int8, &Field::GetInt8> { };
+template<> struct RowValue<uint16> : NumericRowValue<uint16, DatabaseFieldTypes::UInt16, &Field::GetUInt16> { };
+template<> struct RowValue<int16> : NumericRowValue<int16, DatabaseFieldTypes::Int16, &Field::GetInt16> { };
+template<> struct RowValue<uint32> : NumericRowValue<uint32, DatabaseFieldTypes::UInt32, &Field::GetUInt32> { };
+template<> struct RowValue<int32> : NumericRowValue<int32, DatabaseFieldTypes::Int32, &Field::GetInt32> { };
+template<> struct RowValue<uint64> : NumericRowValue<uint64, DatabaseFieldTypes::UInt64, &Field::GetUInt64> { };
+template<> struct RowValue<int64> : NumericRowValue<int64, DatabaseFieldTypes::Int64, &Field::GetInt64> { };
+template<> struct RowValue<float> : NumericRowValue<float, DatabaseFieldTypes::Float, &Field::GetFloat> { };
+template<> struct RowValue<double> : NumericRowValue<double, DatabaseFieldTypes::Double, &Field::GetDouble> { };
+
+template<>
+struct RowValue<bool>
+{
+    static constexpr DatabaseFieldTypes Type = DatabaseFieldTypes::UInt8;
+    static bool Decode(char const* value, uint32 length, bool binaryProtocol) { return RowValue<uint8>::Decode(value, length, binaryProtocol) == 1; }
+    static bool Get(Field const& field) { return field.GetBool(); }
+};
+
+template<>
+struct RowValue<std::string_view>
+{
+    static constexpr DatabaseFieldTypes Type = DatabaseFieldTypes::Binary;
+    static std::string_view Decode(char const* value, uint32 length, bool /*binaryProtocol*/) { return { value, length }; }
+    static std::string_view Get(Field const& field) { return field.GetStringView(); }
+};
+
+template<>
+struct RowValue<std::string>
+{
+    static constexpr DatabaseFieldTypes Type = DatabaseFieldTypes::Binary;
+    static std::string Decode(char const* value, uint32 length, bool /*binaryProtocol*/) { return { value, length }; }
+    static std::string Get(Field const& field) { return field.GetString(); }
+};
+
+// NULL columns are returned as an empty optional instead of a default constructed value
+template<typename T>
+struct RowValue<Optional<T>>
+{
+    static constexpr DatabaseFieldTypes Type = RowValue<T>::Type;
+    static Optional<T> Decode(char const* value, uint32 length, bool binaryProtocol) { return RowValue<T>::Decode(value, length, binaryProtocol); }
+    static Optional<T> Get(Field const& field) { return RowValue<T>::Get(field); }
+};
+
+template<typename T>
+struct IsOptionalRowValue : std::false_type { };
+
+template<typename T>
+struct IsOptionalRowValue<Optional<T>> : std::true_type { };
+}
+
+/**
+    @class QueryResultRowReader
+
+    @brief Decodes a whole row into a tuple of the requested types
+
+    Columns whose type matches the requested type exactly are decoded straight from the row buffer,
+    other columns fall back to the Field accessors and keep their conversion and truncation checks.
+    The column types are compared once per result and requested type list, not for every row.
+*/
+class QueryResultRowReader
+{
+public:
+    struct ColumnCache
+    {
+        void const* Signature = nullptr;    //!< identifies the type list ExactColumns was computed for
+        uint64 ExactColumns = 0;            //!< bit per column that can be decoded without conversion
+    };
+
+    template<typename... Ts>
+    static std::tuple<Ts...> Read(Field const* row, uint32 fieldCount, bool binaryProtocol, ColumnCache& cache)
+    {
+        static_assert(sizeof...(Ts) <= 64, "ReadRow supports at most 64 columns");
+        ASSERT(sizeof...(Ts) <= fieldCount, "ReadRow requested %zu columns from a result with %u columns", sizeof...(Ts), fieldCount);
+
+        if (cache.Signature != &Signature<Ts...>)
+        {
+            cache.Signature = &Signature<Ts...>;
+            cache.ExactColumns = GetExactColumns<Ts...>(row, std::index_sequence_for<Ts...>());
+        }
+
+        return ReadColumns<Ts...>(row, binaryProtocol, cache.ExactColumns, std::index_sequence_for<Ts...>());
+    }
+
+private:
+    template<typename... Ts>
+    static constexpr char Signature = 0;
+
+    template<typename... Ts, std::size_t... Indexes>
+    static uint64 GetExactColumns(Field const* row, std::index_sequence<Indexes...>)
+    {
+        return ((uint64(row[Indexes]._meta->Type == Trinity::Impl::RowValue<Ts>::Type) << Indexes) | ... | uint64(0));
+    }
+
+    template<typename... Ts, std::size_t... Indexes>
+    static std::tuple<Ts...> ReadColumns(Field const* row, bool binaryProtocol, uint64 exactColumns, std::index_sequence<Indexes...>)
+    {
+        return std::tuple<Ts...>(ReadColumn<Ts>(row[Indexes], binaryProtocol, (exactColumns >> Indexes) & 1)...);
+    }
+
+    template<typename T>
+    static T ReadColumn(Field const& field, bool binaryProtocol, bool exact)
+    {
+        if (!field._value)
+        {
+            if constexpr (Trinity::Impl::IsOptionalRowValue<T>::value)
+                return {};
+            else
+                return Trinity::Impl::RowValue<T>::Get(field);
+        }
+
+        if (exact)
+            return Trinity::Impl::RowValue<T>::Decode(field._value, field._length, binaryProtocol);
+
+        return Trinity::Impl::RowValue<T>::Get(field);
+    }
+};
+
+#endif // TRINITY_DATABASE_QUERY_RESULT_ROW_H
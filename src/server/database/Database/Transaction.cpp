@@ -17,12 +17,14 @@
 
 #include "Transaction.h"
 #include "Errors.h"
+#include "Hash.h"
 #include "Log.h"
 #include "MySQLConnection.h"
 #include "PreparedStatement.h"
 #include "Timer.h"
 #include <mysqld_error.h>
 #include <sstream>
+#include <string_view>
 #include <thread>
 #include <cstring>
 
@@ -44,6 +46,51 @@ void TransactionBase::AppendPreparedStatement(PreparedStatementBase* stmt)
     m_queries.emplace_back(std::in_place_type<std::unique_ptr<PreparedStatementBase>>, stmt);
 }
 
+namespace
+{
+struct ParameterHasher
+{
+    std::size_t& Hash;
+
+    void operator()(std::vector<uint8> const& value) const { Trinity::hash_combine(Hash, std::string_view(reinterpret_cast<char const*>(value.data()), value.size())); }
+    void operator()(SystemTimePoint value) const { Trinity::hash_combine(Hash, value.time_since_epoch().count()); }
+    void operator()(std::nullptr_t) const { Trinity::hash_combine(Hash, 0); }
+    template<typename T>
+    void operator()(T const& value) const { Trinity::hash_combine(Hash, value); }
+};
+}
+
+std::size_t TransactionBase::GetQueriesHash(std::size_t first) const
+{
+    std::size_t hash = 0;
+    ParameterHasher hasher{ hash };
+    for (std::size_t i = first; i < m_queries.size(); ++i)
+    {
+        if (std::string const* sql = std::get_if<std::string>(&m_queries[i].query))
+        {
+            Trinity::hash_combine(hash, *sql);
+            continue;
+        }
+
+        PreparedStatementBase const* stmt = std::get<std::unique_ptr<PreparedStatementBase>>(m_queries[i].query).get();
+        Trinity::hash_combine(hash, stmt->GetIndex());
+        for (PreparedStatementData const& parameter : stmt->GetParameters())
+        {
+            // parameters of different types but equal values must not hash the same
+            Trinity::hash_combine(hash, parameter.data.index());
+            std::visit(hasher, parameter.data);
+        }
+    }
+
+    return hash;
+}
+
+void TransactionBase::Truncate(std::size_t size)
+{
+    if (size < m_queries.size())
+        m_queries.erase(m_queries.begin() + size, m_queries.end());
+}
+
 void TransactionBase::Cleanup()
 {
     // This might be called by explicit calls to Cleanup or by the auto-destructor
@@ -66,6 +66,12 @@ class TC_DATABASE_API TransactionBase
 
         std::size_t GetSize() const { return m_queries.size(); }
 
+        //! Hash of the queries and parameters appended at or after position first, to detect saves that did not change anything
+        std::size_t GetQueriesHash(std::size_t first) const;
+
+        //! Drops every query appended at or after position size
+        void Truncate(std::size_t size);
+
     protected:
         void AppendPreparedStatement(PreparedStatementBase* statement);
         void Cleanup();
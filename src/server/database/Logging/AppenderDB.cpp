@@ -18,12 +18,53 @@
 #include "AppenderDB.h"
 #include "DatabaseEnv.h"
 #include "LogMessage.h"
-#include "PreparedStatement.h"
+#include "StringConvert.h"
+#include "StringFormat.h"
+#include <chrono>
 
-AppenderDB::AppenderDB(uint8 id, std::string const& name, LogLevel level, AppenderFlags /*flags*/, std::vector<std::string_view> const& /*args*/)
-    : Appender(id, name, level), realmId(0), enabled(false) { }
+namespace
+{
+uint32 ReadArg(std::vector<std::string_view> const& args, std::size_t index, uint32 defaultValue, std::string const& name)
+{
+    if (args.size() <= index || args[index].empty())
+        return defaultValue;
 
-AppenderDB::~AppenderDB() { }
+    if (Optional<uint32> value = Trinity::StringTo<uint32>(args[index]))
+        return *value;
+
+    throw InvalidAppenderArgsException(Trinity::StringFormat("Log::CreateAppenderFromConfig: Invalid value '{}' for appender {}", args[index], name));
+}
+
+void AppendValue(std::string& sql, std::string value)
+{
+    LoginDatabase.EscapeString(value);
+    sql += '\'';
+    sql += value;
+    sql += '\'';
+}
+}
+
+AppenderDB::AppenderDB(uint8 id, std::string const& name, LogLevel level, AppenderFlags /*flags*/, std::vector<std::string_view> const& args)
+    : Appender(id, name, level), realmId(0), enabled(false),
+    _batchSize(std::max(ReadArg(args, 3, 100, name), 1u)), _flushInterval(ReadArg(args, 4, 1000, name)), _dropQueueSize(ReadArg(args, 5, 10000, name)),
+    _droppedMessages(0), _stopping(false)
+{
+    // without a timer every message is written right away
+    if (!_flushInterval)
+        _batchSize = 1;
+}
+
+AppenderDB::~AppenderDB()
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _stopping = true;
+    }
+
+    _wakeUp.notify_all();
+    if (_flushThread.joinable())
+        _flushThread.join();
+}
 
 void AppenderDB::_write(LogMessage const* message)
 {
@@ -31,17 +72,72 @@ void AppenderDB::_write(LogMessage const* message)
     if (!enabled || (message->type.find("sql") != std::string::npos))
         return;
 
-    LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_LOG);
-    stmt->setUInt64(0, message->mtime);
-    stmt->setUInt32(1, realmId);
-    stmt->setString(2, message->type);
-    stmt->setUInt8(3, uint8(message->level));
-    stmt->setString(4, message->text);
-    LoginDatabase.Execute(stmt);
+    std::unique_lock<std::mutex> lock(_lock);
+
+    // under backpressure keep warnings and errors, the dropped count is logged with the next batch
+    if (_dropQueueSize && message->level < LOG_LEVEL_WARN && LoginDatabase.QueueSize() > _dropQueueSize)
+    {
+        ++_droppedMessages;
+        return;
+    }
+
+    _pending.push_back({ message->mtime, message->type, message->level, message->text });
+    if (_pending.size() >= _batchSize)
+        FlushPending(lock);
+}
+
+void AppenderDB::flush()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    FlushPending(lock);
+}
+
+void AppenderDB::FlushPending(std::unique_lock<std::mutex>& /*lock*/)
+{
+    if (_droppedMessages)
+    {
+        _pending.push_back({ time(nullptr), "server.logging", LOG_LEVEL_WARN,
+            Trinity::StringFormat("AppenderDB dropped {} messages below warning level while the login database was busy", _droppedMessages) });
+        _droppedMessages = 0;
+    }
+
+    if (_pending.empty())
+        return;
+
+    std::string sql = "INSERT INTO logs (time, realm, type, level, string) VALUES ";
+    for (std::size_t i = 0; i < _pending.size(); ++i)
+    {
+        PendingMessage& message = _pending[i];
+        if (i)
+            sql += ',';
+
+        sql += Trinity::StringFormat("({}, {}, ", uint64(message.Time), realmId);
+        AppendValue(sql, std::move(message.Type));
+        sql += Trinity::StringFormat(", {}, ", uint32(message.Level));
+        AppendValue(sql, std::move(message.Text));
+        sql += ')';
+    }
+
+    _pending.clear();
+    LoginDatabase.Execute(sql.c_str(), DatabaseTaskPriority::Background);
+}
+
+void AppenderDB::RunFlushTimer()
+{
+    std::unique_lock<std::mutex> lock(_lock);
+    while (!_stopping)
+    {
+        _wakeUp.wait_for(lock, std::chrono::milliseconds(_flushInterval));
+        if (!_stopping)
+            FlushPending(lock);
+    }
 }
 
 void AppenderDB::setRealmId(uint32 _realmId)
 {
     enabled = true;
     realmId = _realmId;
+
+    if (_flushInterval && !_flushThread.joinable())
+        _flushThread = std::thread(&AppenderDB::RunFlushTimer, this);
 }
@@ -19,7 +19,17 @@
 #define APPENDERDB_H
 
 #include "Appender.h"
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <thread>
 
+/*
+    Messages are buffered and written as one multi row insert once BatchSize messages are pending
+    or FlushInterval passed, whichever comes first.
+    Optional appender arguments: BatchSize (default 100), FlushInterval in milliseconds (default 1000, 0 writes every message right away)
+    and the login database queue size above which messages below LOG_LEVEL_WARN are dropped (default 10000, 0 never drops)
+*/
 class TC_DATABASE_API AppenderDB: public Appender
 {
     public:
@@ -30,11 +40,33 @@ class TC_DATABASE_API AppenderDB: public Appender
 
         void setRealmId(uint32 realmId) override;
         AppenderType getType() const override { return type; }
+        void flush() override;
 
     private:
+        struct PendingMessage
+        {
+            time_t Time;
+            std::string Type;
+            LogLevel Level;
+            std::string Text;
+        };
+
         uint32 realmId;
         bool enabled;
         void _write(LogMessage const* message) override;
+        void FlushPending(std::unique_lock<std::mutex>& lock);
+        void RunFlushTimer();
+
+        uint32 _batchSize;
+        uint32 _flushInterval;
+        uint32 _dropQueueSize;
+
+        std::mutex _lock;
+        std::condition_variable _wakeUp;
+        std::vector<PendingMessage> _pending;
+        uint32 _droppedMessages;
+        bool _stopping;
+        std::thread _flushThread;
 };
 
 #endif
@@ -261,7 +261,8 @@ bool DBUpdater<T>::Update(DatabaseWorkerPool<T>& pool)
             sConfigMgr->GetBoolDefault("Updates.Redundancy", true),
             sConfigMgr->GetBoolDefault("Updates.AllowRehash", true),
             sConfigMgr->GetBoolDefault("Updates.ArchivedRedundancy", false),
-            sConfigMgr->GetIntDefault("Updates.CleanDeadRefMaxCount", 3));
+            sConfigMgr->GetIntDefault("Updates.CleanDeadRefMaxCount", 3),
+            sConfigMgr->GetStringDefault("Updates.HashCache", "sql_updates_hash_cache.txt"));
     }
     catch (UpdateException&)
     {
@@ -24,7 +24,9 @@
 #include "Util.h"
 #include <boost/filesystem/directory.hpp>
 #include <boost/filesystem/operations.hpp>
+#include <ctime>
 #include <fstream>
+#include <mutex>
 #include <sstream>
 
 using namespace boost::filesystem;
@@ -37,6 +39,121 @@ struct UpdateFetcher::DirectoryEntry
     State const state;
 };
 
+namespace
+{
+// Remembers the SHA1 of update files keyed by path, size and modification time so unchanged files
+// are not read and hashed again on every startup. Shared by all databases updated by this process.
+class UpdateHashCache
+{
+public:
+    static UpdateHashCache& Instance()
+    {
+        static UpdateHashCache instance;
+        return instance;
+    }
+
+    template<typename Hasher>
+    std::string GetHash(std::string const& fileName, path const& file, Hasher&& hasher)
+    {
+        if (fileName.empty())
+            return hasher();
+
+        boost::system::error_code error;
+        uintmax_t const size = file_size(file, error);
+        std::time_t const writeTime = error ? 0 : last_write_time(file, error);
+        if (error)
+            return hasher();
+
+        std::string const key = file.generic_string();
+        {
+            std::lock_guard<std::mutex> guard(_lock);
+            LoadIfNeeded(fileName);
+            auto itr = _entries.find(key);
+            if (itr != _entries.end() && itr->second.Size == size && itr->second.WriteTime == writeTime)
+            {
+                itr->second.Used = true;
+                return itr->second.Hash;
+            }
+        }
+
+        std::string hash = hasher();
+
+        // a file modified within the timestamp resolution could still change without its modification time moving
+        if (std::time(nullptr) - writeTime < 2)
+            return hash;
+
+        std::lock_guard<std::mutex> guard(_lock);
+        _entries[key] = { size, writeTime, hash, true };
+        _dirty = true;
+        return hash;
+    }
+
+    void Save(std::string const& fileName)
+    {
+        if (fileName.empty())
+            return;
+
+        std::lock_guard<std::mutex> guard(_lock);
+        if (!_dirty)
+            return;
+
+        path const target(fileName);
+        path const temp(fileName + ".tmp");
+        {
+            std::ofstream out(temp.c_str(), std::ios::out | std::ios::trunc);
+            if (!out.is_open())
+            {
+                TC_LOG_WARN("sql.updates", "Failed to write the update hash cache \"{}\".", fileName);
+                return;
+            }
+
+            // entries of other databases are kept as long as their file still exists
+            for (auto const& [key, entry] : _entries)
+                if (entry.Used || exists(path(key)))
+                    out << entry.Size << ' ' << entry.WriteTime << ' ' << entry.Hash << ' ' << key << '\n';
+        }
+
+        boost::system::error_code error;
+        rename(temp, target, error);
+        if (error)
+            TC_LOG_WARN("sql.updates", "Failed to replace the update hash cache \"{}\": {}", fileName, error.message());
+        else
+            _dirty = false;
+    }
+
+private:
+    struct Entry
+    {
+        uintmax_t Size = 0;
+        std::time_t WriteTime = 0;
+        std::string Hash;
+        bool Used = false;
+    };
+
+    void LoadIfNeeded(std::string const& fileName)
+    {
+        if (_loaded)
+            return;
+
+        _loaded = true;
+
+        std::ifstream in(fileName);
+        if (!in.is_open())
+            return;
+
+        Entry entry;
+        std::string key;
+        while (in >> entry.Size >> entry.WriteTime >> entry.Hash && std::getline(in >> std::ws, key))
+            _entries[key] = entry;
+    }
+
+    std::mutex _lock;
+    std::unordered_map<std::string, Entry> _entries;
+    bool _loaded = false;
+    bool _dirty = false;
+};
+}
+
 UpdateFetcher::UpdateFetcher(Path const& sourceDirectory,
     std::function<void(std::string const&)> const& apply,
     std::function<void(Path const& path)> const& applyFile,
@@ -175,7 +292,8 @@ std::string UpdateFetcher::ReadSQLUpdate(boost::filesystem::path const& file) co
 UpdateResult UpdateFetcher::Update(bool const redundancyChecks,
                                    bool const allowRehash,
                                    bool const archivedRedundancy,
-                                   int32 const cleanDeadReferencesMaxCount) const
+                                   int32 const cleanDeadReferencesMaxCount,
+                                   std::string const& hashCacheFile) const
 {
     LocaleFileStorage const available = GetFileList();
     AppliedFileStorage applied = ReceiveAppliedFiles();
@@ -221,8 +339,11 @@ UpdateResult UpdateFetcher::Update(bool const redundancyChecks,
             }
         }
 
-        // Calculate a Sha1 hash based on query content.
-        std::string const hash = ByteArrayToHexStr(Trinity::Crypto::SHA1::GetDigestOf(ReadSQLUpdate(availableQuery.first)));
+        // Calculate a Sha1 hash based on query content, unchanged files reuse the hash of the previous run.
+        std::string const hash = UpdateHashCache::Instance().GetHash(hashCacheFile, availableQuery.first, [&]
+        {
+            return ByteArrayToHexStr(Trinity::Crypto::SHA1::GetDigestOf(ReadSQLUpdate(availableQuery.first)));
+        });
 
         UpdateMode mode = MODE_APPLY;
 
@@ -342,6 +463,8 @@ UpdateResult UpdateFetcher::Update(bool const redundancyChecks,
         }
     }
 
+    UpdateHashCache::Instance().Save(hashCacheFile);
+
     return UpdateResult(importedUpdates, countRecentUpdates, countArchivedUpdates);
 }
 
@@ -178,6 +178,10 @@ class TC_GAME_API CreatureAI : public UnitAI
         // Called at World update tick
         //virtual void UpdateAI(const uint32 /*diff*/) { }
 
+        // Time (in milliseconds) UpdateAI may be postponed while out of combat, the skipped time is passed on as one larger diff
+        // Limited by Creature.IdleAIUpdateInterval, 0 updates on every tick. Override when UpdateAI only runs timers out of combat
+        virtual uint32 GetIdleUpdateDelay() const { return 0; }
+
         /// == State checks =================================
 
         // Is unit visible for MoveInLineOfSight
@@ -293,6 +293,15 @@ void SmartAI::UpdateAI(uint32 diff)
     UpdateDespawn(diff);
 }
 
+uint32 SmartAI::GetIdleUpdateDelay() const
+{
+    // escorts, follows, delayed despawns and vehicle passenger checks run on UpdateAI timers
+    if (HasEscortState(SMART_ESCORT_ESCORTING) || !_followGUID.IsEmpty() || (_despawnState > 1 && _despawnState <= 3) || _vehicleConditions)
+        return 0;
+
+    return _script.GetIdleUpdateDelay();
+}
+
 bool SmartAI::IsEscortInvokerInRange()
 {
     if (ObjectVector const* targets = GetScript()->GetStoredTargetVector(SMART_ESCORT_TARGETS, *me))
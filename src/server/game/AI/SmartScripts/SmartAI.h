@@ -139,6 +139,7 @@ class TC_GAME_API SmartAI : public CreatureAI
 
         // Called at World update tick
         void UpdateAI(uint32 diff) override;
+        uint32 GetIdleUpdateDelay() const override;
 
         // Called at text emote receive from player
         void ReceiveEmote(Player* player, uint32 textEmote) override;
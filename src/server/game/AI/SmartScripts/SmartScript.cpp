@@ -43,6 +43,7 @@
 #include "SmartAI.h"
 #include "SpellAuras.h"
 #include "TemporarySummon.h"
+#include "ThreadLocalPool.h"
 #include "Vehicle.h"
 #include "WaypointDefines.h"
 #include "WaypointManager.h"
@@ -248,17 +249,14 @@ void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint3
     {
         TC_LOG_WARN("scripts.ai", "SmartScript::ProcessEventsFor: reached the limit of max allowed nested ProcessEventsFor() calls with event {}, skipping!\n{}", e, GetBaseObject()->GetDebugInfo());
     }
-    else
+    else if (e < SMART_EVENT_END && mHandledEvents.test(e))
     {
-        for (SmartScriptHolder& event : mEvents)
+        auto itr = std::ranges::lower_bound(mEventIndex, std::make_pair(uint32(e), uint32(0)));
+        for (; itr != mEventIndex.end() && itr->first == uint32(e); ++itr)
         {
-            SMART_EVENT eventType = SMART_EVENT(event.GetEventType());
-            if (eventType == SMART_EVENT_LINK)//special handling
-                continue;
-
-            if (eventType == e)
-                if (sConditionMgr->IsObjectMeetingSmartEventConditions(event.entryOrGuid, event.event_id, event.source_type, unit, GetBaseObject()))
-                    ProcessEvent(event, unit, var0, var1, bvar, spell, gob, varString);
+            SmartScriptHolder& event = mEvents[itr->second];
+            if (sConditionMgr->IsObjectMeetingSmartEventConditions(event.entryOrGuid, event.event_id, event.source_type, unit, GetBaseObject()))
+                ProcessEvent(event, unit, var0, var1, bvar, spell, gob, varString);
         }
     }
 
@@ -279,6 +277,18 @@ static std::shared_ptr<ConcreteActionImpl> CreateTimedActionListWaitEventFor(Sma
     return std::make_shared<ConcreteActionImpl>(std::forward<Args>(args)...);
 }
 
+// target list storage for every executed action, reused per thread
+struct PooledObjectVector
+{
+    PooledObjectVector() : Objects(Trinity::ThreadLocalVectorPool<WorldObject*>::Acquire()) { }
+    ~PooledObjectVector() { Trinity::ThreadLocalVectorPool<WorldObject*>::Release(std::move(Objects)); }
+
+    PooledObjectVector(PooledObjectVector const&) = delete;
+    PooledObjectVector& operator=(PooledObjectVector const&) = delete;
+
+    ObjectVector Objects;
+};
+
 template <typename InnerResult>
 struct MultiActionResult : Scripting::v2::ActionResult<void>
 {
@@ -313,7 +323,8 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
     if (Unit* tempInvoker = GetLastInvoker())
         TC_LOG_DEBUG("scripts.ai", "SmartScript::ProcessAction: Invoker: {} {}", tempInvoker->GetName(), tempInvoker->GetGUID().ToString());
 
-    ObjectVector targets;
+    PooledObjectVector pooledTargets;
+    ObjectVector& targets = pooledTargets.Objects;
     GetTargets(targets, e, Coalesce<WorldObject>(unit, gob));
 
     switch (e.GetActionType())
@@ -2644,9 +2655,8 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 
     if (e.link && e.link != e.event_id)
     {
-        SmartScriptHolder& linked = SmartAIMgr::FindLinkedEvent(mEvents, e.link);
-        if (linked)
-            ProcessEvent(linked, unit, var0, var1, bvar, spell, gob, varString);
+        if (SmartScriptHolder* linked = FindLinkedEvent(e.link))
+            ProcessEvent(*linked, unit, var0, var1, bvar, spell, gob, varString);
         else
             TC_LOG_DEBUG("sql.sql", "SmartScript::ProcessAction: Entry {} SourceType {}, Event {}, Link Event {} not found or invalid, skipped.", e.entryOrGuid, e.GetScriptType(), e.event_id, e.link);
     }
@@ -3606,7 +3616,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             }
             else if (e.event.distance.entry != 0)
             {
-                std::list<Creature*> list;
+                Trinity::GridSearchResult<Creature*> list;
                 me->GetCreatureListWithEntryInGrid(list, e.event.distance.entry, static_cast<float>(e.event.distance.dist));
 
                 if (!list.empty())
@@ -3636,7 +3646,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
             }
             else if (e.event.distance.entry != 0)
             {
-                std::list<GameObject*> list;
+                Trinity::GridSearchResult<GameObject*> list;
                 me->GetGameObjectListWithEntryInGrid(list, e.event.distance.entry, static_cast<float>(e.event.distance.dist));
 
                 if (!list.empty())
@@ -3801,6 +3811,49 @@ void SmartScript::UpdateTimer(SmartScriptHolder& e, uint32 const diff)
         e.timer -= diff;
 }
 
+uint32 SmartScript::GetIdleUpdateDelay() const
+{
+    if (!mInstallEvents.empty() || mEventSortingRequired || !mTimedActionList.empty())
+        return 0;
+
+    uint32 delay = std::numeric_limits<uint32>::max();
+    auto checkTimer = [&](SmartScriptHolder const& e)
+    {
+        switch (e.GetEventType())
+        {
+            case SMART_EVENT_UPDATE:
+            case SMART_EVENT_UPDATE_OOC:
+            case SMART_EVENT_FRIENDLY_MISSING_BUFF:
+            case SMART_EVENT_HAS_AURA:
+            case SMART_EVENT_DISTANCE_CREATURE:
+            case SMART_EVENT_DISTANCE_GAMEOBJECT:
+                break;
+            case SMART_EVENT_TARGET_BUFFED:
+                if (me && me->GetVictim())
+                    break;
+                return;
+            default: // not timed or only processed while engaged
+                return;
+        }
+
+        if (e.event.event_phase_mask && !IsInPhase(e.event.event_phase_mask))
+            return;
+
+        if ((e.event.event_flags & SMART_EVENT_FLAG_NOT_REPEATABLE) && e.runOnce)
+            return;
+
+        delay = std::min(delay, e.timer);
+    };
+
+    for (SmartScriptHolder const& e : mEvents)
+        checkTimer(e);
+
+    for (SmartScriptHolder const& e : mStoredEvents)
+        checkTimer(e);
+
+    return delay;
+}
+
 bool SmartScript::CheckTimer(SmartScriptHolder const& e) const
 {
     return e.active;
@@ -3814,9 +3867,40 @@ void SmartScript::InstallEvents()
             mEvents.push_back(installevent);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        RebuildEventIndex();
     }
 }
 
+void SmartScript::RebuildEventIndex()
+{
+    mEventIndex.clear();
+    mHandledEvents.reset();
+    mEventIndex.reserve(mEvents.size());
+    for (uint32 i = 0; i < mEvents.size(); ++i)
+    {
+        uint32 eventType = mEvents[i].GetEventType();
+        if (eventType >= SMART_EVENT_END)
+            continue;
+
+        // linked events are indexed for FindLinkedEvent but never dispatched by ProcessEventsFor
+        mEventIndex.emplace_back(eventType, i);
+        if (eventType != SMART_EVENT_LINK)
+            mHandledEvents.set(eventType);
+    }
+
+    std::ranges::sort(mEventIndex);
+}
+
+SmartScriptHolder* SmartScript::FindLinkedEvent(uint32 link)
+{
+    auto itr = std::ranges::lower_bound(mEventIndex, std::make_pair(uint32(SMART_EVENT_LINK), uint32(0)));
+    for (; itr != mEventIndex.end() && itr->first == SMART_EVENT_LINK; ++itr)
+        if (mEvents[itr->second].event_id == link)
+            return &mEvents[itr->second];
+
+    return nullptr;
+}
+
 void SmartScript::RemoveStoredEvent(uint32 id)
 {
     if (!mStoredEvents.empty())
@@ -3917,6 +4001,7 @@ void SmartScript::OnUpdate(uint32 const diff)
     if (mEventSortingRequired)
     {
         SortEvents(mEvents);
+        RebuildEventIndex();
         mEventSortingRequired = false;
     }
 
@@ -4046,6 +4131,8 @@ void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTriggerEn
         mAllEventFlags |= scriptholder.event.event_flags;
         mEvents.push_back(scriptholder);
     }
+
+    RebuildEventIndex();
 }
 
 void SmartScript::GetScript()
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "SmartScriptMgr.h"
+#include <bitset>
 #include <memory>
 
 class AreaTrigger;
@@ -70,6 +71,8 @@ class TC_GAME_API SmartScript
         static bool IsGameObject(WorldObject* obj);
 
         void OnUpdate(const uint32 diff);
+        // time until the next timed event can fire out of combat, 0 when OnUpdate has work on every tick
+        uint32 GetIdleUpdateDelay() const;
         void OnMoveInLineOfSight(Unit* who);
 
         Unit* DoSelectLowestHpFriendly(float range, uint32 MinHPDiff) const;
@@ -114,6 +117,9 @@ class TC_GAME_API SmartScript
         void RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll = false);
 
         SmartAIEventList mEvents;
+        // (event type, position in mEvents) sorted by type then position, rebuilt whenever mEvents changes or is re-sorted
+        std::vector<std::pair<uint32, uint32>> mEventIndex;
+        std::bitset<SMART_EVENT_END> mHandledEvents;
         SmartAIEventList mInstallEvents;
         SmartAIEventList mTimedActionList;
         ObjectGuid mTimedActionListInvoker;
@@ -151,6 +157,8 @@ class TC_GAME_API SmartScript
         ObjectVectorMap _storedTargets;
 
         void InstallEvents();
+        void RebuildEventIndex();
+        SmartScriptHolder* FindLinkedEvent(uint32 link);
 
         void RemoveStoredEvent(uint32 id);
 };
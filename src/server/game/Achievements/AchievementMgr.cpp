@@ -204,6 +204,24 @@ bool AchievementMgr::IsCompletedAchievement(AchievementEntry const* entry)
     return IsCompletedCriteriaTree(tree);
 }
 
+void AchievementMgr::SkipCriteriaOfCompletedAchievement(AchievementEntry const* achievement)
+{
+    CriteriaTree const* tree = sCriteriaMgr->GetCriteriaTree(achievement->CriteriaTree);
+    if (!tree)
+        return;
+
+    CriteriaMgr::WalkCriteriaTree(tree, [this](CriteriaTree const* node)
+    {
+        if (!node->Criteria)
+            return;
+
+        // criteria shared with other achievements keep updating until all of them are earned, same as CanUpdateCriteriaTree
+        CriteriaTreeList const* trees = sCriteriaMgr->GetCriteriaTreesByCriteria(node->Criteria->ID);
+        if (!trees || std::ranges::all_of(*trees, [this](CriteriaTree const* criteriaTree) { return !criteriaTree->Achievement || HasAchieved(criteriaTree->Achievement->ID); }))
+            SetCriteriaSkipped(node->Criteria->ID);
+    });
+}
+
 bool AchievementMgr::RequiredAchievementSatisfied(uint32 achievementId) const
 {
     return HasAchieved(achievementId);
@@ -264,6 +282,7 @@ void PlayerAchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, Pre
             CompletedAchievementData& ca = _completedAchievements[achievementid];
             ca.Date = fields[1].GetInt64();
             ca.Changed = false;
+            SkipCriteriaOfCompletedAchievement(achievement);
 
             _achievementPoints += achievement->Points;
 
@@ -488,6 +507,7 @@ void PlayerAchievementMgr::CompletedAchievement(AchievementEntry const* achievem
     CompletedAchievementData& ca = _completedAchievements[achievement->ID];
     ca.Date = GameTime::GetGameTime();
     ca.Changed = true;
+    SkipCriteriaOfCompletedAchievement(achievement);
 
     if (achievement->Flags & (ACHIEVEMENT_FLAG_REALM_FIRST_REACH | ACHIEVEMENT_FLAG_REALM_FIRST_KILL))
         sAchievementMgr->SetRealmCompleted(achievement);
@@ -754,6 +774,7 @@ void GuildAchievementMgr::LoadFromDB(PreparedQueryResult achievementResult, Prep
                     ca.CompletingPlayers.insert(ObjectGuid::Create<HighGuid::Player>(*parsedGuid));
 
             ca.Changed = false;
+            SkipCriteriaOfCompletedAchievement(achievement);
 
             _achievementPoints += achievement->Points;
         } while (achievementResult->NextRow());
@@ -954,6 +975,7 @@ void GuildAchievementMgr::CompletedAchievement(AchievementEntry const* achieveme
     CompletedAchievementData& ca = _completedAchievements[achievement->ID];
     ca.Date = GameTime::GetGameTime();
     ca.Changed = true;
+    SkipCriteriaOfCompletedAchievement(achievement);
 
     if (achievement->Flags & ACHIEVEMENT_FLAG_SHOW_GUILD_MEMBERS)
     {
@@ -456,6 +456,15 @@ void CriteriaHandler::Reset()
         SendCriteriaProgressRemoved(criteriaprogress.first);
 
     _criteriaProgress.clear();
+    _skippedCriteria.clear();
+}
+
+void CriteriaHandler::SetCriteriaSkipped(uint32 criteriaId)
+{
+    if (criteriaId >= _skippedCriteria.size())
+        _skippedCriteria.resize(criteriaId + 1);
+
+    _skippedCriteria[criteriaId] = true;
 }
 
 /**
@@ -487,11 +496,15 @@ void CriteriaHandler::UpdateCriteria(CriteriaType type, uint64 miscValue1 /*= 0*
     TC_LOG_DEBUG("criteria", "CriteriaHandler::UpdateCriteria({}, {}, {}, {}, {}) {}",
         CriteriaMgr::GetCriteriaTypeString(type), uint32(type), miscValue1, miscValue2, miscValue3, GetOwnerInfo());
 
+    ModifierTreeResults modifierTreeResults;
     CriteriaList const& criteriaList = GetCriteriaByType(type, uint32(miscValue1));
     for (Criteria const* criteria : criteriaList)
     {
+        if (IsCriteriaSkipped(criteria->ID))
+            continue;
+
         CriteriaTreeList const* trees = sCriteriaMgr->GetCriteriaTreesByCriteria(criteria->ID);
-        if (!CanUpdateCriteria(criteria, trees, miscValue1, miscValue2, miscValue3, ref, referencePlayer))
+        if (!CanUpdateCriteria(criteria, trees, miscValue1, miscValue2, miscValue3, ref, referencePlayer, modifierTreeResults))
             continue;
 
         // requirements not found in the dbc
@@ -499,6 +512,9 @@ void CriteriaHandler::UpdateCriteria(CriteriaType type, uint64 miscValue1 /*= 0*
             if (!data->Meets(referencePlayer, ref, uint32(miscValue1), uint32(miscValue2)))
                 continue;
 
+        // progress below can complete achievements and change what modifiers evaluate to
+        modifierTreeResults.clear();
+
         switch (type)
         {
             // std. case: increment at 1
@@ -1295,7 +1311,8 @@ bool CriteriaHandler::IsCompletedCriteria(Criteria const* criteria, uint64 requi
     return false;
 }
 
-bool CriteriaHandler::CanUpdateCriteria(Criteria const* criteria, CriteriaTreeList const* trees, uint64 miscValue1, uint64 miscValue2, uint64 miscValue3, WorldObject const* ref, Player* referencePlayer)
+bool CriteriaHandler::CanUpdateCriteria(Criteria const* criteria, CriteriaTreeList const* trees, uint64 miscValue1, uint64 miscValue2, uint64 miscValue3, WorldObject const* ref, Player* referencePlayer,
+    ModifierTreeResults& modifierTreeResults)
 {
     if (DisableMgr::IsDisabledFor(DISABLE_TYPE_CRITERIA, criteria->ID, nullptr))
     {
@@ -1322,10 +1339,17 @@ bool CriteriaHandler::CanUpdateCriteria(Criteria const* criteria, CriteriaTreeLi
         return false;
     }
 
-    if (criteria->Modifier && !ModifierTreeSatisfied(criteria->Modifier, miscValue1, miscValue2, ref, referencePlayer))
+    if (criteria->Modifier)
     {
-        TC_LOG_TRACE("criteria", "CriteriaHandler::CanUpdateCriteria: (Id: {} Type {}) Requirements have not been satisfied", criteria->ID, CriteriaMgr::GetCriteriaTypeString(criteria->Entry->Type));
-        return false;
+        auto modifierResult = std::ranges::find(modifierTreeResults, criteria->Modifier, &std::pair<ModifierTreeNode const*, bool>::first);
+        if (modifierResult == modifierTreeResults.end())
+            modifierResult = modifierTreeResults.emplace(modifierTreeResults.end(), criteria->Modifier, ModifierTreeSatisfied(criteria->Modifier, miscValue1, miscValue2, ref, referencePlayer));
+
+        if (!modifierResult->second)
+        {
+            TC_LOG_TRACE("criteria", "CriteriaHandler::CanUpdateCriteria: (Id: {} Type {}) Requirements have not been satisfied", criteria->ID, CriteriaMgr::GetCriteriaTypeString(criteria->Entry->Type));
+            return false;
+        }
     }
 
     if (!ConditionsSatisfied(criteria, referencePlayer))
@@ -2907,16 +2931,10 @@ bool CriteriaHandler::ModifierSatisfied(ModifierTreeEntry const* modifier, uint6
             return false;
         case ModifierTreeType::PlayerHasMount: // 183
         {
-            for (auto&& p : referencePlayer->GetSession()->GetCollectionMgr()->GetAccountMounts())
-            {
-                MountEntry const* mount = sDB2Manager.GetMount(p.first);
-                if (!mount)
-                    continue;
-
-                if (mount->ID == reqValue)
-                    return true;
-            }
-            return false;
+            MountEntry const* mount = sDB2Manager.GetMountById(reqValue);
+            if (!mount || !referencePlayer->GetSession()->GetCollectionMgr()->HasMount(mount->SourceSpellID))
+                return false;
+            break;
         }
         case ModifierTreeType::GarrisonFollowerCountWithInactiveWithItemLevelEqualOrGreaterThan: // 184
         {
@@ -3096,7 +3114,7 @@ bool CriteriaHandler::ModifierSatisfied(ModifierTreeEntry const* modifier, uint6
         }
         case ModifierTreeType::PlayerHasItemWithBonusListFromTreeAndQuality: // 222
         {
-            std::vector<int32> bonusListIDs = ItemBonusMgr::GetAllBonusListsForTree(reqValue);
+            std::span<int32 const> bonusListIDs = ItemBonusMgr::GetAllBonusListsForTree(reqValue);
             if (bonusListIDs.empty())
                 return false;
 
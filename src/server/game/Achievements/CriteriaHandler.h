@@ -296,7 +296,16 @@ protected:
     virtual void AfterCriteriaTreeUpdate(CriteriaTree const* /*tree*/, Player* /*referencePlayer*/) { }
 
     bool IsCompletedCriteria(Criteria const* criteria, uint64 requiredAmount);
-    bool CanUpdateCriteria(Criteria const* criteria, CriteriaTreeList const* trees, uint64 miscValue1, uint64 miscValue2, uint64 miscValue3, WorldObject const* ref, Player* referencePlayer);
+
+    // results of criteria modifier trees already evaluated for the current UpdateCriteria call, criteria often share them
+    using ModifierTreeResults = std::vector<std::pair<ModifierTreeNode const*, bool>>;
+    bool CanUpdateCriteria(Criteria const* criteria, CriteriaTreeList const* trees, uint64 miscValue1, uint64 miscValue2, uint64 miscValue3, WorldObject const* ref, Player* referencePlayer,
+        ModifierTreeResults& modifierTreeResults);
+
+    // criteria that can never be updated again for this owner (CanUpdateCriteriaTree is permanently false for all its trees)
+    // are skipped by UpdateCriteria before any tree, requirement or modifier lookup
+    bool IsCriteriaSkipped(uint32 criteriaId) const { return criteriaId < _skippedCriteria.size() && _skippedCriteria[criteriaId]; }
+    void SetCriteriaSkipped(uint32 criteriaId);
 
     virtual void SendPacket(WorldPacket const* data) const = 0;
 
@@ -311,6 +320,7 @@ protected:
 
     CriteriaProgressMap _criteriaProgress;
     std::unordered_map<uint32 /*criteriaID*/, Milliseconds /*time left*/> _startedCriteria;
+    std::vector<bool> _skippedCriteria;
 };
 
 class TC_GAME_API CriteriaMgr
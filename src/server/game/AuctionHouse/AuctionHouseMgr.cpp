@@ -18,6 +18,7 @@
 #include "AuctionHouseBot.h"
 #include "AuctionHouseMgr.h"
 #include "AuctionHousePackets.h"
+#include "AuctionHouseSearchIndex.h"
 #include "AccountMgr.h"
 #include "Bag.h"
 #include "BattlePetMgr.h"
@@ -31,6 +32,7 @@
 #include "Language.h"
 #include "Log.h"
 #include "Mail.h"
+#include "Metric.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Player.h"
@@ -702,8 +704,9 @@ void AuctionHouseMgr::PendingAuctionProcess(Player* player)
         do
         {
             PendingAuctionInfo const& pendingAuction = *itrAH;
-            if (AuctionPosting* auction = GetAuctionsById(pendingAuction.AuctionHouseId)->GetAuction(pendingAuction.AuctionId))
-                auction->EndTime = GameTime::GetSystemTime();
+            AuctionHouseObject* auctionHouse = GetAuctionsById(pendingAuction.AuctionHouseId);
+            if (AuctionPosting* auction = auctionHouse->GetAuction(pendingAuction.AuctionId))
+                auctionHouse->SetAuctionEndTime(auction, GameTime::GetSystemTime());
 
             CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_AUCTION_EXPIRATION);
             stmt->setUInt32(0, uint32(GameTime::GetGameTime()));
@@ -745,8 +748,9 @@ void AuctionHouseMgr::UpdatePendingAuctions()
             CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
             for (PendingAuctionInfo const& pendingAuction : itr->second.Auctions)
             {
-                if (AuctionPosting* auction = GetAuctionsById(pendingAuction.AuctionHouseId)->GetAuction(pendingAuction.AuctionId))
-                    auction->EndTime = GameTime::GetSystemTime();
+                AuctionHouseObject* auctionHouse = GetAuctionsById(pendingAuction.AuctionHouseId);
+                if (AuctionPosting* auction = auctionHouse->GetAuction(pendingAuction.AuctionId))
+                    auctionHouse->SetAuctionEndTime(auction, GameTime::GetSystemTime());
 
                 CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_AUCTION_EXPIRATION);
                 stmt->setUInt32(0, uint32(GameTime::GetGameTime()));
@@ -759,6 +763,21 @@ void AuctionHouseMgr::UpdatePendingAuctions()
     }
 }
 
+void AuctionHouseMgr::UpdateExpiredAuctions()
+{
+    // the batch size is shared by all auction houses, auctions left over are handled by the next calls
+    uint32 budget = sWorld->getIntConfig(CONFIG_AUCTION_EXPIRE_BATCH_SIZE);
+    if (!budget)
+        budget = std::numeric_limits<uint32>::max();
+
+    for (AuctionHouseObject* auctionHouse : { &mHordeAuctions, &mAllianceAuctions, &mNeutralAuctions, &mGoblinAuctions })
+    {
+        budget -= auctionHouse->UpdateExpiredAuctions(budget);
+        if (!budget)
+            break;
+    }
+}
+
 void AuctionHouseMgr::Update()
 {
     mHordeAuctions.Update();
@@ -844,7 +863,14 @@ AuctionHouseEntry const* AuctionHouseMgr::GetAuctionHouseEntry(uint32 factionTem
     return sAuctionHouseStore.LookupEntry(houseid);
 }
 
-AuctionHouseObject::AuctionHouseObject(uint32 auctionHouseId) : _auctionHouse(sAuctionHouseStore.AssertEntry(auctionHouseId))
+struct AuctionReplicateSnapshot
+{
+    TimePoint BuildTime;
+    std::vector<WorldPackets::AuctionHouse::AuctionItem> Items; // ordered by auction id
+};
+
+AuctionHouseObject::AuctionHouseObject(uint32 auctionHouseId) : _auctionHouse(sAuctionHouseStore.AssertEntry(auctionHouseId)),
+    _searchIndex(std::make_unique<AuctionsBucketSearchIndex>())
 {
 }
 
@@ -915,6 +941,8 @@ void AuctionHouseObject::AddAuction(CharacterDatabaseTransaction trans, AuctionP
 
             bucket->FullName[locale] = wstrCaseAccentInsensitiveParse(utf16name, locale);
         }
+
+        _searchIndex->AddBucket(bucket);
     }
     else
         bucket = &bucketItr->second;
@@ -999,6 +1027,7 @@ void AuctionHouseObject::AddAuction(CharacterDatabaseTransaction trans, AuctionP
         _playerBidderAuctions.emplace(bidder, auction.Id);
 
     AuctionPosting* addedAuction = &(_itemsByAuctionId[auction.Id] = std::move(auction));
+    _expirationQueue.emplace(addedAuction->EndTime, addedAuction->Id);
 
     WorldPackets::AuctionHouse::AuctionSortDef priceSort{ AuctionHouseSortOrder::Price, false };
     AuctionPosting::Sorter insertSorter(LOCALE_enUS, std::span(&priceSort, 1));
@@ -1066,7 +1095,10 @@ void AuctionHouseObject::RemoveAuction(CharacterDatabaseTransaction trans, Aucti
             bucket->QualityMask &= static_cast<AuctionHouseFilterMask>(~(1 << (quality + 4)));
     }
     else
+    {
+        _searchIndex->RemoveBucket(bucket);
         _buckets.erase(bucket->Key);
+    }
 
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_AUCTION);
     stmt->setUInt32(0, auction->Id);
@@ -1089,9 +1121,7 @@ void AuctionHouseObject::RemoveAuction(CharacterDatabaseTransaction trans, Aucti
 
 void AuctionHouseObject::Update()
 {
-    SystemTimePoint curTime = GameTime::GetSystemTime();
     TimePoint curTimeSteady = GameTime::Now();
-    ///- Handle expired auctions
 
     // Clear expired throttled players
     for (auto itr = _replicateThrottleMap.begin(); itr != _replicateThrottleMap.end();)
@@ -1110,20 +1140,37 @@ void AuctionHouseObject::Update()
             ++itr;
     }
 
-    if (_itemsByAuctionId.empty())
-        return;
+    if (Optional<Milliseconds> snapshotAge = GetReplicateSnapshotAge())
+        TC_METRIC_VALUE("auction_replicate_snapshot_age", uint64(snapshotAge->count()),
+            TC_METRIC_TAG("auction_house_id", std::to_string(GetAuctionHouseId())));
+}
+
+void AuctionHouseObject::SetAuctionEndTime(AuctionPosting* auction, SystemTimePoint endTime)
+{
+    auction->EndTime = endTime;
+    _expirationQueue.emplace(endTime, auction->Id);
+}
+
+uint32 AuctionHouseObject::UpdateExpiredAuctions(uint32 maxCount)
+{
+    SystemTimePoint curTime = GameTime::GetSystemTime();
+    if (_expirationQueue.empty() || _expirationQueue.top().first > curTime || !maxCount)
+        return 0;
 
     CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
 
-    for (auto it = _itemsByAuctionId.begin(); it != _itemsByAuctionId.end();)
+    uint32 processed = 0;
+    while (!_expirationQueue.empty() && _expirationQueue.top().first <= curTime && processed < maxCount)
     {
-        AuctionPosting* auction = &it->second;
-        ///- filter auctions expired on next update
-        if (auction->EndTime > curTime + 1min)
-        {
-            ++it;
+        auto [endTime, auctionId] = _expirationQueue.top();
+        _expirationQueue.pop();
+
+        AuctionPosting* auction = GetAuction(auctionId);
+        ///- skip entries of auctions already removed or whose end time changed since
+        if (!auction || auction->EndTime != endTime)
             continue;
-        }
+
+        ++processed;
 
         ///- Either cancel the auction if there was no bidder
         if (auction->Bidder.IsEmpty())
@@ -1131,7 +1178,7 @@ void AuctionHouseObject::Update()
             SendAuctionExpired(auction, trans);
             sScriptMgr->OnAuctionExpire(this, auction);
 
-            RemoveAuction(trans, auction, &it);
+            RemoveAuction(trans, auction);
         }
         ///- Or perform the transaction
         else
@@ -1140,19 +1187,20 @@ void AuctionHouseObject::Update()
             // Because auctionHouse->SendAuctionWon can unload items if bidder is offline
             // we need to RemoveAuction before sending mails
             AuctionPosting copy = *auction;
-            RemoveAuction(trans, auction, &it);
+            RemoveAuction(trans, auction);
 
             //we should send an "item sold" message if the seller is online
             //we send the item to the winner
             //we send the money to the seller
             SendAuctionSold(&copy, nullptr, trans);
             SendAuctionWon(&copy, nullptr, trans);
-            sScriptMgr->OnAuctionSuccessful(this, auction);
+            sScriptMgr->OnAuctionSuccessful(this, &copy);
         }
     }
 
-    // Run DB changes
+    // Run DB changes, one transaction for the whole batch
     CharacterDatabase.CommitTransaction(trans);
+    return processed;
 }
 
 void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionListBucketsResult& listBucketsResult, Player const* player,
@@ -1172,29 +1220,29 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
 
     AuctionsResultBuilder<AuctionsBucketData> builder(offset, player->GetSession()->GetSessionDbcLocale(), sorts, AuctionHouseResultLimits::Browse);
 
-    for (std::pair<AuctionsBucketKey const, AuctionsBucketData> const& bucket : _buckets)
+    // only buckets of the requested item classes containing every trigram of the searched name are visited
+    _searchIndex->ForEachCandidate(player->GetSession()->GetSessionDbcLocale(), name, classFilters, [&](AuctionsBucketData const* bucketData)
     {
-        AuctionsBucketData const* bucketData = &bucket.second;
         if (!name.empty())
         {
             if (filters.HasFlag(AuctionHouseFilterMask::ExactMatch))
             {
                 if (bucketData->FullName[player->GetSession()->GetSessionDbcLocale()] != name)
-                    continue;
+                    return;
             }
             else
                 if (bucketData->FullName[player->GetSession()->GetSessionDbcLocale()].find(name) == std::wstring::npos)
-                    continue;
+                    return;
         }
 
         if (minLevel && bucketData->RequiredLevel < minLevel)
-            continue;
+            return;
 
         if (maxLevel && bucketData->RequiredLevel > maxLevel)
-            continue;
+            return;
 
         if (!filters.HasFlag(bucketData->QualityMask))
-            continue;
+            return;
 
         if (classFilters)
         {
@@ -1203,15 +1251,15 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
             // if we want this class and did not specify and subclasses, its set to FILTER_SKIP_SUBCLASS
             // otherwise full restrictions apply
             if (classFilters->Classes[bucketData->ItemClass].SubclassMask == AuctionSearchClassFilters::FILTER_SKIP_CLASS)
-                continue;
+                return;
 
             if (classFilters->Classes[bucketData->ItemClass].SubclassMask != AuctionSearchClassFilters::FILTER_SKIP_SUBCLASS)
             {
                 if (!(classFilters->Classes[bucketData->ItemClass].SubclassMask & (1 << bucketData->ItemSubClass)))
-                    continue;
+                    return;
 
                 if (!(classFilters->Classes[bucketData->ItemClass].InvTypes[bucketData->ItemSubClass] & (UI64LIT(1) << bucketData->InventoryType)))
-                    continue;
+                    return;
             }
         }
 
@@ -1234,34 +1282,34 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
                 }
 
                 if (hasAll)
-                    continue;
+                    return;
             }
             // caged pets
-            else if (bucket.first.BattlePetSpeciesId)
+            else if (bucketData->Key.BattlePetSpeciesId)
             {
-                if (knownPetSpecies.test(bucket.first.BattlePetSpeciesId))
-                    continue;
+                if (knownPetSpecies.test(bucketData->Key.BattlePetSpeciesId))
+                    return;
             }
             // toys
-            else if (sDB2Manager.IsToyItem(bucket.first.ItemId))
+            else if (sDB2Manager.IsToyItem(bucketData->Key.ItemId))
             {
-                if (player->GetSession()->GetCollectionMgr()->HasToy(bucket.first.ItemId))
-                    continue;
+                if (player->GetSession()->GetCollectionMgr()->HasToy(bucketData->Key.ItemId))
+                    return;
             }
             // mounts
             // recipes
             // pet items
             else if (bucketData->ItemClass == ITEM_CLASS_CONSUMABLE || bucketData->ItemClass == ITEM_CLASS_RECIPE || bucketData->ItemClass == ITEM_CLASS_MISCELLANEOUS)
             {
-                ItemTemplate const* itemTemplate = ASSERT_NOTNULL(sObjectMgr->GetItemTemplate(bucket.first.ItemId));
+                ItemTemplate const* itemTemplate = ASSERT_NOTNULL(sObjectMgr->GetItemTemplate(bucketData->Key.ItemId));
                 if (itemTemplate->Effects.size() >= 2 && (itemTemplate->Effects[0]->SpellID == 483 || itemTemplate->Effects[0]->SpellID == 55884))
                 {
                     if (player->HasSpell(itemTemplate->Effects[1]->SpellID))
-                        continue;
+                        return;
 
                     if (BattlePetSpeciesEntry const* battlePetSpecies = BattlePets::BattlePetMgr::GetBattlePetSpeciesBySpell(itemTemplate->Effects[1]->SpellID))
                         if (knownPetSpecies.test(battlePetSpecies->ID))
-                            continue;
+                            return;
                 }
             }
         }
@@ -1269,14 +1317,14 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
         if (filters.HasFlag(AuctionHouseFilterMask::UsableOnly))
         {
             if (bucketData->RequiredLevel && player->GetLevel() < bucketData->RequiredLevel)
-                continue;
+                return;
 
-            if (player->CanUseItem(sObjectMgr->GetItemTemplate(bucket.first.ItemId), true) != EQUIP_ERR_OK)
-                continue;
+            if (player->CanUseItem(sObjectMgr->GetItemTemplate(bucketData->Key.ItemId), true) != EQUIP_ERR_OK)
+                return;
 
             // cannot learn caged pets whose level exceeds highest level of currently owned pet
             if (bucketData->MinBattlePetLevel && bucketData->MinBattlePetLevel > maxKnownPetLevel)
-                continue;
+                return;
         }
 
         // TODO: this one needs to access loot history to know highest item level for every inventory type
@@ -1285,7 +1333,7 @@ void AuctionHouseObject::BuildListBuckets(WorldPackets::AuctionHouse::AuctionLis
         //}
 
         builder.AddItem(bucketData);
-    }
+    });
 
     for (AuctionsBucketData const* resultBucket : builder.GetResultRange())
     {
@@ -1445,24 +1493,58 @@ void AuctionHouseObject::BuildReplicate(WorldPackets::AuctionHouse::AuctionRepli
         throttleItr->second.Global = sAuctionMgr->GenerateReplicationId();
     }
 
-    if (_itemsByAuctionId.empty() || !count)
+    if (!throttleItr->second.Snapshot)
+        throttleItr->second.Snapshot = GetReplicateSnapshot(curTime);
+
+    AuctionReplicateSnapshot const& snapshot = *throttleItr->second.Snapshot;
+    if (snapshot.Items.empty() || !count)
         return;
 
-    auto itr = _itemsByAuctionId.upper_bound(cursor);
-    for (; itr != _itemsByAuctionId.end(); ++itr)
+    auto itr = std::ranges::upper_bound(snapshot.Items, int32(cursor), std::ranges::less(), &WorldPackets::AuctionHouse::AuctionItem::AuctionID);
+    for (; itr != snapshot.Items.end(); ++itr)
     {
-        AuctionPosting const& auction = itr->second;
-
-        replicateResponse.Items.emplace_back();
-        WorldPackets::AuctionHouse::AuctionItem& auctionItem = replicateResponse.Items.back();
-        auction.BuildAuctionItem(&auctionItem, false, true, true, auction.Bidder.IsEmpty());
+        replicateResponse.Items.push_back(*itr);
         if (!--count)
             break;
     }
 
     replicateResponse.ChangeNumberGlobal = throttleItr->second.Global;
     replicateResponse.ChangeNumberCursor = throttleItr->second.Cursor = !replicateResponse.Items.empty() ? replicateResponse.Items.back().AuctionID : 0;
-    replicateResponse.ChangeNumberTombstone = throttleItr->second.Tombstone = !count ? _itemsByAuctionId.rbegin()->first : 0;
+    replicateResponse.ChangeNumberTombstone = throttleItr->second.Tombstone = !count ? snapshot.Items.back().AuctionID : 0;
+
+    if (!throttleItr->second.IsReplicationInProgress())
+        throttleItr->second.Snapshot = nullptr;
+}
+
+Optional<Milliseconds> AuctionHouseObject::GetReplicateSnapshotAge() const
+{
+    if (!_replicateSnapshot)
+        return {};
+
+    return std::chrono::duration_cast<Milliseconds>(GameTime::Now() - _replicateSnapshot->BuildTime);
+}
+
+std::shared_ptr<AuctionReplicateSnapshot const> AuctionHouseObject::GetReplicateSnapshot(TimePoint now)
+{
+    if (_replicateSnapshot && now - _replicateSnapshot->BuildTime < Seconds(sWorld->getIntConfig(CONFIG_AUCTION_REPLICATE_SNAPSHOT_INTERVAL)))
+        return _replicateSnapshot;
+
+    // auction items can only be read on the world thread, build the snapshot here but reuse the previous buffer when possible
+    std::shared_ptr<AuctionReplicateSnapshot> snapshot = std::move(_previousReplicateSnapshot);
+    if (!snapshot || snapshot.use_count() > 1)
+        snapshot = std::make_shared<AuctionReplicateSnapshot>();
+
+    snapshot->BuildTime = now;
+    snapshot->Items.clear();
+    snapshot->Items.reserve(_itemsByAuctionId.size());
+    for (auto const& [auctionId, auction] : _itemsByAuctionId)
+    {
+        WorldPackets::AuctionHouse::AuctionItem& auctionItem = snapshot->Items.emplace_back();
+        auction.BuildAuctionItem(&auctionItem, false, true, true, auction.Bidder.IsEmpty());
+    }
+
+    _previousReplicateSnapshot = std::exchange(_replicateSnapshot, snapshot);
+    return snapshot;
 }
 
 uint64 AuctionHouseObject::CalculateAuctionHouseCut(uint64 bidAmount) const
@@ -26,9 +26,13 @@
 #include "ObjectGuid.h"
 #include "Optional.h"
 #include <map>
+#include <memory>
+#include <queue>
 #include <span>
 #include <unordered_map>
 
+class AuctionsBucketSearchIndex;
+struct AuctionReplicateSnapshot;
 class Item;
 class Player;
 class WorldPacket;
@@ -202,6 +206,7 @@ struct AuctionsBucketData
     uint8 MinBattlePetLevel = 0;
     uint8 MaxBattlePetLevel = 0;
     std::array<std::wstring, TOTAL_LOCALES> FullName = { };
+    uint32 SearchIndexSlot = 0;
 
     std::vector<AuctionPosting*> Auctions;
 
@@ -277,6 +282,7 @@ public:
         uint32 Cursor = 0;
         uint32 Tombstone = 0;
         TimePoint NextAllowedReplication = TimePoint::min();
+        std::shared_ptr<AuctionReplicateSnapshot const> Snapshot; // kept until this replication is complete so pages stay consistent
 
         bool IsReplicationInProgress() const { return Cursor != Tombstone && Global != 0; }
     };
@@ -292,7 +298,11 @@ public:
 
     void RemoveAuction(CharacterDatabaseTransaction trans, AuctionPosting* auction, std::map<uint32, AuctionPosting>::iterator* auctionItr = nullptr);
 
+    // must be used instead of assigning AuctionPosting::EndTime directly to keep the expiration queue up to date
+    void SetAuctionEndTime(AuctionPosting* auction, SystemTimePoint endTime);
+
     void Update();
+    uint32 UpdateExpiredAuctions(uint32 maxCount);
 
     void BuildListBuckets(WorldPackets::AuctionHouse::AuctionListBucketsResult& listBucketsResult, Player const* player,
         std::wstring const& name, uint8 minLevel, uint8 maxLevel, EnumFlag<AuctionHouseFilterMask> filters, Optional<AuctionSearchClassFilters> const& classFilters,
@@ -311,6 +321,7 @@ public:
         uint32 offset, std::span<WorldPackets::AuctionHouse::AuctionSortDef const> sorts) const;
     void BuildReplicate(WorldPackets::AuctionHouse::AuctionReplicateResponse& replicateResponse, Player* player,
         uint32 global, uint32 cursor, uint32 tombstone, uint32 count);
+    Optional<Milliseconds> GetReplicateSnapshotAge() const;
 
     uint64 CalculateAuctionHouseCut(uint64 bidAmount) const;
 
@@ -332,6 +343,7 @@ private:
     std::map<uint32, AuctionPosting> _itemsByAuctionId; // ordered for replicate
     std::unordered_map<uint32, AuctionPosting> _soldItemsById;
     std::map<AuctionsBucketKey, AuctionsBucketData> _buckets; // ordered for search by itemid only
+    std::unique_ptr<AuctionsBucketSearchIndex> _searchIndex;
     std::unordered_map<ObjectGuid, CommodityQuote> _commodityQuotes;
 
     std::unordered_multimap<ObjectGuid, uint32> _playerOwnedAuctions;
@@ -340,6 +352,17 @@ private:
     // Map of throttled players for GetAll, and throttle expiry time
     // Stored here, rather than player object to maintain persistence after logout
     std::unordered_map<ObjectGuid, PlayerReplicateThrottleData> _replicateThrottleMap;
+
+    // min-heap of (end time, auction id), entries whose end time no longer matches the auction are skipped
+    using ExpirationEntry = std::pair<SystemTimePoint, uint32>;
+    std::priority_queue<ExpirationEntry, std::vector<ExpirationEntry>, std::greater<>> _expirationQueue;
+
+    // Replicate responses are paged from a shared snapshot of all auctions, rebuilt at most every Auction.ReplicateSnapshotInterval
+    // The previous snapshot is kept so its storage can be reused once no replication pages through it anymore
+    std::shared_ptr<AuctionReplicateSnapshot> _replicateSnapshot;
+    std::shared_ptr<AuctionReplicateSnapshot> _previousReplicateSnapshot;
+
+    std::shared_ptr<AuctionReplicateSnapshot const> GetReplicateSnapshot(TimePoint now);
 };
 
 class TC_GAME_API AuctionHouseMgr
@@ -383,6 +406,7 @@ class TC_GAME_API AuctionHouseMgr
         std::size_t PendingAuctionCount(Player const* player) const;
         void PendingAuctionProcess(Player* player);
         void UpdatePendingAuctions();
+        void UpdateExpiredAuctions();
         void Update();
 
         uint32 GenerateReplicationId();
@@ -0,0 +1,106 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuctionHouseSearchIndex.h"
+
+std::vector<uint64> AuctionsBucketSearchIndex::GetUniqueTrigrams(std::wstring_view name)
+{
+    std::vector<uint64> trigrams;
+    if (name.size() < 3)
+        return trigrams;
+
+    trigrams.reserve(name.size() - 2);
+    for (std::size_t i = 0; i + 3 <= name.size(); ++i)
+        trigrams.push_back(MakeTrigram(name.substr(i, 3)));
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
+
+void AuctionsBucketSearchIndex::AddBucket(AuctionsBucketData* bucket)
+{
+    uint32 slot;
+    if (!_freeSlots.empty())
+    {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+        _slots[slot] = bucket;
+    }
+    else
+    {
+        slot = uint32(_slots.size());
+        _slots.push_back(bucket);
+
+        // all bitmaps have the same size so they can be combined directly
+        _usedSlots.resize(_slots.size());
+        for (boost::dynamic_bitset<uint64>& slots : _slotsByClass)
+            slots.resize(_slots.size());
+    }
+
+    bucket->SearchIndexSlot = slot;
+    _usedSlots.set(slot);
+    if (bucket->ItemClass < MAX_ITEM_CLASS)
+        _slotsByClass[bucket->ItemClass].set(slot);
+
+    for (std::size_t locale = 0; locale < TOTAL_LOCALES; ++locale)
+    {
+        for (uint64 trigram : GetUniqueTrigrams(bucket->FullName[locale]))
+        {
+            std::vector<uint32>& slots = _slotsByTrigram[locale][trigram];
+            slots.insert(std::lower_bound(slots.begin(), slots.end(), slot), slot);
+        }
+    }
+}
+
+void AuctionsBucketSearchIndex::RemoveBucket(AuctionsBucketData const* bucket)
+{
+    uint32 slot = bucket->SearchIndexSlot;
+    if (slot >= _slots.size() || _slots[slot] != bucket)
+        return;
+
+    for (std::size_t locale = 0; locale < TOTAL_LOCALES; ++locale)
+    {
+        for (uint64 trigram : GetUniqueTrigrams(bucket->FullName[locale]))
+        {
+            auto itr = _slotsByTrigram[locale].find(trigram);
+            if (itr == _slotsByTrigram[locale].end())
+                continue;
+
+            std::vector<uint32>& slots = itr->second;
+            auto slotItr = std::lower_bound(slots.begin(), slots.end(), slot);
+            if (slotItr != slots.end() && *slotItr == slot)
+                slots.erase(slotItr);
+
+            if (slots.empty())
+                _slotsByTrigram[locale].erase(itr);
+        }
+    }
+
+    if (bucket->ItemClass < MAX_ITEM_CLASS)
+        _slotsByClass[bucket->ItemClass].reset(slot);
+
+    _usedSlots.reset(slot);
+    _slots[slot] = nullptr;
+    _freeSlots.push_back(slot);
+}
+
+uint64 AuctionsBucketSearchIndex::MakeTrigram(std::wstring_view text)
+{
+    // code points fit in 21 bits
+    return (uint64(uint32(text[0]) & 0x1FFFFF) << 42) | (uint64(uint32(text[1]) & 0x1FFFFF) << 21) | uint64(uint32(text[2]) & 0x1FFFFF);
+}
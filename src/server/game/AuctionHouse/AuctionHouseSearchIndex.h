@@ -0,0 +1,105 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_AUCTION_HOUSE_SEARCH_INDEX_H
+#define TRINITY_AUCTION_HOUSE_SEARCH_INDEX_H
+
+#include "AuctionHouseMgr.h"
+#include <boost/container/small_vector.hpp>
+#include <boost/dynamic_bitset.hpp>
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Index over the buckets of one auction house, maintained as buckets are created and removed
+// Every bucket gets a dense slot. Per item class bitmaps narrow class filtered browses and per locale
+// trigram posting lists (sorted slots) narrow name searches. Candidates are a superset of the matching
+// buckets, all other filters (level, quality, subclass, collected, usable) are still checked by the caller
+class TC_GAME_API AuctionsBucketSearchIndex
+{
+public:
+    void AddBucket(AuctionsBucketData* bucket);
+    void RemoveBucket(AuctionsBucketData const* bucket);
+
+    std::size_t GetBucketCount() const { return _slots.size() - _freeSlots.size(); }
+
+    // calls callback with every bucket whose item class is accepted by classFilters and whose name in locale
+    // contains every trigram of name (names shorter than a trigram only use the class filters)
+    template <typename Callback>
+    void ForEachCandidate(LocaleConstant locale, std::wstring_view name, Optional<AuctionSearchClassFilters> const& classFilters, Callback&& callback) const
+    {
+        boost::dynamic_bitset<uint64> const* candidates = &_usedSlots;
+        boost::dynamic_bitset<uint64> classCandidates;
+        if (classFilters)
+        {
+            classCandidates.resize(_slots.size());
+            for (std::size_t itemClass = 0; itemClass < MAX_ITEM_CLASS; ++itemClass)
+                if (classFilters->Classes[itemClass].SubclassMask != AuctionSearchClassFilters::FILTER_SKIP_CLASS)
+                    classCandidates |= _slotsByClass[itemClass];
+
+            candidates = &classCandidates;
+        }
+
+        if (name.size() >= 3 && locale < TOTAL_LOCALES)
+        {
+            boost::container::small_vector<std::vector<uint32> const*, 16> postingLists;
+            for (std::size_t i = 0; i + 3 <= name.size(); ++i)
+            {
+                auto itr = _slotsByTrigram[locale].find(MakeTrigram(name.substr(i, 3)));
+                if (itr == _slotsByTrigram[locale].end())
+                    return;
+
+                postingLists.push_back(&itr->second);
+            }
+
+            std::sort(postingLists.begin(), postingLists.end(), [](std::vector<uint32> const* left, std::vector<uint32> const* right)
+            {
+                return left->size() < right->size();
+            });
+            postingLists.erase(std::unique(postingLists.begin(), postingLists.end()), postingLists.end());
+
+            for (uint32 slot : *postingLists.front())
+            {
+                if (!candidates->test(slot))
+                    continue;
+
+                if (!std::all_of(postingLists.begin() + 1, postingLists.end(), [slot](std::vector<uint32> const* slots) { return std::binary_search(slots->begin(), slots->end(), slot); }))
+                    continue;
+
+                callback(_slots[slot]);
+            }
+            return;
+        }
+
+        for (std::size_t slot = candidates->find_first(); slot != boost::dynamic_bitset<uint64>::npos; slot = candidates->find_next(slot))
+            callback(_slots[slot]);
+    }
+
+private:
+    static uint64 MakeTrigram(std::wstring_view text);
+    static std::vector<uint64> GetUniqueTrigrams(std::wstring_view name);
+
+    std::vector<AuctionsBucketData const*> _slots;
+    std::vector<uint32> _freeSlots;
+    boost::dynamic_bitset<uint64> _usedSlots;
+    std::array<boost::dynamic_bitset<uint64>, MAX_ITEM_CLASS> _slotsByClass;
+    std::array<std::unordered_map<uint64, std::vector<uint32>>, TOTAL_LOCALES> _slotsByTrigram;
+};
+
+#endif // TRINITY_AUCTION_HOUSE_SEARCH_INDEX_H
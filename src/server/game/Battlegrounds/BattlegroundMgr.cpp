@@ -125,13 +125,8 @@ void BattlegroundMgr::Update(uint32 diff)
         std::vector<ScheduledQueueUpdate> scheduled;
         std::swap(scheduled, m_QueueUpdateScheduler);
 
-        for (uint8 i = 0; i < scheduled.size(); i++)
-        {
-            uint32 arenaMMRating = scheduled[i].ArenaMatchmakerRating;
-            BattlegroundQueueTypeId bgQueueTypeId = scheduled[i].QueueId;
-            BattlegroundBracketId bracket_id = scheduled[i].BracketId;
-            GetBattlegroundQueue(bgQueueTypeId).BattlegroundQueueUpdate(diff, bracket_id, arenaMMRating);
-        }
+        for (ScheduledQueueUpdate const& update : scheduled)
+            GetBattlegroundQueue(update.QueueId).BattlegroundQueueUpdate(diff, update.BracketId, update.ArenaMatchmakerRating);
     }
 
     // if rating difference counts, maybe force-update queues
@@ -145,6 +145,7 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player const* leader, Group const* g
     ginfo->ArenaMatchmakerRating     = MatchmakerRating;
     ginfo->OpponentsTeamRating       = 0;
     ginfo->OpponentsMatchmakerRating = 0;
+    ginfo->BracketId                 = bracketId;
 
     ginfo->Players.clear();
 
@@ -192,6 +193,8 @@ GroupQueueInfo* BattlegroundQueue::AddGroup(Player const* leader, Group const* g
     //add GroupInfo to m_QueuedGroups
     {
         m_QueuedGroups[bracketId][index].push_back(ginfo);
+        if (m_queueId.Rated)
+            m_RatedGroupsByMatchmakerRating[bracketId].emplace(ginfo->ArenaMatchmakerRating, ginfo);
 
         //announce to world, this code needs mutex
         if (!m_queueId.Rated && !isPremade && sWorld->getBoolConfig(CONFIG_BATTLEGROUND_QUEUE_ANNOUNCER_ENABLE))
@@ -300,29 +303,21 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
 
     GroupQueueInfo* group = itr->second.GroupInfo;
     GroupsQueueType::iterator group_itr;
-    // mostly people with the highest levels are in battlegrounds, thats why
-    // we count from MAX_BATTLEGROUND_QUEUES - 1 to 0
 
     uint32 index = (group->Team == HORDE) ? BG_QUEUE_PREMADE_HORDE : BG_QUEUE_PREMADE_ALLIANCE;
 
-    for (int32 bracket_id_tmp = MAX_BATTLEGROUND_BRACKETS - 1; bracket_id_tmp >= 0 && bracket_id == -1; --bracket_id_tmp)
+    //we must check premade and normal team's queue - because when players from premade are joining bg,
+    //they leave groupinfo so we can't use its players size to find out index
+    for (uint32 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT && bracket_id == -1; j += PVP_TEAMS_COUNT)
     {
-        //we must check premade and normal team's queue - because when players from premade are joining bg,
-        //they leave groupinfo so we can't use its players size to find out index
-        for (uint32 j = index; j < BG_QUEUE_GROUP_TYPES_COUNT; j += PVP_TEAMS_COUNT)
+        GroupsQueueType& groups = m_QueuedGroups[group->BracketId][j];
+        GroupsQueueType::iterator k = std::find(groups.begin(), groups.end(), group);
+        if (k != groups.end())
         {
-            GroupsQueueType::iterator k = m_QueuedGroups[bracket_id_tmp][j].begin();
-            for (; k != m_QueuedGroups[bracket_id_tmp][j].end(); ++k)
-            {
-                if ((*k) == group)
-                {
-                    bracket_id = bracket_id_tmp;
-                    group_itr = k;
-                    //we must store index to be able to erase iterator
-                    index = j;
-                    break;
-                }
-            }
+            bracket_id = group->BracketId;
+            group_itr = k;
+            //we must store index to be able to erase iterator
+            index = j;
         }
     }
 
@@ -375,6 +370,8 @@ void BattlegroundQueue::RemovePlayer(ObjectGuid guid, bool decreaseInvitedCount)
     if (group->Players.empty())
     {
         m_QueuedGroups[bracket_id][index].erase(group_itr);
+        if (m_queueId.Rated && !group->IsInvitedToBGInstanceGUID)
+            RemoveFromRatingIndex(group);
         delete group;
         return;
     }
@@ -435,6 +432,8 @@ bool BattlegroundQueue::InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg,
     {
         // not yet invited
         // set invitation
+        if (m_queueId.Rated)
+            RemoveFromRatingIndex(ginfo);
         ginfo->IsInvitedToBGInstanceGUID = bg->GetInstanceID();
         BattlegroundTypeId bgTypeId = BattlegroundTypeId(m_queueId.BattlemasterListId);
         BattlegroundQueueTypeId bgQueueTypeId = m_queueId;
@@ -883,122 +882,130 @@ void BattlegroundQueue::BattlegroundQueueUpdate(uint32 /*diff*/, BattlegroundBra
     }
     else if (bg_template->IsArena())
     {
-        // found out the minimum and maximum ratings the newly added team should battle against
+        // pick the team to find an opponent for
         // arenaRating is the rating of the latest joined team, or 0
-        // 0 is on (automatic update call) and we must set it to team's with longest wait time
-        if (!arenaRating)
+        // 0 is on (automatic update call) and we must take the team with longest wait time
+        GroupQueueInfo* team = nullptr;
+        if (arenaRating)
         {
-            GroupQueueInfo* front1 = nullptr;
-            GroupQueueInfo* front2 = nullptr;
-            if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].empty())
-            {
-                front1 = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].front();
-                arenaRating = front1->ArenaMatchmakerRating;
-            }
-            if (!m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].empty())
-            {
-                front2 = m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].front();
-                arenaRating = front2->ArenaMatchmakerRating;
-            }
-            if (front1 && front2)
-            {
-                if (front1->JoinTime < front2->JoinTime)
-                    arenaRating = front1->ArenaMatchmakerRating;
-            }
-            else if (!front1 && !front2)
-                return; //queues are empty
+            auto range = m_RatedGroupsByMatchmakerRating[bracket_id].equal_range(arenaRating);
+            for (RatedGroupsMap::const_iterator itr = range.first; itr != range.second; ++itr)
+                if (!team || itr->second->JoinTime > team->JoinTime)
+                    team = itr->second;
         }
 
-        //set rating range
-        uint32 arenaMinRating = (arenaRating <= sBattlegroundMgr->GetMaxRatingDifference()) ? 0 : arenaRating - sBattlegroundMgr->GetMaxRatingDifference();
-        uint32 arenaMaxRating = arenaRating + sBattlegroundMgr->GetMaxRatingDifference();
-        // if max rating difference is set and the time past since server startup is greater than the rating discard time
-        // (after what time the ratings aren't taken into account when making teams) then
-        // the discard time is current_time - time_to_discard, teams that joined after that, will have their ratings taken into account
-        // else leave the discard time on 0, this way all ratings will be discarded
-        // this has to be signed value - when the server starts, this value would be negative and thus overflow
-        int32 discardTime = GameTime::GetGameTimeMS() - sBattlegroundMgr->GetRatingDiscardTimer();
-
-        // we need to find 2 teams which will play next game
-        GroupsQueueType::iterator itr_teams[PVP_TEAMS_COUNT];
-        uint8 found = 0;
-        uint8 team = 0;
-
-        for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
+        if (!team)
         {
-            // take the group that joined first
-            GroupsQueueType::iterator itr2 = m_QueuedGroups[bracket_id][i].begin();
-            for (; itr2 != m_QueuedGroups[bracket_id][i].end(); ++itr2)
+            for (uint8 i = BG_QUEUE_PREMADE_ALLIANCE; i < BG_QUEUE_NORMAL_ALLIANCE; i++)
             {
-                // if group match conditions, then add it to pool
-                if (!(*itr2)->IsInvitedToBGInstanceGUID
-                    && (((*itr2)->ArenaMatchmakerRating >= arenaMinRating && (*itr2)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (int32)(*itr2)->JoinTime < discardTime))
-                {
-                    itr_teams[found++] = itr2;
-                    team = i;
-                    break;
-                }
+                GroupsQueueType const& groups = m_QueuedGroups[bracket_id][i];
+                auto itr = std::find_if(groups.begin(), groups.end(), [](GroupQueueInfo const* ginfo) { return !ginfo->IsInvitedToBGInstanceGUID; });
+                if (itr != groups.end() && (!team || (*itr)->JoinTime < team->JoinTime))
+                    team = *itr;
             }
+
+            if (!team)
+                return; //queues are empty
         }
 
-        if (!found)
+        GroupQueueInfo* opponent = FindRatedOpponent(team);
+        if (!opponent)
             return;
 
-        if (found == 1)
+        //we have 2 teams, then start new arena and invite players!
+        GroupQueueInfo* aTeam = team;
+        GroupQueueInfo* hTeam = opponent;
+        if (team->Team == HORDE)
+            std::swap(aTeam, hTeam);
+
+        Battleground* arena = sBattlegroundMgr->CreateNewBattleground(m_queueId, bracket_id);
+        if (!arena)
         {
-            for (GroupsQueueType::iterator itr3 = itr_teams[0]; itr3 != m_QueuedGroups[bracket_id][team].end(); ++itr3)
-            {
-                if (!(*itr3)->IsInvitedToBGInstanceGUID
-                    && (((*itr3)->ArenaMatchmakerRating >= arenaMinRating && (*itr3)->ArenaMatchmakerRating <= arenaMaxRating)
-                        || (int32)(*itr3)->JoinTime < discardTime)
-                    && (*itr_teams[0])->ArenaTeamId != (*itr3)->ArenaTeamId)
-                {
-                    itr_teams[found++] = itr3;
-                    break;
-                }
-            }
+            TC_LOG_ERROR("bg.battleground", "BattlegroundQueue::Update couldn't create arena instance for rated arena match!");
+            return;
         }
 
-        //if we have 2 teams, then start new arena and invite players!
-        if (found == 2)
+        aTeam->OpponentsTeamRating = hTeam->ArenaTeamRating;
+        hTeam->OpponentsTeamRating = aTeam->ArenaTeamRating;
+        aTeam->OpponentsMatchmakerRating = hTeam->ArenaMatchmakerRating;
+        hTeam->OpponentsMatchmakerRating = aTeam->ArenaMatchmakerRating;
+        TC_LOG_DEBUG("bg.battleground", "setting oposite teamrating for team {} to {}", aTeam->ArenaTeamId, aTeam->OpponentsTeamRating);
+        TC_LOG_DEBUG("bg.battleground", "setting oposite teamrating for team {} to {}", hTeam->ArenaTeamId, hTeam->OpponentsTeamRating);
+
+        // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
+        auto moveToQueue = [&](GroupQueueInfo* ginfo, uint32 from, uint32 to)
         {
-            GroupQueueInfo* aTeam = *itr_teams[TEAM_ALLIANCE];
-            GroupQueueInfo* hTeam = *itr_teams[TEAM_HORDE];
-            Battleground* arena = sBattlegroundMgr->CreateNewBattleground(m_queueId, bracket_id);
-            if (!arena)
-            {
-                TC_LOG_ERROR("bg.battleground", "BattlegroundQueue::Update couldn't create arena instance for rated arena match!");
-                return;
-            }
+            GroupsQueueType& source = m_QueuedGroups[bracket_id][from];
+            source.erase(std::find(source.begin(), source.end(), ginfo));
+            m_QueuedGroups[bracket_id][to].push_front(ginfo);
+        };
+
+        if (aTeam->Team != ALLIANCE)
+            moveToQueue(aTeam, BG_QUEUE_PREMADE_HORDE, BG_QUEUE_PREMADE_ALLIANCE);
+        if (hTeam->Team != HORDE)
+            moveToQueue(hTeam, BG_QUEUE_PREMADE_ALLIANCE, BG_QUEUE_PREMADE_HORDE);
+
+        arena->SetArenaMatchmakerRating(ALLIANCE, aTeam->ArenaMatchmakerRating);
+        arena->SetArenaMatchmakerRating(   HORDE, hTeam->ArenaMatchmakerRating);
+        InviteGroupToBG(aTeam, arena, ALLIANCE);
+        InviteGroupToBG(hTeam, arena, HORDE);
+
+        TC_LOG_DEBUG("bg.battleground", "Starting rated arena match!");
+        arena->StartBattleground();
+    }
+}
 
-            aTeam->OpponentsTeamRating = hTeam->ArenaTeamRating;
-            hTeam->OpponentsTeamRating = aTeam->ArenaTeamRating;
-            aTeam->OpponentsMatchmakerRating = hTeam->ArenaMatchmakerRating;
-            hTeam->OpponentsMatchmakerRating = aTeam->ArenaMatchmakerRating;
-            TC_LOG_DEBUG("bg.battleground", "setting oposite teamrating for team {} to {}", aTeam->ArenaTeamId, aTeam->OpponentsTeamRating);
-            TC_LOG_DEBUG("bg.battleground", "setting oposite teamrating for team {} to {}", hTeam->ArenaTeamId, hTeam->OpponentsTeamRating);
+void BattlegroundQueue::RemoveFromRatingIndex(GroupQueueInfo const* ginfo)
+{
+    RatedGroupsMap& groups = m_RatedGroupsByMatchmakerRating[ginfo->BracketId];
+    auto range = groups.equal_range(ginfo->ArenaMatchmakerRating);
+    for (RatedGroupsMap::iterator itr = range.first; itr != range.second; ++itr)
+    {
+        if (itr->second == ginfo)
+        {
+            groups.erase(itr);
+            return;
+        }
+    }
+}
 
-            // now we must move team if we changed its faction to another faction queue, because then we will spam log by errors in Queue::RemovePlayer
-            if (aTeam->Team != ALLIANCE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].push_front(aTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].erase(itr_teams[TEAM_ALLIANCE]);
-            }
-            if (hTeam->Team != HORDE)
-            {
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_HORDE].push_front(hTeam);
-                m_QueuedGroups[bracket_id][BG_QUEUE_PREMADE_ALLIANCE].erase(itr_teams[TEAM_HORDE]);
-            }
+uint32 BattlegroundQueue::GetRatingWindow(GroupQueueInfo const* ginfo) const
+{
+    // the window starts at the max rating difference and doubles over the rating discard timer
+    // after the discard timer ratings are not taken into account at all
+    uint32 maxDifference = sBattlegroundMgr->GetMaxRatingDifference();
+    uint32 discardTimer = sBattlegroundMgr->GetRatingDiscardTimer();
+    uint32 waitTime = getMSTimeDiff(ginfo->JoinTime, GameTime::GetGameTimeMS());
+    if (waitTime >= discardTimer)
+        return std::numeric_limits<uint32>::max();
+
+    return maxDifference + uint32(uint64(maxDifference) * waitTime / discardTimer);
+}
 
-            arena->SetArenaMatchmakerRating(ALLIANCE, aTeam->ArenaMatchmakerRating);
-            arena->SetArenaMatchmakerRating(   HORDE, hTeam->ArenaMatchmakerRating);
-            InviteGroupToBG(aTeam, arena, ALLIANCE);
-            InviteGroupToBG(hTeam, arena, HORDE);
+GroupQueueInfo* BattlegroundQueue::FindRatedOpponent(GroupQueueInfo const* ginfo) const
+{
+    RatedGroupsMap const& groups = m_RatedGroupsByMatchmakerRating[ginfo->BracketId];
+    uint32 rating = ginfo->ArenaMatchmakerRating;
+    uint32 window = GetRatingWindow(ginfo);
+
+    // walk outwards from the team's own rating so the closest opponent inside the window is found first
+    RatedGroupsMap::const_iterator above = groups.lower_bound(rating);
+    RatedGroupsMap::const_reverse_iterator below = std::make_reverse_iterator(above);
+    while (true)
+    {
+        bool hasAbove = above != groups.end() && above->first - rating <= window;
+        bool hasBelow = below != groups.rend() && rating - below->first <= window;
+        if (!hasAbove && !hasBelow)
+            return nullptr;
+
+        GroupQueueInfo* candidate;
+        if (hasAbove && (!hasBelow || above->first - rating <= rating - below->first))
+            candidate = (above++)->second;
+        else
+            candidate = (below++)->second;
 
-            TC_LOG_DEBUG("bg.battleground", "Starting rated arena match!");
-            arena->StartBattleground();
-        }
+        if (candidate != ginfo && candidate->ArenaTeamId != ginfo->ArenaTeamId)
+            return candidate;
     }
 }
 
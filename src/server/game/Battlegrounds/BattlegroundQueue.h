@@ -47,6 +47,7 @@ struct GroupQueueInfo                                       // stores informatio
     uint32  ArenaMatchmakerRating;                          // if rated match, inited to the rating of the team
     uint32  OpponentsTeamRating;                            // for rated arena matches
     uint32  OpponentsMatchmakerRating;                      // for rated arena matches
+    BattlegroundBracketId BracketId;                        // bracket of m_QueuedGroups the group is stored in
 };
 
 enum BattlegroundQueueGroupTypes
@@ -118,6 +119,10 @@ class TC_GAME_API BattlegroundQueue
             uint32 PlayerCount;
         };
 
+        // uninvited groups of rated queues ordered by matchmaker rating, to find opponents without scanning the queue
+        typedef std::multimap<uint32, GroupQueueInfo*> RatedGroupsMap;
+        RatedGroupsMap m_RatedGroupsByMatchmakerRating[MAX_BATTLEGROUND_BRACKETS];
+
         //one selection pool for horde, other one for alliance
         SelectionPool m_SelectionPools[PVP_TEAMS_COUNT];
         uint32 GetPlayersInQueue(TeamId id);
@@ -128,6 +133,10 @@ class TC_GAME_API BattlegroundQueue
         BattlegroundQueueTypeId m_queueId;
 
         bool InviteGroupToBG(GroupQueueInfo* ginfo, Battleground* bg, Team side);
+        void RemoveFromRatingIndex(GroupQueueInfo const* ginfo);
+        // rating difference accepted for the group, widens with its wait time until ratings are discarded
+        uint32 GetRatingWindow(GroupQueueInfo const* ginfo) const;
+        GroupQueueInfo* FindRatedOpponent(GroupQueueInfo const* ginfo) const;
         uint32 m_WaitTimes[PVP_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS][COUNT_OF_PLAYERS_TO_AVERAGE_WAIT_TIME];
         uint32 m_WaitTimeLastPlayer[PVP_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
         uint32 m_SumOfWaitTimes[PVP_TEAMS_COUNT][MAX_BATTLEGROUND_BRACKETS];
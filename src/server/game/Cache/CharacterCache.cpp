@@ -17,18 +17,43 @@
 
 #include "CharacterCache.h"
 #include "ArenaTeam.h"
+#include "CharacterEnumCache.h"
 #include "DatabaseEnv.h"
 #include "Log.h"
 #include "MiscPackets.h"
 #include "Player.h"
 #include "Timer.h"
+#include "Util.h"
 #include "World.h"
+#include <map>
 #include <unordered_map>
 
 namespace
 {
     std::unordered_map<ObjectGuid, CharacterCacheEntry> _characterCacheStore;
-    std::unordered_map<std::string, CharacterCacheEntry*> _characterCacheByNameStore;
+
+    // keys view the Name of the entry they point to so names are not stored twice,
+    // ordered case insensitively to allow prefix lookups
+    std::map<std::string_view, CharacterCacheEntry*, StringCompareLessI_T> _characterCacheByNameStore;
+
+    void AddNameIndex(CharacterCacheEntry& entry)
+    {
+        auto [itr, inserted] = _characterCacheByNameStore.try_emplace(entry.Name, &entry);
+        if (!inserted)
+        {
+            // the existing key views the name of the entry it was added for, replace it as well
+            _characterCacheByNameStore.erase(itr);
+            _characterCacheByNameStore.try_emplace(entry.Name, &entry);
+        }
+    }
+
+    // must be called before the name of the entry changes
+    void RemoveNameIndex(CharacterCacheEntry const& entry)
+    {
+        auto itr = _characterCacheByNameStore.find(entry.Name);
+        if (itr != _characterCacheByNameStore.end() && itr->second == &entry)
+            _characterCacheByNameStore.erase(itr);
+    }
 }
 
 CharacterCache::CharacterCache()
@@ -68,6 +93,7 @@ CharacterCache* CharacterCache::instance()
 
 void CharacterCache::LoadCharacterCacheStorage()
 {
+    _characterCacheByNameStore.clear();
     _characterCacheStore.clear();
     uint32 oldMSTime = getMSTime();
 
@@ -78,6 +104,8 @@ void CharacterCache::LoadCharacterCacheStorage()
         return;
     }
 
+    _characterCacheStore.reserve(result->GetRowCount());
+
     do
     {
         Field* fields = result->Fetch();
@@ -93,7 +121,11 @@ Modifying functions
 */
 void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accountId, std::string const& name, uint8 gender, uint8 race, uint8 playerClass, uint8 level, bool isDeleted)
 {
-    CharacterCacheEntry& data = _characterCacheStore[guid];
+    auto [itr, inserted] = _characterCacheStore.try_emplace(guid);
+    CharacterCacheEntry& data = itr->second;
+    if (!inserted)
+        RemoveNameIndex(data);
+
     data.Guid = guid;
     data.Name = name;
     data.AccountId = accountId;
@@ -108,13 +140,20 @@ void CharacterCache::AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accou
 
     // Fill Name to Guid Store
     if (!isDeleted)
-        _characterCacheByNameStore[name] = &data;
+        AddNameIndex(data);
+
+    sCharacterEnumCache->Invalidate(accountId);
 }
 
-void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& name)
+void CharacterCache::DeleteCharacterCacheEntry(ObjectGuid const& guid, std::string const& /*name*/)
 {
-    _characterCacheStore.erase(guid);
-    _characterCacheByNameStore.erase(name);
+    auto itr = _characterCacheStore.find(guid);
+    if (itr == _characterCacheStore.end())
+        return;
+
+    sCharacterEnumCache->Invalidate(itr->second.AccountId);
+    RemoveNameIndex(itr->second);
+    _characterCacheStore.erase(itr);
 }
 
 void CharacterCache::UpdateCharacterData(ObjectGuid const& guid, std::string const& name, Optional<uint8> gender /*= {}*/, Optional<uint8> race /*= {}*/)
@@ -123,7 +162,7 @@ void CharacterCache::UpdateCharacterData(ObjectGuid const& guid, std::string con
     if (itr == _characterCacheStore.end())
         return;
 
-    std::string oldName = itr->second.Name;
+    RemoveNameIndex(itr->second);
     itr->second.Name = name;
 
     if (gender)
@@ -137,8 +176,9 @@ void CharacterCache::UpdateCharacterData(ObjectGuid const& guid, std::string con
     sWorld->SendGlobalMessage(invalidatePlayer.Write());
 
     // Correct name -> pointer storage
-    _characterCacheByNameStore.erase(oldName);
-    _characterCacheByNameStore[name] = &itr->second;
+    AddNameIndex(itr->second);
+
+    sCharacterEnumCache->Invalidate(itr->second.AccountId);
 }
 
 void CharacterCache::UpdateCharacterGender(ObjectGuid const& guid, uint8 gender)
@@ -148,6 +188,7 @@ void CharacterCache::UpdateCharacterGender(ObjectGuid const& guid, uint8 gender)
         return;
 
     itr->second.Sex = gender;
+    sCharacterEnumCache->Invalidate(itr->second.AccountId);
 }
 
 void CharacterCache::UpdateCharacterLevel(ObjectGuid const& guid, uint8 level)
@@ -157,6 +198,7 @@ void CharacterCache::UpdateCharacterLevel(ObjectGuid const& guid, uint8 level)
         return;
 
     itr->second.Level = level;
+    sCharacterEnumCache->Invalidate(itr->second.AccountId);
 }
 
 void CharacterCache::UpdateCharacterAccountId(ObjectGuid const& guid, uint32 accountId)
@@ -165,6 +207,8 @@ void CharacterCache::UpdateCharacterAccountId(ObjectGuid const& guid, uint32 acc
     if (itr == _characterCacheStore.end())
         return;
 
+    sCharacterEnumCache->Invalidate(itr->second.AccountId);
+    sCharacterEnumCache->Invalidate(accountId);
     itr->second.AccountId = accountId;
 }
 
@@ -175,6 +219,7 @@ void CharacterCache::UpdateCharacterGuildId(ObjectGuid const& guid, ObjectGuid::
         return;
 
     itr->second.GuildId = guildId;
+    sCharacterEnumCache->Invalidate(itr->second.AccountId);
 }
 
 void CharacterCache::UpdateCharacterArenaTeamId(ObjectGuid const& guid, uint8 slot, uint32 arenaTeamId)
@@ -193,13 +238,15 @@ void CharacterCache::UpdateCharacterInfoDeleted(ObjectGuid const& guid, bool del
     if (itr == _characterCacheStore.end())
         return;
 
-    if (deleted)
-        _characterCacheByNameStore.erase(itr->second.Name);
-    else
-        _characterCacheByNameStore[name] = &itr->second;
+    RemoveNameIndex(itr->second);
 
     itr->second.Name = name;
     itr->second.IsDeleted = deleted;
+
+    if (!deleted)
+        AddNameIndex(itr->second);
+
+    sCharacterEnumCache->Invalidate(itr->second.AccountId);
 }
 
 /*
@@ -228,6 +275,20 @@ CharacterCacheEntry const* CharacterCache::GetCharacterCacheByName(std::string c
     return nullptr;
 }
 
+std::vector<CharacterCacheEntry const*> CharacterCache::GetCharacterCacheByNamePrefix(std::string_view prefix, std::size_t limit) const
+{
+    std::vector<CharacterCacheEntry const*> entries;
+    for (auto itr = _characterCacheByNameStore.lower_bound(prefix); itr != _characterCacheByNameStore.end() && entries.size() < limit; ++itr)
+    {
+        if (!StringStartsWithI(itr->first, prefix))
+            break;
+
+        entries.push_back(itr->second);
+    }
+
+    return entries;
+}
+
 ObjectGuid CharacterCache::GetCharacterGuidByName(std::string const& name) const
 {
     auto itr = _characterCacheByNameStore.find(name);
@@ -23,6 +23,8 @@
 #include "Optional.h"
 #include "SharedDefines.h"
 #include <string>
+#include <string_view>
+#include <vector>
 
 struct CharacterCacheEntry
 {
@@ -60,6 +62,8 @@ class TC_GAME_API CharacterCache
         bool HasCharacterCacheEntry(ObjectGuid const& guid) const;
         CharacterCacheEntry const* GetCharacterCacheByGuid(ObjectGuid const& guid) const;
         CharacterCacheEntry const* GetCharacterCacheByName(std::string const& name) const;
+        // non deleted characters whose name starts with prefix, ignoring case, in name order
+        std::vector<CharacterCacheEntry const*> GetCharacterCacheByNamePrefix(std::string_view prefix, std::size_t limit) const;
 
         ObjectGuid GetCharacterGuidByName(std::string const& name) const;
         bool GetCharacterNameByGuid(ObjectGuid guid, std::string& name) const;
@@ -0,0 +1,76 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CharacterEnumCache.h"
+#include "CharacterCache.h"
+
+CharacterEnumCache* CharacterEnumCache::instance()
+{
+    static CharacterEnumCache instance;
+    return &instance;
+}
+
+std::shared_ptr<CharacterEnumCache::CharacterList const> CharacterEnumCache::Get(uint32 accountId) const
+{
+    std::lock_guard lock(_lock);
+    auto itr = _entries.find(accountId);
+    if (itr == _entries.end())
+        return nullptr;
+
+    return itr->second.Characters;
+}
+
+uint64 CharacterEnumCache::GetStoreToken(uint32 accountId)
+{
+    std::lock_guard lock(_lock);
+    _entries.try_emplace(accountId);
+    return _invalidations;
+}
+
+void CharacterEnumCache::Store(uint32 accountId, uint64 storeToken, std::shared_ptr<CharacterList const> characters)
+{
+    std::lock_guard lock(_lock);
+    auto itr = _entries.find(accountId);
+    if (itr == _entries.end() || itr->second.InvalidatedAt > storeToken)
+        return;
+
+    itr->second.Characters = std::move(characters);
+}
+
+void CharacterEnumCache::Invalidate(uint32 accountId)
+{
+    std::lock_guard lock(_lock);
+    auto itr = _entries.find(accountId);
+    if (itr == _entries.end())
+        return;
+
+    // entries exist from the first request of the list, invalidations of other accounts have nothing to discard
+    itr->second.Characters = nullptr;
+    itr->second.InvalidatedAt = ++_invalidations;
+}
+
+void CharacterEnumCache::InvalidateCharacter(ObjectGuid const& guid)
+{
+    if (uint32 accountId = sCharacterCache->GetCharacterAccountIdByGuid(guid))
+        Invalidate(accountId);
+}
+
+void CharacterEnumCache::Remove(uint32 accountId)
+{
+    std::lock_guard lock(_lock);
+    _entries.erase(accountId);
+}
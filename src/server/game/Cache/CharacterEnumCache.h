@@ -0,0 +1,61 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CharacterEnumCache_h__
+#define CharacterEnumCache_h__
+
+#include "CharacterPackets.h"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Character lists shown at character select, kept per account while its session is connected
+// so returning to character select does not query the database again
+// Anything changing what the list shows (saves, renames, customizations, deletions, bans...) must invalidate the account
+class TC_GAME_API CharacterEnumCache
+{
+    public:
+        using CharacterList = std::vector<WorldPackets::Character::EnumCharactersResult::CharacterInfo>;
+
+        static CharacterEnumCache* instance();
+
+        std::shared_ptr<CharacterList const> Get(uint32 accountId) const;
+
+        // to be taken before the list is queried and passed to Store, a list loaded while the account was invalidated is not stored
+        uint64 GetStoreToken(uint32 accountId);
+        void Store(uint32 accountId, uint64 storeToken, std::shared_ptr<CharacterList const> characters);
+
+        void Invalidate(uint32 accountId);
+        void InvalidateCharacter(ObjectGuid const& guid);
+        void Remove(uint32 accountId);
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<CharacterList const> Characters;
+            uint64 InvalidatedAt = 0;
+        };
+
+        mutable std::mutex _lock;
+        std::unordered_map<uint32, Entry> _entries;
+        uint64 _invalidations = 0;
+};
+
+#define sCharacterEnumCache CharacterEnumCache::instance()
+
+#endif // CharacterEnumCache_h__
@@ -94,6 +94,7 @@ void CalendarMgr::LoadFromDB()
 
             CalendarEvent* calendarEvent = new CalendarEvent(eventID, ownerGUID, guildID, type, textureID, date, flags, title, description, lockDate);
             _events.insert(calendarEvent);
+            _eventsById[eventID] = calendarEvent;
 
             _maxEventId = std::max(_maxEventId, eventID);
 
@@ -122,6 +123,7 @@ void CalendarMgr::LoadFromDB()
 
             CalendarInvite* invite = new CalendarInvite(inviteId, eventId, invitee, senderGUID, responseTime, status, rank, note);
             _invites[eventId].push_back(invite);
+            AddInviteToIndex(invite);
 
             _maxInviteId = std::max(_maxInviteId, inviteId);
 
@@ -132,17 +134,37 @@ void CalendarMgr::LoadFromDB()
     TC_LOG_INFO("server.loading", ">> Loaded {} calendar invites in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
 
     for (uint64 i = 1; i < _maxEventId; ++i)
-        if (!GetEvent(i))
+        if (!_eventsById.contains(i))
             _freeEventIds.push_back(i);
 
     for (uint64 i = 1; i < _maxInviteId; ++i)
-        if (!GetInvite(i))
+        if (!_invitesById.contains(i))
             _freeInviteIds.push_back(i);
 }
 
+void CalendarMgr::AddInviteToIndex(CalendarInvite* invite)
+{
+    _invitesById[invite->GetInviteId()] = invite;
+    _playerInvites[invite->GetInviteeGUID()].push_back(invite);
+}
+
+void CalendarMgr::RemoveInviteFromIndex(CalendarInvite const* invite)
+{
+    _invitesById.erase(invite->GetInviteId());
+
+    auto itr = _playerInvites.find(invite->GetInviteeGUID());
+    if (itr == _playerInvites.end())
+        return;
+
+    std::erase(itr->second, invite);
+    if (itr->second.empty())
+        _playerInvites.erase(itr);
+}
+
 void CalendarMgr::AddEvent(CalendarEvent* calendarEvent, CalendarSendEventType sendType)
 {
     _events.insert(calendarEvent);
+    _eventsById[calendarEvent->GetEventId()] = calendarEvent;
     UpdateEvent(calendarEvent);
     SendCalendarEvent(calendarEvent->GetOwnerGUID(), *calendarEvent, sendType);
 }
@@ -158,6 +180,7 @@ void CalendarMgr::AddInvite(CalendarEvent* calendarEvent, CalendarInvite* invite
     if (!calendarEvent->IsGuildAnnouncement())
     {
         _invites[invite->GetEventId()].push_back(invite);
+        AddInviteToIndex(invite);
         UpdateInvite(invite, trans);
     }
 }
@@ -204,6 +227,7 @@ void CalendarMgr::RemoveEvent(CalendarEvent* calendarEvent, ObjectGuid remover)
             mail.SendMailTo(trans, MailReceiver(invite->GetInviteeGUID().GetCounter()), calendarEvent, MAIL_CHECK_MASK_COPIED);
         }
 
+        RemoveInviteFromIndex(invite);
         delete invite;
     }
 
@@ -215,6 +239,7 @@ void CalendarMgr::RemoveEvent(CalendarEvent* calendarEvent, ObjectGuid remover)
     CharacterDatabase.CommitTransaction(trans);
 
     _events.erase(calendarEvent);
+    _eventsById.erase(calendarEvent->GetEventId());
     delete calendarEvent;
 }
 
@@ -249,6 +274,7 @@ void CalendarMgr::RemoveInvite(uint64 inviteId, uint64 eventId, ObjectGuid /*rem
     //    MailDraft(calendarEvent->BuildCalendarMailSubject(remover), calendarEvent->BuildCalendarMailBody())
     //        .SendMailTo(trans, MailReceiver((*itr)->GetInvitee()), calendarEvent, MAIL_CHECK_MASK_COPIED);
 
+    RemoveInviteFromIndex(*itr);
     delete *itr;
     _invites[eventId].erase(itr);
 }
@@ -299,9 +325,13 @@ void CalendarMgr::RemoveAllPlayerEventsAndInvites(ObjectGuid guid)
 
 void CalendarMgr::RemovePlayerGuildEventsAndSignups(ObjectGuid guid, ObjectGuid::LowType guildId)
 {
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end(); ++itr)
-        if ((*itr)->GetOwnerGUID() == guid && ((*itr)->IsGuildEvent() || (*itr)->IsGuildAnnouncement()))
-            RemoveEvent((*itr)->GetEventId(), guid);
+    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end();)
+    {
+        CalendarEvent* event = *itr;
+        ++itr;
+        if (event->GetOwnerGUID() == guid && (event->IsGuildEvent() || event->IsGuildAnnouncement()))
+            RemoveEvent(event, guid);
+    }
 
     CalendarInviteStore playerInvites = GetPlayerInvites(guid);
     for (CalendarInviteStore::const_iterator itr = playerInvites.begin(); itr != playerInvites.end(); ++itr)
@@ -312,9 +342,8 @@ void CalendarMgr::RemovePlayerGuildEventsAndSignups(ObjectGuid guid, ObjectGuid:
 
 CalendarEvent* CalendarMgr::GetEvent(uint64 eventId) const
 {
-    for (CalendarEventStore::const_iterator itr = _events.begin(); itr != _events.end(); ++itr)
-        if ((*itr)->GetEventId() == eventId)
-            return *itr;
+    if (CalendarEvent* calendarEvent = Trinity::Containers::MapGetValuePtr(_eventsById, eventId))
+        return calendarEvent;
 
     TC_LOG_DEBUG("calendar", "CalendarMgr::GetEvent: [{}] not found!", eventId);
     return nullptr;
@@ -322,10 +351,8 @@ CalendarEvent* CalendarMgr::GetEvent(uint64 eventId) const
 
 CalendarInvite* CalendarMgr::GetInvite(uint64 inviteId) const
 {
-    for (CalendarEventInviteStore::const_iterator itr = _invites.begin(); itr != _invites.end(); ++itr)
-        for (CalendarInviteStore::const_iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); ++itr2)
-            if ((*itr2)->GetInviteId() == inviteId)
-                return *itr2;
+    if (CalendarInvite* invite = Trinity::Containers::MapGetValuePtr(_invitesById, inviteId))
+        return invite;
 
     TC_LOG_DEBUG("calendar", "CalendarMgr::GetInvite: [{}] not found!", inviteId);
     return nullptr;
@@ -409,11 +436,10 @@ CalendarEventStore CalendarMgr::GetPlayerEvents(ObjectGuid guid) const
 {
     CalendarEventStore events;
 
-    for (CalendarEventInviteStore::const_iterator itr = _invites.begin(); itr != _invites.end(); ++itr)
-        for (CalendarInviteStore::const_iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); ++itr2)
-            if ((*itr2)->GetInviteeGUID() == guid)
-                if (CalendarEvent* event = GetEvent(itr->first)) // NULL check added as attempt to fix #11512
-                    events.insert(event);
+    if (CalendarInviteStore const* invites = Trinity::Containers::MapGetValuePtr(_playerInvites, guid))
+        for (CalendarInvite const* invite : *invites)
+            if (CalendarEvent* event = GetEvent(invite->GetEventId())) // NULL check added as attempt to fix #11512
+                events.insert(event);
 
     if (Player* player = ObjectAccessor::FindConnectedPlayer(guid))
         if (player->GetGuildId())
@@ -436,11 +462,8 @@ CalendarInviteStore CalendarMgr::GetEventInvites(uint64 eventId) const
 CalendarInviteStore CalendarMgr::GetPlayerInvites(ObjectGuid guid) const
 {
     CalendarInviteStore invites;
-
-    for (CalendarEventInviteStore::const_iterator itr = _invites.begin(); itr != _invites.end(); ++itr)
-        for (CalendarInviteStore::const_iterator itr2 = itr->second.begin(); itr2 != itr->second.end(); ++itr2)
-            if ((*itr2)->GetInviteeGUID() == guid)
-                invites.push_back(*itr2);
+    if (CalendarInviteStore const* invitesStore = Trinity::Containers::MapGetValuePtr(_playerInvites, guid))
+        invites = *invitesStore;
 
     return invites;
 }
@@ -24,6 +24,7 @@
 #include <deque>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 class Player;
@@ -303,6 +304,14 @@ class TC_GAME_API CalendarMgr
         CalendarEventStore _events;
         CalendarEventInviteStore _invites;
 
+        // lookup indexes over _events and _invites
+        std::unordered_map<uint64, CalendarEvent*> _eventsById;
+        std::unordered_map<uint64, CalendarInvite*> _invitesById;
+        std::unordered_map<ObjectGuid, CalendarInviteStore> _playerInvites;
+
+        void AddInviteToIndex(CalendarInvite* invite);
+        void RemoveInviteFromIndex(CalendarInvite const* invite);
+
         std::deque<uint64> _freeEventIds;
         std::deque<uint64> _freeInviteIds;
         uint64 _maxEventId;
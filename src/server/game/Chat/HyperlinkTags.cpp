@@ -301,7 +301,8 @@ bool Trinity::Hyperlinks::LinkTags::item::StoreTo(ItemLinkData& val, std::string
 
     if (!val.ItemBonusListIDs.empty() && val.ItemBonusListIDs[0] == 3524) // default uninitialized bonus
     {
-        val.ItemBonusListIDs = ItemBonusMgr::GetBonusListsForItem(itemId, ItemContext(val.Context));
+        std::span<int32 const> bonusListIDs = ItemBonusMgr::GetBonusListsForItem(itemId, ItemContext(val.Context));
+        val.ItemBonusListIDs.assign(bonusListIDs.begin(), bonusListIDs.end());
 
         // reset bonuses
         evaluatedBonus.Initialize(val.Item);
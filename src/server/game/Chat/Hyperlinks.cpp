@@ -21,6 +21,7 @@
 #include "Errors.h"
 #include "ItemTemplate.h"
 #include "ObjectMgr.h"
+#include "Optional.h"
 #include "QuestDef.h"
 #include "SharedDefines.h"
 #include "SpellInfo.h"
@@ -736,12 +737,69 @@ static bool ValidateLinkInfo(HyperlinkInfo const& info)
     return false;
 }
 
+// Results of recently validated item links, trade chat links the same few items over and over
+// Kept per thread, entries keep their string capacity so a warm cache validates repeated links without allocating
+class ItemLinkCache
+{
+public:
+    static constexpr std::size_t Size = 256;
+
+    Optional<bool> Find(std::string_view link, int32 severity) const
+    {
+        Entry const& entry = _entries[GetIndex(link)];
+        if (entry.Severity != severity || entry.Link != link)
+            return {};
+
+        return entry.Valid;
+    }
+
+    void Store(std::string_view link, int32 severity, bool valid)
+    {
+        Entry& entry = _entries[GetIndex(link)];
+        entry.Link.assign(link);
+        entry.Severity = severity;
+        entry.Valid = valid;
+    }
+
+private:
+    struct Entry
+    {
+        std::string Link;
+        int32 Severity = 0;
+        bool Valid = false;
+    };
+
+    static std::size_t GetIndex(std::string_view link) { return std::hash<std::string_view>()(link) % Size; }
+
+    std::array<Entry, Size> _entries;
+};
+
+static bool ValidateLinkInfoCached(HyperlinkInfo const& info, std::string_view link)
+{
+    if (info.tag != LinkTags::item::tag())
+        return ValidateLinkInfo(info);
+
+    thread_local ItemLinkCache cache;
+    int32 const severity = static_cast<int32>(sWorld->getIntConfig(CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY));
+    if (Optional<bool> valid = cache.Find(link, severity))
+        return *valid;
+
+    bool valid = ValidateLinkInfo(info);
+    cache.Store(link, severity, valid);
+    return valid;
+}
+
 // Validates all hyperlinks and control sequences contained in str
 bool Trinity::Hyperlinks::CheckAllLinks(std::string_view str)
 {
+    // most messages contain no control sequence at all, find (memchr) is already vectorized
+    std::string_view::size_type first = str.find('|');
+    if (first == std::string_view::npos)
+        return true;
+
     // Step 1: Disallow all control sequences except ||, |H, |h, |c and |r
     {
-        std::string_view::size_type pos = 0;
+        std::string_view::size_type pos = first;
         while ((pos = str.find('|', pos)) != std::string::npos)
         {
             ++pos;
@@ -762,8 +820,8 @@ bool Trinity::Hyperlinks::CheckAllLinks(std::string_view str)
     // - <linkdata> is arbitrary length, no | contained
     // - <linktext> is printable
     {
-        std::string::size_type pos;
-        while ((pos = str.find('|')) != std::string::npos)
+        std::string::size_type pos = first;
+        do
         {
             if (str[pos + 1] == '|') // this is an escaped pipe character (||)
             {
@@ -771,13 +829,14 @@ bool Trinity::Hyperlinks::CheckAllLinks(std::string_view str)
                 continue;
             }
 
-            HyperlinkInfo info = ParseSingleHyperlink(str.substr(pos));
-            if (!info || !ValidateLinkInfo(info))
+            std::string_view link = str.substr(pos);
+            HyperlinkInfo info = ParseSingleHyperlink(link);
+            if (!info || !ValidateLinkInfoCached(info, link.substr(0, link.length() - info.tail.length())))
                 return false;
 
             // tag is fine, find the next one
             str = info.tail;
-        }
+        } while ((pos = str.find('|')) != std::string::npos);
     }
 
     // all tags are valid
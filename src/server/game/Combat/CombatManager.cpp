@@ -20,6 +20,7 @@
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "Player.h"
+#include "ThreadLocalPool.h"
 
 /*static*/ bool CombatManager::CanBeginCombat(Unit const* a, Unit const* b)
 {
@@ -82,7 +83,20 @@ void CombatReference::EndCombat()
             secondAI->JustExitedCombat();
 
     // ...and finally clean up the reference object
-    delete this;
+    if (_isPvP)
+        delete static_cast<PvPCombatReference*>(this);
+    else
+        delete this;
+}
+
+void* CombatReference::operator new(std::size_t size)
+{
+    return Trinity::ThreadLocalAllocationPool<CombatReference>::Allocate(size);
+}
+
+void CombatReference::operator delete(void* ptr, std::size_t size) noexcept
+{
+    Trinity::ThreadLocalAllocationPool<CombatReference>::Deallocate(ptr, size);
 }
 
 void CombatReference::Refresh()
@@ -126,6 +140,16 @@ void PvPCombatReference::RefreshTimer()
     _combatTimer = PVP_COMBAT_TIMEOUT;
 }
 
+void* PvPCombatReference::operator new(std::size_t size)
+{
+    return Trinity::ThreadLocalAllocationPool<PvPCombatReference>::Allocate(size);
+}
+
+void PvPCombatReference::operator delete(void* ptr, std::size_t size) noexcept
+{
+    Trinity::ThreadLocalAllocationPool<PvPCombatReference>::Deallocate(ptr, size);
+}
+
 CombatManager::~CombatManager()
 {
     ASSERT(_pveRefs.empty(), "CombatManager::~CombatManager - %s: we still have %zu PvE combat references, one of them is with %s", _owner->GetGUID().ToString().c_str(), _pveRefs.size(), _pveRefs.begin()->first.ToString().c_str());
@@ -66,6 +66,10 @@ struct TC_GAME_API CombatReference
     CombatReference(CombatReference const&) = delete;
     CombatReference& operator=(CombatReference const&) = delete;
 
+    // references are created and ended at high rates in AoE pulls, blocks are reused per thread
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+
 protected:
     CombatReference(Unit* a, Unit* b, bool pvp = false) : first(a), second(b), _isPvP(pvp) { }
 
@@ -83,6 +87,9 @@ struct TC_GAME_API PvPCombatReference : public CombatReference
 {
     static const uint32 PVP_COMBAT_TIMEOUT = 5 * IN_MILLISECONDS;
 
+    static void* operator new(std::size_t size);
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+
 private:
     PvPCombatReference(Unit* first, Unit* second) : CombatReference(first, second, true) { }
 
@@ -27,11 +27,14 @@
 #include "SpellAuraEffects.h"
 #include "SpellMgr.h"
 #include "TemporarySummon.h"
+#include "ThreadLocalPool.h"
+#include <algorithm>
 #include <boost/heap/fibonacci_heap.hpp>
 
 const CompareThreatLessThan ThreatManager::CompareThreat;
 
-class ThreatManager::Heap : public boost::heap::fibonacci_heap<ThreatReference const*, boost::heap::compare<CompareThreatLessThan>>
+class ThreatManager::Heap : public boost::heap::fibonacci_heap<ThreatReference const*, boost::heap::compare<CompareThreatLessThan>,
+    boost::heap::allocator<Trinity::ThreadLocalPoolAllocator<ThreatReference const*>>>
 {
 };
 
@@ -154,9 +157,13 @@ void ThreatReference::UnregisterAndFree()
 class ThreatReferenceImpl : public ThreatReference
 {
 public:
-    explicit ThreatReferenceImpl(ThreatManager* mgr, Unit* victim) : ThreatReference(mgr, victim) { }
+    explicit ThreatReferenceImpl(ThreatManager* mgr, Unit* victim) : ThreatReference(mgr, victim), _heapUpdatePending(false) { }
+
+    static void* operator new(std::size_t size) { return Trinity::ThreadLocalAllocationPool<ThreatReferenceImpl>::Allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) noexcept { Trinity::ThreadLocalAllocationPool<ThreatReferenceImpl>::Deallocate(ptr, size); }
 
     ThreatManager::Heap::handle_type _handle;
+    bool _heapUpdatePending;
 };
 
 void ThreatReference::HeapNotifyIncreased()
@@ -166,7 +173,13 @@ void ThreatReference::HeapNotifyIncreased()
 
 void ThreatReference::HeapNotifyDecreased()
 {
-    _mgr._sortedThreatList->decrease(static_cast<ThreatReferenceImpl*>(this)->_handle);
+    // unlike increases, decreases restructure the heap - collect them until the order is needed next
+    ThreatReferenceImpl* impl = static_cast<ThreatReferenceImpl*>(this);
+    if (impl->_heapUpdatePending)
+        return;
+
+    impl->_heapUpdatePending = true;
+    _mgr._pendingHeapUpdates.push_back(this);
 }
 
 /*static*/ bool ThreatManager::CanHaveThreatList(Unit const* who)
@@ -306,6 +319,7 @@ Trinity::IteratorPair<ThreatManager::ThreatListIterator, std::nullptr_t> ThreatM
 
 Trinity::IteratorPair<ThreatManager::ThreatListIterator, std::nullptr_t> ThreatManager::GetSortedThreatList() const
 {
+    ApplyPendingHeapUpdates();
     auto itr = _sortedThreatList->ordered_begin();
     auto end = _sortedThreatList->ordered_end();
     std::function<ThreatReference const* ()> generator = [itr, end]() mutable -> ThreatReference const*
@@ -320,6 +334,7 @@ Trinity::IteratorPair<ThreatManager::ThreatListIterator, std::nullptr_t> ThreatM
 
 std::vector<ThreatReference*> ThreatManager::GetModifiableThreatList()
 {
+    ApplyPendingHeapUpdates();
     std::vector<ThreatReference*> list;
     list.reserve(_myThreatListEntries.size());
     for (auto it = _sortedThreatList->ordered_begin(), end = _sortedThreatList->ordered_end(); it != end; ++it)
@@ -490,6 +505,7 @@ void ThreatManager::MatchUnitThreatToHighestThreat(Unit* target)
     if (_sortedThreatList->empty())
         return;
 
+    ApplyPendingHeapUpdates();
     auto it = _sortedThreatList->ordered_begin(), end = _sortedThreatList->ordered_end();
     ThreatReference const* highest = *it;
     if (!highest->IsAvailable())
@@ -605,6 +621,8 @@ ThreatReference const* ThreatManager::ReselectVictim()
     for (auto const& pair : _myThreatListEntries)
         pair.second->UpdateOffline(); // AI notifies are processed in ::UpdateVictim caller
 
+    ApplyPendingHeapUpdates();
+
     // fixated target is always preferred
     if (_fixateRef && _fixateRef->IsAvailable())
         return _fixateRef;
@@ -830,6 +848,7 @@ void ThreatManager::SendClearAllThreatToClients() const
     if (Creature const* owner = _owner->ToCreature(); owner && owner->IsThreatFeedbackDisabled())
         return;
 
+    _lastSentThreatList.clear();
     WorldPackets::Combat::ThreatClear threatClear;
     threatClear.UnitGUID = _owner->GetGUID();
     _owner->SendMessageToSet(threatClear.Write(), false);
@@ -840,6 +859,7 @@ void ThreatManager::SendRemoveToClients(Unit const* victim) const
     if (Creature const* owner = _owner->ToCreature(); owner && owner->IsThreatFeedbackDisabled())
         return;
 
+    _lastSentThreatList.clear();
     WorldPackets::Combat::ThreatRemove threatRemove;
     threatRemove.UnitGUID = _owner->GetGUID();
     threatRemove.AboutGUID = victim->GetGUID();
@@ -851,7 +871,7 @@ void ThreatManager::SendThreatListToClients(bool newHighest) const
     if (Creature const* owner = _owner->ToCreature(); owner && owner->IsThreatFeedbackDisabled())
         return;
 
-    auto fillSharedPacketDataAndSend = [&](auto& packet)
+    auto fillSharedPacketDataAndSend = [&](auto& packet, bool skipIfUnchanged)
     {
         packet.UnitGUID = _owner->GetGUID();
         packet.ThreatList.reserve(_sortedThreatList->size());
@@ -865,6 +885,17 @@ void ThreatManager::SendThreatListToClients(bool newHighest) const
             threatInfo.Threat = int64(ref->GetThreat() * 100);
             packet.ThreatList.push_back(threatInfo);
         }
+
+        if (skipIfUnchanged && std::ranges::equal(packet.ThreatList, _lastSentThreatList, [](WorldPackets::Combat::ThreatInfo const& info, std::pair<ObjectGuid, int64> const& sent)
+        {
+            return info.UnitGUID == sent.first && info.Threat == sent.second;
+        }))
+            return;
+
+        _lastSentThreatList.clear();
+        for (WorldPackets::Combat::ThreatInfo const& threatInfo : packet.ThreatList)
+            _lastSentThreatList.emplace_back(threatInfo.UnitGUID, threatInfo.Threat);
+
         _owner->SendMessageToSet(packet.Write(), false);
     };
 
@@ -872,12 +903,12 @@ void ThreatManager::SendThreatListToClients(bool newHighest) const
     {
         WorldPackets::Combat::HighestThreatUpdate highestThreatUpdate;
         highestThreatUpdate.HighestThreatGUID = _currentVictimRef->GetVictim()->GetGUID();
-        fillSharedPacketDataAndSend(highestThreatUpdate);
+        fillSharedPacketDataAndSend(highestThreatUpdate, false);
     }
     else
     {
         WorldPackets::Combat::ThreatUpdate threatUpdate;
-        fillSharedPacketDataAndSend(threatUpdate);
+        fillSharedPacketDataAndSend(threatUpdate, true);
     }
 }
 
@@ -897,6 +928,8 @@ void ThreatManager::PurgeThreatListRef(ObjectGuid const& guid)
         return;
     ThreatReference* ref = it->second;
     _myThreatListEntries.erase(it);
+    if (static_cast<ThreatReferenceImpl*>(ref)->_heapUpdatePending)
+        std::erase(_pendingHeapUpdates, ref);
     _sortedThreatList->erase(static_cast<ThreatReferenceImpl*>(ref)->_handle);
 
     if (_fixateRef == ref)
@@ -905,6 +938,22 @@ void ThreatManager::PurgeThreatListRef(ObjectGuid const& guid)
         _currentVictimRef = nullptr;
 }
 
+void ThreatManager::ApplyPendingHeapUpdates() const
+{
+    if (_pendingHeapUpdates.empty())
+        return;
+
+    // detach every decreased reference from its parent and children first, consolidating the root list once afterwards
+    for (ThreatReference* ref : _pendingHeapUpdates)
+    {
+        static_cast<ThreatReferenceImpl*>(ref)->_heapUpdatePending = false;
+        _sortedThreatList->update_lazy(static_cast<ThreatReferenceImpl*>(ref)->_handle);
+    }
+
+    _sortedThreatList->update(static_cast<ThreatReferenceImpl*>(_pendingHeapUpdates.back())->_handle);
+    _pendingHeapUpdates.clear();
+}
+
 void ThreatManager::PutThreatenedByMeRef(ObjectGuid const& guid, ThreatReference* ref)
 {
     auto& inMap = _threatenedByMe[guid];
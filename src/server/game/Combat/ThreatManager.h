@@ -205,6 +205,13 @@ class TC_GAME_API ThreatManager
         std::unique_ptr<Heap> _sortedThreatList;
         std::unordered_map<ObjectGuid, ThreatReference*> _myThreatListEntries;
 
+        // references with decreased threat are re-sorted in one batch before the heap order is read next
+        void ApplyPendingHeapUpdates() const;
+        mutable std::vector<ThreatReference*> _pendingHeapUpdates;
+
+        // (victim, threat) as last sent to clients, unchanged lists are not sent again
+        mutable std::vector<std::pair<ObjectGuid, int64>> _lastSentThreatList;
+
         // AI notifies are delayed to ensure we are in a consistent state before we call out to arbitrary logic
         // threat references might register themselves here when ::UpdateOffline() is called - MAKE SURE THIS IS PROCESSED JUST BEFORE YOU EXIT THREATMANAGER LOGIC
         void ProcessAIUpdates();
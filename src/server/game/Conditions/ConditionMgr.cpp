@@ -54,6 +54,7 @@
 #include "WorldSession.h"
 #include "WorldStateMgr.h"
 #include "WowTime.h"
+#include <boost/container/small_vector.hpp>
 #include <random>
 #include <sstream>
 
@@ -997,24 +998,34 @@ uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionContainer cons
 
 bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionContainer const& conditions) const
 {
-    //     groupId, groupCheckPassed
-    std::map<uint32, bool> elseGroupStore;
+    //     groupId, groupCheckPassed - lists rarely have more than a few else groups
+    boost::container::small_vector<std::pair<uint32, bool>, 4> elseGroupStore;
     for (Condition const& condition : conditions)
     {
         TC_LOG_DEBUG("condition", "ConditionMgr::IsPlayerMeetToConditionList {} val1: {}", condition.ToString(), condition.ConditionValue1);
         if (condition.isLoaded())
         {
             //! Find ElseGroup in ElseGroupStore
-            std::map<uint32, bool>::iterator itr = elseGroupStore.try_emplace(condition.ElseGroup, true).first;
+            auto itr = std::ranges::find(elseGroupStore, condition.ElseGroup, &std::pair<uint32, bool>::first);
+            if (itr == elseGroupStore.end())
+                itr = elseGroupStore.emplace(elseGroupStore.end(), condition.ElseGroup, true);
+
             if (!itr->second) //! If another condition in this group was unmatched before this, don't bother checking (the group is false anyway)
                 continue;
 
             if (condition.ReferenceId)//handle reference
             {
-                auto ref = ConditionStore[CONDITION_SOURCE_TYPE_REFERENCE_CONDITION].find({ condition.ReferenceId, 0, 0 });
-                if (ref != ConditionStore[CONDITION_SOURCE_TYPE_REFERENCE_CONDITION].end())
+                ConditionContainer const* reference = condition.Reference;
+                if (!reference) // copies made while loading were not resolved
+                {
+                    auto ref = ConditionStore[CONDITION_SOURCE_TYPE_REFERENCE_CONDITION].find({ condition.ReferenceId, 0, 0 });
+                    if (ref != ConditionStore[CONDITION_SOURCE_TYPE_REFERENCE_CONDITION].end())
+                        reference = ref->second.get();
+                }
+
+                if (reference)
                 {
-                    if (!IsObjectMeetToConditionList(sourceInfo, *ref->second))
+                    if (!IsObjectMeetToConditionList(sourceInfo, *reference))
                         itr->second = false;
                 }
                 else
@@ -1031,11 +1042,7 @@ bool ConditionMgr::IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo,
             }
         }
     }
-    for (std::map<uint32, bool>::const_iterator i = elseGroupStore.begin(); i != elseGroupStore.end(); ++i)
-        if (i->second)
-            return true;
-
-    return false;
+    return std::ranges::any_of(elseGroupStore, [](std::pair<uint32, bool> const& group) { return group.second; });
 }
 
 bool ConditionMgr::IsObjectMeetToConditions(WorldObject const* object, ConditionContainer const& conditions) const
@@ -1266,6 +1273,7 @@ void ConditionMgr::LoadConditions(bool isReload)
         sSpellMgr->UnloadSpellInfoImplicitTargetConditionLists();
 
         sObjectMgr->UnloadPhaseConditions();
+        sObjectMgr->InvalidateQuestGiverStatuses();
     }
 
     QueryResult result = WorldDatabase.Query("SELECT SourceTypeOrReferenceId, SourceGroup, SourceEntry, SourceId, ElseGroup, ConditionTypeOrReference, ConditionTarget, "
@@ -1483,6 +1491,23 @@ void ConditionMgr::LoadConditions(bool isReload)
         }
     }
 
+    // resolve references once, evaluation follows the pointer instead of looking them up every time
+    for (ConditionsByEntryMap& conditionsByEntry : ConditionStore)
+    {
+        for (auto const& [id, conditions] : conditionsByEntry)
+        {
+            for (Condition& condition : *conditions)
+            {
+                if (!condition.ReferenceId)
+                    continue;
+
+                auto ref = ConditionStore[CONDITION_SOURCE_TYPE_REFERENCE_CONDITION].find({ condition.ReferenceId, 0, 0 });
+                if (ref != ConditionStore[CONDITION_SOURCE_TYPE_REFERENCE_CONDITION].end())
+                    condition.Reference = ref->second.get();
+            }
+        }
+    }
+
     TC_LOG_INFO("server.loading", ">> Loaded {} conditions in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -257,6 +257,7 @@ struct TC_GAME_API Condition
     uint32                  ErrorType;
     uint32                  ErrorTextId;
     uint32                  ReferenceId;
+    std::vector<Condition> const* Reference;   // resolved ReferenceId, set after all conditions are loaded
     uint32                  ScriptId;
     uint8                   ConditionTarget;
     bool                    NegativeCondition;
@@ -274,6 +275,7 @@ struct TC_GAME_API Condition
         ConditionValue2    = 0;
         ConditionValue3    = 0;
         ReferenceId        = 0;
+        Reference          = nullptr;
         ErrorType          = 0;
         ErrorTextId        = 0;
         ScriptId           = 0;
@@ -64,6 +64,8 @@ void LoadDisables()
     for (std::size_t i = 0; i < m_DisableMap.size(); ++i)
         m_DisableMap[i].clear();
 
+    sObjectMgr->InvalidateQuestGiverStatuses();
+
     QueryResult result = WorldDatabase.Query("SELECT sourceType, entry, flags, params_0, params_1 FROM disables");
 
     uint32 total_count = 0;
@@ -16,15 +16,19 @@
  */
 
 #include "DB2Stores.h"
+#include "ByteBuffer.h"
 #include "Containers.h"
 #include "DatabaseEnv.h"
 #include "DB2LoadInfo.h"
+#include "FlatHashMap.h"
 #include "Hash.h"
 #include "ItemTemplate.h"
 #include "IteratorPair.h"
 #include "Log.h"
+#include "MemoryUsage.h"
 #include "Random.h"
 #include "Regex.h"
+#include "TaskGraph.h"
 #include "Timer.h"
 #include "Util.h"
 #include "World.h"
@@ -32,6 +36,7 @@
 #include <boost/filesystem/operations.hpp>
 #include <array>
 #include <bitset>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <cctype>
@@ -402,13 +407,13 @@ typedef ChrSpecializationEntry const* ChrSpecializationByIndexContainer[MAX_CLAS
 typedef std::unordered_map<uint32 /*curveID*/, std::vector<DBCPosition2D>> CurvePointsContainer;
 typedef std::map<std::tuple<uint32, uint8, uint8, uint8>, EmotesTextSoundEntry const*> EmotesTextSoundContainer;
 typedef std::unordered_map<uint32, std::vector<uint32>> FactionTeamContainer;
-typedef std::unordered_map<uint32, HeirloomEntry const*> HeirloomItemsContainer;
+typedef Trinity::Containers::FlatHashMap<uint32, HeirloomEntry const*> HeirloomItemsContainer;
 typedef std::unordered_map<uint32 /*glyphPropertiesId*/, std::vector<uint32>> GlyphBindableSpellsContainer;
 typedef std::unordered_map<uint32 /*glyphPropertiesId*/, std::vector<ChrSpecialization>> GlyphRequiredSpecsContainer;
-typedef std::unordered_map<uint32 /*itemId*/, ItemChildEquipmentEntry const*> ItemChildEquipmentContainer;
+typedef Trinity::Containers::FlatHashMap<uint32 /*itemId*/, ItemChildEquipmentEntry const*> ItemChildEquipmentContainer;
 typedef std::array<ItemClassEntry const*, 20> ItemClassByOldEnumContainer;
 typedef std::unordered_map<uint32, std::vector<ItemLimitCategoryConditionEntry const*>> ItemLimitCategoryConditionContainer;
-typedef std::unordered_map<uint32 /*itemId | appearanceMod << 24*/, ItemModifiedAppearanceEntry const*> ItemModifiedAppearanceByItemContainer;
+typedef Trinity::Containers::FlatHashMap<uint32 /*itemId | appearanceMod << 24*/, ItemModifiedAppearanceEntry const*> ItemModifiedAppearanceByItemContainer;
 typedef std::unordered_map<uint32, std::vector<ItemSetSpellEntry const*>> ItemSetSpellContainer;
 typedef std::unordered_map<uint32, std::vector<ItemSpecOverrideEntry const*>> ItemSpecOverridesContainer;
 typedef std::unordered_map<uint32, std::unordered_map<uint32, MapDifficultyEntry const*>> MapDifficultyContainer;
@@ -426,8 +431,13 @@ typedef std::unordered_map<uint32, std::unordered_map<uint32, std::vector<SpellP
 typedef std::unordered_map<uint32, std::vector<SpellProcsPerMinuteModEntry const*>> SpellProcsPerMinuteModContainer;
 typedef std::vector<TalentEntry const*> TalentsByPosition[MAX_CLASSES][MAX_TALENT_TIERS][MAX_TALENT_COLUMNS];
 typedef std::unordered_set<uint32> ToyItemIdsContainer;
-typedef std::tuple<uint16, uint8, int32> WMOAreaTableKey;
-typedef std::map<WMOAreaTableKey, WMOAreaTableEntry const*> WMOAreaTableLookupContainer;
+typedef uint64 /*wmoId << 40 | nameSetId << 32 | wmoGroupId*/ WMOAreaTableKey;
+typedef Trinity::Containers::FlatHashMap<WMOAreaTableKey, WMOAreaTableEntry const*> WMOAreaTableLookupContainer;
+
+inline WMOAreaTableKey MakeWMOAreaTableKey(uint16 wmoId, uint8 nameSetId, int32 wmoGroupId)
+{
+    return (uint64(wmoId) << 40) | (uint64(nameSetId) << 32) | uint32(wmoGroupId);
+}
 typedef std::pair<uint32 /*tableHash*/, int32 /*recordId*/> HotfixBlobKey;
 typedef std::map<HotfixBlobKey, std::vector<uint8>> HotfixBlobMap;
 using AllowedHotfixOptionalData = std::pair<uint32 /*optional data key*/, bool(*)(std::vector<uint8> const& data) /*validator*/>;
@@ -447,6 +457,7 @@ namespace
     std::array<HotfixBlobMap, TOTAL_LOCALES> _hotfixBlob;
     std::unordered_multimap<uint32 /*tableHash*/, AllowedHotfixOptionalData> _allowedHotfixOptionalData;
     std::array<std::map<HotfixBlobKey, std::vector<DB2Manager::HotfixOptionalData>>, TOTAL_LOCALES> _hotfixOptionalData;
+    std::array<std::unordered_map<int32, DB2Manager::HotfixPushContent>, TOTAL_LOCALES> _hotfixPushContent;
 
     AreaGroupMemberContainer _areaGroupMembers;
     ArtifactPowersContainer _artifactPowers;
@@ -532,7 +543,7 @@ namespace
 }
 
 void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::string>& errlist, StorageMap& stores, DB2StorageBase* storage, std::string const& db2Path,
-    LocaleConstant defaultLocale, std::size_t cppRecordSize)
+    LocaleConstant defaultLocale, std::size_t cppRecordSize, bool mapFiles, std::mutex& lock)
 {
     // validate structure
     {
@@ -567,12 +578,13 @@ void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::s
 
     try
     {
-        storage->Load(db2Path + localeNames[defaultLocale] + '/', defaultLocale);
+        storage->Load(db2Path + localeNames[defaultLocale] + '/', defaultLocale, mapFiles);
     }
     catch (std::system_error const& e)
     {
         if (e.code() == std::errc::no_such_file_or_directory)
         {
+            std::lock_guard<std::mutex> guard(lock);
             errlist.push_back(Trinity::StringFormat("File {}{}/{} does not exist", db2Path, localeNames[defaultLocale], storage->GetFileName()));
         }
         else
@@ -580,6 +592,7 @@ void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::s
     }
     catch (std::exception const& e)
     {
+        std::lock_guard<std::mutex> guard(lock);
         errlist.emplace_back(e.what());
         return;
     }
@@ -594,7 +607,7 @@ void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::s
 
         try
         {
-            storage->LoadStringsFrom((db2Path + localeNames[i] + '/'), i);
+            storage->LoadStringsFrom((db2Path + localeNames[i] + '/'), i, mapFiles);
         }
         catch (std::system_error const& e)
         {
@@ -605,6 +618,7 @@ void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::s
         }
         catch (std::exception const& e)
         {
+            std::lock_guard<std::mutex> guard(lock);
             errlist.emplace_back(e.what());
         }
     }
@@ -613,6 +627,7 @@ void LoadDB2(std::bitset<TOTAL_LOCALES>& availableDb2Locales, std::vector<std::s
         if (availableDb2Locales[i])
             storage->LoadStringsFromDB(i);
 
+    std::lock_guard<std::mutex> guard(lock);
     stores[storage->GetTableHash()] = storage;
 }
 
@@ -622,13 +637,15 @@ DB2Manager& DB2Manager::Instance()
     return instance;
 }
 
-uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaultLocale)
+uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaultLocale, Trinity::ThreadPool* pool /*= nullptr*/)
 {
     uint32 oldMSTime = getMSTime();
 
     std::string db2Path = dataPath + "dbc/";
 
     std::vector<std::string> loadErrors;
+    uint32 const selectedLocales = sWorld->getIntConfig(CONFIG_LOAD_LOCALES_MASK);
+    auto IsLocaleSelected = [selectedLocales](LocaleConstant locale) { return !selectedLocales || (selectedLocales & (1 << locale)); };
     std::bitset<TOTAL_LOCALES> availableDb2Locales = [&]()
     {
         std::bitset<TOTAL_LOCALES> foundLocales;
@@ -636,7 +653,7 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
         while (db2PathItr != end)
         {
             LocaleConstant locale = GetLocaleByName(db2PathItr->path().filename().string());
-            if (IsValidLocale(locale) && (sWorld->getBoolConfig(CONFIG_LOAD_LOCALES) || locale == defaultLocale))
+            if (IsValidLocale(locale) && ((sWorld->getBoolConfig(CONFIG_LOAD_LOCALES) && IsLocaleSelected(locale)) || locale == defaultLocale))
                 foundLocales[locale] = true;
 
             ++db2PathItr;
@@ -647,9 +664,17 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
     if (!availableDb2Locales[defaultLocale])
         return 0;
 
+    bool const mapFiles = sWorld->getBoolConfig(CONFIG_LOAD_DB2_MAP_FILES);
+
+    // every store only touches its own data while parsing its files and hotfix tables, errors and the store map are shared
+    std::mutex loadLock;
+    Trinity::TaskGraph loaders;
     auto LOAD_DB2 = [&]<typename T>(DB2Storage<T>& store)
     {
-        LoadDB2(availableDb2Locales, loadErrors, _stores, &store, db2Path, defaultLocale, sizeof(T));
+        loaders.Add(store.GetFileName(), [&, storage = &store]
+        {
+            LoadDB2(availableDb2Locales, loadErrors, _stores, storage, db2Path, defaultLocale, sizeof(T), mapFiles, loadLock);
+        });
     };
 
     LOAD_DB2(sAchievementStore);
@@ -995,6 +1020,8 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
     LOAD_DB2(sWorldMapOverlayStore);
     LOAD_DB2(sWorldStateExpressionStore);
 
+    loaders.Run(pool);
+
     // error checks
     if (!loadErrors.empty())
     {
@@ -1652,7 +1679,7 @@ uint32 DB2Manager::LoadStores(std::string const& dataPath, LocaleConstant defaul
             _uiMapPhases.insert(uiMapArt->PhaseID);
 
     for (WMOAreaTableEntry const* entry : sWMOAreaTableStore)
-        _wmoAreaTableLookup[WMOAreaTableKey(entry->WmoID, entry->NameSetID, entry->WmoGroupID)] = entry;
+        _wmoAreaTableLookup[MakeWMOAreaTableKey(entry->WmoID, entry->NameSetID, entry->WmoGroupID)] = entry;
 
     // Initialize global taxinodes mask
     // reinitialize internal storage for globals after loading TaxiNodes.db2
@@ -1900,6 +1927,69 @@ void DB2Manager::LoadHotfixOptionalData(uint32 localeMask)
     TC_LOG_INFO("server.loading", ">> Loaded {} hotfix optional data records in {} ms", hotfixOptionalDataCount, GetMSTimeDiffToNow(oldMSTime));
 }
 
+void DB2Manager::LoadHotfixPushContent(uint32 localeMask)
+{
+    uint32 oldMSTime = getMSTime();
+
+    std::size_t contentSize = 0;
+    for (LocaleConstant locale = LOCALE_enUS; locale < TOTAL_LOCALES; locale = LocaleConstant(locale + 1))
+    {
+        _hotfixPushContent[locale].clear();
+        if (!(localeMask & (1 << locale)))
+            continue;
+
+        for (auto const& [pushId, push] : _hotfixData)
+        {
+            if (!(push.AvailableLocalesMask & (1 << locale)))
+                continue;
+
+            HotfixPushContent& pushContent = _hotfixPushContent[locale][pushId];
+            ByteBuffer content;
+            for (HotfixRecord const& hotfixRecord : push.Records)
+            {
+                if (!(hotfixRecord.AvailableLocalesMask & (1 << locale)))
+                    continue;
+
+                HotfixPushRecord& record = pushContent.Records.emplace_back();
+                record.Record = hotfixRecord;
+                if (hotfixRecord.HotfixStatus != HotfixRecord::Status::Valid)
+                    continue;
+
+                DB2StorageBase const* storage = GetStorage(hotfixRecord.TableHash);
+                if (storage && storage->HasRecord(uint32(hotfixRecord.RecordID)))
+                {
+                    std::size_t pos = content.size();
+                    storage->WriteRecord(uint32(hotfixRecord.RecordID), locale, content);
+
+                    if (std::vector<HotfixOptionalData> const* optionalDataEntries = GetHotfixOptionalData(hotfixRecord.TableHash, hotfixRecord.RecordID, locale))
+                    {
+                        for (HotfixOptionalData const& optionalData : *optionalDataEntries)
+                        {
+                            content << uint32(optionalData.Key);
+                            content.append(optionalData.Data.data(), optionalData.Data.size());
+                        }
+                    }
+
+                    record.Size = content.size() - pos;
+                }
+                else if (std::vector<uint8> const* blobData = GetHotfixBlobData(hotfixRecord.TableHash, hotfixRecord.RecordID, locale))
+                {
+                    record.Size = blobData->size();
+                    content.append(blobData->data(), blobData->size());
+                }
+                else
+                    // Do not send Status::Valid when we don't have a hotfix blob for current locale
+                    record.Record.HotfixStatus = storage ? HotfixRecord::Status::RecordRemoved : HotfixRecord::Status::Invalid;
+            }
+
+            contentSize += content.size();
+            pushContent.Content = content.Move();
+        }
+    }
+
+    TC_LOG_INFO("server.loading", ">> Serialized hotfix push content ({} bytes) in {} ms", contentSize, GetMSTimeDiffToNow(oldMSTime));
+}
+
 uint32 DB2Manager::GetHotfixCount() const
 {
     return _hotfixData.size();
@@ -1924,6 +2014,36 @@ std::vector<DB2Manager::HotfixOptionalData> const* DB2Manager::GetHotfixOptional
     return Trinity::Containers::MapGetValuePtr(_hotfixOptionalData[locale], std::make_pair(tableHash, recordId));
 }
 
+DB2Manager::HotfixPushContent const* DB2Manager::GetHotfixPushContent(int32 pushId, LocaleConstant locale) const
+{
+    ASSERT(IsValidLocale(locale), "Locale %u is invalid locale", uint32(locale));
+
+    return Trinity::Containers::MapGetValuePtr(_hotfixPushContent[locale], pushId);
+}
+
+void DB2Manager::GetMemoryUsage(Trinity::MemoryUsageReport& report) const
+{
+    for (auto const& [tableHash, store] : _stores)
+        report.Add("db2", store->GetFileName(), store->GetMemoryUsage());
+
+    auto blobUsage = [](auto const& blob) { return Trinity::MemoryUsage::Of(blob.second); };
+    auto optionalDataUsage = [](auto const& optionalData)
+    {
+        return Trinity::MemoryUsage::Of(optionalData.second, [](HotfixOptionalData const& data) { return Trinity::MemoryUsage::Of(data.Data); });
+    };
+    auto pushContentUsage = [](auto const& content) { return Trinity::MemoryUsage::Of(content.second.Records) + Trinity::MemoryUsage::Of(content.second.Content); };
+
+    std::size_t hotfixes = Trinity::MemoryUsage::Of(_hotfixData, [](auto const& push) { return Trinity::MemoryUsage::Of(push.second.Records); });
+    for (uint32 locale = 0; locale < TOTAL_LOCALES; ++locale)
+    {
+        hotfixes += Trinity::MemoryUsage::Of(_hotfixBlob[locale], blobUsage);
+        hotfixes += Trinity::MemoryUsage::Of(_hotfixOptionalData[locale], optionalDataUsage);
+        hotfixes += Trinity::MemoryUsage::Of(_hotfixPushContent[locale], pushContentUsage);
+    }
+
+    report.Add("db2", "hotfixes", hotfixes);
+}
+
 uint32 DB2Manager::GetEmptyAnimStateID() const
 {
     return sAnimationDataStore.GetNumRows();
@@ -3434,7 +3554,7 @@ bool DB2Manager::IsUiMapPhase(uint32 phaseId) const
 
 WMOAreaTableEntry const* DB2Manager::GetWMOAreaTable(int32 rootId, int32 adtId, int32 groupId) const
 {
-    return Trinity::Containers::MapGetValuePtr(_wmoAreaTableLookup, WMOAreaTableKey(int16(rootId), int8(adtId), groupId));
+    return Trinity::Containers::MapGetValuePtr(_wmoAreaTableLookup, MakeWMOAreaTableKey(uint16(rootId), uint8(adtId), groupId));
 }
 
 std::unordered_set<uint32> const* DB2Manager::GetPVPStatIDsForMap(uint32 mapId) const
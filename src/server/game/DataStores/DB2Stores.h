@@ -36,6 +36,12 @@
 
 class DB2HotfixGeneratorBase;
 
+namespace Trinity
+{
+class MemoryUsageReport;
+class ThreadPool;
+}
+
 TC_GAME_API extern DB2Storage<AchievementEntry>                     sAchievementStore;
 TC_GAME_API extern DB2Storage<Achievement_CategoryEntry>            sAchievementCategoryStore;
 TC_GAME_API extern DB2Storage<AdventureJournalEntry>                sAdventureJournalStore;
@@ -414,6 +420,19 @@ public:
 
     using HotfixContainer = std::map<int32, HotfixPush>;
 
+    struct HotfixPushRecord
+    {
+        HotfixRecord Record;
+        uint32 Size = 0;
+    };
+
+    // SMSG_HOTFIX_CONNECT part of one push for one locale, serialized once instead of for every request
+    struct HotfixPushContent
+    {
+        std::vector<HotfixPushRecord> Records;
+        std::vector<uint8> Content;     // data of all records, in order
+    };
+
     using FriendshipRepReactionSet = std::set<FriendshipRepReactionEntry const*, FriendshipRepReactionEntryComparator>;
     using MapDifficultyConditionsContainer = std::vector<std::pair<uint32, PlayerConditionEntry const*>>;
     using MountTypeXCapabilitySet = std::set<MountTypeXCapabilityEntry const*, MountTypeXCapabilityEntryComparator>;
@@ -421,16 +440,22 @@ public:
 
     static DB2Manager& Instance();
 
-    uint32 LoadStores(std::string const& dataPath, LocaleConstant defaultLocale);
+    // stores are loaded concurrently on pool when one is given
+    uint32 LoadStores(std::string const& dataPath, LocaleConstant defaultLocale, Trinity::ThreadPool* pool = nullptr);
     DB2StorageBase const* GetStorage(uint32 type) const;
 
     void LoadHotfixData(uint32 localeMask);
     void LoadHotfixBlob(uint32 localeMask);
     void LoadHotfixOptionalData(uint32 localeMask);
+    void LoadHotfixPushContent(uint32 localeMask);     // requires the stores and all hotfix data to be loaded
     uint32 GetHotfixCount() const;
     HotfixContainer const& GetHotfixData() const;
     std::vector<uint8> const* GetHotfixBlobData(uint32 tableHash, int32 recordId, LocaleConstant locale) const;
     std::vector<HotfixOptionalData> const* GetHotfixOptionalData(uint32 tableHash, int32 recordId, LocaleConstant locale) const;
+    HotfixPushContent const* GetHotfixPushContent(int32 pushId, LocaleConstant locale) const;
+
+    // adds every store and the hotfix data to the report
+    void GetMemoryUsage(Trinity::MemoryUsageReport& report) const;
 
     uint32 GetEmptyAnimStateID() const;
     std::vector<uint32> GetAreasForGroup(uint32 areaGroupId) const;
@@ -16,17 +16,114 @@
  */
 
 #include "M2Stores.h"
-#include "Containers.h"
 #include "DB2Stores.h"
 #include "Log.h"
 #include "M2Structure.h"
-#include "Timer.h"
+#include "ThreadPool.h"
 #include <boost/filesystem/path.hpp>
 #include <G3D/Vector4.h>
 #include <fstream>
+#include <future>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 
 typedef std::vector<FlyByCamera> FlyByCameraCollection;
-std::unordered_map<uint32, FlyByCameraCollection> sFlyByCameraStore;
+
+namespace
+{
+// Camera files are parsed the first time a cinematic needs them and kept in a LRU cache
+// entries hold a shared future so that a prefetch still in progress is waited for instead of loading the file twice
+// failed loads are cached too (as null collection) to not hit the disk again for missing files
+class FlyByCameraCache
+{
+public:
+    using CollectionPtr = std::shared_ptr<FlyByCameraCollection const>;
+
+    void Initialize(std::string const& dataPath, uint32 maxSize)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _camerasPath = boost::filesystem::path(dataPath) / "cameras";
+        _maxSize = maxSize;
+        _entries.clear();
+        _order.clear();
+        if (!_prefetchPool)
+            _prefetchPool = std::make_unique<Trinity::ThreadPool>(1);
+    }
+
+    CollectionPtr Get(uint32 cinematicCameraId)
+    {
+        std::promise<CollectionPtr> promise;
+        std::shared_future<CollectionPtr> future;
+        boost::filesystem::path camerasPath;
+        if (!Acquire(cinematicCameraId, promise, future, camerasPath))
+            return future.get();
+
+        promise.set_value(Load(camerasPath, cinematicCameraId));
+        return future.get();
+    }
+
+    void Prefetch(uint32 cinematicCameraId)
+    {
+        std::promise<CollectionPtr> promise;
+        std::shared_future<CollectionPtr> future;
+        boost::filesystem::path camerasPath;
+        if (!Acquire(cinematicCameraId, promise, future, camerasPath))
+            return;
+
+        _prefetchPool->PostWork([promise = std::move(promise), camerasPath = std::move(camerasPath), cinematicCameraId]() mutable
+        {
+            promise.set_value(Load(camerasPath, cinematicCameraId));
+        });
+    }
+
+private:
+    struct Entry
+    {
+        std::shared_future<CollectionPtr> Cameras;
+        std::list<uint32>::iterator OrderItr;
+    };
+
+    // returns true when the caller is responsible for loading the camera and fulfilling the promise
+    bool Acquire(uint32 cinematicCameraId, std::promise<CollectionPtr>& promise, std::shared_future<CollectionPtr>& future, boost::filesystem::path& camerasPath)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto itr = _entries.find(cinematicCameraId);
+        if (itr != _entries.end())
+        {
+            _order.splice(_order.begin(), _order, itr->second.OrderItr);
+            future = itr->second.Cameras;
+            return false;
+        }
+
+        future = promise.get_future().share();
+        camerasPath = _camerasPath;
+
+        _order.push_front(cinematicCameraId);
+        _entries.emplace(cinematicCameraId, Entry{ future, _order.begin() });
+
+        // evicted collections stay alive for as long as a player is still watching them
+        while (_maxSize && _entries.size() > _maxSize)
+        {
+            _entries.erase(_order.back());
+            _order.pop_back();
+        }
+
+        return true;
+    }
+
+    static CollectionPtr Load(boost::filesystem::path const& camerasPath, uint32 cinematicCameraId);
+
+    std::mutex _lock;
+    boost::filesystem::path _camerasPath;
+    uint32 _maxSize = 0;
+    std::unordered_map<uint32, Entry> _entries;
+    std::list<uint32> _order;   // most recently used first
+    std::unique_ptr<Trinity::ThreadPool> _prefetchPool;
+};
+
+FlyByCameraCache sFlyByCameraCache;
+}
 
 // Convert the geomoetry from a spline value, to an actual WoW XYZ
 G3D::Vector3 translateLocation(G3D::Vector4 const* dbcLocation, G3D::Vector3 const* basePosition, G3D::Vector3 const* splineVector)
@@ -48,11 +145,9 @@ G3D::Vector3 translateLocation(G3D::Vector4 const* dbcLocation, G3D::Vector3 con
 }
 
 // Number of cameras not used. Multiple cameras never used in 7.1.5
-bool readCamera(M2Camera const* cam, uint32 buffSize, M2Header const* header, CinematicCameraEntry const* dbcentry)
+bool readCamera(M2Camera const* cam, uint32 buffSize, M2Header const* header, CinematicCameraEntry const* dbcentry, FlyByCameraCollection& cameras)
 {
     char const* buffer = reinterpret_cast<char const*>(header);
-
-    FlyByCameraCollection cameras;
     FlyByCameraCollection targetcam;
 
     G3D::Vector4 dbcData;
@@ -167,104 +262,110 @@ bool readCamera(M2Camera const* cam, uint32 buffSize, M2Header const* header, Ci
         }
     }
 
-    sFlyByCameraStore[dbcentry->ID] = cameras;
     return true;
 }
 
-TC_GAME_API void LoadM2Cameras(std::string const& dataPath)
+FlyByCameraCache::CollectionPtr FlyByCameraCache::Load(boost::filesystem::path const& camerasPath, uint32 cinematicCameraId)
 {
-    sFlyByCameraStore.clear();
-    TC_LOG_INFO("server.loading", ">> Loading Cinematic Camera files");
+    CinematicCameraEntry const* cameraEntry = sCinematicCameraStore.LookupEntry(cinematicCameraId);
+    if (!cameraEntry)
+        return nullptr;
 
-    boost::filesystem::path camerasPath = boost::filesystem::path(dataPath) / "cameras";
+    boost::filesystem::path filename = camerasPath / Trinity::StringFormat("FILE{:08X}.xxx", cameraEntry->FileDataID);
 
-    uint32 oldMSTime = getMSTime();
-    for (CinematicCameraEntry const* cameraEntry : sCinematicCameraStore)
-    {
-        boost::filesystem::path filename = camerasPath / Trinity::StringFormat("FILE{:08X}.xxx", cameraEntry->FileDataID);
+    // Convert to native format
+    filename.make_preferred();
 
-        // Convert to native format
-        filename.make_preferred();
+    std::ifstream m2file(filename.string().c_str(), std::ios::in | std::ios::binary);
+    if (!m2file.is_open())
+        return nullptr;
 
-        std::ifstream m2file(filename.string().c_str(), std::ios::in | std::ios::binary);
-        if (!m2file.is_open())
-            continue;
+    // Get file size
+    m2file.seekg(0, std::ios::end);
+    std::streamoff fileSize = m2file.tellg();
 
-        // Get file size
-        m2file.seekg(0, std::ios::end);
-        std::streamoff fileSize = m2file.tellg();
+    // Reject if not at least the size of the header
+    if (static_cast<uint32>(fileSize) < sizeof(M2Header) + 4)
+    {
+        TC_LOG_ERROR("misc", "Camera file {} is damaged. File is smaller than header size", filename.string());
+        return nullptr;
+    }
 
-        // Reject if not at least the size of the header
-        if (static_cast<uint32>(fileSize) < sizeof(M2Header) + 4)
-        {
-            TC_LOG_ERROR("server.loading", "Camera file {} is damaged. File is smaller than header size", filename.string());
-            m2file.close();
-            continue;
-        }
+    // Read 4 bytes (signature)
+    m2file.seekg(0, std::ios::beg);
+    char fileCheck[5];
+    m2file.read(fileCheck, 4);
+    fileCheck[4] = '\0';
 
-        // Read 4 bytes (signature)
-        m2file.seekg(0, std::ios::beg);
-        char fileCheck[5];
-        m2file.read(fileCheck, 4);
-        fileCheck[4] = '\0';
+    // Check file has correct magic (MD21)
+    if (strcmp(fileCheck, "MD21"))
+    {
+        TC_LOG_ERROR("misc", "Camera file {} is damaged. File identifier not found.", filename.string());
+        return nullptr;
+    }
 
-        // Check file has correct magic (MD21)
-        if (strcmp(fileCheck, "MD21"))
+    // Now we have a good file, read it all into a vector of char's, then close the file.
+    std::vector<char> buffer(fileSize);
+    m2file.seekg(0, std::ios::beg);
+    if (!m2file.read(buffer.data(), fileSize))
+        return nullptr;
+    m2file.close();
+
+    bool fileValid = true;
+    uint32 m2start = 0;
+    char const* ptr = buffer.data();
+    while (m2start + 4 < buffer.size() && memcmp(ptr, "MD20", 4) != 0)
+    {
+        ++m2start;
+        ++ptr;
+        if (m2start + sizeof(M2Header) > buffer.size())
         {
-            TC_LOG_ERROR("server.loading", "Camera file {} is damaged. File identifier not found.", filename.string());
-            m2file.close();
-            continue;
+            fileValid = false;
+            break;
         }
+    }
 
-        // Now we have a good file, read it all into a vector of char's, then close the file.
-        std::vector<char> buffer(fileSize);
-        m2file.seekg(0, std::ios::beg);
-        if (!m2file.read(buffer.data(), fileSize))
-        {
-            m2file.close();
-            continue;
-        }
-        m2file.close();
+    if (!fileValid)
+    {
+        TC_LOG_ERROR("misc", "Camera file {} is damaged. File is smaller than header size.", filename.string());
+        return nullptr;
+    }
 
-        bool fileValid = true;
-        uint32 m2start = 0;
-        char const* ptr = buffer.data();
-        while (m2start + 4 < buffer.size() && memcmp(ptr, "MD20", 4) != 0)
-        {
-            ++m2start;
-            ++ptr;
-            if (m2start + sizeof(M2Header) > buffer.size())
-            {
-                fileValid = false;
-                break;
-            }
-        }
+    // Read header
+    M2Header const* header = reinterpret_cast<M2Header const*>(buffer.data() + m2start);
 
-        if (!fileValid)
-        {
-            TC_LOG_ERROR("server.loading", "Camera file {} is damaged. File is smaller than header size.", filename.string());
-            continue;
-        }
+    if (m2start + header->ofsCameras + sizeof(M2Camera) > static_cast<uint32>(fileSize))
+    {
+        TC_LOG_ERROR("misc", "Camera file {} is damaged. Camera references position beyond file end", filename.string());
+        return nullptr;
+    }
 
-        // Read header
-        M2Header const* header = reinterpret_cast<M2Header const*>(buffer.data() + m2start);
+    // Get camera(s) - Main header, then dump them.
+    M2Camera const* cam = reinterpret_cast<M2Camera const*>(buffer.data() + m2start + header->ofsCameras);
+    std::shared_ptr<FlyByCameraCollection> cameras = std::make_shared<FlyByCameraCollection>();
+    if (!readCamera(cam, fileSize - m2start, header, cameraEntry, *cameras))
+    {
+        TC_LOG_ERROR("misc", "Camera file {} is damaged. Camera references position beyond file end", filename.string());
+        return nullptr;
+    }
 
-        if (m2start + header->ofsCameras + sizeof(M2Camera) > static_cast<uint32>(fileSize))
-        {
-            TC_LOG_ERROR("server.loading", "Camera file {} is damaged. Camera references position beyond file end", filename.string());
-            continue;
-        }
+    return cameras;
+}
 
-        // Get camera(s) - Main header, then dump them.
-        M2Camera const* cam = reinterpret_cast<M2Camera const*>(buffer.data() + m2start + header->ofsCameras);
-        if (!readCamera(cam, fileSize - m2start, header, cameraEntry))
-            TC_LOG_ERROR("server.loading", "Camera file {} is damaged. Camera references position beyond file end", filename.string());
-    }
+void LoadM2Cameras(std::string const& dataPath, uint32 cacheSize)
+{
+    sFlyByCameraCache.Initialize(dataPath, cacheSize);
+    TC_LOG_INFO("server.loading", ">> Cinematic camera files are loaded on demand, keeping up to {} waypoint sets", cacheSize);
+}
 
-    TC_LOG_INFO("server.loading", ">> Loaded {} cinematic waypoint sets in {} ms", sFlyByCameraStore.size(), GetMSTimeDiffToNow(oldMSTime));
+std::shared_ptr<std::vector<FlyByCamera> const> GetFlyByCameras(uint32 cinematicCameraId)
+{
+    return sFlyByCameraCache.Get(cinematicCameraId);
 }
 
-std::vector<FlyByCamera> const* GetFlyByCameras(uint32 cinematicCameraId)
+void PrefetchFlyByCameras(CinematicSequencesEntry const* sequence)
 {
-    return Trinity::Containers::MapGetValuePtr(sFlyByCameraStore, cinematicCameraId);
+    for (uint16 cinematicCameraId : sequence->Camera)
+        if (cinematicCameraId)
+            sFlyByCameraCache.Prefetch(cinematicCameraId);
 }
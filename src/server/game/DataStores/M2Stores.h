@@ -20,16 +20,24 @@
 
 #include "Define.h"
 #include "Position.h"
+#include <memory>
 #include <vector>
 
+struct CinematicSequencesEntry;
+
 struct FlyByCamera
 {
     uint32 timeStamp;
     Position locations;
 };
 
-TC_GAME_API void LoadM2Cameras(std::string const& dataPath);
+// camera files are not parsed here, only the cache is set up (cacheSize 0 keeps every loaded waypoint set)
+TC_GAME_API void LoadM2Cameras(std::string const& dataPath, uint32 cacheSize);
+
+// loads the waypoints on first use, blocks while a prefetch of the same camera is still running
+TC_GAME_API std::shared_ptr<std::vector<FlyByCamera> const> GetFlyByCameras(uint32 cinematicCameraId);
 
-TC_GAME_API std::vector<FlyByCamera> const* GetFlyByCameras(uint32 cinematicCameraId);
+// starts loading the waypoints of every camera of the sequence in the background
+TC_GAME_API void PrefetchFlyByCameras(CinematicSequencesEntry const* sequence);
 
 #endif
@@ -29,6 +29,7 @@
 #include "LFGQueue.h"
 #include "Log.h"
 #include "Map.h"
+#include "Metric.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Player.h"
@@ -343,9 +344,12 @@ void LFGMgr::Update(uint32 diff)
 
     uint32 lastProposalId = m_lfgProposalId;
     // Check if a proposal can be formed with the new groups being added
-    for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
-        if (uint8 newProposals = it->second.FindGroups())
-            TC_LOG_DEBUG("lfg.update", "Found {} new groups in queue {}", newProposals, it->first);
+    {
+        TC_METRIC_TIMER("lfg_update_time", TC_METRIC_TAG("type", "Find groups"));
+        for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
+            if (uint8 newProposals = it->second.FindGroups())
+                TC_LOG_DEBUG("lfg.update", "Found {} new groups in queue {}", newProposals, it->first);
+    }
 
     if (lastProposalId != m_lfgProposalId)
     {
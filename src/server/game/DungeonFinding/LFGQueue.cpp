@@ -19,35 +19,29 @@
 #include "Containers.h"
 #include "GameTime.h"
 #include "Group.h"
+#include "Hash.h"
 #include "LFGMgr.h"
 #include "Log.h"
+#include "Metric.h"
 #include <sstream>
 
 namespace lfg
 {
 
-/**
-   Given a list of guids returns the concatenation using | as delimiter
+static_assert(std::tuple_size_v<LfgCompatibilityKey> == MAX_GROUP_SIZE);
 
-   @param[in]     check list of guids
-   @returns Concatenated string
-*/
-std::string ConcatenateGuids(GuidList const& check)
+std::size_t LfgCompatibilityKeyHash::operator()(LfgCompatibilityKey const& key) const
 {
-    if (check.empty())
-        return "";
+    std::size_t hashVal = 0;
+    for (uint32 queueId : key)
+        Trinity::hash_combine(hashVal, queueId);
 
-    // need the guids in order to avoid duplicates
-    GuidSet guids(check.begin(), check.end());
-
-    std::ostringstream o;
-
-    GuidSet::const_iterator it = guids.begin();
-    o << it->ToHexString();
-    for (++it; it != guids.end(); ++it)
-        o << '|' << it->ToHexString();
+    return hashVal;
+}
 
-    return o.str();
+uint8 GetCompatibilityKeySize(LfgCompatibilityKey const& key)
+{
+    return uint8(std::count_if(key.begin(), key.end(), [](uint32 queueId) { return queueId != 0; }));
 }
 
 char const* GetCompatibleString(LfgCompatibility compatibles)
@@ -79,8 +73,8 @@ char const* GetCompatibleString(LfgCompatibility compatibles)
     }
 }
 
-LfgQueueData::LfgQueueData() : joinTime(GameTime::GetGameTime()), tanks(LFG_TANKS_NEEDED),
-healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED)
+LfgQueueData::LfgQueueData() : queueId(0), joinTime(GameTime::GetGameTime()), tanks(LFG_TANKS_NEEDED),
+healers(LFG_HEALERS_NEEDED), dps(LFG_DPS_NEEDED), bestCompatible()
 { }
 
 std::string LFGQueue::GetDetailedMatchRoles(GuidList const& check) const
@@ -141,20 +135,15 @@ void LFGQueue::RemoveFromQueue(ObjectGuid guid)
     RemoveFromCurrentQueue(guid);
     RemoveFromCompatibles(guid);
 
-    std::string sguid = guid.ToHexString();
+    LfgQueueDataContainer::iterator itDelete = QueueDataStore.find(guid);
+    uint32 queueId = itDelete != QueueDataStore.end() ? itDelete->second.queueId : 0;
 
-    LfgQueueDataContainer::iterator itDelete = QueueDataStore.end();
     for (LfgQueueDataContainer::iterator itr = QueueDataStore.begin(); itr != QueueDataStore.end(); ++itr)
-        if (itr->first != guid)
+        if (itr != itDelete && queueId && std::find(itr->second.bestCompatible.begin(), itr->second.bestCompatible.end(), queueId) != itr->second.bestCompatible.end())
         {
-            if (std::string::npos != itr->second.bestCompatible.find(sguid))
-            {
-                itr->second.bestCompatible.clear();
-                FindBestCompatibleInQueue(itr);
-            }
+            itr->second.bestCompatible = { };
+            FindBestCompatibleInQueue(itr);
         }
-        else
-            itDelete = itr;
 
     if (itDelete != QueueDataStore.end())
         QueueDataStore.erase(itDelete);
@@ -187,7 +176,13 @@ void LFGQueue::RemoveFromCurrentQueue(ObjectGuid guid)
 
 void LFGQueue::AddQueueData(ObjectGuid guid, time_t joinTime, LfgDungeonSet const& dungeons, LfgRolesMap const& rolesMap)
 {
-    QueueDataStore[guid] = LfgQueueData(joinTime, dungeons, rolesMap);
+    // compatibilities computed with previous queue data are keyed by the old queue id
+    if (QueueDataStore.contains(guid))
+        RemoveFromCompatibles(guid);
+
+    LfgQueueData& queueData = QueueDataStore[guid];
+    queueData = LfgQueueData(joinTime, dungeons, rolesMap);
+    queueData.queueId = ++lastQueueId;
     AddToQueue(guid);
 }
 
@@ -200,28 +195,32 @@ void LFGQueue::RemoveQueueData(ObjectGuid guid)
 
 void LFGQueue::UpdateWaitTimeAvg(int32 waitTime, uint32 dungeonId)
 {
-    LfgWaitTime &wt = waitTimesAvgStore[dungeonId];
-    uint32 old_number = wt.number++;
-    wt.time = int32((wt.time * old_number + waitTime) / wt.number);
+    UpdateWaitTime(waitTimesAvgStore, waitTime, dungeonId, "avg");
 }
 
 void LFGQueue::UpdateWaitTimeTank(int32 waitTime, uint32 dungeonId)
 {
-    LfgWaitTime &wt = waitTimesTankStore[dungeonId];
-    uint32 old_number = wt.number++;
-    wt.time = int32((wt.time * old_number + waitTime) / wt.number);
+    UpdateWaitTime(waitTimesTankStore, waitTime, dungeonId, "tank");
 }
 
 void LFGQueue::UpdateWaitTimeHealer(int32 waitTime, uint32 dungeonId)
 {
-    LfgWaitTime &wt = waitTimesHealerStore[dungeonId];
-    uint32 old_number = wt.number++;
-    wt.time = int32((wt.time * old_number + waitTime) / wt.number);
+    UpdateWaitTime(waitTimesHealerStore, waitTime, dungeonId, "healer");
 }
 
 void LFGQueue::UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId)
 {
-    LfgWaitTime &wt = waitTimesDpsStore[dungeonId];
+    UpdateWaitTime(waitTimesDpsStore, waitTime, dungeonId, "dps");
+}
+
+void LFGQueue::UpdateWaitTime(LfgWaitTimesContainer& waitTimes, int32 waitTime, uint32 dungeonId, char const* role)
+{
+    LfgWaitTime &wt = waitTimes[dungeonId];
+
+    // difference between the wait time players were shown and the real one
+    if (wt.number)
+        TC_METRIC_VALUE("lfg_wait_time_error", int64(waitTime) - wt.time, TC_METRIC_TAG("role", role));
+
     uint32 old_number = wt.number++;
     wt.time = int32((wt.time * old_number + waitTime) / wt.number);
 }
@@ -233,41 +232,99 @@ void LFGQueue::UpdateWaitTimeDps(int32 waitTime, uint32 dungeonId)
 */
 void LFGQueue::RemoveFromCompatibles(ObjectGuid guid)
 {
-    std::string strGuid = guid.ToHexString();
+    LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(guid);
+    if (itQueue == QueueDataStore.end())
+        return;
 
     TC_LOG_DEBUG("lfg.queue.data.compatibles.remove", "Removing {}", guid.ToString());
-    for (LfgCompatibleContainer::iterator itNext = CompatibleMapStore.begin(); itNext != CompatibleMapStore.end();)
+    auto itKeys = CompatibleKeysByQueueId.find(itQueue->second.queueId);
+    if (itKeys == CompatibleKeysByQueueId.end())
+        return;
+
+    for (LfgCompatibilityKey const& key : itKeys->second)
+        CompatibleMapStore.erase(key);
+
+    CompatibleKeysByQueueId.erase(itKeys);
+}
+
+/**
+   Builds the key of a combination of queued guids
+
+   @param[in]     check list of guids
+   @return Queue ids of the guids in ascending order
+*/
+LfgCompatibilityKey LFGQueue::GetCompatibilityKey(GuidList const& check) const
+{
+    LfgCompatibilityKey key = { };
+    std::size_t size = 0;
+    for (GuidList::const_iterator it = check.begin(); it != check.end() && size < key.size(); ++it)
     {
-        LfgCompatibleContainer::iterator it = itNext++;
-        if (std::string::npos != it->first.find(strGuid))
-            CompatibleMapStore.erase(it);
+        LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(*it);
+        if (itQueue != QueueDataStore.end())
+            key[size++] = itQueue->second.queueId;
     }
+
+    std::sort(key.begin(), key.begin() + size);
+    return key;
+}
+
+std::string LFGQueue::GetCompatibilityKeyString(LfgCompatibilityKey const& key) const
+{
+    std::ostringstream o;
+    for (uint32 queueId : key)
+    {
+        if (!queueId)
+            break;
+
+        if (queueId != key.front())
+            o << '|';
+
+        auto itQueue = std::find_if(QueueDataStore.begin(), QueueDataStore.end(), [queueId](LfgQueueDataContainer::value_type const& queueData)
+        {
+            return queueData.second.queueId == queueId;
+        });
+
+        if (itQueue != QueueDataStore.end())
+            o << itQueue->first.ToHexString();
+        else
+            o << queueId;
+    }
+
+    return o.str();
 }
 
 /**
    Stores the compatibility of a list of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Queue ids of the guids
    @param[in]     compatibles type of compatibility
 */
-void LFGQueue::SetCompatibles(std::string const& key, LfgCompatibility compatibles)
+void LFGQueue::SetCompatibles(LfgCompatibilityKey const& key, LfgCompatibility compatibles)
 {
-    LfgCompatibilityData& data = CompatibleMapStore[key];
-    data.compatibility = compatibles;
+    auto [itr, inserted] = CompatibleMapStore.try_emplace(key);
+    itr->second.compatibility = compatibles;
+    if (inserted)
+        for (uint32 queueId : key)
+            if (queueId)
+                CompatibleKeysByQueueId[queueId].push_back(key);
 }
 
-void LFGQueue::SetCompatibilityData(std::string const& key, LfgCompatibilityData const& data)
+void LFGQueue::SetCompatibilityData(LfgCompatibilityKey const& key, LfgCompatibilityData const& data)
 {
-    CompatibleMapStore[key] = data;
+    auto [itr, inserted] = CompatibleMapStore.insert_or_assign(key, data);
+    if (inserted)
+        for (uint32 queueId : key)
+            if (queueId)
+                CompatibleKeysByQueueId[queueId].push_back(key);
 }
 
 /**
    Get the compatibility of a group of guids
 
-   @param[in]     key String concatenation of guids (| used as separator)
+   @param[in]     key Queue ids of the guids
    @return LfgCompatibility type of compatibility
 */
-LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
+LfgCompatibility LFGQueue::GetCompatibles(LfgCompatibilityKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -276,7 +333,7 @@ LfgCompatibility LFGQueue::GetCompatibles(std::string const& key)
     return LFG_COMPATIBILITY_PENDING;
 }
 
-LfgCompatibilityData* LFGQueue::GetCompatibilityData(std::string const& key)
+LfgCompatibilityData* LFGQueue::GetCompatibilityData(LfgCompatibilityKey const& key)
 {
     LfgCompatibleContainer::iterator itr = CompatibleMapStore.find(key);
     if (itr != CompatibleMapStore.end())
@@ -300,6 +357,7 @@ uint8 LFGQueue::FindGroups()
         RemoveFromNewQueue(frontguid);
 
         GuidList temporalList = currentQueueStore;
+        OrderByScarceRoles(temporalList);
         LfgCompatibility compatibles = FindNewGroups(firstNew, temporalList);
 
         if (compatibles == LFG_COMPATIBLES_MATCH)
@@ -310,6 +368,42 @@ uint8 LFGQueue::FindGroups()
     return proposals;
 }
 
+/**
+   Moves queued players/groups offering tank, then healer, roles to the front of the list, keeping queue order
+   otherwise. Those roles are the scarce ones so combinations including them are tried first.
+
+   @param[in,out] queue List of guids in queue order
+*/
+void LFGQueue::OrderByScarceRoles(GuidList& queue) const
+{
+    auto getRolePriority = [this](ObjectGuid guid)
+    {
+        LfgQueueDataContainer::const_iterator itQueue = QueueDataStore.find(guid);
+        if (itQueue == QueueDataStore.end())
+            return 2;
+
+        uint8 roles = 0;
+        for (LfgRolesMap::const_iterator itRoles = itQueue->second.roles.begin(); itRoles != itQueue->second.roles.end(); ++itRoles)
+            roles |= itRoles->second;
+
+        if (roles & PLAYER_ROLE_TANK)
+            return 0;
+        if (roles & PLAYER_ROLE_HEALER)
+            return 1;
+        return 2;
+    };
+
+    std::array<GuidList, 3> buckets;
+    while (!queue.empty())
+    {
+        GuidList& bucket = buckets[getRolePriority(queue.front())];
+        bucket.splice(bucket.end(), queue, queue.begin());
+    }
+
+    for (GuidList& bucket : buckets)
+        queue.splice(queue.end(), bucket);
+}
+
 /**
    Checks que main queue to try to form a Lfg group. Returns first match found (if any)
 
@@ -319,8 +413,11 @@ uint8 LFGQueue::FindGroups()
 */
 LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
 {
-    std::string strGuids = ConcatenateGuids(check);
-    LfgCompatibility compatibles = GetCompatibles(strGuids);
+    if (check.size() > MAX_GROUP_SIZE)
+        return LFG_INCOMPATIBLES_WRONG_GROUP_SIZE;
+
+    LfgCompatibilityKey key = GetCompatibilityKey(check);
+    LfgCompatibility compatibles = GetCompatibles(key);
 
     TC_LOG_DEBUG("lfg.queue.match.check", "Guids: ({}): {} - all({})", GetDetailedMatchRoles(check), GetCompatibleString(compatibles), GetDetailedMatchRoles(all));
     if (compatibles == LFG_COMPATIBILITY_PENDING) // Not previously cached, calculate
@@ -329,7 +426,7 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
     if (compatibles == LFG_COMPATIBLES_BAD_STATES && sLFGMgr->AllQueued(check))
     {
         TC_LOG_DEBUG("lfg.queue.match.check", "Guids: ({}) compatibles (cached) changed from bad states to match", GetDetailedMatchRoles(check));
-        SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+        SetCompatibles(key, LFG_COMPATIBLES_MATCH);
         return LFG_COMPATIBLES_MATCH;
     }
 
@@ -357,7 +454,6 @@ LfgCompatibility LFGQueue::FindNewGroups(GuidList& check, GuidList& all)
 */
 LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
 {
-    std::string strGuids = ConcatenateGuids(check);
     LfgProposal proposal;
     LfgDungeonSet proposalDungeons;
     LfgGroupsMap proposalGroups;
@@ -370,6 +466,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         return LFG_INCOMPATIBLES_WRONG_GROUP_SIZE;
     }
 
+    LfgCompatibilityKey key = GetCompatibilityKey(check);
+
     // Check all-but-new compatiblitity
     if (check.size() > 2)
     {
@@ -380,8 +478,8 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         LfgCompatibility child_compatibles = CheckCompatibility(check);
         if (child_compatibles < LFG_COMPATIBLES_WITH_LESS_PLAYERS) // Group not compatible
         {
-            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) child {} not compatibles", strGuids, GetDetailedMatchRoles(check));
-            SetCompatibles(strGuids, child_compatibles);
+            TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) child {} not compatibles", GetCompatibilityKeyString(key), GetDetailedMatchRoles(check));
+            SetCompatibles(key, child_compatibles);
             return child_compatibles;
         }
         check.push_front(frontGuid);
@@ -425,22 +523,22 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         data.roles = itQueue->second.roles;
         LFGMgr::CheckGroupRoles(data.roles);
 
-        UpdateBestCompatibleInQueue(itQueue, strGuids, data.roles);
-        SetCompatibilityData(strGuids, data);
+        UpdateBestCompatibleInQueue(itQueue, key, data.roles);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
     if (numLfgGroups > 1)
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) More than one Lfggroup ({})", GetDetailedMatchRoles(check), numLfgGroups);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
+        SetCompatibles(key, LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS);
         return LFG_INCOMPATIBLES_MULTIPLE_LFG_GROUPS;
     }
 
     if (numPlayers > MAX_GROUP_SIZE)
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) Too many players ({})", GetDetailedMatchRoles(check), numPlayers);
-        SetCompatibles(strGuids, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
+        SetCompatibles(key, LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS);
         return LFG_INCOMPATIBLES_TOO_MUCH_PLAYERS;
     }
 
@@ -468,7 +566,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         if (uint8 playersize = numPlayers - proposalRoles.size())
         {
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) not compatible, {} players are ignoring each other", GetDetailedMatchRoles(check), playersize);
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_HAS_IGNORES);
+            SetCompatibles(key, LFG_INCOMPATIBLES_HAS_IGNORES);
             return LFG_INCOMPATIBLES_HAS_IGNORES;
         }
 
@@ -480,7 +578,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
                 o << ", " << it->first.ToHexString() << ": " << GetRolesString(it->second);
 
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) Roles not compatible{}", GetDetailedMatchRoles(check), o.str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_ROLES);
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_ROLES);
             return LFG_INCOMPATIBLES_NO_ROLES;
         }
 
@@ -500,7 +598,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         if (proposalDungeons.empty())
         {
             TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) No compatible dungeons{}", GetDetailedMatchRoles(check), o.str());
-            SetCompatibles(strGuids, LFG_INCOMPATIBLES_NO_DUNGEONS);
+            SetCompatibles(key, LFG_INCOMPATIBLES_NO_DUNGEONS);
             return LFG_INCOMPATIBLES_NO_DUNGEONS;
         }
     }
@@ -521,9 +619,9 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
         data.roles = proposalRoles;
 
         for (GuidList::const_iterator itr = check.begin(); itr != check.end(); ++itr)
-            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), strGuids, data.roles);
+            UpdateBestCompatibleInQueue(QueueDataStore.find(*itr), key, data.roles);
 
-        SetCompatibilityData(strGuids, data);
+        SetCompatibilityData(key, data);
         return LFG_COMPATIBLES_WITH_LESS_PLAYERS;
     }
 
@@ -534,7 +632,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     if (!sLFGMgr->AllQueued(check))
     {
         TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) Group MATCH but can't create proposal!", GetDetailedMatchRoles(check));
-        SetCompatibles(strGuids, LFG_COMPATIBLES_BAD_STATES);
+        SetCompatibles(key, LFG_COMPATIBLES_BAD_STATES);
         return LFG_COMPATIBLES_BAD_STATES;
     }
 
@@ -576,7 +674,7 @@ LfgCompatibility LFGQueue::CheckCompatibility(GuidList check)
     sLFGMgr->AddProposal(proposal);
 
     TC_LOG_DEBUG("lfg.queue.match.compatibility.check", "Guids: ({}) MATCH! Group formed", GetDetailedMatchRoles(check));
-    SetCompatibles(strGuids, LFG_COMPATIBLES_MATCH);
+    SetCompatibles(key, LFG_COMPATIBLES_MATCH);
     return LFG_COMPATIBLES_MATCH;
 }
 
@@ -618,7 +716,7 @@ void LFGQueue::UpdateQueueTimers(uint8 queueId, time_t currTime)
                 break;
         }
 
-        if (queueinfo.bestCompatible.empty())
+        if (!queueinfo.bestCompatible.front())
             FindBestCompatibleInQueue(itQueue);
 
         LfgQueueStatusData queueData(queueId, dungeonId, waitTime, wtAvg, wtTank, wtHealer, wtDps, queuedTime, queueinfo.tanks, queueinfo.healers, queueinfo.dps);
@@ -672,7 +770,7 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
     if (full)
         for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
         {
-            o << "(" << itr->first << "): " << GetCompatibleString(itr->second.compatibility);
+            o << "(" << GetCompatibilityKeyString(itr->first) << "): " << GetCompatibleString(itr->second.compatibility);
             if (!itr->second.roles.empty())
             {
                 o << " (";
@@ -695,30 +793,31 @@ std::string LFGQueue::DumpCompatibleInfo(bool full /* = false */) const
 void LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
 {
     TC_LOG_DEBUG("lfg.queue.compatibles.find", "{}", itrQueue->first.ToString());
-    std::string sguid = itrQueue->first.ToHexString();
 
-    for (LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.begin(); itr != CompatibleMapStore.end(); ++itr)
-        if (itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS &&
-            std::string::npos != itr->first.find(sguid))
-        {
+    auto itKeys = CompatibleKeysByQueueId.find(itrQueue->second.queueId);
+    if (itKeys == CompatibleKeysByQueueId.end())
+        return;
+
+    for (LfgCompatibilityKey const& key : itKeys->second)
+    {
+        LfgCompatibleContainer::const_iterator itr = CompatibleMapStore.find(key);
+        if (itr != CompatibleMapStore.end() && itr->second.compatibility == LFG_COMPATIBLES_WITH_LESS_PLAYERS)
             UpdateBestCompatibleInQueue(itrQueue, itr->first, itr->second.roles);
-        }
+    }
 }
 
-void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, std::string const& key, LfgRolesMap const& roles)
+void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, LfgCompatibilityKey const& key, LfgRolesMap const& roles)
 {
     LfgQueueData& queueData = itrQueue->second;
 
-    uint8 storedSize = queueData.bestCompatible.empty() ? 0 :
-        std::count(queueData.bestCompatible.begin(), queueData.bestCompatible.end(), '|') + 1;
-
-    uint8 size = std::count(key.begin(), key.end(), '|') + 1;
+    uint8 storedSize = GetCompatibilityKeySize(queueData.bestCompatible);
+    uint8 size = GetCompatibilityKeySize(key);
 
     if (size <= storedSize)
         return;
 
     TC_LOG_DEBUG("lfg.queue.compatibles.update", "Changed ({}) to ({}) as best compatible group for {}",
-        queueData.bestCompatible, key, itrQueue->first.ToString());
+        GetCompatibilityKeyString(queueData.bestCompatible), GetCompatibilityKeyString(key), itrQueue->first.ToString());
 
     queueData.bestCompatible = key;
     queueData.tanks = LFG_TANKS_NEEDED;
@@ -27,6 +27,7 @@
 #include "GridNotifiersImpl.h"
 #include "Language.h"
 #include "Log.h"
+#include "Map.h"
 #include "Object.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
@@ -45,7 +46,9 @@
 
 AreaTrigger::AreaTrigger() : WorldObject(false), MapObject(), _spawnId(0), _aurEff(nullptr),
     _duration(0), _totalDuration(0), _timeSinceCreated(0), _verticesUpdatePreviousOrientation(std::numeric_limits<float>::infinity()),
-    _isRemoved(false), _reachedDestination(true), _lastSplineIndex(0), _movementTime(0),
+    _isRemoved(false),
+    _polygonBounds({ std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() }),
+    _reachedDestination(true), _lastSplineIndex(0), _movementTime(0),
     _areaTriggerCreateProperties(nullptr), _areaTriggerTemplate(nullptr)
 {
     m_objectType |= TYPEMASK_AREATRIGGER;
@@ -67,7 +70,7 @@ void AreaTrigger::AddToWorld()
         if (m_zoneScript)
             m_zoneScript->OnAreaTriggerCreate(this);
 
-        GetMap()->GetObjectsStore().Insert<AreaTrigger>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<AreaTrigger>(GetGUID(), this);
         if (_spawnId)
             GetMap()->GetAreaTriggerBySpawnIdStore().insert(std::make_pair(_spawnId, this));
 
@@ -97,7 +100,7 @@ void AreaTrigger::RemoveFromWorld()
 
         if (IsStaticSpawn())
             Trinity::Containers::MultimapErasePair(GetMap()->GetAreaTriggerBySpawnIdStore(), _spawnId, this);
-        GetMap()->GetObjectsStore().Remove<AreaTrigger>(GetGUID());
+        GetMap()->RemoveFromObjectsStore<AreaTrigger>(GetGUID());
     }
 }
 
@@ -369,7 +372,7 @@ void AreaTrigger::Update(uint32 diff)
 
     _ai->OnUpdate(diff);
 
-    UpdateTargetList();
+    GetMap()->AddAreaTriggerToTargetUpdateList(this);
 }
 
 void AreaTrigger::Remove()
@@ -641,16 +644,27 @@ void AreaTrigger::UpdateTargetList()
 void AreaTrigger::SearchUnits(std::vector<Unit*>& targetList, float radius, bool check3D)
 {
     Trinity::AnyUnitInObjectRangeCheck check(this, radius, check3D);
-    if (IsStaticSpawn())
+    auto addUnits = [&](std::vector<Unit*> const& units)
     {
-        Trinity::PlayerListSearcher<Trinity::AnyUnitInObjectRangeCheck> searcher(this, targetList, check);
-        Cell::VisitWorldObjects(this, searcher, GetMaxSearchRadius());
-    }
-    else
+        for (Unit* unit : units)
+            if (unit->IsInWorld() && unit->InSamePhase(GetPhaseShift()) && check(unit))
+                targetList.push_back(unit);
+    };
+
+    std::vector<Map::AreaTriggerSearchCell const*> cells;
+    GetMap()->GetAreaTriggerSearchCells(this, GetMaxSearchRadius(), cells);
+
+    // static spawns only search players
+    for (Map::AreaTriggerSearchCell const* cell : cells)
     {
-        Trinity::UnitListSearcher<Trinity::AnyUnitInObjectRangeCheck> searcher(this, targetList, check);
-        Cell::VisitAllObjects(this, searcher, GetMaxSearchRadius());
+        addUnits(cell->Players);
+        if (!IsStaticSpawn())
+            addUnits(cell->WorldCreatures);
     }
+
+    if (!IsStaticSpawn())
+        for (Map::AreaTriggerSearchCell const* cell : cells)
+            addUnits(cell->GridCreatures);
 }
 
 void AreaTrigger::SearchUnitInSphere(std::vector<Unit*>& targetList)
@@ -701,10 +715,19 @@ void AreaTrigger::SearchUnitInPolygon(std::vector<Unit*>& targetList)
 
     SearchUnits(targetList, GetMaxSearchRadius(), false);
 
-    Trinity::Containers::EraseIf(targetList, [this, minZ, maxZ](Unit const* unit) -> bool
+    float minX = GetPositionX() + _polygonBounds[0];
+    float minY = GetPositionY() + _polygonBounds[1];
+    float maxX = GetPositionX() + _polygonBounds[2];
+    float maxY = GetPositionY() + _polygonBounds[3];
+
+    Trinity::Containers::EraseIf(targetList, [this, minX, minY, minZ, maxX, maxY, maxZ](Unit const* unit) -> bool
     {
         return unit->GetPositionZ() < minZ
             || unit->GetPositionZ() > maxZ
+            || unit->GetPositionX() < minX
+            || unit->GetPositionX() > maxX
+            || unit->GetPositionY() < minY
+            || unit->GetPositionY() > maxY
             || !unit->IsInPolygon2D(*this, _polygonVertices);
     });
 }
@@ -916,6 +939,15 @@ void AreaTrigger::UpdatePolygonVertices()
         vertice.Relocate(x, y);
     }
 
+    _polygonBounds = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+    for (Position const& vertice : _polygonVertices)
+    {
+        _polygonBounds[0] = std::min(_polygonBounds[0], vertice.GetPositionX());
+        _polygonBounds[1] = std::min(_polygonBounds[1], vertice.GetPositionY());
+        _polygonBounds[2] = std::max(_polygonBounds[2], vertice.GetPositionX());
+        _polygonBounds[3] = std::max(_polygonBounds[3], vertice.GetPositionY());
+    }
+
     _verticesUpdatePreviousOrientation = newOrientation;
 }
 
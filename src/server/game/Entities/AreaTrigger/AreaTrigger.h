@@ -165,6 +165,9 @@ class TC_GAME_API AreaTrigger final : public WorldObject, public GridObject<Area
 
         void UpdateShape();
 
+        // called by the map once per tick after all objects were updated, see Map::AddAreaTriggerToTargetUpdateList
+        void UpdateTargetList();
+
         UF::UpdateField<UF::AreaTriggerData, 0, TYPEID_AREATRIGGER> m_areaTriggerData;
 
     protected:
@@ -182,7 +185,6 @@ class TC_GAME_API AreaTrigger final : public WorldObject, public GridObject<Area
         void ClearScaleCurve(UF::MutableFieldReference<UF::ScaleCurve, false> scaleCurveMutator);
         void SetScaleCurve(UF::MutableFieldReference<UF::ScaleCurve, false> scaleCurveMutator, Optional<AreaTriggerScaleCurveTemplate> const& curve);
 
-        void UpdateTargetList();
         void SearchUnits(std::vector<Unit*>& targetList, float radius, bool check3D);
         void SearchUnitInSphere(std::vector<Unit*>& targetList);
         void SearchUnitInBox(std::vector<Unit*>& targetList);
@@ -222,6 +224,7 @@ class TC_GAME_API AreaTrigger final : public WorldObject, public GridObject<Area
         Position _rollPitchYaw;
         Position _targetRollPitchYaw;
         std::vector<Position> _polygonVertices;
+        std::array<float, 4> _polygonBounds; // min x, min y, max x, max y of _polygonVertices, rejects units before the edge tests
         std::unique_ptr<::Movement::Spline<int32>> _spline;
 
         bool _reachedDestination;
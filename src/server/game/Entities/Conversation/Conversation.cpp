@@ -49,7 +49,7 @@ void Conversation::AddToWorld()
     ///- Register the Conversation for guid lookup and for caster
     if (!IsInWorld())
     {
-        GetMap()->GetObjectsStore().Insert<Conversation>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<Conversation>(GetGUID(), this);
         WorldObject::AddToWorld();
     }
 }
@@ -60,7 +60,7 @@ void Conversation::RemoveFromWorld()
     if (IsInWorld())
     {
         WorldObject::RemoveFromWorld();
-        GetMap()->GetObjectsStore().Remove<Conversation>(GetGUID());
+        GetMap()->RemoveFromObjectsStore<Conversation>(GetGUID());
     }
 }
 
@@ -374,6 +374,12 @@ void Conversation::BuildValuesUpdate(ByteBuffer* data, Player const* target) con
     data->put<uint32>(sizePos, data->wpos() - sizePos - 4);
 }
 
+bool Conversation::HasViewerDependentChangedValues() const
+{
+    // line start times are stored inside Lines, any conversation change is treated as viewer dependent
+    return WorldObject::HasViewerDependentChangedValues() || m_values.HasChanged(TYPEID_CONVERSATION);
+}
+
 void Conversation::BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::ObjectData::Mask const& requestedObjectMask,
     UF::ConversationData::Mask const& requestedConversationMask, Player const* target) const
 {
@@ -38,6 +38,7 @@ class TC_GAME_API Conversation final : public WorldObject, public GridObject<Con
         void ClearUpdateMask(bool remove) override;
 
     public:
+        bool HasViewerDependentChangedValues() const override;
         void BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::ObjectData::Mask const& requestedObjectMask,
             UF::ConversationData::Mask const& requestedConversationMask, Player const* target) const;
 
@@ -38,6 +38,7 @@
 #include "MapManager.h"
 #include "MiscPackets.h"
 #include "MotionMaster.h"
+#include "MoveSpline.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "PhasingHandler.h"
@@ -315,7 +316,7 @@ Creature::Creature(bool isWorldObject) : Unit(isWorldObject), MapObject(), m_Pla
     m_AlreadyCallAssistance(false), m_AlreadySearchedAssistance(false), m_cannotReachTarget(false), m_cannotReachTimer(0),
     m_meleeDamageSchoolMask(SPELL_SCHOOL_MASK_NORMAL), m_originalEntry(0), m_homePosition(), m_transportHomePosition(),
     m_creatureInfo(nullptr), m_creatureData(nullptr), m_creatureDifficulty(nullptr), m_stringIds(), _waypointPathId(0), _currentWaypointNodeInfo(0, 0),
-    m_formation(nullptr), m_triggerJustAppeared(true), m_respawnCompatibilityMode(false), _lastDamagedTime(0),
+    m_formation(nullptr), m_triggerJustAppeared(true), m_respawnCompatibilityMode(false), _dormantUpdateDiff(0), _idleAIUpdateDiff(0), _lastDamagedTime(0),
     _regenerateHealth(true), _creatureImmunitiesId(0), _gossipMenuId(0), _sparringHealthPct(0)
 {
     m_regenTimer = CREATURE_REGEN_INTERVAL;
@@ -339,7 +340,7 @@ void Creature::AddToWorld()
     ///- Register the creature for guid lookup
     if (!IsInWorld())
     {
-        GetMap()->GetObjectsStore().Insert<Creature>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<Creature>(GetGUID(), this);
         if (m_spawnId)
             GetMap()->GetCreatureBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
 
@@ -368,7 +369,7 @@ void Creature::RemoveFromWorld()
 
         if (m_spawnId)
             Trinity::Containers::MultimapErasePair(GetMap()->GetCreatureBySpawnIdStore(), m_spawnId, this);
-        GetMap()->GetObjectsStore().Remove<Creature>(GetGUID());
+        GetMap()->RemoveFromObjectsStore<Creature>(GetGUID());
     }
 }
 
@@ -735,6 +736,24 @@ void Creature::ApplyAllStaticFlags(CreatureStaticFlagsHolder const& flags)
 
 void Creature::Update(uint32 diff)
 {
+    if (uint32 dormantUpdateInterval = sWorld->getIntConfig(CONFIG_CREATURE_DORMANT_UPDATE_INTERVAL))
+    {
+        bool dormant = CanBeDormant();
+        GetMap()->CountCreatureUpdate(dormant);
+        if (dormant)
+        {
+            _dormantUpdateDiff += diff;
+            if (_dormantUpdateDiff < dormantUpdateInterval)
+                return;
+
+            diff = std::exchange(_dormantUpdateDiff, 0);
+        }
+        else
+            diff += std::exchange(_dormantUpdateDiff, 0);
+    }
+    else if (_dormantUpdateDiff)
+        diff += std::exchange(_dormantUpdateDiff, 0);
+
     if (IsAIEnabled() && m_triggerJustAppeared && m_deathState != DEAD)
     {
         if (IsAreaSpiritHealer() && !IsAreaSpiritHealerIndividual())
@@ -855,7 +874,9 @@ void Creature::Update(uint32 diff)
                     m_boundaryCheckTime -= diff;
             }
 
-            Unit::AIUpdateTick(diff);
+            _idleAIUpdateDiff += diff;
+            if (_idleAIUpdateDiff >= GetIdleAIUpdateDelay())
+                Unit::AIUpdateTick(std::exchange(_idleAIUpdateDiff, 0));
 
             DoMeleeAttackIfReady();
 
@@ -1590,6 +1611,34 @@ void Creature::SelectLevel()
     UpdateLevelDependantStats();
 }
 
+// idle creatures nobody can see update at a reduced rate, anything that makes them act or be seen wakes them on their next update
+bool Creature::CanBeDormant() const
+{
+    if (isActiveObject() || IsPet() || GetCharmerOrOwnerGUID().IsPlayer())
+        return false;
+
+    if (IsEngaged() || IsInEvadeMode() || IsThreatened() || HasUnitState(UNIT_STATE_CASTING))
+        return false;
+
+    if (!movespline->Finalized() || m_triggerJustAppeared || !m_Events.GetEvents().empty())
+        return false;
+
+    return !GetMap()->IsPlayerNearCell(Trinity::ComputeCellCoord(GetPositionX(), GetPositionY()));
+}
+
+// out of combat AIs that allow it skip updates until their next timer is due, MoveInLineOfSight is not affected
+uint32 Creature::GetIdleAIUpdateDelay() const
+{
+    uint32 idleUpdateInterval = sWorld->getIntConfig(CONFIG_CREATURE_IDLE_AI_UPDATE_INTERVAL);
+    if (!idleUpdateInterval || !IsAIEnabled() || IsCharmed())
+        return 0;
+
+    if (IsEngaged() || IsInEvadeMode() || IsThreatened())
+        return 0;
+
+    return std::min(idleUpdateInterval, AI()->GetIdleUpdateDelay());
+}
+
 void Creature::UpdateLevelDependantStats()
 {
     CreatureTemplate const* cInfo = GetCreatureTemplate();
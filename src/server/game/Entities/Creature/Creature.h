@@ -19,6 +19,7 @@
 #define TRINITYCORE_CREATURE_H
 
 #include "Unit.h"
+#include "AllocationTracker.h"
 #include "Common.h"
 #include "CreatureData.h"
 #include "DatabaseEnvFwd.h"
@@ -72,6 +73,8 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         explicit Creature(bool isWorldObject = false);
         ~Creature();
 
+        TC_ALLOCATION_TAGGED_CLASS(Creatures)
+
         void AddToWorld() override;
         void RemoveFromWorld() override;
 
@@ -98,6 +101,8 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         ObjectGuid::LowType GetSpawnId() const { return m_spawnId; }
 
         void Update(uint32 time) override;                         // overwrited Unit::Update
+        bool CanBeDormant() const;
+        uint32 GetIdleAIUpdateDelay() const;
         void Heartbeat() override;
 
         void GetRespawnPosition(float &x, float &y, float &z, float* ori = nullptr, float* dist = nullptr) const;
@@ -537,6 +542,8 @@ class TC_GAME_API Creature : public Unit, public GridObject<Creature>, public Ma
         CreatureGroup* m_formation;
         bool m_triggerJustAppeared;
         bool m_respawnCompatibilityMode;
+        uint32 _dormantUpdateDiff;                          // time skipped while dormant, passed on with the next full update
+        uint32 _idleAIUpdateDiff;                           // time skipped by postponed out of combat AI updates
 
         /* Spell focus system */
         void ReacquireSpellFocusTarget();
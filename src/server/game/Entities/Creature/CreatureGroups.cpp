@@ -20,9 +20,11 @@
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "DatabaseEnv.h"
+#include "FormationMovementGenerator.h"
 #include "Log.h"
 #include "Map.h"
 #include "MotionMaster.h"
+#include "MoveSpline.h"
 #include "MovementGenerator.h"
 #include "ObjectMgr.h"
 
@@ -189,7 +191,8 @@ void FormationMgr::AddFormationMember(ObjectGuid::LowType spawnId, float followA
     _creatureGroupMap.emplace(spawnId, std::move(member));
 }
 
-CreatureGroup::CreatureGroup(ObjectGuid::LowType leaderSpawnId) : _leader(nullptr), _members(), _leaderSpawnId(leaderSpawnId), _formed(false), _engaging(false)
+CreatureGroup::CreatureGroup(ObjectGuid::LowType leaderSpawnId) : _leader(nullptr), _members(), _leaderSpawnId(leaderSpawnId), _formed(false), _engaging(false),
+    _leaderDestinationSplineId(0)
 {
 }
 
@@ -206,6 +209,7 @@ void CreatureGroup::AddMember(Creature* member)
     {
         TC_LOG_DEBUG("entities.unit", "Unit {} is formation leader. Adding group.", member->GetGUID().ToString());
         _leader = member;
+        _leaderDestination.reset();
     }
 
     // formation must be registered at this point
@@ -217,7 +221,10 @@ void CreatureGroup::AddMember(Creature* member)
 void CreatureGroup::RemoveMember(Creature* member)
 {
     if (_leader == member)
+    {
         _leader = nullptr;
+        _leaderDestination.reset();
+    }
 
     _members.erase(member);
     member->SetFormation(nullptr);
@@ -305,3 +312,17 @@ bool CreatureGroup::CanLeaderStartMoving() const
 
     return true;
 }
+
+FormationLeaderDestination CreatureGroup::GetLeaderDestination()
+{
+    std::lock_guard lock(_leaderDestinationLock);
+    if (!_leaderDestination || _leaderDestinationSplineId != _leader->movespline->GetId()
+        || _leaderDestination->Predicted == _leader->movespline->Finalized() || _leaderDestinationOrigin != _leader->GetPosition())
+    {
+        _leaderDestination = FormationMovementGenerator::PredictLeaderDestination(_leader);
+        _leaderDestinationOrigin = _leader->GetPosition();
+        _leaderDestinationSplineId = _leader->movespline->GetId();
+    }
+
+    return *_leaderDestination;
+}
@@ -20,6 +20,9 @@
 
 #include "Define.h"
 #include "ObjectGuid.h"
+#include "Optional.h"
+#include "Position.h"
+#include <mutex>
 #include <unordered_map>
 
 enum GroupAIFlags
@@ -34,7 +37,6 @@ enum GroupAIFlags
 class Creature;
 class CreatureGroup;
 class Unit;
-struct Position;
 
 struct FormationInfo
 {
@@ -45,6 +47,16 @@ struct FormationInfo
     uint32 LeaderWaypointIDs[2];
 };
 
+// where formation members expect their leader to be when their next movement ends
+struct FormationLeaderDestination
+{
+    Position Destination;
+    float RelativeAngle = 0.0f;             // angle from the leader to its current spline destination
+    float TravelDistance = 0.0f;            // distance the destination was moved ahead along the leader's spline
+    float Velocity = 0.0f;
+    bool Predicted = false;                 // false if the leader is not moving
+};
+
 class TC_GAME_API FormationMgr
 {
     private:
@@ -75,6 +87,12 @@ class TC_GAME_API CreatureGroup
         bool _formed;
         bool _engaging;
 
+        // leader destination shared by all members, recalculated when the leader moved or launched another spline
+        std::mutex _leaderDestinationLock;
+        Optional<FormationLeaderDestination> _leaderDestination;
+        Position _leaderDestinationOrigin;
+        uint32 _leaderDestinationSplineId;
+
     public:
         //Group cannot be created empty
         explicit CreatureGroup(ObjectGuid::LowType leaderSpawnId);
@@ -94,6 +112,9 @@ class TC_GAME_API CreatureGroup
         void LeaderStartedMoving();
         void MemberEngagingTarget(Creature* member, Unit* target);
         bool CanLeaderStartMoving() const;
+
+        // requires a leader
+        FormationLeaderDestination GetLeaderDestination();
 };
 
 #define sFormationMgr FormationMgr::instance()
@@ -50,9 +50,11 @@
 #include "PoolMgr.h"
 #include "QueryPackets.h"
 #include "Util.h"
+#include "ScriptProfiler.h"
 #include "SpellAuras.h"
 #include "SpellMgr.h"
 #include "Transport.h"
+#include "ViewerDependentValues.h"
 #include "Vignette.h"
 #include "World.h"
 #include <G3D/Box.h>
@@ -416,13 +418,8 @@ public:
 
     void UpdatePassengerPositions()
     {
-        for (WorldObject* passenger : _passengers)
-        {
-            float x, y, z, o;
-            passenger->m_movementInfo.transport.pos.GetPosition(x, y, z, o);
-            CalculatePassengerPosition(x, y, z, &o);
-            UpdatePassengerPosition(_owner.GetMap(), passenger, x, y, z, o, true);
-        }
+        TransportBase::UpdatePassengerPositions(_owner.GetMap(), _passengers,
+            PassengerTransform(_owner.GetPositionX(), _owner.GetPositionY(), _owner.GetPositionZ(), _owner.GetOrientation()));
     }
 
     uint32 GetTransportPeriod() const
@@ -914,7 +911,7 @@ void GameObject::AddToWorld()
         if (m_zoneScript)
             m_zoneScript->OnGameObjectCreate(this);
 
-        GetMap()->GetObjectsStore().Insert<GameObject>(GetGUID(), this);
+        GetMap()->AddToObjectsStore<GameObject>(GetGUID(), this);
         if (m_spawnId)
             GetMap()->GetGameObjectBySpawnIdStore().insert(std::make_pair(m_spawnId, this));
 
@@ -954,7 +951,7 @@ void GameObject::RemoveFromWorld()
 
         if (m_spawnId)
             Trinity::Containers::MultimapErasePair(GetMap()->GetGameObjectBySpawnIdStore(), m_spawnId, this);
-        GetMap()->GetObjectsStore().Remove<GameObject>(GetGUID());
+        GetMap()->RemoveFromObjectsStore<GameObject>(GetGUID());
     }
 }
 
@@ -1230,7 +1227,22 @@ void GameObject::Update(uint32 diff)
     WorldObject::Update(diff);
 
     if (AI())
+    {
+        ScriptProfiler::ScopedCall profileCall(ScriptProfileHook::GameObjectAI, GetMapId(), [this]() -> std::string
+        {
+            std::string const& scriptName = sObjectMgr->GetScriptName(GetScriptId());
+            if (!scriptName.empty())
+                return scriptName;
+
+            // database selected AIs (SmartGameObjectAI) are reported per gameobject entry
+            if (!GetAIName().empty())
+                return Trinity::StringFormat("{} {}", GetAIName(), GetEntry());
+
+            return "default";
+        });
+
         AI()->UpdateAI(diff);
+    }
     else if (!AIM_Initialize())
         TC_LOG_ERROR("misc", "Could not initialize GameObjectAI");
 
@@ -3987,6 +3999,28 @@ GameObject* GameObject::GetLinkedTrap()
 
 void GameObject::BuildValuesCreate(ByteBuffer* data, Player const* target) const
 {
+    // static gameobjects are created for every player passing by with the same values,
+    // reuse the serialized fields as long as nothing changed and the viewer dependent values match
+    bool canUseCache = !IsTransport() && !m_values.GetChangedObjectTypeMask();
+    CreateValuesCacheEntry key;
+    if (canUseCache)
+    {
+        key.DynamicFlags = UF::ViewerDependentValue<UF::ObjectData::DynamicFlagsTag>::GetValue(&*m_objectData, this, target);
+        key.Flags = UF::ViewerDependentValue<UF::GameObjectData::FlagsTag>::GetValue(&*m_gameObjectData, this, target);
+        key.State = UF::ViewerDependentValue<UF::GameObjectData::StateTag>::GetValue(&*m_gameObjectData, this, target);
+
+        for (CreateValuesCacheEntry const& entry : m_createValuesCache)
+        {
+            if (entry.DynamicFlags == key.DynamicFlags && entry.Flags == key.Flags && entry.State == key.State)
+            {
+                data->append(entry.Data.data(), entry.Data.size());
+                return;
+            }
+        }
+    }
+
+    data->FlushBits();
+
     UF::UpdateFieldFlag flags = GetUpdateFieldFlagsFor(target);
     std::size_t sizePos = data->wpos();
     *data << uint32(0);
@@ -3994,6 +4028,12 @@ void GameObject::BuildValuesCreate(ByteBuffer* data, Player const* target) const
     m_objectData->WriteCreate(*data, flags, this, target);
     m_gameObjectData->WriteCreate(*data, flags, this, target);
     data->put<uint32>(sizePos, data->wpos() - sizePos - 4);
+
+    if (canUseCache && m_createValuesCache.size() < MAX_CREATE_VALUES_CACHE_ENTRIES)
+    {
+        key.Data.assign(data->contents() + sizePos, data->contents() + data->wpos());
+        m_createValuesCache.push_back(std::move(key));
+    }
 }
 
 void GameObject::BuildValuesUpdate(ByteBuffer* data, Player const* target) const
@@ -4012,6 +4052,18 @@ void GameObject::BuildValuesUpdate(ByteBuffer* data, Player const* target) const
     data->put<uint32>(sizePos, data->wpos() - sizePos - 4);
 }
 
+bool GameObject::HasViewerDependentChangedValues() const
+{
+    if (WorldObject::HasViewerDependentChangedValues())
+        return true;
+
+    if (!m_values.HasChanged(TYPEID_GAMEOBJECT))
+        return false;
+
+    return m_gameObjectData->IsChanged(&UF::GameObjectData::Flags)
+        || m_gameObjectData->IsChanged(&UF::GameObjectData::State);
+}
+
 void GameObject::BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::ObjectData::Mask const& requestedObjectMask,
     UF::GameObjectData::Mask const& requestedGameObjectMask, Player const* target) const
 {
@@ -4051,6 +4103,7 @@ void GameObject::ValuesUpdateForPlayerWithMaskSender::operator()(Player const* p
 
 void GameObject::ClearUpdateMask(bool remove)
 {
+    m_createValuesCache.clear();
     m_values.ClearChangesMask(&GameObject::m_gameObjectData);
     Object::ClearUpdateMask(remove);
 }
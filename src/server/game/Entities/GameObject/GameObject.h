@@ -174,6 +174,7 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
         void ClearUpdateMask(bool remove) override;
 
     public:
+        bool HasViewerDependentChangedValues() const override;
         void BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::ObjectData::Mask const& requestedObjectMask,
             UF::GameObjectData::Mask const& requestedGameObjectMask, Player const* target) const;
 
@@ -525,5 +526,19 @@ class TC_GAME_API GameObject : public WorldObject, public GridObject<GameObject>
         std::unique_ptr<std::unordered_map<ObjectGuid, PerPlayerState>> m_perPlayerState;
 
         std::unordered_map<ObjectGuid, PerPlayerState>& GetOrCreatePerPlayerStates();
+
+        // serialized BuildValuesCreate output, one entry per combination of viewer dependent values seen by receivers
+        // only used while there are no pending changes, dropped by ClearUpdateMask
+        struct CreateValuesCacheEntry
+        {
+            uint32 DynamicFlags = 0;
+            uint32 Flags = 0;
+            int8 State = 0;
+            std::vector<uint8> Data;
+        };
+
+        static constexpr std::size_t MAX_CREATE_VALUES_CACHE_ENTRIES = 4;
+
+        mutable std::vector<CreateValuesCacheEntry> m_createValuesCache;
 };
 #endif
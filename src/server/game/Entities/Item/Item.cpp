@@ -1638,7 +1638,10 @@ Item* Item::CreateItem(uint32 itemEntry, uint32 count, ItemContext context, Play
         {
             item->SetCount(count);
             if (addDefaultBonuses)
-                item->SetBonuses(ItemBonusMgr::GetBonusListsForItem(itemEntry, context));
+            {
+                std::span<int32 const> bonusListIDs = ItemBonusMgr::GetBonusListsForItem(itemEntry, context);
+                item->SetBonuses({ bonusListIDs.begin(), bonusListIDs.end() });
+            }
 
             return item;
         }
@@ -19,8 +19,11 @@
 #include "ConditionMgr.h"
 #include "DB2Stores.h"
 #include "MapUtils.h"
+#include "Hash.h"
 #include "ObjectMgr.h"
 #include "Player.h"
+#include <mutex>
+#include <shared_mutex>
 
 namespace
 {
@@ -40,10 +43,55 @@ std::unordered_map<int16 /*itemLevelDelta*/, uint32 /*itemBonusListId*/> _itemLe
 std::unordered_map<uint32 /*itemLevelSelectorQualitySetId*/, ItemLevelSelectorQualities> _itemLevelQualitySelectorQualities;
 std::unordered_map<uint32 /*itemBonusTreeId*/, std::set<ItemBonusTreeNodeEntry const*>> _itemBonusTrees;
 std::unordered_multimap<uint32 /*itemId*/, uint32 /*itemBonusTreeId*/> _itemToBonusTree;
+std::unordered_map<uint32 /*itemBonusTreeId*/, std::vector<int32>> _allBonusListsByTree;
+
+struct GeneratedBonusListsKey
+{
+    uint32 ItemId;
+    ItemContext Context;
+    Optional<int32> MythicPlusKeystoneLevel;
+    Optional<int32> PvpTier;
+
+    friend bool operator==(GeneratedBonusListsKey const& left, GeneratedBonusListsKey const& right) = default;
+};
+
+struct GeneratedBonusListsKeyHash
+{
+    std::size_t operator()(GeneratedBonusListsKey const& key) const
+    {
+        std::size_t hashVal = 0;
+        Trinity::hash_combine(hashVal, key.ItemId);
+        Trinity::hash_combine(hashVal, key.Context);
+        Trinity::hash_combine(hashVal, key.MythicPlusKeystoneLevel.value_or(-1));
+        Trinity::hash_combine(hashVal, key.PvpTier.value_or(-1));
+        return hashVal;
+    }
+};
+
+// generated bonus lists only depend on static data, entries are never removed so returned spans stay valid
+// once full, results are generated into a per thread buffer instead
+constexpr std::size_t MaxGeneratedBonusListsCacheSize = 0x10000;
+std::unordered_map<GeneratedBonusListsKey, std::vector<int32>, GeneratedBonusListsKeyHash> _generatedBonusListsCache;
+std::shared_mutex _generatedBonusListsCacheLock;
 }
 
 namespace ItemBonusMgr
 {
+template<typename Visitor>
+void VisitItemBonusTree(uint32 itemBonusTreeId, Visitor visitor)
+{
+    auto treeItr = _itemBonusTrees.find(itemBonusTreeId);
+    if (treeItr == _itemBonusTrees.end())
+        return;
+
+    for (ItemBonusTreeNodeEntry const* bonusTreeNode : treeItr->second)
+    {
+        visitor(bonusTreeNode);
+        if (bonusTreeNode->ChildItemBonusTreeID)
+            VisitItemBonusTree(bonusTreeNode->ChildItemBonusTreeID, visitor);
+    }
+}
+
 void Load()
 {
     for (AzeriteUnlockMappingEntry const* azeriteUnlockMapping : sAzeriteUnlockMappingStore)
@@ -69,6 +117,19 @@ void Load()
 
     for (ItemXBonusTreeEntry const* itemBonusTreeAssignment : sItemXBonusTreeStore)
         _itemToBonusTree.insert({ itemBonusTreeAssignment->ItemID, itemBonusTreeAssignment->ItemBonusTreeID });
+
+    for (auto const& [itemBonusTreeId, _] : _itemBonusTrees)
+    {
+        std::vector<int32> bonusListIDs;
+        VisitItemBonusTree(itemBonusTreeId, [&bonusListIDs](ItemBonusTreeNodeEntry const* bonusTreeNode)
+        {
+            if (bonusTreeNode->ChildItemBonusListID)
+                bonusListIDs.push_back(bonusTreeNode->ChildItemBonusListID);
+        });
+
+        if (!bonusListIDs.empty())
+            _allBonusListsByTree[itemBonusTreeId] = std::move(bonusListIDs);
+    }
 }
 
 ItemContext GetContextForPlayer(MapDifficultyEntry const* mapDifficulty, Player const* player)
@@ -437,13 +498,11 @@ int32 GetAzeriteUnlockBonusList(uint16 azeriteUnlockMappingSetId, uint16 minItem
     return 0;
 }
 
-std::vector<int32> GetBonusListsForItem(uint32 itemId, ItemBonusGenerationParams const& params)
+void GenerateBonusListsForItem(uint32 itemId, ItemBonusGenerationParams const& params, std::vector<int32>& bonusListIDs)
 {
-    std::vector<int32> bonusListIDs;
-
     ItemTemplate const* itemTemplate = sObjectMgr->GetItemTemplate(itemId);
     if (!itemTemplate)
-        return bonusListIDs;
+        return;
 
     uint32 itemLevelSelectorId = 0;
 
@@ -479,33 +538,37 @@ std::vector<int32> GetBonusListsForItem(uint32 itemId, ItemBonusGenerationParams
         if (int32 azeriteUnlockBonusListId = GetAzeriteUnlockBonusList(selector->AzeriteUnlockMappingSet, selector->MinItemLevel, itemTemplate->GetInventoryType()))
             bonusListIDs.push_back(azeriteUnlockBonusListId);
     }
-
-    return bonusListIDs;
 }
 
-template<typename Visitor>
-void VisitItemBonusTree(uint32 itemBonusTreeId, Visitor visitor)
+std::span<int32 const> GetBonusListsForItem(uint32 itemId, ItemBonusGenerationParams const& params)
 {
-    auto treeItr = _itemBonusTrees.find(itemBonusTreeId);
-    if (treeItr == _itemBonusTrees.end())
-        return;
+    GeneratedBonusListsKey key{ .ItemId = itemId, .Context = params.Context, .MythicPlusKeystoneLevel = params.MythicPlusKeystoneLevel, .PvpTier = params.PvpTier };
 
-    for (ItemBonusTreeNodeEntry const* bonusTreeNode : treeItr->second)
     {
-        visitor(bonusTreeNode);
-        if (bonusTreeNode->ChildItemBonusTreeID)
-            VisitItemBonusTree(bonusTreeNode->ChildItemBonusTreeID, visitor);
+        std::shared_lock<std::shared_mutex> lock(_generatedBonusListsCacheLock);
+        if (std::vector<int32> const* bonusListIDs = Trinity::Containers::MapGetValuePtr(_generatedBonusListsCache, key))
+            return *bonusListIDs;
     }
-}
 
-std::vector<int32> GetAllBonusListsForTree(uint32 itemBonusTreeId)
-{
     std::vector<int32> bonusListIDs;
-    VisitItemBonusTree(itemBonusTreeId, [&bonusListIDs](ItemBonusTreeNodeEntry const* bonusTreeNode)
+    GenerateBonusListsForItem(itemId, params, bonusListIDs);
+
     {
-        if (bonusTreeNode->ChildItemBonusListID)
-            bonusListIDs.push_back(bonusTreeNode->ChildItemBonusListID);
-    });
-    return bonusListIDs;
+        std::unique_lock<std::shared_mutex> lock(_generatedBonusListsCacheLock);
+        if (_generatedBonusListsCache.size() < MaxGeneratedBonusListsCacheSize || _generatedBonusListsCache.contains(key))
+            return _generatedBonusListsCache.try_emplace(key, std::move(bonusListIDs)).first->second;
+    }
+
+    thread_local std::vector<int32> uncachedBonusListIDs;
+    uncachedBonusListIDs = std::move(bonusListIDs);
+    return uncachedBonusListIDs;
+}
+
+std::span<int32 const> GetAllBonusListsForTree(uint32 itemBonusTreeId)
+{
+    if (std::vector<int32> const* bonusListIDs = Trinity::Containers::MapGetValuePtr(_allBonusListsByTree, itemBonusTreeId))
+        return *bonusListIDs;
+
+    return {};
 }
 }
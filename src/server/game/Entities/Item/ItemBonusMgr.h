@@ -48,8 +48,9 @@ struct ItemBonusGenerationParams
     Optional<int32> PvpTier;
 };
 
-TC_GAME_API std::vector<int32> GetBonusListsForItem(uint32 itemId, ItemBonusGenerationParams const& params);
-TC_GAME_API std::vector<int32> GetAllBonusListsForTree(uint32 itemBonusTreeId);
+// The returned span is only guaranteed to stay valid until the next call on the same thread
+TC_GAME_API std::span<int32 const> GetBonusListsForItem(uint32 itemId, ItemBonusGenerationParams const& params);
+TC_GAME_API std::span<int32 const> GetAllBonusListsForTree(uint32 itemBonusTreeId);
 }
 
 #endif // TRINITY_ITEM_BONUS_MGR_H
@@ -203,6 +203,24 @@ void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player const* tar
     data->AddUpdateBlock();
 }
 
+void Object::BuildValuesUpdateBlockForPlayer(UpdateData* data, Player const* target, ValuesUpdateCache& cache) const
+{
+    UF::UpdateFieldFlag flags = GetUpdateFieldFlagsFor(target);
+    ByteBuffer const* values = cache.Find(flags);
+    if (!values)
+    {
+        ByteBuffer& block = cache.Add(flags);
+        BuildValuesUpdate(&block, target);
+        values = &block;
+    }
+
+    ByteBuffer& buf = PrepareValuesUpdateBuffer(data);
+
+    buf.append(*values);
+
+    data->AddUpdateBlock();
+}
+
 void Object::BuildValuesUpdateBlockForPlayerWithFlag(UpdateData* data, UF::UpdateFieldFlag flags, Player const* target) const
 {
     ByteBuffer& buf = PrepareValuesUpdateBuffer(data);
@@ -804,7 +822,7 @@ void Object::ClearUpdateMask(bool remove)
     }
 }
 
-void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) const
+void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map, ValuesUpdateCache* cache /*= nullptr*/) const
 {
     UpdateDataMapType::iterator iter = data_map.find(player);
 
@@ -815,7 +833,20 @@ void Object::BuildFieldsUpdate(Player* player, UpdateDataMapType& data_map) cons
         iter = p.first;
     }
 
-    BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+    // a player's own update also carries its active player data, it is never shared
+    if (cache && player != this)
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first, *cache);
+    else
+        BuildValuesUpdateBlockForPlayer(&iter->second, iter->first);
+}
+
+bool Object::HasViewerDependentChangedValues() const
+{
+    if (!m_values.HasChanged(TYPEID_OBJECT))
+        return false;
+
+    return m_objectData->IsChanged(&UF::ObjectData::EntryID)
+        || m_objectData->IsChanged(&UF::ObjectData::DynamicFlags);
 }
 
 std::string Object::GetDebugInfo() const
@@ -1002,10 +1033,41 @@ void WorldObject::CleanupsBeforeDelete(bool /*finalCleanup*/)
     m_Events.KillAllEvents(false);                      // non-delatable (currently cast spells) will not deleted now but it will deleted at call in Map::RemoveAllObjectsInRemoveList
 }
 
+void WorldObject::AddToNotify(uint16 f)
+{
+    m_notifyflags |= f;
+    if (IsInWorld())
+        GetMap()->MarkRelocationNotifyCell(GetPositionX(), GetPositionY());
+}
+
 void WorldObject::UpdatePositionData()
 {
+    float reuseDistance = sWorld->getFloatConfig(CONFIG_TERRAIN_STATUS_REUSE_DISTANCE);
+    if (reuseDistance <= 0.0f)
+    {
+        PositionFullTerrainStatus data;
+        GetMap()->GetFullTerrainStatusForPosition(_phaseShift, GetPositionX(), GetPositionY(), GetPositionZ(), data, {}, GetCollisionHeight());
+        ProcessPositionDataChanged(data);
+        return;
+    }
+
+    float collisionHeight = GetCollisionHeight();
+    uint32 terrainMapId = PhasingHandler::GetTerrainMapId(_phaseShift, GetMapId(), GetMap()->GetTerrain(), GetPositionX(), GetPositionY());
+    if (_lastTerrainStatus)
+    {
+        // liquid status changes with every bit of height, only dry positions are reused
+        TerrainStatusSnapshot const& last = *_lastTerrainStatus;
+        if (last.Status.liquidStatus == LIQUID_MAP_NO_WATER && last.TerrainMapId == terrainMapId && last.CollisionHeight == collisionHeight
+            && last.Pos.GetExactDist2dSq(this) <= reuseDistance * reuseDistance && std::fabs(last.Pos.GetPositionZ() - GetPositionZ()) <= reuseDistance)
+        {
+            ProcessPositionDataChanged(last.Status);
+            return;
+        }
+    }
+
     PositionFullTerrainStatus data;
-    GetMap()->GetFullTerrainStatusForPosition(_phaseShift, GetPositionX(), GetPositionY(), GetPositionZ(), data, {}, GetCollisionHeight());
+    GetMap()->GetFullTerrainStatusForPosition(_phaseShift, GetPositionX(), GetPositionY(), GetPositionZ(), data, {}, collisionHeight);
+    _lastTerrainStatus = { .Pos = GetPosition(), .TerrainMapId = terrainMapId, .CollisionHeight = collisionHeight, .Status = data };
     ProcessPositionDataChanged(data);
 }
 
@@ -1441,6 +1503,52 @@ void WorldObject::UpdateAllowedPositionZ(float x, float y, float &z, float* grou
     }
 }
 
+void WorldObject::UpdateAllowedPositionZ(std::span<G3D::Vector3> points) const
+{
+    // TODO: Allow transports to be part of dynamic vmap tree
+    if (GetTransport())
+        return;
+
+    Unit const* unit = ToUnit();
+
+    // swimming units need the liquid status of each point, there is nothing to share between them
+    if (unit && !unit->CanFly() && unit->CanSwim())
+    {
+        for (G3D::Vector3& point : points)
+            UpdateAllowedPositionZ(point.x, point.y, point.z);
+
+        return;
+    }
+
+    // same search start as GetMapHeight
+    std::vector<G3D::Vector3> searchPoints(points.begin(), points.end());
+    for (G3D::Vector3& searchPoint : searchPoints)
+        if (searchPoint.z != MAX_HEIGHT)
+            searchPoint.z += Z_OFFSET_FIND_HEIGHT;
+
+    std::vector<float> heights(points.size());
+    GetMap()->GetHeights(GetPhaseShift(), searchPoints, heights);
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        float& z = points[i].z;
+        if (unit)
+        {
+            float hoverOffset = unit->GetHoverOffset();
+            if (!unit->CanFly())
+            {
+                // hovering units cannot go below their hover height
+                if (heights[i] > INVALID_HEIGHT)
+                    z = heights[i] + hoverOffset;
+            }
+            else
+                z = std::max(z, heights[i] + hoverOffset);
+        }
+        else if (heights[i] > INVALID_HEIGHT)
+            z = heights[i];
+    }
+}
+
 float WorldObject::GetGridActivationRange() const
 {
     if (isActiveObject())
@@ -1786,11 +1894,26 @@ struct CombatLogSender
 
     void operator()(Player const* player) const
     {
+        // each variant is copied once on its first recipient, every observer then queues a reference to the same body
         if (player->IsAdvancedCombatLoggingEnabled())
-            player->SendDirectMessage(i_message->GetFullLogPacket());
+        {
+            if (!_fullLogPacket)
+                _fullLogPacket = std::make_shared<WorldPacket const>(*i_message->GetFullLogPacket());
+
+            player->SendDirectMessage(_fullLogPacket);
+        }
         else
-            player->SendDirectMessage(i_message->GetBasicLogPacket());
+        {
+            if (!_basicLogPacket)
+                _basicLogPacket = std::make_shared<WorldPacket const>(*i_message->GetBasicLogPacket());
+
+            player->SendDirectMessage(_basicLogPacket);
+        }
     }
+
+private:
+    mutable std::shared_ptr<WorldPacket const> _fullLogPacket;
+    mutable std::shared_ptr<WorldPacket const> _basicLogPacket;
 };
 
 void WorldObject::SendCombatLogMessage(WorldPackets::CombatLog::CombatLogServerPacket* combatLog) const
@@ -1829,6 +1952,7 @@ void WorldObject::ResetMap()
     if (IsStoredInWorldObjectGridContainer())
         m_currMap->RemoveWorldObject(this);
     m_currMap = nullptr;
+    _lastTerrainStatus.reset();
     //maybe not for corpse
     //m_mapId = 0;
     //m_InstanceId = 0;
@@ -3414,14 +3538,25 @@ void WorldObject::GetNearPoint(WorldObject const* searcher, float& x, float& y,
     float first_y = y;
     float first_z = z;
 
-    // loop in a circle to look for a point in LoS using small steps
-    for (float angle = float(M_PI) / 8; angle < float(M_PI) * 2; angle += float(M_PI) / 8)
+    // loop in a circle to look for a point in LoS using small steps, heights of all candidates are resolved in one batch
+    std::array<G3D::Vector3, 15> candidates;
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        GetNearPoint2D(searcher, x, y, distance2d, absAngle + float(M_PI) / 8 * (i + 1));
+        candidates[i] = G3D::Vector3(x, y, GetPositionZ());
+    }
+
+    (searcher ? searcher : this)->UpdateAllowedPositionZ(candidates);
+
+    for (G3D::Vector3 const& candidate : candidates)
     {
-        GetNearPoint2D(searcher, x, y, distance2d, absAngle + angle);
-        z = GetPositionZ();
-        (searcher ? searcher : this)->UpdateAllowedPositionZ(x, y, z);
-        if (IsWithinLOS(x, y, z))
+        if (IsWithinLOS(candidate.x, candidate.y, candidate.z))
+        {
+            x = candidate.x;
+            y = candidate.y;
+            z = candidate.z;
             return;
+        }
     }
 
     // still not in LoS, give up and return first position found
@@ -3689,8 +3824,9 @@ struct WorldObjectChangeAccumulator
 {
     UpdateDataMapType& i_updateDatas;
     WorldObject& i_object;
+    ValuesUpdateCache* i_valuesCache;
     GuidSet plr_list;
-    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d) : i_updateDatas(d), i_object(obj) { }
+    WorldObjectChangeAccumulator(WorldObject &obj, UpdateDataMapType &d, ValuesUpdateCache* valuesCache) : i_updateDatas(d), i_object(obj), i_valuesCache(valuesCache) { }
     void Visit(PlayerMapType &m)
     {
         Player* source = nullptr;
@@ -3747,7 +3883,7 @@ struct WorldObjectChangeAccumulator
         // Only send update once to a player
         if (plr_list.find(player->GetGUID()) == plr_list.end() && player->HaveAtClient(&i_object))
         {
-            i_object.BuildFieldsUpdate(player, i_updateDatas);
+            i_object.BuildFieldsUpdate(player, i_updateDatas, i_valuesCache);
             plr_list.insert(player->GetGUID());
         }
     }
@@ -3757,7 +3893,9 @@ struct WorldObjectChangeAccumulator
 
 void WorldObject::BuildUpdate(UpdateDataMapType& data_map)
 {
-    WorldObjectChangeAccumulator notifier(*this, data_map);
+    // most changes look the same to every receiver with the same field visibility flags, serialize them once per flags
+    ValuesUpdateCache valuesCache;
+    WorldObjectChangeAccumulator notifier(*this, data_map, HasViewerDependentChangedValues() ? nullptr : &valuesCache);
     //we must build packets for all visible players
     Cell::VisitWorldObjects(this, notifier, GetVisibilityRange());
 
@@ -3824,18 +3962,22 @@ std::string WorldObject::GetDebugInfo() const
 template TC_GAME_API void WorldObject::GetGameObjectListWithEntryInGrid(std::list<GameObject*>&, uint32, float) const;
 template TC_GAME_API void WorldObject::GetGameObjectListWithEntryInGrid(std::deque<GameObject*>&, uint32, float) const;
 template TC_GAME_API void WorldObject::GetGameObjectListWithEntryInGrid(std::vector<GameObject*>&, uint32, float) const;
+template TC_GAME_API void WorldObject::GetGameObjectListWithEntryInGrid(Trinity::GridSearchResult<GameObject*>&, uint32, float) const;
 
 template TC_GAME_API void WorldObject::GetGameObjectListWithOptionsInGrid(std::list<GameObject*>&, float, FindGameObjectOptions const&) const;
 template TC_GAME_API void WorldObject::GetGameObjectListWithOptionsInGrid(std::deque<GameObject*>&, float, FindGameObjectOptions const&) const;
 template TC_GAME_API void WorldObject::GetGameObjectListWithOptionsInGrid(std::vector<GameObject*>&, float, FindGameObjectOptions const&) const;
+template TC_GAME_API void WorldObject::GetGameObjectListWithOptionsInGrid(Trinity::GridSearchResult<GameObject*>&, float, FindGameObjectOptions const&) const;
 
 template TC_GAME_API void WorldObject::GetCreatureListWithEntryInGrid(std::list<Creature*>&, uint32, float) const;
 template TC_GAME_API void WorldObject::GetCreatureListWithEntryInGrid(std::deque<Creature*>&, uint32, float) const;
 template TC_GAME_API void WorldObject::GetCreatureListWithEntryInGrid(std::vector<Creature*>&, uint32, float) const;
+template TC_GAME_API void WorldObject::GetCreatureListWithEntryInGrid(Trinity::GridSearchResult<Creature*>&, uint32, float) const;
 
 template TC_GAME_API void WorldObject::GetCreatureListWithOptionsInGrid(std::list<Creature*>&, float, FindCreatureOptions const&) const;
 template TC_GAME_API void WorldObject::GetCreatureListWithOptionsInGrid(std::deque<Creature*>&,float, FindCreatureOptions const&) const;
 template TC_GAME_API void WorldObject::GetCreatureListWithOptionsInGrid(std::vector<Creature*>&, float, FindCreatureOptions const&) const;
+template TC_GAME_API void WorldObject::GetCreatureListWithOptionsInGrid(Trinity::GridSearchResult<Creature*>&, float, FindCreatureOptions const&) const;
 
 template TC_GAME_API void WorldObject::GetPlayerListInGrid(std::list<Player*>&, float, bool) const;
 template TC_GAME_API void WorldObject::GetPlayerListInGrid(std::deque<Player*>&, float, bool) const;
@@ -32,9 +32,11 @@
 #include "Position.h"
 #include "SharedDefines.h"
 #include "SpellDefines.h"
+#include "TickArena.h"
 #include "UniqueTrackablePtr.h"
 #include "UpdateFields.h"
 #include <list>
+#include <span>
 #include <unordered_map>
 
 class AreaTrigger;
@@ -60,6 +62,7 @@ class TempSummon;
 class TransportBase;
 class Unit;
 class UpdateData;
+class ValuesUpdateCache;
 class WorldObject;
 class WorldPacket;
 class ZoneScript;
@@ -68,6 +71,11 @@ struct Loot;
 struct QuaternionData;
 struct SpellPowerCost;
 
+namespace G3D
+{
+    class Vector3;
+}
+
 namespace WorldPackets
 {
     namespace CombatLog
@@ -76,7 +84,7 @@ namespace WorldPackets
     }
 }
 
-typedef std::unordered_map<Player*, UpdateData> UpdateDataMapType;
+typedef Trinity::TickUnorderedMap<Player*, UpdateData> UpdateDataMapType;
 
 struct CreateObjectBits
 {
@@ -178,6 +186,7 @@ class TC_GAME_API Object
         void SendUpdateToPlayer(Player* player);
 
         void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player const* target) const;
+        void BuildValuesUpdateBlockForPlayer(UpdateData* data, Player const* target, ValuesUpdateCache& cache) const;
         void BuildValuesUpdateBlockForPlayerWithFlag(UpdateData* data, UF::UpdateFieldFlag flags, Player const* target) const;
         void BuildDestroyUpdateBlock(UpdateData* data) const;
         void BuildOutOfRangeUpdateBlock(UpdateData* data) const;
@@ -196,7 +205,11 @@ class TC_GAME_API Object
         bool IsDestroyedObject() const { return m_isDestroyedObject; }
         void SetDestroyedObject(bool destroyed) { m_isDestroyedObject = destroyed; }
         virtual void BuildUpdate(UpdateDataMapType&) { }
-        void BuildFieldsUpdate(Player*, UpdateDataMapType &) const;
+        void BuildFieldsUpdate(Player*, UpdateDataMapType &, ValuesUpdateCache* cache = nullptr) const;
+
+        // true if a changed field is serialized differently for receivers with the same field visibility flags (see ViewerDependentValues.h)
+        // values updates can only be shared between receivers while this is false
+        virtual bool HasViewerDependentChangedValues() const;
 
         inline bool IsWorldObject() const { return isType(TYPEMASK_WORLDOBJECT); }
         static WorldObject* ToWorldObject(Object* o) { return o ? o->ToWorldObject() : nullptr; }
@@ -515,6 +528,7 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         virtual float GetCombatReach() const { return 0.0f; } // overridden (only) in Unit
         void UpdateGroundPositionZ(float x, float y, float &z) const;
         void UpdateAllowedPositionZ(float x, float y, float &z, float* groundZ = nullptr) const;
+        void UpdateAllowedPositionZ(std::span<G3D::Vector3> points) const;
 
         void GetRandomPoint(Position const& srcPos, float distance, float& rand_x, float& rand_y, float& rand_z) const;
         Position GetRandomPoint(Position const& srcPos, float distance) const;
@@ -732,7 +746,7 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         void RemoveFromObjectUpdate() override;
 
         //relocation and visibility system functions
-        void AddToNotify(uint16 f) { m_notifyflags |= f;}
+        void AddToNotify(uint16 f);
         bool isNeedNotify(uint16 f) const { return (m_notifyflags & f) != 0; }
         uint16 GetNotifyFlags() const { return m_notifyflags; }
         void ResetAllNotifies() { m_notifyflags = 0; }
@@ -813,6 +827,16 @@ class TC_GAME_API WorldObject : public Object, public WorldLocation
         ZLiquidStatus m_liquidStatus;
         Optional<WmoLocation> m_currentWmo;
 
+        // terrain status of the last lookup, reused by UpdatePositionData while the object stays close to where it was taken
+        struct TerrainStatusSnapshot
+        {
+            Position Pos;
+            uint32 TerrainMapId;
+            float CollisionHeight;
+            PositionFullTerrainStatus Status;
+        };
+        Optional<TerrainStatusSnapshot> _lastTerrainStatus;
+
         //these functions are used mostly for Relocate() and Corpse/Player specific stuff...
         //use them ONLY in LoadFromDB()/Create() funcs and nowhere else!
         //mapId/instanceId should be set in SetMap() function!
@@ -21,6 +21,7 @@
 #include "Hash.h"
 #include "Log.h"
 #include "Realm.h"
+#include "StringFormatCompiled.h"
 #include "Util.h"
 #include "World.h"
 #include <charconv>
@@ -37,7 +38,7 @@ namespace
 
         static std::string Format(ObjectGuid const& guid)
         {
-            return Trinity::StringFormat("{}", guid);
+            return Trinity::StringFormat(TC_COMPILED_FORMAT("{}"), guid);
         }
 
         ObjectGuid Parse(std::string_view guidString) const
@@ -778,7 +779,7 @@ std::string ObjectGuid::ToString() const
 
 std::string ObjectGuid::ToHexString() const
 {
-    return Trinity::StringFormat("0x{:016X}{:016X}", _data[1], _data[0]);
+    return Trinity::StringFormat(TC_COMPILED_FORMAT("0x{:016X}{:016X}"), _data[1], _data[0]);
 }
 
 ObjectGuid ObjectGuid::FromString(std::string_view guidString)
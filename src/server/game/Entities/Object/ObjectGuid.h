@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "EnumFlag.h"
+#include "FlatHashSet.h"
 #include "advstd.h"
 #include <array>
 #include <functional>
@@ -394,6 +395,7 @@ using GuidSet = std::set<ObjectGuid>;
 using GuidList = std::list<ObjectGuid>;
 using GuidVector = std::vector<ObjectGuid>;
 using GuidUnorderedSet = std::unordered_set<ObjectGuid>;
+using GuidFlatHashSet = Trinity::Containers::FlatHashSet<ObjectGuid>;
 
 class TC_GAME_API ObjectGuidGenerator
 {
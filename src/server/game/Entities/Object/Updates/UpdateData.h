@@ -21,10 +21,16 @@
 #include "Define.h"
 #include "ByteBuffer.h"
 #include "ObjectGuid.h"
+#include <boost/container/small_vector.hpp>
 #include <set>
 
 class WorldPacket;
 
+namespace UF
+{
+    enum class UpdateFieldFlag : uint8;
+}
+
 enum OBJECT_UPDATE_TYPE
 {
     UPDATETYPE_VALUES               = 0,
@@ -64,4 +70,27 @@ class UpdateData
         UpdateData(UpdateData const& right) = delete;
         UpdateData& operator=(UpdateData const& right) = delete;
 };
+
+// Values update blocks of a single object, serialized once per distinct field visibility flags of its receivers
+// Only valid while the changes of that object are being sent, the changes mask must not change in between
+class ValuesUpdateCache
+{
+    public:
+        ByteBuffer const* Find(UF::UpdateFieldFlag flags) const
+        {
+            for (auto const& [blockFlags, block] : m_blocks)
+                if (blockFlags == flags)
+                    return &block;
+
+            return nullptr;
+        }
+
+        ByteBuffer& Add(UF::UpdateFieldFlag flags)
+        {
+            return m_blocks.emplace_back(flags, ByteBuffer()).second;
+        }
+
+    private:
+        boost::container::small_vector<std::pair<UF::UpdateFieldFlag, ByteBuffer>, 4> m_blocks;
+};
 #endif
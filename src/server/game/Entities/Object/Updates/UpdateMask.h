@@ -20,6 +20,8 @@
 
 #include "Define.h"
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cstring> // std::memset
 
 namespace UpdateMaskHelpers
@@ -110,30 +112,42 @@ public:
         }
     }
 
+    // changes masks are mostly empty, both operators only visit blocks that are non zero according to _blocksMask
     constexpr UpdateMask& operator&=(UpdateMask const& right)
     {
-        for (uint32 i = 0; i < BlocksMaskCount; ++i)
-            _blocksMask[i] &= right._blocksMask[i];
-
-        for (uint32 i = 0; i < BlockCount; ++i)
-            if (!(_blocks[i] &= right._blocks[i]))
-                _blocksMask[UpdateMaskHelpers::GetBlockIndex(i)] &= ~UpdateMaskHelpers::GetBlockFlag(i);
+        ForEachSetBlock(_blocksMask, [&](uint32 block)
+        {
+            if (!(_blocks[block] &= right._blocks[block]))
+                _blocksMask[UpdateMaskHelpers::GetBlockIndex(block)] &= ~UpdateMaskHelpers::GetBlockFlag(block);
+        });
 
         return *this;
     }
 
     constexpr UpdateMask& operator|=(UpdateMask const& right)
     {
+        ForEachSetBlock(right._blocksMask, [&](uint32 block)
+        {
+            _blocks[block] |= right._blocks[block];
+        });
+
         for (std::size_t i = 0; i < BlocksMaskCount; ++i)
             _blocksMask[i] |= right._blocksMask[i];
 
-        for (std::size_t i = 0; i < BlockCount; ++i)
-            _blocks[i] |= right._blocks[i];
-
         return *this;
     }
 
 private:
+    template<typename Callback>
+    static constexpr void ForEachSetBlock(std::array<uint32, BlocksMaskCount> blocksMask, Callback&& callback)
+    {
+        for (uint32 i = 0; i < BlocksMaskCount; ++i)
+        {
+            for (uint32 mask = blocksMask[i]; mask; mask &= mask - 1)
+                callback(i * 32 + std::countr_zero(mask));
+        }
+    }
+
     std::array<uint32, BlocksMaskCount> _blocksMask;
     std::array<uint32, BlockCount> _blocks;
 };
@@ -43,6 +43,15 @@ CinematicMgr::~CinematicMgr()
         EndCinematic();
 }
 
+void CinematicMgr::BeginCinematic(CinematicSequencesEntry const* cinematic)
+{
+    m_activeCinematic = cinematic;
+    m_activeCinematicCameraIndex = -1;
+
+    // client requests the first camera once it started playing, load the waypoints until then
+    PrefetchFlyByCameras(cinematic);
+}
+
 void CinematicMgr::NextCinematicCamera()
 {
     // Sanity check for active camera set
@@ -53,11 +62,11 @@ void CinematicMgr::NextCinematicCamera()
     if (!cinematicCameraId)
         return;
 
-    if (std::vector<FlyByCamera> const* flyByCameras = GetFlyByCameras(cinematicCameraId))
+    if (std::shared_ptr<std::vector<FlyByCamera> const> flyByCameras = GetFlyByCameras(cinematicCameraId))
     {
         // Initialize diff, and set camera
         m_cinematicDiff = 0;
-        m_cinematicCamera = flyByCameras;
+        m_cinematicCamera = std::move(flyByCameras);
 
         if (!m_cinematicCamera->empty())
         {
@@ -20,6 +20,8 @@
 
 #include "Define.h"
 #include "Object.h"
+#include <memory>
+#include <vector>
 
 #define CINEMATIC_LOOKAHEAD (2 * IN_MILLISECONDS)
 #define CINEMATIC_UPDATEDIFF 500
@@ -36,11 +38,7 @@ public:
     ~CinematicMgr();
     // Cinematic camera data and remote sight functions
     bool IsOnCinematic() const { return (m_cinematicCamera != nullptr); }
-    void BeginCinematic(CinematicSequencesEntry const* cinematic)
-    {
-        m_activeCinematic = cinematic;
-        m_activeCinematicCameraIndex = -1;
-    }
+    void BeginCinematic(CinematicSequencesEntry const* cinematic);
     void NextCinematicCamera();
     void EndCinematic();
     void UpdateCinematicLocation(uint32 diff);
@@ -55,7 +53,7 @@ protected:
     CinematicSequencesEntry const* m_activeCinematic;
      int32      m_activeCinematicCameraIndex;
     uint32      m_cinematicLength;
-    std::vector<FlyByCamera> const* m_cinematicCamera;
+    std::shared_ptr<std::vector<FlyByCamera> const> m_cinematicCamera;
     Position    m_remoteSightPosition;
     TempSummon* m_CinematicObject;
 };
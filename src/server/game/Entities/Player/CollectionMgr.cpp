@@ -125,21 +125,30 @@ void CollectionMgr::LoadAccountToys(PreparedQueryResult result)
 
 void CollectionMgr::SaveAccountToys(LoginDatabaseTransaction trans)
 {
-    LoginDatabasePreparedStatement* stmt = nullptr;
-    for (auto const& toy : _toys)
+    for (uint32 itemId : _changedToys)
     {
-        stmt = LoginDatabase.GetPreparedStatement(LOGIN_REP_ACCOUNT_TOYS);
+        auto toy = _toys.find(itemId);
+        if (toy == _toys.end())
+            continue;
+
+        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_REP_ACCOUNT_TOYS);
         stmt->setUInt32(0, _owner->GetBattlenetAccountId());
-        stmt->setUInt32(1, toy.first);
-        stmt->setBool(2, toy.second.HasFlag(ToyFlags::Favorite));
-        stmt->setBool(3, toy.second.HasFlag(ToyFlags::HasFanfare));
+        stmt->setUInt32(1, toy->first);
+        stmt->setBool(2, toy->second.HasFlag(ToyFlags::Favorite));
+        stmt->setBool(3, toy->second.HasFlag(ToyFlags::HasFanfare));
         trans->Append(stmt);
     }
+
+    _changedToys.clear();
 }
 
 bool CollectionMgr::UpdateAccountToys(uint32 itemId, bool isFavourite, bool hasFanfare)
 {
-    return _toys.insert(ToyBoxContainer::value_type(itemId, GetToyFlags(isFavourite, hasFanfare))).second;
+    if (!_toys.insert(ToyBoxContainer::value_type(itemId, GetToyFlags(isFavourite, hasFanfare))).second)
+        return false;
+
+    _changedToys.insert(itemId);
+    return true;
 }
 
 void CollectionMgr::ToySetFavorite(uint32 itemId, bool favorite)
@@ -152,6 +161,8 @@ void CollectionMgr::ToySetFavorite(uint32 itemId, bool favorite)
         itr->second |= ToyFlags::Favorite;
     else
         itr->second &= ~ToyFlags::Favorite;
+
+    _changedToys.insert(itemId);
 }
 
 void CollectionMgr::ToyClearFanfare(uint32 itemId)
@@ -161,6 +172,7 @@ void CollectionMgr::ToyClearFanfare(uint32 itemId)
         return;
 
     itr->second &= ~ ToyFlags::HasFanfare;
+    _changedToys.insert(itemId);
 }
 
 void CollectionMgr::OnItemAdded(Item* item)
@@ -203,20 +215,29 @@ void CollectionMgr::LoadAccountHeirlooms(PreparedQueryResult result)
 
 void CollectionMgr::SaveAccountHeirlooms(LoginDatabaseTransaction trans)
 {
-    LoginDatabasePreparedStatement* stmt = nullptr;
-    for (auto const& heirloom : _heirlooms)
+    for (uint32 itemId : _changedHeirlooms)
     {
-        stmt = LoginDatabase.GetPreparedStatement(LOGIN_REP_ACCOUNT_HEIRLOOMS);
+        auto heirloom = _heirlooms.find(itemId);
+        if (heirloom == _heirlooms.end())
+            continue;
+
+        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_REP_ACCOUNT_HEIRLOOMS);
         stmt->setUInt32(0, _owner->GetBattlenetAccountId());
-        stmt->setUInt32(1, heirloom.first);
-        stmt->setUInt32(2, heirloom.second.flags);
+        stmt->setUInt32(1, heirloom->first);
+        stmt->setUInt32(2, heirloom->second.flags);
         trans->Append(stmt);
     }
+
+    _changedHeirlooms.clear();
 }
 
 bool CollectionMgr::UpdateAccountHeirlooms(uint32 itemId, uint32 flags)
 {
-    return _heirlooms.insert(HeirloomContainer::value_type(itemId, HeirloomData(flags, 0))).second;
+    if (!_heirlooms.insert(HeirloomContainer::value_type(itemId, HeirloomData(flags, 0))).second)
+        return false;
+
+    _changedHeirlooms.insert(itemId);
+    return true;
 }
 
 uint32 CollectionMgr::GetHeirloomBonus(uint32 itemId) const
@@ -280,6 +301,7 @@ void CollectionMgr::UpgradeHeirloom(uint32 itemId, int32 castItem)
     player->SetHeirloomFlags(offset, flags);
     itr->second.flags = flags;
     itr->second.bonusId = bonusId;
+    _changedHeirlooms.insert(itemId);
 }
 
 void CollectionMgr::CheckHeirloomUpgrades(Item* item)
@@ -322,6 +344,7 @@ void CollectionMgr::CheckHeirloomUpgrades(Item* item)
 
             _heirlooms.erase(itr);
             _heirlooms[newItemId] = 0;
+            _changedHeirlooms.insert(newItemId);
 
             return;
         }
@@ -368,14 +391,20 @@ void CollectionMgr::LoadAccountMounts(PreparedQueryResult result)
 
 void CollectionMgr::SaveAccountMounts(LoginDatabaseTransaction trans)
 {
-    for (auto const& mount : _mounts)
+    for (uint32 spellId : _changedMounts)
     {
+        auto mount = _mounts.find(spellId);
+        if (mount == _mounts.end())
+            continue;
+
         LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_REP_ACCOUNT_MOUNTS);
         stmt->setUInt32(0, _owner->GetBattlenetAccountId());
-        stmt->setUInt32(1, mount.first);
-        stmt->setUInt8(2, mount.second);
+        stmt->setUInt32(1, mount->first);
+        stmt->setUInt8(2, mount->second);
         trans->Append(stmt);
     }
+
+    _changedMounts.clear();
 }
 
 bool CollectionMgr::AddMount(uint32 spellId, MountStatusFlags flags, bool factionMount /*= false*/, bool learned /*= false*/)
@@ -392,7 +421,8 @@ bool CollectionMgr::AddMount(uint32 spellId, MountStatusFlags flags, bool factio
     if (itr != FactionSpecificMounts.end() && !factionMount)
         AddMount(itr->second, flags, true, learned);
 
-    _mounts.insert(MountContainer::value_type(spellId, flags));
+    if (_mounts.insert(MountContainer::value_type(spellId, flags)).second)
+        _changedMounts.insert(spellId);
 
     // Mount condition only applies to using it, should still learn it.
     if (!ConditionMgr::IsPlayerMeetingCondition(player, mount->PlayerConditionID))
@@ -420,6 +450,7 @@ void CollectionMgr::MountSetFavorite(uint32 spellId, bool favorite)
     else
         itr->second = MountStatusFlags(itr->second & ~MOUNT_IS_FAVORITE);
 
+    _changedMounts.insert(spellId);
     SendSingleMountUpdate(*itr);
 }
 
@@ -463,6 +494,19 @@ private:
     std::function<void(uint32)> _action;
 };
 
+namespace
+{
+    uint32 GetDynamicBitsetBlock(boost::dynamic_bitset<uint32> const& bitset, uint32 blockIndex)
+    {
+        uint32 blockValue = 0;
+        for (std::size_t bit = blockIndex * 32, end = std::min<std::size_t>(bit + 32, bitset.size()); bit < end; ++bit)
+            if (bitset.test(bit))
+                blockValue |= 1u << (bit % 32);
+
+        return blockValue;
+    }
+}
+
 void CollectionMgr::LoadItemAppearances()
 {
     Player* owner = _owner->GetPlayer();
@@ -530,20 +574,17 @@ void CollectionMgr::LoadAccountItemAppearances(PreparedQueryResult knownAppearan
 
 void CollectionMgr::SaveAccountItemAppearances(LoginDatabaseTransaction trans)
 {
-    uint16 blockIndex = 0;
-    boost::to_block_range(*_appearances, DynamicBitsetBlockOutputIterator([this, &blockIndex, trans](uint32 blockValue)
+    // this table is only appended/bits are set (never cleared) so only blocks that gained bits are saved
+    for (uint32 blockIndex : _changedAppearanceBlocks)
     {
-        if (blockValue) // this table is only appended/bits are set (never cleared) so don't save empty blocks
-        {
-            LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_BNET_ITEM_APPEARANCES);
-            stmt->setUInt32(0, _owner->GetBattlenetAccountId());
-            stmt->setUInt16(1, blockIndex);
-            stmt->setUInt32(2, blockValue);
-            trans->Append(stmt);
-        }
+        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_BNET_ITEM_APPEARANCES);
+        stmt->setUInt32(0, _owner->GetBattlenetAccountId());
+        stmt->setUInt16(1, blockIndex);
+        stmt->setUInt32(2, GetDynamicBitsetBlock(*_appearances, blockIndex));
+        trans->Append(stmt);
+    }
 
-        ++blockIndex;
-    }));
+    _changedAppearanceBlocks.clear();
 
     LoginDatabasePreparedStatement* stmt;
     for (auto itr = _favoriteAppearances.begin(); itr != _favoriteAppearances.end();)
@@ -756,6 +797,7 @@ void CollectionMgr::AddItemAppearance(ItemModifiedAppearanceEntry const* itemMod
     uint32 blockIndex = itemModifiedAppearance->ID / 32;
     uint32 bitIndex = itemModifiedAppearance->ID % 32;
     owner->AddTransmogFlag(blockIndex, 1 << bitIndex);
+    _changedAppearanceBlocks.insert(blockIndex);
     auto temporaryAppearance = _temporaryAppearances.find(itemModifiedAppearance->ID);
     if (temporaryAppearance != _temporaryAppearances.end())
     {
@@ -931,20 +973,17 @@ void CollectionMgr::LoadAccountTransmogIllusions(PreparedQueryResult knownTransm
 
 void CollectionMgr::SaveAccountTransmogIllusions(LoginDatabaseTransaction trans)
 {
-    uint16 blockIndex = 0;
-
-    boost::to_block_range(*_transmogIllusions, DynamicBitsetBlockOutputIterator([this, &blockIndex, trans](uint32 blockValue)
+    // this table is only appended/bits are set (never cleared) so only blocks that gained bits are saved
+    for (uint32 blockIndex : _changedTransmogIllusionBlocks)
     {
-        if (blockValue) // this table is only appended/bits are set (never cleared) so don't save empty blocks
-        {
-            LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_BNET_TRANSMOG_ILLUSIONS);
-            stmt->setUInt32(0, _owner->GetBattlenetAccountId());
-            stmt->setUInt16(1, blockIndex);
-            stmt->setUInt32(2, blockValue);
-            trans->Append(stmt);
-        }
-        ++blockIndex;
-    }));
+        LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_INS_BNET_TRANSMOG_ILLUSIONS);
+        stmt->setUInt32(0, _owner->GetBattlenetAccountId());
+        stmt->setUInt16(1, blockIndex);
+        stmt->setUInt32(2, GetDynamicBitsetBlock(*_transmogIllusions, blockIndex));
+        trans->Append(stmt);
+    }
+
+    _changedTransmogIllusionBlocks.clear();
 }
 
 void CollectionMgr::AddTransmogIllusion(uint32 transmogIllusionId)
@@ -964,6 +1003,7 @@ void CollectionMgr::AddTransmogIllusion(uint32 transmogIllusionId)
     uint32 bitIndex = transmogIllusionId % 32;
 
     owner->AddIllusionFlag(blockIndex, 1 << bitIndex);
+    _changedTransmogIllusionBlocks.insert(blockIndex);
 }
 
 bool CollectionMgr::HasTransmogIllusion(uint32 transmogIllusionId) const
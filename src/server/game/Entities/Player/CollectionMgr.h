@@ -23,7 +23,6 @@
 #include "EnumFlag.h"
 #include "ObjectGuid.h"
 #include <boost/dynamic_bitset_fwd.hpp>
-#include <map>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -66,8 +65,8 @@ enum class ToyFlags : uint32
 
 DEFINE_ENUM_FLAG(ToyFlags);
 
-typedef std::map<uint32, EnumFlag<ToyFlags>> ToyBoxContainer;
-typedef std::map<uint32, HeirloomData> HeirloomContainer;
+typedef std::unordered_map<uint32, EnumFlag<ToyFlags>> ToyBoxContainer;
+typedef std::unordered_map<uint32, HeirloomData> HeirloomContainer;
 
 enum MountStatusFlags : uint8
 {
@@ -76,7 +75,7 @@ enum MountStatusFlags : uint8
     MOUNT_IS_FAVORITE   = 0x02
 };
 
-typedef std::map<uint32, MountStatusFlags> MountContainer;
+typedef std::unordered_map<uint32, MountStatusFlags> MountContainer;
 typedef std::unordered_map<uint32, uint32> MountDefinitionMap;
 
 class TC_GAME_API CollectionMgr
@@ -122,6 +121,7 @@ public:
     bool AddMount(uint32 spellId, MountStatusFlags flags, bool factionMount = false, bool learned = false);
     void MountSetFavorite(uint32 spellId, bool favorite);
     void SendSingleMountUpdate(std::pair<uint32, MountStatusFlags> mount);
+    bool HasMount(uint32 spellId) const { return _mounts.contains(spellId); }
     MountContainer const& GetAccountMounts() const { return _mounts; }
 
     // Appearances
@@ -170,6 +170,13 @@ private:
     std::unordered_map<uint32, std::unordered_set<ObjectGuid>> _temporaryAppearances;
     std::unordered_map<uint32, FavoriteAppearanceState> _favoriteAppearances;
     std::unique_ptr<boost::dynamic_bitset<uint32>> _transmogIllusions;
+
+    // only entries added or modified since the last save are written back to the database
+    std::unordered_set<uint32> _changedToys;
+    std::unordered_set<uint32> _changedHeirlooms;
+    std::unordered_set<uint32> _changedMounts;
+    std::unordered_set<uint32> _changedAppearanceBlocks;
+    std::unordered_set<uint32> _changedTransmogIllusionBlocks;
 };
 
 #endif // CollectionMgr_h__
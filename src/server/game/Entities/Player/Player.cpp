@@ -36,6 +36,7 @@
 #include "ChannelMgr.h"
 #include "CharacterCache.h"
 #include "CharacterDatabaseCleaner.h"
+#include "CharacterEnumCache.h"
 #include "CharacterTemplateDataStore.h"
 #include "CharacterPackets.h"
 #include "CharmInfo.h"
@@ -86,6 +87,7 @@
 #include "Mail.h"
 #include "MailPackets.h"
 #include "MapManager.h"
+#include "Metric.h"
 #include "MiscPackets.h"
 #include "MotionMaster.h"
 #include "MovementPackets.h"
@@ -174,6 +176,9 @@ Player::Player(WorldSession* session) : Unit(true), m_sceneMgr(this)
 
     m_ExtraFlags = 0;
 
+    m_questGiverStatusCacheGeneration = 0;
+    m_questGiverStatusCacheLevel = 0;
+
     m_spellModTakingSpell = nullptr;
 
     // players always accept
@@ -193,6 +198,7 @@ Player::Player(WorldSession* session) : Unit(true), m_sceneMgr(this)
 
     m_nextSave = sWorld->getIntConfig(CONFIG_INTERVAL_SAVE);
     m_customizationsChanged = false;
+    ResetSaveSnapshots();
 
     memset(m_items, 0, sizeof(Item*)*PLAYER_SLOTS_COUNT);
 
@@ -266,6 +272,9 @@ Player::Player(WorldSession* session) : Unit(true), m_sceneMgr(this)
     m_mailsUpdated = false;
     unReadMails = 0;
     m_nextMailDelivereTime = 0;
+    m_updateSchedule.Schedule(PlayerScheduledUpdate::AfkReport, m_bgData.bgAfkReportedTimer);
+    m_mailedItemsLoaded = false;
+    m_mailedItemsLoading = false;
 
     m_itemUpdateQueueBlocked = false;
 
@@ -287,6 +296,7 @@ Player::Player(WorldSession* session) : Unit(true), m_sceneMgr(this)
     m_auraBaseFlatMod.fill(0.0f);
     m_auraBasePctMod.fill(1.0f);
     m_baseRatingValue = { };
+    m_pendingRatingUpdates = 0;
 
     m_baseSpellPower = 0;
     m_baseManaRegen = 0;
@@ -920,16 +930,6 @@ void Player::Update(uint32 p_time)
     if (!IsInWorld())
         return;
 
-    // undelivered mail
-    if (m_nextMailDelivereTime && m_nextMailDelivereTime <= GameTime::GetGameTime())
-    {
-        SendNewMail();
-        ++unReadMails;
-
-        // It will be recalculate at mailbox open (for unReadMails important non-0 until mailbox open, it also will be recalculated)
-        m_nextMailDelivereTime = 0;
-    }
-
     // Update cinematic location, if 500ms have passed and we're doing a cinematic now.
     _cinematicMgr->m_cinematicDiff += p_time;
     if (_cinematicMgr->m_cinematicCamera && _cinematicMgr->m_activeCinematic && GetMSTimeDiffToNow(_cinematicMgr->m_lastCinematicCheck) > CINEMATIC_UPDATEDIFF)
@@ -949,7 +949,8 @@ void Player::Update(uint32 p_time)
 
     time_t now = GameTime::GetGameTime();
 
-    UpdatePvPFlag(now);
+    if (m_updateSchedule.HasDue(now))
+        RunScheduledUpdates(now);
 
     UpdateContestedPvP(p_time);
 
@@ -957,8 +958,6 @@ void Player::Update(uint32 p_time)
 
     CheckDuelDistance(now);
 
-    UpdateAfkReport(now);
-
     if (GetCombatManager().HasPvPCombat())
         if (Aura* aura = GetAura(SPELL_PVP_RULES_ENABLED))
             if (!aura->IsPermanent())
@@ -970,10 +969,6 @@ void Player::Update(uint32 p_time)
     if (now > m_Last_tick)
         UpdateItemDuration(uint32(now - m_Last_tick));
 
-    // check every second
-    if (now > m_Last_tick + 1)
-        UpdateSoulboundTradeItems();
-
     // If mute expired, remove it from the DB
     if (GetSession()->m_muteTime && GetSession()->m_muteTime < now)
     {
@@ -1122,17 +1117,6 @@ void Player::Update(uint32 p_time)
     UpdateEnchantTime(p_time);
     UpdateHomebindTime(p_time);
 
-    if (!_instanceResetTimes.empty())
-    {
-        for (InstanceTimeMap::iterator itr = _instanceResetTimes.begin(); itr != _instanceResetTimes.end();)
-        {
-            if (itr->second < now)
-                _instanceResetTimes.erase(itr++);
-            else
-                ++itr;
-        }
-    }
-
     Pet* pet = GetPet();
     if (pet && !pet->IsWithinDistInMap(this, GetMap()->GetVisibilityRange()) && !pet->isPossessed())
     //if (pet && !pet->IsWithinDistInMap(this, GetMap()->GetVisibilityDistance()) && (GetCharmGUID() && (pet->GetGUID() != GetCharmGUID())))
@@ -1156,6 +1140,61 @@ void Player::Update(uint32 p_time)
         TeleportTo(m_teleport_dest, m_teleport_options);
 }
 
+// Each part checks its own condition again, a deadline only tells when it can have work to do
+void Player::RunScheduledUpdates(time_t now)
+{
+    // undelivered mail
+    if (m_updateSchedule.TakeIfDue(PlayerScheduledUpdate::MailDelivery, now) && m_nextMailDelivereTime)
+    {
+        if (m_nextMailDelivereTime <= now)
+        {
+            SendNewMail();
+            ++unReadMails;
+
+            // It will be recalculate at mailbox open (for unReadMails important non-0 until mailbox open, it also will be recalculated)
+            m_nextMailDelivereTime = 0;
+        }
+        else
+            m_updateSchedule.Schedule(PlayerScheduledUpdate::MailDelivery, m_nextMailDelivereTime);
+    }
+
+    if (m_updateSchedule.TakeIfDue(PlayerScheduledUpdate::PvPFlag, now))
+    {
+        UpdatePvPFlag(now);
+
+        // the flag is kept while hostile, check again every second until it is gone
+        if (pvpInfo.EndTimer)
+            m_updateSchedule.Schedule(PlayerScheduledUpdate::PvPFlag, std::max(now + 1, pvpInfo.EndTimer + 300));
+    }
+
+    if (m_updateSchedule.TakeIfDue(PlayerScheduledUpdate::AfkReport, now))
+    {
+        UpdateAfkReport(now);
+        m_updateSchedule.Schedule(PlayerScheduledUpdate::AfkReport, m_bgData.bgAfkReportedTimer);
+    }
+
+    if (m_updateSchedule.TakeIfDue(PlayerScheduledUpdate::SoulboundTradeItems, now))
+    {
+        UpdateSoulboundTradeItems();
+        if (!m_itemSoulboundTradeable.empty())
+            m_updateSchedule.Schedule(PlayerScheduledUpdate::SoulboundTradeItems, now + 1);
+    }
+
+    if (m_updateSchedule.TakeIfDue(PlayerScheduledUpdate::InstanceResetTimes, now))
+    {
+        for (InstanceTimeMap::iterator itr = _instanceResetTimes.begin(); itr != _instanceResetTimes.end();)
+        {
+            if (itr->second < now)
+                _instanceResetTimes.erase(itr++);
+            else
+            {
+                m_updateSchedule.Schedule(PlayerScheduledUpdate::InstanceResetTimes, itr->second + 1);
+                ++itr;
+            }
+        }
+    }
+}
+
 void Player::Heartbeat()
 {
     Unit::Heartbeat();
@@ -2673,6 +2712,9 @@ void Player::UpdateNextMailTimeAndUnreads()
         else if (((*itr)->checked & MAIL_CHECK_MASK_READ) == 0)
             ++unReadMails;
     }
+
+    if (m_nextMailDelivereTime)
+        m_updateSchedule.Schedule(PlayerScheduledUpdate::MailDelivery, m_nextMailDelivereTime);
 }
 
 void Player::AddNewMailDeliverTime(time_t deliver_time)
@@ -2686,6 +2728,8 @@ void Player::AddNewMailDeliverTime(time_t deliver_time)
     {
         if (!m_nextMailDelivereTime || m_nextMailDelivereTime > deliver_time)
             m_nextMailDelivereTime = deliver_time;
+
+        m_updateSchedule.Schedule(PlayerScheduledUpdate::MailDelivery, m_nextMailDelivereTime);
     }
 }
 
@@ -4538,6 +4582,7 @@ void Player::OfflineResurrect(ObjectGuid const& guid, CharacterDatabaseTransacti
     stmt->setUInt16(0, uint16(AT_LOGIN_RESURRECT));
     stmt->setUInt64(1, guid.GetCounter());
     CharacterDatabase.ExecuteOrAppend(trans, stmt);
+    sCharacterEnumCache->InvalidateCharacter(guid);
 }
 
 Corpse* Player::CreateCorpse()
@@ -5365,7 +5410,10 @@ float Player::GetExpertiseDodgeOrParryReduction(WeaponAttackType attType) const
 void Player::ApplyRatingMod(CombatRating combatRating, int32 value, bool apply)
 {
     m_baseRatingValue[combatRating] += (apply ? value : -value);
-    UpdateRating(combatRating);
+    if (IsStatUpdateBatched())
+        m_pendingRatingUpdates |= 1u << combatRating;
+    else
+        UpdateRating(combatRating);
 }
 
 void Player::UpdateRating(CombatRating cr)
@@ -6329,6 +6377,11 @@ void Player::SendDirectMessage(WorldPacket const* data) const
     m_session->SendPacket(data);
 }
 
+void Player::SendDirectMessage(std::shared_ptr<WorldPacket const> const& data) const
+{
+    m_session->SendPacket(data);
+}
+
 void Player::SendCinematicStart(uint32 CinematicSequenceId) const
 {
     WorldPackets::Misc::TriggerCinematic packet;
@@ -7911,6 +7964,9 @@ void Player::_ApplyItemBonuses(Item* item, uint8 slot, bool apply)
     if (GtCombatRatingsMultByILvl const* ratingMult = sCombatRatingsMultByILvlGameTable.GetRow(itemLevel))
         combatRatingMultiplier = GetIlvlStatMultiplier(ratingMult, proto->GetInventoryType());
 
+    // items carry several stats feeding the same derived values, recalculate each of them once
+    BeginStatUpdateBatch();
+
     for (uint8 i = 0; i < MAX_ITEM_PROTO_STATS; ++i)
     {
         int32 statType = item->GetItemStatType(i);
@@ -8152,6 +8208,8 @@ void Player::_ApplyItemBonuses(Item* item, uint8 slot, bool apply)
     WeaponAttackType attType = Player::GetAttackBySlot(slot, proto->GetInventoryType());
     if (attType != MAX_ATTACK)
         _ApplyWeaponDamage(slot, item, apply);
+
+    EndStatUpdateBatch();
 }
 
 void Player::_ApplyWeaponDamage(uint8 slot, Item* item, bool apply)
@@ -9187,18 +9245,9 @@ void Player::SendUpdateWorldState(uint32 variable, uint32 value, bool hidden /*=
 //        Some should keep the same value between different zoneIds and areaIds on the same map
 void Player::SendInitWorldStates(uint32 zoneId, uint32 areaId)
 {
-    uint32 mapId = GetMapId();
-
-    TC_LOG_DEBUG("network", "Player::SendInitWorldStates: Sending SMSG_INIT_WORLD_STATES for Map: {}, Zone: {}", mapId, zoneId);
-
-    WorldPackets::WorldState::InitWorldStates packet;
-    packet.MapID = mapId;
-    packet.AreaID = zoneId;
-    packet.SubareaID = areaId;
-
-    sWorldStateMgr->FillInitialWorldStates(packet, GetMap(), areaId);
+    TC_LOG_DEBUG("network", "Player::SendInitWorldStates: Sending SMSG_INIT_WORLD_STATES for Map: {}, Zone: {}", GetMapId(), zoneId);
 
-    SendDirectMessage(packet.Write());
+    SendDirectMessage(GetMap()->GetInitWorldStatesPacket(zoneId, areaId));
 }
 
 void Player::SetBindPoint(ObjectGuid guid) const
@@ -9516,16 +9565,29 @@ uint32 Player::GetItemCount(uint32 item, bool inBankAlso, Item* skipItem) const
         location |= ItemSearchLocation::Bank;
 
     uint32 count = 0;
-    ForEachItem(location, [&count, item, skipItem, countGems](Item* pItem)
+    // gems socketed into items of other entries are only found by visiting every item
+    if (countGems)
     {
-        if (pItem != skipItem)
+        ForEachItem(location, [&count, item, skipItem](Item* pItem)
         {
-            if (pItem->GetEntry() == item)
-                count += pItem->GetCount();
+            if (pItem != skipItem)
+            {
+                if (pItem->GetEntry() == item)
+                    count += pItem->GetCount();
 
-            if (countGems)
                 count += pItem->GetGemCountWithID(item);
-        }
+            }
+
+            return ItemSearchCallbackResult::Continue;
+        });
+
+        return count;
+    }
+
+    ForEachItemOfEntry(item, location, [&count, skipItem](Item* pItem)
+    {
+        if (pItem != skipItem)
+            count += pItem->GetCount();
 
         return ItemSearchCallbackResult::Continue;
     });
@@ -9871,9 +9933,9 @@ bool Player::HasItemCount(uint32 item, uint32 count, bool inBankAlso) const
         location |= ItemSearchLocation::Bank;
 
     uint32 currentCount = 0;
-    return !ForEachItem(location, [item, count, &currentCount](Item* pItem)
+    return !ForEachItemOfEntry(item, location, [count, &currentCount](Item* pItem)
     {
-        if (pItem->GetEntry() == item && !pItem->IsInTrade())
+        if (!pItem->IsInTrade())
         {
             currentCount += pItem->GetCount();
             if (currentCount >= count)
@@ -10357,11 +10419,15 @@ InventoryResult Player::CanStoreItem(uint8 bag, uint8 slot, ItemPosCountVec &des
     // not specific slot or have space for partly store only in specific slot
     uint8 inventorySlotEnd = INVENTORY_SLOT_ITEM_START + GetInventorySlotCount();
 
+    // stacks can only be merged into items of the same entry, without any the merge searches would visit every slot for nothing
+    bool canMerge = pProto->GetMaxStackSize() != 1
+        && !ForEachItemOfEntry(entry, ItemSearchLocation::Inventory | ItemSearchLocation::ReagentBank, [](Item* /*item*/) { return ItemSearchCallbackResult::Stop; });
+
     // in specific bag
     if (bag != NULL_BAG)
     {
         // search stack in bag for merge to
-        if (pProto->GetMaxStackSize() != 1)
+        if (canMerge)
         {
             if (bag == INVENTORY_SLOT_BAG_0)               // inventory
             {
@@ -10413,7 +10479,7 @@ InventoryResult Player::CanStoreItem(uint8 bag, uint8 slot, ItemPosCountVec &des
     // not specific bag or have space for partly store only in specific bag
 
     // search stack for merge to
-    if (pProto->GetMaxStackSize() != 1)
+    if (canMerge)
     {
         res = CanStoreItem_InInventorySlots(CHILD_EQUIPMENT_SLOT_START, CHILD_EQUIPMENT_SLOT_END, dest, pProto, count, true, pItem, bag, slot);
         if (Optional<InventoryResult> res2 = tryHandleInvStoreResult(res))
@@ -11536,6 +11602,8 @@ Item* Player::_StoreItem(uint16 pos, Item* pItem, uint32 count, bool clone, bool
         else
             pBag->StoreItem(slot, pItem, update);
 
+        AddItemToEntryIndex(pItem);
+
         if (IsInWorld() && update)
         {
             pItem->AddToWorld();
@@ -11890,6 +11958,7 @@ void Player::VisualizeItem(uint8 slot, Item* pItem)
     pItem->SetOwnerGUID(GetGUID());
     pItem->SetSlot(slot);
     pItem->SetContainer(nullptr);
+    AddItemToEntryIndex(pItem);
 
     if (slot < EQUIPMENT_SLOT_END)
         SetVisibleItemSlot(slot, pItem);
@@ -11974,6 +12043,8 @@ void Player::RemoveItem(uint8 bag, uint8 slot, bool update)
         else if (Bag* pBag = GetBagByPos(bag))
             pBag->RemoveItem(slot, update);
 
+        RemoveItemFromEntryIndex(pItem, pItem->GetEntry());
+
         pItem->SetContainedIn(ObjectGuid::Empty);
         // pItem->SetUInt64Value(ITEM_FIELD_OWNER, 0); not clear owner at remove (it will be set at store). This used in mail and auction code
         pItem->SetSlot(NULL_SLOT);
@@ -12110,6 +12181,8 @@ void Player::DestroyItem(uint8 bag, uint8 slot, bool update)
         else if (Bag* pBag = GetBagByPos(bag))
             pBag->RemoveItem(slot, update);
 
+        RemoveItemFromEntryIndex(pItem, pItem->GetEntry());
+
         // Delete rolled money / loot from db.
         // MUST be done before RemoveFromWorld() or GetTemplate() fails
         if (pProto->HasFlag(ITEM_FLAG_HAS_LOOT))
@@ -12446,15 +12519,10 @@ void Player::DestroyConjuredItems(bool update)
 Item* Player::GetItemByEntry(uint32 entry, ItemSearchLocation where /*= ItemSearchLocation::Default */) const
 {
     Item* result = nullptr;
-    ForEachItem(where, [&result, entry](Item* item)
+    ForEachItemOfEntry(entry, where, [&result](Item* item)
     {
-        if (item->GetEntry() == entry)
-        {
-            result = item;
-            return ItemSearchCallbackResult::Stop;
-        }
-
-        return ItemSearchCallbackResult::Continue;
+        result = item;
+        return ItemSearchCallbackResult::Stop;
     });
     return result;
 }
@@ -12466,16 +12534,75 @@ std::vector<Item*> Player::GetItemListByEntry(uint32 entry, bool inBankAlso) con
         location |= ItemSearchLocation::Bank;
 
     std::vector<Item*> itemList = std::vector<Item*>();
-    ForEachItem(location, [&itemList, entry](Item* item)
+    ForEachItemOfEntry(entry, location, [&itemList](Item* item)
     {
-        if (item->GetEntry() == entry)
-            itemList.push_back(item);
-
+        itemList.push_back(item);
         return ItemSearchCallbackResult::Continue;
     });
     return itemList;
 }
 
+bool Player::IsItemInSearchLocation(Item const* item, EnumFlag<ItemSearchLocation> location) const
+{
+    uint8 bag = item->GetBagSlot();
+    uint8 slot = item->GetSlot();
+    if (bag == INVENTORY_SLOT_BAG_0)
+    {
+        if (slot < PROFESSION_SLOT_END)
+            return location.HasFlag(ItemSearchLocation::Equipment);
+
+        if ((slot >= INVENTORY_SLOT_BAG_START && slot < INVENTORY_SLOT_ITEM_START + GetInventorySlotCount())
+            || (slot >= CHILD_EQUIPMENT_SLOT_START && slot < CHILD_EQUIPMENT_SLOT_END))
+            return location.HasFlag(ItemSearchLocation::Inventory);
+
+        if (slot >= BANK_SLOT_ITEM_START && slot < BANK_SLOT_BAG_END)
+            return location.HasFlag(ItemSearchLocation::Bank);
+
+        if (slot >= REAGENT_SLOT_START && slot < REAGENT_SLOT_END)
+            return location.HasFlag(ItemSearchLocation::ReagentBank);
+
+        return false;
+    }
+
+    if (bag >= INVENTORY_SLOT_BAG_START && bag < INVENTORY_SLOT_BAG_END)
+        return location.HasFlag(ItemSearchLocation::Inventory);
+
+    if (bag >= BANK_SLOT_BAG_START && bag < BANK_SLOT_BAG_END)
+        return location.HasFlag(ItemSearchLocation::Bank);
+
+    if (bag >= REAGENT_BAG_SLOT_START && bag < REAGENT_BAG_SLOT_END)
+        return location.HasFlag(ItemSearchLocation::ReagentBank);
+
+    return false;
+}
+
+void Player::AddItemToEntryIndex(Item* item)
+{
+    std::vector<Item*>& items = m_itemsByEntry[item->GetEntry()];
+    if (std::find(items.begin(), items.end(), item) == items.end())
+        items.push_back(item);
+}
+
+void Player::RemoveItemFromEntryIndex(Item* item, uint32 entry)
+{
+    auto itr = m_itemsByEntry.find(entry);
+    if (itr == m_itemsByEntry.end())
+        return;
+
+    std::erase(itr->second, item);
+    if (itr->second.empty())
+        m_itemsByEntry.erase(entry);
+}
+
+void Player::UpdateItemEntryIndex(Item* item, uint32 previousEntry)
+{
+    if (item->GetEntry() == previousEntry)
+        return;
+
+    RemoveItemFromEntryIndex(item, previousEntry);
+    AddItemToEntryIndex(item);
+}
+
 void Player::DestroyItemCount(Item* pItem, uint32 &count, bool update)
 {
     if (!pItem)
@@ -13263,6 +13390,7 @@ void Player::UpdateSoulboundTradeItems()
 void Player::AddTradeableItem(Item* item)
 {
     m_itemSoulboundTradeable.insert(item->GetGUID());
+    m_updateSchedule.Schedule(PlayerScheduledUpdate::SoulboundTradeItems, GameTime::GetGameTime() + 1);
 }
 
 void Player::RemoveTradeableItem(Item* item)
@@ -14793,6 +14921,7 @@ void Player::AddQuest(Quest const* quest, Object* questGiver)
 
     // check for repeatable quests status reset
     SetQuestSlot(log_slot, quest_id);
+    InvalidateQuestGiverStatusCache();
     questStatusData.Slot = log_slot;
     questStatusData.Status = QUEST_STATUS_INCOMPLETE;
     questStatusData.Explored = false;
@@ -15296,6 +15425,7 @@ void Player::RewardQuest(Quest const* quest, LootItemType rewardType, uint32 rew
 
 void Player::SetRewardedQuest(uint32 quest_id)
 {
+    InvalidateQuestGiverStatusCache();
     m_RewardedQuests.insert(quest_id);
     m_RewardedQuestsSave[quest_id] = QUEST_DEFAULT_SAVE_TYPE;
 
@@ -15471,7 +15601,7 @@ bool Player::SatisfyQuestPreviousQuest(Quest const* qInfo, bool msg) const
 
     uint32 prevId = std::abs(qInfo->GetPrevQuestId());
     // If positive previous quest rewarded, return true
-    if (qInfo->GetPrevQuestId() > 0 && m_RewardedQuests.count(prevId) > 0)
+    if (qInfo->GetPrevQuestId() > 0 && m_RewardedQuests.contains(prevId))
         return true;
 
     // If negative previous quest active, return true
@@ -15948,6 +16078,7 @@ void Player::SetQuestStatus(uint32 questId, QuestStatus status, bool update /*=
     {
         QuestStatus oldStatus = m_QuestStatus[questId].Status;
         m_QuestStatus[questId].Status = status;
+        InvalidateQuestGiverStatusCache();
 
         if (!quest->IsTurnIn())
             m_QuestStatusSave[questId] = QUEST_DEFAULT_SAVE_TYPE;
@@ -15974,6 +16105,7 @@ void Player::RemoveActiveQuest(uint32 questId, bool update /*= true*/)
         }
         m_QuestStatus.erase(itr);
         m_QuestStatusSave[questId] = QUEST_DELETE_SAVE_TYPE;
+        InvalidateQuestGiverStatusCache();
     }
 
     Quest const* quest = sObjectMgr->GetQuestTemplate(questId);
@@ -15993,12 +16125,8 @@ void Player::RemoveActiveQuest(uint32 questId, bool update /*= true*/)
 
 void Player::RemoveRewardedQuest(uint32 questId, bool update /*= true*/)
 {
-    RewardedQuestSet::iterator rewItr = m_RewardedQuests.find(questId);
-    if (rewItr != m_RewardedQuests.end())
-    {
-        m_RewardedQuests.erase(rewItr);
+    if (m_RewardedQuests.erase(questId))
         m_RewardedQuestsSave[questId] = QUEST_FORCE_DELETE_SAVE_TYPE;
-    }
 
     if (uint32 questBit = sDB2Manager.GetQuestUniqueBitFlag(questId))
         SetQuestCompletedBit(questBit, false);
@@ -16019,6 +16147,8 @@ void Player::RemoveRewardedQuest(uint32 questId, bool update /*= true*/)
         }
     }
 
+    InvalidateQuestGiverStatusCache();
+
     if (update)
     {
         SendQuestUpdate(questId);
@@ -16121,6 +16251,25 @@ QuestGiverStatus Player::GetQuestDialogStatus(Object const* questgiver) const
             return QuestGiverStatus::None;
     }
 
+    uint64 cacheKey = (uint64(questgiver->GetTypeId()) << 32) | questgiver->GetEntry();
+    uint32 generation = sObjectMgr->GetQuestGiverStatusGeneration();
+    if (m_questGiverStatusCacheGeneration != generation || m_questGiverStatusCacheLevel != GetLevel())
+    {
+        m_questGiverStatusCache.clear();
+        m_questGiverStatusCacheGeneration = generation;
+        m_questGiverStatusCacheLevel = GetLevel();
+    }
+    else if (QuestGiverStatus const* cachedStatus = Trinity::Containers::MapGetValuePtr(m_questGiverStatusCache, cacheKey))
+        return *cachedStatus;
+
+    // conditions and skill values change without invalidating the cache, givers of quests depending on them are always recomputed
+    bool cacheable = true;
+    auto checkCacheable = [&cacheable](Quest const* quest)
+    {
+        if (quest->GetRequiredSkill() || sConditionMgr->HasConditionsForNotGroupedEntry(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, quest->GetQuestId()))
+            cacheable = false;
+    };
+
     QuestGiverStatus result = QuestGiverStatus::None;
 
     for (uint32 questId : qir)
@@ -16129,6 +16278,8 @@ QuestGiverStatus Player::GetQuestDialogStatus(Object const* questgiver) const
         if (!quest)
             continue;
 
+        checkCacheable(quest);
+
         switch (GetQuestStatus(questId))
         {
             case QUEST_STATUS_COMPLETE:
@@ -16170,6 +16321,8 @@ QuestGiverStatus Player::GetQuestDialogStatus(Object const* questgiver) const
         if (!quest)
             continue;
 
+        checkCacheable(quest);
+
         if (!sConditionMgr->IsObjectMeetingNotGroupedConditions(CONDITION_SOURCE_TYPE_QUEST_AVAILABLE, quest->GetQuestId(), this))
             continue;
 
@@ -16201,6 +16354,9 @@ QuestGiverStatus Player::GetQuestDialogStatus(Object const* questgiver) const
         }
     }
 
+    if (cacheable)
+        m_questGiverStatusCache[cacheKey] = result;
+
     return result;
 }
 
@@ -16620,6 +16776,8 @@ void Player::MoneyChanged(uint64 value)
 
 void Player::ReputationChanged(FactionEntry const* factionEntry, int32 change)
 {
+    InvalidateQuestGiverStatusCache();
+
     UpdateQuestObjectiveProgress(QUEST_OBJECTIVE_MIN_REPUTATION, factionEntry->ID, change);
     UpdateQuestObjectiveProgress(QUEST_OBJECTIVE_MAX_REPUTATION, factionEntry->ID, change);
     UpdateQuestObjectiveProgress(QUEST_OBJECTIVE_INCREASE_REPUTATION, factionEntry->ID, change);
@@ -17255,7 +17413,8 @@ void Player::SendQuestGiverStatusMultiple()
     SendQuestGiverStatusMultiple(m_clientGUIDs);
 }
 
-void Player::SendQuestGiverStatusMultiple(GuidUnorderedSet const& guids)
+template<class GuidContainer>
+void Player::SendQuestGiverStatusMultiple(GuidContainer const& guids)
 {
     WorldPackets::Quest::QuestGiverStatusMultiple response;
 
@@ -17285,6 +17444,9 @@ void Player::SendQuestGiverStatusMultiple(GuidUnorderedSet const& guids)
     SendDirectMessage(response.Write());
 }
 
+template TC_GAME_API void Player::SendQuestGiverStatusMultiple(GuidUnorderedSet const& guids);
+template TC_GAME_API void Player::SendQuestGiverStatusMultiple(GuidFlatHashSet const& guids);
+
 bool Player::HasPvPForcingQuest() const
 {
     for (uint8 i = 0; i < MAX_QUEST_LOG_SIZE; ++i)
@@ -17514,6 +17676,8 @@ bool Player::IsLoading() const
 
 bool Player::LoadFromDB(ObjectGuid guid, CharacterDatabaseQueryHolder const& holder)
 {
+    TC_ALLOCATION_TAG_SCOPE(Players);
+
     PreparedQueryResult result = holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_FROM);
     if (!result)
     {
@@ -18242,13 +18406,7 @@ bool Player::LoadFromDB(ObjectGuid guid, CharacterDatabaseQueryHolder const& hol
     StartLoadingActionButtons();
 
     // unread mails and next delivery time, actual mails not loaded
-    _LoadMail(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAILS),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_ARTIFACT),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_MILESTONE_POWER),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_UNLOCKED_ESSENCE),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_EMPOWERED));
+    _LoadMail(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAILS), holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEM_INFO));
 
     m_social = sSocialMgr->LoadFromDB(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_SOCIAL_LIST), GetGUID());
 
@@ -18379,14 +18537,6 @@ bool Player::LoadFromDB(ObjectGuid guid, CharacterDatabaseQueryHolder const& hol
 
     _LoadCUFProfiles(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_CUF_PROFILES));
 
-    std::unique_ptr<Garrison> garrison = std::make_unique<Garrison>(this);
-    if (garrison->LoadFromDB(holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON_BLUEPRINTS),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON_BUILDINGS),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON_FOLLOWERS),
-        holder.GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON_FOLLOWER_ABILITIES)))
-        _garrison = std::move(garrison);
-
     _InitHonorLevelOnLoadFromDB(fields.honor, fields.honorLevel);
 
     _restMgr->LoadRestBonus(REST_TYPE_HONOR, fields.honorRestState, fields.honorRestBonus);
@@ -19140,8 +19290,7 @@ Item* Player::_LoadMailedItem(ObjectGuid const& playerGuid, Player* player, uint
     return item;
 }
 
-void Player::_LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mailItemsResult, PreparedQueryResult artifactResult, PreparedQueryResult azeriteItemResult,
-    PreparedQueryResult azeriteItemMilestonePowersResult, PreparedQueryResult azeriteItemUnlockedEssencesResult, PreparedQueryResult azeriteEmpoweredItemResult)
+void Player::_LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mailItemInfoResult)
 {
     std::unordered_map<uint64, Mail*> mailById;
 
@@ -19180,23 +19329,56 @@ void Player::_LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mail
         while (mailsResult->NextRow());
     }
 
-    if (mailItemsResult)
+    // only the attachment list is needed until the mailbox is opened, see LoadMailedItems
+    if (mailItemInfoResult)
     {
-        std::unordered_map<ObjectGuid::LowType, ItemAdditionalLoadInfo> additionalData;
-        ItemAdditionalLoadInfo::Init(&additionalData, artifactResult, azeriteItemResult, azeriteItemMilestonePowersResult,
-            azeriteItemUnlockedEssencesResult, azeriteEmpoweredItemResult);
-
         do
         {
-            Field* fields = mailItemsResult->Fetch();
-            uint64 mailId = fields[53].GetUInt64();
-            _LoadMailedItem(GetGUID(), this, mailId, mailById[mailId], fields, Trinity::Containers::MapGetValuePtr(additionalData, fields[0].GetUInt64()));
-        } while (mailItemsResult->NextRow());
+            Field* fields = mailItemInfoResult->Fetch();
+            if (Mail* mail = Trinity::Containers::MapGetValuePtr(mailById, fields[0].GetUInt64()))
+                mail->AddItem(fields[1].GetUInt64(), fields[2].GetUInt32());
+        } while (mailItemInfoResult->NextRow());
     }
 
     UpdateNextMailTimeAndUnreads();
 }
 
+void Player::LoadMailedItems(PreparedQueryResult mailItemsResult, PreparedQueryResult artifactResult, PreparedQueryResult azeriteItemResult,
+    PreparedQueryResult azeriteItemMilestonePowersResult, PreparedQueryResult azeriteItemUnlockedEssencesResult, PreparedQueryResult azeriteEmpoweredItemResult)
+{
+    m_mailedItemsLoaded = true;
+    m_mailedItemsLoading = false;
+
+    if (!mailItemsResult)
+        return;
+
+    std::unordered_map<uint64, Mail*> mailById;
+    for (Mail* mail : m_mail)
+        mailById[mail->messageID] = mail;
+
+    std::unordered_map<ObjectGuid::LowType, ItemAdditionalLoadInfo> additionalData;
+    ItemAdditionalLoadInfo::Init(&additionalData, artifactResult, azeriteItemResult, azeriteItemMilestonePowersResult,
+        azeriteItemUnlockedEssencesResult, azeriteEmpoweredItemResult);
+
+    do
+    {
+        Field* fields = mailItemsResult->Fetch();
+        ObjectGuid::LowType itemGuid = fields[0].GetUInt64();
+        uint64 mailId = fields[53].GetUInt64();
+
+        // mails delivered while the query was running already have their items, deleted mails drop theirs on save
+        Mail* mail = Trinity::Containers::MapGetValuePtr(mailById, mailId);
+        if (!mail || mail->state == MAIL_STATE_DELETED || mMitems.count(itemGuid))
+            continue;
+
+        if (std::find_if(mail->items.begin(), mail->items.end(), [itemGuid](MailItemInfo const& info) { return info.item_guid == itemGuid; }) == mail->items.end())
+            continue;
+
+        if (!_LoadMailedItem(GetGUID(), this, mailId, nullptr, fields, Trinity::Containers::MapGetValuePtr(additionalData, itemGuid)))
+            mail->RemoveItem(itemGuid);
+    } while (mailItemsResult->NextRow());
+}
+
 void Player::_LoadQuestStatus(PreparedQueryResult result)
 {
     uint16 slot = 0;
@@ -19779,7 +19961,10 @@ bool Player::CheckInstanceCount(uint32 instanceId) const
 void Player::AddInstanceEnterTime(uint32 instanceId, time_t enterTime)
 {
     if (_instanceResetTimes.find(instanceId) == _instanceResetTimes.end())
+    {
         _instanceResetTimes.insert(InstanceTimeMap::value_type(instanceId, enterTime + HOUR));
+        m_updateSchedule.Schedule(PlayerScheduledUpdate::InstanceResetTimes, enterTime + HOUR + 1);
+    }
 }
 
 WorldSafeLocsEntry const* Player::GetInstanceEntrance(uint32 targetMapId)
@@ -19900,10 +20085,36 @@ void Player::SaveToDB(bool create /*=false*/)
 
     SaveToDB(loginTransaction, trans, create);
 
-    CharacterDatabase.CommitTransaction(trans);
+    GetSession()->AddTransactionCallback(CharacterDatabase.AsyncCommitTransaction(trans)).AfterComplete([session = GetSession(), guid = GetGUID()](bool success)
+    {
+        // rows skipped as unchanged were never written, the next save must rewrite them
+        if (!success)
+            if (Player* player = session->GetPlayer())
+                if (player->GetGUID() == guid)
+                    player->ResetSaveSnapshots();
+    });
     LoginDatabase.CommitTransaction(loginTransaction);
 }
 
+template<typename SaveFunction>
+std::size_t Player::_SaveIfChanged(CharacterDatabaseTransaction const& trans, SaveSnapshot snapshot, SaveFunction save)
+{
+    std::size_t first = trans->GetSize();
+    (this->*save)(trans);
+
+    std::size_t hash = trans->GetQueriesHash(first);
+    std::size_t& lastHash = m_saveSnapshotHashes[size_t(snapshot)];
+    if (hash != lastHash)
+    {
+        lastHash = hash;
+        return 0;
+    }
+
+    std::size_t skipped = trans->GetSize() - first;
+    trans->Truncate(first);
+    return skipped;
+}
+
 void Player::SaveToDB(LoginDatabaseTransaction loginTransaction, CharacterDatabaseTransaction trans, bool create /* = false */)
 {
     // delay auto save at any saves (manual, in code, or autosave)
@@ -19925,8 +20136,12 @@ void Player::SaveToDB(LoginDatabaseTransaction loginTransaction, CharacterDataba
     if (!create)
         sScriptMgr->OnPlayerSave(this);
 
+    sCharacterEnumCache->Invalidate(GetSession()->GetAccountId());
+
     CharacterDatabasePreparedStatement* stmt = nullptr;
     uint8 index = 0;
+    std::size_t firstStatement = trans->GetSize();
+    std::size_t skippedStatements = 0;
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_CHAR_FISHINGSTEPS);
     stmt->setUInt64(0, GetGUID().GetCounter());
@@ -20256,7 +20471,7 @@ void Player::SaveToDB(LoginDatabaseTransaction loginTransaction, CharacterDataba
         _SaveMail(trans);
 
     _SaveCustomizations(trans);
-    _SaveBGData(trans);
+    skippedStatements += _SaveIfChanged(trans, SaveSnapshot::BGData, &Player::_SaveBGData);
     _SaveInventory(trans);
     _SaveVoidStorage(trans);
     _SaveQuestStatus(trans);
@@ -20264,13 +20479,13 @@ void Player::SaveToDB(LoginDatabaseTransaction loginTransaction, CharacterDataba
     _SaveWeeklyQuestStatus(trans);
     _SaveSeasonalQuestStatus(trans);
     _SaveMonthlyQuestStatus(trans);
-    _SaveGlyphs(trans);
-    _SaveTalents(trans);
+    skippedStatements += _SaveIfChanged(trans, SaveSnapshot::Glyphs, &Player::_SaveGlyphs);
+    skippedStatements += _SaveIfChanged(trans, SaveSnapshot::Talents, &Player::_SaveTalents);
     _SaveTraits(trans);
     _SaveSpells(trans);
     GetSpellHistory()->SaveToDB<Player>(trans);
     _SaveActions(trans);
-    _SaveAuras(trans);
+    skippedStatements += _SaveIfChanged(trans, SaveSnapshot::Auras, &Player::_SaveAuras);
     _SaveSkills(trans);
     _SaveStoredAuraTeleportLocations(trans);
     m_achievementMgr->SaveToDB(trans);
@@ -20280,7 +20495,7 @@ void Player::SaveToDB(LoginDatabaseTransaction loginTransaction, CharacterDataba
     GetSession()->SaveTutorialsData(trans);                 // changed only while character in game
     _SaveInstanceTimeRestrictions(trans);
     _SaveCurrency(trans);
-    _SaveCUFProfiles(trans);
+    skippedStatements += _SaveIfChanged(trans, SaveSnapshot::CUFProfiles, &Player::_SaveCUFProfiles);
     if (_garrison)
         _garrison->SaveToDB(trans);
 
@@ -20289,6 +20504,10 @@ void Player::SaveToDB(LoginDatabaseTransaction loginTransaction, CharacterDataba
     if (m_session->isLogingOut() || !sWorld->getBoolConfig(CONFIG_STATS_SAVE_ONLY_ON_LOGOUT))
         _SaveStats(trans);
 
+    TC_LOG_DEBUG("entities.player", "Player::SaveToDB: {} skipped {} statements of unchanged data", GetGUID().ToString(), skippedStatements);
+    TC_METRIC_VALUE("player_save_statements", uint64(trans->GetSize() - firstStatement));
+    TC_METRIC_VALUE("player_save_skipped_statements", uint64(skippedStatements));
+
     // TODO: Move this out
     GetSession()->GetCollectionMgr()->SaveAccountToys(loginTransaction);
     GetSession()->GetBattlePetMgr()->SaveToDB(loginTransaction);
@@ -23436,6 +23655,7 @@ void Player::UpdatePvP(bool state, bool _override)
     else
     {
         pvpInfo.EndTimer = GameTime::GetGameTime();
+        m_updateSchedule.Schedule(PlayerScheduledUpdate::PvPFlag, pvpInfo.EndTimer + 300);
         SetPvP(state);
     }
 }
@@ -23794,7 +24014,7 @@ uint8 Player::GetStartLevel(uint8 race, uint8 playerClass, Optional<int32> chara
 
 bool Player::HaveAtClient(Object const* u) const
 {
-    return u == this || m_clientGUIDs.find(u->GetGUID()) != m_clientGUIDs.end();
+    return u == this || m_clientGUIDs.contains(u->GetGUID());
 }
 
 bool Player::IsNeverVisibleFor(WorldObject const* seer, bool allowServersideObjects) const
@@ -23920,7 +24140,7 @@ void Player::UpdateVisibilityOf(Trinity::IteratorPair<WorldObject**> targets)
         return;
 
     UpdateData udata(GetMapId());
-    std::set<WorldObject*> newVisibleObjects;
+    Trinity::TickSet<WorldObject*> newVisibleObjects(Trinity::TickArena::GetResource());
 
     for (WorldObject* target : targets)
     {
@@ -24095,7 +24315,7 @@ void Player::SendInitialVisiblePackets(WorldObject* target) const
 }
 
 template<class T>
-void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<WorldObject*>& visibleNow)
+void Player::UpdateVisibilityOf(T* target, UpdateData& data, Trinity::TickSet<WorldObject*>& visibleNow)
 {
     if (HaveAtClient(target))
     {
@@ -24130,14 +24350,14 @@ void Player::UpdateVisibilityOf(T* target, UpdateData& data, std::set<WorldObjec
     }
 }
 
-template void Player::UpdateVisibilityOf(Player*        target, UpdateData& data, std::set<WorldObject*>& visibleNow);
-template void Player::UpdateVisibilityOf(Creature*      target, UpdateData& data, std::set<WorldObject*>& visibleNow);
-template void Player::UpdateVisibilityOf(Corpse*        target, UpdateData& data, std::set<WorldObject*>& visibleNow);
-template void Player::UpdateVisibilityOf(GameObject*    target, UpdateData& data, std::set<WorldObject*>& visibleNow);
-template void Player::UpdateVisibilityOf(DynamicObject* target, UpdateData& data, std::set<WorldObject*>& visibleNow);
-template void Player::UpdateVisibilityOf(AreaTrigger*   target, UpdateData& data, std::set<WorldObject*>& visibleNow);
-template void Player::UpdateVisibilityOf(SceneObject*   target, UpdateData& data, std::set<WorldObject*>& visibleNow);
-template void Player::UpdateVisibilityOf(Conversation*  target, UpdateData& data, std::set<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(Player*        target, UpdateData& data, Trinity::TickSet<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(Creature*      target, UpdateData& data, Trinity::TickSet<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(Corpse*        target, UpdateData& data, Trinity::TickSet<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(GameObject*    target, UpdateData& data, Trinity::TickSet<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(DynamicObject* target, UpdateData& data, Trinity::TickSet<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(AreaTrigger*   target, UpdateData& data, Trinity::TickSet<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(SceneObject*   target, UpdateData& data, Trinity::TickSet<WorldObject*>& visibleNow);
+template void Player::UpdateVisibilityOf(Conversation*  target, UpdateData& data, Trinity::TickSet<WorldObject*>& visibleNow);
 
 void Player::UpdateObjectVisibility(bool forced)
 {
@@ -24208,7 +24428,7 @@ void Player::SetMoney(uint64 value)
 
 bool Player::IsQuestRewarded(uint32 quest_id) const
 {
-    return m_RewardedQuests.find(quest_id) != m_RewardedQuests.end();
+    return m_RewardedQuests.contains(quest_id);
 }
 
 Unit* Player::GetSelectedUnit() const
@@ -24272,7 +24492,7 @@ void Player::SetGroup(Group* group, int8 subgroup)
     UpdateObjectVisibility(false);
 }
 
-void Player::SendInitialPacketsBeforeAddToMap()
+void Player::SendInitialPacketsBeforeAddToMap(PlayerInitialPackets const* prebuilt /*= nullptr*/)
 {
     if (!(m_teleport_options & TELE_TO_SEAMLESS))
     {
@@ -24292,6 +24512,65 @@ void Player::SendInitialPacketsBeforeAddToMap()
     // SMSG_SET_PCT_SPELL_MODIFIER
     // SMSG_SET_FLAT_SPELL_MODIFIER
 
+    if (prebuilt)
+    {
+        for (WorldPacket const& packet : prebuilt->Self)
+            SendDirectMessage(&packet);
+    }
+    else
+        SendInitialSelfPackets();
+
+    /// SMSG_LOGIN_SETTIMESPEED
+    static float const TimeSpeed = 0.01666667f;
+    WorldPackets::Misc::LoginSetTimeSpeed loginSetTimeSpeed;
+    loginSetTimeSpeed.NewSpeed = TimeSpeed;
+    loginSetTimeSpeed.GameTime = *GameTime::GetWowTime();
+    loginSetTimeSpeed.ServerTime = *GameTime::GetWowTime();
+    loginSetTimeSpeed.GameTimeHolidayOffset = 0; /// @todo
+    loginSetTimeSpeed.ServerTimeHolidayOffset = 0; /// @todo
+    SendDirectMessage(loginSetTimeSpeed.Write());
+
+    /// SMSG_WORLD_SERVER_INFO
+    WorldPackets::Misc::WorldServerInfo worldServerInfo;
+    if (MapDifficultyEntry const* mapDifficulty = GetMap()->GetMapDifficulty())
+        worldServerInfo.InstanceGroupSize = mapDifficulty->MaxPlayers;
+    worldServerInfo.IsTournamentRealm = 0; /// @todo
+    // worldServerInfo.RestrictedAccountMaxLevel; /// @todo
+    // worldServerInfo.RestrictedAccountMaxMoney; /// @todo
+    worldServerInfo.DifficultyID = GetMap()->GetDifficultyID();
+    // worldServerInfo.XRealmPvpAlert;  /// @todo
+    SendDirectMessage(worldServerInfo.Write());
+
+    if (prebuilt)
+    {
+        for (WorldPacket const& packet : prebuilt->Collections)
+            SendDirectMessage(&packet);
+    }
+    else
+        SendInitialCollectionPackets();
+
+    WorldPackets::Character::InitialSetup initialSetup;
+    initialSetup.ServerExpansionLevel = sWorld->getIntConfig(CONFIG_EXPANSION);
+    SendDirectMessage(initialSetup.Write());
+
+    SetMovedUnit(this);
+}
+
+void Player::BuildInitialPackets(PlayerInitialPackets& packets)
+{
+    {
+        WorldSession::PacketCaptureScope capture(GetSession(), packets.Self);
+        SendInitialSelfPackets();
+    }
+
+    {
+        WorldSession::PacketCaptureScope capture(GetSession(), packets.Collections);
+        SendInitialCollectionPackets();
+    }
+}
+
+void Player::SendInitialSelfPackets()
+{
     /// SMSG_TALENTS_INFO
     SendTalentsInfoData();
     /// SMSG_INITIAL_SPELLS
@@ -24333,28 +24612,10 @@ void Player::SendInitialPacketsBeforeAddToMap()
 
     m_achievementMgr->SendAllData(this);
     m_questObjectiveCriteriaMgr->SendAllData(this);
+}
 
-    /// SMSG_LOGIN_SETTIMESPEED
-    static float const TimeSpeed = 0.01666667f;
-    WorldPackets::Misc::LoginSetTimeSpeed loginSetTimeSpeed;
-    loginSetTimeSpeed.NewSpeed = TimeSpeed;
-    loginSetTimeSpeed.GameTime = *GameTime::GetWowTime();
-    loginSetTimeSpeed.ServerTime = *GameTime::GetWowTime();
-    loginSetTimeSpeed.GameTimeHolidayOffset = 0; /// @todo
-    loginSetTimeSpeed.ServerTimeHolidayOffset = 0; /// @todo
-    SendDirectMessage(loginSetTimeSpeed.Write());
-
-    /// SMSG_WORLD_SERVER_INFO
-    WorldPackets::Misc::WorldServerInfo worldServerInfo;
-    if (MapDifficultyEntry const* mapDifficulty = GetMap()->GetMapDifficulty())
-        worldServerInfo.InstanceGroupSize = mapDifficulty->MaxPlayers;
-    worldServerInfo.IsTournamentRealm = 0; /// @todo
-    // worldServerInfo.RestrictedAccountMaxLevel; /// @todo
-    // worldServerInfo.RestrictedAccountMaxMoney; /// @todo
-    worldServerInfo.DifficultyID = GetMap()->GetDifficultyID();
-    // worldServerInfo.XRealmPvpAlert;  /// @todo
-    SendDirectMessage(worldServerInfo.Write());
-
+void Player::SendInitialCollectionPackets() const
+{
     // Spell modifiers
     SendSpellModifiers();
 
@@ -24377,12 +24638,6 @@ void Player::SendInitialPacketsBeforeAddToMap()
     SendDirectMessage(heirloomUpdate.Write());
 
     GetSession()->GetCollectionMgr()->SendFavoriteAppearances();
-
-    WorldPackets::Character::InitialSetup initialSetup;
-    initialSetup.ServerExpansionLevel = sWorld->getIntConfig(CONFIG_EXPANSION);
-    SendDirectMessage(initialSetup.Write());
-
-    SetMovedUnit(this);
 }
 
 void Player::SendInitialPacketsAfterAddToMap()
@@ -24753,9 +25008,9 @@ void Player::LearnQuestRewardedSpells(Quest const* quest)
 void Player::LearnQuestRewardedSpells()
 {
     // learn spells received from quest completing
-    for (RewardedQuestSet::const_iterator itr = m_RewardedQuests.begin(); itr != m_RewardedQuests.end(); ++itr)
+    for (uint32 questId : m_RewardedQuests)
     {
-        Quest const* quest = sObjectMgr->GetQuestTemplate(*itr);
+        Quest const* quest = sObjectMgr->GetQuestTemplate(questId);
         if (!quest)
             continue;
 
@@ -24877,6 +25132,8 @@ void Player::SendAurasForTarget(Unit* target) const
 
 void Player::SetDailyQuestStatus(uint32 quest_id)
 {
+    InvalidateQuestGiverStatusCache();
+
     if (Quest const* qQuest = sObjectMgr->GetQuestTemplate(quest_id))
     {
         if (!qQuest->IsDFQuest())
@@ -24901,12 +25158,15 @@ bool Player::IsDailyQuestDone(uint32 quest_id) const
 
 void Player::SetWeeklyQuestStatus(uint32 quest_id)
 {
+    InvalidateQuestGiverStatusCache();
     m_weeklyquests.insert(quest_id);
     m_WeeklyQuestChanged = true;
 }
 
 void Player::SetSeasonalQuestStatus(uint32 quest_id)
 {
+    InvalidateQuestGiverStatusCache();
+
     Quest const* quest = sObjectMgr->GetQuestTemplate(quest_id);
     if (!quest)
         return;
@@ -24917,12 +25177,15 @@ void Player::SetSeasonalQuestStatus(uint32 quest_id)
 
 void Player::SetMonthlyQuestStatus(uint32 quest_id)
 {
+    InvalidateQuestGiverStatusCache();
     m_monthlyquests.insert(quest_id);
     m_MonthlyQuestChanged = true;
 }
 
 void Player::DailyReset()
 {
+    InvalidateQuestGiverStatusCache();
+
     for (int32 questId : m_activePlayerData->DailyQuestsCompleted)
         if (uint32 questBit = sDB2Manager.GetQuestUniqueBitFlag(questId))
             SetQuestCompletedBit(questBit, false);
@@ -24968,6 +25231,8 @@ void Player::DailyReset()
 
 void Player::ResetWeeklyQuestStatus()
 {
+    InvalidateQuestGiverStatusCache();
+
     if (m_weeklyquests.empty())
         return;
 
@@ -25003,6 +25268,8 @@ void Player::ResetWeeklyQuestStatus()
 
 void Player::ResetSeasonalQuestStatus(uint16 event_id, time_t eventStartTime)
 {
+    InvalidateQuestGiverStatusCache();
+
     // DB data deleted in caller
     m_SeasonalQuestChanged = false;
 
@@ -25033,6 +25300,8 @@ void Player::ResetSeasonalQuestStatus(uint16 event_id, time_t eventStartTime)
 
 void Player::ResetMonthlyQuestStatus()
 {
+    InvalidateQuestGiverStatusCache();
+
     if (m_monthlyquests.empty())
         return;
 
@@ -29144,6 +29413,7 @@ void Player::_LoadInstanceTimeRestrictions(PreparedQueryResult result)
     {
         Field* fields = result->Fetch();
         _instanceResetTimes.insert(InstanceTimeMap::value_type(fields[0].GetUInt32(), fields[1].GetUInt64()));
+        m_updateSchedule.Schedule(PlayerScheduledUpdate::InstanceResetTimes, fields[1].GetUInt64() + 1);
     } while (result->NextRow());
 }
 
@@ -29318,6 +29588,17 @@ void Player::CreateGarrison(uint32 garrSiteId)
         _garrison = std::move(garrison);
 }
 
+void Player::LoadGarrisonFromDB(PreparedQueryResult garrison, CharacterDatabaseQueryHolder const& garrisonHolder)
+{
+    std::unique_ptr<Garrison> loadedGarrison = std::make_unique<Garrison>(this);
+    if (loadedGarrison->LoadFromDB(garrison,
+        garrisonHolder.GetPreparedResult(PLAYER_GARRISON_LOGIN_QUERY_LOAD_BLUEPRINTS),
+        garrisonHolder.GetPreparedResult(PLAYER_GARRISON_LOGIN_QUERY_LOAD_BUILDINGS),
+        garrisonHolder.GetPreparedResult(PLAYER_GARRISON_LOGIN_QUERY_LOAD_FOLLOWERS),
+        garrisonHolder.GetPreparedResult(PLAYER_GARRISON_LOGIN_QUERY_LOAD_FOLLOWER_ABILITIES)))
+        _garrison = std::move(loadedGarrison);
+}
+
 void Player::DeleteGarrison()
 {
     if (_garrison)
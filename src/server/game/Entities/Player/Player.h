@@ -20,10 +20,13 @@
 
 #include "GridObject.h"
 #include "Unit.h"
+#include "AllocationTracker.h"
 #include "CUFProfile.h"
 #include "DatabaseEnvFwd.h"
 #include "DBCEnums.h"
+#include "DenseIdSet.h"
 #include "EquipmentSet.h"
+#include "FlatHashMap.h"
 #include "GroupReference.h"
 #include "Hash.h"
 #include "ItemDefines.h"
@@ -31,6 +34,7 @@
 #include "MapReference.h"
 #include "PetDefines.h"
 #include "PlayerTaxi.h"
+#include "PlayerUpdateSchedule.h"
 #include "QuestDef.h"
 #include "SceneMgr.h"
 
@@ -58,6 +62,7 @@ struct ItemTemplate;
 struct Loot;
 struct Mail;
 struct MapEntry;
+struct PlayerInitialPackets;
 struct PvpTalentEntry;
 struct QuestPackageItemEntry;
 struct RewardPackEntry;
@@ -578,7 +583,8 @@ struct QuestObjectiveStatusData
 
 using QuestObjectiveStatusMap = std::unordered_multimap<std::pair<QuestObjectiveType, int32>, QuestObjectiveStatusData>;
 
-typedef std::set<uint32> RewardedQuestSet;
+// max level characters have rewarded tens of thousands of quests, a bitmap over quest ids is far smaller than a tree of them
+typedef Trinity::Containers::DenseIdSet<uint32> RewardedQuestSet;
 
 enum QuestSaveType
 {
@@ -890,12 +896,7 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOAD_AZERITE_UNLOCKED_ESSENCES,
     PLAYER_LOGIN_QUERY_LOAD_AZERITE_EMPOWERED,
     PLAYER_LOGIN_QUERY_LOAD_MAILS,
-    PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS,
-    PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_ARTIFACT,
-    PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE,
-    PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_MILESTONE_POWER,
-    PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_UNLOCKED_ESSENCE,
-    PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_EMPOWERED,
+    PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEM_INFO,
     PLAYER_LOGIN_QUERY_LOAD_SOCIAL_LIST,
     PLAYER_LOGIN_QUERY_LOAD_HOME_BIND,
     PLAYER_LOGIN_QUERY_LOAD_SPELL_COOLDOWNS,
@@ -926,15 +927,21 @@ enum PlayerLoginQueryIndex
     PLAYER_LOGIN_QUERY_LOAD_CORPSE_LOCATION,
     PLAYER_LOGIN_QUERY_LOAD_PET_SLOTS,
     PLAYER_LOGIN_QUERY_LOAD_GARRISON,
-    PLAYER_LOGIN_QUERY_LOAD_GARRISON_BLUEPRINTS,
-    PLAYER_LOGIN_QUERY_LOAD_GARRISON_BUILDINGS,
-    PLAYER_LOGIN_QUERY_LOAD_GARRISON_FOLLOWERS,
-    PLAYER_LOGIN_QUERY_LOAD_GARRISON_FOLLOWER_ABILITIES,
     PLAYER_LOGIN_QUERY_LOAD_TRAIT_ENTRIES,
     PLAYER_LOGIN_QUERY_LOAD_TRAIT_CONFIGS,
     MAX_PLAYER_LOGIN_QUERY
 };
 
+// Queried after the login queries, only for characters that have a garrison
+enum PlayerGarrisonLoginQueryIndex
+{
+    PLAYER_GARRISON_LOGIN_QUERY_LOAD_BLUEPRINTS,
+    PLAYER_GARRISON_LOGIN_QUERY_LOAD_BUILDINGS,
+    PLAYER_GARRISON_LOGIN_QUERY_LOAD_FOLLOWERS,
+    PLAYER_GARRISON_LOGIN_QUERY_LOAD_FOLLOWER_ABILITIES,
+    MAX_PLAYER_GARRISON_LOGIN_QUERY
+};
+
 enum PlayerDelayedOperations
 {
     DELAYED_SAVE_PLAYER         = 0x01,
@@ -1168,6 +1175,8 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         explicit Player(WorldSession* session);
         ~Player();
 
+        TC_ALLOCATION_TAGGED_CLASS(Players)
+
         PlayerAI* AI() const { return reinterpret_cast<PlayerAI*>(GetAI()); }
 
         void CleanupsBeforeDelete(bool finalCleanup = true) override;
@@ -1196,8 +1205,13 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
 
         bool IsInAreaTrigger(AreaTriggerEntry const* areaTrigger) const;
 
-        void SendInitialPacketsBeforeAddToMap();
+        void SendInitialPacketsBeforeAddToMap(PlayerInitialPackets const* prebuilt = nullptr);
         void SendInitialPacketsAfterAddToMap();
+        // builds the self only packets of SendInitialPacketsBeforeAddToMap, they read nothing but the player and its session
+        // safe on any thread as long as nothing else can reach the player (logging in, not set on its session yet)
+        void BuildInitialPackets(PlayerInitialPackets& packets);
+        void SendInitialSelfPackets();
+        void SendInitialCollectionPackets() const;
         void SendSupercededSpell(uint32 oldSpell, uint32 newSpell) const;
         void SendTransferAborted(uint32 mapid, TransferAbortReason reason, uint8 arg = 0, int32 mapDifficultyXConditionID = 0) const;
 
@@ -1398,6 +1412,32 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
             return true;
         }
 
+        /**
+         * @brief Iterate over the items with the given entry in the player storage, without visiting any other slot
+         * @tparam T ItemSearchCallbackResult ItemCallback(Item* item)
+         * @param entry Entry of the items to iterate over
+         * @param location Locations of the items to iterate over
+         * @param callback Callback called on each item. Will continue as long as it returns ItemSearchCallbackResult::Continue
+         */
+        template <typename T>
+        bool ForEachItemOfEntry(uint32 entry, ItemSearchLocation location, T callback) const
+        {
+            auto itr = m_itemsByEntry.find(entry);
+            if (itr == m_itemsByEntry.end())
+                return true;
+
+            for (Item* item : itr->second)
+                if (IsItemInSearchLocation(item, location))
+                    if (callback(item) == ItemSearchCallbackResult::Stop)
+                        return false;
+
+            return true;
+        }
+
+        bool IsItemInSearchLocation(Item const* item, EnumFlag<ItemSearchLocation> location) const;
+        // must be called after changing the entry of an item stored by the player
+        void UpdateItemEntryIndex(Item* item, uint32 previousEntry);
+
     public:
         void UpdateAverageItemLevelTotal();
         void UpdateAverageItemLevelEquipped();
@@ -1671,6 +1711,8 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         void RemoveRewardedQuest(uint32 questId, bool update = true);
         void SendQuestUpdate(uint32 questId, bool updateInteractions = true, bool updateGameObjectQuestGiverStatus = false);
         QuestGiverStatus GetQuestDialogStatus(Object const* questGiver) const;
+        // called whenever something the quest giver status of any quest giver depends on changes for this player
+        void InvalidateQuestGiverStatusCache() { m_questGiverStatusCache.clear(); }
         void SkipQuests(std::vector<uint32> const& questIds); // removes quest from log, flags rewarded, but does not give any rewards to player
         void DespawnPersonalSummonsForQuest(uint32 questId);
 
@@ -1741,7 +1783,8 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         void SendQuestUpdateAddItem(ItemTemplate const* itemTemplate, QuestObjective const& obj, uint16 count) const;
         void SendQuestUpdateAddPlayer(Quest const* quest, uint16 newCount) const;
         void SendQuestGiverStatusMultiple();
-        void SendQuestGiverStatusMultiple(GuidUnorderedSet const& guids);
+        template<class GuidContainer>
+        void SendQuestGiverStatusMultiple(GuidContainer const& guids);
         void SendDisplayToast(uint32 entry, DisplayToastType type, bool isBonusRoll, uint32 quantity, DisplayToastMethod method, uint32 questId = 0, Item* item = nullptr) const;
 
         uint32 GetSharedQuestID() const { return m_sharedQuestId; }
@@ -1849,6 +1892,7 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
 
         uint8 unReadMails;
         time_t m_nextMailDelivereTime;
+        PlayerUpdateSchedule m_updateSchedule;
 
         typedef std::unordered_map<ObjectGuid::LowType, Item*> ItemMap;
 
@@ -1858,6 +1902,13 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         void AddMItem(Item* it);
         bool RemoveMItem(ObjectGuid::LowType id);
 
+        // item instances of mails are only created the first time the mailbox is opened
+        bool IsMailedItemsLoaded() const { return m_mailedItemsLoaded; }
+        bool IsMailedItemsLoading() const { return m_mailedItemsLoading; }
+        void SetMailedItemsLoading() { m_mailedItemsLoading = true; }
+        void LoadMailedItems(PreparedQueryResult mailItemsResult, PreparedQueryResult artifactResult, PreparedQueryResult azeriteItemResult,
+            PreparedQueryResult azeriteItemMilestonePowersResult, PreparedQueryResult azeriteItemUnlockedEssencesResult, PreparedQueryResult azeriteEmpoweredItemResult);
+
         void SendOnCancelExpectedVehicleRideAura() const;
         void PetSpellInitialize();
         void CharmSpellInitialize();
@@ -2041,6 +2092,7 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
 
         void UpdateAfkReport(time_t currTime);
         void UpdatePvPFlag(time_t currTime);
+        void RunScheduledUpdates(time_t now);
         void SetContestedPvP(Player* attackedPlayer = nullptr);
         void UpdateContestedPvP(uint32 currTime);
         void SetContestedPvPTimer(uint32 newTime) {m_contestedPvPTimer = newTime;}
@@ -2108,6 +2160,7 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
 
         bool UpdateStats(Stats stat) override;
         bool UpdateAllStats() override;
+        void ApplyPendingStatUpdates() override;
         void ApplySpellPenetrationBonus(int32 amount, bool apply);
         void ApplyModTargetResistance(int32 mod, bool apply) { ApplyModUpdateFieldValue(m_values.ModifyValue(&Player::m_activePlayerData).ModifyValue(&UF::ActivePlayerData::ModTargetResistance), mod, apply); }
         void ApplyModTargetPhysicalResistance(int32 mod, bool apply) { ApplyModUpdateFieldValue(m_values.ModifyValue(&Player::m_activePlayerData).ModifyValue(&UF::ActivePlayerData::ModTargetPhysicalResistance), mod, apply); }
@@ -2453,6 +2506,7 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         void SendInitWorldStates(uint32 zoneId, uint32 areaId);
         void SendUpdateWorldState(uint32 variable, uint32 value, bool hidden = false) const;
         void SendDirectMessage(WorldPacket const* data) const;
+        void SendDirectMessage(std::shared_ptr<WorldPacket const> const& data) const;
 
         void SendAurasForTarget(Unit* target) const;
 
@@ -2585,7 +2639,7 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         uint8 GetStartLevel(uint8 race, uint8 playerClass, Optional<int32> characterTemplateId) const;
 
         // currently visible objects at player client
-        GuidUnorderedSet m_clientGUIDs;
+        GuidFlatHashSet m_clientGUIDs;
         GuidUnorderedSet m_visibleTransports;
 
         bool HaveAtClient(Object const* u) const;
@@ -2603,7 +2657,7 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         void UpdateTriggerVisibility();
 
         template<class T>
-        void UpdateVisibilityOf(T* target, UpdateData& data, std::set<WorldObject*>& visibleNow);
+        void UpdateVisibilityOf(T* target, UpdateData& data, Trinity::TickSet<WorldObject*>& visibleNow);
 
         std::array<uint8, MAX_MOVE_TYPE> m_forced_speed_changes;
         uint8 m_movementForceModMagnitudeChanges;
@@ -2787,6 +2841,7 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         void CreateGarrison(uint32 garrSiteId);
         void DeleteGarrison();
         Garrison* GetGarrison() const { return _garrison.get(); }
+        void LoadGarrisonFromDB(PreparedQueryResult garrison, CharacterDatabaseQueryHolder const& garrisonHolder);
 
         bool IsAdvancedCombatLoggingEnabled() const { return _advancedCombatLoggingEnabled; }
         void SetAdvancedCombatLogging(bool enabled) { _advancedCombatLoggingEnabled = enabled; }
@@ -3005,8 +3060,7 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
             PreparedQueryResult azeriteItemMilestonePowersResult, PreparedQueryResult azeriteItemUnlockedEssencesResult,
             PreparedQueryResult azeriteEmpoweredItemResult, uint32 timeDiff);
         void _LoadVoidStorage(PreparedQueryResult result);
-        void _LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mailItemsResult, PreparedQueryResult artifactResult, PreparedQueryResult azeriteItemResult,
-            PreparedQueryResult azeriteItemMilestonePowersResult, PreparedQueryResult azeriteItemUnlockedEssencesResult, PreparedQueryResult azeriteEmpoweredItemResult);
+        void _LoadMail(PreparedQueryResult mailsResult, PreparedQueryResult mailItemInfoResult);
         static Item* _LoadMailedItem(ObjectGuid const& playerGuid, Player* player, uint64 mailId, Mail* mail, Field* fields, ItemAdditionalLoadInfo* addionalData);
         void _LoadQuestStatus(PreparedQueryResult result);
         void _LoadQuestStatusObjectives(PreparedQueryResult result);
@@ -3063,6 +3117,22 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         void _SaveCurrency(CharacterDatabaseTransaction trans);
         void _SaveCUFProfiles(CharacterDatabaseTransaction trans);
 
+        // categories whose save functions rewrite all of their rows every time
+        enum class SaveSnapshot : uint8
+        {
+            BGData,
+            Glyphs,
+            Talents,
+            Auras,
+            CUFProfiles,
+
+            Max
+        };
+
+        template<typename SaveFunction>
+        std::size_t _SaveIfChanged(CharacterDatabaseTransaction const& trans, SaveSnapshot snapshot, SaveFunction save);
+        void ResetSaveSnapshots() { m_saveSnapshotHashes.fill(0); }
+
         /*********************************************************/
         /***              ENVIRONMENTAL SYSTEM                 ***/
         /*********************************************************/
@@ -3082,6 +3152,7 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         Team m_team;
         uint32 m_nextSave;
         bool m_customizationsChanged;
+        std::array<std::size_t, size_t(SaveSnapshot::Max)> m_saveSnapshotHashes;
         std::array<ChatFloodThrottle, ChatFloodThrottle::MAX> m_chatFloodData;
         Difficulty m_dungeonDifficulty;
         Difficulty m_raidDifficulty;
@@ -3090,6 +3161,8 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         uint32 m_atLoginFlags;
 
         Item* m_items[PLAYER_SLOTS_COUNT];
+        // items of m_items (except buyback) and of equipped bags, grouped by entry
+        Trinity::Containers::FlatHashMap<uint32, std::vector<Item*>> m_itemsByEntry;
         uint32 m_currentBuybackSlot;
 
         PlayerCurrenciesMap _currencyStorage;
@@ -3108,12 +3181,20 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         RewardedQuestSet m_RewardedQuests;
         QuestStatusSaveMap m_RewardedQuestsSave;
 
+        // quest giver statuses by quest giver type id and entry, computed from quest relations only (no AI overrides, hostility or combat)
+        // cleared by quest state and reputation changes, dropped whole when the level or sObjectMgr->GetQuestGiverStatusGeneration() changes
+        mutable Trinity::Containers::FlatHashMap<uint64, QuestGiverStatus> m_questGiverStatusCache;
+        mutable uint32 m_questGiverStatusCacheGeneration;
+        mutable uint8 m_questGiverStatusCacheLevel;
+
         SkillStatusMap mSkillStatus;
 
         ObjectGuid::LowType m_GuildIdInvited;
         uint32 m_ArenaTeamIdInvited;
 
         PlayerMails m_mail;
+        bool m_mailedItemsLoaded;
+        bool m_mailedItemsLoading;
         PlayerSpellMap m_spells;
         std::unordered_map<uint32 /*overridenSpellId*/, std::unordered_set<uint32> /*newSpellId*/> m_overrideSpells;
         uint32 m_lastPotionId;                              // last used health/mana potion in combat, that block next potion use
@@ -3129,6 +3210,7 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         std::array<float, BASEMOD_END> m_auraBaseFlatMod;
         std::array<float, BASEMOD_END> m_auraBasePctMod;
         std::array<int16, MAX_COMBAT_RATING> m_baseRatingValue;
+        uint32 m_pendingRatingUpdates;                      // combat ratings changed during a stat update batch
         uint32 m_baseSpellPower;
         uint32 m_baseManaRegen;
         uint32 m_baseHealthRegen;
@@ -3218,6 +3300,8 @@ class TC_GAME_API Player final : public Unit, public GridObject<Player>
         InventoryResult CanStoreItem_InBag(uint8 bag, ItemPosCountVec& dest, ItemTemplate const* pProto, uint32& count, bool merge, bool non_specialized, Item* pSrcItem, uint8 skip_bag, uint8 skip_slot) const;
         InventoryResult CanStoreItem_InInventorySlots(uint8 slot_begin, uint8 slot_end, ItemPosCountVec& dest, ItemTemplate const* pProto, uint32& count, bool merge, Item* pSrcItem, uint8 skip_bag, uint8 skip_slot) const;
         Item* _StoreItem(uint16 pos, Item* pItem, uint32 count, bool clone, bool update);
+        void AddItemToEntryIndex(Item* item);
+        void RemoveItemFromEntryIndex(Item* item, uint32 entry);
         Item* _LoadItem(CharacterDatabaseTransaction trans, uint32 zoneId, uint32 timeDiff, Field* fields);
 
         std::unique_ptr<CinematicMgr> _cinematicMgr;
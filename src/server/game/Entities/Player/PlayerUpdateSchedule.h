@@ -0,0 +1,79 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PlayerUpdateSchedule_h__
+#define PlayerUpdateSchedule_h__
+
+#include "Define.h"
+#include <algorithm>
+#include <array>
+#include <ctime>
+#include <limits>
+
+enum class PlayerScheduledUpdate : uint8
+{
+    MailDelivery,
+    PvPFlag,
+    AfkReport,
+    SoulboundTradeItems,
+    InstanceResetTimes,
+
+    Max
+};
+
+// Deadlines (game time) of the Player::Update parts that only have work to do at known points in time
+// Player::Update compares the current time with the earliest deadline and skips all of them until it passed
+class PlayerUpdateSchedule
+{
+public:
+    static constexpr time_t Never = std::numeric_limits<time_t>::max();
+
+    PlayerUpdateSchedule() { _deadlines.fill(Never); }
+
+    // an earlier deadline already scheduled is kept
+    void Schedule(PlayerScheduledUpdate update, time_t deadline)
+    {
+        time_t& current = _deadlines[std::size_t(update)];
+        if (deadline < current)
+        {
+            current = deadline;
+            _earliest = std::min(_earliest, deadline);
+        }
+    }
+
+    bool HasDue(time_t now) const { return now >= _earliest; }
+
+    // clears the deadline when it passed, the caller schedules the next one if there is still work left
+    bool TakeIfDue(PlayerScheduledUpdate update, time_t now)
+    {
+        time_t& deadline = _deadlines[std::size_t(update)];
+        if (now < deadline)
+            return false;
+
+        deadline = Never;
+        _earliest = *std::min_element(_deadlines.begin(), _deadlines.end());
+        return true;
+    }
+
+    time_t GetDeadline(PlayerScheduledUpdate update) const { return _deadlines[std::size_t(update)]; }
+
+private:
+    std::array<time_t, std::size_t(PlayerScheduledUpdate::Max)> _deadlines;
+    time_t _earliest = Never;
+};
+
+#endif // PlayerUpdateSchedule_h__
@@ -40,6 +40,9 @@ bool PlayerSocial::AddToSocialList(ObjectGuid const& friendGuid, ObjectGuid cons
     if (GetNumberOfSocialsWithFlag(flag) >= (((flag & SOCIAL_FLAG_FRIEND) != 0) ? SOCIALMGR_FRIEND_LIMIT : SOCIALMGR_IGNORE_LIMIT))
         return false;
 
+    if (flag & SOCIAL_FLAG_FRIEND)
+        sSocialMgr->AddFriendLister(friendGuid, GetPlayerGUID());
+
     PlayerSocialMap::iterator itr = _playerSocialMap.find(friendGuid);
     if (itr != _playerSocialMap.end())
     {
@@ -56,7 +59,7 @@ bool PlayerSocial::AddToSocialList(ObjectGuid const& friendGuid, ObjectGuid cons
     }
     else
     {
-        itr = _playerSocialMap.emplace(std::piecewise_construct, std::forward_as_tuple(friendGuid), std::forward_as_tuple()).first;
+        itr = _playerSocialMap.try_emplace(friendGuid).first;
 
         itr->second.Flags |= flag;
         itr->second.WowAccountGuid = accountGuid;
@@ -82,6 +85,9 @@ void PlayerSocial::RemoveFromSocialList(ObjectGuid const& friendGuid, SocialFlag
     if (itr == _playerSocialMap.end())
         return;
 
+    if (flag & itr->second.Flags & SOCIAL_FLAG_FRIEND)
+        sSocialMgr->RemoveFriendLister(friendGuid, GetPlayerGUID());
+
     itr->second.Flags &= ~flag;
 
     if (!itr->second.Flags)
@@ -95,7 +101,7 @@ void PlayerSocial::RemoveFromSocialList(ObjectGuid const& friendGuid, SocialFlag
 
         ObjectGuid accountGuid = itr->second.WowAccountGuid;
 
-        _playerSocialMap.erase(itr);
+        _playerSocialMap.erase(friendGuid);
 
         if (flag & SOCIAL_FLAG_IGNORED)
         {
@@ -264,32 +270,71 @@ void SocialMgr::BroadcastToFriendListers(Player* player, WorldPacket const* pack
 {
     ASSERT(player);
 
+    FriendListerMap::const_iterator listers = _friendListers.find(player->GetGUID());
+    if (listers == _friendListers.end())
+        return;
+
     AccountTypes gmSecLevel = AccountTypes(sWorld->getIntConfig(CONFIG_GM_LEVEL_IN_WHO_LIST));
-    for (SocialMap::const_iterator itr = _socialMap.begin(); itr != _socialMap.end(); ++itr)
+    for (ObjectGuid const& listerGuid : listers->second)
     {
-        PlayerSocial::PlayerSocialMap::const_iterator itr2 = itr->second._playerSocialMap.find(player->GetGUID());
-        if (itr2 != itr->second._playerSocialMap.end() && (itr2->second.Flags & SOCIAL_FLAG_FRIEND) != 0)
-        {
-            Player* target = ObjectAccessor::FindPlayer(itr->first);
-            if (!target)
-                continue;
+        Player* target = ObjectAccessor::FindPlayer(listerGuid);
+        if (!target)
+            continue;
 
-            WorldSession* session = target->GetSession();
-            if (!session->HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS) && player->GetSession()->GetSecurity() > gmSecLevel)
-                continue;
+        WorldSession* session = target->GetSession();
+        if (!session->HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS) && player->GetSession()->GetSecurity() > gmSecLevel)
+            continue;
 
-            if (target->GetTeam() != player->GetTeam() && !session->HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST))
-                continue;
+        if (target->GetTeam() != player->GetTeam() && !session->HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST))
+            continue;
 
-            if (player->IsVisibleGloballyFor(target))
-                session->SendPacket(packet);
-        }
+        if (player->IsVisibleGloballyFor(target))
+            session->SendPacket(packet);
     }
 }
 
+void SocialMgr::RemovePlayerSocial(ObjectGuid const& guid)
+{
+    SocialMap::iterator itr = _socialMap.find(guid);
+    if (itr == _socialMap.end())
+        return;
+
+    RemoveFriendListerFromAll(itr->second);
+    _socialMap.erase(itr);
+}
+
+void SocialMgr::AddFriendLister(ObjectGuid const& friendGuid, ObjectGuid const& listerGuid)
+{
+    _friendListers[friendGuid].insert(listerGuid);
+}
+
+void SocialMgr::RemoveFriendLister(ObjectGuid const& friendGuid, ObjectGuid const& listerGuid)
+{
+    FriendListerMap::iterator itr = _friendListers.find(friendGuid);
+    if (itr == _friendListers.end())
+        return;
+
+    itr->second.erase(listerGuid);
+    if (itr->second.empty())
+        _friendListers.erase(itr);
+}
+
+void SocialMgr::RemoveFriendListerFromAll(PlayerSocial const& social)
+{
+    for (PlayerSocial::PlayerSocialMap::value_type const& contact : social._playerSocialMap)
+        if (contact.second.Flags & SOCIAL_FLAG_FRIEND)
+            RemoveFriendLister(contact.first, social.GetPlayerGUID());
+}
+
 PlayerSocial* SocialMgr::LoadFromDB(PreparedQueryResult result, ObjectGuid const& guid)
 {
     PlayerSocial* social = &_socialMap[guid];
+
+    // reloading a list that is still loaded replaces it
+    RemoveFriendListerFromAll(*social);
+    social->_playerSocialMap.clear();
+    social->_ignoredAccounts.clear();
+
     social->SetPlayerGUID(guid);
 
     if (result)
@@ -303,6 +348,8 @@ PlayerSocial* SocialMgr::LoadFromDB(PreparedQueryResult result, ObjectGuid const
 
             uint8 flag = fields[2].GetUInt8();
             social->_playerSocialMap[friendGuid] = FriendInfo(friendAccountGuid, flag, fields[3].GetString());
+            if (flag & SOCIAL_FLAG_FRIEND)
+                AddFriendLister(friendGuid, guid);
             if (flag & SOCIAL_FLAG_IGNORED)
                 social->_ignoredAccounts.insert(friendAccountGuid);
         }
@@ -20,8 +20,10 @@
 
 #include "DatabaseEnvFwd.h"
 #include "Common.h"
+#include "FlatHashMap.h"
 #include "ObjectGuid.h"
 #include <map>
+#include <unordered_map>
 
 class Player;
 class WorldPacket;
@@ -125,7 +127,7 @@ class TC_GAME_API PlayerSocial
     private:
         bool _HasContact(ObjectGuid const& guid, SocialFlag flags);
 
-        typedef std::map<ObjectGuid, FriendInfo> PlayerSocialMap;
+        typedef Trinity::Containers::FlatHashMap<ObjectGuid, FriendInfo> PlayerSocialMap;
         PlayerSocialMap _playerSocialMap;
         GuidUnorderedSet _ignoredAccounts;
 
@@ -134,6 +136,8 @@ class TC_GAME_API PlayerSocial
 
 class SocialMgr
 {
+    friend class PlayerSocial;
+
     private:
         SocialMgr() { }
         ~SocialMgr() { }
@@ -142,7 +146,7 @@ class SocialMgr
         static SocialMgr* instance();
 
         // Misc
-        void RemovePlayerSocial(ObjectGuid const& guid) { _socialMap.erase(guid); }
+        void RemovePlayerSocial(ObjectGuid const& guid);
 
         static void GetFriendInfo(Player* player, ObjectGuid const& friendGUID, FriendInfo& friendInfo);
 
@@ -154,8 +158,17 @@ class SocialMgr
         PlayerSocial* LoadFromDB(PreparedQueryResult result, ObjectGuid const& guid);
 
     private:
+        // kept up to date by PlayerSocial for every loaded social list
+        void AddFriendLister(ObjectGuid const& friendGuid, ObjectGuid const& listerGuid);
+        void RemoveFriendLister(ObjectGuid const& friendGuid, ObjectGuid const& listerGuid);
+        void RemoveFriendListerFromAll(PlayerSocial const& social);
+
         typedef std::map<ObjectGuid, PlayerSocial> SocialMap;
         SocialMap _socialMap;
+
+        // players that have the key on their loaded friend list
+        typedef std::unordered_map<ObjectGuid, GuidUnorderedSet> FriendListerMap;
+        FriendListerMap _friendListers;
 };
 
 #define sSocialMgr SocialMgr::instance()
@@ -17,6 +17,8 @@
 
 #include "TaxiPathGraph.h"
 #include "DB2Stores.h"
+#include "Hash.h"
+#include "Log.h"
 #include "MapUtils.h"
 #include "ObjectMgr.h"
 #include "Player.h"
@@ -24,6 +26,8 @@
 #include <boost/graph/depth_first_search.hpp>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <boost/property_map/transform_value_property_map.hpp>
+#include <mutex>
+#include <shared_mutex>
 
 namespace
 {
@@ -31,11 +35,12 @@ struct EdgeCost
 {
     TaxiNodesEntry const* To;
     uint32 Distance;
-    uint32 EvaluateDistance(Player const* player) const
+    template<typename ConditionCheck>
+    uint32 EvaluateDistance(uint32 team, ConditionCheck&& isMeetingCondition) const
     {
         bool isVisibleForFaction = [&]
         {
-            switch (player->GetTeam())
+            switch (team)
             {
                 case HORDE: return To->GetFlags().HasFlag(TaxiNodeFlags::ShowOnHordeMap);
                 case ALLIANCE: return To->GetFlags().HasFlag(TaxiNodeFlags::ShowOnAllianceMap);
@@ -46,13 +51,37 @@ struct EdgeCost
         if (!isVisibleForFaction)
             return std::numeric_limits<uint16>::max();
 
-        if (!ConditionMgr::IsPlayerMeetingCondition(player, To->ConditionID))
+        if (!isMeetingCondition(To))
             return std::numeric_limits<uint16>::max();
 
         return Distance;
     }
 };
 
+// edge costs only depend on the team of the player and on which of the node conditions it meets
+// players sharing both get the same routes, so they share one routing table
+struct RouteClass
+{
+    uint32 Team = 0;
+    uint64 MetConditions = 0;
+
+    friend bool operator==(RouteClass const&, RouteClass const&) = default;
+};
+
+struct RouteClassHash
+{
+    std::size_t operator()(RouteClass const& routeClass) const
+    {
+        std::size_t hash = 0;
+        Trinity::hash_combine(hash, routeClass.Team);
+        Trinity::hash_combine(hash, routeClass.MetConditions);
+        return hash;
+    }
+};
+
+// dijkstra predecessors of every vertex, one array per source vertex, empty until the first route from it is requested
+using RouteTable = std::vector<std::vector<uint16>>;
+
 typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS, boost::property<boost::vertex_index_t, uint32>, boost::property<boost::edge_weight_t, EdgeCost>> Graph;
 typedef boost::property_map<Graph, boost::edge_weight_t>::type WeightMap;
 typedef Graph::vertex_descriptor vertex_descriptor;
@@ -63,6 +92,12 @@ Graph m_graph;
 std::vector<TaxiNodesEntry const*> m_nodesByVertex;
 std::unordered_map<uint32, vertex_descriptor> m_verticesByNode;
 
+std::vector<int32> m_nodeConditions;                // distinct ConditionID of all nodes, bit index in RouteClass::MetConditions
+std::unordered_map<uint32, uint8> m_conditionBitsByNode;
+bool m_useRouteTables = false;
+std::unordered_map<RouteClass, RouteTable, RouteClassHash> m_routeTables;
+std::shared_mutex m_routeTablesLock;
+
 void GetTaxiMapPosition(DBCPosition3D const& position, int32 mapId, DBCPosition2D* uiMapPosition, int32* uiMapId)
 {
     if (!DB2Manager::GetUiMapPosition(position.X, position.Y, position.Z, mapId, 0, 0, 0, UI_MAP_SYSTEM_ADVENTURE, false, uiMapId, uiMapPosition))
@@ -144,6 +179,85 @@ uint32 GetNodeIDFromVertexID(vertex_descriptor vertexID)
     return std::numeric_limits<uint32>::max();
 }
 
+RouteClass GetRouteClass(Player const* player)
+{
+    RouteClass routeClass;
+    routeClass.Team = player->GetTeam();
+    for (std::size_t i = 0; i < m_nodeConditions.size(); ++i)
+        if (ConditionMgr::IsPlayerMeetingCondition(player, m_nodeConditions[i]))
+            routeClass.MetConditions |= UI64LIT(1) << i;
+
+    return routeClass;
+}
+
+template<typename WeightFunction>
+void FindShortestPaths(vertex_descriptor from, std::vector<vertex_descriptor>& p, WeightFunction&& weight)
+{
+    std::vector<uint32> d(boost::num_vertices(m_graph));
+    p.resize(boost::num_vertices(m_graph));
+
+    boost::dijkstra_shortest_paths(m_graph, from,
+        boost::predecessor_map(boost::make_iterator_property_map(p.begin(), boost::get(boost::vertex_index, m_graph)))
+        .distance_map(boost::make_iterator_property_map(d.begin(), boost::get(boost::vertex_index, m_graph)))
+        .vertex_index_map(boost::get(boost::vertex_index, m_graph))
+        .distance_compare(std::less<uint32>())
+        .distance_combine(boost::closed_plus<uint32>())
+        .distance_inf(std::numeric_limits<uint32>::max())
+        .distance_zero(0)
+        .visitor(boost::dijkstra_visitor<boost::null_visitor>())
+        .weight_map(boost::make_transform_value_property_map(std::forward<WeightFunction>(weight), boost::get(boost::edge_weight, m_graph))));
+}
+
+template<typename Predecessors>
+void BuildRoute(vertex_descriptor to, Predecessors const& p, std::vector<uint32>& shortestPath)
+{
+    // found a path to the goal
+    for (vertex_descriptor v = to; ; v = p[v])
+    {
+        shortestPath.push_back(GetNodeIDFromVertexID(v));
+        if (v == p[v])
+            break;
+    }
+
+    std::reverse(shortestPath.begin(), shortestPath.end());
+}
+
+// walks the memoized routing table of the class of player, computing the table for this source vertex on first use
+void GetRouteFromTable(vertex_descriptor from, vertex_descriptor to, Player const* player, std::vector<uint32>& shortestPath)
+{
+    RouteClass routeClass = GetRouteClass(player);
+
+    {
+        std::shared_lock<std::shared_mutex> lock(m_routeTablesLock);
+        auto itr = m_routeTables.find(routeClass);
+        if (itr != m_routeTables.end() && !itr->second[from].empty())
+        {
+            BuildRoute(to, itr->second[from], shortestPath);
+            return;
+        }
+    }
+
+    std::vector<vertex_descriptor> p;
+    FindShortestPaths(from, p, [&routeClass](EdgeCost const& edgeCost)
+    {
+        return edgeCost.EvaluateDistance(routeClass.Team, [&routeClass](TaxiNodesEntry const* node)
+        {
+            uint8 const* conditionBit = Trinity::Containers::MapGetValuePtr(m_conditionBitsByNode, node->ID);
+            return !conditionBit || (routeClass.MetConditions & (UI64LIT(1) << *conditionBit)) != 0;
+        });
+    });
+
+    std::unique_lock<std::shared_mutex> lock(m_routeTablesLock);
+    RouteTable& table = m_routeTables[routeClass];
+    if (table.empty())
+        table.resize(m_nodesByVertex.size());
+
+    if (table[from].empty())
+        table[from].assign(p.begin(), p.end());
+
+    BuildRoute(to, table[from], shortestPath);
+}
+
 template<typename T>
 struct DiscoverVertexVisitor : public boost::base_visitor<DiscoverVertexVisitor<T>>
 {
@@ -193,6 +307,24 @@ void TaxiPathGraph::Initialize()
         edge_descriptor e = boost::add_edge(edges[j].first.first, edges[j].first.second, m_graph).first;
         weightmap[e] = edges[j].second;
     }
+
+    // routing tables store predecessors as uint16 and conditions met by a player as bits of an uint64
+    for (TaxiNodesEntry const* node : m_nodesByVertex)
+    {
+        if (!node->ConditionID)
+            continue;
+
+        auto conditionItr = std::find(m_nodeConditions.begin(), m_nodeConditions.end(), node->ConditionID);
+        if (conditionItr == m_nodeConditions.end())
+            conditionItr = m_nodeConditions.insert(m_nodeConditions.end(), node->ConditionID);
+
+        m_conditionBitsByNode[node->ID] = uint8(std::distance(m_nodeConditions.begin(), conditionItr));
+    }
+
+    m_useRouteTables = m_nodesByVertex.size() <= std::numeric_limits<uint16>::max() && m_nodeConditions.size() <= 64;
+    if (!m_useRouteTables)
+        TC_LOG_ERROR("server.loading", "TaxiPathGraph: {} nodes with {} distinct conditions do not fit routing tables, flight routes will be searched on every request",
+            m_nodesByVertex.size(), m_nodeConditions.size());
 }
 
 std::size_t TaxiPathGraph::GetCompleteNodeRoute(TaxiNodesEntry const* from, TaxiNodesEntry const* to, Player const* player, std::vector<uint32>& shortestPath)
@@ -219,31 +351,20 @@ std::size_t TaxiPathGraph::GetCompleteNodeRoute(TaxiNodesEntry const* from, Taxi
         vertex_descriptor const* toVertexId = GetVertexIDFromNodeID(to);
         if (fromVertexId && toVertexId)
         {
-            std::vector<vertex_descriptor> p(boost::num_vertices(m_graph));
-            std::vector<uint32> d(boost::num_vertices(m_graph));
-
-            boost::dijkstra_shortest_paths(m_graph, *fromVertexId,
-                boost::predecessor_map(boost::make_iterator_property_map(p.begin(), boost::get(boost::vertex_index, m_graph)))
-                .distance_map(boost::make_iterator_property_map(d.begin(), boost::get(boost::vertex_index, m_graph)))
-                .vertex_index_map(boost::get(boost::vertex_index, m_graph))
-                .distance_compare(std::less<uint32>())
-                .distance_combine(boost::closed_plus<uint32>())
-                .distance_inf(std::numeric_limits<uint32>::max())
-                .distance_zero(0)
-                .visitor(boost::dijkstra_visitor<boost::null_visitor>())
-                .weight_map(boost::make_transform_value_property_map(
-                    [player](EdgeCost const& edgeCost) { return edgeCost.EvaluateDistance(player); },
-                    boost::get(boost::edge_weight, m_graph))));
-
-            // found a path to the goal
-            for (vertex_descriptor v = *toVertexId; ; v = p[v])
+            if (m_useRouteTables)
+                GetRouteFromTable(*fromVertexId, *toVertexId, player, shortestPath);
+            else
             {
-                shortestPath.push_back(GetNodeIDFromVertexID(v));
-                if (v == p[v])
-                    break;
+                std::vector<vertex_descriptor> p;
+                FindShortestPaths(*fromVertexId, p, [player](EdgeCost const& edgeCost)
+                {
+                    return edgeCost.EvaluateDistance(player->GetTeam(), [player](TaxiNodesEntry const* node)
+                    {
+                        return ConditionMgr::IsPlayerMeetingCondition(player, node->ConditionID);
+                    });
+                });
+                BuildRoute(*toVertexId, p, shortestPath);
             }
-
-            std::reverse(shortestPath.begin(), shortestPath.end());
         }
     }
 
@@ -36,7 +36,7 @@
 #include <G3D/Vector3.h>
 #include <sstream>
 
-void TransportBase::UpdatePassengerPosition(Map* map, WorldObject* passenger, float x, float y, float z, float o, bool setHomePosition)
+void TransportBase::UpdatePassengerPosition(Map* map, WorldObject* passenger, float x, float y, float z, float o, PassengerTransform const* homeTransform)
 {
     // transport teleported but passenger not yet (can happen for players)
     if (passenger->GetMap() != map)
@@ -50,10 +50,10 @@ void TransportBase::UpdatePassengerPosition(Map* map, WorldObject* passenger, fl
         {
             Creature* creature = passenger->ToCreature();
             map->CreatureRelocation(creature, x, y, z, o, false);
-            if (setHomePosition)
+            if (homeTransform)
             {
                 creature->GetTransportHomePosition(x, y, z, o);
-                CalculatePassengerPosition(x, y, z, &o);
+                homeTransform->Apply(x, y, z, &o);
                 creature->SetHomePosition(x, y, z, o);
             }
             break;
@@ -542,7 +542,8 @@ void Transport::UpdatePosition(float x, float y, float z, float o)
     m_stationaryPosition.SetOrientation(o);
     UpdateModelPosition();
 
-    UpdatePassengerPositions(_passengers);
+    PassengerTransform const transform(GetPositionX(), GetPositionY(), GetPositionZ(), GetTransportOrientation());
+    UpdatePassengerPositions(GetMap(), _passengers, transform);
 
     /* There are four possible scenarios that trigger loading/unloading passengers:
       1. transport moves from inactive to active grid
@@ -555,7 +556,7 @@ void Transport::UpdatePosition(float x, float y, float z, float o)
     else if (!_staticPassengers.empty() && !newActive && oldCell.DiffGrid(Cell(GetPositionX(), GetPositionY()))) // 3.
         UnloadStaticPassengers();
     else
-        UpdatePassengerPositions(_staticPassengers);
+        UpdatePassengerPositions(GetMap(), _staticPassengers, transform);
     // 4. is handed by grid unload
 }
 
@@ -702,26 +703,17 @@ void Transport::TeleportPassengersAndHideTransport(uint32 newMapid)
     }
 }
 
-void Transport::UpdatePassengerPositions(PassengerSet const& passengers)
-{
-    for (WorldObject* passenger : passengers)
-    {
-        float x, y, z, o;
-        passenger->m_movementInfo.transport.pos.GetPosition(x, y, z, o);
-        CalculatePassengerPosition(x, y, z, &o);
-        UpdatePassengerPosition(GetMap(), passenger, x, y, z, o, true);
-    }
-}
-
 void Transport::BuildUpdate(UpdateDataMapType& data_map)
 {
     Map::PlayerList const& players = GetMap()->GetPlayers();
     if (players.isEmpty())
         return;
 
+    ValuesUpdateCache valuesCache;
+    ValuesUpdateCache* valuesCachePtr = HasViewerDependentChangedValues() ? nullptr : &valuesCache;
     for (MapReference const& playerReference : players)
         if (playerReference.GetSource()->InSamePhase(this))
-            BuildFieldsUpdate(playerReference.GetSource(), data_map);
+            BuildFieldsUpdate(playerReference.GetSource(), data_map, valuesCachePtr);
 
     ClearUpdateMask(true);
 }
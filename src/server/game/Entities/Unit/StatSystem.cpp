@@ -194,6 +194,20 @@ void Player::UpdateSpellDamageAndHealingBonus()
     }
 }
 
+void Player::ApplyPendingStatUpdates()
+{
+    Unit::ApplyPendingStatUpdates();
+
+    for (uint32 cr = 0; cr < MAX_COMBAT_RATING && m_pendingRatingUpdates; ++cr)
+    {
+        if (!(m_pendingRatingUpdates & (1u << cr)))
+            continue;
+
+        m_pendingRatingUpdates &= ~(1u << cr);
+        UpdateRating(CombatRating(cr));
+    }
+}
+
 bool Player::UpdateAllStats()
 {
     for (uint8 i = STAT_STRENGTH; i < MAX_STATS; ++i)
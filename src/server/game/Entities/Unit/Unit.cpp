@@ -72,6 +72,7 @@
 #include "QuestDef.h"
 #include "Spell.h"
 #include "ScheduledChangeAI.h"
+#include "ScriptProfiler.h"
 #include "SpellAuraEffects.h"
 #include "SpellAuras.h"
 #include "SpellHistory.h"
@@ -308,7 +309,7 @@ SpellNonMeleeDamage::SpellNonMeleeDamage(Unit* _attacker, Unit* _target, SpellIn
 Unit::Unit(bool isWorldObject) :
     WorldObject(isWorldObject), m_lastSanctuaryTime(0), LastCharmerGUID(), movespline(std::make_unique<Movement::MoveSpline>()),
     m_ControlledByPlayer(false), m_procDeep(0), m_procChainLength(0), m_transformSpell(0),
-    m_removedAurasCount(0), m_interruptMask(SpellAuraInterruptFlags::None), m_interruptMask2(SpellAuraInterruptFlags2::None),
+    m_areaAuraTargetCandidates(nullptr), m_removedAurasCount(0), m_interruptMask(SpellAuraInterruptFlags::None), m_interruptMask2(SpellAuraInterruptFlags2::None),
     m_unitMovedByMe(nullptr), m_playerMovingMe(nullptr), m_charmer(nullptr), m_charmed(nullptr),
     i_motionMaster(std::make_unique<MotionMaster>(this)), m_regenTimer(0), m_vehicle(nullptr),
     m_unitTypeMask(UNIT_MASK_NONE), m_Diminishing(), m_combatManager(this),
@@ -336,6 +337,7 @@ Unit::Unit(bool isWorldObject) :
     m_auraUpdateIterator = m_ownedAuras.end();
 
     m_canModifyStats = false;
+    m_statUpdateBatchDepth = 0;
 
     for (uint8 i = 0; i < UNIT_MOD_END; ++i)
     {
@@ -2884,6 +2886,9 @@ void Unit::_UpdateSpells(uint32 time)
         }
     }
 
+    AreaAuraTargetCandidates areaAuraTargetCandidates;
+    m_areaAuraTargetCandidates = &areaAuraTargetCandidates;
+
     // m_auraUpdateIterator can be updated in indirect called code at aura remove to skip next planned to update but removed auras
     for (m_auraUpdateIterator = m_ownedAuras.begin(); m_auraUpdateIterator != m_ownedAuras.end();)
     {
@@ -2892,6 +2897,8 @@ void Unit::_UpdateSpells(uint32 time)
         i_aura->UpdateOwner(time, this);
     }
 
+    m_areaAuraTargetCandidates = nullptr;
+
     // remove expired auras - do that after updates(used in scripts?)
     for (AuraMap::iterator i = m_ownedAuras.begin(); i != m_ownedAuras.end();)
     {
@@ -3402,6 +3409,13 @@ AuraApplication* Unit::_CreateAuraApplication(Aura* aura, uint32 effMask)
     AuraApplication * aurApp = new AuraApplication(this, caster, aura, effMask);
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
 
+    // only auras with spell proc entry can trigger proc
+    if (SpellProcEntry const* procEntry = sSpellMgr->GetSpellProcEntry(aurSpellInfo))
+    {
+        bool checkOnEveryEvent = aurSpellInfo->HasAttribute(SPELL_ATTR0_PROC_FAILURE_BURNS_CHARGE) || aurSpellInfo->HasAttribute(SPELL_ATTR2_PROC_COOLDOWN_ON_FAILURE);
+        m_procAuraApplications.emplace(aurId, ProcAuraApplication{ aurApp, procEntry->ProcFlags, checkOnEveryEvent });
+    }
+
     if (aurSpellInfo->HasAnyAuraInterruptFlag())
     {
         m_interruptableAuras.push_front(aurApp);
@@ -3503,6 +3517,15 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMo
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
 
+    for (auto [itr, end] = m_procAuraApplications.equal_range(aura->GetId()); itr != end; ++itr)
+    {
+        if (itr->second.Application == aurApp)
+        {
+            m_procAuraApplications.erase(itr);
+            break;
+        }
+    }
+
     if (aura->GetSpellInfo()->HasAnyAuraInterruptFlag())
     {
         Trinity::Containers::Lists::RemoveUnique(m_interruptableAuras, aurApp);
@@ -3619,6 +3642,8 @@ void Unit::_RemoveNoStackAurasDueToAura(Aura* aura, bool owned)
 
 void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
 {
+    InvalidateAuraModifierCache(aurEff->GetAuraType());
+
     if (apply)
     {
         m_modAuras[aurEff->GetAuraType()].push_front(aurEff);
@@ -4954,43 +4979,96 @@ int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType, std::function<bool(Aur
     return modifier;
 }
 
+template <typename T, typename Calculator>
+T Unit::GetCachedAuraModifier(AuraType auraType, AuraModifierQuery query, AuraModifierFilter filter, int32 misc, Calculator calculator) const
+{
+    // nothing to aggregate, don't keep cache entries for types that are not applied
+    if (m_modAuras[auraType].empty())
+        return calculator();
+
+    std::vector<CachedAuraModifier>& cachedModifiers = m_auraModifierCache[auraType];
+    for (CachedAuraModifier const& cached : cachedModifiers)
+    {
+        if (cached.Query != query || cached.Filter != filter || cached.Misc != misc)
+            continue;
+
+        if constexpr (std::is_same_v<T, float>)
+            return cached.Multiplier;
+        else
+            return cached.Modifier;
+    }
+
+    T value = calculator();
+
+    CachedAuraModifier& cached = cachedModifiers.emplace_back();
+    cached.Query = query;
+    cached.Filter = filter;
+    cached.Misc = misc;
+    cached.Modifier = 0;
+    cached.Multiplier = 1.0f;
+    if constexpr (std::is_same_v<T, float>)
+        cached.Multiplier = value;
+    else
+        cached.Modifier = value;
+
+    return value;
+}
+
 int32 Unit::GetTotalAuraModifier(AuraType auraType) const
 {
-    return GetTotalAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetCachedAuraModifier<int32>(auraType, AuraModifierQuery::TotalModifier, AuraModifierFilter::None, 0, [&]
+    {
+        return GetTotalAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    });
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auraType) const
 {
-    return GetTotalAuraMultiplier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetCachedAuraModifier<float>(auraType, AuraModifierQuery::TotalMultiplier, AuraModifierFilter::None, 0, [&]
+    {
+        return GetTotalAuraMultiplier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    });
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auraType) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetCachedAuraModifier<int32>(auraType, AuraModifierQuery::MaxPositiveModifier, AuraModifierFilter::None, 0, [&]
+    {
+        return GetMaxPositiveAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    });
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auraType) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    return GetCachedAuraModifier<int32>(auraType, AuraModifierQuery::MaxNegativeModifier, AuraModifierFilter::None, 0, [&]
+    {
+        return GetMaxNegativeAuraModifier(auraType, [](AuraEffect const* /*aurEff*/) { return true; });
+    });
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetTotalAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<int32>(auraType, AuraModifierQuery::TotalModifier, AuraModifierFilter::MiscMask, int32(miscMask), [&]
     {
-        if ((aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
+        return GetTotalAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+        {
+            if ((aurEff->GetMiscValue() & miscMask) != 0)
+                return true;
+            return false;
+        });
     });
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetTotalAuraMultiplier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<float>(auraType, AuraModifierQuery::TotalMultiplier, AuraModifierFilter::MiscMask, int32(miscMask), [&]
     {
-        if ((aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
+        return GetTotalAuraMultiplier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+        {
+            if ((aurEff->GetMiscValue() & miscMask) != 0)
+                return true;
+            return false;
+        });
     });
 }
 
@@ -5006,51 +5084,66 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auraType, uint32 miscM
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auraType, uint32 miscMask) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<int32>(auraType, AuraModifierQuery::MaxNegativeModifier, AuraModifierFilter::MiscMask, int32(miscMask), [&]
     {
-        if ((aurEff->GetMiscValue() & miscMask) != 0)
-            return true;
-        return false;
+        return GetMaxNegativeAuraModifier(auraType, [miscMask](AuraEffect const* aurEff) -> bool
+        {
+            if ((aurEff->GetMiscValue() & miscMask) != 0)
+                return true;
+            return false;
+        });
     });
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetTotalAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<int32>(auraType, AuraModifierQuery::TotalModifier, AuraModifierFilter::MiscValue, int32(miscValue), [&]
     {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
+        return GetTotalAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+        {
+            if (aurEff->GetMiscValue() == miscValue)
+                return true;
+            return false;
+        });
     });
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetTotalAuraMultiplier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<float>(auraType, AuraModifierQuery::TotalMultiplier, AuraModifierFilter::MiscValue, int32(miscValue), [&]
     {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
+        return GetTotalAuraMultiplier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+        {
+            if (aurEff->GetMiscValue() == miscValue)
+                return true;
+            return false;
+        });
     });
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetMaxPositiveAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<int32>(auraType, AuraModifierQuery::MaxPositiveModifier, AuraModifierFilter::MiscValue, int32(miscValue), [&]
     {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
+        return GetMaxPositiveAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+        {
+            if (aurEff->GetMiscValue() == miscValue)
+                return true;
+            return false;
+        });
     });
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auraType, int32 miscValue) const
 {
-    return GetMaxNegativeAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+    return GetCachedAuraModifier<int32>(auraType, AuraModifierQuery::MaxNegativeModifier, AuraModifierFilter::MiscValue, int32(miscValue), [&]
     {
-        if (aurEff->GetMiscValue() == miscValue)
-            return true;
-        return false;
+        return GetMaxNegativeAuraModifier(auraType, [miscValue](AuraEffect const* aurEff) -> bool
+        {
+            if (aurEff->GetMiscValue() == miscValue)
+                return true;
+            return false;
+        });
     });
 }
 
@@ -9144,11 +9237,39 @@ float Unit::GetPctModifierValue(UnitMods unitMod, UnitModifierPctType modifierTy
     return m_auraPctModifiersGroup[unitMod][modifierType];
 }
 
+void Unit::EndStatUpdateBatch()
+{
+    ASSERT(m_statUpdateBatchDepth);
+    if (--m_statUpdateBatchDepth)
+        return;
+
+    ApplyPendingStatUpdates();
+}
+
+void Unit::ApplyPendingStatUpdates()
+{
+    // UnitMods are ordered so that stats are recalculated before health, power, attack power and damage derived from them
+    for (uint32 i = 0; i < UNIT_MOD_END && m_pendingUnitModUpdates.any(); ++i)
+    {
+        if (!m_pendingUnitModUpdates.test(i))
+            continue;
+
+        m_pendingUnitModUpdates.reset(i);
+        UpdateUnitMod(UnitMods(i));
+    }
+}
+
 void Unit::UpdateUnitMod(UnitMods unitMod)
 {
     if (!CanModifyStats())
         return;
 
+    if (IsStatUpdateBatched())
+    {
+        m_pendingUnitModUpdates.set(unitMod);
+        return;
+    }
+
     switch (unitMod)
     {
         case UNIT_MOD_STAT_STRENGTH:
@@ -9621,6 +9742,23 @@ void Unit::AIUpdateTick(uint32 diff)
 {
     if (UnitAI* ai = GetAI())
     {
+        ScriptProfiler::ScopedCall profileCall(ScriptProfileHook::UnitAI, GetMapId(), [this]() -> std::string
+        {
+            Creature const* creature = ToCreature();
+            if (!creature)
+                return "PlayerAI";
+
+            std::string scriptName = creature->GetScriptName();
+            if (!scriptName.empty())
+                return scriptName;
+
+            // database selected AIs (SmartAI) are reported per creature entry
+            if (!creature->GetAIName().empty())
+                return Trinity::StringFormat("{} {}", creature->GetAIName(), creature->GetEntry());
+
+            return "default";
+        });
+
         m_aiLocked = true;
         ai->UpdateAI(diff);
         m_aiLocked = false;
@@ -10021,11 +10159,12 @@ void Unit::GetProcAurasTriggeredOnEvent(AuraApplicationProcContainer& aurasTrigg
             processAuraApplication(aurApp);
         }
     }
-    // or generate one on our own
+    // or generate one on our own, skipping auras whose proc flags can never match this event
     else
     {
-        for (AuraApplicationMap::iterator itr = GetAppliedAuras().begin(); itr != GetAppliedAuras().end(); ++itr)
-            processAuraApplication(itr->second);
+        for (auto const& [spellId, procAuraApplication] : m_procAuraApplications)
+            if (procAuraApplication.CheckOnEveryEvent || (eventInfo.GetTypeMask() & procAuraApplication.ProcFlags))
+                processAuraApplication(procAuraApplication.Application);
     }
 }
 
@@ -13480,6 +13619,25 @@ void Unit::BuildValuesUpdate(ByteBuffer* data, Player const* target) const
     data->put<uint32>(sizePos, data->wpos() - sizePos - 4);
 }
 
+bool Unit::HasViewerDependentChangedValues() const
+{
+    if (WorldObject::HasViewerDependentChangedValues())
+        return true;
+
+    if (!m_values.HasChanged(TYPEID_UNIT))
+        return false;
+
+    return m_unitData->IsChanged(&UF::UnitData::DisplayID)
+        || m_unitData->IsChanged(&UF::UnitData::NpcFlags)
+        || m_unitData->IsChanged(&UF::UnitData::FactionTemplate)
+        || m_unitData->IsChanged(&UF::UnitData::Flags)
+        || m_unitData->IsChanged(&UF::UnitData::Flags2)
+        || m_unitData->IsChanged(&UF::UnitData::Flags3)
+        || m_unitData->IsChanged(&UF::UnitData::AuraState)
+        || m_unitData->IsChanged(&UF::UnitData::PvpFlags)
+        || m_unitData->IsChanged(&UF::UnitData::InteractSpellID);
+}
+
 void Unit::BuildValuesUpdateWithFlag(ByteBuffer* data, UF::UpdateFieldFlag flags, Player const* target) const
 {
     UpdateMask<NUM_CLIENT_OBJECT_TYPES> valuesMask;
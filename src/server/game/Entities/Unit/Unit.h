@@ -22,11 +22,13 @@
 #include "CombatManager.h"
 #include "FlatSet.h"
 #include "SpellAuraDefines.h"
+#include "ThreadLocalPool.h"
 #include "ThreatManager.h"
 #include "Timer.h"
 #include "UnitDefines.h"
 #include "Util.h"
 #include <array>
+#include <bitset>
 #include <forward_list>
 #include <map>
 #include <memory>
@@ -631,11 +633,12 @@ class TC_GAME_API Unit : public WorldObject
         typedef std::set<Unit*> ControlList;
         typedef std::vector<Unit*> UnitVector;
 
-        typedef std::multimap<uint32, Aura*> AuraMap;
+        // aura maps insert and erase a node for every aura applied, nodes are recycled per thread instead of going through the heap
+        typedef std::multimap<uint32, Aura*, std::less<uint32>, Trinity::ThreadLocalPoolAllocator<std::pair<uint32 const, Aura*>>> AuraMap;
         typedef std::pair<AuraMap::const_iterator, AuraMap::const_iterator> AuraMapBounds;
         typedef std::pair<AuraMap::iterator, AuraMap::iterator> AuraMapBoundsNonConst;
 
-        typedef std::multimap<uint32,  AuraApplication*> AuraApplicationMap;
+        typedef std::multimap<uint32, AuraApplication*, std::less<uint32>, Trinity::ThreadLocalPoolAllocator<std::pair<uint32 const, AuraApplication*>>> AuraApplicationMap;
         typedef std::pair<AuraApplicationMap::const_iterator, AuraApplicationMap::const_iterator> AuraApplicationMapBounds;
         typedef std::pair<AuraApplicationMap::iterator, AuraApplicationMap::iterator> AuraApplicationMapBoundsNonConst;
 
@@ -1269,6 +1272,17 @@ class TC_GAME_API Unit : public WorldObject
         AuraMap      & GetOwnedAuras()       { return m_ownedAuras; }
         AuraMap const& GetOwnedAuras() const { return m_ownedAuras; }
 
+        // objects around this unit gathered by the first area aura target search of an owned aura update pass
+        // and reused by the other area auras updating their targets in the same pass, nullptr outside of _UpdateSpells
+        struct AreaAuraTargetCandidates
+        {
+            Position Center;
+            float Radius = -1.0f;
+            uint32 TypeMask = 0;
+            std::vector<std::pair<WorldObject*, uint32 /*gridMapTypeMask*/>> Objects;
+        };
+        AreaAuraTargetCandidates* GetAreaAuraTargetCandidates() { return m_areaAuraTargetCandidates; }
+
         void RemoveOwnedAura(AuraMap::iterator& i, AuraRemoveMode removeMode = AURA_REMOVE_BY_DEFAULT);
         void RemoveOwnedAura(uint32 spellId, ObjectGuid casterGUID = ObjectGuid::Empty, uint32 reqEffMask = 0, AuraRemoveMode removeMode = AURA_REMOVE_BY_DEFAULT);
         void RemoveOwnedAura(Aura* aura, AuraRemoveMode removeMode = AURA_REMOVE_BY_DEFAULT);
@@ -1325,6 +1339,7 @@ class TC_GAME_API Unit : public WorldObject
 
         AuraEffectList const& GetAuraEffectsByType(AuraType type) const { return m_modAuras[type]; }
         AuraEffectList& GetAuraEffectsByType(AuraType type) { return m_modAuras[type]; }
+        void InvalidateAuraModifierCache(AuraType type) { m_auraModifierCache.erase(type); }
         AuraList      & GetSingleCastAuras()       { return m_scAuras; }
         AuraList const& GetSingleCastAuras() const { return m_scAuras; }
 
@@ -1511,10 +1526,15 @@ class TC_GAME_API Unit : public WorldObject
         Stats GetStatByAuraGroup(UnitMods unitMod) const;
         bool CanModifyStats() const { return m_canModifyStats; }
         void SetCanModifyStats(bool modifyStats) { m_canModifyStats = modifyStats; }
+        // UnitMod changes between these calls only mark the mod, each marked mod is recalculated once when the outermost batch ends
+        void BeginStatUpdateBatch() { ++m_statUpdateBatchDepth; }
+        void EndStatUpdateBatch();
+        bool IsStatUpdateBatched() const { return m_statUpdateBatchDepth != 0; }
         virtual bool UpdateStats(Stats stat) = 0;
         virtual bool UpdateAllStats() = 0;
         virtual void UpdateResistances(uint32 school);
         virtual void UpdateAllResistances();
+        virtual void ApplyPendingStatUpdates();
         virtual void UpdateArmor() = 0;
         virtual void UpdateMaxHealth() = 0;
         virtual void UpdateMaxPower(Powers power) = 0;
@@ -1830,6 +1850,7 @@ class TC_GAME_API Unit : public WorldObject
         void BuildValuesUpdate(ByteBuffer* data, Player const* target) const override;
 
     public:
+        bool HasViewerDependentChangedValues() const override;
         void BuildValuesUpdateWithFlag(ByteBuffer* data, UF::UpdateFieldFlag flags, Player const* target) const override;
         void BuildValuesUpdateForPlayerWithMask(UpdateData* data, UF::ObjectData::Mask const& requestedObjectMask,
             UF::UnitData::Mask const& requestedUnitMask, Player const* target) const;
@@ -1883,11 +1904,51 @@ class TC_GAME_API Unit : public WorldObject
 
         AuraMap m_ownedAuras;
         AuraApplicationMap m_appliedAuras;
+
+        struct ProcAuraApplication
+        {
+            AuraApplication* Application;
+            ProcFlagsInit ProcFlags;
+            bool CheckOnEveryEvent;                 // failed proc attempts can burn charges or start cooldown
+        };
+        std::multimap<uint32, ProcAuraApplication> m_procAuraApplications; // applied auras with spell proc entry, same order as m_appliedAuras
         AuraList m_removedAuras;
         AuraMap::iterator m_auraUpdateIterator;
+        AreaAuraTargetCandidates* m_areaAuraTargetCandidates;
         uint32 m_removedAurasCount;
 
         std::array<AuraEffectList, TOTAL_AURAS> m_modAuras;
+
+        enum class AuraModifierQuery : uint8
+        {
+            TotalModifier,
+            TotalMultiplier,
+            MaxPositiveModifier,
+            MaxNegativeModifier
+        };
+
+        enum class AuraModifierFilter : uint8
+        {
+            None,
+            MiscMask,
+            MiscValue
+        };
+
+        struct CachedAuraModifier
+        {
+            AuraModifierQuery Query;
+            AuraModifierFilter Filter;
+            int32 Misc;
+            int32 Modifier;
+            float Multiplier;
+        };
+
+        // results of aura modifier queries without custom predicates, dropped per type when its effect list or any amount in it changes
+        mutable std::unordered_map<AuraType, std::vector<CachedAuraModifier>> m_auraModifierCache;
+
+        template <typename T, typename Calculator>
+        T GetCachedAuraModifier(AuraType auraType, AuraModifierQuery query, AuraModifierFilter filter, int32 misc, Calculator calculator) const;
+
         AuraList m_scAuras;                        // cast singlecast auras
         AuraApplicationList m_interruptableAuras;  // auras which have interrupt mask applied on unit
         AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
@@ -1898,6 +1959,8 @@ class TC_GAME_API Unit : public WorldObject
         float m_auraPctModifiersGroup[UNIT_MOD_END][MODIFIER_TYPE_PCT_END];
         float m_weaponDamage[MAX_ATTACK][2];
         bool m_canModifyStats;
+        uint32 m_statUpdateBatchDepth;
+        std::bitset<UNIT_MOD_END> m_pendingUnitModUpdates;
 
         VisibleAuraContainer m_visibleAuras;
         Trinity::Containers::FlatSet<AuraApplication*, VisibleAuraSlotCompare> m_visibleAurasToUpdate;
@@ -559,6 +559,7 @@ void Vehicle::RelocatePassengers()
     seatRelocation.reserve(Seats.size());
 
     // not sure that absolute position calculation is correct, it must depend on vehicle pitch angle
+    PassengerTransform const transform(GetBase()->GetPositionX(), GetBase()->GetPositionY(), GetBase()->GetPositionZ(), GetBase()->GetOrientation());
     for (SeatMap::const_iterator itr = Seats.begin(); itr != Seats.end(); ++itr)
     {
         if (Unit* passenger = ObjectAccessor::GetUnit(*GetBase(), itr->second.Passenger.Guid))
@@ -567,14 +568,14 @@ void Vehicle::RelocatePassengers()
 
             float px, py, pz, po;
             passenger->m_movementInfo.transport.pos.GetPosition(px, py, pz, po);
-            CalculatePassengerPosition(px, py, pz, &po);
+            transform.Apply(px, py, pz, &po);
 
             seatRelocation.emplace_back(passenger, Position(px, py, pz, po));
         }
     }
 
     for (auto const& [passenger, position] : seatRelocation)
-        UpdatePassengerPosition(_me->GetMap(), passenger, position.GetPositionX(), position.GetPositionY(), position.GetPositionZ(), position.GetOrientation(), false);
+        UpdatePassengerPosition(_me->GetMap(), passenger, position.GetPositionX(), position.GetPositionY(), position.GetPositionZ(), position.GetOrientation(), nullptr);
 }
 
 /**
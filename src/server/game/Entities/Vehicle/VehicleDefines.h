@@ -171,17 +171,47 @@ public:
 
     virtual TransportBase* RemovePassenger(WorldObject* passenger) = 0;
 
-    void UpdatePassengerPosition(Map* map, WorldObject* passenger, float x, float y, float z, float o, bool setHomePosition);
+    /// Transforms offsets into global coordinates for one transport position
+    /// Computes the rotation once, to be reused for all passengers moved together
+    struct PassengerTransform
+    {
+        PassengerTransform(float transX, float transY, float transZ, float transO)
+            : X(transX), Y(transY), Z(transZ), O(transO), Cos(std::cos(transO)), Sin(std::sin(transO)) { }
+
+        void Apply(float& x, float& y, float& z, float* o) const
+        {
+            float inx = x, iny = y, inz = z;
+            if (o)
+                *o = Position::NormalizeOrientation(O + *o);
+
+            x = X + inx * Cos - iny * Sin;
+            y = Y + iny * Cos + inx * Sin;
+            z = Z + inz;
+        }
+
+        float X, Y, Z, O;
+        float Cos, Sin;
+    };
+
+    /// Moves a passenger to global coordinates x, y, z, o, creature home positions are moved as well when homeTransform is set
+    void UpdatePassengerPosition(Map* map, WorldObject* passenger, float x, float y, float z, float o, PassengerTransform const* homeTransform);
+
+    /// Moves all passengers to their offsets transformed by transform, together with creature home positions
+    template<typename PassengerContainer>
+    void UpdatePassengerPositions(Map* map, PassengerContainer const& passengers, PassengerTransform const& transform)
+    {
+        for (auto* passenger : passengers)
+        {
+            float x, y, z, o;
+            passenger->m_movementInfo.transport.pos.GetPosition(x, y, z, o);
+            transform.Apply(x, y, z, &o);
+            UpdatePassengerPosition(map, passenger, x, y, z, o, &transform);
+        }
+    }
 
     static void CalculatePassengerPosition(float& x, float& y, float& z, float* o, float transX, float transY, float transZ, float transO)
     {
-        float inx = x, iny = y, inz = z;
-        if (o)
-            *o = Position::NormalizeOrientation(transO + *o);
-
-        x = transX + inx * std::cos(transO) - iny * std::sin(transO);
-        y = transY + iny * std::cos(transO) + inx * std::sin(transO);
-        z = transZ + inz;
+        PassengerTransform(transX, transY, transZ, transO).Apply(x, y, z, o);
     }
 
     static void CalculatePassengerOffset(float& x, float& y, float& z, float* o, float transX, float transY, float transZ, float transO)
@@ -1164,96 +1164,58 @@ void GameEventMgr::GameEventSpawn(int16 event_id)
 {
     int32 internal_event_id = mGameEvent.size() + event_id - 1;
 
-    if (internal_event_id < 0 || internal_event_id >= int32(mGameEventCreatureGuids.size()))
+    if (internal_event_id < 0 || internal_event_id >= int32(mGameEventCreatureGuids.size())
+        || internal_event_id >= int32(mGameEventGameobjectGuids.size()) || internal_event_id >= int32(mGameEventPoolIds.size()))
     {
-        TC_LOG_ERROR("gameevent", "GameEventMgr::GameEventSpawn attempted access to out of range mGameEventCreatureGuids element {} (size: {}).",
-            internal_event_id, mGameEventCreatureGuids.size());
+        TC_LOG_ERROR("gameevent", "GameEventMgr::GameEventSpawn attempted access to out of range event spawn element {} (sizes: {}, {}, {}).",
+            internal_event_id, mGameEventCreatureGuids.size(), mGameEventGameobjectGuids.size(), mGameEventPoolIds.size());
         return;
     }
 
+    // the spawns themselves are created by each map during its own update
+    ChangesByMapId changesByMap;
+
     for (GuidList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin(); itr != mGameEventCreatureGuids[internal_event_id].end(); ++itr)
     {
         // Add to correct cell
         if (CreatureData const* data = sObjectMgr->GetCreatureData(*itr))
         {
             sObjectMgr->AddCreatureToGrid(data);
-
-            // Spawn if necessary (loaded grids only)
-            sMapMgr->DoForAllMapsWithMapId(data->mapId, [&itr, data](Map* map)
-            {
-                map->RemoveRespawnTime(SPAWN_TYPE_CREATURE, *itr);
-                // We use spawn coords to spawn
-                if (map->IsGridLoaded(data->spawnPoint))
-                    Creature::CreateCreatureFromDB(*itr, map);
-            });
+            changesByMap[data->mapId].push_back({ GameEventMapAction::SpawnCreature, *itr });
         }
     }
 
-    if (internal_event_id >= int32(mGameEventGameobjectGuids.size()))
-    {
-        TC_LOG_ERROR("gameevent", "GameEventMgr::GameEventSpawn attempted access to out of range mGameEventGameobjectGuids element {} (size: {}).",
-            internal_event_id, mGameEventGameobjectGuids.size());
-        return;
-    }
-
     for (GuidList::iterator itr = mGameEventGameobjectGuids[internal_event_id].begin(); itr != mGameEventGameobjectGuids[internal_event_id].end(); ++itr)
     {
         // Add to correct cell
         if (GameObjectData const* data = sObjectMgr->GetGameObjectData(*itr))
         {
             sObjectMgr->AddGameobjectToGrid(data);
-            // Spawn if necessary (loaded grids only)
-            // this base map checked as non-instanced and then only existed
-            sMapMgr->DoForAllMapsWithMapId(data->mapId, [&itr, data](Map* map)
-            {
-                map->RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, *itr);
-                // We use current coords to unspawn, not spawn coords since creature can have changed grid
-                if (map->IsGridLoaded(data->spawnPoint))
-                {
-                    if (GameObject* go = GameObject::CreateGameObjectFromDB(*itr, map, false))
-                    {
-                        /// @todo find out when it is add to map
-                        if (go->isSpawnedByDefault())
-                        {
-                            if (!map->AddToMap(go))
-                                delete go;
-                        }
-                    }
-                }
-            });
+            changesByMap[data->mapId].push_back({ GameEventMapAction::SpawnGameObject, *itr });
         }
     }
 
-    if (internal_event_id >= int32(mGameEventPoolIds.size()))
-    {
-        TC_LOG_ERROR("gameevent", "GameEventMgr::GameEventSpawn attempted access to out of range mGameEventPoolIds element {} (size: {}).",
-            internal_event_id, mGameEventPoolIds.size());
-        return;
-    }
-
     for (IdList::iterator itr = mGameEventPoolIds[internal_event_id].begin(); itr != mGameEventPoolIds[internal_event_id].end(); ++itr)
-    {
         if (PoolTemplateData const* poolTemplate = sPoolMgr->GetPoolTemplate(*itr))
-        {
-            sMapMgr->DoForAllMapsWithMapId(poolTemplate->MapId, [&itr](Map* map)
-            {
-                sPoolMgr->SpawnPool(map->GetPoolData(), *itr);
-            });
-        }
-    }
+            changesByMap[poolTemplate->MapId].push_back({ GameEventMapAction::SpawnPool, *itr });
+
+    SendMapChanges(changesByMap);
 }
 
 void GameEventMgr::GameEventUnspawn(int16 event_id)
 {
     int32 internal_event_id = mGameEvent.size() + event_id - 1;
 
-    if (internal_event_id < 0 || internal_event_id >= int32(mGameEventCreatureGuids.size()))
+    if (internal_event_id < 0 || internal_event_id >= int32(mGameEventCreatureGuids.size())
+        || internal_event_id >= int32(mGameEventGameobjectGuids.size()) || internal_event_id >= int32(mGameEventPoolIds.size()))
     {
-        TC_LOG_ERROR("gameevent", "GameEventMgr::GameEventUnspawn attempted access to out of range mGameEventCreatureGuids element {} (size: {}).",
-            internal_event_id, mGameEventCreatureGuids.size());
+        TC_LOG_ERROR("gameevent", "GameEventMgr::GameEventUnspawn attempted access to out of range event spawn element {} (sizes: {}, {}, {}).",
+            internal_event_id, mGameEventCreatureGuids.size(), mGameEventGameobjectGuids.size(), mGameEventPoolIds.size());
         return;
     }
 
+    ChangesByMapId changesByMap;
+
     for (GuidList::iterator itr = mGameEventCreatureGuids[internal_event_id].begin(); itr != mGameEventCreatureGuids[internal_event_id].end(); ++itr)
     {
         // check if it's needed by another event, if so, don't remove
@@ -1263,28 +1225,10 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         if (CreatureData const* data = sObjectMgr->GetCreatureData(*itr))
         {
             sObjectMgr->RemoveCreatureFromGrid(data);
-
-            sMapMgr->DoForAllMapsWithMapId(data->mapId, [&itr](Map* map)
-            {
-                map->RemoveRespawnTime(SPAWN_TYPE_CREATURE, *itr);
-                auto creatureBounds = map->GetCreatureBySpawnIdStore().equal_range(*itr);
-                for (auto itr2 = creatureBounds.first; itr2 != creatureBounds.second;)
-                {
-                    Creature* creature = itr2->second;
-                    ++itr2;
-                    creature->AddObjectToRemoveList();
-                }
-            });
+            changesByMap[data->mapId].push_back({ GameEventMapAction::DespawnCreature, *itr });
         }
     }
 
-    if (internal_event_id < 0 || internal_event_id >= int32(mGameEventGameobjectGuids.size()))
-    {
-        TC_LOG_ERROR("gameevent", "GameEventMgr::GameEventUnspawn attempted access to out of range mGameEventGameobjectGuids element {} (size: {}).",
-            internal_event_id, mGameEventGameobjectGuids.size());
-        return;
-    }
-
     for (GuidList::iterator itr = mGameEventGameobjectGuids[internal_event_id].begin(); itr != mGameEventGameobjectGuids[internal_event_id].end(); ++itr)
     {
         // check if it's needed by another event, if so, don't remove
@@ -1294,36 +1238,25 @@ void GameEventMgr::GameEventUnspawn(int16 event_id)
         if (GameObjectData const* data = sObjectMgr->GetGameObjectData(*itr))
         {
             sObjectMgr->RemoveGameobjectFromGrid(data);
-
-            sMapMgr->DoForAllMapsWithMapId(data->mapId, [&itr](Map* map)
-            {
-                map->RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, *itr);
-                auto gameobjectBounds = map->GetGameObjectBySpawnIdStore().equal_range(*itr);
-                for (auto itr2 = gameobjectBounds.first; itr2 != gameobjectBounds.second;)
-                {
-                    GameObject* go = itr2->second;
-                    ++itr2;
-                    go->AddObjectToRemoveList();
-                }
-            });
+            changesByMap[data->mapId].push_back({ GameEventMapAction::DespawnGameObject, *itr });
         }
     }
 
-    if (internal_event_id < 0 || internal_event_id >= int32(mGameEventPoolIds.size()))
-    {
-        TC_LOG_ERROR("gameevent", "GameEventMgr::GameEventUnspawn attempted access to out of range mGameEventPoolIds element {} (size: {}).", internal_event_id, mGameEventPoolIds.size());
-        return;
-    }
-
     for (IdList::iterator itr = mGameEventPoolIds[internal_event_id].begin(); itr != mGameEventPoolIds[internal_event_id].end(); ++itr)
-    {
         if (PoolTemplateData const* poolTemplate = sPoolMgr->GetPoolTemplate(*itr))
+            changesByMap[poolTemplate->MapId].push_back({ GameEventMapAction::DespawnPool, *itr });
+
+    SendMapChanges(changesByMap);
+}
+
+void GameEventMgr::SendMapChanges(ChangesByMapId& changesByMap)
+{
+    for (auto& [mapId, changes] : changesByMap)
+    {
+        sMapMgr->DoForAllMapsWithMapId(mapId, [&changes](Map* map)
         {
-            sMapMgr->DoForAllMapsWithMapId(poolTemplate->MapId, [&itr](Map* map)
-            {
-                sPoolMgr->DespawnPool(map->GetPoolData(), *itr, true);
-            });
-        }
+            map->AddGameEventChanges(changes);
+        });
     }
 }
 
@@ -1620,22 +1553,33 @@ class GameEventAIHookWorker
 public:
     GameEventAIHookWorker(uint16 eventId, bool activate) : _eventId(eventId), _activate(activate) { }
 
-    void Visit(std::unordered_map<ObjectGuid, Creature*>& creatureMap)
+    // AI hooks can summon objects of the visited type, which invalidates the store iterators
+    void Visit(Trinity::Containers::FlatHashMap<ObjectGuid, Creature*>& creatureMap)
     {
+        std::vector<Creature*> creatures;
+        creatures.reserve(creatureMap.size());
         for (auto const& p : creatureMap)
-            if (p.second->IsInWorld() && p.second->IsAIEnabled())
-                p.second->AI()->OnGameEvent(_activate, _eventId);
+            creatures.push_back(p.second);
+
+        for (Creature* creature : creatures)
+            if (creature->IsInWorld() && creature->IsAIEnabled())
+                creature->AI()->OnGameEvent(_activate, _eventId);
     }
 
-    void Visit(std::unordered_map<ObjectGuid, GameObject*>& gameObjectMap)
+    void Visit(Trinity::Containers::FlatHashMap<ObjectGuid, GameObject*>& gameObjectMap)
     {
+        std::vector<GameObject*> gameObjects;
+        gameObjects.reserve(gameObjectMap.size());
         for (auto const& p : gameObjectMap)
-            if (p.second->IsInWorld())
-                p.second->AI()->OnGameEvent(_activate, _eventId);
+            gameObjects.push_back(p.second);
+
+        for (GameObject* gameObject : gameObjects)
+            if (gameObject->IsInWorld())
+                gameObject->AI()->OnGameEvent(_activate, _eventId);
     }
 
     template<class T>
-    void Visit(std::unordered_map<ObjectGuid, T*>&) { }
+    void Visit(Trinity::Containers::FlatHashMap<ObjectGuid, T*>&) { }
 
 private:
     uint16 _eventId;
@@ -1644,16 +1588,22 @@ private:
 
 void GameEventMgr::RunSmartAIScripts(uint16 event_id, bool activate)
 {
-    //! Iterate over every supported source type (creature and gameobject)
-    //! Not entirely sure how this will affect units in non-loaded grids.
+    // queued behind the spawn changes of the event so objects spawned by it are notified too
     sMapMgr->DoForAllMaps([event_id, activate](Map* map)
     {
-        GameEventAIHookWorker worker(event_id, activate);
-        TypeContainerVisitor<GameEventAIHookWorker, MapStoredObjectTypesContainer> visitor(worker);
-        visitor.Visit(map->GetObjectsStore());
+        map->AddGameEventChanges({ { activate ? GameEventMapAction::StartEventAI : GameEventMapAction::EndEventAI, event_id } });
     });
 }
 
+void GameEventMgr::RunSmartAIScriptsOnMap(Map* map, uint16 event_id, bool activate)
+{
+    //! Iterate over every supported source type (creature and gameobject)
+    //! Not entirely sure how this will affect units in non-loaded grids.
+    GameEventAIHookWorker worker(event_id, activate);
+    TypeContainerVisitor<GameEventAIHookWorker, MapStoredObjectTypesContainer> visitor(worker);
+    visitor.Visit(map->GetObjectsStore());
+}
+
 void GameEventMgr::SetHolidayEventTime(GameEventData& event)
 {
     if (!event.holidayStage) // Ignore holiday
@@ -86,8 +86,10 @@ struct ModelEquip
 };
 
 class Creature;
+class Map;
 class Player;
 class Quest;
+struct GameEventMapChange;
 struct VendorItem;
 
 class TC_GAME_API GameEventMgr
@@ -116,6 +118,7 @@ class TC_GAME_API GameEventMgr
         void StopEvent(uint16 event_id, bool overwrite = false);
         void HandleQuestComplete(uint32 quest_id);  // called on world event type quest completions
         uint64 GetNPCFlag(Creature* cr);
+        void RunSmartAIScriptsOnMap(Map* map, uint16 event_id, bool activate);   // called by the map while applying queued event changes
 
     private:
         void SendWorldStateUpdate(Player* player, uint16 event_id);
@@ -123,8 +126,10 @@ class TC_GAME_API GameEventMgr
         void RemoveActiveEvent(uint16 event_id) { m_ActiveEvents.erase(event_id); }
         void ApplyNewEvent(uint16 event_id);
         void UnApplyEvent(uint16 event_id);
+        typedef std::unordered_map<uint32 /*mapId*/, std::vector<GameEventMapChange>> ChangesByMapId;
         void GameEventSpawn(int16 event_id);
         void GameEventUnspawn(int16 event_id);
+        void SendMapChanges(ChangesByMapId& changesByMap);
         void ChangeEquipOrModel(int16 event_id, bool activate);
         void UpdateEventQuests(uint16 event_id, bool activate);
         void UpdateWorldStates(uint16 event_id, bool Activate);
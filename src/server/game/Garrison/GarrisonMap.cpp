@@ -45,6 +45,7 @@ private:
     NGridType* i_grid;
     GarrisonMap* i_map;
     Garrison* i_garrison;
+    std::vector<Garrison::Plot*> i_plots;
     uint32 i_gameObjects;
     uint32 i_creatures;
 };
@@ -53,6 +54,9 @@ void GarrisonGridLoader::LoadN()
 {
     if (i_garrison)
     {
+        // collected once for the whole grid instead of once for every visited cell
+        i_plots = i_garrison->GetPlots();
+
         i_cell.data.Part.cell_y = 0;
         for (uint32 x = 0; x < MAX_NUMBER_OF_CELLS; ++x)
         {
@@ -73,11 +77,10 @@ void GarrisonGridLoader::LoadN()
 
 void GarrisonGridLoader::Visit(GameObjectMapType& m)
 {
-    std::vector<Garrison::Plot*> plots = i_garrison->GetPlots();
-    if (!plots.empty())
+    if (!i_plots.empty())
     {
         CellCoord cellCoord = i_cell.GetCellCoord();
-        for (Garrison::Plot* plot : plots)
+        for (Garrison::Plot* plot : i_plots)
         {
             Position const& spawn = plot->PacketInfo.PlotPos.Pos;
             if (cellCoord != Trinity::ComputeCellCoord(spawn.GetPositionX(), spawn.GetPositionY()))
@@ -27,6 +27,7 @@
 #include "SpellMgr.h"
 #include "Timer.h"
 #include <cmath>
+#include <set>
 
 template <>
 struct std::hash<AreaTriggerId>
@@ -42,7 +43,7 @@ struct std::hash<AreaTriggerId>
 
 namespace
 {
-    typedef std::unordered_map<uint32/*cell_id*/, std::set<ObjectGuid::LowType>> AtCellObjectGuidsMap;
+    typedef std::unordered_map<uint32/*cell_id*/, Trinity::Containers::FlatSet<ObjectGuid::LowType>> AtCellObjectGuidsMap;
     typedef std::unordered_map<std::pair<uint32 /*mapId*/, Difficulty>, AtCellObjectGuidsMap> AtMapObjectGuids;
 
     AtMapObjectGuids _areaTriggerSpawnsByLocation;
@@ -428,7 +429,7 @@ AreaTriggerCreateProperties const* AreaTriggerDataStore::GetAreaTriggerCreatePro
     return Trinity::Containers::MapGetValuePtr(_areaTriggerCreateProperties, areaTriggerCreatePropertiesId);
 }
 
-std::set<ObjectGuid::LowType> const* AreaTriggerDataStore::GetAreaTriggersForMapAndCell(uint32 mapId, Difficulty difficulty, uint32 cellId) const
+Trinity::Containers::FlatSet<ObjectGuid::LowType> const* AreaTriggerDataStore::GetAreaTriggersForMapAndCell(uint32 mapId, Difficulty difficulty, uint32 cellId) const
 {
     if (auto* atForMapAndDifficulty = Trinity::Containers::MapGetValuePtr(_areaTriggerSpawnsByLocation, { mapId, difficulty }))
         return Trinity::Containers::MapGetValuePtr(*atForMapAndDifficulty, cellId);
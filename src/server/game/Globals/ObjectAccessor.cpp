@@ -26,9 +26,34 @@
 #include "ObjectMgr.h"
 #include "Pet.h"
 #include "Player.h"
+#include "ReadCopyUpdate.h"
 #include "Transport.h"
+#include <algorithm>
 #include <mutex>
 
+namespace
+{
+// copy of HashMapHolder container sorted by guid, lets Find run without touching the shared lock
+template<class T>
+using HashMapHolderSnapshot = std::vector<std::pair<ObjectGuid, T*>>;
+
+template<class T>
+Trinity::ReadCopyUpdate<HashMapHolderSnapshot<T>>& GetHashMapHolderSnapshot()
+{
+    static Trinity::ReadCopyUpdate<HashMapHolderSnapshot<T>> _snapshot;
+    return _snapshot;
+}
+
+template<class Snapshot>
+auto FindInSnapshot(Snapshot& snapshot, ObjectGuid const& guid)
+{
+    return std::lower_bound(snapshot.begin(), snapshot.end(), guid, [](typename Snapshot::value_type const& entry, ObjectGuid const& key)
+    {
+        return entry.first < key;
+    });
+}
+}
+
 template<class T>
 void HashMapHolder<T>::Insert(T* o)
 {
@@ -38,6 +63,15 @@ void HashMapHolder<T>::Insert(T* o)
     std::unique_lock<std::shared_mutex> lock(*GetLock());
 
     GetContainer()[o->GetGUID()] = o;
+
+    GetHashMapHolderSnapshot<T>().Update([o](HashMapHolderSnapshot<T>& snapshot)
+    {
+        auto itr = FindInSnapshot(snapshot, o->GetGUID());
+        if (itr != snapshot.end() && itr->first == o->GetGUID())
+            itr->second = o;
+        else
+            snapshot.emplace(itr, o->GetGUID(), o);
+    });
 }
 
 template<class T>
@@ -46,15 +80,23 @@ void HashMapHolder<T>::Remove(T* o)
     std::unique_lock<std::shared_mutex> lock(*GetLock());
 
     GetContainer().erase(o->GetGUID());
+
+    GetHashMapHolderSnapshot<T>().Update([o](HashMapHolderSnapshot<T>& snapshot)
+    {
+        auto itr = FindInSnapshot(snapshot, o->GetGUID());
+        if (itr != snapshot.end() && itr->first == o->GetGUID())
+            snapshot.erase(itr);
+    });
 }
 
 template<class T>
 T* HashMapHolder<T>::Find(ObjectGuid guid)
 {
-    std::shared_lock<std::shared_mutex> lock(*GetLock());
-
-    typename MapType::iterator itr = GetContainer().find(guid);
-    return (itr != GetContainer().end()) ? itr->second : nullptr;
+    return GetHashMapHolderSnapshot<T>().Read([&guid](HashMapHolderSnapshot<T> const& snapshot) -> T*
+    {
+        auto itr = FindInSnapshot(snapshot, guid);
+        return itr != snapshot.end() && itr->first == guid ? itr->second : nullptr;
+    });
 }
 
 template<class T>
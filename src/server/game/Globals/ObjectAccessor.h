@@ -51,6 +51,7 @@ public:
 
     static void Remove(T* o);
 
+    // does not take the lock, reads a sorted snapshot republished by Insert and Remove
     static T* Find(ObjectGuid guid);
 
     static MapType& GetContainer();
@@ -45,6 +45,7 @@
 #include "LootMgr.h"
 #include "Mail.h"
 #include "MapManager.h"
+#include "MemoryUsage.h"
 #include "MotionMaster.h"
 #include "MovementTypedefs.h"
 #include "ObjectAccessor.h"
@@ -223,6 +224,7 @@ ObjectMgr::ObjectMgr():
     _creatureSpawnId(1),
     _gameObjectSpawnId(1),
     _voidItemId(1),
+    _questGiverStatusGeneration(0),
     DBCLocaleIndex(LOCALE_enUS)
 {
 }
@@ -2127,14 +2129,15 @@ void ObjectMgr::LoadCreatures()
     uint32 oldMSTime = getMSTime();
 
     //                                               0              1   2    3           4           5           6            7        8             9              10
-    QueryResult result = WorldDatabase.Query("SELECT creature.guid, id, map, position_x, position_y, position_z, orientation, modelid, equipment_id, spawntimesecs, wander_distance, "
+    QueryResult result = WorldDatabase.QueryCached("SELECT creature.guid, id, map, position_x, position_y, position_z, orientation, modelid, equipment_id, spawntimesecs, wander_distance, "
     //   11               12            13            14                 15          16           17                18                   19                    20
         "currentwaypoint, curHealthPct, MovementType, spawnDifficulties, eventEntry, poolSpawnId, creature.npcflag, creature.unit_flags, creature.unit_flags2, creature.unit_flags3, "
     //   21                      22                23                   24                       25                   26
         "creature.phaseUseFlags, creature.phaseid, creature.phasegroup, creature.terrainSwapMap, creature.ScriptName, creature.StringId "
         "FROM creature "
         "LEFT OUTER JOIN game_event_creature ON creature.guid = game_event_creature.guid "
-        "LEFT OUTER JOIN pool_members ON pool_members.type = 0 AND creature.guid = pool_members.spawnId");
+        "LEFT OUTER JOIN pool_members ON pool_members.type = 0 AND creature.guid = pool_members.spawnId",
+        { "creature", "game_event_creature", "pool_members" });
 
     if (!result)
     {
@@ -2153,10 +2156,12 @@ void ObjectMgr::LoadCreatures()
 
     do
     {
-        Field* fields = result->Fetch();
-
-        ObjectGuid::LowType guid = fields[0].GetUInt64();
-        uint32 entry        = fields[1].GetUInt32();
+        auto [guid, entry, mapId, positionX, positionY, positionZ, orientation, modelId, equipmentId, spawntimesecs, wanderDistance,
+            currentWaypoint, curHealthPct, movementType, spawnDifficulties, eventEntry, poolSpawnId, npcflag, unitFlags, unitFlags2, unitFlags3,
+            phaseUseFlags, phaseId, phaseGroup, terrainSwapMap, scriptName, stringId] = result->ReadRow<
+            ObjectGuid::LowType, uint32, uint16, float, float, float, float, uint32, int8, uint32, float,
+            uint32, uint32, uint8, std::string_view, int8, uint32, Optional<uint64>, Optional<uint32>, Optional<uint32>, Optional<uint32>,
+            uint8, uint32, uint32, int32, std::string, std::string>();
 
         CreatureTemplate const* cInfo = GetCreatureTemplate(entry);
         if (!cInfo)
@@ -2168,33 +2173,33 @@ void ObjectMgr::LoadCreatures()
         CreatureData& data = _creatureDataStore[guid];
         data.spawnId        = guid;
         data.id             = entry;
-        data.mapId          = fields[2].GetUInt16();
-        data.spawnPoint.Relocate(fields[3].GetFloat(), fields[4].GetFloat(), fields[5].GetFloat(), fields[6].GetFloat());
-        if (uint32 displayId = fields[7].GetUInt32())
-            data.display.emplace(displayId, DEFAULT_PLAYER_DISPLAY_SCALE, 1.0f);
-        data.equipmentId    = fields[8].GetInt8();
-        data.spawntimesecs  = fields[9].GetUInt32();
-        data.wander_distance = fields[10].GetFloat();
-        data.currentwaypoint = fields[11].GetUInt32();
-        data.curHealthPct   = fields[12].GetUInt32();
-        data.movementType   = fields[13].GetUInt8();
-        data.spawnDifficulties = ParseSpawnDifficulties(fields[14].GetStringView(), "creature", guid, data.mapId, spawnMasks[data.mapId]);
-        int16 gameEvent     = fields[15].GetInt8();
-        data.poolId         = fields[16].GetUInt32();
-        if (!fields[17].IsNull())
-            data.npcflag = fields[17].GetUInt64();
-        if (!fields[18].IsNull())
-            data.unit_flags = fields[18].GetUInt32();
-        if (!fields[19].IsNull())
-            data.unit_flags2 = fields[19].GetUInt32();
-        if (!fields[20].IsNull())
-            data.unit_flags3 = fields[20].GetUInt32();
-        data.phaseUseFlags  = fields[21].GetUInt8();
-        data.phaseId        = fields[22].GetUInt32();
-        data.phaseGroup     = fields[23].GetUInt32();
-        data.terrainSwapMap = fields[24].GetInt32();
-        data.scriptId       = GetScriptId(fields[25].GetString());
-        data.StringId       = fields[26].GetString();
+        data.mapId          = mapId;
+        data.spawnPoint.Relocate(positionX, positionY, positionZ, orientation);
+        if (modelId)
+            data.display.emplace(modelId, DEFAULT_PLAYER_DISPLAY_SCALE, 1.0f);
+        data.equipmentId    = equipmentId;
+        data.spawntimesecs  = spawntimesecs;
+        data.wander_distance = wanderDistance;
+        data.currentwaypoint = currentWaypoint;
+        data.curHealthPct   = curHealthPct;
+        data.movementType   = movementType;
+        data.spawnDifficulties = ParseSpawnDifficulties(spawnDifficulties, "creature", guid, data.mapId, spawnMasks[data.mapId]);
+        int16 gameEvent     = eventEntry;
+        data.poolId         = poolSpawnId;
+        if (npcflag)
+            data.npcflag = *npcflag;
+        if (unitFlags)
+            data.unit_flags = *unitFlags;
+        if (unitFlags2)
+            data.unit_flags2 = *unitFlags2;
+        if (unitFlags3)
+            data.unit_flags3 = *unitFlags3;
+        data.phaseUseFlags  = phaseUseFlags;
+        data.phaseId        = phaseId;
+        data.phaseGroup     = phaseGroup;
+        data.terrainSwapMap = terrainSwapMap;
+        data.scriptId       = GetScriptId(scriptName);
+        data.StringId       = std::move(stringId);
         data.spawnGroupData = IsTransportMap(data.mapId) ? GetLegacySpawnGroup() : GetDefaultSpawnGroup(); // transport spawns default to compatibility group
 
         MapEntry const* mapEntry = sMapStore.LookupEntry(data.mapId);
@@ -2472,13 +2477,14 @@ void ObjectMgr::LoadGameObjects()
     uint32 oldMSTime = getMSTime();
 
     //                                                0                1   2    3           4           5           6
-    QueryResult result = WorldDatabase.Query("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
+    QueryResult result = WorldDatabase.QueryCached("SELECT gameobject.guid, id, map, position_x, position_y, position_z, orientation, "
     //   7          8          9          10         11             12            13     14                 15          16
         "rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnDifficulties, eventEntry, poolSpawnId, "
     //   17             18       19          20              21          22
         "phaseUseFlags, phaseid, phasegroup, terrainSwapMap, ScriptName, StringId "
         "FROM gameobject LEFT OUTER JOIN game_event_gameobject ON gameobject.guid = game_event_gameobject.guid "
-        "LEFT OUTER JOIN pool_members ON pool_members.type = 1 AND gameobject.guid = pool_members.spawnId");
+        "LEFT OUTER JOIN pool_members ON pool_members.type = 1 AND gameobject.guid = pool_members.spawnId",
+        { "gameobject", "game_event_gameobject", "pool_members" });
 
     if (!result)
     {
@@ -2497,10 +2503,12 @@ void ObjectMgr::LoadGameObjects()
 
     do
     {
-        Field* fields = result->Fetch();
-
-        ObjectGuid::LowType guid = fields[0].GetUInt64();
-        uint32 entry        = fields[1].GetUInt32();
+        auto [guid, entry, mapId, positionX, positionY, positionZ, orientation,
+            rotation0, rotation1, rotation2, rotation3, spawntimesecs, animprogress, state, spawnDifficulties, eventEntry, poolSpawnId,
+            phaseUseFlags, phaseId, phaseGroup, terrainSwapMap, scriptName, stringId] = result->ReadRow<
+            ObjectGuid::LowType, uint32, uint16, float, float, float, float,
+            float, float, float, float, int32, uint8, uint8, std::string_view, int8, uint32,
+            uint8, uint32, uint32, int32, std::string, std::string>();
 
         GameObjectTemplate const* gInfo = GetGameObjectTemplate(entry);
         if (!gInfo)
@@ -2532,13 +2540,13 @@ void ObjectMgr::LoadGameObjects()
 
         data.spawnId        = guid;
         data.id             = entry;
-        data.mapId          = fields[2].GetUInt16();
-        data.spawnPoint.Relocate(fields[3].GetFloat(), fields[4].GetFloat(), fields[5].GetFloat(), fields[6].GetFloat());
-        data.rotation.x     = fields[7].GetFloat();
-        data.rotation.y     = fields[8].GetFloat();
-        data.rotation.z     = fields[9].GetFloat();
-        data.rotation.w     = fields[10].GetFloat();
-        data.spawntimesecs  = fields[11].GetInt32();
+        data.mapId          = mapId;
+        data.spawnPoint.Relocate(positionX, positionY, positionZ, orientation);
+        data.rotation.x     = rotation0;
+        data.rotation.y     = rotation1;
+        data.rotation.z     = rotation2;
+        data.rotation.w     = rotation3;
+        data.spawntimesecs  = spawntimesecs;
         data.spawnGroupData = IsTransportMap(data.mapId) ? GetLegacySpawnGroup() : GetDefaultSpawnGroup(); // transport spawns default to compatibility group
 
         MapEntry const* mapEntry = sMapStore.LookupEntry(data.mapId);
@@ -2571,10 +2579,10 @@ void ObjectMgr::LoadGameObjects()
             TC_LOG_ERROR("sql.sql", "Table `gameobject` has gameobject (GUID: {} Entry: {}) with `spawntimesecs` (0) value, but the gameobejct is marked as despawnable at action.", guid, data.id);
         }
 
-        data.animprogress   = fields[12].GetUInt8();
+        data.animprogress   = animprogress;
         data.artKit         = 0;
 
-        uint32 go_state     = fields[13].GetUInt8();
+        uint32 go_state     = state;
         if (go_state >= MAX_GO_STATE)
         {
             if (gInfo->type != GAMEOBJECT_TYPE_TRANSPORT || go_state > GO_STATE_TRANSPORT_ACTIVE + MAX_GO_STATE_TRANSPORT_STOP_FRAMES)
@@ -2585,18 +2593,18 @@ void ObjectMgr::LoadGameObjects()
         }
         data.goState       = GOState(go_state);
 
-        data.spawnDifficulties      = ParseSpawnDifficulties(fields[14].GetStringView(), "gameobject", guid, data.mapId, spawnMasks[data.mapId]);
+        data.spawnDifficulties      = ParseSpawnDifficulties(spawnDifficulties, "gameobject", guid, data.mapId, spawnMasks[data.mapId]);
         if (data.spawnDifficulties.empty())
         {
             TC_LOG_ERROR("sql.sql", "Table `creature` has creature (GUID: {}) that is not spawned in any difficulty, skipped.", guid);
             continue;
         }
 
-        int16 gameEvent     = fields[15].GetInt8();
-        data.poolId         = fields[16].GetUInt32();
-        data.phaseUseFlags  = fields[17].GetUInt8();
-        data.phaseId        = fields[18].GetUInt32();
-        data.phaseGroup     = fields[19].GetUInt32();
+        int16 gameEvent     = eventEntry;
+        data.poolId         = poolSpawnId;
+        data.phaseUseFlags  = phaseUseFlags;
+        data.phaseId        = phaseId;
+        data.phaseGroup     = phaseGroup;
 
         if (data.phaseUseFlags & ~PHASE_USE_FLAGS_ALL)
         {
@@ -2635,7 +2643,7 @@ void ObjectMgr::LoadGameObjects()
             }
         }
 
-        data.terrainSwapMap = fields[20].GetInt32();
+        data.terrainSwapMap = terrainSwapMap;
         if (data.terrainSwapMap != -1)
         {
             MapEntry const* terrainSwapEntry = sMapStore.LookupEntry(data.terrainSwapMap);
@@ -2651,8 +2659,8 @@ void ObjectMgr::LoadGameObjects()
             }
         }
 
-        data.scriptId = GetScriptId(fields[21].GetString());
-        data.StringId = fields[22].GetString();
+        data.scriptId = GetScriptId(scriptName);
+        data.StringId = std::move(stringId);
 
         if (data.rotation.x < -1.0f || data.rotation.x > 1.0f)
         {
@@ -4499,6 +4507,8 @@ void ObjectMgr::LoadQuests()
 {
     uint32 oldMSTime = getMSTime();
 
+    InvalidateQuestGiverStatuses();
+
     _questTemplates.clear();
     _questTemplatesAutoPush.clear();
     _questObjectives.clear();
@@ -8577,6 +8587,7 @@ void ObjectMgr::LoadQuestRelationsHelper(QuestRelations& map, QuestRelationsReve
 {
     uint32 oldMSTime = getMSTime();
 
+    InvalidateQuestGiverStatuses();
     map.clear();                                            // need for reload case
 
     uint32 count = 0;
@@ -11647,3 +11658,42 @@ std::string ObjectMgr::GetPhaseName(uint32 phaseId) const
     PhaseNameContainer::const_iterator iter = _phaseNameStore.find(phaseId);
     return iter != _phaseNameStore.end() ? iter->second : "Unknown Name";
 }
+
+void ObjectMgr::GetMemoryUsage(Trinity::MemoryUsageReport& report) const
+{
+    using Trinity::MemoryUsage::Of;
+
+    auto cellGuidsUsage = [](auto const& cells)
+    {
+        return Of(cells.second, [](auto const& cell) { return Of(cell.second.creatures) + Of(cell.second.gameobjects); });
+    };
+
+    report.Add("ObjectMgr", "creature_template", Of(_creatureTemplateStore, [](auto const& creatureTemplate)
+    {
+        CreatureTemplate const& info = creatureTemplate.second;
+        return Of(info.Models) + Of(info.Name) + Of(info.FemaleName) + Of(info.SubName) + Of(info.TitleAlt) + Of(info.IconName)
+            + Of(info.GossipMenuIds) + Of(info.difficultyStore) + Of(info.AIName) + Of(info.StringId);
+    }));
+    report.Add("ObjectMgr", "creature", Of(_creatureDataStore) + Of(_creatureAddonStore));
+    report.Add("ObjectMgr", "gameobject_template", Of(_gameObjectTemplateStore) + Of(_gameObjectTemplateAddonStore));
+    report.Add("ObjectMgr", "gameobject", Of(_gameObjectDataStore) + Of(_gameObjectAddonStore));
+    report.Add("ObjectMgr", "cell_guids", Of(_mapObjectGuidsStore, cellGuidsUsage) + Of(_mapPersonalObjectGuidsStore, cellGuidsUsage));
+    report.Add("ObjectMgr", "spawn_group", Of(_spawnGroupDataStore) + Of(_spawnGroupMapStore) + Of(_spawnGroupsByMap, [](auto const& spawnGroups) { return Of(spawnGroups.second); }));
+    report.Add("ObjectMgr", "item_template", Of(_itemTemplateStore));
+    report.Add("ObjectMgr", "quest_template", Of(_questTemplates, [](auto const&) { return sizeof(Quest); }) + Of(_questObjectives));
+    report.Add("ObjectMgr", "vendor", Of(_cacheVendorItemStore, [](auto const& vendor) { return Of(vendor.second.m_items); }));
+    report.Add("ObjectMgr", "gossip", Of(_gossipMenusStore) + Of(_gossipMenuItemsStore) + Of(_npcTextStore) + Of(_pageTextStore));
+
+    report.Add("ObjectMgr", "locales", Of(_creatureLocaleStore, [](auto const& locale)
+    {
+        return Of(locale.second.Name) + Of(locale.second.NameAlt) + Of(locale.second.Title) + Of(locale.second.TitleAlt);
+    }) + Of(_gameObjectLocaleStore, [](auto const& locale)
+    {
+        return Of(locale.second.Name) + Of(locale.second.CastBarCaption) + Of(locale.second.Unk1);
+    }) + Of(_questTemplateLocaleStore, [](auto const& locale)
+    {
+        QuestTemplateLocale const& data = locale.second;
+        return Of(data.LogTitle) + Of(data.LogDescription) + Of(data.QuestDescription) + Of(data.AreaDescription) + Of(data.PortraitGiverText)
+            + Of(data.PortraitGiverName) + Of(data.PortraitTurnInText) + Of(data.PortraitTurnInName) + Of(data.QuestCompletionLog);
+    }) + Of(_trinityStringStore, [](auto const& str) { return Of(str.second.Content); }));
+}
@@ -22,6 +22,7 @@
 #include "ConditionMgr.h"
 #include "CreatureData.h"
 #include "DatabaseEnvFwd.h"
+#include "FlatSet.h"
 #include "GameObjectData.h"
 #include "ItemTemplate.h"
 #include "IteratorPair.h"
@@ -46,6 +47,10 @@ class Item;
 class Unit;
 class Vehicle;
 class Map;
+namespace Trinity
+{
+class MemoryUsageReport;
+}
 enum class GossipOptionFlags : int32;
 enum class GossipOptionNpc : uint8;
 struct AccessRequirement;
@@ -483,7 +488,8 @@ struct AccessRequirement
     std::string questFailedText;
 };
 
-typedef std::set<ObjectGuid::LowType> CellGuidSet;
+// spawn ids of a cell kept sorted in one contiguous block, loading a grid reads them linearly
+typedef Trinity::Containers::FlatSet<ObjectGuid::LowType> CellGuidSet;
 struct CellObjectGuids
 {
     CellGuidSet creatures;
@@ -1292,15 +1298,21 @@ class TC_GAME_API ObjectMgr
         void LoadCreatureQuestStarters();
         void LoadCreatureQuestEnders();
 
-        QuestRelations* GetGOQuestRelationMapHACK() { return &_goQuestRelations; }
+        // callers change quest giver relations through these, which makes every cached player quest giver status stale
+        QuestRelations* GetGOQuestRelationMapHACK() { InvalidateQuestGiverStatuses(); return &_goQuestRelations; }
         QuestRelationResult GetGOQuestRelations(uint32 entry) const { return GetQuestRelationsFrom(_goQuestRelations, entry, true); }
         QuestRelationResult GetGOQuestInvolvedRelations(uint32 entry) const { return GetQuestRelationsFrom(_goQuestInvolvedRelations, entry, false); }
         Trinity::IteratorPair<QuestRelationsReverse::const_iterator> GetGOQuestInvolvedRelationReverseBounds(uint32 questId) const { return _goQuestInvolvedRelationsReverse.equal_range(questId); }
-        QuestRelations* GetCreatureQuestRelationMapHACK() { return &_creatureQuestRelations; }
+        QuestRelations* GetCreatureQuestRelationMapHACK() { InvalidateQuestGiverStatuses(); return &_creatureQuestRelations; }
         QuestRelationResult GetCreatureQuestRelations(uint32 entry) const { return GetQuestRelationsFrom(_creatureQuestRelations, entry, true); }
         QuestRelationResult GetCreatureQuestInvolvedRelations(uint32 entry) const { return GetQuestRelationsFrom(_creatureQuestInvolvedRelations, entry, false); }
         Trinity::IteratorPair<QuestRelationsReverse::const_iterator> GetCreatureQuestInvolvedRelationReverseBounds(uint32 questId) const { return _creatureQuestInvolvedRelationsReverse.equal_range(questId); }
 
+        // players drop their cached quest giver statuses when this changes (see Player::GetQuestDialogStatus)
+        uint32 GetQuestGiverStatusGeneration() const { return _questGiverStatusGeneration.load(std::memory_order_relaxed); }
+        // for changes of quest data shared by all players: quests, quest giver relations, quest disables and conditions
+        void InvalidateQuestGiverStatuses() { _questGiverStatusGeneration.fetch_add(1, std::memory_order_relaxed); }
+
         ExclusiveQuestGroupsBounds GetExclusiveQuestGroupBounds(int32 exclusiveGroupId) const
         {
             return _exclusiveQuestGroups.equal_range(exclusiveGroupId);
@@ -1772,6 +1784,9 @@ class TC_GAME_API ObjectMgr
 
         CreatureStaticFlagsOverride const* GetCreatureStaticFlagsOverride(ObjectGuid::LowType spawnId, Difficulty difficultyId) const;
 
+        // adds the largest template, spawn and locale containers to the report
+        void GetMemoryUsage(Trinity::MemoryUsageReport& report) const;
+
     private:
         // first free id for selected id type
         uint32 _auctionId;
@@ -1781,6 +1796,7 @@ class TC_GAME_API ObjectMgr
         ObjectGuid::LowType _creatureSpawnId;
         ObjectGuid::LowType _gameObjectSpawnId;
         uint64 _voidItemId;
+        std::atomic<uint32> _questGiverStatusGeneration;
 
         // first free low guid for selected guid type
         ObjectGuidGenerator& GetGuidSequenceGenerator(HighGuid high);
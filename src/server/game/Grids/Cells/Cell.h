@@ -108,6 +108,10 @@ struct Cell
 
     static CellArea CalculateCellArea(float x, float y, float radius);
 
+    // true if any point of the cell is within radius of x, y (2d)
+    // cells failing this can not hold anything a range check would accept, so visiting them is skipped
+    static bool IsCellInRange(CellCoord const& cellCoord, float x, float y, float radius);
+
     template<class T> static void VisitGridObjects(WorldObject const* obj, T& visitor, float radius, bool dont_load = true);
     template<class T> static void VisitWorldObjects(WorldObject const* obj, T& visitor, float radius, bool dont_load = true);
     template<class T> static void VisitAllObjects(WorldObject const* obj, T& visitor, float radius, bool dont_load = true);
@@ -117,7 +121,7 @@ struct Cell
     template<class T> static void VisitAllObjects(float x, float y, Map* map, T& visitor, float radius, bool dont_load = true);
 
 private:
-    template<class T, class CONTAINER> void VisitCircle(TypeContainerVisitor<T, CONTAINER> &, Map &, CellCoord const&, CellCoord const&) const;
+    template<class T, class CONTAINER> void VisitCircle(TypeContainerVisitor<T, CONTAINER> &, Map &, CellCoord const&, CellCoord const&, float x, float y, float radius) const;
 };
 
 #endif
@@ -21,6 +21,7 @@
 #include "Cell.h"
 #include "Map.h"
 #include "Object.h"
+#include <algorithm>
 
 inline Cell::Cell(CellCoord const& p)
 {
@@ -57,6 +58,16 @@ inline CellArea Cell::CalculateCellArea(float x, float y, float radius)
     return CellArea(centerX, centerY);
 }
 
+inline bool Cell::IsCellInRange(CellCoord const& cellCoord, float x, float y, float radius)
+{
+    // cell x_coord covers [(x_coord - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL, (x_coord - CENTER_GRID_CELL_ID + 1) * SIZE_OF_GRID_CELL), see ComputeCellCoord
+    float minX = (float(cellCoord.x_coord) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+    float minY = (float(cellCoord.y_coord) - CENTER_GRID_CELL_ID) * SIZE_OF_GRID_CELL;
+    float dx = std::max({ minX - x, 0.0f, x - (minX + SIZE_OF_GRID_CELL) });
+    float dy = std::max({ minY - y, 0.0f, y - (minY + SIZE_OF_GRID_CELL) });
+    return dx * dx + dy * dy <= radius * radius;
+}
+
 template<class T, class CONTAINER>
 inline void Cell::Visit(CellCoord const& standing_cell, TypeContainerVisitor<T, CONTAINER>& visitor, Map& map, WorldObject const& obj, float radius) const
 {
@@ -98,7 +109,7 @@ inline void Cell::Visit(CellCoord const& standing_cell, TypeContainerVisitor<T,
     //there are nothing to optimize because SIZE_OF_GRID_CELL is too big...
     if ((area.high_bound.x_coord > (area.low_bound.x_coord + 4)) && (area.high_bound.y_coord > (area.low_bound.y_coord + 4)))
     {
-        VisitCircle(visitor, map, area.low_bound, area.high_bound);
+        VisitCircle(visitor, map, area.low_bound, area.high_bound, x_off, y_off, radius);
         return;
     }
 
@@ -113,7 +124,8 @@ inline void Cell::Visit(CellCoord const& standing_cell, TypeContainerVisitor<T,
         {
             CellCoord cellCoord(x, y);
             //lets skip standing cell since we already visited it
-            if (cellCoord != standing_cell)
+            //and corner cells of the area that are entirely out of the search circle
+            if (cellCoord != standing_cell && IsCellInRange(cellCoord, x_off, y_off, radius))
             {
                 Cell r_zone(cellCoord);
                 r_zone.data.Part.nocreate = this->data.Part.nocreate;
@@ -124,7 +136,7 @@ inline void Cell::Visit(CellCoord const& standing_cell, TypeContainerVisitor<T,
 }
 
 template<class T, class CONTAINER>
-inline void Cell::VisitCircle(TypeContainerVisitor<T, CONTAINER>& visitor, Map& map, CellCoord const& begin_cell, CellCoord const& end_cell) const
+inline void Cell::VisitCircle(TypeContainerVisitor<T, CONTAINER>& visitor, Map& map, CellCoord const& begin_cell, CellCoord const& end_cell, float x, float y, float radius) const
 {
     //here is an algorithm for 'filling' circum-squared octagon
     uint32 x_shift = (uint32)ceilf((end_cell.x_coord - begin_cell.x_coord) * 0.3f - 0.5f);
@@ -133,11 +145,14 @@ inline void Cell::VisitCircle(TypeContainerVisitor<T, CONTAINER>& visitor, Map&
     const uint32 x_end = end_cell.x_coord - x_shift;
 
     //visit central strip with constant width...
-    for (uint32 x = x_start; x <= x_end; ++x)
+    for (uint32 cellX = x_start; cellX <= x_end; ++cellX)
     {
-        for (uint32 y = begin_cell.y_coord; y <= end_cell.y_coord; ++y)
+        for (uint32 cellY = begin_cell.y_coord; cellY <= end_cell.y_coord; ++cellY)
         {
-            CellCoord cellCoord(x, y);
+            CellCoord cellCoord(cellX, cellY);
+            if (!IsCellInRange(cellCoord, x, y, radius))
+                continue;
+
             Cell r_zone(cellCoord);
             r_zone.data.Part.nocreate = this->data.Part.nocreate;
             map.Visit(r_zone, visitor);
@@ -157,20 +172,26 @@ inline void Cell::VisitCircle(TypeContainerVisitor<T, CONTAINER>& visitor, Map&
         //each step reduces strip height by 2 cells...
         y_end += 1;
         y_start -= 1;
-        for (uint32 y = y_start; y >= y_end; --y)
+        for (uint32 cellY = y_start; cellY >= y_end; --cellY)
         {
             //we visit cells symmetrically from both sides, heading from center to sides and from up to bottom
             //e.g. filling 2 trapezoids after filling central cell strip...
-            CellCoord cellCoord_left(x_start - step, y);
-            Cell r_zone_left(cellCoord_left);
-            r_zone_left.data.Part.nocreate = this->data.Part.nocreate;
-            map.Visit(r_zone_left, visitor);
+            CellCoord cellCoord_left(x_start - step, cellY);
+            if (IsCellInRange(cellCoord_left, x, y, radius))
+            {
+                Cell r_zone_left(cellCoord_left);
+                r_zone_left.data.Part.nocreate = this->data.Part.nocreate;
+                map.Visit(r_zone_left, visitor);
+            }
 
             //right trapezoid cell visit
-            CellCoord cellCoord_right(x_end + step, y);
-            Cell r_zone_right(cellCoord_right);
-            r_zone_right.data.Part.nocreate = this->data.Part.nocreate;
-            map.Visit(r_zone_right, visitor);
+            CellCoord cellCoord_right(x_end + step, cellY);
+            if (IsCellInRange(cellCoord_right, x, y, radius))
+            {
+                Cell r_zone_right(cellCoord_right);
+                r_zone_right.data.Part.nocreate = this->data.Part.nocreate;
+                map.Visit(r_zone_right, visitor);
+            }
         }
     }
 }
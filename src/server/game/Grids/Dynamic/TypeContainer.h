@@ -23,9 +23,9 @@
  * types of object at the same time.
  */
 
-#include <unordered_map>
 #include "Define.h"
 #include "Dynamic/TypeList.h"
+#include "FlatHashMap.h"
 #include "GridRefManager.h"
 
 /*
@@ -51,10 +51,12 @@ struct ContainerMapList<TypeList<H, T> >
     ContainerMapList<T> _TailElements;
 };
 
+// open addressing table, lookups probe one contiguous array instead of chasing node pointers
+// insertions and erasures invalidate all iterators, visitors must not add or remove objects of the visited type
 template<class OBJECT, class KEY_TYPE>
 struct ContainerUnorderedMap
 {
-    std::unordered_map<KEY_TYPE, OBJECT*> _element;
+    Trinity::Containers::FlatHashMap<KEY_TYPE, OBJECT*> _element;
 };
 
 template<class KEY_TYPE>
@@ -36,12 +36,9 @@ namespace Trinity
     {
         if constexpr (std::is_same_v<H, SPECIFIC_TYPE>)
         {
-            auto i = elements._elements._element.find(handle);
-            if (i == elements._elements._element.end())
-            {
-                elements._elements._element[handle] = obj;
+            auto [i, inserted] = elements._elements._element.try_emplace(handle, obj);
+            if (inserted)
                 return true;
-            }
             else
             {
                 ASSERT(i->second == obj, "Object with certain key already in but objects are different!");
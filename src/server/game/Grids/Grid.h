@@ -106,6 +106,12 @@ class Grid
             return uint32(i_objects.template Count<T>());
         }
 
+        template<class T>
+        uint32 GetGridObjectCountInGrid() const
+        {
+            return uint32(i_container.template Count<T>());
+        }
+
         /** Inserts a container type object into the grid.
          */
         template<class SPECIFIC_OBJECT> void AddGridObject(SPECIFIC_OBJECT *obj)
@@ -19,6 +19,7 @@
 #define _GRIDREFMANAGER
 
 #include "RefManager.h"
+#include <vector>
 
 template<class OBJECT>
 class GridReference;
@@ -27,12 +28,60 @@ template<class OBJECT>
 class GridRefManager : public RefManager<GridRefManager<OBJECT>, OBJECT>
 {
     public:
-        typedef LinkedListHead::Iterator< GridReference<OBJECT> > iterator;
+        // Besides the intrusive list every manager keeps its references in a contiguous slot array (swap-remove on unlink)
+        // so visits scan memory linearly instead of chasing list nodes spread over the objects
+        // Slots are iterated from the back: unlinking the current element only moves an already visited one into its slot
+        // and elements linked during the iteration are not visited, like with the list (insertFirst)
+        class iterator
+        {
+            public:
+                iterator(std::vector<GridReference<OBJECT>*> const* slots, std::size_t remaining) : _slots(slots), _remaining(remaining) { }
+
+                GridReference<OBJECT>& operator*() const { return *(*_slots)[_remaining - 1]; }
+                GridReference<OBJECT>* operator->() const { return (*_slots)[_remaining - 1]; }
+
+                iterator& operator++()
+                {
+                    --_remaining;
+                    // elements unlinked during the iteration may have shrunk the array below the current position
+                    if (_remaining > _slots->size())
+                        _remaining = _slots->size();
+                    return *this;
+                }
+
+                iterator operator++(int)
+                {
+                    iterator tmp = *this;
+                    ++*this;
+                    return tmp;
+                }
+
+                bool operator==(iterator const& right) const { return _remaining == right._remaining; }
+
+            private:
+                std::vector<GridReference<OBJECT>*> const* _slots;
+                std::size_t _remaining;
+        };
+
+        GridRefManager() = default;
+        // references must be invalidated while _slots is still alive
+        ~GridRefManager() { this->clearReferences(); }
 
         GridReference<OBJECT>* getFirst() { return (GridReference<OBJECT>*)RefManager<GridRefManager<OBJECT>, OBJECT>::getFirst(); }
         GridReference<OBJECT>* getLast() { return (GridReference<OBJECT>*)RefManager<GridRefManager<OBJECT>, OBJECT>::getLast(); }
 
-        iterator begin() { return iterator(getFirst()); }
-        iterator end() { return iterator(nullptr); }
+        iterator begin() { return iterator(&_slots, _slots.size()); }
+        iterator end() { return iterator(&_slots, 0); }
+
+    private:
+        friend class GridReference<OBJECT>;
+
+        void AddSlot(GridReference<OBJECT>* ref);
+        void RemoveSlot(GridReference<OBJECT>* ref);
+
+        std::vector<GridReference<OBJECT>*> _slots;
 };
+
+#include "GridReference.h"
+
 #endif
@@ -19,9 +19,7 @@
 #define _GRIDREFERENCE_H
 
 #include "LinkedReference/Reference.h"
-
-template<class OBJECT>
-class GridRefManager;
+#include "GridRefManager.h"
 
 template<class OBJECT>
 class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
@@ -32,20 +30,48 @@ class GridReference : public Reference<GridRefManager<OBJECT>, OBJECT>
             // called from link()
             this->getTarget()->insertFirst(this);
             this->getTarget()->incSize();
+            this->getTarget()->AddSlot(this);
         }
         void targetObjectDestroyLink() override
         {
             // called from unlink()
-            if (this->isValid()) this->getTarget()->decSize();
+            if (this->isValid())
+            {
+                this->getTarget()->decSize();
+                this->getTarget()->RemoveSlot(this);
+            }
         }
         void sourceObjectDestroyLink() override
         {
             // called from invalidate()
             this->getTarget()->decSize();
+            this->getTarget()->RemoveSlot(this);
         }
     public:
-        GridReference() : Reference<GridRefManager<OBJECT>, OBJECT>() { }
+        GridReference() : Reference<GridRefManager<OBJECT>, OBJECT>(), _slot(0) { }
         ~GridReference() { this->unlink(); }
         GridReference* next() { return (GridReference*)Reference<GridRefManager<OBJECT>, OBJECT>::next(); }
+
+    private:
+        friend class GridRefManager<OBJECT>;
+
+        // position in GridRefManager::_slots, kept up to date when other references are swap-removed
+        std::size_t _slot;
 };
+
+template<class OBJECT>
+void GridRefManager<OBJECT>::AddSlot(GridReference<OBJECT>* ref)
+{
+    ref->_slot = _slots.size();
+    _slots.push_back(ref);
+}
+
+template<class OBJECT>
+void GridRefManager<OBJECT>::RemoveSlot(GridReference<OBJECT>* ref)
+{
+    GridReference<OBJECT>* last = _slots.back();
+    _slots[ref->_slot] = last;
+    last->_slot = ref->_slot;
+    _slots.pop_back();
+}
 #endif
@@ -16,6 +16,7 @@
  */
 
 #include "GridStates.h"
+#include "GameTime.h"
 #include "GridNotifiers.h"
 #include "Log.h"
 #include "Map.h"
@@ -40,20 +41,25 @@ void ActiveState::Update(Map& map, NGridType& grid, GridInfo& info, uint32 diff)
             TC_LOG_DEBUG("maps", "Grid[{}, {}] on map {} moved to IDLE state", grid.getX(), grid.getY(), map.GetId());
         }
         else
+        {
+            info.setLastActiveTime(GameTime::GetGameTimeMS());
             map.ResetGridExpiry(grid, 0.1f);
+        }
     }
 }
 
 void IdleState::Update(Map& map, NGridType& grid, GridInfo&, uint32) const
 {
     map.ResetGridExpiry(grid);
+    map.UpdateGridMemoryUsage(grid);
     grid.SetGridState(GRID_STATE_REMOVAL);
     TC_LOG_DEBUG("maps", "Grid[{}, {}] on map {} moved to REMOVAL state", grid.getX(), grid.getY(), map.GetId());
 }
 
 void RemovalState::Update(Map& map, NGridType& grid, GridInfo& info, uint32 diff) const
 {
-    if (!info.getUnloadLock())
+    // with a memory budget idle grids are unloaded by Map::UnloadGridsOverMemoryBudget and MapManager::Update instead
+    if (!info.getUnloadLock() && !Map::IsGridMemoryBudgetEnabled())
     {
         info.UpdateTimeTracker(diff);
         if (info.getTimeTracker().Passed() && !map.UnloadGrid(grid, false))
@@ -42,9 +42,17 @@ public:
     void ResetTimeTracker(time_t interval) { i_timer.Reset(interval); }
     void UpdateTimeTracker(time_t diff) { i_timer.Update(diff); }
     PeriodicTimer& getRelocationTimer() { return vis_Update; }
+
+    // used by memory budgeted grid unloading
+    uint32 getLastActiveTime() const { return i_lastActiveTime; }
+    void setLastActiveTime(uint32 time) { i_lastActiveTime = time; }
+    std::size_t getMemoryUsage() const { return i_memoryUsage; }
+    void setMemoryUsage(std::size_t size) { i_memoryUsage = size; }
 private:
     TimeTracker i_timer;
     PeriodicTimer vis_Update;
+    uint32 i_lastActiveTime;                                // game time (ms) when the grid was last seen active
+    std::size_t i_memoryUsage;                              // estimated footprint of objects, terrain and nav tiles
 
     uint16 i_unloadActiveLockCount : 16;                    // lock from active object spawn points (prevent clone loading)
     bool   i_unloadExplicitLock    : 1;                     // explicit manual lock or config setting
@@ -170,6 +178,16 @@ class NGrid
             return count;
         }
 
+        template<class T>
+        uint32 GetGridObjectCountInNGrid() const
+        {
+            uint32 count = 0;
+            for (uint32 x = 0; x < N; ++x)
+                for (uint32 y = 0; y < N; ++y)
+                    count += i_cells[x][y].template GetGridObjectCountInGrid<T>();
+            return count;
+        }
+
     private:
         uint32 i_gridId;
         GridInfo i_GridInfo;
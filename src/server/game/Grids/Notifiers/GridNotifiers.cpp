@@ -26,16 +26,31 @@
 
 using namespace Trinity;
 
+VisibleNotifier::VisibleNotifier(Player& player) : i_player(player), i_data(player.GetMapId()),
+    i_visibleNow(Trinity::TickArena::GetResource()), i_visitedGuids(Trinity::TickArena::GetResource())
+{
+    i_visitedGuids.reserve(player.m_clientGUIDs.size());
+}
+
 void VisibleNotifier::SendToSelf()
 {
+    std::sort(i_visitedGuids.begin(), i_visitedGuids.end());
+
+    auto isVisited = [&](ObjectGuid const& guid)
+    {
+        return std::binary_search(i_visitedGuids.begin(), i_visitedGuids.end(), guid);
+    };
+
     // at this moment i_clientGUIDs have guids that not iterate at grid level checks
     // but exist one case when this possible and object not out of range: transports
     if (Transport* transport = dynamic_cast<Transport*>(i_player.GetTransport()))
     {
         for (WorldObject* passenger : transport->GetPassengers())
         {
-            if (vis_guids.erase(passenger->GetGUID()) > 0)
+            if (!isVisited(passenger->GetGUID()) && i_player.m_clientGUIDs.contains(passenger->GetGUID()))
             {
+                i_visitedGuids.insert(std::upper_bound(i_visitedGuids.begin(), i_visitedGuids.end(), passenger->GetGUID()), passenger->GetGUID());
+
                 switch (passenger->GetTypeId())
                 {
                     case TYPEID_GAMEOBJECT:
@@ -62,7 +77,12 @@ void VisibleNotifier::SendToSelf()
         }
     }
 
-    for (ObjectGuid const& outOfRangeGuid : vis_guids)
+    Trinity::TickVector<ObjectGuid> outOfRangeGuids(Trinity::TickArena::GetResource());
+    for (ObjectGuid const& guid : i_player.m_clientGUIDs)
+        if (!isVisited(guid))
+            outOfRangeGuids.push_back(guid);
+
+    for (ObjectGuid const& outOfRangeGuid : outOfRangeGuids)
     {
         i_player.m_clientGUIDs.erase(outOfRangeGuid);
         i_data.AddOutOfRangeGUID(outOfRangeGuid);
@@ -138,7 +158,7 @@ void PlayerRelocationNotifier::Visit(PlayerMapType &m)
     {
         Player* player = iter->GetSource();
 
-        vis_guids.erase(player->GetGUID());
+        i_visitedGuids.push_back(player->GetGUID());
 
         i_player.UpdateVisibilityOf(player, i_data, i_visibleNow);
 
@@ -157,7 +177,7 @@ void PlayerRelocationNotifier::Visit(CreatureMapType &m)
     {
         Creature* c = iter->GetSource();
 
-        vis_guids.erase(c->GetGUID());
+        i_visitedGuids.push_back(c->GetGUID());
 
         i_player.UpdateVisibilityOf(c, i_data, i_visibleNow);
 
@@ -24,6 +24,7 @@
 #include "Conversation.h"
 #include "DynamicObject.h"
 #include "GameObject.h"
+#include "GridSearchResult.h"
 #include "Player.h"
 #include "SceneObject.h"
 #include "Spell.h"
@@ -49,10 +50,11 @@ namespace Trinity
     {
         Player &i_player;
         UpdateData i_data;
-        std::set<WorldObject*> i_visibleNow;
-        GuidUnorderedSet vis_guids;
+        Trinity::TickSet<WorldObject*> i_visibleNow;
+        // guids of all objects visited, anything else known to client is out of range (sorted in SendToSelf)
+        Trinity::TickVector<ObjectGuid> i_visitedGuids;
 
-        VisibleNotifier(Player &player) : i_player(player), i_data(player.GetMapId()), vis_guids(player.m_clientGUIDs) { }
+        VisibleNotifier(Player &player);
         template<class T> void Visit(GridRefManager<T> &m);
         void SendToSelf(void);
     };
@@ -138,8 +140,15 @@ namespace Trinity
 
         void operator()(Player const* player) const
         {
-            player->SendDirectMessage(Data);
+            // copied once on the first recipient, every socket then queues a reference to the same body
+            if (!_sharedData)
+                _sharedData = std::make_shared<WorldPacket const>(*Data);
+
+            player->SendDirectMessage(_sharedData);
         }
+
+    private:
+        mutable std::shared_ptr<WorldPacket const> _sharedData;
     };
 
     template<typename Packet>
@@ -149,7 +158,42 @@ namespace Trinity
 
         void operator()(Player const* player) const
         {
-            player->SendDirectMessage(Data.GetRawPacket());
+            // Data is fully written before the first recipient, every socket then queues a reference to the same body
+            if (!_sharedData)
+                _sharedData = std::make_shared<WorldPacket const>(*Data.GetRawPacket());
+
+            player->SendDirectMessage(_sharedData);
+        }
+
+    private:
+        mutable std::shared_ptr<WorldPacket const> _sharedData;
+    };
+
+    // Sends only every Interval-th packet of a periodic stream (movement heartbeats) to receivers viewing from farther than DistSq
+    struct PacketSenderDistanceLod
+    {
+        struct Band
+        {
+            float DistSq = 0.0f;
+            uint32 Interval = 1;
+        };
+
+        PacketSenderRef Sender;
+        WorldObject const* Source;
+        uint32 Sequence;
+        std::array<Band, 2> Bands;
+
+        PacketSenderDistanceLod(WorldPacket const* message, WorldObject const* source, uint32 sequence) : Sender(message), Source(source), Sequence(sequence) { }
+
+        void operator()(Player const* player) const
+        {
+            WorldObject const* viewPoint = player->m_seer ? player->m_seer : player;
+            float distSq = viewPoint->GetExactDist2dSq(Source);
+            for (Band const& band : Bands)
+                if (band.DistSq > 0.0f && distSq > band.DistSq && Sequence % band.Interval)
+                    return;
+
+            Sender(player);
         }
     };
 
@@ -0,0 +1,31 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_GRID_SEARCH_RESULT_H
+#define TRINITY_GRID_SEARCH_RESULT_H
+
+#include <boost/container/small_vector.hpp>
+
+namespace Trinity
+{
+    // Result container for list searchers in hot code paths
+    // The first InlineCapacity results are stored inside the container itself instead of one heap node per result like std::list
+    template<typename T, std::size_t InlineCapacity = 16>
+    using GridSearchResult = boost::container::small_vector<T, InlineCapacity>;
+}
+
+#endif // TRINITY_GRID_SEARCH_RESULT_H
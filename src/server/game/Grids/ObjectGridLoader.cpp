@@ -103,10 +103,9 @@ void AddObjectHelper(CellCoord &cell, GridRefManager<T> &m, uint32 &count, Map*
 template <class T>
 void LoadHelper(CellGuidSet const& guid_set, CellCoord& cell, GridRefManager<T>& m, uint32& count, Map* map, uint32 phaseId = 0, Optional<ObjectGuid> phaseOwner = {})
 {
-    for (CellGuidSet::const_iterator i_guid = guid_set.begin(); i_guid != guid_set.end(); ++i_guid)
+    for (ObjectGuid::LowType guid : guid_set)
     {
         // Don't spawn at all if there's a respawn timer
-        ObjectGuid::LowType guid = *i_guid;
         if (!map->ShouldBeSpawnedOnGridLoad<T>(guid))
             continue;
 
@@ -833,11 +833,45 @@ void Group::SendTargetIconList(WorldSession* session)
 
 void Group::SendUpdate()
 {
+    // the roster is built once and shared by the packets of all members, only viewer specific fields differ
+    std::vector<WorldPackets::Party::PartyPlayerInfo> playerList = BuildPartyPlayerList();
     for (member_witerator witr = m_memberSlots.begin(); witr != m_memberSlots.end(); ++witr)
-        SendUpdateToPlayer(witr->guid, &(*witr));
+        SendUpdateToPlayer(witr->guid, &(*witr), playerList);
 }
 
 void Group::SendUpdateToPlayer(ObjectGuid playerGUID, MemberSlot* slot)
+{
+    std::vector<WorldPackets::Party::PartyPlayerInfo> playerList = BuildPartyPlayerList();
+    SendUpdateToPlayer(playerGUID, slot, playerList);
+}
+
+std::vector<WorldPackets::Party::PartyPlayerInfo> Group::BuildPartyPlayerList() const
+{
+    std::vector<WorldPackets::Party::PartyPlayerInfo> playerList;
+    playerList.reserve(m_memberSlots.size());
+    for (member_citerator citr = m_memberSlots.begin(); citr != m_memberSlots.end(); ++citr)
+    {
+        Player* member = ObjectAccessor::FindConnectedPlayer(citr->guid);
+
+        WorldPackets::Party::PartyPlayerInfo& playerInfos = playerList.emplace_back();
+
+        playerInfos.GUID = citr->guid;
+        playerInfos.Name = citr->name;
+        playerInfos.Class = citr->_class;
+
+        playerInfos.FactionGroup = Player::GetFactionGroupForRace(citr->race);
+
+        playerInfos.Connected = member && member->GetSession() && !member->GetSession()->PlayerLogout();
+
+        playerInfos.Subgroup = citr->group;         // groupid
+        playerInfos.Flags = citr->flags;            // See enum GroupMemberFlags
+        playerInfos.RolesAssigned = citr->roles;    // Lfg Roles
+    }
+
+    return playerList;
+}
+
+void Group::SendUpdateToPlayer(ObjectGuid playerGUID, MemberSlot* slot, std::vector<WorldPackets::Party::PartyPlayerInfo>& playerList)
 {
     Player* player = ObjectAccessor::FindConnectedPlayer(playerGUID);
 
@@ -867,31 +901,11 @@ void Group::SendUpdateToPlayer(ObjectGuid playerGUID, MemberSlot* slot)
 
     partyUpdate.SequenceNum = player->NextGroupUpdateSequenceNumber(m_groupCategory);
 
-    partyUpdate.MyIndex = -1;
-    uint8 index = 0;
-    for (member_citerator citr = m_memberSlots.begin(); citr != m_memberSlots.end(); ++citr, ++index)
-    {
-        if (slot->guid == citr->guid)
-            partyUpdate.MyIndex = index;
-
-        Player* member = ObjectAccessor::FindConnectedPlayer(citr->guid);
-
-        WorldPackets::Party::PartyPlayerInfo playerInfos;
-
-        playerInfos.GUID = citr->guid;
-        playerInfos.Name = citr->name;
-        playerInfos.Class = citr->_class;
-
-        playerInfos.FactionGroup = Player::GetFactionGroupForRace(citr->race);
-
-        playerInfos.Connected = member && member->GetSession() && !member->GetSession()->PlayerLogout();
+    auto myInfo = std::find_if(playerList.begin(), playerList.end(), [slot](WorldPackets::Party::PartyPlayerInfo const& playerInfos) { return playerInfos.GUID == slot->guid; });
+    partyUpdate.MyIndex = myInfo != playerList.end() ? int32(std::distance(playerList.begin(), myInfo)) : -1;
 
-        playerInfos.Subgroup = citr->group;         // groupid
-        playerInfos.Flags = citr->flags;            // See enum GroupMemberFlags
-        playerInfos.RolesAssigned = citr->roles;    // Lfg Roles
-
-        partyUpdate.PlayerList.push_back(playerInfos);
-    }
+    // borrowed for writing, handed back below for the next member
+    partyUpdate.PlayerList = std::move(playerList);
 
     if (GetMembersCount() > 1)
     {
@@ -931,7 +945,10 @@ void Group::SendUpdateToPlayer(ObjectGuid playerGUID, MemberSlot* slot)
         partyUpdate.LfgInfos->MyKickVoteCount = 0;
     }
 
-    player->SendDirectMessage(partyUpdate.Write());
+    partyUpdate.Write();
+    playerList = std::move(partyUpdate.PlayerList);
+
+    player->SendDirectMessage(partyUpdate.GetRawPacket());
 }
 
 void Group::SendUpdateDestroyGroupToPlayer(Player* player) const
@@ -951,16 +968,24 @@ void Group::UpdatePlayerOutOfRange(Player* player)
     if (!player || !player->IsInWorld())
         return;
 
-    WorldPackets::Party::PartyMemberFullState packet;
-    packet.Initialize(player);
-    packet.Write();
+    // built only when a member is out of range, all of them then share one copy of the body
+    std::shared_ptr<WorldPacket const> packet;
 
     Player* member;
     for (GroupReference* itr = GetFirstMember(); itr != nullptr; itr = itr->next())
     {
         member = itr->GetSource();
         if (member && member != player && (!member->IsInMap(player) || !member->IsWithinDist(player, member->GetSightRange(), false)))
-            member->SendDirectMessage(packet.GetRawPacket());
+        {
+            if (!packet)
+            {
+                WorldPackets::Party::PartyMemberFullState fullState;
+                fullState.Initialize(player);
+                packet = std::make_shared<WorldPacket const>(*fullState.Write());
+            }
+
+            member->SendDirectMessage(packet);
+        }
     }
 }
 
@@ -43,6 +43,11 @@ struct BattlegroundTemplate;
 struct ItemDisenchantLootEntry;
 struct MapEntry;
 
+namespace WorldPackets::Party
+{
+    struct PartyPlayerInfo;
+}
+
 enum class InstanceResetMethod : uint8;
 enum class InstanceResetResult : uint8;
 enum LootMethod : uint8;
@@ -422,6 +427,9 @@ class TC_GAME_API Group
         void SubGroupCounterIncrease(uint8 subgroup);
         void SubGroupCounterDecrease(uint8 subgroup);
         void ToggleGroupMemberFlag(member_witerator slot, uint8 flag, bool apply);
+        // roster part of the party update, identical for every member
+        std::vector<WorldPackets::Party::PartyPlayerInfo> BuildPartyPlayerList() const;
+        void SendUpdateToPlayer(ObjectGuid playerGUID, MemberSlot* slot, std::vector<WorldPackets::Party::PartyPlayerInfo>& playerList);
 
         MemberSlotList      m_memberSlots;
         GroupRefManager     m_memberMgr;
@@ -83,13 +83,15 @@ void Guild::SendSaveEmblemResult(WorldSession* session, GuildEmblemError errCode
 // LogHolder
 template <typename Entry>
 Guild::LogHolder<Entry>::LogHolder()
-    : m_maxRecords(sWorld->getIntConfig(std::is_same_v<Entry, BankEventLogEntry> ? CONFIG_GUILD_BANK_EVENT_LOG_COUNT : CONFIG_GUILD_EVENT_LOG_COUNT)), m_nextGUID(uint32(GUILD_EVENT_LOG_GUID_UNDEFINED))
+    : m_maxRecords(sWorld->getIntConfig(std::is_same_v<Entry, BankEventLogEntry> ? CONFIG_GUILD_BANK_EVENT_LOG_COUNT : CONFIG_GUILD_EVENT_LOG_COUNT)), m_log(m_maxRecords),
+    m_nextGUID(uint32(GUILD_EVENT_LOG_GUID_UNDEFINED))
 { }
 
 template <typename Entry> template <typename... Ts>
 void Guild::LogHolder<Entry>::LoadEvent(Ts&&... args)
 {
-    Entry const& newEntry = m_log.emplace_front(std::forward<Ts>(args)...);
+    m_log.push_front(Entry(std::forward<Ts>(args)...));
+    Entry const& newEntry = m_log.front();
     if (m_nextGUID == uint32(GUILD_EVENT_LOG_GUID_UNDEFINED))
         m_nextGUID = newEntry.GetGUID();
 }
@@ -97,12 +99,9 @@ void Guild::LogHolder<Entry>::LoadEvent(Ts&&... args)
 template <typename Entry> template <typename... Ts>
 Entry& Guild::LogHolder<Entry>::AddEvent(CharacterDatabaseTransaction trans, Ts&&... args)
 {
-    // Check max records limit
-    if (!CanInsert())
-        m_log.pop_front();
-
-    // Add event to list
-    Entry& entry = m_log.emplace_back(std::forward<Ts>(args)...);
+    // Add event to log, a full log drops its oldest event
+    m_log.push_back(Entry(std::forward<Ts>(args)...));
+    Entry& entry = m_log.back();
     // Save to DB
     entry.SaveToDB(trans);
     return entry;
@@ -2183,7 +2182,7 @@ void Guild::HandleGuildRequestChallengeUpdate(WorldSession* session) const
 
 void Guild::SendEventLog(WorldSession* session) const
 {
-    std::list<EventLogEntry> const& eventLog = m_eventLog.GetGuildLog();
+    LogHolder<EventLogEntry>::GuildLog const& eventLog = m_eventLog.GetGuildLog();
 
     WorldPackets::Guild::GuildEventLogQueryResults packet;
     packet.Entry.reserve(eventLog.size());
@@ -2198,7 +2197,7 @@ void Guild::SendEventLog(WorldSession* session) const
 
 void Guild::SendNewsUpdate(WorldSession* session) const
 {
-    std::list<NewsLogEntry> const& newsLog = m_newsLog.GetGuildLog();
+    LogHolder<NewsLogEntry>::GuildLog const& newsLog = m_newsLog.GetGuildLog();
 
     WorldPackets::Guild::GuildNews packet;
     packet.NewsEvents.reserve(newsLog.size());
@@ -2219,7 +2218,7 @@ void Guild::SendBankLog(WorldSession* session, uint8 tabId) const
     // GUILD_BANK_MAX_TABS send by client for money log
     if (tabId < _GetPurchasedTabsSize() || tabId == GUILD_BANK_MAX_TABS)
     {
-        std::list<BankEventLogEntry> const& bankEventLog = m_bankEventLog[tabId].GetGuildLog();
+        LogHolder<BankEventLogEntry>::GuildLog const& bankEventLog = m_bankEventLog[tabId].GetGuildLog();
 
         WorldPackets::Guild::GuildBankLogQueryResults packet;
         packet.Tab = int32(tabId);
@@ -3784,7 +3783,7 @@ void Guild::UpdateCriteria(CriteriaType type, uint64 miscValue1, uint64 miscValu
 
 void Guild::HandleNewsSetSticky(WorldSession* session, uint32 newsId, bool sticky)
 {
-    std::list<NewsLogEntry>& newsLog = m_newsLog.GetGuildLog();
+    LogHolder<NewsLogEntry>::GuildLog& newsLog = m_newsLog.GetGuildLog();
     auto itr = newsLog.begin();
     while (itr != newsLog.end() && itr->GetGUID() != newsId)
         ++itr;
@@ -26,6 +26,7 @@
 #include "RaceMask.h"
 #include "SharedDefines.h"
 #include "UniqueTrackablePtr.h"
+#include <boost/circular_buffer.hpp>
 #include <set>
 #include <unordered_map>
 
@@ -537,14 +538,17 @@ class TC_GAME_API Guild
         };
 
         // Class encapsulating work with events collection
+        // Events are kept in a ring buffer of configured capacity that only allocates storage for the events it holds
         template <typename Entry>
         class LogHolder
         {
             public:
+                typedef boost::circular_buffer_space_optimized<Entry> GuildLog;
+
                 LogHolder();
 
                 // Checks if new log entry can be added to holder
-                bool CanInsert() const { return m_log.size() < m_maxRecords; }
+                bool CanInsert() const { return !m_log.full(); }
 
                 // Adds event from DB to collection
                 template <typename... Ts>
@@ -555,12 +559,12 @@ class TC_GAME_API Guild
                 Entry& AddEvent(CharacterDatabaseTransaction trans, Ts&&... args);
 
                 uint32 GetNextGUID();
-                std::list<Entry>& GetGuildLog() { return m_log; }
-                std::list<Entry> const& GetGuildLog() const { return m_log; }
+                GuildLog& GetGuildLog() { return m_log; }
+                GuildLog const& GetGuildLog() const { return m_log; }
 
             private:
-                std::list<Entry> m_log;
                 uint32 const m_maxRecords;
+                GuildLog m_log;
                 uint32 m_nextGUID;
         };
 
@@ -27,6 +27,7 @@
 #include "BattlePetMgr.h"
 #include "CalendarMgr.h"
 #include "CharacterCache.h"
+#include "CharacterEnumCache.h"
 #include "CharacterPackets.h"
 #include "Chat.h"
 #include "Common.h"
@@ -61,6 +62,7 @@
 #include "SocialMgr.h"
 #include "StringConvert.h"
 #include "SystemPackets.h"
+#include "ThreadPool.h"
 #include "Util.h"
 #include "World.h"
 #include <sstream>
@@ -185,29 +187,9 @@ bool LoginQueryHolder::Initialize()
     stmt->setUInt64(0, lowGuid);
     res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAILS, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS);
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAIL_ITEM_INFO);
     stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS, stmt);
-
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_ARTIFACT);
-    stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_ARTIFACT, stmt);
-
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE);
-    stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE, stmt);
-
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE_MILESTONE_POWER);
-    stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_MILESTONE_POWER, stmt);
-
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE_UNLOCKED_ESSENCE);
-    stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_UNLOCKED_ESSENCE, stmt);
-
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE_EMPOWERED);
-    stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEMS_AZERITE_EMPOWERED, stmt);
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_MAIL_ITEM_INFO, stmt);
 
     stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_SOCIALLIST);
     stmt->setUInt64(0, lowGuid);
@@ -316,29 +298,48 @@ bool LoginQueryHolder::Initialize()
     stmt->setUInt64(0, lowGuid);
     res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_GARRISON, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_GARRISON_BLUEPRINTS);
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_TRAIT_ENTRIES);
     stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_GARRISON_BLUEPRINTS, stmt);
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_TRAIT_ENTRIES, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_GARRISON_BUILDINGS);
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_TRAIT_CONFIGS);
     stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_GARRISON_BUILDINGS, stmt);
+    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_TRAIT_CONFIGS, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_GARRISON_FOLLOWERS);
+    return res;
+}
+
+class GarrisonLoginQueryHolder : public CharacterDatabaseQueryHolder
+{
+    private:
+        ObjectGuid m_guid;
+    public:
+        explicit GarrisonLoginQueryHolder(ObjectGuid guid) : m_guid(guid) { }
+        bool Initialize();
+};
+
+bool GarrisonLoginQueryHolder::Initialize()
+{
+    SetSize(MAX_PLAYER_GARRISON_LOGIN_QUERY);
+
+    bool res = true;
+    ObjectGuid::LowType lowGuid = m_guid.GetCounter();
+
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_GARRISON_BLUEPRINTS);
     stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_GARRISON_FOLLOWERS, stmt);
+    res &= SetPreparedQuery(PLAYER_GARRISON_LOGIN_QUERY_LOAD_BLUEPRINTS, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_GARRISON_FOLLOWER_ABILITIES);
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_GARRISON_BUILDINGS);
     stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_GARRISON_FOLLOWER_ABILITIES, stmt);
+    res &= SetPreparedQuery(PLAYER_GARRISON_LOGIN_QUERY_LOAD_BUILDINGS, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_TRAIT_ENTRIES);
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_GARRISON_FOLLOWERS);
     stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_TRAIT_ENTRIES, stmt);
+    res &= SetPreparedQuery(PLAYER_GARRISON_LOGIN_QUERY_LOAD_FOLLOWERS, stmt);
 
-    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_TRAIT_CONFIGS);
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHARACTER_GARRISON_FOLLOWER_ABILITIES);
     stmt->setUInt64(0, lowGuid);
-    res &= SetPreparedQuery(PLAYER_LOGIN_QUERY_LOAD_TRAIT_CONFIGS, stmt);
+    res &= SetPreparedQuery(PLAYER_GARRISON_LOGIN_QUERY_LOAD_FOLLOWER_ABILITIES, stmt);
 
     return res;
 }
@@ -378,24 +379,25 @@ public:
         stmt->setUInt32(0, accountId);
         result &= SetPreparedQuery(CUSTOMIZATIONS, stmt);
 
+        if (result && !isDeletedCharacters)
+            _storeToken = sCharacterEnumCache->GetStoreToken(accountId);
+
         return result;
     }
 
     bool IsDeletedCharacters() const { return _isDeletedCharacters; }
+    Optional<uint64> GetStoreToken() const { return _storeToken; }
 
 private:
     bool _isDeletedCharacters = false;
+    Optional<uint64> _storeToken;
 };
 
 void WorldSession::HandleCharEnum(CharacterDatabaseQueryHolder const& holder)
 {
-    WorldPackets::Character::EnumCharactersResult charEnum;
-    charEnum.Success = true;
-    charEnum.IsDeletedCharacters = static_cast<EnumCharactersQueryHolder const&>(holder).IsDeletedCharacters();
-    charEnum.DisabledClassesMask = sWorld->getIntConfig(CONFIG_CHARACTER_CREATING_DISABLED_CLASSMASK);
-
-    if (!charEnum.IsDeletedCharacters)
-        _legitCharacters.clear();
+    EnumCharactersQueryHolder const& enumHolder = static_cast<EnumCharactersQueryHolder const&>(holder);
+    std::shared_ptr<CharacterEnumCache::CharacterList> characters = std::make_shared<CharacterEnumCache::CharacterList>();
+    bool cacheable = enumHolder.GetStoreToken().has_value();
 
     std::unordered_map<ObjectGuid::LowType, std::vector<UF::ChrCustomizationChoice>> customizations;
     if (PreparedQueryResult customizationsResult = holder.GetPreparedResult(EnumCharactersQueryHolder::CUSTOMIZATIONS))
@@ -414,16 +416,14 @@ void WorldSession::HandleCharEnum(CharacterDatabaseQueryHolder const& holder)
     {
         do
         {
-            charEnum.Characters.emplace_back(result->Fetch());
-
-            WorldPackets::Character::EnumCharactersResult::CharacterInfo& charInfo = charEnum.Characters.back();
+            WorldPackets::Character::EnumCharactersResult::CharacterInfo& charInfo = characters->emplace_back(result->Fetch());
 
             if (std::vector<UF::ChrCustomizationChoice>* customizationsForChar = Trinity::Containers::MapGetValuePtr(customizations, charInfo.Guid.GetCounter()))
                 charInfo.Customizations = std::move(*customizationsForChar);
 
             TC_LOG_INFO("network", "Loading char guid {} from account {}.", charInfo.Guid.ToString(), GetAccountId());
 
-            if (!charEnum.IsDeletedCharacters)
+            if (!enumHolder.IsDeletedCharacters())
             {
                 if (!ValidateAppearance(Races(charInfo.RaceID), Classes(charInfo.ClassID), Gender(charInfo.SexID), MakeChrCustomizationChoiceRange(charInfo.Customizations)))
                 {
@@ -440,18 +440,42 @@ void WorldSession::HandleCharEnum(CharacterDatabaseQueryHolder const& holder)
                         charInfo.Flags2 = CHAR_CUSTOMIZE_FLAG_CUSTOMIZE;
                     }
                 }
-
-                // Do not allow locked characters to login
-                if (!(charInfo.Flags & (CHARACTER_FLAG_LOCKED_FOR_TRANSFER | CHARACTER_FLAG_LOCKED_BY_BILLING)))
-                    _legitCharacters.insert(charInfo.Guid);
             }
 
+            // bans expire without anything invalidating the cached list
+            if (charInfo.Flags & CHARACTER_FLAG_LOCKED_BY_BILLING)
+                cacheable = false;
+
             if (!sCharacterCache->HasCharacterCacheEntry(charInfo.Guid)) // This can happen if characters are inserted into the database manually. Core hasn't loaded name data yet.
                 sCharacterCache->AddCharacterCacheEntry(charInfo.Guid, GetAccountId(), charInfo.Name, charInfo.SexID, charInfo.RaceID, charInfo.ClassID, charInfo.ExperienceLevel, false);
-
-            charEnum.MaxCharacterLevel = std::max<int32>(charEnum.MaxCharacterLevel, charInfo.ExperienceLevel);
         }
-        while (result->NextRow() && charEnum.Characters.size() < MAX_CHARACTERS_PER_REALM);
+        while (result->NextRow() && characters->size() < MAX_CHARACTERS_PER_REALM);
+    }
+
+    if (cacheable)
+        sCharacterEnumCache->Store(GetAccountId(), *enumHolder.GetStoreToken(), characters);
+
+    WorldPackets::Character::EnumCharactersResult charEnum;
+    charEnum.IsDeletedCharacters = enumHolder.IsDeletedCharacters();
+    charEnum.Characters = *characters;
+    SendCharEnum(charEnum);
+}
+
+void WorldSession::SendCharEnum(WorldPackets::Character::EnumCharactersResult& charEnum)
+{
+    charEnum.Success = true;
+    charEnum.DisabledClassesMask = sWorld->getIntConfig(CONFIG_CHARACTER_CREATING_DISABLED_CLASSMASK);
+
+    if (!charEnum.IsDeletedCharacters)
+        _legitCharacters.clear();
+
+    for (WorldPackets::Character::EnumCharactersResult::CharacterInfo const& charInfo : charEnum.Characters)
+    {
+        // Do not allow locked characters to login
+        if (!charEnum.IsDeletedCharacters && !(charInfo.Flags & (CHARACTER_FLAG_LOCKED_FOR_TRANSFER | CHARACTER_FLAG_LOCKED_BY_BILLING)))
+            _legitCharacters.insert(charInfo.Guid);
+
+        charEnum.MaxCharacterLevel = std::max<int32>(charEnum.MaxCharacterLevel, charInfo.ExperienceLevel);
     }
 
     for (std::pair<uint8 const, RaceUnlockRequirement> const& requirement : sObjectMgr->GetRaceUnlockRequirements())
@@ -474,6 +498,14 @@ void WorldSession::HandleCharEnumOpcode(WorldPackets::Character::EnumCharacters&
     CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_EXPIRED_BANS);
     CharacterDatabase.Execute(stmt);
 
+    if (std::shared_ptr<CharacterEnumCache::CharacterList const> characters = sCharacterEnumCache->Get(GetAccountId()))
+    {
+        WorldPackets::Character::EnumCharactersResult charEnum;
+        charEnum.Characters = *characters;
+        SendCharEnum(charEnum);
+        return;
+    }
+
     /// get all the data necessary for loading all characters (along with their pets) on the account
     std::shared_ptr<EnumCharactersQueryHolder> holder = std::make_shared<EnumCharactersQueryHolder>();
     if (!holder->Initialize(GetAccountId(), sWorld->getBoolConfig(CONFIG_DECLINED_NAMES_USED), false))
@@ -1105,9 +1137,26 @@ void WorldSession::HandleContinuePlayerLogin()
 
     SendPacket(WorldPackets::Auth::ResumeComms(CONNECTION_TYPE_INSTANCE).Write());
 
-    AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder)).AfterComplete([this](SQLQueryHolderBase const& holder)
+    AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(holder)).AfterComplete([this, holder](SQLQueryHolderBase const& /*result*/)
     {
-        HandlePlayerLogin(static_cast<LoginQueryHolder const&>(holder));
+        // most characters never create a garrison, its contents are only queried when the garrison itself exists
+        if (!holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON))
+        {
+            HandlePlayerLogin(holder, nullptr);
+            return;
+        }
+
+        std::shared_ptr<GarrisonLoginQueryHolder> garrisonHolder = std::make_shared<GarrisonLoginQueryHolder>(holder->GetGuid());
+        if (!garrisonHolder->Initialize())
+        {
+            m_playerLoading.Clear();
+            return;
+        }
+
+        AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(garrisonHolder)).AfterComplete([this, holder, garrisonHolder](SQLQueryHolderBase const& /*result*/)
+        {
+            HandlePlayerLogin(holder, garrisonHolder.get());
+        });
     });
 }
 
@@ -1128,16 +1177,12 @@ void WorldSession::HandleLoadScreenOpcode(WorldPackets::Character::LoadingScreen
     // TODO: Do something with this packet
 }
 
-void WorldSession::HandlePlayerLogin(LoginQueryHolder const& holder)
+void WorldSession::HandlePlayerLogin(std::shared_ptr<LoginQueryHolder const> holder, GarrisonLoginQueryHolder const* garrisonHolder)
 {
-    ObjectGuid playerGuid = holder.GetGuid();
-
     Player* pCurrChar = new Player(this);
-     // for send server info and strings (config)
-    ChatHandler chH = ChatHandler(pCurrChar->GetSession());
 
     // "GetAccountId() == db stored account id" checked in LoadFromDB (prevent login not own character using cheating tools)
-    if (!pCurrChar->LoadFromDB(playerGuid, holder))
+    if (!pCurrChar->LoadFromDB(holder->GetGuid(), *holder))
     {
         SetPlayer(nullptr);
         KickPlayer("WorldSession::HandlePlayerLogin Player::LoadFromDB failed"); // disconnect client, player no set to session and it will not deleted or saved at kick
@@ -1146,6 +1191,49 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder const& holder)
         return;
     }
 
+    if (garrisonHolder)
+        pCurrChar->LoadGarrisonFromDB(holder->GetPreparedResult(PLAYER_LOGIN_QUERY_LOAD_GARRISON), *garrisonHolder);
+
+    // the packets describing only the player itself (spells, talents, achievements, collections...) are built
+    // on a session update thread, the session stays in the loading state without a player until they are done
+    if (Trinity::ThreadPool* pool = sWorld->GetSessionUpdatePool())
+    {
+        SetPlayer(nullptr);
+
+        std::shared_ptr<PendingLogin> login = std::make_shared<PendingLogin>();
+        login->LoadedPlayer = pCurrChar;
+        login->Holder = std::move(holder);
+        _pendingLogin = login;
+
+        pool->PostWork([login]
+        {
+            login->LoadedPlayer->BuildInitialPackets(login->Packets);
+            login->Built.store(true, std::memory_order_release);
+            login->Built.notify_all();
+        });
+        return;
+    }
+
+    FinishPlayerLogin(pCurrChar, *holder, nullptr);
+}
+
+void WorldSession::ProcessPendingLogin()
+{
+    if (!_pendingLogin || !_pendingLogin->Built.load(std::memory_order_acquire))
+        return;
+
+    std::shared_ptr<PendingLogin> login = std::move(_pendingLogin);
+    SetPlayer(login->LoadedPlayer);
+    FinishPlayerLogin(login->LoadedPlayer, *login->Holder, &login->Packets);
+}
+
+void WorldSession::FinishPlayerLogin(Player* pCurrChar, LoginQueryHolder const& holder, PlayerInitialPackets const* initialPackets)
+{
+    ObjectGuid playerGuid = holder.GetGuid();
+
+     // for send server info and strings (config)
+    ChatHandler chH = ChatHandler(pCurrChar->GetSession());
+
     pCurrChar->SetVirtualPlayerRealm(GetVirtualRealmAddress());
 
     SendAccountDataTimes(ObjectGuid::Empty, GLOBAL_CACHE_MASK);
@@ -1208,7 +1296,7 @@ void WorldSession::HandlePlayerLogin(LoginQueryHolder const& holder)
 
     pCurrChar->GetSession()->GetBattlePetMgr()->SendJournalLockStatus();
 
-    pCurrChar->SendInitialPacketsBeforeAddToMap();
+    pCurrChar->SendInitialPacketsBeforeAddToMap(initialPackets);
 
     //Show cinematic at the first time that player login
     if (!pCurrChar->getCinematic())
@@ -2688,6 +2776,7 @@ void WorldSession::HandleReorderCharacters(WorldPackets::Character::ReorderChara
     }
 
     CharacterDatabase.CommitTransaction(trans);
+    sCharacterEnumCache->Invalidate(GetAccountId());
 }
 
 void WorldSession::HandleOpeningCinematic(WorldPackets::Misc::OpeningCinematic& /*packet*/)
@@ -2739,95 +2828,82 @@ void WorldSession::HandleCharUndeleteOpcode(WorldPackets::Character::UndeleteCha
         return;
     }
 
-    LoginDatabasePreparedStatement* stmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_LAST_CHAR_UNDELETE);
-    stmt->setUInt32(0, GetBattlenetAccountId());
+    StartAsyncTask(UndeleteCharacter(undeleteCharacter.UndeleteInfo));
+}
 
-    std::shared_ptr<WorldPackets::Character::CharacterUndeleteInfo> undeleteInfo = undeleteCharacter.UndeleteInfo;
-    _queryProcessor.AddCallback(LoginDatabase.AsyncQuery(stmt)
-        .WithChainingPreparedCallback([this, undeleteInfo](QueryCallback& queryCallback, PreparedQueryResult result)
+Trinity::Database::AsyncTask WorldSession::UndeleteCharacter(std::shared_ptr<WorldPackets::Character::CharacterUndeleteInfo> undeleteInfo)
+{
+    LoginDatabasePreparedStatement* loginStmt = LoginDatabase.GetPreparedStatement(LOGIN_SEL_LAST_CHAR_UNDELETE);
+    loginStmt->setUInt32(0, GetBattlenetAccountId());
+
+    if (PreparedQueryResult result = co_await LoginDatabase.AwaitQuery(loginStmt))
     {
-        if (result)
+        uint32 lastUndelete = result->Fetch()[0].GetUInt32();
+        uint32 maxCooldown = sWorld->getIntConfig(CONFIG_FEATURE_SYSTEM_CHARACTER_UNDELETE_COOLDOWN);
+        if (lastUndelete && (lastUndelete + maxCooldown > GameTime::GetGameTime()))
         {
-            uint32 lastUndelete = result->Fetch()[0].GetUInt32();
-            uint32 maxCooldown = sWorld->getIntConfig(CONFIG_FEATURE_SYSTEM_CHARACTER_UNDELETE_COOLDOWN);
-            if (lastUndelete && (lastUndelete + maxCooldown > GameTime::GetGameTime()))
-            {
-                SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_ERROR_COOLDOWN, undeleteInfo.get());
-                return;
-            }
+            SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_ERROR_COOLDOWN, undeleteInfo.get());
+            co_return;
         }
+    }
 
-        CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_DEL_INFO_BY_GUID);
-        stmt->setUInt64(0, undeleteInfo->CharacterGuid.GetCounter());
-        queryCallback.SetNextQuery(CharacterDatabase.AsyncQuery(stmt));
-    })
-        .WithChainingPreparedCallback([this, undeleteInfo](QueryCallback& queryCallback, PreparedQueryResult result)
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHAR_DEL_INFO_BY_GUID);
+    stmt->setUInt64(0, undeleteInfo->CharacterGuid.GetCounter());
+    PreparedQueryResult deleteInfo = co_await CharacterDatabase.AwaitQuery(stmt);
+    if (!deleteInfo)
     {
-        if (!result)
-        {
-            SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_ERROR_CHAR_CREATE, undeleteInfo.get());
-            return;
-        }
+        SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_ERROR_CHAR_CREATE, undeleteInfo.get());
+        co_return;
+    }
 
-        Field* fields = result->Fetch();
-        undeleteInfo->Name = fields[1].GetString();
-        uint32 account = fields[2].GetUInt32();
+    Field* fields = deleteInfo->Fetch();
+    undeleteInfo->Name = fields[1].GetString();
+    uint32 account = fields[2].GetUInt32();
 
-        if (account != GetAccountId())
-        {
-            SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_ERROR_UNKNOWN, undeleteInfo.get());
-            return;
-        }
+    if (account != GetAccountId())
+    {
+        SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_ERROR_UNKNOWN, undeleteInfo.get());
+        co_return;
+    }
 
-        CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHECK_NAME);
-        stmt->setString(0, undeleteInfo->Name);
-        queryCallback.SetNextQuery(CharacterDatabase.AsyncQuery(stmt));
-    })
-        .WithChainingPreparedCallback([this, undeleteInfo](QueryCallback& queryCallback, PreparedQueryResult result)
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_CHECK_NAME);
+    stmt->setString(0, undeleteInfo->Name);
+    if (co_await CharacterDatabase.AwaitQuery(stmt))
     {
-        if (result)
-        {
-            SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_ERROR_NAME_TAKEN_BY_THIS_ACCOUNT, undeleteInfo.get());
-            return;
-        }
+        SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_ERROR_NAME_TAKEN_BY_THIS_ACCOUNT, undeleteInfo.get());
+        co_return;
+    }
 
-        /// @todo: add more safety checks
-        /// * max char count per account
-        /// * max death knight count
-        /// * max demon hunter count
-        /// * team violation
+    /// @todo: add more safety checks
+    /// * max char count per account
+    /// * max death knight count
+    /// * max demon hunter count
+    /// * team violation
 
-        CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_SUM_CHARS);
-        stmt->setUInt32(0, GetAccountId());
-        queryCallback.SetNextQuery(CharacterDatabase.AsyncQuery(stmt));
-    })
-        .WithPreparedCallback([this, undeleteInfo](PreparedQueryResult result)
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_SUM_CHARS);
+    stmt->setUInt32(0, GetAccountId());
+    if (PreparedQueryResult result = co_await CharacterDatabase.AwaitQuery(stmt))
     {
-        if (result)
+        if (result->Fetch()[0].GetUInt64() >= sWorld->getIntConfig(CONFIG_CHARACTERS_PER_REALM)) // SQL's COUNT() returns uint64 but it will always be less than uint8.Max
         {
-            Field* fields = result->Fetch();
-
-            if (fields[0].GetUInt64() >= sWorld->getIntConfig(CONFIG_CHARACTERS_PER_REALM)) // SQL's COUNT() returns uint64 but it will always be less than uint8.Max
-            {
-                SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_ERROR_CHAR_CREATE, undeleteInfo.get());
-                return;
-            }
+            SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_ERROR_CHAR_CREATE, undeleteInfo.get());
+            co_return;
         }
+    }
 
-        CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_RESTORE_DELETE_INFO);
-        stmt->setString(0, undeleteInfo->Name);
-        stmt->setUInt32(1, GetAccountId());
-        stmt->setUInt64(2, undeleteInfo->CharacterGuid.GetCounter());
-        CharacterDatabase.Execute(stmt);
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_RESTORE_DELETE_INFO);
+    stmt->setString(0, undeleteInfo->Name);
+    stmt->setUInt32(1, GetAccountId());
+    stmt->setUInt64(2, undeleteInfo->CharacterGuid.GetCounter());
+    CharacterDatabase.Execute(stmt);
 
-        LoginDatabasePreparedStatement* loginStmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_LAST_CHAR_UNDELETE);
-        loginStmt->setUInt32(0, GetBattlenetAccountId());
-        LoginDatabase.Execute(loginStmt);
+    loginStmt = LoginDatabase.GetPreparedStatement(LOGIN_UPD_LAST_CHAR_UNDELETE);
+    loginStmt->setUInt32(0, GetBattlenetAccountId());
+    LoginDatabase.Execute(loginStmt);
 
-        sCharacterCache->UpdateCharacterInfoDeleted(undeleteInfo->CharacterGuid, false, undeleteInfo->Name);
+    sCharacterCache->UpdateCharacterInfoDeleted(undeleteInfo->CharacterGuid, false, undeleteInfo->Name);
 
-        SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_OK, undeleteInfo.get());
-    }));
+    SendUndeleteCharacterResponse(CHARACTER_UNDELETE_RESULT_OK, undeleteInfo.get());
 }
 
 void WorldSession::HandleSavePersonalEmblem(WorldPackets::Character::SavePersonalEmblem const& savePersonalEmblem)
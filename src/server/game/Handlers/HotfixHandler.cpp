@@ -16,7 +16,6 @@
  */
 
 #include "WorldSession.h"
-#include "Containers.h"
 #include "DB2Stores.h"
 #include "GameTime.h"
 #include "HotfixPackets.h"
@@ -76,49 +75,21 @@ void WorldSession::SendAvailableHotfixes()
 
 void WorldSession::HandleHotfixRequest(WorldPackets::Hotfix::HotfixRequest& hotfixQuery)
 {
-    DB2Manager::HotfixContainer const& hotfixes = sDB2Manager.GetHotfixData();
     WorldPackets::Hotfix::HotfixConnect hotfixQueryResponse;
     hotfixQueryResponse.Hotfixes.reserve(hotfixQuery.Hotfixes.size());
     for (int32 hotfixId : hotfixQuery.Hotfixes)
     {
-        if (DB2Manager::HotfixPush const* hotfixRecords = Trinity::Containers::MapGetValuePtr(hotfixes, hotfixId))
+        if (DB2Manager::HotfixPushContent const* pushContent = sDB2Manager.GetHotfixPushContent(hotfixId, GetSessionDbcLocale()))
         {
-            for (DB2Manager::HotfixRecord const& hotfixRecord : hotfixRecords->Records)
+            for (DB2Manager::HotfixPushRecord const& record : pushContent->Records)
             {
-                if (!(hotfixRecord.AvailableLocalesMask & (1 << GetSessionDbcLocale())))
-                    continue;
-
                 WorldPackets::Hotfix::HotfixConnect::HotfixData& hotfixData = hotfixQueryResponse.Hotfixes.emplace_back();
-                hotfixData.Record = hotfixRecord;
-                if (hotfixRecord.HotfixStatus == DB2Manager::HotfixRecord::Status::Valid)
-                {
-                    DB2StorageBase const* storage = sDB2Manager.GetStorage(hotfixRecord.TableHash);
-                    if (storage && storage->HasRecord(uint32(hotfixRecord.RecordID)))
-                    {
-                        std::size_t pos = hotfixQueryResponse.HotfixContent.size();
-                        storage->WriteRecord(uint32(hotfixRecord.RecordID), GetSessionDbcLocale(), hotfixQueryResponse.HotfixContent);
-
-                        if (std::vector<DB2Manager::HotfixOptionalData> const* optionalDataEntries = sDB2Manager.GetHotfixOptionalData(hotfixRecord.TableHash, hotfixRecord.RecordID, GetSessionDbcLocale()))
-                        {
-                            for (DB2Manager::HotfixOptionalData const& optionalData : *optionalDataEntries)
-                            {
-                                hotfixQueryResponse.HotfixContent << uint32(optionalData.Key);
-                                hotfixQueryResponse.HotfixContent.append(optionalData.Data.data(), optionalData.Data.size());
-                            }
-                        }
-
-                        hotfixData.Size = hotfixQueryResponse.HotfixContent.size() - pos;
-                    }
-                    else if (std::vector<uint8> const* blobData = sDB2Manager.GetHotfixBlobData(hotfixRecord.TableHash, hotfixRecord.RecordID, GetSessionDbcLocale()))
-                    {
-                        hotfixData.Size = blobData->size();
-                        hotfixQueryResponse.HotfixContent.append(blobData->data(), blobData->size());
-                    }
-                    else
-                        // Do not send Status::Valid when we don't have a hotfix blob for current locale
-                        hotfixData.Record.HotfixStatus = storage ? DB2Manager::HotfixRecord::Status::RecordRemoved : DB2Manager::HotfixRecord::Status::Invalid;
-                }
+                hotfixData.Record = record.Record;
+                hotfixData.Size = record.Size;
             }
+
+            if (!pushContent->Content.empty())
+                hotfixQueryResponse.HotfixContent.append(pushContent->Content.data(), pushContent->Content.size());
         }
     }
 
@@ -883,6 +883,7 @@ void WorldSession::HandleWrapItem(WorldPackets::Item::WrapItem& packet)
     stmt->setUInt32(3, item->m_itemData->DynamicFlags);
     trans->Append(stmt);
 
+    uint32 previousEntry = item->GetEntry();
     item->SetEntry(gift->GetEntry());
 
     switch (item->GetEntry())
@@ -909,6 +910,8 @@ void WorldSession::HandleWrapItem(WorldPackets::Item::WrapItem& packet)
             break;
     }
 
+    _player->UpdateItemEntryIndex(item, previousEntry);
+
     item->SetGiftCreator(_player->GetGUID());
     item->ReplaceAllItemFlags(ITEM_FIELD_FLAG_WRAPPED);
     item->SetState(ITEM_CHANGED, _player);
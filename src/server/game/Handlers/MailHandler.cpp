@@ -33,8 +33,56 @@
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Player.h"
+#include "QueryHolder.h"
 #include "World.h"
 
+class MailedItemsLoadQueryHolder : public CharacterDatabaseQueryHolder
+{
+public:
+    enum
+    {
+        ITEMS,
+        ARTIFACT,
+        AZERITE,
+        AZERITE_MILESTONE_POWER,
+        AZERITE_UNLOCKED_ESSENCE,
+        AZERITE_EMPOWERED,
+
+        MAX
+    };
+
+    MailedItemsLoadQueryHolder(ObjectGuid::LowType receiverGuid)
+    {
+        SetSize(MAX);
+
+        CharacterDatabasePreparedStatement* stmt;
+
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS);
+        stmt->setUInt64(0, receiverGuid);
+        SetPreparedQuery(ITEMS, stmt);
+
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_ARTIFACT);
+        stmt->setUInt64(0, receiverGuid);
+        SetPreparedQuery(ARTIFACT, stmt);
+
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE);
+        stmt->setUInt64(0, receiverGuid);
+        SetPreparedQuery(AZERITE, stmt);
+
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE_MILESTONE_POWER);
+        stmt->setUInt64(0, receiverGuid);
+        SetPreparedQuery(AZERITE_MILESTONE_POWER, stmt);
+
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE_UNLOCKED_ESSENCE);
+        stmt->setUInt64(0, receiverGuid);
+        SetPreparedQuery(AZERITE_UNLOCKED_ESSENCE, stmt);
+
+        stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_MAILITEMS_AZERITE_EMPOWERED);
+        stmt->setUInt64(0, receiverGuid);
+        SetPreparedQuery(AZERITE_EMPOWERED, stmt);
+    }
+};
+
 bool WorldSession::CanOpenMailBox(ObjectGuid guid)
 {
     if (guid == _player->GetGUID())
@@ -376,7 +424,8 @@ void WorldSession::HandleMailReturnToSender(WorldPackets::Mail::MailReturnToSend
 
     Player* player = _player;
     Mail* m = player->GetMail(returnToSender.MailID);
-    if (!m || m->state == MAIL_STATE_DELETED || m->deliver_time > GameTime::GetGameTime() || m->sender != returnToSender.SenderGUID.GetCounter())
+    if (!m || m->state == MAIL_STATE_DELETED || m->deliver_time > GameTime::GetGameTime() || m->sender != returnToSender.SenderGUID.GetCounter()
+        || (m->HasItems() && !player->IsMailedItemsLoaded()))
     {
         player->SendMailResult(returnToSender.MailID, MAIL_RETURNED_TO_SENDER, MAIL_ERR_INTERNAL_ERROR);
         return;
@@ -451,6 +500,11 @@ void WorldSession::HandleMailTakeItem(WorldPackets::Mail::MailTakeItem& takeItem
     }
 
     Item* it = player->GetMItem(takeItem.AttachID);
+    if (!it)
+    {
+        player->SendMailResult(takeItem.MailID, MAIL_ITEM_TAKEN, MAIL_ERR_INTERNAL_ERROR);
+        return;
+    }
 
     ItemPosCountVec dest;
     uint8 msg = _player->CanStoreItem(NULL_BAG, NULL_SLOT, dest, it, false);
@@ -559,6 +613,38 @@ void WorldSession::HandleGetMailList(WorldPackets::Mail::MailGetList& getList)
         return;
 
     Player* player = _player;
+    if (player->IsMailedItemsLoaded())
+    {
+        SendMailList(getList.Mailbox);
+        return;
+    }
+
+    // the list is sent once the attachments are loaded, repeated requests in the meantime are dropped
+    if (player->IsMailedItemsLoading())
+        return;
+
+    player->SetMailedItemsLoading();
+    AddQueryHolderCallback(CharacterDatabase.DelayQueryHolder(std::make_shared<MailedItemsLoadQueryHolder>(player->GetGUID().GetCounter())))
+        .AfterComplete([this, player, mailbox = getList.Mailbox](SQLQueryHolderBase const& holder)
+    {
+        if (GetPlayer() != player)
+            return;
+
+        player->LoadMailedItems(holder.GetPreparedResult(MailedItemsLoadQueryHolder::ITEMS),
+            holder.GetPreparedResult(MailedItemsLoadQueryHolder::ARTIFACT),
+            holder.GetPreparedResult(MailedItemsLoadQueryHolder::AZERITE),
+            holder.GetPreparedResult(MailedItemsLoadQueryHolder::AZERITE_MILESTONE_POWER),
+            holder.GetPreparedResult(MailedItemsLoadQueryHolder::AZERITE_UNLOCKED_ESSENCE),
+            holder.GetPreparedResult(MailedItemsLoadQueryHolder::AZERITE_EMPOWERED));
+
+        if (CanOpenMailBox(mailbox))
+            SendMailList(mailbox);
+    });
+}
+
+void WorldSession::SendMailList(ObjectGuid mailbox)
+{
+    Player* player = _player;
 
     WorldPackets::Mail::MailListResult response;
     time_t curTime = GameTime::GetGameTime();
@@ -577,7 +663,7 @@ void WorldSession::HandleGetMailList(WorldPackets::Mail::MailGetList& getList)
     }
 
     player->PlayerTalkClass->GetInteractionData().Reset();
-    player->PlayerTalkClass->GetInteractionData().SourceGuid = getList.Mailbox;
+    player->PlayerTalkClass->GetInteractionData().SourceGuid = mailbox;
     SendPacket(response.Write());
 
     // recalculate m_nextMailDelivereTime and unReadMails
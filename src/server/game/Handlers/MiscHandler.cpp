@@ -141,49 +141,43 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
     WorldPackets::Who::WhoResponsePkt response;
     response.RequestID = whoRequest.RequestID;
 
-    WhoListInfoVector const& whoList = sWhoListStorageMgr->GetWhoList();
-    for (WhoListPlayerInfo const& target : whoList)
+    // returns false once the response is full
+    auto addIfMatching = [&](WhoListPlayerInfo const& target)
     {
         // player can see member of other team only if has RBAC_PERM_TWO_SIDE_WHO_LIST
         if (target.GetTeam() != team && !HasPermission(rbac::RBAC_PERM_TWO_SIDE_WHO_LIST))
-            continue;
+            return true;
 
         // player can see MODERATOR, GAME MASTER, ADMINISTRATOR only if has RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS
         if (target.GetSecurity() > AccountTypes(gmLevelInWhoList) && !HasPermission(rbac::RBAC_PERM_WHO_SEE_ALL_SEC_LEVELS))
-            continue;
+            return true;
 
         // check if target is globally visible for player
         if (_player->GetGUID() != target.GetGuid() && !target.IsVisible())
             if (AccountMgr::IsPlayerAccount(_player->GetSession()->GetSecurity()) || target.GetSecurity() > _player->GetSession()->GetSecurity())
-                continue;
+                return true;
 
         // check if target's level is in level range
         uint8 lvl = target.GetLevel();
         if (lvl < request.MinLevel || lvl > request.MaxLevel)
-            continue;
+            return true;
 
         // check if class matches classmask
         if (request.ClassFilter >= 0 && !(request.ClassFilter & (1 << target.GetClass())))
-            continue;
+            return true;
 
         // check if race matches racemask
         if (!request.RaceFilter.HasRace(target.GetRace()))
-            continue;
-
-        if (!whoRequest.Areas.empty())
-        {
-            if (std::find(whoRequest.Areas.begin(), whoRequest.Areas.end(), int32(target.GetZoneId())) == whoRequest.Areas.end())
-                continue;
-        }
+            return true;
 
         std::wstring const& wTargetName = target.GetWidePlayerName();
         if (!(wPlayerName.empty() || wTargetName.find(wPlayerName) != std::wstring::npos))
-            continue;
+            return true;
 
         std::wstring const& wTargetGuildName = target.GetWideGuildName();
 
         if (!wGuildName.empty() && wTargetGuildName.find(wGuildName) == std::wstring::npos)
-            continue;
+            return true;
 
         if (!wWords.empty())
         {
@@ -207,12 +201,12 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
             }
 
             if (!show)
-                continue;
+                return true;
         }
 
         WorldPackets::Who::WhoEntry whoEntry;
         if (!whoEntry.PlayerData.Initialize(target.GetGuid(), nullptr))
-            continue;
+            return true;
 
         if (!target.GetGuildGuid().IsEmpty())
         {
@@ -228,8 +222,43 @@ void WorldSession::HandleWhoOpcode(WorldPackets::Who::WhoRequestPkt& whoRequest)
 
         // 50 is maximum player count sent to client - can be overridden
         // through config, but is unstable
-        if (response.Response.Entries.size() >= sWorld->getIntConfig(CONFIG_MAX_WHO))
-            break;
+        return response.Response.Entries.size() < sWorld->getIntConfig(CONFIG_MAX_WHO);
+    };
+
+    // the who list is sorted by level and indexed by zone, only players in the requested level range and zones are visited
+    uint8 minLevel = uint8(std::clamp<int32>(request.MinLevel, 0, STRONG_MAX_LEVEL));
+    uint8 maxLevel = uint8(std::clamp<int32>(request.MaxLevel, 0, STRONG_MAX_LEVEL));
+    if (!whoRequest.Areas.empty())
+    {
+        std::vector<int32> areas(whoRequest.Areas.begin(), whoRequest.Areas.end());
+        std::sort(areas.begin(), areas.end());
+        areas.erase(std::unique(areas.begin(), areas.end()), areas.end());
+
+        WhoListInfoVector const& whoList = sWhoListStorageMgr->GetWhoList();
+        bool full = false;
+        for (int32 areaId : areas)
+        {
+            WhoListIndexVector const* zonePlayers = sWhoListStorageMgr->GetPlayersInZone(uint32(areaId));
+            if (!zonePlayers)
+                continue;
+
+            auto itr = std::lower_bound(zonePlayers->begin(), zonePlayers->end(), minLevel, [&whoList](uint32 index, uint8 level)
+            {
+                return whoList[index].GetLevel() < level;
+            });
+
+            for (; itr != zonePlayers->end() && whoList[*itr].GetLevel() <= maxLevel && !full; ++itr)
+                full = !addIfMatching(whoList[*itr]);
+
+            if (full)
+                break;
+        }
+    }
+    else
+    {
+        for (WhoListPlayerInfo const& target : sWhoListStorageMgr->GetPlayersInLevelRange(minLevel, maxLevel))
+            if (!addIfMatching(target))
+                break;
     }
 
     SendPacket(response.Write());
@@ -17,10 +17,12 @@
 
 #include "WorldSession.h"
 #include "Battleground.h"
+#include "CellImpl.h"
 #include "Corpse.h"
 #include "DB2Stores.h"
 #include "FlightPathMovementGenerator.h"
 #include "GameTime.h"
+#include "GridNotifiersImpl.h"
 #include "Garrison.h"
 #include "InstanceLockMgr.h"
 #include "InstancePackets.h"
@@ -36,6 +38,7 @@
 #include "MoveSpline.h"
 #include "Transport.h"
 #include "Vehicle.h"
+#include "World.h"
 #include "SpellMgr.h"
 #include <boost/accumulators/statistics/variance.hpp>
 #include <boost/accumulators/accumulators.hpp>
@@ -453,7 +456,10 @@ void WorldSession::HandleMovementOpcode(OpcodeClient opcode, MovementInfo& movem
 
     WorldPackets::Movement::MoveUpdate moveUpdate;
     moveUpdate.Status = &mover->m_movementInfo;
-    mover->SendMessageToSet(moveUpdate.Write(), _player);
+    if (opcode == CMSG_MOVE_HEARTBEAT)
+        SendMovementHeartbeatToSet(mover, moveUpdate.Write());
+    else
+        mover->SendMessageToSet(moveUpdate.Write(), _player);
 
     if (plrMover)                                            // nothing is charmed, or player charmed
     {
@@ -583,6 +589,31 @@ void WorldSession::HandleForceSpeedChangeAck(WorldPackets::Movement::MovementSpe
     }
 }
 
+void WorldSession::SendMovementHeartbeatToSet(Unit const* mover, WorldPacket const* data)
+{
+    float nearDistance = float(sWorld->getIntConfig(CONFIG_MOVEMENT_RELAY_LOD_NEAR_DISTANCE));
+    float farDistance = float(sWorld->getIntConfig(CONFIG_MOVEMENT_RELAY_LOD_FAR_DISTANCE));
+    if (nearDistance <= 0.0f && farDistance <= 0.0f)
+    {
+        mover->SendMessageToSet(data, _player);
+        return;
+    }
+
+    // heartbeats only refresh the position of a movement already announced by the start/stop opcodes,
+    // far observers interpolate between the ones they get and still receive every state change
+    if (mover != _player)
+        if (Player const* plrMover = mover->ToPlayer())
+            plrMover->SendDirectMessage(data);
+
+    Trinity::PacketSenderDistanceLod sender(data, mover, _moveHeartbeatSequence++);
+    sender.Bands[0] = { nearDistance * nearDistance, sWorld->getIntConfig(CONFIG_MOVEMENT_RELAY_LOD_NEAR_INTERVAL) };
+    sender.Bands[1] = { farDistance * farDistance, sWorld->getIntConfig(CONFIG_MOVEMENT_RELAY_LOD_FAR_INTERVAL) };
+
+    float dist = mover->GetVisibilityRange();
+    Trinity::MessageDistDeliverer<Trinity::PacketSenderDistanceLod> notifier(mover, sender, dist, false, _player);
+    Cell::VisitWorldObjects(mover, notifier, dist);
+}
+
 void WorldSession::HandleSetActiveMoverOpcode(WorldPackets::Movement::SetActiveMover& packet)
 {
     if (GetPlayer()->IsInWorld())
@@ -182,8 +182,10 @@ void WorldSession::HandleOpenWrappedItemCallback(uint16 pos, ObjectGuid itemGuid
     uint32 entry = fields[0].GetUInt32();
     uint32 flags = fields[1].GetUInt32();
 
+    uint32 previousEntry = item->GetEntry();
     item->SetGiftCreator(ObjectGuid::Empty);
     item->SetEntry(entry);
+    GetPlayer()->UpdateItemEntryIndex(item, previousEntry);
     item->ReplaceAllItemFlags(ItemFieldFlags(flags));
     item->SetMaxDurability(item->GetTemplate()->MaxDurability);
     item->SetState(ITEM_CHANGED, GetPlayer());
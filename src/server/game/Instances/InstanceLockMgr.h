@@ -24,6 +24,7 @@
 #include "Hash.h"
 #include "ObjectGuid.h"
 #include "Optional.h"
+#include <array>
 #include <shared_mutex>
 #include <unordered_map>
 
@@ -305,12 +306,24 @@ private:
     using PlayerLockMap = std::unordered_map<InstanceLockKey, std::unique_ptr<InstanceLock>>;
     using LockMap = std::unordered_map<ObjectGuid, PlayerLockMap>;
 
+    // players are spread over shards with their own mutex so map threads updating locks of one raid
+    // do not block lock lookups for players in other instances
+    struct LockShard
+    {
+        mutable std::shared_mutex Mutex;
+        LockMap TemporaryInstanceLocksByPlayer; // locks stored here before any boss gets killed
+        LockMap InstanceLocksByPlayer;
+    };
+
+    static constexpr std::size_t LockShardCount = 16;
+
+    LockShard& GetLockShard(ObjectGuid const& playerGuid) { return _lockShards[playerGuid.GetCounter() % LockShardCount]; }
+    LockShard const& GetLockShard(ObjectGuid const& playerGuid) const { return _lockShards[playerGuid.GetCounter() % LockShardCount]; }
+
     static InstanceLock* FindInstanceLock(LockMap const& locks, ObjectGuid const& playerGuid, MapDb2Entries const& entries);
     InstanceLock* FindActiveInstanceLock(ObjectGuid const& playerGuid, MapDb2Entries const& entries, bool ignoreTemporary, bool ignoreExpired) const;
 
-    mutable std::shared_mutex _locksMutex;
-    LockMap _temporaryInstanceLocksByPlayer; // locks stored here before any boss gets killed
-    LockMap _instanceLocksByPlayer;
+    std::array<LockShard, LockShardCount> _lockShards;
     std::unordered_map<uint32, std::weak_ptr<SharedInstanceLockData>> _instanceLockDataById;
     bool _unloading = false;
 };
@@ -839,7 +839,8 @@ void Loot::AddItem(LootStoreItem const& item)
         generatedLoot.context = _itemContext;
         generatedLoot.count = std::min(count, proto->GetMaxStackSize());
         generatedLoot.LootListId = items.size();
-        generatedLoot.BonusListIDs = ItemBonusMgr::GetBonusListsForItem(generatedLoot.itemid, _itemContext);
+        std::span<int32 const> bonusListIDs = ItemBonusMgr::GetBonusListsForItem(generatedLoot.itemid, _itemContext);
+        generatedLoot.BonusListIDs.assign(bonusListIDs.begin(), bonusListIDs.end());
 
         items.push_back(generatedLoot);
         count -= proto->GetMaxStackSize();
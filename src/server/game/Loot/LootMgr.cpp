@@ -23,6 +23,7 @@
 #include "ItemTemplate.h"
 #include "Log.h"
 #include "Loot.h"
+#include "MemoryUsage.h"
 #include "ObjectMgr.h"
 #include "Player.h"
 #include "Random.h"
@@ -96,6 +97,7 @@ class LootTemplate::LootGroup                               // A set of loot def
             Player const* personalLooter = nullptr) const;  // Rolls an item from the group (if any) and adds the item to the loot
         float RawTotalChance() const;                       // Overall chance for the group (without equal chanced items)
         float TotalChance() const;                          // Overall chance for the group
+        std::size_t GetMemoryUsage() const;
 
         void Verify(LootStore const& lootstore, uint32 id, uint8 group_id) const;
         void CheckLootRefs(LootTemplateMap const& store, LootIdSet* ref_set) const;
@@ -104,6 +106,9 @@ class LootTemplate::LootGroup                               // A set of loot def
     private:
         LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
         LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
+        std::vector<float> ExplicitlyChancedRollLimits;     // Running sum of explicit chances, rolled with a binary search when every entry is eligible
+        uint16 ExplicitlyChancedLootModes = 0xFFFF;         // Loot modes shared by all explicitly chanced entries
+        uint16 EqualChancedLootModes = 0xFFFF;              // Loot modes shared by all equal chanced entries
 
         // Rolls an item from the group, returns NULL if all miss their chances
         LootStoreItem const* Roll(uint16 lootMode, Player const* personalLooter = nullptr) const;
@@ -226,6 +231,14 @@ LootTemplate const* LootStore::GetLootFor(uint32 loot_id) const
     return tab->second;
 }
 
+std::size_t LootStore::GetMemoryUsage() const
+{
+    return Trinity::MemoryUsage::Of(m_LootTemplates, [](LootTemplateMap::value_type const& lootTemplate)
+    {
+        return sizeof(LootTemplate) + lootTemplate.second->GetMemoryUsage();
+    });
+}
+
 LootTemplate* LootStore::GetLootForConditionFill(uint32 loot_id)
 {
     LootTemplateMap::iterator tab = m_LootTemplates.find(loot_id);
@@ -363,36 +376,70 @@ LootTemplate::LootGroup::~LootGroup()
 void LootTemplate::LootGroup::AddEntry(LootStoreItem* item)
 {
     if (item->chance != 0)
+    {
         ExplicitlyChanced.push_back(item);
+        ExplicitlyChancedRollLimits.push_back((ExplicitlyChancedRollLimits.empty() ? 0.0f : ExplicitlyChancedRollLimits.back()) + item->chance);
+        ExplicitlyChancedLootModes &= item->lootmode;
+    }
     else
+    {
         EqualChanced.push_back(item);
+        EqualChancedLootModes &= item->lootmode;
+    }
 }
 
 // Rolls an item from the group, returns NULL if all miss their chances
 LootStoreItem const* LootTemplate::LootGroup::Roll(uint16 lootMode, Player const* personalLooter /*= nullptr*/) const
 {
-    LootStoreItemList possibleLoot = ExplicitlyChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(lootMode, personalLooter));
+    LootGroupInvalidSelector isInvalid(lootMode, personalLooter);
 
-    if (!possibleLoot.empty())                             // First explicitly chanced entries are checked
+    if (!ExplicitlyChanced.empty())                         // First explicitly chanced entries are checked
     {
         float roll = rand_chance();
 
-        for (LootStoreItemList::const_iterator itr = possibleLoot.begin(); itr != possibleLoot.end(); ++itr)   // check each explicitly chanced entry in the template and modify its chance based on quality.
+        if (!personalLooter && (ExplicitlyChancedLootModes & lootMode))
         {
-            LootStoreItem* item = *itr;
-            if (item->chance >= 100.0f)
-                return item;
+            // every entry takes part in the roll, find the first one whose running chance exceeds the roll
+            auto itr = std::upper_bound(ExplicitlyChancedRollLimits.begin(), ExplicitlyChancedRollLimits.end(), roll);
+            if (itr != ExplicitlyChancedRollLimits.end())
+                return ExplicitlyChanced[std::distance(ExplicitlyChancedRollLimits.begin(), itr)];
+        }
+        else
+        {
+            for (LootStoreItem const* item : ExplicitlyChanced)   // check each explicitly chanced entry in the template and modify its chance based on quality.
+            {
+                if (isInvalid(item))
+                    continue;
 
-            roll -= item->chance;
-            if (roll < 0)
-                return item;
+                if (item->chance >= 100.0f)
+                    return item;
+
+                roll -= item->chance;
+                if (roll < 0)
+                    return item;
+            }
         }
     }
 
-    possibleLoot = EqualChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(lootMode, personalLooter));
-    if (!possibleLoot.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
+    if (EqualChanced.empty())
+        return nullptr;                                     // Empty drop from the group
+
+    // If nothing selected yet - an item is taken from equal-chanced part
+    if (!personalLooter && (EqualChancedLootModes & lootMode))
+        return Trinity::Containers::SelectRandomContainerElement(EqualChanced);
+
+    // a few random picks find an eligible entry without checking all of them, rejected picks keep the selection uniform
+    for (uint32 attempt = 0; attempt < 3; ++attempt)
+    {
+        LootStoreItem const* item = Trinity::Containers::SelectRandomContainerElement(EqualChanced);
+        if (!isInvalid(item))
+            return item;
+    }
+
+    LootStoreItemList possibleLoot;
+    possibleLoot.reserve(EqualChanced.size());
+    std::remove_copy_if(EqualChanced.begin(), EqualChanced.end(), std::back_inserter(possibleLoot), isInvalid);
+    if (!possibleLoot.empty())
         return Trinity::Containers::SelectRandomContainerElement(possibleLoot);
 
     return nullptr;                                            // Empty drop from the group
@@ -473,6 +520,13 @@ float LootTemplate::LootGroup::TotalChance() const
     return result;
 }
 
+std::size_t LootTemplate::LootGroup::GetMemoryUsage() const
+{
+    std::size_t size = Trinity::MemoryUsage::Of(ExplicitlyChanced) + Trinity::MemoryUsage::Of(EqualChanced);
+    size += (ExplicitlyChanced.size() + EqualChanced.size()) * sizeof(LootStoreItem);
+    return size;
+}
+
 void LootTemplate::LootGroup::Verify(LootStore const& lootstore, uint32 id, uint8 group_id) const
 {
     float chance = RawTotalChance();
@@ -523,6 +577,16 @@ LootTemplate::~LootTemplate()
         delete Groups[i];
 }
 
+std::size_t LootTemplate::GetMemoryUsage() const
+{
+    std::size_t size = Trinity::MemoryUsage::Of(Entries) + Entries.size() * sizeof(LootStoreItem) + Trinity::MemoryUsage::Of(Groups);
+    for (LootGroup const* group : Groups)
+        if (group)
+            size += sizeof(LootGroup) + group->GetMemoryUsage();
+
+    return size;
+}
+
 // Adds an entry to the group (at loading stage)
 void LootTemplate::AddEntry(LootStoreItem* item)
 {
@@ -1350,3 +1414,11 @@ void LoadLootTables()
 
     LoadLootTemplates_Reference();
 }
+
+void GetLootMemoryUsage(Trinity::MemoryUsageReport& report)
+{
+    for (LootStore const* store : { &LootTemplates_Creature, &LootTemplates_Fishing, &LootTemplates_Gameobject, &LootTemplates_Item,
+        &LootTemplates_Mail, &LootTemplates_Milling, &LootTemplates_Pickpocketing, &LootTemplates_Reference, &LootTemplates_Skinning,
+        &LootTemplates_Disenchant, &LootTemplates_Prospecting, &LootTemplates_Spell })
+        report.Add("LootMgr", store->GetName(), store->GetMemoryUsage());
+}
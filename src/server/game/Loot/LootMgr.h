@@ -21,7 +21,6 @@
 #include "Define.h"
 #include "ConditionMgr.h"
 #include "ObjectGuid.h"
-#include <list>
 #include <memory>
 #include <set>
 #include <unordered_map>
@@ -33,6 +32,10 @@ class Player;
 struct Loot;
 struct LootItem;
 struct MapDifficultyEntry;
+namespace Trinity
+{
+class MemoryUsageReport;
+}
 enum LootType : uint8;
 enum class ItemContext : uint8;
 
@@ -59,7 +62,7 @@ struct TC_GAME_API LootStoreItem
     bool IsValid(LootStore const& store, uint32 entry) const; // Checks correctness of values
 };
 
-typedef std::list<LootStoreItem*> LootStoreItemList;
+typedef std::vector<LootStoreItem*> LootStoreItemList;
 typedef std::unordered_map<uint32, LootTemplate*> LootTemplateMap;
 
 typedef std::set<uint32> LootIdSet;
@@ -87,6 +90,9 @@ class TC_GAME_API LootStore
         LootTemplate const* GetLootFor(uint32 loot_id) const;
         LootTemplate* GetLootForConditionFill(uint32 loot_id);
 
+        // estimate of the memory used by all templates of the store
+        std::size_t GetMemoryUsage() const;
+
         char const* GetName() const { return m_name; }
         char const* GetEntryName() const { return m_entryName; }
         bool IsRatesAllowed() const { return m_ratesAllowed; }
@@ -129,6 +135,8 @@ class TC_GAME_API LootTemplate
         bool LinkConditions(ConditionId const& id, ConditionsReference reference);
         bool isReference(uint32 id);
 
+        std::size_t GetMemoryUsage() const;
+
     private:
         LootStoreItemList Entries;                          // not grouped only
         LootGroups        Groups;                           // groups have own (optimised) processing, grouped entries go there
@@ -173,6 +181,9 @@ TC_GAME_API void LoadLootTemplates_Prospecting();
 TC_GAME_API void LoadLootTemplates_Spell();
 TC_GAME_API void LoadLootTemplates_Reference();
 
+// adds every loot store to the report
+TC_GAME_API void GetLootMemoryUsage(Trinity::MemoryUsageReport& report);
+
 TC_GAME_API void LoadLootTables();
 
 #endif
@@ -19,8 +19,110 @@
 #include "DB2Stores.h"
 #include "GridDefines.h"
 #include "Log.h"
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <G3D/Plane.h>
 #include <G3D/Ray.h>
+#include <cstdio>
+#include <cstring>
+
+// Reads a .map file either with stdio or from a read only mapping
+// arrays are returned in place from the mapping when their offset is suitably aligned, otherwise they are copied into memory owned by the GridMap
+class GridMap::FileReader
+{
+public:
+    FileReader(char const* filename, bool mapFile) : _file(nullptr), _position(0)
+    {
+        if (mapFile)
+        {
+            // mapping fails for missing and empty files, those are handled by the regular file access below
+            try
+            {
+                _mapping = std::make_unique<boost::iostreams::mapped_file_source>(filename);
+                return;
+            }
+            catch (std::exception const&)
+            {
+                _mapping = nullptr;
+            }
+        }
+
+        _file = fopen(filename, "rb");
+    }
+
+    FileReader(FileReader const&) = delete;
+    FileReader& operator=(FileReader const&) = delete;
+
+    ~FileReader()
+    {
+        if (_file)
+            fclose(_file);
+    }
+
+    bool IsOpen() const { return _mapping || _file; }
+
+    bool Seek(uint32 offset)
+    {
+        if (_mapping)
+        {
+            if (offset > _mapping->size())
+                return false;
+
+            _position = offset;
+            return true;
+        }
+
+        return fseek(_file, offset, SEEK_SET) == 0;
+    }
+
+    template<typename T>
+    bool Read(T* destination, std::size_t count = 1)
+    {
+        if (_mapping)
+        {
+            if (_position + sizeof(T) * count > _mapping->size())
+                return false;
+
+            memcpy(destination, _mapping->data() + _position, sizeof(T) * count);
+            _position += sizeof(T) * count;
+            return true;
+        }
+
+        return fread(destination, sizeof(T), count, _file) == count;
+    }
+
+    template<typename T>
+    T const* ReadArray(GridMap& owner, std::size_t count)
+    {
+        if (_mapping)
+        {
+            if (_position + sizeof(T) * count > _mapping->size())
+                return nullptr;
+
+            char const* data = _mapping->data() + _position;
+            if (reinterpret_cast<uintptr_t>(data) % alignof(T) == 0)
+            {
+                _position += sizeof(T) * count;
+                return reinterpret_cast<T const*>(data);
+            }
+        }
+
+        std::unique_ptr<uint8[]>& storage = owner._ownedData.emplace_back(new uint8[sizeof(T) * count]);
+        owner._ownedDataSize += sizeof(T) * count;
+        T* array = reinterpret_cast<T*>(storage.get());
+        if (!Read(array, count))
+            return nullptr;
+
+        return array;
+    }
+
+    // hands the mapping over to the grid that uses its data in place
+    std::unique_ptr<boost::iostreams::mapped_file_source> ReleaseMapping() { return std::move(_mapping); }
+
+private:
+    FILE* _file;
+    std::unique_ptr<boost::iostreams::mapped_file_source> _mapping;
+    std::size_t _position;
+};
 
 // *****************************
 // Grid function
@@ -50,6 +152,7 @@ GridMap::GridMap()
     _liquidFlags = nullptr;
     _liquidMap  = nullptr;
     _holes = nullptr;
+    _ownedDataSize = 0;
 }
 
 GridMap::~GridMap()
@@ -57,22 +160,19 @@ GridMap::~GridMap()
     unloadData();
 }
 
-GridMap::LoadResult GridMap::loadData(char const* filename)
+GridMap::LoadResult GridMap::loadData(char const* filename, bool mapFile /*= false*/)
 {
     // Unload old data if exist
     unloadData();
 
     map_fileheader header;
     // Not return error if file not found
-    FILE* in = fopen(filename, "rb");
-    if (!in)
+    FileReader in(filename, mapFile);
+    if (!in.IsOpen())
         return LoadResult::FileDoesNotExist;
 
-    if (fread(&header, sizeof(header), 1, in) != 1)
-    {
-        fclose(in);
+    if (!in.Read(&header))
         return LoadResult::InvalidFile;
-    }
 
     if (header.mapMagic == MapMagic && header.versionMagic == MapVersionMagic)
     {
@@ -80,50 +180,45 @@ GridMap::LoadResult GridMap::loadData(char const* filename)
         if (header.areaMapOffset && !loadAreaData(in, header.areaMapOffset, header.areaMapSize))
         {
             TC_LOG_ERROR("maps", "Error loading map area data\n");
-            fclose(in);
+            unloadData();
             return LoadResult::InvalidFile;
         }
         // load up height data
         if (header.heightMapOffset && !loadHeightData(in, header.heightMapOffset, header.heightMapSize))
         {
             TC_LOG_ERROR("maps", "Error loading map height data\n");
-            fclose(in);
+            unloadData();
             return LoadResult::InvalidFile;
         }
         // load up liquid data
         if (header.liquidMapOffset && !loadLiquidData(in, header.liquidMapOffset, header.liquidMapSize))
         {
             TC_LOG_ERROR("maps", "Error loading map liquids data\n");
-            fclose(in);
+            unloadData();
             return LoadResult::InvalidFile;
         }
         // loadup holes data (if any. check header.holesOffset)
         if (header.holesSize && !loadHolesData(in, header.holesOffset, header.holesSize))
         {
             TC_LOG_ERROR("maps", "Error loading map holes data\n");
-            fclose(in);
+            unloadData();
             return LoadResult::InvalidFile;
         }
-        fclose(in);
+        _mapping = in.ReleaseMapping();
         return LoadResult::Ok;
     }
 
     TC_LOG_ERROR("maps", "Map file '{}' is from an incompatible map version ({} v{}), {} v{} is expected. Please pull your source, recompile tools and recreate maps using the updated mapextractor, then replace your old map files with new files. If you still have problems search on forum for error TCE00018.",
         filename, std::string_view(header.mapMagic.data(), 4), header.versionMagic, std::string_view(MapMagic.data(), 4), MapVersionMagic);
-    fclose(in);
     return LoadResult::InvalidFile;
 }
 
 void GridMap::unloadData()
 {
-    delete[] _areaMap;
-    delete[] m_V9;
-    delete[] m_V8;
     delete[] _minHeightPlanes;
-    delete[] _liquidEntry;
-    delete[] _liquidFlags;
-    delete[] _liquidMap;
-    delete[] _holes;
+    _ownedData.clear();
+    _ownedDataSize = 0;
+    _mapping = nullptr;
     _areaMap = nullptr;
     m_V9 = nullptr;
     m_V8 = nullptr;
@@ -135,30 +230,35 @@ void GridMap::unloadData()
     _gridGetHeight = &GridMap::getHeightFromFlat;
 }
 
-bool GridMap::loadAreaData(FILE* in, uint32 offset, uint32 /*size*/)
+std::size_t GridMap::GetMemoryUsage() const
 {
-    map_areaHeader header;
-    fseek(in, offset, SEEK_SET);
+    std::size_t size = sizeof(GridMap) + _ownedDataSize + _ownedData.capacity() * sizeof(std::unique_ptr<uint8[]>);
+    if (_minHeightPlanes)
+        size += sizeof(G3D::Plane) * 8;
+
+    return size;
+}
 
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.areaMagic != MapAreaMagic)
+bool GridMap::loadAreaData(FileReader& in, uint32 offset, uint32 /*size*/)
+{
+    map_areaHeader header;
+    if (!in.Seek(offset) || !in.Read(&header) || header.areaMagic != MapAreaMagic)
         return false;
 
     _gridArea = header.gridArea;
     if (!header.flags.HasFlag(map_areaHeaderFlags::NoArea))
     {
-        _areaMap = new uint16[16 * 16];
-        if (fread(_areaMap, sizeof(uint16), 16*16, in) != 16*16)
+        _areaMap = in.ReadArray<uint16>(*this, 16 * 16);
+        if (!_areaMap)
             return false;
     }
     return true;
 }
 
-bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHeightData(FileReader& in, uint32 offset, uint32 /*size*/)
 {
     map_heightHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.heightMagic != MapHeightMagic)
+    if (!in.Seek(offset) || !in.Read(&header) || header.heightMagic != MapHeightMagic)
         return false;
 
     _gridHeight = header.gridHeight;
@@ -166,30 +266,27 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         if (header.flags.HasFlag(map_heightHeaderFlags::HeightAsInt16))
         {
-            m_uint16_V9 = new uint16 [129*129];
-            m_uint16_V8 = new uint16 [128*128];
-            if (fread(m_uint16_V9, sizeof(uint16), 129*129, in) != 129*129 ||
-                fread(m_uint16_V8, sizeof(uint16), 128*128, in) != 128*128)
+            m_uint16_V9 = in.ReadArray<uint16>(*this, 129 * 129);
+            m_uint16_V8 = in.ReadArray<uint16>(*this, 128 * 128);
+            if (!m_uint16_V9 || !m_uint16_V8)
                 return false;
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 65535;
             _gridGetHeight = &GridMap::getHeightFromUint16;
         }
         else if (header.flags.HasFlag(map_heightHeaderFlags::HeightAsInt8))
         {
-            m_uint8_V9 = new uint8 [129*129];
-            m_uint8_V8 = new uint8 [128*128];
-            if (fread(m_uint8_V9, sizeof(uint8), 129*129, in) != 129*129 ||
-                fread(m_uint8_V8, sizeof(uint8), 128*128, in) != 128*128)
+            m_uint8_V9 = in.ReadArray<uint8>(*this, 129 * 129);
+            m_uint8_V8 = in.ReadArray<uint8>(*this, 128 * 128);
+            if (!m_uint8_V9 || !m_uint8_V8)
                 return false;
             _gridIntHeightMultiplier = (header.gridMaxHeight - header.gridHeight) / 255;
             _gridGetHeight = &GridMap::getHeightFromUint8;
         }
         else
         {
-            m_V9 = new float [129*129];
-            m_V8 = new float [128*128];
-            if (fread(m_V9, sizeof(float), 129*129, in) != 129*129 ||
-                fread(m_V8, sizeof(float), 128*128, in) != 128*128)
+            m_V9 = in.ReadArray<float>(*this, 129 * 129);
+            m_V8 = in.ReadArray<float>(*this, 128 * 128);
+            if (!m_V9 || !m_V8)
                 return false;
             _gridGetHeight = &GridMap::getHeightFromFloat;
         }
@@ -201,8 +298,7 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     {
         std::array<int16, 9> maxHeights;
         std::array<int16, 9> minHeights;
-        if (fread(maxHeights.data(), sizeof(int16), maxHeights.size(), in) != maxHeights.size() ||
-            fread(minHeights.data(), sizeof(int16), minHeights.size(), in) != minHeights.size())
+        if (!in.Read(maxHeights.data(), maxHeights.size()) || !in.Read(minHeights.data(), minHeights.size()))
             return false;
 
         static uint32 constexpr indices[8][3] =
@@ -242,12 +338,10 @@ bool GridMap::loadHeightData(FILE* in, uint32 offset, uint32 /*size*/)
     return true;
 }
 
-bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadLiquidData(FileReader& in, uint32 offset, uint32 /*size*/)
 {
     map_liquidHeader header;
-    fseek(in, offset, SEEK_SET);
-
-    if (fread(&header, sizeof(header), 1, in) != 1 || header.liquidMagic != MapLiquidMagic)
+    if (!in.Seek(offset) || !in.Read(&header) || header.liquidMagic != MapLiquidMagic)
         return false;
 
     _liquidGlobalEntry = header.liquidType;
@@ -260,33 +354,30 @@ bool GridMap::loadLiquidData(FILE* in, uint32 offset, uint32 /*size*/)
 
     if (!header.flags.HasFlag(map_liquidHeaderFlags::NoType))
     {
-        _liquidEntry = new uint16[16*16];
-        if (fread(_liquidEntry, sizeof(uint16), 16*16, in) != 16*16)
+        _liquidEntry = in.ReadArray<uint16>(*this, 16 * 16);
+        if (!_liquidEntry)
             return false;
 
-        _liquidFlags = new map_liquidHeaderTypeFlags[16*16];
-        if (fread(_liquidFlags, sizeof(map_liquidHeaderTypeFlags), 16*16, in) != 16*16)
+        _liquidFlags = in.ReadArray<map_liquidHeaderTypeFlags>(*this, 16 * 16);
+        if (!_liquidFlags)
             return false;
     }
     if (!header.flags.HasFlag(map_liquidHeaderFlags::NoHeight))
     {
-        _liquidMap = new float[uint32(_liquidWidth) * uint32(_liquidHeight)];
-        if (fread(_liquidMap, sizeof(float), _liquidWidth*_liquidHeight, in) != (uint32(_liquidWidth) * uint32(_liquidHeight)))
+        _liquidMap = in.ReadArray<float>(*this, uint32(_liquidWidth) * uint32(_liquidHeight));
+        if (!_liquidMap)
             return false;
     }
     return true;
 }
 
-bool GridMap::loadHolesData(FILE* in, uint32 offset, uint32 /*size*/)
+bool GridMap::loadHolesData(FileReader& in, uint32 offset, uint32 /*size*/)
 {
-    if (fseek(in, offset, SEEK_SET) != 0)
+    if (!in.Seek(offset))
         return false;
 
-    _holes = new uint8[16 * 16 * 8];
-    if (fread(_holes, sizeof(uint8), 16 * 16 * 8, in) != 16 * 16 * 8)
-        return false;
-
-    return true;
+    _holes = in.ReadArray<uint8>(*this, 16 * 16 * 8);
+    return _holes != nullptr;
 }
 
 uint16 GridMap::getArea(float x, float y) const
@@ -410,7 +501,7 @@ float GridMap::getHeightFromUint8(float x, float y) const
         return INVALID_HEIGHT;
 
     int32 a, b, c;
-    uint8 *V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
+    uint8 const* V9_h1_ptr = &m_uint8_V9[x_int*128 + x_int + y_int];
     if (x+y < 1)
     {
         if (x > y)
@@ -480,7 +571,7 @@ float GridMap::getHeightFromUint16(float x, float y) const
         return INVALID_HEIGHT;
 
     int32 a, b, c;
-    uint16 *V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
+    uint16 const* V9_h1_ptr = &m_uint16_V9[x_int*128 + x_int + y_int];
     if (x+y < 1)
     {
         if (x > y)
@@ -21,26 +21,32 @@
 #include "Define.h"
 #include "MapDefines.h"
 #include "Optional.h"
-#include <cstdio>
+#include <memory>
+#include <vector>
 
 struct LiquidData;
 enum ZLiquidStatus : uint32;
 namespace G3D { class Plane; }
 
+namespace boost::iostreams
+{
+class mapped_file_source;
+}
+
 class TC_GAME_API GridMap
 {
     uint32  _flags;
     union
     {
-        float* m_V9;
-        uint16* m_uint16_V9;
-        uint8* m_uint8_V9;
+        float const* m_V9;
+        uint16 const* m_uint16_V9;
+        uint8 const* m_uint8_V9;
     };
     union
     {
-        float* m_V8;
-        uint16* m_uint16_V8;
-        uint8* m_uint8_V8;
+        float const* m_V8;
+        uint16 const* m_uint16_V8;
+        uint8 const* m_uint8_V8;
     };
     G3D::Plane* _minHeightPlanes;
     // Height level data
@@ -48,13 +54,13 @@ class TC_GAME_API GridMap
     float _gridIntHeightMultiplier;
 
     // Area data
-    uint16* _areaMap;
+    uint16 const* _areaMap;
 
     // Liquid data
     float _liquidLevel;
-    uint16* _liquidEntry;
-    map_liquidHeaderTypeFlags* _liquidFlags;
-    float* _liquidMap;
+    uint16 const* _liquidEntry;
+    map_liquidHeaderTypeFlags const* _liquidFlags;
+    float const* _liquidMap;
     uint16 _gridArea;
     uint16 _liquidGlobalEntry;
     map_liquidHeaderTypeFlags _liquidGlobalFlags;
@@ -63,12 +69,19 @@ class TC_GAME_API GridMap
     uint8 _liquidWidth;
     uint8 _liquidHeight;
 
-    uint8* _holes;
+    uint8 const* _holes;
+
+    // grid arrays point either into _mapping or into _ownedData, arrays are copied when the file is not mapped or misaligned
+    std::unique_ptr<boost::iostreams::mapped_file_source> _mapping;
+    std::vector<std::unique_ptr<uint8[]>> _ownedData;
+    std::size_t _ownedDataSize;
 
-    bool loadAreaData(FILE* in, uint32 offset, uint32 size);
-    bool loadHeightData(FILE* in, uint32 offset, uint32 size);
-    bool loadLiquidData(FILE* in, uint32 offset, uint32 size);
-    bool loadHolesData(FILE* in, uint32 offset, uint32 size);
+    class FileReader;
+
+    bool loadAreaData(FileReader& in, uint32 offset, uint32 size);
+    bool loadHeightData(FileReader& in, uint32 offset, uint32 size);
+    bool loadLiquidData(FileReader& in, uint32 offset, uint32 size);
+    bool loadHolesData(FileReader& in, uint32 offset, uint32 size);
     bool isHole(int row, int col) const;
 
     // Get height functions and pointers
@@ -90,9 +103,13 @@ public:
         InvalidFile
     };
 
-    LoadResult loadData(char const* filename);
+    // mapFile reads the grid through a read only mapping shared with other processes, its arrays are then used in place
+    LoadResult loadData(char const* filename, bool mapFile = false);
     void unloadData();
 
+    // approximate heap memory held by the loaded grid data, in bytes (data used in place from a mapping is not included)
+    std::size_t GetMemoryUsage() const;
+
     uint16 getArea(float x, float y) const;
     float getHeight(float x, float y) const { return (this->*_gridGetHeight)(x, y); }
     float getMinHeight(float x, float y) const;
@@ -0,0 +1,105 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LineOfSightCache.h"
+#include "Hash.h"
+#include <G3D/Vector3.h>
+#include <bit>
+#include <cmath>
+#include <utility>
+
+void LineOfSightCache::SetSize(std::size_t size)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _entries.clear();
+    if (size)
+        _entries.resize(std::bit_ceil(size));
+    _entries.shrink_to_fit();
+    _generation = 1;
+}
+
+Optional<bool> LineOfSightCache::Find(uint32 terrainMapId, G3D::Vector3 const& start, G3D::Vector3 const& end, uint8 ignoreFlags)
+{
+    Key key = MakeKey(terrainMapId, start, end, ignoreFlags);
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_entries.empty())
+        return {};
+
+    Entry const& entry = _entries[Hash(key) & (_entries.size() - 1)];
+    if (entry.Generation != _generation || !(entry.EntryKey == key))
+    {
+        ++_statistics.Misses;
+        return {};
+    }
+
+    ++_statistics.Hits;
+    return entry.Result;
+}
+
+void LineOfSightCache::Store(uint32 terrainMapId, G3D::Vector3 const& start, G3D::Vector3 const& end, uint8 ignoreFlags, bool result)
+{
+    Key key = MakeKey(terrainMapId, start, end, ignoreFlags);
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_entries.empty())
+        return;
+
+    Entry& entry = _entries[Hash(key) & (_entries.size() - 1)];
+    entry.EntryKey = key;
+    entry.Generation = _generation;
+    entry.Result = result;
+}
+
+void LineOfSightCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (++_generation == 0)
+    {
+        // generation wrapped around, old entries could become valid again
+        for (Entry& entry : _entries)
+            entry.Generation = 0;
+        _generation = 1;
+    }
+}
+
+LineOfSightCache::Statistics LineOfSightCache::ConsumeStatistics()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return std::exchange(_statistics, Statistics());
+}
+
+LineOfSightCache::Key LineOfSightCache::MakeKey(uint32 terrainMapId, G3D::Vector3 const& start, G3D::Vector3 const& end, uint8 ignoreFlags)
+{
+    auto quantize = [](float value) { return int32(std::floor(value / Resolution)); };
+    return
+    {
+        .Coordinates = { quantize(start.x), quantize(start.y), quantize(start.z), quantize(end.x), quantize(end.y), quantize(end.z) },
+        .TerrainMapId = terrainMapId,
+        .IgnoreFlags = ignoreFlags
+    };
+}
+
+std::size_t LineOfSightCache::Hash(Key const& key)
+{
+    std::size_t hash = 0;
+    for (int32 coordinate : key.Coordinates)
+        Trinity::hash_combine(hash, coordinate);
+    Trinity::hash_combine(hash, key.TerrainMapId);
+    Trinity::hash_combine(hash, key.IgnoreFlags);
+    return hash;
+}
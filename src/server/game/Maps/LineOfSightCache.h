@@ -0,0 +1,90 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_LINE_OF_SIGHT_CACHE_H
+#define TRINITY_LINE_OF_SIGHT_CACHE_H
+
+#include "Define.h"
+#include "Optional.h"
+#include <array>
+#include <mutex>
+#include <vector>
+
+namespace G3D
+{
+class Vector3;
+}
+
+// Fixed size cache of static (vmap) line of sight results of a single map
+// endpoints are quantized to Resolution, so queries between nearly identical positions share an entry
+// entries are assigned to slots by hash and overwritten on collision, Clear() drops all of them at once
+class TC_GAME_API LineOfSightCache
+{
+public:
+    static constexpr float Resolution = 0.5f;
+
+    struct Statistics
+    {
+        uint64 Hits = 0;
+        uint64 Misses = 0;
+    };
+
+    LineOfSightCache() = default;
+
+    LineOfSightCache(LineOfSightCache const&) = delete;
+    LineOfSightCache& operator=(LineOfSightCache const&) = delete;
+
+    // size is rounded up to a power of two, 0 disables the cache
+    void SetSize(std::size_t size);
+    bool IsEnabled() const { return !_entries.empty(); }
+
+    Optional<bool> Find(uint32 terrainMapId, G3D::Vector3 const& start, G3D::Vector3 const& end, uint8 ignoreFlags);
+    void Store(uint32 terrainMapId, G3D::Vector3 const& start, G3D::Vector3 const& end, uint8 ignoreFlags, bool result);
+
+    // called when terrain data used by the map changes
+    void Clear();
+
+    // returns the counters collected since the previous call and resets them
+    Statistics ConsumeStatistics();
+
+private:
+    struct Key
+    {
+        std::array<int32, 6> Coordinates;
+        uint32 TerrainMapId;
+        uint8 IgnoreFlags;
+
+        friend bool operator==(Key const&, Key const&) = default;
+    };
+
+    struct Entry
+    {
+        Key EntryKey;
+        uint32 Generation = 0;
+        bool Result = false;
+    };
+
+    static Key MakeKey(uint32 terrainMapId, G3D::Vector3 const& start, G3D::Vector3 const& end, uint8 ignoreFlags);
+    static std::size_t Hash(Key const& key);
+
+    std::mutex _lock;
+    std::vector<Entry> _entries;
+    uint32 _generation = 1;     // entries of older generations are empty
+    Statistics _statistics;
+};
+
+#endif // TRINITY_LINE_OF_SIGHT_CACHE_H
@@ -16,6 +16,7 @@
  */
 
 #include "Map.h"
+#include "AllocationTracker.h"
 #include "Battleground.h"
 #include "BattlegroundMgr.h"
 #include "BattlegroundScript.h"
@@ -26,6 +27,7 @@
 #include "DB2Stores.h"
 #include "DatabaseEnv.h"
 #include "DynamicTree.h"
+#include "GameEventMgr.h"
 #include "GameObjectModel.h"
 #include "GameTime.h"
 #include "GridNotifiers.h"
@@ -38,18 +40,23 @@
 #include "InstanceScript.h"
 #include "Log.h"
 #include "MapManager.h"
+#include "MapReplay.h"
 #include "Metric.h"
 #include "MiscPackets.h"
 #include "MotionMaster.h"
 #include "ObjectAccessor.h"
 #include "ObjectGridLoader.h"
 #include "ObjectMgr.h"
+#include "PathCache.h"
 #include "Pet.h"
 #include "PhasingHandler.h"
 #include "PoolMgr.h"
 #include "ScriptMgr.h"
+#include "ScriptProfiler.h"
+#include "Spell.h"
 #include "SpellAuras.h"
 #include "TerrainMgr.h"
+#include "ThreadPool.h"
 #include "Transport.h"
 #include "VMapFactory.h"
 #include "VMapManager2.h"
@@ -62,7 +69,8 @@
 #include "WorldSession.h"
 #include "WorldStateMgr.h"
 #include "WorldStatePackets.h"
-#include <boost/heap/fibonacci_heap.hpp>
+#include <latch>
+#include <map>
 #include <sstream>
 
 #define DEFAULT_GRID_EXPIRY     300
@@ -76,16 +84,115 @@ ZoneDynamicInfo::ZoneDynamicInfo() : MusicId(0), DefaultWeather(nullptr), Weathe
 
 RespawnInfo::~RespawnInfo() = default;
 
-struct RespawnInfoWithHandle;
-struct RespawnListContainer : boost::heap::fibonacci_heap<RespawnInfoWithHandle*, boost::heap::compare<CompareRespawnInfo>>
+struct RespawnInfoWithHandle : RespawnInfo
 {
+    explicit RespawnInfoWithHandle(RespawnInfo const& other) : RespawnInfo(other) { }
+
+    uint32 bucket = 0;
+    std::size_t bucketIndex = 0;
 };
 
-struct RespawnInfoWithHandle : RespawnInfo
+// Timer wheel of one second buckets covering the next Size seconds, respawns further away wait in an overflow
+// bucket that is redistributed every time the wheel wraps around. Insert, erase and reschedule are O(1)
+struct RespawnListContainer
 {
-    explicit RespawnInfoWithHandle(RespawnInfo const& other) : RespawnInfo(other) { }
+    static constexpr uint32 Size = 512;
+    static constexpr uint32 OverflowBucket = Size;
+
+    explicit RespawnListContainer(time_t now) : _cursor(now) { }
+
+    bool empty() const { return _count == 0; }
+
+    void Insert(RespawnInfoWithHandle* info)
+    {
+        if (_buckets.empty())
+            _buckets.resize(Size + 1);
+
+        // already due respawns are handled at the next processed second
+        time_t respawnTime = std::max(info->respawnTime, _cursor);
+        uint32 bucket = respawnTime - _cursor < time_t(Size) ? uint32(respawnTime % Size) : OverflowBucket;
+        Link(info, bucket);
+        ++_count;
+    }
+
+    void Erase(RespawnInfoWithHandle* info)
+    {
+        Unlink(info);
+        --_count;
+    }
+
+    void Reschedule(RespawnInfoWithHandle* info)
+    {
+        Erase(info);
+        Insert(info);
+    }
+
+    // removes and returns the next respawn due at or before now
+    RespawnInfoWithHandle* PopDue(time_t now)
+    {
+        while (_count && _cursor <= now)
+        {
+            std::vector<RespawnInfoWithHandle*>& bucket = _buckets[uint32(_cursor % Size)];
+            if (!bucket.empty())
+            {
+                RespawnInfoWithHandle* info = bucket.back();
+                bucket.pop_back();
+                --_count;
+                return info;
+            }
+
+            if (++_cursor % Size == 0)
+                RedistributeOverflow();
+        }
+
+        if (!_count && _cursor <= now)
+            _cursor = now + 1;
+
+        return nullptr;
+    }
+
+    void clear()
+    {
+        _buckets.clear();
+        _count = 0;
+    }
+
+private:
+    void Link(RespawnInfoWithHandle* info, uint32 bucket)
+    {
+        info->bucket = bucket;
+        info->bucketIndex = _buckets[bucket].size();
+        _buckets[bucket].push_back(info);
+    }
+
+    void Unlink(RespawnInfoWithHandle* info)
+    {
+        std::vector<RespawnInfoWithHandle*>& bucket = _buckets[info->bucket];
+        RespawnInfoWithHandle* last = bucket.back();
+        bucket[info->bucketIndex] = last;
+        last->bucketIndex = info->bucketIndex;
+        bucket.pop_back();
+    }
 
-    RespawnListContainer::handle_type handle;
+    void RedistributeOverflow()
+    {
+        std::vector<RespawnInfoWithHandle*>& overflow = _buckets[OverflowBucket];
+        for (std::size_t i = 0; i < overflow.size();)
+        {
+            RespawnInfoWithHandle* info = overflow[i];
+            if (info->respawnTime - _cursor < time_t(Size))
+            {
+                Unlink(info);
+                Link(info, uint32(std::max(info->respawnTime, _cursor) % Size));
+            }
+            else
+                ++i;
+        }
+    }
+
+    std::vector<std::vector<RespawnInfoWithHandle*>> _buckets;  // allocated with the first respawn, most instances never have any
+    time_t _cursor;                                             // first second not processed yet
+    std::size_t _count = 0;
 };
 
 Map::~Map()
@@ -133,13 +240,13 @@ void Map::DeleteStateMachine()
 }
 
 Map::Map(uint32 id, time_t expiry, uint32 InstanceId, Difficulty SpawnMode) :
-_creatureToMoveLock(false), _gameObjectsToMoveLock(false), _dynamicObjectsToMoveLock(false), _areaTriggersToMoveLock(false),
+_regionUpdatePool(nullptr), _regionUpdateInProgress(false), _creatureToMoveLock(false), _gameObjectsToMoveLock(false), _dynamicObjectsToMoveLock(false), _areaTriggersToMoveLock(false),
 i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
-m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
+m_unloadTimer(0), m_lastUpdateDuration(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
 m_VisibilityNotifyPeriod(DEFAULT_VISIBILITY_NOTIFY_PERIOD),
 m_activeNonPlayersIter(m_activeNonPlayers.end()), _transportsUpdateIter(_transports.end()),
 i_gridExpiry(expiry), m_terrain(sTerrainMgr.LoadTerrain(id)), m_forceEnabledNavMeshFilterFlags(0), m_forceDisabledNavMeshFilterFlags(0),
-i_scriptLock(false), _respawnTimes(std::make_unique<RespawnListContainer>()), _respawnCheckTimer(0), _vignetteUpdateTimer(5200, 5200)
+i_scriptLock(false), _respawnTimes(std::make_unique<RespawnListContainer>(GameTime::GetGameTime())), _respawnCheckTimer(0), _vignetteUpdateTimer(5200, 5200)
 {
     for (uint32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
     {
@@ -156,6 +263,7 @@ i_scriptLock(false), _respawnTimes(std::make_unique<RespawnListContainer>()), _r
     Map::InitVisibilityDistance();
 
     _weatherUpdateTimer.SetInterval(time_t(1 * IN_MILLISECONDS));
+    _mmapTileTouchTimer.SetInterval(time_t(5 * IN_MILLISECONDS));
 
     GetGuidSequenceGenerator(HighGuid::Transport).Set(sObjectMgr->GetGenerator<HighGuid::Transport>().GetNextAfterMaxUsed());
 
@@ -166,6 +274,16 @@ i_scriptLock(false), _respawnTimes(std::make_unique<RespawnListContainer>()), _r
     m_terrain->LoadMMapInstance(GetId(), GetInstanceId());
 
     _worldStateValues = sWorldStateMgr->GetInitialWorldStatesForMap(this);
+    _initWorldStatesRealmVersion = sWorldStateMgr->GetRealmWorldStatesVersion();
+
+    _lineOfSightCache.SetSize(sWorld->getIntConfig(CONFIG_VMAP_LOS_CACHE_SIZE));
+    _terrainStatusCache.SetSize(sWorld->getIntConfig(CONFIG_VMAP_TERRAIN_STATUS_CACHE_SIZE));
+
+    if (uint32 pathCacheSize = sWorld->getIntConfig(CONFIG_MMAP_PATH_CACHE_SIZE))
+    {
+        _pathCache = std::make_shared<PathCache>();
+        _pathCache->SetSize(pathCacheSize);
+    }
 }
 
 void Map::InitVisibilityDistance()
@@ -317,6 +435,7 @@ void Map::EnsureGridCreated(GridCoord const& p)
     if (!getNGrid(p.x_coord, p.y_coord))
     {
         TC_LOG_DEBUG("maps", "Creating grid[{}, {}] for map {} instance {}", p.x_coord, p.y_coord, GetId(), i_InstanceId);
+        TC_ALLOCATION_TAG_SCOPE(Grids);
 
         NGridType* ngrid = new NGridType(p.x_coord * MAX_NUMBER_OF_GRIDS + p.y_coord, p.x_coord, p.y_coord, i_gridExpiry, sWorld->getBoolConfig(CONFIG_GRID_UNLOAD));
         setNGrid(ngrid, p.x_coord, p.y_coord);
@@ -331,6 +450,14 @@ void Map::EnsureGridCreated(GridCoord const& p)
         int gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
 
         m_terrain->LoadMapAndVMap(gx, gy);
+
+        // results for rays through this grid were computed without its vmap tile
+        _lineOfSightCache.Clear();
+        _terrainStatusCache.Clear();
+
+        // same for paths and its mmap tile
+        if (_pathCache)
+            _pathCache->Clear();
     }
 }
 
@@ -351,11 +478,19 @@ void Map::EnsureGridLoadedForActiveObject(Cell const& cell, WorldObject const* o
         ResetGridExpiry(*grid, 0.1f);
         grid->SetGridState(GRID_STATE_ACTIVE);
     }
+
+    grid->getGridInfoRef()->setLastActiveTime(GameTime::GetGameTimeMS());
 }
 
 //Create NGrid and load the object data in it
 bool Map::EnsureGridLoaded(Cell const& cell)
 {
+    if (getNGrid(cell.GridX(), cell.GridY()) && isGridObjectDataLoaded(cell.GridX(), cell.GridY()))
+        return false;
+
+    TC_METRIC_TIMER("grid_attach_time", TC_METRIC_TAG("map_id", std::to_string(GetId())));
+    TC_ALLOCATION_TAG_SCOPE(Grids);
+
     EnsureGridCreated(GridCoord(cell.GridX(), cell.GridY()));
     NGridType *grid = getNGrid(cell.GridX(), cell.GridY());
 
@@ -367,6 +502,8 @@ bool Map::EnsureGridLoaded(Cell const& cell)
         setGridObjectDataLoaded(true, cell.GridX(), cell.GridY());
 
         LoadGridObjects(grid, cell);
+        UpdateGridMemoryUsage(*grid);
+        grid->getGridInfoRef()->setLastActiveTime(GameTime::GetGameTimeMS());
 
         Balance();
         return true;
@@ -375,6 +512,140 @@ bool Map::EnsureGridLoaded(Cell const& cell)
     return false;
 }
 
+void Map::PrepareGridAsync(GridCoord const& p)
+{
+    Trinity::ThreadPool* pool = sMapMgr->GetGridPreparePool();
+    if (!pool || !p.IsCoordValid() || getNGrid(p.x_coord, p.y_coord))
+        return;
+
+    // prepared terrain is released by TerrainInfo::CleanUpGrids if the grid is never created, allow preparing it again after that
+    time_t now = GameTime::GetGameTime();
+    auto itr = _gridPrepareRequests.find(p.GetId());
+    if (itr != _gridPrepareRequests.end())
+    {
+        if (itr->second + 60 > now)
+            return;
+
+        itr->second = now;
+    }
+    else
+    {
+        if (_gridPrepareRequests.size() >= sWorld->getIntConfig(CONFIG_GRID_PREPARE_MAX_PENDING))
+        {
+            std::erase_if(_gridPrepareRequests, [&](std::pair<uint32 const, time_t> const& request)
+            {
+                return request.second + 60 <= now || getNGrid(request.first % MAX_NUMBER_OF_GRIDS, request.first / MAX_NUMBER_OF_GRIDS);
+            });
+
+            if (_gridPrepareRequests.size() >= sWorld->getIntConfig(CONFIG_GRID_PREPARE_MAX_PENDING))
+                return;
+        }
+
+        _gridPrepareRequests.emplace(p.GetId(), now);
+    }
+
+    int32 gx = (MAX_NUMBER_OF_GRIDS - 1) - p.x_coord;
+    int32 gy = (MAX_NUMBER_OF_GRIDS - 1) - p.y_coord;
+    pool->PostWork([terrain = m_terrain, gx, gy]()
+    {
+        TC_METRIC_TIMER("grid_prepare_time", TC_METRIC_TAG("map_id", std::to_string(terrain->GetId())));
+        terrain->PrepareMapAndVMap(gx, gy);
+    });
+}
+
+void Map::PrepareGridsAround(float x, float y, float range)
+{
+    if (!Trinity::IsValidMapCoord(x, y))
+        return;
+
+    float minX = x - range, maxX = x + range;
+    float minY = y - range, maxY = y + range;
+    Trinity::NormalizeMapCoord(minX);
+    Trinity::NormalizeMapCoord(maxX);
+    Trinity::NormalizeMapCoord(minY);
+    Trinity::NormalizeMapCoord(maxY);
+
+    GridCoord low = Trinity::ComputeGridCoord(minX, minY);
+    GridCoord high = Trinity::ComputeGridCoord(maxX, maxY);
+    for (uint32 x = low.x_coord; x <= high.x_coord; ++x)
+        for (uint32 y = low.y_coord; y <= high.y_coord; ++y)
+            if (!getNGrid(x, y))
+                PrepareGridAsync(GridCoord(x, y));
+}
+
+void Map::PrepareGridsAlongMovement(Player const* player)
+{
+    // start loading terrain of grids the player is close to before they become active
+    PrepareGridsAround(player->GetPositionX(), player->GetPositionY(), player->GetGridActivationRange() + SIZE_OF_GRID_CELL);
+
+    // taxi paths are handled by FlightPathMovementGenerator
+    if (player->IsInFlight() || !player->isMoving())
+        return;
+
+    uint32 lookAhead = sWorld->getIntConfig(CONFIG_GRID_PREPARE_LOOKAHEAD);
+    if (!lookAhead)
+        return;
+
+    float speed = player->GetSpeed(player->IsFlying() ? MOVE_FLIGHT : (player->IsInWater() ? MOVE_SWIM : MOVE_RUN));
+    float distance = speed * lookAhead / float(IN_MILLISECONDS);
+    if (distance < SIZE_OF_GRID_CELL)
+        return;
+
+    float horizontal = std::cos(player->m_movementInfo.pitch);
+    float dx = std::cos(player->GetOrientation()) * horizontal;
+    float dy = std::sin(player->GetOrientation()) * horizontal;
+
+    // sample the predicted path with a step smaller than a grid so that no crossed grid is skipped
+    float const step = SIZE_OF_GRIDS / 2.0f;
+    for (float traveled = step; traveled < distance + step; traveled += step)
+    {
+        float predicted = std::min(traveled, distance);
+        PrepareGridsAround(player->GetPositionX() + dx * predicted, player->GetPositionY() + dy * predicted, SIZE_OF_GRID_CELL);
+    }
+}
+
+void Map::TouchMMapTilesAround(float x, float y, float range)
+{
+    if (!Trinity::IsValidMapCoord(x, y))
+        return;
+
+    float minX = x - range, maxX = x + range;
+    float minY = y - range, maxY = y + range;
+    Trinity::NormalizeMapCoord(minX);
+    Trinity::NormalizeMapCoord(maxX);
+    Trinity::NormalizeMapCoord(minY);
+    Trinity::NormalizeMapCoord(maxY);
+
+    GridCoord low = Trinity::ComputeGridCoord(minX, minY);
+    GridCoord high = Trinity::ComputeGridCoord(maxX, maxY);
+    for (uint32 x = low.x_coord; x <= high.x_coord; ++x)
+    {
+        for (uint32 y = low.y_coord; y <= high.y_coord; ++y)
+        {
+            int32 gx = (MAX_NUMBER_OF_GRIDS - 1) - x;
+            int32 gy = (MAX_NUMBER_OF_GRIDS - 1) - y;
+            if (!m_terrain->TouchMMaps(gx, gy))
+                continue;
+
+            if (Trinity::ThreadPool* pool = sMapMgr->GetGridPreparePool())
+                pool->PostWork([terrain = m_terrain, gx, gy]() { terrain->ReloadEvictedMMaps(gx, gy); });
+            else
+                m_terrain->ReloadEvictedMMaps(gx, gy);
+        }
+    }
+}
+
+void Map::TouchMMapTilesOfActiveObjects()
+{
+    for (MapReference const& ref : m_mapRefManager)
+        if (Player* player = ref.GetSource(); player && player->IsInWorld())
+            TouchMMapTilesAround(player->GetPositionX(), player->GetPositionY(), player->GetGridActivationRange() + SIZE_OF_GRID_CELL);
+
+    for (WorldObject* object : m_activeNonPlayers)
+        if (object->IsInWorld())
+            TouchMMapTilesAround(object->GetPositionX(), object->GetPositionY(), object->GetGridActivationRange() + SIZE_OF_GRID_CELL);
+}
+
 void Map::LoadGridObjects(NGridType* grid, Cell const& cell)
 {
     ObjectGridLoader loader(*grid, this, cell);
@@ -476,29 +747,84 @@ void Map::SetWorldStateValue(int32 worldStateId, int32 value, bool hidden)
 
     itr->second = value;
 
-    WorldStateTemplate const* worldStateTemplate = sWorldStateMgr->GetWorldStateTemplate(worldStateId);
-    if (worldStateTemplate)
+    if (inserted)
+        _worldStateIdsByArea.clear();
+
+    _initWorldStatesPackets.clear();
+    _pendingWorldStateUpdates[worldStateId] = hidden;
+
+    if (WorldStateTemplate const* worldStateTemplate = sWorldStateMgr->GetWorldStateTemplate(worldStateId))
         sScriptMgr->OnWorldStateValueChange(worldStateTemplate, oldValue, value, this);
+}
+
+std::vector<int32> const& Map::GetWorldStateIdsForArea(uint32 areaId) const
+{
+    auto [itr, inserted] = _worldStateIdsByArea.try_emplace(areaId);
+    if (inserted)
+    {
+        for (auto const& [worldStateId, value] : _worldStateValues)
+            if (sWorldStateMgr->IsWorldStateVisibleInArea(worldStateId, areaId))
+                itr->second.push_back(worldStateId);
+    }
+
+    return itr->second;
+}
+
+std::shared_ptr<WorldPacket const> Map::GetInitWorldStatesPacket(uint32 zoneId, uint32 areaId)
+{
+    uint32 realmVersion = sWorldStateMgr->GetRealmWorldStatesVersion();
+    if (_initWorldStatesRealmVersion != realmVersion)
+    {
+        _initWorldStatesPackets.clear();
+        _initWorldStatesRealmVersion = realmVersion;
+    }
+
+    std::shared_ptr<WorldPacket const>& packet = _initWorldStatesPackets[MAKE_PAIR64(areaId, zoneId)];
+    if (!packet)
+    {
+        WorldPackets::WorldState::InitWorldStates initWorldStates;
+        initWorldStates.MapID = GetId();
+        initWorldStates.AreaID = zoneId;
+        initWorldStates.SubareaID = areaId;
+
+        sWorldStateMgr->FillInitialWorldStates(initWorldStates, this, areaId);
+        initWorldStates.Write();
 
-    // Broadcast update to all players on the map
-    WorldPackets::WorldState::UpdateWorldState updateWorldState;
-    updateWorldState.VariableID = worldStateId;
-    updateWorldState.Value = value;
-    updateWorldState.Hidden = hidden;
-    updateWorldState.Write();
+        packet = std::make_shared<WorldPacket const>(initWorldStates.Move());
+    }
+
+    return packet;
+}
 
-    for (MapReference const& mapReference : m_mapRefManager)
+void Map::SendWorldStateUpdates()
+{
+    if (_pendingWorldStateUpdates.empty())
+        return;
+
+    for (auto const& [worldStateId, hidden] : _pendingWorldStateUpdates)
     {
-        if (worldStateTemplate && !worldStateTemplate->AreaIds.empty())
+        WorldPackets::WorldState::UpdateWorldState updateWorldState;
+        updateWorldState.VariableID = worldStateId;
+        updateWorldState.Value = GetWorldStateValue(worldStateId);
+        updateWorldState.Hidden = hidden;
+        updateWorldState.Write();
+
+        WorldStateTemplate const* worldStateTemplate = sWorldStateMgr->GetWorldStateTemplate(worldStateId);
+        for (MapReference const& mapReference : m_mapRefManager)
         {
-            bool isInAllowedArea = std::any_of(worldStateTemplate->AreaIds.begin(), worldStateTemplate->AreaIds.end(),
-                [playerAreaId = mapReference.GetSource()->GetAreaId()](uint32 requiredAreaId) { return DB2Manager::IsInArea(playerAreaId, requiredAreaId); });
-            if (!isInAllowedArea)
-                continue;
-        }
+            if (worldStateTemplate && !worldStateTemplate->AreaIds.empty())
+            {
+                bool isInAllowedArea = std::any_of(worldStateTemplate->AreaIds.begin(), worldStateTemplate->AreaIds.end(),
+                    [playerAreaId = mapReference.GetSource()->GetAreaId()](uint32 requiredAreaId) { return DB2Manager::IsInArea(playerAreaId, requiredAreaId); });
+                if (!isInAllowedArea)
+                    continue;
+            }
 
-        mapReference.GetSource()->SendDirectMessage(updateWorldState.GetRawPacket());
+            mapReference.GetSource()->SendDirectMessage(updateWorldState.GetRawPacket());
+        }
     }
+
+    _pendingWorldStateUpdates.clear();
 }
 
 void Map::AddInfiniteAOIVignette(Vignettes::VignetteData* vignette)
@@ -514,6 +840,53 @@ void Map::AddInfiniteAOIVignette(Vignettes::VignetteData* vignette)
             ref.GetSource()->SendDirectMessage(vignetteUpdate.GetRawPacket());
 }
 
+void Map::SendInfiniteAOIVignetteUpdates()
+{
+    std::vector<Vignettes::VignetteData const*> updatedVignettes;
+    for (Vignettes::VignetteData* vignette : _infiniteAOIVignettes)
+    {
+        if (vignette->NeedUpdate)
+        {
+            updatedVignettes.push_back(vignette);
+            vignette->NeedUpdate = false;
+        }
+    }
+
+    if (updatedVignettes.empty() || !HavePlayers())
+        return;
+
+    // one packet per player with every vignette it can see, built only once for all players seeing the same vignettes
+    std::map<std::vector<bool>, std::shared_ptr<WorldPacket const>> packets;
+    std::vector<bool> visibleVignettes(updatedVignettes.size());
+    for (MapReference const& ref : m_mapRefManager)
+    {
+        Player const* player = ref.GetSource();
+        bool anyVisible = false;
+        for (std::size_t i = 0; i < updatedVignettes.size(); ++i)
+        {
+            visibleVignettes[i] = Vignettes::CanSee(player, *updatedVignettes[i]);
+            anyVisible = anyVisible || visibleVignettes[i];
+        }
+
+        if (!anyVisible)
+            continue;
+
+        std::shared_ptr<WorldPacket const>& packet = packets[visibleVignettes];
+        if (!packet)
+        {
+            WorldPackets::Vignette::VignetteUpdate vignetteUpdate;
+            for (std::size_t i = 0; i < updatedVignettes.size(); ++i)
+                if (visibleVignettes[i])
+                    updatedVignettes[i]->FillPacket(vignetteUpdate.Updated);
+
+            vignetteUpdate.Write();
+            packet = std::make_shared<WorldPacket const>(vignetteUpdate.Move());
+        }
+
+        player->SendDirectMessage(packet);
+    }
+}
+
 void Map::RemoveInfiniteAOIVignette(Vignettes::VignetteData* vignette)
 {
     if (!std::erase(_infiniteAOIVignettes, vignette))
@@ -661,6 +1034,13 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
                 continue;
 
             markCell(cell_id);
+            if (_regionUpdatePool)
+            {
+                // visited later by UpdateRegions
+                _regionUpdateCells.push_back(cell_id);
+                continue;
+            }
+
             CellCoord pair(x, y);
             Cell cell(pair);
             cell.SetNoCreate();
@@ -670,6 +1050,195 @@ void Map::VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::Obj
     }
 }
 
+void Map::UpdateRegions(uint32 diff)
+{
+    if (_regionUpdateCells.empty())
+        return;
+
+    // group visited cells by grid, grids touching each other (including diagonally) belong to the same region
+    // so that every region is surrounded by grids without any updated objects
+    std::vector<uint32> gridParent(MAX_NUMBER_OF_GRIDS * MAX_NUMBER_OF_GRIDS, std::numeric_limits<uint32>::max());
+    auto findRoot = [&](uint32 gridId)
+    {
+        while (gridParent[gridId] != gridId)
+        {
+            gridParent[gridId] = gridParent[gridParent[gridId]];
+            gridId = gridParent[gridId];
+        }
+        return gridId;
+    };
+
+    std::vector<uint32> activeGrids;
+    for (uint32 cellId : _regionUpdateCells)
+    {
+        // grid object loading touches containers of the whole map, finish it before going parallel
+        Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+        if (IsGridLoaded(GridCoord(cell.GridX(), cell.GridY())))
+            EnsureGridLoaded(cell);
+
+        uint32 gridId = cell.GridY() * MAX_NUMBER_OF_GRIDS + cell.GridX();
+        if (gridParent[gridId] == std::numeric_limits<uint32>::max())
+        {
+            gridParent[gridId] = gridId;
+            activeGrids.push_back(gridId);
+        }
+    }
+
+    for (uint32 gridId : activeGrids)
+    {
+        uint32 gridX = gridId % MAX_NUMBER_OF_GRIDS;
+        uint32 gridY = gridId / MAX_NUMBER_OF_GRIDS;
+        for (uint32 x = gridX > 0 ? gridX - 1 : 0; x <= std::min<uint32>(gridX + 1, MAX_NUMBER_OF_GRIDS - 1); ++x)
+        {
+            for (uint32 y = gridY > 0 ? gridY - 1 : 0; y <= std::min<uint32>(gridY + 1, MAX_NUMBER_OF_GRIDS - 1); ++y)
+            {
+                uint32 neighborId = y * MAX_NUMBER_OF_GRIDS + x;
+                if (gridParent[neighborId] == std::numeric_limits<uint32>::max())
+                    continue;
+
+                uint32 left = findRoot(gridId);
+                uint32 right = findRoot(neighborId);
+                if (left != right)
+                    gridParent[std::max(left, right)] = std::min(left, right);
+            }
+        }
+    }
+
+    std::unordered_map<uint32, std::vector<uint32>> regions;
+    for (uint32 cellId : _regionUpdateCells)
+    {
+        Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+        regions[findRoot(cell.GridY() * MAX_NUMBER_OF_GRIDS + cell.GridX())].push_back(cellId);
+    }
+
+    _regionUpdateCells.clear();
+
+    auto updateRegion = [this, diff](std::vector<uint32> const& cells)
+    {
+        Trinity::ObjectUpdater updater(diff);
+        TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> gridVisitor(updater);
+        TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> worldVisitor(updater);
+        for (uint32 cellId : cells)
+        {
+            Cell cell(CellCoord(cellId % TOTAL_NUMBER_OF_CELLS_PER_MAP, cellId / TOTAL_NUMBER_OF_CELLS_PER_MAP));
+            cell.SetNoCreate();
+            Visit(cell, gridVisitor);
+            Visit(cell, worldVisitor);
+        }
+    };
+
+    if (regions.size() == 1)
+    {
+        updateRegion(regions.begin()->second);
+        return;
+    }
+
+    _regionUpdateInProgress = true;
+
+    std::latch regionsDone(regions.size());
+    for (auto const& [root, cells] : regions)
+    {
+        _regionUpdatePool->PostWork([&updateRegion, &cells = cells, &regionsDone]()
+        {
+            updateRegion(cells);
+            regionsDone.count_down();
+        });
+    }
+
+    regionsDone.wait();
+
+    _regionUpdateInProgress = false;
+}
+
+void Map::AddAreaTriggerToTargetUpdateList(AreaTrigger* at)
+{
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+
+    _areaTriggersToUpdateTargets.push_back(at->GetGUID());
+}
+
+namespace
+{
+struct AreaTriggerSearchCellCollector
+{
+    std::vector<Unit*>& Players;
+    std::vector<Unit*>& Creatures;
+
+    void Visit(PlayerMapType& m)
+    {
+        for (GridReference<Player> const& ref : m)
+            Players.push_back(ref.GetSource());
+    }
+
+    void Visit(CreatureMapType& m)
+    {
+        for (GridReference<Creature> const& ref : m)
+            Creatures.push_back(ref.GetSource());
+    }
+
+    template<class NOT_INTERESTED> void Visit(GridRefManager<NOT_INTERESTED>&) { }
+};
+}
+
+void Map::GetAreaTriggerSearchCells(WorldObject const* center, float radius, std::vector<AreaTriggerSearchCell const*>& cells)
+{
+    float x = center->GetPositionX();
+    float y = center->GetPositionY();
+    CellCoord standingCell = Trinity::ComputeCellCoord(x, y);
+    if (!standingCell.IsCoordValid())
+        return;
+
+    auto addCell = [&](CellCoord const& cellCoord)
+    {
+        auto [itr, inserted] = _areaTriggerSearchCells.try_emplace(cellCoord.GetId());
+        if (inserted)
+        {
+            Cell cell(cellCoord);
+            cell.SetNoCreate();
+
+            AreaTriggerSearchCellCollector worldCollector{ itr->second.Players, itr->second.WorldCreatures };
+            TypeContainerVisitor<AreaTriggerSearchCellCollector, WorldTypeMapContainer> worldVisitor(worldCollector);
+            Visit(cell, worldVisitor);
+
+            AreaTriggerSearchCellCollector gridCollector{ itr->second.Players, itr->second.GridCreatures };
+            TypeContainerVisitor<AreaTriggerSearchCellCollector, GridTypeMapContainer> gridVisitor(gridCollector);
+            Visit(cell, gridVisitor);
+        }
+
+        cells.push_back(&itr->second);
+    };
+
+    addCell(standingCell);
+
+    // same cells as Cell::Visit with a center object
+    radius = std::min(radius + center->GetCombatReach(), float(SIZE_OF_GRIDS));
+    if (radius <= 0.0f)
+        return;
+
+    CellArea area = Cell::CalculateCellArea(x, y, radius);
+    for (uint32 cellX = area.low_bound.x_coord; cellX <= area.high_bound.x_coord; ++cellX)
+    {
+        for (uint32 cellY = area.low_bound.y_coord; cellY <= area.high_bound.y_coord; ++cellY)
+        {
+            CellCoord cellCoord(cellX, cellY);
+            if (cellCoord != standingCell && Cell::IsCellInRange(cellCoord, x, y, radius))
+                addCell(cellCoord);
+        }
+    }
+}
+
+void Map::UpdateAreaTriggerTargets()
+{
+    // target lists are updated after all objects of the tick, units only change cells when the move lists are processed
+    // so the collected cells stay valid until the end of this function (units added meanwhile are found next tick)
+    for (std::size_t i = 0; i < _areaTriggersToUpdateTargets.size(); ++i)
+        if (AreaTrigger* at = GetAreaTrigger(_areaTriggersToUpdateTargets[i]))
+            at->UpdateTargetList();
+
+    _areaTriggersToUpdateTargets.clear();
+    _areaTriggerSearchCells.clear();
+}
+
 void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 {
     // Nothing to do if no change
@@ -687,23 +1256,31 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 
 void Map::Update(uint32 t_diff)
 {
+    // temporaries of the tick are released together when it ends
+    Trinity::TickArena::Scope tickArena;
+    MapUpdateProfiler::ScopedTick profileTick(_updateProfiler, GetId(), GetInstanceId());
+
     _dynamicTree.update(t_diff);
     /// update worldsessions for existing players
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* player = m_mapRefIter->GetSource();
-        if (player && player->IsInWorld())
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::Sessions);
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
         {
-            //player->Update(t_diff);
-            WorldSession* session = player->GetSession();
-            MapSessionFilter updater(session);
-            session->Update(t_diff, updater);
+            Player* player = m_mapRefIter->GetSource();
+            if (player && player->IsInWorld())
+            {
+                //player->Update(t_diff);
+                WorldSession* session = player->GetSession();
+                MapSessionFilter updater(session);
+                session->Update(t_diff, updater);
+            }
         }
     }
 
     /// process any due respawns
     if (_respawnCheckTimer <= t_diff)
     {
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::Respawns);
         ProcessRespawns();
         UpdateSpawnGroupConditions();
         _respawnCheckTimer = sWorld->getIntConfig(CONFIG_RESPAWN_MINCHECKINTERVALMS);
@@ -711,114 +1288,143 @@ void Map::Update(uint32 t_diff)
     else
         _respawnCheckTimer -= t_diff;
 
+    /// apply game event spawn changes queued for this map
+    if (!_gameEventChanges.empty())
+    {
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::Respawns);
+        ProcessGameEventChanges();
+    }
+
     /// update active cells around players and active objects
     resetMarkedCells();
 
+    UpdatePlayerNearCells();
+
     Trinity::ObjectUpdater updater(t_diff);
     // for creature
     TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer  > grid_object_update(updater);
     // for pets
     TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer > world_object_update(updater);
 
-    // the player iterator is stored in the map object
-    // to make sure calls to Map::Remove don't invalidate it
-    for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
     {
-        Player* player = m_mapRefIter->GetSource();
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::Players);
+        // the player iterator is stored in the map object
+        // to make sure calls to Map::Remove don't invalidate it
+        for (m_mapRefIter = m_mapRefManager.begin(); m_mapRefIter != m_mapRefManager.end(); ++m_mapRefIter)
+        {
+            Player* player = m_mapRefIter->GetSource();
 
-        if (!player || !player->IsInWorld())
-            continue;
+            if (!player || !player->IsInWorld())
+                continue;
 
-        // update players at tick
-        player->Update(t_diff);
+            // update players at tick
+            player->Update(t_diff);
 
-        VisitNearbyCellsOf(player, grid_object_update, world_object_update);
+            VisitNearbyCellsOf(player, grid_object_update, world_object_update);
 
-        // If player is using far sight or mind vision, visit that object too
-        if (WorldObject* viewPoint = player->GetViewpoint())
-            VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
+            PrepareGridsAlongMovement(player);
 
-        // Handle updates for creatures in combat with player and are more than 60 yards away
-        if (player->IsInCombat())
-        {
-            std::vector<Unit*> toVisit;
-            for (auto const& pair : player->GetCombatManager().GetPvECombatRefs())
-                if (Creature* unit = pair.second->GetOther(player)->ToCreature())
-                    if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
-                        toVisit.push_back(unit);
-            for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
-        }
+            // If player is using far sight or mind vision, visit that object too
+            if (WorldObject* viewPoint = player->GetViewpoint())
+                VisitNearbyCellsOf(viewPoint, grid_object_update, world_object_update);
 
-        { // Update any creatures that own auras the player has applications of
-            std::unordered_set<Unit*> toVisit;
-            for (std::pair<uint32, AuraApplication*> pair : player->GetAppliedAuras())
+            // Handle updates for creatures in combat with player and are more than 60 yards away
+            if (player->IsInCombat())
             {
-                if (Unit* caster = pair.second->GetBase()->GetCaster())
-                    if (caster->GetTypeId() != TYPEID_PLAYER && !caster->IsWithinDistInMap(player, GetVisibilityRange(), false))
-                        toVisit.insert(caster);
+                std::vector<Unit*> toVisit;
+                for (auto const& pair : player->GetCombatManager().GetPvECombatRefs())
+                    if (Creature* unit = pair.second->GetOther(player)->ToCreature())
+                        if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
+                            toVisit.push_back(unit);
+                for (Unit* unit : toVisit)
+                    VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
+            }
+
+            { // Update any creatures that own auras the player has applications of
+                std::unordered_set<Unit*> toVisit;
+                for (std::pair<uint32, AuraApplication*> pair : player->GetAppliedAuras())
+                {
+                    if (Unit* caster = pair.second->GetBase()->GetCaster())
+                        if (caster->GetTypeId() != TYPEID_PLAYER && !caster->IsWithinDistInMap(player, GetVisibilityRange(), false))
+                            toVisit.insert(caster);
+                }
+                for (Unit* unit : toVisit)
+                    VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
+            }
+
+            { // Update player's summons
+                std::vector<Unit*> toVisit;
+
+                // Totems
+                for (ObjectGuid const& summonGuid : player->m_SummonSlot)
+                    if (!summonGuid.IsEmpty())
+                        if (Creature* unit = GetCreature(summonGuid))
+                            if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
+                                toVisit.push_back(unit);
+
+                for (Unit* unit : toVisit)
+                    VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
             }
-            for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
         }
+    }
+
+    {
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::ActiveObjects);
+        // non-player active objects, increasing iterator in the loop in case of object removal
+        for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+        {
+            WorldObject* obj = *m_activeNonPlayersIter;
+            ++m_activeNonPlayersIter;
 
-        { // Update player's summons
-            std::vector<Unit*> toVisit;
+            if (!obj || !obj->IsInWorld())
+                continue;
 
-            // Totems
-            for (ObjectGuid const& summonGuid : player->m_SummonSlot)
-                if (!summonGuid.IsEmpty())
-                    if (Creature* unit = GetCreature(summonGuid))
-                        if (unit->GetMapId() == player->GetMapId() && !unit->IsWithinDistInMap(player, GetVisibilityRange(), false))
-                            toVisit.push_back(unit);
+            VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+        }
+    }
+
+    if (_regionUpdatePool)
+    {
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::Regions);
+        UpdateRegions(t_diff);
+    }
 
-            for (Unit* unit : toVisit)
-                VisitNearbyCellsOf(unit, grid_object_update, world_object_update);
+    {
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::Transports);
+        for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
+        {
+            WorldObject* obj = *_transportsUpdateIter;
+            ++_transportsUpdateIter;
+            obj->Update(t_diff);
         }
     }
 
-    // non-player active objects, increasing iterator in the loop in case of object removal
-    for (m_activeNonPlayersIter = m_activeNonPlayers.begin(); m_activeNonPlayersIter != m_activeNonPlayers.end();)
+    if (!_areaTriggersToUpdateTargets.empty())
     {
-        WorldObject* obj = *m_activeNonPlayersIter;
-        ++m_activeNonPlayersIter;
-
-        if (!obj || !obj->IsInWorld())
-            continue;
-
-        VisitNearbyCellsOf(obj, grid_object_update, world_object_update);
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::AreaTriggerTargets);
+        UpdateAreaTriggerTargets();
     }
 
-    for (_transportsUpdateIter = _transports.begin(); _transportsUpdateIter != _transports.end();)
+    if (_vignetteUpdateTimer.Update(t_diff))
     {
-        WorldObject* obj = *_transportsUpdateIter;
-        ++_transportsUpdateIter;
-        obj->Update(t_diff);
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::Vignettes);
+        SendInfiniteAOIVignetteUpdates();
     }
 
-    if (_vignetteUpdateTimer.Update(t_diff))
     {
-        for (Vignettes::VignetteData* vignette : _infiniteAOIVignettes)
-        {
-            if (vignette->NeedUpdate)
-            {
-                WorldPackets::Vignette::VignetteUpdate vignetteUpdate;
-                vignette->FillPacket(vignetteUpdate.Updated);
-                vignetteUpdate.Write();
-                for (MapReference const& ref : m_mapRefManager)
-                    if (Vignettes::CanSee(ref.GetSource(), *vignette))
-                        ref.GetSource()->SendDirectMessage(vignetteUpdate.GetRawPacket());
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::SendObjectUpdates);
+        SendObjectUpdates();
+        SendWorldStateUpdates();
 
-                vignette->NeedUpdate = false;
-            }
-        }
+        // object updates are the bulk of what a map tick sends, write them out together with everything else sent during the tick
+        for (MapReference const& ref : m_mapRefManager)
+            ref.GetSource()->GetSession()->FlushPackets();
     }
 
-    SendObjectUpdates();
-
     ///- Process necessary scripts
     if (!m_scriptSchedule.empty())
     {
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::Scripts);
         i_scriptLock = true;
         ScriptsProcess();
         i_scriptLock = false;
@@ -827,6 +1433,7 @@ void Map::Update(uint32 t_diff)
     _weatherUpdateTimer.Update(t_diff);
     if (_weatherUpdateTimer.Passed())
     {
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::Weather);
         for (auto&& zoneInfo : _zoneDynamicInfo)
             if (zoneInfo.second.DefaultWeather && !zoneInfo.second.DefaultWeather->Update(_weatherUpdateTimer.GetInterval()))
                 zoneInfo.second.DefaultWeather.reset();
@@ -834,17 +1441,44 @@ void Map::Update(uint32 t_diff)
         _weatherUpdateTimer.Reset();
     }
 
+    _mmapTileTouchTimer.Update(t_diff);
+    if (_mmapTileTouchTimer.Passed())
+    {
+        if (sWorld->getIntConfig(CONFIG_MMAP_TILE_MEMORY_BUDGET))
+            TouchMMapTilesOfActiveObjects();
+
+        _mmapTileTouchTimer.Reset();
+    }
+
     // update phase shift objects
-    GetMultiPersonalPhaseTracker().Update(this, t_diff);
+    {
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::PhaseTracker);
+        GetMultiPersonalPhaseTracker().Update(this, t_diff);
+    }
 
-    MoveAllCreaturesInMoveList();
-    MoveAllGameObjectsInMoveList();
-    MoveAllAreaTriggersInMoveList();
+    {
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::MoveLists);
+        MoveAllCreaturesInMoveList();
+        MoveAllGameObjectsInMoveList();
+        MoveAllAreaTriggersInMoveList();
+    }
 
     if (!m_mapRefManager.isEmpty() || !m_activeNonPlayers.empty())
+    {
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::RelocationNotifies);
         ProcessRelocationNotifies(t_diff);
+    }
+
+    {
+        MapUpdateProfiler::ScopedPhase profilePhase(_updateProfiler, MapUpdatePhase::ScriptHooks);
+        sScriptMgr->OnMapUpdate(this, t_diff);
+    }
 
-    sScriptMgr->OnMapUpdate(this, t_diff);
+    {
+        std::lock_guard<std::mutex> lock(_replayRecordingLock);
+        if (_replayRecording)
+            _replayRecording->RecordTick(*this, t_diff);
+    }
 
     TC_METRIC_VALUE("map_creatures", uint64(GetObjectsStore().Size<Creature>()),
         TC_METRIC_TAG("map_id", std::to_string(GetId())),
@@ -853,6 +1487,82 @@ void Map::Update(uint32 t_diff)
     TC_METRIC_VALUE("map_gameobjects", uint64(GetObjectsStore().Size<GameObject>()),
         TC_METRIC_TAG("map_id", std::to_string(GetId())),
         TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    if (sMetric->IsEnabled())
+    {
+        DynamicMapTree::BalanceStatistics balanceStatistics = _dynamicTree.consumeBalanceStatistics();
+        TC_METRIC_VALUE("map_dynamic_tree_balance_time", balanceStatistics.BalanceTime,
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+        TC_METRIC_VALUE("map_dynamic_tree_rebuilds", uint64(balanceStatistics.Rebuilds),
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+    }
+
+    if (_lineOfSightCache.IsEnabled() && sMetric->IsEnabled())
+    {
+        LineOfSightCache::Statistics lineOfSightStatistics = _lineOfSightCache.ConsumeStatistics();
+        TC_METRIC_VALUE("map_los_cache_hits", lineOfSightStatistics.Hits,
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+        TC_METRIC_VALUE("map_los_cache_misses", lineOfSightStatistics.Misses,
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+    }
+
+    if (!_playerNearCells.empty() && sMetric->IsEnabled())
+    {
+        TC_METRIC_VALUE("map_creatures_active", _activeCreatureUpdates.exchange(0),
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+        TC_METRIC_VALUE("map_creatures_dormant", _dormantCreatureUpdates.exchange(0),
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+    }
+
+    if (sMetric->IsEnabled())
+    {
+        TC_METRIC_VALUE("map_repaths_computed", _computedRepaths.exchange(0),
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+        TC_METRIC_VALUE("map_repaths_skipped", _skippedRepaths.exchange(0),
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+    }
+
+    if (_terrainStatusCache.IsEnabled() && sMetric->IsEnabled())
+    {
+        TerrainStatusCache::Statistics terrainStatusStatistics = _terrainStatusCache.ConsumeStatistics();
+        TC_METRIC_VALUE("map_terrain_status_cache_hits", terrainStatusStatistics.Hits,
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+        TC_METRIC_VALUE("map_terrain_status_cache_misses", terrainStatusStatistics.Misses,
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+    }
+
+    if (_pathCache && sMetric->IsEnabled())
+    {
+        PathCache::Statistics pathStatistics = _pathCache->ConsumeStatistics();
+        TC_METRIC_VALUE("map_path_cache_hits", pathStatistics.Hits,
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+        TC_METRIC_VALUE("map_path_cache_misses", pathStatistics.Misses,
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+    }
+}
+
+void Map::StartReplayRecording(uint32 seed)
+{
+    std::lock_guard<std::mutex> lock(_replayRecordingLock);
+    _replayRecording = std::make_unique<MapReplay>(GetId(), seed);
+}
+
+std::unique_ptr<MapReplay> Map::StopReplayRecording()
+{
+    std::lock_guard<std::mutex> lock(_replayRecordingLock);
+    return std::move(_replayRecording);
 }
 
 struct ResetNotifier
@@ -867,8 +1577,26 @@ struct ResetNotifier
     void Visit(PlayerMapType &m) { resetNotify<Player>(m);}
 };
 
+void Map::MarkRelocationNotifyCell(float x, float y)
+{
+    CellCoord cellCoord = Trinity::ComputeCellCoord(x, y);
+    if (!cellCoord.IsCoordValid())
+        return;
+
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+    _relocationNotifyCells.set(cellCoord.GetId());
+}
+
 void Map::ProcessRelocationNotifies(const uint32 diff)
 {
+    // players are processed from their own cell but notify flags are set on their viewpoint
+    for (MapReference const& ref : m_mapRefManager)
+    {
+        Player* player = ref.GetSource();
+        if (player->m_seer != player && player->m_seer->isNeedNotify(NOTIFY_VISIBILITY_CHANGED))
+            MarkRelocationNotifyCell(player->GetPositionX(), player->GetPositionY());
+    }
+
     for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end(); ++i)
     {
         NGridType *grid = i->GetSource();
@@ -890,7 +1618,7 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
             for (uint32 y = cell_min.y_coord; y < cell_max.y_coord; ++y)
             {
                 uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                if (!isCellMarked(cell_id))
+                if (!isCellMarked(cell_id) || !_relocationNotifyCells.test(cell_id))
                     continue;
 
                 CellCoord pair(x, y);
@@ -931,7 +1659,7 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
             for (uint32 y = cell_min.y_coord; y < cell_max.y_coord; ++y)
             {
                 uint32 cell_id = (y * TOTAL_NUMBER_OF_CELLS_PER_MAP) + x;
-                if (!isCellMarked(cell_id))
+                if (!isCellMarked(cell_id) || !_relocationNotifyCells.test(cell_id))
                     continue;
 
                 CellCoord pair(x, y);
@@ -939,6 +1667,8 @@ void Map::ProcessRelocationNotifies(const uint32 diff)
                 cell.SetNoCreate();
                 Visit(cell, grid_notifier);
                 Visit(cell, world_notifier);
+
+                _relocationNotifyCells.reset(cell_id);
             }
         }
     }
@@ -1202,6 +1932,8 @@ void Map::AreaTriggerRelocation(AreaTrigger* at, float x, float y, float z, floa
 
 void Map::AddCreatureToMoveList(Creature* c, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+
     if (_creatureToMoveLock) //can this happen?
         return;
 
@@ -1212,6 +1944,8 @@ void Map::AddCreatureToMoveList(Creature* c, float x, float y, float z, float an
 
 void Map::RemoveCreatureFromMoveList(Creature* c)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+
     if (_creatureToMoveLock) //can this happen?
         return;
 
@@ -1221,6 +1955,8 @@ void Map::RemoveCreatureFromMoveList(Creature* c)
 
 void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+
     if (_gameObjectsToMoveLock) //can this happen?
         return;
 
@@ -1231,6 +1967,8 @@ void Map::AddGameObjectToMoveList(GameObject* go, float x, float y, float z, flo
 
 void Map::RemoveGameObjectFromMoveList(GameObject* go)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+
     if (_gameObjectsToMoveLock) //can this happen?
         return;
 
@@ -1240,6 +1978,8 @@ void Map::RemoveGameObjectFromMoveList(GameObject* go)
 
 void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+
     if (_dynamicObjectsToMoveLock) //can this happen?
         return;
 
@@ -1250,6 +1990,8 @@ void Map::AddDynamicObjectToMoveList(DynamicObject* dynObj, float x, float y, fl
 
 void Map::RemoveDynamicObjectFromMoveList(DynamicObject* dynObj)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+
     if (_dynamicObjectsToMoveLock) //can this happen?
         return;
 
@@ -1259,6 +2001,8 @@ void Map::RemoveDynamicObjectFromMoveList(DynamicObject* dynObj)
 
 void Map::AddAreaTriggerToMoveList(AreaTrigger* at, float x, float y, float z, float ang)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+
     if (_areaTriggersToMoveLock) //can this happen?
         return;
 
@@ -1269,6 +2013,8 @@ void Map::AddAreaTriggerToMoveList(AreaTrigger* at, float x, float y, float z, f
 
 void Map::RemoveAreaTriggerFromMoveList(AreaTrigger* at)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+
     if (_areaTriggersToMoveLock) //can this happen?
         return;
 
@@ -1661,11 +2407,123 @@ bool Map::UnloadGrid(NGridType& ngrid, bool unloadAll)
     int gy = (MAX_NUMBER_OF_GRIDS - 1) - y;
 
     m_terrain->UnloadMap(gx, gy);
+    _lineOfSightCache.Clear();
+    _terrainStatusCache.Clear();
+    if (_pathCache)
+        _pathCache->Clear();
 
     TC_LOG_DEBUG("maps", "Unloading grid[{}, {}] for map {} finished", x, y, GetId());
     return true;
 }
 
+bool Map::IsGridMemoryBudgetEnabled()
+{
+    return sWorld->getBoolConfig(CONFIG_GRID_UNLOAD) &&
+        (sWorld->getIntConfig(CONFIG_GRID_MEMORY_BUDGET_PER_MAP) || sWorld->getIntConfig(CONFIG_GRID_MEMORY_BUDGET_TOTAL));
+}
+
+void Map::UpdateGridMemoryUsage(NGridType& grid)
+{
+    std::size_t size = sizeof(NGridType);
+
+    size += grid.GetWorldObjectCountInNGrid<Player>() * sizeof(Player);
+    size += grid.GetWorldObjectCountInNGrid<Creature>() * sizeof(Creature);
+    size += grid.GetWorldObjectCountInNGrid<Corpse>() * sizeof(Corpse);
+    size += grid.GetWorldObjectCountInNGrid<DynamicObject>() * sizeof(DynamicObject);
+
+    size += grid.GetGridObjectCountInNGrid<GameObject>() * sizeof(GameObject);
+    size += grid.GetGridObjectCountInNGrid<Creature>() * sizeof(Creature);
+    size += grid.GetGridObjectCountInNGrid<DynamicObject>() * sizeof(DynamicObject);
+    size += grid.GetGridObjectCountInNGrid<Corpse>() * sizeof(Corpse);
+    size += grid.GetGridObjectCountInNGrid<AreaTrigger>() * sizeof(AreaTrigger);
+    size += grid.GetGridObjectCountInNGrid<SceneObject>() * sizeof(SceneObject);
+    size += grid.GetGridObjectCountInNGrid<Conversation>() * sizeof(Conversation);
+
+    // terrain is shared between instances of the same map, it is only released when the last of them unloads the grid
+    int32 gx = (MAX_NUMBER_OF_GRIDS - 1) - grid.getX();
+    int32 gy = (MAX_NUMBER_OF_GRIDS - 1) - grid.getY();
+    if (!m_terrain->IsGridReferencedByOtherMaps(gx, gy))
+        size += m_terrain->GetGridMemoryUsage(gx, gy);
+
+    grid.getGridInfoRef()->setMemoryUsage(size);
+}
+
+std::size_t Map::GetGridsMemoryUsage()
+{
+    std::size_t size = 0;
+    for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end(); ++i)
+        size += i->GetSource()->getGridInfoRef()->getMemoryUsage();
+
+    return size;
+}
+
+NGridType* Map::GetLeastRecentlyUsedIdleGrid(uint32 activeBefore)
+{
+    // grids of battlegrounds are never unloaded, see DelayedUpdate
+    if (IsBattlegroundOrArena())
+        return nullptr;
+
+    NGridType* result = nullptr;
+    for (GridRefManager<NGridType>::iterator i = GridRefManager<NGridType>::begin(); i != GridRefManager<NGridType>::end(); ++i)
+    {
+        NGridType* grid = i->GetSource();
+        if (grid->GetGridState() != GRID_STATE_REMOVAL || grid->getUnloadLock())
+            continue;
+
+        uint32 lastActiveTime = grid->getGridInfoRef()->getLastActiveTime();
+        if (lastActiveTime >= activeBefore)
+            continue;
+
+        if (!result || lastActiveTime < result->getGridInfoRef()->getLastActiveTime())
+            result = grid;
+    }
+
+    return result;
+}
+
+std::size_t Map::UnloadGridForMemoryBudget(NGridType& grid)
+{
+    GridInfo* info = grid.getGridInfoRef();
+    std::size_t size = info->getMemoryUsage();
+    int32 x = grid.getX();
+    int32 y = grid.getY();
+    uint32 idleTime = getMSTimeDiff(info->getLastActiveTime(), GameTime::GetGameTimeMS());
+
+    if (!UnloadGrid(grid, false))
+    {
+        // move it to the back of the queue, it is retried once it becomes the least recently used grid again
+        info->setLastActiveTime(GameTime::GetGameTimeMS());
+        TC_LOG_DEBUG("maps", "Grid[{}, {}] for map {} differed unloading due to players or active objects nearby", x, y, GetId());
+        return 0;
+    }
+
+    TC_LOG_DEBUG("maps", "Grid[{}, {}] on map {} instance {} unloaded to stay within memory budget, released {} bytes after being idle for {} ms",
+        x, y, GetId(), GetInstanceId(), size, idleTime);
+    TC_METRIC_VALUE("grid_evicted_bytes", uint64(size), TC_METRIC_TAG("map_id", std::to_string(GetId())));
+    return size;
+}
+
+void Map::UnloadGridsOverMemoryBudget(std::size_t budget)
+{
+    std::size_t usage = GetGridsMemoryUsage();
+    uint32 now = GameTime::GetGameTimeMS();
+    while (usage > budget)
+    {
+        NGridType* grid = GetLeastRecentlyUsedIdleGrid(now);
+        if (!grid)
+            break;
+
+        usage -= std::min(usage, UnloadGridForMemoryBudget(*grid));
+    }
+}
+
+void Map::CreateGridForPosition(float x, float y)
+{
+    GridCoord p = Trinity::ComputeGridCoord(x, y);
+    if (p.IsCoordValid())
+        EnsureGridCreated(p);
+}
+
 void Map::RemoveAllPlayers()
 {
     if (HavePlayers())
@@ -1722,7 +2580,7 @@ void Map::UnloadAll()
 void Map::GetFullTerrainStatusForPosition(PhaseShift const& phaseShift, float x, float y, float z, PositionFullTerrainStatus& data,
     Optional<map_liquidHeaderTypeFlags> reqLiquidType, float collisionHeight)
 {
-    m_terrain->GetFullTerrainStatusForPosition(phaseShift, GetId(), x, y, z, data, reqLiquidType, collisionHeight, &_dynamicTree);
+    m_terrain->GetFullTerrainStatusForPosition(phaseShift, GetId(), x, y, z, data, reqLiquidType, collisionHeight, &_dynamicTree, &_terrainStatusCache);
 }
 
 ZLiquidStatus Map::GetLiquidStatus(PhaseShift const& phaseShift, float x, float y, float z, Optional<map_liquidHeaderTypeFlags> ReqLiquidType, LiquidData* data,
@@ -1761,6 +2619,18 @@ float Map::GetStaticHeight(PhaseShift const& phaseShift, float x, float y, float
     return m_terrain->GetStaticHeight(phaseShift, GetId(), x, y, z, checkVMap, maxSearchDist);
 }
 
+void Map::GetStaticHeights(PhaseShift const& phaseShift, std::span<G3D::Vector3 const> positions, std::span<float> heights, bool checkVMap, float maxSearchDist)
+{
+    m_terrain->GetStaticHeights(phaseShift, GetId(), positions, heights, checkVMap, maxSearchDist);
+}
+
+void Map::GetHeights(PhaseShift const& phaseShift, std::span<G3D::Vector3 const> positions, std::span<float> heights, bool vmap, float maxSearchDist)
+{
+    GetStaticHeights(phaseShift, positions, heights, vmap, maxSearchDist);
+    for (std::size_t i = 0; i < positions.size(); ++i)
+        heights[i] = std::max<float>(heights[i], GetGameObjectFloor(phaseShift, positions[i].x, positions[i].y, positions[i].z, maxSearchDist));
+}
+
 float Map::GetWaterLevel(PhaseShift const& phaseShift, float x, float y)
 {
     return m_terrain->GetWaterLevel(phaseShift, GetId(), x, y);
@@ -1783,15 +2653,75 @@ float Map::GetWaterOrGroundLevel(PhaseShift const& phaseShift, float x, float y,
 
 bool Map::isInLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
 {
-    if ((checks & LINEOFSIGHT_CHECK_VMAP)
-      && !VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(PhasingHandler::GetTerrainMapId(phaseShift, GetId(), m_terrain.get(), x1, y1), x1, y1, z1, x2, y2, z2, ignoreFlags))
-        return false;
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+    {
+        uint32 terrainMapId = PhasingHandler::GetTerrainMapId(phaseShift, GetId(), m_terrain.get(), x1, y1);
+        if (_lineOfSightCache.IsEnabled())
+        {
+            G3D::Vector3 start(x1, y1, z1);
+            G3D::Vector3 end(x2, y2, z2);
+            Optional<bool> inLineOfSight = _lineOfSightCache.Find(terrainMapId, start, end, uint8(ignoreFlags));
+            if (!inLineOfSight)
+            {
+                inLineOfSight = VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(terrainMapId, x1, y1, z1, x2, y2, z2, ignoreFlags);
+                _lineOfSightCache.Store(terrainMapId, start, end, uint8(ignoreFlags), *inLineOfSight);
+            }
+
+            if (!*inLineOfSight)
+                return false;
+        }
+        else if (!VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(terrainMapId, x1, y1, z1, x2, y2, z2, ignoreFlags))
+            return false;
+    }
     if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT)
       && !_dynamicTree.isInLineOfSight({ x1, y1, z1 }, { x2, y2, z2 }, phaseShift))
         return false;
     return true;
 }
 
+void Map::isInLineOfSight(PhaseShift const& phaseShift, G3D::Vector3 const& pos, std::span<G3D::Vector3 const> targets, std::span<bool> results, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    std::fill(results.begin(), results.end(), true);
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+    {
+        uint32 terrainMapId = PhasingHandler::GetTerrainMapId(phaseShift, GetId(), m_terrain.get(), pos.x, pos.y);
+        bool useCache = _lineOfSightCache.IsEnabled();
+        std::vector<G3D::Vector3> uncachedTargets;
+        std::vector<std::size_t> uncachedIndexes;
+        for (std::size_t i = 0; i < targets.size(); ++i)
+        {
+            Optional<bool> inLineOfSight;
+            if (useCache)
+                inLineOfSight = _lineOfSightCache.Find(terrainMapId, pos, targets[i], uint8(ignoreFlags));
+
+            if (inLineOfSight)
+                results[i] = *inLineOfSight;
+            else
+            {
+                uncachedTargets.push_back(targets[i]);
+                uncachedIndexes.push_back(i);
+            }
+        }
+
+        if (!uncachedTargets.empty())
+        {
+            std::unique_ptr<bool[]> uncachedResults = std::make_unique<bool[]>(uncachedTargets.size());
+            VMAP::VMapFactory::createOrGetVMapManager()->isInLineOfSight(terrainMapId, pos, uncachedTargets, { uncachedResults.get(), uncachedTargets.size() }, ignoreFlags);
+            for (std::size_t i = 0; i < uncachedTargets.size(); ++i)
+            {
+                results[uncachedIndexes[i]] = uncachedResults[i];
+                if (useCache)
+                    _lineOfSightCache.Store(terrainMapId, pos, uncachedTargets[i], uint8(ignoreFlags), uncachedResults[i]);
+            }
+        }
+    }
+
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT))
+        for (std::size_t i = 0; i < targets.size(); ++i)
+            if (results[i] && !_dynamicTree.isInLineOfSight(pos, targets[i], phaseShift))
+                results[i] = false;
+}
+
 bool Map::getObjectHitPos(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist)
 {
     G3D::Vector3 startPos(x1, y1, z1);
@@ -1963,7 +2893,7 @@ inline void Map::setNGrid(NGridType *grid, uint32 x, uint32 y)
 
 void Map::SendObjectUpdates()
 {
-    UpdateDataMapType update_players;
+    UpdateDataMapType update_players(Trinity::TickArena::GetResource());
 
     while (!_updateObjects.empty())
     {
@@ -1973,13 +2903,55 @@ void Map::SendObjectUpdates()
         obj->BuildUpdate(update_players);
     }
 
-    WorldPacket packet;                                     // here we allocate a std::vector with a size of 0x10000
-    for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+    // every packet is built for a single player so its storage is handed to the socket instead of being copied there,
+    // compression and encryption then happen on the network thread
+    static constexpr std::size_t PlayersPerPacketBuildTask = 32;
+    if (!_regionUpdatePool || update_players.size() <= PlayersPerPacketBuildTask)
+    {
+        for (UpdateDataMapType::iterator iter = update_players.begin(); iter != update_players.end(); ++iter)
+        {
+            WorldPacket packet;
+            iter->second.BuildPacket(&packet);
+            iter->first->SendDirectMessage(std::make_shared<WorldPacket const>(std::move(packet)));
+        }
+        return;
+    }
+
+    // crowded maps copy a lot of update data into packets, spread that over the region threads and keep sending on the map thread
+    Trinity::TickVector<std::pair<Player*, UpdateData*>> receivers(Trinity::TickArena::GetResource());
+    receivers.reserve(update_players.size());
+    for (auto& [player, updateData] : update_players)
+        receivers.emplace_back(player, &updateData);
+
+    std::vector<WorldPacket> packets(receivers.size());
+    std::size_t taskCount = (receivers.size() + PlayersPerPacketBuildTask - 1) / PlayersPerPacketBuildTask;
+    std::atomic<std::size_t> nextTask = 0;
+    auto buildPackets = [&]()
+    {
+        for (std::size_t task = nextTask++; task < taskCount; task = nextTask++)
+        {
+            std::size_t end = std::min((task + 1) * PlayersPerPacketBuildTask, receivers.size());
+            for (std::size_t i = task * PlayersPerPacketBuildTask; i < end; ++i)
+                receivers[i].second->BuildPacket(&packets[i]);
+        }
+    };
+
+    // the map thread builds packets too, helpers that start late find nothing left to do
+    std::latch helpersDone(taskCount - 1);
+    for (std::size_t i = 1; i < taskCount; ++i)
     {
-        iter->second.BuildPacket(&packet);
-        iter->first->SendDirectMessage(&packet);
-        packet.clear();                                     // clean the string
+        _regionUpdatePool->PostWork([&buildPackets, &helpersDone]()
+        {
+            buildPackets();
+            helpersDone.count_down();
+        });
     }
+
+    buildPackets();
+    helpersDone.wait();
+
+    for (std::size_t i = 0; i < receivers.size(); ++i)
+        receivers[i].first->SendDirectMessage(std::make_shared<WorldPacket const>(std::move(packets[i])));
 }
 
 // CheckRespawn MUST do one of the following:
@@ -2062,7 +3034,7 @@ void Map::Respawn(RespawnInfo* info, CharacterDatabaseTransaction dbTrans)
     if (info->respawnTime <= GameTime::GetGameTime())
         return;
     info->respawnTime = GameTime::GetGameTime();
-    _respawnTimes->increase(static_cast<RespawnInfoWithHandle*>(info)->handle);
+    _respawnTimes->Reschedule(static_cast<RespawnInfoWithHandle*>(info));
     SaveRespawnInfoDB(*info, dbTrans);
 }
 
@@ -2119,7 +3091,7 @@ bool Map::AddRespawnInfo(RespawnInfo const& info)
         ABORT_MSG("Invalid respawn info for spawn id (%u," UI64FMTD ") being inserted", uint32(info.type), info.spawnId);
 
     RespawnInfoWithHandle* ri = new RespawnInfoWithHandle(info);
-    ri->handle = _respawnTimes->push(ri);
+    _respawnTimes->Insert(ri);
     bySpawnIdMap->emplace(ri->spawnId, ri);
     return true;
 }
@@ -2152,8 +3124,9 @@ RespawnInfo* Map::GetRespawnInfo(SpawnObjectType type, ObjectGuid::LowType spawn
 
 void Map::UnloadAllRespawnInfos() // delete everything from memory
 {
-    for (RespawnInfo* info : *_respawnTimes)
-        delete info;
+    for (RespawnInfoMap const* map : { &_creatureRespawnTimesBySpawnId, &_gameObjectRespawnTimesBySpawnId })
+        for (auto const& [spawnId, info] : *map)
+            delete info;
     _respawnTimes->clear();
     _creatureRespawnTimesBySpawnId.clear();
     _gameObjectRespawnTimesBySpawnId.clear();
@@ -2174,8 +3147,8 @@ void Map::DeleteRespawnInfo(RespawnInfo* info, CharacterDatabaseTransaction dbTr
     ASSERT(it != range.second, "Respawn stores inconsistent for map %u, spawnid " UI64FMTD " (type %u)", GetId(), info->spawnId, uint32(info->type));
     spawnMap->erase(it);
 
-    // respawn heap
-    _respawnTimes->erase(static_cast<RespawnInfoWithHandle*>(info)->handle);
+    // respawn queue
+    _respawnTimes->Erase(static_cast<RespawnInfoWithHandle*>(info));
 
     // database
     DeleteRespawnInfoFromDB(info->type, info->spawnId, dbTrans);
@@ -2226,16 +3199,14 @@ void Map::DoRespawn(SpawnObjectType type, ObjectGuid::LowType spawnId, uint32 gr
 void Map::ProcessRespawns()
 {
     time_t now = GameTime::GetGameTime();
-    while (!_respawnTimes->empty())
+    uint32 processed = 0;
+    while (RespawnInfoWithHandle* next = _respawnTimes->PopDue(now))
     {
-        RespawnInfoWithHandle* next = _respawnTimes->top();
-        if (now < next->respawnTime) // done for this tick
-            break;
+        ++processed;
 
         if (uint32 poolId = sPoolMgr->IsPartOfAPool(next->type, next->spawnId)) // is this part of a pool?
         { // if yes, respawn will be handled by (external) pooling logic, just delete the respawn time
             // step 1: remove entry from maps to avoid it being reachable by outside logic
-            _respawnTimes->pop();
             ASSERT_NOTNULL(GetRespawnMapForType(next->type))->erase(next->spawnId);
 
             // step 2: tell pooling logic to do its thing
@@ -2248,7 +3219,6 @@ void Map::ProcessRespawns()
         else if (CheckRespawn(next)) // see if we're allowed to respawn
         { // ok, respawn
             // step 1: remove entry from maps to avoid it being reachable by outside logic
-            _respawnTimes->pop();
             ASSERT_NOTNULL(GetRespawnMapForType(next->type))->erase(next->spawnId);
 
             // step 2: do the respawn, which involves external logic
@@ -2260,18 +3230,22 @@ void Map::ProcessRespawns()
         }
         else if (!next->respawnTime)
         { // just remove this respawn entry without rescheduling
-            _respawnTimes->pop();
             ASSERT_NOTNULL(GetRespawnMapForType(next->type))->erase(next->spawnId);
             RemoveRespawnTime(next->type, next->spawnId, nullptr, true);
             delete next;
         }
         else
-        { // new respawn time, update heap position
+        { // new respawn time, put it back in the queue
             ASSERT(now < next->respawnTime); // infinite loop guard
-            _respawnTimes->decrease(next->handle);
+            _respawnTimes->Insert(next);
             SaveRespawnInfoDB(*next);
         }
     }
+
+    if (processed)
+        TC_METRIC_VALUE("map_respawns", uint64(processed),
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
 }
 
 void Map::ApplyDynamicModeRespawnScaling(WorldObject const* obj, ObjectGuid::LowType spawnId, uint32& respawnDelay, uint32 mode) const
@@ -2548,19 +3522,155 @@ ObjectGuidGenerator& Map::GetGuidSequenceGenerator(HighGuid high)
 
 void Map::AddFarSpellCallback(FarSpellCallback&& callback)
 {
-    _farSpellCallbacks.Enqueue(new FarSpellCallback(std::move(callback)));
+    MapMessage* message = _messagePool.Acquire();
+    message->Type = MapMessageType::Callback;
+    message->Callback = std::move(callback);
+    SendMessage(message);
 }
 
-void Map::DelayedUpdate(uint32 t_diff)
+void Map::AddFarSpellEffect(Spell* spell, SpellEffectInfo const& spellEffectInfo, ObjectGuid const& targetGuid)
+{
+    MapMessage* message = _messagePool.Acquire();
+    message->Type = MapMessageType::FarSpellEffect;
+    message->SpellOrigin = spell;
+    message->EffectInfo = &spellEffectInfo;
+    message->Target = targetGuid;
+    SendMessage(message);
+}
+
+void Map::AddGameEventChanges(std::vector<GameEventMapChange> changes)
+{
+    AddFarSpellCallback([changes = std::move(changes)](Map* map)
+    {
+        map->_gameEventChanges.insert(map->_gameEventChanges.end(), changes.begin(), changes.end());
+    });
+}
+
+void Map::ProcessGameEventChanges()
+{
+    uint32 limit = sWorld->getIntConfig(CONFIG_GAME_EVENT_SPAWN_BATCH_SIZE);
+    for (uint32 processed = 0; !_gameEventChanges.empty() && (!limit || processed < limit); ++processed)
+    {
+        GameEventMapChange change = _gameEventChanges.front();
+        _gameEventChanges.pop_front();
+
+        switch (change.Action)
+        {
+            case GameEventMapAction::SpawnCreature:
+                if (CreatureData const* data = sObjectMgr->GetCreatureData(change.Id))
+                {
+                    RemoveRespawnTime(SPAWN_TYPE_CREATURE, change.Id);
+                    // We use spawn coords to spawn
+                    if (IsGridLoaded(data->spawnPoint))
+                        Creature::CreateCreatureFromDB(change.Id, this);
+                }
+                break;
+            case GameEventMapAction::DespawnCreature:
+            {
+                RemoveRespawnTime(SPAWN_TYPE_CREATURE, change.Id);
+                auto creatureBounds = GetCreatureBySpawnIdStore().equal_range(change.Id);
+                for (auto itr = creatureBounds.first; itr != creatureBounds.second;)
+                {
+                    Creature* creature = itr->second;
+                    ++itr;
+                    creature->AddObjectToRemoveList();
+                }
+                break;
+            }
+            case GameEventMapAction::SpawnGameObject:
+                if (GameObjectData const* data = sObjectMgr->GetGameObjectData(change.Id))
+                {
+                    RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, change.Id);
+                    // the grid may have been loaded with the spawn already in it since the change was queued
+                    if (IsGridLoaded(data->spawnPoint) && GetGameObjectBySpawnIdStore().find(change.Id) == GetGameObjectBySpawnIdStore().end())
+                    {
+                        if (GameObject* go = GameObject::CreateGameObjectFromDB(change.Id, this, false))
+                        {
+                            /// @todo find out when it is add to map
+                            if (go->isSpawnedByDefault())
+                            {
+                                if (!AddToMap(go))
+                                    delete go;
+                            }
+                        }
+                    }
+                }
+                break;
+            case GameEventMapAction::DespawnGameObject:
+            {
+                RemoveRespawnTime(SPAWN_TYPE_GAMEOBJECT, change.Id);
+                auto gameobjectBounds = GetGameObjectBySpawnIdStore().equal_range(change.Id);
+                for (auto itr = gameobjectBounds.first; itr != gameobjectBounds.second;)
+                {
+                    GameObject* go = itr->second;
+                    ++itr;
+                    go->AddObjectToRemoveList();
+                }
+                break;
+            }
+            case GameEventMapAction::SpawnPool:
+                sPoolMgr->SpawnPool(GetPoolData(), change.Id);
+                break;
+            case GameEventMapAction::DespawnPool:
+                sPoolMgr->DespawnPool(GetPoolData(), change.Id, true);
+                break;
+            case GameEventMapAction::StartEventAI:
+            case GameEventMapAction::EndEventAI:
+                sGameEventMgr->RunSmartAIScriptsOnMap(this, uint16(change.Id), change.Action == GameEventMapAction::StartEventAI);
+                break;
+        }
+    }
+}
+
+void Map::SendMessage(MapMessage* message)
 {
+    _messages.Enqueue(message);
+}
+
+void Map::ProcessMessages()
+{
+    std::array<uint32, MAX_MAP_MESSAGE_TYPES> handled = { };
+
+    MapMessage* message;
+    while (_messages.Dequeue(message))
     {
-        FarSpellCallback* callback;
-        while (_farSpellCallbacks.Dequeue(callback))
+        switch (message->Type)
         {
-            (*callback)(this);
-            delete callback;
+            case MapMessageType::FarSpellEffect:
+                message->SpellOrigin->HandleFarEffect(this, *message->EffectInfo, message->Target);
+                break;
+            case MapMessageType::Callback:
+                message->Callback(this);
+                break;
+            default:
+                ABORT_MSG("Map::ProcessMessages: unhandled message type %u", uint32(message->Type));
+                break;
         }
+
+        ++handled[std::size_t(message->Type)];
+        _handledMessageBatch.push_back(message);
+    }
+
+    if (_handledMessageBatch.empty())
+        return;
+
+    _messagePool.Release(_handledMessageBatch);
+
+    for (std::size_t i = 0; i < handled.size(); ++i)
+    {
+        if (!handled[i])
+            continue;
+
+        _handledMessages[i] += handled[i];
+        TC_METRIC_VALUE("map_messages", uint64(handled[i]),
+            TC_METRIC_TAG("map_id", std::to_string(GetId())),
+            TC_METRIC_TAG("type", GetMapMessageTypeName(MapMessageType(i))));
     }
+}
+
+void Map::DelayedUpdate(uint32 t_diff)
+{
+    ProcessMessages();
 
     RemoveAllObjectsInRemoveList();
 
@@ -2576,6 +3686,9 @@ void Map::DelayedUpdate(uint32 t_diff)
             ASSERT(grid->GetGridState() >= 0 && grid->GetGridState() < MAX_GRID_STATE);
             si_GridStates[grid->GetGridState()]->Update(*this, *grid, *info, t_diff);
         }
+
+        if (uint32 budget = sWorld->getIntConfig(CONFIG_GRID_MEMORY_BUDGET_PER_MAP); budget && IsGridMemoryBudgetEnabled())
+            UnloadGridsOverMemoryBudget(std::size_t(budget) * 1024 * 1024);
     }
 }
 
@@ -2583,6 +3696,8 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 {
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
 
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+
     obj->SetDestroyedObject(true);
     obj->CleanupsBeforeDelete(false);                            // remove or simplify at least cross referenced links
 
@@ -2592,6 +3707,8 @@ void Map::AddObjectToRemoveList(WorldObject* obj)
 void Map::AddObjectToSwitchList(WorldObject* obj, bool on)
 {
     ASSERT(obj->GetMapId() == GetId() && obj->GetInstanceId() == GetInstanceId());
+
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
     // i_objectsToSwitch is iterated only in Map::RemoveAllObjectsInRemoveList() and it uses
     // the contained objects only if GetTypeId() == TYPEID_UNIT , so we can return in all other cases
     if (obj->GetTypeId() != TYPEID_UNIT)
@@ -2695,6 +3812,51 @@ void Map::SendToPlayers(WorldPacket const* data) const
         itr->GetSource()->SendDirectMessage(data);
 }
 
+void Map::UpdatePlayerNearCells()
+{
+    if (!sWorld->getIntConfig(CONFIG_CREATURE_DORMANT_UPDATE_INTERVAL))
+    {
+        if (!_playerNearCells.empty())
+        {
+            _playerNearCells = std::vector<bool>();
+            _playerNearCellIds = std::vector<uint32>();
+        }
+        return;
+    }
+
+    if (_playerNearCells.empty())
+        _playerNearCells.resize(TOTAL_NUMBER_OF_CELLS_PER_MAP * TOTAL_NUMBER_OF_CELLS_PER_MAP);
+
+    for (uint32 cellId : _playerNearCellIds)
+        _playerNearCells[cellId] = false;
+    _playerNearCellIds.clear();
+
+    uint32 cellRange = uint32(std::ceil(GetVisibilityRange() / SIZE_OF_GRID_CELL));
+    for (MapRefManager::iterator iter = m_mapRefManager.begin(); iter != m_mapRefManager.end(); ++iter)
+    {
+        Player* player = iter->GetSource();
+        CellCoord low = Trinity::ComputeCellCoord(player->GetPositionX(), player->GetPositionY());
+        CellCoord high = low;
+        low.dec_x(cellRange);
+        low.dec_y(cellRange);
+        high.inc_x(cellRange);
+        high.inc_y(cellRange);
+
+        for (uint32 x = low.x_coord; x <= high.x_coord; ++x)
+        {
+            for (uint32 y = low.y_coord; y <= high.y_coord; ++y)
+            {
+                uint32 cellId = CellCoord(x, y).GetId();
+                if (!_playerNearCells[cellId])
+                {
+                    _playerNearCells[cellId] = true;
+                    _playerNearCellIds.push_back(cellId);
+                }
+            }
+        }
+    }
+}
+
 bool Map::ActiveObjectsNearGrid(NGridType const& ngrid) const
 {
     CellCoord cell_min(ngrid.getX() * MAX_NUMBER_OF_CELLS, ngrid.getY() * MAX_NUMBER_OF_CELLS);
@@ -2830,18 +3992,26 @@ template TC_GAME_API void Map::RemoveFromMap(Conversation*, bool);
 
 InstanceMap::InstanceMap(uint32 id, time_t expiry, uint32 InstanceId, Difficulty SpawnMode, TeamId InstanceTeam, InstanceLock* instanceLock)
   : Map(id, expiry, InstanceId, SpawnMode),
-    i_data(nullptr), i_script_id(0), i_scenario(nullptr), i_instanceLock(instanceLock)
+    i_data(nullptr), i_script_id(0), i_scenario(nullptr), i_instanceLock(nullptr)
 {
     //lets initialize visibility distance for dungeons
     InstanceMap::InitVisibilityDistance();
 
+    Bind(InstanceTeam, instanceLock);
+}
+
+void InstanceMap::Bind(TeamId instanceTeam, InstanceLock* instanceLock)
+{
+    ASSERT(!i_instanceLock);
+
     // the timer is started by default, and stopped when the first player joins
     // this make sure it gets unloaded if for some reason no player joins
     m_unloadTimer = std::max(sWorld->getIntConfig(CONFIG_INSTANCE_UNLOAD_DELAY), (uint32)MIN_UNLOAD_DELAY);
 
-    sWorldStateMgr->SetValue(WS_TEAM_IN_INSTANCE_ALLIANCE, InstanceTeam == TEAM_ALLIANCE, false, this);
-    sWorldStateMgr->SetValue(WS_TEAM_IN_INSTANCE_HORDE, InstanceTeam == TEAM_HORDE, false, this);
+    sWorldStateMgr->SetValue(WS_TEAM_IN_INSTANCE_ALLIANCE, instanceTeam == TEAM_ALLIANCE, false, this);
+    sWorldStateMgr->SetValue(WS_TEAM_IN_INSTANCE_HORDE, instanceTeam == TEAM_HORDE, false, this);
 
+    i_instanceLock = instanceLock;
     if (i_instanceLock)
     {
         i_instanceLock->SetInUse(true);
@@ -2955,6 +4125,7 @@ void InstanceMap::Update(uint32 t_diff)
 
     if (i_data)
     {
+        ScriptProfiler::ScopedCall profileCall(ScriptProfileHook::Instance, GetId(), [this]() -> std::string_view { return GetScriptName(); });
         i_data->Update(t_diff);
         i_data->UpdateCombatResurrection(t_diff);
     }
@@ -3491,16 +4662,19 @@ void BattlegroundMap::Update(uint32 diff)
 
 AreaTrigger* Map::GetAreaTrigger(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
     return _objectsStore.Find<AreaTrigger>(guid);
 }
 
 SceneObject* Map::GetSceneObject(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
     return _objectsStore.Find<SceneObject>(guid);
 }
 
 Conversation* Map::GetConversation(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
     return _objectsStore.Find<Conversation>(guid);
 }
 
@@ -3511,26 +4685,31 @@ Player* Map::GetPlayer(ObjectGuid const& guid)
 
 Corpse* Map::GetCorpse(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
     return _objectsStore.Find<Corpse>(guid);
 }
 
 Creature* Map::GetCreature(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
     return _objectsStore.Find<Creature>(guid);
 }
 
 DynamicObject* Map::GetDynamicObject(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
     return _objectsStore.Find<DynamicObject>(guid);
 }
 
 GameObject* Map::GetGameObject(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
     return _objectsStore.Find<GameObject>(guid);
 }
 
 Pet* Map::GetPet(ObjectGuid const& guid)
 {
+    std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
     return _objectsStore.Find<Pet>(guid);
 }
 
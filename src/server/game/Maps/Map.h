@@ -26,22 +26,32 @@
 #include "GridDefines.h"
 #include "GridRefManager.h"
 #include "GroupInstanceReference.h"
+#include "LineOfSightCache.h"
 #include "MapDefines.h"
+#include "MapMessage.h"
 #include "MapReference.h"
 #include "MapRefManager.h"
+#include "MapUpdateProfiler.h"
 #include "MPSCQueue.h"
 #include "ObjectGuid.h"
 #include "PersonalPhaseTracker.h"
 #include "SharedDefines.h"
 #include "SpawnData.h"
+#include "TerrainStatusCache.h"
 #include "Timer.h"
 #include "UniqueTrackablePtr.h"
 #include "WorldStateDefines.h"
+#include <array>
+#include <atomic>
 #include <bitset>
+#include <deque>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <span>
+#include <unordered_map>
 #include <unordered_set>
 
 class Battleground;
@@ -54,6 +64,8 @@ class InstanceLock;
 class InstanceMap;
 class InstanceScript;
 class InstanceScenario;
+class MapReplay;
+class PathCache;
 class Object;
 class PhaseShift;
 class Player;
@@ -79,7 +91,7 @@ enum Difficulty : uint8;
 enum WeatherState : uint32;
 enum class ItemContext : uint8;
 
-namespace Trinity { struct ObjectUpdater; }
+namespace Trinity { struct ObjectUpdater; class ThreadPool; }
 namespace Vignettes { struct VignetteData; }
 namespace VMAP { enum class ModelIgnoreFlags : uint32; }
 
@@ -154,10 +166,6 @@ struct ZoneDynamicInfo
 #define MAP_INVALID_ZONE      0xFFFFFFFF
 
 struct RespawnInfo; // forward declaration
-struct CompareRespawnInfo
-{
-    bool operator()(RespawnInfo const* a, RespawnInfo const* b) const;
-};
 using ZoneDynamicInfoMap = std::unordered_map<uint32 /*zoneId*/, ZoneDynamicInfo>;
 struct RespawnListContainer;
 using RespawnInfoMap = std::unordered_map<ObjectGuid::LowType, RespawnInfo*>;
@@ -171,17 +179,24 @@ struct TC_GAME_API RespawnInfo
     time_t respawnTime;
     uint32 gridId;
 };
-inline bool CompareRespawnInfo::operator()(RespawnInfo const* a, RespawnInfo const* b) const
+enum class GameEventMapAction : uint8
 {
-    if (a == b)
-        return false;
-    if (a->respawnTime != b->respawnTime)
-        return (a->respawnTime > b->respawnTime);
-    if (a->spawnId != b->spawnId)
-        return a->spawnId < b->spawnId;
-    ASSERT(a->type != b->type, "Duplicate respawn entry for spawnId (%u," UI64FMTD ") found!", a->type, a->spawnId);
-    return a->type < b->type;
-}
+    SpawnCreature,
+    DespawnCreature,
+    SpawnGameObject,
+    DespawnGameObject,
+    SpawnPool,
+    DespawnPool,
+    StartEventAI,
+    EndEventAI
+};
+
+// Game event change to one tagged spawn or pool (or to the AI of the whole map), queued by GameEventMgr and applied by the map itself
+struct GameEventMapChange
+{
+    GameEventMapAction Action;
+    uint64 Id;                                              // spawn id, pool id or event id
+};
 
 extern template class TypeUnorderedMapContainer<AllMapStoredObjectTypes, ObjectGuid>;
 typedef TypeUnorderedMapContainer<AllMapStoredObjectTypes, ObjectGuid> MapStoredObjectTypesContainer;
@@ -217,6 +232,21 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void VisitNearbyCellsOf(WorldObject* obj, TypeContainerVisitor<Trinity::ObjectUpdater, GridTypeMapContainer> &gridVisitor, TypeContainerVisitor<Trinity::ObjectUpdater, WorldTypeMapContainer> &worldVisitor);
         virtual void Update(uint32);
 
+        // wall clock duration of the last Update call in microseconds, used by MapUpdater to schedule expensive maps first
+        uint32 GetLastUpdateDuration() const { return m_lastUpdateDuration; }
+        void SetLastUpdateDuration(uint32 duration) { m_lastUpdateDuration = duration; }
+        MapUpdateProfiler const& GetUpdateProfiler() const { return _updateProfiler; }
+
+        // records player movement of every following update until stopped, see map_bench
+        void StartReplayRecording(uint32 seed);
+        std::unique_ptr<MapReplay> StopReplayRecording();
+
+        // Experimental: object updates of grid regions separated by at least one inactive grid run in parallel on this pool
+        // Anything that crosses regions is queued into the already deferred containers (move lists, remove list, far spell callbacks)
+        // and processed serially after all regions finished
+        void SetRegionUpdatePool(Trinity::ThreadPool* pool) { _regionUpdatePool = pool; }
+        bool IsRegionUpdateInProgress() const { return _regionUpdateInProgress; }
+
         float GetVisibilityRange() const { return m_VisibleDistance; }
         //function for setting up visibility distance for maps on per-type/per-Id basis
         virtual void InitVisibilityDistance();
@@ -227,6 +257,18 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void DynamicObjectRelocation(DynamicObject* go, float x, float y, float z, float orientation);
         void AreaTriggerRelocation(AreaTrigger* at, float x, float y, float z, float orientation);
 
+        // Area trigger target lists are refreshed together once all objects of the tick were updated,
+        // the units of every cell searched are collected once and shared by all area triggers overlapping that cell
+        struct AreaTriggerSearchCell
+        {
+            std::vector<Unit*> Players;
+            std::vector<Unit*> WorldCreatures;
+            std::vector<Unit*> GridCreatures;
+        };
+
+        void AddAreaTriggerToTargetUpdateList(AreaTrigger* at);
+        void GetAreaTriggerSearchCells(WorldObject const* center, float radius, std::vector<AreaTriggerSearchCell const*>& cells);
+
         template<class T, class CONTAINER>
         void Visit(Cell const& cell, TypeContainerVisitor<T, CONTAINER>& visitor);
 
@@ -237,6 +279,14 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         }
         bool IsRemovalGrid(Position const& pos) const { return IsRemovalGrid(pos.GetPositionX(), pos.GetPositionY()); }
 
+        // loads terrain of a not yet created grid on a background thread so that creating it later only has to spawn objects
+        void PrepareGridAsync(GridCoord const& p);
+        void PrepareGridsAround(float x, float y, float range);
+        void PrepareGridsAlongMovement(Player const* player);
+        // keeps navmesh tiles around players and active objects from being evicted, evicted ones are reloaded in the background
+        void TouchMMapTilesAround(float x, float y, float range);
+        void TouchMMapTilesOfActiveObjects();
+
         bool IsGridLoaded(uint32 gridId) const { return IsGridLoaded(GridCoord(gridId % MAX_NUMBER_OF_GRIDS, gridId / MAX_NUMBER_OF_GRIDS)); }
         bool IsGridLoaded(float x, float y) const { return IsGridLoaded(Trinity::ComputeGridCoord(x, y)); }
         bool IsGridLoaded(Position const& pos) const { return IsGridLoaded(pos.GetPositionX(), pos.GetPositionY()); }
@@ -246,6 +296,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void LoadGrid(float x, float y);
         void LoadGridForActiveObject(float x, float y, WorldObject const* object);
         void LoadAllCells();
+        // creates the grid and attaches its terrain without loading objects
+        void CreateGridForPosition(float x, float y);
         bool UnloadGrid(NGridType& ngrid, bool pForce);
         void GridMarkNoUnload(uint32 x, uint32 y);
         void GridUnmarkNoUnload(uint32 x, uint32 y);
@@ -258,6 +310,14 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         time_t GetGridExpiry() const { return i_gridExpiry; }
 
+        // memory budgeted grid unloading, idle grids stay loaded until a budget is exceeded instead of expiring after GridCleanUpDelay
+        static bool IsGridMemoryBudgetEnabled();
+        void UpdateGridMemoryUsage(NGridType& grid);
+        std::size_t GetGridsMemoryUsage();
+        NGridType* GetLeastRecentlyUsedIdleGrid(uint32 activeBefore);
+        std::size_t UnloadGridForMemoryBudget(NGridType& grid);
+        void UnloadGridsOverMemoryBudget(std::size_t budget);
+
         static void InitStateMachine();
         static void DeleteStateMachine();
 
@@ -290,6 +350,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         float GetStaticHeight(PhaseShift const& phaseShift, Position const& pos, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) { return GetStaticHeight(phaseShift, pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), checkVMap, maxSearchDist); }
         float GetHeight(PhaseShift const& phaseShift, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) { return std::max<float>(GetStaticHeight(phaseShift, x, y, z, vmap, maxSearchDist), GetGameObjectFloor(phaseShift, x, y, z, maxSearchDist)); }
         float GetHeight(PhaseShift const& phaseShift, Position const& pos, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) { return GetHeight(phaseShift, pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), vmap, maxSearchDist); }
+        void GetStaticHeights(PhaseShift const& phaseShift, std::span<G3D::Vector3 const> positions, std::span<float> heights, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH);
+        void GetHeights(PhaseShift const& phaseShift, std::span<G3D::Vector3 const> positions, std::span<float> heights, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH);
 
         float GetWaterLevel(PhaseShift const& phaseShift, float x, float y);
         bool IsInWater(PhaseShift const& phaseShift, float x, float y, float z, LiquidData* data = nullptr);
@@ -355,10 +417,18 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         bool isCellMarked(uint32 pCellId) { return marked_cells.test(pCellId); }
         void markCell(uint32 pCellId) { marked_cells.set(pCellId); }
 
+        // only cells containing objects waiting for visibility notifies are visited by ProcessRelocationNotifies
+        void MarkRelocationNotifyCell(float x, float y);
+
         bool HavePlayers() const { return !m_mapRefManager.isEmpty(); }
         uint32 GetPlayersCountExceptGMs() const;
         bool ActiveObjectsNearGrid(NGridType const& ngrid) const;
 
+        // creatures in cells out of visibility range of all players can update at a reduced rate, see Creature::CanBeDormant
+        bool IsPlayerNearCell(CellCoord const& cell) const { return _playerNearCells.empty() || _playerNearCells[cell.GetId()]; }
+        void CountCreatureUpdate(bool dormant) { ++(dormant ? _dormantCreatureUpdates : _activeCreatureUpdates); }
+        void CountRepath(bool computed) { ++(computed ? _computedRepaths : _skippedRepaths); }
+
         void AddWorldObject(WorldObject* obj) { i_worldObjects.insert(obj); }
         void RemoveWorldObject(WorldObject* obj) { i_worldObjects.erase(obj); }
 
@@ -422,6 +492,20 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         MapStoredObjectTypesContainer& GetObjectsStore() { return _objectsStore; }
 
+        template<class T>
+        void AddToObjectsStore(ObjectGuid const& guid, T* obj)
+        {
+            std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+            _objectsStore.Insert<T>(guid, obj);
+        }
+
+        template<class T>
+        void RemoveFromObjectsStore(ObjectGuid const& guid)
+        {
+            std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
+            _objectsStore.Remove<T>(guid);
+        }
+
         typedef std::unordered_multimap<ObjectGuid::LowType, Creature*> CreatureBySpawnIdContainer;
         CreatureBySpawnIdContainer& GetCreatureBySpawnIdStore() { return _creatureBySpawnIdStore; }
         CreatureBySpawnIdContainer const& GetCreatureBySpawnIdStore() const { return _creatureBySpawnIdStore; }
@@ -459,10 +543,15 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         BattlegroundMap const* ToBattlegroundMap() const { if (IsBattlegroundOrArena()) return reinterpret_cast<BattlegroundMap const*>(this); return nullptr; }
 
         bool isInLineOfSight(PhaseShift const& phaseShift, float x1, float y1, float z1, float x2, float y2, float z2, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+        // line of sight from one position to several targets, results[i] belongs to targets[i]
+        // vmap checks that are not cached are traced together, which is cheaper than one isInLineOfSight call per target
+        void isInLineOfSight(PhaseShift const& phaseShift, G3D::Vector3 const& pos, std::span<G3D::Vector3 const> targets, std::span<bool> results, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
         void Balance() { _dynamicTree.balance(); }
         void RemoveGameObjectModel(GameObjectModel const& model) { _dynamicTree.remove(model); }
         void InsertGameObjectModel(GameObjectModel const& model) { _dynamicTree.insert(model); }
         bool ContainsGameObjectModel(GameObjectModel const& model) const { return _dynamicTree.contains(model);}
+        // null when mmap.PathCache.Size is 0
+        std::shared_ptr<PathCache> const& GetPathCache() const { return _pathCache; }
         float GetGameObjectFloor(PhaseShift const& phaseShift, float x, float y, float z, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const
         {
             return _dynamicTree.getHeight(x, y, z, maxSearchDist, phaseShift);
@@ -532,11 +621,13 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         void AddUpdateObject(Object* obj)
         {
+            std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
             _updateObjects.insert(obj);
         }
 
         void RemoveUpdateObject(Object* obj)
         {
+            std::unique_lock<std::recursive_mutex> lock = AcquireRegionUpdateLock();
             _updateObjects.erase(obj);
         }
 
@@ -571,6 +662,23 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         void AddAreaTriggerToMoveList(AreaTrigger* at, float x, float y, float z, float ang);
         void RemoveAreaTriggerFromMoveList(AreaTrigger* at);
 
+        void UpdateRegions(uint32 diff);
+        void UpdateAreaTriggerTargets();
+
+        // locks containers shared between regions, no-op when regions are not being updated in parallel
+        std::unique_lock<std::recursive_mutex> AcquireRegionUpdateLock()
+        {
+            if (!_regionUpdateInProgress)
+                return {};
+
+            return std::unique_lock<std::recursive_mutex>(_regionUpdateLock);
+        }
+
+        Trinity::ThreadPool* _regionUpdatePool;
+        std::vector<uint32> _regionUpdateCells;
+        bool _regionUpdateInProgress;
+        std::recursive_mutex _regionUpdateLock;
+
         bool _creatureToMoveLock;
         std::vector<Creature*> _creaturesToMove;
 
@@ -583,6 +691,9 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         bool _areaTriggersToMoveLock;
         std::vector<AreaTrigger*> _areaTriggersToMove;
 
+        std::vector<ObjectGuid> _areaTriggersToUpdateTargets;
+        std::unordered_map<uint32 /*cellId*/, AreaTriggerSearchCell> _areaTriggerSearchCells;
+
         bool IsGridLoaded(GridCoord const&) const;
         void EnsureGridCreated(GridCoord const&);
         bool EnsureGridLoaded(Cell const&);
@@ -612,8 +723,23 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         uint32 i_InstanceId;
         Trinity::unique_weak_ptr<Map> m_weakRef;
         uint32 m_unloadTimer;
+        uint32 m_lastUpdateDuration;
+        MapUpdateProfiler _updateProfiler;
+        std::unique_ptr<MapReplay> _replayRecording;
+        std::mutex _replayRecordingLock;
         float m_VisibleDistance;
         DynamicMapTree _dynamicTree;
+        mutable LineOfSightCache _lineOfSightCache;
+        TerrainStatusCache _terrainStatusCache;
+
+        void UpdatePlayerNearCells();
+        std::vector<bool> _playerNearCells;         // empty while dormant creature updates are disabled
+        std::vector<uint32> _playerNearCellIds;     // set bits of _playerNearCells, cleared before the next update
+        std::atomic<uint32> _activeCreatureUpdates;
+        std::atomic<uint32> _dormantCreatureUpdates;
+        std::atomic<uint32> _computedRepaths;
+        std::atomic<uint32> _skippedRepaths;
+        std::shared_ptr<PathCache> _pathCache;      // shared with path queries still running on pathfinding threads
 
         MapRefManager m_mapRefManager;
         MapRefManager::iterator m_mapRefIter;
@@ -643,11 +769,13 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         time_t i_gridExpiry;
 
         std::shared_ptr<TerrainInfo> m_terrain;
+        std::unordered_map<uint32 /*gridId*/, time_t /*requestTime*/> _gridPrepareRequests;
         uint16 m_forceEnabledNavMeshFilterFlags;
         uint16 m_forceDisabledNavMeshFilterFlags;
 
         NGridType* i_grids[MAX_NUMBER_OF_GRIDS][MAX_NUMBER_OF_GRIDS];
         std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> marked_cells;
+        std::bitset<TOTAL_NUMBER_OF_CELLS_PER_MAP*TOTAL_NUMBER_OF_CELLS_PER_MAP> _relocationNotifyCells;
 
         //these functions used to process player/mob aggro reactions and
         //visibility calculations. Highly optimized for massive calculations
@@ -718,6 +846,12 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         typedef std::function<void(Map*)> FarSpellCallback;
         void AddFarSpellCallback(FarSpellCallback&& callback);
+        // thread safe, the effect is handled on this map during its next DelayedUpdate
+        void AddFarSpellEffect(Spell* spell, SpellEffectInfo const& spellEffectInfo, ObjectGuid const& targetGuid);
+        // thread safe, the changes are applied in order during the following updates of this map, a bounded batch per update
+        void AddGameEventChanges(std::vector<GameEventMapChange> changes);
+
+        uint64 GetHandledMessageCount(MapMessageType type) const { return _handledMessages[std::size_t(type)]; }
 
         void InitSpawnGroupState();
         void UpdateSpawnGroupConditions();
@@ -791,6 +925,7 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         ZoneDynamicInfoMap _zoneDynamicInfo;
         IntervalTimer _weatherUpdateTimer;
+        IntervalTimer _mmapTileTouchTimer;
 
         ObjectGuidGenerator& GetGuidSequenceGenerator(HighGuid high);
 
@@ -806,7 +941,17 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
 
         std::unordered_set<Object*> _updateObjects;
 
-        MPSCQueue<FarSpellCallback> _farSpellCallbacks;
+        void SendMessage(MapMessage* message);
+        void ProcessMessages();
+
+        MapMessagePool _messagePool;
+        MPSCQueue<MapMessage, &MapMessage::QueueLink> _messages;
+        std::vector<MapMessage*> _handledMessageBatch;
+        std::array<uint64, MAX_MAP_MESSAGE_TYPES> _handledMessages = { };
+
+        void ProcessGameEventChanges();
+
+        std::deque<GameEventMapChange> _gameEventChanges;
 
         /*********************************************************/
         /***                   Phasing                         ***/
@@ -825,10 +970,24 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         int32 GetWorldStateValue(int32 worldStateId) const;
         void SetWorldStateValue(int32 worldStateId, int32 value, bool hidden);
         WorldStateValueContainer const& GetWorldStateValues() const { return _worldStateValues; }
+        std::vector<int32> const& GetWorldStateIdsForArea(uint32 areaId) const;
+        std::shared_ptr<WorldPacket const> GetInitWorldStatesPacket(uint32 zoneId, uint32 areaId);
 
     private:
+        void SendWorldStateUpdates();
+
         WorldStateValueContainer _worldStateValues;
 
+        // value changes are sent once per tick, only the last value and hidden flag set for each world state are broadcast
+        std::unordered_map<int32, bool /*hidden*/> _pendingWorldStateUpdates;
+
+        // world states of this map visible in an area, rebuilt when a world state is added to the map
+        mutable std::unordered_map<uint32 /*areaId*/, std::vector<int32>> _worldStateIdsByArea;
+
+        // SMSG_INIT_WORLD_STATES for each zone and area pair, dropped when any map or realm wide value changes
+        std::unordered_map<uint64 /*zoneId | areaId*/, std::shared_ptr<WorldPacket const>> _initWorldStatesPackets;
+        uint32 _initWorldStatesRealmVersion;
+
         /*********************************************************/
         /***                   Vignettes                       ***/
         /*********************************************************/
@@ -838,6 +997,8 @@ class TC_GAME_API Map : public GridRefManager<NGridType>
         std::vector<Vignettes::VignetteData*> const& GetInfiniteAOIVignettes() const { return _infiniteAOIVignettes; }
 
     private:
+        void SendInfiniteAOIVignetteUpdates();
+
         std::vector<Vignettes::VignetteData*> _infiniteAOIVignettes;
         PeriodicTimer _vignetteUpdateTimer;
 };
@@ -864,6 +1025,8 @@ class TC_GAME_API InstanceMap : public Map
         bool AddPlayerToMap(Player* player, bool initPlayer = true) override;
         void RemovePlayerFromMap(Player*, bool) override;
         void Update(uint32) override;
+        // assigns team and lock to an instance constructed without them ahead of time
+        void Bind(TeamId instanceTeam, InstanceLock* instanceLock);
         void CreateInstanceData();
         InstanceResetResult Reset(InstanceResetMethod method);
         uint32 GetScriptId() const { return i_script_id; }
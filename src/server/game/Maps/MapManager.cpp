@@ -19,18 +19,26 @@
 #include "BattlefieldMgr.h"
 #include "Battleground.h"
 #include "CharacterCache.h"
+#include "Config.h"
 #include "Containers.h"
 #include "DatabaseEnv.h"
 #include "DB2Stores.h"
+#include "GameTime.h"
 #include "GarrisonMap.h"
 #include "Group.h"
 #include "InstanceLockMgr.h"
 #include "Log.h"
 #include "Map.h"
+#include "Metric.h"
+#include "MMapFactory.h"
+#include "ObjectMgr.h"
 #include "OutdoorPvPMgr.h"
 #include "Player.h"
 #include "ScenarioMgr.h"
 #include "ScriptMgr.h"
+#include "StringConvert.h"
+#include "ThreadPool.h"
+#include "Util.h"
 #include "World.h"
 #include "WorldStateMgr.h"
 #include <boost/dynamic_bitset.hpp>
@@ -53,6 +61,42 @@ void MapManager::Initialize()
     // Start mtmaps if needed.
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (uint32 regionThreads = sWorld->getIntConfig(CONFIG_MAP_UPDATE_REGION_THREADS))
+    {
+        std::string regionMaps = sConfigMgr->GetStringDefault("MapUpdate.Regions.Maps", "");
+        for (std::string_view mapId : Trinity::Tokenize(regionMaps, ' ', false))
+            if (Optional<uint32> id = Trinity::StringTo<uint32>(mapId))
+                _regionUpdateMapIds.insert(*id);
+
+        if (!_regionUpdateMapIds.empty())
+            _regionUpdatePool = std::make_unique<Trinity::ThreadPool>(regionThreads);
+    }
+
+    if (uint32 gridPrepareThreads = sWorld->getIntConfig(CONFIG_GRID_PREPARE_THREADS))
+        _gridPreparePool = std::make_unique<Trinity::ThreadPool>(gridPrepareThreads);
+
+    if (uint32 pathfindingThreads = sWorld->getIntConfig(CONFIG_PATHFINDING_THREADS))
+        _pathfindingPool = std::make_unique<Trinity::ThreadPool>(pathfindingThreads);
+
+    if (sWorld->getIntConfig(CONFIG_INSTANCE_POOL_SIZE))
+    {
+        std::string pooledMaps = sConfigMgr->GetStringDefault("InstanceMap.Pool.Maps", "");
+        for (std::string_view pooledMap : Trinity::Tokenize(pooledMaps, ' ', false))
+        {
+            std::vector<std::string_view> tokens = Trinity::Tokenize(pooledMap, ':', false);
+            Optional<uint32> mapId = tokens.size() == 2 ? Trinity::StringTo<uint32>(tokens[0]) : std::nullopt;
+            Optional<uint32> difficulty = tokens.size() == 2 ? Trinity::StringTo<uint32>(tokens[1]) : std::nullopt;
+            MapEntry const* entry = mapId ? sMapStore.LookupEntry(*mapId) : nullptr;
+            if (!entry || !entry->IsDungeon() || !difficulty || !sDB2Manager.GetMapDifficultyData(*mapId, Difficulty(*difficulty)))
+            {
+                TC_LOG_ERROR("server.loading", "InstanceMap.Pool.Maps contains invalid map and difficulty pair '{}', skipped", pooledMap);
+                continue;
+            }
+
+            _instancePool[{ *mapId, Difficulty(*difficulty) }];
+        }
+    }
 }
 
 void MapManager::InitializeVisibilityDistanceInfo()
@@ -80,6 +124,9 @@ Map* MapManager::CreateWorldMap(uint32 mapId, uint32 instanceId)
     map->LoadCorpseData();
     map->InitSpawnGroupState();
 
+    if (_regionUpdatePool && _regionUpdateMapIds.contains(mapId))
+        map->SetRegionUpdatePool(_regionUpdatePool.get());
+
     if (sWorld->getBoolConfig(CONFIG_BASEMAP_LOAD_GRIDS))
         map->LoadAllCells();
 
@@ -102,7 +149,15 @@ InstanceMap* MapManager::CreateInstance(uint32 mapId, uint32 instanceId, Instanc
     TC_LOG_DEBUG("maps", "MapInstanced::CreateInstance: {}map instance {} for {} created with difficulty {}",
         instanceLock && instanceLock->IsNew() ? "" : "new ", instanceId, mapId, sDifficultyStore.AssertEntry(difficulty)->Name[sWorld->GetDefaultDbcLocale()]);
 
-    InstanceMap* map = new InstanceMap(mapId, i_gridCleanUpDelay, instanceId, difficulty, team, instanceLock);
+    InstanceMap* map = nullptr;
+    if (std::unique_ptr<InstanceMap> pooledMap = TakePooledInstance(mapId, difficulty, instanceId))
+    {
+        map = pooledMap.release();
+        map->Bind(team, instanceLock);
+    }
+    else
+        map = new InstanceMap(mapId, i_gridCleanUpDelay, instanceId, difficulty, team, instanceLock);
+
     ASSERT(map->IsDungeon());
 
     map->LoadRespawnTimes();
@@ -120,6 +175,50 @@ InstanceMap* MapManager::CreateInstance(uint32 mapId, uint32 instanceId, Instanc
     return map;
 }
 
+uint32 MapManager::GetPooledInstanceId(uint32 mapId, Difficulty difficulty) const
+{
+    auto itr = _instancePool.find({ mapId, difficulty });
+    if (itr == _instancePool.end() || itr->second.empty())
+        return 0;
+
+    return itr->second.back()->GetInstanceId();
+}
+
+std::unique_ptr<InstanceMap> MapManager::TakePooledInstance(uint32 mapId, Difficulty difficulty, uint32 instanceId)
+{
+    auto itr = _instancePool.find({ mapId, difficulty });
+    if (itr == _instancePool.end() || itr->second.empty() || itr->second.back()->GetInstanceId() != instanceId)
+        return nullptr;
+
+    std::unique_ptr<InstanceMap> map = std::move(itr->second.back());
+    itr->second.pop_back();
+    return map;
+}
+
+void MapManager::RefillInstancePool()
+{
+    uint32 poolSize = sWorld->getIntConfig(CONFIG_INSTANCE_POOL_SIZE);
+
+    std::unique_lock<std::shared_mutex> lock(_mapsLock);
+
+    // build at most one instance per update to keep the world thread responsive
+    for (auto& [key, pooledMaps] : _instancePool)
+    {
+        if (pooledMaps.size() >= poolSize)
+            continue;
+
+        std::unique_ptr<InstanceMap> map = std::make_unique<InstanceMap>(key.first, i_gridCleanUpDelay, GenerateInstanceId(), key.second, TEAM_NEUTRAL, nullptr);
+
+        // keep terrain of the entrance resident so the first players do not wait for it
+        if (AreaTriggerStruct const* entrance = sObjectMgr->GetMapEntranceTrigger(key.first))
+            map->CreateGridForPosition(entrance->target_X, entrance->target_Y);
+
+        TC_LOG_DEBUG("maps", "MapManager::RefillInstancePool: prepared instance {} for map {} difficulty {}", map->GetInstanceId(), key.first, uint32(key.second));
+        pooledMaps.push_back(std::move(map));
+        break;
+    }
+}
+
 BattlegroundMap* MapManager::CreateBattleground(uint32 mapId, uint32 instanceId, Battleground* bg)
 {
     TC_LOG_DEBUG("maps", "MapInstanced::CreateBattleground: map bg {} for {} created.", instanceId, mapId);
@@ -205,7 +304,10 @@ Map* MapManager::CreateMap(uint32 mapId, Player* player)
             if (!entries.MapDifficulty->HasResetSchedule())
                 newInstanceId = group ? group->GetRecentInstanceId(mapId) : player->GetRecentInstanceId(mapId);
 
-            // If not found or instance is not a normal dungeon, generate new one
+            // If not found or instance is not a normal dungeon, use a prepared one or generate new one
+            if (!newInstanceId)
+                newInstanceId = GetPooledInstanceId(mapId, difficulty);
+
             if (!newInstanceId)
                 newInstanceId = GenerateInstanceId();
 
@@ -251,22 +353,43 @@ Map* MapManager::CreateMap(uint32 mapId, Player* player)
     }
 
     if (map)
-    {
-        Trinity::unique_trackable_ptr<Map>& ptr = i_maps[{ map->GetId(), map->GetInstanceId() }];
-        if (ptr.get() != map)
-        {
-            ptr.reset(map);
-            map->SetWeakPtr(ptr);
+        AddMap_i(map);
 
-            sScriptMgr->OnCreateMap(map);
-            sOutdoorPvPMgr->CreateOutdoorPvPForMap(map);
-            sBattlefieldMgr->CreateBattlefieldsForMap(map);
-        }
+    return map;
+}
+
+Map* MapManager::CreateMapWithoutPlayer(uint32 mapId)
+{
+    MapEntry const* entry = sMapStore.LookupEntry(mapId);
+    if (!entry || entry->Instanceable() || entry->IsGarrison() || entry->IsSplitByFaction())
+        return nullptr;
+
+    std::unique_lock<std::shared_mutex> lock(_mapsLock);
+
+    Map* map = FindMap_i(mapId, 0);
+    if (!map)
+    {
+        map = CreateWorldMap(mapId, 0);
+        AddMap_i(map);
     }
 
     return map;
 }
 
+void MapManager::AddMap_i(Map* map)
+{
+    Trinity::unique_trackable_ptr<Map>& ptr = i_maps[{ map->GetId(), map->GetInstanceId() }];
+    if (ptr.get() != map)
+    {
+        ptr.reset(map);
+        map->SetWeakPtr(ptr);
+
+        sScriptMgr->OnCreateMap(map);
+        sOutdoorPvPMgr->CreateOutdoorPvPForMap(map);
+        sBattlefieldMgr->CreateBattlefieldsForMap(map);
+    }
+}
+
 Map* MapManager::FindMap(uint32 mapId, uint32 instanceId) const
 {
     std::shared_lock<std::shared_mutex> lock(_mapsLock);
@@ -348,9 +471,58 @@ void MapManager::Update(uint32 diff)
     for (iter = i_maps.begin(); iter != i_maps.end(); ++iter)
         iter->second->DelayedUpdate(uint32(i_timer.GetCurrent()));
 
+    if (uint32 budget = sWorld->getIntConfig(CONFIG_GRID_MEMORY_BUDGET_TOTAL); budget && Map::IsGridMemoryBudgetEnabled())
+        UnloadGridsOverMemoryBudget(std::size_t(budget) * 1024 * 1024);
+
+    // map update threads are idle here, paths calculated by worker threads wait for the eviction to finish
+    if (uint32 budget = sWorld->getIntConfig(CONFIG_MMAP_TILE_MEMORY_BUDGET))
+        if (std::size_t released = MMAP::MMapFactory::createOrGetMMapManager()->evictTilesOverBudget(std::size_t(budget) * 1024 * 1024, 60 * IN_MILLISECONDS))
+            TC_METRIC_VALUE("mmap_evicted_bytes", uint64(released));
+
+    if (sMetric->IsEnabled())
+    {
+        for (MMAP::MMapTileStatistics const& statistics : MMAP::MMapFactory::createOrGetMMapManager()->getTileStatistics())
+        {
+            TC_METRIC_VALUE("mmap_tiles", uint64(statistics.Tiles), TC_METRIC_TAG("map_id", std::to_string(statistics.MapId)));
+            TC_METRIC_VALUE("mmap_tile_bytes", uint64(statistics.TileDataSize), TC_METRIC_TAG("map_id", std::to_string(statistics.MapId)));
+            TC_METRIC_VALUE("mmap_evicted_tiles", uint64(statistics.EvictedTiles), TC_METRIC_TAG("map_id", std::to_string(statistics.MapId)));
+        }
+    }
+
+    if (!_instancePool.empty())
+        RefillInstancePool();
+
     i_timer.SetCurrent(0);
 }
 
+void MapManager::UnloadGridsOverMemoryBudget(std::size_t budget)
+{
+    std::size_t usage = 0;
+    for (MapMapType::value_type const& map : i_maps)
+        usage += map.second->GetGridsMemoryUsage();
+
+    uint32 now = GameTime::GetGameTimeMS();
+    while (usage > budget)
+    {
+        Map* lruMap = nullptr;
+        NGridType* lruGrid = nullptr;
+        for (MapMapType::value_type const& map : i_maps)
+        {
+            NGridType* grid = map.second->GetLeastRecentlyUsedIdleGrid(now);
+            if (grid && (!lruGrid || grid->getGridInfoRef()->getLastActiveTime() < lruGrid->getGridInfoRef()->getLastActiveTime()))
+            {
+                lruMap = map.second.get();
+                lruGrid = grid;
+            }
+        }
+
+        if (!lruGrid)
+            break;
+
+        usage -= std::min(usage, lruMap->UnloadGridForMemoryBudget(*lruGrid));
+    }
+}
+
 bool MapManager::DestroyMap(Map* map)
 {
     map->RemoveAllPlayers();
@@ -391,9 +563,26 @@ void MapManager::UnloadAll()
     // then delete them
     i_maps.clear();
 
+    for (auto& [key, pooledMaps] : _instancePool)
+    {
+        for (std::unique_ptr<InstanceMap> const& map : pooledMaps)
+            map->UnloadAll();
+
+        pooledMaps.clear();
+    }
+
     if (m_updater.activated())
         m_updater.deactivate();
 
+    if (_regionUpdatePool)
+        _regionUpdatePool->Join();
+
+    if (_gridPreparePool)
+        _gridPreparePool->Join();
+
+    if (_pathfindingPool)
+        _pathfindingPool->Join();
+
     Map::DeleteStateMachine();
 }
 
@@ -409,6 +598,24 @@ uint32 MapManager::GetNumPlayersInInstances() const
     return std::accumulate(i_maps.begin(), i_maps.end(), 0u, [](uint32 total, MapMapType::value_type const& value) { return total + (value.second->IsDungeon() ? value.second->GetPlayers().getSize() : 0); });
 }
 
+void MapManager::DoForAllMapsInParallel(std::function<void(Map*)> const& worker)
+{
+    std::shared_lock<std::shared_mutex> lock(_mapsLock);
+
+    if (!m_updater.activated())
+    {
+        for (auto const& [key, map] : i_maps)
+            worker(map.get());
+
+        return;
+    }
+
+    for (auto const& [key, map] : i_maps)
+        m_updater.schedule_task(*map, [&worker](Map& target) { worker(&target); }, map->GetPlayers().getSize());
+
+    m_updater.wait();
+}
+
 void MapManager::InitInstanceIds()
 {
     _nextInstanceId = 1;
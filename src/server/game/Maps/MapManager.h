@@ -25,8 +25,11 @@
 #include "SharedDefines.h"
 #include "UniqueTrackablePtr.h"
 #include <boost/dynamic_bitset_fwd.hpp>
+#include <functional>
 #include <map>
 #include <shared_mutex>
+#include <unordered_set>
+#include <vector>
 
 class Battleground;
 class BattlegroundMap;
@@ -38,6 +41,11 @@ class Map;
 class Player;
 enum Difficulty : uint8;
 
+namespace Trinity
+{
+class ThreadPool;
+}
+
 class TC_GAME_API MapManager
 {
         MapManager();
@@ -52,6 +60,8 @@ class TC_GAME_API MapManager
         static MapManager* instance();
 
         Map* CreateMap(uint32 mapId, Player* player);
+        // creates (or finds) a continent map without a player entering it, used by tools like map_bench; returns nullptr for instanceable and faction split maps
+        Map* CreateMapWithoutPlayer(uint32 mapId);
         Map* FindMap(uint32 mapId, uint32 instanceId) const;
         uint32 FindInstanceIdForPlayer(uint32 mapId, Player const* player) const;
 
@@ -117,10 +127,16 @@ class TC_GAME_API MapManager
         void FreeInstanceId(uint32 instanceId);
 
         MapUpdater * GetMapUpdater() { return &m_updater; }
+        Trinity::ThreadPool* GetGridPreparePool() { return _gridPreparePool.get(); }
+        Trinity::ThreadPool* GetPathfindingPool() { return _pathfindingPool.get(); }
 
         template<typename Worker>
         void DoForAllMaps(Worker&& worker);
 
+        // calls worker for every map on the map update threads and waits for all of them
+        // must not be called during a map update, maps with more players are started first
+        void DoForAllMapsInParallel(std::function<void(Map*)> const& worker);
+
         template<typename Worker>
         void DoForAllMapsWithMapId(uint32 mapId, Worker&& worker);
 
@@ -139,11 +155,18 @@ class TC_GAME_API MapManager
         Map* FindMap_i(uint32 mapId, uint32 instanceId) const;
 
         Map* CreateWorldMap(uint32 mapId, uint32 instanceId);
+        void AddMap_i(Map* map);
         InstanceMap* CreateInstance(uint32 mapId, uint32 instanceId, InstanceLock* instanceLock, Difficulty difficulty, TeamId team, Group* group);
         BattlegroundMap* CreateBattleground(uint32 mapId, uint32 instanceId, Battleground* bg);
         GarrisonMap* CreateGarrison(uint32 mapId, uint32 instanceId, Player* owner);
 
+        uint32 GetPooledInstanceId(uint32 mapId, Difficulty difficulty) const;
+        std::unique_ptr<InstanceMap> TakePooledInstance(uint32 mapId, Difficulty difficulty, uint32 instanceId);
+        void RefillInstancePool();
+
         bool DestroyMap(Map* map);
+        // unloads the least recently used idle grids of all maps until their estimated footprint fits the budget
+        void UnloadGridsOverMemoryBudget(std::size_t budget);
 
         mutable std::shared_mutex _mapsLock;
         uint32 i_gridCleanUpDelay;
@@ -154,6 +177,20 @@ class TC_GAME_API MapManager
         uint32 _nextInstanceId;
         MapUpdater m_updater;
 
+        // maps updated by independent grid regions in parallel
+        std::unique_ptr<Trinity::ThreadPool> _regionUpdatePool;
+        std::unordered_set<uint32> _regionUpdateMapIds;
+
+        // background loading of grid terrain
+        std::unique_ptr<Trinity::ThreadPool> _gridPreparePool;
+
+        // detour queries of paths requested with PathGenerator::CalculatePathAsync
+        std::unique_ptr<Trinity::ThreadPool> _pathfindingPool;
+
+        // instances constructed ahead of time, taken by CreateInstance for new instances of pooled maps
+        using InstancePoolKey = std::pair<uint32, Difficulty>;
+        std::map<InstancePoolKey, std::vector<std::unique_ptr<InstanceMap>>> _instancePool;
+
         // atomic op counter for active scripts amount
         std::atomic<std::size_t> _scheduledScripts;
 };
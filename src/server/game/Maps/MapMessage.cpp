@@ -0,0 +1,67 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapMessage.h"
+
+char const* GetMapMessageTypeName(MapMessageType type)
+{
+    switch (type)
+    {
+        case MapMessageType::FarSpellEffect: return "FarSpellEffect";
+        case MapMessageType::Callback: return "Callback";
+        default:
+            break;
+    }
+    return "Unknown";
+}
+
+MapMessagePool::~MapMessagePool()
+{
+    for (MapMessage* message : _free)
+        delete message;
+}
+
+MapMessage* MapMessagePool::Acquire()
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        if (!_free.empty())
+        {
+            MapMessage* message = _free.back();
+            _free.pop_back();
+            return message;
+        }
+    }
+
+    return new MapMessage();
+}
+
+void MapMessagePool::Release(std::vector<MapMessage*>& messages)
+{
+    for (MapMessage* message : messages)
+        message->Reset();
+
+    std::lock_guard<std::mutex> lock(_lock);
+    _free.insert(_free.end(), messages.begin(), messages.end());
+    messages.clear();
+}
+
+std::size_t MapMessagePool::GetFreeCount() const
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return _free.size();
+}
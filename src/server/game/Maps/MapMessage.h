@@ -0,0 +1,90 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAP_MESSAGE_H
+#define TRINITY_MAP_MESSAGE_H
+
+#include "Define.h"
+#include "ObjectGuid.h"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+class Map;
+class Spell;
+class SpellEffectInfo;
+
+enum class MapMessageType : uint8
+{
+    FarSpellEffect,     // spell effect hitting a player on another map
+    Callback,           // generic std::function, for rare senders
+
+    Max
+};
+
+constexpr std::size_t MAX_MAP_MESSAGE_TYPES = std::size_t(MapMessageType::Max);
+
+TC_GAME_API char const* GetMapMessageTypeName(MapMessageType type);
+
+// Message sent to a map from any thread, handled by the map at the start of its DelayedUpdate
+// Messages are pooled by the receiving map and linked intrusively into its queue, sending does not allocate once the pool is warm
+struct MapMessage
+{
+    MapMessageType Type = MapMessageType::Callback;
+
+    // FarSpellEffect
+    Spell* SpellOrigin = nullptr;
+    SpellEffectInfo const* EffectInfo = nullptr;
+    ObjectGuid Target;
+
+    // Callback
+    std::function<void(Map*)> Callback;
+
+    std::atomic<MapMessage*> QueueLink;
+
+    void Reset()
+    {
+        SpellOrigin = nullptr;
+        EffectInfo = nullptr;
+        Target.Clear();
+        Callback = nullptr;
+    }
+};
+
+class TC_GAME_API MapMessagePool
+{
+public:
+    MapMessagePool() = default;
+    ~MapMessagePool();
+
+    MapMessagePool(MapMessagePool const&) = delete;
+    MapMessagePool& operator=(MapMessagePool const&) = delete;
+
+    MapMessage* Acquire();
+
+    // returns a whole batch of handled messages with a single lock
+    void Release(std::vector<MapMessage*>& messages);
+
+    std::size_t GetFreeCount() const;
+
+private:
+    mutable std::mutex _lock;
+    std::vector<MapMessage*> _free;
+};
+
+#endif // TRINITY_MAP_MESSAGE_H
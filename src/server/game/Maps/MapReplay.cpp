@@ -0,0 +1,198 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapReplay.h"
+#include "Log.h"
+#include "Map.h"
+#include "MapManager.h"
+#include "Player.h"
+#include "Random.h"
+#include "StringFormat.h"
+#include "TemporarySummon.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+bool MapReplay::LoadFromFile(std::string const& fileName, MapReplay& replay, std::string& error)
+{
+    std::ifstream file(fileName);
+    if (!file)
+    {
+        error = Trinity::StringFormat("cannot open {}", fileName);
+        return false;
+    }
+
+    std::string line;
+    uint32 version = 0;
+    std::string magic;
+    if (!std::getline(file, line) || !(std::istringstream(line) >> magic >> version >> replay._mapId >> replay._seed) || magic != "mapreplay" || version != 1)
+    {
+        error = Trinity::StringFormat("{} is not a version 1 map replay", fileName);
+        return false;
+    }
+
+    replay._ticks.clear();
+    uint32 lineNumber = 1;
+    while (std::getline(file, line))
+    {
+        ++lineNumber;
+        if (line.empty())
+            continue;
+
+        std::istringstream tokens(line);
+        std::string type;
+        tokens >> type;
+        if (type == "t")
+        {
+            Tick& tick = replay._ticks.emplace_back();
+            if (!(tokens >> tick.Diff))
+            {
+                error = Trinity::StringFormat("{}:{}: malformed tick", fileName, lineNumber);
+                return false;
+            }
+        }
+        else if (type == "p" && !replay._ticks.empty())
+        {
+            TrackPosition position;
+            float x, y, z, o;
+            if (!(tokens >> position.Track >> x >> y >> z >> o))
+            {
+                error = Trinity::StringFormat("{}:{}: malformed position", fileName, lineNumber);
+                return false;
+            }
+
+            position.Pos.Relocate(x, y, z, o);
+            replay._ticks.back().Positions.push_back(position);
+        }
+        else
+        {
+            error = Trinity::StringFormat("{}:{}: unexpected '{}'", fileName, lineNumber, type);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool MapReplay::SaveToFile(std::string const& fileName) const
+{
+    std::ofstream file(fileName, std::ios::trunc);
+    if (!file)
+        return false;
+
+    file << "mapreplay 1 " << _mapId << ' ' << _seed << '\n';
+    for (Tick const& tick : _ticks)
+    {
+        file << "t " << tick.Diff << '\n';
+        for (TrackPosition const& position : tick.Positions)
+            file << Trinity::StringFormat("p {} {:.3f} {:.3f} {:.3f} {:.3f}\n", position.Track,
+                position.Pos.GetPositionX(), position.Pos.GetPositionY(), position.Pos.GetPositionZ(), position.Pos.GetOrientation());
+    }
+
+    return bool(file);
+}
+
+void MapReplay::RecordTick(Map const& map, uint32 diff)
+{
+    Tick& tick = _ticks.emplace_back();
+    tick.Diff = diff;
+    for (MapReference const& ref : map.GetPlayers())
+    {
+        Player const* player = ref.GetSource();
+        tick.Positions.push_back({ player->GetGUID().GetCounter(), player->GetPosition() });
+    }
+}
+
+bool MapReplayRunner::Run(uint32 ticks, AllocationCounter allocationCounter, MapReplayResult& result)
+{
+    result = MapReplayResult();
+
+    std::vector<MapReplay::Tick> const& recordedTicks = _replay.GetTicks();
+    if (recordedTicks.empty())
+        return false;
+
+    Map* map = sMapMgr->CreateMapWithoutPlayer(_replay.GetMapId());
+    if (!map)
+        return false;
+
+    SeedRandomEngine(_replay.GetSeed());
+
+    std::unordered_map<uint64, ObjectGuid> tracks;
+    std::vector<uint32> tickTimes;
+    tickTimes.reserve(ticks);
+
+    for (uint32 i = 0; i < ticks; ++i)
+    {
+        MapReplay::Tick const& tick = recordedTicks[i % recordedTicks.size()];
+        for (MapReplay::TrackPosition const& position : tick.Positions)
+        {
+            Creature* creature = nullptr;
+            auto itr = tracks.find(position.Track);
+            if (itr != tracks.end())
+                creature = map->GetCreature(itr->second);
+
+            if (!creature)
+            {
+                if (TempSummon* summon = map->SummonCreature(_trackCreatureEntry, position.Pos))
+                {
+                    // active objects keep their surroundings loaded and updated like players do
+                    summon->setActive(true);
+                    tracks[position.Track] = summon->GetGUID();
+                }
+                continue;
+            }
+
+            map->CreatureRelocation(creature, position.Pos.GetPositionX(), position.Pos.GetPositionY(), position.Pos.GetPositionZ(), position.Pos.GetOrientation());
+        }
+
+        uint64 allocationsBefore = allocationCounter ? allocationCounter() : 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        map->Update(tick.Diff);
+        map->DelayedUpdate(tick.Diff);
+
+        uint32 elapsed = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        if (allocationCounter)
+        {
+            uint64 allocations = allocationCounter() - allocationsBefore;
+            result.Allocations += allocations;
+            result.MaxTickAllocations = std::max(result.MaxTickAllocations, allocations);
+        }
+
+        tickTimes.push_back(elapsed);
+        result.Total += elapsed;
+    }
+
+    for (auto const& [track, guid] : tracks)
+        if (Creature* creature = map->GetCreature(guid))
+            creature->DespawnOrUnsummon();
+
+    result.Ticks = ticks;
+    if (!tickTimes.empty())
+    {
+        std::sort(tickTimes.begin(), tickTimes.end());
+        result.P50 = tickTimes[(tickTimes.size() - 1) * 50 / 100];
+        result.P99 = tickTimes[(tickTimes.size() - 1) * 99 / 100];
+        result.Max = tickTimes.back();
+    }
+
+    TC_LOG_INFO("maps", "MapReplay: map {} replayed {} ticks ({} tracks), p50 {} us, p99 {} us, max {} us",
+        _replay.GetMapId(), result.Ticks, tracks.size(), result.P50, result.P99, result.Max);
+    return true;
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAP_REPLAY_H
+#define TRINITY_MAP_REPLAY_H
+
+#include "Define.h"
+#include "Position.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+class Map;
+
+// Recorded movement of the players of a single map, tick by tick
+// Text format:
+//   mapreplay 1 <mapId> <seed>
+//   t <diff>                      starts a new tick
+//   p <track> <x> <y> <z> <o>     position of a track during the current tick
+class TC_GAME_API MapReplay
+{
+public:
+    struct TrackPosition
+    {
+        uint64 Track;
+        Position Pos;
+    };
+
+    struct Tick
+    {
+        uint32 Diff = 0;
+        std::vector<TrackPosition> Positions;
+    };
+
+    MapReplay(uint32 mapId, uint32 seed) : _mapId(mapId), _seed(seed) { }
+
+    static bool LoadFromFile(std::string const& fileName, MapReplay& replay, std::string& error);
+    bool SaveToFile(std::string const& fileName) const;
+
+    // records the position of every player on the map, called at the end of Map::Update
+    void RecordTick(Map const& map, uint32 diff);
+
+    uint32 GetMapId() const { return _mapId; }
+    uint32 GetSeed() const { return _seed; }
+    std::vector<Tick> const& GetTicks() const { return _ticks; }
+
+private:
+    uint32 _mapId;
+    uint32 _seed;
+    std::vector<Tick> _ticks;
+};
+
+struct MapReplayResult
+{
+    uint32 Ticks = 0;
+    // Map::Update + Map::DelayedUpdate wall clock time, microseconds
+    uint32 P50 = 0;
+    uint32 P99 = 0;
+    uint32 Max = 0;
+    uint64 Total = 0;
+    // heap allocations, only counted when the runner got a counter
+    uint64 Allocations = 0;
+    uint64 MaxTickAllocations = 0;
+};
+
+// Drives Map::Update headlessly with the recorded movement
+// Every track is represented by an active creature moved to the recorded positions before each tick
+class TC_GAME_API MapReplayRunner
+{
+public:
+    using AllocationCounter = std::function<uint64()>;
+
+    MapReplayRunner(MapReplay const& replay, uint32 trackCreatureEntry) : _replay(replay), _trackCreatureEntry(trackCreatureEntry) { }
+
+    // replays ticks ticks (wrapping around the recording when it is shorter), returns false if the map could not be created
+    bool Run(uint32 ticks, AllocationCounter allocationCounter, MapReplayResult& result);
+
+private:
+    MapReplay const& _replay;
+    uint32 _trackCreatureEntry;
+};
+
+#endif // TRINITY_MAP_REPLAY_H
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapUpdateProfiler.h"
+#include "Metric.h"
+#include <algorithm>
+#include <string>
+
+char const* GetMapUpdatePhaseName(MapUpdatePhase phase)
+{
+    switch (phase)
+    {
+        case MapUpdatePhase::Sessions:              return "Sessions";
+        case MapUpdatePhase::Respawns:              return "Respawns";
+        case MapUpdatePhase::Players:               return "Players";
+        case MapUpdatePhase::ActiveObjects:         return "ActiveObjects";
+        case MapUpdatePhase::Regions:               return "Regions";
+        case MapUpdatePhase::Transports:            return "Transports";
+        case MapUpdatePhase::AreaTriggerTargets:    return "AreaTriggerTargets";
+        case MapUpdatePhase::Vignettes:             return "Vignettes";
+        case MapUpdatePhase::SendObjectUpdates:     return "SendObjectUpdates";
+        case MapUpdatePhase::Scripts:               return "Scripts";
+        case MapUpdatePhase::Weather:               return "Weather";
+        case MapUpdatePhase::PhaseTracker:          return "PhaseTracker";
+        case MapUpdatePhase::MoveLists:             return "MoveLists";
+        case MapUpdatePhase::RelocationNotifies:    return "RelocationNotifies";
+        case MapUpdatePhase::ScriptHooks:           return "ScriptHooks";
+        default:
+            break;
+    }
+    return "Unknown";
+}
+
+void MapUpdateProfiler::TickTimes::Add(TickTimes const& other)
+{
+    for (std::size_t i = 0; i < PhaseCount; ++i)
+        Phases[i] += other.Phases[i];
+
+    Total += other.Total;
+}
+
+void MapUpdateProfiler::AddPhaseTime(MapUpdatePhase phase, std::chrono::steady_clock::duration duration)
+{
+    _current.Phases[std::size_t(phase)] += uint32(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+void MapUpdateProfiler::EndTick(std::chrono::steady_clock::duration duration, uint32 mapId, uint32 instanceId)
+{
+    _current.Total = uint32(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+
+    for (std::size_t i = 0; i < PhaseCount; ++i)
+        _phaseHistograms[i].Add(_current.Phases[i]);
+    _totalHistogram.Add(_current.Total);
+
+    _history[_historyIndex] = _current;
+    _historyIndex = (_historyIndex + 1) % HistorySize;
+    _historyCount = std::min(_historyCount + 1, HistorySize);
+    _current = TickTimes();
+
+    if (++_ticksSinceExport < HistorySize)
+        return;
+
+    TC_METRIC_HISTOGRAM("map_update_time", _totalHistogram,
+        TC_METRIC_TAG("map_id", std::to_string(mapId)),
+        TC_METRIC_TAG("map_instanceid", std::to_string(instanceId)));
+
+    for (std::size_t i = 0; i < PhaseCount; ++i)
+    {
+        TC_METRIC_HISTOGRAM("map_update_phase_time", _phaseHistograms[i],
+            TC_METRIC_TAG("map_id", std::to_string(mapId)),
+            TC_METRIC_TAG("map_instanceid", std::to_string(instanceId)),
+            TC_METRIC_TAG("phase", GetMapUpdatePhaseName(MapUpdatePhase(i))));
+        _phaseHistograms[i].Reset();
+    }
+
+    _totalHistogram.Reset();
+    _ticksSinceExport = 0;
+}
+
+MapUpdateProfiler::TickTimes MapUpdateProfiler::GetSummary(uint32 ticks, TickTimes* worst /*= nullptr*/) const
+{
+    TickTimes summary;
+    std::size_t count = std::min<std::size_t>(ticks, _historyCount);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        TickTimes const& tick = _history[(_historyIndex + HistorySize - 1 - i) % HistorySize];
+        summary.Add(tick);
+        if (worst && tick.Total > worst->Total)
+            *worst = tick;
+    }
+
+    return summary;
+}
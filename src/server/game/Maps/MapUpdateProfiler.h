@@ -0,0 +1,137 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_MAP_UPDATE_PROFILER_H
+#define TRINITY_MAP_UPDATE_PROFILER_H
+
+#include "AllocationTracker.h"
+#include "Define.h"
+#include "MetricHistogram.h"
+#include "TickTracer.h"
+#include <array>
+#include <chrono>
+
+enum class MapUpdatePhase : uint8
+{
+    Sessions,
+    Respawns,
+    Players,                // player updates and the cells visited around them
+    ActiveObjects,
+    Regions,
+    Transports,
+    AreaTriggerTargets,
+    Vignettes,
+    SendObjectUpdates,
+    Scripts,
+    Weather,
+    PhaseTracker,
+    MoveLists,
+    RelocationNotifies,
+    ScriptHooks,
+
+    Max
+};
+
+TC_GAME_API char const* GetMapUpdatePhaseName(MapUpdatePhase phase);
+
+// Collects the time spent in each phase of Map::Update for the last ticks of a single map
+// and periodically exports them as histograms through Metric
+class TC_GAME_API MapUpdateProfiler
+{
+public:
+    static constexpr std::size_t PhaseCount = std::size_t(MapUpdatePhase::Max);
+    static constexpr std::size_t HistorySize = 256;
+
+    // durations in microseconds
+    struct TickTimes
+    {
+        std::array<uint32, PhaseCount> Phases = { };
+        uint32 Total = 0;
+
+        void Add(TickTimes const& other);
+    };
+
+    class ScopedPhase
+    {
+    public:
+        ScopedPhase(MapUpdateProfiler& profiler, MapUpdatePhase phase) : _profiler(profiler), _phase(phase), _allocationTag(GetAllocationTag(phase)),
+            _start(std::chrono::steady_clock::now()) { }
+        ~ScopedPhase()
+        {
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            _profiler.AddPhaseTime(_phase, end - _start);
+            if (Trinity::TickTracer::IsRecording())
+                Trinity::TickTracer::Record(GetMapUpdatePhaseName(_phase), {}, {}, _start, end);
+        }
+
+        ScopedPhase(ScopedPhase const&) = delete;
+        ScopedPhase& operator=(ScopedPhase const&) = delete;
+
+    private:
+        static constexpr Trinity::AllocationTag GetAllocationTag(MapUpdatePhase phase)
+        {
+            switch (phase)
+            {
+                case MapUpdatePhase::Scripts:
+                case MapUpdatePhase::ScriptHooks:
+                    return Trinity::AllocationTag::Scripts;
+                default:
+                    return Trinity::AllocationTag::MapUpdate;
+            }
+        }
+
+        MapUpdateProfiler& _profiler;
+        MapUpdatePhase _phase;
+        Trinity::AllocationTagScope _allocationTag;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    class ScopedTick
+    {
+    public:
+        ScopedTick(MapUpdateProfiler& profiler, uint32 mapId, uint32 instanceId) : _profiler(profiler), _mapId(mapId), _instanceId(instanceId), _start(std::chrono::steady_clock::now()) { }
+        ~ScopedTick() { _profiler.EndTick(std::chrono::steady_clock::now() - _start, _mapId, _instanceId); }
+
+        ScopedTick(ScopedTick const&) = delete;
+        ScopedTick& operator=(ScopedTick const&) = delete;
+
+    private:
+        MapUpdateProfiler& _profiler;
+        uint32 _mapId;
+        uint32 _instanceId;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    void AddPhaseTime(MapUpdatePhase phase, std::chrono::steady_clock::duration duration);
+    void EndTick(std::chrono::steady_clock::duration duration, uint32 mapId, uint32 instanceId);
+
+    // sums the last ticks (limited to HistorySize), worst receives the slowest of them
+    TickTimes GetSummary(uint32 ticks, TickTimes* worst = nullptr) const;
+    uint32 GetRecordedTicks() const { return uint32(_historyCount); }
+
+private:
+    TickTimes _current;
+    std::array<TickTimes, HistorySize> _history;
+    std::size_t _historyIndex = 0;
+    std::size_t _historyCount = 0;
+
+    std::array<MetricHistogram, PhaseCount> _phaseHistograms;
+    MetricHistogram _totalHistogram;
+    uint32 _ticksSinceExport = 0;
+};
+
+#endif // TRINITY_MAP_UPDATE_PROFILER_H
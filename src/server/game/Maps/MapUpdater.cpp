@@ -19,8 +19,10 @@
 #include "DatabaseEnv.h"
 #include "Map.h"
 #include "Metric.h"
-
-#include <mutex>
+#include "StringFormat.h"
+#include "ThreadAffinity.h"
+#include <algorithm>
+#include <chrono>
 
 class MapUpdateRequest
 {
@@ -29,37 +31,72 @@ class MapUpdateRequest
         Map& m_map;
         MapUpdater& m_updater;
         uint32 m_diff;
+        uint32 m_expectedDuration;
+        std::function<void(Map&)> m_task;
 
     public:
 
         MapUpdateRequest(Map& m, MapUpdater& u, uint32 d)
-            : m_map(m), m_updater(u), m_diff(d)
+            : m_map(m), m_updater(u), m_diff(d), m_expectedDuration(m.GetLastUpdateDuration())
+        {
+        }
+
+        MapUpdateRequest(Map& m, MapUpdater& u, std::function<void(Map&)>&& task, uint32 expectedDuration)
+            : m_map(m), m_updater(u), m_diff(0), m_expectedDuration(expectedDuration), m_task(std::move(task))
         {
         }
 
+        uint32 GetExpectedDuration() const { return m_expectedDuration; }
+
         void call()
         {
+            if (m_task)
+            {
+                m_task(m_map);
+                m_updater.update_finished();
+                return;
+            }
+
             TC_METRIC_TIMER("map_update_time_diff", TC_METRIC_TAG("map_id", std::to_string(m_map.GetId())));
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
             m_map.Update (m_diff);
+            m_map.SetLastUpdateDuration(uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
             m_updater.update_finished();
         }
 };
 
+MapUpdater::MapUpdater() : _cancelationToken(false), _dispatchGeneration(0), _pendingRequests(0)
+{
+}
+
+MapUpdater::~MapUpdater()
+{
+    for (MapUpdateRequest* request : _scheduledRequests)
+        delete request;
+
+    for (std::unique_ptr<WorkerQueue>& queue : _workerQueues)
+        for (MapUpdateRequest* request : queue->Requests)
+            delete request;
+}
+
 void MapUpdater::activate(size_t num_threads)
 {
+    for (size_t i = 0; i < num_threads; ++i)
+        _workerQueues.push_back(std::make_unique<WorkerQueue>());
+
     for (size_t i = 0; i < num_threads; ++i)
     {
-        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this));
+        _workerThreads.push_back(std::thread(&MapUpdater::WorkerThread, this, i));
     }
 }
 
 void MapUpdater::deactivate()
 {
-    _cancelationToken = true;
-
     wait();
 
-    _queue.Cancel();
+    _cancelationToken = true;
+    ++_dispatchGeneration;
+    _dispatchGeneration.notify_all();
 
     for (auto& thread : _workerThreads)
     {
@@ -69,21 +106,24 @@ void MapUpdater::deactivate()
 
 void MapUpdater::wait()
 {
-    std::unique_lock<std::mutex> lock(_lock);
-
-    while (pending_requests > 0)
-        _condition.wait(lock);
+    dispatch();
 
-    lock.unlock();
+    size_t pending = _pendingRequests.load(std::memory_order_acquire);
+    while (pending > 0)
+    {
+        _pendingRequests.wait(pending, std::memory_order_acquire);
+        pending = _pendingRequests.load(std::memory_order_acquire);
+    }
 }
 
 void MapUpdater::schedule_update(Map& map, uint32 diff)
 {
-    std::lock_guard<std::mutex> lock(_lock);
-
-    ++pending_requests;
+    _scheduledRequests.push_back(new MapUpdateRequest(map, *this, diff));
+}
 
-    _queue.Push(new MapUpdateRequest(map, *this, diff));
+void MapUpdater::schedule_task(Map& map, std::function<void(Map&)> task, uint32 expectedDuration)
+{
+    _scheduledRequests.push_back(new MapUpdateRequest(map, *this, std::move(task), expectedDuration));
 }
 
 bool MapUpdater::activated()
@@ -91,33 +131,100 @@ bool MapUpdater::activated()
     return _workerThreads.size() > 0;
 }
 
+void MapUpdater::dispatch()
+{
+    if (_scheduledRequests.empty())
+        return;
+
+    // longest processing time first - every request goes to the currently least loaded worker
+    // which leaves each worker queue sorted from most to least expensive
+    std::stable_sort(_scheduledRequests.begin(), _scheduledRequests.end(), [](MapUpdateRequest const* left, MapUpdateRequest const* right)
+    {
+        return left->GetExpectedDuration() > right->GetExpectedDuration();
+    });
+
+    std::vector<uint64> workerLoad(_workerQueues.size(), 0);
+    std::vector<std::vector<MapUpdateRequest*>> assignments(_workerQueues.size());
+    for (MapUpdateRequest* request : _scheduledRequests)
+    {
+        size_t worker = std::distance(workerLoad.begin(), std::min_element(workerLoad.begin(), workerLoad.end()));
+        // maps without history still count as some work to spread them evenly
+        workerLoad[worker] += std::max<uint32>(request->GetExpectedDuration(), 1);
+        assignments[worker].push_back(request);
+    }
+
+    _pendingRequests.fetch_add(_scheduledRequests.size(), std::memory_order_acq_rel);
+    _scheduledRequests.clear();
+
+    for (size_t i = 0; i < _workerQueues.size(); ++i)
+    {
+        std::lock_guard<std::mutex> lock(_workerQueues[i]->Lock);
+        _workerQueues[i]->Requests.insert(_workerQueues[i]->Requests.end(), assignments[i].begin(), assignments[i].end());
+    }
+
+    _dispatchGeneration.fetch_add(1, std::memory_order_release);
+    _dispatchGeneration.notify_all();
+}
+
 void MapUpdater::update_finished()
 {
-    std::lock_guard<std::mutex> lock(_lock);
+    if (_pendingRequests.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        _pendingRequests.notify_all();
+}
 
-    --pending_requests;
+MapUpdateRequest* MapUpdater::pop_request(size_t workerIndex)
+{
+    {
+        WorkerQueue& own = *_workerQueues[workerIndex];
+        std::lock_guard<std::mutex> lock(own.Lock);
+        if (!own.Requests.empty())
+        {
+            MapUpdateRequest* request = own.Requests.front();
+            own.Requests.pop_front();
+            return request;
+        }
+    }
 
-    _condition.notify_all();
+    // steal from the back of other queues where the cheapest requests are
+    for (size_t i = 1; i < _workerQueues.size(); ++i)
+    {
+        WorkerQueue& victim = *_workerQueues[(workerIndex + i) % _workerQueues.size()];
+        std::lock_guard<std::mutex> lock(victim.Lock);
+        if (!victim.Requests.empty())
+        {
+            MapUpdateRequest* request = victim.Requests.back();
+            victim.Requests.pop_back();
+            return request;
+        }
+    }
+
+    return nullptr;
 }
 
-void MapUpdater::WorkerThread()
+void MapUpdater::WorkerThread(size_t workerIndex)
 {
+    Trinity::TickTracer::SetThreadName(Trinity::StringFormat("map updater {}", workerIndex));
+    Trinity::ThreadAffinity::ApplyToCurrentThread(Trinity::ThreadClass::MapUpdate);
+
     LoginDatabase.WarnAboutSyncQueries(true);
     CharacterDatabase.WarnAboutSyncQueries(true);
     WorldDatabase.WarnAboutSyncQueries(true);
     HotfixDatabase.WarnAboutSyncQueries(true);
 
+    uint32 generation = 0;
     while (1)
     {
-        MapUpdateRequest* request = nullptr;
-
-        _queue.WaitAndPop(request);
+        _dispatchGeneration.wait(generation, std::memory_order_acquire);
+        generation = _dispatchGeneration.load(std::memory_order_acquire);
 
         if (_cancelationToken)
             return;
 
-        request->call();
+        while (MapUpdateRequest* request = pop_request(workerIndex))
+        {
+            request->call();
 
-        delete request;
+            delete request;
+        }
     }
 }
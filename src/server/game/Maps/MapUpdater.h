@@ -19,25 +19,40 @@
 #define _MAP_UPDATER_H_INCLUDED
 
 #include "Define.h"
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <thread>
-#include <condition_variable>
-#include "ProducerConsumerQueue.h"
+#include <vector>
 
 class MapUpdateRequest;
 class Map;
 
+/*
+ * Updates maps in parallel using a work stealing pool.
+ *
+ * Requests scheduled during a tick are collected and only handed to workers in wait(),
+ * sorted by the duration of their previous update (longest first) and spread over per worker
+ * queues so that the most expensive maps start as early as possible. A worker that runs out of
+ * its own requests steals the cheapest remaining request from another worker.
+ */
 class TC_GAME_API MapUpdater
 {
     public:
 
-        MapUpdater() : _cancelationToken(false), pending_requests(0) {}
-        ~MapUpdater() { };
+        MapUpdater();
+        ~MapUpdater();
 
         friend class MapUpdateRequest;
 
         void schedule_update(Map& map, uint32 diff);
 
+        // runs task on a worker instead of updating the map, it may only touch objects of that map like a map update
+        // expectedDuration is only compared with other scheduled requests to order them
+        void schedule_task(Map& map, std::function<void(Map&)> task, uint32 expectedDuration);
+
         void wait();
 
         void activate(size_t num_threads);
@@ -48,18 +63,32 @@ class TC_GAME_API MapUpdater
 
     private:
 
-        ProducerConsumerQueue<MapUpdateRequest*> _queue;
+        struct WorkerQueue
+        {
+            std::mutex Lock;
+            std::deque<MapUpdateRequest*> Requests;
+        };
 
+        // only accessed by the thread scheduling updates
+        std::vector<MapUpdateRequest*> _scheduledRequests;
+
+        std::vector<std::unique_ptr<WorkerQueue>> _workerQueues;
         std::vector<std::thread> _workerThreads;
         std::atomic<bool> _cancelationToken;
 
-        std::mutex _lock;
-        std::condition_variable _condition;
-        size_t pending_requests;
+        // incremented every time a batch of requests is dispatched, workers sleep on it
+        std::atomic<uint32> _dispatchGeneration;
+
+        // completion latch for the current batch
+        std::atomic<size_t> _pendingRequests;
+
+        void dispatch();
 
         void update_finished();
 
-        void WorkerThread();
+        MapUpdateRequest* pop_request(size_t workerIndex);
+
+        void WorkerThread(size_t workerIndex);
 };
 
 #endif //_MAP_UPDATER_H_INCLUDED
@@ -26,6 +26,7 @@
 #include "PhasingHandler.h"
 #include "Random.h"
 #include "ScriptMgr.h"
+#include "TerrainStatusCache.h"
 #include "Util.h"
 #include "VMapFactory.h"
 #include "VMapManager2.h"
@@ -160,7 +161,15 @@ void TerrainInfo::LoadMapAndVMap(int32 gx, int32 gy)
         return;
 
     std::lock_guard<std::mutex> lock(_loadMutex);
-    LoadMapAndVMapImpl(gx, gy);
+    if (!_loadedGrids[GetBitsetIndex(gx, gy)])     // could have been prepared in advance
+        LoadMapAndVMapImpl(gx, gy);
+}
+
+void TerrainInfo::PrepareMapAndVMap(int32 gx, int32 gy)
+{
+    std::lock_guard<std::mutex> lock(_loadMutex);
+    if (!_loadedGrids[GetBitsetIndex(gx, gy)])
+        LoadMapAndVMapImpl(gx, gy);
 }
 
 void TerrainInfo::LoadMMapInstance(uint32 mapId, uint32 instanceId)
@@ -171,6 +180,67 @@ void TerrainInfo::LoadMMapInstance(uint32 mapId, uint32 instanceId)
         childTerrain->LoadMMapInstanceImpl(mapId, instanceId);
 }
 
+bool TerrainInfo::TouchMMaps(int32 gx, int32 gy)
+{
+    bool evicted = MMAP::MMapFactory::createOrGetMMapManager()->touchTile(GetId(), gx, gy);
+
+    for (std::shared_ptr<TerrainInfo> const& childTerrain : _childTerrain)
+        evicted = childTerrain->TouchMMaps(gx, gy) || evicted;
+
+    return evicted;
+}
+
+void TerrainInfo::ReloadEvictedMMaps(int32 gx, int32 gy)
+{
+    MMAP::MMapFactory::createOrGetMMapManager()->reloadEvictedTile(sWorld->GetDataPath(), GetId(), gx, gy);
+
+    for (std::shared_ptr<TerrainInfo> const& childTerrain : _childTerrain)
+        childTerrain->ReloadEvictedMMaps(gx, gy);
+}
+
+std::size_t TerrainInfo::GetGridMemoryUsage(int32 gx, int32 gy)
+{
+    std::lock_guard<std::mutex> lock(_loadMutex);
+    return GetGridMemoryUsageImpl(gx, gy);
+}
+
+std::size_t TerrainInfo::GetGridMemoryUsageImpl(int32 gx, int32 gy) const
+{
+    if (!_loadedGrids[GetBitsetIndex(gx, gy)])
+        return 0;
+
+    std::size_t size = 0;
+    if (_gridMap[gx][gy])
+        size += _gridMap[gx][gy]->GetMemoryUsage();
+
+    size += MMAP::MMapFactory::createOrGetMMapManager()->getTileDataSize(GetId(), gx, gy);
+
+    for (std::shared_ptr<TerrainInfo> const& childTerrain : _childTerrain)
+        size += childTerrain->GetGridMemoryUsageImpl(gx, gy);
+
+    return size;
+}
+
+std::size_t TerrainInfo::GetMemoryUsage()
+{
+    std::lock_guard<std::mutex> lock(_loadMutex);
+    return GetMemoryUsageImpl();
+}
+
+std::size_t TerrainInfo::GetMemoryUsageImpl() const
+{
+    std::size_t size = 0;
+    for (int32 gx = 0; gx < MAX_NUMBER_OF_GRIDS; ++gx)
+        for (int32 gy = 0; gy < MAX_NUMBER_OF_GRIDS; ++gy)
+            if (_gridMap[gx][gy])
+                size += _gridMap[gx][gy]->GetMemoryUsage();
+
+    for (std::shared_ptr<TerrainInfo> const& childTerrain : _childTerrain)
+        size += childTerrain->GetMemoryUsageImpl();
+
+    return size;
+}
+
 void TerrainInfo::LoadMapAndVMapImpl(int32 gx, int32 gy)
 {
     LoadMap(gx, gy);
@@ -201,7 +271,7 @@ void TerrainInfo::LoadMap(int32 gx, int32 gy)
     TC_LOG_DEBUG("maps", "Loading map {}", fileName);
     // loading data
     std::unique_ptr<GridMap> gridMap = std::make_unique<GridMap>();
-    GridMap::LoadResult gridMapLoadResult = gridMap->loadData(fileName.c_str());
+    GridMap::LoadResult gridMapLoadResult = gridMap->loadData(fileName.c_str(), sWorld->getBoolConfig(CONFIG_LOAD_GRID_MAP_FILES));
     if (gridMapLoadResult == GridMap::LoadResult::Ok)
         _gridMap[gx][gy] = std::move(gridMap);
     else
@@ -309,6 +379,7 @@ void TerrainInfo::CleanUpGrids(uint32 diff)
         return;
 
     // delete those GridMap objects which have refcount = 0
+    std::lock_guard<std::mutex> lock(_loadMutex);
     for (int32 x = 0; x < MAX_NUMBER_OF_GRIDS; ++x)
         for (int32 y = 0; y < MAX_NUMBER_OF_GRIDS; ++y)
             if (_loadedGrids[GetBitsetIndex(x, y)] && !_referenceCountFromMap[x][y])
@@ -323,7 +394,7 @@ static bool IsInWMOInterior(uint32 mogpFlags)
 }
 
 void TerrainInfo::GetFullTerrainStatusForPosition(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, PositionFullTerrainStatus& data,
-    Optional<map_liquidHeaderTypeFlags> reqLiquidType, float collisionHeight, DynamicMapTree const* dynamicMapTree)
+    Optional<map_liquidHeaderTypeFlags> reqLiquidType, float collisionHeight, DynamicMapTree const* dynamicMapTree, TerrainStatusCache* staticCache)
 {
     VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
     VMAP::AreaAndLiquidData vmapData;
@@ -331,7 +402,20 @@ void TerrainInfo::GetFullTerrainStatusForPosition(PhaseShift const& phaseShift,
     VMAP::AreaAndLiquidData* wmoData = nullptr;
     uint32 terrainMapId = PhasingHandler::GetTerrainMapId(phaseShift, mapId, this, x, y);
     GridMap* gmap = GetGrid(terrainMapId, x, y);
-    vmgr->getAreaAndLiquidData(terrainMapId, x, y, z, reqLiquidType ? AsUnderlyingType(*reqLiquidType) : Optional<uint8>(), vmapData);
+    Optional<uint8> vmapLiquidType = reqLiquidType ? AsUnderlyingType(*reqLiquidType) : Optional<uint8>();
+    if (staticCache && staticCache->IsEnabled())
+    {
+        // only the static vmap part is shared, gameobjects below are phase dependent and can move
+        if (Optional<VMAP::AreaAndLiquidData> cachedData = staticCache->Find(terrainMapId, x, y, z, vmapLiquidType))
+            vmapData = *cachedData;
+        else
+        {
+            vmgr->getAreaAndLiquidData(terrainMapId, x, y, z, vmapLiquidType, vmapData);
+            staticCache->Store(terrainMapId, x, y, z, vmapLiquidType, vmapData);
+        }
+    }
+    else
+        vmgr->getAreaAndLiquidData(terrainMapId, x, y, z, vmapLiquidType, vmapData);
     if (dynamicMapTree)
         dynamicMapTree->getAreaAndLiquidData(x, y, z, phaseShift, reqLiquidType ? AsUnderlyingType(*reqLiquidType) : Optional<uint8>(), dynData);
 
@@ -682,23 +766,13 @@ float TerrainInfo::GetGridHeight(PhaseShift const& phaseShift, uint32 mapId, flo
     return VMAP_INVALID_HEIGHT_VALUE;
 }
 
-float TerrainInfo::GetStaticHeight(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/)
+static float SelectStaticHeight(float z, float gridHeight, float vmapHeight)
 {
     // find raw .map surface under Z coordinates
     float mapHeight = VMAP_INVALID_HEIGHT_VALUE;
-    uint32 terrainMapId = PhasingHandler::GetTerrainMapId(phaseShift, mapId, this, x, y);
-    float gridHeight = GetGridHeight(phaseShift, mapId, x, y);
     if (G3D::fuzzyGe(z, gridHeight - GROUND_HEIGHT_TOLERANCE))
         mapHeight = gridHeight;
 
-    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;
-    if (checkVMap)
-    {
-        VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
-        if (vmgr->isHeightCalcEnabled())
-            vmapHeight = vmgr->getHeight(terrainMapId, x, y, z, maxSearchDist);
-    }
-
     // mapHeight set for any above raw ground Z or <= INVALID_HEIGHT
     // vmapheight set for any under Z value or <= INVALID_HEIGHT
     if (vmapHeight > INVALID_HEIGHT)
@@ -721,6 +795,60 @@ float TerrainInfo::GetStaticHeight(PhaseShift const& phaseShift, uint32 mapId, f
     return mapHeight;                               // explicitly use map data
 }
 
+float TerrainInfo::GetStaticHeight(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/)
+{
+    uint32 terrainMapId = PhasingHandler::GetTerrainMapId(phaseShift, mapId, this, x, y);
+    float gridHeight = GetGridHeight(phaseShift, mapId, x, y);
+
+    float vmapHeight = VMAP_INVALID_HEIGHT_VALUE;
+    if (checkVMap)
+    {
+        VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+        if (vmgr->isHeightCalcEnabled())
+            vmapHeight = vmgr->getHeight(terrainMapId, x, y, z, maxSearchDist);
+    }
+
+    return SelectStaticHeight(z, gridHeight, vmapHeight);
+}
+
+void TerrainInfo::GetStaticHeights(PhaseShift const& phaseShift, uint32 mapId, std::span<G3D::Vector3 const> positions, std::span<float> heights, bool checkVMap /*= true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/)
+{
+    ASSERT(heights.size() >= positions.size());
+
+    VMAP::IVMapManager* vmgr = VMAP::VMapFactory::createOrGetVMapManager();
+    checkVMap = checkVMap && vmgr->isHeightCalcEnabled();
+
+    std::size_t runStart = 0;
+    while (runStart < positions.size())
+    {
+        // group consecutive positions on the same grid, they resolve to the same terrain map and GridMap
+        GridCoord gridCoord = Trinity::ComputeGridCoord(positions[runStart].x, positions[runStart].y);
+        std::size_t runEnd = runStart + 1;
+        while (runEnd < positions.size() && Trinity::ComputeGridCoord(positions[runEnd].x, positions[runEnd].y) == gridCoord)
+            ++runEnd;
+
+        std::span<G3D::Vector3 const> run = positions.subspan(runStart, runEnd - runStart);
+        std::span<float> runHeights = heights.subspan(runStart, run.size());
+
+        uint32 terrainMapId = PhasingHandler::GetTerrainMapId(phaseShift, mapId, this, run.front().x, run.front().y);
+
+        // vmap heights are resolved first in place, then combined with the grid height of each position
+        if (checkVMap)
+            vmgr->getHeights(terrainMapId, run, runHeights, maxSearchDist);
+        else
+            std::fill(runHeights.begin(), runHeights.end(), VMAP_INVALID_HEIGHT_VALUE);
+
+        GridMap* gmap = GetGrid(terrainMapId, run.front().x, run.front().y);
+        for (std::size_t i = 0; i < run.size(); ++i)
+        {
+            float gridHeight = gmap ? gmap->getHeight(run[i].x, run[i].y) : VMAP_INVALID_HEIGHT_VALUE;
+            runHeights[i] = SelectStaticHeight(run[i].z, gridHeight, runHeights[i]);
+        }
+
+        runStart = runEnd;
+    }
+}
+
 float TerrainInfo::GetWaterLevel(PhaseShift const& phaseShift, uint32 mapId, float x, float y)
 {
     if (GridMap* gmap = GetGrid(PhasingHandler::GetTerrainMapId(phaseShift, mapId, this, x, y), x, y))
@@ -824,6 +952,16 @@ void TerrainMgr::Update(uint32 diff)
             terrain->CleanUpGrids(diff);
 }
 
+std::size_t TerrainMgr::GetMemoryUsage() const
+{
+    std::size_t size = 0;
+    for (auto const& [mapId, terrainRef] : _terrainMaps)
+        if (std::shared_ptr<TerrainInfo> terrain = terrainRef.lock())
+            size += terrain->GetMemoryUsage();
+
+    return size;
+}
+
 uint32 TerrainMgr::GetAreaId(PhaseShift const& phaseShift, uint32 mapid, float x, float y, float z)
 {
     if (std::shared_ptr<TerrainInfo> t = LoadTerrain(mapid))
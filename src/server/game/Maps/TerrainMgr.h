@@ -23,16 +23,19 @@
 #include "MapDefines.h"
 #include "Position.h"
 #include "Timer.h"
+#include <G3D/Vector3.h>
 #include <atomic>
 #include <bitset>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <unordered_map>
 #include <vector>
 
 class DynamicMapTree;
 class GridMap;
 class PhaseShift;
+class TerrainStatusCache;
 
 class TC_GAME_API TerrainInfo
 {
@@ -56,9 +59,24 @@ public:
     void AddChildTerrain(std::shared_ptr<TerrainInfo> childTerrain);
 
     void LoadMapAndVMap(int32 gx, int32 gy);
+    // loads terrain, vmap and mmap tiles without referencing them from a map, safe to call from any thread
+    // unreferenced tiles are released by CleanUpGrids if no map grid is created for them
+    void PrepareMapAndVMap(int32 gx, int32 gy);
     void LoadMMapInstance(uint32 mapId, uint32 instanceId);
+    // marks the navmesh tiles of the grid as used, returns true if one of them was evicted and ReloadEvictedMMaps must be called
+    bool TouchMMaps(int32 gx, int32 gy);
+    // safe to call from any thread
+    void ReloadEvictedMMaps(int32 gx, int32 gy);
+
+    // approximate memory held by terrain and navmesh data of a grid that would be released once no map references it
+    std::size_t GetGridMemoryUsage(int32 gx, int32 gy);
+    // grid map data of all loaded grids of this terrain and its child terrains
+    std::size_t GetMemoryUsage();
+    bool IsGridReferencedByOtherMaps(int32 gx, int32 gy) const { return _referenceCountFromMap[gx][gy] > 1; }
 
 private:
+    std::size_t GetGridMemoryUsageImpl(int32 gx, int32 gy) const;
+    std::size_t GetMemoryUsageImpl() const;
     void LoadMapAndVMapImpl(int32 gx, int32 gy);
     void LoadMMapInstanceImpl(uint32 mapId, uint32 instanceId);
     void LoadMap(int32 gx, int32 gy);
@@ -78,7 +96,7 @@ private:
 public:
     void CleanUpGrids(uint32 diff);
 
-    void GetFullTerrainStatusForPosition(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, PositionFullTerrainStatus& data, Optional<map_liquidHeaderTypeFlags> reqLiquidType = {}, float collisionHeight = 2.03128f, DynamicMapTree const* dynamicMapTree = nullptr); // DEFAULT_COLLISION_HEIGHT in Object.h
+    void GetFullTerrainStatusForPosition(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, PositionFullTerrainStatus& data, Optional<map_liquidHeaderTypeFlags> reqLiquidType = {}, float collisionHeight = 2.03128f, DynamicMapTree const* dynamicMapTree = nullptr, TerrainStatusCache* staticCache = nullptr); // DEFAULT_COLLISION_HEIGHT in Object.h
     ZLiquidStatus GetLiquidStatus(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, Optional<map_liquidHeaderTypeFlags> ReqLiquidType = {}, LiquidData* data = nullptr, float collisionHeight = 2.03128f); // DEFAULT_COLLISION_HEIGHT in Object.h
 
     bool GetAreaInfo(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, uint32& mogpflags, int32& adtId, int32& rootId, int32& groupId, DynamicMapTree const* dynamicMapTree = nullptr);
@@ -93,6 +111,8 @@ public:
     float GetGridHeight(PhaseShift const& phaseShift, uint32 mapId, float x, float y);
     float GetStaticHeight(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH);
     float GetStaticHeight(PhaseShift const& phaseShift, uint32 mapId, Position const& pos, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) { return GetStaticHeight(phaseShift, mapId, pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), checkVMap, maxSearchDist); }
+    // same as GetStaticHeight for every position, consecutive positions on the same grid share terrain map, GridMap and vmap tree lookups
+    void GetStaticHeights(PhaseShift const& phaseShift, uint32 mapId, std::span<G3D::Vector3 const> positions, std::span<float> heights, bool checkVMap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH);
 
     float GetWaterLevel(PhaseShift const& phaseShift, uint32 mapId, float x, float y);
     bool IsInWater(PhaseShift const& phaseShift, uint32 mapId, float x, float y, float z, LiquidData* data = nullptr);
@@ -139,6 +159,9 @@ public:
 
     void Update(uint32 diff);
 
+    // grid map data of all loaded terrains, navmesh and vmap data are reported by their managers
+    std::size_t GetMemoryUsage() const;
+
     uint32 GetAreaId(PhaseShift const& phaseShift, uint32 mapid, float x, float y, float z);
     uint32 GetAreaId(PhaseShift const& phaseShift, uint32 mapid, Position const& pos) { return GetAreaId(phaseShift, mapid, pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ()); }
     uint32 GetAreaId(PhaseShift const& phaseShift, WorldLocation const& loc) { return GetAreaId(phaseShift, loc.GetMapId(), loc); }
@@ -0,0 +1,86 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_TERRAIN_STATUS_CACHE_H
+#define TRINITY_TERRAIN_STATUS_CACHE_H
+
+#include "Define.h"
+#include "IVMapManager.h"
+#include "Optional.h"
+#include <array>
+#include <mutex>
+#include <vector>
+
+// Fixed size cache of static (vmap) area and liquid query results of a single map
+// positions are quantized to Resolution, so queries at nearly identical positions share an entry
+// entries are assigned to slots by hash and overwritten on collision, Clear() drops all of them at once
+class TC_GAME_API TerrainStatusCache
+{
+public:
+    static constexpr float Resolution = 0.5f;
+
+    struct Statistics
+    {
+        uint64 Hits = 0;
+        uint64 Misses = 0;
+    };
+
+    TerrainStatusCache() = default;
+
+    TerrainStatusCache(TerrainStatusCache const&) = delete;
+    TerrainStatusCache& operator=(TerrainStatusCache const&) = delete;
+
+    // size is rounded up to a power of two, 0 disables the cache
+    void SetSize(std::size_t size);
+    bool IsEnabled() const { return !_entries.empty(); }
+
+    Optional<VMAP::AreaAndLiquidData> Find(uint32 terrainMapId, float x, float y, float z, Optional<uint8> reqLiquidType);
+    void Store(uint32 terrainMapId, float x, float y, float z, Optional<uint8> reqLiquidType, VMAP::AreaAndLiquidData const& data);
+
+    // called when terrain data used by the map changes
+    void Clear();
+
+    // returns the counters collected since the previous call and resets them
+    Statistics ConsumeStatistics();
+
+private:
+    struct Key
+    {
+        std::array<int32, 3> Coordinates;
+        uint32 TerrainMapId;
+        int16 ReqLiquidType;
+
+        friend bool operator==(Key const&, Key const&) = default;
+    };
+
+    struct Entry
+    {
+        Key EntryKey;
+        uint32 Generation = 0;
+        VMAP::AreaAndLiquidData Data;
+    };
+
+    static Key MakeKey(uint32 terrainMapId, float x, float y, float z, Optional<uint8> reqLiquidType);
+    static std::size_t Hash(Key const& key);
+
+    std::mutex _lock;
+    std::vector<Entry> _entries;
+    uint32 _generation = 1;     // entries of older generations are empty
+    Statistics _statistics;
+};
+
+#endif // TRINITY_TERRAIN_STATUS_CACHE_H
@@ -19,12 +19,15 @@
 #include "Creature.h"
 #include "CreatureAI.h"
 #include "G3DPosition.hpp"
+#include "Map.h"
 #include "MotionMaster.h"
 #include "MoveSpline.h"
 #include "MoveSplineInit.h"
 #include "PathGenerator.h"
+#include "Random.h"
 #include "Unit.h"
 #include "Util.h"
+#include "World.h"
 
 static bool HasLostTarget(Unit* owner, Unit* target)
 {
@@ -82,6 +85,7 @@ void ChaseMovementGenerator::Initialize(Unit* /*owner*/)
 
     _path = nullptr;
     _lastTargetPosition.reset();
+    _repathThrottle.Reset();
 }
 
 void ChaseMovementGenerator::Reset(Unit* owner)
@@ -102,11 +106,14 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
     if (!target || !target->IsInWorld())
         return false;
 
+    _repathThrottle.Update(target->GetPosition(), diff);
+
     // the owner might be unable to move (rooted or casting), or we have lost the target, pause movement
     if (owner->HasUnitState(UNIT_STATE_NOT_MOVE) || owner->IsMovementPreventedByCasting() || HasLostTarget(owner, target))
     {
         owner->StopMoving();
         _lastTargetPosition.reset();
+        _repathThrottle.Reset();
         if (Creature* cOwner = owner->ToCreature())
             cOwner->SetCannotReachTarget(false);
         return true;
@@ -142,6 +149,14 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
         }
     }
 
+    // the path requested by an earlier update is calculated by a pathfinding thread, keep moving on the current spline until it is done
+    if (_path && _path->IsPathPending())
+    {
+        if (_path->UpdatePendingPath())
+            LaunchMovement(owner, target);
+        return true;
+    }
+
     // if we're done moving, we want to clean up
     if (owner->HasUnitState(UNIT_STATE_CHASE_MOVE) && owner->movespline->Finalized())
     {
@@ -157,6 +172,14 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
     // if the target moved, we have to consider whether to adjust
     if (!_lastTargetPosition || target->GetPosition() != _lastTargetPosition.value() || mutualChase != _mutualChase)
     {
+        // keep following the current path while it still ends close enough to the target
+        if (owner->HasUnitState(UNIT_STATE_CHASE_MOVE) && mutualChase == _mutualChase
+            && _repathThrottle.CanKeepPath(target->GetPosition(), sWorld->getFloatConfig(CONFIG_MOVEMENT_REPATH_TOLERANCE), sWorld->getIntConfig(CONFIG_MOVEMENT_REPATH_INTERVAL)))
+        {
+            owner->GetMap()->CountRepath(false);
+            return true;
+        }
+
         _lastTargetPosition = target->GetPosition();
         _mutualChase = mutualChase;
         if (owner->HasUnitState(UNIT_STATE_CHASE_MOVE) || !PositionOkay(owner, target, minRange, maxRange, angle))
@@ -197,8 +220,13 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
             if (owner->IsHovering())
                 owner->UpdateAllowedPositionZ(x, y, z);
 
-            bool success = _path->CalculatePath(x, y, z, owner->CanFly());
-            if (!success || (_path->GetPathType() & (PATHFIND_NOPATH /* | PATHFIND_INCOMPLETE*/)))
+            _shortenPathDistance = shortenPath ? Optional<float>(maxTarget) : Optional<float>();
+
+            uint32 const repathInterval = sWorld->getIntConfig(CONFIG_MOVEMENT_REPATH_INTERVAL);
+            _repathThrottle.OnPathCalculated(target->GetPosition(), repathInterval ? urand(repathInterval / 2, repathInterval) : 0);
+            owner->GetMap()->CountRepath(true);
+
+            if (!_path->CalculatePathAsync(x, y, z, owner->CanFly()))
             {
                 if (cOwner)
                     cOwner->SetCannotReachTarget(true);
@@ -206,41 +234,56 @@ bool ChaseMovementGenerator::Update(Unit* owner, uint32 diff)
                 return true;
             }
 
-            if (shortenPath)
-                _path->ShortenPathUntilDist(PositionToVector3(target), maxTarget);
+            if (!_path->IsPathPending())
+                LaunchMovement(owner, target);
+        }
+    }
 
-            if (cOwner)
-                cOwner->SetCannotReachTarget(false);
+    // and then, finally, we're done for the tick
+    return true;
+}
 
-            bool walk = false;
-            if (cOwner && !cOwner->IsPet())
-            {
-                switch (cOwner->GetMovementTemplate().GetChase())
-                {
-                    case CreatureChaseMovementType::CanWalk:
-                        walk = owner->IsWalking();
-                        break;
-                    case CreatureChaseMovementType::AlwaysWalk:
-                        walk = true;
-                        break;
-                    default:
-                        break;
-                }
-            }
+void ChaseMovementGenerator::LaunchMovement(Unit* owner, Unit* target)
+{
+    Creature* const cOwner = owner->ToCreature();
+    if (_path->GetPathType() & (PATHFIND_NOPATH /* | PATHFIND_INCOMPLETE*/))
+    {
+        if (cOwner)
+            cOwner->SetCannotReachTarget(true);
+        owner->StopMoving();
+        return;
+    }
 
-            owner->AddUnitState(UNIT_STATE_CHASE_MOVE);
-            AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
+    if (_shortenPathDistance)
+        _path->ShortenPathUntilDist(PositionToVector3(target), *_shortenPathDistance);
 
-            Movement::MoveSplineInit init(owner);
-            init.MovebyPath(_path->GetPath());
-            init.SetWalk(walk);
-            init.SetFacing(target);
-            init.Launch();
+    if (cOwner)
+        cOwner->SetCannotReachTarget(false);
+
+    bool walk = false;
+    if (cOwner && !cOwner->IsPet())
+    {
+        switch (cOwner->GetMovementTemplate().GetChase())
+        {
+            case CreatureChaseMovementType::CanWalk:
+                walk = owner->IsWalking();
+                break;
+            case CreatureChaseMovementType::AlwaysWalk:
+                walk = true;
+                break;
+            default:
+                break;
         }
     }
 
-    // and then, finally, we're done for the tick
-    return true;
+    owner->AddUnitState(UNIT_STATE_CHASE_MOVE);
+    AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
+
+    Movement::MoveSplineInit init(owner);
+    init.MovebyPath(_path->GetPath());
+    init.SetWalk(walk);
+    init.SetFacing(target);
+    init.Launch();
 }
 
 void ChaseMovementGenerator::Deactivate(Unit* owner)
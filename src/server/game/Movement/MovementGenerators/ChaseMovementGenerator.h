@@ -23,6 +23,7 @@
 #include "MovementGenerator.h"
 #include "Optional.h"
 #include "Position.h"
+#include "RepathThrottle.h"
 #include "Timer.h"
 
 class PathGenerator;
@@ -41,17 +42,21 @@ class ChaseMovementGenerator : public MovementGenerator, public AbstractFollower
         void Finalize(Unit*, bool, bool) override;
         MovementGeneratorType GetMovementGeneratorType() const override { return CHASE_MOTION_TYPE; }
 
-        void UnitSpeedChanged() override { _lastTargetPosition.reset(); }
+        void UnitSpeedChanged() override { _lastTargetPosition.reset(); _repathThrottle.Reset(); }
 
     private:
         static constexpr uint32 RANGE_CHECK_INTERVAL = 100; // time (ms) until we attempt to recalculate
 
+        void LaunchMovement(Unit* owner, Unit* target);
+
         Optional<ChaseRange> const _range;
         Optional<ChaseAngle> const _angle;
 
         std::unique_ptr<PathGenerator> _path;
+        Optional<float> _shortenPathDistance;   // distance to the target the path is shortened to once it is calculated
         Optional<Position> _lastTargetPosition;
         TimeTracker _rangeCheckTimer;
+        RepathThrottle _repathThrottle;
         bool _movingTowards = true;
         bool _mutualChase = true;
 };
@@ -25,6 +25,7 @@
 #include "MoveSplineInit.h"
 #include "ObjectMgr.h"
 #include "Player.h"
+#include "World.h"
 #include <sstream>
 
 #define FLIGHT_TRAVEL_UPDATE 100
@@ -40,6 +41,7 @@ FlightPathMovementGenerator::FlightPathMovementGenerator(Optional<float> speed,
     _endGridY = 0.0f;
     _endMapId = 0;
     _preloadTargetNode = 0;
+    _preparedNode = 0;
 
     Mode = MOTION_MODE_DEFAULT;
     Priority = MOTION_PRIORITY_HIGHEST;
@@ -141,6 +143,8 @@ bool FlightPathMovementGenerator::DoUpdate(Player* owner, uint32 /*diff*/)
         } while (_currentNode < _path.size() - 1);
     }
 
+    PrepareGridsAhead(owner);
+
     if (_currentNode >= (_path.size() - 1))
     {
         AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
@@ -215,6 +219,7 @@ void FlightPathMovementGenerator::LoadPath(Player* owner, uint32 startNode /*= 0
 {
     _path.clear();
     _currentNode = startNode;
+    _preparedNode = startNode;
     _pointsForPathSwitch.clear();
     std::deque<uint32> const& taxi = owner->m_taxi.GetPath();
     float discount = owner->GetReputationPriceDiscount(owner->m_taxi.GetFlightMasterFactionTemplate());
@@ -303,6 +308,34 @@ void FlightPathMovementGenerator::InitEndGridInfo()
     _endGridY = _path[nodeCount - 1]->Loc.Y;
 }
 
+void FlightPathMovementGenerator::PrepareGridsAhead(Player* owner)
+{
+    // load terrain of grids the taxi will fly over during the next few seconds in background
+    uint32 lookAhead = sWorld->getIntConfig(CONFIG_GRID_PREPARE_LOOKAHEAD);
+    if (!lookAhead || _currentNode >= _path.size())
+        return;
+
+    float remaining = _speed.value_or(PLAYER_FLIGHT_SPEED) * lookAhead / float(IN_MILLISECONDS);
+    Map* map = owner->GetMap();
+    for (uint32 i = _currentNode + 1; i < _path.size(); ++i)
+    {
+        TaxiPathNodeEntry const* previous = _path[i - 1];
+        TaxiPathNodeEntry const* node = _path[i];
+        if (node->ContinentID != owner->GetMapId())
+            break;
+
+        remaining -= std::sqrt(square(node->Loc.X - previous->Loc.X) + square(node->Loc.Y - previous->Loc.Y));
+        if (remaining < 0.0f)
+            break;
+
+        if (i <= _preparedNode)
+            continue;
+
+        map->PrepareGridAsync(Trinity::ComputeGridCoord(node->Loc.X, node->Loc.Y));
+        _preparedNode = i;
+    }
+}
+
 void FlightPathMovementGenerator::PreloadEndGrid(Player* owner)
 {
     // Used to preload the final grid where the flightmaster is
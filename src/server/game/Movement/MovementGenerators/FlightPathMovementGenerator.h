@@ -56,6 +56,7 @@ class FlightPathMovementGenerator : public MovementGeneratorMedium<Player, Fligh
         void DoEventIfAny(Player* owner, TaxiPathNodeEntry const* node, bool departure);
         void InitEndGridInfo();
         void PreloadEndGrid(Player* owner);
+        void PrepareGridsAhead(Player* owner);
 
         std::string GetDebugInfo() const override;
 
@@ -65,6 +66,7 @@ class FlightPathMovementGenerator : public MovementGeneratorMedium<Player, Fligh
         float _endGridY; //!< Y coord of last node location
         uint32 _endMapId; //!< map Id of last node location
         uint32 _preloadTargetNode; //!< node index where preloading starts
+        uint32 _preparedNode; //!< last node index whose grid terrain was prepared in advance
 
         struct TaxiNodeChangeInfo
         {
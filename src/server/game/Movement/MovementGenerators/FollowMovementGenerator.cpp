@@ -18,13 +18,16 @@
 #include "FollowMovementGenerator.h"
 #include "Creature.h"
 #include "CreatureAI.h"
+#include "Map.h"
 #include "MoveSpline.h"
 #include "MoveSplineInit.h"
 #include "Optional.h"
 #include "PathGenerator.h"
 #include "Pet.h"
+#include "Random.h"
 #include "Unit.h"
 #include "Util.h"
+#include "World.h"
 
 static void DoMovementInform(Unit* owner, Unit* target)
 {
@@ -66,6 +69,7 @@ void FollowMovementGenerator::Initialize(Unit* owner)
     UpdatePetSpeed(owner);
     _path = nullptr;
     _lastTargetPosition.reset();
+    _repathThrottle.Reset();
 }
 
 void FollowMovementGenerator::Reset(Unit* owner)
@@ -86,6 +90,8 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
     if (!target || !target->IsInWorld())
         return false;
 
+    _repathThrottle.Update(target->GetPosition(), diff);
+
     if (_duration)
     {
         _duration->Update(diff);
@@ -102,6 +108,7 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
         _path = nullptr;
         owner->StopMoving();
         _lastTargetPosition.reset();
+        _repathThrottle.Reset();
         return true;
     }
 
@@ -125,6 +132,14 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
         }
     }
 
+    // the path requested by an earlier update is calculated by a pathfinding thread, keep moving on the current spline until it is done
+    if (_path && _path->IsPathPending())
+    {
+        if (_path->UpdatePendingPath())
+            LaunchMovement(owner, target);
+        return true;
+    }
+
     if (owner->HasUnitState(UNIT_STATE_FOLLOW_MOVE) && owner->movespline->Finalized())
     {
         RemoveFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
@@ -135,6 +150,14 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
 
     if (!_lastTargetPosition || _lastTargetPosition->GetExactDistSq(target->GetPosition()) > 0.0f)
     {
+        // keep following the current path while it still ends close enough to the target
+        if (owner->HasUnitState(UNIT_STATE_FOLLOW_MOVE)
+            && _repathThrottle.CanKeepPath(target->GetPosition(), sWorld->getFloatConfig(CONFIG_MOVEMENT_REPATH_TOLERANCE), sWorld->getIntConfig(CONFIG_MOVEMENT_REPATH_INTERVAL)))
+        {
+            owner->GetMap()->CountRepath(false);
+            return true;
+        }
+
         _lastTargetPosition = target->GetPosition();
         if (owner->HasUnitState(UNIT_STATE_FOLLOW_MOVE) || !PositionOkay(owner, target, range + FOLLOW_RANGE_TOLERANCE))
         {
@@ -171,26 +194,41 @@ bool FollowMovementGenerator::Update(Unit* owner, uint32 diff)
                     allowShortcut = true;
             }
 
-            bool success = _path->CalculatePath(x, y, z, allowShortcut);
-            if (!success || (_path->GetPathType() & PATHFIND_NOPATH))
+            uint32 const repathInterval = sWorld->getIntConfig(CONFIG_MOVEMENT_REPATH_INTERVAL);
+            _repathThrottle.OnPathCalculated(target->GetPosition(), repathInterval ? urand(repathInterval / 2, repathInterval) : 0);
+            owner->GetMap()->CountRepath(true);
+
+            if (!_path->CalculatePathAsync(x, y, z, allowShortcut))
             {
                 owner->StopMoving();
                 return true;
             }
 
-            owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
-            AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
-
-            Movement::MoveSplineInit init(owner);
-            init.MovebyPath(_path->GetPath());
-            init.SetWalk(target->IsWalking());
-            init.SetFacing(target->GetOrientation());
-            init.Launch();
+            if (!_path->IsPathPending())
+                LaunchMovement(owner, target);
         }
     }
     return true;
 }
 
+void FollowMovementGenerator::LaunchMovement(Unit* owner, Unit* target)
+{
+    if (_path->GetPathType() & PATHFIND_NOPATH)
+    {
+        owner->StopMoving();
+        return;
+    }
+
+    owner->AddUnitState(UNIT_STATE_FOLLOW_MOVE);
+    AddFlag(MOVEMENTGENERATOR_FLAG_INFORM_ENABLED);
+
+    Movement::MoveSplineInit init(owner);
+    init.MovebyPath(_path->GetPath());
+    init.SetWalk(target->IsWalking());
+    init.SetFacing(target->GetOrientation());
+    init.Launch();
+}
+
 void FollowMovementGenerator::Deactivate(Unit* owner)
 {
     AddFlag(MOVEMENTGENERATOR_FLAG_DEACTIVATED);
@@ -22,6 +22,7 @@
 #include "MovementDefines.h"
 #include "MovementGenerator.h"
 #include "Position.h"
+#include "RepathThrottle.h"
 #include "Timer.h"
 
 class PathGenerator;
@@ -43,11 +44,12 @@ class FollowMovementGenerator : public MovementGenerator, public AbstractFollowe
         void Finalize(Unit*, bool, bool) override;
         MovementGeneratorType GetMovementGeneratorType() const override { return FOLLOW_MOTION_TYPE; }
 
-        void UnitSpeedChanged() override { _lastTargetPosition.reset(); }
+        void UnitSpeedChanged() override { _lastTargetPosition.reset(); _repathThrottle.Reset(); }
 
     private:
         static constexpr uint32 CHECK_INTERVAL = 100;
 
+        void LaunchMovement(Unit* owner, Unit* target);
         void UpdatePetSpeed(Unit* owner);
 
         float const _range;
@@ -57,6 +59,7 @@ class FollowMovementGenerator : public MovementGenerator, public AbstractFollowe
         Optional<TimeTracker> _duration;
         std::unique_ptr<PathGenerator> _path;
         Optional<Position> _lastTargetPosition;
+        RepathThrottle _repathThrottle;
 };
 
 #endif
@@ -23,6 +23,7 @@
 #include "MovementDefines.h"
 #include "MoveSpline.h"
 #include "MoveSplineInit.h"
+#include "World.h"
 
 FormationMovementGenerator::FormationMovementGenerator(Unit* leader, float range, float angle, uint32 point1, uint32 point2) : AbstractFollower(ASSERT_NOTNULL(leader)),
     _range(range), _angle(angle), _point1(point1), _point2(point2), _lastLeaderSplineID(0), _hasPredictedDestination(false)
@@ -137,14 +138,8 @@ bool FormationMovementGenerator::DoUpdate(Creature* owner, uint32 diff)
     return true;
 }
 
-void FormationMovementGenerator::LaunchMovement(Creature* owner, Unit* target)
+FormationLeaderDestination FormationMovementGenerator::PredictLeaderDestination(Unit* leader)
 {
-    float relativeAngle = 0.f;
-
-    // Determine our relative angle to our current spline destination point
-    if (!target->movespline->Finalized())
-        relativeAngle = target->GetRelativeAngle(Vector3ToPosition(target->movespline->CurrentDestination()));
-
     // Destination calculation
     /*
         According to sniff data, formation members have a periodic move interal of 1,2s.
@@ -152,39 +147,70 @@ void FormationMovementGenerator::LaunchMovement(Creature* owner, Unit* target)
         To get a representative result like that we have to predict our formation leader's path
         and apply our formation shape based on that destination.
     */
-    Position dest = target->GetPosition();
-    float velocity = 0.f;
+    FormationLeaderDestination result;
+    result.Destination = leader->GetPosition();
 
-    // Formation leader is moving. Predict our destination
-    if (!target->movespline->Finalized())
-    {
-        // Pick up leader's spline velocity
-        velocity = target->movespline->Velocity();
+    // Formation leader is not moving, the formation shape is applied on his position
+    if (leader->movespline->Finalized())
+        return result;
+
+    // Determine our relative angle to our current spline destination point
+    result.RelativeAngle = leader->GetRelativeAngle(Vector3ToPosition(leader->movespline->CurrentDestination()));
 
-        // Calculate travel distance to get a 1650ms result
-        float travelDist = velocity * 1.65f;
+    // Pick up leader's spline velocity
+    result.Velocity = leader->movespline->Velocity();
+
+    // Calculate travel distance to get a 1650ms result
+    result.TravelDistance = result.Velocity * 1.65f;
+
+    // Move destination ahead
+    leader->MovePositionToFirstCollision(result.Destination, result.TravelDistance, result.RelativeAngle);
+    result.Predicted = true;
+    return result;
+}
+
+void FormationMovementGenerator::LaunchMovement(Creature* owner, Unit* target)
+{
+    // members of a formation share the prediction of their leader's movement
+    CreatureGroup* formation = owner->GetFormation();
+    bool const sharedPath = sWorld->getBoolConfig(CONFIG_CREATURE_FORMATION_SHARED_PATH) && formation && target->GetTypeId() == TYPEID_UNIT
+        && formation->IsLeader(target->ToCreature());
 
-        // Move destination ahead...
-        target->MovePositionToFirstCollision(dest, travelDist, relativeAngle);
-        // ... and apply formation shape
-        target->MovePositionToFirstCollision(dest, _range, _angle + relativeAngle);
+    FormationLeaderDestination const leaderDestination = sharedPath ? formation->GetLeaderDestination() : PredictLeaderDestination(target);
+    Position dest = leaderDestination.Destination;
+    float velocity = leaderDestination.Velocity;
 
+    // Apply formation shape
+    if (sharedPath)
+    {
+        // only the leader's movement is checked for collisions, our offset from it is just placed on the ground
+        float const angle = target->GetOrientation() + _angle + leaderDestination.RelativeAngle;
+        float x = dest.GetPositionX() + _range * std::cos(angle);
+        float y = dest.GetPositionY() + _range * std::sin(angle);
+        float z = dest.GetPositionZ();
+        if (Trinity::IsValidMapCoord(x, y))
+        {
+            owner->UpdateAllowedPositionZ(x, y, z);
+            dest.Relocate(x, y, z);
+        }
+    }
+    else
+        target->MovePositionToFirstCollision(dest, _range, _angle + leaderDestination.RelativeAngle);
+
+    // Formation leader is moving. Adjust our speed to arrive at our predicted destination together with him
+    if (leaderDestination.Predicted)
+    {
         float distance = owner->GetExactDist(dest);
 
         // Calculate catchup speed mod (Limit to a maximum of 50% of our original velocity
-        float velocityMod = std::min<float>(distance / travelDist, 1.5f);
+        float velocityMod = std::min<float>(distance / leaderDestination.TravelDistance, 1.5f);
 
         // Now we will always stay synch with our leader
         velocity *= velocityMod;
-        _hasPredictedDestination = true;
-    }
-    else
-    {
-        // Formation leader is not moving. Just apply the base formation shape on his position.
-        target->MovePositionToFirstCollision(dest, _range, _angle + relativeAngle);
-        _hasPredictedDestination = false;
     }
 
+    _hasPredictedDestination = leaderDestination.Predicted;
+
     // Leader is not moving, so just pick up his default walk speed
     if (velocity == 0.f)
         velocity = target->GetSpeed(MOVE_WALK);
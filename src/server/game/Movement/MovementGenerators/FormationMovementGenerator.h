@@ -24,6 +24,7 @@
 #include "Timer.h"
 
 class Creature;
+struct FormationLeaderDestination;
 
 class FormationMovementGenerator : public MovementGeneratorMedium<Creature, FormationMovementGenerator>, public AbstractFollower
 {
@@ -38,6 +39,8 @@ class FormationMovementGenerator : public MovementGeneratorMedium<Creature, Form
         void DoDeactivate(Creature*);
         void DoFinalize(Creature*, bool, bool);
 
+        static FormationLeaderDestination PredictLeaderDestination(Unit* leader);
+
     private:
         void MovementInform(Creature*);
         void LaunchMovement(Creature* owner, Unit* target);
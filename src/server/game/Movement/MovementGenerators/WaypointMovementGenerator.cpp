@@ -364,7 +364,8 @@ void CreateSingularPointPath(Unit const* owner, WaypointPath const* path, uint32
 }
 
 void CreateMergedPath(Unit const* owner, WaypointPath const* path, uint32 previousNode, uint32 currentNode, bool isReturningToStart, bool generatePath,
-    Movement::PointsArray* points, std::vector<int32>* waypointTransitionSplinePoints, WaypointNode const** lastWaypointOnPath)
+    Movement::PointsArray* points, std::vector<int32>* waypointTransitionSplinePoints, WaypointNode const** lastWaypointOnPath,
+    std::span<float const>* knownSegmentLengths)
 {
     std::span<WaypointNode const> segment = [&]
     {
@@ -393,6 +394,29 @@ void CreateMergedPath(Unit const* owner, WaypointPath const* path, uint32 previo
     *lastWaypointOnPath = !isReturningToStart ? &segment.back() : &segment.front();
 
     waypointTransitionSplinePoints->clear();
+    if (!generatePath)
+    {
+        // without pathfinding the spline goes through the nodes themselves, take them and the lengths between them from the shared path data
+        std::size_t const first = &segment.front() - path->Nodes.data();
+        points->emplace_back(owner->GetPositionX(), owner->GetPositionY(), owner->GetPositionZ());
+        if (!isReturningToStart)
+            points->insert(points->end(), path->Points.begin() + first, path->Points.begin() + first + segment.size());
+        else
+            points->insert(points->end(), std::make_reverse_iterator(path->Points.begin() + first + segment.size()), std::make_reverse_iterator(path->Points.begin() + first));
+
+        for (std::size_t i = 1; i < points->size(); ++i)
+            waypointTransitionSplinePoints->push_back(i);
+
+        if (segment.size() >= 3)
+        {
+            if (!isReturningToStart)
+                *knownSegmentLengths = std::span(&path->ForwardSegmentLengths[currentNode + 1], segment.size() - 2);
+            else
+                *knownSegmentLengths = std::span(&path->BackwardSegmentLengths[path->Nodes.size() - currentNode], segment.size() - 2);
+        }
+        return;
+    }
+
     auto fillPath = [&]<typename iterator>(iterator itr, iterator end)
     {
         Optional<PathGenerator> generator;
@@ -504,10 +528,11 @@ void WaypointMovementGenerator<Creature>::StartMove(Creature* owner, bool relaun
     WaypointNode const* lastWaypointForSegment = &path->Nodes[_currentNode];
 
     Movement::PointsArray points;
+    std::span<float const> knownSegmentLengths;
 
     if (IsExactSplinePath())
         CreateMergedPath(owner, path, previousNode, _currentNode, _isReturningToStart, false,
-            &points, &_waypointTransitionSplinePoints, &lastWaypointForSegment);
+            &points, &_waypointTransitionSplinePoints, &lastWaypointForSegment, &knownSegmentLengths);
     else
         CreateSingularPointPath(owner, path, _currentNode, _generatePath, &points, &_waypointTransitionSplinePoints);
 
@@ -568,7 +593,10 @@ void WaypointMovementGenerator<Creature>::StartMove(Creature* owner, bool relaun
         init.SetVelocity(*_speed);
 
     if (IsExactSplinePath() && points.size() > 2 && owner->CanFly())
+    {
         init.SetSmooth();
+        init.SetKnownSegmentLengths(knownSegmentLengths);
+    }
 
     Milliseconds duration(init.Launch());
 
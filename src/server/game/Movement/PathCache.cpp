@@ -0,0 +1,98 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathCache.h"
+#include "Hash.h"
+#include <algorithm>
+#include <utility>
+
+void PathCache::SetSize(std::size_t size)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _maxSize = size;
+    _entries.clear();
+    _order.clear();
+}
+
+uint32 PathCache::Find(uint32 meshMapId, dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags, dtPolyRef* path, uint32 maxPathLength)
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_maxSize)
+        return 0;
+
+    auto itr = _entries.find({ startPoly, endPoly, meshMapId, includeFlags, excludeFlags });
+    if (itr == _entries.end() || itr->second.Path.size() > maxPathLength)
+    {
+        ++_statistics.Misses;
+        return 0;
+    }
+
+    ++_statistics.Hits;
+    _order.splice(_order.begin(), _order, itr->second.OrderItr);
+    std::copy(itr->second.Path.begin(), itr->second.Path.end(), path);
+    return uint32(itr->second.Path.size());
+}
+
+void PathCache::Store(uint32 meshMapId, dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags, dtPolyRef const* path, uint32 pathLength)
+{
+    Key key{ startPoly, endPoly, meshMapId, includeFlags, excludeFlags };
+
+    std::lock_guard<std::mutex> lock(_lock);
+    if (!_maxSize || !pathLength)
+        return;
+
+    auto [itr, inserted] = _entries.try_emplace(key);
+    itr->second.Path.assign(path, path + pathLength);
+    if (!inserted)
+    {
+        _order.splice(_order.begin(), _order, itr->second.OrderItr);
+        return;
+    }
+
+    _order.push_front(key);
+    itr->second.OrderItr = _order.begin();
+
+    while (_entries.size() > _maxSize)
+    {
+        _entries.erase(_order.back());
+        _order.pop_back();
+    }
+}
+
+void PathCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    _entries.clear();
+    _order.clear();
+}
+
+PathCache::Statistics PathCache::ConsumeStatistics()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    return std::exchange(_statistics, Statistics());
+}
+
+std::size_t PathCache::KeyHash::operator()(Key const& key) const
+{
+    std::size_t hash = 0;
+    Trinity::hash_combine(hash, key.StartPoly);
+    Trinity::hash_combine(hash, key.EndPoly);
+    Trinity::hash_combine(hash, key.MeshMapId);
+    Trinity::hash_combine(hash, key.IncludeFlags);
+    Trinity::hash_combine(hash, key.ExcludeFlags);
+    return hash;
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_PATH_CACHE_H
+#define TRINITY_PATH_CACHE_H
+
+#include "Define.h"
+#include "DetourNavMesh.h"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// LRU cache of detour polygon paths (findPath results) of a single map
+// entries are keyed by nav mesh, start and end polygon and the flags of the query filter
+// the point path is still built from the actual start and end positions, only the search for the polygon corridor is skipped
+// polygon references of tiles that were unloaded become invalid, callers must check them before use
+class TC_GAME_API PathCache
+{
+public:
+    struct Statistics
+    {
+        uint64 Hits = 0;
+        uint64 Misses = 0;
+    };
+
+    PathCache() = default;
+
+    PathCache(PathCache const&) = delete;
+    PathCache& operator=(PathCache const&) = delete;
+
+    // 0 disables the cache
+    void SetSize(std::size_t size);
+    bool IsEnabled() const { return _maxSize != 0; }
+
+    // return: number of polygons copied to path, 0 if there is no entry
+    uint32 Find(uint32 meshMapId, dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags, dtPolyRef* path, uint32 maxPathLength);
+    void Store(uint32 meshMapId, dtPolyRef startPoly, dtPolyRef endPoly, uint16 includeFlags, uint16 excludeFlags, dtPolyRef const* path, uint32 pathLength);
+
+    // called when nav mesh tiles used by the map change
+    void Clear();
+
+    // returns the counters collected since the previous call and resets them
+    Statistics ConsumeStatistics();
+
+private:
+    struct Key
+    {
+        dtPolyRef StartPoly;
+        dtPolyRef EndPoly;
+        uint32 MeshMapId;
+        uint16 IncludeFlags;
+        uint16 ExcludeFlags;
+
+        friend bool operator==(Key const&, Key const&) = default;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(Key const& key) const;
+    };
+
+    struct Entry
+    {
+        std::vector<dtPolyRef> Path;
+        std::list<Key>::iterator OrderItr;
+    };
+
+    std::mutex _lock;
+    std::size_t _maxSize = 0;
+    std::unordered_map<Key, Entry, KeyHash> _entries;
+    std::list<Key> _order;  // most recently used first
+    Statistics _statistics;
+};
+
+#endif // TRINITY_PATH_CACHE_H
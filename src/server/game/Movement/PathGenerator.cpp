@@ -25,27 +25,37 @@
 #include "MMapFactory.h"
 #include "MMapManager.h"
 #include "Map.h"
+#include "MapManager.h"
 #include "Metric.h"
+#include "PathCache.h"
 #include "PhasingHandler.h"
+#include "ThreadPool.h"
+
+namespace
+{
+void ExecutePathQueryOnWorker(PathQuery& query)
+{
+    MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
+    std::shared_lock<std::shared_mutex> lock = mmap->LockNavMeshesForWorker();
+    MMAP::NavMeshQueryPtr navMeshQuery = mmap->AcquireNavMeshQuery(query.MeshMapId);
+    query.Execute(navMeshQuery.get());
+}
+}
 
 ////////////////// PathGenerator //////////////////
 PathGenerator::PathGenerator(WorldObject const* owner) :
     _polyLength(0), _type(PATHFIND_BLANK), _useStraightPath(false),
     _forceDestination(false), _pointPathLimit(MAX_POINT_PATH_LENGTH), _useRaycast(false),
     _startPosition(PositionToVector3(owner)), _endPosition(G3D::Vector3::zero()), _source(owner), _navMesh(nullptr),
-    _navMeshQuery(nullptr)
+    _navMeshQuery(nullptr), _meshMapId(0)
 {
     memset(_pathPolyRefs, 0, sizeof(_pathPolyRefs));
 
     TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::PathGenerator for {}", _source->GetGUID().ToString());
 
-    uint32 mapId = PhasingHandler::GetTerrainMapId(_source->GetPhaseShift(), _source->GetMapId(), _source->GetMap()->GetTerrain(), _startPosition.x, _startPosition.y);
+    _meshMapId = PhasingHandler::GetTerrainMapId(_source->GetPhaseShift(), _source->GetMapId(), _source->GetMap()->GetTerrain(), _startPosition.x, _startPosition.y);
     if (DisableMgr::IsPathfindingEnabled(_source->GetMapId()))
-    {
-        MMAP::MMapManager* mmap = MMAP::MMapFactory::createOrGetMMapManager();
-        _navMeshQuery = mmap->GetNavMeshQuery(mapId, _source->GetMapId(), _source->GetInstanceId());
-        _navMesh = _navMeshQuery ? _navMeshQuery->getAttachedNavMesh() : mmap->GetNavMesh(mapId);
-    }
+        _navMesh = MMAP::MMapFactory::createOrGetMMapManager()->GetNavMesh(_meshMapId);
 
     CreateFilter();
 }
@@ -56,12 +66,44 @@ PathGenerator::~PathGenerator()
 }
 
 bool PathGenerator::CalculatePath(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, bool forceDest)
+{
+    return BuildPath(srcX, srcY, srcZ, destX, destY, destZ, forceDest, false);
+}
+
+bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool forceDest)
+{
+    float x, y, z;
+    _source->GetPosition(x, y, z);
+    return BuildPath(x, y, z, destX, destY, destZ, forceDest, false);
+}
+
+bool PathGenerator::CalculatePathAsync(float destX, float destY, float destZ, bool forceDest)
+{
+    float x, y, z;
+    _source->GetPosition(x, y, z);
+    return BuildPath(x, y, z, destX, destY, destZ, forceDest, true);
+}
+
+bool PathGenerator::UpdatePendingPath()
+{
+    if (!_pendingQuery || !_pendingQuery->Done.load(std::memory_order_acquire))
+        return false;
+
+    std::shared_ptr<PathQuery> query = std::move(_pendingQuery);
+    FinishPolyPath(*query);
+    return true;
+}
+
+bool PathGenerator::BuildPath(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, bool forceDest, bool async)
 {
     if (!Trinity::IsValidMapCoord(destX, destY, destZ) || !Trinity::IsValidMapCoord(srcX, srcY, srcZ))
         return false;
 
     TC_METRIC_DETAILED_EVENT("mmap_events", "CalculatePath", "");
 
+    // a path that is still being calculated is replaced by the new one, the result of its worker is ignored
+    _pendingQuery = nullptr;
+
     G3D::Vector3 dest(destX, destY, destZ);
     SetEndPosition(dest);
 
@@ -72,6 +114,13 @@ bool PathGenerator::CalculatePath(float srcX, float srcY, float srcZ, float dest
 
     TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::CalculatePath() for {}", _source->GetGUID().ToString());
 
+    // the nav mesh query is borrowed for the duration of the calculation only
+    MMAP::NavMeshQueryPtr navMeshQuery;
+    if (_navMesh)
+        navMeshQuery = MMAP::MMapFactory::createOrGetMMapManager()->AcquireNavMeshQuery(_meshMapId);
+
+    _navMeshQuery = navMeshQuery.get();
+
     // make sure navMesh works - we can run on map w/o mmap
     // check if the start and end point have a .mmtile loaded (can we pass via not loaded tile on the way?)
     Unit const* _sourceUnit = _source->ToUnit();
@@ -80,20 +129,40 @@ bool PathGenerator::CalculatePath(float srcX, float srcY, float srcZ, float dest
     {
         BuildShortcut();
         _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
-        return true;
     }
+    else
+    {
+        UpdateFilter();
 
-    UpdateFilter();
+        BuildPolyPath(start, dest, async);
+    }
 
-    BuildPolyPath(start, dest);
+    _navMeshQuery = nullptr;
     return true;
 }
 
-bool PathGenerator::CalculatePath(float destX, float destY, float destZ, bool forceDest)
+void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos, bool async)
 {
-    float x, y, z;
-    _source->GetPosition(x, y, z);
-    return CalculatePath(x, y, z, destX, destY, destZ, forceDest);
+    if (async)
+    {
+        if (Trinity::ThreadPool* pool = sMapMgr->GetPathfindingPool())
+        {
+            std::shared_ptr<PathQuery> query = std::make_shared<PathQuery>();
+            if (PreparePolyPath(startPos, endPos, *query))
+            {
+                _pendingQuery = query;
+                pool->PostWork([query = std::move(query)]() { ExecutePathQueryOnWorker(*query); });
+            }
+            return;
+        }
+    }
+
+    PathQuery query;
+    if (PreparePolyPath(startPos, endPos, query))
+    {
+        query.Execute(_navMeshQuery);
+        FinishPolyPath(query);
+    }
 }
 
 dtPolyRef PathGenerator::GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* point, float* distance) const
@@ -162,7 +231,7 @@ dtPolyRef PathGenerator::GetPolyByLocation(float const* point, float* distance)
     return INVALID_POLYREF;
 }
 
-void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos)
+bool PathGenerator::PreparePolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos, PathQuery& query)
 {
     // *** getting start/end poly logic ***
 
@@ -203,14 +272,14 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         if (path || waterPath)
         {
             _type = PathType(PATHFIND_NORMAL | PATHFIND_NOT_USING_PATH);
-            return;
+            return false;
         }
 
         // raycast doesn't need endPoly to be valid
         if (!_useRaycast)
         {
             _type = PATHFIND_NOPATH;
-            return;
+            return false;
         }
     }
 
@@ -251,7 +320,7 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
 
             AddFarFromPolyFlags(startFarFromPoly, endFarFromPoly);
 
-            return;
+            return false;
         }
         else
         {
@@ -269,332 +338,149 @@ void PathGenerator::BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 con
         }
     }
 
-    // *** poly path generating logic ***
-
-    // start and end are on same polygon
-    // handle this case as if they were 2 different polygons, building a line path split in some few points
-    if (startPoly == endPoly && !_useRaycast)
+    // raycast is a single detour call and only builds a 2-point path, it is always done right away
+    if (_useRaycast)
     {
-        TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (startPoly == endPoly)");
-
-        _pathPolyRefs[0] = startPoly;
-        _polyLength = 1;
-
-        if (startFarFromPoly || endFarFromPoly)
+        // it can't continue a previous path
+        if (std::find(_pathPolyRefs, _pathPolyRefs + _polyLength, startPoly) != _pathPolyRefs + _polyLength)
         {
-            _type = PathType(PATHFIND_INCOMPLETE);
-
-            AddFarFromPolyFlags(startFarFromPoly, endFarFromPoly);
+            TC_LOG_ERROR("maps.mmaps", "PathGenerator::BuildPolyPath() called with _useRaycast with a previous path for unit {}", _source->GetGUID().ToString());
+            BuildShortcut();
+            _type = PATHFIND_NOPATH;
+            return false;
         }
-        else
-         _type = PATHFIND_NORMAL;
 
-        BuildPointPath(startPoint, endPoint);
-        return;
+        // free and invalidate old path data
+        Clear();
+
+        BuildRaycastPath(startPoly, startPoint, endPoint, startFarFromPoly, endFarFromPoly);
+        return false;
     }
 
-    // look for startPoly/endPoly in current path
-    /// @todo we can merge it with getPathPolyByPosition() loop
-    bool startPolyFound = false;
-    bool endPolyFound = false;
-    uint32 pathStartIndex = 0;
-    uint32 pathEndIndex = 0;
+    query.MeshMapId = _meshMapId;
+    query.Source = _source->GetGUID();
+    query.Filter = _filter;
+    query.StartPoly = startPoly;
+    query.EndPoly = endPoly;
+    dtVcopy(query.StartPoint, startPoint);
+    dtVcopy(query.EndPoint, endPoint);
+    query.StartFarFromPoly = startFarFromPoly;
+    query.EndFarFromPoly = endFarFromPoly;
+    query.UseStraightPath = _useStraightPath;
+    query.PointPathLimit = _pointPathLimit;
+    query.Cache = _source->GetMap()->GetPathCache();
+    memcpy(query.PathPolyRefs, _pathPolyRefs, _polyLength * sizeof(dtPolyRef));
+    query.PolyLength = _polyLength;
+    return true;
+}
 
-    if (_polyLength)
+void PathGenerator::BuildRaycastPath(dtPolyRef startPoly, float const* startPoint, float* endPoint, bool startFarFromPoly, bool endFarFromPoly)
+{
+    float hit = 0;
+    float hitNormal[3];
+    memset(hitNormal, 0, sizeof(hitNormal));
+
+    dtStatus dtResult = _navMeshQuery->raycast(
+                    startPoly,
+                    startPoint,
+                    endPoint,
+                    &_filter,
+                    &hit,
+                    hitNormal,
+                    _pathPolyRefs,
+                    (int*)&_polyLength,
+                    MAX_PATH_LENGTH);
+
+    if (!_polyLength || dtStatusFailed(dtResult))
     {
-        for (; pathStartIndex < _polyLength; ++pathStartIndex)
-        {
-            // here to catch few bugs
-            if (_pathPolyRefs[pathStartIndex] == INVALID_POLYREF)
-            {
-                TC_LOG_ERROR("maps.mmaps", "Invalid poly ref in BuildPolyPath. _polyLength: {}, pathStartIndex: {},"
-                                     " startPos: {}, endPos: {}, mapid: {}",
-                                     _polyLength, pathStartIndex, startPos.toString(), endPos.toString(),
-                                     _source->GetMapId());
-
-                break;
-            }
-
-            if (_pathPolyRefs[pathStartIndex] == startPoly)
-            {
-                startPolyFound = true;
-                break;
-            }
-        }
-
-        for (pathEndIndex = _polyLength-1; pathEndIndex > pathStartIndex; --pathEndIndex)
-            if (_pathPolyRefs[pathEndIndex] == endPoly)
-            {
-                endPolyFound = true;
-                break;
-            }
+        BuildShortcut();
+        _type = PATHFIND_NOPATH;
+        AddFarFromPolyFlags(startFarFromPoly, endFarFromPoly);
+        return;
     }
 
-    if (startPolyFound && endPolyFound)
-    {
-        TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (startPolyFound && endPolyFound)");
-
-        // we moved along the path and the target did not move out of our old poly-path
-        // our path is a simple subpath case, we have all the data we need
-        // just "cut" it out
-
-        _polyLength = pathEndIndex - pathStartIndex + 1;
-        memmove(_pathPolyRefs, _pathPolyRefs + pathStartIndex, _polyLength * sizeof(dtPolyRef));
-    }
-    else if (startPolyFound && !endPolyFound)
+    // raycast() sets hit to FLT_MAX if there is a ray between start and end
+    if (hit != FLT_MAX)
     {
-        TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (startPolyFound && !endPolyFound)");
-
-        // we are moving on the old path but target moved out
-        // so we have atleast part of poly-path ready
-
-        _polyLength -= pathStartIndex;
-
-        // try to adjust the suffix of the path instead of recalculating entire length
-        // at given interval the target cannot get too far from its last location
-        // thus we have less poly to cover
-        // sub-path of optimal path is optimal
-
-        // take ~80% of the original length
-        /// @todo play with the values here
-        uint32 prefixPolyLength = uint32(_polyLength * 0.8f + 0.5f);
-        memmove(_pathPolyRefs, _pathPolyRefs+pathStartIndex, prefixPolyLength * sizeof(dtPolyRef));
+        float hitPos[3];
 
-        dtPolyRef suffixStartPoly = _pathPolyRefs[prefixPolyLength-1];
+        // Walk back a bit from the hit point to make sure it's in the mesh (sometimes the point is actually outside of the polygons due to float precision issues)
+        hit *= 0.99f;
+        dtVlerp(hitPos, startPoint, endPoint, hit);
 
-        // we need any point on our suffix start poly to generate poly-path, so we need last poly in prefix data
-        float suffixEndPoint[VERTEX_SIZE];
-        if (dtStatusFailed(_navMeshQuery->closestPointOnPoly(suffixStartPoly, endPoint, suffixEndPoint, nullptr)))
-        {
-            // we can hit offmesh connection as last poly - closestPointOnPoly() don't like that
-            // try to recover by using prev polyref
-            --prefixPolyLength;
-            suffixStartPoly = _pathPolyRefs[prefixPolyLength-1];
-            if (dtStatusFailed(_navMeshQuery->closestPointOnPoly(suffixStartPoly, endPoint, suffixEndPoint, nullptr)))
-            {
-                // suffixStartPoly is still invalid, error state
-                BuildShortcut();
-                _type = PATHFIND_NOPATH;
-                return;
-            }
-        }
+        // if it fails again, clamp to poly boundary
+        if (dtStatusFailed(_navMeshQuery->getPolyHeight(_pathPolyRefs[_polyLength - 1], hitPos, &hitPos[1])))
+            _navMeshQuery->closestPointOnPolyBoundary(_pathPolyRefs[_polyLength - 1], hitPos, hitPos);
 
-        // generate suffix
-        uint32 suffixPolyLength = 0;
+        _pathPoints.resize(2);
+        _pathPoints[0] = GetStartPosition();
+        _pathPoints[1] = G3D::Vector3(hitPos[2], hitPos[0], hitPos[1]);
 
-        dtStatus dtResult;
-        if (_useRaycast)
-        {
-            TC_LOG_ERROR("maps.mmaps", "PathGenerator::BuildPolyPath() called with _useRaycast with a previous path for unit {}", _source->GetGUID().ToString());
-            BuildShortcut();
-            _type = PATHFIND_NOPATH;
-            return;
-        }
-        else
-        {
-            dtResult = _navMeshQuery->findPath(
-                            suffixStartPoly,    // start polygon
-                            endPoly,            // end polygon
-                            suffixEndPoint,     // start position
-                            endPoint,           // end position
-                            &_filter,            // polygon search filter
-                            _pathPolyRefs + prefixPolyLength - 1,    // [out] path
-                            (int*)&suffixPolyLength,
-                            MAX_PATH_LENGTH - prefixPolyLength);   // max number of polygons in output path
-        }
-
-        if (!suffixPolyLength || dtStatusFailed(dtResult))
-        {
-            // this is probably an error state, but we'll leave it
-            // and hopefully recover on the next Update
-            // we still need to copy our preffix
-            TC_LOG_ERROR("maps.mmaps", "Path Build failed\n{}", _source->GetDebugInfo());
-        }
-
-        TC_LOG_DEBUG("maps.mmaps", "++  m_polyLength={} prefixPolyLength={} suffixPolyLength={}", _polyLength, prefixPolyLength, suffixPolyLength);
-
-        // new path = prefix + suffix - overlap
-        _polyLength = prefixPolyLength + suffixPolyLength - 1;
+        NormalizePath();
+        _type = PATHFIND_INCOMPLETE;
+        AddFarFromPolyFlags(startFarFromPoly, false);
     }
     else
     {
-        TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (!startPolyFound && !endPolyFound)");
+        // clamp to poly boundary if we fail to get the height
+        if (dtStatusFailed(_navMeshQuery->getPolyHeight(_pathPolyRefs[_polyLength - 1], endPoint, &endPoint[1])))
+            _navMeshQuery->closestPointOnPolyBoundary(_pathPolyRefs[_polyLength - 1], endPoint, endPoint);
 
-        // either we have no path at all -> first run
-        // or something went really wrong -> we aren't moving along the path to the target
-        // just generate new path
+        _pathPoints.resize(2);
+        _pathPoints[0] = GetStartPosition();
+        _pathPoints[1] = G3D::Vector3(endPoint[2], endPoint[0], endPoint[1]);
 
-        // free and invalidate old path data
-        Clear();
-
-        dtStatus dtResult;
-        if (_useRaycast)
+        NormalizePath();
+        if (startFarFromPoly || endFarFromPoly)
         {
-            float hit = 0;
-            float hitNormal[3];
-            memset(hitNormal, 0, sizeof(hitNormal));
-
-            dtResult = _navMeshQuery->raycast(
-                            startPoly,
-                            startPoint,
-                            endPoint,
-                            &_filter,
-                            &hit,
-                            hitNormal,
-                            _pathPolyRefs,
-                            (int*)&_polyLength,
-                            MAX_PATH_LENGTH);
-
-            if (!_polyLength || dtStatusFailed(dtResult))
-            {
-                BuildShortcut();
-                _type = PATHFIND_NOPATH;
-                AddFarFromPolyFlags(startFarFromPoly, endFarFromPoly);
-                return;
-            }
-
-            // raycast() sets hit to FLT_MAX if there is a ray between start and end
-            if (hit != FLT_MAX)
-            {
-                float hitPos[3];
-
-                // Walk back a bit from the hit point to make sure it's in the mesh (sometimes the point is actually outside of the polygons due to float precision issues)
-                hit *= 0.99f;
-                dtVlerp(hitPos, startPoint, endPoint, hit);
-
-                // if it fails again, clamp to poly boundary
-                if (dtStatusFailed(_navMeshQuery->getPolyHeight(_pathPolyRefs[_polyLength - 1], hitPos, &hitPos[1])))
-                    _navMeshQuery->closestPointOnPolyBoundary(_pathPolyRefs[_polyLength - 1], hitPos, hitPos);
-
-                _pathPoints.resize(2);
-                _pathPoints[0] = GetStartPosition();
-                _pathPoints[1] = G3D::Vector3(hitPos[2], hitPos[0], hitPos[1]);
-
-                NormalizePath();
-                _type = PATHFIND_INCOMPLETE;
-                AddFarFromPolyFlags(startFarFromPoly, false);
-                return;
-            }
-            else
-            {
-                // clamp to poly boundary if we fail to get the height
-                if (dtStatusFailed(_navMeshQuery->getPolyHeight(_pathPolyRefs[_polyLength - 1], endPoint, &endPoint[1])))
-                    _navMeshQuery->closestPointOnPolyBoundary(_pathPolyRefs[_polyLength - 1], endPoint, endPoint);
-
-                _pathPoints.resize(2);
-                _pathPoints[0] = GetStartPosition();
-                _pathPoints[1] = G3D::Vector3(endPoint[2], endPoint[0], endPoint[1]);
-
-                NormalizePath();
-                if (startFarFromPoly || endFarFromPoly)
-                {
-                    _type = PathType(PATHFIND_INCOMPLETE);
+            _type = PathType(PATHFIND_INCOMPLETE);
 
-                    AddFarFromPolyFlags(startFarFromPoly, endFarFromPoly);
-                }
-                else
-                    _type = PATHFIND_NORMAL;
-                return;
-            }
+            AddFarFromPolyFlags(startFarFromPoly, endFarFromPoly);
         }
         else
-        {
-            dtResult = _navMeshQuery->findPath(
-                            startPoly,          // start polygon
-                            endPoly,            // end polygon
-                            startPoint,         // start position
-                            endPoint,           // end position
-                            &_filter,           // polygon search filter
-                            _pathPolyRefs,     // [out] path
-                            (int*)&_polyLength,
-                            MAX_PATH_LENGTH);   // max number of polygons in output path
-        }
-
-        if (!_polyLength || dtStatusFailed(dtResult))
-        {
-            // only happens if we passed bad data to findPath(), or navmesh is messed up
-            TC_LOG_ERROR("maps.mmaps", "{} Path Build failed: 0 length path", _source->GetGUID().ToString());
-            BuildShortcut();
-            _type = PATHFIND_NOPATH;
-            return;
-        }
+            _type = PATHFIND_NORMAL;
     }
-
-    // by now we know what type of path we can get
-    if (_pathPolyRefs[_polyLength - 1] == endPoly && !(_type & PATHFIND_INCOMPLETE))
-        _type = PATHFIND_NORMAL;
-    else
-        _type = PATHFIND_INCOMPLETE;
-
-    AddFarFromPolyFlags(startFarFromPoly, endFarFromPoly);
-
-    // generate the point-path out of our up-to-date poly-path
-    BuildPointPath(startPoint, endPoint);
 }
 
-void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoint)
+void PathGenerator::FinishPolyPath(PathQuery const& query)
 {
-    float pathPoints[MAX_POINT_PATH_LENGTH*VERTEX_SIZE];
-    uint32 pointCount = 0;
-    dtStatus dtResult = DT_FAILURE;
-    if (_useRaycast)
+    ASSERT(query.Result != PathQueryResult::Pending);
+
+    memcpy(_pathPolyRefs, query.PathPolyRefs, query.PolyLength * sizeof(dtPolyRef));
+    _polyLength = query.PolyLength;
+
+    if (query.Result == PathQueryResult::NoNavMesh || query.Result == PathQueryResult::NoPolyPath)
     {
-        // _straightLine uses raycast and it currently doesn't support building a point path, only a 2-point path with start and hitpoint/end is returned
-        TC_LOG_ERROR("maps.mmaps", "PathGenerator::BuildPointPath() called with _useRaycast for unit {}", _source->GetGUID().ToString());
         BuildShortcut();
         _type = PATHFIND_NOPATH;
         return;
     }
-    else if (_useStraightPath)
-    {
-        dtResult = _navMeshQuery->findStraightPath(
-                startPoint,         // start position
-                endPoint,           // end position
-                _pathPolyRefs,     // current path
-                _polyLength,       // lenth of current path
-                pathPoints,         // [out] path corner points
-                nullptr,               // [out] flags
-                nullptr,               // [out] shortened path
-                (int*)&pointCount,
-                _pointPathLimit);   // maximum number of points/polygons to use
-    }
+
+    // by now we know what type of path we can get
+    if (_pathPolyRefs[_polyLength - 1] == query.EndPoly && !(_type & PATHFIND_INCOMPLETE))
+        _type = PATHFIND_NORMAL;
     else
-    {
-        dtResult = FindSmoothPath(
-                startPoint,         // start position
-                endPoint,           // end position
-                _pathPolyRefs,     // current path
-                _polyLength,       // length of current path
-                pathPoints,         // [out] path corner points
-                (int*)&pointCount,
-                _pointPathLimit);    // maximum number of points
-    }
+        _type = PATHFIND_INCOMPLETE;
 
-    // Special case with start and end positions very close to each other
-    if (_polyLength == 1 && pointCount == 1)
-    {
-        // First point is start position, append end position
-        dtVcopy(&pathPoints[1 * VERTEX_SIZE], endPoint);
-        pointCount++;
-    }
-    else if ( pointCount < 2 || dtStatusFailed(dtResult))
+    AddFarFromPolyFlags(query.StartFarFromPoly, query.EndFarFromPoly);
+
+    if (query.Result == PathQueryResult::NoPointPath)
     {
-        // only happens if pass bad data to findStraightPath or navmesh is broken
-        // single point paths can be generated here
-        /// @todo check the exact cases
-        TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::BuildPointPath FAILED! path sized {} returned\n", pointCount);
         BuildShortcut();
         _type = PathType(_type | PATHFIND_NOPATH);
         return;
     }
-    else if (pointCount >= _pointPathLimit)
+
+    if (query.Result == PathQueryResult::PointPathTooLong)
     {
-        TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::BuildPointPath FAILED! path sized {} returned, lower than limit set to {}", pointCount, _pointPathLimit);
         BuildShortcut();
         _type = PathType(_type | PATHFIND_SHORT);
         return;
     }
 
+    uint32 pointCount = query.PointCount;
+    float const* pathPoints = query.PathPoints;
+
     _pathPoints.resize(pointCount);
     for (uint32 i = 0; i < pointCount; ++i)
         _pathPoints[i] = G3D::Vector3(pathPoints[i*VERTEX_SIZE+2], pathPoints[i*VERTEX_SIZE], pathPoints[i*VERTEX_SIZE+1]);
@@ -628,8 +514,7 @@ void PathGenerator::BuildPointPath(const float *startPoint, const float *endPoin
 
 void PathGenerator::NormalizePath()
 {
-    for (uint32 i = 0; i < _pathPoints.size(); ++i)
-        _source->UpdateAllowedPositionZ(_pathPoints[i].x, _pathPoints[i].y, _pathPoints[i].z);
+    _source->UpdateAllowedPositionZ(_pathPoints);
 }
 
 void PathGenerator::BuildShortcut()
@@ -734,7 +619,249 @@ bool PathGenerator::HaveTile(const G3D::Vector3& p) const
     return (_navMesh->getTileAt(tx, ty, 0) != nullptr);
 }
 
-uint32 PathGenerator::FixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPath, dtPolyRef const* visited, uint32 nvisited)
+////////////////// PathQuery //////////////////
+void PathQuery::Execute(dtNavMeshQuery const* navMeshQuery)
+{
+    _navMeshQuery = navMeshQuery;
+
+    if (!_navMeshQuery)
+        Result = PathQueryResult::NoNavMesh;
+    else if (BuildPolyPath())
+        BuildPointPath();
+
+    Done.store(true, std::memory_order_release);
+}
+
+bool PathQuery::BuildPolyPath()
+{
+    // *** poly path generating logic ***
+
+    // start and end are on same polygon
+    // handle this case as if they were 2 different polygons, building a line path split in some few points
+    if (StartPoly == EndPoly)
+    {
+        TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (startPoly == endPoly)");
+
+        PathPolyRefs[0] = StartPoly;
+        PolyLength = 1;
+        return true;
+    }
+
+    // look for startPoly/endPoly in current path
+    /// @todo we can merge it with getPathPolyByPosition() loop
+    bool startPolyFound = false;
+    bool endPolyFound = false;
+    uint32 pathStartIndex = 0;
+    uint32 pathEndIndex = 0;
+
+    if (PolyLength)
+    {
+        for (; pathStartIndex < PolyLength; ++pathStartIndex)
+        {
+            // here to catch few bugs
+            if (PathPolyRefs[pathStartIndex] == INVALID_POLYREF)
+            {
+                TC_LOG_ERROR("maps.mmaps", "Invalid poly ref in BuildPolyPath. _polyLength: {}, pathStartIndex: {},"
+                                     " startPos: {}, endPos: {}, mapid: {}",
+                                     PolyLength, pathStartIndex, G3D::Vector3(StartPoint[2], StartPoint[0], StartPoint[1]).toString(),
+                                     G3D::Vector3(EndPoint[2], EndPoint[0], EndPoint[1]).toString(), MeshMapId);
+
+                break;
+            }
+
+            if (PathPolyRefs[pathStartIndex] == StartPoly)
+            {
+                startPolyFound = true;
+                break;
+            }
+        }
+
+        for (pathEndIndex = PolyLength-1; pathEndIndex > pathStartIndex; --pathEndIndex)
+            if (PathPolyRefs[pathEndIndex] == EndPoly)
+            {
+                endPolyFound = true;
+                break;
+            }
+    }
+
+    if (startPolyFound && endPolyFound)
+    {
+        TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (startPolyFound && endPolyFound)");
+
+        // we moved along the path and the target did not move out of our old poly-path
+        // our path is a simple subpath case, we have all the data we need
+        // just "cut" it out
+
+        PolyLength = pathEndIndex - pathStartIndex + 1;
+        memmove(PathPolyRefs, PathPolyRefs + pathStartIndex, PolyLength * sizeof(dtPolyRef));
+    }
+    else if (startPolyFound && !endPolyFound)
+    {
+        TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (startPolyFound && !endPolyFound)");
+
+        // we are moving on the old path but target moved out
+        // so we have atleast part of poly-path ready
+
+        PolyLength -= pathStartIndex;
+
+        // try to adjust the suffix of the path instead of recalculating entire length
+        // at given interval the target cannot get too far from its last location
+        // thus we have less poly to cover
+        // sub-path of optimal path is optimal
+
+        // take ~80% of the original length
+        /// @todo play with the values here
+        uint32 prefixPolyLength = uint32(PolyLength * 0.8f + 0.5f);
+        memmove(PathPolyRefs, PathPolyRefs+pathStartIndex, prefixPolyLength * sizeof(dtPolyRef));
+
+        dtPolyRef suffixStartPoly = PathPolyRefs[prefixPolyLength-1];
+
+        // we need any point on our suffix start poly to generate poly-path, so we need last poly in prefix data
+        float suffixEndPoint[VERTEX_SIZE];
+        if (dtStatusFailed(_navMeshQuery->closestPointOnPoly(suffixStartPoly, EndPoint, suffixEndPoint, nullptr)))
+        {
+            // we can hit offmesh connection as last poly - closestPointOnPoly() don't like that
+            // try to recover by using prev polyref
+            --prefixPolyLength;
+            suffixStartPoly = PathPolyRefs[prefixPolyLength-1];
+            if (dtStatusFailed(_navMeshQuery->closestPointOnPoly(suffixStartPoly, EndPoint, suffixEndPoint, nullptr)))
+            {
+                // suffixStartPoly is still invalid, error state
+                Result = PathQueryResult::NoPolyPath;
+                return false;
+            }
+        }
+
+        // generate suffix
+        uint32 suffixPolyLength = 0;
+
+        dtStatus dtResult = _navMeshQuery->findPath(
+                            suffixStartPoly,    // start polygon
+                            EndPoly,            // end polygon
+                            suffixEndPoint,     // start position
+                            EndPoint,           // end position
+                            &Filter,            // polygon search filter
+                            PathPolyRefs + prefixPolyLength - 1,    // [out] path
+                            (int*)&suffixPolyLength,
+                            MAX_PATH_LENGTH - prefixPolyLength);   // max number of polygons in output path
+
+        if (!suffixPolyLength || dtStatusFailed(dtResult))
+        {
+            // this is probably an error state, but we'll leave it
+            // and hopefully recover on the next Update
+            // we still need to copy our preffix
+            TC_LOG_ERROR("maps.mmaps", "Path Build failed for {}", Source.ToString());
+        }
+
+        TC_LOG_DEBUG("maps.mmaps", "++  m_polyLength={} prefixPolyLength={} suffixPolyLength={}", PolyLength, prefixPolyLength, suffixPolyLength);
+
+        // new path = prefix + suffix - overlap
+        PolyLength = prefixPolyLength + suffixPolyLength - 1;
+    }
+    else
+    {
+        TC_LOG_DEBUG("maps.mmaps", "++ BuildPolyPath :: (!startPolyFound && !endPolyFound)");
+
+        // either we have no path at all -> first run
+        // or something went really wrong -> we aren't moving along the path to the target
+        // just generate new path
+
+        // free and invalidate old path data
+        PolyLength = 0;
+
+        if (Cache)
+        {
+            PolyLength = Cache->Find(MeshMapId, StartPoly, EndPoly, Filter.getIncludeFlags(), Filter.getExcludeFlags(), PathPolyRefs, MAX_PATH_LENGTH);
+
+            // the path may cross tiles that were unloaded since it was cached
+            dtNavMesh const* navMesh = _navMeshQuery->getAttachedNavMesh();
+            if (!std::all_of(PathPolyRefs, PathPolyRefs + PolyLength, [navMesh](dtPolyRef polyRef) { return navMesh->isValidPolyRef(polyRef); }))
+                PolyLength = 0;
+        }
+
+        if (!PolyLength)
+        {
+            dtStatus dtResult = _navMeshQuery->findPath(
+                                StartPoly,          // start polygon
+                                EndPoly,            // end polygon
+                                StartPoint,         // start position
+                                EndPoint,           // end position
+                                &Filter,            // polygon search filter
+                                PathPolyRefs,       // [out] path
+                                (int*)&PolyLength,
+                                MAX_PATH_LENGTH);   // max number of polygons in output path
+
+            if (!PolyLength || dtStatusFailed(dtResult))
+            {
+                // only happens if we passed bad data to findPath(), or navmesh is messed up
+                TC_LOG_ERROR("maps.mmaps", "{} Path Build failed: 0 length path", Source.ToString());
+                Result = PathQueryResult::NoPolyPath;
+                return false;
+            }
+
+            if (Cache)
+                Cache->Store(MeshMapId, StartPoly, EndPoly, Filter.getIncludeFlags(), Filter.getExcludeFlags(), PathPolyRefs, PolyLength);
+        }
+    }
+
+    return true;
+}
+
+void PathQuery::BuildPointPath()
+{
+    dtStatus dtResult = DT_FAILURE;
+    if (UseStraightPath)
+    {
+        dtResult = _navMeshQuery->findStraightPath(
+                StartPoint,         // start position
+                EndPoint,           // end position
+                PathPolyRefs,       // current path
+                PolyLength,         // lenth of current path
+                PathPoints,         // [out] path corner points
+                nullptr,               // [out] flags
+                nullptr,               // [out] shortened path
+                (int*)&PointCount,
+                PointPathLimit);    // maximum number of points/polygons to use
+    }
+    else
+    {
+        dtResult = FindSmoothPath(
+                StartPoint,         // start position
+                EndPoint,           // end position
+                PathPolyRefs,       // current path
+                PolyLength,         // length of current path
+                PathPoints,         // [out] path corner points
+                (int*)&PointCount,
+                PointPathLimit);    // maximum number of points
+    }
+
+    // Special case with start and end positions very close to each other
+    if (PolyLength == 1 && PointCount == 1)
+    {
+        // First point is start position, append end position
+        dtVcopy(&PathPoints[1 * VERTEX_SIZE], EndPoint);
+        PointCount++;
+    }
+    else if (PointCount < 2 || dtStatusFailed(dtResult))
+    {
+        // only happens if pass bad data to findStraightPath or navmesh is broken
+        // single point paths can be generated here
+        /// @todo check the exact cases
+        TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::BuildPointPath FAILED! path sized {} returned\n", PointCount);
+        Result = PathQueryResult::NoPointPath;
+        return;
+    }
+    else if (PointCount >= PointPathLimit)
+    {
+        TC_LOG_DEBUG("maps.mmaps", "++ PathGenerator::BuildPointPath FAILED! path sized {} returned, lower than limit set to {}", PointCount, PointPathLimit);
+        Result = PathQueryResult::PointPathTooLong;
+        return;
+    }
+
+    Result = PathQueryResult::Success;
+}
+
+uint32 PathQuery::FixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPath, dtPolyRef const* visited, uint32 nvisited)
 {
     int32 furthestPath = -1;
     int32 furthestVisited = -1;
@@ -779,9 +906,9 @@ uint32 PathGenerator::FixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPat
     return req+size;
 }
 
-bool PathGenerator::GetSteerTarget(float const* startPos, float const* endPos,
+bool PathQuery::GetSteerTarget(float const* startPos, float const* endPos,
                               float minTargetDist, dtPolyRef const* path, uint32 pathSize,
-                              float* steerPos, unsigned char& steerPosFlag, dtPolyRef& steerPosRef)
+                              float* steerPos, unsigned char& steerPosFlag, dtPolyRef& steerPosRef) const
 {
     // Find steer target.
     static const uint32 MAX_STEER_POINTS = 3;
@@ -816,9 +943,9 @@ bool PathGenerator::GetSteerTarget(float const* startPos, float const* endPos,
     return true;
 }
 
-dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPos,
+dtStatus PathQuery::FindSmoothPath(float const* startPos, float const* endPos,
                                      dtPolyRef const* polyPath, uint32 polyPathSize,
-                                     float* smoothPath, int* smoothPathSize, uint32 maxSmoothPathSize)
+                                     float* smoothPath, int* smoothPathSize, uint32 maxSmoothPathSize) const
 {
     *smoothPathSize = 0;
     uint32 nsmoothPath = 0;
@@ -882,12 +1009,12 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
         dtPolyRef visited[MAX_VISIT_POLY];
 
         uint32 nvisited = 0;
-        if (dtStatusFailed(_navMeshQuery->moveAlongSurface(polys[0], iterPos, moveTgt, &_filter, result, visited, (int*)&nvisited, MAX_VISIT_POLY)))
+        if (dtStatusFailed(_navMeshQuery->moveAlongSurface(polys[0], iterPos, moveTgt, &Filter, result, visited, (int*)&nvisited, MAX_VISIT_POLY)))
             return DT_FAILURE;
         npolys = FixupCorridor(polys, npolys, MAX_PATH_LENGTH, visited, nvisited);
 
         if (dtStatusFailed(_navMeshQuery->getPolyHeight(polys[0], result, &result[1])))
-            TC_LOG_DEBUG("maps.mmaps", "Cannot find height at position X: {} Y: {} Z: {} for {}", result[2], result[0], result[1], _source->GetDebugInfo());
+            TC_LOG_DEBUG("maps.mmaps", "Cannot find height at position X: {} Y: {} Z: {} for {}", result[2], result[0], result[1], Source.ToString());
         result[1] += 0.5f;
         dtVcopy(iterPos, result);
 
@@ -923,7 +1050,7 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
 
             // Handle the connection.
             float connectionStartPos[VERTEX_SIZE], connectionEndPos[VERTEX_SIZE];
-            if (dtStatusSucceed(_navMesh->getOffMeshConnectionPolyEndPoints(prevRef, polyRef, connectionStartPos, connectionEndPos)))
+            if (dtStatusSucceed(_navMeshQuery->getAttachedNavMesh()->getOffMeshConnectionPolyEndPoints(prevRef, polyRef, connectionStartPos, connectionEndPos)))
             {
                 if (nsmoothPath < maxSmoothPathSize)
                 {
@@ -952,7 +1079,7 @@ dtStatus PathGenerator::FindSmoothPath(float const* startPos, float const* endPo
     return nsmoothPath < MAX_POINT_PATH_LENGTH ? DT_SUCCESS : DT_FAILURE;
 }
 
-bool PathGenerator::InRangeYZX(float const* v1, float const* v2, float r, float h) const
+bool PathQuery::InRangeYZX(float const* v1, float const* v2, float r, float h)
 {
     const float dx = v2[0] - v1[0];
     const float dy = v2[1] - v1[1]; // elevation
@@ -22,8 +22,12 @@
 #include "DetourNavMeshQuery.h"
 #include "MMapDefines.h"
 #include "MoveSplineInitArgs.h"
+#include "ObjectGuid.h"
 #include <G3D/Vector3.h>
+#include <atomic>
+#include <memory>
 
+class PathCache;
 class WorldObject;
 
 // 74*4.0f=296y number_of_points*interval = max_path_len
@@ -52,6 +56,61 @@ enum PathType
     PATHFIND_FARFROMPOLY       = PATHFIND_FARFROMPOLY_START | PATHFIND_FARFROMPOLY_END, // start or end positions are far from the mmap poligon
 };
 
+enum class PathQueryResult : uint8
+{
+    Pending,
+    NoNavMesh,          // the nav mesh was unloaded before the query ran
+    NoPolyPath,         // no poly path between start and end polygon
+    NoPointPath,        // the point path could not be built from the poly path
+    PointPathTooLong,   // the point path is longer than the path length limit
+    Success
+};
+
+// Detour part of a path calculation, between finding the start and end polygons and normalizing the point path
+// it only reads the nav mesh, which allows running it outside of the map update
+struct PathQuery
+{
+    void Execute(dtNavMeshQuery const* navMeshQuery);
+
+    uint32 MeshMapId = 0;
+    ObjectGuid Source;          // for log messages only
+    dtQueryFilter Filter;
+    dtPolyRef StartPoly = INVALID_POLYREF;
+    dtPolyRef EndPoly = INVALID_POLYREF;
+    float StartPoint[VERTEX_SIZE] = { };
+    float EndPoint[VERTEX_SIZE] = { };
+    bool StartFarFromPoly = false;
+    bool EndFarFromPoly = false;
+    bool UseStraightPath = false;
+    uint32 PointPathLimit = MAX_POINT_PATH_LENGTH;
+    std::shared_ptr<PathCache> Cache;   // poly paths of the map, can be null
+
+    // in: poly path of the previous calculation, reused when the start polygon is still on it, out: the new poly path
+    dtPolyRef PathPolyRefs[MAX_PATH_LENGTH] = { };
+    uint32 PolyLength = 0;
+
+    PathQueryResult Result = PathQueryResult::Pending;
+    float PathPoints[MAX_POINT_PATH_LENGTH * VERTEX_SIZE];
+    uint32 PointCount = 0;
+
+    std::atomic<bool> Done = false;     // set by the thread executing the query after all results are written
+
+private:
+    bool BuildPolyPath();
+    void BuildPointPath();
+
+    // smooth path aux functions
+    static uint32 FixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPath, dtPolyRef const* visited, uint32 nvisited);
+    bool GetSteerTarget(float const* startPos, float const* endPos, float minTargetDist, dtPolyRef const* path, uint32 pathSize, float* steerPos,
+                        unsigned char& steerPosFlag, dtPolyRef& steerPosRef) const;
+    dtStatus FindSmoothPath(float const* startPos, float const* endPos,
+                          dtPolyRef const* polyPath, uint32 polyPathSize,
+                          float* smoothPath, int* smoothPathSize, uint32 maxSmoothPathSize) const;
+    static bool InRangeYZX(float const* v1, float const* v2, float r, float h);
+
+    dtNavMeshQuery const* _navMeshQuery = nullptr;
+};
+
 class TC_GAME_API PathGenerator
 {
     public:
@@ -69,6 +128,14 @@ class TC_GAME_API PathGenerator
         bool CalculatePath(float destX, float destY, float destZ, bool forceDest = false);
         bool IsInvalidDestinationZ(WorldObject const* target) const;
 
+        // same as CalculatePath, but the detour queries run on the pathfinding worker threads of MapManager
+        // when the path is not finished right away IsPathPending() returns true until UpdatePendingPath() picked up the result
+        // falls back to CalculatePath if there are no pathfinding worker threads
+        bool CalculatePathAsync(float destX, float destY, float destZ, bool forceDest = false);
+        bool IsPathPending() const { return _pendingQuery != nullptr; }
+        // return: true once the pending path is finished and can be used
+        bool UpdatePendingPath();
+
         // option setters - use optional
         void SetUseStraightPath(bool useStraightPath) { _useStraightPath = useStraightPath; }
         void SetPathLengthLimit(float distance) { _pointPathLimit = std::min<uint32>(uint32(distance/SMOOTH_PATH_STEP_SIZE), MAX_POINT_PATH_LENGTH); }
@@ -106,10 +173,13 @@ class TC_GAME_API PathGenerator
 
         WorldObject const* const _source;       // the object that is moving
         dtNavMesh const* _navMesh;              // the nav mesh
-        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path
+        dtNavMeshQuery const* _navMeshQuery;    // the nav mesh query used to find the path, only set while a path is calculated
 
         dtQueryFilter _filter;  // use single filter for all movements, update it when needed
 
+        uint32 _meshMapId;                          // map id of the nav mesh
+        std::shared_ptr<PathQuery> _pendingQuery;   // query running on a pathfinding worker
+
         void SetStartPosition(G3D::Vector3 const& point) { _startPosition = point; }
         void SetEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; _endPosition = point; }
         void SetActualEndPosition(G3D::Vector3 const& point) { _actualEndPosition = point; }
@@ -123,28 +193,23 @@ class TC_GAME_API PathGenerator
 
         bool InRange(G3D::Vector3 const& p1, G3D::Vector3 const& p2, float r, float h) const;
         float Dist3DSqr(G3D::Vector3 const& p1, G3D::Vector3 const& p2) const;
-        bool InRangeYZX(float const* v1, float const* v2, float r, float h) const;
 
         dtPolyRef GetPathPolyByPosition(dtPolyRef const* polyPath, uint32 polyPathSize, float const* Point, float* Distance = nullptr) const;
         dtPolyRef GetPolyByLocation(float const* Point, float* Distance) const;
         bool HaveTile(G3D::Vector3 const& p) const;
 
-        void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos);
-        void BuildPointPath(float const* startPoint, float const* endPoint);
+        bool BuildPath(float srcX, float srcY, float srcZ, float destX, float destY, float destZ, bool forceDest, bool async);
+        void BuildPolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos, bool async);
+        // finds start and end polygons, returns false when the path is already finished and the query does not need to run
+        bool PreparePolyPath(G3D::Vector3 const& startPos, G3D::Vector3 const& endPos, PathQuery& query);
+        void BuildRaycastPath(dtPolyRef startPoly, float const* startPoint, float* endPoint, bool startFarFromPoly, bool endFarFromPoly);
+        void FinishPolyPath(PathQuery const& query);
         void BuildShortcut();
 
         NavTerrainFlag GetNavTerrain(float x, float y, float z) const;
         void CreateFilter();
         void UpdateFilter();
 
-        // smooth path aux functions
-        uint32 FixupCorridor(dtPolyRef* path, uint32 npath, uint32 maxPath, dtPolyRef const* visited, uint32 nvisited);
-        bool GetSteerTarget(float const* startPos, float const* endPos, float minTargetDist, dtPolyRef const* path, uint32 pathSize, float* steerPos,
-                            unsigned char& steerPosFlag, dtPolyRef& steerPosRef);
-        dtStatus FindSmoothPath(float const* startPos, float const* endPos,
-                              dtPolyRef const* polyPath, uint32 polyPathSize,
-                              float* smoothPath, int* smoothPathSize, uint32 maxSmoothPathSize);
-
         void AddFarFromPolyFlags(bool startFarFromPoly, bool endFarFromPoly);
 };
 
@@ -0,0 +1,66 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RepathThrottle.h"
+#include <algorithm>
+
+void RepathThrottle::Reset()
+{
+    _pathTargetPosition.reset();
+    _lastTargetPosition.reset();
+    _velocityX = _velocityY = _velocityZ = 0.0f;
+    _repathDelay = 0;
+}
+
+void RepathThrottle::Update(Position const& targetPosition, uint32 diff)
+{
+    _repathDelay -= std::min(_repathDelay, diff);
+
+    if (!diff)
+        return;
+
+    if (_lastTargetPosition)
+    {
+        _velocityX = (targetPosition.GetPositionX() - _lastTargetPosition->GetPositionX()) / diff;
+        _velocityY = (targetPosition.GetPositionY() - _lastTargetPosition->GetPositionY()) / diff;
+        _velocityZ = (targetPosition.GetPositionZ() - _lastTargetPosition->GetPositionZ()) / diff;
+    }
+
+    _lastTargetPosition = targetPosition;
+}
+
+bool RepathThrottle::CanKeepPath(Position const& targetPosition, float tolerance, uint32 lookahead) const
+{
+    if (!_pathTargetPosition)
+        return false;
+
+    // the target left the corridor or is about to, only the repath delay can keep the current path
+    Position predicted(targetPosition.GetPositionX() + _velocityX * lookahead,
+        targetPosition.GetPositionY() + _velocityY * lookahead,
+        targetPosition.GetPositionZ() + _velocityZ * lookahead);
+    float const toleranceSq = tolerance * tolerance;
+    if (_pathTargetPosition->GetExactDistSq(targetPosition) > toleranceSq || _pathTargetPosition->GetExactDistSq(predicted) > toleranceSq)
+        return _repathDelay != 0;
+
+    return true;
+}
+
+void RepathThrottle::OnPathCalculated(Position const& targetPosition, uint32 delay)
+{
+    _pathTargetPosition = targetPosition;
+    _repathDelay = delay;
+}
@@ -0,0 +1,54 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_REPATH_THROTTLE_H
+#define TRINITY_REPATH_THROTTLE_H
+
+#include "Define.h"
+#include "Optional.h"
+#include "Position.h"
+
+// decides whether a follower moving along a path has to recalculate it after its target moved
+// the path is kept while the target, and its position extrapolated from its recent velocity, stay within
+// tolerance of where the target was when the path was calculated
+// once the target leaves that corridor the next path is still delayed until the repath delay passed
+class TC_GAME_API RepathThrottle
+{
+public:
+    // forgets the current path and the observed target movement
+    void Reset();
+
+    // called every update with the current target position
+    void Update(Position const& targetPosition, uint32 diff);
+
+    // tolerance: distance the target may move away from the path end before a new path is needed
+    // lookahead: time (ms) the target position is extrapolated ahead
+    bool CanKeepPath(Position const& targetPosition, float tolerance, uint32 lookahead) const;
+
+    // delay: minimum time (ms) before the next path may be calculated
+    void OnPathCalculated(Position const& targetPosition, uint32 delay);
+
+private:
+    Optional<Position> _pathTargetPosition;
+    Optional<Position> _lastTargetPosition;
+    float _velocityX = 0.0f;                // target velocity in yards per ms
+    float _velocityY = 0.0f;
+    float _velocityZ = 0.0f;
+    uint32 _repathDelay = 0;
+};
+
+#endif
@@ -19,6 +19,7 @@
 #include "Log.h"
 #include "Creature.h"
 #include "DB2Stores.h"
+#include "MovementPackets.h"
 
 #include <sstream>
 
@@ -135,12 +136,15 @@ enum{
 
 struct CommonInitializer
 {
-    CommonInitializer(float _velocity) : velocityInv(1000.f/_velocity), time(minimal_duration) { }
+    CommonInitializer(float _velocity, std::span<float const> _knownLengths = {}, int32 _firstKnown = 0) : velocityInv(1000.f/_velocity), time(minimal_duration),
+        knownLengths(_knownLengths), firstKnown(_firstKnown) { }
     float velocityInv;
     int32 time;
+    std::span<float const> knownLengths;
+    int32 firstKnown;
     inline int32 operator()(Spline<int32>& s, int32 i)
     {
-        time += (s.SegLength(i) * velocityInv);
+        time += ((!knownLengths.empty() && i >= firstKnown ? knownLengths[i - firstKnown] : s.SegLength(i)) * velocityInv);
         return time;
     }
 };
@@ -166,7 +170,12 @@ void MoveSpline::init_spline(MoveSplineInitArgs const& args)
     }
     else
     {
-        CommonInitializer init(args.velocity);
+        // lengths of segments touching the first two control points can never be known in advance
+        std::span<float const> knownLengths = args.knownSegmentLengths;
+        if (!args.flags.isSmooth() || spline.isCyclic() || int32(knownLengths.size()) > spline.last() - spline.first() - 2)
+            knownLengths = {};
+
+        CommonInitializer init(args.velocity, knownLengths, spline.last() - int32(knownLengths.size()));
         spline.initLengths(init);
     }
 
@@ -195,6 +204,7 @@ void MoveSpline::Initialize(MoveSplineInitArgs const& args)
     splineIsFacingOnly = args.path.size() == 2 && args.facing.type != MONSTER_MOVE_NORMAL && ((args.path[1] - args.path[0]).length() < 0.1f);
 
     velocity = args.velocity;
+    createObjectBlock.clear();
 
     // Check if its a stop spline
     if (args.flags.Done)
@@ -371,6 +381,8 @@ MoveSpline::UpdateResult MoveSpline::_updateState(int32& ms_time_diff)
                         if (args.Validate(nullptr))
                             init_spline(args);
                     }
+
+                    WorldPackets::Movement::CommonMovement::CacheCreateObjectSplineDataBlock(*this);
                 }
             }
             else
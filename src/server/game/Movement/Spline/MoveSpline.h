@@ -21,6 +21,7 @@
 #include "Spline.h"
 #include "MoveSplineInitArgs.h"
 #include <G3D/Vector3.h>
+#include <vector>
 
 enum class AnimTier : uint8;
 
@@ -85,6 +86,8 @@ namespace Movement
         float           velocity;
         Optional<SpellEffectExtraData> spell_effect_extra;
         Optional<AnimTierTransition> anim_tier;
+        // create object block serialized at launch, only the elapsed time is patched when it is sent
+        std::vector<uint8> createObjectBlock;
 
         void init_spline(MoveSplineInitArgs const& args);
 
@@ -95,6 +98,15 @@ namespace Movement
         void computeFallElevation(int32 time_point, float& el) const;
 
         UpdateResult _updateState(int32& ms_time_diff);
+        // most updates end inside the current segment, they only move time forward and produce no event
+        bool _advanceInSegment(int32 ms_time_diff)
+        {
+            if (Finalized() || time_passed + ms_time_diff >= next_timestamp())
+                return false;
+
+            time_passed += ms_time_diff;
+            return true;
+        }
         int32 next_timestamp() const { return spline.length(point_Idx + 1); }
         int32 segment_time_elapsed() const { return next_timestamp() - time_passed; }
 
@@ -118,6 +130,12 @@ namespace Movement
         void updateState(int32 difftime, UpdateHandler& handler)
         {
             ASSERT(Initialized());
+            if (_advanceInSegment(difftime))
+            {
+                handler(Result_None);
+                return;
+            }
+
             do
                 handler(_updateState(difftime));
             while (difftime > 0);
@@ -126,6 +144,9 @@ namespace Movement
         void updateState(int32 difftime)
         {
             ASSERT(Initialized());
+            if (_advanceInSegment(difftime))
+                return;
+
             do _updateState(difftime);
             while (difftime > 0);
         }
@@ -133,6 +133,7 @@ namespace Movement
 
         unit->m_movementInfo.SetMovementFlags(moveFlags);
         move_spline.Initialize(args);
+        WorldPackets::Movement::CommonMovement::CacheCreateObjectSplineDataBlock(move_spline);
 
         WorldPackets::Movement::MonsterMove packet;
         packet.MoverGUID = unit->GetGUID();
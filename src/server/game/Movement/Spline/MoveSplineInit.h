@@ -108,6 +108,11 @@ namespace Movement
          */
         void SetFirstPointId(int32 pointId) { args.path_Idx_offset = pointId; }
 
+        /* Skips evaluating the lengths of the last segments of a smooth path
+         * the lengths must have been calculated with the same control points, see WaypointPath::BuildSegments
+         */
+        void SetKnownSegmentLengths(std::span<float const> lengths) { args.knownSegmentLengths = lengths; }
+
         /* Enables CatmullRom spline interpolation mode(makes path smooth)
          * if not enabled linear spline mode will be choosen. Disabled by default
          */
@@ -23,6 +23,7 @@
 #include "MovementTypedefs.h"
 #include "ObjectGuid.h"
 #include "Optional.h"
+#include <span>
 
 class Unit;
 
@@ -79,6 +80,7 @@ namespace Movement
         float initialOrientation;
         Optional<SpellEffectExtraData> spellEffectExtra;
         Optional<AnimTierTransition> animTier;
+        std::span<float const> knownSegmentLengths; // lengths of the last segments of a smooth path, computed by the caller from the same control points
         bool walk;
         bool HasVelocity;
         bool TransformForTransport;
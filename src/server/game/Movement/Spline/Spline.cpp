@@ -21,30 +21,6 @@
 
 namespace Movement{
 
-SplineBase::EvaluationMethtod SplineBase::evaluators[SplineBase::ModesEnd] =
-{
-    &SplineBase::EvaluateLinear,
-    &SplineBase::EvaluateCatmullRom,
-    &SplineBase::EvaluateBezier3,
-    &SplineBase::UninitializedSplineEvaluationMethod,
-};
-
-SplineBase::EvaluationMethtod SplineBase::derivative_evaluators[SplineBase::ModesEnd] =
-{
-    &SplineBase::EvaluateDerivativeLinear,
-    &SplineBase::EvaluateDerivativeCatmullRom,
-    &SplineBase::EvaluateDerivativeBezier3,
-    &SplineBase::UninitializedSplineEvaluationMethod,
-};
-
-SplineBase::SegLenghtMethtod SplineBase::seglengths[SplineBase::ModesEnd] =
-{
-    &SplineBase::SegLengthLinear,
-    &SplineBase::SegLengthCatmullRom,
-    &SplineBase::SegLengthBezier3,
-    &SplineBase::UninitializedSplineSegLenghtMethod,
-};
-
 SplineBase::InitMethtod SplineBase::initializers[SplineBase::ModesEnd] =
 {
     //&SplineBase::InitLinear,
@@ -111,12 +87,6 @@ inline void C_Evaluate_Derivative(Vector3 const* vertice, float t, Matrix4 const
            + vertice[2] * weights[2] + vertice[3] * weights[3];
 }
 
-void SplineBase::EvaluateLinear(index_type index, float u, Vector3& result) const
-{
-    ASSERT(index >= index_lo && index < index_hi);
-    result = points[index] + (points[index+1] - points[index]) * u;
-}
-
 void SplineBase::EvaluateCatmullRom( index_type index, float t, Vector3& result) const
 {
     ASSERT(index >= index_lo && index < index_hi);
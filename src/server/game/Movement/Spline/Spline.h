@@ -58,22 +58,23 @@ protected:
     index_type stepsPerSegment = 3;
 
 protected:
-    void EvaluateLinear(index_type, float, Vector3&) const;
+    // evaluation runs for every moving unit on every update, modes are dispatched with a switch instead of member function pointers
+    // so the linear case, by far the most common one, can be inlined
+    void EvaluateLinear(index_type index, float u, Vector3& result) const
+    {
+        ASSERT(index >= index_lo && index < index_hi);
+        result = points[index] + (points[index + 1] - points[index]) * u;
+    }
     void EvaluateCatmullRom(index_type, float, Vector3&) const;
     void EvaluateBezier3(index_type, float, Vector3&) const;
-    typedef void (SplineBase::*EvaluationMethtod)(index_type, float, Vector3&) const;
-    static EvaluationMethtod evaluators[ModesEnd];
 
     void EvaluateDerivativeLinear(index_type, float, Vector3&) const;
     void EvaluateDerivativeCatmullRom(index_type, float, Vector3&) const;
     void EvaluateDerivativeBezier3(index_type, float, Vector3&) const;
-    static EvaluationMethtod derivative_evaluators[ModesEnd];
 
     float SegLengthLinear(index_type) const;
     float SegLengthCatmullRom(index_type) const;
     float SegLengthBezier3(index_type) const;
-    typedef float (SplineBase::*SegLenghtMethtod)(index_type) const;
-    static SegLenghtMethtod seglengths[ModesEnd];
 
     void InitLinear(Vector3 const*, index_type, index_type);
     void InitCatmullRom(Vector3 const*, index_type, index_type);
@@ -98,13 +99,31 @@ public:
         @param t - percent of segment length, assumes that t in range [0, 1]
         @param Idx - spline segment index, should be in range [first, last)
      */
-    void evaluate_percent(index_type Idx, float u, Vector3& c) const {(this->*evaluators[m_mode])(Idx, u, c);}
+    void evaluate_percent(index_type Idx, float u, Vector3& c) const
+    {
+        switch (m_mode)
+        {
+            case ModeLinear: EvaluateLinear(Idx, u, c); break;
+            case ModeCatmullrom: EvaluateCatmullRom(Idx, u, c); break;
+            case ModeBezier3_Unused: EvaluateBezier3(Idx, u, c); break;
+            default: UninitializedSplineEvaluationMethod(Idx, u, c); break;
+        }
+    }
 
     /** Caclulates derivation in index Idx, and percent of segment length t
         @param Idx - spline segment index, should be in range [first, last)
         @param t  - percent of spline segment length, assumes that t in range [0, 1]
      */
-    void evaluate_derivative(index_type Idx, float u, Vector3& hermite) const {(this->*derivative_evaluators[m_mode])(Idx, u, hermite);}
+    void evaluate_derivative(index_type Idx, float u, Vector3& hermite) const
+    {
+        switch (m_mode)
+        {
+            case ModeLinear: EvaluateDerivativeLinear(Idx, u, hermite); break;
+            case ModeCatmullrom: EvaluateDerivativeCatmullRom(Idx, u, hermite); break;
+            case ModeBezier3_Unused: EvaluateDerivativeBezier3(Idx, u, hermite); break;
+            default: UninitializedSplineEvaluationMethod(Idx, u, hermite); break;
+        }
+    }
 
     /**  Bounds for spline indexes. All indexes should be in range [first, last). */
     index_type first() const { return index_lo;}
@@ -133,7 +152,16 @@ public:
     virtual void clear();
 
     /** Calculates distance between [i; i+1] points, assumes that index i is in bounds. */
-    float SegLength(index_type i) const { return (this->*seglengths[m_mode])(i);}
+    float SegLength(index_type i) const
+    {
+        switch (m_mode)
+        {
+            case ModeLinear: return SegLengthLinear(i);
+            case ModeCatmullrom: return SegLengthCatmullRom(i);
+            case ModeBezier3_Unused: return SegLengthBezier3(i);
+            default: return UninitializedSplineSegLenghtMethod(i);
+        }
+    }
 
     void set_steps_per_segment(index_type newStepsPerSegment) { stepsPerSegment = newStepsPerSegment; }
 
@@ -22,6 +22,7 @@
 #include "Duration.h"
 #include "EnumFlag.h"
 #include "Optional.h"
+#include <G3D/Vector3.h>
 #include <vector>
 
 static inline constexpr std::size_t WAYPOINT_PATH_FLAG_FOLLOW_PATH_BACKWARDS_MINIMUM_NODES = 2;
@@ -83,6 +84,11 @@ struct WaypointPath
 
     std::vector<WaypointNode> Nodes;
     std::vector<std::pair<std::size_t, std::size_t>> ContinuousSegments;
+    // node positions and smooth (catmull-rom) spline segment lengths, shared by all creatures moving along exact spline paths
+    // lengths are only known for segments whose neighbouring control points are all nodes of the same continuous segment
+    std::vector<G3D::Vector3> Points;
+    std::vector<float> ForwardSegmentLengths;                       // [k]: node k to node k + 1
+    std::vector<float> BackwardSegmentLengths;                      // [Nodes.size() - 1 - k]: node k to node k - 1
     uint32 Id = 0;
     WaypointMoveType MoveType = WaypointMoveType::Walk;
     EnumFlag<WaypointPathFlags> Flags = WaypointPathFlags::None;
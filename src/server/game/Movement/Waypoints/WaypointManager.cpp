@@ -22,8 +22,10 @@
 #include "MapUtils.h"
 #include "ObjectAccessor.h"
 #include "Optional.h"
+#include "Spline.h"
 #include "TemporarySummon.h"
 #include "Unit.h"
+#include <algorithm>
 
 void WaypointMgr::LoadPaths()
 {
@@ -346,4 +348,29 @@ void WaypointPath::BuildSegments()
         if (i + 1 != Nodes.size() && Nodes[i].Delay)
             ContinuousSegments.emplace_back(i, 1);
     }
+
+    Points.resize(Nodes.size());
+    std::ranges::transform(Nodes, Points.begin(), [](WaypointNode const& node) { return G3D::Vector3(node.X, node.Y, node.Z); });
+
+    // evaluate the same splines MoveSpline builds when launched along a segment (in both directions)
+    // segments of a launched spline that start at its first or second control point depend on the creature's position and are left out
+    ForwardSegmentLengths.assign(Nodes.size(), 0.0f);
+    BackwardSegmentLengths.assign(Nodes.size(), 0.0f);
+    Movement::Spline<int32> spline;
+    std::vector<G3D::Vector3> reversed;
+    for (auto [first, count] : ContinuousSegments)
+    {
+        if (count < 3)
+            continue;
+
+        std::size_t const last = first + count - 1;
+        spline.init_spline(&Points[first], count, Movement::SplineBase::ModeCatmullrom);
+        for (std::size_t k = first + 1; k < last; ++k)
+            ForwardSegmentLengths[k] = spline.SegLength(k - first + 1);
+
+        reversed.assign(std::make_reverse_iterator(Points.begin() + last + 1), std::make_reverse_iterator(Points.begin() + first));
+        spline.init_spline(reversed.data(), count, Movement::SplineBase::ModeCatmullrom);
+        for (std::size_t k = first + 1; k < last; ++k)
+            BackwardSegmentLengths[Nodes.size() - 1 - k] = spline.SegLength(last - k + 1);
+    }
 }
@@ -18,6 +18,15 @@
 #include "PhaseShift.h"
 #include "Containers.h"
 
+namespace
+{
+uint64 GetPhaseMaskBit(uint32 phaseId)
+{
+    // fibonacci hashing, top 6 bits of the product pick the bit so neighbouring phase ids spread out
+    return UI64LIT(1) << ((phaseId * 0x9E3779B1u) >> 26);
+}
+}
+
 PhaseShift::PhaseShift() = default;
 PhaseShift::PhaseShift(PhaseShift const& right) = default;
 PhaseShift::PhaseShift(PhaseShift&& right)  noexcept = default;
@@ -32,6 +41,9 @@ bool PhaseShift::AddPhase(uint32 phaseId, PhaseFlags flags, std::vector<Conditio
     if (areaConditions)
         insertResult.first->AreaConditions = areaConditions;
 
+    if (insertResult.second)
+        UpdatePhaseMasks();
+
     return insertResult.second;
 }
 
@@ -42,7 +54,11 @@ PhaseShift::EraseResult<PhaseShift::PhaseContainer> PhaseShift::RemovePhase(uint
     {
         ModifyPhasesReferences(itr, -1);
         if (!itr->References)
-            return { Phases.erase(itr), true };
+        {
+            itr = Phases.erase(itr);
+            UpdatePhaseMasks();
+            return { itr, true };
+        }
         return { itr, false };
     }
     return { Phases.end(), false };
@@ -103,6 +119,7 @@ void PhaseShift::ClearPhases()
     PersonalReferences = 0;
     DefaultReferences = 0;
     UpdateUnphasedFlag();
+    UpdatePhaseMasks();
 }
 
 bool PhaseShift::CanSee(PhaseShift const& other) const
@@ -118,10 +135,19 @@ bool PhaseShift::CanSee(PhaseShift const& other) const
     if (Flags.HasFlag(PhaseShiftFlags::NoCosmetic) && other.Flags.HasFlag(PhaseShiftFlags::NoCosmetic))
         excludePhasesWithFlag = PhaseFlags::Cosmetic;
 
+    int32 maskIndex = excludePhasesWithFlag == PhaseFlags::Cosmetic ? PHASE_MASK_EXCLUDE_COSMETIC : 0;
+
     if (!Flags.HasFlag(PhaseShiftFlags::Inverse) && !other.Flags.HasFlag(PhaseShiftFlags::Inverse))
     {
         ObjectGuid ownerGuid = PersonalGuid;
         ObjectGuid otherPersonalGuid = other.PersonalGuid;
+        if (ownerGuid != otherPersonalGuid)
+            maskIndex |= PHASE_MASK_EXCLUDE_PERSONAL;
+
+        // only flags of our own phases are checked below
+        if (!(PhaseMasks[maskIndex] & other.PhaseMasks[0]))
+            return false;
+
         return Trinity::Containers::Intersects(Phases.begin(), Phases.end(), other.Phases.begin(), other.Phases.end(),
             [&ownerGuid, &otherPersonalGuid, excludePhasesWithFlag](PhaseRef const& myPhase, PhaseRef const& /*otherPhase*/)
         {
@@ -129,11 +155,14 @@ bool PhaseShift::CanSee(PhaseShift const& other) const
         });
     }
 
-    auto checkInversePhaseShift = [excludePhasesWithFlag](PhaseShift const& phaseShift, PhaseShift const& excludedPhaseShift)
+    auto checkInversePhaseShift = [excludePhasesWithFlag, maskIndex](PhaseShift const& phaseShift, PhaseShift const& excludedPhaseShift)
     {
         if (phaseShift.Flags.HasFlag(PhaseShiftFlags::Unphased) && excludedPhaseShift.Flags.HasFlag(PhaseShiftFlags::InverseUnphased))
             return false;
 
+        if (!(phaseShift.PhaseMasks[maskIndex] & excludedPhaseShift.PhaseMasks[maskIndex]))
+            return true;
+
         for (PhaseRef const& phase : phaseShift.Phases)
         {
             if (phase.Flags.HasFlag(excludePhasesWithFlag))
@@ -188,6 +217,24 @@ void PhaseShift::UpdateUnphasedFlag()
         Flags |= unphasedFlag;
 }
 
+void PhaseShift::UpdatePhaseMasks()
+{
+    PhaseMasks = { };
+    for (PhaseRef const& phase : Phases)
+    {
+        uint64 bit = GetPhaseMaskBit(phase.Id);
+        for (int32 i = 0; i < MAX_PHASE_MASKS; ++i)
+        {
+            if ((i & PHASE_MASK_EXCLUDE_COSMETIC) && phase.Flags.HasFlag(PhaseFlags::Cosmetic))
+                continue;
+            if ((i & PHASE_MASK_EXCLUDE_PERSONAL) && phase.Flags.HasFlag(PhaseFlags::Personal))
+                continue;
+
+            PhaseMasks[i] |= bit;
+        }
+    }
+}
+
 void PhaseShift::UpdatePersonalGuid()
 {
     if (!PersonalReferences)
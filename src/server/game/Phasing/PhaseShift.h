@@ -22,6 +22,7 @@
 #include "EnumFlag.h"
 #include "FlatSet.h"
 #include "ObjectGuid.h"
+#include <array>
 #include <map>
 
 class PhasingHandler;
@@ -129,11 +130,24 @@ protected:
     void ModifyPhasesReferences(PhaseContainer::iterator itr, int32 references);
     void UpdateUnphasedFlag();
     void UpdatePersonalGuid();
+    void UpdatePhaseMasks();
     int32 NonCosmeticReferences = 0;
     int32 CosmeticReferences = 0;
     int32 PersonalReferences = 0;
     int32 DefaultReferences = 0;
     bool IsDbPhaseShift = false;
+
+    // 64 bit signatures of Phases (every phase id sets one hashed bit), rebuilt whenever Phases changes
+    // no common bit means no common phase, CanSee only compares the containers when signatures intersect
+    enum PhaseMaskIndex
+    {
+        PHASE_MASK_EXCLUDE_COSMETIC = 0x1,
+        PHASE_MASK_EXCLUDE_PERSONAL = 0x2,
+
+        MAX_PHASE_MASKS             = 0x4
+    };
+
+    std::array<uint64, MAX_PHASE_MASKS> PhaseMasks = { };
 };
 
 #endif // PhaseShift_h__
@@ -390,6 +390,8 @@ bool PhasingHandler::OnConditionChange(WorldObject* object, bool updateVisibilit
             ++itr;
     }
 
+    phaseShift.UpdatePhaseMasks();
+
     for (auto itr = suppressedPhaseShift.Phases.begin(); itr != suppressedPhaseShift.Phases.end();)
     {
         if (!DisableMgr::IsDisabledFor(DISABLE_TYPE_PHASE_AREA, itr->Id, object) && sConditionMgr->IsObjectMeetToConditions(srcInfo, *ASSERT_NOTNULL(itr->AreaConditions)))
@@ -402,6 +404,8 @@ bool PhasingHandler::OnConditionChange(WorldObject* object, bool updateVisibilit
             ++itr;
     }
 
+    suppressedPhaseShift.UpdatePhaseMasks();
+
     for (auto itr = phaseShift.VisibleMapIds.begin(); itr != phaseShift.VisibleMapIds.end();)
     {
         if (!sConditionMgr->IsObjectMeetingNotGroupedConditions(CONDITION_SOURCE_TYPE_TERRAIN_SWAP, itr->first, srcInfo))
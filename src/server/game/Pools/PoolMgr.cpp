@@ -160,11 +160,28 @@ template <class T>
 void PoolGroup<T>::AddEntry(PoolObject& poolitem, uint32 maxentries)
 {
     if (poolitem.chance != 0 && maxentries == 1)
+    {
         ExplicitlyChanced.push_back(poolitem);
+        ExplicitlyChancedRollLimits.push_back((ExplicitlyChancedRollLimits.empty() ? 0.0f : ExplicitlyChancedRollLimits.back()) + poolitem.chance);
+    }
     else
         EqualChanced.push_back(poolitem);
 }
 
+template <class T>
+void PoolGroup<T>::UpdateExplicitlyChancedRollLimits()
+{
+    ExplicitlyChancedRollLimits.clear();
+    ExplicitlyChancedRollLimits.reserve(ExplicitlyChanced.size());
+
+    float limit = 0.0f;
+    for (PoolObject const& obj : ExplicitlyChanced)
+    {
+        limit += obj.chance;
+        ExplicitlyChancedRollLimits.push_back(limit);
+    }
+}
+
 // Method to check the chances are proper in this object pool
 template <class T>
 bool PoolGroup<T>::CheckPool() const
@@ -186,6 +203,17 @@ bool PoolGroup<T>::CheckPool() const
 template<class T>
 void PoolGroup<T>::DespawnObject(SpawnedPoolData& spawns, uint64 guid, bool alwaysDeleteRespawnTime)
 {
+    // a single member only needs its own state checked, respawn times of the others are left alone in that case
+    if (guid && !alwaysDeleteRespawnTime)
+    {
+        if (spawns.IsSpawnedObject<T>(guid) && sPoolMgr->IsPartOfAPool<T>(guid) == poolId)
+        {
+            Despawn1Object(spawns, guid);
+            spawns.RemoveSpawn<T>(guid, poolId);
+        }
+        return;
+    }
+
     for (size_t i=0; i < EqualChanced.size(); ++i)
     {
         // if spawned
@@ -272,6 +300,7 @@ void PoolGroup<Pool>::RemoveOneRelation(uint32 child_pool_id)
         if (itr->guid == child_pool_id)
         {
             ExplicitlyChanced.erase(itr);
+            UpdateExplicitlyChancedRollLimits();
             break;
         }
     }
@@ -285,6 +314,53 @@ void PoolGroup<Pool>::RemoveOneRelation(uint32 child_pool_id)
     }
 }
 
+// Triggering object is marked as spawned at this time and can be also rolled (respawn case)
+template <class T>
+bool PoolGroup<T>::IsSpawnable(SpawnedPoolData const& spawns, PoolObject const& obj, uint64 triggerFrom) const
+{
+    return obj.guid == triggerFrom || !spawns.IsSpawnedObject<T>(obj.guid);
+}
+
+// Rolled object is the first spawnable one at or after the rolled position
+template <class T>
+PoolObject const* PoolGroup<T>::RollExplicitlyChanced(SpawnedPoolData const& spawns, uint64 triggerFrom) const
+{
+    float roll = rand_chance();
+
+    auto itr = std::upper_bound(ExplicitlyChancedRollLimits.begin(), ExplicitlyChancedRollLimits.end(), roll);
+    for (std::size_t i = std::distance(ExplicitlyChancedRollLimits.begin(), itr); i < ExplicitlyChanced.size(); ++i)
+        if (IsSpawnable(spawns, ExplicitlyChanced[i], triggerFrom))
+            return &ExplicitlyChanced[i];
+
+    return nullptr;
+}
+
+template <class T>
+void PoolGroup<T>::RollEqualChanced(SpawnedPoolData const& spawns, uint32 count, uint64 triggerFrom, PoolObjectList& rolledObjects) const
+{
+    // large pools usually only replace the object that triggered the respawn, a few random picks find a free one
+    // without filtering the whole list
+    if (count == 1)
+    {
+        for (uint32 attempt = 0; attempt < 3; ++attempt)
+        {
+            PoolObject const& obj = Trinity::Containers::SelectRandomContainerElement(EqualChanced);
+            if (IsSpawnable(spawns, obj, triggerFrom))
+            {
+                rolledObjects.push_back(obj);
+                return;
+            }
+        }
+    }
+
+    std::copy_if(EqualChanced.begin(), EqualChanced.end(), std::back_inserter(rolledObjects), [&](PoolObject const& obj)
+    {
+        return IsSpawnable(spawns, obj, triggerFrom);
+    });
+
+    Trinity::Containers::RandomResize(rolledObjects, count);
+}
+
 template <class T>
 void PoolGroup<T>::SpawnObject(SpawnedPoolData& spawns, uint32 limit, uint64 triggerFrom)
 {
@@ -303,31 +379,11 @@ void PoolGroup<T>::SpawnObject(SpawnedPoolData& spawns, uint32 limit, uint64 tri
 
         // roll objects to be spawned
         if (!ExplicitlyChanced.empty())
-        {
-            float roll = rand_chance();
-
-            for (PoolObject& obj : ExplicitlyChanced)
-            {
-                roll -= obj.chance;
-                // Triggering object is marked as spawned at this time and can be also rolled (respawn case)
-                // so this need explicit check for this case
-                if (roll < 0 && (obj.guid == triggerFrom || !spawns.IsSpawnedObject<T>(obj.guid)))
-                {
-                    rolledObjects.push_back(obj);
-                    break;
-                }
-            }
-        }
+            if (PoolObject const* obj = RollExplicitlyChanced(spawns, triggerFrom))
+                rolledObjects.push_back(*obj);
 
         if (!EqualChanced.empty() && rolledObjects.empty())
-        {
-            std::copy_if(EqualChanced.begin(), EqualChanced.end(), std::back_inserter(rolledObjects), [triggerFrom, &spawns](PoolObject const& object)
-            {
-                return object.guid == triggerFrom || !spawns.IsSpawnedObject<T>(object.guid);
-            });
-
-            Trinity::Containers::RandomResize(rolledObjects, count);
-        }
+            RollEqualChanced(spawns, count, triggerFrom, rolledObjects);
 
         // try to spawn rolled objects
         for (PoolObject& obj : rolledObjects)
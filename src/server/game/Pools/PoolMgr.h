@@ -20,10 +20,9 @@
 
 #include "Define.h"
 #include "SpawnData.h"
-#include <map>
 #include <memory>
-#include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class Creature;
@@ -48,8 +47,8 @@ class Pool                                                  // for Pool of Pool
 {
 };
 
-typedef std::set<uint64> SpawnedPoolObjects;
-typedef std::map<uint64, uint32> SpawnedPoolPools;
+typedef std::unordered_set<uint64> SpawnedPoolObjects;
+typedef std::unordered_map<uint64, uint32> SpawnedPoolPools;
 
 class TC_GAME_API SpawnedPoolData
 {
@@ -111,9 +110,15 @@ class TC_GAME_API PoolGroup
         void RemoveOneRelation(uint32 child_pool_id);
         uint32 GetPoolId() const { return poolId; }
     private:
+        bool IsSpawnable(SpawnedPoolData const& spawns, PoolObject const& obj, uint64 triggerFrom) const;
+        PoolObject const* RollExplicitlyChanced(SpawnedPoolData const& spawns, uint64 triggerFrom) const;
+        void RollEqualChanced(SpawnedPoolData const& spawns, uint32 count, uint64 triggerFrom, PoolObjectList& rolledObjects) const;
+        void UpdateExplicitlyChancedRollLimits();
+
         uint32 poolId;
         PoolObjectList ExplicitlyChanced;
         PoolObjectList EqualChanced;
+        std::vector<float> ExplicitlyChancedRollLimits;     // running sum of ExplicitlyChanced chances
 };
 
 class TC_GAME_API PoolMgr
@@ -164,7 +169,7 @@ class TC_GAME_API PoolMgr
         typedef std::unordered_map<uint32, PoolGroup<GameObject>> PoolGroupGameObjectMap;
         typedef std::unordered_map<uint32, PoolGroup<Pool>>       PoolGroupPoolMap;
         typedef std::pair<uint64, uint32> SearchPair;
-        typedef std::map<uint64, uint32> SearchMap;
+        typedef std::unordered_map<uint64, uint32> SearchMap;
 
         PoolTemplateDataMap    mPoolTemplate;
         PoolGroupCreatureMap   mPoolCreatureGroups;
@@ -35,6 +35,7 @@
 #include "Log.h"
 #include "Map.h"
 #include "MapManager.h"
+#include "Metric.h"
 #include "ObjectMgr.h"
 #include "OutdoorPvPMgr.h"
 #include "Player.h"
@@ -49,6 +50,7 @@
 #include "Vehicle.h"
 #include "Weather.h"
 #include "WorldPacket.h"
+#include <array>
 #include <unordered_map>
 
 // Trait which indicates whether this script type
@@ -307,6 +309,41 @@ private:
 
 #define sScriptRegistryCompositum ScriptRegistryCompositum::Instance()
 
+// Hooks called at high rates (per damage and heal event or per player action), dispatched only
+// to scripts that override them - see ScriptObject::MarkHookNotOverridden
+enum class ScriptHook : uint32
+{
+    UnitOnHeal,
+    UnitOnDamage,
+    UnitModifyPeriodicDamageAurasTick,
+    UnitModifyMeleeDamage,
+    UnitModifySpellDamageTaken,
+    PlayerOnChat,
+    PlayerOnChatWhisper,
+    PlayerOnChatGroup,
+    PlayerOnChatGuild,
+    PlayerOnChatChannel,
+    PlayerOnUpdateZone,
+    Max
+};
+
+constexpr std::array<char const*, size_t(ScriptHook::Max)> ScriptHookNames =
+{
+    "UnitScript::OnHeal",
+    "UnitScript::OnDamage",
+    "UnitScript::ModifyPeriodicDamageAurasTick",
+    "UnitScript::ModifyMeleeDamage",
+    "UnitScript::ModifySpellDamageTaken",
+    "PlayerScript::OnChat",
+    "PlayerScript::OnChat(whisper)",
+    "PlayerScript::OnChat(group)",
+    "PlayerScript::OnChat(guild)",
+    "PlayerScript::OnChat(channel)",
+    "PlayerScript::OnUpdateZone"
+};
+
+static std::array<std::atomic<uint64>, size_t(ScriptHook::Max)> ScriptHookCalls = { };
+
 template<typename /*ScriptType*/, bool /*IsDatabaseBound*/>
 class SpecializedScriptRegistry;
 
@@ -393,13 +430,13 @@ class CreatureGameObjectAreaTriggerScriptRegistrySwapHooks
         AIFunctionMapWorker(T&& worker)
             : _worker(std::forward<T>(worker)) { }
 
-        void Visit(std::unordered_map<ObjectGuid, ObjectType*>& objects)
+        void Visit(Trinity::Containers::FlatHashMap<ObjectGuid, ObjectType*>& objects)
         {
             _worker(objects);
         }
 
         template<typename O>
-        void Visit(std::unordered_map<ObjectGuid, O*>&) { }
+        void Visit(Trinity::Containers::FlatHashMap<ObjectGuid, O*>&) { }
 
     private:
         W _worker;
@@ -562,7 +599,7 @@ class CreatureGameObjectAreaTriggerScriptRegistrySwapHooks
     {
         return [&idsToRemove](Map* map, auto&& visitor)
         {
-            auto evaluator = [&](std::unordered_map<ObjectGuid, ObjectType*>& objects)
+            auto evaluator = [&](Trinity::Containers::FlatHashMap<ObjectGuid, ObjectType*>& objects)
             {
                 for (auto object : objects)
                 {
@@ -585,7 +622,7 @@ class CreatureGameObjectAreaTriggerScriptRegistrySwapHooks
     {
         return [](Map* map, auto&& visitor)
         {
-            auto evaluator = [&](std::unordered_map<ObjectGuid, ObjectType*>& objects)
+            auto evaluator = [&](Trinity::Containers::FlatHashMap<ObjectGuid, ObjectType*>& objects)
             {
                 for (auto object : objects)
                 {
@@ -1130,6 +1167,7 @@ public:
         this->BeforeReleaseContext(context);
 
         _scripts.erase(context);
+        _hooksWithoutOverrides = 0;
     }
 
     void SwapContext(bool initialize) final override
@@ -1148,6 +1186,7 @@ public:
         this->BeforeUnload();
 
         _scripts.clear();
+        _hooksWithoutOverrides = 0;
     }
 
     void SyncScriptNames() final override
@@ -1176,6 +1215,7 @@ public:
 
         // We're dealing with a code-only script, just add it.
         _scripts.insert(std::make_pair(sScriptMgr->GetCurrentScriptContext(), std::move(script_ptr)));
+        _hooksWithoutOverrides = 0;
     }
 
     ScriptStoreType& GetScripts()
@@ -1183,8 +1223,36 @@ public:
         return _scripts;
     }
 
+    // Calls the hook on every script that overrides it, hooks no registered script overrides cost a single check
+    template<typename Call>
+    void CallOverriddenHook(ScriptHook hook, Call&& call)
+    {
+        ScriptHookCalls[size_t(hook)].fetch_add(1, std::memory_order_relaxed);
+
+        uint64 hookMask = UI64LIT(1) << uint32(hook);
+        if (_hooksWithoutOverrides.load(std::memory_order_relaxed) & hookMask)
+            return;
+
+        bool anyOverride = false;
+        for (auto const& [context, script] : _scripts)
+        {
+            if (!script->IsHookOverridden(uint32(hook)))
+                continue;
+
+            call(script.get());
+            // the base implementation marks the script while being called
+            anyOverride = anyOverride || script->IsHookOverridden(uint32(hook));
+        }
+
+        if (!anyOverride)
+            _hooksWithoutOverrides.fetch_or(hookMask, std::memory_order_relaxed);
+    }
+
 private:
     ScriptStoreType _scripts;
+
+    // Hooks known to be overridden by none of the registered scripts, reset whenever scripts are added or removed
+    std::atomic<uint64> _hooksWithoutOverrides = 0;
 };
 
 // Utility macros to refer to the script registry.
@@ -1220,7 +1288,7 @@ private:
     if (!V) \
         return R;
 
-ScriptObject::ScriptObject(char const* name) : _name(name)
+ScriptObject::ScriptObject(char const* name) : _name(name), _hooksNotOverridden(0)
 {
     sScriptMgr->IncreaseScriptCount();
 }
@@ -1492,6 +1560,13 @@ void ScriptMgr::OnWorldUpdate(uint32 diff)
     FOREACH_SCRIPT(WorldScript)->OnUpdate(diff);
 }
 
+void ScriptMgr::ReportHookMetrics()
+{
+    for (size_t i = 0; i < ScriptHookCalls.size(); ++i)
+        if (uint64 calls = ScriptHookCalls[i].exchange(0, std::memory_order_relaxed))
+            TC_METRIC_VALUE("script_hook_calls", calls, TC_METRIC_TAG("hook", ScriptHookNames[i]));
+}
+
 void ScriptMgr::OnHonorCalculation(float& honor, uint8 level, float multiplier)
 {
     FOREACH_SCRIPT(FormulaScript)->OnHonorCalculation(honor, level, multiplier);
@@ -2036,27 +2111,27 @@ void ScriptMgr::OnPlayerDuelEnd(Player* winner, Player* loser, DuelCompleteType
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg);
+    ScriptRegistry<PlayerScript>::Instance()->CallOverriddenHook(ScriptHook::PlayerOnChat, [&](PlayerScript* script) { script->OnChat(player, type, lang, msg); });
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Player* receiver)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, receiver);
+    ScriptRegistry<PlayerScript>::Instance()->CallOverriddenHook(ScriptHook::PlayerOnChatWhisper, [&](PlayerScript* script) { script->OnChat(player, type, lang, msg, receiver); });
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Group* group)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, group);
+    ScriptRegistry<PlayerScript>::Instance()->CallOverriddenHook(ScriptHook::PlayerOnChatGroup, [&](PlayerScript* script) { script->OnChat(player, type, lang, msg, group); });
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Guild* guild)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, guild);
+    ScriptRegistry<PlayerScript>::Instance()->CallOverriddenHook(ScriptHook::PlayerOnChatGuild, [&](PlayerScript* script) { script->OnChat(player, type, lang, msg, guild); });
 }
 
 void ScriptMgr::OnPlayerChat(Player* player, uint32 type, uint32 lang, std::string& msg, Channel* channel)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnChat(player, type, lang, msg, channel);
+    ScriptRegistry<PlayerScript>::Instance()->CallOverriddenHook(ScriptHook::PlayerOnChatChannel, [&](PlayerScript* script) { script->OnChat(player, type, lang, msg, channel); });
 }
 
 void ScriptMgr::OnPlayerClearEmote(Player* player)
@@ -2111,7 +2186,7 @@ void ScriptMgr::OnPlayerBindToInstance(Player* player, Difficulty difficulty, ui
 
 void ScriptMgr::OnPlayerUpdateZone(Player* player, uint32 newZone, uint32 newArea)
 {
-    FOREACH_SCRIPT(PlayerScript)->OnUpdateZone(player, newZone, newArea);
+    ScriptRegistry<PlayerScript>::Instance()->CallOverriddenHook(ScriptHook::PlayerOnUpdateZone, [&](PlayerScript* script) { script->OnUpdateZone(player, newZone, newArea); });
 }
 
 void ScriptMgr::OnQuestStatusChange(Player* player, uint32 questId)
@@ -2256,27 +2331,27 @@ void ScriptMgr::OnGroupDisband(Group* group)
 // Unit
 void ScriptMgr::OnHeal(Unit* healer, Unit* reciever, uint32& gain)
 {
-    FOREACH_SCRIPT(UnitScript)->OnHeal(healer, reciever, gain);
+    ScriptRegistry<UnitScript>::Instance()->CallOverriddenHook(ScriptHook::UnitOnHeal, [&](UnitScript* script) { script->OnHeal(healer, reciever, gain); });
 }
 
 void ScriptMgr::OnDamage(Unit* attacker, Unit* victim, uint32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->OnDamage(attacker, victim, damage);
+    ScriptRegistry<UnitScript>::Instance()->CallOverriddenHook(ScriptHook::UnitOnDamage, [&](UnitScript* script) { script->OnDamage(attacker, victim, damage); });
 }
 
 void ScriptMgr::ModifyPeriodicDamageAurasTick(Unit* target, Unit* attacker, uint32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->ModifyPeriodicDamageAurasTick(target, attacker, damage);
+    ScriptRegistry<UnitScript>::Instance()->CallOverriddenHook(ScriptHook::UnitModifyPeriodicDamageAurasTick, [&](UnitScript* script) { script->ModifyPeriodicDamageAurasTick(target, attacker, damage); });
 }
 
 void ScriptMgr::ModifyMeleeDamage(Unit* target, Unit* attacker, uint32& damage)
 {
-    FOREACH_SCRIPT(UnitScript)->ModifyMeleeDamage(target, attacker, damage);
+    ScriptRegistry<UnitScript>::Instance()->CallOverriddenHook(ScriptHook::UnitModifyMeleeDamage, [&](UnitScript* script) { script->ModifyMeleeDamage(target, attacker, damage); });
 }
 
 void ScriptMgr::ModifySpellDamageTaken(Unit* target, Unit* attacker, int32& damage, SpellInfo const* spellInfo)
 {
-    FOREACH_SCRIPT(UnitScript)->ModifySpellDamageTaken(target, attacker, damage, spellInfo);
+    ScriptRegistry<UnitScript>::Instance()->CallOverriddenHook(ScriptHook::UnitModifySpellDamageTaken, [&](UnitScript* script) { script->ModifySpellDamageTaken(target, attacker, damage, spellInfo); });
 }
 
 // Conversation
@@ -2655,22 +2730,27 @@ UnitScript::~UnitScript() = default;
 
 void UnitScript::OnHeal(Unit* /*healer*/, Unit* /*reciever*/, uint32& /*gain*/)
 {
+    MarkHookNotOverridden(uint32(ScriptHook::UnitOnHeal));
 }
 
 void UnitScript::OnDamage(Unit* /*attacker*/, Unit* /*victim*/, uint32& /*damage*/)
 {
+    MarkHookNotOverridden(uint32(ScriptHook::UnitOnDamage));
 }
 
 void UnitScript::ModifyPeriodicDamageAurasTick(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/)
 {
+    MarkHookNotOverridden(uint32(ScriptHook::UnitModifyPeriodicDamageAurasTick));
 }
 
 void UnitScript::ModifyMeleeDamage(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/)
 {
+    MarkHookNotOverridden(uint32(ScriptHook::UnitModifyMeleeDamage));
 }
 
 void UnitScript::ModifySpellDamageTaken(Unit* /*target*/, Unit* /*attacker*/, int32& /*damage*/, SpellInfo const* /*spellInfo*/)
 {
+    MarkHookNotOverridden(uint32(ScriptHook::UnitModifySpellDamageTaken));
 }
 
 CreatureScript::CreatureScript(char const* name)
@@ -2955,22 +3035,27 @@ void PlayerScript::OnDuelEnd(Player* /*winner*/, Player* /*loser*/, DuelComplete
 
 void PlayerScript::OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/)
 {
+    MarkHookNotOverridden(uint32(ScriptHook::PlayerOnChat));
 }
 
 void PlayerScript::OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Player* /*receiver*/)
 {
+    MarkHookNotOverridden(uint32(ScriptHook::PlayerOnChatWhisper));
 }
 
 void PlayerScript::OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Group* /*group*/)
 {
+    MarkHookNotOverridden(uint32(ScriptHook::PlayerOnChatGroup));
 }
 
 void PlayerScript::OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Guild* /*guild*/)
 {
+    MarkHookNotOverridden(uint32(ScriptHook::PlayerOnChatGuild));
 }
 
 void PlayerScript::OnChat(Player* /*player*/, uint32 /*type*/, uint32 /*lang*/, std::string& /*msg*/, Channel* /*channel*/)
 {
+    MarkHookNotOverridden(uint32(ScriptHook::PlayerOnChatChannel));
 }
 
 void PlayerScript::OnClearEmote(Player* /*player*/)
@@ -3015,6 +3100,7 @@ void PlayerScript::OnBindToInstance(Player* /*player*/, Difficulty /*difficulty*
 
 void PlayerScript::OnUpdateZone(Player* /*player*/, uint32 /*newZone*/, uint32 /*newArea*/)
 {
+    MarkHookNotOverridden(uint32(ScriptHook::PlayerOnUpdateZone));
 }
 
 void PlayerScript::OnMapChanged(Player* /*player*/)
@@ -23,6 +23,7 @@
 #include "Tuples.h"
 #include "Types.h"
 #include <boost/preprocessor/punctuation/remove_parens.hpp>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -186,14 +187,22 @@ class TC_GAME_API ScriptObject
 
         std::string const& GetName() const;
 
+        // false once the base implementation of the hook was reached for this script
+        bool IsHookOverridden(uint32 hook) const { return !(_hooksNotOverridden.load(std::memory_order_relaxed) & (UI64LIT(1) << hook)); }
+
     protected:
 
         ScriptObject(char const* name);
         virtual ~ScriptObject();
 
+        // Called by base hook implementations, the script is skipped by later calls of that hook
+        // Overrides of these hooks must not call the base implementation
+        void MarkHookNotOverridden(uint32 hook) { _hooksNotOverridden.fetch_or(UI64LIT(1) << hook, std::memory_order_relaxed); }
+
     private:
 
         std::string const _name;
+        std::atomic<uint64> _hooksNotOverridden;
 };
 
 class TC_GAME_API SpellScriptLoader : public ScriptObject
@@ -1022,6 +1031,9 @@ class TC_GAME_API ScriptMgr
 
         uint32 GetScriptCount() const { return _scriptCount; }
 
+        /// Reports and resets the call counters of the hooks dispatched only to overriding scripts
+        void ReportHookMetrics();
+
         typedef void(*ScriptLoaderCallbackType)();
 
         /// Sets the script loader callback which is invoked to load scripts
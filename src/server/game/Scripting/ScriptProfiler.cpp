@@ -0,0 +1,168 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ScriptProfiler.h"
+#include "Metric.h"
+#include "World.h"
+#include <chrono>
+
+char const* GetScriptProfileHookName(ScriptProfileHook hook)
+{
+    switch (hook)
+    {
+        case ScriptProfileHook::UnitAI: return "UnitAI";
+        case ScriptProfileHook::GameObjectAI: return "GameObjectAI";
+        case ScriptProfileHook::Instance: return "Instance";
+        case ScriptProfileHook::SpellScript: return "SpellScript";
+        case ScriptProfileHook::AuraScript: return "AuraScript";
+        default:
+            break;
+    }
+    return "Unknown";
+}
+
+ScriptProfiler* ScriptProfiler::instance()
+{
+    static ScriptProfiler instance;
+    return &instance;
+}
+
+struct ScriptProfiler::ActiveCall
+{
+    ScriptStats* Stats;     // nullptr when the call is not measured
+    uint32 Weight;
+    std::chrono::steady_clock::time_point Start;
+};
+
+std::vector<ScriptProfiler::ActiveCall>& ScriptProfiler::GetActiveCalls()
+{
+    thread_local std::vector<ActiveCall> activeCalls;
+    return activeCalls;
+}
+
+bool ScriptProfiler::IsEnabled()
+{
+    return sWorld->getIntConfig(CONFIG_SCRIPT_PROFILER_SAMPLE_RATE) != 0;
+}
+
+bool ScriptProfiler::ShouldSampleCall()
+{
+    thread_local uint32 callsUntilSample = 0;
+    if (callsUntilSample--)
+        return false;
+
+    callsUntilSample = sWorld->getIntConfig(CONFIG_SCRIPT_PROFILER_SAMPLE_RATE) - 1;
+    return true;
+}
+
+void ScriptProfiler::BeginSampledCall(ScriptProfileHook hook, uint32 mapId, std::string_view name)
+{
+    ScriptProfiler* profiler = instance();
+    ScriptStats* stats;
+    {
+        std::lock_guard<std::mutex> lock(profiler->_lock);
+        auto itr = profiler->_stats.find(name);
+        if (itr == profiler->_stats.end())
+            itr = profiler->_stats.emplace(std::string(name), std::map<std::pair<uint32, ScriptProfileHook>, ScriptStats>()).first;
+
+        stats = &itr->second[{ mapId, hook }];
+    }
+
+    GetActiveCalls().push_back({ stats, std::max<uint32>(sWorld->getIntConfig(CONFIG_SCRIPT_PROFILER_SAMPLE_RATE), 1), std::chrono::steady_clock::now() });
+}
+
+void ScriptProfiler::BeginUnsampledCall()
+{
+    GetActiveCalls().push_back({ nullptr, 0, { } });
+}
+
+void ScriptProfiler::EndCall()
+{
+    std::vector<ActiveCall>& activeCalls = GetActiveCalls();
+    if (activeCalls.empty())
+        return;
+
+    ActiveCall call = activeCalls.back();
+    activeCalls.pop_back();
+    if (!call.Stats)
+        return;
+
+    uint32 elapsed = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - call.Start).count());
+
+    std::lock_guard<std::mutex> lock(instance()->_lock);
+    call.Stats->Calls += call.Weight;
+    call.Stats->Time += uint64(elapsed) * call.Weight;
+    call.Stats->Latency.Add(elapsed);
+}
+
+std::vector<ScriptProfiler::Summary> ScriptProfiler::GetSummaries() const
+{
+    std::vector<Summary> summaries;
+
+    std::lock_guard<std::mutex> lock(_lock);
+    for (auto const& [name, scriptStats] : _stats)
+    {
+        for (auto const& [key, stats] : scriptStats)
+        {
+            if (!stats.Calls)
+                continue;
+
+            Summary& summary = summaries.emplace_back();
+            summary.Name = name;
+            summary.MapId = key.first;
+            summary.Hook = key.second;
+            summary.Calls = stats.Calls;
+            summary.Time = stats.Time;
+            summary.Latency = stats.Latency;
+        }
+    }
+
+    return summaries;
+}
+
+void ScriptProfiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(_lock);
+    for (auto& [name, scriptStats] : _stats)
+        for (auto& [key, stats] : scriptStats)
+            stats = ScriptStats();
+}
+
+void ScriptProfiler::Update(uint32 diff)
+{
+    _exportTimer += diff;
+    if (_exportTimer < ExportInterval)
+        return;
+
+    _exportTimer = 0;
+    if (!sMetric->IsEnabled() || !IsEnabled())
+        return;
+
+    // everything is cumulative since the last Reset (.debug scripts reset)
+    for (Summary const& summary : GetSummaries())
+    {
+        std::string mapId = std::to_string(summary.MapId);
+        TC_METRIC_VALUE("script_calls", summary.Calls,
+            TC_METRIC_TAG("script", summary.Name),
+            TC_METRIC_TAG("map_id", mapId),
+            TC_METRIC_TAG("hook", GetScriptProfileHookName(summary.Hook)));
+        TC_METRIC_VALUE("script_time", summary.Time,
+            TC_METRIC_TAG("script", summary.Name),
+            TC_METRIC_TAG("map_id", mapId),
+            TC_METRIC_TAG("hook", GetScriptProfileHookName(summary.Hook)));
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_SCRIPT_PROFILER_H
+#define TRINITY_SCRIPT_PROFILER_H
+
+#include "Common.h"
+#include "MetricHistogram.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+enum class ScriptProfileHook : uint8
+{
+    UnitAI,         // UnitAI::UpdateAI of creatures and charmed players
+    GameObjectAI,   // GameObjectAI::UpdateAI
+    Instance,       // InstanceScript::Update
+    SpellScript,    // every SpellScript hook call
+    AuraScript,     // every AuraScript hook call
+
+    Max
+};
+
+TC_GAME_API char const* GetScriptProfileHookName(ScriptProfileHook hook);
+
+// CPU time of script calls per script name, hook and map id, to find the content scripts that cost the most
+// Only every Metric.ScriptProfiler.SampleRate-th call of a thread is measured and weighted with the sample rate,
+// calls and total times are estimates. Times include nested script calls (spells cast from UpdateAI)
+class TC_GAME_API ScriptProfiler
+{
+    struct ScriptStats
+    {
+        uint64 Calls = 0;
+        uint64 Time = 0;                // microseconds
+        MetricHistogram Latency;        // microseconds, sampled calls only
+    };
+
+public:
+    struct Summary
+    {
+        std::string Name;
+        uint32 MapId;
+        ScriptProfileHook Hook;
+        uint64 Calls;
+        uint64 Time;
+        MetricHistogram Latency;
+    };
+
+    // measures a single script call when it is sampled, the name is only built for sampled calls
+    class ScopedCall
+    {
+    public:
+        template <typename NameProvider>
+        ScopedCall(ScriptProfileHook hook, uint32 mapId, NameProvider&& nameProvider) : _active(IsEnabled())
+        {
+            if (_active)
+                BeginCall(hook, mapId, std::forward<NameProvider>(nameProvider));
+        }
+
+        ~ScopedCall()
+        {
+            if (_active)
+                EndCall();
+        }
+
+        ScopedCall(ScopedCall const&) = delete;
+        ScopedCall& operator=(ScopedCall const&) = delete;
+
+    private:
+        bool _active;
+    };
+
+    static ScriptProfiler* instance();
+
+    static bool IsEnabled();
+
+    // every BeginCall must be followed by EndCall on the same thread, calls nest
+    template <typename NameProvider>
+    static void BeginCall(ScriptProfileHook hook, uint32 mapId, NameProvider&& nameProvider)
+    {
+        if (ShouldSampleCall())
+            BeginSampledCall(hook, mapId, nameProvider());
+        else
+            BeginUnsampledCall();
+    }
+
+    static void EndCall();
+
+    // snapshot of every script sampled since the last Reset
+    std::vector<Summary> GetSummaries() const;
+    void Reset();
+
+    // called from World::Update, sends the collected values to Metric every ExportInterval
+    void Update(uint32 diff);
+
+private:
+    ScriptProfiler() = default;
+    ~ScriptProfiler() = default;
+
+    struct ActiveCall;
+    static std::vector<ActiveCall>& GetActiveCalls();
+
+    static bool ShouldSampleCall();
+    static void BeginSampledCall(ScriptProfileHook hook, uint32 mapId, std::string_view name);
+    static void BeginUnsampledCall();
+
+    static constexpr uint32 ExportInterval = 10 * IN_MILLISECONDS;
+
+    // stats are never erased so running calls can keep pointers to them
+    mutable std::mutex _lock;
+    std::map<std::string, std::map<std::pair<uint32, ScriptProfileHook>, ScriptStats>, std::less<>> _stats;
+    uint32 _exportTimer = 0;
+};
+
+#define sScriptProfiler ScriptProfiler::instance()
+
+#endif // TRINITY_SCRIPT_PROFILER_H
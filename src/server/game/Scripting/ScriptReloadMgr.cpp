@@ -454,6 +454,9 @@ class HotSwapScriptReloadMgr final
         BuildJobType type_;
         // The async process result of the current job
         std::shared_ptr<Trinity::AsyncProcessResult> async_result_;
+        // Is true when an associated source was changed while the job was running,
+        // the result is dropped and the module is built again afterwards
+        bool terminate_early_;
 
     public:
         explicit BuildJob(std::string script_module_name, std::string script_module_project_name,
@@ -461,7 +464,8 @@ class HotSwapScriptReloadMgr final
             : script_module_name_(std::move(script_module_name)),
               script_module_project_name_(std::move(script_module_project_name)),
               script_module_build_directive_(std::move(script_module_build_directive)),
-              start_time_(getMSTime()), type_(BuildJobType::BUILD_JOB_NONE) { }
+              start_time_(getMSTime()), type_(BuildJobType::BUILD_JOB_NONE),
+              terminate_early_(false) { }
 
         bool IsValid() const
         {
@@ -478,6 +482,10 @@ class HotSwapScriptReloadMgr final
 
         BuildJobType GetType() const { return type_; }
 
+        bool IsTerminatedEarly() const { return terminate_early_; }
+
+        void SetTerminatedEarly() { terminate_early_ = true; }
+
         std::shared_ptr<Trinity::AsyncProcessResult> const& GetProcess() const
         {
             ASSERT(async_result_, "Tried to access an empty process handle!");
@@ -538,7 +546,7 @@ public:
     HotSwapScriptReloadMgr()
         : _libraryWatcher(-1), _unique_library_name_counter(0),
           _last_time_library_changed(0), _last_time_sources_changed(0),
-          _last_time_user_informed(0), terminate_early(false) { }
+          _last_time_user_informed(0) { }
 
     virtual ~HotSwapScriptReloadMgr()
     {
@@ -652,12 +660,11 @@ public:
             _libraryWatcher = -1;
         }
 
-        // If a build is in progress cancel it
-        if (_build_job)
-        {
-            _build_job->GetProcess()->Terminate();
-            _build_job.reset();
-        }
+        // If builds are in progress cancel them
+        for (BuildJob& job : _build_jobs)
+            job.GetProcess()->Terminate();
+
+        _build_jobs.clear();
 
         // Release all strong references to script modules
         // to trigger unload actions as early as possible,
@@ -996,46 +1003,41 @@ private:
     }
 
     /// Called periodically on the worldserver tick to process all recompile
-    /// requests. This method invokes one build or install job at the time
+    /// requests. This method runs build and install jobs of up to
+    /// HotSwap.ReCompilerParallelModules modules at the same time,
+    /// a rerun of CMake has the build directory for itself.
     void DispatchRunningBuildJobs()
     {
-        if (_build_job)
+        // Terminate the build jobs when an associated source was changed
+        // while compiling and the terminate early option is enabled.
+        if (sWorld->getBoolConfig(CONFIG_HOTSWAP_EARLY_TERMINATION_ENABLED))
         {
-            // Terminate the current build job when an associated source was changed
-            // while compiling and the terminate early option is enabled.
-            if (sWorld->getBoolConfig(CONFIG_HOTSWAP_EARLY_TERMINATION_ENABLED))
+            for (BuildJob& job : _build_jobs)
             {
-                if (!terminate_early && _sources_changed.find(_build_job->GetModuleName()) != _sources_changed.end())
+                if (!job.IsTerminatedEarly() && _sources_changed.find(job.GetModuleName()) != _sources_changed.end())
                 {
                     /*
                     FIXME: Currently crashes the server
                     TC_LOG_INFO("scripts.hotswap", "Terminating the running build of module \"{}\"...",
-                                _build_job->GetModuleName());
-
-                    _build_job->GetProcess()->Terminate();
-                    _build_job.reset();
+                                job.GetModuleName());
 
-                    // Continue with the default execution path
-                    DispatchRunningBuildJobs();
-                    return;
+                    job.GetProcess()->Terminate();
                     */
 
-                    terminate_early = true;
-                    return;
+                    job.SetTerminatedEarly();
                 }
             }
+        }
 
-            // Wait for the current build job to finish, if the job finishes in time
-            // evaluate it and continue with the next one.
-            if (_build_job->GetProcess()->GetFutureResult().
-                    wait_for(0s) == std::future_status::ready)
-                ProcessReadyBuildJob();
+        // Evaluate the jobs which finished in the meantime,
+        // jobs which continued with their next step are kept.
+        for (auto itr = _build_jobs.begin(); itr != _build_jobs.end();)
+        {
+            if (itr->GetProcess()->GetFutureResult().wait_for(0s) == std::future_status::ready
+                && ProcessReadyBuildJob(*itr))
+                itr = _build_jobs.erase(itr);
             else
-                return; // Return when the job didn't finish in time
-
-            // Skip this cycle when the previous job scheduled a new one
-            if (_build_job)
-                return;
+                ++itr;
         }
 
         // Avoid burst updates through waiting for a short time after changes
@@ -1063,14 +1065,42 @@ private:
             return;
         }
 
-        // Find all source files of a changed script module and removes
-        // it from the changed source list, invoke the build afterwards.
-        bool rebuild_buildfiles;
-        auto module_name = [&]
+        std::size_t const max_parallel_modules =
+            std::size_t(std::max(sConfigMgr->GetIntDefault("HotSwap.ReCompilerParallelModules", 2), 1));
+
+        while (_build_jobs.size() < max_parallel_modules)
         {
-            auto itr = _sources_changed.begin();
-            auto name = itr->first;
-            rebuild_buildfiles = !itr->second.empty();
+            // Don't start builds while CMake recreates the build files
+            if (std::any_of(_build_jobs.begin(), _build_jobs.end(), [](BuildJob const& job)
+                {
+                    return job.GetType() == BuildJobType::BUILD_JOB_RERUN_CMAKE;
+                }))
+                return;
+
+            // Find a changed script module which isn't built already,
+            // modules changed while building are picked up once their job finished.
+            auto const itr = std::find_if(_sources_changed.begin(), _sources_changed.end(), [&](auto const& entry)
+            {
+                return std::none_of(_build_jobs.begin(), _build_jobs.end(), [&](BuildJob const& job)
+                {
+                    return job.GetModuleName() == entry.first;
+                });
+            });
+
+            if (itr == _sources_changed.end())
+                return;
+
+            bool const rebuild_buildfiles = !itr->second.empty();
+            bool const rerun_cmake = rebuild_buildfiles
+                && sWorld->getBoolConfig(CONFIG_HOTSWAP_BUILD_FILE_RECREATION_ENABLED);
+
+            // Wait for the running builds to finish before recreating the build files
+            if (rerun_cmake && !_build_jobs.empty())
+                return;
+
+            // Find all source files of a changed script module and removes
+            // it from the changed source list, invoke the build afterwards.
+            std::string module_name = itr->first;
 
             if (sLog->ShouldLog("scripts.hotswap", LogLevel::LOG_LEVEL_TRACE))
                 for (auto const& entry : itr->second)
@@ -1082,68 +1112,64 @@ private:
                 }
 
             _sources_changed.erase(itr);
-            return name;
-        }();
 
-        // Erase the added delete history all modules when we
-        // invoke a cmake rebuild since we add all
-        // added files of other modules to the build as well
-        if (rebuild_buildfiles)
-        {
-            for (auto& entry : _sources_changed)
-                entry.second.clear();
-        }
+            // Erase the added delete history all modules when we
+            // invoke a cmake rebuild since we add all
+            // added files of other modules to the build as well
+            if (rebuild_buildfiles)
+            {
+                for (auto& entry : _sources_changed)
+                    entry.second.clear();
+            }
 
-        ASSERT(!module_name.empty(),
-               "The current module name is invalid!");
+            ASSERT(!module_name.empty(),
+                   "The current module name is invalid!");
 
-        TC_LOG_INFO("scripts.hotswap", "Recompiling Module \"{}\"...",
-            module_name);
+            TC_LOG_INFO("scripts.hotswap", "Recompiling Module \"{}\"...",
+                module_name);
 
-        // Calculate the project name of the script module
-        auto project_name = CalculateScriptModuleProjectName(module_name);
+            // Calculate the project name of the script module
+            auto project_name = CalculateScriptModuleProjectName(module_name);
 
-        // Find the best build directive for the module
-        auto build_directive = [&] () -> std::string
-        {
-            auto directive = sConfigMgr->GetStringDefault("HotSwap.ReCompilerBuildType", "");
-            if (!directive.empty())
-                return directive;
-
-            auto const itr = _known_modules_build_directives.find(module_name);
-            if (itr != _known_modules_build_directives.end())
-                return itr->second;
-            else // If no build directive of the module was found use the one from the game library
-                return _BUILD_DIRECTIVE;
-        }();
-
-        // Initiate the new build job
-        _build_job = BuildJob(std::move(module_name),
-            std::move(project_name), std::move(build_directive));
-
-        // Rerun CMake when we need to recreate the build files
-        if (rebuild_buildfiles
-            && sWorld->getBoolConfig(CONFIG_HOTSWAP_BUILD_FILE_RECREATION_ENABLED))
-            DoRerunCMake();
-        else
-            DoCompileCurrentProcessedModule();
+            // Find the best build directive for the module
+            auto build_directive = [&] () -> std::string
+            {
+                auto directive = sConfigMgr->GetStringDefault("HotSwap.ReCompilerBuildType", "");
+                if (!directive.empty())
+                    return directive;
+
+                auto const itr = _known_modules_build_directives.find(module_name);
+                if (itr != _known_modules_build_directives.end())
+                    return itr->second;
+                else // If no build directive of the module was found use the one from the game library
+                    return _BUILD_DIRECTIVE;
+            }();
+
+            // Initiate the new build job
+            BuildJob& job = _build_jobs.emplace_back(std::move(module_name),
+                std::move(project_name), std::move(build_directive));
+
+            // Rerun CMake when we need to recreate the build files
+            if (rerun_cmake)
+                DoRerunCMake(job);
+            else
+                DoCompileModule(job);
+        }
     }
 
-    void ProcessReadyBuildJob()
+    /// Evaluates the result of a finished job step and continues with the next one.
+    /// Returns true when the job is done.
+    bool ProcessReadyBuildJob(BuildJob& job)
     {
-        ASSERT(_build_job->IsValid(), "Invalid build job!");
+        ASSERT(job.IsValid(), "Invalid build job!");
 
         // Retrieve the result
-        auto const error = _build_job->GetProcess()->GetFutureResult().get();
+        auto const error = job.GetProcess()->GetFutureResult().get();
 
-        if (terminate_early)
-        {
-            _build_job.reset();
-            terminate_early = false;
-            return;
-        }
+        if (job.IsTerminatedEarly())
+            return true;
 
-        switch (_build_job->GetType())
+        switch (job.GetType())
         {
             case BuildJobType::BUILD_JOB_RERUN_CMAKE:
             {
@@ -1159,8 +1185,8 @@ private:
                                 BuiltInConfig::GetBuildDirectory());
                 }
                 // Continue with building the changes sources
-                DoCompileCurrentProcessedModule();
-                return;
+                DoCompileModule(job);
+                return false;
             }
             case BuildJobType::BUILD_JOB_COMPILE:
             {
@@ -1171,22 +1197,22 @@ private:
                         // Continue with the installation when it's enabled
                         TC_LOG_INFO("scripts.hotswap",
                                     ">> Successfully build module {}, continue with installing...",
-                                    _build_job->GetModuleName());
+                                    job.GetModuleName());
 
-                        DoInstallCurrentProcessedModule();
-                        return;
+                        DoInstallModule(job);
+                        return false;
                     }
 
                     // Skip the installation because it's disabled in config
                     TC_LOG_INFO("scripts.hotswap",
                         ">> Successfully build module {}, skipped the installation.",
-                        _build_job->GetModuleName());
+                        job.GetModuleName());
                 }
                 else // Build wasn't successful
                 {
                     TC_LOG_ERROR("scripts.hotswap",
                         ">> The build of module {} failed! See the log for details.",
-                        _build_job->GetModuleName());
+                        job.GetModuleName());
                 }
                 break;
             }
@@ -1196,15 +1222,15 @@ private:
                 {
                     // Installation was successful
                     TC_LOG_INFO("scripts.hotswap", ">> Successfully installed module {} in {}s",
-                        _build_job->GetModuleName(),
-                        _build_job->GetTimeFromStart() / IN_MILLISECONDS);
+                        job.GetModuleName(),
+                        job.GetTimeFromStart() / IN_MILLISECONDS);
                 }
                 else
                 {
                     // Installation wasn't successful
                     TC_LOG_INFO("scripts.hotswap",
                         ">> The installation of module {} failed! See the log for details.",
-                        _build_job->GetModuleName());
+                        job.GetModuleName());
                 }
                 break;
             }
@@ -1212,48 +1238,48 @@ private:
                 break;
         }
 
-        // Clear the current job
-        _build_job.reset();
+        return true;
     }
 
     /// Reruns CMake asynchronously over the build directory
-    void DoRerunCMake()
+    void DoRerunCMake(BuildJob& job)
     {
-        ASSERT(_build_job, "There isn't any active build job!");
-
         TC_LOG_INFO("scripts.hotswap", "Rerunning CMake because there were sources added or removed...");
 
-        _build_job->UpdateCurrentJob(BuildJobType::BUILD_JOB_RERUN_CMAKE,
+        job.UpdateCurrentJob(BuildJobType::BUILD_JOB_RERUN_CMAKE,
             InvokeAsyncCMakeCommand(BuiltInConfig::GetBuildDirectory()));
     }
 
-    /// Invokes a new build of the current active module job
-    void DoCompileCurrentProcessedModule()
+    /// Invokes a new incremental build of the module of the given job,
+    /// only the changed sources of the module target are recompiled.
+    void DoCompileModule(BuildJob& job)
     {
-        ASSERT(_build_job, "There isn't any active build job!");
-
         TC_LOG_INFO("scripts.hotswap", "Starting asynchronous build job for module {}...",
-                    _build_job->GetModuleName());
+                    job.GetModuleName());
+
+        // Compile the sources of the module in parallel, by default one process per core
+        int32 build_processes = sConfigMgr->GetIntDefault("HotSwap.ReCompilerBuildProcesses", 0);
+        if (build_processes <= 0)
+            build_processes = std::max<int32>(std::thread::hardware_concurrency(), 1);
 
-        _build_job->UpdateCurrentJob(BuildJobType::BUILD_JOB_COMPILE,
+        job.UpdateCurrentJob(BuildJobType::BUILD_JOB_COMPILE,
             InvokeAsyncCMakeCommand(
                 "--build", BuiltInConfig::GetBuildDirectory(),
-                "--target", _build_job->GetProjectName(),
-                "--config", _build_job->GetBuildDirective()));
+                "--target", job.GetProjectName(),
+                "--config", job.GetBuildDirective(),
+                "--parallel", std::to_string(build_processes)));
     }
 
-    /// Invokes a new asynchronous install of the current active module job
-    void DoInstallCurrentProcessedModule()
+    /// Invokes a new asynchronous install of the module of the given job
+    void DoInstallModule(BuildJob& job)
     {
-        ASSERT(_build_job, "There isn't any active build job!");
-
         TC_LOG_INFO("scripts.hotswap", "Starting asynchronous install job for module {}...",
-                    _build_job->GetModuleName());
+                    job.GetModuleName());
 
-        _build_job->UpdateCurrentJob(BuildJobType::BUILD_JOB_INSTALL,
+        job.UpdateCurrentJob(BuildJobType::BUILD_JOB_INSTALL,
             InvokeAsyncCMakeCommand(
-                "-DCOMPONENT=" + _build_job->GetProjectName(),
-                "-DBUILD_TYPE=" + _build_job->GetBuildDirective(),
+                "-DCOMPONENT=" + job.GetProjectName(),
+                "-DBUILD_TYPE=" + job.GetBuildDirective(),
                 "-P", fs::absolute("cmake_install.cmake",
                     BuiltInConfig::GetBuildDirectory()).generic_string()));
     }
@@ -1417,12 +1443,8 @@ private:
     // Tracks the last timestamp the user was informed about a certain repeating event.
     uint32 _last_time_user_informed;
 
-    // Represents the current build job which is in progress
-    Optional<BuildJob> _build_job;
-
-    // Is true when the build job dispatcher should stop after
-    // the current job has finished
-    bool terminate_early;
+    // Represents the build jobs which are in progress
+    std::vector<BuildJob> _build_jobs;
 
     // The path to the tc_scripts temporary cache
     fs::path temporary_cache_path_;
@@ -16,15 +16,50 @@
  */
 
 #include "Packet.h"
+#include "ByteBufferStoragePool.h"
 #include "Errors.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+
+namespace
+{
+// largest recent size of every server opcode, decays slowly so a single huge packet does not inflate the reserve forever
+std::array<std::atomic<uint32>, NUM_SMSG_OPCODES> ServerPacketSizeHints = { };
+
+std::size_t GetServerPacketSizeHint(OpcodeServer opcode, std::size_t initialSize)
+{
+    if (opcode < MIN_SMSG_OPCODE_NUMBER || opcode > MAX_SMSG_OPCODE_NUMBER)
+        return initialSize;
+
+    return std::max<std::size_t>(initialSize, ServerPacketSizeHints[opcode - MIN_SMSG_OPCODE_NUMBER].load(std::memory_order_relaxed));
+}
+
+void UpdateServerPacketSizeHint(OpcodeServer opcode, std::size_t size)
+{
+    if (!size || opcode < MIN_SMSG_OPCODE_NUMBER || opcode > MAX_SMSG_OPCODE_NUMBER)
+        return;
+
+    std::atomic<uint32>& hint = ServerPacketSizeHints[opcode - MIN_SMSG_OPCODE_NUMBER];
+    uint32 current = hint.load(std::memory_order_relaxed);
+    uint32 learned = std::max<uint32>(std::min(size, ByteBufferStoragePool::SizeClasses.back()), current - current / 16);
+    if (learned != current)
+        hint.store(learned, std::memory_order_relaxed);
+}
+}
 
 WorldPackets::Packet::Packet(WorldPacket&& worldPacket) : _worldPacket(std::move(worldPacket))
 {
 }
 
 WorldPackets::ServerPacket::ServerPacket(OpcodeServer opcode, size_t initialSize /*= 200*/, ConnectionType connection /*= CONNECTION_TYPE_DEFAULT*/)
-    : Packet(WorldPacket(opcode, initialSize, connection))
+    : Packet(WorldPacket(opcode, GetServerPacketSizeHint(opcode, initialSize), connection))
+{
+}
+
+WorldPackets::ServerPacket::~ServerPacket()
 {
+    UpdateServerPacketSizeHint(GetOpcode(), _worldPacket.size());
 }
 
 void WorldPackets::ServerPacket::Read()
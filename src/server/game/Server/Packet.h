@@ -46,7 +46,9 @@ namespace WorldPackets
     class TC_GAME_API ServerPacket : public Packet
     {
     public:
+        // initialSize is raised to the size recently written for this opcode
         ServerPacket(OpcodeServer opcode, size_t initialSize = 200, ConnectionType connection = CONNECTION_TYPE_DEFAULT);
+        ~ServerPacket();
 
         void Read() override final;
 
@@ -830,7 +830,7 @@ namespace WorldPackets
             WorldPacket const* Write() override;
 
             bool IsFullUpdate = false;
-            std::map<uint32, HeirloomData> const* Heirlooms = nullptr;
+            HeirloomContainer const* Heirlooms = nullptr;
             int32 Unk = 0;
         };
 
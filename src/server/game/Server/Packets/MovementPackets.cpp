@@ -364,7 +364,39 @@ ByteBuffer& WorldPackets::operator<<(ByteBuffer& data, Movement::MovementMonster
     return data;
 }
 
+namespace
+{
+// ID, Destination, HasSplineMove and SplineFlags precede Elapsed
+constexpr std::size_t CreateObjectSplineElapsedOffset = 4 + 3 * 4 + 1 + 4;
+}
+
 void WorldPackets::Movement::CommonMovement::WriteCreateObjectSplineDataBlock(::Movement::MoveSpline const& moveSpline, ByteBuffer& data)
+{
+    if (moveSpline.createObjectBlock.empty() || moveSpline.Finalized())
+    {
+        WriteCreateObjectSplineDataBlockImpl(moveSpline, data);
+        return;
+    }
+
+    std::size_t blockPos = data.wpos();
+    data.append(moveSpline.createObjectBlock.data(), moveSpline.createObjectBlock.size());
+    data.put<int32>(blockPos + CreateObjectSplineElapsedOffset, moveSpline.timePassed());
+}
+
+void WorldPackets::Movement::CommonMovement::CacheCreateObjectSplineDataBlock(::Movement::MoveSpline& moveSpline)
+{
+    moveSpline.createObjectBlock.clear();
+
+    // blocks without MovementSplineMove are too small to be worth it
+    if (moveSpline.Finalized() || moveSpline.splineIsFacingOnly)
+        return;
+
+    ByteBuffer block(CreateObjectSplineElapsedOffset + 64 + moveSpline.getPath().size() * sizeof(G3D::Vector3), ByteBuffer::Reserve{});
+    WriteCreateObjectSplineDataBlockImpl(moveSpline, block);
+    moveSpline.createObjectBlock.assign(block.contents(), block.contents() + block.size());
+}
+
+void WorldPackets::Movement::CommonMovement::WriteCreateObjectSplineDataBlockImpl(::Movement::MoveSpline const& moveSpline, ByteBuffer& data)
 {
     data << uint32(moveSpline.GetId());                                         // ID
 
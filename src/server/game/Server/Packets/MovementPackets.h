@@ -148,9 +148,13 @@ namespace WorldPackets
         {
         public:
             static void WriteCreateObjectSplineDataBlock(::Movement::MoveSpline const& moveSpline, ByteBuffer& data);
+            static void CacheCreateObjectSplineDataBlock(::Movement::MoveSpline& moveSpline);
             static void WriteCreateObjectAreaTriggerSpline(::Movement::Spline<int32> const& spline, ByteBuffer& data);
 
             static void WriteMovementForceWithDirection(MovementForce const& movementForce, ByteBuffer& data, Position const* objectPosition = nullptr);
+
+        private:
+            static void WriteCreateObjectSplineDataBlockImpl(::Movement::MoveSpline const& moveSpline, ByteBuffer& data);
         };
 
         class MonsterMove final : public ServerPacket
@@ -717,8 +721,8 @@ namespace WorldPackets
     ByteBuffer& operator<<(ByteBuffer& data, Movement::MovementMonsterSpline const& movementMonsterSpline);
 }
 
-ByteBuffer& operator>>(ByteBuffer& data, MovementInfo& movementInfo);
-ByteBuffer& operator<<(ByteBuffer& data, MovementInfo const& movementInfo);
+TC_GAME_API ByteBuffer& operator>>(ByteBuffer& data, MovementInfo& movementInfo);
+TC_GAME_API ByteBuffer& operator<<(ByteBuffer& data, MovementInfo const& movementInfo);
 
 ByteBuffer& operator>>(ByteBuffer& data, MovementInfo::TransportInfo& transportInfo);
 ByteBuffer& operator<<(ByteBuffer& data, MovementInfo::TransportInfo const& transportInfo);
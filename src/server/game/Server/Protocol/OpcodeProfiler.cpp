@@ -0,0 +1,160 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "OpcodeProfiler.h"
+#include "Metric.h"
+#include "World.h"
+
+char const* GetPacketProcessingContextName(PacketProcessingContext context)
+{
+    switch (context)
+    {
+        case PacketProcessingContext::World: return "World";
+        case PacketProcessingContext::Map: return "Map";
+        case PacketProcessingContext::Session: return "Session";
+        default:
+            break;
+    }
+    return "Unknown";
+}
+
+OpcodeProfiler::ScopedCall::ScopedCall(PacketProcessingContext context, OpcodeClient opcode, std::size_t size) : _stats(nullptr)
+{
+    OpcodeStats* stats = sOpcodeProfiler->GetStats(context, opcode);
+    if (!stats)
+        return;
+
+    stats->Calls.fetch_add(1, std::memory_order_relaxed);
+    stats->Bytes.fetch_add(size, std::memory_order_relaxed);
+
+    uint32 sampleRate = sWorld->getIntConfig(CONFIG_PACKET_PROFILER_SAMPLE_RATE);
+    if (!sampleRate)
+        return;
+
+    thread_local uint32 packetsUntilSample = 0;
+    if (packetsUntilSample--)
+        return;
+
+    packetsUntilSample = sampleRate - 1;
+    _stats = stats;
+    _start = std::chrono::steady_clock::now();
+}
+
+OpcodeProfiler::ScopedCall::~ScopedCall()
+{
+    if (!_stats)
+        return;
+
+    uint32 elapsed = uint32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count());
+    std::lock_guard<std::mutex> lock(_stats->LatencyLock);
+    _stats->Latency.Add(elapsed);
+}
+
+OpcodeProfiler* OpcodeProfiler::instance()
+{
+    static OpcodeProfiler instance;
+    return &instance;
+}
+
+OpcodeProfiler::OpcodeStats* OpcodeProfiler::GetStats(PacketProcessingContext context, OpcodeClient opcode)
+{
+    if (opcode < MIN_CMSG_OPCODE_NUMBER || opcode > MAX_CMSG_OPCODE_NUMBER || context >= PacketProcessingContext::Max)
+        return nullptr;
+
+    std::atomic<OpcodeStats*>& slot = _stats[std::size_t(context)][opcode - MIN_CMSG_OPCODE_NUMBER];
+    if (OpcodeStats* stats = slot.load(std::memory_order_acquire))
+        return stats;
+
+    std::lock_guard<std::mutex> lock(_allocationLock);
+    if (OpcodeStats* stats = slot.load(std::memory_order_relaxed))
+        return stats;
+
+    OpcodeStats* stats = _allocatedStats.emplace_back(std::make_unique<OpcodeStats>()).get();
+    slot.store(stats, std::memory_order_release);
+    return stats;
+}
+
+std::vector<OpcodeProfiler::Summary> OpcodeProfiler::GetSummaries() const
+{
+    std::vector<Summary> summaries;
+    for (std::size_t context = 0; context < ContextCount; ++context)
+    {
+        for (std::size_t i = 0; i < NUM_CMSG_OPCODES; ++i)
+        {
+            OpcodeStats* stats = _stats[context][i].load(std::memory_order_acquire);
+            if (!stats || !stats->Calls.load(std::memory_order_relaxed))
+                continue;
+
+            Summary& summary = summaries.emplace_back();
+            summary.Opcode = OpcodeClient(i + MIN_CMSG_OPCODE_NUMBER);
+            summary.Context = PacketProcessingContext(context);
+            summary.Calls = stats->Calls.load(std::memory_order_relaxed);
+            summary.Bytes = stats->Bytes.load(std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(stats->LatencyLock);
+            summary.Latency = stats->Latency;
+        }
+    }
+
+    return summaries;
+}
+
+void OpcodeProfiler::Reset()
+{
+    for (std::size_t context = 0; context < ContextCount; ++context)
+    {
+        for (std::size_t i = 0; i < NUM_CMSG_OPCODES; ++i)
+        {
+            OpcodeStats* stats = _stats[context][i].load(std::memory_order_acquire);
+            if (!stats)
+                continue;
+
+            stats->Calls.store(0, std::memory_order_relaxed);
+            stats->Bytes.store(0, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock(stats->LatencyLock);
+            stats->Latency.Reset();
+        }
+    }
+}
+
+void OpcodeProfiler::Update(uint32 diff)
+{
+    _exportTimer += diff;
+    if (_exportTimer < ExportInterval)
+        return;
+
+    _exportTimer = 0;
+    if (!sMetric->IsEnabled())
+        return;
+
+    // everything is cumulative since the last Reset (.debug opcodes reset)
+    for (Summary const& summary : GetSummaries())
+    {
+        std::string name = GetOpcodeNameForLogging(summary.Opcode);
+        TC_METRIC_VALUE("opcode_calls", summary.Calls,
+            TC_METRIC_TAG("opcode", name),
+            TC_METRIC_TAG("context", GetPacketProcessingContextName(summary.Context)));
+        TC_METRIC_VALUE("opcode_bytes", summary.Bytes,
+            TC_METRIC_TAG("opcode", name),
+            TC_METRIC_TAG("context", GetPacketProcessingContextName(summary.Context)));
+        if (summary.Latency.GetCount())
+            TC_METRIC_HISTOGRAM("opcode_handler_time", summary.Latency,
+                TC_METRIC_TAG("opcode", name),
+                TC_METRIC_TAG("context", GetPacketProcessingContextName(summary.Context)));
+    }
+}
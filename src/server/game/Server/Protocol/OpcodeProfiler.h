@@ -0,0 +1,107 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_OPCODE_PROFILER_H
+#define TRINITY_OPCODE_PROFILER_H
+
+#include "Common.h"
+#include "MetricHistogram.h"
+#include "Opcodes.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+enum class PacketProcessingContext : uint8
+{
+    World,      // World::UpdateSessions, thread unsafe handlers and sessions without a player in world
+    Map,        // Map::Update, thread safe handlers of players in world
+    Session,    // session update threads of World::UpdateSessions, session local handlers of sessions without a player in world
+
+    Max
+};
+
+TC_GAME_API char const* GetPacketProcessingContextName(PacketProcessingContext context);
+
+// Per opcode call counts, received bytes and handler latency, separately for every processing context
+// Counts are exact, latency is only measured for every Metric.PacketProfiler.SampleRate-th packet of a thread
+class TC_GAME_API OpcodeProfiler
+{
+    struct OpcodeStats
+    {
+        std::atomic<uint64> Calls;
+        std::atomic<uint64> Bytes;
+        std::mutex LatencyLock;
+        MetricHistogram Latency;    // microseconds
+    };
+
+public:
+    static constexpr std::size_t ContextCount = std::size_t(PacketProcessingContext::Max);
+
+    struct Summary
+    {
+        OpcodeClient Opcode;
+        PacketProcessingContext Context;
+        uint64 Calls;
+        uint64 Bytes;
+        MetricHistogram Latency;
+    };
+
+    // measures a single handler call, does nothing but count the packet when it is not sampled
+    class ScopedCall
+    {
+    public:
+        ScopedCall(PacketProcessingContext context, OpcodeClient opcode, std::size_t size);
+        ~ScopedCall();
+
+        ScopedCall(ScopedCall const&) = delete;
+        ScopedCall& operator=(ScopedCall const&) = delete;
+
+    private:
+        OpcodeStats* _stats;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    static OpcodeProfiler* instance();
+
+    // snapshot of every opcode seen since the last Reset
+    std::vector<Summary> GetSummaries() const;
+    void Reset();
+
+    // called from World::Update, sends the collected values to Metric every ExportInterval
+    void Update(uint32 diff);
+
+private:
+    OpcodeProfiler() = default;
+    ~OpcodeProfiler() = default;
+
+    OpcodeStats* GetStats(PacketProcessingContext context, OpcodeClient opcode);
+
+    static constexpr uint32 ExportInterval = 10 * IN_MILLISECONDS;
+
+    // allocated on first use, most opcodes are never received
+    std::array<std::array<std::atomic<OpcodeStats*>, NUM_CMSG_OPCODES>, ContextCount> _stats = { };
+    std::mutex _allocationLock;
+    std::vector<std::unique_ptr<OpcodeStats>> _allocatedStats;
+    uint32 _exportTimer = 0;
+};
+
+#define sOpcodeProfiler OpcodeProfiler::instance()
+
+#endif // TRINITY_OPCODE_PROFILER_H
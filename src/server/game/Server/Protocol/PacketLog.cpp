@@ -19,10 +19,15 @@
 #include "Config.h"
 #include "GameTime.h"
 #include "IpAddress.h"
+#include "Log.h"
 #include "Realm.h"
+#include "StringConvert.h"
+#include "StringFormat.h"
 #include "Timer.h"
+#include "Util.h"
 #include "World.h"
 #include "WorldPacket.h"
+#include <algorithm>
 
 #pragma pack(push, 1)
 
@@ -60,13 +65,116 @@ struct PacketHeader
 
 #pragma pack(pop)
 
-PacketLog::PacketLog() : _file(nullptr)
+class PacketLog::RingBuffer
+{
+public:
+    explicit RingBuffer(std::size_t size) : _data(std::make_unique<uint8[]>(size)), _size(size), _head(0), _tail(0) { }
+
+    // producer side, only called by the owning thread
+    bool Write(void const* header, uint32 headerSize, uint8 const* data, uint32 dataSize)
+    {
+        uint32 recordSize = headerSize + dataSize;
+        std::size_t head = _head.load(std::memory_order_relaxed);
+        std::size_t tail = _tail.load(std::memory_order_acquire);
+        if (_size - (head - tail) < sizeof(recordSize) + recordSize)
+            return false;
+
+        CopyIn(head, &recordSize, sizeof(recordSize));
+        CopyIn(head + sizeof(recordSize), header, headerSize);
+        CopyIn(head + sizeof(recordSize) + headerSize, data, dataSize);
+        _head.store(head + sizeof(recordSize) + recordSize, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side, only called by the writer thread
+    bool Read(std::vector<uint8>& record)
+    {
+        std::size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire))
+            return false;
+
+        uint32 recordSize;
+        CopyOut(tail, &recordSize, sizeof(recordSize));
+        record.resize(recordSize);
+        CopyOut(tail + sizeof(recordSize), record.data(), recordSize);
+        _tail.store(tail + sizeof(recordSize) + recordSize, std::memory_order_release);
+        return true;
+    }
+
+private:
+    void CopyIn(std::size_t position, void const* source, std::size_t size)
+    {
+        std::size_t offset = position % _size;
+        std::size_t first = std::min(size, _size - offset);
+        memcpy(&_data[offset], source, first);
+        memcpy(&_data[0], static_cast<uint8 const*>(source) + first, size - first);
+    }
+
+    void CopyOut(std::size_t position, void* destination, std::size_t size) const
+    {
+        std::size_t offset = position % _size;
+        std::size_t first = std::min(size, _size - offset);
+        memcpy(destination, &_data[offset], first);
+        memcpy(static_cast<uint8*>(destination) + first, &_data[0], size - first);
+    }
+
+    std::unique_ptr<uint8[]> _data;
+    std::size_t _size;
+    // positions only ever grow, the offset into _data is position % _size
+    std::atomic<std::size_t> _head;
+    std::atomic<std::size_t> _tail;
+};
+
+namespace
+{
+void WriteLogHeader(FILE* file)
+{
+    LogHeader header;
+    header.Signature[0] = 'P'; header.Signature[1] = 'K'; header.Signature[2] = 'T';
+    header.FormatVersion = 0x0301;
+    header.SnifferId = 'T';
+    header.Build = realm.Build;
+    header.Locale[0] = 'e'; header.Locale[1] = 'n'; header.Locale[2] = 'U'; header.Locale[3] = 'S';
+    std::memset(header.SessionKey, 0, sizeof(header.SessionKey));
+    header.SniffStartUnixtime = GameTime::GetGameTime();
+    header.SniffStartTicks = getMSTime();
+    header.OptionalDataSize = 0;
+
+    fwrite(&header, sizeof(header), 1, file);
+}
+
+void LoadFilter(std::string const& configName, std::unordered_set<uint32>& filter)
+{
+    std::string values = sConfigMgr->GetStringDefault(configName, "");
+    for (std::string_view token : Trinity::Tokenize(values, ' ', false))
+    {
+        if (Optional<uint32> value = Trinity::StringTo<uint32>(token, 0))
+            filter.insert(*value);
+        else
+            TC_LOG_ERROR("server.loading", "{} contains invalid value '{}', skipped", configName, token);
+    }
+}
+}
+
+PacketLog::PacketLog() : _enabled(false), _file(nullptr), _fileIndex(0), _fileSize(0), _maxFileSize(0), _bufferSize(0),
+    _droppedPackets(0), _reportedDroppedPackets(0), _stopWriter(false)
 {
     std::call_once(_initializeFlag, &PacketLog::Initialize, this);
 }
 
 PacketLog::~PacketLog()
 {
+    if (_writer.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(_writerLock);
+            _stopWriter = true;
+        }
+
+        _writerCondition.notify_one();
+        _writer.join();
+    }
+
     if (_file)
         fclose(_file);
 
@@ -88,31 +196,58 @@ void PacketLog::Initialize()
             logsDir.push_back('/');
 
     std::string logname = sConfigMgr->GetStringDefault("PacketLogFile", "");
-    if (!logname.empty())
+    if (logname.empty())
+        return;
+
+    _fileName = logsDir + logname;
+    _maxFileSize = uint64(sConfigMgr->GetIntDefault("PacketLog.MaxFileSize", 0)) * 1024 * 1024;
+    _bufferSize = std::max<std::size_t>(sConfigMgr->GetIntDefault("PacketLog.BufferSize", 4096), 64) * 1024;
+    LoadFilter("PacketLog.Accounts", _accountFilter);
+    LoadFilter("PacketLog.Opcodes", _opcodeFilter);
+
+    if (!OpenFile())
+        return;
+
+    _enabled = true;
+    _writer = std::thread(&PacketLog::WriterThread, this);
+}
+
+bool PacketLog::OpenFile()
+{
+    if (_file)
+        fclose(_file);
+
+    // rotated files keep the extension so they stay parsable, World.pkt is followed by World_1.pkt, World_2.pkt...
+    std::string fileName = _fileName;
+    if (_fileIndex)
     {
-        _file = fopen((logsDir + logname).c_str(), "wb");
+        std::size_t extension = fileName.find_last_of('.');
+        std::size_t directory = fileName.find_last_of("/\\");
+        if (extension == std::string::npos || (directory != std::string::npos && extension < directory))
+            extension = fileName.length();
 
-        if (CanLogPacket())
-        {
-            LogHeader header;
-            header.Signature[0] = 'P'; header.Signature[1] = 'K'; header.Signature[2] = 'T';
-            header.FormatVersion = 0x0301;
-            header.SnifferId = 'T';
-            header.Build = realm.Build;
-            header.Locale[0] = 'e'; header.Locale[1] = 'n'; header.Locale[2] = 'U'; header.Locale[3] = 'S';
-            std::memset(header.SessionKey, 0, sizeof(header.SessionKey));
-            header.SniffStartUnixtime = GameTime::GetGameTime();
-            header.SniffStartTicks = getMSTime();
-            header.OptionalDataSize = 0;
-
-            fwrite(&header, sizeof(header), 1, _file);
-        }
+        fileName.insert(extension, Trinity::StringFormat("_{}", _fileIndex));
     }
+
+    _file = fopen(fileName.c_str(), "wb");
+    if (!_file)
+    {
+        TC_LOG_ERROR("network", "PacketLog: cannot open {}", fileName);
+        return false;
+    }
+
+    WriteLogHeader(_file);
+    _fileSize = sizeof(LogHeader);
+    return true;
 }
 
-void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port, ConnectionType connectionType)
+void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port, ConnectionType connectionType, uint32 accountId)
 {
-    std::lock_guard<std::mutex> lock(_logPacketLock);
+    if (!_accountFilter.empty() && !_accountFilter.contains(accountId))
+        return;
+
+    if (!_opcodeFilter.empty() && !_opcodeFilter.contains(packet.GetOpcode()))
+        return;
 
     PacketHeader header;
     header.Direction = direction == CLIENT_TO_SERVER ? 0x47534d43 : 0x47534d53;
@@ -134,20 +269,88 @@ void PacketLog::LogPacket(WorldPacket const& packet, Direction direction, boost:
 
     header.OptionalData.SocketPort = port;
     std::size_t size = packet.size();
+    uint8 const* data = packet.contents();
     if (direction == CLIENT_TO_SERVER)
+    {
         size -= 2;
+        data += 2;
+    }
 
     header.Length = size + sizeof(header.Opcode);
     header.Opcode = packet.GetOpcode();
 
-    fwrite(&header, sizeof(header), 1, _file);
-    if (size)
+    if (!GetThreadBuffer()->Write(&header, sizeof(header), data, uint32(size)))
+        ++_droppedPackets;
+}
+
+PacketLog::RingBuffer* PacketLog::GetThreadBuffer()
+{
+    thread_local RingBuffer* buffer = nullptr;
+    if (!buffer)
     {
-        uint8 const* data = packet.contents();
-        if (direction == CLIENT_TO_SERVER)
-            data += 2;
-        fwrite(data, 1, size, _file);
+        std::lock_guard<std::mutex> lock(_buffersLock);
+        buffer = _buffers.emplace_back(std::make_unique<RingBuffer>(_bufferSize)).get();
     }
 
-    fflush(_file);
+    return buffer;
+}
+
+void PacketLog::WriterThread()
+{
+    std::vector<uint8> record;
+    std::unique_lock<std::mutex> lock(_writerLock);
+    while (!_stopWriter)
+    {
+        _writerCondition.wait_for(lock, 10ms);
+
+        lock.unlock();
+        Drain(record);
+        lock.lock();
+    }
+
+    lock.unlock();
+    Drain(record);
+}
+
+void PacketLog::Drain(std::vector<uint8>& record)
+{
+    std::vector<RingBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(_buffersLock);
+        buffers.reserve(_buffers.size());
+        for (std::unique_ptr<RingBuffer> const& buffer : _buffers)
+            buffers.push_back(buffer.get());
+    }
+
+    // every buffer is in order but buffers of different threads are interleaved, parsers order packets by ArrivalTicks
+    bool written = false;
+    for (RingBuffer* buffer : buffers)
+    {
+        while (buffer->Read(record))
+        {
+            if (!_file)
+                continue;
+
+            if (_maxFileSize && _fileSize + record.size() > _maxFileSize && _fileSize > sizeof(LogHeader))
+            {
+                ++_fileIndex;
+                if (!OpenFile())
+                    continue;
+            }
+
+            fwrite(record.data(), 1, record.size(), _file);
+            _fileSize += record.size();
+            written = true;
+        }
+    }
+
+    if (written && _file)
+        fflush(_file);
+
+    uint64 dropped = _droppedPackets;
+    if (dropped != _reportedDroppedPackets)
+    {
+        TC_LOG_WARN("network", "PacketLog: {} packets dropped because the log buffer was full (PacketLog.BufferSize)", dropped - _reportedDroppedPackets);
+        _reportedDroppedPackets = dropped;
+    }
 }
@@ -19,7 +19,14 @@
 #define TRINITY_PACKETLOG_H
 
 #include "Common.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 enum Direction
 {
@@ -41,23 +48,52 @@ namespace boost
     }
 }
 
+/// Packets are copied into a ring buffer owned by the calling thread and written to disk by a background thread
+/// so logging never blocks network or map threads, packets that do not fit into a full buffer are dropped and counted
 class TC_GAME_API PacketLog
 {
     private:
         PacketLog();
         ~PacketLog();
-        std::mutex _logPacketLock;
         std::once_flag _initializeFlag;
 
     public:
         static PacketLog* instance();
 
         void Initialize();
-        bool CanLogPacket() const { return (_file != nullptr); }
-        void LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port, ConnectionType connectionType);
+        bool CanLogPacket() const { return _enabled; }
+        void LogPacket(WorldPacket const& packet, Direction direction, boost::asio::ip::address const& addr, uint16 port, ConnectionType connectionType, uint32 accountId);
+
+        uint64 GetDroppedPacketCount() const { return _droppedPackets; }
 
     private:
+        class RingBuffer;
+
+        RingBuffer* GetThreadBuffer();
+        bool OpenFile();
+        void WriterThread();
+        void Drain(std::vector<uint8>& record);
+
+        bool _enabled;
         FILE* _file;
+        std::string _fileName;
+        uint32 _fileIndex;
+        uint64 _fileSize;
+        uint64 _maxFileSize;
+
+        std::unordered_set<uint32> _accountFilter;
+        std::unordered_set<uint32> _opcodeFilter;
+
+        std::mutex _buffersLock;
+        std::vector<std::unique_ptr<RingBuffer>> _buffers;
+        std::size_t _bufferSize;
+        std::atomic<uint64> _droppedPackets;
+        uint64 _reportedDroppedPackets;
+
+        std::thread _writer;
+        std::mutex _writerLock;
+        std::condition_variable _writerCondition;
+        bool _stopWriter;
 };
 
 #define sPacketLog PacketLog::instance()
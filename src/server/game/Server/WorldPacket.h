@@ -18,6 +18,7 @@
 #ifndef TRINITYCORE_WORLDPACKET_H
 #define TRINITYCORE_WORLDPACKET_H
 
+#include "AllocationTracker.h"
 #include "ByteBuffer.h"
 #include "Opcodes.h"
 #include "Duration.h"
@@ -47,6 +48,8 @@ class WorldPacket : public ByteBuffer
 
         WorldPacket(WorldPacket const& right) = default;
 
+        TC_ALLOCATION_TAGGED_CLASS(Packets)
+
         WorldPacket& operator=(WorldPacket const& right)
         {
             if (this != &right)
@@ -76,7 +79,11 @@ class WorldPacket : public ByteBuffer
         void Initialize(uint32 opcode, size_t newres = 200, ConnectionType connection = CONNECTION_TYPE_DEFAULT)
         {
             clear();
-            _storage.reserve(newres);
+            if (_storage.capacity() < newres)
+            {
+                ByteBufferStoragePool::Release(std::move(_storage));
+                _storage = ByteBufferStoragePool::Acquire(newres);
+            }
             m_opcode = opcode;
             _connection = connection;
         }
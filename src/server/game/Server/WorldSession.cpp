@@ -22,10 +22,12 @@
 #include "WorldSession.h"
 #include "QueryHolder.h"
 #include "AccountMgr.h"
+#include "AllocationTracker.h"
 #include "AuthenticationPackets.h"
 #include "BattlePetMgr.h"
 #include "BattlegroundMgr.h"
 #include "BattlenetPackets.h"
+#include "CharacterEnumCache.h"
 #include "CharacterPackets.h"
 #include "ChatPackets.h"
 #include "ClientConfigPackets.h"
@@ -41,6 +43,7 @@
 #include "Metric.h"
 #include "MiscPackets.h"
 #include "ObjectMgr.h"
+#include "OpcodeProfiler.h"
 #include "OutdoorPvPMgr.h"
 #include "PacketUtilities.h"
 #include "Player.h"
@@ -59,6 +62,10 @@ namespace {
 
 std::string const DefaultPlayerName = "<none>";
 
+// see WorldSession::PacketCaptureScope
+thread_local WorldSession const* CapturingSession = nullptr;
+thread_local std::vector<WorldPacket>* CapturedPackets = nullptr;
+
 } // namespace
 
 bool MapSessionFilter::Process(WorldPacket* packet)
@@ -70,7 +77,7 @@ bool MapSessionFilter::Process(WorldPacket* packet)
         return true;
 
     //we do not process thread-unsafe packets
-    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE)
+    if (opHandle->ProcessingPlace != PROCESS_THREADSAFE)
         return false;
 
     Player* player = m_pSession->GetPlayer();
@@ -92,7 +99,7 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
         return true;
 
     //thread-unsafe packets should be processed in World::UpdateSessions()
-    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE)
+    if (opHandle->ProcessingPlace == PROCESS_THREADUNSAFE || opHandle->ProcessingPlace == PROCESS_SESSIONLOCAL)
         return true;
 
     //no player attached? -> our client! ^^
@@ -104,6 +111,27 @@ bool WorldSessionFilter::Process(WorldPacket* packet)
     return (player->IsInWorld() == false);
 }
 
+bool OutOfWorldSessionFilter::Process(WorldPacket* packet)
+{
+    ClientOpcodeHandler const* opHandle = opcodeTable[static_cast<OpcodeClient>(packet->GetOpcode())];
+
+    if (opHandle->ProcessingPlace != PROCESS_INPLACE && opHandle->ProcessingPlace != PROCESS_SESSIONLOCAL)
+        return false;
+
+    Player* player = m_pSession->GetPlayer();
+    return !player || !player->IsInWorld();
+}
+
+PacketProcessingContext PacketFilter::GetProcessingContext() const
+{
+    return ProcessUnsafe() ? PacketProcessingContext::World : PacketProcessingContext::Map;
+}
+
+PacketProcessingContext OutOfWorldSessionFilter::GetProcessingContext() const
+{
+    return PacketProcessingContext::Session;
+}
+
 /// WorldSession constructor
 WorldSession::WorldSession(uint32 id, std::string&& name, uint32 battlenetAccountId, std::shared_ptr<WorldSocket> sock, AccountTypes sec, uint8 expansion, time_t mute_time,
     std::string os, Minutes timezoneOffset, LocaleConstant locale, uint32 recruiter, bool isARecruiter):
@@ -141,6 +169,7 @@ WorldSession::WorldSession(uint32 id, std::string&& name, uint32 battlenetAccoun
     _pendingTimeSyncRequests(),
     _timeSyncNextCounter(0),
     _timeSyncTimer(0),
+    _moveHeartbeatSequence(0),
     _calendarEventCreationCooldown(0),
     _battlePetMgr(std::make_unique<BattlePets::BattlePetMgr>(this)),
     _collectionMgr(std::make_unique<CollectionMgr>(this))
@@ -161,6 +190,14 @@ WorldSession::WorldSession(uint32 id, std::string&& name, uint32 battlenetAccoun
 /// WorldSession destructor
 WorldSession::~WorldSession()
 {
+    ///- drop a login still waiting for its initial packets, the player was never added to the world
+    if (_pendingLogin)
+    {
+        _pendingLogin->Built.wait(false, std::memory_order_acquire);
+        delete _pendingLogin->LoadedPlayer;
+        _pendingLogin = nullptr;
+    }
+
     ///- unload player if not unloaded
     if (_player)
         LogoutPlayer (true);
@@ -178,10 +215,11 @@ WorldSession::~WorldSession()
     delete _RBACData;
 
     ///- empty incoming packet queue
-    WorldPacket* packet = nullptr;
-    while (_recvQueue.next(packet))
+    for (WorldPacket* packet : _recvPending)
         delete packet;
 
+    sCharacterEnumCache->Remove(GetAccountId());
+
     LoginDatabase.PExecute("UPDATE account SET online = 0 WHERE id = {};", GetAccountId());     // One-time query
 }
 
@@ -209,19 +247,64 @@ std::string WorldSession::GetPlayerInfo() const
 
 /// Send a packet to the client
 void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/)
+{
+    if (CapturingSession == this)
+    {
+        CapturedPackets->push_back(*packet);
+        return;
+    }
+
+    if (WorldSocket* socket = GetSocketForPacket(packet, forced))
+        socket->SendPacket(*packet);
+}
+
+/// Send a packet body shared with other sessions to the client, the socket queues a reference instead of a copy
+void WorldSession::SendPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
+    if (CapturingSession == this)
+    {
+        CapturedPackets->push_back(*packet);
+        return;
+    }
+
+    if (WorldSocket* socket = GetSocketForPacket(packet.get(), false))
+        socket->SendPacket(packet);
+}
+
+void WorldSession::FlushPackets()
+{
+    for (std::shared_ptr<WorldSocket> const& socket : m_Socket)
+        if (socket)
+            socket->FlushPackets();
+}
+
+WorldSession::PacketCaptureScope::PacketCaptureScope(WorldSession const* session, std::vector<WorldPacket>& packets)
+{
+    ASSERT(!CapturingSession, "Packet capture scopes can not be nested");
+    CapturingSession = session;
+    CapturedPackets = &packets;
+}
+
+WorldSession::PacketCaptureScope::~PacketCaptureScope()
+{
+    CapturingSession = nullptr;
+    CapturedPackets = nullptr;
+}
+
+WorldSocket* WorldSession::GetSocketForPacket(WorldPacket const* packet, bool forced)
 {
     if (packet->GetOpcode() < MIN_SMSG_OPCODE_NUMBER || packet->GetOpcode() > MAX_SMSG_OPCODE_NUMBER)
     {
         char const* specialName = packet->GetOpcode() == UNKNOWN_OPCODE ? "UNKNOWN_OPCODE" : "INVALID_OPCODE";
         TC_LOG_ERROR("network.opcode", "Prevented sending of {} (0x{:04X}) to {}", specialName, packet->GetOpcode(), GetPlayerInfo());
-        return;
+        return nullptr;
     }
 
     ServerOpcodeHandler const* handler = opcodeTable[static_cast<OpcodeServer>(packet->GetOpcode())];
     if (!handler)
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of opcode {} with non existing handler to {}", packet->GetOpcode(), GetPlayerInfo());
-        return;
+        return nullptr;
     }
 
     // Default connection index defined in Opcodes.cpp table
@@ -233,7 +316,7 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
         if (packet->GetConnection() != CONNECTION_TYPE_INSTANCE && IsInstanceOnlyOpcode(packet->GetOpcode()))
         {
             TC_LOG_ERROR("network.opcode", "Prevented sending of instance only opcode {} with connection type {} to {}", packet->GetOpcode(), uint32(packet->GetConnection()), GetPlayerInfo());
-            return;
+            return nullptr;
         }
 
         conIdx = packet->GetConnection();
@@ -242,7 +325,7 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
     if (!m_Socket[conIdx])
     {
         TC_LOG_ERROR("network.opcode", "Prevented sending of {} to non existent socket {} to {}", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())), uint32(conIdx), GetPlayerInfo());
-        return;
+        return nullptr;
     }
 
     if (!forced)
@@ -250,7 +333,7 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
         if (handler->Status == STATUS_UNHANDLED)
         {
             TC_LOG_ERROR("network.opcode", "Prevented sending disabled opcode {} to {}", GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())), GetPlayerInfo());
-            return;
+            return nullptr;
         }
     }
 
@@ -291,13 +374,13 @@ void WorldSession::SendPacket(WorldPacket const* packet, bool forced /*= false*/
     sScriptMgr->OnPacketSend(this, *packet);
 
     TC_LOG_TRACE("network.opcode", "S->C: {} {}", GetPlayerInfo(), GetOpcodeNameForLogging(static_cast<OpcodeServer>(packet->GetOpcode())));
-    m_Socket[conIdx]->SendPacket(*packet);
+    return m_Socket[conIdx].get();
 }
 
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
-    _recvQueue.add(new_packet);
+    _recvQueue.Enqueue(new_packet);
 }
 
 /// Logging helper for unexpected opcodes
@@ -318,16 +401,8 @@ void WorldSession::LogUnprocessedTail(WorldPacket const* packet)
     packet->print_storage();
 }
 
-/// Update the WorldSession (triggered by World update)
-bool WorldSession::Update(uint32 diff, PacketFilter& updater)
+void WorldSession::ProcessReceivedPackets(PacketFilter& updater)
 {
-    ///- Before we process anything:
-    /// If necessary, kick the player because the client didn't send anything for too long
-    /// (or they've been idling in character select)
-    if (IsConnectionIdle() && !HasPermission(rbac::RBAC_PERM_IGNORE_IDLE_CONNECTION))
-        m_Socket[CONNECTION_TYPE_REALM]->CloseSocket();
-
-    ///- Retrieve packets from the receive queue and call the appropriate handlers
     /// not process packets if socket already closed
     WorldPacket* packet = nullptr;
     //! Delete packet after processing by default
@@ -338,11 +413,20 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     constexpr uint32 MAX_PROCESSED_PACKETS_IN_SAME_WORLDSESSION_UPDATE = 100;
 
-    while (m_Socket[CONNECTION_TYPE_REALM] && _recvQueue.next(packet, updater))
+    // move everything received so far out of the lock free queue, packets the current updater cannot handle stay pending in order
+    while (_recvQueue.Dequeue(packet))
+        _recvPending.push_back(packet);
+
+    while (m_Socket[CONNECTION_TYPE_REALM] && !_recvPending.empty() && updater.Process(_recvPending.front()))
     {
+        packet = _recvPending.front();
+        _recvPending.pop_front();
+
         OpcodeClient opcode = static_cast<OpcodeClient>(packet->GetOpcode());
         ClientOpcodeHandler const* opHandle = opcodeTable[opcode];
         TC_METRIC_DETAILED_TIMER("worldsession_update_opcode_time", TC_METRIC_TAG("opcode", opHandle->Name));
+        OpcodeProfiler::ScopedCall profileCall(updater.GetProcessingContext(), opcode, packet->size());
+        TC_ALLOCATION_TAG_SCOPE(PacketHandlers);
 
         try
         {
@@ -474,7 +558,30 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     TC_METRIC_VALUE("processed_packets", processedPackets);
 
-    _recvQueue.readd(requeuePackets.begin(), requeuePackets.end());
+    _recvPending.insert(_recvPending.begin(), requeuePackets.begin(), requeuePackets.end());
+}
+
+void WorldSession::UpdateOutOfWorld()
+{
+    OutOfWorldSessionFilter updater(this);
+    ProcessReceivedPackets(updater);
+
+    FlushPackets();
+}
+
+/// Update the WorldSession (triggered by World update)
+bool WorldSession::Update(uint32 diff, PacketFilter& updater)
+{
+    ///- Before we process anything:
+    /// If necessary, kick the player because the client didn't send anything for too long
+    /// (or they've been idling in character select)
+    if (IsConnectionIdle() && !HasPermission(rbac::RBAC_PERM_IGNORE_IDLE_CONNECTION))
+        m_Socket[CONNECTION_TYPE_REALM]->CloseSocket();
+
+    ///- Retrieve packets from the receive queue and call the appropriate handlers
+    ProcessReceivedPackets(updater);
+
+    time_t currentTime = GameTime::GetGameTime();
 
     if (!updater.ProcessUnsafe()) // <=> updater is of type MapSessionFilter
     {
@@ -490,6 +597,11 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
     ProcessQueryCallbacks();
 
+    if (updater.ProcessUnsafe())
+        ProcessPendingLogin();
+
+    FlushPackets();
+
     //check if we are safe to proceed with logout
     //logout procedure should happen only in World::UpdateSessions() method!!!
     if (updater.ProcessUnsafe())
@@ -533,6 +645,16 @@ bool WorldSession::Update(uint32 diff, PacketFilter& updater)
 
 /// %Log the player out
 void WorldSession::LogoutPlayer(bool save)
+{
+    BeginLogout(save);
+
+    if (_player && save)
+        _player->SaveToDB();
+
+    FinishLogout();
+}
+
+void WorldSession::BeginLogout(bool save)
 {
     // finish pending transfers before starting the logout
     while (_player && _player->IsBeingTeleportedFar())
@@ -609,7 +731,7 @@ void WorldSession::LogoutPlayer(bool save)
 
         _player->FailQuestsWithFlag(QUEST_FLAGS_FAIL_ON_LOGOUT);
 
-        ///- empty buyback items and save the player in the database
+        ///- empty buyback items, the caller saves the player in the database before FinishLogout
         // some save parts only correctly work in case player present in map/player_lists (pets, etc)
         if (save)
         {
@@ -621,9 +743,14 @@ void WorldSession::LogoutPlayer(bool save)
                 _player->SetBuybackPrice(eslot, 0);
                 _player->SetBuybackTimestamp(eslot, 0);
             }
-            _player->SaveToDB();
         }
+    }
+}
 
+void WorldSession::FinishLogout()
+{
+    if (_player)
+    {
         ///- Leave all channels before player delete...
         _player->CleanupChannels();
 
@@ -980,6 +1107,7 @@ void WorldSession::ProcessQueryCallbacks()
     _queryProcessor.ProcessReadyCallbacks();
     _transactionCallbacks.ProcessReadyCallbacks();
     _queryHolderProcessor.ProcessReadyCallbacks();
+    _asyncTasks.ProcessReadyTasks();
 }
 
 TransactionCallback& WorldSession::AddTransactionCallback(TransactionCallback&& callback)
@@ -992,6 +1120,11 @@ SQLQueryHolderCallback& WorldSession::AddQueryHolderCallback(SQLQueryHolderCallb
     return _queryHolderProcessor.AddCallback(std::move(callback));
 }
 
+void WorldSession::StartAsyncTask(Trinity::Database::AsyncTask&& task)
+{
+    _asyncTasks.Start(std::move(task));
+}
+
 bool WorldSession::CanAccessAlliedRaces() const
 {
     return GetAccountExpansion() >= EXPANSION_BATTLE_FOR_AZEROTH;
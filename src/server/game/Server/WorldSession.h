@@ -25,10 +25,11 @@
 #include "Common.h"
 #include "AsyncCallbackProcessor.h"
 #include "AuthDefines.h"
+#include "DatabaseAwaitable.h"
 #include "DatabaseEnvFwd.h"
 #include "Duration.h"
 #include "IteratorPair.h"
-#include "LockedQueue.h"
+#include "MPSCQueue.h"
 #include "ObjectGuid.h"
 #include "Opcodes.h"
 #include "Optional.h"
@@ -37,13 +38,16 @@
 #include <boost/circular_buffer_fwd.hpp>
 #include <array>
 #include <atomic>
+#include <deque>
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 class BlackMarketEntry;
 class CollectionMgr;
 class Creature;
+class GarrisonLoginQueryHolder;
 class InstanceLock;
 class Item;
 class LoginQueryHolder;
@@ -66,6 +70,7 @@ struct Position;
 enum class AuctionCommand : int8;
 enum class AuctionResult : int8;
 enum InventoryResult : uint8;
+enum class PacketProcessingContext : uint8;
 enum class StableResult : uint8;
 enum class TabardVendorType : int32;
 
@@ -249,6 +254,7 @@ namespace WorldPackets
 
         class AlterApperance;
         class EnumCharacters;
+        class EnumCharactersResult;
         class CreateCharacter;
         class CharDelete;
         class CharacterRenameRequest;
@@ -929,6 +935,7 @@ public:
 
     virtual bool Process(WorldPacket* /*packet*/) { return true; }
     virtual bool ProcessUnsafe() const { return true; }
+    virtual PacketProcessingContext GetProcessingContext() const;
 
 protected:
     WorldSession* const m_pSession;
@@ -962,6 +969,26 @@ public:
     bool ProcessUnsafe() const override { return true; }
 };
 
+//process only packets that touch nothing but their own session while player is not in world
+//used by the session update threads in World::UpdateSessions(), everything else is left to WorldSessionFilter
+class OutOfWorldSessionFilter : public PacketFilter
+{
+public:
+    explicit OutOfWorldSessionFilter(WorldSession* pSession) : PacketFilter(pSession) { }
+    ~OutOfWorldSessionFilter() { }
+
+    bool Process(WorldPacket* packet) override;
+    bool ProcessUnsafe() const override { return false; }
+    PacketProcessingContext GetProcessingContext() const override;
+};
+
+// self only packets sent before a logging in player is added to the map, see Player::BuildInitialPackets
+struct PlayerInitialPackets
+{
+    std::vector<WorldPacket> Self;
+    std::vector<WorldPacket> Collections;
+};
+
 struct PacketCounter
 {
     time_t lastReceiveTime;
@@ -985,6 +1012,23 @@ class TC_GAME_API WorldSession
         bool IsAddonRegistered(std::string_view prefix) const;
 
         void SendPacket(WorldPacket const* packet, bool forced = false);
+        void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
+
+        /// Lets the sockets write everything sent so far when packet coalescing is enabled, called at the end of every tick that sends packets
+        void FlushPackets();
+
+        /// Packets the calling thread sends to the session while the scope is alive are stored in packets instead of being sent
+        /// Packets sent by other threads are not affected
+        class TC_GAME_API PacketCaptureScope
+        {
+        public:
+            PacketCaptureScope(WorldSession const* session, std::vector<WorldPacket>& packets);
+            ~PacketCaptureScope();
+
+            PacketCaptureScope(PacketCaptureScope const&) = delete;
+            PacketCaptureScope& operator=(PacketCaptureScope const&) = delete;
+        };
+
         void AddInstanceConnection(std::shared_ptr<WorldSocket> sock) { m_Socket[CONNECTION_TYPE_INSTANCE] = sock; }
 
         void SendNotification(char const* format, ...) ATTR_PRINTF(2, 3);
@@ -1048,6 +1092,10 @@ class TC_GAME_API WorldSession
         }
 
         void LogoutPlayer(bool save);
+        // LogoutPlayer split around the save, the caller has to save the player in between when save is true
+        // lets shutdown save all players at once
+        void BeginLogout(bool save);
+        void FinishLogout();
         void KickPlayer(std::string const& reason);
         // Returns true if all contained hyperlinks are valid
         // May kick player on false depending on world config (handler should abort)
@@ -1058,6 +1106,9 @@ class TC_GAME_API WorldSession
 
         void QueuePacket(WorldPacket* new_packet);
         bool Update(uint32 diff, PacketFilter& updater);
+        /// Handles packets of a session without a player in world that can run concurrently with other sessions
+        /// Query callbacks, logout and all other packets are still left to Update
+        void UpdateOutOfWorld();
 
         /// Handle the authentication waiting queue (to be completed)
         void SendAuthWaitQueue(uint32 position);
@@ -1072,6 +1123,7 @@ class TC_GAME_API WorldSession
         void SendListInventory(ObjectGuid guid);
         void SendShowBank(ObjectGuid guid);
         bool CanOpenMailBox(ObjectGuid guid);
+        void SendMailList(ObjectGuid mailbox);
         void SendShowMailBox(ObjectGuid guid);
         void SendTabardVendorActivate(ObjectGuid guid, TabardVendorType type);
         void SendSpiritResurrect();
@@ -1194,6 +1246,7 @@ class TC_GAME_API WorldSession
         void LogUnprocessedTail(WorldPacket const* packet);
 
         void HandleCharEnum(CharacterDatabaseQueryHolder const& holder);
+        void SendCharEnum(WorldPackets::Character::EnumCharactersResult& charEnum);
         void HandleCharEnumOpcode(WorldPackets::Character::EnumCharacters& /*enumCharacters*/);
         void HandleCharUndeleteEnumOpcode(WorldPackets::Character::EnumCharacters& /*enumCharacters*/);
         void HandleCharDeleteOpcode(WorldPackets::Character::CharDelete& charDelete);
@@ -1204,7 +1257,9 @@ class TC_GAME_API WorldSession
         void HandleContinuePlayerLogin();
         void AbortLogin(WorldPackets::Character::LoginFailureReason reason);
         void HandleLoadScreenOpcode(WorldPackets::Character::LoadingScreenNotify& loadingScreenNotify);
-        void HandlePlayerLogin(LoginQueryHolder const& holder);
+        void HandlePlayerLogin(std::shared_ptr<LoginQueryHolder const> holder, GarrisonLoginQueryHolder const* garrisonHolder);
+        void FinishPlayerLogin(Player* pCurrChar, LoginQueryHolder const& holder, PlayerInitialPackets const* initialPackets);
+        void ProcessPendingLogin();
         void HandleCheckCharacterNameAvailability(WorldPackets::Character::CheckCharacterNameAvailability& checkCharacterNameAvailability);
         void HandleCharRenameOpcode(WorldPackets::Character::CharacterRenameRequest& request);
         void HandleCharRenameCallBack(std::shared_ptr<WorldPackets::Character::CharacterRenameInfo> renameInfo, PreparedQueryResult result);
@@ -1220,6 +1275,7 @@ class TC_GAME_API WorldSession
         void HandleGetUndeleteCooldownStatus(WorldPackets::Character::GetUndeleteCharacterCooldownStatus& /*getCooldown*/);
         void HandleUndeleteCooldownStatusCallback(PreparedQueryResult result);
         void HandleCharUndeleteOpcode(WorldPackets::Character::UndeleteCharacter& undeleteInfo);
+        Trinity::Database::AsyncTask UndeleteCharacter(std::shared_ptr<WorldPackets::Character::CharacterUndeleteInfo> undeleteInfo);
         void HandleSavePersonalEmblem(WorldPackets::Character::SavePersonalEmblem const& savePersonalEmblem);
         bool MeetsChrCustomizationReq(ChrCustomizationReqEntry const* req, Races race, Classes playerClass,
             bool checkRequiredDependentChoices, Trinity::IteratorPair<UF::ChrCustomizationChoice const*> selectedChoices) const;
@@ -1329,6 +1385,7 @@ class TC_GAME_API WorldSession
 
         void HandleMovementOpcodes(WorldPackets::Movement::ClientPlayerMovement& packet);
         void HandleMovementOpcode(OpcodeClient opcode, MovementInfo& movementInfo);
+        void SendMovementHeartbeatToSet(Unit const* mover, WorldPacket const* data);
         void HandleSetActiveMoverOpcode(WorldPackets::Movement::SetActiveMover& packet);
         void HandleMoveDismissVehicle(WorldPackets::Vehicle::MoveDismissVehicle& moveDismissVehicle);
         void HandleRequestVehiclePrevSeat(WorldPackets::Vehicle::RequestVehiclePrevSeat& requestVehiclePrevSeat);
@@ -1877,6 +1934,8 @@ class TC_GAME_API WorldSession
         QueryCallbackProcessor& GetQueryProcessor() { return _queryProcessor; }
         TransactionCallback& AddTransactionCallback(TransactionCallback&& callback);
         SQLQueryHolderCallback& AddQueryHolderCallback(SQLQueryHolderCallback&& callback);
+        //! Runs task until its first co_await, the rest runs in the session update once the awaited result arrived
+        void StartAsyncTask(Trinity::Database::AsyncTask&& task);
 
     private:
         void ProcessQueryCallbacks();
@@ -1884,6 +1943,7 @@ class TC_GAME_API WorldSession
         QueryCallbackProcessor _queryProcessor;
         AsyncCallbackProcessor<TransactionCallback> _transactionCallbacks;
         AsyncCallbackProcessor<SQLQueryHolderCallback> _queryHolderProcessor;
+        Trinity::Database::AsyncTaskProcessor _asyncTasks;
 
     friend class World;
     protected:
@@ -1923,6 +1983,10 @@ class TC_GAME_API WorldSession
 
         // logging helper
         void LogUnexpectedOpcode(WorldPacket* packet, char const* status, const char *reason);
+        void ProcessReceivedPackets(PacketFilter& updater);
+
+        // validates an outgoing packet and returns the socket it should be sent on
+        WorldSocket* GetSocketForPacket(WorldPacket const* packet, bool forced);
 
         // EnumData helpers
         bool IsLegitCharacterForAccount(ObjectGuid lowGUID)
@@ -1959,6 +2023,16 @@ class TC_GAME_API WorldSession
         time_t _logoutTime;
         bool m_inQueue;                                     // session wait in auth.queue
         ObjectGuid m_playerLoading;                         // code processed in LoginPlayer
+
+        // login waiting for its initial packets to be built on a session update thread, the player is not set on the session meanwhile
+        struct PendingLogin
+        {
+            Player* LoadedPlayer = nullptr;
+            std::shared_ptr<LoginQueryHolder const> Holder;
+            PlayerInitialPackets Packets;
+            std::atomic<bool> Built = false;
+        };
+        std::shared_ptr<PendingLogin> _pendingLogin;
         bool m_playerLogout;                                // code processed in LogoutPlayer
         bool m_playerRecentlyLogout;
         bool m_playerSave;
@@ -1973,7 +2047,8 @@ class TC_GAME_API WorldSession
         bool _filterAddonMessages;
         uint32 recruiterId;
         bool isRecruiter;
-        LockedQueue<WorldPacket*> _recvQueue;
+        MPSCQueue<WorldPacket> _recvQueue;                    // filled by the network thread
+        std::deque<WorldPacket*> _recvPending;                // packets taken from _recvQueue, only touched by the thread updating the session
         rbac::RBACData* _RBACData;
         uint32 expireTime;
         bool forceExit;
@@ -1986,6 +2061,9 @@ class TC_GAME_API WorldSession
         uint32 _timeSyncNextCounter;
         uint32 _timeSyncTimer;
 
+        // counts relayed CMSG_MOVE_HEARTBEAT, far observers only get some of them (Movement.RelayLod.*)
+        uint32 _moveHeartbeatSequence;
+
         // Packets cooldown
         time_t _calendarEventCreationCooldown;
 
@@ -57,8 +57,9 @@ uint8 const WorldSocket::ContinuedSessionSeed[16] = { 0x16, 0xAD, 0x0C, 0xD4, 0x
 uint8 const WorldSocket::EncryptionKeySeed[16] = { 0xE9, 0x75, 0x3C, 0x50, 0x90, 0x93, 0x61, 0xDA, 0x3B, 0x07, 0xEE, 0xFA, 0xFF, 0x9D, 0x41, 0xB8 };
 
 WorldSocket::WorldSocket(boost::asio::ip::tcp::socket&& socket) : Socket(std::move(socket)),
-    _type(CONNECTION_TYPE_REALM), _key(0), _OverSpeedPings(0),
-    _worldSession(nullptr), _authed(false), _canRequestHotfixes(true), _sendBufferSize(4096), _compressionStream(nullptr)
+    _type(CONNECTION_TYPE_REALM), _key(0), _accountId(0), _OverSpeedPings(0),
+    _worldSession(nullptr), _authed(false), _canRequestHotfixes(true), _sendBufferSize(4096),
+    _queuedBytes(0), _flushRequested(false), _coalesceMaxDelay(0), _coalesceMaxSize(0), _compressionStream(nullptr)
 {
     Trinity::Crypto::GetRandomBytes(_serverChallenge);
     _sessionKey.fill(0);
@@ -198,29 +199,59 @@ void WorldSocket::InitializeHandler(boost::system::error_code const& error, std:
     AsyncReadWithCallback(&WorldSocket::InitializeHandler);
 }
 
+bool WorldSocket::ShouldWriteQueuedPackets()
+{
+    // only coalesce once authed, a session is then there to flush at the end of its tick
+    if (_coalesceMaxDelay <= 0ms || !_authed || !IsOpen())
+        return true;
+
+    if (!_queuedBytes.load(std::memory_order_relaxed))
+        return false;
+
+    if (_flushRequested.exchange(false, std::memory_order_acquire) || _queuedBytes.load(std::memory_order_relaxed) >= _coalesceMaxSize)
+        return true;
+
+    TimePoint now = std::chrono::steady_clock::now();
+    if (!_coalesceStart)
+        _coalesceStart = now;
+
+    return now - *_coalesceStart >= _coalesceMaxDelay;
+}
+
 bool WorldSocket::Update()
 {
     EncryptablePacket* queued;
-    MessageBuffer buffer(_sendBufferSize);
-    while (_bufferQueue.Dequeue(queued))
+    MessageBuffer buffer(0);
+    std::size_t writtenBytes = 0;
+    bool writeQueued = ShouldWriteQueuedPackets();
+    while (writeQueued && _bufferQueue.Dequeue(queued))
     {
-        uint32 packetSize = queued->size() + 2 /*opcode*/;
+        writtenBytes += queued->GetPacket().size();
+
+        uint32 packetSize = queued->GetPacket().size() + 2 /*opcode*/;
         if (packetSize > MinSizeForCompression && queued->NeedsEncryption())
             packetSize = deflateBound(_compressionStream, packetSize) + sizeof(CompressedWorldPacket);
 
         // Flush current buffer if too small for next packet
         if (buffer.GetRemainingSpace() < packetSize + sizeof(PacketHeader))
         {
-            QueuePacket(std::move(buffer));
-            buffer.Resize(_sendBufferSize);
+            if (buffer.GetActiveSize() > 0)
+            {
+                EncryptWrittenPackets();
+                QueuePacket(std::move(buffer));
+            }
+
+            if (packetSize + sizeof(PacketHeader) <= _sendBufferSize)
+                buffer = GetFreeWriteBuffer(_sendBufferSize);
         }
 
         if (buffer.GetRemainingSpace() >= packetSize + sizeof(PacketHeader))
             WritePacketToBuffer(*queued, buffer);
         else    // single packet larger than _sendBufferSize
         {
-            MessageBuffer packetBuffer(packetSize + sizeof(PacketHeader));
+            MessageBuffer packetBuffer = GetFreeWriteBuffer(packetSize + sizeof(PacketHeader));
             WritePacketToBuffer(*queued, packetBuffer);
+            EncryptWrittenPackets();
             QueuePacket(std::move(packetBuffer));
         }
 
@@ -228,7 +259,16 @@ bool WorldSocket::Update()
     }
 
     if (buffer.GetActiveSize() > 0)
+    {
+        EncryptWrittenPackets();
         QueuePacket(std::move(buffer));
+    }
+
+    if (writeQueued)
+    {
+        _queuedBytes.fetch_sub(writtenBytes, std::memory_order_relaxed);
+        _coalesceStart.reset();
+    }
 
     if (!BaseSocket::Update())
         return false;
@@ -372,7 +412,7 @@ WorldSocket::ReadDataHandlerResult WorldSocket::ReadDataHandler()
     packet.SetOpcode(opcode);
 
     if (sPacketLog->CanLogPacket())
-        sPacketLog->LogPacket(packet, CLIENT_TO_SERVER, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType());
+        sPacketLog->LogPacket(packet, CLIENT_TO_SERVER, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType(), _accountId);
 
     std::unique_lock<std::mutex> sessionGuard(_worldSessionLock, std::defer_lock);
 
@@ -529,13 +569,27 @@ void WorldSocket::SendPacket(WorldPacket const& packet)
         return;
 
     if (sPacketLog->CanLogPacket())
-        sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType());
+        sPacketLog->LogPacket(packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType(), _accountId);
+
+    _queuedBytes.fetch_add(packet.size(), std::memory_order_relaxed);
+    _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
+}
+
+void WorldSocket::SendPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
+    if (!IsOpen())
+        return;
+
+    if (sPacketLog->CanLogPacket())
+        sPacketLog->LogPacket(*packet, SERVER_TO_CLIENT, GetRemoteIpAddress(), GetRemotePort(), GetConnectionType(), _accountId);
 
+    _queuedBytes.fetch_add(packet->size(), std::memory_order_relaxed);
     _bufferQueue.Enqueue(new EncryptablePacket(packet, _authCrypt.IsInitialized()));
 }
 
-void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer)
+void WorldSocket::WritePacketToBuffer(EncryptablePacket const& queued, MessageBuffer& buffer)
 {
+    WorldPacket const& packet = queued.GetPacket();
     uint16 opcode = packet.GetOpcode();
     uint32 packetSize = packet.size();
 
@@ -545,7 +599,7 @@ void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBu
     uint8* dataPos = buffer.GetWritePointer();
     buffer.WriteCompleted(sizeof(opcode));
 
-    if (packetSize > MinSizeForCompression && packet.NeedsEncryption())
+    if (packetSize > MinSizeForCompression && queued.NeedsEncryption())
     {
         CompressedWorldPacket cmp;
         cmp.UncompressedSize = packetSize + 2;
@@ -571,11 +625,15 @@ void WorldSocket::WritePacketToBuffer(EncryptablePacket const& packet, MessageBu
     memcpy(dataPos, &opcode, sizeof(opcode));
     packetSize += 2 /*opcode*/;
 
-    PacketHeader header;
-    header.Size = packetSize;
-    _authCrypt.EncryptSend(dataPos, header.Size, header.Tag);
+    // tag is filled in by EncryptWrittenPackets
+    memcpy(headerPos + offsetof(PacketHeader, Size), &packetSize, sizeof(PacketHeader::Size));
+    _pendingEncryption.push_back({ .Data = dataPos, .Length = packetSize, .Tag = reinterpret_cast<Trinity::Crypto::AES::Tag*>(headerPos + offsetof(PacketHeader, Tag)) });
+}
 
-    memcpy(headerPos, &header, sizeof(PacketHeader));
+void WorldSocket::EncryptWrittenPackets()
+{
+    _authCrypt.EncryptSendBatch(_pendingEncryption);
+    _pendingEncryption.clear();
 }
 
 uint32 WorldSocket::CompressPacket(uint8* buffer, WorldPacket const& packet)
@@ -797,7 +855,7 @@ void WorldSocket::HandleAuthSessionCallback(std::shared_ptr<WorldPackets::Auth::
         return;
     }
 
-    if (IpLocationRecord const* location = sIPLocation->GetLocationRecord(address))
+    if (IpLocationRecord const* location = sIPLocation->GetLocationRecord(GetRemoteIpAddress()))
         _ipCountry = location->CountryCode;
 
     ///- Re-check ip locking (same check as in auth).
@@ -876,6 +934,7 @@ void WorldSocket::HandleAuthSessionCallback(std::shared_ptr<WorldPackets::Auth::
     sScriptMgr->OnAccountLogin(account.Game.Id);
 
     _authed = true;
+    _accountId = account.Game.Id;
     _worldSession = new WorldSession(account.Game.Id, std::move(authSession->RealmJoinTicket), account.BattleNet.Id, shared_from_this(), account.Game.Security,
         account.Game.Expansion, mutetime, account.Game.OS, account.Game.TimezoneOffset, account.BattleNet.Locale, account.Game.Recruiter, account.Game.IsRectuiter);
 
@@ -961,6 +1020,8 @@ void WorldSocket::HandleAuthContinuedSessionCallback(std::shared_ptr<WorldPacket
     // only first 16 bytes of the hmac are used
     memcpy(_encryptKey.data(), encryptKeyGen.GetDigest().data(), 16);
 
+    _accountId = accountId;
+
     SendPacketAndLogOpcode(*WorldPackets::Auth::EnterEncryptedMode(_encryptKey, true).Write());
     AsyncRead();
 }
@@ -22,12 +22,15 @@
 #include "AuthDefines.h"
 #include "DatabaseEnvFwd.h"
 #include "MessageBuffer.h"
+#include "Optional.h"
 #include "Socket.h"
 #include "WorldPacket.h"
 #include "WorldPacketCrypt.h"
 #include "MPSCQueue.h"
 #include <array>
+#include <atomic>
 #include <boost/asio/ip/tcp.hpp>
+#include <memory>
 #include <mutex>
 
 typedef struct z_stream_s z_stream;
@@ -37,19 +40,29 @@ class WorldSession;
 enum ConnectionType : int8;
 enum OpcodeClient : uint16;
 
-class EncryptablePacket : public WorldPacket
+class EncryptablePacket
 {
 public:
-    EncryptablePacket(WorldPacket const& packet, bool encrypt) : WorldPacket(packet), _encrypt(encrypt)
+    EncryptablePacket(WorldPacket const& packet, bool encrypt) : _ownedPacket(packet), _packet(&_ownedPacket), _encrypt(encrypt)
     {
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
+    // packet body shared by all recipients of a broadcast, never modified after queueing
+    EncryptablePacket(std::shared_ptr<WorldPacket const> packet, bool encrypt) : _sharedPacket(std::move(packet)), _packet(_sharedPacket.get()), _encrypt(encrypt)
+    {
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
+    WorldPacket const& GetPacket() const { return *_packet; }
     bool NeedsEncryption() const { return _encrypt; }
 
     std::atomic<EncryptablePacket*> SocketQueueLink;
 
 private:
+    WorldPacket _ownedPacket;
+    std::shared_ptr<WorldPacket const> _sharedPacket;
+    WorldPacket const* _packet;
     bool _encrypt;
 };
 
@@ -106,6 +119,7 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
 
     ConnectionType GetConnectionType() const { return _type; }
 
@@ -113,6 +127,13 @@ public:
     void SetWorldSession(WorldSession* session);
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
+    /// Holds queued packets until FlushPackets is called, maxSize bytes are queued or the oldest packet waited maxDelay
+    /// A zero maxDelay writes queued packets on every network thread update
+    void SetPacketCoalescing(Milliseconds maxDelay, std::size_t maxSize) { _coalesceMaxDelay = maxDelay; _coalesceMaxSize = maxSize; }
+
+    /// Called by the session at the end of its tick, wakes the network thread to write everything queued so far
+    void FlushPackets() { _flushRequested.store(true, std::memory_order_release); }
+
 protected:
     void OnClose() override;
     void ReadHandler() override;
@@ -135,7 +156,9 @@ private:
     void LogOpcodeText(OpcodeClient opcode, std::unique_lock<std::mutex> const& guard) const;
     /// sends and logs network.opcode without accessing WorldSession
     void SendPacketAndLogOpcode(WorldPacket const& packet);
-    void WritePacketToBuffer(EncryptablePacket const& packet, MessageBuffer& buffer);
+    bool ShouldWriteQueuedPackets();
+    void WritePacketToBuffer(EncryptablePacket const& queued, MessageBuffer& buffer);
+    void EncryptWrittenPackets();
     uint32 CompressPacket(uint8* buffer, WorldPacket const& packet);
 
     void HandleSendAuthSession();
@@ -150,6 +173,8 @@ private:
 
     ConnectionType _type;
     uint64 _key;
+    // known once authed, only used to filter packet logging
+    std::atomic<uint32> _accountId;
 
     std::array<uint8, 16> _serverChallenge;
     WorldPacketCrypt _authCrypt;
@@ -168,6 +193,14 @@ private:
     MessageBuffer _packetBuffer;
     MPSCQueue<EncryptablePacket, &EncryptablePacket::SocketQueueLink> _bufferQueue;
     std::size_t _sendBufferSize;
+    // packets written to send buffers by Update, encrypted together before the buffer is queued
+    std::vector<WorldPacketCrypt::SendRequest> _pendingEncryption;
+
+    std::atomic<std::size_t> _queuedBytes;
+    std::atomic<bool> _flushRequested;
+    Milliseconds _coalesceMaxDelay;
+    std::size_t _coalesceMaxSize;
+    Optional<TimePoint> _coalesceStart;
 
     z_stream* _compressionStream;
 
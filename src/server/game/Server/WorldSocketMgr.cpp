@@ -33,6 +33,7 @@ public:
     void SocketAdded(std::shared_ptr<WorldSocket> sock) override
     {
         sock->SetSendBufferSize(sWorldSocketMgr.GetApplicationSendBufferSize());
+        sock->SetPacketCoalescing(sWorldSocketMgr.GetPacketCoalescingMaxDelay(), sWorldSocketMgr.GetPacketCoalescingMaxSize());
         sScriptMgr->OnSocketOpen(sock);
     }
 
@@ -42,7 +43,8 @@ public:
     }
 };
 
-WorldSocketMgr::WorldSocketMgr() : BaseSocketMgr(), _instanceAcceptor(nullptr), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(65536), _tcpNoDelay(true)
+WorldSocketMgr::WorldSocketMgr() : BaseSocketMgr(), _instanceAcceptor(nullptr), _socketSystemSendBufferSize(-1), _socketApplicationSendBufferSize(65536), _tcpNoDelay(true),
+    _packetCoalescingMaxDelay(0), _packetCoalescingMaxSize(65536)
 {
 }
 
@@ -75,6 +77,11 @@ bool WorldSocketMgr::StartWorldNetwork(Trinity::Asio::IoContext& ioContext, std:
         return false;
     }
 
+    _packetCoalescingMaxDelay = Milliseconds(std::max(sConfigMgr->GetIntDefault("Network.CoalescePackets.MaxDelay", 0), 0));
+    _packetCoalescingMaxSize = std::max(sConfigMgr->GetIntDefault("Network.CoalescePackets.MaxSize", 65536), 1);
+
+    SetReusePortAcceptors(sConfigMgr->GetBoolDefault("Network.ReusePort", false));
+
     if (!BaseSocketMgr::StartNetwork(ioContext, bindIp, port, threadCount))
         return false;
 
@@ -100,7 +107,7 @@ bool WorldSocketMgr::StartWorldNetwork(Trinity::Asio::IoContext& ioContext, std:
 
     _instanceAcceptor->SetSocketFactory([this]() { return GetSocketForAccept(); });
 
-    _acceptor->AsyncAcceptWithCallback<&OnSocketAccept>();
+    AsyncAcceptWithCallback<&OnSocketAccept>();
     _instanceAcceptor->AsyncAcceptWithCallback<&OnSocketAccept>();
 
     sScriptMgr->OnNetworkStart();
@@ -24,6 +24,7 @@
 #ifndef __WORLDSOCKETMGR_H
 #define __WORLDSOCKETMGR_H
 
+#include "Duration.h"
 #include "SocketMgr.h"
 
 class WorldSocket;
@@ -47,6 +48,8 @@ public:
     void OnSocketOpen(boost::asio::ip::tcp::socket&& sock, uint32 threadIndex) override;
 
     std::size_t GetApplicationSendBufferSize() const { return _socketApplicationSendBufferSize; }
+    Milliseconds GetPacketCoalescingMaxDelay() const { return _packetCoalescingMaxDelay; }
+    std::size_t GetPacketCoalescingMaxSize() const { return _packetCoalescingMaxSize; }
 
 protected:
     WorldSocketMgr();
@@ -64,6 +67,8 @@ private:
     int32 _socketSystemSendBufferSize;
     int32 _socketApplicationSendBufferSize;
     bool _tcpNoDelay;
+    Milliseconds _packetCoalescingMaxDelay;
+    std::size_t _packetCoalescingMaxSize;
 };
 
 #define sWorldSocketMgr WorldSocketMgr::Instance()
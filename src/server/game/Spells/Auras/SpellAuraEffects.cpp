@@ -802,6 +802,7 @@ uint32 AuraEffect::GetTotalTicks() const
 
 void AuraEffect::ResetPeriodic(bool resetPeriodicTimer /*= false*/)
 {
+    GetBase()->ApplySkippedUpdateTime();
     _ticksDone = 0;
     if (resetPeriodicTimer)
     {
@@ -814,6 +815,7 @@ void AuraEffect::ResetPeriodic(bool resetPeriodicTimer /*= false*/)
 
 void AuraEffect::CalculatePeriodic(Unit* caster, bool resetPeriodicTimer /*= true*/, bool load /*= false*/)
 {
+    GetBase()->ApplySkippedUpdateTime();
     _period = GetSpellEffectInfo().ApplyAuraPeriod;
 
     // prepare periodics
@@ -1122,7 +1124,7 @@ void AuraEffect::ApplySpellMod(Unit* target, bool apply, AuraEffect const* trigg
 
 void AuraEffect::Update(uint32 diff, Unit* caster)
 {
-    if (!m_isPeriodic || (GetBase()->GetDuration() < 0 && !GetBase()->IsPassive() && !GetBase()->IsPermanent()))
+    if (!IsPeriodicTimerRunning())
         return;
 
     uint32 totalTicks = GetTotalTicks();
@@ -1148,6 +1150,49 @@ void AuraEffect::Update(uint32 diff, Unit* caster)
     }
 }
 
+void AuraEffect::SetAmount(int32 amount)
+{
+    _amount = amount;
+    m_canBeRecalculated = false;
+
+    // cached aggregates of this aura type on targets include the old amount
+    std::vector<AuraApplication*> effectApplications;
+    GetApplicationList(effectApplications);
+    for (AuraApplication* aurApp : effectApplications)
+        aurApp->GetTarget()->InvalidateAuraModifierCache(GetAuraType());
+}
+
+int32 AuraEffect::GetTimeUntilNextTick() const
+{
+    return _period - _periodicTimer;
+}
+
+int32 AuraEffect::GetPeriodicTimer() const
+{
+    // include owner update time that base aura has not applied to the timer yet
+    if (IsPeriodicTimerRunning())
+        return _periodicTimer + GetBase()->GetSkippedUpdateTime();
+
+    return _periodicTimer;
+}
+
+void AuraEffect::SetPeriodicTimer(int32 periodicTimer)
+{
+    GetBase()->ApplySkippedUpdateTime();
+    _periodicTimer = periodicTimer;
+}
+
+bool AuraEffect::IsPeriodicTimerRunning() const
+{
+    return m_isPeriodic && (GetBase()->GetDuration() >= 0 || GetBase()->IsPassive() || GetBase()->IsPermanent());
+}
+
+void AuraEffect::ApplySkippedUpdateTime(uint32 diff)
+{
+    if (IsPeriodicTimerRunning())
+        _periodicTimer += diff;
+}
+
 float AuraEffect::GetCritChanceFor(Unit const* caster, Unit const* target) const
 {
     return target->SpellCritChanceTaken(caster, nullptr, this, GetSpellInfo()->GetSchoolMask(), CalcPeriodicCritChance(caster), GetSpellInfo()->GetAttackType());
@@ -3567,6 +3612,7 @@ void AuraEffect::HandleAuraModStat(AuraApplication const* aurApp, uint8 mode, bo
     if (std::abs(spellGroupVal) >= std::abs(GetAmount()))
         return;
 
+    target->BeginStatUpdateBatch();
     for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
         // -1 or -2 is all stats (misc < -2 checked in function beginning)
@@ -3584,6 +3630,8 @@ void AuraEffect::HandleAuraModStat(AuraApplication const* aurApp, uint8 mode, bo
                 target->UpdateStatBuffMod(Stats(i));
         }
     }
+
+    target->EndStatUpdateBatch();
 }
 
 void AuraEffect::HandleModPercentStat(AuraApplication const* aurApp, uint8 mode, bool apply) const
@@ -3603,6 +3651,7 @@ void AuraEffect::HandleModPercentStat(AuraApplication const* aurApp, uint8 mode,
     if (target->GetTypeId() != TYPEID_PLAYER)
         return;
 
+    target->BeginStatUpdateBatch();
     for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
         if (GetMiscValue() == i || GetMiscValue() == -1)
@@ -3621,6 +3670,8 @@ void AuraEffect::HandleModPercentStat(AuraApplication const* aurApp, uint8 mode,
             }
         }
     }
+
+    target->EndStatUpdateBatch();
 }
 
 void AuraEffect::HandleModSpellDamagePercentFromStat(AuraApplication const* aurApp, uint8 mode, bool /*apply*/) const
@@ -3693,6 +3744,7 @@ void AuraEffect::HandleModTotalPercentStat(AuraApplication const* aurApp, uint8
     if (target->getDeathState() == CORPSE)
         zeroHealth = (target->GetHealth() == 0);
 
+    target->BeginStatUpdateBatch();
     for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
         if (GetMiscValueB() & 1 << i || !GetMiscValueB()) // 0 is also used for all stats
@@ -3713,6 +3765,8 @@ void AuraEffect::HandleModTotalPercentStat(AuraApplication const* aurApp, uint8
         }
     }
 
+    target->EndStatUpdateBatch();
+
     // recalculate current HP/MP after applying aura modifications (only for spells with SPELL_ATTR0_ABILITY 0x00000010 flag)
     // this check is total bullshit i think
     if ((GetMiscValueB() & 1 << STAT_STAMINA || !GetMiscValueB()) && (m_spellInfo->HasAttribute(SPELL_ATTR0_IS_ABILITY)))
@@ -3780,6 +3834,7 @@ void AuraEffect::HandleModStatBonusPercent(AuraApplication const* aurApp, uint8
     if (target->GetTypeId() != TYPEID_PLAYER)
         return;
 
+    target->BeginStatUpdateBatch();
     for (int32 i = STAT_STRENGTH; i < MAX_STATS; ++i)
     {
         if (GetMiscValue() == i || GetMiscValue() == -1)
@@ -3788,6 +3843,8 @@ void AuraEffect::HandleModStatBonusPercent(AuraApplication const* aurApp, uint8
             target->UpdateStatBuffMod(Stats(i));
         }
     }
+
+    target->EndStatUpdateBatch();
 }
 
 void AuraEffect::HandleOverrideSpellPowerByAttackPower(AuraApplication const* aurApp, uint8 mode, bool apply) const
@@ -57,12 +57,12 @@ class TC_GAME_API AuraEffect
         int32 GetMiscValue() const { return GetSpellEffectInfo().MiscValue; }
         AuraType GetAuraType() const { return GetSpellEffectInfo().ApplyAuraName; }
         int32 GetAmount() const { return _amount; }
-        void SetAmount(int32 amount) { _amount = amount; m_canBeRecalculated = false; }
+        void SetAmount(int32 amount);
 
         Optional<float> GetEstimatedAmount() const { return _estimatedAmount; }
 
-        int32 GetPeriodicTimer() const { return _periodicTimer; }
-        void SetPeriodicTimer(int32 periodicTimer) { _periodicTimer = periodicTimer; }
+        int32 GetPeriodicTimer() const;
+        void SetPeriodicTimer(int32 periodicTimer);
 
         int32 CalculateAmount(Unit* caster);
         static Optional<float> CalculateEstimatedAmount(Unit const* caster, Unit* target, SpellInfo const* spellInfo, SpellEffectInfo const& spellEffectInfo, int32 amount, uint8 stack, AuraEffect const* aurEff);
@@ -80,6 +80,7 @@ class TC_GAME_API AuraEffect
         void ApplySpellMod(Unit* target, bool apply, AuraEffect const* triggeredBy = nullptr);
 
         void Update(uint32 diff, Unit* caster);
+        int32 GetTimeUntilNextTick() const;
 
         uint32 GetTickNumber() const { return _ticksDone; }
         uint32 GetRemainingTicks() const { return GetTotalTicks() - _ticksDone; }
@@ -88,7 +89,9 @@ class TC_GAME_API AuraEffect
         void ResetTicks() { _ticksDone = 0; }
 
         bool IsPeriodic() const { return m_isPeriodic; }
-        void SetPeriodic(bool isPeriodic) { m_isPeriodic = isPeriodic; }
+        void SetPeriodic(bool isPeriodic) { GetBase()->ApplySkippedUpdateTime(); m_isPeriodic = isPeriodic; }
+        bool IsPeriodicTimerRunning() const;
+        void ApplySkippedUpdateTime(uint32 diff);
         bool IsAffectingSpell(SpellInfo const* spell) const;
         bool HasSpellClassMask() const { return !!GetSpellEffectInfo().SpellClassMask; }
 
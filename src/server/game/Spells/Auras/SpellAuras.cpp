@@ -19,6 +19,7 @@
 #include "CellImpl.h"
 #include "Containers.h"
 #include "DynamicObject.h"
+#include "GameTime.h"
 #include "GridNotifiersImpl.h"
 #include "Item.h"
 #include "ListUtils.h"
@@ -389,6 +390,9 @@ Aura* Aura::TryCreate(AuraCreateInfo& createInfo)
 
 Aura* Aura::Create(AuraCreateInfo& createInfo)
 {
+    // effects and applications are charged to auras too
+    TC_ALLOCATION_TAG_SCOPE(Auras);
+
     // try to get caster of aura
     if (!createInfo.CasterGUID.IsEmpty())
     {
@@ -456,11 +460,12 @@ Aura::Aura(AuraCreateInfo const& createInfo) :
 m_spellInfo(createInfo._spellInfo), m_castDifficulty(createInfo._castDifficulty), m_castId(createInfo._castId), m_casterGuid(createInfo.CasterGUID),
 m_castItemGuid(createInfo.CastItemGUID), m_castItemId(createInfo.CastItemId),
 m_castItemLevel(createInfo.CastItemLevel), m_spellVisual({ createInfo.Caster ? createInfo.Caster->GetCastSpellXSpellVisualId(createInfo._spellInfo) : createInfo._spellInfo->GetSpellXSpellVisualId(), 0 }),
-m_applyTime(GameTime::GetGameTime()), m_owner(createInfo._owner), m_timeCla(0), m_updateTargetMapInterval(0),
+m_applyTime(GameTime::GetGameTime()), m_owner(createInfo._owner), m_timeCla(0), m_updateTargetMapInterval(0), m_skippedUpdateTime(0), m_nextUpdateDue(0),
 m_casterLevel(createInfo.Caster ? createInfo.Caster->GetLevel() : m_spellInfo->SpellLevel), m_procCharges(0), m_stackAmount(1),
 m_isRemoved(false), m_isSingleTarget(false), m_isUsingCharges(false), m_dropEvent(nullptr),
 m_procCooldown(TimePoint::min()),
-m_lastProcAttemptTime(GameTime::Now() - Seconds(10)), m_lastProcSuccessTime(GameTime::Now() - Seconds(120)), m_scriptRef(this, NoopAuraDeleter())
+m_lastProcAttemptTime(GameTime::Now() - Seconds(10)), m_lastProcSuccessTime(GameTime::Now() - Seconds(120)), m_scriptHookMask(0),
+m_scriptRef(this, NoopAuraDeleter())
 {
     for (SpellPowerEntry const* power : m_spellInfo->PowerCosts)
         if (power && (power->ManaPerSecond != 0 || power->PowerPctPerSecond > 0.0f))
@@ -580,6 +585,7 @@ void Aura::_UnapplyForTarget(Unit* target, Unit* caster, AuraApplication* auraAp
     m_applications.erase(itr);
 
     _removedApplications.push_back(auraApp);
+    ApplySkippedUpdateTime();
 
     // reset cooldown state for spells
     if (caster && GetSpellInfo()->IsCooldownStartedOnEvent())
@@ -616,8 +622,14 @@ void Aura::UpdateTargetMap(Unit* caster, bool apply)
     if (IsRemoved())
         return;
 
+    ApplySkippedUpdateTime();
     m_updateTargetMapInterval = UPDATE_TARGET_MAP_INTERVAL;
 
+    // area auras of the same owner refresh their targets together so they can share a single grid search,
+    // owners are spread over the interval by guid
+    if (GetType() == UNIT_AURA_TYPE && GetSpellInfo()->HasAreaAuraEffect())
+        m_updateTargetMapInterval -= int32((GameTime::GetGameTimeMS() + GetOwner()->GetGUID().GetCounter()) % UPDATE_TARGET_MAP_INTERVAL);
+
     // fill up to date target list
     //                 target, effMask
     std::unordered_map<Unit*, uint32> targets;
@@ -774,6 +786,15 @@ void Aura::UpdateOwner(uint32 diff, WorldObject* owner)
 {
     ASSERT(owner == m_owner);
 
+    // no timer expires during this update, defer it until one does
+    if (m_skippedUpdateTime + diff < m_nextUpdateDue)
+    {
+        m_skippedUpdateTime += diff;
+        return;
+    }
+
+    diff += std::exchange(m_skippedUpdateTime, 0);
+
     Unit* caster = GetCaster();
     // Apply spellmods for channeled auras
     // used for example when triggered spell of spell:10 is modded
@@ -807,6 +828,51 @@ void Aura::UpdateOwner(uint32 diff, WorldObject* owner)
         modOwner->SetSpellModTakingSpell(modSpell, false);
 
     _DeleteRemovedApplications();
+
+    m_nextUpdateDue = CalcNextUpdateDue();
+}
+
+void Aura::ApplySkippedUpdateTime()
+{
+    m_nextUpdateDue = 0;
+
+    uint32 diff = std::exchange(m_skippedUpdateTime, 0);
+    if (!diff)
+        return;
+
+    // none of the timers could expire within skipped time, advance them without running any of the update logic
+    if (m_duration > 0)
+    {
+        m_duration -= diff;
+        if (m_timeCla)
+            m_timeCla -= diff;
+    }
+
+    m_updateTargetMapInterval -= diff;
+
+    for (AuraEffect* effect : GetAuraEffects())
+        if (effect)
+            effect->ApplySkippedUpdateTime(diff);
+}
+
+uint32 Aura::CalcNextUpdateDue() const
+{
+    if (IsRemoved())
+        return 0;
+
+    int32 due = m_updateTargetMapInterval;
+    if (m_duration > 0)
+    {
+        due = std::min(due, m_duration);
+        if (m_timeCla)
+            due = std::min(due, m_timeCla);
+    }
+
+    for (AuraEffect const* effect : GetAuraEffects())
+        if (effect && effect->IsPeriodicTimerRunning())
+            due = std::min(due, effect->GetTimeUntilNextTick());
+
+    return uint32(std::max(due, 0));
 }
 
 void Aura::Update(uint32 diff, Unit* caster)
@@ -902,12 +968,15 @@ void Aura::SetDuration(int32 duration, bool withMods)
             if (Player* modOwner = caster->GetSpellModOwner())
                 modOwner->ApplySpellMod(GetSpellInfo(), SpellModOp::Duration, duration);
 
+    ApplySkippedUpdateTime();
     m_duration = duration;
     SetNeedClientUpdateForTargets();
 }
 
 void Aura::RefreshDuration(bool withMods)
 {
+    ApplySkippedUpdateTime();
+
     Unit* caster = GetCaster();
     if (withMods && caster)
     {
@@ -1239,6 +1308,7 @@ AuraKey Aura::GenerateKey(uint32& recalculateMask) const
 
 void Aura::SetLoadedState(int32 maxDuration, int32 duration, int32 charges, uint8 stackAmount, uint32 recalculateMask, int32* amount)
 {
+    ApplySkippedUpdateTime();
     m_maxDuration = maxDuration;
     m_duration = duration;
     m_procCharges = charges;
@@ -2032,10 +2102,54 @@ void Aura::LoadScripts()
         TC_LOG_DEBUG("spells", "Aura::LoadScripts: Script `{}` for aura `{}` is loaded now", script->GetScriptName(), m_spellInfo->Id);
         script->Register();
     }
+
+    // collect registered hooks once so CallScript* functions for hooks no script uses are a single bit test
+    auto addHook = [&](AuraScriptHookType hookType, auto const& hookList)
+    {
+        if (hookList.size())
+            m_scriptHookMask |= UI64LIT(1) << hookType;
+    };
+
+    for (AuraScript* script : m_loadedScripts)
+    {
+        addHook(AURA_SCRIPT_HOOK_CHECK_AREA_TARGET, script->DoCheckAreaTarget);
+        addHook(AURA_SCRIPT_HOOK_DISPEL, script->OnDispel);
+        addHook(AURA_SCRIPT_HOOK_AFTER_DISPEL, script->AfterDispel);
+        addHook(AURA_SCRIPT_HOOK_ON_HEARTBEAT, script->OnHeartbeat);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_APPLY, script->OnEffectApply);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_AFTER_APPLY, script->AfterEffectApply);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_REMOVE, script->OnEffectRemove);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_AFTER_REMOVE, script->AfterEffectRemove);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_PERIODIC, script->OnEffectPeriodic);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_UPDATE_PERIODIC, script->OnEffectUpdatePeriodic);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_CALC_AMOUNT, script->DoEffectCalcAmount);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_CALC_PERIODIC, script->DoEffectCalcPeriodic);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_CALC_SPELLMOD, script->DoEffectCalcSpellMod);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_CALC_CRIT_CHANCE, script->DoEffectCalcCritChance);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_CALC_DAMAGE_AND_HEALING, script->DoEffectCalcDamageAndHealing);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_ABSORB, script->OnEffectAbsorb);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_ABSORB, script->OnEffectAbsorbHeal);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_AFTER_ABSORB, script->AfterEffectAbsorb);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_AFTER_ABSORB, script->AfterEffectAbsorbHeal);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_MANASHIELD, script->OnEffectManaShield);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_AFTER_MANASHIELD, script->AfterEffectManaShield);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_SPLIT, script->OnEffectSplit);
+        addHook(AURA_SCRIPT_HOOK_ENTER_LEAVE_COMBAT, script->OnEnterLeaveCombat);
+        addHook(AURA_SCRIPT_HOOK_CHECK_PROC, script->DoCheckProc);
+        addHook(AURA_SCRIPT_HOOK_CHECK_EFFECT_PROC, script->DoCheckEffectProc);
+        addHook(AURA_SCRIPT_HOOK_PREPARE_PROC, script->DoPrepareProc);
+        addHook(AURA_SCRIPT_HOOK_PROC, script->OnProc);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_PROC, script->OnEffectProc);
+        addHook(AURA_SCRIPT_HOOK_EFFECT_AFTER_PROC, script->AfterEffectProc);
+        addHook(AURA_SCRIPT_HOOK_AFTER_PROC, script->AfterProc);
+    }
 }
 
 bool Aura::CallScriptCheckAreaTargetHandlers(Unit* target)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_CHECK_AREA_TARGET))
+        return true;
+
     bool result = true;
     for (AuraScript* script : m_loadedScripts)
     {
@@ -2050,6 +2164,9 @@ bool Aura::CallScriptCheckAreaTargetHandlers(Unit* target)
 
 void Aura::CallScriptDispel(DispelInfo* dispelInfo)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_DISPEL))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_DISPEL);
@@ -2062,6 +2179,9 @@ void Aura::CallScriptDispel(DispelInfo* dispelInfo)
 
 void Aura::CallScriptAfterDispel(DispelInfo* dispelInfo)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_AFTER_DISPEL))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_AFTER_DISPEL);
@@ -2074,6 +2194,9 @@ void Aura::CallScriptAfterDispel(DispelInfo* dispelInfo)
 
 void Aura::CallScriptOnHeartbeat()
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_ON_HEARTBEAT))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_ON_HEARTBEAT);
@@ -2086,6 +2209,9 @@ void Aura::CallScriptOnHeartbeat()
 
 bool Aura::CallScriptEffectApplyHandlers(AuraEffect const* aurEff, AuraApplication const* aurApp, AuraEffectHandleModes mode)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_APPLY))
+        return false;
+
     bool preventDefault = false;
     for (AuraScript* script : m_loadedScripts)
     {
@@ -2105,6 +2231,9 @@ bool Aura::CallScriptEffectApplyHandlers(AuraEffect const* aurEff, AuraApplicati
 
 bool Aura::CallScriptEffectRemoveHandlers(AuraEffect const* aurEff, AuraApplication const* aurApp, AuraEffectHandleModes mode)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_REMOVE))
+        return false;
+
     bool preventDefault = false;
     for (AuraScript* script : m_loadedScripts)
     {
@@ -2123,6 +2252,9 @@ bool Aura::CallScriptEffectRemoveHandlers(AuraEffect const* aurEff, AuraApplicat
 
 void Aura::CallScriptAfterEffectApplyHandlers(AuraEffect const* aurEff, AuraApplication const* aurApp, AuraEffectHandleModes mode)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_AFTER_APPLY))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_AFTER_APPLY, aurApp);
@@ -2136,6 +2268,9 @@ void Aura::CallScriptAfterEffectApplyHandlers(AuraEffect const* aurEff, AuraAppl
 
 void Aura::CallScriptAfterEffectRemoveHandlers(AuraEffect const* aurEff, AuraApplication const* aurApp, AuraEffectHandleModes mode)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_AFTER_REMOVE))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_AFTER_REMOVE, aurApp);
@@ -2149,6 +2284,9 @@ void Aura::CallScriptAfterEffectRemoveHandlers(AuraEffect const* aurEff, AuraApp
 
 bool Aura::CallScriptEffectPeriodicHandlers(AuraEffect const* aurEff, AuraApplication const* aurApp)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_PERIODIC))
+        return false;
+
     bool preventDefault = false;
     for (AuraScript* script : m_loadedScripts)
     {
@@ -2168,6 +2306,9 @@ bool Aura::CallScriptEffectPeriodicHandlers(AuraEffect const* aurEff, AuraApplic
 
 void Aura::CallScriptEffectUpdatePeriodicHandlers(AuraEffect* aurEff)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_UPDATE_PERIODIC))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_UPDATE_PERIODIC);
@@ -2181,6 +2322,9 @@ void Aura::CallScriptEffectUpdatePeriodicHandlers(AuraEffect* aurEff)
 
 void Aura::CallScriptEffectCalcAmountHandlers(AuraEffect const* aurEff, int32& amount, bool& canBeRecalculated)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_CALC_AMOUNT))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_CALC_AMOUNT);
@@ -2194,6 +2338,9 @@ void Aura::CallScriptEffectCalcAmountHandlers(AuraEffect const* aurEff, int32& a
 
 void Aura::CallScriptEffectCalcPeriodicHandlers(AuraEffect const* aurEff, bool& isPeriodic, int32& amplitude)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_CALC_PERIODIC))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_CALC_PERIODIC);
@@ -2207,6 +2354,9 @@ void Aura::CallScriptEffectCalcPeriodicHandlers(AuraEffect const* aurEff, bool&
 
 void Aura::CallScriptEffectCalcSpellModHandlers(AuraEffect const* aurEff, SpellModifier*& spellMod)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_CALC_SPELLMOD))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_CALC_SPELLMOD);
@@ -2220,6 +2370,9 @@ void Aura::CallScriptEffectCalcSpellModHandlers(AuraEffect const* aurEff, SpellM
 
 void Aura::CallScriptEffectCalcCritChanceHandlers(AuraEffect const* aurEff, AuraApplication const* aurApp, Unit const* victim, float& critChance)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_CALC_CRIT_CHANCE))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_CALC_CRIT_CHANCE, aurApp);
@@ -2233,6 +2386,9 @@ void Aura::CallScriptEffectCalcCritChanceHandlers(AuraEffect const* aurEff, Aura
 
 void Aura::CallScriptCalcDamageAndHealingHandlers(AuraEffect const* aurEff, AuraApplication const* aurApp, Unit* victim, int32& damageOrHealing, int32& flatMod, float& pctMod)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_CALC_DAMAGE_AND_HEALING))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_CALC_DAMAGE_AND_HEALING, aurApp);
@@ -2246,6 +2402,9 @@ void Aura::CallScriptCalcDamageAndHealingHandlers(AuraEffect const* aurEff, Aura
 
 void Aura::CallScriptEffectAbsorbHandlers(AuraEffect* aurEff, AuraApplication const* aurApp, DamageInfo& dmgInfo, uint32& absorbAmount, bool& defaultPrevented)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_ABSORB))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_ABSORB, aurApp);
@@ -2262,6 +2421,9 @@ void Aura::CallScriptEffectAbsorbHandlers(AuraEffect* aurEff, AuraApplication co
 
 void Aura::CallScriptEffectAfterAbsorbHandlers(AuraEffect* aurEff, AuraApplication const* aurApp, DamageInfo& dmgInfo, uint32& absorbAmount)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_AFTER_ABSORB))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_AFTER_ABSORB, aurApp);
@@ -2275,6 +2437,9 @@ void Aura::CallScriptEffectAfterAbsorbHandlers(AuraEffect* aurEff, AuraApplicati
 
 void Aura::CallScriptEffectAbsorbHandlers(AuraEffect* aurEff, AuraApplication const* aurApp, HealInfo& healInfo, uint32& absorbAmount, bool& defaultPrevented)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_ABSORB))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_ABSORB, aurApp);
@@ -2291,6 +2456,9 @@ void Aura::CallScriptEffectAbsorbHandlers(AuraEffect* aurEff, AuraApplication co
 
 void Aura::CallScriptEffectAfterAbsorbHandlers(AuraEffect* aurEff, AuraApplication const* aurApp, HealInfo& healInfo, uint32& absorbAmount)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_AFTER_ABSORB))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_AFTER_ABSORB, aurApp);
@@ -2304,6 +2472,9 @@ void Aura::CallScriptEffectAfterAbsorbHandlers(AuraEffect* aurEff, AuraApplicati
 
 void Aura::CallScriptEffectManaShieldHandlers(AuraEffect* aurEff, AuraApplication const* aurApp, DamageInfo& dmgInfo, uint32& absorbAmount, bool& defaultPrevented)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_MANASHIELD))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_MANASHIELD, aurApp);
@@ -2320,6 +2491,9 @@ void Aura::CallScriptEffectManaShieldHandlers(AuraEffect* aurEff, AuraApplicatio
 
 void Aura::CallScriptEffectAfterManaShieldHandlers(AuraEffect* aurEff, AuraApplication const* aurApp, DamageInfo& dmgInfo, uint32& absorbAmount)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_AFTER_MANASHIELD))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_AFTER_MANASHIELD, aurApp);
@@ -2333,6 +2507,9 @@ void Aura::CallScriptEffectAfterManaShieldHandlers(AuraEffect* aurEff, AuraAppli
 
 void Aura::CallScriptEffectSplitHandlers(AuraEffect* aurEff, AuraApplication const* aurApp, DamageInfo& dmgInfo, uint32& splitAmount)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_SPLIT))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_SPLIT, aurApp);
@@ -2346,6 +2523,9 @@ void Aura::CallScriptEffectSplitHandlers(AuraEffect* aurEff, AuraApplication con
 
 void Aura::CallScriptEnterLeaveCombatHandlers(AuraApplication const* aurApp, bool isNowInCombat)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_ENTER_LEAVE_COMBAT))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_ENTER_LEAVE_COMBAT, aurApp);
@@ -2358,6 +2538,9 @@ void Aura::CallScriptEnterLeaveCombatHandlers(AuraApplication const* aurApp, boo
 
 bool Aura::CallScriptCheckProcHandlers(AuraApplication const* aurApp, ProcEventInfo& eventInfo)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_CHECK_PROC))
+        return true;
+
     bool result = true;
     for (AuraScript* script : m_loadedScripts)
     {
@@ -2373,6 +2556,9 @@ bool Aura::CallScriptCheckProcHandlers(AuraApplication const* aurApp, ProcEventI
 
 bool Aura::CallScriptPrepareProcHandlers(AuraApplication const* aurApp, ProcEventInfo& eventInfo)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_PREPARE_PROC))
+        return true;
+
     bool prepare = true;
     for (AuraScript* script : m_loadedScripts)
     {
@@ -2391,6 +2577,9 @@ bool Aura::CallScriptPrepareProcHandlers(AuraApplication const* aurApp, ProcEven
 
 bool Aura::CallScriptProcHandlers(AuraApplication const* aurApp, ProcEventInfo& eventInfo)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_PROC))
+        return false;
+
     bool handled = false;
     for (AuraScript* script : m_loadedScripts)
     {
@@ -2407,6 +2596,9 @@ bool Aura::CallScriptProcHandlers(AuraApplication const* aurApp, ProcEventInfo&
 
 void Aura::CallScriptAfterProcHandlers(AuraApplication const* aurApp, ProcEventInfo& eventInfo)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_AFTER_PROC))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_AFTER_PROC, aurApp);
@@ -2419,6 +2611,9 @@ void Aura::CallScriptAfterProcHandlers(AuraApplication const* aurApp, ProcEventI
 
 bool Aura::CallScriptCheckEffectProcHandlers(AuraEffect const* aurEff, AuraApplication const* aurApp, ProcEventInfo& eventInfo)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_CHECK_EFFECT_PROC))
+        return true;
+
     bool result = true;
     for (AuraScript* script : m_loadedScripts)
     {
@@ -2435,6 +2630,9 @@ bool Aura::CallScriptCheckEffectProcHandlers(AuraEffect const* aurEff, AuraAppli
 
 bool Aura::CallScriptEffectProcHandlers(AuraEffect* aurEff, AuraApplication const* aurApp, ProcEventInfo& eventInfo)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_PROC))
+        return false;
+
     bool preventDefault = false;
     for (AuraScript* script : m_loadedScripts)
     {
@@ -2453,6 +2651,9 @@ bool Aura::CallScriptEffectProcHandlers(AuraEffect* aurEff, AuraApplication cons
 
 void Aura::CallScriptAfterEffectProcHandlers(AuraEffect* aurEff, AuraApplication const* aurApp, ProcEventInfo& eventInfo)
 {
+    if (!HasScriptHook(AURA_SCRIPT_HOOK_EFFECT_AFTER_PROC))
+        return;
+
     for (AuraScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(AURA_SCRIPT_HOOK_EFFECT_AFTER_PROC, aurApp);
@@ -2507,6 +2708,33 @@ void UnitAura::Remove(AuraRemoveMode removeMode)
     GetUnitOwner()->RemoveOwnedAura(this, removeMode);
 }
 
+// area auras of one owner updating their targets in the same aura update pass search around it only once
+static Unit::AreaAuraTargetCandidates* GetAreaAuraTargetCandidates(Unit* owner, float radius, uint32 containerTypeMask)
+{
+    Unit::AreaAuraTargetCandidates* candidates = owner->GetAreaAuraTargetCandidates();
+    if (!candidates)
+        return nullptr;
+
+    // search again when a wider area or more object types are needed than the previous search covered or the owner moved meanwhile
+    if (radius > candidates->Radius || (containerTypeMask & ~candidates->TypeMask) || owner->GetExactDistSq(candidates->Center) != 0.0f)
+    {
+        candidates->Center.Relocate(owner->GetPosition());
+        candidates->Radius = std::max(candidates->Radius, radius);
+        candidates->TypeMask |= containerTypeMask;
+        candidates->Objects.clear();
+
+        auto collector = [candidates](auto* object)
+        {
+            candidates->Objects.emplace_back(object, Trinity::GridMapTypeMaskForType<std::remove_pointer_t<decltype(object)>>::value);
+        };
+        Trinity::WorldObjectWorker<decltype(collector)> worker(owner, collector, candidates->TypeMask);
+        worker.i_phaseShift = &PhasingHandler::GetAlwaysVisiblePhaseShift();
+        Spell::SearchTargets(worker, candidates->TypeMask, owner, owner, candidates->Radius);
+    }
+
+    return candidates;
+}
+
 void UnitAura::FillTargetMap(std::unordered_map<Unit*, uint32>& targets, Unit* caster)
 {
     if (GetSpellInfo()->HasAttribute(SPELL_ATTR7_DISABLE_AURA_WHILE_DEAD) && !GetUnitOwner()->IsAlive())
@@ -2603,9 +2831,18 @@ void UnitAura::FillTargetMap(std::unordered_map<Unit*, uint32>& targets, Unit* c
             if (uint32 containerTypeMask = Spell::GetSearcherTypeMask(m_spellInfo, spellEffectInfo, TARGET_OBJECT_TYPE_UNIT, condList))
             {
                 Trinity::WorldObjectSpellAreaTargetCheck check(radius, GetUnitOwner(), ref, GetUnitOwner(), m_spellInfo, selectionType, condList, TARGET_OBJECT_TYPE_UNIT);
-                Trinity::WorldObjectListSearcher searcher(GetUnitOwner(), units, check, containerTypeMask);
-                searcher.i_phaseShift = &PhasingHandler::GetAlwaysVisiblePhaseShift();
-                Spell::SearchTargets(searcher, containerTypeMask, GetUnitOwner(), GetUnitOwner(), radius + extraSearchRadius);
+                if (Unit::AreaAuraTargetCandidates* candidates = GetAreaAuraTargetCandidates(GetUnitOwner(), radius + extraSearchRadius, containerTypeMask))
+                {
+                    for (auto const& [object, gridMapTypeMask] : candidates->Objects)
+                        if ((gridMapTypeMask & containerTypeMask) && object->IsInWorld() && check(object))
+                            units.push_back(object);
+                }
+                else
+                {
+                    Trinity::WorldObjectListSearcher searcher(GetUnitOwner(), units, check, containerTypeMask);
+                    searcher.i_phaseShift = &PhasingHandler::GetAlwaysVisiblePhaseShift();
+                    Spell::SearchTargets(searcher, containerTypeMask, GetUnitOwner(), GetUnitOwner(), radius + extraSearchRadius);
+                }
 
                 // by design WorldObjectSpellAreaTargetCheck allows not-in-world units (for spells) but for auras it is not acceptable
                 Trinity::Containers::EraseIf(units, [this](WorldObject const* unit) { return !unit->IsSelfOrInSameMap(GetUnitOwner()); });
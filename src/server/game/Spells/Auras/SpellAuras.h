@@ -18,6 +18,7 @@
 #ifndef TRINITY_SPELLAURAS_H
 #define TRINITY_SPELLAURAS_H
 
+#include "AllocationTracker.h"
 #include "SpellAuraDefines.h"
 #include "SpellInfo.h"
 #include "UniqueTrackablePtr.h"
@@ -131,6 +132,8 @@ class TC_GAME_API Aura
         void SaveCasterInfo(Unit* caster);
         virtual ~Aura();
 
+        TC_ALLOCATION_TAGGED_CLASS(Auras)
+
         SpellInfo const* GetSpellInfo() const { return m_spellInfo; }
         uint32 GetId() const{ return GetSpellInfo()->Id; }
         Difficulty GetCastDifficulty() const { return m_castDifficulty; }
@@ -163,14 +166,16 @@ class TC_GAME_API Aura
 
         void UpdateOwner(uint32 diff, WorldObject* owner);
         void Update(uint32 diff, Unit* caster);
+        uint32 GetSkippedUpdateTime() const { return m_skippedUpdateTime; }
+        void ApplySkippedUpdateTime();
 
         time_t GetApplyTime() const { return m_applyTime; }
         int32 GetMaxDuration() const { return m_maxDuration; }
-        void SetMaxDuration(int32 duration) { m_maxDuration = duration; }
+        void SetMaxDuration(int32 duration) { ApplySkippedUpdateTime(); m_maxDuration = duration; }
         int32 CalcMaxDuration() const { return CalcMaxDuration(GetCaster()); }
         int32 CalcMaxDuration(Unit* caster) const;
         static int32 CalcMaxDuration(SpellInfo const* spellInfo, WorldObject const* caster, std::vector<SpellPowerCost> const* powerCosts);
-        int32 GetDuration() const { return m_duration; }
+        int32 GetDuration() const { return m_duration > 0 ? std::max(m_duration - int32(m_skippedUpdateTime), 0) : m_duration; }
         void SetDuration(int32 duration, bool withMods = false);
         void RefreshDuration(bool withMods = false);
         void RefreshTimers(bool resetPeriodicTimer);
@@ -322,6 +327,8 @@ class TC_GAME_API Aura
     private:
         AuraScript* GetScriptByType(std::type_info const& type) const;
         void _DeleteRemovedApplications();
+        uint32 CalcNextUpdateDue() const;
+        bool HasScriptHook(uint32 hookType) const { return (m_scriptHookMask & (UI64LIT(1) << hookType)) != 0; }
 
     protected:
         SpellInfo const* const m_spellInfo;
@@ -340,6 +347,8 @@ class TC_GAME_API Aura
         int32 m_timeCla;                                    // Timer for power per sec calcultion
         std::vector<SpellPowerEntry const*> m_periodicCosts;// Periodic costs
         int32 m_updateTargetMapInterval;                    // Timer for UpdateTargetMapOfEffect
+        uint32 m_skippedUpdateTime;                         // Owner update time not yet applied to the timers above and effect periodic timers
+        uint32 m_nextUpdateDue;                             // Time after the last full update at which the earliest timer expires, 0 forces next update
 
         uint8 const m_casterLevel;                          // Aura level (store caster level for correct show level dep amount)
         uint8 m_procCharges;                                // Aura charges (0 for infinite)
@@ -362,6 +371,8 @@ class TC_GAME_API Aura
 
         AuraEffectVector _effects;
 
+        uint64 m_scriptHookMask;                            // AuraScriptHookType bits with a handler registered by any loaded script
+
         struct NoopAuraDeleter { void operator()(Aura*) const { /*noop - not managed*/ } };
         Trinity::unique_trackable_ptr<Aura> m_scriptRef;
 };
@@ -16,6 +16,7 @@
  */
 
 #include "Spell.h"
+#include "AllocationTracker.h"
 #include "AzeriteEmpoweredItem.h"
 #include "Battlefield.h"
 #include "BattlefieldMgr.h"
@@ -59,6 +60,7 @@
 #include "SpellPackets.h"
 #include "SpellScript.h"
 #include "TemporarySummon.h"
+#include "ThreadLocalPool.h"
 #include "TradeData.h"
 #include "TraitPackets.h"
 #include "UniqueTrackablePtr.h"
@@ -493,6 +495,9 @@ public:
     void Abort(uint64 e_time) override;
     bool IsDeletable() const override;
     Spell const* GetSpell() const { return m_Spell.get(); }
+
+    static void* operator new(std::size_t size) { return Trinity::ThreadLocalAllocationPool<SpellEvent>::Allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) noexcept { Trinity::ThreadLocalAllocationPool<SpellEvent>::Deallocate(ptr, size); }
     Trinity::unique_weak_ptr<Spell> GetSpellWeakPtr() const { return m_Spell; }
 
     std::string GetDebugInfo() const { return m_Spell->GetDebugInfo(); }
@@ -506,6 +511,10 @@ Spell::Spell(WorldObject* caster, SpellInfo const* info, TriggerCastFlags trigge
 m_spellInfo(info), m_caster((info->HasAttribute(SPELL_ATTR6_ORIGINATE_FROM_CONTROLLER) && caster->GetCharmerOrOwner()) ? caster->GetCharmerOrOwner() : caster),
 m_spellValue(new SpellValue(m_spellInfo, caster)), _spellEvent(nullptr)
 {
+    // target containers keep the capacity they had in previously destroyed spells
+    m_UniqueTargetInfo = Trinity::ThreadLocalVectorPool<TargetInfo>::Acquire();
+    m_UniqueGOTargetInfo = Trinity::ThreadLocalVectorPool<GOTargetInfo>::Acquire();
+
     m_customError = SPELL_CUSTOM_ERROR_NONE;
     m_fromClient = false;
     m_selfContainer = nullptr;
@@ -602,6 +611,10 @@ m_spellValue(new SpellValue(m_spellInfo, caster)), _spellEvent(nullptr)
     m_immediateHandled = false;
 
     m_channelTargetEffectMask = 0;
+    m_areaTargetCandidateTypeMask = 0;
+    m_areaTargetCandidateRadius = -1.0f;
+    m_scriptHookMask = 0;
+    std::fill(std::begin(m_scriptEffectHandlerMask), std::end(m_scriptEffectHandlerMask), 0);
 
     if (m_spellInfo->IsEmpowerSpell())
         m_empower = std::make_unique<EmpowerData>();
@@ -638,6 +651,20 @@ Spell::~Spell()
         ASSERT(m_caster->ToPlayer()->m_spellModTakingSpell != this);
 
     delete m_spellValue;
+
+    Trinity::ThreadLocalVectorPool<TargetInfo>::Release(std::move(m_UniqueTargetInfo));
+    Trinity::ThreadLocalVectorPool<GOTargetInfo>::Release(std::move(m_UniqueGOTargetInfo));
+}
+
+void* Spell::operator new(std::size_t size)
+{
+    TC_ALLOCATION_TAG_SCOPE(Spells);
+    return Trinity::ThreadLocalAllocationPool<Spell>::Allocate(size);
+}
+
+void Spell::operator delete(void* ptr, std::size_t size) noexcept
+{
+    Trinity::ThreadLocalAllocationPool<Spell>::Deallocate(ptr, size);
 }
 
 void Spell::InitExplicitTargets(SpellCastTargets const& targets)
@@ -744,6 +771,8 @@ void Spell::SelectSpellTargets()
     // select targets for cast phase
     SelectExplicitTargets();
 
+    m_areaTargetCandidates.clear();
+
     uint32 processedAreaEffectsMask = 0;
 
     for (SpellEffectInfo const& spellEffectInfo : m_spellInfo->GetEffects())
@@ -1315,7 +1344,7 @@ void Spell::SelectImplicitConeTargets(SpellEffectInfo const& spellEffectInfo, Sp
             break;
     }
 
-    std::list<WorldObject*> targets;
+    Trinity::GridSearchResult<WorldObject*> targets;
     SpellTargetObjectTypes objectType = targetType.GetObjectType();
     SpellTargetCheckTypes selectionType = targetType.GetCheckType();
     ConditionContainer* condList = spellEffectInfo.ImplicitTargetConditions.get();
@@ -1405,7 +1434,7 @@ void Spell::SelectImplicitAreaTargets(SpellEffectInfo const& spellEffectInfo, Sp
     }
 
     float radius = spellEffectInfo.CalcRadius(m_caster, targetIndex) * m_spellValue->RadiusMod;
-    std::list<WorldObject*> targets;
+    Trinity::GridSearchResult<WorldObject*> targets;
     switch (targetType.GetTarget())
     {
         case TARGET_UNIT_CASTER_AND_PASSENGERS:
@@ -1463,7 +1492,7 @@ void Spell::SelectImplicitAreaTargets(SpellEffectInfo const& spellEffectInfo, Sp
     CallScriptObjectAreaTargetSelectHandlers(targets, spellEffectInfo.EffectIndex, targetType);
 
     if (targetType.GetTarget() == TARGET_UNIT_SRC_AREA_FURTHEST_ENEMY)
-        targets.sort(Trinity::ObjectDistanceOrderPred(referer, false));
+        std::sort(targets.begin(), targets.end(), Trinity::ObjectDistanceOrderPred(referer, false));
 
     if (!targets.empty())
     {
@@ -1846,7 +1875,7 @@ void Spell::SelectImplicitChainTargets(SpellEffectInfo const& spellEffectInfo, S
                 m_damageMultipliers[k] = 1.0f;
         m_applyMultiplierMask |= effMask;
 
-        std::list<WorldObject*> targets;
+        Trinity::GridSearchResult<WorldObject*> targets;
         SearchChainTargets(targets, maxTargets - 1, target, targetType.GetObjectType(), targetType.GetCheckType()
             , spellEffectInfo, targetType.GetTarget() == TARGET_UNIT_TARGET_CHAINHEAL_ALLY);
 
@@ -1855,7 +1884,7 @@ void Spell::SelectImplicitChainTargets(SpellEffectInfo const& spellEffectInfo, S
 
         Position const* losPosition = m_spellInfo->HasAttribute(SPELL_ATTR2_CHAIN_FROM_CASTER) ? m_caster : target;
 
-        for (std::list<WorldObject*>::iterator itr = targets.begin(); itr != targets.end(); ++itr)
+        for (auto itr = targets.begin(); itr != targets.end(); ++itr)
         {
             if (Unit* unit = (*itr)->ToUnit())
                 AddUnitTarget(unit, effMask, false, true, losPosition);
@@ -1891,14 +1920,14 @@ void Spell::SelectImplicitTrajTargets(SpellEffectInfo const& spellEffectInfo, Sp
     srcPos.SetOrientation(m_caster->GetOrientation());
     float srcToDestDelta = m_targets.GetDstPos()->m_positionZ - srcPos.m_positionZ;
 
-    std::list<WorldObject*> targets;
+    Trinity::GridSearchResult<WorldObject*> targets;
     Trinity::WorldObjectSpellTrajTargetCheck check(dist2d, &srcPos, m_caster, m_spellInfo, targetType.GetCheckType(), spellEffectInfo.ImplicitTargetConditions.get(), TARGET_OBJECT_TYPE_NONE);
     Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellTrajTargetCheck> searcher(m_caster, targets, check, GRID_MAP_TYPE_MASK_ALL);
     SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellTrajTargetCheck> > (searcher, GRID_MAP_TYPE_MASK_ALL, m_caster, &srcPos, dist2d);
     if (targets.empty())
         return;
 
-    targets.sort(Trinity::ObjectDistanceOrderPred(m_caster));
+    std::sort(targets.begin(), targets.end(), Trinity::ObjectDistanceOrderPred(m_caster));
 
     float b = tangent(m_targets.GetPitch());
     float a = (srcToDestDelta - dist2d * b) / (dist2d * dist2d);
@@ -1966,7 +1995,7 @@ void Spell::SelectImplicitTrajTargets(SpellEffectInfo const& spellEffectInfo, Sp
 
 void Spell::SelectImplicitLineTargets(SpellEffectInfo const& spellEffectInfo, SpellImplicitTargetInfo const& targetType, SpellTargetIndex targetIndex, uint32 effMask)
 {
-    std::list<WorldObject*> targets;
+    Trinity::GridSearchResult<WorldObject*> targets;
     SpellTargetObjectTypes objectType = targetType.GetObjectType();
     SpellTargetCheckTypes selectionType = targetType.GetCheckType();
     Position const* dst = nullptr;
@@ -2007,12 +2036,12 @@ void Spell::SelectImplicitLineTargets(SpellEffectInfo const& spellEffectInfo, Sp
             {
                 if (maxTargets < targets.size())
                 {
-                    targets.sort(Trinity::ObjectDistanceOrderPred(m_caster));
+                    std::sort(targets.begin(), targets.end(), Trinity::ObjectDistanceOrderPred(m_caster));
                     targets.resize(maxTargets);
                 }
             }
 
-            for (std::list<WorldObject*>::iterator itr = targets.begin(); itr != targets.end(); ++itr)
+            for (auto itr = targets.begin(); itr != targets.end(); ++itr)
             {
                 if (Unit* unit = (*itr)->ToUnit())
                     AddUnitTarget(unit, effMask, false);
@@ -2047,18 +2076,7 @@ void Spell::SelectEffectTypeImplicitTargets(SpellEffectInfo const& spellEffectIn
                     if (player->IsImmunedToSpellEffect(m_spellInfo, spellEffectInfo, nullptr))
                         return;
 
-                    target->GetMap()->AddFarSpellCallback([spell = this, &spellEffectInfo, targetGuid = target->GetGUID()](Map* map)
-                    {
-                        Player* player = ObjectAccessor::GetPlayer(map, targetGuid);
-                        if (!player)
-                            return;
-
-                        // check immunity again in case it changed during update
-                        if (player->IsImmunedToSpellEffect(spell->GetSpellInfo(), spellEffectInfo, nullptr))
-                            return;
-
-                        spell->HandleEffects(player, nullptr, nullptr, nullptr, spellEffectInfo, SPELL_EFFECT_HANDLE_HIT_TARGET);
-                    });
+                    target->GetMap()->AddFarSpellEffect(this, spellEffectInfo, target->GetGUID());
                 }
             }
             return;
@@ -2207,7 +2225,8 @@ WorldObject* Spell::SearchNearbyTarget(SpellEffectInfo const& spellEffectInfo, f
     return target;
 }
 
-void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, SpellEffectInfo const& spellEffectInfo, float range, Position const* position, WorldObject* referer,
+template<class Container>
+void Spell::SearchAreaTargets(Container& targets, SpellEffectInfo const& spellEffectInfo, float range, Position const* position, WorldObject* referer,
     SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer const* condList,
     Trinity::WorldObjectSpellAreaTargetSearchReason searchReason)
 {
@@ -2217,12 +2236,76 @@ void Spell::SearchAreaTargets(std::list<WorldObject*>& targets, SpellEffectInfo
 
     float extraSearchRadius = range > 0.0f ? EXTRA_CELL_SEARCH_RADIUS : 0.0f;
     Trinity::WorldObjectSpellAreaTargetCheck check(range, position, m_caster, referer, m_spellInfo, selectionType, condList, objectType, searchReason);
+
+    // spells selecting area targets for several effects around the same center search the grid once
+    if (searchReason == Trinity::WorldObjectSpellAreaTargetSearchReason::Area && range > 0.0f)
+    {
+        if (AreaTargetCandidates const* candidates = GetAreaTargetCandidates(*position, range))
+        {
+            for (auto const& [object, gridMapTypeMask] : candidates->Objects)
+                if ((gridMapTypeMask & containerTypeMask) && object->IsInWorld() && check(object))
+                    targets.insert(targets.end(), object);
+
+            return;
+        }
+    }
+
     Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck> searcher(m_caster, targets, check, containerTypeMask);
     searcher.i_phaseShift = &PhasingHandler::GetAlwaysVisiblePhaseShift();
     SearchTargets<Trinity::WorldObjectListSearcher<Trinity::WorldObjectSpellAreaTargetCheck>>(searcher, containerTypeMask, m_caster, position, range + extraSearchRadius);
 }
 
-void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType,
+Spell::AreaTargetCandidates const* Spell::GetAreaTargetCandidates(Position const& center, float range)
+{
+    if (m_areaTargetCandidateRadius < 0.0f)
+    {
+        m_areaTargetCandidateRadius = 0.0f;
+
+        uint32 areaSelections = 0;
+        for (SpellEffectInfo const& spellEffectInfo : m_spellInfo->GetEffects())
+        {
+            if (!spellEffectInfo.IsEffect())
+                continue;
+
+            for (SpellTargetIndex targetIndex : { SpellTargetIndex::TargetA, SpellTargetIndex::TargetB })
+            {
+                SpellImplicitTargetInfo const& targetType = targetIndex == SpellTargetIndex::TargetA ? spellEffectInfo.TargetA : spellEffectInfo.TargetB;
+                if (targetType.GetSelectionCategory() != TARGET_SELECT_CATEGORY_AREA)
+                    continue;
+
+                ++areaSelections;
+                m_areaTargetCandidateRadius = std::max(m_areaTargetCandidateRadius, spellEffectInfo.CalcRadius(m_caster, targetIndex) * m_spellValue->RadiusMod);
+                m_areaTargetCandidateTypeMask |= GetSearcherTypeMask(m_spellInfo, spellEffectInfo, targetType.GetObjectType(), spellEffectInfo.ImplicitTargetConditions.get());
+            }
+        }
+
+        // a single search gains nothing from the shared candidates
+        if (areaSelections < 2)
+            m_areaTargetCandidateTypeMask = 0;
+    }
+
+    // radius changed by scripts after the first search
+    if (!m_areaTargetCandidateTypeMask || range > m_areaTargetCandidateRadius)
+        return nullptr;
+
+    for (AreaTargetCandidates const& candidates : m_areaTargetCandidates)
+        if (candidates.Center.GetPositionX() == center.GetPositionX() && candidates.Center.GetPositionY() == center.GetPositionY() && candidates.Center.GetPositionZ() == center.GetPositionZ())
+            return &candidates;
+
+    AreaTargetCandidates& candidates = m_areaTargetCandidates.emplace_back();
+    candidates.Center.Relocate(center);
+
+    auto collector = [&candidates](auto* object)
+    {
+        candidates.Objects.emplace_back(object, Trinity::GridMapTypeMaskForType<std::remove_pointer_t<decltype(object)>>::value);
+    };
+    Trinity::WorldObjectWorker<decltype(collector)> worker(m_caster, collector, m_areaTargetCandidateTypeMask);
+    worker.i_phaseShift = &PhasingHandler::GetAlwaysVisiblePhaseShift();
+    SearchTargets(worker, m_areaTargetCandidateTypeMask, m_caster, &candidates.Center, m_areaTargetCandidateRadius + EXTRA_CELL_SEARCH_RADIUS);
+    return &candidates;
+}
+
+void Spell::SearchChainTargets(Trinity::GridSearchResult<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType,
     SpellTargetCheckTypes selectType, SpellEffectInfo const& spellEffectInfo, bool isChainHeal)
 {
     // max dist for jump target selection
@@ -2264,16 +2347,16 @@ void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTar
     }();
 
     WorldObject* chainSource = m_spellInfo->HasAttribute(SPELL_ATTR2_CHAIN_FROM_CASTER) ? m_caster : target;
-    std::list<WorldObject*> tempTargets;
+    Trinity::GridSearchResult<WorldObject*, 32> tempTargets;
     SearchAreaTargets(tempTargets, spellEffectInfo, searchRadius, chainSource, m_caster, objectType, selectType, spellEffectInfo.ImplicitTargetConditions.get(),
         Trinity::WorldObjectSpellAreaTargetSearchReason::Chain);
-    tempTargets.remove(target);
+    tempTargets.erase(std::remove(tempTargets.begin(), tempTargets.end(), target), tempTargets.end());
 
     // remove targets which are always invalid for chain spells
     // for some spells allow only chain targets in front of caster (swipe for example)
     if (m_spellInfo->HasAttribute(SPELL_ATTR5_MELEE_CHAIN_TARGETING))
     {
-        tempTargets.remove_if([&](WorldObject* object)
+        Trinity::Containers::EraseIf(tempTargets, [&](WorldObject* object)
         {
             return !m_caster->HasInArc(static_cast<float>(M_PI), object);
         });
@@ -2282,12 +2365,12 @@ void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTar
     while (chainTargets)
     {
         // try to get unit for next chain jump
-        std::list<WorldObject*>::iterator foundItr = tempTargets.end();
+        auto foundItr = tempTargets.end();
         // get unit with highest hp deficit in dist
         if (isChainHeal)
         {
             uint32 maxHPDeficit = 0;
-            for (std::list<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
+            for (auto itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
             {
                 if (Unit* unit = (*itr)->ToUnit())
                 {
@@ -2303,7 +2386,7 @@ void Spell::SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTar
         // get closest object
         else
         {
-            for (std::list<WorldObject*>::iterator itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
+            for (auto itr = tempTargets.begin(); itr != tempTargets.end(); ++itr)
             {
                 bool isBestDistanceMatch = foundItr != tempTargets.end() ? chainSource->GetDistanceOrder(*itr, *foundItr) : chainSource->IsWithinDist(*itr, jumpRadius);
                 if (!isBestDistanceMatch)
@@ -5825,6 +5908,19 @@ void Spell::HandleEffects(Unit* pUnitTarget, Item* pItemTarget, GameObject* pGoT
         (this->*SpellEffectHandlers[spellEffectInfo.Effect].Value)();
 }
 
+void Spell::HandleFarEffect(Map* map, SpellEffectInfo const& spellEffectInfo, ObjectGuid const& targetGuid)
+{
+    Player* player = ObjectAccessor::GetPlayer(map, targetGuid);
+    if (!player)
+        return;
+
+    // check immunity again in case it changed during update
+    if (player->IsImmunedToSpellEffect(GetSpellInfo(), spellEffectInfo, nullptr))
+        return;
+
+    HandleEffects(player, nullptr, nullptr, nullptr, spellEffectInfo, SPELL_EFFECT_HANDLE_HIT_TARGET);
+}
+
 /*static*/ Spell const* Spell::ExtractSpellFromEvent(BasicEvent* event)
 {
     if (SpellEvent* spellEvent = dynamic_cast<SpellEvent*>(event))
@@ -8828,6 +8924,47 @@ void Spell::LoadScripts()
         TC_LOG_DEBUG("spells", "Spell::LoadScripts: Script `{}` for spell `{}` is loaded now", script->GetScriptName(), m_spellInfo->Id);
         script->Register();
     }
+
+    // collect registered hooks once so CallScript* functions for hooks no script uses are a single bit test
+    auto addHook = [&](SpellScriptHookType hookType, auto const& hookList)
+    {
+        if (hookList.size())
+            m_scriptHookMask |= UI64LIT(1) << hookType;
+    };
+
+    auto addEffectHandlers = [&](SpellEffectHandleMode mode, SpellScriptHookType hookType, HookList<SpellScript::EffectHandler> const& effectHandlers)
+    {
+        addHook(hookType, effectHandlers);
+        for (SpellScript::EffectHandler const& effectHandler : effectHandlers)
+            for (SpellEffectInfo const& spellEffectInfo : m_spellInfo->GetEffects())
+                if (effectHandler.IsEffectAffected(m_spellInfo, spellEffectInfo.EffectIndex))
+                    m_scriptEffectHandlerMask[mode] |= 1u << spellEffectInfo.EffectIndex;
+    };
+
+    for (SpellScript* script : m_loadedScripts)
+    {
+        addHook(SPELL_SCRIPT_HOOK_BEFORE_CAST, script->BeforeCast);
+        addHook(SPELL_SCRIPT_HOOK_ON_CAST, script->OnCast);
+        addHook(SPELL_SCRIPT_HOOK_AFTER_CAST, script->AfterCast);
+        addHook(SPELL_SCRIPT_HOOK_CHECK_CAST, script->OnCheckCast);
+        addEffectHandlers(SPELL_EFFECT_HANDLE_LAUNCH, SPELL_SCRIPT_HOOK_EFFECT_LAUNCH, script->OnEffectLaunch);
+        addEffectHandlers(SPELL_EFFECT_HANDLE_LAUNCH_TARGET, SPELL_SCRIPT_HOOK_EFFECT_LAUNCH_TARGET, script->OnEffectLaunchTarget);
+        addEffectHandlers(SPELL_EFFECT_HANDLE_HIT, SPELL_SCRIPT_HOOK_EFFECT_HIT, script->OnEffectHit);
+        addEffectHandlers(SPELL_EFFECT_HANDLE_HIT_TARGET, SPELL_SCRIPT_HOOK_EFFECT_HIT_TARGET, script->OnEffectHitTarget);
+        addHook(SPELL_SCRIPT_HOOK_EFFECT_SUCCESSFUL_DISPEL, script->OnEffectSuccessfulDispel);
+        addHook(SPELL_SCRIPT_HOOK_BEFORE_HIT, script->BeforeHit);
+        addHook(SPELL_SCRIPT_HOOK_HIT, script->OnHit);
+        addHook(SPELL_SCRIPT_HOOK_AFTER_HIT, script->AfterHit);
+        addHook(SPELL_SCRIPT_HOOK_CALC_CRIT_CHANCE, script->OnCalcCritChance);
+        addHook(SPELL_SCRIPT_HOOK_OBJECT_AREA_TARGET_SELECT, script->OnObjectAreaTargetSelect);
+        addHook(SPELL_SCRIPT_HOOK_OBJECT_TARGET_SELECT, script->OnObjectTargetSelect);
+        addHook(SPELL_SCRIPT_HOOK_DESTINATION_TARGET_SELECT, script->OnDestinationTargetSelect);
+        addHook(SPELL_SCRIPT_HOOK_CALC_DAMAGE, script->CalcDamage);
+        addHook(SPELL_SCRIPT_HOOK_CALC_HEALING, script->CalcHealing);
+        addHook(SPELL_SCRIPT_HOOK_ON_RESIST_ABSORB_CALCULATION, script->OnCalculateResistAbsorb);
+        addHook(SPELL_SCRIPT_HOOK_EMPOWER_STAGE_COMPLETED, script->OnEmpowerStageCompleted);
+        addHook(SPELL_SCRIPT_HOOK_EMPOWER_COMPLETED, script->OnEmpowerCompleted);
+    }
 }
 
 void Spell::CallScriptOnPrecastHandler()
@@ -8842,6 +8979,9 @@ void Spell::CallScriptOnPrecastHandler()
 
 void Spell::CallScriptBeforeCastHandlers()
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_BEFORE_CAST))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_BEFORE_CAST);
@@ -8854,6 +8994,9 @@ void Spell::CallScriptBeforeCastHandlers()
 
 void Spell::CallScriptOnCastHandlers()
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_ON_CAST))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_ON_CAST);
@@ -8866,6 +9009,9 @@ void Spell::CallScriptOnCastHandlers()
 
 void Spell::CallScriptAfterCastHandlers()
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_AFTER_CAST))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_AFTER_CAST);
@@ -8878,6 +9024,9 @@ void Spell::CallScriptAfterCastHandlers()
 
 SpellCastResult Spell::CallScriptCheckCastHandlers()
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_CHECK_CAST))
+        return SPELL_CAST_OK;
+
     SpellCastResult retVal = SPELL_CAST_OK;
     for (SpellScript* script : m_loadedScripts)
     {
@@ -8907,6 +9056,9 @@ int32 Spell::CallScriptCalcCastTimeHandlers(int32 castTime)
 
 bool Spell::CallScriptEffectHandlers(SpellEffIndex effIndex, SpellEffectHandleMode mode)
 {
+    if (!(m_scriptEffectHandlerMask[mode] & (1u << effIndex)))
+        return false;
+
     // execute script effect handler hooks and check if effects was prevented
     bool preventDefault = false;
     for (SpellScript* script : m_loadedScripts)
@@ -8953,6 +9105,9 @@ bool Spell::CallScriptEffectHandlers(SpellEffIndex effIndex, SpellEffectHandleMo
 
 void Spell::CallScriptSuccessfulDispel(SpellEffIndex effIndex)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_EFFECT_SUCCESSFUL_DISPEL))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_EFFECT_SUCCESSFUL_DISPEL);
@@ -8965,6 +9120,9 @@ void Spell::CallScriptSuccessfulDispel(SpellEffIndex effIndex)
 
 void Spell::CallScriptBeforeHitHandlers(SpellMissInfo missInfo)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_BEFORE_HIT))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_InitHit();
@@ -8978,6 +9136,9 @@ void Spell::CallScriptBeforeHitHandlers(SpellMissInfo missInfo)
 
 void Spell::CallScriptOnHitHandlers()
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_HIT))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_HIT);
@@ -8990,6 +9151,9 @@ void Spell::CallScriptOnHitHandlers()
 
 void Spell::CallScriptAfterHitHandlers()
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_AFTER_HIT))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_AFTER_HIT);
@@ -9002,6 +9166,9 @@ void Spell::CallScriptAfterHitHandlers()
 
 void Spell::CallScriptCalcCritChanceHandlers(Unit const* victim, float& critChance)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_CALC_CRIT_CHANCE))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_CALC_CRIT_CHANCE);
@@ -9014,6 +9181,9 @@ void Spell::CallScriptCalcCritChanceHandlers(Unit const* victim, float& critChan
 
 void Spell::CallScriptCalcDamageHandlers(Unit* victim, int32& damage, int32& flatMod, float& pctMod)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_CALC_DAMAGE))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_CALC_DAMAGE);
@@ -9026,6 +9196,9 @@ void Spell::CallScriptCalcDamageHandlers(Unit* victim, int32& damage, int32& fla
 
 void Spell::CallScriptCalcHealingHandlers(Unit* victim, int32& healing, int32& flatMod, float& pctMod)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_CALC_HEALING))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_CALC_HEALING);
@@ -9036,21 +9209,39 @@ void Spell::CallScriptCalcHealingHandlers(Unit* victim, int32& healing, int32& f
     }
 }
 
-void Spell::CallScriptObjectAreaTargetSelectHandlers(std::list<WorldObject*>& targets, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
+void Spell::CallScriptObjectAreaTargetSelectHandlers(Trinity::GridSearchResult<WorldObject*>& targets, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_OBJECT_AREA_TARGET_SELECT))
+        return;
+
+    // script hooks take a std::list, only build it when a hook is registered for this target
+    Optional<std::list<WorldObject*>> scriptTargets;
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_OBJECT_AREA_TARGET_SELECT);
         for (SpellScript::ObjectAreaTargetSelectHandler const& objectAreaTargetSelect : script->OnObjectAreaTargetSelect)
+        {
             if (objectAreaTargetSelect.IsEffectAffected(m_spellInfo, effIndex) && targetType.GetTarget() == objectAreaTargetSelect.GetTarget())
-                objectAreaTargetSelect.Call(script, targets);
+            {
+                if (!scriptTargets)
+                    scriptTargets.emplace(targets.begin(), targets.end());
+
+                objectAreaTargetSelect.Call(script, *scriptTargets);
+            }
+        }
 
         script->_FinishScriptCall();
     }
+
+    if (scriptTargets)
+        targets.assign(scriptTargets->begin(), scriptTargets->end());
 }
 
 void Spell::CallScriptObjectTargetSelectHandlers(WorldObject*& target, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_OBJECT_TARGET_SELECT))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_OBJECT_TARGET_SELECT);
@@ -9064,6 +9255,9 @@ void Spell::CallScriptObjectTargetSelectHandlers(WorldObject*& target, SpellEffI
 
 void Spell::CallScriptDestinationTargetSelectHandlers(SpellDestination& target, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_DESTINATION_TARGET_SELECT))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_DESTINATION_TARGET_SELECT);
@@ -9077,6 +9271,9 @@ void Spell::CallScriptDestinationTargetSelectHandlers(SpellDestination& target,
 
 void Spell::CallScriptOnResistAbsorbCalculateHandlers(DamageInfo const& damageInfo, uint32& resistAmount, int32& absorbAmount)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_ON_RESIST_ABSORB_CALCULATION))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_ON_RESIST_ABSORB_CALCULATION);
@@ -9089,6 +9286,9 @@ void Spell::CallScriptOnResistAbsorbCalculateHandlers(DamageInfo const& damageIn
 
 void Spell::CallScriptEmpowerStageCompletedHandlers(int32 completedStagesCount)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_EMPOWER_STAGE_COMPLETED))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_EMPOWER_STAGE_COMPLETED);
@@ -9101,6 +9301,9 @@ void Spell::CallScriptEmpowerStageCompletedHandlers(int32 completedStagesCount)
 
 void Spell::CallScriptEmpowerCompletedHandlers(int32 completedStagesCount)
 {
+    if (!HasScriptHook(SPELL_SCRIPT_HOOK_EMPOWER_COMPLETED))
+        return;
+
     for (SpellScript* script : m_loadedScripts)
     {
         script->_PrepareScriptCall(SPELL_SCRIPT_HOOK_EMPOWER_COMPLETED);
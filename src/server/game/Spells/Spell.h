@@ -21,6 +21,7 @@
 #include "ConditionMgr.h"
 #include "DBCEnums.h"
 #include "Duration.h"
+#include "GridSearchResult.h"
 #include "ModelIgnoreFlags.h"
 #include "ObjectGuid.h"
 #include "Optional.h"
@@ -443,6 +444,10 @@ class TC_GAME_API Spell
         Spell(WorldObject* caster, SpellInfo const* info, TriggerCastFlags triggerFlags, ObjectGuid originalCasterGUID = ObjectGuid::Empty, ObjectGuid originalCastId = ObjectGuid::Empty);
         ~Spell();
 
+        // spells are created and destroyed for every cast, reuse their memory per thread
+        static void* operator new(std::size_t size);
+        static void operator delete(void* ptr, std::size_t size) noexcept;
+
         void InitExplicitTargets(SpellCastTargets const& targets);
         void SelectExplicitTargets();
 
@@ -467,12 +472,20 @@ class TC_GAME_API Spell
         template<class SEARCHER> static void SearchTargets(SEARCHER& searcher, uint32 containerMask, WorldObject* referer, Position const* pos, float radius);
 
         WorldObject* SearchNearbyTarget(SpellEffectInfo const& spellEffectInfo, float range, SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer const* condList = nullptr);
-        void SearchAreaTargets(std::list<WorldObject*>& targets, SpellEffectInfo const& spellEffectInfo, float range, Position const* position, WorldObject* referer,
+        template<class Container>
+        void SearchAreaTargets(Container& targets, SpellEffectInfo const& spellEffectInfo, float range, Position const* position, WorldObject* referer,
             SpellTargetObjectTypes objectType, SpellTargetCheckTypes selectionType, ConditionContainer const* condList,
             Trinity::WorldObjectSpellAreaTargetSearchReason searchReason);
-        void SearchChainTargets(std::list<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType,
+        void SearchChainTargets(Trinity::GridSearchResult<WorldObject*>& targets, uint32 chainTargets, WorldObject* target, SpellTargetObjectTypes objectType,
             SpellTargetCheckTypes selectType, SpellEffectInfo const& spellEffectInfo, bool isChainHeal);
 
+        struct AreaTargetCandidates
+        {
+            Position Center;
+            std::vector<std::pair<WorldObject*, uint32 /*gridMapTypeMask*/>> Objects;
+        };
+        AreaTargetCandidates const* GetAreaTargetCandidates(Position const& center, float range);
+
         GameObject* SearchSpellFocus();
 
         SpellCastResult prepare(SpellCastTargets const& targets, AuraEffect const* triggeredByAura = nullptr);
@@ -565,6 +578,8 @@ class TC_GAME_API Spell
         void SendResurrectRequest(Player* target);
 
         void HandleEffects(Unit* pUnitTarget, Item* pItemTarget, GameObject* pGoTarget, Corpse* pCorpseTarget, SpellEffectInfo const& spellEffectInfo, SpellEffectHandleMode mode);
+        // handles an effect queued with Map::AddFarSpellEffect on the map of the target
+        void HandleFarEffect(Map* map, SpellEffectInfo const& spellEffectInfo, ObjectGuid const& targetGuid);
         void HandleThreatSpells();
         static Spell const* ExtractSpellFromEvent(BasicEvent* event);
 
@@ -860,6 +875,11 @@ class TC_GAME_API Spell
         };
         std::vector<CorpseTargetInfo> m_UniqueCorpseTargetInfo;
 
+        // objects around area target search centers, shared by all area target selections of one SelectSpellTargets call
+        std::vector<AreaTargetCandidates> m_areaTargetCandidates;
+        uint32 m_areaTargetCandidateTypeMask;
+        float m_areaTargetCandidateRadius;                      // negative until calculated for the cast
+
         template <class Container>
         void DoProcessTargetContainer(Container& targetContainer);
 
@@ -905,13 +925,16 @@ class TC_GAME_API Spell
         void CallScriptCalcDamageHandlers(Unit* victim, int32& damage, int32& flatMod, float& pctMod);
         void CallScriptCalcHealingHandlers(Unit* victim, int32& healing, int32& flatMod, float& pctMod);
     protected:
-        void CallScriptObjectAreaTargetSelectHandlers(std::list<WorldObject*>& targets, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType);
+        void CallScriptObjectAreaTargetSelectHandlers(Trinity::GridSearchResult<WorldObject*>& targets, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType);
         void CallScriptObjectTargetSelectHandlers(WorldObject*& target, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType);
         void CallScriptDestinationTargetSelectHandlers(SpellDestination& target, SpellEffIndex effIndex, SpellImplicitTargetInfo const& targetType);
         void CallScriptEmpowerStageCompletedHandlers(int32 completedStagesCount);
         void CallScriptEmpowerCompletedHandlers(int32 completedStagesCount);
         bool CheckScriptEffectImplicitTargets(uint32 effIndex, uint32 effIndexToCheck);
+        bool HasScriptHook(uint32 hookType) const { return (m_scriptHookMask & (UI64LIT(1) << hookType)) != 0; }
         std::vector<SpellScript*> m_loadedScripts;
+        uint64 m_scriptHookMask;                                                    // SpellScriptHookType bits with a handler registered by any loaded script
+        uint32 m_scriptEffectHandlerMask[SPELL_EFFECT_HANDLE_HIT_TARGET + 1];       // effects with a registered effect handler, for each SpellEffectHandleMode
 
         struct HitTriggerSpell
         {
@@ -137,7 +137,7 @@ struct SpellHistory::PersistenceHelper<Pet>
     }
 };
 
-SpellHistory::SpellHistory(Unit* owner) : _owner(owner), _schoolLockouts()
+SpellHistory::SpellHistory(Unit* owner) : _owner(owner), _schoolLockouts(), _nextExpiryCheck(TimePoint::max())
 {
 }
 
@@ -159,6 +159,8 @@ void SpellHistory::LoadFromDB(PreparedQueryResult cooldownsResult, PreparedQuery
                 _spellCooldowns[spellId] = cooldown;
                 if (cooldown.CategoryId)
                     _categoryCooldowns[cooldown.CategoryId] = &_spellCooldowns[spellId];
+
+                ScheduleExpiryCheck(std::min(cooldown.CooldownEnd, cooldown.CategoryEnd));
             }
 
         } while (cooldownsResult->NextRow());
@@ -172,7 +174,10 @@ void SpellHistory::LoadFromDB(PreparedQueryResult cooldownsResult, PreparedQuery
             uint32 categoryId = 0;
             ChargeEntry charges;
             if (StatementInfo::ReadCharge(fields, &categoryId, &charges))
+            {
                 _categoryCharges[categoryId].push_back(charges);
+                ScheduleExpiryCheck(charges.RechargeEnd);
+            }
 
         } while (chargesResult->NextRow());
     }
@@ -220,12 +225,19 @@ void SpellHistory::SaveToDB(CharacterDatabaseTransaction trans)
 void SpellHistory::Update()
 {
     TimePoint now = time_point_cast<Duration>(GameTime::GetTime<Clock>());
+    if (now < _nextExpiryCheck)
+        return;
+
+    _nextExpiryCheck = TimePoint::max();
     for (auto itr = _categoryCooldowns.begin(); itr != _categoryCooldowns.end();)
     {
         if (itr->second->CategoryEnd < now)
             itr = _categoryCooldowns.erase(itr);
         else
+        {
+            ScheduleExpiryCheck(itr->second->CategoryEnd);
             ++itr;
+        }
     }
 
     for (auto itr = _spellCooldowns.begin(); itr != _spellCooldowns.end();)
@@ -233,12 +245,22 @@ void SpellHistory::Update()
         if (itr->second.CooldownEnd < now)
             itr = EraseCooldown(itr);
         else
+        {
+            ScheduleExpiryCheck(itr->second.CooldownEnd);
             ++itr;
+        }
     }
 
     for (auto& [chargeCategoryId, chargeRefreshTimes] : _categoryCharges)
-        while (!chargeRefreshTimes.empty() && chargeRefreshTimes.front().RechargeEnd <= now)
-            chargeRefreshTimes.pop_front();
+    {
+        chargeRefreshTimes.erase(chargeRefreshTimes.begin(), std::find_if(chargeRefreshTimes.begin(), chargeRefreshTimes.end(), [now](ChargeEntry const& charge)
+        {
+            return charge.RechargeEnd > now;
+        }));
+
+        if (!chargeRefreshTimes.empty())
+            ScheduleExpiryCheck(chargeRefreshTimes.front().RechargeEnd);
+    }
 }
 
 void SpellHistory::HandleCooldowns(SpellInfo const* spellInfo, Item const* item, Spell* spell /*= nullptr*/)
@@ -564,6 +586,8 @@ void SpellHistory::AddCooldown(uint32 spellId, uint32 itemId, TimePoint cooldown
         if (categoryId)
             _categoryCooldowns[categoryId] = &cooldownEntry;
     }
+
+    ScheduleExpiryCheck(std::min(cooldownEntry.CooldownEnd, cooldownEntry.CategoryEnd));
 }
 
 void SpellHistory::ModifySpellCooldown(uint32 spellId, Duration cooldownMod, bool withoutCategoryCooldown)
@@ -591,6 +615,8 @@ void SpellHistory::ModifySpellCooldown(CooldownStorageType::iterator& itr, Durat
             itr->second.CooldownEnd = itr->second.CategoryEnd;
     }
 
+    ScheduleExpiryCheck(std::min(itr->second.CooldownEnd, itr->second.CategoryEnd));
+
     if (Player* playerOwner = GetPlayerOwner())
     {
         WorldPackets::Spells::ModifyCooldown modifyCooldown;
@@ -812,13 +838,14 @@ bool SpellHistory::ConsumeCharge(uint32 chargeCategoryId)
     if (chargeRecovery > 0 && GetMaxCharges(chargeCategoryId) > 0)
     {
         TimePoint recoveryStart;
-        std::deque<ChargeEntry>& charges = _categoryCharges[chargeCategoryId];
+        ChargeEntryCollection& charges = _categoryCharges[chargeCategoryId];
         if (charges.empty())
             recoveryStart = time_point_cast<Duration>(GameTime::GetTime<Clock>());
         else
             recoveryStart = charges.back().RechargeEnd;
 
         charges.emplace_back(recoveryStart, Milliseconds(chargeRecovery));
+        ScheduleExpiryCheck(charges.back().RechargeEnd);
         return true;
     }
 
@@ -844,7 +871,10 @@ void SpellHistory::ModifyChargeRecoveryTime(uint32 chargeCategoryId, Duration co
     }
 
     while (!itr->second.empty() && itr->second.front().RechargeEnd < now)
-        itr->second.pop_front();
+        itr->second.erase(itr->second.begin());
+
+    if (!itr->second.empty())
+        ScheduleExpiryCheck(itr->second.front().RechargeEnd);
 
     SendSetSpellCharges(chargeCategoryId, itr->second);
 }
@@ -1090,6 +1120,9 @@ void SpellHistory::RestoreCooldownStateAfterDuel()
                 _spellCooldowns[pair.first] = _spellCooldownsBeforeDuel[pair.first];
         }
 
+        // restored cooldowns can end earlier than anything scheduled so far
+        _nextExpiryCheck = TimePoint::min();
+
         // update the client: restore old cooldowns
         WorldPackets::Spells::SpellCooldown spellCooldown;
         spellCooldown.Caster = _owner->GetGUID();
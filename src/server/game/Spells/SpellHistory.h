@@ -23,7 +23,7 @@
 #include "GameTime.h"
 #include "Optional.h"
 #include "SharedDefines.h"
-#include <deque>
+#include <boost/container/small_vector.hpp>
 #include <unordered_map>
 #include <vector>
 
@@ -70,7 +70,7 @@ public:
         TimePoint RechargeEnd;
     };
 
-    using ChargeEntryCollection = std::deque<ChargeEntry>;
+    using ChargeEntryCollection = boost::container::small_vector<ChargeEntry, 3>;
     using CooldownStorageType = std::unordered_map<uint32 /*spellId*/, CooldownEntry>;
     using CategoryCooldownStorageType = std::unordered_map<uint32 /*categoryId*/, CooldownEntry*>;
     using ChargeStorageType = std::unordered_map<uint32 /*categoryId*/, ChargeEntryCollection>;
@@ -193,6 +193,13 @@ private:
         return _spellCooldowns.erase(itr);
     }
 
+    // Update only sweeps stored cooldowns and charges once the earliest of them is due
+    void ScheduleExpiryCheck(TimePoint end)
+    {
+        if (end < _nextExpiryCheck)
+            _nextExpiryCheck = end;
+    }
+
     void SendSetSpellCharges(uint32 chargeCategoryId, ChargeEntryCollection const& chargeCollection);
 
     static void GetCooldownDurations(SpellInfo const* spellInfo, uint32 itemId, Duration* cooldown, uint32* categoryId, Duration* categoryCooldown);
@@ -205,6 +212,7 @@ private:
     ChargeStorageType _categoryCharges;
     GlobalCooldownStorageType _globalCooldowns;
     Optional<TimePoint> _pauseTime;
+    TimePoint _nextExpiryCheck;
 
     template<class T>
     struct PersistenceHelper { };
@@ -37,6 +37,7 @@
 #include "SpellMgr.h"
 #include "Vehicle.h"
 #include <G3D/g3dmath.h>
+#include <algorithm>
 
 uint32 GetTargetFlagMask(SpellTargetObjectTypes objType)
 {
@@ -1393,6 +1394,9 @@ uint32 SpellInfo::GetCategory() const
 
 bool SpellInfo::HasEffect(SpellEffectName effect) const
 {
+    if (!_hotEffects.empty())
+        return std::ranges::any_of(_hotEffects, [effect](SpellEffectHotInfo const& eff) { return eff.Effect == effect; });
+
     for (SpellEffectInfo const& eff : GetEffects())
         if (eff.IsEffect(effect))
             return true;
@@ -1402,6 +1406,9 @@ bool SpellInfo::HasEffect(SpellEffectName effect) const
 
 bool SpellInfo::HasAura(AuraType aura) const
 {
+    if (!_hotEffects.empty())
+        return std::ranges::any_of(_hotEffects, [aura](SpellEffectHotInfo const& effect) { return effect.HasFlag(SpellEffectHotInfo::FLAG_AURA) && effect.ApplyAuraName == aura; });
+
     for (SpellEffectInfo const& effect : GetEffects())
         if (effect.IsAura(aura))
             return true;
@@ -1411,6 +1418,9 @@ bool SpellInfo::HasAura(AuraType aura) const
 
 bool SpellInfo::HasAreaAuraEffect() const
 {
+    if (!_hotEffects.empty())
+        return std::ranges::any_of(_hotEffects, [](SpellEffectHotInfo const& effect) { return effect.HasFlag(SpellEffectHotInfo::FLAG_AREA_AURA); });
+
     for (SpellEffectInfo const& effect : GetEffects())
         if (effect.IsAreaAuraEffect())
             return true;
@@ -1446,6 +1456,9 @@ bool SpellInfo::HasOnlyDamageEffects() const
 
 bool SpellInfo::HasTargetType(::Targets target) const
 {
+    if (!_hotEffects.empty())
+        return std::ranges::any_of(_hotEffects, [target](SpellEffectHotInfo const& effect) { return effect.TargetA == target || effect.TargetB == target; });
+
     for (SpellEffectInfo const& effect : GetEffects())
         if (effect.TargetA.GetTarget() == target || effect.TargetB.GetTarget() == target)
             return true;
@@ -1534,6 +1547,13 @@ bool SpellInfo::IsAbilityOfSkillType(uint32 skillType) const
 
 bool SpellInfo::IsAffectingArea() const
 {
+    if (!_hotEffects.empty())
+        return std::ranges::any_of(_hotEffects, [](SpellEffectHotInfo const& effect)
+        {
+            return effect.Effect && (effect.HasFlag(SpellEffectHotInfo::FLAG_TARGETING_AREA) || effect.Effect == SPELL_EFFECT_PERSISTENT_AREA_AURA
+                || effect.HasFlag(SpellEffectHotInfo::FLAG_AREA_AURA));
+        });
+
     for (SpellEffectInfo const& effect : GetEffects())
         if (effect.IsEffect() && (effect.IsTargetingArea() || effect.IsEffect(SPELL_EFFECT_PERSISTENT_AREA_AURA) || effect.IsAreaAuraEffect()))
             return true;
@@ -1544,6 +1564,9 @@ bool SpellInfo::IsAffectingArea() const
 // checks if spell targets are selected from area, doesn't include spell effects in check (like area wide auras for example)
 bool SpellInfo::IsTargetingArea() const
 {
+    if (!_hotEffects.empty())
+        return std::ranges::any_of(_hotEffects, [](SpellEffectHotInfo const& effect) { return effect.Effect && effect.HasFlag(SpellEffectHotInfo::FLAG_TARGETING_AREA); });
+
     for (SpellEffectInfo const& effect : GetEffects())
         if (effect.IsEffect() && effect.IsTargetingArea())
             return true;
@@ -24,6 +24,7 @@
 #include "SpellAuraDefines.h"
 #include "SpellDefines.h"
 #include <bitset>
+#include <span>
 
 class AuraEffect;
 class Item;
@@ -301,6 +302,26 @@ typedef std::vector<AuraEffect*> AuraEffectVector;
 
 struct SpellInfoLoadHelper;
 
+// Hot attributes of one effect, SpellMgr::LoadSpellInfoHotData packs them for all spells into a single array
+// effect scans then read 8 bytes per effect instead of touching every SpellEffectInfo
+struct SpellEffectHotInfo
+{
+    enum Flag : uint8
+    {
+        FLAG_AURA               = 0x01,     // SpellEffectInfo::IsAura()
+        FLAG_AREA_AURA          = 0x02,     // SpellEffectInfo::IsAreaAuraEffect()
+        FLAG_TARGETING_AREA     = 0x04      // SpellEffectInfo::IsTargetingArea()
+    };
+
+    uint16 Effect = 0;
+    uint16 ApplyAuraName = 0;
+    uint8 TargetA = 0;
+    uint8 TargetB = 0;
+    uint8 Flags = 0;
+
+    bool HasFlag(Flag flag) const { return (Flags & flag) != 0; }
+};
+
 struct TC_GAME_API SpellDiminishInfo
 {
     DiminishingGroup DiminishGroup = DIMINISHING_NONE;
@@ -575,6 +596,8 @@ class TC_GAME_API SpellInfo
         uint32 GetSpellVisual(WorldObject const* caster = nullptr, WorldObject const* viewer = nullptr) const;
 
         std::vector<SpellEffectInfo> const& GetEffects() const { return _effects; }
+        // packed copy of the hot effect attributes, empty until SpellMgr::LoadSpellInfoHotData has run
+        std::span<SpellEffectHotInfo const> GetHotEffects() const { return _hotEffects; }
         SpellEffectInfo const& GetEffect(SpellEffIndex index) const { ASSERT(index < _effects.size()); return _effects[index]; }
 
         // spell diminishing returns
@@ -615,6 +638,7 @@ class TC_GAME_API SpellInfo
 
     private:
         std::vector<SpellEffectInfo> _effects;
+        std::span<SpellEffectHotInfo const> _hotEffects;
         SpellVisualVector _visuals;
         SpellSpecificType _spellSpecific = SPELL_SPECIFIC_NORMAL;
         AuraStateType _auraState = AURA_STATE_NONE;
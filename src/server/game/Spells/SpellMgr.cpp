@@ -25,6 +25,7 @@
 #include "DatabaseEnv.h"
 #include "LanguageMgr.h"
 #include "Log.h"
+#include "MemoryUsage.h"
 #include "MotionMaster.h"
 #include "ObjectMgr.h"
 #include "Player.h"
@@ -62,6 +63,19 @@ namespace
         >
     > mSpellInfoMap;
 
+    // Dense spell id indexed view of mSpellInfoMap with difficulty fallback chains resolved at load
+    // Most spells only have a DIFFICULTY_NONE entry and are answered by Default, the others list the difficulties resolving to something else
+    struct SpellInfoLookupEntry
+    {
+        SpellInfo const* Default = nullptr;             // returned for difficulties whose fallback chain reaches DIFFICULTY_NONE
+        uint32 OverridesBegin = 0;
+        uint32 OverridesEnd = 0;
+    };
+
+    std::vector<SpellInfoLookupEntry> mSpellInfoLookup;
+    std::vector<std::pair<Difficulty, SpellInfo const*>> mSpellInfoLookupOverrides;
+    std::array<bool, std::numeric_limits<std::underlying_type_t<Difficulty>>::max() + 1> mDifficultyFallsBackToNone;
+
     class ServersideSpellName
     {
     public:
@@ -99,6 +113,9 @@ namespace
 
     std::unordered_map<std::pair<uint32, Difficulty>, SpellProcEntry> mSpellProcMap;
     std::unordered_map<int32, CreatureImmunities> mCreatureImmunities;
+
+    // SpellInfo::_hotEffects of every spell points into this array
+    std::vector<SpellEffectHotInfo> mSpellEffectHotInfos;
 }
 
 PetFamilySpellsStore sPetFamilySpellsStore;
@@ -679,25 +696,107 @@ CreatureImmunities const* SpellMgr::GetCreatureImmunities(int32 creatureImmuniti
     return Trinity::Containers::MapGetValuePtr(mCreatureImmunities, creatureImmunitiesId);
 }
 
-SpellInfo const* SpellMgr::GetSpellInfo(uint32 spellId, Difficulty difficulty) const
+namespace
 {
-    auto itr = mSpellInfoMap.find(boost::make_tuple(spellId, difficulty));
-    if (itr != mSpellInfoMap.end())
-        return &*itr;
+    SpellInfo const* FindSpellInfo(uint32 spellId, Difficulty difficulty)
+    {
+        auto itr = mSpellInfoMap.find(boost::make_tuple(spellId, difficulty));
+        if (itr != mSpellInfoMap.end())
+            return &*itr;
+
+        if (DifficultyEntry const* difficultyEntry = sDifficultyStore.LookupEntry(difficulty))
+        {
+            do
+            {
+                itr = mSpellInfoMap.find(boost::make_tuple(spellId, Difficulty(difficultyEntry->FallbackDifficultyID)));
+                if (itr != mSpellInfoMap.end())
+                    return &*itr;
+
+                difficultyEntry = sDifficultyStore.LookupEntry(difficultyEntry->FallbackDifficultyID);
+            } while (difficultyEntry);
+        }
+
+        return nullptr;
+    }
 
-    if (DifficultyEntry const* difficultyEntry = sDifficultyStore.LookupEntry(difficulty))
+    void BuildSpellInfoLookup()
     {
-        do
+        mSpellInfoLookup.clear();
+        mSpellInfoLookupOverrides.clear();
+
+        // difficulties searched by FindSpellInfo, in order
+        std::array<std::vector<Difficulty>, std::tuple_size_v<decltype(mDifficultyFallsBackToNone)>> fallbackChains;
+        for (std::size_t i = 0; i < fallbackChains.size(); ++i)
+        {
+            std::vector<Difficulty>& chain = fallbackChains[i];
+            chain.push_back(Difficulty(i));
+            for (DifficultyEntry const* difficultyEntry = sDifficultyStore.LookupEntry(i); difficultyEntry && chain.size() <= fallbackChains.size();
+                difficultyEntry = sDifficultyStore.LookupEntry(difficultyEntry->FallbackDifficultyID))
+                chain.push_back(Difficulty(difficultyEntry->FallbackDifficultyID));
+
+            mDifficultyFallsBackToNone[i] = std::find(chain.begin(), chain.end(), DIFFICULTY_NONE) != chain.end();
+        }
+
+        // spell ids past the client store (serverside spells) keep using FindSpellInfo
+        mSpellInfoLookup.resize(sSpellNameStore.GetNumRows());
+
+        std::vector<uint32> multiDifficultySpells;
+        for (SpellInfo const& spellInfo : mSpellInfoMap)
+        {
+            if (spellInfo.Id >= mSpellInfoLookup.size())
+                continue;
+
+            if (spellInfo.Difficulty == DIFFICULTY_NONE)
+                mSpellInfoLookup[spellInfo.Id].Default = &spellInfo;
+            else
+                multiDifficultySpells.push_back(spellInfo.Id);
+        }
+
+        std::sort(multiDifficultySpells.begin(), multiDifficultySpells.end());
+        multiDifficultySpells.erase(std::unique(multiDifficultySpells.begin(), multiDifficultySpells.end()), multiDifficultySpells.end());
+
+        for (uint32 spellId : multiDifficultySpells)
         {
-            itr = mSpellInfoMap.find(boost::make_tuple(spellId, Difficulty(difficultyEntry->FallbackDifficultyID)));
-            if (itr != mSpellInfoMap.end())
-                return &*itr;
+            SpellInfoLookupEntry& entry = mSpellInfoLookup[spellId];
+            entry.OverridesBegin = mSpellInfoLookupOverrides.size();
 
-            difficultyEntry = sDifficultyStore.LookupEntry(difficultyEntry->FallbackDifficultyID);
-        } while (difficultyEntry);
+            std::vector<SpellInfo const*> difficultyInfos;
+            for (SpellInfo const& spellInfo : Trinity::Containers::MakeIteratorPair(mSpellInfoMap.get<SpellIdIndex>().equal_range(spellId)))
+                difficultyInfos.push_back(&spellInfo);
+
+            for (std::size_t i = 0; i < fallbackChains.size(); ++i)
+            {
+                SpellInfo const* resolved = nullptr;
+                for (Difficulty difficulty : fallbackChains[i])
+                {
+                    auto itr = std::find_if(difficultyInfos.begin(), difficultyInfos.end(), [difficulty](SpellInfo const* spellInfo) { return spellInfo->Difficulty == difficulty; });
+                    if (itr != difficultyInfos.end())
+                    {
+                        resolved = *itr;
+                        break;
+                    }
+                }
+
+                if (resolved != (mDifficultyFallsBackToNone[i] ? entry.Default : nullptr))
+                    mSpellInfoLookupOverrides.emplace_back(Difficulty(i), resolved);
+            }
+
+            entry.OverridesEnd = mSpellInfoLookupOverrides.size();
+        }
     }
+}
 
-    return nullptr;
+SpellInfo const* SpellMgr::GetSpellInfo(uint32 spellId, Difficulty difficulty) const
+{
+    if (spellId >= mSpellInfoLookup.size())
+        return FindSpellInfo(spellId, difficulty);
+
+    SpellInfoLookupEntry const& entry = mSpellInfoLookup[spellId];
+    for (uint32 i = entry.OverridesBegin; i < entry.OverridesEnd; ++i)
+        if (mSpellInfoLookupOverrides[i].first == difficulty)
+            return mSpellInfoLookupOverrides[i].second;
+
+    return mDifficultyFallsBackToNone[difficulty] ? entry.Default : nullptr;
 }
 
 auto _GetSpellInfo(uint32 spellId)
@@ -717,6 +816,27 @@ void SpellMgr::ForEachSpellInfoDifficulty(uint32 spellId, std::function<void(Spe
         callback(&spellInfo);
 }
 
+void SpellMgr::GetMemoryUsage(Trinity::MemoryUsageReport& report) const
+{
+    using Trinity::MemoryUsage::Of;
+
+    // every SpellInfo node is linked into both hashed indexes of the container
+    std::size_t spellInfos = mSpellInfoMap.bucket_count() * sizeof(void*) * 2;
+    for (SpellInfo const& spellInfo : mSpellInfoMap)
+        spellInfos += sizeof(SpellInfo) + 4 * sizeof(void*) + Of(spellInfo.GetEffects()) + Of(spellInfo.Labels)
+            + Of(spellInfo.ProcPPMMods) + Of(spellInfo.ReagentsCurrency) + Of(spellInfo.EmpowerStageThresholds);
+
+    report.Add("SpellMgr", "spell_info", spellInfos + Of(mSpellEffectHotInfos) + Of(mSpellInfoLookup) + Of(mSpellInfoLookupOverrides));
+    report.Add("SpellMgr", "spell_proc", Of(mSpellProcMap));
+    report.Add("SpellMgr", "spell_chain", Of(mSpellChains) + Of(mSpellsReqSpell) + Of(mSpellReq) + Of(mSpellDifficultySearcherMap));
+    report.Add("SpellMgr", "spell_area", Of(mSpellAreaMap) + Of(mSpellAreaForQuestMap) + Of(mSpellAreaForQuestEndMap)
+        + Of(mSpellAreaForAuraMap) + Of(mSpellAreaForAreaMap));
+    report.Add("SpellMgr", "spell_group", Of(mSpellSpellGroup) + Of(mSpellGroupSpell) + Of(mSpellGroupStack) + Of(mSpellSameEffectStack));
+    report.Add("SpellMgr", "skill_line_ability", Of(mSkillLineAbilityMap) + Of(mSpellLearnSkills) + Of(mSpellLearnSpells));
+    report.Add("SpellMgr", "spell_misc", Of(mSpellTargetPositions) + Of(mSpellThreatMap) + Of(mSpellPetAuraMap) + Of(mSpellLinkedMap)
+        + Of(mSpellEnchantProcEventMap) + Of(mPetLevelupSpellMap) + Of(mPetDefaultSpellsMap) + Of(mSpellTotemModel) + Of(mCreatureImmunities));
+}
+
 bool SpellArea::IsFitToRequirements(Player const* player, uint32 newZone, uint32 newArea) const
 {
     if (gender != GENDER_NONE)                   // is not expected gender
@@ -2708,13 +2828,18 @@ void SpellMgr::LoadSpellInfoStore()
         mSpellInfoMap.emplace(spellNameEntry, key.second, data);
     }
 
+    BuildSpellInfoLookup();
+
     TC_LOG_INFO("server.loading", ">> Loaded SpellInfo store in {} ms", GetMSTimeDiffToNow(oldMSTime));
 }
 
 void SpellMgr::UnloadSpellInfoStore()
 {
+    mSpellInfoLookup.clear();
+    mSpellInfoLookupOverrides.clear();
     mSpellInfoMap.clear();
     mServersideSpellNames.clear();
+    mSpellEffectHotInfos.clear();
 }
 
 void SpellMgr::UnloadSpellInfoImplicitTargetConditionLists()
@@ -2727,6 +2852,10 @@ void SpellMgr::LoadSpellInfoServerside()
 {
     uint32 oldMSTime = getMSTime();
 
+    // serverside spells can fill gaps in the client store ids, look them up through the map until the lookup is rebuilt
+    mSpellInfoLookup.clear();
+    mSpellInfoLookupOverrides.clear();
+
     std::unordered_map<std::pair<uint32, Difficulty>, std::vector<SpellEffectEntry>> spellEffects;
 
     //                                                      0        1            2             3       4           5                6
@@ -2964,6 +3093,8 @@ void SpellMgr::LoadSpellInfoServerside()
         } while (spellsResult->NextRow());
     }
 
+    BuildSpellInfoLookup();
+
     TC_LOG_INFO("server.loading", ">> Loaded {} serverside spells {} ms", mServersideSpellNames.size(), GetMSTimeDiffToNow(oldMSTime));
 }
 
@@ -5027,6 +5158,46 @@ void SpellMgr::LoadSpellInfoDiminishing()
     TC_LOG_INFO("server.loading", ">> Loaded SpellInfo diminishing infos in {} ms", GetMSTimeDiffToNow(oldMSTime));
 }
 
+void SpellMgr::LoadSpellInfoHotData()
+{
+    uint32 oldMSTime = getMSTime();
+
+    static_assert(TOTAL_SPELL_EFFECTS <= std::numeric_limits<decltype(SpellEffectHotInfo::Effect)>::max());
+    static_assert(TOTAL_AURAS <= std::numeric_limits<decltype(SpellEffectHotInfo::ApplyAuraName)>::max());
+    static_assert(TOTAL_SPELL_TARGETS <= std::numeric_limits<decltype(SpellEffectHotInfo::TargetA)>::max());
+
+    std::size_t effectCount = 0;
+    for (SpellInfo const& spellInfo : mSpellInfoMap)
+        effectCount += spellInfo.GetEffects().size();
+
+    // reserved up front, spell infos keep pointers into the array
+    mSpellEffectHotInfos.clear();
+    mSpellEffectHotInfos.reserve(effectCount);
+
+    for (SpellInfo const& spellInfo : mSpellInfoMap)
+    {
+        std::size_t first = mSpellEffectHotInfos.size();
+        for (SpellEffectInfo const& effect : spellInfo.GetEffects())
+        {
+            SpellEffectHotInfo& hotInfo = mSpellEffectHotInfos.emplace_back();
+            hotInfo.Effect = uint16(effect.Effect);
+            hotInfo.ApplyAuraName = uint16(effect.ApplyAuraName);
+            hotInfo.TargetA = uint8(effect.TargetA.GetTarget());
+            hotInfo.TargetB = uint8(effect.TargetB.GetTarget());
+            if (effect.IsAura())
+                hotInfo.Flags |= SpellEffectHotInfo::FLAG_AURA;
+            if (effect.IsAreaAuraEffect())
+                hotInfo.Flags |= SpellEffectHotInfo::FLAG_AREA_AURA;
+            if (effect.IsTargetingArea())
+                hotInfo.Flags |= SpellEffectHotInfo::FLAG_TARGETING_AREA;
+        }
+
+        const_cast<SpellInfo&>(spellInfo)._hotEffects = std::span<SpellEffectHotInfo const>(mSpellEffectHotInfos.data() + first, spellInfo.GetEffects().size());
+    }
+
+    TC_LOG_INFO("server.loading", ">> Packed {} SpellInfo effects in {} ms", effectCount, GetMSTimeDiffToNow(oldMSTime));
+}
+
 void SpellMgr::LoadSpellInfoImmunities()
 {
     uint32 oldMSTime = getMSTime();
@@ -41,6 +41,10 @@
 
 class SpellInfo;
 class Player;
+namespace Trinity
+{
+class MemoryUsageReport;
+}
 class Unit;
 class ProcEventInfo;
 struct SkillLineAbilityEntry;
@@ -785,6 +789,9 @@ class TC_GAME_API SpellMgr
         void ForEachSpellInfo(std::function<void(SpellInfo const*)> callback);
         void ForEachSpellInfoDifficulty(uint32 spellId, std::function<void(SpellInfo const*)> callback);
 
+        // adds the spell info store and the largest spell data containers to the report
+        void GetMemoryUsage(Trinity::MemoryUsageReport& report) const;
+
         void LoadPetFamilySpellsStore();
 
         uint32 GetModelForTotem(uint32 spellId, uint8 race) const;
@@ -819,6 +826,7 @@ class TC_GAME_API SpellMgr
         void LoadSpellInfoSpellSpecificAndAuraState();
         void LoadSpellInfoDiminishing();
         void LoadSpellInfoImmunities();
+        void LoadSpellInfoHotData();                        // must be after all SpellInfo effect corrections
         void LoadSpellTotemModel();
 
     private:
@@ -18,6 +18,7 @@
 #include "SpellScript.h"
 #include "Log.h"
 #include "ScriptMgr.h"
+#include "ScriptProfiler.h"
 #include "Spell.h"
 #include "SpellAuras.h"
 #include "SpellMgr.h"
@@ -330,10 +331,15 @@ void SpellScript::_InitHit()
 void SpellScript::_PrepareScriptCall(SpellScriptHookType hookType)
 {
     m_currentScriptState = hookType;
+    if (ScriptProfiler::IsEnabled())
+        ScriptProfiler::BeginCall(ScriptProfileHook::SpellScript, m_spell->GetCaster()->GetMapId(), [this] { return m_scriptName; });
 }
 
 void SpellScript::_FinishScriptCall()
 {
+    if (ScriptProfiler::IsEnabled())
+        ScriptProfiler::EndCall();
+
     m_currentScriptState = SPELL_SCRIPT_STATE_NONE;
 }
 
@@ -933,10 +939,15 @@ void AuraScript::_PrepareScriptCall(AuraScriptHookType hookType, AuraApplication
     m_currentScriptState = hookType;
     m_defaultActionPrevented = false;
     m_auraApplication = aurApp;
+    if (ScriptProfiler::IsEnabled())
+        ScriptProfiler::BeginCall(ScriptProfileHook::AuraScript, m_aura->GetOwner()->GetMapId(), [this] { return m_scriptName; });
 }
 
 void AuraScript::_FinishScriptCall()
 {
+    if (ScriptProfiler::IsEnabled())
+        ScriptProfiler::EndCall();
+
     ScriptStateStore stateStore = m_scriptStates.top();
     m_currentScriptState = stateStore._currentScriptState;
     m_auraApplication = stateStore._auraApplication;
@@ -22,6 +22,7 @@
 #include "GuildMgr.h"
 #include "WorldSession.h"
 #include "Guild.h"
+#include <algorithm>
 
 WhoListStorageMgr* WhoListStorageMgr::instance()
 {
@@ -34,6 +35,11 @@ void WhoListStorageMgr::Update()
     // clear current list
     _whoListStorage.clear();
     _whoListStorage.reserve(sWorld->GetPlayerCount()+1);
+    for (auto& [zoneId, players] : _zoneIndex)
+        players.clear();
+
+    // guild names are converted once per guild instead of once per member
+    std::unordered_map<ObjectGuid::LowType, std::pair<std::string, std::wstring>> guildNames;
 
     HashMapHolder<Player>::MapType const& m = ObjectAccessor::GetPlayers();
     for (HashMapHolder<Player>::MapType::const_iterator itr = m.begin(); itr != m.end(); ++itr)
@@ -48,12 +54,17 @@ void WhoListStorageMgr::Update()
 
         wstrToLower(widePlayerName);
 
-        std::string guildName = sGuildMgr->GetGuildNameById(itr->second->GetGuildId());
-        std::wstring wideGuildName;
-        if (!Utf8toWStr(guildName, wideGuildName))
-            continue;
+        auto guildNameItr = guildNames.find(itr->second->GetGuildId());
+        if (guildNameItr == guildNames.end())
+        {
+            std::string guildName = sGuildMgr->GetGuildNameById(itr->second->GetGuildId());
+            std::wstring wideGuildName;
+            if (!Utf8toWStr(guildName, wideGuildName))
+                continue;
 
-        wstrToLower(wideGuildName);
+            wstrToLower(wideGuildName);
+            guildNameItr = guildNames.emplace(itr->second->GetGuildId(), std::make_pair(std::move(guildName), std::move(wideGuildName))).first;
+        }
 
         Guild* guild = itr->second->GetGuild();
         ObjectGuid guildGuid;
@@ -63,6 +74,42 @@ void WhoListStorageMgr::Update()
 
         _whoListStorage.emplace_back(itr->second->GetGUID(), itr->second->GetTeam(), itr->second->GetSession()->GetSecurity(), itr->second->GetLevel(),
             itr->second->GetClass(), itr->second->GetRace(), itr->second->GetZoneId(), itr->second->GetNativeGender(), itr->second->IsVisible(),
-            itr->second->IsGameMaster(), widePlayerName, wideGuildName, playerName, guildName, guildGuid);
+            itr->second->IsGameMaster(), widePlayerName, guildNameItr->second.second, playerName, guildNameItr->second.first, guildGuid);
     }
+
+    // queries only visit the level range and zones they ask for
+    std::stable_sort(_whoListStorage.begin(), _whoListStorage.end(), [](WhoListPlayerInfo const& left, WhoListPlayerInfo const& right)
+    {
+        return left.GetLevel() < right.GetLevel();
+    });
+
+    for (uint32 i = 0; i < _whoListStorage.size(); ++i)
+        _zoneIndex[_whoListStorage[i].GetZoneId()].push_back(i);
+}
+
+Trinity::IteratorPair<WhoListInfoVector::const_iterator> WhoListStorageMgr::GetPlayersInLevelRange(uint8 minLevel, uint8 maxLevel) const
+{
+    if (minLevel > maxLevel)
+        return { _whoListStorage.end(), _whoListStorage.end() };
+
+    auto begin = std::lower_bound(_whoListStorage.begin(), _whoListStorage.end(), minLevel, [](WhoListPlayerInfo const& player, uint8 level)
+    {
+        return player.GetLevel() < level;
+    });
+
+    auto end = std::upper_bound(begin, _whoListStorage.end(), maxLevel, [](uint8 level, WhoListPlayerInfo const& player)
+    {
+        return level < player.GetLevel();
+    });
+
+    return { begin, end };
+}
+
+WhoListIndexVector const* WhoListStorageMgr::GetPlayersInZone(uint32 zoneId) const
+{
+    auto itr = _zoneIndex.find(zoneId);
+    if (itr == _zoneIndex.end() || itr->second.empty())
+        return nullptr;
+
+    return &itr->second;
 }
@@ -19,7 +19,9 @@
 #define _WHOLISTSTORAGE_H
 
 #include "Common.h"
+#include "IteratorPair.h"
 #include "ObjectGuid.h"
+#include <unordered_map>
 
 class WhoListPlayerInfo
 {
@@ -64,6 +66,7 @@ private:
 };
 
 typedef std::vector<WhoListPlayerInfo> WhoListInfoVector;
+typedef std::vector<uint32> WhoListIndexVector;
 
 class TC_GAME_API WhoListStorageMgr
 {
@@ -75,10 +78,18 @@ public:
     static WhoListStorageMgr* instance();
 
     void Update();
+    // sorted by level
     WhoListInfoVector const& GetWhoList() const { return _whoListStorage; }
 
+    // players of GetWhoList() with level in [minLevel, maxLevel]
+    Trinity::IteratorPair<WhoListInfoVector::const_iterator> GetPlayersInLevelRange(uint8 minLevel, uint8 maxLevel) const;
+
+    // indexes into GetWhoList() of the players in zone, sorted by level, nullptr if there are none
+    WhoListIndexVector const* GetPlayersInZone(uint32 zoneId) const;
+
 protected:
     WhoListInfoVector _whoListStorage;
+    std::unordered_map<uint32, WhoListIndexVector> _zoneIndex;
 };
 
 #define sWhoListStorageMgr WhoListStorageMgr::instance()
@@ -87,6 +87,6 @@ ChatPacketSender* TrinityStringChatBuilder::operator()(LocaleConstant locale) co
 
 ChatPacketSender* CreatureTextTextBuilder::operator()(LocaleConstant locale) const
 {
-    return new ChatPacketSender(_msgType, _language, _talker, _target, sCreatureTextMgr->GetLocalizedChatString(_source->GetEntry(), _gender, _textGroup, _textId, locale), 0, locale);
+    return new ChatPacketSender(_msgType, _language, _talker, _target, std::string(sCreatureTextMgr->GetLocalizedChatText(_text, _gender, locale)), 0, locale);
 }
 }
@@ -25,6 +25,7 @@
 
 class Player;
 class WorldObject;
+struct CreatureTextEntry;
 
 namespace Trinity
 {
@@ -103,18 +104,16 @@ namespace Trinity
     class CreatureTextTextBuilder
     {
         public:
-            CreatureTextTextBuilder(WorldObject const* obj, WorldObject const* speaker, uint8 gender, ChatMsg msgtype, uint8 textGroup, uint32 id, Language language, WorldObject const* target)
-                : _source(obj), _talker(speaker), _gender(gender), _msgType(msgtype), _textGroup(textGroup), _textId(id), _language(language), _target(target) { }
+            CreatureTextTextBuilder(WorldObject const* speaker, uint8 gender, ChatMsg msgtype, CreatureTextEntry const& text, Language language, WorldObject const* target)
+                : _talker(speaker), _gender(gender), _msgType(msgtype), _text(text), _language(language), _target(target) { }
 
             ChatPacketSender* operator()(LocaleConstant locale) const;
 
         private:
-            WorldObject const* _source;
             WorldObject const* _talker;
             uint8 _gender;
             ChatMsg _msgType;
-            uint8 _textGroup;
-            uint32 _textId;
+            CreatureTextEntry const& _text;
             Language _language;
             WorldObject const* _target;
     };
@@ -192,21 +192,23 @@ uint32 CreatureTextMgr::SendChat(Creature* source, uint8 textGroup, WorldObject
 
     CreatureTextGroup const& textGroupContainer = itr->second;  //has all texts in the group
     CreatureTextRepeatIds repeatGroup = source->GetTextRepeatGroup(textGroup);//has all textIDs from the group that were already said
-    CreatureTextGroup tempGroup;//will use this to talk after sorting repeatGroup
+    std::vector<CreatureTextEntry const*> tempGroup;//will use this to talk after sorting repeatGroup
+    tempGroup.reserve(textGroupContainer.size());
 
-    for (CreatureTextGroup::const_iterator giter = textGroupContainer.begin(); giter != textGroupContainer.end(); ++giter)
-        if (std::find(repeatGroup.begin(), repeatGroup.end(), giter->id) == repeatGroup.end())
-            tempGroup.push_back(*giter);
+    for (CreatureTextEntry const& text : textGroupContainer)
+        if (std::find(repeatGroup.begin(), repeatGroup.end(), text.id) == repeatGroup.end())
+            tempGroup.push_back(&text);
 
     if (tempGroup.empty())
     {
         source->ClearTextRepeatGroup(textGroup);
-        tempGroup = textGroupContainer;
+        for (CreatureTextEntry const& text : textGroupContainer)
+            tempGroup.push_back(&text);
     }
 
-    auto iter = Trinity::Containers::SelectRandomWeightedContainerElement(tempGroup, [](CreatureTextEntry const& t) -> double
+    CreatureTextEntry const* iter = *Trinity::Containers::SelectRandomWeightedContainerElement(tempGroup, [](CreatureTextEntry const* t) -> double
     {
-        return t.probability;
+        return t->probability;
     });
 
     ChatMsg finalType = (msgType == CHAT_MSG_ADDON) ? iter->type : msgType;
@@ -237,12 +239,12 @@ uint32 CreatureTextMgr::SendChat(Creature* source, uint8 textGroup, WorldObject
 
     if (srcPlr)
     {
-        Trinity::CreatureTextTextBuilder builder(source, finalSource, finalSource->GetGender(), finalType, iter->groupId, iter->id, finalLang, whisperTarget);
+        Trinity::CreatureTextTextBuilder builder(finalSource, finalSource->GetGender(), finalType, *iter, finalLang, whisperTarget);
         SendChatPacket(finalSource, builder, finalType, whisperTarget, range, team, gmOnly);
     }
     else
     {
-        Trinity::CreatureTextTextBuilder builder(finalSource, finalSource, finalSource->GetGender(), finalType, iter->groupId, iter->id, finalLang, whisperTarget);
+        Trinity::CreatureTextTextBuilder builder(finalSource, finalSource->GetGender(), finalType, *iter, finalLang, whisperTarget);
         SendChatPacket(finalSource, builder, finalType, whisperTarget, range, team, gmOnly);
     }
 
@@ -423,23 +425,24 @@ std::string CreatureTextMgr::GetLocalizedChatString(uint32 entry, uint8 gender,
     if (groupItr == holderItr->second.end())
         return "";
 
+    return std::string(GetLocalizedChatText(*groupItr, gender, locale));
+}
+
+std::string_view CreatureTextMgr::GetLocalizedChatText(CreatureTextEntry const& text, uint8 gender, LocaleConstant locale) const
+{
     if (locale >= TOTAL_LOCALES)
         locale = DEFAULT_LOCALE;
 
-    std::string baseText = "";
-    BroadcastTextEntry const* bct = sBroadcastTextStore.LookupEntry(groupItr->BroadcastTextId);
-
-    if (bct)
-        baseText = DB2Manager::GetBroadcastTextValue(bct, locale, gender);
-    else
-        baseText = groupItr->text;
+    if (BroadcastTextEntry const* bct = sBroadcastTextStore.LookupEntry(text.BroadcastTextId))
+        return DB2Manager::GetBroadcastTextValue(bct, locale, gender);
 
-    if (locale != DEFAULT_LOCALE && !bct)
+    if (locale != DEFAULT_LOCALE)
     {
-        LocaleCreatureTextMap::const_iterator locItr = mLocaleTextMap.find(CreatureTextId(entry, uint32(textGroup), id));
+        LocaleCreatureTextMap::const_iterator locItr = mLocaleTextMap.find(CreatureTextId(text.creatureId, uint32(text.groupId), text.id));
         if (locItr != mLocaleTextMap.end())
-            ObjectMgr::GetLocaleString(locItr->second.Text, locale, baseText);
+            if (std::string_view localized = ObjectMgr::GetLocaleString(locItr->second.Text, locale); !localized.empty())
+                return localized;
     }
 
-    return baseText;
+    return text.text;
 }
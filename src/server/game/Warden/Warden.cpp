@@ -22,6 +22,7 @@
 #include "CryptoHash.h"
 #include "GameTime.h"
 #include "Log.h"
+#include "Random.h"
 #include "SmartEnum.h"
 #include "Util.h"
 #include "WardenPackets.h"
@@ -33,6 +34,9 @@
 Warden::Warden() : _session(nullptr), _checkTimer(10 * IN_MILLISECONDS), _clientResponseTimer(0),
                    _dataSent(false), _initialized(false)
 {
+    // delay the first request by a random part of the hold off, sessions that logged in together (after a restart)
+    // then send their requests spread over the whole interval instead of all in the same world tick
+    _checkTimer += urand(0, sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_CHECK_HOLDOFF) * IN_MILLISECONDS);
 }
 
 Warden::~Warden()
@@ -103,6 +107,8 @@ void Warden::Update(uint32 diff)
     if (!_initialized)
         return;
 
+    _validationCallbacks.ProcessReadyCallbacks();
+
     if (_dataSent)
     {
         uint32 maxClientResponseDelay = sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_RESPONSE_DELAY);
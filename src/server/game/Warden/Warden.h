@@ -19,7 +19,9 @@
 #define _WARDEN_BASE_H
 
 #include "ARC4.h"
+#include "AsyncCallbackProcessor.h"
 #include "AuthDefines.h"
+#include "CryptoWorkerPool.h"
 #include "Optional.h"
 #include "WardenCheckMgr.h"
 #include <array>
@@ -126,6 +128,7 @@ class TC_GAME_API Warden
         bool _dataSent;
         Optional<ClientWardenModule> _module;
         bool _initialized;
+        AsyncCallbackProcessor<Trinity::Crypto::WorkerCallback> _validationCallbacks;   // check results validated on crypto workers
 };
 
 #endif
@@ -22,6 +22,7 @@
 #include "Errors.h"
 #include "Log.h"
 #include "Warden.h"
+#include "WardenWin.h"
 #include "World.h"
 
 WardenCheckMgr::WardenCheckMgr()
@@ -117,6 +118,8 @@ void WardenCheckMgr::LoadWardenChecks()
         // initialize action with default action from config, this may be overridden later
         wardenCheck.Action = WardenActions(sWorld->getIntConfig(CONFIG_WARDEN_CLIENT_FAIL_ACTION));
 
+        WardenWin::PrepareCheckRequest(wardenCheck);
+
         _pools[category].push_back(id);
         ++count;
     }
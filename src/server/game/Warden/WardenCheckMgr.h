@@ -106,6 +106,11 @@ struct WardenCheck
     std::string Comment;
     std::array<char, 4> IdStr = {};                         // LUA
     WardenActions Action = WARDEN_ACTION_LOG;
+
+    // parts of the check request packet built once at load, see WardenWin::PrepareCheckRequest
+    std::vector<uint8> RequestString;                       // string table entry
+    std::vector<uint8> RequestData;                         // bytes following the check type, except per request values (string index, MODULE seed)
+    uint16 RequestSize = 0;                                 // total bytes used in the request packet
 };
 
 constexpr uint8 WARDEN_MAX_LUA_CHECK_LENGTH = 170;
@@ -210,6 +210,50 @@ static uint16 GetCheckPacketSize(WardenCheck const& check)
     return size;
 }
 
+void WardenWin::PrepareCheckRequest(WardenCheck& check)
+{
+    ByteBuffer requestString;
+    if (check.Type == LUA_EVAL_CHECK)
+    {
+        requestString << uint8(sizeof(_luaEvalPrefix) - 1 + check.Str.size() + sizeof(_luaEvalMidfix) - 1 + check.IdStr.size() + sizeof(_luaEvalPostfix) - 1);
+        requestString.append(_luaEvalPrefix, sizeof(_luaEvalPrefix) - 1);
+        requestString.append(check.Str.data(), check.Str.size());
+        requestString.append(_luaEvalMidfix, sizeof(_luaEvalMidfix) - 1);
+        requestString.append(check.IdStr.data(), check.IdStr.size());
+        requestString.append(_luaEvalPostfix, sizeof(_luaEvalPostfix) - 1);
+    }
+    else if (!check.Str.empty())
+    {
+        requestString << uint8(check.Str.size());
+        requestString.append(check.Str.data(), check.Str.size());
+    }
+
+    ByteBuffer requestData;
+    switch (check.Type)
+    {
+        case MEM_CHECK:
+            requestData << uint8(0x00);
+            requestData << uint32(check.Address);
+            requestData << uint8(sWardenCheckMgr->GetCheckResult(check.CheckId).size());
+            break;
+        case PAGE_CHECK_A:
+        case PAGE_CHECK_B:
+            requestData.append(check.Data.data(), check.Data.size());
+            requestData << uint32(check.Address);
+            requestData << uint8(check.Length);
+            break;
+        case DRIVER_CHECK:
+            requestData.append(check.Data.data(), check.Data.size());
+            break;
+        default:
+            break;
+    }
+
+    check.RequestString.assign(requestString.contents(), requestString.contents() + requestString.size());
+    check.RequestData.assign(requestData.contents(), requestData.contents() + requestData.size());
+    check.RequestSize = GetCheckPacketSize(check);
+}
+
 void WardenWin::RequestChecks()
 {
     TC_LOG_DEBUG("warden", "Request data from {} (account {}) - loaded: {}", _session->GetPlayerName(), _session->GetAccountId(), _session->GetPlayer() && !_session->PlayerLoading());
@@ -253,7 +297,7 @@ void WardenWin::RequestChecks()
     Trinity::Containers::EraseIf(_currentChecks,
         [&expectedSize](uint16 id)
         {
-            uint8 const thisSize = GetCheckPacketSize(sWardenCheckMgr->GetCheckData(id));
+            uint16 const thisSize = sWardenCheckMgr->GetCheckData(id).RequestSize;
             if ((expectedSize + thisSize) > 450) // warden packets are truncated to 512 bytes clientside
                 return true;
             expectedSize += thisSize;
@@ -264,20 +308,7 @@ void WardenWin::RequestChecks()
     for (uint16 const id : _currentChecks)
     {
         WardenCheck const& check = sWardenCheckMgr->GetCheckData(id);
-        if (check.Type == LUA_EVAL_CHECK)
-        {
-            buff << uint8(sizeof(_luaEvalPrefix) - 1 + check.Str.size() + sizeof(_luaEvalMidfix) - 1 + check.IdStr.size() + sizeof(_luaEvalPostfix) - 1);
-            buff.append(_luaEvalPrefix, sizeof(_luaEvalPrefix) - 1);
-            buff.append(check.Str.data(), check.Str.size());
-            buff.append(_luaEvalMidfix, sizeof(_luaEvalMidfix) - 1);
-            buff.append(check.IdStr.data(), check.IdStr.size());
-            buff.append(_luaEvalPostfix, sizeof(_luaEvalPostfix) - 1);
-        }
-        else if (!check.Str.empty())
-        {
-            buff << uint8(check.Str.size());
-            buff.append(check.Str.data(), check.Str.size());
-        }
+        buff.append(check.RequestString.data(), check.RequestString.size());
     }
 
     uint8 xorByte = _inputKey[0];
@@ -294,32 +325,13 @@ void WardenWin::RequestChecks()
 
         WardenCheckType const type = check.Type;
         buff << uint8(type ^ xorByte);
+        buff.append(check.RequestData.data(), check.RequestData.size());
         switch (type)
         {
-            case MEM_CHECK:
-            {
-                buff << uint8(0x00);
-                buff << uint32(check.Address);
-                buff << uint8(sWardenCheckMgr->GetCheckResult(id).size());
-                break;
-            }
-            case PAGE_CHECK_A:
-            case PAGE_CHECK_B:
-            {
-                buff.append(check.Data.data(), check.Data.size());
-                buff << uint32(check.Address);
-                buff << uint8(check.Length);
-                break;
-            }
             case MPQ_CHECK:
             case LUA_EVAL_CHECK:
-            {
-                buff << uint8(index++);
-                break;
-            }
             case DRIVER_CHECK:
             {
-                buff.append(check.Data.data(), check.Data.size());
                 buff << uint8(index++);
                 break;
             }
@@ -379,8 +391,43 @@ void WardenWin::HandleCheckResult(ByteBuffer &buff)
 {
     TC_LOG_DEBUG("warden", "Handle data");
 
-    _dataSent = false;
-    _clientResponseTimer = 0;
+    // validating the result only needs the packet and the checks that were requested,
+    // the verdict is applied to the session once a crypto worker is done with it
+    std::shared_ptr<CheckResultValidation> validation = std::make_shared<CheckResultValidation>();
+    validation->Data = std::move(buff);
+    validation->Checks = _currentChecks;
+    validation->AccountId = _session->GetAccountId();
+    validation->ServerTicks = _serverTicks;
+    validation->ReceivedTicks = GameTime::GetGameTimeMS();
+
+    _validationCallbacks.AddCallback(sCryptoWorkerPool.Post([validation]
+    {
+        return ValidateCheckResult(*validation);
+    }, [this, validation](Optional<std::pair<CheckResultVerdict, uint16>> verdict)
+    {
+        // workers are busy, validate here instead of penalizing the client for it
+        if (!verdict)
+            verdict = ValidateCheckResult(*validation);
+
+        ApplyCheckResultVerdict(verdict->first, verdict->second);
+    }));
+}
+
+std::pair<WardenWin::CheckResultVerdict, uint16> WardenWin::ValidateCheckResult(CheckResultValidation& validation)
+{
+    try
+    {
+        return ValidateCheckResultData(validation);
+    }
+    catch (ByteBufferException const&)
+    {
+        return { CheckResultVerdict::Malformed, 0 };
+    }
+}
+
+std::pair<WardenWin::CheckResultVerdict, uint16> WardenWin::ValidateCheckResultData(CheckResultValidation& validation)
+{
+    ByteBuffer& buff = validation.Data;
 
     uint16 Length;
     buff >> Length;
@@ -388,20 +435,10 @@ void WardenWin::HandleCheckResult(ByteBuffer &buff)
     buff >> Checksum;
 
     if (Length != (buff.size() - buff.rpos()))
-    {
-        buff.rfinish();
-        char const* penalty = ApplyPenalty(nullptr);
-        TC_LOG_WARN("warden", "{} sends manipulated warden packet. Action: {}", _session->GetPlayerInfo(), penalty);
-        return;
-    }
+        return { CheckResultVerdict::Manipulated, 0 };
 
     if (!IsValidCheckSum(Checksum, buff.contents() + buff.rpos(), Length))
-    {
-        buff.rfinish();
-        char const* penalty = ApplyPenalty(nullptr);
-        TC_LOG_WARN("warden", "{} failed checksum. Action: {}", _session->GetPlayerInfo(), penalty);
-        return;
-    }
+        return { CheckResultVerdict::ChecksumMismatch, 0 };
 
     // TIMING_CHECK
     {
@@ -409,26 +446,21 @@ void WardenWin::HandleCheckResult(ByteBuffer &buff)
         buff >> result;
         /// @todo test it.
         if (result == 0x00)
-        {
-            char const* penalty = ApplyPenalty(nullptr);
-            TC_LOG_WARN("warden", "{} failed timing check. Action: {}", _session->GetPlayerInfo(), penalty);
-            return;
-        }
+            return { CheckResultVerdict::TimingFailed, 0 };
 
         uint32 newClientTicks;
         buff >> newClientTicks;
 
-        uint32 ticksNow = GameTime::GetGameTimeMS();
-        uint32 ourTicks = newClientTicks + (ticksNow - _serverTicks);
+        uint32 ourTicks = newClientTicks + (validation.ReceivedTicks - validation.ServerTicks);
 
-        TC_LOG_DEBUG("warden", "Server tick count now:    {}", ticksNow);
-        TC_LOG_DEBUG("warden", "Server tick count at req: {}", _serverTicks);
+        TC_LOG_DEBUG("warden", "Server tick count now:    {}", validation.ReceivedTicks);
+        TC_LOG_DEBUG("warden", "Server tick count at req: {}", validation.ServerTicks);
         TC_LOG_DEBUG("warden", "Client ticks in response: {}", newClientTicks);
         TC_LOG_DEBUG("warden", "Round trip response time: {} ms", ourTicks - newClientTicks);
     }
 
     uint16 checkFailed = 0;
-    for (uint16 const id : _currentChecks)
+    for (uint16 const id : validation.Checks)
     {
         WardenCheck const& check = sWardenCheckMgr->GetCheckData(id);
 
@@ -441,7 +473,7 @@ void WardenWin::HandleCheckResult(ByteBuffer &buff)
 
                 if (Mem_Result != 0)
                 {
-                    TC_LOG_DEBUG("warden", "RESULT MEM_CHECK not 0x00, CheckId {} account Id {}", id, _session->GetAccountId());
+                    TC_LOG_DEBUG("warden", "RESULT MEM_CHECK not 0x00, CheckId {} account Id {}", id, validation.AccountId);
                     checkFailed = id;
                     continue;
                 }
@@ -454,14 +486,14 @@ void WardenWin::HandleCheckResult(ByteBuffer &buff)
 
                 if (response != expected)
                 {
-                    TC_LOG_DEBUG("warden", "RESULT MEM_CHECK fail CheckId {} account Id {}", id, _session->GetAccountId());
+                    TC_LOG_DEBUG("warden", "RESULT MEM_CHECK fail CheckId {} account Id {}", id, validation.AccountId);
                     TC_LOG_DEBUG("warden", "Expected: {}", ByteArrayToHexStr(expected));
                     TC_LOG_DEBUG("warden", "Got:      {}", ByteArrayToHexStr(response));
                     checkFailed = id;
                     continue;
                 }
 
-                TC_LOG_DEBUG("warden", "RESULT MEM_CHECK passed CheckId {} account Id {}", id, _session->GetAccountId());
+                TC_LOG_DEBUG("warden", "RESULT MEM_CHECK passed CheckId {} account Id {}", id, validation.AccountId);
                 break;
             }
             case PAGE_CHECK_A:
@@ -471,12 +503,12 @@ void WardenWin::HandleCheckResult(ByteBuffer &buff)
             {
                 if (buff.read<uint8>() != 0xE9)
                 {
-                    TC_LOG_DEBUG("warden", "RESULT {} fail, CheckId {} account Id {}", EnumUtils::ToConstant(check.Type), id, _session->GetAccountId());
+                    TC_LOG_DEBUG("warden", "RESULT {} fail, CheckId {} account Id {}", EnumUtils::ToConstant(check.Type), id, validation.AccountId);
                     checkFailed = id;
                     continue;
                 }
 
-                TC_LOG_DEBUG("warden", "RESULT {} passed CheckId {} account Id {}", EnumUtils::ToConstant(check.Type), id, _session->GetAccountId());
+                TC_LOG_DEBUG("warden", "RESULT {} passed CheckId {} account Id {}", EnumUtils::ToConstant(check.Type), id, validation.AccountId);
                 break;
             }
             case LUA_EVAL_CHECK:
@@ -485,7 +517,7 @@ void WardenWin::HandleCheckResult(ByteBuffer &buff)
                 if (result == 0)
                     buff.read_skip(buff.read<uint8>()); // discard attached string
 
-                TC_LOG_DEBUG("warden", "LUA_EVAL_CHECK CheckId {} account Id {} got in-warden dummy response ({})", id, _session->GetAccountId(), result);
+                TC_LOG_DEBUG("warden", "LUA_EVAL_CHECK CheckId {} account Id {} got in-warden dummy response ({})", id, validation.AccountId, result);
                 break;
             }
             case MPQ_CHECK:
@@ -495,7 +527,7 @@ void WardenWin::HandleCheckResult(ByteBuffer &buff)
 
                 if (Mpq_Result != 0)
                 {
-                    TC_LOG_DEBUG("warden", "RESULT MPQ_CHECK not 0x00 account id {}", _session->GetAccountId());
+                    TC_LOG_DEBUG("warden", "RESULT MPQ_CHECK not 0x00 account id {}", validation.AccountId);
                     checkFailed = id;
                     continue;
                 }
@@ -505,12 +537,12 @@ void WardenWin::HandleCheckResult(ByteBuffer &buff)
                 buff.read(result.data(), result.size());
                 if (result != sWardenCheckMgr->GetCheckResult(id)) // SHA1
                 {
-                    TC_LOG_DEBUG("warden", "RESULT MPQ_CHECK fail, CheckId {} account Id {}", id, _session->GetAccountId());
+                    TC_LOG_DEBUG("warden", "RESULT MPQ_CHECK fail, CheckId {} account Id {}", id, validation.AccountId);
                     checkFailed = id;
                     continue;
                 }
 
-                TC_LOG_DEBUG("warden", "RESULT MPQ_CHECK passed, CheckId {} account Id {}", id, _session->GetAccountId());
+                TC_LOG_DEBUG("warden", "RESULT MPQ_CHECK passed, CheckId {} account Id {}", id, validation.AccountId);
                 break;
             }
             default:                                        // Should never happen
@@ -519,10 +551,48 @@ void WardenWin::HandleCheckResult(ByteBuffer &buff)
     }
 
     if (checkFailed > 0)
+        return { CheckResultVerdict::CheckFailed, checkFailed };
+
+    return { CheckResultVerdict::Passed, 0 };
+}
+
+void WardenWin::ApplyCheckResultVerdict(CheckResultVerdict verdict, uint16 failedCheckId)
+{
+    _dataSent = false;
+    _clientResponseTimer = 0;
+
+    switch (verdict)
     {
-        WardenCheck const& check = sWardenCheckMgr->GetCheckData(checkFailed);
-        char const* penalty = ApplyPenalty(&check);
-        TC_LOG_WARN("warden", "{} failed Warden check {} ({}). Action: {}", _session->GetPlayerInfo(), checkFailed, EnumUtils::ToConstant(check.Type), penalty);
+        case CheckResultVerdict::Malformed:
+            TC_LOG_WARN("warden", "{} sent a check result shorter than the requested checks", _session->GetPlayerInfo());
+            return;
+        case CheckResultVerdict::Manipulated:
+        {
+            char const* penalty = ApplyPenalty(nullptr);
+            TC_LOG_WARN("warden", "{} sends manipulated warden packet. Action: {}", _session->GetPlayerInfo(), penalty);
+            return;
+        }
+        case CheckResultVerdict::ChecksumMismatch:
+        {
+            char const* penalty = ApplyPenalty(nullptr);
+            TC_LOG_WARN("warden", "{} failed checksum. Action: {}", _session->GetPlayerInfo(), penalty);
+            return;
+        }
+        case CheckResultVerdict::TimingFailed:
+        {
+            char const* penalty = ApplyPenalty(nullptr);
+            TC_LOG_WARN("warden", "{} failed timing check. Action: {}", _session->GetPlayerInfo(), penalty);
+            return;
+        }
+        case CheckResultVerdict::CheckFailed:
+        {
+            WardenCheck const& check = sWardenCheckMgr->GetCheckData(failedCheckId);
+            char const* penalty = ApplyPenalty(&check);
+            TC_LOG_WARN("warden", "{} failed Warden check {} ({}). Action: {}", _session->GetPlayerInfo(), failedCheckId, EnumUtils::ToConstant(check.Type), penalty);
+            break;
+        }
+        default:
+            break;
     }
 
     // Set hold off timer, minimum timer should at least be 1 second
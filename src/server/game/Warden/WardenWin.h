@@ -19,6 +19,7 @@
 #define _WARDEN_WIN_H
 
 #include "Cryptography/ARC4.h"
+#include "ByteBuffer.h"
 #include "Cryptography/BigNumber.h"
 #include "Warden.h"
 #include <array>
@@ -77,7 +78,34 @@ class TC_GAME_API WardenWin : public Warden
 
         size_t DEBUG_ForceSpecificChecks(std::vector<uint16> const& checks) override;
 
+        // fills the request parts of WardenCheck that are the same for every session
+        static void PrepareCheckRequest(WardenCheck& check);
+
     private:
+        enum class CheckResultVerdict : uint8
+        {
+            Passed,
+            Malformed,
+            Manipulated,
+            ChecksumMismatch,
+            TimingFailed,
+            CheckFailed
+        };
+
+        struct CheckResultValidation
+        {
+            ByteBuffer Data;
+            std::vector<uint16> Checks;
+            uint32 AccountId = 0;
+            uint32 ServerTicks = 0;
+            uint32 ReceivedTicks = 0;
+        };
+
+        // does not touch the session, runs on crypto workers
+        static std::pair<CheckResultVerdict, uint16> ValidateCheckResult(CheckResultValidation& validation);
+        static std::pair<CheckResultVerdict, uint16> ValidateCheckResultData(CheckResultValidation& validation);
+        void ApplyCheckResultVerdict(CheckResultVerdict verdict, uint16 failedCheckId);
+
         uint32 _serverTicks;
         std::array<std::pair<std::vector<uint16>, std::vector<uint16>::const_iterator>, NUM_CHECK_CATEGORIES> _checks;
         std::vector<uint16> _currentChecks;
@@ -36,6 +36,7 @@
 #include "ChannelMgr.h"
 #include "CharacterCache.h"
 #include "CharacterDatabaseCleaner.h"
+#include "CharacterEnumCache.h"
 #include "CharacterTemplateDataStore.h"
 #include "Chat.h"
 #include "ChatCommand.h"
@@ -72,10 +73,12 @@
 #include "MMapFactory.h"
 #include "Map.h"
 #include "MapManager.h"
+#include "MemoryUsage.h"
 #include "Metric.h"
 #include "MiscPackets.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
+#include "OpcodeProfiler.h"
 #include "OutdoorPvPMgr.h"
 #include "PetitionMgr.h"
 #include "Player.h"
@@ -85,14 +88,18 @@
 #include "Realm.h"
 #include "ScenarioMgr.h"
 #include "ScriptMgr.h"
+#include "ScriptProfiler.h"
 #include "ScriptReloadMgr.h"
 #include "SkillDiscovery.h"
 #include "SkillExtraItems.h"
 #include "SmartScriptMgr.h"
 #include "SpellMgr.h"
 #include "SupportMgr.h"
+#include "TaskGraph.h"
 #include "TaxiPathGraph.h"
 #include "TerrainMgr.h"
+#include "ThreadPool.h"
+#include "TickTracer.h"
 #include "TraitMgr.h"
 #include "TransportMgr.h"
 #include "Unit.h"
@@ -159,6 +166,7 @@ World::World()
     m_NextCalendarOldEventsDeletionTime = 0;
     m_NextGuildReset = 0;
     m_NextCurrencyReset = 0;
+    m_NextSlowTickTrace = 0;
 
     m_defaultDbcLocale = LOCALE_enUS;
     m_availableDbcLocaleMask = 0;
@@ -772,6 +780,8 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_CLEAN_CHARACTER_DB] = sConfigMgr->GetBoolDefault("CleanCharacterDB", false);
     m_int_configs[CONFIG_PERSISTENT_CHARACTER_CLEAN_FLAGS] = sConfigMgr->GetIntDefault("PersistentCharacterCleanFlags", 0);
     m_int_configs[CONFIG_AUCTION_REPLICATE_DELAY] = sConfigMgr->GetIntDefault("Auction.ReplicateItemsCooldown", 900);
+    m_int_configs[CONFIG_AUCTION_REPLICATE_SNAPSHOT_INTERVAL] = sConfigMgr->GetIntDefault("Auction.ReplicateSnapshotInterval", 60);
+    m_int_configs[CONFIG_AUCTION_EXPIRE_BATCH_SIZE] = sConfigMgr->GetIntDefault("Auction.ExpireBatchSize", 200);
     m_int_configs[CONFIG_AUCTION_SEARCH_DELAY] = sConfigMgr->GetIntDefault("Auction.SearchDelay", 300);
     if (m_int_configs[CONFIG_AUCTION_SEARCH_DELAY] < 100 || m_int_configs[CONFIG_AUCTION_SEARCH_DELAY] > 10000)
     {
@@ -813,6 +823,7 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_INTERVAL_SAVE] = sConfigMgr->GetIntDefault("PlayerSaveInterval", 15 * MINUTE * IN_MILLISECONDS);
     m_int_configs[CONFIG_INTERVAL_DISCONNECT_TOLERANCE] = sConfigMgr->GetIntDefault("DisconnectToleranceInterval", 0);
     m_bool_configs[CONFIG_STATS_SAVE_ONLY_ON_LOGOUT] = sConfigMgr->GetBoolDefault("PlayerSave.Stats.SaveOnlyOnLogout", true);
+    m_int_configs[CONFIG_SHUTDOWN_SAVE_TIMEOUT] = sConfigMgr->GetIntDefault("PlayerSave.ShutdownTimeout", 120);
 
     m_int_configs[CONFIG_MIN_LEVEL_STAT_SAVE] = sConfigMgr->GetIntDefault("PlayerSave.Stats.MinLevel", 0);
     if (m_int_configs[CONFIG_MIN_LEVEL_STAT_SAVE] > MAX_LEVEL)
@@ -830,6 +841,9 @@ void World::LoadConfigSettings(bool reload)
     if (reload)
         sMapMgr->SetGridCleanUpDelay(m_int_configs[CONFIG_INTERVAL_GRIDCLEAN]);
 
+    m_int_configs[CONFIG_GRID_MEMORY_BUDGET_PER_MAP] = sConfigMgr->GetIntDefault("GridUnload.MemoryBudget.PerMap", 0);
+    m_int_configs[CONFIG_GRID_MEMORY_BUDGET_TOTAL] = sConfigMgr->GetIntDefault("GridUnload.MemoryBudget.Total", 0);
+
     m_int_configs[CONFIG_INTERVAL_MAPUPDATE] = sConfigMgr->GetIntDefault("MapUpdateInterval", 10);
     if (m_int_configs[CONFIG_INTERVAL_MAPUPDATE] < MIN_MAP_UPDATE_DELAY)
     {
@@ -1247,6 +1261,7 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_CHATFLOOD_MUTE_TIME]     = sConfigMgr->GetIntDefault("ChatFlood.MuteTime", 10);
 
     m_bool_configs[CONFIG_EVENT_ANNOUNCE] = sConfigMgr->GetBoolDefault("Event.Announce", false);
+    m_int_configs[CONFIG_GAME_EVENT_SPAWN_BATCH_SIZE] = sConfigMgr->GetIntDefault("Event.SpawnBatchSize", 200);
 
     m_float_configs[CONFIG_CREATURE_FAMILY_FLEE_ASSISTANCE_RADIUS] = sConfigMgr->GetFloatDefault("CreatureFamilyFleeAssistanceRadius", 30.0f);
     m_float_configs[CONFIG_CREATURE_FAMILY_ASSISTANCE_RADIUS] = sConfigMgr->GetFloatDefault("CreatureFamilyAssistanceRadius", 10.0f);
@@ -1448,6 +1463,16 @@ void World::LoadConfigSettings(bool reload)
     m_visibility_notify_periodInBG         = sConfigMgr->GetIntDefault("Visibility.Notify.Period.InBG",         DEFAULT_VISIBILITY_NOTIFY_PERIOD);
     m_visibility_notify_periodInArenas     = sConfigMgr->GetIntDefault("Visibility.Notify.Period.InArenas",     DEFAULT_VISIBILITY_NOTIFY_PERIOD);
 
+    m_int_configs[CONFIG_MOVEMENT_RELAY_LOD_NEAR_DISTANCE] = sConfigMgr->GetIntDefault("Movement.RelayLod.Near.Distance", 0);
+    m_int_configs[CONFIG_MOVEMENT_RELAY_LOD_NEAR_INTERVAL] = std::max(sConfigMgr->GetIntDefault("Movement.RelayLod.Near.Interval", 2), 1);
+    m_int_configs[CONFIG_MOVEMENT_RELAY_LOD_FAR_DISTANCE] = sConfigMgr->GetIntDefault("Movement.RelayLod.Far.Distance", 0);
+    m_int_configs[CONFIG_MOVEMENT_RELAY_LOD_FAR_INTERVAL] = std::max(sConfigMgr->GetIntDefault("Movement.RelayLod.Far.Interval", 4), 1);
+    m_int_configs[CONFIG_CREATURE_DORMANT_UPDATE_INTERVAL] = sConfigMgr->GetIntDefault("Creature.DormantUpdateInterval", 0);
+    m_int_configs[CONFIG_CREATURE_IDLE_AI_UPDATE_INTERVAL] = sConfigMgr->GetIntDefault("Creature.IdleAIUpdateInterval", 0);
+    m_bool_configs[CONFIG_CREATURE_FORMATION_SHARED_PATH] = sConfigMgr->GetBoolDefault("Creature.Formation.SharedPath", false);
+    m_int_configs[CONFIG_MOVEMENT_REPATH_INTERVAL] = sConfigMgr->GetIntDefault("Movement.Repath.Interval", 0);
+    m_float_configs[CONFIG_MOVEMENT_REPATH_TOLERANCE] = std::max(0.0f, sConfigMgr->GetFloatDefault("Movement.Repath.Tolerance", 0.0f));
+
     ///- Load the CharDelete related config options
     m_int_configs[CONFIG_CHARDELETE_METHOD] = sConfigMgr->GetIntDefault("CharDelete.Method", 0);
     m_int_configs[CONFIG_CHARDELETE_MIN_LEVEL] = sConfigMgr->GetIntDefault("CharDelete.MinLevel", 0);
@@ -1544,6 +1569,10 @@ void World::LoadConfigSettings(bool reload)
     }
 
     m_bool_configs[CONFIG_ENABLE_MMAPS] = sConfigMgr->GetBoolDefault("mmap.enablePathFinding", true);
+    m_int_configs[CONFIG_PATHFINDING_THREADS] = sConfigMgr->GetIntDefault("mmap.PathFinding.Threads", 0);
+    m_int_configs[CONFIG_SESSION_UPDATE_THREADS] = std::max(sConfigMgr->GetIntDefault("SessionUpdate.Threads", 1), 1);
+    m_int_configs[CONFIG_MMAP_PATH_CACHE_SIZE] = sConfigMgr->GetIntDefault("mmap.PathCache.Size", 0);
+    m_int_configs[CONFIG_MMAP_TILE_MEMORY_BUDGET] = sConfigMgr->GetIntDefault("mmap.TileMemoryBudget", 0);
     TC_LOG_INFO("server.loading", "WORLD: MMap data directory is: {}mmaps", m_dataPath);
 
     m_bool_configs[CONFIG_VMAP_INDOOR_CHECK] = sConfigMgr->GetBoolDefault("vmap.enableIndoorCheck", false);
@@ -1558,6 +1587,9 @@ void World::LoadConfigSettings(bool reload)
     VMAP::VMapFactory::createOrGetVMapManager()->setEnableHeightCalc(enableHeight);
     TC_LOG_INFO("server.loading", "VMap support included. LineOfSight: {}, getHeight: {}, indoorCheck: {}", enableLOS, enableHeight, enableIndoor);
     TC_LOG_INFO("server.loading", "VMap data directory is: {}vmaps", m_dataPath);
+    m_int_configs[CONFIG_VMAP_LOS_CACHE_SIZE] = sConfigMgr->GetIntDefault("vmap.LineOfSightCache.Size", 0);
+    m_int_configs[CONFIG_VMAP_TERRAIN_STATUS_CACHE_SIZE] = sConfigMgr->GetIntDefault("vmap.TerrainStatusCache.Size", 0);
+    m_float_configs[CONFIG_TERRAIN_STATUS_REUSE_DISTANCE] = std::max(0.0f, sConfigMgr->GetFloatDefault("vmap.TerrainStatusReuseDistance", 0.0f));
 
     m_int_configs[CONFIG_MAX_WHO] = sConfigMgr->GetIntDefault("MaxWhoListReturns", 49);
     m_bool_configs[CONFIG_START_ALL_SPELLS] = sConfigMgr->GetBoolDefault("PlayerStart.AllSpells", false);
@@ -1580,6 +1612,17 @@ void World::LoadConfigSettings(bool reload)
     m_bool_configs[CONFIG_SHOW_MUTE_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowMuteInWorld", false);
     m_bool_configs[CONFIG_SHOW_BAN_IN_WORLD] = sConfigMgr->GetBoolDefault("ShowBanInWorld", false);
     m_int_configs[CONFIG_NUMTHREADS] = sConfigMgr->GetIntDefault("MapUpdate.Threads", 1);
+    m_int_configs[CONFIG_MAP_UPDATE_REGION_THREADS] = sConfigMgr->GetIntDefault("MapUpdate.Regions.Threads", 0);
+    m_int_configs[CONFIG_GRID_PREPARE_THREADS] = sConfigMgr->GetIntDefault("MapUpdate.GridPrepare.Threads", 1);
+    m_int_configs[CONFIG_GRID_PREPARE_LOOKAHEAD] = sConfigMgr->GetIntDefault("MapUpdate.GridPrepare.LookAhead", 5000);
+    m_int_configs[CONFIG_GRID_PREPARE_MAX_PENDING] = sConfigMgr->GetIntDefault("MapUpdate.GridPrepare.MaxPendingGrids", 32);
+    m_int_configs[CONFIG_INSTANCE_POOL_SIZE] = sConfigMgr->GetIntDefault("InstanceMap.Pool.Size", 0);
+    m_int_configs[CONFIG_PACKET_PROFILER_SAMPLE_RATE] = sConfigMgr->GetIntDefault("Metric.PacketProfiler.SampleRate", 16);
+    m_int_configs[CONFIG_SCRIPT_PROFILER_SAMPLE_RATE] = sConfigMgr->GetIntDefault("Metric.ScriptProfiler.SampleRate", 0);
+    m_int_configs[CONFIG_METRIC_MEMORY_USAGE_INTERVAL] = sConfigMgr->GetIntDefault("Metric.MemoryUsageInterval", 5);
+    m_bool_configs[CONFIG_TICK_TRACER_ENABLE] = sConfigMgr->GetBoolDefault("Metric.TickTracer.Enable", false);
+    m_int_configs[CONFIG_TICK_TRACER_SLOW_TICK_THRESHOLD] = sConfigMgr->GetIntDefault("Metric.TickTracer.SlowTickThreshold", 0);
+    Trinity::TickTracer::SetRecording(m_bool_configs[CONFIG_TICK_TRACER_ENABLE]);
     m_int_configs[CONFIG_MAX_RESULTS_LOOKUP_COMMANDS] = sConfigMgr->GetIntDefault("Command.LookupMaxResults", 0);
 
     // Warden
@@ -1591,6 +1634,7 @@ void World::LoadConfigSettings(bool reload)
     m_int_configs[CONFIG_WARDEN_CLIENT_CHECK_HOLDOFF]  = sConfigMgr->GetIntDefault("Warden.ClientCheckHoldOff", 30);
     m_int_configs[CONFIG_WARDEN_CLIENT_FAIL_ACTION]    = sConfigMgr->GetIntDefault("Warden.ClientCheckFailAction", 0);
     m_int_configs[CONFIG_WARDEN_CLIENT_RESPONSE_DELAY] = sConfigMgr->GetIntDefault("Warden.ClientResponseDelay", 600);
+    m_int_configs[CONFIG_WARDEN_VALIDATION_THREADS]    = sConfigMgr->GetIntDefault("Warden.ValidationThreads", 1);
 
     // Feature System
     m_bool_configs[CONFIG_FEATURE_SYSTEM_BPAY_STORE_ENABLED]         = sConfigMgr->GetBoolDefault("FeatureSystem.BpayStore.Enabled", false);
@@ -1726,6 +1770,22 @@ void World::LoadConfigSettings(bool reload)
 
     // Loading of Locales
     m_bool_configs[CONFIG_LOAD_LOCALES] = sConfigMgr->GetBoolDefault("Load.Locales", true);
+    m_int_configs[CONFIG_LOAD_THREADS] = std::max(sConfigMgr->GetIntDefault("Load.Threads", 4), 1);
+    m_bool_configs[CONFIG_LOAD_DB2_MAP_FILES] = sConfigMgr->GetBoolDefault("Load.DB2.MapFiles", false);
+    m_bool_configs[CONFIG_LOAD_GRID_MAP_FILES] = sConfigMgr->GetBoolDefault("Load.Maps.MapFiles", false);
+    m_int_configs[CONFIG_LOAD_CINEMATIC_CAMERA_CACHE_SIZE] = sConfigMgr->GetIntDefault("Load.CinematicCameras.CacheSize", 64);
+
+    // Locales whose db2 strings are loaded, sessions of other locales use DBC.Locale
+    m_int_configs[CONFIG_LOAD_LOCALES_MASK] = 0;
+    std::string loadedLocales = sConfigMgr->GetStringDefault("Load.Locales.List", "");
+    for (std::string_view localeName : Trinity::Tokenize(loadedLocales, ' ', false))
+    {
+        LocaleConstant locale = GetLocaleByName(localeName);
+        if (IsValidLocale(locale))
+            m_int_configs[CONFIG_LOAD_LOCALES_MASK] |= 1 << locale;
+        else
+            TC_LOG_ERROR("server.loading", "Load.Locales.List contains unknown locale {}, ignored.", localeName);
+    }
 
     // call ScriptMgr if we're reloading the configuration
     if (reload)
@@ -1757,6 +1817,19 @@ bool World::SetInitialWorldSettings()
     ///- Initialize Allowed Security Level
     LoadDBAllowedSecurityLevel();
 
+    ///- Independent loaders are declared as task graphs and run on this pool
+    std::unique_ptr<Trinity::ThreadPool> loaderPool;
+    if (m_int_configs[CONFIG_LOAD_THREADS] > 1)
+        loaderPool = std::make_unique<Trinity::ThreadPool>(m_int_configs[CONFIG_LOAD_THREADS]);
+
+    std::vector<Trinity::TaskGraph::Timing> loaderTimings;
+    auto runLoaders = [&](Trinity::TaskGraph& loaders)
+    {
+        loaders.Run(loaderPool.get());
+        for (Trinity::TaskGraph::Timing& timing : loaders.GetTimings())
+            loaderTimings.push_back(std::move(timing));
+    };
+
     ///- Init highest guids before any table loading to prevent using not initialized guids in some code.
     sObjectMgr->SetHighestGuids();
 
@@ -1798,7 +1871,7 @@ bool World::SetInitialWorldSettings()
 
     TC_LOG_INFO("server.loading", "Initialize data stores...");
     ///- Load DB2s
-    m_availableDbcLocaleMask = sDB2Manager.LoadStores(m_dataPath, m_defaultDbcLocale);
+    m_availableDbcLocaleMask = sDB2Manager.LoadStores(m_dataPath, m_defaultDbcLocale, loaderPool.get());
     if (!(m_availableDbcLocaleMask & (1 << m_defaultDbcLocale)))
     {
         TC_LOG_FATAL("server.loading", "Unable to load db2 files for {} locale specified in DBC.Locale config!", localeNames[m_defaultDbcLocale]);
@@ -1818,8 +1891,9 @@ bool World::SetInitialWorldSettings()
     sDB2Manager.LoadHotfixData(m_availableDbcLocaleMask);
     TC_LOG_INFO("misc", "Loading hotfix optional data...");
     sDB2Manager.LoadHotfixOptionalData(m_availableDbcLocaleMask);
+    sDB2Manager.LoadHotfixPushContent(m_availableDbcLocaleMask);
     ///- Load M2 fly by cameras
-    LoadM2Cameras(m_dataPath);
+    LoadM2Cameras(m_dataPath, getIntConfig(CONFIG_LOAD_CINEMATIC_CAMERA_CACHE_SIZE));
     ///- Load GameTables
     LoadGameTables(m_dataPath);
 
@@ -1883,6 +1957,9 @@ bool World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading SpellInfo immunity infos...");
     sSpellMgr->LoadSpellInfoImmunities();
 
+    TC_LOG_INFO("server.loading", "Packing SpellInfo hot data...");
+    sSpellMgr->LoadSpellInfoHotData();
+
     TC_LOG_INFO("server.loading", "Loading PetFamilySpellsStore Data...");
     sSpellMgr->LoadPetFamilySpellsStore();
 
@@ -1910,15 +1987,18 @@ bool World::SetInitialWorldSettings()
     uint32 oldMSTime = getMSTime();
     if (m_bool_configs[CONFIG_LOAD_LOCALES])
     {
-        sObjectMgr->LoadCreatureLocales();
-        sObjectMgr->LoadGameObjectLocales();
-        sObjectMgr->LoadQuestTemplateLocale();
-        sObjectMgr->LoadQuestOfferRewardLocale();
-        sObjectMgr->LoadQuestRequestItemsLocale();
-        sObjectMgr->LoadQuestObjectivesLocale();
-        sObjectMgr->LoadPageTextLocales();
-        sObjectMgr->LoadGossipMenuItemsLocales();
-        sObjectMgr->LoadPointOfInterestLocales();
+        // every locale table has its own store and does not read other stores
+        Trinity::TaskGraph localeLoaders;
+        localeLoaders.Add("creature_template_locale", [] { sObjectMgr->LoadCreatureLocales(); });
+        localeLoaders.Add("gameobject_template_locale", [] { sObjectMgr->LoadGameObjectLocales(); });
+        localeLoaders.Add("quest_template_locale", [] { sObjectMgr->LoadQuestTemplateLocale(); });
+        localeLoaders.Add("quest_offer_reward_locale", [] { sObjectMgr->LoadQuestOfferRewardLocale(); });
+        localeLoaders.Add("quest_request_items_locale", [] { sObjectMgr->LoadQuestRequestItemsLocale(); });
+        localeLoaders.Add("quest_objectives_locale", [] { sObjectMgr->LoadQuestObjectivesLocale(); });
+        localeLoaders.Add("page_text_locale", [] { sObjectMgr->LoadPageTextLocales(); });
+        localeLoaders.Add("gossip_menu_option_locale", [] { sObjectMgr->LoadGossipMenuItemsLocales(); });
+        localeLoaders.Add("points_of_interest_locale", [] { sObjectMgr->LoadPointOfInterestLocales(); });
+        runLoaders(localeLoaders);
     }
 
     sObjectMgr->SetDBCLocaleIndex(GetDefaultDbcLocale());        // Get once for all the locale index of DBC language (console/broadcasts)
@@ -2015,20 +2095,17 @@ bool World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading Creature template sparring...");
     sObjectMgr->LoadCreatureTemplateSparring();
 
-    TC_LOG_INFO("server.loading", "Loading Reputation Reward Rates...");
-    sObjectMgr->LoadReputationRewardRate();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Reputation OnKill Data...");
-    sObjectMgr->LoadReputationOnKill();
-
-    TC_LOG_INFO("server.loading", "Loading Reputation Spillover Data...");
-    sObjectMgr->LoadReputationSpilloverTemplate();
-
-    TC_LOG_INFO("server.loading", "Loading Points Of Interest Data...");
-    sObjectMgr->LoadPointsOfInterest();
-
-    TC_LOG_INFO("server.loading", "Loading Creature Base Stats...");
-    sObjectMgr->LoadCreatureClassLevelStats();
+    TC_LOG_INFO("server.loading", "Loading Reputation, Points Of Interest and Creature Base Stats Data...");
+    {
+        // only read DB2 stores and creature templates, which are complete at this point
+        Trinity::TaskGraph loaders;
+        loaders.Add("reputation_reward_rate", [] { sObjectMgr->LoadReputationRewardRate(); });
+        loaders.Add("creature_onkill_reputation", [] { sObjectMgr->LoadReputationOnKill(); });
+        loaders.Add("reputation_spillover_template", [] { sObjectMgr->LoadReputationSpilloverTemplate(); });
+        loaders.Add("points_of_interest", [] { sObjectMgr->LoadPointsOfInterest(); });
+        loaders.Add("creature_classlevelstats", [] { sObjectMgr->LoadCreatureClassLevelStats(); });
+        runLoaders(loaders);
+    }
 
     TC_LOG_INFO("server.loading", "Loading Spawn Group Templates...");
     sObjectMgr->LoadSpawnGroupTemplates();
@@ -2454,6 +2531,8 @@ bool World::SetInitialWorldSettings()
 
     m_timers[WUPDATE_CHANNEL_SAVE].SetInterval(getIntConfig(CONFIG_PRESERVE_CUSTOM_CHANNEL_INTERVAL) * MINUTE * IN_MILLISECONDS);
 
+    m_timers[WUPDATE_MEMORY_USAGE].SetInterval(getIntConfig(CONFIG_METRIC_MEMORY_USAGE_INTERVAL) * MINUTE * IN_MILLISECONDS);
+
     //to set mailtimer to return mails every day between 4 and 5 am
     //mailtimer is increased when updating auctions
     //one second is 1000 -(tested on win system)
@@ -2471,6 +2550,9 @@ bool World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Starting Map System");
     sMapMgr->Initialize();
 
+    if (m_int_configs[CONFIG_SESSION_UPDATE_THREADS] > 1)
+        _sessionUpdatePool = std::make_unique<Trinity::ThreadPool>(m_int_configs[CONFIG_SESSION_UPDATE_THREADS]);
+
     TC_LOG_INFO("server.loading", "Starting Game Event system...");
     uint32 nextGameEvent = sGameEventMgr->StartSystem();
     m_timers[WUPDATE_EVENTS].SetInterval(nextGameEvent);    //depend on next event
@@ -2552,6 +2634,20 @@ bool World::SetInitialWorldSettings()
     TC_LOG_INFO("server.loading", "Loading phase names...");
     sObjectMgr->LoadPhaseNames();
 
+    if (!loaderTimings.empty())
+    {
+        loaderPool.reset();
+
+        std::sort(loaderTimings.begin(), loaderTimings.end(), [](Trinity::TaskGraph::Timing const& left, Trinity::TaskGraph::Timing const& right)
+        {
+            return left.Duration > right.Duration;
+        });
+
+        TC_LOG_INFO("server.loading", "Parallel startup loaders ({} threads), slowest first:", m_int_configs[CONFIG_LOAD_THREADS]);
+        for (Trinity::TaskGraph::Timing const& timing : loaderTimings)
+            TC_LOG_INFO("server.loading", "    {:<32} {} ms", timing.Name, timing.Duration);
+    }
+
     uint32 startupDuration = GetMSTimeDiffToNow(startupBegin);
 
     TC_LOG_INFO("server.worldserver", "World initialized in {} minutes {} seconds", (startupDuration / 60000), ((startupDuration % 60000) / 1000));
@@ -2603,10 +2699,13 @@ void World::LoadAutobroadcasts()
 void World::Update(uint32 diff)
 {
     TC_METRIC_TIMER("world_update_time_total");
+    TC_METRIC_HISTOGRAM_TIMER("world_tick_time");
     ///- Update the game time and check for shutdown time
     _UpdateGameTime();
     time_t currentGameTime = GameTime::GetGameTime();
 
+    TraceSlowTick(diff);
+
     sWorldUpdateTime.UpdateWithDiff(diff);
 
     ///- Update the different timers
@@ -2676,7 +2775,7 @@ void World::Update(uint32 diff)
     /// <ul><li> Handle auctions when the timer has passed
     if (m_timers[WUPDATE_AUCTIONS].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update expired auctions"));
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update auctions"));
         m_timers[WUPDATE_AUCTIONS].Reset();
 
         ///- Update mails (return old mails with item, or delete them)
@@ -2693,10 +2792,11 @@ void World::Update(uint32 diff)
 
     if (m_timers[WUPDATE_AUCTIONS_PENDING].Passed())
     {
-        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update pending auctions"));
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update pending and expired auctions"));
         m_timers[WUPDATE_AUCTIONS_PENDING].Reset();
 
         sAuctionMgr->UpdatePendingAuctions();
+        sAuctionMgr->UpdateExpiredAuctions();
     }
 
     if (m_timers[WUPDATE_BLACKMARKET].Passed())
@@ -2777,7 +2877,7 @@ void World::Update(uint32 diff)
             stmt->setUInt32(1, uint32(GameTime::GetGameTime()));
             stmt->setUInt32(2, realm.Id.Realm);
 
-            LoginDatabase.Execute(stmt);
+            LoginDatabase.Execute(stmt, DatabaseTaskPriority::Background);
         }
     }
 
@@ -2874,6 +2974,20 @@ void World::Update(uint32 diff)
         WorldDatabase.KeepAlive();
     }
 
+    ///- Send memory usage estimates to Metric
+    if (getIntConfig(CONFIG_METRIC_MEMORY_USAGE_INTERVAL) && m_timers[WUPDATE_MEMORY_USAGE].Passed())
+    {
+        TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Memory usage"));
+        m_timers[WUPDATE_MEMORY_USAGE].Reset();
+        if (sMetric->IsEnabled())
+        {
+            Trinity::MemoryUsageReport report;
+            GetMemoryUsage(report);
+            for (auto const& [category, bytes] : report.GetCategoryTotals())
+                TC_METRIC_VALUE("memory_usage", uint64(bytes), TC_METRIC_TAG("category", category));
+        }
+    }
+
     if (m_timers[WUPDATE_GUILDSAVE].Passed())
     {
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Save guilds"));
@@ -2906,10 +3020,42 @@ void World::Update(uint32 diff)
         TC_METRIC_TIMER("world_update_time", TC_METRIC_TAG("type", "Update metrics"));
         // Stats logger update
         sMetric->Update();
+        sOpcodeProfiler->Update(diff);
+        sScriptProfiler->Update(diff);
+        sScriptMgr->ReportHookMetrics();
         TC_METRIC_VALUE("update_time_diff", diff);
     }
 }
 
+// diff is the time since the previous tick started, all zones of that tick have been recorded by now
+void World::TraceSlowTick(uint32 diff)
+{
+    uint32 threshold = getIntConfig(CONFIG_TICK_TRACER_SLOW_TICK_THRESHOLD);
+    if (!threshold || diff < threshold || !Trinity::TickTracer::IsRecording())
+        return;
+
+    // a struggling server would otherwise spend even more time writing traces
+    time_t now = GameTime::GetGameTime();
+    if (now < m_NextSlowTickTrace)
+        return;
+
+    m_NextSlowTickTrace = now + MINUTE;
+    if (Optional<std::string> fileName = WriteTickTrace(Milliseconds(diff) + 100ms))
+        TC_LOG_WARN("server.worldserver", "World tick took {} ms, wrote tick trace to {}", diff, *fileName);
+}
+
+Optional<std::string> World::WriteTickTrace(Milliseconds window) const
+{
+    std::string fileName = Trinity::StringFormat("{}tick_trace_{}.json", sLog->GetLogsDir(), TimeToTimestampStr(GameTime::GetGameTime()));
+    if (!Trinity::TickTracer::WriteChromeTrace(fileName, window))
+    {
+        TC_LOG_ERROR("server.worldserver", "Could not write tick trace to {}", fileName);
+        return {};
+    }
+
+    return fileName;
+}
+
 void World::ForceGameEventUpdate()
 {
     m_timers[WUPDATE_EVENTS].Reset();                   // to give time for Update() to be processed
@@ -3130,6 +3276,132 @@ void World::KickAllLess(AccountTypes sec)
             itr->second->KickPlayer("World::KickAllLess");
 }
 
+/// Log out all players for shutdown, saves of a map are built on the map update threads and share transactions
+void World::LogoutAllPlayersForShutdown()
+{
+    // bounds the size of a single commit
+    static constexpr uint32 PlayersPerTransaction = 50;
+
+    struct SaveBatch
+    {
+        TransactionCallback Callback;
+        uint32 Players;
+    };
+
+    uint32 startMSTime = getMSTime();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::vector<WorldSession*> sessions;
+    for (auto const& [accountId, session] : m_sessions)
+    {
+        if (!session->GetPlayer())
+            continue;
+
+        session->BeginLogout(true);
+        sessions.push_back(session);
+    }
+
+    if (sessions.empty())
+        return;
+
+    TC_LOG_INFO("server.worldserver", "Saving {} players for shutdown...", sessions.size());
+
+    std::mutex batchesLock;
+    std::vector<SaveBatch> batches;
+    sMapMgr->DoForAllMapsInParallel([&](Map* map)
+    {
+        CharacterDatabaseTransaction trans;
+        LoginDatabaseTransaction loginTransaction;
+        uint32 players = 0;
+        auto commit = [&]
+        {
+            SaveBatch batch{ CharacterDatabase.AsyncCommitTransaction(std::move(trans)), players };
+            LoginDatabase.CommitTransaction(std::move(loginTransaction));
+            trans = nullptr;
+            loginTransaction = nullptr;
+            players = 0;
+
+            std::lock_guard lock(batchesLock);
+            batches.push_back(std::move(batch));
+        };
+
+        for (MapReference const& ref : map->GetPlayers())
+        {
+            Player* player = ref.GetSource();
+            if (!player->GetSession()->PlayerLogoutWithSave())
+                continue;
+
+            if (!trans)
+            {
+                trans = CharacterDatabase.BeginTransaction();
+                loginTransaction = LoginDatabase.BeginTransaction();
+            }
+
+            player->SaveToDB(loginTransaction, trans);
+            if (++players >= PlayersPerTransaction)
+                commit();
+        }
+
+        if (players)
+            commit();
+    });
+
+    for (WorldSession* session : sessions)
+    {
+        // not on any map, e.g. still waiting for a far teleport
+        if (Player* player = session->GetPlayer(); player && !player->IsInWorld())
+            player->SaveToDB();
+
+        session->FinishLogout();
+    }
+
+    uint32 total = 0;
+    uint32 saved = 0;
+    uint32 failed = 0;
+    for (SaveBatch& batch : batches)
+    {
+        total += batch.Players;
+        batch.Callback.AfterComplete([&saved, &failed, players = batch.Players](bool success)
+        {
+            (success ? saved : failed) += players;
+        });
+    }
+
+    TC_LOG_INFO("server.worldserver", "Built saves of {} players in {} ms in {} transactions, waiting for the database...",
+        sessions.size(), GetMSTimeDiffToNow(startMSTime), batches.size());
+
+    // whatever is still queued when the databases close is lost
+    std::chrono::steady_clock::time_point deadline = start + Seconds(getIntConfig(CONFIG_SHUTDOWN_SAVE_TIMEOUT));
+    std::chrono::steady_clock::time_point nextProgress = std::chrono::steady_clock::now() + 1s;
+    while (true)
+    {
+        std::erase_if(batches, [](SaveBatch& batch) { return batch.Callback.InvokeIfReady(); });
+        if (batches.empty() && !CharacterDatabase.QueueSize() && !LoginDatabase.QueueSize())
+            break;
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+        {
+            TC_LOG_ERROR("server.worldserver", "Shutdown save timeout ({}s) reached, {} of {} players were not saved yet, {} character database tasks pending",
+                getIntConfig(CONFIG_SHUTDOWN_SAVE_TIMEOUT), total - saved - failed, total, CharacterDatabase.QueueSize());
+            break;
+        }
+
+        if (now >= nextProgress)
+        {
+            TC_LOG_INFO("server.worldserver", "Saving players for shutdown: {}/{} saved, {} character database tasks pending", saved, total, CharacterDatabase.QueueSize());
+            nextProgress = now + 1s;
+        }
+
+        std::this_thread::sleep_for(10ms);
+    }
+
+    if (failed)
+        TC_LOG_ERROR("server.worldserver", "{} players could not be saved for shutdown", failed);
+
+    TC_LOG_INFO("server.worldserver", "Saved {} of {} players for shutdown in {} ms", saved, total, GetMSTimeDiffToNow(startMSTime));
+}
+
 /// Ban an account or ban an IP address, duration will be parsed using TimeStringToSecs if it is positive, otherwise permban
 BanReturn World::BanAccount(BanMode mode, std::string const& nameOrIP, std::string const& duration, std::string const& reason, std::string const& author)
 {
@@ -3284,6 +3556,7 @@ BanReturn World::BanCharacter(std::string const& name, std::string const& durati
     stmt->setString(3, reason);
     trans->Append(stmt);
     CharacterDatabase.CommitTransaction(trans);
+    sCharacterEnumCache->InvalidateCharacter(guid);
 
     if (banned)
         banned->GetSession()->KickPlayer("World::BanCharacter Banning character");
@@ -3447,6 +3720,14 @@ void World::UpdateSessions(uint32 diff)
             AddSession_(sess);
     }
 
+    if (_sessionUpdatePool)
+    {
+        TC_METRIC_DETAILED_NO_THRESHOLD_TIMER("world_update_time",
+            TC_METRIC_TAG("type", "Update out of world sessions"),
+            TC_METRIC_TAG("parent_type", "Update sessions"));
+        UpdateOutOfWorldSessions();
+    }
+
     ///- Then send an update signal to remaining ones
     for (SessionMap::iterator itr = m_sessions.begin(), next; itr != m_sessions.end(); itr = next)
     {
@@ -3472,6 +3753,38 @@ void World::UpdateSessions(uint32 diff)
     }
 }
 
+void World::UpdateOutOfWorldSessions()
+{
+    _outOfWorldSessions.clear();
+    for (auto const& [accountId, session] : m_sessions)
+        if (!session->GetPlayer() || !session->GetPlayer()->IsInWorld())
+            _outOfWorldSessions.push_back(session);
+
+    // a shard per thread, small batches are not worth waking the pool for
+    constexpr std::size_t MinSessionsPerShard = 16;
+    std::size_t shardCount = std::min<std::size_t>(m_int_configs[CONFIG_SESSION_UPDATE_THREADS], _outOfWorldSessions.size() / MinSessionsPerShard);
+    if (shardCount < 2)
+    {
+        for (WorldSession* session : _outOfWorldSessions)
+            session->UpdateOutOfWorld();
+        return;
+    }
+
+    Trinity::TaskGraph shards;
+    for (std::size_t i = 0; i < shardCount; ++i)
+    {
+        std::size_t begin = _outOfWorldSessions.size() * i / shardCount;
+        std::size_t end = _outOfWorldSessions.size() * (i + 1) / shardCount;
+        shards.Add(Trinity::StringFormat("sessions {}", i), [this, begin, end]
+        {
+            for (std::size_t j = begin; j < end; ++j)
+                _outOfWorldSessions[j]->UpdateOutOfWorld();
+        });
+    }
+
+    shards.Run(_sessionUpdatePool.get());
+}
+
 // This handles the issued and queued CLI commands
 void World::ProcessCliCommands()
 {
@@ -3942,6 +4255,18 @@ void World::RemoveOldCorpses()
     m_timers[WUPDATE_CORPSES].SetCurrent(m_timers[WUPDATE_CORPSES].GetInterval());
 }
 
+void World::GetMemoryUsage(Trinity::MemoryUsageReport& report) const
+{
+    sDB2Manager.GetMemoryUsage(report);
+    sObjectMgr->GetMemoryUsage(report);
+    sSpellMgr->GetMemoryUsage(report);
+    GetLootMemoryUsage(report);
+
+    report.Add("maps", "grid maps", sTerrainMgr.GetMemoryUsage());
+    report.Add("maps", "mmaps", MMAP::MMapFactory::createOrGetMMapManager()->getMemoryUsage());
+    report.Add("maps", "vmaps", VMAP::VMapFactory::createOrGetVMapManager()->getMemoryUsage());
+}
+
 void World::UpdateWarModeRewardValues()
 {
     std::array<int64, 2> warModeEnabledFaction = { };
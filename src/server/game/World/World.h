@@ -44,6 +44,12 @@ class WorldSession;
 class WorldSocket;
 struct Realm;
 
+namespace Trinity
+{
+class MemoryUsageReport;
+class ThreadPool;
+}
+
 // ServerMessages.dbc
 enum ServerMessageType
 {
@@ -95,6 +101,7 @@ enum WorldTimers
     WUPDATE_CHECK_FILECHANGES,
     WUPDATE_WHO_LIST,
     WUPDATE_CHANNEL_SAVE,
+    WUPDATE_MEMORY_USAGE,
     WUPDATE_COUNT
 };
 
@@ -199,6 +206,10 @@ enum WorldBoolConfigs
     CONFIG_BATTLEGROUNDMAP_LOAD_GRIDS,
     CONFIG_ENABLE_AE_LOOT,
     CONFIG_LOAD_LOCALES,
+    CONFIG_LOAD_DB2_MAP_FILES,
+    CONFIG_LOAD_GRID_MAP_FILES,
+    CONFIG_CREATURE_FORMATION_SHARED_PATH,
+    CONFIG_TICK_TRACER_ENABLE,
     BOOL_CONFIG_VALUE_COUNT
 };
 
@@ -226,6 +237,8 @@ enum WorldFloatConfigs
     CONFIG_CALL_TO_ARMS_5_PCT,
     CONFIG_CALL_TO_ARMS_10_PCT,
     CONFIG_CALL_TO_ARMS_20_PCT,
+    CONFIG_TERRAIN_STATUS_REUSE_DISTANCE,
+    CONFIG_MOVEMENT_REPATH_TOLERANCE,
     FLOAT_CONFIG_VALUE_COUNT
 };
 
@@ -233,7 +246,10 @@ enum WorldIntConfigs
 {
     CONFIG_COMPRESSION = 0,
     CONFIG_INTERVAL_SAVE,
+    CONFIG_SHUTDOWN_SAVE_TIMEOUT,
     CONFIG_INTERVAL_GRIDCLEAN,
+    CONFIG_GRID_MEMORY_BUDGET_PER_MAP,
+    CONFIG_GRID_MEMORY_BUDGET_TOTAL,
     CONFIG_INTERVAL_MAPUPDATE,
     CONFIG_INTERVAL_CHANGEWEATHER,
     CONFIG_INTERVAL_DISCONNECT_TOLERANCE,
@@ -357,6 +373,24 @@ enum WorldIntConfigs
     CONFIG_ENABLE_SINFO_LOGIN,
     CONFIG_PLAYER_ALLOW_COMMANDS,
     CONFIG_NUMTHREADS,
+    CONFIG_MAP_UPDATE_REGION_THREADS,
+    CONFIG_GRID_PREPARE_THREADS,
+    CONFIG_GRID_PREPARE_LOOKAHEAD,
+    CONFIG_GRID_PREPARE_MAX_PENDING,
+    CONFIG_PATHFINDING_THREADS,
+    CONFIG_SESSION_UPDATE_THREADS,
+    CONFIG_MMAP_PATH_CACHE_SIZE,
+    CONFIG_MMAP_TILE_MEMORY_BUDGET,
+    CONFIG_INSTANCE_POOL_SIZE,
+    CONFIG_VMAP_LOS_CACHE_SIZE,
+    CONFIG_VMAP_TERRAIN_STATUS_CACHE_SIZE,
+    CONFIG_LOAD_THREADS,
+    CONFIG_LOAD_LOCALES_MASK,
+    CONFIG_LOAD_CINEMATIC_CAMERA_CACHE_SIZE,
+    CONFIG_PACKET_PROFILER_SAMPLE_RATE,
+    CONFIG_SCRIPT_PROFILER_SAMPLE_RATE,
+    CONFIG_METRIC_MEMORY_USAGE_INTERVAL,
+    CONFIG_TICK_TRACER_SLOW_TICK_THRESHOLD,
     CONFIG_LOGDB_CLEARINTERVAL,
     CONFIG_LOGDB_CLEARTIME,
     CONFIG_CLIENTCACHE_VERSION,
@@ -389,6 +423,7 @@ enum WorldIntConfigs
     CONFIG_WARDEN_NUM_INJECT_CHECKS,
     CONFIG_WARDEN_NUM_LUA_CHECKS,
     CONFIG_WARDEN_NUM_CLIENT_MOD_CHECKS,
+    CONFIG_WARDEN_VALIDATION_THREADS,
     CONFIG_WINTERGRASP_PLR_MAX,
     CONFIG_WINTERGRASP_PLR_MIN,
     CONFIG_WINTERGRASP_PLR_MIN_LVL,
@@ -424,6 +459,8 @@ enum WorldIntConfigs
     CONFIG_NO_GRAY_AGGRO_ABOVE,
     CONFIG_NO_GRAY_AGGRO_BELOW,
     CONFIG_AUCTION_REPLICATE_DELAY,
+    CONFIG_AUCTION_REPLICATE_SNAPSHOT_INTERVAL,
+    CONFIG_AUCTION_EXPIRE_BATCH_SIZE,
     CONFIG_AUCTION_SEARCH_DELAY,
     CONFIG_AUCTION_TAINTED_SEARCH_DELAY,
     CONFIG_TALENTS_INSPECTING,
@@ -435,10 +472,18 @@ enum WorldIntConfigs
     CONFIG_RESPAWN_DYNAMICMINIMUM_CREATURE,
     CONFIG_RESPAWN_DYNAMICMINIMUM_GAMEOBJECT,
     CONFIG_RESPAWN_GUIDWARNING_FREQUENCY,
+    CONFIG_GAME_EVENT_SPAWN_BATCH_SIZE,
     CONFIG_SOCKET_TIMEOUTTIME_ACTIVE,
     CONFIG_BLACKMARKET_MAXAUCTIONS,
     CONFIG_BLACKMARKET_UPDATE_PERIOD,
     CONFIG_FACTION_BALANCE_LEVEL_CHECK_DIFF,
+    CONFIG_MOVEMENT_RELAY_LOD_NEAR_DISTANCE,
+    CONFIG_MOVEMENT_RELAY_LOD_NEAR_INTERVAL,
+    CONFIG_MOVEMENT_RELAY_LOD_FAR_DISTANCE,
+    CONFIG_MOVEMENT_RELAY_LOD_FAR_INTERVAL,
+    CONFIG_CREATURE_DORMANT_UPDATE_INTERVAL,
+    CONFIG_CREATURE_IDLE_AI_UPDATE_INTERVAL,
+    CONFIG_MOVEMENT_REPATH_INTERVAL,
     INT_CONFIG_VALUE_COUNT
 };
 
@@ -656,6 +701,9 @@ class TC_GAME_API World
         void SendGlobalText(char const* text, WorldSession* self);
         void SendGMText(uint32 string_id, ...);
         void SendServerMessage(ServerMessageType messageID, std::string_view stringParam = {}, Player const* player = nullptr);
+        /// Writes what every thread did during the last window as a Chrome trace file into LogsDir, returns the file name
+        Optional<std::string> WriteTickTrace(Milliseconds window) const;
+
         void SendGlobalMessage(WorldPacket const* packet, WorldSession* self = nullptr, Optional<Team> team = { });
         void SendGlobalGMMessage(WorldPacket const* packet, WorldSession* self = nullptr, Optional<Team> team = { });
         bool SendZoneMessage(uint32 zone, WorldPacket const* packet, WorldSession* self = nullptr, Optional<Team> team = { });
@@ -674,6 +722,8 @@ class TC_GAME_API World
         void Update(uint32 diff);
 
         void UpdateSessions(uint32 diff);
+        // threads of SessionUpdate.Threads, nullptr when sessions are only updated by the world thread
+        Trinity::ThreadPool* GetSessionUpdatePool() const { return _sessionUpdatePool.get(); }
         /// Set a server rate (see #Rates)
         void setRate(Rates rate, float value) { rate_values[rate]=value; }
         /// Get a server rate (see #Rates)
@@ -743,6 +793,8 @@ class TC_GAME_API World
 
         void KickAll();
         void KickAllLess(AccountTypes sec);
+        /// Logs out all players for shutdown, their saves are built in parallel per map and the call waits for them to be written
+        void LogoutAllPlayersForShutdown();
         BanReturn BanAccount(BanMode mode, std::string const& nameOrIP, std::string const& duration, std::string const& reason, std::string const& author);
         BanReturn BanAccount(BanMode mode, std::string const& nameOrIP, uint32 duration_secs, std::string const& reason, std::string const& author);
         bool RemoveBanAccount(BanMode mode, std::string const& nameOrIP);
@@ -786,6 +838,9 @@ class TC_GAME_API World
         void ReloadRBAC();
 
         void RemoveOldCorpses();
+
+        // estimates of the memory used by data stores, managers and loaded terrain, reported by .server memory and sent to Metric
+        void GetMemoryUsage(Trinity::MemoryUsageReport& report) const;
         void TriggerGuidWarning();
         void TriggerGuidAlert();
         bool IsGuidWarning() { return _guidWarn; }
@@ -797,6 +852,7 @@ class TC_GAME_API World
 
     protected:
         void _UpdateGameTime();
+        void TraceSlowTick(uint32 diff);
 
         // callback for UpdateRealmCharacters
         void _UpdateRealmCharCount(PreparedQueryResult resultCharCount);
@@ -880,6 +936,7 @@ class TC_GAME_API World
         time_t m_NextCalendarOldEventsDeletionTime;
         time_t m_NextGuildReset;
         time_t m_NextCurrencyReset;
+        time_t m_NextSlowTickTrace;
 
         //Player Queue
         Queue m_QueuedPlayer;
@@ -891,6 +948,11 @@ class TC_GAME_API World
         void ProcessLinkInstanceSocket(std::pair<std::weak_ptr<WorldSocket>, uint64> linkInfo);
         LockedQueue<std::pair<std::weak_ptr<WorldSocket>, uint64>> _linkSocketQueue;
 
+        // packets of sessions without a player in world that touch only their session, handled on the session update threads
+        void UpdateOutOfWorldSessions();
+        std::unique_ptr<Trinity::ThreadPool> _sessionUpdatePool;
+        std::vector<WorldSession*> _outOfWorldSessions;
+
         // used versions
         std::string m_DBVersion;
 
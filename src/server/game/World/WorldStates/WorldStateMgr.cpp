@@ -27,6 +27,7 @@
 #include "Util.h"
 #include "World.h"
 #include "WorldStatePackets.h"
+#include <atomic>
 
 namespace
 {
@@ -34,6 +35,7 @@ constexpr int32 WORLDSTATE_ANY_MAP = -1;
 std::unordered_map<int32, WorldStateTemplate> _worldStateTemplates;
 WorldStateValueContainer _realmWorldStateValues;
 std::unordered_map<int32, WorldStateValueContainer> _worldStatesByMap;
+std::atomic<uint32> _realmWorldStatesVersion = 0;
 }
 
 void WorldStateMgr::LoadFromDB()
@@ -208,6 +210,7 @@ void WorldStateMgr::SetValue(int32 worldStateId, int32 value, bool hidden, Map*
             return;
 
         itr->second = value;
+        ++_realmWorldStatesVersion;
 
         if (worldStateTemplate)
             sScriptMgr->OnWorldStateValueChange(worldStateTemplate, oldValue, value, nullptr);
@@ -256,24 +259,31 @@ WorldStateValueContainer WorldStateMgr::GetInitialWorldStatesForMap(Map const* m
     return initialValues;
 }
 
+bool WorldStateMgr::IsWorldStateVisibleInArea(int32 worldStateId, uint32 areaId) const
+{
+    WorldStateTemplate const* worldStateTemplate = GetWorldStateTemplate(worldStateId);
+    if (!worldStateTemplate || worldStateTemplate->AreaIds.empty())
+        return true;
+
+    return std::any_of(worldStateTemplate->AreaIds.begin(), worldStateTemplate->AreaIds.end(),
+        [=](uint32 requiredAreaId) { return DB2Manager::IsInArea(areaId, requiredAreaId); });
+}
+
+uint32 WorldStateMgr::GetRealmWorldStatesVersion() const
+{
+    return _realmWorldStatesVersion;
+}
+
 void WorldStateMgr::FillInitialWorldStates(WorldPackets::WorldState::InitWorldStates& initWorldStates, Map const* map, uint32 playerAreaId) const
 {
+    std::vector<int32> const& mapWorldStateIds = map->GetWorldStateIdsForArea(playerAreaId);
+    initWorldStates.Worldstates.reserve(_realmWorldStateValues.size() + mapWorldStateIds.size());
+
     for (auto const& [worldStateId, value] : _realmWorldStateValues)
         initWorldStates.Worldstates.emplace_back(worldStateId, value);
 
-    for (auto const& [worldStateId, value] : map->GetWorldStateValues())
-    {
-        WorldStateTemplate const* worldStateTemplate = GetWorldStateTemplate(worldStateId);
-        if (worldStateTemplate && !worldStateTemplate->AreaIds.empty())
-        {
-            bool isInAllowedArea = std::any_of(worldStateTemplate->AreaIds.begin(), worldStateTemplate->AreaIds.end(),
-                [=](uint32 requiredAreaId) { return DB2Manager::IsInArea(playerAreaId, requiredAreaId); });
-            if (!isInAllowedArea)
-                continue;
-        }
-
-        initWorldStates.Worldstates.emplace_back(worldStateId, value);
-    }
+    for (int32 worldStateId : mapWorldStateIds)
+        initWorldStates.Worldstates.emplace_back(worldStateId, map->GetWorldStateValue(worldStateId));
 }
 
 WorldStateMgr* WorldStateMgr::instance()
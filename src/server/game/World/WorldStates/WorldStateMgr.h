@@ -44,6 +44,11 @@ public:
 
     WorldStateValueContainer GetInitialWorldStatesForMap(Map const* map) const;
 
+    bool IsWorldStateVisibleInArea(int32 worldStateId, uint32 areaId) const;
+
+    // incremented every time a realm wide value changes, lets maps drop cached SMSG_INIT_WORLD_STATES packets
+    uint32 GetRealmWorldStatesVersion() const;
+
     void FillInitialWorldStates(WorldPackets::WorldState::InitWorldStates& initWorldStates, Map const* map, uint32 playerAreaId) const;
 };
 
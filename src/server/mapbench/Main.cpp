@@ -0,0 +1,290 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Replays a recorded map movement stream (see .debug mapreplay) against Map::Update
+/// without network or players and reports update time percentiles and heap allocations
+
+#include "Common.h"
+#include "Banner.h"
+#include "Configuration/Config.h"
+#include "DatabaseEnv.h"
+#include "DatabaseLoader.h"
+#include "GitRevision.h"
+#include "InstanceLockMgr.h"
+#include "Locales.h"
+#include "Log.h"
+#include "MapManager.h"
+#include "MapReplay.h"
+#include "Memory.h"
+#include "MySQLThreading.h"
+#include "OpenSSLCrypto.h"
+#include "OutdoorPvP/OutdoorPvPMgr.h"
+#include "Realm.h"
+#include "ScriptLoader.h"
+#include "ScriptMgr.h"
+#include "ScriptReloadMgr.h"
+#include "SecretMgr.h"
+#include "TerrainMgr.h"
+#include "World.h"
+#include <boost/dll/runtime_symbol_info.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/program_options.hpp>
+#include <google/protobuf/stubs/common.h>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include "Hacks/boost_program_options_with_filesystem_path.h"
+
+using namespace boost::program_options;
+namespace fs = boost::filesystem;
+
+#ifndef _TRINITY_CORE_CONFIG
+    #define _TRINITY_CORE_CONFIG  "worldserver.conf"
+#endif
+
+#ifndef _TRINITY_CORE_CONFIG_DIR
+    #define _TRINITY_CORE_CONFIG_DIR "worldserver.conf.d"
+#endif
+
+namespace
+{
+std::atomic<uint64> AllocationCount;
+}
+
+void* operator new(std::size_t size)
+{
+    AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+    AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::nothrow_t const&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::nothrow_t const&) noexcept { std::free(ptr); }
+
+bool StartDB();
+void StopDB();
+variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile, fs::path& configDir, fs::path& replayFile, uint32& ticks, uint32& creatureEntry);
+
+int main(int argc, char** argv)
+{
+    signal(SIGABRT, &Trinity::AbortHandler);
+
+    Trinity::Locale::Init();
+
+    auto configFile = fs::absolute(_TRINITY_CORE_CONFIG);
+    auto configDir  = fs::absolute(_TRINITY_CORE_CONFIG_DIR);
+    fs::path replayFile;
+    uint32 ticks = 0;
+    uint32 creatureEntry = 0;
+
+    auto vm = GetConsoleArguments(argc, argv, configFile, configDir, replayFile, ticks, creatureEntry);
+    if (vm.count("help") || vm.count("version"))
+        return 0;
+
+    if (replayFile.empty())
+    {
+        printf("No replay file given, use --replay <file>\n");
+        return 1;
+    }
+
+    MapReplay replay(0, 0);
+    std::string replayError;
+    if (!MapReplay::LoadFromFile(replayFile.generic_string(), replay, replayError))
+    {
+        printf("Error in replay file: %s\n", replayError.c_str());
+        return 1;
+    }
+
+    uint32 dummy = 0;
+
+    GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+    auto protobufHandle = Trinity::make_unique_ptr_with_deleter(&dummy, [](void*) { google::protobuf::ShutdownProtobufLibrary(); });
+
+    std::string configError;
+    if (!sConfigMgr->LoadInitial(configFile.generic_string(),
+                                 std::vector<std::string>(argv, argv + argc),
+                                 configError))
+    {
+        printf("Error in config file: %s\n", configError.c_str());
+        return 1;
+    }
+
+    std::vector<std::string> loadedConfigFiles;
+    std::vector<std::string> configDirErrors;
+    if (!sConfigMgr->LoadAdditionalDir(configDir.generic_string(), true, loadedConfigFiles, configDirErrors))
+    {
+        for (std::string const& configDirError : configDirErrors)
+            printf("Error in additional config files: %s\n", configDirError.c_str());
+
+        return 1;
+    }
+
+    sConfigMgr->OverrideWithEnvVariablesIfAny();
+
+    sLog->Initialize(nullptr);
+
+    Trinity::Banner::Show("map_bench",
+        [](char const* text)
+        {
+            TC_LOG_INFO("server.worldserver", "{}", text);
+        },
+        nullptr
+    );
+
+    OpenSSLCrypto::threadsSetup(boost::dll::program_location().remove_filename());
+
+    auto opensslHandle = Trinity::make_unique_ptr_with_deleter(&dummy, [](void*) { OpenSSLCrypto::threadsCleanup(); });
+
+    if (!StartDB())
+        return 1;
+
+    auto dbHandle = Trinity::make_unique_ptr_with_deleter(&dummy, [](void*) { StopDB(); });
+
+    auto scriptReloadMgrHandle = Trinity::make_unique_ptr_with_deleter(sScriptReloadMgr, [](ScriptReloadMgr* mgr) { mgr->Unload(); });
+
+    sScriptMgr->SetScriptLoader(AddScripts);
+    auto sScriptMgrHandle = Trinity::make_unique_ptr_with_deleter(sScriptMgr, [](ScriptMgr* mgr) { mgr->Unload(); });
+
+    sSecretMgr->Initialize(SECRET_OWNER_WORLDSERVER);
+    if (!sWorld->SetInitialWorldSettings())
+        return 1;
+
+    auto instanceLockMgrHandle = Trinity::make_unique_ptr_with_deleter(&sInstanceLockMgr, [](InstanceLockMgr* mgr) { mgr->Unload(); });
+
+    auto terrainMgrHandle = Trinity::make_unique_ptr_with_deleter(&sTerrainMgr, [](TerrainMgr* mgr) { mgr->UnloadAll(); });
+
+    auto outdoorPvpMgrHandle = Trinity::make_unique_ptr_with_deleter(sOutdoorPvPMgr, [](OutdoorPvPMgr* mgr) { mgr->Die(); });
+
+    auto mapManagementHandle = Trinity::make_unique_ptr_with_deleter(sMapMgr, [](MapManager* mgr) { mgr->UnloadAll(); });
+
+    if (!ticks)
+        ticks = uint32(replay.GetTicks().size());
+
+    MapReplayRunner runner(replay, creatureEntry);
+    MapReplayResult result;
+    if (!runner.Run(ticks, []() { return AllocationCount.load(std::memory_order_relaxed); }, result))
+    {
+        TC_LOG_ERROR("server.worldserver", "Map {} of {} cannot be replayed (only non instanced maps with at least one recorded tick are supported)",
+            replay.GetMapId(), replayFile.generic_string());
+        return 1;
+    }
+
+    printf("map %u ticks %u seed %u\n", replay.GetMapId(), result.Ticks, replay.GetSeed());
+    printf("update time us: p50 %u p99 %u max %u avg %u\n", result.P50, result.P99, result.Max, uint32(result.Total / std::max<uint32>(result.Ticks, 1)));
+    printf("allocations: total " UI64FMTD " per tick %.1f max per tick " UI64FMTD "\n",
+        result.Allocations, double(result.Allocations) / std::max<uint32>(result.Ticks, 1), result.MaxTickAllocations);
+    return 0;
+}
+
+bool StartDB()
+{
+    MySQL::Library_Init();
+
+    DatabaseLoader loader("server.worldserver", DatabaseLoader::DATABASE_NONE);
+    loader
+        .AddDatabase(LoginDatabase, "Login")
+        .AddDatabase(CharacterDatabase, "Character")
+        .AddDatabase(WorldDatabase, "World")
+        .AddDatabase(HotfixDatabase, "Hotfix");
+
+    if (!loader.Load())
+        return false;
+
+    realm.Id.Realm = sConfigMgr->GetIntDefault("RealmID", 0);
+    if (!realm.Id.Realm)
+    {
+        TC_LOG_ERROR("server.worldserver", "Realm ID not defined in configuration file");
+        return false;
+    }
+
+    sWorld->LoadDBVersion();
+    return true;
+}
+
+void StopDB()
+{
+    HotfixDatabase.Close();
+    WorldDatabase.Close();
+    CharacterDatabase.Close();
+    LoginDatabase.Close();
+
+    MySQL::Library_End();
+}
+
+variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile, fs::path& configDir, fs::path& replayFile, uint32& ticks, uint32& creatureEntry)
+{
+    options_description all("Allowed options");
+    all.add_options()
+        ("help,h", "print usage message")
+        ("version,v", "print version build info")
+        ("config,c", value<fs::path>(&configFile)->default_value(fs::absolute(_TRINITY_CORE_CONFIG)),
+                     "use <arg> as configuration file")
+        ("config-dir,cd", value<fs::path>(&configDir)->default_value(fs::absolute(_TRINITY_CORE_CONFIG_DIR)),
+                     "use <arg> as directory with additional config files")
+        ("replay,r", value<fs::path>(&replayFile), "recorded map replay to run (see .debug mapreplay)")
+        ("ticks,t", value<uint32>(&ticks)->default_value(0), "number of ticks to run, 0 runs the recording once")
+        ("entry,e", value<uint32>(&creatureEntry)->default_value(1), "creature entry used to represent recorded players")
+        ;
+
+    variables_map vm;
+    try
+    {
+        store(command_line_parser(argc, argv).options(all).allow_unregistered().run(), vm);
+        notify(vm);
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+    }
+
+    if (vm.count("help"))
+    {
+        std::cout << all << "\n";
+    }
+    else if (vm.count("version"))
+    {
+        std::cout << GitRevision::GetFullVersion() << "\n";
+    }
+
+    return vm;
+}
@@ -25,6 +25,7 @@ EndScriptData */
 #include "ScriptMgr.h"
 #include "AccountMgr.h"
 #include "CharacterCache.h"
+#include "CharacterEnumCache.h"
 #include "Chat.h"
 #include "ChatCommand.h"
 #include "DatabaseEnv.h"
@@ -382,6 +383,7 @@ public:
                 stmt->setUInt16(0, uint16(AT_LOGIN_RENAME));
                 stmt->setUInt64(1, player->GetGUID().GetCounter());
                 CharacterDatabase.Execute(stmt);
+                sCharacterEnumCache->InvalidateCharacter(player->GetGUID());
             }
         }
 
@@ -408,6 +410,7 @@ public:
             stmt->setUInt16(0, static_cast<uint16>(AT_LOGIN_CUSTOMIZE));
             stmt->setUInt64(1, player->GetGUID().GetCounter());
             CharacterDatabase.Execute(stmt);
+            sCharacterEnumCache->InvalidateCharacter(player->GetGUID());
         }
 
         return true;
@@ -432,6 +435,7 @@ public:
             stmt->setUInt16(0, uint16(AT_LOGIN_CHANGE_FACTION));
             stmt->setUInt64(1, player->GetGUID().GetCounter());
             CharacterDatabase.Execute(stmt);
+            sCharacterEnumCache->InvalidateCharacter(player->GetGUID());
         }
 
         return true;
@@ -456,6 +460,7 @@ public:
             stmt->setUInt16(0, uint16(AT_LOGIN_CHANGE_RACE));
             stmt->setUInt64(1, player->GetGUID().GetCounter());
             CharacterDatabase.Execute(stmt);
+            sCharacterEnumCache->InvalidateCharacter(player->GetGUID());
         }
 
         return true;
@@ -42,14 +42,18 @@ EndScriptData */
 #include "Log.h"
 #include "M2Stores.h"
 #include "MapManager.h"
+#include "MapReplay.h"
 #include "MovementPackets.h"
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
+#include "OpcodeProfiler.h"
 #include "PhasingHandler.h"
 #include "PoolMgr.h"
 #include "RBAC.h"
+#include "ScriptProfiler.h"
 #include "SpellMgr.h"
 #include "SpellPackets.h"
+#include "TickTracer.h"
 #include "Transport.h"
 #include "Warden.h"
 #include "World.h"
@@ -128,6 +132,16 @@ public:
             { "asan outofbounds",   HandleDebugOutOfBounds,                rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
             { "guidlimits",         HandleDebugGuidLimitsCommand,          rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
             { "objectcount",        HandleDebugObjectCountCommand,         rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "mapupdate",          HandleDebugMapUpdateCommand,           rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "mapreplay start",    HandleDebugMapReplayStartCommand,      rbac::RBAC_PERM_COMMAND_DEBUG,   Console::No },
+            { "mapreplay stop",     HandleDebugMapReplayStopCommand,       rbac::RBAC_PERM_COMMAND_DEBUG,   Console::No },
+            { "opcodes",            HandleDebugOpcodesCommand,             rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "opcodes reset",      HandleDebugOpcodesResetCommand,        rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "scripts top",        HandleDebugScriptsTopCommand,          rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "scripts reset",      HandleDebugScriptsResetCommand,        rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "trace start",        HandleDebugTraceStartCommand,          rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "trace stop",         HandleDebugTraceStopCommand,           rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
+            { "trace dump",         HandleDebugTraceDumpCommand,           rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
             { "questreset",         HandleDebugQuestResetCommand,          rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
             { "warden force",       HandleDebugWardenForce,                rbac::RBAC_PERM_COMMAND_DEBUG,   Console::Yes },
             { "personalclone",      HandleDebugBecomePersonalClone,        rbac::RBAC_PERM_COMMAND_DEBUG,   Console::No }
@@ -196,7 +210,7 @@ public:
         }
 
         // Dump camera locations
-        if (std::vector<FlyByCamera> const* flyByCameras = GetFlyByCameras(cineSeq->Camera[0]))
+        if (std::shared_ptr<std::vector<FlyByCamera> const> flyByCameras = GetFlyByCameras(cineSeq->Camera[0]))
         {
             handler->PSendSysMessage("Waypoints for sequence %u, camera %u", cinematicId, cineSeq->Camera[0]);
             uint32 count = 1;
@@ -1713,12 +1727,185 @@ public:
         return true;
     }
 
+    static bool HandleDebugMapUpdateCommand(ChatHandler* handler, Optional<uint32> ticks, Optional<uint32> count)
+    {
+        struct MapUpdateStats
+        {
+            Map* UpdatedMap;
+            MapUpdateProfiler::TickTimes Sum;
+            MapUpdateProfiler::TickTimes Worst;
+            uint32 Ticks;
+        };
+
+        uint32 tickCount = std::clamp<uint32>(ticks.value_or(100), 1, MapUpdateProfiler::HistorySize);
+        std::vector<MapUpdateStats> stats;
+        sMapMgr->DoForAllMaps([&](Map* map)
+        {
+            MapUpdateProfiler const& profiler = map->GetUpdateProfiler();
+            if (!profiler.GetRecordedTicks())
+                return;
+
+            MapUpdateStats& mapStats = stats.emplace_back();
+            mapStats.UpdatedMap = map;
+            mapStats.Sum = profiler.GetSummary(tickCount, &mapStats.Worst);
+            mapStats.Ticks = std::min(tickCount, profiler.GetRecordedTicks());
+        });
+
+        std::sort(stats.begin(), stats.end(), [](MapUpdateStats const& left, MapUpdateStats const& right)
+        {
+            return uint64(left.Sum.Total) * right.Ticks > uint64(right.Sum.Total) * left.Ticks;
+        });
+
+        if (stats.size() > count.value_or(10))
+            stats.resize(count.value_or(10));
+
+        handler->PSendSysMessage("Slowest %u maps over the last %u update ticks (times in microseconds):", uint32(stats.size()), tickCount);
+        for (MapUpdateStats const& mapStats : stats)
+        {
+            handler->PSendSysMessage("Map Id: %u Name: '%s' Instance Id: %u Ticks: %u Avg: %u Max: %u",
+                mapStats.UpdatedMap->GetId(), mapStats.UpdatedMap->GetMapName(), mapStats.UpdatedMap->GetInstanceId(),
+                mapStats.Ticks, mapStats.Sum.Total / mapStats.Ticks, mapStats.Worst.Total);
+
+            std::ostringstream phases;
+            for (std::size_t i = 0; i < MapUpdateProfiler::PhaseCount; ++i)
+            {
+                if (!mapStats.Sum.Phases[i] && !mapStats.Worst.Phases[i])
+                    continue;
+
+                phases << ' ' << GetMapUpdatePhaseName(MapUpdatePhase(i)) << ": " << mapStats.Sum.Phases[i] / mapStats.Ticks << '/' << mapStats.Worst.Phases[i];
+            }
+
+            handler->PSendSysMessage("  avg/slowest tick:%s", phases.str().c_str());
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugOpcodesCommand(ChatHandler* handler, Optional<uint32> count)
+    {
+        std::vector<OpcodeProfiler::Summary> summaries = sOpcodeProfiler->GetSummaries();
+        std::sort(summaries.begin(), summaries.end(), [](OpcodeProfiler::Summary const& left, OpcodeProfiler::Summary const& right)
+        {
+            return left.Latency.GetPercentile(99.0f) > right.Latency.GetPercentile(99.0f);
+        });
+
+        if (summaries.size() > count.value_or(10))
+            summaries.resize(count.value_or(10));
+
+        handler->PSendSysMessage("Slowest %u opcode handlers (times in microseconds):", uint32(summaries.size()));
+        for (OpcodeProfiler::Summary const& summary : summaries)
+        {
+            uint32 samples = std::max<uint32>(summary.Latency.GetCount(), 1);
+            handler->PSendSysMessage("%s [%s] Calls: " UI64FMTD " Avg size: " UI64FMTD " Samples: %u Avg: %u P99: %u Max: %u",
+                GetOpcodeNameForLogging(summary.Opcode).c_str(), GetPacketProcessingContextName(summary.Context),
+                summary.Calls, summary.Bytes / std::max<uint64>(summary.Calls, 1), summary.Latency.GetCount(),
+                uint32(summary.Latency.GetSum() / samples), summary.Latency.GetPercentile(99.0f), summary.Latency.GetMax());
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugOpcodesResetCommand(ChatHandler* handler)
+    {
+        sOpcodeProfiler->Reset();
+        handler->SendSysMessage("Opcode statistics reset");
+        return true;
+    }
+
+    static bool HandleDebugScriptsTopCommand(ChatHandler* handler, Optional<uint32> count)
+    {
+        if (!ScriptProfiler::IsEnabled())
+        {
+            handler->SendSysMessage("Script profiling is disabled (Metric.ScriptProfiler.SampleRate)");
+            return true;
+        }
+
+        std::vector<ScriptProfiler::Summary> summaries = sScriptProfiler->GetSummaries();
+        std::sort(summaries.begin(), summaries.end(), [](ScriptProfiler::Summary const& left, ScriptProfiler::Summary const& right)
+        {
+            return left.Time > right.Time;
+        });
+
+        if (summaries.size() > count.value_or(10))
+            summaries.resize(count.value_or(10));
+
+        handler->PSendSysMessage("Most expensive %u scripts (estimated from samples, times in microseconds):", uint32(summaries.size()));
+        for (ScriptProfiler::Summary const& summary : summaries)
+        {
+            handler->PSendSysMessage("%s [%s] Map: %u Calls: " UI64FMTD " Total: " UI64FMTD " Avg: %u P99: %u Max: %u",
+                summary.Name.c_str(), GetScriptProfileHookName(summary.Hook), summary.MapId, summary.Calls, summary.Time,
+                uint32(summary.Time / std::max<uint64>(summary.Calls, 1)), summary.Latency.GetPercentile(99.0f), summary.Latency.GetMax());
+        }
+
+        return true;
+    }
+
+    static bool HandleDebugScriptsResetCommand(ChatHandler* handler)
+    {
+        sScriptProfiler->Reset();
+        handler->SendSysMessage("Script statistics reset");
+        return true;
+    }
+
+    static bool HandleDebugTraceStartCommand(ChatHandler* handler)
+    {
+        Trinity::TickTracer::SetRecording(true);
+        handler->SendSysMessage("Tick tracer is recording");
+        return true;
+    }
+
+    static bool HandleDebugTraceStopCommand(ChatHandler* handler)
+    {
+        Trinity::TickTracer::SetRecording(false);
+        handler->SendSysMessage("Tick tracer stopped, recorded zones are kept for .debug trace dump");
+        return true;
+    }
+
+    static bool HandleDebugTraceDumpCommand(ChatHandler* handler, Optional<uint32> milliseconds)
+    {
+        if (Optional<std::string> fileName = sWorld->WriteTickTrace(Milliseconds(milliseconds.value_or(1000))))
+            handler->PSendSysMessage("Tick trace written to %s", fileName->c_str());
+        else
+            handler->SendSysMessage("Could not write the tick trace file");
+
+        return true;
+    }
+
+    static bool HandleDebugMapReplayStartCommand(ChatHandler* handler, Optional<uint32> seed)
+    {
+        Map* map = handler->GetPlayer()->GetMap();
+        map->StartReplayRecording(seed.value_or(GameTime::GetGameTime()));
+        handler->PSendSysMessage("Recording player movement of map %u", map->GetId());
+        return true;
+    }
+
+    static bool HandleDebugMapReplayStopCommand(ChatHandler* handler, std::string fileName)
+    {
+        std::unique_ptr<MapReplay> replay = handler->GetPlayer()->GetMap()->StopReplayRecording();
+        if (!replay)
+        {
+            handler->SendSysMessage("This map is not being recorded");
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        if (!replay->SaveToFile(fileName))
+        {
+            handler->PSendSysMessage("Failed to write %s", fileName.c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        handler->PSendSysMessage("Saved %u recorded ticks to %s", uint32(replay->GetTicks().size()), fileName.c_str());
+        return true;
+    }
+
     class CreatureCountWorker
     {
     public:
         CreatureCountWorker() { }
 
-        void Visit(std::unordered_map<ObjectGuid, Creature*>& creatureMap)
+        void Visit(Trinity::Containers::FlatHashMap<ObjectGuid, Creature*>& creatureMap)
         {
             for (auto const& p : creatureMap)
             {
@@ -1728,7 +1915,7 @@ public:
         }
 
         template<class T>
-        void Visit(std::unordered_map<ObjectGuid, T*>&) { }
+        void Visit(Trinity::Containers::FlatHashMap<ObjectGuid, T*>&) { }
 
         std::vector<std::pair<uint32, uint32>> GetTopCreatureCount(uint32 count)
         {
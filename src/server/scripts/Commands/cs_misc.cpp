@@ -1223,7 +1223,7 @@ public:
             itemContext = ItemContext(Trinity::StringTo<uint8>(context).value_or(0));
             if (itemContext < ItemContext::Max)
             {
-                std::vector<int32> contextBonuses = ItemBonusMgr::GetBonusListsForItem(itemId, itemContext);
+                std::span<int32 const> contextBonuses = ItemBonusMgr::GetBonusListsForItem(itemId, itemContext);
                 bonusListIDs.insert(bonusListIDs.begin(), contextBonuses.begin(), contextBonuses.end());
             }
         }
@@ -1389,7 +1389,7 @@ public:
             itemContext = ItemContext(Trinity::StringTo<uint8>(context).value_or(0));
             if (itemContext < ItemContext::Max)
             {
-                std::vector<int32> contextBonuses = ItemBonusMgr::GetBonusListsForItem(itemId, itemContext);
+                std::span<int32 const> contextBonuses = ItemBonusMgr::GetBonusListsForItem(itemId, itemContext);
                 bonusListIDs.insert(bonusListIDs.begin(), contextBonuses.begin(), contextBonuses.end());
             }
         }
@@ -1509,7 +1509,7 @@ public:
                 std::vector<int32> bonusListIDsForItem = bonusListIDs; // copy, bonuses for each depending on context might be different for each item
                 if (itemContext < ItemContext::Max)
                 {
-                    std::vector<int32> contextBonuses = ItemBonusMgr::GetBonusListsForItem(itemTemplatePair.first, itemContext);
+                    std::span<int32 const> contextBonuses = ItemBonusMgr::GetBonusListsForItem(itemTemplatePair.first, itemContext);
                     bonusListIDsForItem.insert(bonusListIDsForItem.begin(), contextBonuses.begin(), contextBonuses.end());
                 }
 
@@ -23,6 +23,7 @@ Category: commandscripts
 EndScriptData */
 
 #include "ScriptMgr.h"
+#include "AllocationTracker.h"
 #include "Chat.h"
 #include "ChatCommand.h"
 #include "Config.h"
@@ -32,6 +33,7 @@ EndScriptData */
 #include "GitRevision.h"
 #include "Language.h"
 #include "Log.h"
+#include "MemoryUsage.h"
 #include "MySQLThreading.h"
 #include "RBAC.h"
 #include "Realm.h"
@@ -45,6 +47,7 @@ EndScriptData */
 #include <boost/filesystem/operations.hpp>
 #include <openssl/crypto.h>
 #include <openssl/opensslv.h>
+#include <algorithm>
 #include <numeric>
 
 #if TRINITY_COMPILER == TRINITY_COMPILER_GNU
@@ -99,6 +102,7 @@ public:
             { "idlerestart",  rbac::RBAC_PERM_COMMAND_SERVER_IDLERESTART,  true, nullptr,                     "", serverIdleRestartCommandTable },
             { "idleshutdown", rbac::RBAC_PERM_COMMAND_SERVER_IDLESHUTDOWN, true, nullptr,                     "", serverIdleShutdownCommandTable },
             { "info",         rbac::RBAC_PERM_COMMAND_SERVER_INFO,         true, &HandleServerInfoCommand,    "" },
+            { "memory",       rbac::RBAC_PERM_COMMAND_SERVER_DEBUG,        true, &HandleServerMemoryCommand,  "" },
             { "motd",         rbac::RBAC_PERM_COMMAND_SERVER_MOTD,         true, &HandleServerMotdCommand,    "" },
             { "plimit",       rbac::RBAC_PERM_COMMAND_SERVER_PLIMIT,       true, &HandleServerPLimitCommand,  "" },
             { "restart",      rbac::RBAC_PERM_COMMAND_SERVER_RESTART,      true, nullptr,                     "", serverRestartCommandTable },
@@ -254,6 +258,55 @@ public:
         return true;
     }
 
+    // without arguments lists the total of every category, with a category name lists its largest entries
+    static bool HandleServerMemoryCommand(ChatHandler* handler, char const* args)
+    {
+        Trinity::MemoryUsageReport report;
+        sWorld->GetMemoryUsage(report);
+
+        auto toMB = [](std::size_t bytes) { return double(bytes) / (1024.0 * 1024.0); };
+
+        std::string_view category = args ? std::string_view(args) : std::string_view();
+        if (category.empty())
+        {
+            handler->PSendSysMessage("Estimated memory usage: %.1f MB", toMB(report.GetTotal()));
+            for (auto const& [name, bytes] : report.GetCategoryTotals())
+                handler->PSendSysMessage("  %s: %.1f MB", name.c_str(), toMB(bytes));
+
+            if (Trinity::AllocationTracker::IsEnabled())
+            {
+                std::array<Trinity::AllocationTracker::TagStatistics, Trinity::AllocationTracker::TagCount> tags = Trinity::AllocationTracker::GetStatistics();
+                handler->PSendSysMessage("Live heap by allocation tag:");
+                for (std::size_t i = 0; i < tags.size(); ++i)
+                    handler->PSendSysMessage("  %s: %.1f MB", Trinity::GetAllocationTagName(Trinity::AllocationTag(i)), toMB(std::max<int64>(tags[i].LiveBytes, 0)));
+            }
+            return true;
+        }
+
+        std::vector<Trinity::MemoryUsageReport::Entry const*> entries;
+        for (Trinity::MemoryUsageReport::Entry const& entry : report.GetEntries())
+            if (StringEqualI(entry.Category, category))
+                entries.push_back(&entry);
+
+        if (entries.empty())
+        {
+            handler->PSendSysMessage("No memory usage reported for category %s", std::string(category).c_str());
+            handler->SetSentErrorMessage(true);
+            return false;
+        }
+
+        std::sort(entries.begin(), entries.end(), [](Trinity::MemoryUsageReport::Entry const* left, Trinity::MemoryUsageReport::Entry const* right)
+        {
+            return left->Bytes > right->Bytes;
+        });
+
+        std::size_t const maxEntries = 25;
+        handler->PSendSysMessage("Largest entries of %s (%u of %u):", entries.front()->Category.c_str(), uint32(std::min(entries.size(), maxEntries)), uint32(entries.size()));
+        for (std::size_t i = 0; i < entries.size() && i < maxEntries; ++i)
+            handler->PSendSysMessage("  %s: %.2f MB", entries[i]->Name.c_str(), toMB(entries[i]->Bytes));
+        return true;
+    }
+
     static bool HandleServerInfoCommand(ChatHandler* handler, char const* /*args*/)
     {
         uint32 playersNum           = sWorld->GetPlayerCount();
@@ -21,6 +21,8 @@
 #include "DB2FileSystemSource.h"
 #include "DB2Meta.h"
 #include "StringFormat.h"
+#include <algorithm>
+#include <cstring>
 
 DB2StorageBase::DB2StorageBase(char const* fileName, DB2LoadInfo const* loadInfo)
     : _tableHash(0), _layoutHash(0), _fileName(fileName), _fieldCount(0), _loadInfo(loadInfo), _dataTable(nullptr), _dataTableEx(),
@@ -85,12 +87,71 @@ void DB2StorageBase::WriteRecord(uint32 id, LocaleConstant locale, ByteBuffer& b
     }
 }
 
-void DB2StorageBase::Load(std::string const& path, LocaleConstant locale)
+std::size_t DB2StorageBase::GetMemoryUsage() const
+{
+    uint32 recordSize = _loadInfo->Meta->GetRecordSize();
+    std::size_t size = _indexTableSize * sizeof(char*) + _stringPool.capacity() * sizeof(char*);
+    for (uint32 id = 0; id < _indexTableSize; ++id)
+    {
+        char const* entry = _indexTable[id];
+        if (!entry)
+            continue;
+
+        size += recordSize;
+        if (!_loadInfo->GetStringFieldCount(false))
+            continue;
+
+        if (!_loadInfo->Meta->HasIndexFieldInData())
+            entry += 4;
+
+        for (uint32 i = 0; i < _loadInfo->Meta->FieldCount; ++i)
+        {
+            for (uint8 arr = 0; arr < _loadInfo->Meta->Fields[i].ArraySize; ++arr)
+            {
+                switch (_loadInfo->Meta->Fields[i].Type)
+                {
+                    case FT_INT:
+                    case FT_FLOAT:
+                        entry += 4;
+                        break;
+                    case FT_BYTE:
+                        entry += 1;
+                        break;
+                    case FT_SHORT:
+                        entry += 2;
+                        break;
+                    case FT_LONG:
+                        entry += 8;
+                        break;
+                    case FT_STRING:
+                    {
+                        // locales that were not loaded share the pointer of another locale
+                        LocalizedString const* str = reinterpret_cast<LocalizedString const*>(entry);
+                        for (std::size_t locale = 0; locale < str->Str.size(); ++locale)
+                            if (str->Str[locale] && *str->Str[locale] && std::find(str->Str.begin(), str->Str.begin() + locale, str->Str[locale]) == str->Str.begin() + locale)
+                                size += strlen(str->Str[locale]) + 1;
+                        entry += sizeof(LocalizedString);
+                        break;
+                    }
+                    case FT_STRING_NOT_LOCALIZED:
+                        if (char const* str = *reinterpret_cast<char const* const*>(entry))
+                            size += strlen(str) + 1;
+                        entry += sizeof(char const*);
+                        break;
+                }
+            }
+        }
+    }
+
+    return size;
+}
+
+void DB2StorageBase::Load(std::string const& path, LocaleConstant locale, bool mapFile /*= false*/)
 {
     DB2FileLoader db2;
-    DB2FileSystemSource source(path + _fileName);
+    std::unique_ptr<DB2FileSystemSource> source = std::make_unique<DB2FileSystemSource>(path + _fileName, mapFile);
     // Check if load was successful, only then continue
-    db2.Load(&source, _loadInfo);
+    db2.Load(source.get(), _loadInfo);
 
     _fieldCount = db2.GetCols();
     _tableHash = db2.GetTableHash();
@@ -105,23 +166,32 @@ void DB2StorageBase::Load(std::string const& path, LocaleConstant locale)
         _stringPool.push_back(stringBlock);
 
     db2.AutoProduceRecordCopies(_indexTableSize, _indexTable, _dataTable);
+
+    // produced strings may point into the mapping
+    if (source->IsMapped() && _loadInfo->GetStringFieldCount(false))
+        _mappedFiles.push_back(std::move(source));
 }
 
-void DB2StorageBase::LoadStringsFrom(std::string const& path, LocaleConstant locale)
+void DB2StorageBase::LoadStringsFrom(std::string const& path, LocaleConstant locale, bool mapFile /*= false*/)
 {
     // DB2 must be already loaded using Load
     if (!_indexTable)
         throw DB2FileLoadException(Trinity::StringFormat("{} was not loaded properly, cannot load strings", path));
 
     DB2FileLoader db2;
-    DB2FileSystemSource source(path + _fileName);
+    std::unique_ptr<DB2FileSystemSource> source = std::make_unique<DB2FileSystemSource>(path + _fileName, mapFile);
     // Check if load was successful, only then continue
-    db2.Load(&source, _loadInfo);
+    db2.Load(source.get(), _loadInfo);
 
     // load strings from another locale db2 data
     if (_loadInfo->GetStringFieldCount(true))
+    {
         if (char* stringBlock = db2.AutoProduceStrings(_indexTable, _indexTableSize, locale))
             _stringPool.push_back(stringBlock);
+
+        if (source->IsMapped())
+            _mappedFiles.push_back(std::move(source));
+    }
 }
 
 void DB2StorageBase::LoadFromDB()
@@ -21,9 +21,11 @@
 #include "Common.h"
 #include "Errors.h"
 #include "DBStorageIterator.h"
+#include <memory>
 #include <vector>
 
 class ByteBuffer;
+struct DB2FileSource;
 struct DB2LoadInfo;
 
 /// Interface class for common access
@@ -49,8 +51,12 @@ public:
     DB2LoadInfo const* GetLoadInfo() const { return _loadInfo; }
     uint32 GetNumRows() const { return _indexTableSize; }
 
-    void Load(std::string const& path, LocaleConstant locale);
-    void LoadStringsFrom(std::string const& path, LocaleConstant locale);
+    // estimate of the memory used by the index, records and strings, mapped strings are included
+    std::size_t GetMemoryUsage() const;
+
+    // mapFile reads the db2 file through a shared read only mapping, strings are then used in place and the mapping is kept for the lifetime of the store
+    void Load(std::string const& path, LocaleConstant locale, bool mapFile = false);
+    void LoadStringsFrom(std::string const& path, LocaleConstant locale, bool mapFile = false);
     void LoadFromDB();
     void LoadStringsFromDB(LocaleConstant locale);
 
@@ -63,6 +69,7 @@ protected:
     char* _dataTable;
     char* _dataTableEx[2];
     std::vector<char*> _stringPool;
+    std::vector<std::unique_ptr<DB2FileSource>> _mappedFiles;
     char** _indexTable;
     uint32 _indexTableSize;
     uint32 _minId;
@@ -69,7 +69,8 @@ public:
         });
     }
 
-    bool Bind()
+    /// reusePort allows several acceptors to listen on the same endpoint, the kernel spreads incoming connections between them
+    bool Bind(bool reusePort = false)
     {
         boost::system::error_code errorCode;
         _acceptor.open(_endpoint.protocol(), errorCode);
@@ -79,6 +80,21 @@ public:
             return false;
         }
 
+        if (reusePort)
+        {
+#if TRINITY_PLATFORM == TRINITY_PLATFORM_UNIX && defined(SO_REUSEPORT)
+            _acceptor.set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true), errorCode);
+            if (errorCode)
+            {
+                TC_LOG_INFO("network", "Failed to set SO_REUSEPORT option on acceptor {}", errorCode.message());
+                return false;
+            }
+#else
+            TC_LOG_INFO("network", "SO_REUSEPORT acceptors are not supported on this platform");
+            return false;
+#endif
+        }
+
 #if TRINITY_PLATFORM != TRINITY_PLATFORM_WINDOWS
         _acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true), errorCode);
         if (errorCode)
@@ -116,6 +132,9 @@ public:
 
     void SetSocketFactory(std::function<std::pair<boost::asio::ip::tcp::socket*, uint32>()> func) { _socketFactory = std::move(func); }
 
+    /// Socket owned by the acceptor, created on the same io_context
+    boost::asio::ip::tcp::socket* GetAcceptSocket() { return &_socket; }
+
 private:
     std::pair<boost::asio::ip::tcp::socket*, uint32> DefeaultSocketFactory() { return std::make_pair(&_socket, 0); }
 
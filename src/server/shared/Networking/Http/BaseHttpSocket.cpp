@@ -23,13 +23,15 @@ namespace Trinity::Net::Http
 using RequestSerializer = boost::beast::http::request_serializer<ResponseBody>;
 using ResponseSerializer = boost::beast::http::response_serializer<ResponseBody>;
 
-bool AbstractSocket::ParseRequest(MessageBuffer& packet, RequestParser& parser)
+bool AbstractSocket::ParseRequest(MessageBuffer& packet, RequestParser& parser, boost::system::error_code& error)
 {
     if (!parser.is_done())
     {
         // need more data in the payload
-        boost::system::error_code ec = {};
-        std::size_t readDataSize = parser.put(boost::asio::const_buffer(packet.GetReadPointer(), packet.GetActiveSize()), ec);
+        std::size_t readDataSize = parser.put(boost::asio::const_buffer(packet.GetReadPointer(), packet.GetActiveSize()), error);
+        if (error == boost::beast::http::error::need_more)
+            error = {};
+
         packet.ReadCompleted(readDataSize);
     }
 
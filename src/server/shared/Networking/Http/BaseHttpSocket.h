@@ -19,6 +19,7 @@
 #define TRINITYCORE_BASE_HTTP_SOCKET_H
 
 #include "AsyncCallbackProcessor.h"
+#include "CryptoWorkerPool.h"
 #include "DatabaseEnvFwd.h"
 #include "HttpCommon.h"
 #include "HttpSessionState.h"
@@ -44,7 +45,8 @@ public:
     AbstractSocket& operator=(AbstractSocket&& other) = default;
     virtual ~AbstractSocket() = default;
 
-    static bool ParseRequest(MessageBuffer& packet, RequestParser& parser);
+    // returns true once the parser holds a complete request, malformed requests are reported through error
+    static bool ParseRequest(MessageBuffer& packet, RequestParser& parser, boost::system::error_code& error);
 
     static std::string SerializeRequest(Request const& request);
     static MessageBuffer SerializeResponse(Request const& request, Response& response);
@@ -53,6 +55,8 @@ public:
 
     virtual void QueueQuery(QueryCallback&& queryCallback) = 0;
 
+    virtual void QueueCryptoCallback(Crypto::WorkerCallback&& cryptoCallback) = 0;
+
     virtual std::string GetClientInfo() const = 0;
 
     virtual Optional<boost::uuids::uuid> GetSessionId() const = 0;
@@ -80,11 +84,29 @@ public:
         if (!this->IsOpen())
             return;
 
+        if (HandleBufferedRequests())
+            this->AsyncRead();
+    }
+
+    // Handles every complete request in the read buffer (keep-alive connections may pipeline several)
+    // Responses must be sent in request order, so processing stops at a request answered asynchronously
+    // and resumes, together with reading, once its response is sent
+    // Returns true if the socket should keep reading
+    bool HandleBufferedRequests()
+    {
         MessageBuffer& packet = this->GetReadBuffer();
-        while (packet.GetActiveSize() > 0)
+        while (packet.GetActiveSize() > 0 && !_asyncRequestPending)
         {
-            if (!ParseRequest(packet, *_httpParser))
+            boost::system::error_code error;
+            if (!ParseRequest(packet, *_httpParser, error))
             {
+                if (error)
+                {
+                    TC_LOG_DEBUG("server.http", "{} Malformed request: {}", this->GetClientInfo(), error.message());
+                    this->CloseSocket();
+                    return false;
+                }
+
                 // Couldn't receive the whole data this time.
                 break;
             }
@@ -92,18 +114,18 @@ public:
             if (!HandleMessage(_httpParser->get()))
             {
                 this->CloseSocket();
-                break;
+                return false;
             }
 
             this->ResetHttpParser();
         }
 
-        this->AsyncRead();
+        return !_asyncRequestPending;
     }
 
     bool HandleMessage(Request& request)
     {
-        RequestContext context { .request = std::move(request) };
+        RequestContext context { .request = std::move(request), .receivedTime = TimePoint::clock::now() };
 
         if (!_state)
             _state = this->ObtainSessionState(context);
@@ -112,6 +134,8 @@ public:
 
         if (status != RequestHandlerResult::Async)
             this->SendResponse(context);
+        else
+            _asyncRequestPending = true;
 
         return status != RequestHandlerResult::Error;
     }
@@ -132,10 +156,16 @@ public:
                 CanLogResponseContent(context) ? std::string_view(reinterpret_cast<char const*>(buffer.GetBasePointer()), buffer.GetActiveSize()) : "<REDACTED>");
         }
 
+        RecordRequestLatency(context);
+
         this->QueuePacket(std::move(buffer));
 
+        bool resumeReading = std::exchange(_asyncRequestPending, false);
+
         if (!context.response.keep_alive())
             this->DelayedCloseSocket();
+        else if (resumeReading && HandleBufferedRequests())
+            this->AsyncRead();
     }
 
     void QueueQuery(QueryCallback&& queryCallback) override
@@ -143,12 +173,18 @@ public:
         this->_queryProcessor.AddCallback(std::move(queryCallback));
     }
 
+    void QueueCryptoCallback(Crypto::WorkerCallback&& cryptoCallback) override
+    {
+        this->_cryptoProcessor.AddCallback(std::move(cryptoCallback));
+    }
+
     bool Update() override
     {
         if (!this->Base::Update())
             return false;
 
         this->_queryProcessor.ProcessReadyCallbacks();
+        this->_cryptoProcessor.ProcessReadyCallbacks();
         return true;
     }
 
@@ -183,8 +219,10 @@ protected:
     virtual std::shared_ptr<SessionState> ObtainSessionState(RequestContext& context) const = 0;
 
     QueryCallbackProcessor _queryProcessor;
+    AsyncCallbackProcessor<Crypto::WorkerCallback> _cryptoProcessor;
     Optional<RequestParser> _httpParser;
     std::shared_ptr<SessionState> _state;
+    bool _asyncRequestPending = false;
 };
 }
 
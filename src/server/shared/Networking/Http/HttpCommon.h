@@ -19,6 +19,7 @@
 #define TRINITYCORE_HTTP_COMMON_H
 
 #include "Define.h"
+#include "Duration.h"
 #include <boost/beast/http/message.hpp>
 #include <boost/beast/http/string_body.hpp>
 
@@ -35,11 +36,14 @@ struct RequestContext
     Request request;
     Response response;
     struct RequestHandler const* handler = nullptr;
+    TimePoint receivedTime;
 };
 
 TC_SHARED_API bool CanLogRequestContent(RequestContext const& context);
 TC_SHARED_API bool CanLogResponseContent(RequestContext const& context);
 
+TC_SHARED_API void RecordRequestLatency(RequestContext const& context);
+
 inline std::string_view ToStdStringView(boost::beast::string_view bsw)
 {
     return { bsw.data(), bsw.size() };
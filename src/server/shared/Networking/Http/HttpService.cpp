@@ -18,6 +18,7 @@
 #include "HttpService.h"
 #include "BaseHttpSocket.h"
 #include "CryptoRandom.h"
+#include "Metric.h"
 #include "Timezone.h"
 #include <boost/beast/version.hpp>
 #include <boost/uuid/string_generator.hpp>
@@ -35,6 +36,17 @@ bool CanLogResponseContent(RequestContext const& context)
     return !context.handler || !context.handler->Flags.HasFlag(RequestHandlerFlag::DoNotLogResponseContent);
 }
 
+void RecordRequestLatency(RequestContext const& context)
+{
+    if (!context.handler)
+        return;
+
+    uint32 elapsed = uint32(std::chrono::duration_cast<std::chrono::microseconds>(TimePoint::clock::now() - context.receivedTime).count());
+
+    std::lock_guard<std::mutex> lock(context.handler->Stats->Lock);
+    context.handler->Stats->Latency.Add(elapsed);
+}
+
 RequestHandlerResult DispatcherService::HandleRequest(std::shared_ptr<AbstractSocket> session, RequestContext& context)
 {
     TC_LOG_DEBUG(_logger, "{} Starting request {} {}", session->GetClientInfo(),
@@ -119,10 +131,32 @@ void DispatcherService::RegisterHandler(boost::beast::http::verb method, std::st
         }
     }();
 
-    handlerMap[std::string(path)] = { .Func = std::move(handler), .Flags = flags };
+    std::unique_ptr<RequestHandlerStats> stats = std::make_unique<RequestHandlerStats>();
+    stats->Name = StringFormat("{} {}", ToStdStringView(boost::beast::http::to_string(method)), path);
+
+    handlerMap[std::string(path)] = { .Func = std::move(handler), .Flags = flags, .Stats = std::move(stats) };
     TC_LOG_INFO(_logger, "Registered new handler for {} {}", ToStdStringView(boost::beast::http::to_string(method)), path);
 }
 
+void DispatcherService::LogMetrics()
+{
+    for (HttpMethodHandlerMap* handlerMap : { &_getHandlers, &_postHandlers })
+    {
+        for (auto& [path, handler] : *handlerMap)
+        {
+            MetricHistogram latency;
+            {
+                std::lock_guard<std::mutex> lock(handler.Stats->Lock);
+                latency = handler.Stats->Latency;
+                handler.Stats->Latency.Reset();
+            }
+
+            if (latency.GetCount())
+                TC_METRIC_HISTOGRAM("http_request_latency", latency, TC_METRIC_TAG("endpoint", handler.Stats->Name));
+        }
+    }
+}
+
 void SessionService::InitAndStoreSessionState(std::shared_ptr<SessionState> state, boost::asio::ip::address const& address)
 {
     state->RemoteAddress = address;
@@ -235,7 +269,9 @@ void SessionService::KillInactiveSessions()
             auto sessionItr = _sessions.find(*itr);
             if (sessionItr == _sessions.end() || sessionItr->second->InactiveTimestamp < now)
             {
-                _sessions.erase(sessionItr);
+                if (sessionItr != _sessions.end())
+                    _sessions.erase(sessionItr);
+
                 itr = inactiveSessions.erase(itr);
             }
             else
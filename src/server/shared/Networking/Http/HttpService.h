@@ -24,11 +24,14 @@
 #include "EnumFlag.h"
 #include "HttpCommon.h"
 #include "HttpSessionState.h"
+#include "MetricHistogram.h"
 #include "Optional.h"
 #include "SocketMgr.h"
 #include <boost/uuid/uuid.hpp>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <shared_mutex>
 
@@ -45,10 +48,18 @@ enum class RequestHandlerFlag
 
 DEFINE_ENUM_FLAG(RequestHandlerFlag);
 
+struct RequestHandlerStats
+{
+    std::string Name;
+    std::mutex Lock;
+    MetricHistogram Latency;    // microseconds from receiving the request to queueing its response
+};
+
 struct RequestHandler
 {
     std::function<RequestHandlerResult(std::shared_ptr<AbstractSocket> session, RequestContext& context)> Func;
     EnumFlag<RequestHandlerFlag> Flags = RequestHandlerFlag::None;
+    std::unique_ptr<RequestHandlerStats> Stats;
 };
 
 class TC_SHARED_API DispatcherService
@@ -65,6 +76,8 @@ public:
     static RequestHandlerResult HandleUnauthorized(std::shared_ptr<AbstractSocket> session, RequestContext& context);
     static RequestHandlerResult HandlePathNotFound(std::shared_ptr<AbstractSocket> session, RequestContext& context);
 
+    void LogMetrics();
+
 protected:
     void RegisterHandler(boost::beast::http::verb method, std::string_view path,
         std::function<RequestHandlerResult(std::shared_ptr<AbstractSocket> session, RequestContext& context)> handler,
@@ -0,0 +1,59 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MetricExporterService.h"
+#include "Metric.h"
+
+namespace Trinity::Net::Http
+{
+RequestHandlerResult MetricExporterSession::RequestHandler(RequestContext& context)
+{
+    return sMetricExporterService.HandleRequest(shared_from_this(), context);
+}
+
+MetricExporterService& MetricExporterService::Instance()
+{
+    static MetricExporterService instance;
+    return instance;
+}
+
+bool MetricExporterService::StartNetwork(Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, int32 threadCount)
+{
+    if (!HttpService::StartNetwork(ioContext, bindIp, port, threadCount))
+        return false;
+
+    RegisterHandler(boost::beast::http::verb::get, "/metrics", [](std::shared_ptr<MetricExporterSession> session, RequestContext& context)
+    {
+        return HandleGetMetrics(std::move(session), context);
+    }, RequestHandlerFlag::DoNotLogResponseContent);
+
+    AsyncAcceptWithCallback<&MetricExporterService::OnSocketAccept>();
+    return true;
+}
+
+void MetricExporterService::OnSocketAccept(boost::asio::ip::tcp::socket&& sock, uint32 threadIndex)
+{
+    sMetricExporterService.OnSocketOpen(std::move(sock), threadIndex);
+}
+
+RequestHandlerResult MetricExporterService::HandleGetMetrics(std::shared_ptr<MetricExporterSession> /*session*/, RequestContext& context)
+{
+    context.response.set(boost::beast::http::field::content_type, "text/plain; version=0.0.4; charset=utf-8");
+    context.response.body() = sMetric->GetExportedText();
+    return RequestHandlerResult::Handled;
+}
+}
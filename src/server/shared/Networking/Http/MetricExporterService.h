@@ -0,0 +1,57 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITYCORE_METRIC_EXPORTER_SERVICE_H
+#define TRINITYCORE_METRIC_EXPORTER_SERVICE_H
+
+#include "HttpService.h"
+#include "HttpSocket.h"
+
+namespace Trinity::Net::Http
+{
+class MetricExporterSession : public Socket<MetricExporterSession>
+{
+public:
+    using Socket::Socket;
+
+    RequestHandlerResult RequestHandler(RequestContext& context) override;
+
+protected:
+    // scrapes are stateless
+    std::shared_ptr<SessionState> ObtainSessionState(RequestContext& /*context*/) const override { return nullptr; }
+};
+
+// Serves the metrics collected by sMetric at /metrics for Prometheus to scrape
+class TC_SHARED_API MetricExporterService : public HttpService<MetricExporterSession>
+{
+public:
+    MetricExporterService() : HttpService("metrics") { }
+
+    static MetricExporterService& Instance();
+
+    bool StartNetwork(Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, int32 threadCount = 1) override;
+
+private:
+    static void OnSocketAccept(boost::asio::ip::tcp::socket&& sock, uint32 threadIndex);
+
+    static RequestHandlerResult HandleGetMetrics(std::shared_ptr<MetricExporterSession> session, RequestContext& context);
+};
+}
+
+#define sMetricExporterService Trinity::Net::Http::MetricExporterService::Instance()
+
+#endif // TRINITYCORE_METRIC_EXPORTER_SERVICE_H
@@ -23,8 +23,11 @@
 #include "Errors.h"
 #include "IoContext.h"
 #include "Log.h"
+#include "ThreadAffinity.h"
+#include "TickTracer.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -33,8 +36,12 @@ template<class SocketType>
 class NetworkThread
 {
 public:
-    NetworkThread() : _connections(0), _stopped(false), _thread(nullptr), _ioContext(1),
-        _acceptSocket(_ioContext), _updateTimer(_ioContext)
+    // one microsecond spent updating sockets weighs as much as this many bytes of traffic
+    static constexpr uint64 LoadUpdateTimeWeight = 16;
+    static constexpr std::chrono::milliseconds LoadMeasureInterval = std::chrono::seconds(1);
+
+    NetworkThread() : _connections(0), _stopped(false), _load(0), _connectionsAddedSinceLoadUpdate(0), _thread(nullptr), _ioContext(1),
+        _acceptSocket(_ioContext), _updateTimer(_ioContext), _measuredBytes(0), _measuredUpdateTime(0)
     {
     }
 
@@ -77,17 +84,32 @@ public:
         return _connections;
     }
 
+    /// Traffic of all sockets of this thread in bytes per second plus weighted socket update time, smoothed over the last few seconds
+    uint64 GetLoad() const
+    {
+        return _load;
+    }
+
+    /// Sockets added since the load was last measured, their traffic is not part of GetLoad yet
+    int32 GetConnectionsAddedSinceLoadUpdate() const
+    {
+        return _connectionsAddedSinceLoadUpdate;
+    }
+
     void AddSocket(std::shared_ptr<SocketType> sock)
     {
         std::lock_guard<std::mutex> lock(_newSocketsLock);
 
         ++_connections;
+        ++_connectionsAddedSinceLoadUpdate;
         _newSockets.push_back(sock);
         SocketAdded(sock);
     }
 
     boost::asio::ip::tcp::socket* GetSocketForAccept() { return &_acceptSocket; }
 
+    Trinity::Asio::IoContext& GetIoContext() { return _ioContext; }
+
 protected:
     virtual void SocketAdded(std::shared_ptr<SocketType> /*sock*/) { }
     virtual void SocketRemoved(std::shared_ptr<SocketType> /*sock*/) { }
@@ -116,7 +138,10 @@ protected:
     void Run()
     {
         TC_LOG_DEBUG("misc", "Network Thread Starting");
+        Trinity::TickTracer::SetThreadName("network");
+        Trinity::ThreadAffinity::ApplyToCurrentThread(Trinity::ThreadClass::Network);
 
+        _measureStart = std::chrono::steady_clock::now();
         _updateTimer.expires_from_now(boost::posix_time::milliseconds(1));
         _updateTimer.async_wait([this](boost::system::error_code const&) { Update(); });
         _ioContext.run();
@@ -134,11 +159,16 @@ protected:
         _updateTimer.expires_from_now(boost::posix_time::milliseconds(1));
         _updateTimer.async_wait([this](boost::system::error_code const&) { Update(); });
 
+        std::chrono::steady_clock::time_point updateStart = std::chrono::steady_clock::now();
+        TC_TRACE_ZONE("network_update");
+
         AddNewSockets();
 
         _sockets.erase(std::remove_if(_sockets.begin(), _sockets.end(), [this](std::shared_ptr<SocketType> sock)
         {
-            if (!sock->Update())
+            bool keep = sock->Update();
+            this->_measuredBytes += sock->ConsumeTransferredBytes();
+            if (!keep)
             {
                 if (sock->IsOpen())
                     sock->CloseSocket();
@@ -151,6 +181,25 @@ protected:
 
             return false;
         }), _sockets.end());
+
+        std::chrono::steady_clock::time_point updateEnd = std::chrono::steady_clock::now();
+        _measuredUpdateTime += std::chrono::duration_cast<std::chrono::microseconds>(updateEnd - updateStart).count();
+        if (updateEnd - _measureStart >= LoadMeasureInterval)
+            UpdateLoad(updateEnd);
+    }
+
+    void UpdateLoad(std::chrono::steady_clock::time_point now)
+    {
+        uint64 elapsed = std::max<uint64>(std::chrono::duration_cast<std::chrono::milliseconds>(now - _measureStart).count(), 1);
+        uint64 load = (_measuredBytes + _measuredUpdateTime * LoadUpdateTimeWeight) * 1000 / elapsed;
+
+        // halve the weight of older measurements every interval so short bursts do not dominate placement
+        _load = (_load + load) / 2;
+        _connectionsAddedSinceLoadUpdate = 0;
+
+        _measuredBytes = 0;
+        _measuredUpdateTime = 0;
+        _measureStart = now;
     }
 
 private:
@@ -159,6 +208,9 @@ private:
     std::atomic<int32> _connections;
     std::atomic<bool> _stopped;
 
+    std::atomic<uint64> _load;
+    std::atomic<int32> _connectionsAddedSinceLoadUpdate;
+
     std::thread* _thread;
 
     SocketContainer _sockets;
@@ -169,6 +221,11 @@ private:
     Trinity::Asio::IoContext _ioContext;
     boost::asio::ip::tcp::socket _acceptSocket;
     Trinity::Asio::DeadlineTimer _updateTimer;
+
+    // network thread only
+    uint64 _measuredBytes;
+    uint64 _measuredUpdateTime;
+    std::chrono::steady_clock::time_point _measureStart;
 };
 
 #endif // NetworkThread_h__
@@ -20,13 +20,21 @@
 
 #include "Log.h"
 #include "MessageBuffer.h"
+#include "TickTracer.h"
 #include <boost/asio/ip/tcp.hpp>
 #include <atomic>
+#include <deque>
 #include <memory>
-#include <queue>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #define READ_BLOCK_SIZE 4096
+// maximum number of queued buffers submitted with a single gathered write
+#define WRITE_BATCH_SIZE 64
+// sent buffers kept for reuse by GetFreeWriteBuffer, larger buffers are released
+#define WRITE_BUFFER_POOL_SIZE 4
+#define WRITE_BUFFER_POOL_MAX_BUFFER_SIZE 65536
 #ifdef BOOST_ASIO_HAS_IOCP
 #define TC_SOCKET_USE_IOCP
 #endif
@@ -65,9 +73,12 @@ public:
     template<typename... Args>
     explicit Socket(boost::asio::ip::tcp::socket&& socket, Args&&... args) : _socket(std::move(socket), std::forward<Args>(args)...),
         _remoteAddress(_socket.remote_endpoint().address()), _remotePort(_socket.remote_endpoint().port()),
-        _closed(false), _closing(false), _isWritingAsync(false)
+        _closed(false), _closing(false), _isWritingAsync(false), _transferredBytes(0)
     {
         _readBuffer.Resize(READ_BLOCK_SIZE);
+#ifndef TC_SOCKET_USE_IOCP
+        _writeBuffers.reserve(WRITE_BATCH_SIZE);
+#endif
     }
 
     Socket(Socket const& other) = delete;
@@ -140,7 +151,7 @@ public:
 
     void QueuePacket(MessageBuffer&& buffer)
     {
-        _writeQueue.push(std::move(buffer));
+        _writeQueue.push_back(std::move(buffer));
 
 #ifdef TC_SOCKET_USE_IOCP
         AsyncProcessQueue();
@@ -175,9 +186,26 @@ public:
 
     MessageBuffer& GetReadBuffer() { return _readBuffer; }
 
+    /// Bytes received and sent since the previous call, only called from the owning network thread
+    std::size_t ConsumeTransferredBytes() { return std::exchange(_transferredBytes, 0); }
+
 protected:
     virtual void OnClose() { }
 
+    /// Returns an empty buffer of at least size bytes, reusing storage of already sent buffers when possible
+    MessageBuffer GetFreeWriteBuffer(std::size_t size)
+    {
+        if (_freeWriteBuffers.empty())
+            return MessageBuffer(size);
+
+        MessageBuffer buffer(std::move(_freeWriteBuffers.back()));
+        _freeWriteBuffers.pop_back();
+        if (buffer.GetBufferSize() < size)
+            buffer.Resize(size);
+
+        return buffer;
+    }
+
     virtual void ReadHandler() = 0;
 
     bool AsyncProcessQueue()
@@ -220,6 +248,18 @@ protected:
     }
 
 private:
+    void PopSentWriteBuffer()
+    {
+        MessageBuffer& buffer = _writeQueue.front();
+        if (_freeWriteBuffers.size() < WRITE_BUFFER_POOL_SIZE && buffer.GetBufferSize() <= WRITE_BUFFER_POOL_MAX_BUFFER_SIZE)
+        {
+            buffer.Reset();
+            _freeWriteBuffers.push_back(std::move(buffer));
+        }
+
+        _writeQueue.pop_front();
+    }
+
     void ReadHandlerInternal(boost::system::error_code const& error, size_t transferredBytes)
     {
         if (error)
@@ -228,6 +268,8 @@ private:
             return;
         }
 
+        TC_TRACE_ZONE("socket_read");
+        _transferredBytes += transferredBytes;
         _readBuffer.WriteCompleted(transferredBytes);
         ReadHandler();
     }
@@ -236,12 +278,14 @@ private:
 
     void WriteHandler(boost::system::error_code const& error, std::size_t transferedBytes)
     {
+        TC_TRACE_ZONE("socket_write");
         if (!error)
         {
             _isWritingAsync = false;
+            _transferredBytes += transferedBytes;
             _writeQueue.front().ReadCompleted(transferedBytes);
             if (!_writeQueue.front().GetActiveSize())
-                _writeQueue.pop();
+                PopSentWriteBuffer();
 
             if (!_writeQueue.empty())
                 AsyncProcessQueue();
@@ -256,6 +300,7 @@ private:
 
     void WriteHandlerWrapper(boost::system::error_code const& /*error*/, std::size_t /*transferedBytes*/)
     {
+        TC_TRACE_ZONE("socket_write");
         _isWritingAsync = false;
         HandleQueue();
     }
@@ -265,37 +310,54 @@ private:
         if (_writeQueue.empty())
             return false;
 
-        MessageBuffer& queuedMessage = _writeQueue.front();
-
-        std::size_t bytesToSend = queuedMessage.GetActiveSize();
+        // gather as much of the queue as possible into a single writev
+        _writeBuffers.clear();
+        for (MessageBuffer& queuedMessage : _writeQueue)
+        {
+            _writeBuffers.emplace_back(queuedMessage.GetReadPointer(), queuedMessage.GetActiveSize());
+            if (_writeBuffers.size() >= WRITE_BATCH_SIZE)
+                break;
+        }
 
         boost::system::error_code error;
-        std::size_t bytesSent = _socket.write_some(boost::asio::buffer(queuedMessage.GetReadPointer(), bytesToSend), error);
+        std::size_t bytesSent = _socket.write_some(_writeBuffers, error);
 
         if (error)
         {
             if (error == boost::asio::error::would_block || error == boost::asio::error::try_again)
                 return AsyncProcessQueue();
 
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
         else if (bytesSent == 0)
         {
-            _writeQueue.pop();
+            _writeQueue.pop_front();
             if (_closing && _writeQueue.empty())
                 CloseSocket();
             return false;
         }
-        else if (bytesSent < bytesToSend) // now n > 0
+
+        _transferredBytes += bytesSent;
+
+        // drop every fully sent buffer and advance the first partially sent one
+        // streams that only send the first buffer of a sequence (ssl) end on a buffer boundary and simply continue with the next one
+        std::size_t remainingSent = bytesSent;
+        while (remainingSent)
         {
-            queuedMessage.ReadCompleted(bytesSent);
-            return AsyncProcessQueue();
+            MessageBuffer& queuedMessage = _writeQueue.front();
+            if (remainingSent < queuedMessage.GetActiveSize())
+            {
+                queuedMessage.ReadCompleted(remainingSent);
+                return AsyncProcessQueue();
+            }
+
+            remainingSent -= queuedMessage.GetActiveSize();
+            PopSentWriteBuffer();
         }
 
-        _writeQueue.pop();
         if (_closing && _writeQueue.empty())
             CloseSocket();
         return !_writeQueue.empty();
@@ -309,12 +371,18 @@ private:
     uint16 _remotePort;
 
     MessageBuffer _readBuffer;
-    std::queue<MessageBuffer> _writeQueue;
+    std::deque<MessageBuffer> _writeQueue;
+    std::vector<MessageBuffer> _freeWriteBuffers;
+#ifndef TC_SOCKET_USE_IOCP
+    std::vector<boost::asio::const_buffer> _writeBuffers;
+#endif
 
     std::atomic<bool> _closed;
     std::atomic<bool> _closing;
 
     bool _isWritingAsync;
+
+    std::size_t _transferredBytes;
 };
 
 #endif // __SOCKET_H__
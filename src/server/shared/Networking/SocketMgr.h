@@ -22,7 +22,9 @@
 #include "Errors.h"
 #include "NetworkThread.h"
 #include <boost/asio/ip/tcp.hpp>
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 template<class SocketType>
 class SocketMgr
@@ -30,48 +32,71 @@ class SocketMgr
 public:
     virtual ~SocketMgr()
     {
-        ASSERT(!_threads && !_acceptor && !_threadCount, "StopNetwork must be called prior to SocketMgr destruction");
+        ASSERT(!_threads && !_acceptor && _threadAcceptors.empty() && !_threadCount, "StopNetwork must be called prior to SocketMgr destruction");
     }
 
     virtual bool StartNetwork(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, int threadCount)
     {
         ASSERT(threadCount > 0);
 
-        AsyncAcceptor* acceptor = nullptr;
-        try
-        {
-            acceptor = new AsyncAcceptor(ioContext, bindIp, port);
-        }
-        catch (boost::system::system_error const& err)
+        _threadCount = threadCount;
+        _threads = CreateThreads();
+
+        ASSERT(_threads);
+
+        if (_reusePortAcceptors && _threadCount > 1)
         {
-            TC_LOG_ERROR("network", "Exception caught in SocketMgr.StartNetwork ({}:{}): {}", bindIp, port, err.what());
-            return false;
+            if (!BindThreadAcceptors(bindIp, port))
+            {
+                TC_LOG_ERROR("network", "StartNetwork failed to bind SO_REUSEPORT acceptors on {}:{}, falling back to a single acceptor", bindIp, port);
+                for (AsyncAcceptor* acceptor : _threadAcceptors)
+                    delete acceptor;
+                _threadAcceptors.clear();
+            }
         }
 
-        if (!acceptor->Bind())
+        if (_threadAcceptors.empty())
         {
-            TC_LOG_ERROR("network", "StartNetwork failed to bind socket acceptor");
-            delete acceptor;
-            return false;
+            AsyncAcceptor* acceptor = CreateAcceptor(ioContext, bindIp, port, false);
+            if (!acceptor)
+            {
+                delete[] _threads;
+                _threads = nullptr;
+                _threadCount = 0;
+                return false;
+            }
+
+            _acceptor = acceptor;
+            _acceptor->SetSocketFactory([this]() { return GetSocketForAccept(); });
         }
 
-        _acceptor = acceptor;
-        _threadCount = threadCount;
-        _threads = CreateThreads();
-
-        ASSERT(_threads);
-
         for (int32 i = 0; i < _threadCount; ++i)
             _threads[i].Start();
 
-        _acceptor->SetSocketFactory([this]() { return GetSocketForAccept(); });
-
         return true;
     }
 
+    /// Starts accepting connections on every acceptor, per thread acceptors start accepting on their own thread
+    template<AsyncAcceptor::AcceptCallback acceptCallback>
+    void AsyncAcceptWithCallback()
+    {
+        if (_acceptor)
+            _acceptor->AsyncAcceptWithCallback<acceptCallback>();
+
+        for (int32 i = 0; i < int32(_threadAcceptors.size()); ++i)
+        {
+            AsyncAcceptor* acceptor = _threadAcceptors[i];
+            Trinity::Asio::post(_threads[i].GetIoContext(), [acceptor]() { acceptor->AsyncAcceptWithCallback<acceptCallback>(); });
+        }
+    }
+
     virtual void StopNetwork()
     {
-        _acceptor->Close();
+        if (_acceptor)
+            _acceptor->Close();
+
+        for (AsyncAcceptor* acceptor : _threadAcceptors)
+            acceptor->Close();
 
         if (_threadCount != 0)
             for (int32 i = 0; i < _threadCount; ++i)
@@ -81,6 +106,9 @@ public:
 
         delete _acceptor;
         _acceptor = nullptr;
+        for (AsyncAcceptor* acceptor : _threadAcceptors)
+            delete acceptor;
+        _threadAcceptors.clear();
         delete[] _threads;
         _threads = nullptr;
         _threadCount = 0;
@@ -110,33 +138,108 @@ public:
 
     int32 GetNetworkThreadCount() const { return _threadCount; }
 
-    uint32 SelectThreadWithMinConnections() const
+    /// Selects the thread with the least measured traffic
+    /// Connections placed since a thread last measured its load are counted with the average load of a connection
+    /// so that a burst of new connections does not all land on the same thread before its load catches up
+    uint32 SelectThreadWithMinLoad() const
     {
-        uint32 min = 0;
+        uint64 totalLoad = 0;
+        uint64 totalConnections = 0;
+        for (int32 i = 0; i < _threadCount; ++i)
+        {
+            totalLoad += _threads[i].GetLoad();
+            totalConnections += std::max(_threads[i].GetConnectionCount(), 0);
+        }
+
+        uint64 connectionLoad = std::max<uint64>(totalConnections ? totalLoad / totalConnections : 0, MinConnectionLoad);
+        auto getScore = [&](int32 i)
+        {
+            NetworkThread<SocketType> const& thread = _threads[i];
+            return thread.GetLoad()
+                + uint64(std::max(thread.GetConnectionsAddedSinceLoadUpdate(), 0)) * connectionLoad
+                + uint64(std::max(thread.GetConnectionCount(), 0)) * MinConnectionLoad;
+        };
 
+        uint32 min = 0;
+        uint64 minScore = getScore(0);
         for (int32 i = 1; i < _threadCount; ++i)
-            if (_threads[i].GetConnectionCount() < _threads[min].GetConnectionCount())
+        {
+            uint64 score = getScore(i);
+            if (score < minScore || (score == minScore && _threads[i].GetConnectionCount() < _threads[min].GetConnectionCount()))
+            {
                 min = i;
+                minScore = score;
+            }
+        }
 
         return min;
     }
 
     std::pair<boost::asio::ip::tcp::socket*, uint32> GetSocketForAccept()
     {
-        uint32 threadIndex = SelectThreadWithMinConnections();
+        uint32 threadIndex = SelectThreadWithMinLoad();
         return std::make_pair(_threads[threadIndex].GetSocketForAccept(), threadIndex);
     }
 
 protected:
-    SocketMgr() : _acceptor(nullptr), _threads(nullptr), _threadCount(0)
+    /// When enabled StartNetwork opens one SO_REUSEPORT acceptor per network thread instead of a single acceptor
+    /// Connections are spread by the kernel and start on the thread that accepted them
+    void SetReusePortAcceptors(bool enable) { _reusePortAcceptors = enable; }
+
+    // load every connection adds regardless of its traffic, keeps idle connections spread evenly
+    static constexpr uint64 MinConnectionLoad = 64;
+
+    SocketMgr() : _acceptor(nullptr), _threads(nullptr), _threadCount(0), _reusePortAcceptors(false)
     {
     }
 
     virtual NetworkThread<SocketType>* CreateThreads() const = 0;
 
     AsyncAcceptor* _acceptor;
+    std::vector<AsyncAcceptor*> _threadAcceptors;
     NetworkThread<SocketType>* _threads;
     int32 _threadCount;
+    bool _reusePortAcceptors;
+
+private:
+    static AsyncAcceptor* CreateAcceptor(Trinity::Asio::IoContext& ioContext, std::string const& bindIp, uint16 port, bool reusePort)
+    {
+        AsyncAcceptor* acceptor = nullptr;
+        try
+        {
+            acceptor = new AsyncAcceptor(ioContext, bindIp, port);
+        }
+        catch (boost::system::system_error const& err)
+        {
+            TC_LOG_ERROR("network", "Exception caught in SocketMgr.StartNetwork ({}:{}): {}", bindIp, port, err.what());
+            return nullptr;
+        }
+
+        if (!acceptor->Bind(reusePort))
+        {
+            TC_LOG_ERROR("network", "StartNetwork failed to bind socket acceptor");
+            delete acceptor;
+            return nullptr;
+        }
+
+        return acceptor;
+    }
+
+    bool BindThreadAcceptors(std::string const& bindIp, uint16 port)
+    {
+        for (int32 i = 0; i < _threadCount; ++i)
+        {
+            AsyncAcceptor* acceptor = CreateAcceptor(_threads[i].GetIoContext(), bindIp, port, true);
+            if (!acceptor)
+                return false;
+
+            // accept into the acceptor's own socket, the thread accept socket is still handed out by GetSocketForAccept to other acceptors
+            acceptor->SetSocketFactory([acceptor, i]() { return std::make_pair(acceptor->GetAcceptSocket(), uint32(i)); });
+            _threadAcceptors.push_back(acceptor);
+        }
+
+        return true;
+    }
 };
 
 #endif // SocketMgr_h__
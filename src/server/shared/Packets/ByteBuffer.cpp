@@ -16,6 +16,7 @@
  */
 
 #include "ByteBuffer.h"
+#include "AllocationTracker.h"
 #include "Errors.h"
 #include "MessageBuffer.h"
 #include "Log.h"
@@ -96,6 +97,7 @@ void ByteBuffer::append(uint8 const* src, size_t cnt)
     size_t const newSize = _wpos + cnt;
     if (_storage.capacity() < newSize) // custom memory allocation rules
     {
+        TC_ALLOCATION_TAG_SCOPE(Packets);
         if (newSize < 100)
             _storage.reserve(300);
         else if (newSize < 750)
@@ -20,6 +20,7 @@
 
 #include "Define.h"
 #include "ByteConverter.h"
+#include "ByteBufferStoragePool.h"
 #include <array>
 #include <string>
 #include <vector>
@@ -59,9 +60,8 @@ class TC_SHARED_API ByteBuffer
         constexpr static uint8 InitialBitPos = 8;
 
         // constructor
-        ByteBuffer() : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0)
+        ByteBuffer() : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0), _storage(ByteBufferStoragePool::Acquire(DEFAULT_SIZE))
         {
-            _storage.reserve(DEFAULT_SIZE);
         }
 
         // reserve/resize tag
@@ -70,18 +70,30 @@ class TC_SHARED_API ByteBuffer
 
         ByteBuffer(size_t size, Reserve) : _rpos(0), _wpos(0), _bitpos(InitialBitPos), _curbitval(0)
         {
-            _storage.reserve(size);
+            if (size)
+                _storage = ByteBufferStoragePool::Acquire(size);
         }
 
         ByteBuffer(size_t size, Resize) : _rpos(0), _wpos(size), _bitpos(InitialBitPos), _curbitval(0)
         {
+            if (size)
+                _storage = ByteBufferStoragePool::Acquire(size);
+
             _storage.resize(size);
         }
 
         ByteBuffer(ByteBuffer&& buf) noexcept : _rpos(buf._rpos), _wpos(buf._wpos),
             _bitpos(buf._bitpos), _curbitval(buf._curbitval), _storage(buf.Move()) { }
 
-        ByteBuffer(ByteBuffer const& right) = default;
+        ByteBuffer(ByteBuffer const& right) : _rpos(right._rpos), _wpos(right._wpos),
+            _bitpos(right._bitpos), _curbitval(right._curbitval)
+        {
+            if (!right._storage.empty())
+            {
+                _storage = ByteBufferStoragePool::Acquire(right._storage.size());
+                _storage.assign(right._storage.begin(), right._storage.end());
+            }
+        }
 
         ByteBuffer(MessageBuffer&& buffer);
 
@@ -122,7 +134,10 @@ class TC_SHARED_API ByteBuffer
             return *this;
         }
 
-        virtual ~ByteBuffer() = default;
+        virtual ~ByteBuffer()
+        {
+            ByteBufferStoragePool::Release(std::move(_storage));
+        }
 
         void clear()
         {
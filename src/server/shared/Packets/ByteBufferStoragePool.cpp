@@ -0,0 +1,157 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ByteBufferStoragePool.h"
+#include "AllocationTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+
+namespace
+{
+constexpr std::size_t LocalListSize = 64;
+constexpr std::size_t TransferBatchSize = LocalListSize / 2;
+constexpr std::size_t MaxDepotSize = 1024;
+// storage that grew far beyond the largest size class is not worth keeping around
+constexpr std::size_t MaxPooledCapacity = ByteBufferStoragePool::SizeClasses.back() * 2;
+
+using StorageList = std::vector<std::vector<uint8>>;
+
+struct Depot
+{
+    std::mutex Lock;
+    std::array<StorageList, ByteBufferStoragePool::SizeClassCount> Lists;
+    std::array<std::atomic<std::size_t>, ByteBufferStoragePool::SizeClassCount> Counts = { };
+};
+
+Depot& GetDepot()
+{
+    static Depot depot;
+    return depot;
+}
+
+std::atomic<uint64> Hits;
+std::atomic<uint64> Misses;
+
+struct LocalCache
+{
+    // buffers destroyed during thread exit after the cache itself (static objects) bypass the pool
+    static thread_local bool Destroyed;
+
+    std::array<StorageList, ByteBufferStoragePool::SizeClassCount> Lists;
+
+    ~LocalCache()
+    {
+        Destroyed = true;
+
+        // hand leftovers of exiting threads to the depot
+        for (std::size_t i = 0; i < Lists.size(); ++i)
+            while (!Lists[i].empty())
+                Flush(i, Lists[i].size());
+    }
+
+    void Flush(std::size_t sizeClass, std::size_t count)
+    {
+        StorageList& list = Lists[sizeClass];
+        Depot& depot = GetDepot();
+        std::lock_guard<std::mutex> lock(depot.Lock);
+        StorageList& depotList = depot.Lists[sizeClass];
+        std::size_t moved = std::min(count, MaxDepotSize - std::min(MaxDepotSize, depotList.size()));
+        std::move(list.end() - moved, list.end(), std::back_inserter(depotList));
+        list.erase(list.end() - count, list.end());
+        depot.Counts[sizeClass].store(depotList.size(), std::memory_order_relaxed);
+    }
+
+    void Refill(std::size_t sizeClass)
+    {
+        Depot& depot = GetDepot();
+        if (!depot.Counts[sizeClass].load(std::memory_order_relaxed))
+            return;
+
+        std::lock_guard<std::mutex> lock(depot.Lock);
+        StorageList& depotList = depot.Lists[sizeClass];
+        std::size_t count = std::min(TransferBatchSize, depotList.size());
+        std::move(depotList.end() - count, depotList.end(), std::back_inserter(Lists[sizeClass]));
+        depotList.erase(depotList.end() - count, depotList.end());
+        depot.Counts[sizeClass].store(depotList.size(), std::memory_order_relaxed);
+    }
+};
+
+thread_local bool LocalCache::Destroyed = false;
+thread_local LocalCache Cache;
+}
+
+std::vector<uint8> ByteBufferStoragePool::Acquire(std::size_t size)
+{
+    TC_ALLOCATION_TAG_SCOPE(Packets);
+    std::vector<uint8> storage;
+    auto sizeClass = std::lower_bound(SizeClasses.begin(), SizeClasses.end(), size);
+    if (sizeClass == SizeClasses.end() || LocalCache::Destroyed)
+    {
+        storage.reserve(size);
+        return storage;
+    }
+
+    std::size_t index = std::distance(SizeClasses.begin(), sizeClass);
+    StorageList& list = Cache.Lists[index];
+    if (list.empty())
+        Cache.Refill(index);
+
+    if (!list.empty())
+    {
+        storage = std::move(list.back());
+        list.pop_back();
+        Hits.fetch_add(1, std::memory_order_relaxed);
+        return storage;
+    }
+
+    Misses.fetch_add(1, std::memory_order_relaxed);
+    storage.reserve(*sizeClass);
+    return storage;
+}
+
+void ByteBufferStoragePool::Release(std::vector<uint8>&& storage)
+{
+    // largest size class that still fits in the storage capacity
+    if (storage.capacity() > MaxPooledCapacity || LocalCache::Destroyed)
+        return;
+
+    auto sizeClass = std::upper_bound(SizeClasses.begin(), SizeClasses.end(), storage.capacity());
+    if (sizeClass == SizeClasses.begin())
+        return;
+
+    std::size_t index = std::distance(SizeClasses.begin(), sizeClass) - 1;
+    StorageList& list = Cache.Lists[index];
+    if (list.size() >= LocalListSize)
+        Cache.Flush(index, TransferBatchSize);
+
+    storage.clear();
+    list.push_back(std::move(storage));
+}
+
+ByteBufferStoragePool::Statistics ByteBufferStoragePool::GetStatistics()
+{
+    Statistics statistics;
+    statistics.Hits = Hits.load(std::memory_order_relaxed);
+    statistics.Misses = Misses.load(std::memory_order_relaxed);
+    Depot& depot = GetDepot();
+    for (std::size_t i = 0; i < SizeClassCount; ++i)
+        statistics.DepotCounts[i] = depot.Counts[i].load(std::memory_order_relaxed);
+
+    return statistics;
+}
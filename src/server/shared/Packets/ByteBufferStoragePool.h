@@ -0,0 +1,50 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_BYTE_BUFFER_STORAGE_POOL_H
+#define TRINITY_BYTE_BUFFER_STORAGE_POOL_H
+
+#include "Define.h"
+#include <array>
+#include <vector>
+
+// Size class pool for ByteBuffer storage
+// Every thread keeps a small free list per size class, surplus storage is exchanged in batches through a shared depot
+// so buffers allocated by one thread and destroyed by another (packets queued to sockets) still get reused
+class TC_SHARED_API ByteBufferStoragePool
+{
+public:
+    static constexpr std::size_t SizeClassCount = 5;
+    static constexpr std::array<std::size_t, SizeClassCount> SizeClasses = { 256, 1024, 4096, 16384, 65536 };
+
+    struct Statistics
+    {
+        uint64 Hits = 0;
+        uint64 Misses = 0;
+        std::array<std::size_t, SizeClassCount> DepotCounts = { };
+    };
+
+    // returns empty storage with capacity of at least size bytes
+    static std::vector<uint8> Acquire(std::size_t size);
+
+    // returns storage to the pool, storage smaller than the smallest size class is simply freed
+    static void Release(std::vector<uint8>&& storage);
+
+    static Statistics GetStatistics();
+};
+
+#endif // TRINITY_BYTE_BUFFER_STORAGE_POOL_H
@@ -32,7 +32,7 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <zlib.h>
 
-RealmList::RealmList() : _updateInterval(0)
+RealmList::RealmList() : _cacheGeneration(0), _updateInterval(0)
 {
 }
 
@@ -194,13 +194,23 @@ void RealmList::UpdateRealms()
     for (auto itr = existingRealms.begin(); itr != existingRealms.end(); ++itr)
         TC_LOG_INFO("realmlist", "Removed realm \"{}\".", itr->second);
 
+    bool changed;
     {
         std::unique_lock<std::shared_mutex> lock(_realmsMutex);
 
+        changed = _subRegions != newSubRegions || HasClientVisibleChanges(_realms, newRealms);
         _subRegions.swap(newSubRegions);
         _realms.swap(newRealms);
     }
 
+    if (changed)
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        _realmListCache.clear();
+        _realmEntryCache.clear();
+        ++_cacheGeneration;
+    }
+
     if (_updateInterval)
     {
         _updateTimer->expires_from_now(boost::posix_time::seconds(_updateInterval));
@@ -214,6 +224,28 @@ void RealmList::UpdateRealms()
     }
 }
 
+bool RealmList::HasClientVisibleChanges(RealmMap const& oldRealms, RealmMap const& newRealms)
+{
+    if (oldRealms.size() != newRealms.size())
+        return true;
+
+    for (auto oldItr = oldRealms.begin(), newItr = newRealms.begin(); oldItr != oldRealms.end(); ++oldItr, ++newItr)
+    {
+        Realm const& oldRealm = oldItr->second;
+        Realm const& newRealm = newItr->second;
+        if (oldItr->first != newItr->first
+            || oldRealm.Build != newRealm.Build
+            || oldRealm.Name != newRealm.Name
+            || oldRealm.Type != newRealm.Type
+            || oldRealm.Flags != newRealm.Flags
+            || oldRealm.Timezone != newRealm.Timezone
+            || oldRealm.PopulationLevel != newRealm.PopulationLevel)
+            return true;
+    }
+
+    return false;
+}
+
 Realm const* RealmList::GetRealm(Battlenet::RealmHandle const& id) const
 {
     std::shared_lock<std::shared_mutex> lock(_realmsMutex);
@@ -258,6 +290,31 @@ void RealmList::WriteSubRegions(bgs::protocol::game_utilities::v1::GetAllValuesF
 }
 
 std::vector<uint8> RealmList::GetRealmEntryJSON(Battlenet::RealmHandle const& id, uint32 build) const
+{
+    uint32 generation;
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        auto itr = _realmEntryCache.find({ id, build });
+        if (itr != _realmEntryCache.end())
+            return itr->second;
+
+        generation = _cacheGeneration;
+    }
+
+    std::vector<uint8> compressed = BuildRealmEntryJSON(id, build);
+
+    // the key comes from the client, only entries of existing realms are kept
+    if (compressed.empty())
+        return compressed;
+
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    if (generation == _cacheGeneration)
+        _realmEntryCache[{ id, build }] = compressed;
+
+    return compressed;
+}
+
+std::vector<uint8> RealmList::BuildRealmEntryJSON(Battlenet::RealmHandle const& id, uint32 build) const
 {
     std::vector<uint8> compressed;
     std::shared_lock<std::shared_mutex> lock(_realmsMutex);
@@ -312,6 +369,37 @@ std::vector<uint8> RealmList::GetRealmEntryJSON(Battlenet::RealmHandle const& id
 }
 
 std::vector<uint8> RealmList::GetRealmList(uint32 build, std::string const& subRegion) const
+{
+    uint32 generation;
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        auto itr = _realmListCache.find({ build, subRegion });
+        if (itr != _realmListCache.end())
+            return itr->second;
+
+        generation = _cacheGeneration;
+    }
+
+    std::vector<uint8> compressed = BuildRealmList(build, subRegion);
+
+    // the key comes from the client, only known builds and sub regions are kept
+    if (!GetBuildInfo(build))
+        return compressed;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(_realmsMutex);
+        if (!_subRegions.contains(subRegion))
+            return compressed;
+    }
+
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    if (generation == _cacheGeneration)
+        _realmListCache[{ build, subRegion }] = compressed;
+
+    return compressed;
+}
+
+std::vector<uint8> RealmList::BuildRealmList(uint32 build, std::string const& subRegion) const
 {
     JSON::RealmList::RealmListUpdates realmList;
     {
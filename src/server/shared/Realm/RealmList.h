@@ -24,6 +24,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <unordered_set>
 #include <vector>
@@ -80,6 +81,9 @@ private:
 
     void LoadBuildInfo();
     void UpdateRealms();
+    static bool HasClientVisibleChanges(RealmMap const& oldRealms, RealmMap const& newRealms);
+    std::vector<uint8> BuildRealmEntryJSON(Battlenet::RealmHandle const& id, uint32 build) const;
+    std::vector<uint8> BuildRealmList(uint32 build, std::string const& subRegion) const;
     void UpdateRealm(Realm& realm, Battlenet::RealmHandle const& id, uint32 build, std::string const& name,
         boost::asio::ip::address&& address, boost::asio::ip::address&& localAddr,
         uint16 port, uint8 icon, RealmFlags flag, uint8 timezone, AccountTypes allowedSecurityLevel, float population);
@@ -88,6 +92,14 @@ private:
     mutable std::shared_mutex _realmsMutex;
     RealmMap _realms;
     std::unordered_set<std::string> _subRegions;
+
+    // compressed realm list responses, cleared whenever UpdateRealms sees a change visible to clients
+    // blobs built from realms older than _cacheGeneration are not stored
+    mutable std::mutex _cacheMutex;
+    mutable std::map<std::pair<uint32, std::string>, std::vector<uint8>> _realmListCache;
+    mutable std::map<std::pair<Battlenet::RealmHandle, uint32>, std::vector<uint8>> _realmEntryCache;
+    uint32 _cacheGeneration;
+
     uint32 _updateInterval;
     std::unique_ptr<Trinity::Asio::DeadlineTimer> _updateTimer;
     std::unique_ptr<Trinity::Asio::Resolver> _resolver;
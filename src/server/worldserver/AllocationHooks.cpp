@@ -0,0 +1,80 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Replaces the global allocation functions of worldserver to charge all heap memory to allocation tags
+// Must be part of the executable, replacements living in shared libraries are not picked up on every platform
+// Over-aligned allocations are left to the default implementation and are not tracked
+
+#ifdef WITH_ALLOCATION_TAGS
+
+#include "AllocationTracker.h"
+#include <new>
+
+void* operator new(std::size_t size)
+{
+    if (void* ptr = Trinity::AllocationTracker::Allocate(size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept
+{
+    return Trinity::AllocationTracker::Allocate(size);
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept
+{
+    return Trinity::AllocationTracker::Allocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    Trinity::AllocationTracker::Deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    Trinity::AllocationTracker::Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+    Trinity::AllocationTracker::Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t /*size*/) noexcept
+{
+    Trinity::AllocationTracker::Deallocate(ptr);
+}
+
+void operator delete(void* ptr, std::nothrow_t const&) noexcept
+{
+    Trinity::AllocationTracker::Deallocate(ptr);
+}
+
+void operator delete[](void* ptr, std::nothrow_t const&) noexcept
+{
+    Trinity::AllocationTracker::Deallocate(ptr);
+}
+
+#endif
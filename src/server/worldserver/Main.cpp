@@ -20,14 +20,17 @@
 /// \file
 
 #include "Common.h"
+#include "AllocationTracker.h"
 #include "AppenderDB.h"
 #include "AsyncAcceptor.h"
 #include "AuthenticationPackets.h"
 #include "Banner.h"
 #include "BattlegroundMgr.h"
 #include "BigNumber.h"
+#include "ByteBufferStoragePool.h"
 #include "CliRunnable.h"
 #include "Configuration/Config.h"
+#include "CryptoWorkerPool.h"
 #include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
 #include "DeadlineTimer.h"
@@ -39,6 +42,7 @@
 #include "MapManager.h"
 #include "Memory.h"
 #include "Metric.h"
+#include "MetricExporterService.h"
 #include "MySQLThreading.h"
 #include "OpenSSLCrypto.h"
 #include "OutdoorPvP/OutdoorPvPMgr.h"
@@ -51,6 +55,7 @@
 #include "SecretMgr.h"
 #include "TCSoap.h"
 #include "TerrainMgr.h"
+#include "ThreadAffinity.h"
 #include "ThreadPool.h"
 #include "World.h"
 #include "WorldSocket.h"
@@ -279,6 +284,15 @@ extern int main(int argc, char** argv)
 #endif
     signals.async_wait(SignalHandler);
 
+    // Place thread classes on their processors, this must happen before any of their threads are started
+    bool numaLocalMemory = sConfigMgr->GetBoolDefault("ThreadAffinity.NumaLocalMemory", false);
+    for (auto const& [threadClass, configName] : { std::pair(Trinity::ThreadClass::MapUpdate, "ThreadAffinity.MapUpdate"),
+        std::pair(Trinity::ThreadClass::Network, "ThreadAffinity.Network"),
+        std::pair(Trinity::ThreadClass::DatabaseAsync, "ThreadAffinity.DatabaseAsync"),
+        std::pair(Trinity::ThreadClass::ThreadPool, "ThreadAffinity.ThreadPool") })
+        if (!Trinity::ThreadAffinity::Configure(threadClass, sConfigMgr->GetStringDefault(configName, ""), numaLocalMemory))
+            TC_LOG_ERROR("server.worldserver", "{} is not a valid processor list, {} threads are not restricted", configName, Trinity::GetThreadClassName(threadClass));
+
     // Start the Boost based thread pool
     int numThreads = sConfigMgr->GetIntDefault("ThreadPool", 1);
     if (numThreads < 1)
@@ -287,7 +301,11 @@ extern int main(int argc, char** argv)
     std::unique_ptr<Trinity::ThreadPool> threadPool = std::make_unique<Trinity::ThreadPool>(numThreads);
 
     for (int i = 0; i < numThreads; ++i)
-        threadPool->PostWork([ioContext]() { ioContext->run(); });
+        threadPool->PostWork([ioContext]()
+        {
+            Trinity::ThreadAffinity::ApplyToCurrentThread(Trinity::ThreadClass::ThreadPool);
+            ioContext->run();
+        });
 
     auto ioContextStopHandle = Trinity::make_unique_ptr_with_deleter(ioContext.get(), [](Trinity::Asio::IoContext* ctx) { ctx->stop(); });
 
@@ -320,6 +338,28 @@ extern int main(int argc, char** argv)
         TC_METRIC_VALUE("db_queue_login", uint64(LoginDatabase.QueueSize()));
         TC_METRIC_VALUE("db_queue_character", uint64(CharacterDatabase.QueueSize()));
         TC_METRIC_VALUE("db_queue_world", uint64(WorldDatabase.QueueSize()));
+        LoginDatabase.LogQueueMetrics();
+        CharacterDatabase.LogQueueMetrics();
+        WorldDatabase.LogQueueMetrics();
+
+        ByteBufferStoragePool::Statistics packetPool = ByteBufferStoragePool::GetStatistics();
+        TC_METRIC_VALUE("bytebuffer_pool_hits", packetPool.Hits);
+        TC_METRIC_VALUE("bytebuffer_pool_misses", packetPool.Misses);
+        for (std::size_t i = 0; i < ByteBufferStoragePool::SizeClassCount; ++i)
+            TC_METRIC_VALUE("bytebuffer_pool_depot", uint64(packetPool.DepotCounts[i]),
+                TC_METRIC_TAG("size_class", std::to_string(ByteBufferStoragePool::SizeClasses[i])));
+
+        if (Trinity::AllocationTracker::IsEnabled())
+        {
+            std::array<Trinity::AllocationTracker::TagStatistics, Trinity::AllocationTracker::TagCount> tags = Trinity::AllocationTracker::GetStatistics();
+            for (std::size_t i = 0; i < tags.size(); ++i)
+            {
+                char const* tagName = Trinity::GetAllocationTagName(Trinity::AllocationTag(i));
+                TC_METRIC_VALUE("allocation_live_bytes", tags[i].LiveBytes, TC_METRIC_TAG("tag", tagName));
+                TC_METRIC_VALUE("allocation_count", tags[i].Allocations, TC_METRIC_TAG("tag", tagName));
+                TC_METRIC_VALUE("allocation_bytes", tags[i].AllocatedBytes, TC_METRIC_TAG("tag", tagName));
+            }
+        }
     });
 
     TC_METRIC_EVENT("events", "Worldserver started", "");
@@ -330,6 +370,19 @@ extern int main(int argc, char** argv)
         metric->Unload();
     });
 
+    if (sMetric->IsExportEnabled())
+    {
+        std::string exporterBindIp = sConfigMgr->GetStringDefault("Metric.Exporter.BindIP", "0.0.0.0");
+        uint16 exporterPort = uint16(sConfigMgr->GetIntDefault("Metric.Exporter.Port", 0));
+        if (!sMetricExporterService.StartNetwork(*ioContext, exporterBindIp, exporterPort))
+        {
+            TC_LOG_ERROR("server.worldserver", "Failed to initialize metric exporter");
+            return 1;
+        }
+    }
+
+    auto sMetricExporterServiceHandle = Trinity::make_unique_ptr_with_deleter(&sMetricExporterService, [](Trinity::Net::Http::MetricExporterService* service) { service->StopNetwork(); });
+
     auto scriptReloadMgrHandle = Trinity::make_unique_ptr_with_deleter(sScriptReloadMgr, [](ScriptReloadMgr* mgr) { mgr->Unload(); });
 
     sScriptMgr->SetScriptLoader(AddScripts);
@@ -340,6 +393,12 @@ extern int main(int argc, char** argv)
     if (!sWorld->SetInitialWorldSettings())
         return 1;
 
+    // Warden check results are validated on the crypto workers, sessions validate their own results when too many are queued
+    if (sWorld->getBoolConfig(CONFIG_WARDEN_ENABLED))
+        sCryptoWorkerPool.Start(sWorld->getIntConfig(CONFIG_WARDEN_VALIDATION_THREADS), 1024);
+
+    auto cryptoWorkerPoolHandle = Trinity::make_unique_ptr_with_deleter(&sCryptoWorkerPool, [](Trinity::Crypto::WorkerPool* pool) { pool->Stop(); });
+
     auto instanceLockMgrHandle = Trinity::make_unique_ptr_with_deleter(&sInstanceLockMgr, [](InstanceLockMgr* mgr) { mgr->Unload(); });
 
     auto terrainMgrHandle = Trinity::make_unique_ptr_with_deleter(&sTerrainMgr, [](TerrainMgr* mgr) { mgr->UnloadAll(); });
@@ -390,7 +449,8 @@ extern int main(int argc, char** argv)
 
     auto sWorldSocketMgrHandle = Trinity::make_unique_ptr_with_deleter(&sWorldSocketMgr, [](WorldSocketMgr* mgr)
     {
-        sWorld->KickAll();                                       // save and kick all players
+        sWorld->LogoutAllPlayersForShutdown();                   // save all players and wait for the database to write them
+        sWorld->KickAll();                                       // kick all players
         sWorld->UpdateSessions(1);                             // real players unload required UpdateSessions call
 
         mgr->StopNetwork();
@@ -415,6 +475,9 @@ extern int main(int argc, char** argv)
 
     sScriptMgr->OnStartup();
 
+    for (std::string const& placement : Trinity::ThreadAffinity::GetSummary())
+        TC_LOG_INFO("server.worldserver", "Thread placement: {}", placement);
+
     TC_LOG_INFO("server.worldserver", "{} (worldserver-daemon) ready...", GitRevision::GetFullVersion());
 
     // Launch CliRunnable thread
@@ -541,6 +604,8 @@ void WorldUpdateLoop()
     WorldDatabase.WarnAboutSyncQueries(true);
     HotfixDatabase.WarnAboutSyncQueries(true);
 
+    Trinity::TickTracer::SetThreadName("world");
+
     ///- While we have not World::m_stopEvent, update the world
     while (!World::IsStopped())
     {
@@ -684,6 +749,9 @@ bool StartDB()
 
 void StopDB()
 {
+    // buffered db log messages must reach the login database before it closes
+    sLog->Flush();
+
     HotfixDatabase.Close();
     WorldDatabase.Close();
     CharacterDatabase.Close();
@@ -26,6 +26,8 @@
 #include "Locales.h"
 #include "MapDefines.h"
 #include "StringFormat.h"
+#include "ThreadPool.h"
+#include "Timer.h"
 #include "Util.h"
 #include "adt.h"
 #include "wdt.h"
@@ -33,6 +35,8 @@
 #include <boost/filesystem/directory.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
+#include <array>
+#include <atomic>
 #include <bitset>
 #include <deque>
 #include <fstream>
@@ -79,6 +83,7 @@ std::unordered_map<uint32, LiquidObjectEntry> LiquidObjects;
 std::unordered_map<uint32, LiquidTypeEntry> LiquidTypes;
 std::set<uint32> CameraFileDataIds;
 bool PrintProgress = true;
+unsigned int Threads = std::max(1u, std::thread::hardware_concurrency());
 boost::filesystem::path input_path;
 boost::filesystem::path output_path;
 
@@ -170,6 +175,7 @@ void Usage(char const* prg)
         "-p which installed product to open (wow/wowt/wow_beta)\n"\
         "-c use remote casc\n"\
         "-r set remote casc region - standard: eu\n"\
+        "-t number of threads used to convert map tiles and extract dbc files - standard: all available cores\n"\
         "Example: %s -f 0 -i \"c:\\games\\game\"\n", prg, prg);
     exit(1);
 }
@@ -186,6 +192,7 @@ void HandleArgs(int argc, char* arg[])
         // l - dbc locale
         // c - use remote casc
         // r - set casc remote region - standard: eu
+        // t - number of threads
         if (arg[c][0] != '-')
             Usage(arg[0]);
 
@@ -248,6 +255,12 @@ void HandleArgs(int argc, char* arg[])
                 else
                     Usage(arg[0]);
                 break;
+            case 't':
+                if (c + 1 < argc && atoi(arg[c + 1]) > 0)    // all ok
+                    Threads = uint32(atoi(arg[c++ + 1]));
+                else
+                    Usage(arg[0]);
+                break;
             case 'h':
                 Usage(arg[0]);
                 break;
@@ -423,24 +436,24 @@ float selectUInt16StepStore(float maxDiff)
 {
     return 65535 / maxDiff;
 }
-// Temporary grid data store
-uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+// Temporary grid data store, one per conversion thread
+thread_local uint16 area_ids[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
 
-float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
-uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local float V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint16 uint16_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint16 uint16_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint8  uint8_V8[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local uint8  uint8_V9[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
 
-uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-map_liquidHeaderTypeFlags liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
-bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
-float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
-uint8 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8];
+thread_local uint16 liquid_entry[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local map_liquidHeaderTypeFlags liquid_flags[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID];
+thread_local bool  liquid_show[ADT_GRID_SIZE][ADT_GRID_SIZE];
+thread_local float liquid_height[ADT_GRID_SIZE+1][ADT_GRID_SIZE+1];
+thread_local uint8 holes[ADT_CELLS_PER_GRID][ADT_CELLS_PER_GRID][8];
 
-int16 flight_box_max[3][3];
-int16 flight_box_min[3][3];
+thread_local int16 flight_box_max[3][3];
+thread_local int16 flight_box_min[3][3];
 
 LiquidVertexFormatType adt_MH2O::GetLiquidVertexFormat(adt_liquid_instance const* liquidInstance) const
 {
@@ -1071,8 +1084,6 @@ bool IsDeepWaterIgnored(uint32 mapId, uint32 x, uint32 y)
 
 void ExtractMaps(uint32 build)
 {
-    std::string outputFileName;
-
     printf("Extracting maps...\n");
 
     ReadMapDBC();
@@ -1095,6 +1106,17 @@ void ExtractMaps(uint32 build)
             FileChunk* mphd = wdt.GetChunk("MPHD");
             FileChunk* main = wdt.GetChunk("MAIN");
             FileChunk* maid = wdt.GetChunk("MAID");
+
+            // every tile writes its own .map file, results are collected per tile and merged into the bitset once all are done
+            std::array<bool, (WDT_MAP_SIZE) * (WDT_MAP_SIZE)> convertedTiles = { };
+            std::atomic<uint32> processedTiles = 0;
+            uint32 tileCount = 0;
+            for (uint32 y = 0; y < WDT_MAP_SIZE; ++y)
+                for (uint32 x = 0; x < WDT_MAP_SIZE; ++x)
+                    if (main->As<wdt_MAIN>()->adt_list[y][x].flag & 0x1)
+                        ++tileCount;
+
+            Trinity::ThreadPool pool(Threads);
             for (uint32 y = 0; y < WDT_MAP_SIZE; ++y)
             {
                 for (uint32 x = 0; x < WDT_MAP_SIZE; ++x)
@@ -1102,23 +1124,32 @@ void ExtractMaps(uint32 build)
                     if (!(main->As<wdt_MAIN>()->adt_list[y][x].flag & 0x1))
                         continue;
 
-                    outputFileName = Trinity::StringFormat("{}/maps/{:04}_{:02}_{:02}.map", output_path.string(), map_ids[z].Id, y, x);
-                    bool ignoreDeepWater = IsDeepWaterIgnored(map_ids[z].Id, y, x);
-                    if (mphd && mphd->As<wdt_MPHD>()->flags & 0x200)
+                    pool.PostWork([&, x, y]()
                     {
-                        existingTiles[y * WDT_MAP_SIZE + x] = ConvertADT(maid->As<wdt_MAID>()->adt_files[y][x].rootADT, map_ids[z].Name, outputFileName, y, x, build, ignoreDeepWater);
-                    }
-                    else
-                    {
-                        std::string storagePath = Trinity::StringFormat(R"(World\Maps\{}\{}_{}_{}.adt)", map_ids[z].Directory, map_ids[z].Directory, x, y);
-                        existingTiles[y * WDT_MAP_SIZE + x] = ConvertADT(storagePath, map_ids[z].Name, outputFileName, y, x, build, ignoreDeepWater);
-                    }
-                }
+                        std::string outputFileName = Trinity::StringFormat("{}/maps/{:04}_{:02}_{:02}.map", output_path.string(), map_ids[z].Id, y, x);
+                        bool ignoreDeepWater = IsDeepWaterIgnored(map_ids[z].Id, y, x);
+                        if (mphd && mphd->As<wdt_MPHD>()->flags & 0x200)
+                        {
+                            convertedTiles[y * WDT_MAP_SIZE + x] = ConvertADT(maid->As<wdt_MAID>()->adt_files[y][x].rootADT, map_ids[z].Name, outputFileName, y, x, build, ignoreDeepWater);
+                        }
+                        else
+                        {
+                            std::string storagePath = Trinity::StringFormat(R"(World\Maps\{}\{}_{}_{}.adt)", map_ids[z].Directory, map_ids[z].Directory, x, y);
+                            convertedTiles[y * WDT_MAP_SIZE + x] = ConvertADT(storagePath, map_ids[z].Name, outputFileName, y, x, build, ignoreDeepWater);
+                        }
 
-                // draw progress bar
-                if (PrintProgress)
-                    printf("Processing........................%d%%\r", (100 * (y + 1)) / WDT_MAP_SIZE);
+                        // draw progress bar
+                        uint32 processed = ++processedTiles;
+                        if (PrintProgress)
+                            printf("Processing........................%u/%u\r", processed, tileCount);
+                    });
+                }
             }
+
+            pool.Join();
+
+            for (std::size_t i = 0; i < convertedTiles.size(); ++i)
+                existingTiles[i] = convertedTiles[i];
         }
 
         if (FILE* tileList = fopen(Trinity::StringFormat("{}/maps/{:04}.tilelist", output_path.string(), map_ids[z].Id).c_str(), "wb"))
@@ -1134,6 +1165,28 @@ void ExtractMaps(uint32 build)
     printf("\n");
 }
 
+// copies the remaining bytes of a casc file to output in fixed size blocks, never holding more than one block in memory
+bool CopyCascFile(CASC::File* fileInArchive, int64 bytesToCopy, FILE* output)
+{
+    std::array<char, 0x10000> buffer;
+    while (bytesToCopy > 0)
+    {
+        uint32 readBytes = 0;
+        if (!fileInArchive->ReadFile(buffer.data(), uint32(std::min<int64>(bytesToCopy, buffer.size())), &readBytes))
+            return false;
+
+        if (!readBytes)
+            break;
+
+        if (fwrite(buffer.data(), 1, readBytes, output) != readBytes)
+            return false;
+
+        bytesToCopy -= readBytes;
+    }
+
+    return true;
+}
+
 bool ExtractFile(CASC::File* fileInArchive, std::string const& filename)
 {
     int64 fileSize = fileInArchive->GetSize();
@@ -1150,29 +1203,13 @@ bool ExtractFile(CASC::File* fileInArchive, std::string const& filename)
         return false;
     }
 
-    char  buffer[0x10000];
-    uint32 readBytes;
-
-    do
+    if (!CopyCascFile(fileInArchive, fileSize, output))
     {
-        readBytes = 0;
-        if (!fileInArchive->ReadFile(buffer, std::min<uint32>(fileSize, sizeof(buffer)), &readBytes))
-        {
-            printf("Can't read file '%s'\n", filename.c_str());
-            fclose(output);
-            boost::filesystem::remove(filename);
-            return false;
-        }
-
-        if (!readBytes)
-            break;
-
-        fwrite(buffer, 1, readBytes, output);
-        fileSize -= readBytes;
-        if (!fileSize) // now we have read entire file
-            break;
-
-    } while (true);
+        printf("Can't read file '%s'\n", filename.c_str());
+        fclose(output);
+        boost::filesystem::remove(filename);
+        return false;
+    }
 
     fclose(output);
     return true;
@@ -1228,32 +1265,14 @@ bool ExtractDB2File(uint32 fileDataId, char const* cascFileName, int locale, boo
         posAfterHeaders += fwrite(&sectionHeader, 1, sizeof(sectionHeader), output);
     }
 
-    char buffer[0x10000];
-    uint32 readBatchSize = 0x10000;
-    uint32 readBytes;
     source.SetPosition(posAfterHeaders);
-
-    do
+    if (!CopyCascFile(source.GetNativeHandle(), fileSize - posAfterHeaders, output))
     {
-        readBytes = 0;
-        if (!source.GetNativeHandle()->ReadFile(buffer, std::min<uint32>(fileSize, readBatchSize), &readBytes))
-        {
-            printf("Can't read file '%s'\n", outputFileName.c_str());
-            fclose(output);
-            boost::filesystem::remove(outputPath);
-            return false;
-        }
-
-        if (!readBytes)
-            break;
-
-        fwrite(buffer, 1, readBytes, output);
-        fileSize -= readBytes;
-        readBatchSize = 0x10000;
-        if (!fileSize) // now we have read entire file
-            break;
-
-    } while (true);
+        printf("Can't read file '%s'\n", outputFileName.c_str());
+        fclose(output);
+        boost::filesystem::remove(outputPath);
+        return false;
+    }
 
     fclose(output);
     return true;
@@ -1278,18 +1297,25 @@ void ExtractDBFilesClient(int l)
 
     printf("locale %s output path %s\n", localeNames[l], localePath.string().c_str());
 
-    uint32 count = 0;
+    std::atomic<uint32> count = 0;
+    Trinity::ThreadPool pool(Threads);
     for (DB2FileInfo const& db2 : DBFilesClientList)
     {
         boost::filesystem::path filePath = localePath / db2.Name;
 
         if (!boost::filesystem::exists(filePath))
-            if (ExtractDB2File(db2.FileDataId, db2.Name, l, filePath.string()))
-                ++count;
-
+        {
+            pool.PostWork([&count, &db2, l, filePath]()
+            {
+                if (ExtractDB2File(db2.FileDataId, db2.Name, l, filePath.string()))
+                    ++count;
+            });
+        }
     }
 
-    printf("Extracted %u files\n\n", count);
+    pool.Join();
+
+    printf("Extracted %u files\n\n", count.load());
 }
 
 void ExtractCameraFiles()
@@ -1491,6 +1517,10 @@ int main(int argc, char * arg[])
     int32 firstInstalledLocale = -1;
     uint32 build = 0;
 
+    // time spent per extraction stage, printed as a summary at the end
+    std::vector<std::pair<char const*, uint32>> stageTimes;
+    uint32 dbcTime = 0;
+
     for (int i = 0; i < TOTAL_LOCALES; ++i)
     {
         if (CONF_Locale && !(CONF_Locale & (1 << i)))
@@ -1528,7 +1558,9 @@ int main(int argc, char * arg[])
         }
 
         printf("Detected client build %u for locale %s\n\n", tempBuild, localeNames[i]);
+        uint32 stageStart = getMSTime();
         ExtractDBFilesClient(i);
+        dbcTime += GetMSTimeDiffToNow(stageStart);
         CascStorage.reset();
 
         if (firstInstalledLocale < 0)
@@ -1544,26 +1576,39 @@ int main(int argc, char * arg[])
         return 0;
     }
 
+    if (CONF_extract & EXTRACT_DBC)
+        stageTimes.emplace_back("dbc/db2 files", dbcTime);
+
     if (CONF_extract & EXTRACT_CAMERA)
     {
+        uint32 stageStart = getMSTime();
         OpenCascStorage(firstInstalledLocale);
         ExtractCameraFiles();
         CascStorage.reset();
+        stageTimes.emplace_back("camera files", GetMSTimeDiffToNow(stageStart));
     }
 
     if (CONF_extract & EXTRACT_GT)
     {
+        uint32 stageStart = getMSTime();
         OpenCascStorage(firstInstalledLocale);
         ExtractGameTables();
         CascStorage.reset();
+        stageTimes.emplace_back("game tables", GetMSTimeDiffToNow(stageStart));
     }
 
     if (CONF_extract & EXTRACT_MAP)
     {
+        uint32 stageStart = getMSTime();
         OpenCascStorage(firstInstalledLocale);
         ExtractMaps(build);
         CascStorage.reset();
+        stageTimes.emplace_back("maps", GetMSTimeDiffToNow(stageStart));
     }
 
+    printf("Extraction times (%u threads):\n", Threads);
+    for (auto const& [stage, time] : stageTimes)
+        printf("  %-16s %u.%03u s\n", stage, time / IN_MILLISECONDS, time % IN_MILLISECONDS);
+
     return 0;
 }
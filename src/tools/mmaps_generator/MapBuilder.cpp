@@ -17,6 +17,7 @@
 
 #include "MapBuilder.h"
 #include "Containers.h"
+#include "CryptoHash.h"
 #include "IntermediateValues.h"
 #include "MapTree.h"
 #include "Memory.h"
@@ -24,8 +25,10 @@
 #include "ModelInstance.h"
 #include "PathCommon.h"
 #include "StringFormat.h"
+#include "Util.h"
 #include <DetourNavMesh.h>
 #include <DetourNavMeshBuilder.h>
+#include <boost/filesystem/operations.hpp>
 #include <climits>
 
 namespace MMAP
@@ -58,7 +61,8 @@ namespace MMAP
 
     MapBuilder::MapBuilder(Optional<float> maxWalkableAngle, Optional<float> maxWalkableAngleNotSteep, bool skipLiquid,
         bool skipContinents, bool skipJunkMaps, bool skipBattlegrounds,
-        bool debugOutput, bool bigBaseUnit, int mapid, char const* offMeshFilePath, unsigned int threads) :
+        bool debugOutput, bool bigBaseUnit, int mapid, char const* offMeshFilePath, unsigned int threads,
+        uint32 shardIndex, uint32 shardCount) :
         m_terrainBuilder     (nullptr),
         m_debugOutput        (debugOutput),
         m_threads            (threads),
@@ -70,6 +74,8 @@ namespace MMAP
         m_maxWalkableAngleNotSteep (maxWalkableAngleNotSteep),
         m_bigBaseUnit        (bigBaseUnit),
         m_mapid              (mapid),
+        m_shardIndex         (shardIndex),
+        m_shardCount         (std::max(1u, shardCount)),
         m_totalTiles         (0u),
         m_totalTilesProcessed(0u),
         m_rcContext          (nullptr),
@@ -85,6 +91,8 @@ namespace MMAP
         discoverTiles();
 
         ParseOffMeshConnectionsFile(offMeshFilePath);
+
+        loadManifests();
     }
 
     /**************************************************************************/
@@ -305,6 +313,151 @@ namespace MMAP
             delete builder;
 
         m_tileBuilders.clear();
+
+        saveManifest();
+    }
+
+    /**************************************************************************/
+    bool MapBuilder::isTileInShard(uint32 mapID, uint32 tileX, uint32 tileY) const
+    {
+        return ((mapID * 64 + tileX) * 64 + tileY) % m_shardCount == m_shardIndex;
+    }
+
+    std::string MapBuilder::getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY) const
+    {
+        Trinity::Crypto::SHA1 hash;
+
+        auto hashFile = [&hash](std::string const& fileName)
+        {
+            auto file = Trinity::make_unique_ptr_with_deleter(fopen(fileName.c_str(), "rb"), &::fclose);
+            if (!file)
+                return false;
+
+            hash.UpdateData(fileName);
+            uint8 buffer[65536];
+            while (size_t read = fread(buffer, 1, sizeof(buffer), file.get()))
+                hash.UpdateData(buffer, read);
+
+            return true;
+        };
+
+        // same lookup as the terrain builder, tiles missing for child maps are taken from their parents
+        auto hashFileOfMapOrParent = [&](auto fileNameOfMap)
+        {
+            int32 fileMapId = int32(mapID);
+            while (fileMapId != -1 && !hashFile(fileNameOfMap(uint32(fileMapId))))
+            {
+                auto itr = sMapStore.find(uint32(fileMapId));
+                fileMapId = itr != sMapStore.end() ? itr->second.ParentMapID : -1;
+            }
+        };
+
+        // terrain of the tile and the borders of its neighbours, see TerrainBuilder::loadMap
+        std::pair<uint32, uint32> const mapTiles[] = { { tileX, tileY }, { tileX + 1, tileY }, { tileX - 1, tileY }, { tileX, tileY + 1 }, { tileX, tileY - 1 } };
+        for (std::pair<uint32, uint32> const& mapTile : mapTiles)
+            hashFileOfMapOrParent([&](uint32 fileMapId) { return Trinity::StringFormat("maps/{:04}_{:02}_{:02}.map", fileMapId, mapTile.second, mapTile.first); });
+
+        // model spawns, changes of the models themselves are not detected
+        hashFile(Trinity::StringFormat("vmaps/{:04}.vmtree", mapID));
+        hashFileOfMapOrParent([&](uint32 fileMapId) { return "vmaps/" + StaticMapTree::getTileFileName(fileMapId, tileY, tileX); });
+
+        for (OffMeshData const& offMeshConnection : m_offMeshConnections)
+        {
+            if (offMeshConnection.MapId != mapID || offMeshConnection.TileX != tileX || offMeshConnection.TileY != tileY)
+                continue;
+
+            hash.UpdateData(Trinity::StringFormat("{} {} {} {} {} {} {} {} {} {}", offMeshConnection.From[0], offMeshConnection.From[1], offMeshConnection.From[2],
+                offMeshConnection.To[0], offMeshConnection.To[1], offMeshConnection.To[2], offMeshConnection.Bidirectional,
+                offMeshConnection.Radius, offMeshConnection.AreaId, offMeshConnection.Flags));
+        }
+
+        hash.UpdateData(Trinity::StringFormat("{} {} {} {} {} {}", MMAP_VERSION, DT_NAVMESH_VERSION,
+            m_maxWalkableAngle.value_or(-1.0f), m_maxWalkableAngleNotSteep.value_or(-1.0f), m_bigBaseUnit, m_skipLiquid));
+
+        hash.Finalize();
+        return ByteArrayToHexStr(hash.GetDigest());
+    }
+
+    bool MapBuilder::isTileUpToDate(uint32 mapID, uint32 tileX, uint32 tileY, std::string const& inputHash, bool hasTile) const
+    {
+        // a tile deleted to force rebuilding it is not up to date
+        std::lock_guard<std::mutex> lock(m_manifestLock);
+        auto itr = m_manifest.find({ mapID, tileX, tileY });
+        return itr != m_manifest.end() && itr->second.InputHash == inputHash && itr->second.HasTile == hasTile;
+    }
+
+    void MapBuilder::updateManifest(uint32 mapID, uint32 tileX, uint32 tileY, std::string const& inputHash, bool hasTile)
+    {
+        std::lock_guard<std::mutex> lock(m_manifestLock);
+        TileManifestEntry& entry = m_manifest[{ mapID, tileX, tileY }];
+        entry.InputHash = inputHash;
+        entry.HasTile = hasTile;
+    }
+
+    void MapBuilder::loadManifests()
+    {
+        // the merged manifest first, manifests of shards are newer
+        std::vector<std::string> files;
+        files.push_back("manifest.txt");
+        getDirContents(files, "mmaps", "manifest_*.txt");
+
+        for (std::string const& fileName : files)
+        {
+            auto file = Trinity::make_unique_ptr_with_deleter(fopen(("mmaps/" + fileName).c_str(), "r"), &::fclose);
+            if (!file)
+                continue;
+
+            char buf[128] = { };
+            while (fgets(buf, sizeof(buf), file.get()))
+            {
+                uint32 mapID, tileX, tileY, hasTile;
+                char inputHash[64] = { };
+                if (sscanf(buf, "%u %u %u %63s %u", &mapID, &tileX, &tileY, inputHash, &hasTile) != 5)
+                    continue;
+
+                TileManifestEntry& entry = m_manifest[{ mapID, tileX, tileY }];
+                entry.InputHash = inputHash;
+                entry.HasTile = hasTile != 0;
+            }
+        }
+    }
+
+    void MapBuilder::saveManifest() const
+    {
+        std::string fileName = m_shardCount > 1 ? Trinity::StringFormat("mmaps/manifest_{}_{}.txt", m_shardIndex, m_shardCount) : "mmaps/manifest.txt";
+        auto file = Trinity::make_unique_ptr_with_deleter(fopen(fileName.c_str(), "w"), &::fclose);
+        if (!file)
+        {
+            perror(Trinity::StringFormat("Failed to open {} for writing!\n", fileName).c_str());
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_manifestLock);
+        for (std::pair<std::tuple<uint32, uint32, uint32> const, TileManifestEntry> const& entry : m_manifest)
+        {
+            auto [mapID, tileX, tileY] = entry.first;
+            if (m_shardCount > 1 && !isTileInShard(mapID, tileX, tileY))
+                continue;
+
+            fprintf(file.get(), "%u %u %u %s %u\n", mapID, tileX, tileY, entry.second.InputHash.c_str(), entry.second.HasTile ? 1 : 0);
+        }
+
+        file.reset();
+
+        // the merged manifest replaces all manifests of shards
+        if (m_shardCount == 1)
+        {
+            std::vector<std::string> files;
+            getDirContents(files, "mmaps", "manifest_*.txt");
+            for (std::string const& shardFileName : files)
+                boost::filesystem::remove(boost::filesystem::path("mmaps") / shardFileName);
+        }
+    }
+
+    void MapBuilder::mergeManifests()
+    {
+        printf("Merging %u tile manifests\n", uint32(m_manifest.size()));
+        saveManifest();
     }
 
     /**************************************************************************/
@@ -455,6 +608,8 @@ namespace MMAP
         _cancelationToken = true;
 
         _queue.Cancel();
+
+        saveManifest();
     }
 
     /**************************************************************************/
@@ -498,7 +653,14 @@ namespace MMAP
     /**************************************************************************/
     void TileBuilder::buildTile(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
     {
-        if(shouldSkipTile(mapID, tileX, tileY))
+        if (!m_mapBuilder->isTileInShard(mapID, tileX, tileY))
+        {
+            ++m_mapBuilder->m_totalTilesProcessed;
+            return;
+        }
+
+        std::string inputHash = m_mapBuilder->getTileInputHash(mapID, tileX, tileY);
+        if (m_mapBuilder->isTileUpToDate(mapID, tileX, tileY, inputHash, shouldSkipTile(mapID, tileX, tileY)))
         {
             ++m_mapBuilder->m_totalTilesProcessed;
             return;
@@ -506,6 +668,15 @@ namespace MMAP
 
         printf("%u%% [Map %04i] Building tile [%02u,%02u]\n", m_mapBuilder->currentPercentageDone(), mapID, tileX, tileY);
 
+        buildTileFromInputs(mapID, tileX, tileY, navMesh);
+
+        m_mapBuilder->updateManifest(mapID, tileX, tileY, inputHash, shouldSkipTile(mapID, tileX, tileY));
+
+        ++m_mapBuilder->m_totalTilesProcessed;
+    }
+
+    void TileBuilder::buildTileFromInputs(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh)
+    {
         MeshData meshData;
 
         // get heightmap data
@@ -516,10 +687,7 @@ namespace MMAP
 
         // if there is no data, give up now
         if (!meshData.solidVerts.size() && !meshData.liquidVerts.size())
-        {
-            ++m_mapBuilder->m_totalTilesProcessed;
             return;
-        }
 
         // remove unused vertices
         TerrainBuilder::cleanVertices(meshData.solidVerts, meshData.solidTris);
@@ -531,10 +699,7 @@ namespace MMAP
         allVerts.append(meshData.solidVerts);
 
         if (!allVerts.size())
-        {
-            ++m_mapBuilder->m_totalTilesProcessed;
             return;
-        }
 
         // get bounds of current tile
         float bmin[3], bmax[3];
@@ -544,8 +709,6 @@ namespace MMAP
 
         // build navmesh tile
         buildMoveMapTile(mapID, tileX, tileY, meshData, bmin, bmax, navMesh);
-
-        ++m_mapBuilder->m_totalTilesProcessed;
     }
 
     /**************************************************************************/
@@ -21,8 +21,11 @@
 #include <vector>
 #include <set>
 #include <list>
+#include <map>
 #include <atomic>
+#include <mutex>
 #include <thread>
+#include <tuple>
 
 #include "TerrainBuilder.h"
 
@@ -102,6 +105,15 @@ namespace MMAP
         dtNavMeshParams m_navMeshParams;
     };
 
+    // inputs a tile was last built from, tiles whose inputs did not change are not rebuilt
+    struct TileManifestEntry
+    {
+        std::string InputHash;
+        bool HasTile = false;       // tiles without terrain or models don't produce a file
+    };
+
+    typedef std::map<std::tuple<uint32, uint32, uint32>, TileManifestEntry> TileManifest;
+
     // ToDo: move this to its own file. For now it will stay here to keep the changes to a minimum, especially in the cpp file
     class MapBuilder;
     class TileBuilder
@@ -131,6 +143,8 @@ namespace MMAP
             bool shouldSkipTile(uint32 mapID, uint32 tileX, uint32 tileY) const;
 
         private:
+            void buildTileFromInputs(uint32 mapID, uint32 tileX, uint32 tileY, dtNavMesh* navMesh);
+
             bool m_bigBaseUnit;
             bool m_debugOutput;
 
@@ -156,7 +170,9 @@ namespace MMAP
                 bool bigBaseUnit,
                 int mapid,
                 char const* offMeshFilePath,
-                unsigned int threads);
+                unsigned int threads,
+                uint32 shardIndex = 0,
+                uint32 shardCount = 1);
 
             ~MapBuilder();
 
@@ -168,6 +184,9 @@ namespace MMAP
             // builds list of maps, then builds all of mmap tiles (based on the skip settings)
             void buildMaps(Optional<uint32> mapID);
 
+            // combines the manifests written by sharded builds into mmaps/manifest.txt
+            void mergeManifests();
+
         private:
             // builds all mmap tiles for the specified map id (ignores skip settings)
             void buildMap(uint32 mapID);
@@ -195,6 +214,13 @@ namespace MMAP
 
             void ParseOffMeshConnectionsFile(char const* offMeshFilePath);
 
+            bool isTileInShard(uint32 mapID, uint32 tileX, uint32 tileY) const;
+            std::string getTileInputHash(uint32 mapID, uint32 tileX, uint32 tileY) const;
+            bool isTileUpToDate(uint32 mapID, uint32 tileX, uint32 tileY, std::string const& inputHash, bool hasTile) const;
+            void updateManifest(uint32 mapID, uint32 tileX, uint32 tileY, std::string const& inputHash, bool hasTile);
+            void loadManifests();
+            void saveManifest() const;
+
             TerrainBuilder* m_terrainBuilder;
             TileList m_tiles;
 
@@ -213,6 +239,13 @@ namespace MMAP
 
             int32 m_mapid;
 
+            // tiles are spread over several build machines by --shard, each builds the tiles with index % count == shard
+            uint32 m_shardIndex;
+            uint32 m_shardCount;
+
+            TileManifest m_manifest;
+            mutable std::mutex m_manifestLock;
+
             std::atomic<uint32> m_totalTiles;
             std::atomic<uint32> m_totalTilesProcessed;
 
@@ -133,7 +133,10 @@ bool handleArgs(int argc, char** argv,
                bool &bigBaseUnit,
                char* &offMeshInputPath,
                char* &file,
-               unsigned int& threads)
+               unsigned int& threads,
+               uint32& shardIndex,
+               uint32& shardCount,
+               bool& mergeManifests)
 {
     char* param = nullptr;
     [[maybe_unused]] bool allowDebug = false;
@@ -170,6 +173,22 @@ bool handleArgs(int argc, char** argv,
                 return false;
             threads = static_cast<unsigned int>(std::max(0, atoi(param)));
         }
+        else if (strcmp(argv[i], "--shard") == 0)
+        {
+            param = argv[++i];
+            if (!param)
+                return false;
+
+            if (sscanf(param, "%u/%u", &shardIndex, &shardCount) != 2 || !shardCount || shardIndex >= shardCount)
+            {
+                printf("invalid option for '--shard', expected index/count with index lower than count\n");
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--mergeManifests") == 0)
+        {
+            mergeManifests = true;
+        }
         else if (strcmp(argv[i], "--file") == 0)
         {
             param = argv[++i];
@@ -412,11 +431,14 @@ int main(int argc, char** argv)
          bigBaseUnit = false;
     char* offMeshInputPath = nullptr;
     char* file = nullptr;
+    uint32 shardIndex = 0, shardCount = 1;
+    bool mergeManifests = false;
 
     bool validParam = handleArgs(argc, argv, mapnum,
                                  tileX, tileY, maxAngle, maxAngleNotSteep,
                                  skipLiquid, skipContinents, skipJunkMaps, skipBattlegrounds,
-                                 debugOutput, silent, bigBaseUnit, offMeshInputPath, file, threads);
+                                 debugOutput, silent, bigBaseUnit, offMeshInputPath, file, threads,
+                                 shardIndex, shardCount, mergeManifests);
 
     if (!validParam)
         return silent ? -1 : finish("You have specified invalid parameters", -1);
@@ -442,10 +464,13 @@ int main(int argc, char** argv)
     _mapDataForVmapInitialization = LoadMap(dbcLocales[0], silent, -4);
 
     MapBuilder builder(maxAngle, maxAngleNotSteep, skipLiquid, skipContinents, skipJunkMaps,
-                       skipBattlegrounds, debugOutput, bigBaseUnit, mapnum, offMeshInputPath, threads);
+                       skipBattlegrounds, debugOutput, bigBaseUnit, mapnum, offMeshInputPath, threads,
+                       shardIndex, shardCount);
 
     uint32 start = getMSTime();
-    if (file)
+    if (mergeManifests)
+        builder.mergeManifests();
+    else if (file)
         builder.buildMeshFromFile(file);
     else if (tileX > -1 && tileY > -1 && mapnum >= 0)
         builder.buildSingleTile(mapnum, tileX, tileY);
@@ -19,6 +19,7 @@
 #include "BoundingIntervalHierarchy.h"
 #include "MapTree.h"
 #include "StringFormat.h"
+#include "ThreadPool.h"
 #include "VMapDefinitions.h"
 #include <boost/filesystem.hpp>
 #include <iomanip>
@@ -41,8 +42,8 @@ namespace VMAP
 
     //=================================================================
 
-    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName)
-        : iDestDir(pDestDirName), iSrcDir(pSrcDirName)
+    TileAssembler::TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, unsigned int threads)
+        : iDestDir(pDestDirName), iSrcDir(pSrcDirName), iThreads(std::max(1u, threads))
     {
         boost::filesystem::create_directories(iDestDir);
     }
@@ -57,123 +58,148 @@ namespace VMAP
         if (!success)
             return false;
 
-        float constexpr invTileSize = 1.0f / 533.33333f;
+        // every output file is written by a single task so the result does not depend on the number of threads
+        std::vector<std::set<std::string>> mapModelFiles(mapData.size());
+        std::unique_ptr<bool[]> mapResults = std::make_unique<bool[]>(mapData.size());
+        {
+            Trinity::ThreadPool pool(iThreads);
+            for (std::size_t i = 0; i < mapData.size(); ++i)
+                pool.PostWork([this, &mapModelFiles, &mapResults, i]() { mapResults[i] = convertMap(mapData[i], mapModelFiles[i]); });
+
+            pool.Join();
+        }
 
-        // export Map data
-        while (!mapData.empty())
+        for (std::size_t i = 0; i < mapData.size(); ++i)
         {
-            MapSpawns data = std::move(mapData.front());
-            mapData.pop_front();
-
-            // build global map tree
-            std::vector<ModelSpawn*> mapSpawns;
-            mapSpawns.reserve(data.UniqueEntries.size());
-            printf("Calculating model bounds for map %u...\n", data.MapId);
-            for (auto entry = data.UniqueEntries.begin(); entry != data.UniqueEntries.end(); ++entry)
-            {
-                // M2 models don't have a bound set in WDT/ADT placement data, they're not used for LoS but are needed for pathfinding
-                if (!(entry->second.flags & MOD_HAS_BOUND))
-                    if (!calculateTransformedBound(entry->second))
-                        continue;
-
-                mapSpawns.push_back(&entry->second);
-                spawnedModelFiles.insert(entry->second.name);
-
-                std::map<uint32, std::set<uint32>>& tileEntries = (entry->second.flags & MOD_PARENT_SPAWN) ? data.ParentTileEntries : data.TileEntries;
-
-                G3D::AABox const& bounds = entry->second.iBound;
-                G3D::Vector2int16 low(int16(bounds.low().x * invTileSize), int16(bounds.low().y * invTileSize));
-                G3D::Vector2int16 high(int16(bounds.high().x * invTileSize), int16(bounds.high().y * invTileSize));
-                for (int x = low.x; x <= high.x; ++x)
-                    for (int y = low.y; y <= high.y; ++y)
-                        tileEntries[StaticMapTree::packTileID(x, y)].insert(entry->second.ID);
-            }
+            success = success && mapResults[i];
+            spawnedModelFiles.insert(mapModelFiles[i].begin(), mapModelFiles[i].end());
+        }
 
-            printf("Creating map tree for map %u...\n", data.MapId);
-            BIH pTree;
+        mapData.clear();
 
-            try
-            {
-                pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
-            }
-            catch (std::exception& e)
-            {
-                printf("Exception ""%s"" when calling pTree.build", e.what());
-                return false;
-            }
+        // add an object models, listed in temp_gameobject_models file
+        exportGameobjectModels();
+        // export objects
+        std::cout << "\nConverting Model Files" << std::endl;
+        std::vector<std::string> modelFiles(spawnedModelFiles.begin(), spawnedModelFiles.end());
+        std::unique_ptr<bool[]> modelResults = std::make_unique<bool[]>(modelFiles.size());
+        {
+            Trinity::ThreadPool pool(iThreads);
+            for (std::size_t i = 0; i < modelFiles.size(); ++i)
+                pool.PostWork([this, &modelFiles, &modelResults, i]() { modelResults[i] = convertRawFile(modelFiles[i]); });
 
-            // ===> possibly move this code to StaticMapTree class
+            pool.Join();
+        }
 
-            // write map tree file
-            std::stringstream mapfilename;
-            mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(4) << data.MapId << ".vmtree";
-            FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
-            if (!mapfile)
+        for (std::size_t i = 0; i < modelFiles.size(); ++i)
+        {
+            if (!modelResults[i])
             {
+                std::cout << "error converting " << modelFiles[i] << std::endl;
                 success = false;
-                printf("Cannot open %s\n", mapfilename.str().c_str());
-                break;
             }
+        }
 
-            //general info
-            if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
-            // Nodes
-            if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
-            if (success) success = pTree.writeToFile(mapfile);
-
-            // spawn id to index map
-            uint32 mapSpawnsSize = mapSpawns.size();
-            if (success && fwrite("SIDX", 4, 1, mapfile) != 1) success = false;
-            if (success && fwrite(&mapSpawnsSize, sizeof(uint32), 1, mapfile) != 1) success = false;
-            for (uint32 i = 0; i < mapSpawnsSize; ++i)
-            {
-                if (success && fwrite(&mapSpawns[i]->ID, sizeof(uint32), 1, mapfile) != 1) success = false;
-            }
+        return success;
+    }
+
+    bool TileAssembler::convertMap(MapSpawns& data, std::set<std::string>& mapModelFiles) const
+    {
+        bool success = true;
+        float constexpr invTileSize = 1.0f / 533.33333f;
 
-            fclose(mapfile);
+        // build global map tree
+        std::vector<ModelSpawn*> mapSpawns;
+        mapSpawns.reserve(data.UniqueEntries.size());
+        printf("Calculating model bounds for map %u...\n", data.MapId);
+        for (auto entry = data.UniqueEntries.begin(); entry != data.UniqueEntries.end(); ++entry)
+        {
+            // M2 models don't have a bound set in WDT/ADT placement data, they're not used for LoS but are needed for pathfinding
+            if (!(entry->second.flags & MOD_HAS_BOUND))
+                if (!calculateTransformedBound(entry->second))
+                    continue;
+
+            mapSpawns.push_back(&entry->second);
+            mapModelFiles.insert(entry->second.name);
+
+            std::map<uint32, std::set<uint32>>& tileEntries = (entry->second.flags & MOD_PARENT_SPAWN) ? data.ParentTileEntries : data.TileEntries;
+
+            G3D::AABox const& bounds = entry->second.iBound;
+            G3D::Vector2int16 low(int16(bounds.low().x * invTileSize), int16(bounds.low().y * invTileSize));
+            G3D::Vector2int16 high(int16(bounds.high().x * invTileSize), int16(bounds.high().y * invTileSize));
+            for (int x = low.x; x <= high.x; ++x)
+                for (int y = low.y; y <= high.y; ++y)
+                    tileEntries[StaticMapTree::packTileID(x, y)].insert(entry->second.ID);
+        }
 
-            // <====
+        printf("Creating map tree for map %u...\n", data.MapId);
+        BIH pTree;
 
-            // write map tile files, similar to ADT files, only with extra BIH tree node info
-            for (auto tileItr = data.TileEntries.begin(); tileItr != data.TileEntries.end(); ++tileItr)
-            {
-                uint32 x, y;
-                StaticMapTree::unpackTileID(tileItr->first, x, y);
-                std::string tileFileName = Trinity::StringFormat("{}/{:04}_{:02}_{:02}.vmtile", iDestDir, data.MapId, y, x);
-                if (FILE* tileFile = fopen(tileFileName.c_str(), "wb"))
-                {
-                    std::set<uint32> const& parentTileEntries = data.ParentTileEntries[tileItr->first];
-
-                    uint32 nSpawns = tileItr->second.size() + parentTileEntries.size();
-
-                    // file header
-                    if (success && fwrite(VMAP_MAGIC, 1, 8, tileFile) != 8) success = false;
-                    // write number of tile spawns
-                    if (success && fwrite(&nSpawns, sizeof(uint32), 1, tileFile) != 1) success = false;
-                    // write tile spawns
-                    for (auto spawnItr = tileItr->second.begin(); spawnItr != tileItr->second.end() && success; ++spawnItr)
-                        success = ModelSpawn::writeToFile(tileFile, data.UniqueEntries[*spawnItr]);
-
-                    for (auto spawnItr = parentTileEntries.begin(); spawnItr != parentTileEntries.end() && success; ++spawnItr)
-                        success = ModelSpawn::writeToFile(tileFile, data.UniqueEntries[*spawnItr]);
-
-                    fclose(tileFile);
-                }
-            }
+        try
+        {
+            pTree.build(mapSpawns, BoundsTrait<ModelSpawn*>::getBounds);
+        }
+        catch (std::exception& e)
+        {
+            printf("Exception ""%s"" when calling pTree.build", e.what());
+            return false;
         }
 
-        // add an object models, listed in temp_gameobject_models file
-        exportGameobjectModels();
-        // export objects
-        std::cout << "\nConverting Model Files" << std::endl;
-        for (std::string const& spawnedModelFile : spawnedModelFiles)
+        // ===> possibly move this code to StaticMapTree class
+
+        // write map tree file
+        std::stringstream mapfilename;
+        mapfilename << iDestDir << '/' << std::setfill('0') << std::setw(4) << data.MapId << ".vmtree";
+        FILE* mapfile = fopen(mapfilename.str().c_str(), "wb");
+        if (!mapfile)
+        {
+            printf("Cannot open %s\n", mapfilename.str().c_str());
+            return false;
+        }
+
+        //general info
+        if (success && fwrite(VMAP_MAGIC, 1, 8, mapfile) != 8) success = false;
+        // Nodes
+        if (success && fwrite("NODE", 4, 1, mapfile) != 1) success = false;
+        if (success) success = pTree.writeToFile(mapfile);
+
+        // spawn id to index map
+        uint32 mapSpawnsSize = mapSpawns.size();
+        if (success && fwrite("SIDX", 4, 1, mapfile) != 1) success = false;
+        if (success && fwrite(&mapSpawnsSize, sizeof(uint32), 1, mapfile) != 1) success = false;
+        for (uint32 i = 0; i < mapSpawnsSize; ++i)
+        {
+            if (success && fwrite(&mapSpawns[i]->ID, sizeof(uint32), 1, mapfile) != 1) success = false;
+        }
+
+        fclose(mapfile);
+
+        // <====
+
+        // write map tile files, similar to ADT files, only with extra BIH tree node info
+        for (auto tileItr = data.TileEntries.begin(); tileItr != data.TileEntries.end(); ++tileItr)
         {
-            std::cout << "Converting " << spawnedModelFile << std::endl;
-            if (!convertRawFile(spawnedModelFile))
+            uint32 x, y;
+            StaticMapTree::unpackTileID(tileItr->first, x, y);
+            std::string tileFileName = Trinity::StringFormat("{}/{:04}_{:02}_{:02}.vmtile", iDestDir, data.MapId, y, x);
+            if (FILE* tileFile = fopen(tileFileName.c_str(), "wb"))
             {
-                std::cout << "error converting " << spawnedModelFile << std::endl;
-                success = false;
-                break;
+                std::set<uint32> const& parentTileEntries = data.ParentTileEntries[tileItr->first];
+
+                uint32 nSpawns = tileItr->second.size() + parentTileEntries.size();
+
+                // file header
+                if (success && fwrite(VMAP_MAGIC, 1, 8, tileFile) != 8) success = false;
+                // write number of tile spawns
+                if (success && fwrite(&nSpawns, sizeof(uint32), 1, tileFile) != 1) success = false;
+                // write tile spawns
+                for (auto spawnItr = tileItr->second.begin(); spawnItr != tileItr->second.end() && success; ++spawnItr)
+                    success = ModelSpawn::writeToFile(tileFile, data.UniqueEntries[*spawnItr]);
+
+                for (auto spawnItr = parentTileEntries.begin(); spawnItr != parentTileEntries.end() && success; ++spawnItr)
+                    success = ModelSpawn::writeToFile(tileFile, data.UniqueEntries[*spawnItr]);
+
+                fclose(tileFile);
             }
         }
 
@@ -223,7 +249,7 @@ namespace VMAP
         return success;
     }
 
-    bool TileAssembler::calculateTransformedBound(ModelSpawn &spawn)
+    bool TileAssembler::calculateTransformedBound(ModelSpawn &spawn) const
     {
         std::string modelFilename(iSrcDir);
         modelFilename.push_back('/');
@@ -262,7 +288,7 @@ namespace VMAP
     };
 #pragma pack(pop)
     //=================================================================
-    bool TileAssembler::convertRawFile(const std::string& pModelFilename)
+    bool TileAssembler::convertRawFile(const std::string& pModelFilename) const
     {
         bool success = true;
         std::string filename = iSrcDir;
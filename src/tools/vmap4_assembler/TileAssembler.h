@@ -95,19 +95,23 @@ namespace VMAP
         private:
             std::string iDestDir;
             std::string iSrcDir;
+            unsigned int iThreads;
             MapData mapData;
             std::set<std::string> spawnedModelFiles;
 
+            // writes the map tree and tile files of a single map, maps are independent and converted on all threads
+            bool convertMap(MapSpawns& data, std::set<std::string>& mapModelFiles) const;
+
         public:
-            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName);
+            TileAssembler(const std::string& pSrcDirName, const std::string& pDestDirName, unsigned int threads = 1);
             virtual ~TileAssembler();
 
             bool convertWorld2();
             bool readMapSpawns();
-            bool calculateTransformedBound(ModelSpawn &spawn);
+            bool calculateTransformedBound(ModelSpawn &spawn) const;
             void exportGameobjectModels();
 
-            bool convertRawFile(const std::string& pModelFilename);
+            bool convertRawFile(const std::string& pModelFilename) const;
     };
 
 }                                                           // VMAP
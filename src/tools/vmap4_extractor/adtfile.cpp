@@ -233,6 +233,56 @@ bool ADTFile::init(uint32 map_num, uint32 originalMapId)
     return true;
 }
 
+void ADTFile::GetReferencedModels(std::vector<std::pair<std::string, bool>>& models)
+{
+    uint32 size;
+    while (!_file.isEof())
+    {
+        char fourcc[5];
+        _file.read(&fourcc, 4);
+        _file.read(&size, 4);
+        flipcc(fourcc);
+        fourcc[4] = 0;
+
+        size_t nextpos = _file.getPos() + size;
+
+        if ((!strcmp(fourcc, "MMDX") || !strcmp(fourcc, "MWMO")) && size)
+        {
+            bool isWmo = !strcmp(fourcc, "MWMO");
+            std::unique_ptr<char[]> buf = std::make_unique<char[]>(size);
+            _file.read(buf.get(), size);
+            for (char* p = buf.get(); p < buf.get() + size; p += strlen(p) + 1)
+                models.emplace_back(p, isWmo);
+        }
+        else if (!strcmp(fourcc, "MDDF"))
+        {
+            uint32 doodadCount = size / sizeof(ADT::MDDF);
+            for (uint32 i = 0; i < doodadCount; ++i)
+            {
+                ADT::MDDF doodadDef;
+                _file.read(&doodadDef, sizeof(ADT::MDDF));
+                if (doodadDef.Flags & 0x40)
+                    models.emplace_back(Trinity::StringFormat("FILE{:08X}.xxx", doodadDef.Id), false);
+            }
+        }
+        else if (!strcmp(fourcc, "MODF"))
+        {
+            uint32 mapObjectCount = size / sizeof(ADT::MODF);
+            for (uint32 i = 0; i < mapObjectCount; ++i)
+            {
+                ADT::MODF mapObjDef;
+                _file.read(&mapObjDef, sizeof(ADT::MODF));
+                if (mapObjDef.Flags & 0x8)
+                    models.emplace_back(Trinity::StringFormat("FILE{:08X}.xxx", mapObjDef.Id), true);
+            }
+        }
+
+        _file.seek(nextpos);
+    }
+
+    _file.close();
+}
+
 bool ADTFile::initFromCache(uint32 map_num, uint32 originalMapId)
 {
     if (dirfileCache->empty())
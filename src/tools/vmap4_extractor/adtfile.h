@@ -70,6 +70,8 @@ public:
     std::vector<std::string> ModelInstanceNames;
     bool init(uint32 map_num, uint32 originalMapId);
     bool initFromCache(uint32 map_num, uint32 originalMapId);
+    // paths of the models (false) and wmos (true) in the order init extracts them
+    void GetReferencedModels(std::vector<std::pair<std::string, bool>>& models);
 };
 
 char const* GetPlainName(char const* FileName);
@@ -21,11 +21,13 @@
 #include "ExtractorDB2LoadInfo.h"
 #include "model.h"
 #include "StringFormat.h"
+#include "ThreadPool.h"
 #include "vmapexport.h"
 #include "VMapDefinitions.h"
 #include <CascLib.h>
 #include <algorithm>
 #include <cstdio>
+#include <vector>
 
 bool ExtractSingleModel(std::string& fname)
 {
@@ -48,14 +50,17 @@ bool ExtractSingleModel(std::string& fname)
     output += "/";
     output += name;
 
-    if (FileExists(output.c_str()))
-        return true;
+    return ExtractModelOnce(output, [&]()
+    {
+        if (FileExists(output.c_str()))
+            return true;
 
-    Model mdl(originalName);
-    if (!mdl.open())
-        return false;
+        Model mdl(originalName);
+        if (!mdl.open())
+            return false;
 
-    return mdl.ConvertToVMAPModel(output.c_str());
+        return mdl.ConvertToVMAPModel(output.c_str());
+    });
 }
 
 extern std::shared_ptr<CASC::Storage> CascStorage;
@@ -103,6 +108,15 @@ void ExtractGameobjectModels()
 
     fwrite(VMAP::RAW_VMAP_MAGIC, 1, 8, model_list);
 
+    struct GameObjectModel
+    {
+        uint32 DisplayId;
+        std::string FileName;
+        bool Extracted = false;
+    };
+
+    std::vector<GameObjectModel> models;
+    models.reserve(db2.GetRecordCount());
     for (uint32 rec = 0; rec < db2.GetRecordCount(); ++rec)
     {
         DB2Record record = db2.GetRecord(rec);
@@ -113,26 +127,38 @@ void ExtractGameobjectModels()
         if (!fileId)
             continue;
 
-        std::string fileName = Trinity::StringFormat("FILE{:08X}.xxx", fileId);
-        bool result = false;
-        uint32 header;
-        if (!GetHeaderMagic(fileName, &header))
-            continue;
+        models.push_back({ .DisplayId = record.GetId(), .FileName = Trinity::StringFormat("FILE{:08X}.xxx", fileId) });
+    }
 
-        if (!memcmp(&header, "REVM", 4))
-            result = ExtractSingleWmo(fileName);
-        else if (!memcmp(&header, "MD20", 4) || !memcmp(&header, "MD21", 4))
-            result = ExtractSingleModel(fileName);
-        else
-            ABORT_MSG("%s header: %d - %c%c%c%c", fileName.c_str(), header, (header >> 24) & 0xFF, (header >> 16) & 0xFF, (header >> 8) & 0xFF, header & 0xFF);
+    // models are converted on all threads, the list is written in record order afterwards
+    Trinity::ThreadPool pool(Threads);
+    for (GameObjectModel& model : models)
+    {
+        pool.PostWork([&model]()
+        {
+            uint32 header;
+            if (!GetHeaderMagic(model.FileName, &header))
+                return;
+
+            if (!memcmp(&header, "REVM", 4))
+                model.Extracted = ExtractSingleWmo(model.FileName);
+            else if (!memcmp(&header, "MD20", 4) || !memcmp(&header, "MD21", 4))
+                model.Extracted = ExtractSingleModel(model.FileName);
+            else
+                ABORT_MSG("%s header: %d - %c%c%c%c", model.FileName.c_str(), header, (header >> 24) & 0xFF, (header >> 16) & 0xFF, (header >> 8) & 0xFF, header & 0xFF);
+        });
+    }
 
-        if (result)
+    pool.Join();
+
+    for (GameObjectModel const& model : models)
+    {
+        if (model.Extracted)
         {
-            uint32 displayId = record.GetId();
-            uint32 path_length = fileName.length();
-            fwrite(&displayId, sizeof(uint32), 1, model_list);
+            uint32 path_length = model.FileName.length();
+            fwrite(&model.DisplayId, sizeof(uint32), 1, model_list);
             fwrite(&path_length, sizeof(uint32), 1, model_list);
-            fwrite(fileName.c_str(), sizeof(char), path_length, model_list);
+            fwrite(model.FileName.c_str(), sizeof(char), path_length, model_list);
         }
     }
 
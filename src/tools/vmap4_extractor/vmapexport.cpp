@@ -22,6 +22,7 @@
 #include "DB2CascFileSource.h"
 #include "ExtractorDB2LoadInfo.h"
 #include "StringFormat.h"
+#include "ThreadPool.h"
 #include "VMapDefinitions.h"
 #include "vmapexport.h"
 #include "Locales.h"
@@ -33,8 +34,10 @@
 #include <boost/filesystem/directory.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <fstream>
+#include <future>
 #include <list>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -69,6 +72,14 @@ char const* CascRegion = "eu";
 bool UseRemoteCasc = false;
 uint32 DbcLocale = 0;
 std::unordered_map<std::string, WMODoodadData> WmoDoodads;
+std::mutex WmoDoodadsLock;
+unsigned int Threads = std::max(1u, std::thread::hardware_concurrency());
+
+namespace
+{
+    std::mutex ExtractedModelsLock;
+    std::unordered_map<std::string, std::shared_future<bool>> ExtractedModels;
+}
 
 // Constants
 
@@ -186,15 +197,29 @@ bool FileExists(char const* file)
     return false;
 }
 
-bool ExtractSingleWmo(std::string& fname)
+bool ExtractModelOnce(std::string const& outputFileName, std::function<bool()> const& extract)
 {
-    // Copy files from archive
-    std::string originalName = fname;
+    std::promise<bool> result;
+    {
+        std::unique_lock<std::mutex> lock(ExtractedModelsLock);
+        auto itr = ExtractedModels.find(outputFileName);
+        if (itr != ExtractedModels.end())
+        {
+            std::shared_future<bool> extracted = itr->second;
+            lock.unlock();
+            return extracted.get();
+        }
 
-    char* plain_name = GetPlainName(&fname[0]);
-    NormalizeFileName(plain_name, strlen(plain_name));
-    std::string szLocalFile = Trinity::StringFormat("{}/{}", szWorkDirWmo, plain_name);
+        ExtractedModels.emplace(outputFileName, result.get_future().share());
+    }
+
+    bool extracted = extract();
+    result.set_value(extracted);
+    return extracted;
+}
 
+static bool ConvertWmo(std::string const& originalName, char const* plain_name, std::string const& szLocalFile)
+{
     if (FileExists(szLocalFile.c_str()))
         return true;
 
@@ -223,7 +248,7 @@ bool ExtractSingleWmo(std::string& fname)
         return false;
     }
     froot.ConvertToVMAPRootWmo(output);
-    WMODoodadData& doodads = WmoDoodads[plain_name];
+    WMODoodadData doodads;
     std::swap(doodads, froot.DoodadData);
     int Wmo_nVertices = 0;
     uint32 groupCount = 0;
@@ -276,9 +301,86 @@ bool ExtractSingleWmo(std::string& fname)
     // Delete the extracted file in the case of an error
     if (!file_ok)
         remove(szLocalFile.c_str());
+
+    std::lock_guard<std::mutex> lock(WmoDoodadsLock);
+    WmoDoodads[plain_name] = std::move(doodads);
     return true;
 }
 
+bool ExtractSingleWmo(std::string& fname)
+{
+    // Copy files from archive
+    std::string originalName = fname;
+
+    char* plain_name = GetPlainName(&fname[0]);
+    NormalizeFileName(plain_name, strlen(plain_name));
+    std::string szLocalFile = Trinity::StringFormat("{}/{}", szWorkDirWmo, plain_name);
+
+    return ExtractModelOnce(szLocalFile, [&]() { return ConvertWmo(originalName, plain_name, szLocalFile); });
+}
+
+// name of the file a model is extracted to, see ExtractSingleModel and ExtractSingleWmo
+static std::string GetExtractedModelFileName(std::string fname, bool isWmo)
+{
+    if (!isWmo && fname.length() >= 4)
+    {
+        std::string extension = fname.substr(fname.length() - 4, 4);
+        if (extension == ".mdx" || extension == ".MDX" || extension == ".mdl" || extension == ".MDL")
+        {
+            fname.erase(fname.length() - 2, 2);
+            fname.append("2");
+        }
+    }
+
+    char* plain_name = GetPlainName(&fname[0]);
+    NormalizeFileName(plain_name, strlen(plain_name));
+    return plain_name;
+}
+
+// converts the models used by the adts of a map on all threads before their spawns are written in order by ADTFile::init
+// models with the same file name are converted from the first path found, like a single threaded extraction would
+static void ExtractMapModels(WDTFile const& wdt)
+{
+    std::vector<std::vector<std::pair<std::string, bool>>> adtModels(64 * 64);
+    {
+        Trinity::ThreadPool pool(Threads);
+        for (int32 x = 0; x < 64; ++x)
+        {
+            for (int32 y = 0; y < 64; ++y)
+            {
+                pool.PostWork([&wdt, &models = adtModels[x * 64 + y], x, y]()
+                {
+                    if (std::unique_ptr<ADTFile> adt = wdt.OpenMap(x, y))
+                        adt->GetReferencedModels(models);
+                });
+            }
+        }
+
+        pool.Join();
+    }
+
+    std::unordered_set<std::string> fileNames;
+    Trinity::ThreadPool pool(Threads);
+    for (std::vector<std::pair<std::string, bool>>& models : adtModels)
+    {
+        for (std::pair<std::string, bool>& model : models)
+        {
+            if (!fileNames.insert(GetExtractedModelFileName(model.first, model.second)).second)
+                continue;
+
+            pool.PostWork([&model]()
+            {
+                if (model.second)
+                    ExtractSingleWmo(model.first);
+                else
+                    ExtractSingleModel(model.first);
+            });
+        }
+    }
+
+    pool.Join();
+}
+
 void ParsMapFiles()
 {
     std::unordered_map<uint32, WDTFile> wdts;
@@ -313,6 +415,7 @@ void ParsMapFiles()
         if (WDTFile* WDT = getWDT(mapEntry.Id))
         {
             WDTFile* parentWDT = mapEntry.ParentMapID >= 0 ? getWDT(mapEntry.ParentMapID) : nullptr;
+            ExtractMapModels(*WDT);
             printf("Processing Map %u\n[", mapEntry.Id);
             for (int32 x = 0; x < 64; ++x)
             {
@@ -383,6 +486,13 @@ bool processArgv(int argc, char ** argv, const char *versionString)
         {
             UseRemoteCasc = true;
         }
+        else if (strcmp("-t", argv[i]) == 0)
+        {
+            if (i + 1 < argc && atoi(argv[i + 1]) > 0)
+                Threads = uint32(atoi(argv[++i]));
+            else
+                result = false;
+        }
         else if (strcmp("-r", argv[i]) == 0)
         {
             if (i + 1 < argc && strlen(argv[i + 1]))
@@ -412,13 +522,14 @@ bool processArgv(int argc, char ** argv, const char *versionString)
     if (!result)
     {
         printf("Extract %s.\n",versionString);
-        printf("%s [-?][-s][-l][-d <path>][-p <product>]\n", argv[0]);
+        printf("%s [-?][-s][-l][-d <path>][-p <product>][-t <threads>]\n", argv[0]);
         printf("   -s  : (default) small size (data size optimization), ~500MB less vmap data.\n");
         printf("   -l  : large size, ~500MB more vmap data. (might contain more details)\n");
         printf("   -d  <path>: Path to the vector data source folder.\n");
         printf("   -p  <product>: which installed product to open (wow/wowt/wow_beta)\n");
         printf("   -c  use remote casc\n");
         printf("   -r  set remote casc region - standard: eu\n");
+        printf("   -t  <threads>: number of threads converting models, the output does not depend on it - standard: all cores\n");
         printf("   -dl dbc locale\n");
         printf("   -? : This message.\n");
     }
@@ -19,6 +19,7 @@
 #define VMAPEXPORT_H
 
 #include "Define.h"
+#include <functional>
 #include <string>
 #include <unordered_map>
 
@@ -40,11 +41,15 @@ struct WMODoodadData;
 
 extern const char * szWorkDirWmo;
 extern std::unordered_map<std::string, WMODoodadData> WmoDoodads;
+extern unsigned int Threads;
 
 uint32 GenerateUniqueObjectId(uint32 clientId, uint16 clientDoodadId, bool isWmo);
 
 bool FileExists(const char * file);
 
+// converts each output file only once when several threads extract the same model, the others wait for its result
+bool ExtractModelOnce(std::string const& outputFileName, std::function<bool()> const& extract);
+
 bool ExtractSingleWmo(std::string& fname);
 bool ExtractSingleModel(std::string& fname);
 
@@ -146,20 +146,31 @@ ADTFile* WDTFile::GetMap(int32 x, int32 y)
     if (_adtCache && _adtCache->file[x][y])
         return _adtCache->file[x][y].get();
 
+    ADTFile* adt = CreateADT(x, y, _adtCache != nullptr);
+    if (adt && _adtCache)
+        _adtCache->file[x][y].reset(adt);
+
+    return adt;
+}
+
+std::unique_ptr<ADTFile> WDTFile::OpenMap(int32 x, int32 y) const
+{
+    if (!(x >= 0 && y >= 0 && x < 64 && y < 64))
+        return nullptr;
+
+    return std::unique_ptr<ADTFile>(CreateADT(x, y, false));
+}
+
+ADTFile* WDTFile::CreateADT(int32 x, int32 y, bool cache) const
+{
     if (!(_adtInfo.Data[y][x].Flag & 1))
         return nullptr;
 
-    ADTFile* adt;
     std::string name = Trinity::StringFormat(R"(World\Maps\{}\{}_{}_{}_obj0.adt)", _mapName, _mapName, x, y);
     if (_header.Flags & 0x200)
-        adt = new ADTFile(_adtFileDataIds->Data[y][x].Obj0ADT, name, _adtCache != nullptr);
-    else
-        adt = new ADTFile(name, _adtCache != nullptr);
+        return new ADTFile(_adtFileDataIds->Data[y][x].Obj0ADT, name, cache);
 
-    if (_adtCache)
-        _adtCache->file[x][y].reset(adt);
-
-    return adt;
+    return new ADTFile(name, cache);
 }
 
 void WDTFile::FreeADT(ADTFile* adt)
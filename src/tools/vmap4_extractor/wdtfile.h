@@ -76,7 +76,11 @@ public:
 
     ADTFile* GetMap(int32 x, int32 y);
     void FreeADT(ADTFile* adt);
+    // opens a new uncached adt, can be called from several threads at once after init
+    std::unique_ptr<ADTFile> OpenMap(int32 x, int32 y) const;
 private:
+    ADTFile* CreateADT(int32 x, int32 y, bool cache) const;
+
     CASCFile _file;
     WDT::MPHD _header;
     WDT::MAIN _adtInfo;
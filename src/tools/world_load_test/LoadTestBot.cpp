@@ -0,0 +1,665 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoadTestBot.h"
+#include "CryptoHash.h"
+#include "CryptoRandom.h"
+#include "HMAC.h"
+#include "LoadTestConfig.h"
+#include "LoadTestConnection.h"
+#include "Log.h"
+#include "MovementPackets.h"
+#include "Random.h"
+#include "SessionKeyGenerator.h"
+#include "Spell.h"
+#include "Timer.h"
+#include "UnitDefines.h"
+#include "WorldPacket.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+// seeds of the realm join handshake, see WorldSocket.cpp
+uint8 const AuthCheckSeed[16] = { 0xC5, 0xC6, 0x98, 0x95, 0x76, 0x3F, 0x1D, 0xCD, 0xB6, 0xA1, 0x37, 0x28, 0xB3, 0x12, 0xFF, 0x8A };
+uint8 const SessionKeySeed[16] = { 0x58, 0xCB, 0xCF, 0x40, 0xFE, 0x2E, 0xCE, 0xA6, 0x5A, 0x90, 0xB8, 0x01, 0x68, 0x6C, 0x28, 0x0B };
+uint8 const ContinuedSessionSeed[16] = { 0x16, 0xAD, 0x0C, 0xD4, 0x46, 0xF9, 0x4F, 0xB2, 0xEF, 0x7D, 0xEA, 0x2A, 0x17, 0x66, 0x4D, 0x2F };
+uint8 const EncryptionKeySeed[16] = { 0xE9, 0x75, 0x3C, 0x50, 0x90, 0x93, 0x61, 0xDA, 0x3B, 0x07, 0xEE, 0xFA, 0xFF, 0x9D, 0x41, 0xB8 };
+
+constexpr std::size_t DigestSize = 24;
+constexpr std::size_t ConnectToSignatureSize = 256;
+constexpr std::size_t EnterEncryptedModeSignatureSize = 64;
+
+constexpr float RunSpeed = 7.0f;
+constexpr float WanderRadius = 30.0f;
+constexpr float FarClip = 100.0f;
+
+enum ConnectToAddressType : uint8
+{
+    IPv4        = 1,
+    IPv6        = 2,
+    NamedSocket = 3
+};
+}
+
+LoadTest::Bot::Bot(Config const& config, Statistics& statistics, boost::asio::io_context& ioContext, uint32 index, TimePoint startTime) :
+    _config(config), _statistics(statistics), _ioContext(ioContext), _index(index), _accountName(GetAccountName(config, index)), _state(State::Waiting),
+    _startTime(startTime), _sessionKey(), _instanceConnectKey(0), _mapId(0), _homeX(0.0f), _homeY(0.0f), _positionX(0.0f), _positionY(0.0f),
+    _positionZ(0.0f), _orientation(0.0f), _moving(false), _pingSerial(0), _castCounter(0), _nextMove(TimePoint::max()), _nextPing(TimePoint::max()),
+    _nextChat(TimePoint::max()), _nextCast(TimePoint::max()), _nextLfgJoin(TimePoint::max())
+{
+}
+
+LoadTest::Bot::~Bot()
+{
+    Stop();
+}
+
+std::string LoadTest::Bot::GetAccountName(Config const& config, uint32 index)
+{
+    return Trinity::StringFormat("{}#1", config.FirstBattlenetAccountId + index);
+}
+
+std::array<uint8, 64> LoadTest::Bot::GetSessionKeyData(Config const& config, std::string const& accountName)
+{
+    std::array<uint8, 64> keyData;
+    for (std::size_t half = 0; half < 2; ++half)
+    {
+        Trinity::Crypto::HMAC_SHA256 hmac(reinterpret_cast<uint8 const*>(config.SessionKeySecret.data()), config.SessionKeySecret.size());
+        hmac.UpdateData(accountName);
+        hmac.UpdateData(half ? "b" : "a");
+        hmac.Finalize();
+        memcpy(keyData.data() + half * Trinity::Crypto::HMAC_SHA256::DIGEST_LENGTH, hmac.GetDigest().data(), Trinity::Crypto::HMAC_SHA256::DIGEST_LENGTH);
+    }
+
+    return keyData;
+}
+
+void LoadTest::Bot::Update(TimePoint now)
+{
+    if (_state == State::Waiting)
+    {
+        if (now < _startTime)
+            return;
+
+        _state = State::Authenticating;
+        StartRequest(Action::Login, now);
+        Connect(CONNECTION_TYPE_REALM, _config.Address, _config.Port);
+    }
+
+    if (_state == State::Offline)
+        return;
+
+    for (ConnectionData& connection : _connections)
+        if (connection.Socket)
+            connection.Socket->Update();
+
+    if (_state == State::InWorld)
+        UpdateActions(now);
+
+    CheckRequestTimeouts(now);
+}
+
+void LoadTest::Bot::Stop()
+{
+    _state = State::Offline;
+    for (ConnectionData& connection : _connections)
+        if (connection.Socket)
+            connection.Socket->CloseSocket();
+}
+
+void LoadTest::Bot::Connect(ConnectionType type, boost::asio::ip::address const& address, uint16 port)
+{
+    std::shared_ptr<boost::asio::ip::tcp::socket> socket = std::make_shared<boost::asio::ip::tcp::socket>(_ioContext);
+    socket->async_connect(boost::asio::ip::tcp::endpoint(address, port), [bot = weak_from_this(), type, socket](boost::system::error_code const& error)
+    {
+        if (std::shared_ptr<Bot> self = bot.lock())
+            self->HandleConnected(type, std::move(*socket), error);
+    });
+}
+
+void LoadTest::Bot::HandleConnected(ConnectionType type, boost::asio::ip::tcp::socket&& socket, boost::system::error_code const& error)
+{
+    if (_state == State::Offline)
+        return;
+
+    if (error)
+    {
+        Fail(Trinity::StringFormat("connecting {} connection failed: {}", type == CONNECTION_TYPE_REALM ? "realm" : "instance", error.message()));
+        return;
+    }
+
+    ConnectionData& connection = _connections[type];
+    connection.Socket = std::make_shared<Connection>(std::move(socket), weak_from_this(), type);
+    connection.Socket->Start();
+}
+
+void LoadTest::Bot::Fail(std::string_view reason)
+{
+    if (_state == State::Offline)
+        return;
+
+    TC_LOG_DEBUG("loadtest", "Bot {} ({}) went offline: {}", _index, _accountName, reason);
+    if (_state == State::InWorld)
+        _statistics.AddDisconnect();
+    else
+        _statistics.AddLoginFailure();
+
+    Stop();
+}
+
+void LoadTest::Bot::OnConnectionClosed(ConnectionType type)
+{
+    Fail(type == CONNECTION_TYPE_REALM ? "realm connection closed" : "instance connection closed");
+}
+
+void LoadTest::Bot::SendPacket(WorldPacket const& packet)
+{
+    // everything but pings goes to the instance connection once there is one, like the client does
+    SendPacket(_connections[CONNECTION_TYPE_INSTANCE].Socket ? CONNECTION_TYPE_INSTANCE : CONNECTION_TYPE_REALM, packet);
+}
+
+void LoadTest::Bot::SendPacket(ConnectionType type, WorldPacket const& packet)
+{
+    std::shared_ptr<Connection> const& socket = _connections[type].Socket;
+    if (!socket || !socket->IsOpen())
+        return;
+
+    socket->SendPacket(packet);
+    _statistics.AddPacketSent();
+}
+
+void LoadTest::Bot::HandlePacket(Connection& connection, uint16 opcode, ByteBuffer& packet)
+{
+    _statistics.AddPacketReceived();
+
+    ConnectionType type = connection.GetConnectionType();
+    switch (opcode)
+    {
+        case SMSG_AUTH_CHALLENGE:
+            HandleAuthChallenge(type, packet);
+            break;
+        case SMSG_ENTER_ENCRYPTED_MODE:
+            HandleEnterEncryptedMode(type, packet);
+            break;
+        case SMSG_AUTH_RESPONSE:
+            HandleAuthResponse(packet);
+            break;
+        case SMSG_ENUM_CHARACTERS_RESULT:
+            HandleEnumCharactersResult(packet);
+            break;
+        case SMSG_CONNECT_TO:
+            HandleConnectTo(packet);
+            break;
+        case SMSG_CHARACTER_LOGIN_FAILED:
+            Fail(Trinity::StringFormat("character login failed with code {}", packet.read<uint8>()));
+            break;
+        case SMSG_LOGIN_VERIFY_WORLD:
+            HandleLoginVerifyWorld(packet);
+            break;
+        case SMSG_TIME_SYNC_REQUEST:
+            HandleTimeSyncRequest(packet);
+            break;
+        case SMSG_PONG:
+            if (packet.read<uint32>() == _pingSerial)
+                CompleteRequest(Action::Ping);
+            break;
+        case SMSG_CHAT:
+        {
+            packet.read_skip<uint8>();      // SlashCmd
+            packet.read_skip<uint32>();     // Language
+            ObjectGuid sender;
+            packet >> sender;
+            if (sender == _playerGuid)
+                CompleteRequest(Action::Chat);
+            break;
+        }
+        case SMSG_SPELL_START:
+        case SMSG_SPELL_GO:
+        {
+            ObjectGuid caster;
+            packet >> caster;
+            if (caster == _playerGuid)
+                CompleteRequest(Action::Cast);
+            break;
+        }
+        case SMSG_CAST_FAILED:
+        {
+            // CastID is generated by the server, not the one we sent
+            ObjectGuid castId;
+            packet >> castId;
+            if (packet.read<int32>() == int32(_config.CastSpellId))
+                CompleteRequest(Action::Cast);
+            break;
+        }
+        case SMSG_LFG_UPDATE_STATUS:
+        case SMSG_LFG_JOIN_RESULT:
+            CompleteRequest(Action::LfgJoin);
+            break;
+        default:
+            break;
+    }
+}
+
+void LoadTest::Bot::HandleAuthChallenge(ConnectionType type, ByteBuffer& packet)
+{
+    ConnectionData& connection = _connections[type];
+    packet.read_skip(32);   // DosChallenge
+    packet.read(connection.ServerChallenge.data(), connection.ServerChallenge.size());
+    Trinity::Crypto::GetRandomBytes(connection.LocalChallenge);
+
+    if (type == CONNECTION_TYPE_REALM)
+    {
+        std::array<uint8, 64> keyData = GetSessionKeyData(_config, _accountName);
+
+        Trinity::Crypto::SHA256 digestKeyHash;
+        digestKeyHash.UpdateData(keyData.data(), keyData.size());
+        digestKeyHash.UpdateData(_config.AuthSeed.data(), _config.AuthSeed.size());
+        digestKeyHash.Finalize();
+
+        Trinity::Crypto::HMAC_SHA256 hmac(digestKeyHash.GetDigest());
+        hmac.UpdateData(connection.LocalChallenge);
+        hmac.UpdateData(connection.ServerChallenge);
+        hmac.UpdateData(AuthCheckSeed, 16);
+        hmac.Finalize();
+
+        Trinity::Crypto::SHA256 keyDataHash;
+        keyDataHash.UpdateData(keyData.data(), keyData.size());
+        keyDataHash.Finalize();
+
+        Trinity::Crypto::HMAC_SHA256 sessionKeyHmac(keyDataHash.GetDigest());
+        sessionKeyHmac.UpdateData(connection.ServerChallenge);
+        sessionKeyHmac.UpdateData(connection.LocalChallenge);
+        sessionKeyHmac.UpdateData(SessionKeySeed, 16);
+        sessionKeyHmac.Finalize();
+
+        SessionKeyGenerator<Trinity::Crypto::SHA256> sessionKeyGenerator(sessionKeyHmac.GetDigest());
+        sessionKeyGenerator.Generate(_sessionKey.data(), _sessionKey.size());
+
+        WorldPacket authSession(CMSG_AUTH_SESSION, 8 + 4 + 4 + 4 + 16 + DigestSize + 1 + 4 + _accountName.length());
+        authSession << uint64(0);   // DosResponse
+        authSession << uint32(_config.RegionId);
+        authSession << uint32(_config.BattlegroupId);
+        authSession << uint32(_config.RealmId);
+        authSession.append(connection.LocalChallenge.data(), connection.LocalChallenge.size());
+        authSession.append(hmac.GetDigest().data(), DigestSize);
+        authSession.WriteBit(false);    // UseIPv6
+        authSession << uint32(_accountName.length());
+        authSession.append(reinterpret_cast<uint8 const*>(_accountName.data()), _accountName.length());
+        SendPacket(type, authSession);
+    }
+    else
+    {
+        Trinity::Crypto::HMAC_SHA256 hmac(_sessionKey);
+        hmac.UpdateData(reinterpret_cast<uint8 const*>(&_instanceConnectKey), sizeof(_instanceConnectKey));
+        hmac.UpdateData(connection.LocalChallenge);
+        hmac.UpdateData(connection.ServerChallenge);
+        hmac.UpdateData(ContinuedSessionSeed, 16);
+        hmac.Finalize();
+
+        WorldPacket authContinuedSession(CMSG_AUTH_CONTINUED_SESSION, 8 + 8 + 16 + DigestSize);
+        authContinuedSession << uint64(0);  // DosResponse
+        authContinuedSession << uint64(_instanceConnectKey);
+        authContinuedSession.append(connection.LocalChallenge.data(), connection.LocalChallenge.size());
+        authContinuedSession.append(hmac.GetDigest().data(), DigestSize);
+        SendPacket(type, authContinuedSession);
+    }
+}
+
+void LoadTest::Bot::HandleEnterEncryptedMode(ConnectionType type, ByteBuffer& packet)
+{
+    // the signature is not verified, the bot trusts the server it was pointed at
+    packet.read_skip(EnterEncryptedModeSignatureSize);
+    if (!packet.ReadBit())
+        return;
+
+    ConnectionData& connection = _connections[type];
+    Trinity::Crypto::HMAC_SHA256 encryptKeyGen(_sessionKey);
+    encryptKeyGen.UpdateData(connection.LocalChallenge);
+    encryptKeyGen.UpdateData(connection.ServerChallenge);
+    encryptKeyGen.UpdateData(EncryptionKeySeed, 16);
+    encryptKeyGen.Finalize();
+
+    // only first 16 bytes of the hmac are used
+    Trinity::Crypto::AES::Key encryptKey;
+    memcpy(encryptKey.data(), encryptKeyGen.GetDigest().data(), encryptKey.size());
+
+    SendPacket(type, WorldPacket(CMSG_ENTER_ENCRYPTED_MODE_ACK, 0));
+    connection.Socket->InitEncryption(encryptKey);
+}
+
+void LoadTest::Bot::HandleAuthResponse(ByteBuffer& packet)
+{
+    uint32 result = packet.read<uint32>();
+    if (result != 0)
+    {
+        Fail(Trinity::StringFormat("authentication failed with result {}", result));
+        return;
+    }
+
+    bool hasSuccessInfo = packet.ReadBit();
+    if (!hasSuccessInfo || _state != State::Authenticating)
+        return;     // still in the login queue
+
+    _state = State::SelectingCharacter;
+    SendPacket(CONNECTION_TYPE_REALM, WorldPacket(CMSG_ENUM_CHARACTERS, 0));
+}
+
+void LoadTest::Bot::HandleEnumCharactersResult(ByteBuffer& packet)
+{
+    if (_state != State::SelectingCharacter)
+        return;
+
+    packet.ReadBits(6);
+    bool hasDisabledClassesMask = packet.ReadBit();
+    uint32 characterCount = packet.read<uint32>();
+    packet.read_skip<int32>();      // MaxCharacterLevel
+    packet.read_skip<uint32>();     // RaceUnlockData
+    uint32 unlockedConditionalAppearanceCount = packet.read<uint32>();
+    uint32 raceLimitDisableCount = packet.read<uint32>();
+    if (hasDisabledClassesMask)
+        packet.read_skip<uint32>();
+
+    if (!characterCount)
+    {
+        Fail("account has no characters");
+        return;
+    }
+
+    packet.read_skip((unlockedConditionalAppearanceCount + raceLimitDisableCount) * 8);
+    packet >> _playerGuid;
+
+    _state = State::LoggingIn;
+
+    WorldPacket playerLogin(CMSG_PLAYER_LOGIN, 18 + 4);
+    playerLogin << _playerGuid;
+    playerLogin << float(FarClip);
+    SendPacket(CONNECTION_TYPE_REALM, playerLogin);
+}
+
+void LoadTest::Bot::HandleConnectTo(ByteBuffer& packet)
+{
+    packet.read_skip(ConnectToSignatureSize);
+
+    boost::asio::ip::address address;
+    switch (packet.read<uint8>())
+    {
+        case IPv4:
+        {
+            boost::asio::ip::address_v4::bytes_type bytes;
+            packet.read(bytes.data(), bytes.size());
+            address = boost::asio::ip::address_v4(bytes);
+            break;
+        }
+        case IPv6:
+        {
+            boost::asio::ip::address_v6::bytes_type bytes;
+            packet.read(bytes.data(), bytes.size());
+            address = boost::asio::ip::address_v6(bytes);
+            break;
+        }
+        default:
+            Fail("SMSG_CONNECT_TO with unsupported address type");
+            return;
+    }
+
+    uint16 port = packet.read<uint16>();
+    packet.read_skip<uint32>();     // Serial
+    packet.read_skip<uint8>();      // Con
+    packet >> _instanceConnectKey;
+
+    // servers without InstanceServerAddress configured send an unusable address
+    if (address.is_unspecified())
+        address = _config.Address;
+
+    Connect(CONNECTION_TYPE_INSTANCE, address, port);
+}
+
+void LoadTest::Bot::HandleLoginVerifyWorld(ByteBuffer& packet)
+{
+    if (_state != State::LoggingIn)
+        return;
+
+    _mapId = uint32(packet.read<int32>());
+    packet >> _positionX >> _positionY >> _positionZ >> _orientation;
+    _homeX = _positionX;
+    _homeY = _positionY;
+
+    _state = State::InWorld;
+    CompleteRequest(Action::Login);
+
+    TimePoint now = std::chrono::steady_clock::now();
+    _lastMove = now;
+    _nextMove = GetNextActionTime(now, _config.MoveInterval, true);
+    _nextPing = GetNextActionTime(now, _config.PingInterval, true);
+    _nextChat = GetNextActionTime(now, _config.ChatInterval, true);
+    _nextCast = _config.CastSpellId ? GetNextActionTime(now, _config.CastInterval, true) : TimePoint::max();
+    _nextLfgJoin = GetNextActionTime(now, _config.LfgJoinInterval, true);
+}
+
+void LoadTest::Bot::HandleTimeSyncRequest(ByteBuffer& packet)
+{
+    WorldPacket timeSyncResponse(CMSG_TIME_SYNC_RESPONSE, 4 + 4);
+    timeSyncResponse << uint32(packet.read<uint32>());
+    timeSyncResponse << uint32(getMSTime());
+    SendPacket(timeSyncResponse);
+}
+
+void LoadTest::Bot::StartRequest(Action action, TimePoint now)
+{
+    PendingRequest& request = _pendingRequests[std::size_t(action)];
+    request.SentTime = now;
+    request.Active = true;
+}
+
+void LoadTest::Bot::CompleteRequest(Action action)
+{
+    PendingRequest& request = _pendingRequests[std::size_t(action)];
+    if (!request.Active)
+        return;
+
+    request.Active = false;
+    _statistics.AddLatency(action, std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - request.SentTime));
+}
+
+void LoadTest::Bot::CheckRequestTimeouts(TimePoint now)
+{
+    for (std::size_t i = 0; i < _pendingRequests.size(); ++i)
+    {
+        PendingRequest& request = _pendingRequests[i];
+        Action action = Action(i);
+        if (!request.Active || now - request.SentTime < (action == Action::Login ? _config.LoginTimeout : _config.ResponseTimeout))
+            continue;
+
+        request.Active = false;
+        _statistics.AddTimeout(action);
+        if (action == Action::Login)
+            Fail("login timed out");
+    }
+}
+
+void LoadTest::Bot::UpdateActions(TimePoint now)
+{
+    if (now >= _nextMove)
+    {
+        SendMovement(now);
+        _nextMove = GetNextActionTime(now, _config.MoveInterval);
+    }
+
+    if (now >= _nextPing)
+    {
+        SendPing(now);
+        _nextPing = GetNextActionTime(now, _config.PingInterval);
+    }
+
+    if (now >= _nextChat)
+    {
+        SendChat(now);
+        _nextChat = GetNextActionTime(now, _config.ChatInterval);
+    }
+
+    if (now >= _nextCast)
+    {
+        SendCast(now);
+        _nextCast = GetNextActionTime(now, _config.CastInterval);
+    }
+
+    if (now >= _nextLfgJoin)
+    {
+        SendLfgJoin(now);
+        _nextLfgJoin = GetNextActionTime(now, _config.LfgJoinInterval);
+    }
+}
+
+void LoadTest::Bot::SendMovement(TimePoint now)
+{
+    // random walk around the login position, turning back towards it after leaving WanderRadius
+    uint32 opcode;
+    if (_moving)
+    {
+        float distance = RunSpeed * std::chrono::duration<float>(now - _lastMove).count();
+        _positionX += std::cos(_orientation) * distance;
+        _positionY += std::sin(_orientation) * distance;
+        if (std::hypot(_positionX - _homeX, _positionY - _homeY) > WanderRadius)
+        {
+            opcode = CMSG_MOVE_STOP;
+            _moving = false;
+        }
+        else
+            opcode = CMSG_MOVE_HEARTBEAT;
+    }
+    else
+    {
+        if (std::hypot(_positionX - _homeX, _positionY - _homeY) > WanderRadius)
+            _orientation = std::atan2(_homeY - _positionY, _homeX - _positionX);
+        else
+            _orientation = frand(0.0f, 2.0f * float(M_PI));
+
+        if (_orientation < 0.0f)
+            _orientation += 2.0f * float(M_PI);
+
+        opcode = CMSG_MOVE_START_FORWARD;
+        _moving = true;
+    }
+
+    _lastMove = now;
+
+    MovementInfo movementInfo;
+    movementInfo.flags = _moving ? uint32(MOVEMENTFLAG_FORWARD) : 0;
+    movementInfo.flags = _moving ? MOVEMENTFLAG_FORWARD : 0;
+    movementInfo.time = getMSTime();
+    movementInfo.pos.Relocate(_positionX, _positionY, _positionZ, _orientation);
+
+    WorldPacket movement(opcode, 100);
+    movement << movementInfo;
+    SendPacket(movement);
+}
+
+void LoadTest::Bot::SendPing(TimePoint now)
+{
+    if (_pendingRequests[std::size_t(Action::Ping)].Active)
+        return;
+
+    StartRequest(Action::Ping, now);
+
+    WorldPacket ping(CMSG_PING, 4 + 4);
+    ping << uint32(++_pingSerial);
+    ping << uint32(0);  // Latency
+    SendPacket(CONNECTION_TYPE_REALM, ping);
+}
+
+void LoadTest::Bot::SendChat(TimePoint now)
+{
+    if (_pendingRequests[std::size_t(Action::Chat)].Active)
+        return;
+
+    StartRequest(Action::Chat, now);
+
+    // emotes need no language, /say would need one the character knows
+    std::string text = Trinity::StringFormat("load test {}", _index);
+    WorldPacket chat(CMSG_CHAT_MESSAGE_EMOTE, 2 + text.length());
+    chat.WriteBits(text.length(), 11);
+    chat.FlushBits();
+    chat.WriteString(text);
+    SendPacket(chat);
+}
+
+void LoadTest::Bot::SendCast(TimePoint now)
+{
+    if (_pendingRequests[std::size_t(Action::Cast)].Active)
+        return;
+
+    StartRequest(Action::Cast, now);
+
+    WorldPacket cast(CMSG_CAST_SPELL, 100);
+    cast << ObjectGuid::Create<HighGuid::Cast>(SPELL_CAST_SOURCE_NORMAL, _mapId, _config.CastSpellId, ++_castCounter);
+    cast << int32(0);   // Misc[0]
+    cast << int32(0);   // Misc[1]
+    cast << int32(_config.CastSpellId);
+    cast << int32(0);   // SpellXSpellVisualID
+    cast << int32(0);   // ScriptVisualID
+    cast << float(0.0f);    // MissileTrajectory.Pitch
+    cast << float(0.0f);    // MissileTrajectory.Speed
+    cast << ObjectGuid::Empty;  // CraftingNPC
+    cast << uint32(0);  // OptionalCurrencies
+    cast << uint32(0);  // OptionalReagents
+    cast << uint32(0);  // RemovedModifications
+    cast.WriteBits(0, 5);   // SendCastFlags
+    cast.WriteBit(false);   // MoveUpdate
+    cast.WriteBits(0, 2);   // Weight
+    cast.WriteBit(false);   // CraftingOrderID
+    cast.FlushBits();
+
+    // self cast
+    cast.WriteBits(0, 28);  // Flags
+    cast.WriteBit(false);   // SrcLocation
+    cast.WriteBit(false);   // DstLocation
+    cast.WriteBit(false);   // Orientation
+    cast.WriteBit(false);   // MapID
+    cast.WriteBits(0, 7);   // Name
+    cast << ObjectGuid::Empty;  // Unit
+    cast << ObjectGuid::Empty;  // Item
+    SendPacket(cast);
+}
+
+void LoadTest::Bot::SendLfgJoin(TimePoint now)
+{
+    if (_pendingRequests[std::size_t(Action::LfgJoin)].Active)
+        return;
+
+    StartRequest(Action::LfgJoin, now);
+
+    WorldPacket join(CMSG_DF_JOIN, 1 + 1 + 4 + 4);
+    join.WriteBit(false);   // QueueAsGroup
+    join.WriteBit(false);   // PartyIndex
+    join.WriteBit(false);   // Unknown
+    join << uint8(_config.LfgRoles);
+    join << uint32(1);
+    join << uint32(_config.LfgDungeonSlot);
+    SendPacket(join);
+}
+
+TimePoint LoadTest::Bot::GetNextActionTime(TimePoint now, Milliseconds interval, bool spread)
+{
+    if (interval <= 0ms)
+        return TimePoint::max();
+
+    if (spread)
+        return now + Milliseconds(urand(0, uint32(interval.count())));
+
+    return now + interval;
+}
@@ -0,0 +1,151 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_LOAD_TEST_BOT_H
+#define TRINITY_LOAD_TEST_BOT_H
+
+#include "AES.h"
+#include "AuthDefines.h"
+#include "Duration.h"
+#include "LoadTestStatistics.h"
+#include "ObjectGuid.h"
+#include "Opcodes.h"
+#include "Optional.h"
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <array>
+#include <memory>
+#include <string>
+
+class ByteBuffer;
+class WorldPacket;
+
+namespace LoadTest
+{
+class Connection;
+struct Config;
+
+// One synthetic player
+// Logs in with the realm connection like the client does after a battle.net realm join, follows SMSG_CONNECT_TO to the
+// instance connection, then moves, pings, chats, casts and joins the dungeon finder at the configured rates
+// Bots are owned by a single network thread, everything here runs on it
+class Bot : public std::enable_shared_from_this<Bot>
+{
+public:
+    enum class State : uint8
+    {
+        Waiting,            // for its turn to log in
+        Authenticating,
+        SelectingCharacter,
+        LoggingIn,
+        InWorld,
+        Offline             // failed or disconnected, session keys only work once so it stays offline
+    };
+
+    Bot(Config const& config, Statistics& statistics, boost::asio::io_context& ioContext, uint32 index, TimePoint startTime);
+    ~Bot();
+
+    void Update(TimePoint now);
+    void Stop();
+
+    void HandlePacket(Connection& connection, uint16 opcode, ByteBuffer& packet);
+    void OnConnectionClosed(ConnectionType type);
+
+    State GetState() const { return _state; }
+    std::string const& GetAccountName() const { return _accountName; }
+
+    // game account name of the bot with the index, the accounts need to exist
+    static std::string GetAccountName(Config const& config, uint32 index);
+
+    // what battle.net would have stored in account.session_key_bnet, derived from LoadTest.SessionKeySecret
+    static std::array<uint8, 64> GetSessionKeyData(Config const& config, std::string const& accountName);
+
+private:
+    struct ConnectionData
+    {
+        std::shared_ptr<Connection> Socket;
+        std::array<uint8, 16> LocalChallenge = { };
+        std::array<uint8, 16> ServerChallenge = { };
+    };
+
+    struct PendingRequest
+    {
+        TimePoint SentTime;
+        bool Active = false;
+    };
+
+    void Connect(ConnectionType type, boost::asio::ip::address const& address, uint16 port);
+    void HandleConnected(ConnectionType type, boost::asio::ip::tcp::socket&& socket, boost::system::error_code const& error);
+    void Fail(std::string_view reason);
+
+    void SendPacket(WorldPacket const& packet);
+    void SendPacket(ConnectionType type, WorldPacket const& packet);
+
+    void HandleAuthChallenge(ConnectionType type, ByteBuffer& packet);
+    void HandleEnterEncryptedMode(ConnectionType type, ByteBuffer& packet);
+    void HandleAuthResponse(ByteBuffer& packet);
+    void HandleEnumCharactersResult(ByteBuffer& packet);
+    void HandleConnectTo(ByteBuffer& packet);
+    void HandleLoginVerifyWorld(ByteBuffer& packet);
+    void HandleTimeSyncRequest(ByteBuffer& packet);
+
+    void StartRequest(Action action, TimePoint now);
+    void CompleteRequest(Action action);
+    void CheckRequestTimeouts(TimePoint now);
+
+    void UpdateActions(TimePoint now);
+    void SendMovement(TimePoint now);
+    void SendPing(TimePoint now);
+    void SendChat(TimePoint now);
+    void SendCast(TimePoint now);
+    void SendLfgJoin(TimePoint now);
+    // spread picks a random time within the first interval so bots that logged in together do not act together
+    static TimePoint GetNextActionTime(TimePoint now, Milliseconds interval, bool spread = false);
+
+    Config const& _config;
+    Statistics& _statistics;
+    boost::asio::io_context& _ioContext;
+    uint32 _index;
+    std::string _accountName;
+    State _state;
+    TimePoint _startTime;
+    TimePoint _loginStartTime;
+
+    std::array<ConnectionData, MAX_CONNECTION_TYPES> _connections;
+    SessionKey _sessionKey;
+    uint64 _instanceConnectKey;
+
+    ObjectGuid _playerGuid;
+    ObjectGuid _pendingCastId;
+    uint32 _mapId;
+    float _homeX, _homeY;
+    float _positionX, _positionY, _positionZ, _orientation;
+    bool _moving;
+    uint32 _pingSerial;
+    uint32 _castCounter;
+
+    std::array<PendingRequest, Statistics::ActionCount> _pendingRequests;
+    TimePoint _lastMove;
+    TimePoint _nextMove;
+    TimePoint _nextPing;
+    TimePoint _nextChat;
+    TimePoint _nextCast;
+    TimePoint _nextLfgJoin;
+};
+}
+
+#endif // TRINITY_LOAD_TEST_BOT_H
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoadTestConfig.h"
+#include "Config.h"
+#include "IoContext.h"
+#include "Log.h"
+#include "Resolver.h"
+#include "Util.h"
+#include <algorithm>
+
+bool LoadTest::Config::Load()
+{
+    Host = sConfigMgr->GetStringDefault("LoadTest.Host", "127.0.0.1");
+    Trinity::Asio::IoContext ioContext;
+    Trinity::Asio::Resolver resolver(ioContext);
+    Optional<boost::asio::ip::tcp::endpoint> endpoint = resolver.Resolve(boost::asio::ip::tcp::v4(), Host, "");
+    if (!endpoint)
+    {
+        TC_LOG_ERROR("loadtest", "Could not resolve LoadTest.Host {}", Host);
+        return false;
+    }
+
+    Address = endpoint->address();
+
+    int32 port = sConfigMgr->GetIntDefault("LoadTest.Port", 8085);
+    if (port <= 0 || port > 0xFFFF)
+    {
+        TC_LOG_ERROR("loadtest", "Specified world port ({}) out of allowed range (1-65535)", port);
+        return false;
+    }
+
+    Port = uint16(port);
+    RegionId = uint32(sConfigMgr->GetIntDefault("LoadTest.RegionId", 1));
+    BattlegroupId = uint32(sConfigMgr->GetIntDefault("LoadTest.BattlegroupId", 1));
+    RealmId = uint32(sConfigMgr->GetIntDefault("LoadTest.RealmId", 1));
+
+    std::string authSeed = sConfigMgr->GetStringDefault("LoadTest.AuthSeed", "");
+    if (authSeed.length() != AuthSeed.size() * 2)
+    {
+        TC_LOG_ERROR("loadtest", "LoadTest.AuthSeed must be the {} hex characters of Win64AuthSeed in build_info for the realm build", AuthSeed.size() * 2);
+        return false;
+    }
+
+    HexStrToByteArray(authSeed, AuthSeed);
+
+    SessionKeySecret = sConfigMgr->GetStringDefault("LoadTest.SessionKeySecret", "");
+    if (SessionKeySecret.empty())
+    {
+        TC_LOG_ERROR("loadtest", "LoadTest.SessionKeySecret must not be empty");
+        return false;
+    }
+
+    FirstBattlenetAccountId = uint32(std::max(sConfigMgr->GetIntDefault("LoadTest.FirstBattlenetAccountId", 1), 1));
+    BotCount = uint32(std::max(sConfigMgr->GetIntDefault("LoadTest.BotCount", 100), 1));
+    LoginsPerSecond = uint32(std::max(sConfigMgr->GetIntDefault("LoadTest.LoginsPerSecond", 50), 1));
+    NetworkThreads = uint32(std::max(sConfigMgr->GetIntDefault("LoadTest.NetworkThreads", 4), 1));
+    Duration = Seconds(std::max(sConfigMgr->GetIntDefault("LoadTest.Duration", 300), 0));
+    ReportInterval = Seconds(std::max(sConfigMgr->GetIntDefault("LoadTest.ReportInterval", 10), 1));
+    ReportFile = sConfigMgr->GetStringDefault("LoadTest.ReportFile", "");
+
+    LoginTimeout = Milliseconds(std::max(sConfigMgr->GetIntDefault("LoadTest.LoginTimeout", 30000), 1000));
+    ResponseTimeout = Milliseconds(std::max(sConfigMgr->GetIntDefault("LoadTest.ResponseTimeout", 5000), 100));
+
+    MoveInterval = Milliseconds(std::max(sConfigMgr->GetIntDefault("LoadTest.MoveInterval", 500), 0));
+    PingInterval = Milliseconds(std::max(sConfigMgr->GetIntDefault("LoadTest.PingInterval", 30000), 0));
+    if (PingInterval > 0ms && PingInterval < 30s)
+    {
+        // WorldSocket::HandlePing counts pings less than 27 seconds apart as overspeed and kicks for them
+        TC_LOG_WARN("loadtest", "LoadTest.PingInterval raised from {} to 30000 milliseconds", PingInterval.count());
+        PingInterval = 30s;
+    }
+
+    ChatInterval = Milliseconds(std::max(sConfigMgr->GetIntDefault("LoadTest.ChatInterval", 20000), 0));
+    CastInterval = Milliseconds(std::max(sConfigMgr->GetIntDefault("LoadTest.CastInterval", 0), 0));
+    CastSpellId = uint32(std::max(sConfigMgr->GetIntDefault("LoadTest.CastSpellId", 0), 0));
+    if (CastInterval > 0ms && !CastSpellId)
+    {
+        TC_LOG_ERROR("loadtest", "LoadTest.CastInterval requires LoadTest.CastSpellId");
+        return false;
+    }
+
+    LfgJoinInterval = Milliseconds(std::max(sConfigMgr->GetIntDefault("LoadTest.LfgJoinInterval", 0), 0));
+    LfgDungeonSlot = uint32(std::max(sConfigMgr->GetIntDefault("LoadTest.LfgDungeonSlot", 0), 0));
+    LfgRoles = uint8(sConfigMgr->GetIntDefault("LoadTest.LfgRoles", 8));
+    if (LfgJoinInterval > 0ms && !LfgDungeonSlot)
+    {
+        TC_LOG_ERROR("loadtest", "LoadTest.LfgJoinInterval requires LoadTest.LfgDungeonSlot");
+        return false;
+    }
+
+    return true;
+}
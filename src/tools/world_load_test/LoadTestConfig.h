@@ -0,0 +1,66 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_LOAD_TEST_CONFIG_H
+#define TRINITY_LOAD_TEST_CONFIG_H
+
+#include "Define.h"
+#include "Duration.h"
+#include <boost/asio/ip/address.hpp>
+#include <array>
+#include <string>
+
+namespace LoadTest
+{
+struct Config
+{
+    std::string Host;
+    boost::asio::ip::address Address;       // Host resolved by Load
+    uint16 Port = 8085;
+    uint32 RegionId = 1;
+    uint32 BattlegroupId = 1;
+    uint32 RealmId = 1;
+    std::array<uint8, 16> AuthSeed = { };   // Win64AuthSeed of the client build in build_info
+    std::string SessionKeySecret;
+
+    uint32 FirstBattlenetAccountId = 1;
+    uint32 BotCount = 100;
+    uint32 LoginsPerSecond = 50;
+    uint32 NetworkThreads = 4;
+    Seconds Duration = 300s;
+    Seconds ReportInterval = 10s;
+    std::string ReportFile;
+
+    Milliseconds LoginTimeout = 30s;
+    Milliseconds ResponseTimeout = 5s;
+
+    // zero disables the action
+    Milliseconds MoveInterval = 500ms;
+    Milliseconds PingInterval = 30s;
+    Milliseconds ChatInterval = 20s;
+    Milliseconds CastInterval = 0ms;
+    Milliseconds LfgJoinInterval = 0ms;
+    uint32 CastSpellId = 0;
+    uint32 LfgDungeonSlot = 0;
+    uint8 LfgRoles = 8;
+
+    // false when a setting is unusable, errors are logged
+    bool Load();
+};
+}
+
+#endif // TRINITY_LOAD_TEST_CONFIG_H
@@ -0,0 +1,287 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoadTestConnection.h"
+#include "ByteBuffer.h"
+#include "LoadTestBot.h"
+#include "Log.h"
+#include "WorldPacket.h"
+#include "WorldSocket.h"
+#include <zlib.h>
+#include <cstring>
+#include <string_view>
+
+namespace
+{
+constexpr std::string_view ServerConnectionInitialize = "WORLD OF WARCRAFT CONNECTION - SERVER TO CLIENT - V2\n";
+constexpr std::string_view ClientConnectionInitialize = "WORLD OF WARCRAFT CONNECTION - CLIENT TO SERVER - V2\n";
+
+// anything larger is a framing error, the server compresses large packets
+constexpr uint32 MaxPacketSize = 0x400000;
+
+struct ClientPacketCryptIV
+{
+    ClientPacketCryptIV(uint64 counter, uint32 magic)
+    {
+        memcpy(Value.data(), &counter, sizeof(uint64));
+        memcpy(Value.data() + sizeof(uint64), &magic, sizeof(uint32));
+    }
+
+    Trinity::Crypto::AES::IV Value;
+};
+}
+
+LoadTest::ClientPacketCrypt::ClientPacketCrypt() : _clientEncrypt(true), _serverDecrypt(false), _clientCounter(0), _serverCounter(0), _initialized(false)
+{
+}
+
+void LoadTest::ClientPacketCrypt::Init(Trinity::Crypto::AES::Key const& key)
+{
+    _clientEncrypt.Init(key);
+    _serverDecrypt.Init(key);
+    _initialized = true;
+}
+
+bool LoadTest::ClientPacketCrypt::EncryptSend(uint8* data, std::size_t length, Trinity::Crypto::AES::Tag& tag)
+{
+    if (_initialized)
+    {
+        ClientPacketCryptIV iv{ _clientCounter, 0x544E4C43 };
+        if (!_clientEncrypt.Process(iv.Value, data, length, tag))
+            return false;
+    }
+    else
+        memset(tag, 0, sizeof(tag));
+
+    ++_clientCounter;
+    return true;
+}
+
+bool LoadTest::ClientPacketCrypt::DecryptRecv(uint8* data, std::size_t length, Trinity::Crypto::AES::Tag& tag)
+{
+    if (_initialized)
+    {
+        ClientPacketCryptIV iv{ _serverCounter, 0x52565253 };
+        if (!_serverDecrypt.Process(iv.Value, data, length, tag))
+            return false;
+    }
+
+    ++_serverCounter;
+    return true;
+}
+
+LoadTest::Connection::Connection(boost::asio::ip::tcp::socket&& socket, std::weak_ptr<Bot> bot, ConnectionType type) : BaseSocket(std::move(socket)),
+    _bot(std::move(bot)), _type(type), _decompressionStream(new z_stream())
+{
+    _decompressionStream->zalloc = (alloc_func)nullptr;
+    _decompressionStream->zfree = (free_func)nullptr;
+    _decompressionStream->opaque = (voidpf)nullptr;
+    _decompressionStream->avail_in = 0;
+    _decompressionStream->next_in = nullptr;
+    int32 z_res = inflateInit2(_decompressionStream, -15);
+    if (z_res != Z_OK)
+        TC_LOG_ERROR("loadtest", "Can't initialize packet decompression (zlib: inflateInit) Error code: {} ({})", z_res, zError(z_res));
+
+    _headerBuffer.Resize(sizeof(PacketHeader));
+}
+
+LoadTest::Connection::~Connection()
+{
+    inflateEnd(_decompressionStream);
+    delete _decompressionStream;
+}
+
+void LoadTest::Connection::Start()
+{
+    SetNoDelay(true);
+
+    MessageBuffer initializer(ClientConnectionInitialize.length());
+    initializer.Write(ClientConnectionInitialize.data(), ClientConnectionInitialize.length());
+    QueuePacket(std::move(initializer));
+
+    _packetBuffer.Resize(ServerConnectionInitialize.length());
+    AsyncReadWithCallback(&Connection::InitializeHandler);
+}
+
+void LoadTest::Connection::InitializeHandler(boost::system::error_code const& error, std::size_t transferredBytes)
+{
+    if (error)
+    {
+        CloseSocket();
+        return;
+    }
+
+    MessageBuffer& packet = GetReadBuffer();
+    packet.WriteCompleted(transferredBytes);
+
+    std::size_t readSize = std::min(packet.GetActiveSize(), _packetBuffer.GetRemainingSpace());
+    _packetBuffer.Write(packet.GetReadPointer(), readSize);
+    packet.ReadCompleted(readSize);
+
+    if (_packetBuffer.GetRemainingSpace() > 0)
+    {
+        AsyncReadWithCallback(&Connection::InitializeHandler);
+        return;
+    }
+
+    if (memcmp(_packetBuffer.GetReadPointer(), ServerConnectionInitialize.data(), ServerConnectionInitialize.length()) != 0)
+    {
+        TC_LOG_ERROR("loadtest", "Connection::InitializeHandler: {} did not answer with the world connection initializer", GetRemoteIpAddress().to_string());
+        CloseSocket();
+        return;
+    }
+
+    _packetBuffer.Reset();
+
+    // handles whatever arrived together with the initializer and continues reading
+    ReadHandler();
+}
+
+void LoadTest::Connection::ReadHandler()
+{
+    if (!IsOpen())
+        return;
+
+    MessageBuffer& packet = GetReadBuffer();
+    while (packet.GetActiveSize() > 0)
+    {
+        if (_headerBuffer.GetRemainingSpace() > 0)
+        {
+            std::size_t readHeaderSize = std::min(packet.GetActiveSize(), _headerBuffer.GetRemainingSpace());
+            _headerBuffer.Write(packet.GetReadPointer(), readHeaderSize);
+            packet.ReadCompleted(readHeaderSize);
+
+            if (_headerBuffer.GetRemainingSpace() > 0)
+                break;
+
+            PacketHeader* header = reinterpret_cast<PacketHeader*>(_headerBuffer.GetReadPointer());
+            if (header->Size < sizeof(uint16) || header->Size > MaxPacketSize)
+            {
+                TC_LOG_ERROR("loadtest", "Connection::ReadHandler: {} sent a packet with invalid size {}", GetRemoteIpAddress().to_string(), header->Size);
+                CloseSocket();
+                return;
+            }
+
+            _packetBuffer.Resize(header->Size);
+        }
+
+        if (_packetBuffer.GetRemainingSpace() > 0)
+        {
+            std::size_t readDataSize = std::min(packet.GetActiveSize(), _packetBuffer.GetRemainingSpace());
+            _packetBuffer.Write(packet.GetReadPointer(), readDataSize);
+            packet.ReadCompleted(readDataSize);
+
+            if (_packetBuffer.GetRemainingSpace() > 0)
+                break;
+        }
+
+        bool handled = HandleReceivedPacket();
+        _headerBuffer.Reset();
+        if (!handled)
+        {
+            CloseSocket();
+            return;
+        }
+
+        if (!IsOpen())
+            return;
+    }
+
+    AsyncRead();
+}
+
+bool LoadTest::Connection::HandleReceivedPacket()
+{
+    PacketHeader* header = reinterpret_cast<PacketHeader*>(_headerBuffer.GetReadPointer());
+    if (!_crypt.DecryptRecv(_packetBuffer.GetReadPointer(), header->Size, header->Tag))
+    {
+        TC_LOG_ERROR("loadtest", "Connection::HandleReceivedPacket: failed to decrypt packet (size: {})", header->Size);
+        return false;
+    }
+
+    ByteBuffer packet(std::move(_packetBuffer));
+    try
+    {
+        uint16 opcode = packet.read<uint16>();
+        if (opcode == SMSG_COMPRESSED_PACKET && !Inflate(packet, opcode))
+            return false;
+
+        if (std::shared_ptr<Bot> bot = _bot.lock())
+            bot->HandlePacket(*this, opcode, packet);
+    }
+    catch (ByteBufferException const& ex)
+    {
+        TC_LOG_ERROR("loadtest", "Connection::HandleReceivedPacket: ByteBufferException {} while parsing a packet from {}", ex.what(), GetRemoteIpAddress().to_string());
+        return false;
+    }
+
+    return true;
+}
+
+bool LoadTest::Connection::Inflate(ByteBuffer& packet, uint16& opcode)
+{
+    // CompressedWorldPacket header, the checksums are not verified
+    uint32 uncompressedSize = packet.read<uint32>();
+    packet.read_skip<uint32>();
+    packet.read_skip<uint32>();
+    if (uncompressedSize < sizeof(uint16) || uncompressedSize > MaxPacketSize || packet.rpos() >= packet.size())
+        return false;
+
+    ByteBuffer inflated(uncompressedSize, ByteBuffer::Resize{});
+    _decompressionStream->next_in = packet.contents() + packet.rpos();
+    _decompressionStream->avail_in = uint32(packet.size() - packet.rpos());
+    _decompressionStream->next_out = inflated.contents();
+    _decompressionStream->avail_out = uncompressedSize;
+
+    int32 z_res = inflate(_decompressionStream, Z_SYNC_FLUSH);
+    if (z_res != Z_OK || _decompressionStream->avail_out != 0)
+    {
+        TC_LOG_ERROR("loadtest", "Can't decompress packet (zlib: inflate) Error code: {} ({})", z_res, zError(z_res));
+        return false;
+    }
+
+    packet = std::move(inflated);
+    opcode = packet.read<uint16>();
+    return true;
+}
+
+void LoadTest::Connection::SendPacket(WorldPacket const& packet)
+{
+    uint16 opcode = packet.GetOpcode();
+    uint32 packetSize = packet.size() + sizeof(opcode);
+
+    MessageBuffer buffer(sizeof(PacketHeader) + packetSize);
+    uint8* headerPos = buffer.GetWritePointer();
+    buffer.WriteCompleted(sizeof(PacketHeader));
+    uint8* dataPos = buffer.GetWritePointer();
+    buffer.Write(&opcode, sizeof(opcode));
+    if (!packet.empty())
+        buffer.Write(packet.contents(), packet.size());
+
+    PacketHeader header;
+    header.Size = packetSize;
+    _crypt.EncryptSend(dataPos, packetSize, header.Tag);
+    memcpy(headerPos, &header, sizeof(header));
+
+    QueuePacket(std::move(buffer));
+}
+
+void LoadTest::Connection::OnClose()
+{
+    if (std::shared_ptr<Bot> bot = _bot.lock())
+        bot->OnConnectionClosed(_type);
+}
@@ -0,0 +1,92 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_LOAD_TEST_CONNECTION_H
+#define TRINITY_LOAD_TEST_CONNECTION_H
+
+#include "AES.h"
+#include "MessageBuffer.h"
+#include "Opcodes.h"
+#include "Socket.h"
+#include <memory>
+
+class ByteBuffer;
+class WorldPacket;
+typedef struct z_stream_s z_stream;
+
+namespace LoadTest
+{
+class Bot;
+
+// Counterpart of WorldPacketCrypt for the client end of a connection
+// Packets sent before Init still advance the counters, like on the server
+class ClientPacketCrypt
+{
+public:
+    ClientPacketCrypt();
+
+    void Init(Trinity::Crypto::AES::Key const& key);
+    bool EncryptSend(uint8* data, std::size_t length, Trinity::Crypto::AES::Tag& tag);
+    bool DecryptRecv(uint8* data, std::size_t length, Trinity::Crypto::AES::Tag& tag);
+
+private:
+    Trinity::Crypto::AES _clientEncrypt;
+    Trinity::Crypto::AES _serverDecrypt;
+    uint64 _clientCounter;
+    uint64 _serverCounter;
+    bool _initialized;
+};
+
+// Client end of a realm or instance connection to the worldserver
+// Frames, encrypts and inflates packets the way WorldSocket expects and produces them, everything else is left to the bot
+class Connection : public Socket<Connection>
+{
+    typedef Socket<Connection> BaseSocket;
+
+public:
+    Connection(boost::asio::ip::tcp::socket&& socket, std::weak_ptr<Bot> bot, ConnectionType type);
+    ~Connection();
+
+    void Start() override;
+
+    void SendPacket(WorldPacket const& packet);
+
+    // call right after sending CMSG_ENTER_ENCRYPTED_MODE_ACK, the ack itself is not encrypted
+    void InitEncryption(Trinity::Crypto::AES::Key const& key) { _crypt.Init(key); }
+
+    ConnectionType GetConnectionType() const { return _type; }
+
+protected:
+    void OnClose() override;
+    void ReadHandler() override;
+
+private:
+    void InitializeHandler(boost::system::error_code const& error, std::size_t transferredBytes);
+    bool HandleReceivedPacket();
+    bool Inflate(ByteBuffer& packet, uint16& opcode);
+
+    std::weak_ptr<Bot> _bot;
+    ConnectionType _type;
+    ClientPacketCrypt _crypt;
+    z_stream* _decompressionStream;
+
+    MessageBuffer _headerBuffer;
+    MessageBuffer _packetBuffer;
+};
+}
+
+#endif // TRINITY_LOAD_TEST_CONNECTION_H
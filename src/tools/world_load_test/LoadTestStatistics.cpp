@@ -0,0 +1,112 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LoadTestStatistics.h"
+#include "Log.h"
+#include "StringFormat.h"
+#include <fstream>
+
+char const* LoadTest::GetActionName(Action action)
+{
+    switch (action)
+    {
+        case Action::Login: return "login";
+        case Action::Ping: return "ping";
+        case Action::Chat: return "chat";
+        case Action::Cast: return "cast";
+        case Action::LfgJoin: return "lfg_join";
+        default:
+            break;
+    }
+    return "unknown";
+}
+
+void LoadTest::Statistics::Snapshot::Merge(Snapshot const& other)
+{
+    for (std::size_t i = 0; i < ActionCount; ++i)
+    {
+        Actions[i].Latency.Merge(other.Actions[i].Latency);
+        Actions[i].Timeouts += other.Actions[i].Timeouts;
+    }
+
+    PacketsSent += other.PacketsSent;
+    PacketsReceived += other.PacketsReceived;
+    Disconnects += other.Disconnects;
+    LoginFailures += other.LoginFailures;
+}
+
+void LoadTest::Statistics::MoveTo(Snapshot& snapshot)
+{
+    for (std::size_t i = 0; i < ActionCount; ++i)
+    {
+        _actions[i].Latency.MoveTo(snapshot.Actions[i].Latency);
+        snapshot.Actions[i].Timeouts += _actions[i].Timeouts.exchange(0, std::memory_order_relaxed);
+    }
+
+    snapshot.PacketsSent += _packetsSent.exchange(0, std::memory_order_relaxed);
+    snapshot.PacketsReceived += _packetsReceived.exchange(0, std::memory_order_relaxed);
+    snapshot.Disconnects += _disconnects.exchange(0, std::memory_order_relaxed);
+    snapshot.LoginFailures += _loginFailures.exchange(0, std::memory_order_relaxed);
+}
+
+void LoadTest::Reporter::Report(std::vector<Statistics*> const& statistics, uint32 botsInWorld, Seconds elapsed)
+{
+    Statistics::Snapshot interval;
+    for (Statistics* threadStatistics : statistics)
+        threadStatistics->MoveTo(interval);
+
+    _total.Merge(interval);
+
+    TC_LOG_INFO("loadtest", "[{}s] {} bots in world, {} packets sent, {} received, {} failed logins, {} disconnects",
+        elapsed.count(), botsInWorld, interval.PacketsSent, interval.PacketsReceived, interval.LoginFailures, interval.Disconnects);
+    LogSnapshot(interval, "interval", elapsed);
+}
+
+void LoadTest::Reporter::ReportTotal(Seconds elapsed)
+{
+    TC_LOG_INFO("loadtest", "Total after {}s: {} packets sent, {} received, {} failed logins, {} disconnects",
+        elapsed.count(), _total.PacketsSent, _total.PacketsReceived, _total.LoginFailures, _total.Disconnects);
+    LogSnapshot(_total, "total", elapsed);
+}
+
+void LoadTest::Reporter::LogSnapshot(Statistics::Snapshot const& snapshot, std::string_view label, Seconds elapsed)
+{
+    std::ofstream file;
+    if (!_reportFile.empty())
+    {
+        file.open(_reportFile, std::ios::out | std::ios::app);
+        if (file && file.tellp() == 0)
+            file << "elapsed_seconds,scope,action,count,p50_ms,p95_ms,p99_ms,max_ms,timeouts\n";
+    }
+
+    for (std::size_t i = 0; i < Statistics::ActionCount; ++i)
+    {
+        Statistics::ActionSnapshot const& action = snapshot.Actions[i];
+        if (!action.Latency.GetCount() && !action.Timeouts)
+            continue;
+
+        char const* name = GetActionName(Action(i));
+        TC_LOG_INFO("loadtest", "    {:<10} count {:>7} p50 {:>6}ms p95 {:>6}ms p99 {:>6}ms max {:>6}ms timeouts {}",
+            name, action.Latency.GetCount(), action.Latency.GetPercentile(50.0f), action.Latency.GetPercentile(95.0f),
+            action.Latency.GetPercentile(99.0f), action.Latency.GetMax(), action.Timeouts);
+
+        if (file)
+            file << Trinity::StringFormat("{},{},{},{},{},{},{},{},{}\n", elapsed.count(), label, name, action.Latency.GetCount(),
+                action.Latency.GetPercentile(50.0f), action.Latency.GetPercentile(95.0f), action.Latency.GetPercentile(99.0f),
+                action.Latency.GetMax(), action.Timeouts);
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRINITY_LOAD_TEST_STATISTICS_H
+#define TRINITY_LOAD_TEST_STATISTICS_H
+
+#include "Define.h"
+#include "Duration.h"
+#include "MetricHistogram.h"
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+namespace LoadTest
+{
+// requests whose response latency is measured, a bot has at most one of each in flight
+enum class Action : uint8
+{
+    Login,      // connecting to SMSG_LOGIN_VERIFY_WORLD
+    Ping,       // CMSG_PING to SMSG_PONG
+    Chat,       // CMSG_CHAT_MESSAGE_EMOTE to the SMSG_CHAT echo
+    Cast,       // CMSG_CAST_SPELL to SMSG_SPELL_START, SMSG_SPELL_GO or SMSG_CAST_FAILED
+    LfgJoin,    // CMSG_DF_JOIN to SMSG_LFG_UPDATE_STATUS or SMSG_LFG_JOIN_RESULT
+
+    Max
+};
+
+char const* GetActionName(Action action);
+
+// Counters of one network thread, written by that thread and moved out by the reporter
+class Statistics
+{
+public:
+    static constexpr std::size_t ActionCount = std::size_t(Action::Max);
+
+    void AddLatency(Action action, Milliseconds latency) { _actions[std::size_t(action)].Latency.Add(uint32(latency.count())); }
+    void AddTimeout(Action action) { _actions[std::size_t(action)].Timeouts.fetch_add(1, std::memory_order_relaxed); }
+    void AddPacketSent() { _packetsSent.fetch_add(1, std::memory_order_relaxed); }
+    void AddPacketReceived() { _packetsReceived.fetch_add(1, std::memory_order_relaxed); }
+    void AddDisconnect() { _disconnects.fetch_add(1, std::memory_order_relaxed); }
+    void AddLoginFailure() { _loginFailures.fetch_add(1, std::memory_order_relaxed); }
+
+    struct ActionSnapshot
+    {
+        MetricHistogram Latency;
+        uint32 Timeouts = 0;
+    };
+
+    struct Snapshot
+    {
+        std::array<ActionSnapshot, ActionCount> Actions;
+        uint64 PacketsSent = 0;
+        uint64 PacketsReceived = 0;
+        uint32 Disconnects = 0;
+        uint32 LoginFailures = 0;
+
+        void Merge(Snapshot const& other);
+    };
+
+    // adds everything recorded since the previous call to snapshot
+    void MoveTo(Snapshot& snapshot);
+
+private:
+    struct ActionCounters
+    {
+        AtomicMetricHistogram Latency;
+        std::atomic<uint32> Timeouts;
+    };
+
+    std::array<ActionCounters, ActionCount> _actions = { };
+    std::atomic<uint64> _packetsSent;
+    std::atomic<uint64> _packetsReceived;
+    std::atomic<uint32> _disconnects;
+    std::atomic<uint32> _loginFailures;
+};
+
+// Logs interval and total latency percentiles and appends them to the csv ReportFile when configured
+class Reporter
+{
+public:
+    explicit Reporter(std::string reportFile) : _reportFile(std::move(reportFile)) { }
+
+    void Report(std::vector<Statistics*> const& statistics, uint32 botsInWorld, Seconds elapsed);
+    void ReportTotal(Seconds elapsed);
+
+private:
+    void LogSnapshot(Statistics::Snapshot const& snapshot, std::string_view label, Seconds elapsed);
+
+    std::string _reportFile;
+    Statistics::Snapshot _total;
+};
+}
+
+#endif // TRINITY_LOAD_TEST_STATISTICS_H
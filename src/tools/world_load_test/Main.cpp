@@ -0,0 +1,332 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+* @file Main.cpp
+* @brief World server load test client
+*
+* Logs in LoadTest.BotCount synthetic players with the world protocol and
+* reports the response latency the server delivers to them
+*/
+
+#include "Banner.h"
+#include "Config.h"
+#include "DeadlineTimer.h"
+#include "GitRevision.h"
+#include "IoContext.h"
+#include "LoadTestBot.h"
+#include "LoadTestConfig.h"
+#include "LoadTestStatistics.h"
+#include "Locales.h"
+#include "Log.h"
+#include "Memory.h"
+#include "OpenSSLCrypto.h"
+#include "Util.h"
+#include <boost/asio/signal_set.hpp>
+#include <boost/dll/runtime_symbol_info.hpp>
+#include <boost/program_options.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <atomic>
+#include <csignal>
+#include <iostream>
+#include <thread>
+
+#include "Hacks/boost_program_options_with_filesystem_path.h"
+
+using namespace boost::program_options;
+namespace fs = boost::filesystem;
+
+#ifndef _TRINITY_LOADTEST_CONFIG
+# define _TRINITY_LOADTEST_CONFIG  "worldloadtest.conf"
+#endif
+
+namespace
+{
+// Runs the connections and the update loop of its share of the bots
+class BotThread
+{
+public:
+    static constexpr Milliseconds UpdateInterval = 10ms;
+
+    BotThread() : _updateTimer(_ioContext.get_executor()), _botsInWorld(0) { }
+
+    ~BotThread()
+    {
+        Stop();
+    }
+
+    BotThread(BotThread const&) = delete;
+    BotThread& operator=(BotThread const&) = delete;
+
+    void AddBot(LoadTest::Config const& config, uint32 index, TimePoint startTime)
+    {
+        _bots.push_back(std::make_shared<LoadTest::Bot>(config, _statistics, _ioContext, index, startTime));
+    }
+
+    void Start()
+    {
+        _thread = std::thread([this]
+        {
+            ScheduleUpdate();
+            _ioContext.run();
+
+            // bots own the sockets, they have to be destroyed on the thread that used them
+            for (std::shared_ptr<LoadTest::Bot> const& bot : _bots)
+                bot->Stop();
+
+            _bots.clear();
+        });
+    }
+
+    void Stop()
+    {
+        if (!_thread.joinable())
+            return;
+
+        _ioContext.stop();
+        _thread.join();
+    }
+
+    LoadTest::Statistics& GetStatistics() { return _statistics; }
+    uint32 GetBotsInWorld() const { return _botsInWorld.load(std::memory_order_relaxed); }
+
+private:
+    void ScheduleUpdate()
+    {
+        _updateTimer.expires_from_now(boost::posix_time::milliseconds(UpdateInterval.count()));
+        _updateTimer.async_wait([this](boost::system::error_code const& error)
+        {
+            if (error)
+                return;
+
+            Update();
+            ScheduleUpdate();
+        });
+    }
+
+    void Update()
+    {
+        TimePoint now = std::chrono::steady_clock::now();
+        uint32 botsInWorld = 0;
+        for (std::shared_ptr<LoadTest::Bot> const& bot : _bots)
+        {
+            bot->Update(now);
+            if (bot->GetState() == LoadTest::Bot::State::InWorld)
+                ++botsInWorld;
+        }
+
+        _botsInWorld.store(botsInWorld, std::memory_order_relaxed);
+    }
+
+    Trinity::Asio::IoContext _ioContext;
+    Trinity::Asio::DeadlineTimer _updateTimer;
+    std::vector<std::shared_ptr<LoadTest::Bot>> _bots;
+    LoadTest::Statistics _statistics;
+    std::atomic<uint32> _botsInWorld;
+    std::thread _thread;
+};
+
+void PrintProvisioningSql(LoadTest::Config const& config);
+void ReportHandler(std::weak_ptr<Trinity::Asio::DeadlineTimer> reportTimerRef, LoadTest::Reporter& reporter, std::vector<std::unique_ptr<BotThread>> const& threads,
+    TimePoint startTime, Seconds interval, boost::system::error_code const& error);
+variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile);
+}
+
+int main(int argc, char** argv)
+{
+    signal(SIGABRT, &Trinity::AbortHandler);
+
+    Trinity::Locale::Init();
+
+    auto configFile = fs::absolute(_TRINITY_LOADTEST_CONFIG);
+    auto vm = GetConsoleArguments(argc, argv, configFile);
+    // exit if help or version is enabled
+    if (vm.count("help") || vm.count("version"))
+        return 0;
+
+    std::string configError;
+    if (!sConfigMgr->LoadInitial(configFile.generic_string(),
+                                 std::vector<std::string>(argv, argv + argc),
+                                 configError))
+    {
+        printf("Error in config file: %s\n", configError.c_str());
+        return 1;
+    }
+
+    sLog->Initialize(nullptr);
+
+    Trinity::Banner::Show("worldloadtest",
+        [](char const* text)
+        {
+            TC_LOG_INFO("loadtest", "{}", text);
+        },
+        []()
+        {
+            TC_LOG_INFO("loadtest", "Using configuration file {}.", sConfigMgr->GetFilename());
+        }
+    );
+
+    uint32 dummy = 0;
+    OpenSSLCrypto::threadsSetup(boost::dll::program_location().remove_filename());
+
+    auto opensslHandle = Trinity::make_unique_ptr_with_deleter(&dummy, [](void*) { OpenSSLCrypto::threadsCleanup(); });
+
+    LoadTest::Config config;
+    if (!config.Load())
+        return 1;
+
+    if (vm.count("print-provisioning-sql"))
+    {
+        PrintProvisioningSql(config);
+        return 0;
+    }
+
+    TC_LOG_INFO("loadtest", "Logging in {} bots at {} per second to {}:{} for {}s",
+        config.BotCount, config.LoginsPerSecond, config.Host, config.Port, config.Duration.count());
+
+    TimePoint startTime = std::chrono::steady_clock::now();
+
+    std::vector<std::unique_ptr<BotThread>> threads;
+    threads.reserve(config.NetworkThreads);
+    for (uint32 i = 0; i < config.NetworkThreads; ++i)
+        threads.push_back(std::make_unique<BotThread>());
+
+    for (uint32 i = 0; i < config.BotCount; ++i)
+        threads[i % threads.size()]->AddBot(config, i, startTime + Milliseconds(uint64(i) * 1000 / config.LoginsPerSecond));
+
+    for (std::unique_ptr<BotThread>& thread : threads)
+        thread->Start();
+
+    Trinity::Asio::IoContext ioContext;
+
+    boost::asio::signal_set signals(ioContext, SIGINT, SIGTERM);
+    signals.async_wait([&ioContext](boost::system::error_code const& error, int /*signalNumber*/)
+    {
+        if (!error)
+            ioContext.stop();
+    });
+
+    LoadTest::Reporter reporter(config.ReportFile);
+    std::shared_ptr<Trinity::Asio::DeadlineTimer> reportTimer = std::make_shared<Trinity::Asio::DeadlineTimer>(ioContext);
+    reportTimer->expires_from_now(boost::posix_time::seconds(config.ReportInterval.count()));
+    reportTimer->async_wait([reportTimerRef = std::weak_ptr(reportTimer), &reporter, &threads, startTime, interval = config.ReportInterval](boost::system::error_code const& error)
+    {
+        ReportHandler(reportTimerRef, reporter, threads, startTime, interval, error);
+    });
+
+    // 0 runs until interrupted
+    std::shared_ptr<Trinity::Asio::DeadlineTimer> durationTimer = std::make_shared<Trinity::Asio::DeadlineTimer>(ioContext);
+    if (config.Duration > 0s)
+    {
+        durationTimer->expires_from_now(boost::posix_time::seconds(config.Duration.count()));
+        durationTimer->async_wait([&ioContext](boost::system::error_code const& error)
+        {
+            if (!error)
+                ioContext.stop();
+        });
+    }
+
+    ioContext.run();
+
+    for (std::unique_ptr<BotThread>& thread : threads)
+        thread->Stop();
+
+    std::vector<LoadTest::Statistics*> statistics;
+    for (std::unique_ptr<BotThread> const& thread : threads)
+        statistics.push_back(&thread->GetStatistics());
+
+    Seconds elapsed = std::chrono::duration_cast<Seconds>(std::chrono::steady_clock::now() - startTime);
+    reporter.Report(statistics, 0, elapsed);
+    reporter.ReportTotal(elapsed);
+
+    TC_LOG_INFO("loadtest", "Halting process...");
+    return 0;
+}
+
+namespace
+{
+void PrintProvisioningSql(LoadTest::Config const& config)
+{
+    // worldserver replaces the key with the session key after every login, so this has to be run again before each test
+    for (uint32 i = 0; i < config.BotCount; ++i)
+    {
+        std::string accountName = LoadTest::Bot::GetAccountName(config, i);
+        printf("UPDATE account SET session_key_bnet = 0x%s, os = 'Wn64' WHERE username = '%s';\n",
+            ByteArrayToHexStr(LoadTest::Bot::GetSessionKeyData(config, accountName)).c_str(), accountName.c_str());
+    }
+}
+
+void ReportHandler(std::weak_ptr<Trinity::Asio::DeadlineTimer> reportTimerRef, LoadTest::Reporter& reporter, std::vector<std::unique_ptr<BotThread>> const& threads,
+    TimePoint startTime, Seconds interval, boost::system::error_code const& error)
+{
+    if (error)
+        return;
+
+    std::shared_ptr<Trinity::Asio::DeadlineTimer> reportTimer = reportTimerRef.lock();
+    if (!reportTimer)
+        return;
+
+    std::vector<LoadTest::Statistics*> statistics;
+    uint32 botsInWorld = 0;
+    for (std::unique_ptr<BotThread> const& thread : threads)
+    {
+        statistics.push_back(&thread->GetStatistics());
+        botsInWorld += thread->GetBotsInWorld();
+    }
+
+    reporter.Report(statistics, botsInWorld, std::chrono::duration_cast<Seconds>(std::chrono::steady_clock::now() - startTime));
+
+    reportTimer->expires_from_now(boost::posix_time::seconds(interval.count()));
+    reportTimer->async_wait([reportTimerRef, &reporter, &threads, startTime, interval](boost::system::error_code const& error)
+    {
+        ReportHandler(reportTimerRef, reporter, threads, startTime, interval, error);
+    });
+}
+
+variables_map GetConsoleArguments(int argc, char** argv, fs::path& configFile)
+{
+    options_description all("Allowed options");
+    all.add_options()
+        ("help,h", "print usage message")
+        ("version,v", "print version build info")
+        ("config,c", value<fs::path>(&configFile)->default_value(fs::absolute(_TRINITY_LOADTEST_CONFIG)),
+                     "use <arg> as configuration file")
+        ("print-provisioning-sql", "print the login database updates that let the bots log in and exit")
+        ;
+    variables_map variablesMap;
+    try
+    {
+        store(command_line_parser(argc, argv).options(all).allow_unregistered().run(), variablesMap);
+        notify(variablesMap);
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+    }
+
+    if (variablesMap.count("help"))
+    {
+        std::cout << all << "\n";
+    }
+    else if (variablesMap.count("version"))
+    {
+        std::cout << GitRevision::GetFullVersion() << "\n";
+    }
+
+    return variablesMap;
+}
+}
@@ -0,0 +1,93 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SpellBenchmarkData.h"
+#include "DB2Stores.h"
+#include "DummyData.h"
+#include "SpellAuraDefines.h"
+#include "SpellMgr.h"
+
+namespace
+{
+UnitTestDataLoader::DB2<DifficultyEntry, &DifficultyEntry::ID> difficulties(sDifficultyStore);
+UnitTestDataLoader::DB2<SpellNameEntry, &SpellNameEntry::ID> spellNames(sSpellNameStore);
+UnitTestDataLoader::DB2<SpellMiscEntry, &SpellMiscEntry::ID> spellMiscs(sSpellMiscStore);
+UnitTestDataLoader::DB2<SpellEffectEntry, &SpellEffectEntry::ID> spellEffects(sSpellEffectStore);
+
+void AddDifficulty(decltype(difficulties.Loader())& loader, Difficulty id, Difficulty fallback)
+{
+    DifficultyEntry& difficulty = loader.Add();
+    difficulty.ID = id;
+    difficulty.Name.Str.fill("");
+    difficulty.FallbackDifficultyID = fallback;
+}
+}
+
+void SpellBenchmarkData::Load()
+{
+    if (sSpellNameStore.GetNumRows())
+        return;
+
+    {
+        auto loader = difficulties.Loader();
+        AddDifficulty(loader, DIFFICULTY_NORMAL, DIFFICULTY_NONE);
+        AddDifficulty(loader, DIFFICULTY_HEROIC, DIFFICULTY_NORMAL);
+        AddDifficulty(loader, DIFFICULTY_NORMAL_RAID, DIFFICULTY_NORMAL);
+        AddDifficulty(loader, DIFFICULTY_HEROIC_RAID, DIFFICULTY_NORMAL_RAID);
+        AddDifficulty(loader, DIFFICULTY_MYTHIC_RAID, DIFFICULTY_HEROIC_RAID);
+    }
+
+    {
+        auto nameLoader = spellNames.Loader();
+        auto miscLoader = spellMiscs.Loader();
+        auto effectLoader = spellEffects.Loader();
+
+        auto addSpell = [&](uint32 spellId, Difficulty difficulty)
+        {
+            SpellMiscEntry& misc = miscLoader.Add();
+            misc = { };
+            misc.ID = spellId * 2 + (difficulty != DIFFICULTY_NONE);
+            misc.SpellID = spellId;
+            misc.DifficultyID = difficulty;
+            misc.SchoolMask = SPELL_SCHOOL_MASK_FIRE;
+
+            SpellEffectEntry& effect = effectLoader.Add();
+            effect = { };
+            effect.ID = misc.ID;
+            effect.SpellID = spellId;
+            effect.DifficultyID = difficulty;
+            effect.EffectIndex = EFFECT_0;
+            effect.Effect = SPELL_EFFECT_APPLY_AURA;
+            effect.EffectAura = spellId % 2 ? SPELL_AURA_PERIODIC_DAMAGE : SPELL_AURA_MOD_STAT;
+            effect.EffectBasePoints = float(spellId % 100);
+            effect.ImplicitTarget = { TARGET_UNIT_TARGET_ENEMY, 0 };
+        };
+
+        for (uint32 spellId = 1; spellId <= SpellCount; ++spellId)
+        {
+            SpellNameEntry& name = nameLoader.Add();
+            name.ID = spellId;
+            name.Name.Str.fill("");
+
+            addSpell(spellId, DIFFICULTY_NONE);
+            if (!(spellId % HeroicVariantInterval))
+                addSpell(spellId, DIFFICULTY_HEROIC);
+        }
+    }
+
+    sSpellMgr->LoadSpellInfoStore();
+}
@@ -15,27 +15,19 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef LOGOPERATION_H
-#define LOGOPERATION_H
+#ifndef TRINITY_SPELLBENCHMARKDATA_H
+#define TRINITY_SPELLBENCHMARKDATA_H
 
 #include "Define.h"
-#include <memory>
 
-class Logger;
-struct LogMessage;
-
-class TC_COMMON_API LogOperation
+// Trimmed DB2 fixture loaded into the client stores and SpellMgr in place of real game data
+namespace SpellBenchmarkData
 {
-    public:
-        LogOperation(Logger const* _logger, std::unique_ptr<LogMessage>&& _msg);
-
-        ~LogOperation();
-
-        int call();
+    // spell ids 1..SpellCount exist, every HeroicVariantInterval-th spell also has a DIFFICULTY_HEROIC entry
+    constexpr uint32 SpellCount = 50000;
+    constexpr uint32 HeroicVariantInterval = 10;
 
-    protected:
-        Logger const* logger;
-        std::unique_ptr<LogMessage> msg;
-};
+    void Load();
+}
 
-#endif
+#endif // TRINITY_SPELLBENCHMARKDATA_H
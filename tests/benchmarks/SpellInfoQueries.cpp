@@ -0,0 +1,93 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Random.h"
+#include "SpellBenchmarkData.h"
+#include "SpellInfo.h"
+#include "SpellMgr.h"
+#include <vector>
+
+namespace
+{
+std::vector<uint32> MakeSpellIds(std::size_t count)
+{
+    std::vector<uint32> spellIds(count);
+    for (uint32& spellId : spellIds)
+        spellId = urand(1, SpellBenchmarkData::SpellCount);
+
+    return spellIds;
+}
+}
+
+TEST_CASE("SpellMgr::GetSpellInfo", "[spell][!benchmark]")
+{
+    SpellBenchmarkData::Load();
+    std::vector<uint32> spellIds = MakeSpellIds(1024);
+
+    REQUIRE(sSpellMgr->GetSpellInfo(SpellBenchmarkData::HeroicVariantInterval, DIFFICULTY_MYTHIC_RAID)->Difficulty == DIFFICULTY_NONE);
+    REQUIRE(sSpellMgr->GetSpellInfo(SpellBenchmarkData::HeroicVariantInterval, DIFFICULTY_HEROIC)->Difficulty == DIFFICULTY_HEROIC);
+
+    BENCHMARK("DIFFICULTY_NONE")
+    {
+        std::size_t found = 0;
+        for (uint32 spellId : spellIds)
+            found += sSpellMgr->GetSpellInfo(spellId, DIFFICULTY_NONE) != nullptr;
+        return found;
+    };
+
+    BENCHMARK("heroic, mixed own entries and fallbacks")
+    {
+        std::size_t found = 0;
+        for (uint32 spellId : spellIds)
+            found += sSpellMgr->GetSpellInfo(spellId, DIFFICULTY_HEROIC) != nullptr;
+        return found;
+    };
+
+    BENCHMARK("mythic raid, four step fallback chain")
+    {
+        std::size_t found = 0;
+        for (uint32 spellId : spellIds)
+            found += sSpellMgr->GetSpellInfo(spellId, DIFFICULTY_MYTHIC_RAID) != nullptr;
+        return found;
+    };
+}
+
+TEST_CASE("SpellInfo effect queries", "[spell][!benchmark]")
+{
+    SpellBenchmarkData::Load();
+    std::vector<SpellInfo const*> spellInfos;
+    for (uint32 spellId : MakeSpellIds(1024))
+        spellInfos.push_back(sSpellMgr->AssertSpellInfo(spellId, DIFFICULTY_NONE));
+
+    BENCHMARK("HasAura")
+    {
+        std::size_t found = 0;
+        for (SpellInfo const* spellInfo : spellInfos)
+            found += spellInfo->HasAura(SPELL_AURA_PERIODIC_DAMAGE);
+        return found;
+    };
+
+    BENCHMARK("HasEffect")
+    {
+        std::size_t found = 0;
+        for (SpellInfo const* spellInfo : spellInfos)
+            found += spellInfo->HasEffect(SPELL_EFFECT_SCHOOL_DAMAGE);
+        return found;
+    };
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ByteBuffer.h"
+#include "MessageBuffer.h"
+#include <array>
+#include <string>
+
+TEST_CASE("ByteBuffer", "[ByteBuffer][!benchmark]")
+{
+    std::string const name = "Benchmarkname";
+
+    ByteBuffer filled;
+    for (uint32 i = 0; i < 256; ++i)
+        filled << uint32(i) << uint64(i) << float(i);
+
+    BENCHMARK("write 256 fixed size fields")
+    {
+        ByteBuffer buffer;
+        for (uint32 i = 0; i < 256; ++i)
+            buffer << uint32(i) << uint64(i) << float(i);
+        return buffer.size();
+    };
+
+    BENCHMARK("write 256 bit packed fields and strings")
+    {
+        ByteBuffer buffer;
+        for (uint32 i = 0; i < 256; ++i)
+        {
+            buffer.WriteBit(i & 1);
+            buffer.WriteBits(name.length(), 6);
+            buffer.FlushBits();
+            buffer.WriteString(name);
+        }
+        return buffer.size();
+    };
+
+    BENCHMARK("read 256 fixed size fields")
+    {
+        filled.rpos(0);
+        uint64 sum = 0;
+        for (uint32 i = 0; i < 256; ++i)
+        {
+            sum += filled.read<uint32>();
+            sum += filled.read<uint64>();
+            sum += uint64(filled.read<float>());
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("MessageBuffer", "[MessageBuffer][!benchmark]")
+{
+    // socket read pattern, a header and a payload consumed per packet, compacted after every batch
+    std::array<uint8, 64> packet = { };
+
+    BENCHMARK("write and consume 256 packets")
+    {
+        MessageBuffer buffer(4096);
+        for (uint32 batch = 0; batch < 4; ++batch)
+        {
+            for (uint32 i = 0; i < 64; ++i)
+                buffer.Write(packet.data(), packet.size());
+
+            while (buffer.GetActiveSize() >= packet.size())
+                buffer.ReadCompleted(packet.size());
+
+            buffer.Normalize();
+        }
+        return buffer.GetBufferSize();
+    };
+}
@@ -0,0 +1,98 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "LockedQueue.h"
+#include "MPSCQueue.h"
+#include "ProducerConsumerQueue.h"
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t ProducerCount = 4;
+constexpr std::size_t ItemsPerProducer = 10000;
+
+struct QueueItem
+{
+    std::size_t Value = 0;
+};
+
+// every iteration starts ProducerCount threads pushing ItemsPerProducer items each while the calling thread drains the queue
+// thread startup is part of the measurement but small next to the 40000 contended operations
+template<typename Push, typename Pop>
+std::size_t RunContended(Push push, Pop pop)
+{
+    std::vector<std::thread> producers;
+    producers.reserve(ProducerCount);
+    for (std::size_t producer = 0; producer < ProducerCount; ++producer)
+    {
+        producers.emplace_back([&push, producer]
+        {
+            for (std::size_t i = 0; i < ItemsPerProducer; ++i)
+                push(producer * ItemsPerProducer + i);
+        });
+    }
+
+    std::size_t consumed = 0;
+    while (consumed < ProducerCount * ItemsPerProducer)
+        if (pop())
+            ++consumed;
+
+    for (std::thread& producer : producers)
+        producer.join();
+
+    return consumed;
+}
+}
+
+TEST_CASE("Queues under contention", "[MPSCQueue][LockedQueue][ProducerConsumerQueue][!benchmark]")
+{
+    // MPSCQueue only links pointers, the items live here so no allocation but the queue's own nodes is measured
+    std::vector<QueueItem> items(ProducerCount * ItemsPerProducer);
+
+    BENCHMARK("MPSCQueue")
+    {
+        MPSCQueue<QueueItem> queue;
+        return RunContended([&](std::size_t i) { queue.Enqueue(&items[i]); }, [&]
+        {
+            QueueItem* item;
+            return queue.Dequeue(item);
+        });
+    };
+
+    BENCHMARK("LockedQueue")
+    {
+        LockedQueue<std::size_t> queue;
+        return RunContended([&](std::size_t i) { queue.add(i); }, [&]
+        {
+            std::size_t item;
+            return queue.next(item);
+        });
+    };
+
+    BENCHMARK("ProducerConsumerQueue")
+    {
+        ProducerConsumerQueue<std::size_t> queue;
+        return RunContended([&](std::size_t i) { queue.Push(i); }, [&]
+        {
+            std::size_t item;
+            return queue.Pop(item);
+        });
+    };
+}
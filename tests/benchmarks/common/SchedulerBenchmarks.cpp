@@ -0,0 +1,70 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "EventMap.h"
+#include "TaskScheduler.h"
+
+namespace
+{
+// roughly what a busy boss script keeps scheduled
+constexpr uint32 ScheduledCount = 32;
+}
+
+TEST_CASE("EventMap", "[EventMap][!benchmark]")
+{
+    BENCHMARK("schedule, update and execute")
+    {
+        EventMap events;
+        for (uint32 i = 0; i < ScheduledCount; ++i)
+            events.ScheduleEvent(i + 1, Milliseconds(100 + i * 50));
+
+        uint32 executed = 0;
+        for (uint32 tick = 0; tick < 50; ++tick)
+        {
+            events.Update(50);
+            while (uint32 eventId = events.ExecuteEvent())
+            {
+                events.Repeat(1s);
+                executed += eventId;
+            }
+        }
+        return executed;
+    };
+}
+
+TEST_CASE("TaskScheduler", "[TaskScheduler][!benchmark]")
+{
+    BENCHMARK("schedule, update and repeat")
+    {
+        TaskScheduler scheduler;
+        uint32 executed = 0;
+        for (uint32 i = 0; i < ScheduledCount; ++i)
+        {
+            scheduler.Schedule(Milliseconds(100 + i * 50), [&executed](TaskContext context)
+            {
+                ++executed;
+                context.Repeat(1s);
+            });
+        }
+
+        for (uint32 tick = 0; tick < 50; ++tick)
+            scheduler.Update(50ms);
+        return executed;
+    };
+}
@@ -0,0 +1,180 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "FlatHashMap.h"
+#include "FlatSet.h"
+#include "ObjectGuid.h"
+#include "Random.h"
+#include "StringFormat.h"
+#include "StringFormatCompiled.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+TEST_CASE("FlatSet", "[FlatSet][!benchmark]")
+{
+    std::vector<uint32> values;
+    for (uint32 i = 0; i < 64; ++i)
+        values.push_back((i * 2654435761u) % 1000);
+
+    Trinity::Containers::FlatSet<uint32> filled;
+    for (uint32 value : values)
+        filled.insert(value);
+
+    BENCHMARK("insert 64")
+    {
+        Trinity::Containers::FlatSet<uint32> flat;
+        for (uint32 value : values)
+            flat.insert(value);
+        return flat.size();
+    };
+
+    BENCHMARK("find 1000")
+    {
+        std::size_t found = 0;
+        for (uint32 i = 0; i < 1000; ++i)
+            found += filled.find(i) != filled.end();
+        return found;
+    };
+}
+
+TEST_CASE("StringFormat", "[StringFormat][!benchmark]")
+{
+    std::string const name = "Benchmarkname";
+
+    BENCHMARK("runtime format string")
+    {
+        return Trinity::StringFormat("{} (guid {}) at {:.2f} {:.2f} {:.2f}", name, 12345u, 1.5f, -2.25f, 100.0f);
+    };
+
+    BENCHMARK("compiled format string")
+    {
+        return Trinity::StringFormat(TC_COMPILED_FORMAT("{} (guid {}) at {:.2f} {:.2f} {:.2f}"), name, 12345u, 1.5f, -2.25f, 100.0f);
+    };
+}
+
+TEST_CASE("ObjectGuid hashing", "[ObjectGuid][!benchmark]")
+{
+    std::vector<ObjectGuid> guids;
+    for (uint64 i = 1; i <= 1024; ++i)
+    {
+        guids.push_back(ObjectGuid::Create<HighGuid::Player>(i));
+        guids.push_back(ObjectGuid::Create<HighGuid::Creature>(0, uint32(i % 64), i));
+    }
+
+    BENCHMARK("std::hash of 2048 guids")
+    {
+        std::size_t combined = 0;
+        for (ObjectGuid const& guid : guids)
+            combined ^= std::hash<ObjectGuid>()(guid);
+        return combined;
+    };
+}
+
+TEST_CASE("Map object store lookups", "[FlatHashMap][ObjectGuid][!benchmark]")
+{
+    // a crowded map worth of creatures, looked up in spawn order and in the scattered order scripts and threat lists use
+    constexpr uint64 CreatureCount = 8192;
+    std::vector<ObjectGuid> guids;
+    std::unordered_map<ObjectGuid, void*> nodeStore;
+    Trinity::Containers::FlatHashMap<ObjectGuid, void*> flatStore;
+    for (uint64 i = 1; i <= CreatureCount; ++i)
+    {
+        ObjectGuid guid = ObjectGuid::Create<HighGuid::Creature>(0, uint32(i % 256), i);
+        guids.push_back(guid);
+        nodeStore[guid] = &guids;
+        flatStore[guid] = &guids;
+    }
+
+    std::vector<ObjectGuid> scattered;
+    for (uint64 i = 0; i < CreatureCount; ++i)
+        scattered.push_back(guids[(i * 2654435761u) % CreatureCount]);
+
+    BENCHMARK("std::unordered_map, 8192 scattered lookups")
+    {
+        std::size_t found = 0;
+        for (ObjectGuid const& guid : scattered)
+            found += nodeStore.find(guid) != nodeStore.end();
+        return found;
+    };
+
+    BENCHMARK("FlatHashMap, 8192 scattered lookups")
+    {
+        std::size_t found = 0;
+        for (ObjectGuid const& guid : scattered)
+            found += flatStore.find(guid) != flatStore.end();
+        return found;
+    };
+
+    BENCHMARK("std::unordered_map, 8192 missing lookups")
+    {
+        std::size_t found = 0;
+        for (uint64 i = 1; i <= CreatureCount; ++i)
+            found += nodeStore.find(ObjectGuid::Create<HighGuid::Creature>(0, 1, CreatureCount + i)) != nodeStore.end();
+        return found;
+    };
+
+    BENCHMARK("FlatHashMap, 8192 missing lookups")
+    {
+        std::size_t found = 0;
+        for (uint64 i = 1; i <= CreatureCount; ++i)
+            found += flatStore.find(ObjectGuid::Create<HighGuid::Creature>(0, 1, CreatureCount + i)) != flatStore.end();
+        return found;
+    };
+}
+
+TEST_CASE("Chance rolls", "[Random][!benchmark]")
+{
+    // roughly the entries of a large creature loot template
+    constexpr std::size_t RollCount = 256;
+    std::vector<float> chances;
+    for (std::size_t i = 0; i < RollCount; ++i)
+        chances.push_back(float(i % 100) + 0.5f);
+
+    bool results[RollCount];
+
+    BENCHMARK("roll_chance_f, 256 rolls")
+    {
+        std::size_t hits = 0;
+        for (float chance : chances)
+            hits += roll_chance_f(chance);
+        return hits;
+    };
+
+    BENCHMARK("roll_chances_f, 256 rolls")
+    {
+        roll_chances_f(RollCount, chances.data(), results);
+        return results[0];
+    };
+
+    std::vector<uint32> words(RollCount);
+
+    BENCHMARK("rand32, 256 words")
+    {
+        for (uint32& word : words)
+            word = rand32();
+        return words[0];
+    };
+
+    BENCHMARK("fill_rand32, 256 words")
+    {
+        fill_rand32(words.data(), words.size());
+        return words[0];
+    };
+}
@@ -15,20 +15,5 @@
  * with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include "LogOperation.h"
-#include "Logger.h"
-#include "LogMessage.h"
-
-LogOperation::LogOperation(Logger const* _logger, std::unique_ptr<LogMessage>&& _msg) : logger(_logger), msg(std::forward<std::unique_ptr<LogMessage>>(_msg))
-{
-}
-
-LogOperation::~LogOperation()
-{
-}
-
-int LogOperation::call()
-{
-    logger->write(msg.get());
-    return 0;
-}
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "AllocationTracker.h"
+#include <thread>
+
+using Trinity::AllocationTag;
+using Trinity::AllocationTagScope;
+using Trinity::AllocationTracker;
+
+namespace
+{
+AllocationTracker::TagStatistics GetTag(AllocationTag tag)
+{
+    return AllocationTracker::GetStatistics()[std::size_t(tag)];
+}
+}
+
+TEST_CASE("AllocationTracker: Scopes nest and restore the previous tag")
+{
+    REQUIRE(AllocationTracker::GetCurrentTag() == AllocationTag::Untagged);
+    {
+        AllocationTagScope outer(AllocationTag::MapUpdate);
+        REQUIRE(AllocationTracker::GetCurrentTag() == AllocationTag::MapUpdate);
+        {
+            AllocationTagScope inner(AllocationTag::Spells);
+            REQUIRE(AllocationTracker::GetCurrentTag() == AllocationTag::Spells);
+        }
+        REQUIRE(AllocationTracker::GetCurrentTag() == AllocationTag::MapUpdate);
+    }
+    REQUIRE(AllocationTracker::GetCurrentTag() == AllocationTag::Untagged);
+}
+
+TEST_CASE("AllocationTracker: Allocations are charged to the current tag")
+{
+    AllocationTracker::TagStatistics before = GetTag(AllocationTag::Grids);
+
+    void* ptr;
+    {
+        AllocationTagScope scope(AllocationTag::Grids);
+        ptr = AllocationTracker::Allocate(1000);
+    }
+    REQUIRE(ptr != nullptr);
+
+    AllocationTracker::TagStatistics allocated = GetTag(AllocationTag::Grids);
+    REQUIRE(allocated.LiveBytes - before.LiveBytes == 1000);
+    REQUIRE(allocated.Allocations - before.Allocations == 1);
+    REQUIRE(allocated.AllocatedBytes - before.AllocatedBytes == 1000);
+
+    // released from the tag it was allocated with
+    AllocationTracker::Deallocate(ptr);
+
+    AllocationTracker::TagStatistics freed = GetTag(AllocationTag::Grids);
+    REQUIRE(freed.LiveBytes == before.LiveBytes);
+    REQUIRE(freed.Allocations - before.Allocations == 1);
+}
+
+TEST_CASE("AllocationTracker: Memory can be freed on another thread")
+{
+    AllocationTracker::TagStatistics before = GetTag(AllocationTag::DatabaseResults);
+
+    void* ptr = nullptr;
+    std::thread([&ptr]
+    {
+        AllocationTagScope scope(AllocationTag::DatabaseResults);
+        ptr = AllocationTracker::Allocate(64);
+    }).join();
+
+    REQUIRE(GetTag(AllocationTag::DatabaseResults).LiveBytes - before.LiveBytes == 64);
+
+    AllocationTracker::Deallocate(ptr);
+    REQUIRE(GetTag(AllocationTag::DatabaseResults).LiveBytes == before.LiveBytes);
+}
+
+TEST_CASE("AllocationTracker: Every tag has a name")
+{
+    for (std::size_t i = 0; i < AllocationTracker::TagCount; ++i)
+        REQUIRE(std::string_view(Trinity::GetAllocationTagName(AllocationTag(i))) != "unknown");
+}
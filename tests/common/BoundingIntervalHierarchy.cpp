@@ -0,0 +1,116 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "BoundingIntervalHierarchy.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+struct BoxBounds
+{
+    void operator()(G3D::AABox const& box, G3D::AABox& bounds) const { bounds = box; }
+};
+
+struct SingleRayCallback
+{
+    std::vector<G3D::AABox> const& Boxes;
+    bool Hit = false;
+
+    bool operator()(G3D::Ray const& ray, uint32 entry, float& distance, bool /*stopAtFirstHit*/)
+    {
+        float time = ray.intersectionTime(Boxes[entry]);
+        if (time >= distance)
+            return false;
+
+        distance = time;
+        Hit = true;
+        return true;
+    }
+};
+
+struct RayPacketCallback
+{
+    std::vector<G3D::AABox> const& Boxes;
+    uint32 Hits = 0;
+
+    bool operator()(std::size_t rayIndex, G3D::Ray const& ray, uint32 entry, float& distance, bool /*stopAtFirstHit*/)
+    {
+        float time = ray.intersectionTime(Boxes[entry]);
+        if (time >= distance)
+            return false;
+
+        distance = time;
+        Hits |= 1u << rayIndex;
+        return true;
+    }
+};
+}
+
+TEST_CASE("BIH: Ray packets find the same hits as single rays", "[BIH]")
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(0.0f, 1000.0f);
+    std::uniform_real_distribution<float> size(1.0f, 30.0f);
+    std::uniform_real_distribution<float> direction(-1.0f, 1.0f);
+
+    std::vector<G3D::AABox> boxes;
+    for (int i = 0; i < 2000; ++i)
+    {
+        G3D::Vector3 low(position(rng), position(rng), position(rng) / 10.0f);
+        boxes.emplace_back(low, low + G3D::Vector3(size(rng), size(rng), size(rng)));
+    }
+
+    BIH tree;
+    BoxBounds bounds;
+    tree.build(boxes, bounds);
+
+    for (int iteration = 0; iteration < 2000; ++iteration)
+    {
+        bool stopAtFirstHit = iteration & 1;
+        std::size_t count = 1 + iteration % BIH::RayPacketSize;
+        G3D::Vector3 origin(position(rng), position(rng), position(rng) / 10.0f);
+
+        G3D::Ray rays[BIH::RayPacketSize];
+        float packetDistances[BIH::RayPacketSize];
+        float singleDistances[BIH::RayPacketSize];
+        bool singleHits[BIH::RayPacketSize];
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            // axis aligned directions exercise the infinite inverse direction case
+            G3D::Vector3 dir(direction(rng), iteration % 11 ? direction(rng) : 0.0f, iteration % 7 ? direction(rng) * 0.2f : 0.0f);
+            rays[i] = G3D::Ray::fromOriginAndDirection(origin, dir.direction());
+            packetDistances[i] = singleDistances[i] = 20.0f + position(rng) / 2.0f;
+
+            SingleRayCallback callback{ boxes };
+            tree.intersectRay(rays[i], callback, singleDistances[i], stopAtFirstHit);
+            singleHits[i] = callback.Hit;
+        }
+
+        RayPacketCallback callback{ boxes };
+        tree.intersectRays(rays, count, callback, packetDistances, stopAtFirstHit);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            REQUIRE(((callback.Hits >> i) & 1) == uint32(singleHits[i]));
+            if (!stopAtFirstHit)
+                REQUIRE(std::abs(packetDistances[i] - singleDistances[i]) < 1e-3f);
+        }
+    }
+}
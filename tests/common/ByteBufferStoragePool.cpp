@@ -0,0 +1,59 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ByteBufferStoragePool.h"
+#include <thread>
+
+TEST_CASE("ByteBufferStoragePool: Acquire rounds up to size class")
+{
+    std::vector<uint8> storage = ByteBufferStoragePool::Acquire(300);
+    REQUIRE(storage.empty());
+    REQUIRE(storage.capacity() >= 1024);
+
+    std::vector<uint8> large = ByteBufferStoragePool::Acquire(100000);
+    REQUIRE(large.capacity() >= 100000);
+}
+
+TEST_CASE("ByteBufferStoragePool: Released storage is reused")
+{
+    std::vector<uint8> storage = ByteBufferStoragePool::Acquire(4000);
+    storage.resize(100, 7);
+    uint8 const* data = storage.data();
+    ByteBufferStoragePool::Release(std::move(storage));
+
+    uint64 hits = ByteBufferStoragePool::GetStatistics().Hits;
+    std::vector<uint8> reused = ByteBufferStoragePool::Acquire(2000);
+    REQUIRE(reused.data() == data);
+    REQUIRE(reused.empty());
+    REQUIRE(ByteBufferStoragePool::GetStatistics().Hits == hits + 1);
+    ByteBufferStoragePool::Release(std::move(reused));
+}
+
+TEST_CASE("ByteBufferStoragePool: Storage released by another thread reaches the depot")
+{
+    std::thread releaser([]()
+    {
+        for (uint32 i = 0; i < 200; ++i)
+            ByteBufferStoragePool::Release(ByteBufferStoragePool::Acquire(16384));
+    });
+    releaser.join();
+
+    // the exiting thread handed its free list over
+    REQUIRE(ByteBufferStoragePool::GetStatistics().DepotCounts[3] > 0);
+}
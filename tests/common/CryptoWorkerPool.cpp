@@ -0,0 +1,99 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "tc_catch2.h"
+
+#include "AsyncCallbackProcessor.h"
+#include "CryptoWorkerPool.h"
+#include <thread>
+
+using Trinity::Crypto::WorkerCallback;
+using Trinity::Crypto::WorkerPool;
+
+TEST_CASE("CryptoWorkerPool: Work runs inline without threads")
+{
+    WorkerPool pool;
+    Optional<int> result;
+    WorkerCallback callback = pool.Post([] { return 42; }, [&](Optional<int> value) { result = value; });
+    REQUIRE(callback.InvokeIfReady());
+    REQUIRE(result == 42);
+}
+
+TEST_CASE("CryptoWorkerPool: Callbacks run on the processing thread")
+{
+    WorkerPool pool;
+    pool.Start(2, 16);
+
+    std::thread::id processingThread = std::this_thread::get_id();
+    std::thread::id workThread;
+    std::thread::id callbackThread;
+    int sum = 0;
+
+    AsyncCallbackProcessor<WorkerCallback> processor;
+    for (int i = 1; i <= 4; ++i)
+    {
+        processor.AddCallback(pool.Post([i, &workThread]
+        {
+            if (i == 1)
+                workThread = std::this_thread::get_id();
+            return i;
+        }, [&](Optional<int> value)
+        {
+            callbackThread = std::this_thread::get_id();
+            sum += value.value_or(0);
+        }));
+    }
+
+    pool.Stop();
+    processor.ProcessReadyCallbacks();
+
+    REQUIRE(sum == 10);
+    REQUIRE(workThread != processingThread);
+    REQUIRE(callbackThread == processingThread);
+}
+
+TEST_CASE("CryptoWorkerPool: Work is rejected when the queue is full")
+{
+    WorkerPool pool;
+    pool.Start(1, 1);
+
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<void> started;
+
+    // occupies the only worker
+    bool blockingDone = false;
+    WorkerCallback blocking = pool.Post([&started, released] { started.set_value(); released.wait(); return true; },
+        [&](Optional<bool> result) { blockingDone = result.has_value(); });
+    started.get_future().wait();
+
+    bool queuedDone = false;
+    WorkerCallback queued = pool.Post([] { return true; }, [&](Optional<bool> result) { queuedDone = result.has_value(); });
+    REQUIRE(pool.GetQueueDepth() == 1);
+
+    bool rejected = false;
+    WorkerCallback overflow = pool.Post([] { return true; }, [&](Optional<bool> result) { rejected = !result; });
+    REQUIRE(overflow.InvokeIfReady());
+    REQUIRE(rejected);
+    REQUIRE(pool.GetRejectedCount() == 1);
+
+    release.set_value();
+    pool.Stop();
+    REQUIRE(blocking.InvokeIfReady());
+    REQUIRE(queued.InvokeIfReady());
+    REQUIRE(blockingDone);
+    REQUIRE(queuedDone);
+}
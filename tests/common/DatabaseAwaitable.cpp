@@ -0,0 +1,93 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "DatabaseAwaitable.h"
+#include <thread>
+
+using Trinity::Database::AsyncTask;
+using Trinity::Database::AsyncTaskProcessor;
+using Trinity::Database::Awaitable;
+using Trinity::Database::AwaitState;
+
+namespace
+{
+AsyncTask AwaitTwice(std::shared_ptr<AwaitState<int>> first, std::shared_ptr<AwaitState<int>> second, std::vector<int>& results, std::thread::id& resumeThread)
+{
+    results.push_back(co_await Awaitable<int>(first));
+    results.push_back(co_await Awaitable<int>(second));
+    resumeThread = std::this_thread::get_id();
+}
+}
+
+TEST_CASE("DatabaseAwaitable: Completed results do not suspend")
+{
+    std::shared_ptr<AwaitState<int>> first = std::make_shared<AwaitState<int>>();
+    std::shared_ptr<AwaitState<int>> second = std::make_shared<AwaitState<int>>();
+    first->Complete(1);
+    second->Complete(2);
+
+    std::vector<int> results;
+    std::thread::id resumeThread;
+    AsyncTaskProcessor processor;
+    processor.Start(AwaitTwice(first, second, results, resumeThread));
+
+    REQUIRE(processor.IsEmpty());
+    REQUIRE(results == std::vector<int>{ 1, 2 });
+}
+
+TEST_CASE("DatabaseAwaitable: Tasks resume on the processing thread")
+{
+    std::shared_ptr<AwaitState<int>> first = std::make_shared<AwaitState<int>>();
+    std::shared_ptr<AwaitState<int>> second = std::make_shared<AwaitState<int>>();
+
+    std::vector<int> results;
+    std::thread::id resumeThread;
+    AsyncTaskProcessor processor;
+    processor.Start(AwaitTwice(first, second, results, resumeThread));
+    REQUIRE(results.empty());
+
+    std::thread([&] { first->Complete(1); }).join();
+    REQUIRE(results.empty());
+
+    processor.ProcessReadyTasks();
+    REQUIRE(results == std::vector<int>{ 1 });
+    REQUIRE_FALSE(processor.IsEmpty());
+
+    std::thread([&] { second->Complete(2); }).join();
+    processor.ProcessReadyTasks();
+    REQUIRE(results == std::vector<int>{ 1, 2 });
+    REQUIRE(resumeThread == std::this_thread::get_id());
+    REQUIRE(processor.IsEmpty());
+}
+
+TEST_CASE("DatabaseAwaitable: Completing after the processor is gone")
+{
+    std::shared_ptr<AwaitState<int>> first = std::make_shared<AwaitState<int>>();
+    std::shared_ptr<AwaitState<int>> second = std::make_shared<AwaitState<int>>();
+
+    std::vector<int> results;
+    std::thread::id resumeThread;
+    {
+        AsyncTaskProcessor processor;
+        processor.Start(AwaitTwice(first, second, results, resumeThread));
+    }
+
+    first->Complete(1);
+    REQUIRE(results.empty());
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "DenseIdSet.h"
+#include <vector>
+
+TEST_CASE("Insertion", "[DenseIdSet]")
+{
+    Trinity::Containers::DenseIdSet<uint32> ids;
+
+    REQUIRE(ids.empty());
+    REQUIRE(ids.insert(70) == true);
+    REQUIRE(ids.insert(3) == true);
+    REQUIRE(ids.insert(64) == true);
+    REQUIRE(ids.insert(3) == false);
+
+    REQUIRE(ids.size() == 3);
+    REQUIRE(ids.contains(3));
+    REQUIRE(ids.contains(64));
+    REQUIRE(ids.contains(70));
+    REQUIRE(!ids.contains(4));
+    REQUIRE(!ids.contains(100000));
+}
+
+TEST_CASE("Iteration is ordered", "[DenseIdSet]")
+{
+    Trinity::Containers::DenseIdSet<uint32> ids;
+    for (uint32 id : { 200u, 0u, 63u, 64u, 1000u })
+        ids.insert(id);
+
+    std::vector<uint32> values(ids.begin(), ids.end());
+    REQUIRE(values == std::vector<uint32>{ 0, 63, 64, 200, 1000 });
+}
+
+TEST_CASE("Erase", "[DenseIdSet]")
+{
+    Trinity::Containers::DenseIdSet<uint32> ids;
+    ids.insert(5);
+    ids.insert(500);
+
+    REQUIRE(ids.erase(6) == 0);
+    REQUIRE(ids.erase(500) == 1);
+    REQUIRE(ids.size() == 1);
+    REQUIRE(!ids.contains(500));
+
+    std::vector<uint32> values(ids.begin(), ids.end());
+    REQUIRE(values == std::vector<uint32>{ 5 });
+
+    REQUIRE(ids.erase(5) == 1);
+    REQUIRE(ids.empty());
+    REQUIRE(ids.begin() == ids.end());
+}
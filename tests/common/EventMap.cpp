@@ -376,6 +376,52 @@ TEST_CASE("Delay grouped events", "[EventMap]")
     REQUIRE(eventMap.GetTimeUntilEvent(EVENT_3) == 4s);
 }
 
+TEST_CASE("Events with the same time execute in scheduling order", "[EventMap]")
+{
+    EventMap eventMap;
+    eventMap.ScheduleEvent(EVENT_2, 1s);
+    eventMap.ScheduleEvent(EVENT_1, 1s);
+    eventMap.ScheduleEvent(EVENT_3, 500ms);
+
+    eventMap.Update(1000);
+
+    REQUIRE(eventMap.ExecuteEvent() == EVENT_3);
+    REQUIRE(eventMap.ExecuteEvent() == EVENT_2);
+    REQUIRE(eventMap.ExecuteEvent() == EVENT_1);
+    REQUIRE(eventMap.Empty());
+}
+
+TEST_CASE("Delayed grouped events execute after other events with the same time", "[EventMap]")
+{
+    EventMap eventMap;
+    eventMap.ScheduleEvent(EVENT_1, 1s, GROUP_1);
+    eventMap.ScheduleEvent(EVENT_2, 2s);
+    eventMap.ScheduleEvent(EVENT_3, 1s, GROUP_1);
+
+    eventMap.DelayEvents(1s, GROUP_1);
+    eventMap.Update(2000);
+
+    REQUIRE(eventMap.ExecuteEvent() == EVENT_2);
+    REQUIRE(eventMap.ExecuteEvent() == EVENT_1);
+    REQUIRE(eventMap.ExecuteEvent() == EVENT_3);
+    REQUIRE(eventMap.Empty());
+}
+
+TEST_CASE("Many scheduled events", "[EventMap]")
+{
+    EventMap eventMap;
+    for (uint32 i = 1; i <= 32; ++i)
+        eventMap.ScheduleEvent(i, Milliseconds((33 - i) * 100), i % 2 ? GROUP_1 : GROUP_2);
+
+    eventMap.CancelEventGroup(GROUP_2);
+    eventMap.Update(3200);
+
+    for (uint32 i = 32; i > 0; i -= 2)
+        REQUIRE(eventMap.ExecuteEvent() == i - 1);
+
+    REQUIRE(eventMap.Empty());
+}
+
 TEST_CASE("Reset map", "[EventMap]")
 {
     EventMap eventMap;
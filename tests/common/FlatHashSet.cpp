@@ -0,0 +1,124 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "FlatHashMap.h"
+#include "FlatHashSet.h"
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace
+{
+// every key lands in the same bucket, forces long probe sequences
+struct CollidingHash
+{
+    std::size_t operator()(int) const { return 0; }
+};
+}
+
+TEST_CASE("FlatHashSet: insert, find and erase", "[FlatHashSet]")
+{
+    Trinity::Containers::FlatHashSet<int> set;
+
+    REQUIRE(set.insert(5).second);
+    REQUIRE(set.insert(3).second);
+    REQUIRE(!set.insert(5).second);
+    REQUIRE(set.size() == 2);
+
+    REQUIRE(set.contains(3));
+    REQUIRE(*set.find(5) == 5);
+    REQUIRE(set.find(7) == set.end());
+
+    REQUIRE(set.erase(3) == 1);
+    REQUIRE(set.erase(3) == 0);
+    REQUIRE(!set.contains(3));
+    REQUIRE(set.size() == 1);
+
+    set.clear();
+    REQUIRE(set.empty());
+    REQUIRE(set.begin() == set.end());
+}
+
+TEST_CASE("FlatHashSet: erase keeps colliding keys reachable", "[FlatHashSet]")
+{
+    Trinity::Containers::FlatHashSet<int, CollidingHash> set;
+    for (int i = 0; i < 6; ++i)
+        set.insert(i);
+
+    REQUIRE(set.erase(0) == 1);
+    REQUIRE(set.erase(3) == 1);
+    for (int i : { 1, 2, 4, 5 })
+        REQUIRE(set.contains(i));
+
+    std::size_t count = 0;
+    for (int i : set)
+    {
+        REQUIRE(i != 0);
+        REQUIRE(i != 3);
+        ++count;
+    }
+    REQUIRE(count == 4);
+}
+
+TEST_CASE("FlatHashSet: matches std::unordered_set", "[FlatHashSet]")
+{
+    Trinity::Containers::FlatHashSet<int> set;
+    std::unordered_set<int> reference;
+
+    std::mt19937 rng(42);
+    for (int i = 0; i < 20000; ++i)
+    {
+        int key = int(rng() % 500);
+        if (rng() % 3)
+            REQUIRE(set.insert(key).second == reference.insert(key).second);
+        else
+            REQUIRE(set.erase(key) == reference.erase(key));
+    }
+
+    REQUIRE(set.size() == reference.size());
+    for (int key : set)
+        REQUIRE(reference.contains(key));
+}
+
+TEST_CASE("FlatHashMap: operator[] and try_emplace", "[FlatHashMap]")
+{
+    Trinity::Containers::FlatHashMap<int, std::string> map;
+
+    map[1] = "one";
+    REQUIRE(map.try_emplace(2, "two").second);
+    REQUIRE(!map.try_emplace(2, "deux").second);
+    REQUIRE(map.find(2)->second == "two");
+    REQUIRE(map[1] == "one");
+    REQUIRE(map.size() == 2);
+
+    std::unordered_map<int, std::string> reference;
+    for (int i = 0; i < 1000; ++i)
+    {
+        map[i] = std::to_string(i);
+        reference[i] = std::to_string(i);
+    }
+
+    for (int i = 0; i < 1000; i += 2)
+        REQUIRE(map.erase(i) == reference.erase(i));
+
+    REQUIRE(map.size() == reference.size());
+    for (auto const& [key, value] : map)
+        REQUIRE(reference.at(key) == value);
+}
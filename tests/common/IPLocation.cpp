@@ -0,0 +1,87 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "tc_catch2.h"
+
+#include "IPLocation.h"
+#include <boost/filesystem/operations.hpp>
+#include <fstream>
+
+namespace
+{
+struct TemporaryDatabase
+{
+    TemporaryDatabase()
+    {
+        Path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("iplocation-%%%%-%%%%.csv")).string();
+        std::ofstream file(Path);
+        file << "\"16777216\",\"16777472\",\"AU\",\"Australia\"\r\n";
+        file << "\"16777472\",\"16777728\",\"CN\",\"China\"\r\n";
+        file << "\"134744064\",\"134744320\",\"US\",\"United States of America\"\r\n";
+        file << "\"16777728\",\"16778240\",\"US\",\"United States of America\"\r\n";
+        // 2001:db8::/32
+        file << "\"42540766411282592856903984951653826560\",\"42540766490510755371168322545197776896\",\"DE\",\"Germany\"\r\n";
+    }
+
+    ~TemporaryDatabase()
+    {
+        boost::system::error_code error;
+        boost::filesystem::remove(Path, error);
+        boost::filesystem::remove(Path + ".cache", error);
+    }
+
+    std::string Path;
+};
+}
+
+TEST_CASE("IPLocation: Lookup", "[IPLocation]")
+{
+    TemporaryDatabase database;
+
+    IpLocationStore store;
+    REQUIRE(store.LoadFile(database.Path));
+    REQUIRE(!store.IsMapped());
+
+    auto check = [&](IpLocationStore const& store)
+    {
+        IpLocationRecord const* record = store.GetLocationRecord("1.0.0.1");
+        REQUIRE(record);
+        REQUIRE(record->CountryCode == "au");
+        REQUIRE(record->CountryName == "Australia");
+
+        record = store.GetLocationRecord(boost::asio::ip::make_address("8.8.8.8"));
+        REQUIRE(record);
+        REQUIRE(record->CountryCode == "us");
+
+        // range ends are exclusive
+        REQUIRE(store.GetLocationRecord("8.8.9.0") == nullptr);
+        REQUIRE(store.GetLocationRecord("0.255.255.255") == nullptr);
+        REQUIRE(store.GetLocationRecord("::ffff:1.0.0.1")->CountryCode == "au");
+        REQUIRE(store.GetLocationRecord("2001:db8::1")->CountryCode == "de");
+        REQUIRE(store.GetLocationRecord("2001:db9::1") == nullptr);
+        REQUIRE(store.GetLocationRecord("not an address") == nullptr);
+
+        // countries are shared between their ranges
+        REQUIRE(store.GetLocationRecord("1.0.2.1") == store.GetLocationRecord("8.8.8.1"));
+    };
+
+    check(store);
+
+    IpLocationStore cached;
+    REQUIRE(cached.LoadFile(database.Path));
+    REQUIRE(cached.IsMapped());
+    check(cached);
+}
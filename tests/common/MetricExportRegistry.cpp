@@ -0,0 +1,71 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "MetricExportRegistry.h"
+
+using Tag = MetricExportRegistry::Tag;
+
+TEST_CASE("MetricExportRegistry: Names are sanitized")
+{
+    REQUIRE(MetricExportRegistry::FormatName("world_update_time") == "world_update_time");
+    REQUIRE(MetricExportRegistry::FormatName("db queue.login") == "db_queue_login");
+    REQUIRE(MetricExportRegistry::FormatName("5min") == "_5min");
+}
+
+TEST_CASE("MetricExportRegistry: Values are gauges")
+{
+    MetricExportRegistry registry;
+    Tag tags[] = { { "realm", "Trinity \"Test\"" }, { "", "ignored" } };
+    registry.SetValue("online_players", tags, 10.0);
+    registry.SetValue("online_players", tags, 12.0);
+    registry.SetValue("uptime", {}, 3.5);
+
+    REQUIRE(registry.Render() ==
+        "# TYPE online_players gauge\n"
+        "online_players{realm=\"Trinity \\\"Test\\\"\"} 12\n"
+        "# TYPE uptime gauge\n"
+        "uptime 3.5\n");
+}
+
+TEST_CASE("MetricExportRegistry: Histograms are cumulative")
+{
+    MetricExportRegistry registry;
+    Tag tags[] = { { "map_id", "0" } };
+
+    MetricHistogram first;
+    first.Add(0);
+    first.Add(3);
+    registry.AddHistogram("map_update_time", tags, first);
+
+    MetricHistogram second;
+    second.Add(2);
+    registry.AddHistogram("map_update_time", tags, second);
+
+    // same category logged as a value keeps the first type
+    registry.SetValue("map_update_time", tags, 1.0);
+
+    REQUIRE(registry.Render() ==
+        "# TYPE map_update_time histogram\n"
+        "map_update_time_bucket{map_id=\"0\",le=\"0\"} 1\n"
+        "map_update_time_bucket{map_id=\"0\",le=\"1\"} 1\n"
+        "map_update_time_bucket{map_id=\"0\",le=\"3\"} 3\n"
+        "map_update_time_bucket{map_id=\"0\",le=\"+Inf\"} 3\n"
+        "map_update_time_sum{map_id=\"0\"} 5\n"
+        "map_update_time_count{map_id=\"0\"} 3\n");
+}
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "MetricHistogram.h"
+
+TEST_CASE("MetricHistogram: Empty histogram")
+{
+    MetricHistogram histogram;
+    REQUIRE(histogram.GetCount() == 0);
+    REQUIRE(histogram.GetSum() == 0);
+    REQUIRE(histogram.GetMax() == 0);
+    REQUIRE(histogram.GetPercentile(50.0f) == 0);
+}
+
+TEST_CASE("MetricHistogram: Count, sum and max")
+{
+    MetricHistogram histogram;
+    histogram.Add(0);
+    histogram.Add(10);
+    histogram.Add(1000);
+
+    REQUIRE(histogram.GetCount() == 3);
+    REQUIRE(histogram.GetSum() == 1010);
+    REQUIRE(histogram.GetMax() == 1000);
+}
+
+TEST_CASE("MetricHistogram: Percentiles")
+{
+    MetricHistogram histogram;
+    for (uint32 i = 0; i < 99; ++i)
+        histogram.Add(5);
+    histogram.Add(3000);
+
+    // 5 falls into bucket [4, 8)
+    REQUIRE(histogram.GetPercentile(50.0f) == 7);
+    REQUIRE(histogram.GetPercentile(99.0f) == 7);
+
+    // capped by the largest recorded value instead of the bucket bound
+    REQUIRE(histogram.GetPercentile(100.0f) == 3000);
+}
+
+TEST_CASE("MetricHistogram: Merge and reset")
+{
+    MetricHistogram first;
+    first.Add(1);
+    first.Add(2);
+
+    MetricHistogram second;
+    second.Add(64);
+
+    first.Merge(second);
+    REQUIRE(first.GetCount() == 3);
+    REQUIRE(first.GetSum() == 67);
+    REQUIRE(first.GetMax() == 64);
+    REQUIRE(first.GetPercentile(100.0f) == 64);
+
+    first.Reset();
+    REQUIRE(first.GetCount() == 0);
+    REQUIRE(first.GetMax() == 0);
+}
+
+TEST_CASE("AtomicMetricHistogram: Move to histogram")
+{
+    AtomicMetricHistogram shard;
+    shard.Add(3);
+    shard.Add(100);
+
+    MetricHistogram histogram;
+    histogram.Add(1);
+    shard.MoveTo(histogram);
+    REQUIRE(histogram.GetCount() == 3);
+    REQUIRE(histogram.GetSum() == 104);
+    REQUIRE(histogram.GetMax() == 100);
+    REQUIRE(histogram.GetBucket(2) == 1);
+
+    // moved values are not collected twice
+    MetricHistogram empty;
+    shard.MoveTo(empty);
+    REQUIRE(empty.GetCount() == 0);
+    REQUIRE(empty.GetMax() == 0);
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Random.h"
+#include <array>
+#include <vector>
+
+TEST_CASE("fill_rand32 returns the words of rand32", "[Random]")
+{
+    // crosses several generated blocks and starts in the middle of one
+    constexpr std::size_t WordCount = 2000;
+
+    SeedRandomEngine(12345);
+    rand32();
+    std::vector<uint32> single(WordCount);
+    for (uint32& word : single)
+        word = rand32();
+    uint32 nextSingle = rand32();
+
+    SeedRandomEngine(12345);
+    rand32();
+    std::vector<uint32> filled(WordCount);
+    fill_rand32(filled.data(), 700);
+    fill_rand32(filled.data() + 700, WordCount - 700);
+
+    REQUIRE(filled == single);
+    REQUIRE(rand32() == nextSingle);
+}
+
+TEST_CASE("roll_chances_f rolls like roll_chance_f", "[Random]")
+{
+    std::array<float, 1000> chances;
+    for (std::size_t i = 0; i < chances.size(); ++i)
+        chances[i] = float(i % 101);
+
+    SeedRandomEngine(777);
+    std::array<bool, 1000> single;
+    for (std::size_t i = 0; i < chances.size(); ++i)
+        single[i] = roll_chance_f(chances[i]);
+    float nextSingle = rand_chance();
+
+    SeedRandomEngine(777);
+    std::array<bool, 1000> bulk;
+    roll_chances_f(chances.size(), chances.data(), bulk.data());
+
+    REQUIRE(bulk == single);
+    REQUIRE(rand_chance() == nextSingle);
+    REQUIRE(!bulk[0]);
+    REQUIRE(bulk[100]);
+}
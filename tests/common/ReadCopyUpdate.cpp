@@ -0,0 +1,91 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ReadCopyUpdate.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ReadCopyUpdate: Readers see published updates")
+{
+    Trinity::ReadCopyUpdate<std::vector<int>> values;
+    REQUIRE(values.Read([](std::vector<int> const& snapshot) { return snapshot.size(); }) == 0);
+
+    values.Update([](std::vector<int>& snapshot) { snapshot.push_back(1); });
+    values.Update([](std::vector<int>& snapshot) { snapshot.push_back(2); });
+
+    REQUIRE(values.Read([](std::vector<int> const& snapshot) { return snapshot; }) == std::vector<int>{ 1, 2 });
+}
+
+TEST_CASE("ReadCopyUpdate: Nested reads")
+{
+    Trinity::ReadCopyUpdate<int> first;
+    Trinity::ReadCopyUpdate<int> second;
+    first.Update([](int& value) { value = 1; });
+    second.Update([](int& value) { value = 2; });
+
+    int sum = first.Read([&](int const& a)
+    {
+        return a + second.Read([](int const& b) { return b; });
+    });
+    REQUIRE(sum == 3);
+
+    // the nested read must not leave the epoch pinned
+    second.Update([](int& value) { value = 3; });
+    REQUIRE(second.Read([](int const& value) { return value; }) == 3);
+}
+
+TEST_CASE("ReadCopyUpdate: Concurrent readers and writer")
+{
+    Trinity::ReadCopyUpdate<std::vector<int>> values;
+    std::atomic<bool> stop = false;
+    std::atomic<bool> consistent = true;
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&]
+        {
+            while (!stop)
+            {
+                // every published snapshot holds 0..n-1
+                bool valid = values.Read([](std::vector<int> const& snapshot)
+                {
+                    for (std::size_t j = 0; j < snapshot.size(); ++j)
+                        if (snapshot[j] != int(j))
+                            return false;
+                    return true;
+                });
+
+                if (!valid)
+                    consistent = false;
+            }
+        });
+    }
+
+    for (int i = 0; i < 2000; ++i)
+        values.Update([i](std::vector<int>& snapshot) { snapshot.push_back(i); });
+
+    stop = true;
+    for (std::thread& reader : readers)
+        reader.join();
+
+    REQUIRE(consistent);
+    REQUIRE(values.Read([](std::vector<int> const& snapshot) { return snapshot.size(); }) == 2000);
+}
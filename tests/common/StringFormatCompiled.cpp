@@ -0,0 +1,42 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "StringFormatCompiled.h"
+#include <cstdint>
+#include <iterator>
+
+TEST_CASE("StringFormatCompiled: Same output as runtime format strings")
+{
+    REQUIRE(Trinity::StringFormat(TC_COMPILED_FORMAT("{}"), 42) == "42");
+    REQUIRE(Trinity::StringFormat(TC_COMPILED_FORMAT("0x{:016X}{:016X}"), uint64_t(1), uint64_t(0xABC))
+        == Trinity::StringFormat("0x{:016X}{:016X}", uint64_t(1), uint64_t(0xABC)));
+    REQUIRE(Trinity::StringFormat(TC_COMPILED_FORMAT("[{0} 0x{1:04X} ({1})]"), "CMSG_PING", 0x3768u) == "[CMSG_PING 0x3768 (14184)]");
+    REQUIRE(Trinity::StringFormat(TC_COMPILED_FORMAT("{:<5}|"), "INFO") == "INFO |");
+}
+
+TEST_CASE("StringFormatCompiled: Appends to caller provided buffers")
+{
+    std::string buffer = "prefix ";
+    Trinity::StringFormatTo(std::back_inserter(buffer), TC_COMPILED_FORMAT("{:04}-{:02}"), 2024, 3);
+    REQUIRE(buffer == "prefix 2024-03");
+
+    char chars[8] = { };
+    char* end = Trinity::StringFormatTo(chars, TC_COMPILED_FORMAT("{}{}"), 'a', 7);
+    REQUIRE(std::string_view(chars, end) == "a7");
+}
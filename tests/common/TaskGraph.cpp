@@ -0,0 +1,75 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "TaskGraph.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("TaskGraph: Dependencies finish before dependents", "[TaskGraph]")
+{
+    Trinity::ThreadPool pool(4);
+
+    std::mutex lock;
+    std::vector<int> order;
+    auto record = [&](int value) { return [&, value] { std::lock_guard<std::mutex> guard(lock); order.push_back(value); }; };
+
+    Trinity::TaskGraph graph;
+    Trinity::TaskGraph::TaskId a = graph.Add("a", record(1));
+    Trinity::TaskGraph::TaskId b = graph.Add("b", record(2));
+    Trinity::TaskGraph::TaskId c = graph.Add("c", record(3), { a, b });
+    graph.Add("d", record(4), { c });
+
+    graph.Run(&pool);
+
+    REQUIRE(order.size() == 4);
+    REQUIRE(order[2] == 3);
+    REQUIRE(order[3] == 4);
+    REQUIRE(graph.GetTimings().size() == 4);
+}
+
+TEST_CASE("TaskGraph: Runs on the calling thread without a pool", "[TaskGraph]")
+{
+    std::vector<int> order;
+
+    Trinity::TaskGraph graph;
+    Trinity::TaskGraph::TaskId a = graph.Add("a", [&] { order.push_back(1); });
+    graph.Add("b", [&] { order.push_back(2); });
+    graph.Add("c", [&] { order.push_back(3); }, { a });
+
+    graph.Run(nullptr);
+
+    REQUIRE(order == std::vector<int>{ 1, 2, 3 });
+}
+
+TEST_CASE("TaskGraph: Failed task skips its dependents", "[TaskGraph]")
+{
+    Trinity::ThreadPool pool(2);
+    std::atomic<bool> dependentRan = false;
+
+    Trinity::TaskGraph graph;
+    Trinity::TaskGraph::TaskId failing = graph.Add("failing", [] { throw std::runtime_error("failed"); });
+    graph.Add("dependent", [&] { dependentRan = true; }, { failing });
+
+    REQUIRE_THROWS_AS(graph.Run(&pool), std::runtime_error);
+    REQUIRE(!dependentRan);
+    REQUIRE(graph.GetTimings().empty());
+}
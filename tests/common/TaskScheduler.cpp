@@ -0,0 +1,80 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "TaskScheduler.h"
+#include <vector>
+
+TEST_CASE("TaskScheduler: Tasks are dispatched in order of their end", "[TaskScheduler]")
+{
+    TaskScheduler scheduler;
+    std::vector<uint32> executed;
+
+    scheduler.Schedule(2s, [&](TaskContext) { executed.push_back(3); });
+    scheduler.Schedule(1s, [&](TaskContext) { executed.push_back(1); });
+    scheduler.Schedule(1s, [&](TaskContext) { executed.push_back(2); });
+
+    scheduler.Update(1s);
+    REQUIRE(executed == std::vector<uint32>{ 1, 2 });
+
+    scheduler.Update(1s);
+    REQUIRE(executed == std::vector<uint32>{ 1, 2, 3 });
+}
+
+TEST_CASE("TaskScheduler: Repeated tasks", "[TaskScheduler]")
+{
+    TaskScheduler scheduler;
+    uint32 executions = 0;
+
+    scheduler.Schedule(1s, [&](TaskContext context)
+    {
+        if (++executions < 3)
+            context.Repeat();
+    });
+
+    scheduler.Update(5s);
+    REQUIRE(executions == 3);
+}
+
+TEST_CASE("TaskScheduler: Groups", "[TaskScheduler]")
+{
+    TaskScheduler scheduler;
+    std::vector<uint32> executed;
+
+    scheduler.Schedule(1s, 1, [&](TaskContext) { executed.push_back(1); });
+    scheduler.Schedule(2s, 2, [&](TaskContext) { executed.push_back(2); });
+    scheduler.Schedule(3s, 1, [&](TaskContext) { executed.push_back(3); });
+
+    SECTION("Cancel group")
+    {
+        scheduler.CancelGroup(1);
+        scheduler.Update(3s);
+        REQUIRE(executed == std::vector<uint32>{ 2 });
+    }
+
+    SECTION("Delay group")
+    {
+        // delayed tasks are dispatched after other tasks ending at the same time
+        scheduler.DelayGroup(1, 1s);
+        scheduler.Update(2s);
+        REQUIRE(executed == std::vector<uint32>{ 2, 1 });
+
+        scheduler.Update(2s);
+        REQUIRE(executed == std::vector<uint32>{ 2, 1, 3 });
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ThreadAffinity.h"
+
+TEST_CASE("ThreadAffinity: Processor lists", "[ThreadAffinity]")
+{
+    SECTION("Empty list means no restriction")
+    {
+        Optional<std::vector<uint32>> processors = Trinity::ThreadAffinity::ParseProcessorList("");
+        REQUIRE(processors.has_value());
+        REQUIRE(processors->empty());
+    }
+
+    SECTION("Numbers and ranges are sorted and deduplicated")
+    {
+        Optional<std::vector<uint32>> processors = Trinity::ThreadAffinity::ParseProcessorList(" 8, 0-3 ,2,10-11");
+        REQUIRE(processors.has_value());
+        REQUIRE(*processors == std::vector<uint32>{ 0, 1, 2, 3, 8, 10, 11 });
+    }
+
+    SECTION("Malformed lists are rejected")
+    {
+        REQUIRE(!Trinity::ThreadAffinity::ParseProcessorList("a").has_value());
+        REQUIRE(!Trinity::ThreadAffinity::ParseProcessorList("3-1").has_value());
+        REQUIRE(!Trinity::ThreadAffinity::ParseProcessorList("1-").has_value());
+        REQUIRE(!Trinity::ThreadAffinity::ParseProcessorList("node:x").has_value());
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "ThreadLocalPool.h"
+#include <map>
+#include <thread>
+
+namespace
+{
+struct PooledObject
+{
+    uint64 Values[8] = { };
+
+    static void* operator new(std::size_t size) { return Trinity::ThreadLocalAllocationPool<PooledObject, 2>::Allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) noexcept { Trinity::ThreadLocalAllocationPool<PooledObject, 2>::Deallocate(ptr, size); }
+};
+}
+
+TEST_CASE("ThreadLocalAllocationPool: Freed blocks are reused")
+{
+    PooledObject* first = new PooledObject();
+    void* block = first;
+    delete first;
+
+    PooledObject* second = new PooledObject();
+    REQUIRE(static_cast<void*>(second) == block);
+    delete second;
+}
+
+TEST_CASE("ThreadLocalAllocationPool: Free list is capped")
+{
+    PooledObject* objects[3] = { new PooledObject(), new PooledObject(), new PooledObject() };
+    for (PooledObject* object : objects)
+        delete object;
+
+    // only the first two blocks were kept, most recently freed first
+    PooledObject* a = new PooledObject();
+    PooledObject* b = new PooledObject();
+    REQUIRE(static_cast<void*>(a) == static_cast<void*>(objects[1]));
+    REQUIRE(static_cast<void*>(b) == static_cast<void*>(objects[0]));
+    delete a;
+    delete b;
+}
+
+TEST_CASE("ThreadLocalAllocationPool: Blocks stay with the freeing thread")
+{
+    PooledObject* object = new PooledObject();
+    void* block = object;
+    std::thread([object]() { delete object; }).join();
+
+    PooledObject* other = new PooledObject();
+    REQUIRE(static_cast<void*>(other) != block);
+    delete other;
+}
+
+TEST_CASE("ThreadLocalVectorPool: Released vectors keep capacity")
+{
+    using Pool = Trinity::ThreadLocalVectorPool<uint32, 4, 16>;
+
+    std::vector<uint32> values = Pool::Acquire();
+    values.assign({ 1, 2, 3 });
+    uint32 const* data = values.data();
+    std::size_t capacity = values.capacity();
+    Pool::Release(std::move(values));
+
+    std::vector<uint32> reused = Pool::Acquire();
+    REQUIRE(reused.empty());
+    REQUIRE(reused.data() == data);
+    REQUIRE(reused.capacity() == capacity);
+
+    // vectors that grew too large are dropped
+    reused.resize(100);
+    Pool::Release(std::move(reused));
+    REQUIRE(Pool::Acquire().capacity() == 0);
+}
+
+TEST_CASE("ThreadLocalPoolAllocator: Erased container nodes are reused")
+{
+    using Map = std::multimap<uint32, uint32, std::less<uint32>, Trinity::ThreadLocalPoolAllocator<std::pair<uint32 const, uint32>>>;
+
+    Map values;
+    auto itr = values.emplace(1, 10);
+    void const* node = &*itr;
+    values.erase(itr);
+
+    itr = values.emplace(2, 20);
+    REQUIRE(values.count(2) == 1);
+
+    // the first node went back to this thread's free list and was handed out again
+    REQUIRE(static_cast<void const*>(&*itr) == node);
+}
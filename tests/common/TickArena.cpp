@@ -0,0 +1,97 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "TickArena.h"
+#include <thread>
+
+using Trinity::TickArena;
+
+TEST_CASE("TickArena: Default resource is used outside of a scope")
+{
+    REQUIRE(TickArena::GetResource() == std::pmr::get_default_resource());
+
+    {
+        TickArena::Scope scope;
+        REQUIRE(TickArena::GetResource() != std::pmr::get_default_resource());
+    }
+
+    REQUIRE(TickArena::GetResource() == std::pmr::get_default_resource());
+}
+
+TEST_CASE("TickArena: Nested scopes share the arena")
+{
+    TickArena::Scope outer;
+    std::pmr::memory_resource* resource = TickArena::GetResource();
+    {
+        TickArena::Scope inner;
+        REQUIRE(TickArena::GetResource() == resource);
+    }
+    REQUIRE(TickArena::GetResource() == resource);
+}
+
+TEST_CASE("TickArena: Memory is reused by the next tick")
+{
+    void* first;
+    {
+        TickArena::Scope scope;
+        first = TickArena::GetResource()->allocate(128);
+    }
+
+    void* second;
+    {
+        TickArena::Scope scope;
+        second = TickArena::GetResource()->allocate(128);
+    }
+
+    REQUIRE(first == second);
+}
+
+TEST_CASE("TickArena: Reserved block grows after a tick that needed more")
+{
+    // fresh thread, fresh arena
+    std::thread([]
+    {
+        {
+            TickArena::Scope scope;
+            REQUIRE(TickArena::GetReservedSize() == TickArena::InitialSize);
+
+            Trinity::TickVector<uint32> values(TickArena::GetResource());
+            for (uint32 i = 0; i < TickArena::InitialSize; ++i)
+                values.push_back(i);
+
+            REQUIRE(values.size() == TickArena::InitialSize);
+            REQUIRE(values.back() == TickArena::InitialSize - 1);
+        }
+
+        std::size_t grown = TickArena::GetReservedSize();
+        REQUIRE(grown > TickArena::InitialSize);
+        REQUIRE(grown <= TickArena::MaxSize);
+
+        {
+            TickArena::Scope scope;
+            Trinity::TickSet<uint32> values(TickArena::GetResource());
+            for (uint32 i = 0; i < 1000; ++i)
+                values.insert(i);
+
+            REQUIRE(values.size() == 1000);
+        }
+
+        REQUIRE(TickArena::GetReservedSize() == grown);
+    }).join();
+}
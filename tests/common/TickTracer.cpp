@@ -0,0 +1,55 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "TickTracer.h"
+
+using Trinity::TickTracer;
+
+TEST_CASE("TickTracer: Zones are only recorded while recording")
+{
+    TickTracer::SetThreadName("tick tracer test");
+
+    TickTracer::SetRecording(false);
+    {
+        TC_TRACE_ZONE("tick_tracer_test_ignored");
+    }
+
+    TickTracer::SetRecording(true);
+    {
+        TC_TRACE_ZONE("tick_tracer_test_zone");
+    }
+    TickTracer::SetRecording(false);
+
+    std::string trace = TickTracer::FormatChromeTrace(Milliseconds(1000));
+    REQUIRE(trace.find("\"name\":\"tick tracer test\"") != std::string::npos);
+    REQUIRE(trace.find("\"name\":\"tick_tracer_test_zone\"") != std::string::npos);
+    REQUIRE(trace.find("tick_tracer_test_ignored") == std::string::npos);
+}
+
+TEST_CASE("TickTracer: Arguments and window")
+{
+    TimePoint now = std::chrono::steady_clock::now();
+    TickTracer::Record("tick_tracer_test_map", "map_id", "571", now - 2ms, now);
+    TickTracer::Record("tick_tracer_test_old", {}, {}, now - 10s, now - 9s);
+
+    std::string trace = TickTracer::FormatChromeTrace(Milliseconds(1000));
+    REQUIRE(trace.find("\"name\":\"tick_tracer_test_map (571)\"") != std::string::npos);
+    REQUIRE(trace.find("\"args\":{\"map_id\":\"571\"}") != std::string::npos);
+    REQUIRE(trace.find("tick_tracer_test_old") == std::string::npos);
+}
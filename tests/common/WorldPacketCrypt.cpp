@@ -0,0 +1,85 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "WorldPacketCrypt.h"
+#include <cstring>
+#include <vector>
+
+namespace
+{
+struct TestPacket
+{
+    std::vector<uint8> Data;
+    Trinity::Crypto::AES::Tag Tag;
+};
+
+std::vector<TestPacket> MakePackets()
+{
+    std::vector<TestPacket> packets(4);
+    for (std::size_t i = 0; i < packets.size(); ++i)
+    {
+        packets[i].Data.resize(10 + i * 100);
+        for (std::size_t j = 0; j < packets[i].Data.size(); ++j)
+            packets[i].Data[j] = uint8(i * 31 + j);
+    }
+    return packets;
+}
+}
+
+TEST_CASE("WorldPacketCrypt: Batch encryption matches single packet encryption")
+{
+    Trinity::Crypto::AES::Key key = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 };
+
+    WorldPacketCrypt single;
+    single.Init(key);
+    WorldPacketCrypt batched;
+    batched.Init(key);
+
+    std::vector<TestPacket> expected = MakePackets();
+    std::vector<TestPacket> actual = MakePackets();
+
+    // same counter state for the batch
+    Trinity::Crypto::AES::Tag firstTag;
+    std::vector<uint8> first = { 1, 2, 3 };
+    REQUIRE(single.EncryptSend(first.data(), first.size(), firstTag));
+    REQUIRE(batched.EncryptSend(first.data(), first.size(), firstTag));
+
+    for (TestPacket& packet : expected)
+        REQUIRE(single.EncryptSend(packet.Data.data(), packet.Data.size(), packet.Tag));
+
+    std::vector<WorldPacketCrypt::SendRequest> requests;
+    for (TestPacket& packet : actual)
+        requests.push_back({ .Data = packet.Data.data(), .Length = packet.Data.size(), .Tag = &packet.Tag });
+
+    REQUIRE(batched.EncryptSendBatch(requests));
+
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        REQUIRE(expected[i].Data == actual[i].Data);
+        REQUIRE(std::memcmp(expected[i].Tag, actual[i].Tag, sizeof(Trinity::Crypto::AES::Tag)) == 0);
+    }
+
+    // both continue with the same counter
+    Trinity::Crypto::AES::Tag singleTag, batchedTag;
+    std::vector<uint8> singleLast = { 4, 5, 6 }, batchedLast = { 4, 5, 6 };
+    REQUIRE(single.EncryptSend(singleLast.data(), singleLast.size(), singleTag));
+    REQUIRE(batched.EncryptSend(batchedLast.data(), batchedLast.size(), batchedTag));
+    REQUIRE(singleLast == batchedLast);
+    REQUIRE(std::memcmp(singleTag, batchedTag, sizeof(Trinity::Crypto::AES::Tag)) == 0);
+}
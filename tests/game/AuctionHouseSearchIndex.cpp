@@ -0,0 +1,88 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "AuctionHouseSearchIndex.h"
+#include <set>
+
+namespace
+{
+AuctionsBucketData MakeBucket(uint32 itemId, uint8 itemClass, std::wstring name)
+{
+    AuctionsBucketData bucket;
+    bucket.Key.ItemId = itemId;
+    bucket.ItemClass = itemClass;
+    bucket.FullName[LOCALE_enUS] = std::move(name);
+    return bucket;
+}
+
+std::set<uint32> Search(AuctionsBucketSearchIndex const& index, std::wstring_view name, Optional<AuctionSearchClassFilters> const& classFilters = {})
+{
+    std::set<uint32> itemIds;
+    index.ForEachCandidate(LOCALE_enUS, name, classFilters, [&](AuctionsBucketData const* bucket) { itemIds.insert(bucket->Key.ItemId); });
+    return itemIds;
+}
+}
+
+TEST_CASE("AuctionsBucketSearchIndex", "[AuctionHouseSearchIndex]")
+{
+    AuctionsBucketSearchIndex index;
+    AuctionsBucketData sword = MakeBucket(1, ITEM_CLASS_WEAPON, L"copper shortsword");
+    AuctionsBucketData ore = MakeBucket(2, ITEM_CLASS_TRADE_GOODS, L"copper ore");
+    AuctionsBucketData bar = MakeBucket(3, ITEM_CLASS_TRADE_GOODS, L"tin bar");
+    index.AddBucket(&sword);
+    index.AddBucket(&ore);
+    index.AddBucket(&bar);
+
+    SECTION("Names narrow candidates by trigrams")
+    {
+        REQUIRE(Search(index, L"copper") == std::set<uint32>{ 1, 2 });
+        REQUIRE(Search(index, L"ore") == std::set<uint32>{ 2 });
+        REQUIRE(Search(index, L"iron").empty());
+    }
+
+    SECTION("Short names only use class filters")
+    {
+        REQUIRE(Search(index, L"") == std::set<uint32>{ 1, 2, 3 });
+        REQUIRE(Search(index, L"ba") == std::set<uint32>{ 1, 2, 3 });
+    }
+
+    SECTION("Class filters narrow candidates")
+    {
+        Optional<AuctionSearchClassFilters> classFilters;
+        classFilters.emplace();
+        classFilters->Classes[ITEM_CLASS_TRADE_GOODS].SubclassMask = AuctionSearchClassFilters::FILTER_SKIP_SUBCLASS;
+
+        REQUIRE(Search(index, L"", classFilters) == std::set<uint32>{ 2, 3 });
+        REQUIRE(Search(index, L"copper", classFilters) == std::set<uint32>{ 2 });
+    }
+
+    SECTION("Removed buckets are no longer candidates and their slots are reused")
+    {
+        index.RemoveBucket(&ore);
+        REQUIRE(index.GetBucketCount() == 2);
+        REQUIRE(Search(index, L"copper") == std::set<uint32>{ 1 });
+        REQUIRE(Search(index, L"ore").empty());
+
+        AuctionsBucketData dust = MakeBucket(4, ITEM_CLASS_TRADE_GOODS, L"strange dust");
+        index.AddBucket(&dust);
+        REQUIRE(dust.SearchIndexSlot == 1);
+        REQUIRE(Search(index, L"dust") == std::set<uint32>{ 4 });
+        REQUIRE(Search(index, L"") == std::set<uint32>{ 1, 3, 4 });
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "GridRefManager.h"
+#include <array>
+#include <set>
+
+namespace
+{
+struct GridTestObject
+{
+    GridReference<GridTestObject> Ref;
+    int Id = 0;
+};
+
+std::multiset<int> Visit(GridRefManager<GridTestObject>& manager)
+{
+    std::multiset<int> ids;
+    for (GridReference<GridTestObject>& ref : manager)
+        ids.insert(ref.GetSource()->Id);
+    return ids;
+}
+}
+
+TEST_CASE("GridRefManager slots", "[GridRefManager]")
+{
+    GridRefManager<GridTestObject> manager;
+    std::array<GridTestObject, 8> objects;
+    for (std::size_t i = 0; i < objects.size(); ++i)
+    {
+        objects[i].Id = int(i);
+        objects[i].Ref.link(&manager, &objects[i]);
+    }
+
+    SECTION("Every linked object is visited once")
+    {
+        REQUIRE(Visit(manager) == std::multiset<int>{ 0, 1, 2, 3, 4, 5, 6, 7 });
+        REQUIRE(manager.getSize() == 8);
+    }
+
+    SECTION("Unlinking removes the slot")
+    {
+        objects[0].Ref.unlink();
+        objects[5].Ref.unlink();
+        REQUIRE(Visit(manager) == std::multiset<int>{ 1, 2, 3, 4, 6, 7 });
+        REQUIRE(manager.getSize() == 6);
+    }
+
+    SECTION("Unlinking the current object during iteration visits all others")
+    {
+        std::multiset<int> visited;
+        for (auto itr = manager.begin(); itr != manager.end(); ++itr)
+        {
+            GridTestObject* object = itr->GetSource();
+            visited.insert(object->Id);
+            if (object->Id % 2)
+                object->Ref.unlink();
+        }
+
+        REQUIRE(visited == std::multiset<int>{ 0, 1, 2, 3, 4, 5, 6, 7 });
+        REQUIRE(Visit(manager) == std::multiset<int>{ 0, 2, 4, 6 });
+    }
+
+    SECTION("Objects linked during iteration are not visited")
+    {
+        GridTestObject extra;
+        extra.Id = 100;
+
+        std::multiset<int> visited;
+        for (auto itr = manager.begin(); itr != manager.end(); ++itr)
+        {
+            visited.insert(itr->GetSource()->Id);
+            if (!extra.Ref.isValid())
+                extra.Ref.link(&manager, &extra);
+        }
+
+        REQUIRE(visited == std::multiset<int>{ 0, 1, 2, 3, 4, 5, 6, 7 });
+        extra.Ref.unlink();
+    }
+}
@@ -71,6 +71,17 @@ TEST_CASE("|Hitem validation", "[Hyperlinks]")
         REQUIRE(false == CheckAllLinks("This is a mis-colored |cffa335ee|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r."));
         REQUIRE(false == CheckAllLinks("This is a |cffffffff|Hitem:6948:-1:::::::60:::::|h[Hearthstone]|h|r that is quite negative."));
     }
+    SECTION("Repeated item link")
+    {
+        REQUIRE(true  == CheckAllLinks("|cffffffff|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r and |cffffffff|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r"));
+        REQUIRE(false == CheckAllLinks("|cffffffff|Hitem:6948::::::::60:::::|h[Hearthstone]|h|r and |cffffffff|Hitem:6948::::::::60:::::|h[Doormat]|h|r"));
+        REQUIRE(false == CheckAllLinks("|cffffffff|Hitem:6948::::::::60:::::|h[Doormat]|h|r"));
+
+        sWorld->setIntConfig(CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY, 0);
+        REQUIRE(true  == CheckAllLinks("|cffffffff|Hitem:6948::::::::60:::::|h[Doormat]|h|r"));
+        sWorld->setIntConfig(CONFIG_CHAT_STRICT_LINK_CHECKING_SEVERITY, 1);
+        REQUIRE(false == CheckAllLinks("|cffffffff|Hitem:6948::::::::60:::::|h[Doormat]|h|r"));
+    }
 }
 
 TEST_CASE("|Hachievement validation", "[Hyperlinks]")
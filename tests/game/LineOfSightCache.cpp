@@ -0,0 +1,62 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "LineOfSightCache.h"
+#include <G3D/Vector3.h>
+
+TEST_CASE("LineOfSightCache: Disabled cache stores nothing", "[LineOfSightCache]")
+{
+    LineOfSightCache cache;
+    REQUIRE(!cache.IsEnabled());
+
+    cache.Store(0, { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f }, 0, false);
+    REQUIRE(!cache.Find(0, { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f }, 0));
+}
+
+TEST_CASE("LineOfSightCache: Nearby endpoints share entries", "[LineOfSightCache]")
+{
+    LineOfSightCache cache;
+    cache.SetSize(100);
+    REQUIRE(cache.IsEnabled());
+
+    REQUIRE(!cache.Find(0, { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f }, 0));
+    cache.Store(0, { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f }, 0, false);
+
+    REQUIRE(cache.Find(0, { 1.1f, 2.1f, 3.1f }, { 4.1f, 5.1f, 6.1f }, 0) == false);
+    REQUIRE(!cache.Find(0, { 1.0f, 2.0f, 3.0f }, { 14.0f, 5.0f, 6.0f }, 0));
+    REQUIRE(!cache.Find(1, { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f }, 0));
+    REQUIRE(!cache.Find(0, { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f }, 1));
+
+    LineOfSightCache::Statistics statistics = cache.ConsumeStatistics();
+    REQUIRE(statistics.Hits == 1);
+    REQUIRE(statistics.Misses == 4);
+    REQUIRE(cache.ConsumeStatistics().Misses == 0);
+}
+
+TEST_CASE("LineOfSightCache: Clear drops all entries", "[LineOfSightCache]")
+{
+    LineOfSightCache cache;
+    cache.SetSize(16);
+
+    cache.Store(0, { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f }, 0, true);
+    REQUIRE(cache.Find(0, { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f }, 0) == true);
+
+    cache.Clear();
+    REQUIRE(!cache.Find(0, { 1.0f, 2.0f, 3.0f }, { 4.0f, 5.0f, 6.0f }, 0));
+}
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "PathCache.h"
+
+TEST_CASE("PathCache: Disabled cache stores nothing", "[PathCache]")
+{
+    PathCache cache;
+    REQUIRE(!cache.IsEnabled());
+
+    dtPolyRef path[3] = { 1, 2, 3 };
+    cache.Store(0, 1, 3, 1, 0, path, 3);
+    REQUIRE(cache.Find(0, 1, 3, 1, 0, path, 3) == 0);
+}
+
+TEST_CASE("PathCache: Entries are keyed by polygons and filter", "[PathCache]")
+{
+    PathCache cache;
+    cache.SetSize(16);
+    REQUIRE(cache.IsEnabled());
+
+    dtPolyRef path[3] = { 1, 2, 3 };
+    cache.Store(0, 1, 3, 1, 0, path, 3);
+
+    dtPolyRef found[3] = { };
+    REQUIRE(cache.Find(0, 1, 3, 1, 0, found, 3) == 3);
+    REQUIRE(found[0] == 1);
+    REQUIRE(found[1] == 2);
+    REQUIRE(found[2] == 3);
+
+    REQUIRE(cache.Find(1, 1, 3, 1, 0, found, 3) == 0);
+    REQUIRE(cache.Find(0, 2, 3, 1, 0, found, 3) == 0);
+    REQUIRE(cache.Find(0, 1, 3, 3, 0, found, 3) == 0);
+    REQUIRE(cache.Find(0, 1, 3, 1, 2, found, 3) == 0);
+    REQUIRE(cache.Find(0, 1, 3, 1, 0, found, 2) == 0);
+
+    PathCache::Statistics statistics = cache.ConsumeStatistics();
+    REQUIRE(statistics.Hits == 1);
+    REQUIRE(statistics.Misses == 5);
+    REQUIRE(cache.ConsumeStatistics().Misses == 0);
+}
+
+TEST_CASE("PathCache: Least recently used entries are evicted", "[PathCache]")
+{
+    PathCache cache;
+    cache.SetSize(2);
+
+    dtPolyRef path[2] = { 1, 2 };
+    cache.Store(0, 1, 2, 1, 0, path, 2);
+    cache.Store(0, 1, 3, 1, 0, path, 2);
+
+    dtPolyRef found[2];
+    REQUIRE(cache.Find(0, 1, 2, 1, 0, found, 2) == 2);
+
+    cache.Store(0, 1, 4, 1, 0, path, 2);
+    REQUIRE(cache.Find(0, 1, 2, 1, 0, found, 2) == 2);
+    REQUIRE(cache.Find(0, 1, 3, 1, 0, found, 2) == 0);
+    REQUIRE(cache.Find(0, 1, 4, 1, 0, found, 2) == 2);
+}
+
+TEST_CASE("PathCache: Clear drops all entries", "[PathCache]")
+{
+    PathCache cache;
+    cache.SetSize(16);
+
+    dtPolyRef path[2] = { 1, 2 };
+    cache.Store(0, 1, 2, 1, 0, path, 2);
+    cache.Clear();
+
+    dtPolyRef found[2];
+    REQUIRE(cache.Find(0, 1, 2, 1, 0, found, 2) == 0);
+}
@@ -0,0 +1,57 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "PlayerUpdateSchedule.h"
+
+TEST_CASE("PlayerUpdateSchedule: Nothing is due without deadlines", "[PlayerUpdateSchedule]")
+{
+    PlayerUpdateSchedule schedule;
+    REQUIRE_FALSE(schedule.HasDue(1000));
+    REQUIRE_FALSE(schedule.TakeIfDue(PlayerScheduledUpdate::PvPFlag, 1000));
+}
+
+TEST_CASE("PlayerUpdateSchedule: Earlier deadline is kept", "[PlayerUpdateSchedule]")
+{
+    PlayerUpdateSchedule schedule;
+    schedule.Schedule(PlayerScheduledUpdate::MailDelivery, 100);
+    schedule.Schedule(PlayerScheduledUpdate::MailDelivery, 200);
+    REQUIRE(schedule.GetDeadline(PlayerScheduledUpdate::MailDelivery) == 100);
+
+    schedule.Schedule(PlayerScheduledUpdate::MailDelivery, 50);
+    REQUIRE(schedule.GetDeadline(PlayerScheduledUpdate::MailDelivery) == 50);
+}
+
+TEST_CASE("PlayerUpdateSchedule: Taking a deadline moves the earliest one", "[PlayerUpdateSchedule]")
+{
+    PlayerUpdateSchedule schedule;
+    schedule.Schedule(PlayerScheduledUpdate::AfkReport, 100);
+    schedule.Schedule(PlayerScheduledUpdate::InstanceResetTimes, 300);
+
+    REQUIRE_FALSE(schedule.HasDue(99));
+    REQUIRE(schedule.HasDue(100));
+
+    REQUIRE_FALSE(schedule.TakeIfDue(PlayerScheduledUpdate::InstanceResetTimes, 100));
+    REQUIRE(schedule.TakeIfDue(PlayerScheduledUpdate::AfkReport, 100));
+    REQUIRE(schedule.GetDeadline(PlayerScheduledUpdate::AfkReport) == PlayerUpdateSchedule::Never);
+    REQUIRE_FALSE(schedule.HasDue(299));
+    REQUIRE(schedule.HasDue(300));
+
+    REQUIRE(schedule.TakeIfDue(PlayerScheduledUpdate::InstanceResetTimes, 300));
+    REQUIRE_FALSE(schedule.HasDue(PlayerUpdateSchedule::Never - 1));
+}
@@ -0,0 +1,67 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "RepathThrottle.h"
+
+TEST_CASE("RepathThrottle: Without a path a new one is always needed", "[RepathThrottle]")
+{
+    RepathThrottle throttle;
+    throttle.Update(Position(0.0f, 0.0f, 0.0f), 100);
+    REQUIRE(!throttle.CanKeepPath(Position(0.0f, 0.0f, 0.0f), 5.0f, 0));
+}
+
+TEST_CASE("RepathThrottle: Path is kept while the target stays within tolerance", "[RepathThrottle]")
+{
+    RepathThrottle throttle;
+    throttle.Update(Position(0.0f, 0.0f, 0.0f), 100);
+    throttle.OnPathCalculated(Position(0.0f, 0.0f, 0.0f), 0);
+
+    throttle.Update(Position(1.0f, 0.0f, 0.0f), 100);
+    REQUIRE(throttle.CanKeepPath(Position(1.0f, 0.0f, 0.0f), 2.0f, 0));
+    REQUIRE(!throttle.CanKeepPath(Position(1.0f, 0.0f, 0.0f), 0.5f, 0));
+}
+
+TEST_CASE("RepathThrottle: Target leaving the corridor is predicted from its velocity", "[RepathThrottle]")
+{
+    RepathThrottle throttle;
+    throttle.Update(Position(0.0f, 0.0f, 0.0f), 100);
+    throttle.OnPathCalculated(Position(0.0f, 0.0f, 0.0f), 0);
+
+    // 1 yard per 100 ms, 2 yards ahead after 200 ms
+    throttle.Update(Position(1.0f, 0.0f, 0.0f), 100);
+    REQUIRE(throttle.CanKeepPath(Position(1.0f, 0.0f, 0.0f), 2.5f, 100));
+    REQUIRE(!throttle.CanKeepPath(Position(1.0f, 0.0f, 0.0f), 2.5f, 200));
+}
+
+TEST_CASE("RepathThrottle: Repath delay keeps the path until it passed", "[RepathThrottle]")
+{
+    RepathThrottle throttle;
+    throttle.Update(Position(0.0f, 0.0f, 0.0f), 100);
+    throttle.OnPathCalculated(Position(0.0f, 0.0f, 0.0f), 250);
+
+    throttle.Update(Position(10.0f, 0.0f, 0.0f), 100);
+    REQUIRE(throttle.CanKeepPath(Position(10.0f, 0.0f, 0.0f), 1.0f, 0));
+    throttle.Update(Position(10.0f, 0.0f, 0.0f), 100);
+    REQUIRE(throttle.CanKeepPath(Position(10.0f, 0.0f, 0.0f), 1.0f, 0));
+    throttle.Update(Position(10.0f, 0.0f, 0.0f), 100);
+    REQUIRE(!throttle.CanKeepPath(Position(10.0f, 0.0f, 0.0f), 1.0f, 0));
+
+    throttle.Reset();
+    REQUIRE(!throttle.CanKeepPath(Position(0.0f, 0.0f, 0.0f), 1.0f, 0));
+}
@@ -0,0 +1,71 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "TerrainStatusCache.h"
+
+TEST_CASE("TerrainStatusCache: Disabled cache stores nothing", "[TerrainStatusCache]")
+{
+    TerrainStatusCache cache;
+    REQUIRE(!cache.IsEnabled());
+
+    cache.Store(0, 1.0f, 2.0f, 3.0f, {}, VMAP::AreaAndLiquidData());
+    REQUIRE(!cache.Find(0, 1.0f, 2.0f, 3.0f, {}));
+}
+
+TEST_CASE("TerrainStatusCache: Nearby positions share entries", "[TerrainStatusCache]")
+{
+    TerrainStatusCache cache;
+    cache.SetSize(100);
+    REQUIRE(cache.IsEnabled());
+
+    VMAP::AreaAndLiquidData data;
+    data.floorZ = 2.5f;
+    data.liquidInfo.emplace(2, 3.0f);
+
+    REQUIRE(!cache.Find(0, 1.0f, 2.0f, 3.0f, {}));
+    cache.Store(0, 1.0f, 2.0f, 3.0f, {}, data);
+
+    Optional<VMAP::AreaAndLiquidData> cached = cache.Find(0, 1.1f, 2.1f, 3.1f, {});
+    REQUIRE(cached.has_value());
+    REQUIRE(cached->floorZ == 2.5f);
+    REQUIRE(cached->liquidInfo.has_value());
+    REQUIRE(cached->liquidInfo->type == 2);
+    REQUIRE(!cached->areaInfo.has_value());
+
+    REQUIRE(!cache.Find(0, 1.0f, 2.0f, 13.0f, {}));
+    REQUIRE(!cache.Find(1, 1.0f, 2.0f, 3.0f, {}));
+    REQUIRE(!cache.Find(0, 1.0f, 2.0f, 3.0f, uint8(1)));
+
+    TerrainStatusCache::Statistics statistics = cache.ConsumeStatistics();
+    REQUIRE(statistics.Hits == 1);
+    REQUIRE(statistics.Misses == 4);
+    REQUIRE(cache.ConsumeStatistics().Misses == 0);
+}
+
+TEST_CASE("TerrainStatusCache: Clear drops all entries", "[TerrainStatusCache]")
+{
+    TerrainStatusCache cache;
+    cache.SetSize(16);
+
+    cache.Store(0, 1.0f, 2.0f, 3.0f, {}, VMAP::AreaAndLiquidData());
+    REQUIRE(cache.Find(0, 1.0f, 2.0f, 3.0f, {}).has_value());
+
+    cache.Clear();
+    REQUIRE(!cache.Find(0, 1.0f, 2.0f, 3.0f, {}));
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "UpdateMask.h"
+
+// more than 32 blocks, so the blocks mask spans two words
+using TestMask = UpdateMask<1100>;
+
+TEST_CASE("UpdateMask: AND keeps only common bits", "[UpdateMask]")
+{
+    TestMask left;
+    left.Set(3);
+    left.Set(40);
+    left.Set(1050);
+
+    TestMask right;
+    right.Set(40);
+    right.Set(41);
+    right.Set(1050);
+
+    TestMask result = left & right;
+    REQUIRE(!result[3]);
+    REQUIRE(result[40]);
+    REQUIRE(!result[41]);
+    REQUIRE(result[1050]);
+
+    // emptied blocks are no longer reported
+    REQUIRE(result.GetBlock(0) == 0);
+    REQUIRE((result.GetBlocksMask(0) & 1) == 0);
+    REQUIRE((result.GetBlocksMask(0) & 2) != 0);
+    REQUIRE(result.GetBlocksMask(1) != 0);
+}
+
+TEST_CASE("UpdateMask: AND with an empty mask", "[UpdateMask]")
+{
+    TestMask left;
+    left.Set(5);
+    left.Set(1099);
+
+    left &= TestMask();
+    REQUIRE(!left.IsAnySet());
+}
+
+TEST_CASE("UpdateMask: OR merges bits and blocks", "[UpdateMask]")
+{
+    TestMask left;
+    left.Set(1);
+
+    TestMask right;
+    right.Set(2);
+    right.Set(1080);
+
+    TestMask result = left | right;
+    REQUIRE(result[1]);
+    REQUIRE(result[2]);
+    REQUIRE(result[1080]);
+    REQUIRE(result.GetBlock(0) == 0x6);
+    REQUIRE(result.GetBlocksMask(1) != 0);
+}
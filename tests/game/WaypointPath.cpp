@@ -0,0 +1,85 @@
+/*
+ * This file is part of the TrinityCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation; either version 2 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tc_catch2.h"
+
+#include "Spline.h"
+#include "WaypointDefines.h"
+#include <span>
+
+namespace
+{
+WaypointPath MakePath()
+{
+    std::vector<WaypointNode> nodes;
+    for (uint32 i = 0; i < 9; ++i)
+        nodes.emplace_back(i, float(i * 7 % 5) * 3.0f + float(i), float(i * i % 7), float(i % 3), Optional<float>(), i == 4 ? Optional<Milliseconds>(100ms) : Optional<Milliseconds>());
+
+    WaypointPath path(1, std::move(nodes));
+    path.BuildSegments();
+    return path;
+}
+
+// checks the shared lengths against a spline built the same way as a launched spline, starting at start and passing the given nodes
+void CheckKnownLengths(G3D::Vector3 const& start, std::vector<G3D::Vector3> const& nodes, std::span<float const> knownLengths)
+{
+    std::vector<G3D::Vector3> controls{ start };
+    controls.insert(controls.end(), nodes.begin(), nodes.end());
+
+    Movement::Spline<int32> spline;
+    spline.init_spline(controls.data(), controls.size(), Movement::SplineBase::ModeCatmullrom, 0.7f);
+
+    REQUIRE(int32(knownLengths.size()) == spline.last() - spline.first() - 2);
+    int32 firstKnown = spline.last() - int32(knownLengths.size());
+    for (int32 i = firstKnown; i < spline.last(); ++i)
+        REQUIRE(spline.SegLength(i) == knownLengths[i - firstKnown]);
+}
+}
+
+TEST_CASE("WaypointPath: Points follow nodes", "[WaypointPath]")
+{
+    WaypointPath path = MakePath();
+    REQUIRE(path.Points.size() == path.Nodes.size());
+    for (std::size_t i = 0; i < path.Nodes.size(); ++i)
+        REQUIRE(path.Points[i] == G3D::Vector3(path.Nodes[i].X, path.Nodes[i].Y, path.Nodes[i].Z));
+}
+
+TEST_CASE("WaypointPath: Known segment lengths match launched splines", "[WaypointPath]")
+{
+    WaypointPath path = MakePath();
+    G3D::Vector3 start(-3.0f, 2.0f, 1.0f);
+
+    REQUIRE(path.ContinuousSegments.size() == 2);
+    for (auto [first, count] : path.ContinuousSegments)
+    {
+        std::size_t last = first + count - 1;
+        for (std::size_t current = first; current <= last; ++current)
+        {
+            if (last - current + 1 >= 3)
+            {
+                std::vector<G3D::Vector3> nodes(path.Points.begin() + current, path.Points.begin() + last + 1);
+                CheckKnownLengths(start, nodes, std::span(&path.ForwardSegmentLengths[current + 1], last - current - 1));
+            }
+
+            if (current - first + 1 >= 3)
+            {
+                std::vector<G3D::Vector3> nodes(std::make_reverse_iterator(path.Points.begin() + current + 1), std::make_reverse_iterator(path.Points.begin() + first));
+                CheckKnownLengths(start, nodes, std::span(&path.BackwardSegmentLengths[path.Nodes.size() - current], current - first - 1));
+            }
+        }
+    }
+}